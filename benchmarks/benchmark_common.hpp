@@ -0,0 +1,246 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_BENCHMARKS_BENCHMARK_COMMON_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_BENCHMARKS_BENCHMARK_COMMON_HPP_INCLUDED
+
+/// \file benchmark_common.hpp
+/// \brief Command-line, percentile and result output helpers shared by the benchmarks.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mdbxc_bench {
+
+    /// \brief Names accepted by \c --preset, one per line for \c --list-presets.
+    static const char* const preset_names = "quick\nrealistic\n";
+
+    inline bool is_decimal_digit(char ch) {
+        return ch >= '0' && ch <= '9';
+    }
+
+    /// \brief Parses a decimal unsigned 64-bit argument.
+    /// \param text Argument text.
+    /// \param name Argument name used in error messages.
+    /// \throws std::runtime_error if \p text is not a decimal number or overflows.
+    inline std::uint64_t parse_u64(const char* text, const char* name) {
+        if (!is_decimal_digit(text[0])) {
+            throw std::runtime_error(std::string("invalid ") + name + ": " + text);
+        }
+        char* end = nullptr;
+        errno = 0;
+        const unsigned long long value = std::strtoull(text, &end, 10);
+        if (end == text || *end != '\0') {
+            throw std::runtime_error(std::string("invalid ") + name + ": " + text);
+        }
+        const unsigned long long max_u64 =
+            static_cast<unsigned long long>(std::numeric_limits<std::uint64_t>::max());
+        if (errno == ERANGE || value > max_u64) {
+            throw std::runtime_error(std::string("out-of-range ") + name + ": " + text);
+        }
+        return static_cast<std::uint64_t>(value);
+    }
+
+    /// \brief Escapes quotes, backslashes and control characters for a JSON string.
+    inline std::string json_escape(const std::string& text) {
+        std::string out;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const unsigned char ch = static_cast<unsigned char>(text[i]);
+            if (ch == '"' || ch == '\\') {
+                out.push_back('\\');
+                out.push_back(static_cast<char>(ch));
+            } else if (ch < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                out += buf;
+            } else {
+                out.push_back(static_cast<char>(ch));
+            }
+        }
+        return out;
+    }
+
+    /// \brief Returns the sample at \p fraction of the sorted \p values, or 0 if empty.
+    inline double percentile(std::vector<double> values, double fraction) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        const std::size_t rank = std::min(values.size() - 1,
+            static_cast<std::size_t>(fraction * static_cast<double>(values.size())));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+        return values[rank];
+    }
+
+    /// \brief Prints the usage lines shared by the benchmarks with CSV/JSON output.
+    /// \param program Executable name.
+    /// \param positional Positional scenario arguments; a leading newline puts
+    ///        them on their own line.
+    /// \param details Description printed after a blank line.
+    inline void print_usage(const char* program, const char* positional, const char* details) {
+        const std::string options = std::string(program) + " [--format csv|json] [--label text]";
+        std::cout
+            << "usage: " << options << (positional[0] == '\n' ? "" : " ") << positional << "\n"
+            << "       " << options << " --preset quick\n"
+            << "       " << options << " --preset realistic\n"
+            << "       " << program << " --list-presets\n"
+            << "\n"
+            << details;
+    }
+
+    /// \brief Removes \c --format and \c --label from the command line.
+    /// \param format Receives the output format; \c csv unless given.
+    /// \param label Receives the label column value.
+    /// \return The remaining arguments, without the program name.
+    /// \throws std::runtime_error if a value is missing or the format is unknown.
+    inline std::vector<std::string> split_output_options(int argc, char** argv,
+                                                         std::string& format,
+                                                         std::string& label) {
+        format = "csv";
+        std::vector<std::string> args;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--format" || arg == "--label") {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error(arg + " expects a value");
+                }
+                (arg == "--format" ? format : label) = argv[++i];
+            } else {
+                args.push_back(arg);
+            }
+        }
+        if (format != "csv" && format != "json") {
+            throw std::runtime_error("--format must be csv or json");
+        }
+        return args;
+    }
+
+    /// \brief Handles \c --help, \c --list-presets and \c --preset.
+    /// \param args Arguments without the program name and benchmark-specific options.
+    /// \param usage Prints the benchmark usage for \c --help.
+    /// \param preset Receives the selected preset; \c quick when \p args is empty.
+    /// \return \c true if a preset was selected, \c false if \p args holds
+    ///         scenario arguments. \c --help and \c --list-presets exit the process.
+    /// \throws std::runtime_error on a malformed \c --list-presets or \c --preset.
+    inline bool select_preset(const std::vector<std::string>& args,
+                              void (*usage)(),
+                              std::string& preset) {
+        if (args.empty()) {
+            preset = "quick";
+            return true;
+        }
+        const std::string& first = args[0];
+        if (first == "--help" || first == "-h") {
+            usage();
+            std::exit(0);
+        }
+        if (first == "--list-presets") {
+            if (args.size() != 1) {
+                throw std::runtime_error("--list-presets does not accept arguments");
+            }
+            std::cout << preset_names;
+            std::exit(0);
+        }
+        if (first == "--preset") {
+            if (args.size() != 2) {
+                throw std::runtime_error("--preset expects exactly one preset name");
+            }
+            preset = args[1];
+            return true;
+        }
+        return false;
+    }
+
+    /// \brief Writes result rows as CSV or as a JSON array of objects.
+    /// \details Every row starts with the label column. The CSV header is taken
+    /// from the column names of the first row.
+    class ResultWriter {
+    public:
+        ResultWriter(const std::string& format, const std::string& label)
+            : m_json(format == "json"), m_label(label) {}
+
+        void begin() {
+            if (m_json) {
+                std::cout << "[\n";
+            }
+        }
+
+        /// \brief Starts a row with its label column.
+        ResultWriter& begin_row() {
+            m_line.str(std::string());
+            m_columns = 0;
+            return text("label", m_label);
+        }
+
+        /// \brief Appends a string column; quoted and escaped in JSON.
+        ResultWriter& text(const char* name, const std::string& value) {
+            if (!m_json) return column(name, value);
+            next_column(name);
+            m_line << '"' << json_escape(value) << '"';
+            return *this;
+        }
+
+        /// \brief Appends a numeric column.
+        template<class T>
+        ResultWriter& number(const char* name, const T& value) {
+            return column(name, value);
+        }
+
+        /// \brief Prints the row and flushes the output.
+        void end_row() {
+            if (m_json) {
+                std::cout << (m_rows == 0 ? "  " : ",\n  ") << '{' << m_line.str() << '}';
+            } else {
+                if (m_rows == 0) {
+                    std::cout << m_header << '\n';
+                }
+                std::cout << m_line.str() << '\n';
+            }
+            ++m_rows;
+            std::cout.flush();
+        }
+
+        void end() {
+            if (m_json) {
+                std::cout << (m_rows == 0 ? "]\n" : "\n]\n");
+            }
+        }
+
+    private:
+        template<class T>
+        ResultWriter& column(const char* name, const T& value) {
+            next_column(name);
+            m_line << value;
+            return *this;
+        }
+
+        void next_column(const char* name) {
+            if (m_columns++ != 0) {
+                m_line << ',';
+            }
+            if (m_json) {
+                m_line << '"' << name << "\":";
+            } else if (m_rows == 0) {
+                if (!m_header.empty()) m_header += ',';
+                m_header += name;
+            }
+        }
+
+        bool m_json;
+        std::string m_label;
+        std::size_t m_rows = 0;
+        std::size_t m_columns = 0;
+        std::string m_header;
+        std::ostringstream m_line;
+    };
+
+} // namespace mdbxc_bench
+
+#endif // MDBX_CONTAINERS_HEADER_BENCHMARKS_BENCHMARK_COMMON_HPP_INCLUDED
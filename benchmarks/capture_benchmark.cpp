@@ -0,0 +1,500 @@
+/// \file capture_benchmark.cpp
+/// \brief Manual benchmark of the write-path cost of sync change capture.
+/// \details Writes the same records through \c KeyValueTable in write
+/// transactions of several sizes with no capture sink, with a
+/// \c ThreadLocalChangeAccumulator attached through \c SyncCaptureScope,
+/// and with a timing wrapper around the accumulator that splits the cost
+/// into recording ops and flushing the batch. Built a second time with
+/// \c MDBXC_SYNC_ENABLED=0 as \c capture_benchmark_sync_disabled, where
+/// only the sink-less rows run.
+
+#include <mdbx_containers.hpp>
+#include <mdbx_containers/sync.hpp>
+
+#include "benchmark_common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::size_t min_value_bytes = 8;
+const std::size_t max_value_bytes = 1024 * 1024;
+const std::uint64_t max_txn_ops = 1000000;
+const std::uint64_t key_mix = 0x9E3779B97F4A7C15ULL;
+
+#if MDBXC_SYNC_ENABLED
+const char* const build_name = "sync_enabled";
+#else
+const char* const build_name = "sync_disabled";
+#endif
+
+struct Scenario {
+    std::string   name;
+    std::string   commit;       ///< durable or nosync.
+    std::uint64_t ops;
+    std::uint64_t value_bytes;
+    std::vector<std::uint64_t> txn_sizes;
+};
+
+struct Row {
+    std::string   mode;
+    std::uint64_t txn_ops = 1;
+    std::uint64_t txns = 0;
+    double        ms = 0.0;
+    double        overhead_pct = 0.0;
+    double        record_us_per_op = 0.0;
+    double        flush_us_per_txn = 0.0;
+    double        encode_us_per_txn = 0.0;
+    double        append_us_per_txn = 0.0;
+    double        changelog_bytes_per_txn = 0.0;
+};
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+struct CleanupGuard {
+    explicit CleanupGuard(const std::string& path_value) : path(path_value) {}
+
+    ~CleanupGuard() {
+        cleanup(path);
+    }
+
+    std::string path;
+};
+
+std::string run_id() {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds ticks =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch());
+    return std::to_string(ticks.count());
+}
+
+using mdbxc_bench::parse_u64;
+
+double elapsed_us(std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point finish) {
+    const std::chrono::nanoseconds elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start);
+    return static_cast<double>(elapsed.count()) / 1000.0;
+}
+
+// --- Scenarios ---
+
+void validate_scenario(const Scenario& scenario) {
+    if (scenario.commit != "durable" && scenario.commit != "nosync") {
+        throw std::runtime_error("commit must be durable or nosync");
+    }
+    if (scenario.ops == 0) {
+        throw std::runtime_error("ops must be positive");
+    }
+    if (scenario.value_bytes < min_value_bytes || scenario.value_bytes > max_value_bytes) {
+        throw std::runtime_error("value_bytes must be in [8, 1048576]");
+    }
+    if (scenario.txn_sizes.empty()) {
+        throw std::runtime_error("at least one txn_ops value is required");
+    }
+    for (std::size_t i = 0; i < scenario.txn_sizes.size(); ++i) {
+        if (scenario.txn_sizes[i] == 0 || scenario.txn_sizes[i] > max_txn_ops) {
+            throw std::runtime_error("txn_ops must be in [1, 1000000]");
+        }
+    }
+}
+
+Scenario make_scenario(const std::string& name,
+                       const std::string& commit,
+                       std::uint64_t ops,
+                       std::uint64_t value_bytes) {
+    Scenario scenario;
+    scenario.name = name;
+    scenario.commit = commit;
+    scenario.ops = ops;
+    scenario.value_bytes = value_bytes;
+    scenario.txn_sizes.push_back(1);
+    scenario.txn_sizes.push_back(10);
+    scenario.txn_sizes.push_back(100);
+    scenario.txn_sizes.push_back(1000);
+    return scenario;
+}
+
+std::vector<Scenario> default_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("nosync_100k_v64", "nosync", 100000, 64));
+    return scenarios;
+}
+
+std::vector<Scenario> realistic_scenarios() {
+    std::vector<Scenario> scenarios;
+    Scenario nosync = make_scenario("nosync_1m_v256", "nosync", 1000000, 256);
+    nosync.txn_sizes.push_back(10000);
+    scenarios.push_back(nosync);
+    // Every durable commit waits for fsync; fewer operations keep the run
+    // short.
+    scenarios.push_back(make_scenario("durable_20k_v256", "durable", 20000, 256));
+    return scenarios;
+}
+
+std::vector<Scenario> preset_scenarios(const std::string& preset) {
+    if (preset == "quick") {
+        return default_scenarios();
+    }
+    if (preset == "realistic") {
+        return realistic_scenarios();
+    }
+    throw std::runtime_error("unknown benchmark preset: " + preset);
+}
+
+void print_usage() {
+    mdbxc_bench::print_usage(
+        "capture_benchmark",
+        "[commit ops value_bytes [txn_ops...]]",
+        "Without scenario arguments, runs the quick built-in scenario.\n"
+        "commit is durable or nosync; positional arguments are optional from\n"
+        "left to right and default to nosync 100000 64 1 10 100 1000. Each\n"
+        "txn_ops value writes ops records in transactions of that many\n"
+        "writes, with capture off, attached, and attached with timing.\n");
+}
+
+struct CommandLine {
+    std::string format = "csv";
+    std::string label;
+    std::vector<Scenario> scenarios;
+};
+
+CommandLine parse_options(int argc, char** argv) {
+    CommandLine options;
+    const std::vector<std::string> args =
+        mdbxc_bench::split_output_options(argc, argv, options.format, options.label);
+    std::string preset;
+    if (mdbxc_bench::select_preset(args, print_usage, preset)) {
+        options.scenarios = preset_scenarios(preset);
+        return options;
+    }
+    const std::string& first = args[0];
+    if (first[0] == '-') {
+        throw std::runtime_error("unknown option: " + first);
+    }
+    Scenario scenario = make_scenario(
+        "custom",
+        first,
+        args.size() > 1 ? parse_u64(args[1].c_str(), "ops") : 100000,
+        args.size() > 2 ? parse_u64(args[2].c_str(), "value_bytes") : 64);
+    if (args.size() > 3) {
+        scenario.txn_sizes.clear();
+        for (std::size_t i = 3; i < args.size(); ++i) {
+            scenario.txn_sizes.push_back(parse_u64(args[i].c_str(), "txn_ops"));
+        }
+    }
+    options.scenarios.push_back(scenario);
+    return options;
+}
+
+// --- Output ---
+
+using mdbxc_bench::ResultWriter;
+
+void write_row(ResultWriter& writer, const Scenario& scenario, const Row& row) {
+    const double per_sec =
+        row.ms <= 0.0 ? 0.0 : (static_cast<double>(scenario.ops) * 1000.0) / row.ms;
+    const double us_per_txn =
+        row.txns == 0 ? 0.0 : row.ms * 1000.0 / static_cast<double>(row.txns);
+    writer.begin_row()
+        .text("build", build_name)
+        .text("scenario", scenario.name)
+        .text("commit", scenario.commit)
+        .text("mode", row.mode)
+        .number("txn_ops", row.txn_ops)
+        .number("value_bytes", scenario.value_bytes)
+        .number("ops", scenario.ops)
+        .number("txns", row.txns)
+        .number("ms", row.ms)
+        .number("ops_per_sec", per_sec)
+        .number("us_per_txn", us_per_txn)
+        .number("overhead_pct", row.overhead_pct)
+        .number("record_us_per_op", row.record_us_per_op)
+        .number("flush_us_per_txn", row.flush_us_per_txn)
+        .number("encode_us_per_txn", row.encode_us_per_txn)
+        .number("append_us_per_txn", row.append_us_per_txn)
+        .number("changelog_bytes_per_txn", row.changelog_bytes_per_txn)
+        .end_row();
+}
+
+// --- Environment ---
+
+/// \brief Value of seed \p seed; its first 8 bytes keep values distinct.
+std::string make_value(std::size_t size, std::uint64_t seed) {
+    std::string out(size, 'v');
+    for (std::size_t i = 0; i < 8; ++i) {
+        out[i] = static_cast<char>((seed >> (56 - 8 * i)) & 0xFF);
+    }
+    return out;
+}
+
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path,
+                                            const Scenario& scenario) {
+    mdbxc::Config config;
+    config.pathname = path;
+    config.max_dbs = 16;
+    config.no_subdir = true;
+    config.size_now = 256LL * 1024LL * 1024LL;
+    config.size_upper = 64LL * 1024LL * 1024LL * 1024LL;
+    if (scenario.commit == "nosync") {
+        config.sync_mode = mdbxc::SyncMode::UtterlyNoSync;
+    }
+    return mdbxc::Connection::create(config);
+}
+
+typedef mdbxc::KeyValueTable<std::uint64_t, std::string> BenchTable;
+
+#if MDBXC_SYNC_ENABLED
+
+mdbxc::sync::NodeId make_node(std::uint8_t seed) {
+    mdbxc::sync::NodeId node{};
+    for (int i = 0; i < 16; ++i) {
+        node[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return node;
+}
+
+/// \brief Forwards to another sink and times the record and flush calls.
+/// \details Adds two clock reads per call, so its rows run slightly slower
+/// than the plain \c capture rows; compare totals with those instead.
+class TimedCaptureSink : public mdbxc::sync::ISyncCaptureSink {
+public:
+    explicit TimedCaptureSink(mdbxc::sync::ISyncCaptureSink& next) : m_next(next) {}
+
+    void record_change(MDBX_txn* txn,
+                       const std::string& dbi_name,
+                       mdbxc::sync::ChangeOpType op_type,
+                       std::uint32_t dbi_flags,
+                       const std::vector<std::uint8_t>& storage_key,
+                       const std::vector<std::uint8_t>& value) override {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        m_next.record_change(txn, dbi_name, op_type, dbi_flags, storage_key, value);
+        record_us += elapsed_us(start, std::chrono::steady_clock::now());
+        ++records;
+    }
+
+    void record_change_view(MDBX_txn* txn,
+                            const std::string& dbi_name,
+                            mdbxc::sync::ChangeOpType op_type,
+                            std::uint32_t dbi_flags,
+                            const MDBX_val& storage_key,
+                            const MDBX_val& value) override {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        m_next.record_change_view(txn, dbi_name, op_type, dbi_flags, storage_key, value);
+        record_us += elapsed_us(start, std::chrono::steady_clock::now());
+        ++records;
+    }
+
+    void flush_in_txn(MDBX_txn* txn) override {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        m_next.flush_in_txn(txn);
+        flush_us += elapsed_us(start, std::chrono::steady_clock::now());
+        ++flushes;
+    }
+
+    void discard_txn(MDBX_txn* txn) noexcept override {
+        m_next.discard_txn(txn);
+    }
+
+    void committed_txn(std::uint64_t txn_id) noexcept override {
+        m_next.committed_txn(txn_id);
+    }
+
+    std::shared_ptr<mdbxc::sync::OriginTailCache> origin_tail_cache() const override {
+        return m_next.origin_tail_cache();
+    }
+
+    void env_closed() noexcept override {
+        m_next.env_closed();
+    }
+
+    double        record_us = 0.0;
+    double        flush_us = 0.0;
+    std::uint64_t records = 0;
+    std::uint64_t flushes = 0;
+
+private:
+    mdbxc::sync::ISyncCaptureSink& m_next;
+};
+
+/// \brief Encodes \p txns batches of \p txn_ops puts the way the
+/// accumulator streams them into its arena.
+/// \param arena Receives the last batch.
+/// \return Average microseconds per batch.
+double measure_encode(const Scenario& scenario, std::uint64_t txn_ops,
+                      std::uint64_t txns, std::vector<std::uint8_t>& arena) {
+    const std::string dbi_name = "bench";
+    const mdbxc::sync::NodeId origin = make_node(0xA0);
+    mdbxc::sync::ChangeBatchCodec::NameDictionary names;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::uint64_t op = 0;
+    for (std::uint64_t t = 0; t < txns; ++t) {
+        arena.clear();
+        names.clear();
+        arena.resize(mdbxc::sync::ChangeBatchCodec::header_size());
+        const std::uint64_t end = std::min(scenario.ops, op + txn_ops);
+        for (; op < end; ++op) {
+            const std::uint64_t key = op * key_mix;
+            const std::string value = make_value(static_cast<std::size_t>(scenario.value_bytes), op);
+            mdbxc::sync::ChangeBatchCodec::append_op(
+                arena, names, mdbxc::sync::ChangeOpType::Put, 0, dbi_name,
+                &key, sizeof(key), value.data(), value.size());
+        }
+        mdbxc::sync::ChangeBatchCodec::write_header(
+            &arena[0], mdbxc::sync::BATCH_NONE, origin, t + 1, 0,
+            static_cast<std::uint32_t>(end - t * txn_ops));
+    }
+    return elapsed_us(start, std::chrono::steady_clock::now()) / static_cast<double>(txns);
+}
+
+/// \brief Appends \p txns copies of \p arena to the changelog of a foreign
+/// origin, one write transaction each, timing only the append calls.
+double measure_append(const std::shared_ptr<mdbxc::Connection>& conn,
+                      const std::vector<std::uint8_t>& arena, std::uint64_t txns) {
+    const mdbxc::sync::NodeId origin = make_node(0xC0);
+    mdbxc::sync::ChangeLogStore log(conn->env_handle());
+    double total_us = 0.0;
+    for (std::uint64_t t = 0; t < txns; ++t) {
+        mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        log.reset_open();
+        log.open(txn.handle());
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        log.append(txn.handle(), origin, t + 1, arena);
+        total_us += elapsed_us(start, std::chrono::steady_clock::now());
+        txn.commit();
+    }
+    return total_us / static_cast<double>(txns);
+}
+
+#endif
+
+// --- Measurements ---
+
+/// \brief Writes every record once in transactions of \p txn_ops writes.
+double write_records(const std::shared_ptr<mdbxc::Connection>& conn,
+                     BenchTable& table,
+                     const Scenario& scenario,
+                     std::uint64_t txn_ops) {
+    const std::size_t value_bytes = static_cast<std::size_t>(scenario.value_bytes);
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::uint64_t offset = 0; offset < scenario.ops; offset += txn_ops) {
+        const std::uint64_t end = std::min(scenario.ops, offset + txn_ops);
+        mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        for (std::uint64_t i = offset; i < end; ++i) {
+            // Multiplying by an odd constant spreads keys without repeats.
+            table.insert_or_assign(i * key_mix, make_value(value_bytes, i), txn);
+        }
+        txn.commit();
+    }
+    return elapsed_us(start, std::chrono::steady_clock::now()) / 1000.0;
+}
+
+Row run_mode(const Scenario& scenario, const std::string& path,
+             const std::string& mode, std::uint64_t txn_ops) {
+    cleanup(path);
+    Row row;
+    row.mode = mode;
+    row.txn_ops = txn_ops;
+    row.txns = (scenario.ops + txn_ops - 1) / txn_ops;
+    std::shared_ptr<mdbxc::Connection> conn = open_env(path, scenario);
+    {
+        BenchTable table(conn, "bench");
+#if MDBXC_SYNC_ENABLED
+        // Every mode gets the sync system tables, so only the sink differs.
+        mdbxc::sync::SyncEngine engine(conn);
+        engine.initialize_local_identity(make_node(0xA0), make_node(0xD0));
+        mdbxc::sync::ThreadLocalChangeAccumulator capture(conn);
+        TimedCaptureSink timed(capture);
+        std::unique_ptr<mdbxc::sync::SyncCaptureScope> scope;
+        if (mode == "capture") {
+            scope.reset(new mdbxc::sync::SyncCaptureScope(conn, capture));
+        } else if (mode == "capture_timed") {
+            scope.reset(new mdbxc::sync::SyncCaptureScope(conn, timed));
+        }
+        row.ms = write_records(conn, table, scenario, txn_ops);
+        scope.reset();
+        if (mode == "capture_timed") {
+            row.record_us_per_op = timed.records == 0
+                ? 0.0 : timed.record_us / static_cast<double>(timed.records);
+            row.flush_us_per_txn = timed.flushes == 0
+                ? 0.0 : timed.flush_us / static_cast<double>(timed.flushes);
+            std::vector<std::uint8_t> arena;
+            row.encode_us_per_txn = measure_encode(scenario, txn_ops, row.txns, arena);
+            row.append_us_per_txn = measure_append(conn, arena, row.txns);
+            row.changelog_bytes_per_txn = static_cast<double>(arena.size());
+        }
+#else
+        row.ms = write_records(conn, table, scenario, txn_ops);
+#endif
+    }
+    conn->disconnect();
+    cleanup(path);
+    return row;
+}
+
+void run_scenario(const Scenario& scenario, const std::string& id, ResultWriter& writer) {
+    validate_scenario(scenario);
+    const std::string path = "benchmark_capture_" + id + "_" + scenario.name + ".mdbx";
+    CleanupGuard cleanup_guard(path);
+    std::vector<std::string> modes;
+    modes.push_back("off");
+#if MDBXC_SYNC_ENABLED
+    modes.push_back("capture");
+    modes.push_back("capture_timed");
+#endif
+    for (std::size_t s = 0; s < scenario.txn_sizes.size(); ++s) {
+        double off_ms = 0.0;
+        for (std::size_t m = 0; m < modes.size(); ++m) {
+            Row row = run_mode(scenario, path, modes[m], scenario.txn_sizes[s]);
+            if (m == 0) {
+                off_ms = row.ms;
+            } else if (off_ms > 0.0) {
+                row.overhead_pct = (row.ms - off_ms) * 100.0 / off_ms;
+            }
+            write_row(writer, scenario, row);
+        }
+    }
+}
+
+int run(int argc, char** argv) {
+    const CommandLine options = parse_options(argc, argv);
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        validate_scenario(options.scenarios[i]);
+    }
+    const std::string id = run_id();
+    ResultWriter writer(options.format, options.label);
+    writer.begin();
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        run_scenario(options.scenarios[i], id, writer);
+    }
+    writer.end();
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL capture_benchmark: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "FAIL capture_benchmark: non-std exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,590 @@
+/// \file concurrency_benchmark.cpp
+/// \brief Manual benchmark of auto-transaction read/write throughput
+/// through one Connection as the thread count grows.
+/// \details Every operation is a table call without a transaction argument,
+/// so each one opens and closes its own transaction through
+/// TransactionTracker and Connection. Rows sweep thread counts and
+/// read/write mixes with sync capture detached, attached, or with a
+/// concurrent remote apply holding the sync-apply guard.
+
+#include <mdbx_containers.hpp>
+#include <mdbx_containers/sync.hpp>
+
+#include "benchmark_common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::uint64_t preload_batch = 1000;
+const std::size_t min_value_bytes = 8;
+const std::size_t max_value_bytes = 1024 * 1024;
+const std::uint64_t max_threads = 256;
+const std::uint64_t max_ops_per_thread = 10000000;
+
+struct Scenario {
+    std::string   name;
+    std::string   commit;       ///< durable or nosync.
+    std::uint64_t records;
+    std::uint64_t value_bytes;
+    std::uint64_t ops_per_thread;
+    std::vector<std::uint64_t> threads;
+    std::vector<std::string>   configs;      ///< default, read_cache, group_commit.
+    std::vector<std::string>   sync_modes;   ///< off, capture, apply.
+    std::vector<std::uint64_t> read_percents;
+};
+
+struct Row {
+    std::string   config;
+    std::string   sync;
+    std::uint64_t read_pct = 100;
+    std::uint64_t threads = 1;
+    std::uint64_t reads = 0;
+    std::uint64_t writes = 0;
+    std::uint64_t applied_batches = 0;
+    double        ms = 0.0;
+    double        read_p50_us = 0.0;
+    double        read_p99_us = 0.0;
+    double        write_p50_us = 0.0;
+    double        write_p99_us = 0.0;
+};
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+struct CleanupGuard {
+    explicit CleanupGuard(const std::string& path_value) : path(path_value) {}
+
+    ~CleanupGuard() {
+        cleanup(path);
+    }
+
+    std::string path;
+};
+
+std::string run_id() {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds ticks =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch());
+    return std::to_string(ticks.count());
+}
+
+using mdbxc_bench::parse_u64;
+using mdbxc_bench::percentile;
+
+double elapsed_us(std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point finish) {
+    const std::chrono::nanoseconds elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start);
+    return static_cast<double>(elapsed.count()) / 1000.0;
+}
+
+// --- Scenarios ---
+
+void validate_scenario(const Scenario& scenario) {
+    if (scenario.commit != "durable" && scenario.commit != "nosync") {
+        throw std::runtime_error("commit must be durable or nosync");
+    }
+    if (scenario.records == 0) {
+        throw std::runtime_error("records must be positive");
+    }
+    if (scenario.value_bytes < min_value_bytes || scenario.value_bytes > max_value_bytes) {
+        throw std::runtime_error("value_bytes must be in [8, 1048576]");
+    }
+    if (scenario.ops_per_thread == 0 || scenario.ops_per_thread > max_ops_per_thread) {
+        throw std::runtime_error("ops_per_thread must be in [1, 10000000]");
+    }
+    if (scenario.threads.empty()) {
+        throw std::runtime_error("at least one thread count is required");
+    }
+    for (std::size_t i = 0; i < scenario.threads.size(); ++i) {
+        if (scenario.threads[i] == 0 || scenario.threads[i] > max_threads) {
+            throw std::runtime_error("thread counts must be in [1, 256]");
+        }
+    }
+    for (std::size_t i = 0; i < scenario.configs.size(); ++i) {
+        const std::string& config = scenario.configs[i];
+        if (config != "default" && config != "read_cache" && config != "group_commit") {
+            throw std::runtime_error("unknown connection config: " + config);
+        }
+    }
+    for (std::size_t i = 0; i < scenario.sync_modes.size(); ++i) {
+        const std::string& sync = scenario.sync_modes[i];
+        if (sync != "off" && sync != "capture" && sync != "apply") {
+            throw std::runtime_error("unknown sync mode: " + sync);
+        }
+    }
+    for (std::size_t i = 0; i < scenario.read_percents.size(); ++i) {
+        if (scenario.read_percents[i] > 100) {
+            throw std::runtime_error("read percentages must be in [0, 100]");
+        }
+    }
+}
+
+std::vector<std::uint64_t> thread_counts_up_to(std::uint64_t max_count) {
+    std::vector<std::uint64_t> counts;
+    for (std::uint64_t n = 1; n < max_count; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max_count);
+    return counts;
+}
+
+Scenario make_scenario(const std::string& name,
+                       const std::string& commit,
+                       std::uint64_t records,
+                       std::uint64_t value_bytes,
+                       std::uint64_t threads,
+                       std::uint64_t ops_per_thread) {
+    Scenario scenario;
+    scenario.name = name;
+    scenario.commit = commit;
+    scenario.records = records;
+    scenario.value_bytes = value_bytes;
+    scenario.ops_per_thread = ops_per_thread;
+    scenario.threads = thread_counts_up_to(threads);
+    scenario.configs.push_back("default");
+    scenario.sync_modes.push_back("off");
+    scenario.sync_modes.push_back("capture");
+    scenario.sync_modes.push_back("apply");
+    scenario.read_percents.push_back(100);
+    scenario.read_percents.push_back(95);
+    scenario.read_percents.push_back(50);
+    scenario.read_percents.push_back(0);
+    return scenario;
+}
+
+std::vector<Scenario> default_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("nosync_20k_v64", "nosync", 20000, 64, 4, 5000));
+    return scenarios;
+}
+
+std::vector<Scenario> realistic_scenarios() {
+    std::vector<Scenario> scenarios;
+    Scenario nosync = make_scenario("nosync_200k_v256", "nosync", 200000, 256, 16, 20000);
+    nosync.configs.push_back("read_cache");
+    nosync.configs.push_back("group_commit");
+    scenarios.push_back(nosync);
+    // Every durable write waits for fsync; fewer operations keep the run
+    // short, and the read-only mix would repeat the nosync rows.
+    Scenario durable = make_scenario("durable_200k_v256", "durable", 200000, 256, 16, 500);
+    durable.configs.push_back("group_commit");
+    durable.read_percents.erase(durable.read_percents.begin());
+    scenarios.push_back(durable);
+    return scenarios;
+}
+
+std::vector<Scenario> preset_scenarios(const std::string& preset) {
+    if (preset == "quick") {
+        return default_scenarios();
+    }
+    if (preset == "realistic") {
+        return realistic_scenarios();
+    }
+    throw std::runtime_error("unknown benchmark preset: " + preset);
+}
+
+void print_usage() {
+    mdbxc_bench::print_usage(
+        "concurrency_benchmark",
+        "[commit records value_bytes max_threads ops_per_thread]",
+        "Without scenario arguments, runs the quick built-in scenario.\n"
+        "commit is durable or nosync; positional arguments are optional from\n"
+        "left to right and default to nosync 100000 64 8 20000. Each row runs\n"
+        "ops_per_thread auto-transaction operations per thread with 1, 2, 4,\n"
+        "... threads up to max_threads, for read mixes 100, 95, 50 and 0\n"
+        "percent and sync modes off, capture and apply.\n");
+}
+
+struct CommandLine {
+    std::string format = "csv";
+    std::string label;
+    std::vector<Scenario> scenarios;
+};
+
+CommandLine parse_options(int argc, char** argv) {
+    CommandLine options;
+    const std::vector<std::string> args =
+        mdbxc_bench::split_output_options(argc, argv, options.format, options.label);
+    std::string preset;
+    if (mdbxc_bench::select_preset(args, print_usage, preset)) {
+        options.scenarios = preset_scenarios(preset);
+        return options;
+    }
+    const std::string& first = args[0];
+    if (first[0] == '-') {
+        throw std::runtime_error("unknown option: " + first);
+    }
+    if (args.size() > 5) {
+        throw std::runtime_error("too many positional arguments");
+    }
+    const std::uint64_t records = args.size() > 1 ? parse_u64(args[1].c_str(), "records") : 100000;
+    const std::uint64_t value_bytes = args.size() > 2 ? parse_u64(args[2].c_str(), "value_bytes") : 64;
+    const std::uint64_t threads = args.size() > 3 ? parse_u64(args[3].c_str(), "max_threads") : 8;
+    const std::uint64_t ops = args.size() > 4 ? parse_u64(args[4].c_str(), "ops_per_thread") : 20000;
+    if (threads == 0 || threads > max_threads) {
+        throw std::runtime_error("max_threads must be in [1, 256]");
+    }
+    options.scenarios.push_back(
+        make_scenario("custom", first, records, value_bytes, threads, ops));
+    return options;
+}
+
+// --- Output ---
+
+using mdbxc_bench::ResultWriter;
+
+void write_row(ResultWriter& writer, const Scenario& scenario, const Row& row) {
+    const std::uint64_t ops = row.reads + row.writes;
+    const double per_sec =
+        row.ms <= 0.0 ? 0.0 : (static_cast<double>(ops) * 1000.0) / row.ms;
+    writer.begin_row()
+        .text("scenario", scenario.name)
+        .text("commit", scenario.commit)
+        .text("config", row.config)
+        .text("sync", row.sync)
+        .number("read_pct", row.read_pct)
+        .number("records", scenario.records)
+        .number("value_bytes", scenario.value_bytes)
+        .number("threads", row.threads)
+        .number("ops", ops)
+        .number("reads", row.reads)
+        .number("writes", row.writes)
+        .number("ms", row.ms)
+        .number("ops_per_sec", per_sec)
+        .number("read_p50_us", row.read_p50_us)
+        .number("read_p99_us", row.read_p99_us)
+        .number("write_p50_us", row.write_p50_us)
+        .number("write_p99_us", row.write_p99_us)
+        .number("applied_batches", row.applied_batches)
+        .end_row();
+}
+
+// --- Environment ---
+
+mdbxc::sync::NodeId make_node(std::uint8_t seed) {
+    mdbxc::sync::NodeId node{};
+    for (int i = 0; i < 16; ++i) {
+        node[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return node;
+}
+
+/// \brief Value of seed \p seed; its first 8 bytes keep values distinct.
+std::string make_value(std::size_t size, std::uint64_t seed) {
+    std::string out(size, 'v');
+    for (std::size_t i = 0; i < 8; ++i) {
+        out[i] = static_cast<char>((seed >> (56 - 8 * i)) & 0xFF);
+    }
+    return out;
+}
+
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path,
+                                            const Scenario& scenario,
+                                            const std::string& config_name) {
+    const std::uint64_t max_count =
+        *std::max_element(scenario.threads.begin(), scenario.threads.end());
+    mdbxc::Config config;
+    config.pathname = path;
+    config.max_dbs = 16;
+    config.no_subdir = true;
+    config.size_now = 256LL * 1024LL * 1024LL;
+    config.size_upper = 64LL * 1024LL * 1024LL * 1024LL;
+    // Room for every worker, the apply thread and parked read transactions.
+    config.max_readers = static_cast<std::int64_t>(3 * max_count + 8);
+    if (scenario.commit == "nosync") {
+        config.sync_mode = mdbxc::SyncMode::UtterlyNoSync;
+    }
+    if (config_name == "read_cache") {
+        config.read_txn_cache_size = static_cast<std::int64_t>(max_count);
+    } else if (config_name == "group_commit") {
+        config.group_commit = true;
+    }
+    return mdbxc::Connection::create(config);
+}
+
+typedef mdbxc::KeyValueTable<std::uint64_t, std::string> BenchTable;
+
+/// \brief Measured connection with its table and the sync objects of
+/// the capture and apply modes.
+struct BenchEnv {
+    BenchEnv(const std::shared_ptr<mdbxc::Connection>& conn_value,
+             const Scenario& scenario)
+        : conn(conn_value),
+          table(conn_value, "bench"),
+          engine(conn_value),
+          capture(conn_value),
+          local_node(make_node(0xA0)),
+          feeder_node(make_node(0xB0)),
+          db_id(make_node(0xD0)),
+          value_bytes(static_cast<std::size_t>(scenario.value_bytes)) {
+        engine.initialize_local_identity(local_node, db_id);
+    }
+
+    std::shared_ptr<mdbxc::Connection> conn;
+    BenchTable table;
+    mdbxc::sync::SyncEngine engine;
+    mdbxc::sync::ThreadLocalChangeAccumulator capture;
+    mdbxc::sync::NodeId local_node;
+    mdbxc::sync::NodeId feeder_node;
+    mdbxc::sync::NodeId db_id;
+    std::size_t value_bytes;
+    std::uint64_t feeder_seq = 0;   ///< Last seq pushed from feeder_node.
+};
+
+void preload(BenchEnv& env, std::uint64_t records) {
+    for (std::uint64_t offset = 0; offset < records; offset += preload_batch) {
+        const std::uint64_t end = std::min(records, offset + preload_batch);
+        mdbxc::Transaction txn = env.conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        for (std::uint64_t i = offset; i < end; ++i) {
+            env.table.insert_or_assign(i, make_value(env.value_bytes, i), txn);
+        }
+        txn.commit();
+    }
+}
+
+/// \brief Pushes one-op batches from \c feeder_node until \p stop is set,
+/// as a replica receiving a remote stream would.
+/// \return Number of applied batches.
+std::uint64_t feed_remote_batches(BenchEnv& env,
+                                  std::uint64_t records,
+                                  const std::atomic<bool>& stop) {
+    std::uint64_t applied = 0;
+    mdbxc::sync::PushRequest push;
+    push.sender = env.feeder_node;
+    push.db_id = env.db_id;
+    push.batches.resize(1);
+    mdbxc::sync::ChangeBatch& batch = push.batches[0];
+    batch.origin_node_id = env.feeder_node;
+    batch.ops.resize(1);
+    mdbxc::sync::ChangeOp& op = batch.ops[0];
+    op.op_type = mdbxc::sync::ChangeOpType::Put;
+    op.dbi_name = "feed";
+    op.storage_key.resize(8);
+    while (!stop.load()) {
+        const std::uint64_t seq = ++env.feeder_seq;
+        const std::uint64_t slot = seq % records;
+        for (int i = 0; i < 8; ++i) {
+            op.storage_key[i] = static_cast<std::uint8_t>((slot >> ((7 - i) * 8)) & 0xff);
+        }
+        const std::string value = make_value(env.value_bytes, seq);
+        op.value.assign(value.begin(), value.end());
+        batch.seq = seq;
+        batch.time_unix_ns = seq;
+        const mdbxc::sync::PushResponse response = env.engine.handle_push(push);
+        if (!response.ok) {
+            throw std::runtime_error("remote apply failed: " + response.error);
+        }
+        ++applied;
+    }
+    return applied;
+}
+
+// --- Measurements ---
+
+struct WorkerResult {
+    std::vector<double> read_us;
+    std::vector<double> write_us;
+    std::uint64_t misses = 0;
+    std::string error;
+};
+
+/// \brief Runs \p threads workers doing \c ops_per_thread auto-transaction
+/// operations each, \p read_pct percent of them reads.
+Row measure_mix(BenchEnv& env,
+                const Scenario& scenario,
+                const std::string& sync,
+                std::uint64_t read_pct,
+                std::uint64_t threads) {
+    std::vector<WorkerResult> results(static_cast<std::size_t>(threads));
+    std::atomic<std::size_t> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < results.size(); ++t) {
+        workers.push_back(std::thread([&env, &scenario, &results, &ready, &go, read_pct, t]() {
+            WorkerResult& out = results[t];
+            try {
+                std::mt19937_64 rng(7000 + t);
+                std::uniform_int_distribution<std::uint64_t> pick_key(0, scenario.records - 1);
+                std::uniform_int_distribution<std::uint64_t> pick_pct(0, 99);
+                out.read_us.reserve(static_cast<std::size_t>(scenario.ops_per_thread));
+                out.write_us.reserve(static_cast<std::size_t>(scenario.ops_per_thread));
+                std::string value;
+                ready.fetch_add(1);
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+                for (std::uint64_t i = 0; i < scenario.ops_per_thread; ++i) {
+                    const std::uint64_t key = pick_key(rng);
+                    const bool read = pick_pct(rng) < read_pct;
+                    if (!read) {
+                        value = make_value(env.value_bytes, key ^ (i << 20));
+                    }
+                    const std::chrono::steady_clock::time_point start =
+                        std::chrono::steady_clock::now();
+                    if (read) {
+                        if (!env.table.try_get(key, value, nullptr)) {
+                            ++out.misses;
+                        }
+                    } else {
+                        env.table.insert_or_assign(key, value);
+                    }
+                    const double us = elapsed_us(start, std::chrono::steady_clock::now());
+                    (read ? out.read_us : out.write_us).push_back(us);
+                }
+            } catch (const std::exception& e) {
+                out.error = e.what();
+                ready.fetch_add(1);
+            }
+        }));
+    }
+    while (ready.load() < workers.size()) {
+        std::this_thread::yield();
+    }
+
+    std::atomic<bool> stop_feeder(false);
+    std::uint64_t applied = 0;
+    std::string feeder_error;
+    std::thread feeder;
+    if (sync == "apply") {
+        feeder = std::thread([&env, &scenario, &stop_feeder, &applied, &feeder_error]() {
+            try {
+                applied = feed_remote_batches(env, scenario.records, stop_feeder);
+            } catch (const std::exception& e) {
+                feeder_error = e.what();
+            }
+        });
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    go.store(true);
+    for (std::size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    const double us = elapsed_us(start, std::chrono::steady_clock::now());
+    stop_feeder.store(true);
+    if (feeder.joinable()) {
+        feeder.join();
+    }
+    if (!feeder_error.empty()) {
+        throw std::runtime_error("apply thread failed: " + feeder_error);
+    }
+
+    Row row;
+    row.sync = sync;
+    row.read_pct = read_pct;
+    row.threads = threads;
+    row.applied_batches = applied;
+    row.ms = us / 1000.0;
+    std::vector<double> reads;
+    std::vector<double> writes;
+    for (std::size_t t = 0; t < results.size(); ++t) {
+        if (!results[t].error.empty()) {
+            throw std::runtime_error("worker thread failed: " + results[t].error);
+        }
+        if (results[t].misses != 0) {
+            throw std::runtime_error("read missed a preloaded record");
+        }
+        reads.insert(reads.end(), results[t].read_us.begin(), results[t].read_us.end());
+        writes.insert(writes.end(), results[t].write_us.begin(), results[t].write_us.end());
+    }
+    row.reads = reads.size();
+    row.writes = writes.size();
+    row.read_p50_us = percentile(reads, 0.50);
+    row.read_p99_us = percentile(reads, 0.99);
+    row.write_p50_us = percentile(writes, 0.50);
+    row.write_p99_us = percentile(writes, 0.99);
+    return row;
+}
+
+void run_config(const Scenario& scenario,
+                const std::string& path,
+                const std::string& config,
+                ResultWriter& writer) {
+    cleanup(path);
+    std::shared_ptr<mdbxc::Connection> conn = open_env(path, scenario, config);
+    {
+        BenchEnv env(conn, scenario);
+        preload(env, scenario.records);
+        for (std::size_t s = 0; s < scenario.sync_modes.size(); ++s) {
+            const std::string& sync = scenario.sync_modes[s];
+            if (sync == "capture") {
+                conn->attach_sync_capture(&env.capture);
+            }
+            try {
+                for (std::size_t m = 0; m < scenario.read_percents.size(); ++m) {
+                    for (std::size_t i = 0; i < scenario.threads.size(); ++i) {
+                        Row row = measure_mix(env, scenario, sync,
+                                              scenario.read_percents[m], scenario.threads[i]);
+                        row.config = config;
+                        write_row(writer, scenario, row);
+                    }
+                }
+            } catch (...) {
+                if (sync == "capture") {
+                    conn->detach_sync_capture();
+                }
+                throw;
+            }
+            if (sync == "capture") {
+                conn->detach_sync_capture();
+            }
+        }
+    }
+    conn->disconnect();
+}
+
+void run_scenario(const Scenario& scenario, const std::string& id, ResultWriter& writer) {
+    validate_scenario(scenario);
+    const std::string path = "benchmark_concurrency_" + id + "_" + scenario.name + ".mdbx";
+    CleanupGuard cleanup_guard(path);
+    for (std::size_t i = 0; i < scenario.configs.size(); ++i) {
+        run_config(scenario, path, scenario.configs[i], writer);
+    }
+}
+
+int run(int argc, char** argv) {
+    const CommandLine options = parse_options(argc, argv);
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        validate_scenario(options.scenarios[i]);
+    }
+    const std::string id = run_id();
+    ResultWriter writer(options.format, options.label);
+    writer.begin();
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        run_scenario(options.scenarios[i], id, writer);
+    }
+    writer.end();
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL concurrency_benchmark: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "FAIL concurrency_benchmark: non-std exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,886 @@
+/// \file sync_transport_benchmark.cpp
+/// \brief Manual benchmark for hub-style sync pull/push over real loopback
+/// transports.
+/// \details Runs the \c sync_tick_hub_benchmark presets with the replica
+/// pulling from the primary's listener and pushing every page to its own
+/// listener, so encoding, framing and socket costs are part of the timings.
+/// Each binding is compiled in when its CMake transport option is ON.
+
+#include <mdbx_containers.hpp>
+#include <mdbx_containers/sync.hpp>
+
+#if defined(MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT) && MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT
+#include <mdbx_containers/sync/transports/simple_web/HttpTransport.hpp>
+#if defined(MDBXC_HAS_KURLYK_HTTP_TRANSPORT) && MDBXC_HAS_KURLYK_HTTP_TRANSPORT
+#include <mdbx_containers/sync/transports/kurlyk/HttpTransport.hpp>
+#endif
+#if defined(MDBXC_HAS_CURL_HTTP_TRANSPORT) && MDBXC_HAS_CURL_HTTP_TRANSPORT
+#include <mdbx_containers/sync/transports/curl/HttpTransport.hpp>
+#endif
+#endif
+#if defined(MDBXC_HAS_SIMPLE_WEB_WEBSOCKET_TRANSPORT) && MDBXC_HAS_SIMPLE_WEB_WEBSOCKET_TRANSPORT
+#include <mdbx_containers/sync/transports/simple_web/WebSocketTransport.hpp>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <sys/time.h>
+#endif
+
+#include "../benchmark_common.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::uint64_t default_max_bytes = 4ULL * 1024ULL * 1024ULL;
+const std::uint64_t max_ticks_per_chunk = 1000000ULL;
+const std::size_t tick_payload_bytes = 32;
+const std::chrono::seconds exchange_timeout(60);
+
+struct Scenario {
+    std::string   name;
+    std::uint64_t origins;
+    std::uint64_t historical_chunks_per_origin;
+    std::uint64_t new_chunks_per_origin;
+    std::uint64_t ticks_per_chunk;
+    std::uint64_t max_batches;
+    std::uint64_t max_bytes;
+};
+
+/// \brief Simulated link between the replica and both listeners.
+struct Shaping {
+    std::uint64_t latency_ms = 0;       ///< Added once per request/response exchange.
+    std::uint64_t bandwidth_kbps = 0;   ///< Serialization delay of both bodies; 0 is unlimited.
+};
+
+/// \brief Message bytes seen by one client side, excluding HTTP headers
+/// and WebSocket frame headers.
+struct WireCounters {
+    std::uint64_t exchanges = 0;
+    std::uint64_t request_bytes = 0;
+    std::uint64_t response_bytes = 0;
+};
+
+struct PhaseMetrics {
+    std::string   phase;
+    std::uint64_t chunks_per_origin = 0;
+    std::uint64_t seeded_batches = 0;
+    std::uint64_t pulled_batches = 0;
+    std::uint64_t pull_pages = 0;
+    double        pull_ms = 0.0;
+    double        push_ms = 0.0;
+    double        cpu_ms = 0.0;
+    WireCounters  pull_wire;
+    WireCounters  push_wire;
+};
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+struct CleanupGuard {
+    CleanupGuard(const std::string& primary_value, const std::string& replica_value)
+        : primary(primary_value), replica(replica_value) {}
+
+    ~CleanupGuard() {
+        cleanup(primary);
+        cleanup(replica);
+    }
+
+    std::string primary;
+    std::string replica;
+};
+
+std::string run_id() {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds ticks =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch());
+    return std::to_string(ticks.count());
+}
+
+using mdbxc_bench::parse_u64;
+
+double elapsed_ms(std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point finish) {
+    const std::chrono::microseconds elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(finish - start);
+    return static_cast<double>(elapsed.count()) / 1000.0;
+}
+
+/// \brief User plus system CPU time of the whole process, listener
+/// threads included.
+double process_cpu_ms() {
+#ifdef _WIN32
+    FILETIME creation;
+    FILETIME exit;
+    FILETIME kernel;
+    FILETIME user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    ULARGE_INTEGER k;
+    ULARGE_INTEGER u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return static_cast<double>(k.QuadPart + u.QuadPart) / 10000.0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    const double user_ms = static_cast<double>(usage.ru_utime.tv_sec) * 1000.0 +
+                           static_cast<double>(usage.ru_utime.tv_usec) / 1000.0;
+    const double system_ms = static_cast<double>(usage.ru_stime.tv_sec) * 1000.0 +
+                             static_cast<double>(usage.ru_stime.tv_usec) / 1000.0;
+    return user_ms + system_ms;
+#endif
+}
+
+// --- Scenarios ---
+
+void validate_scenario(const Scenario& scenario) {
+    if (scenario.origins == 0 ||
+        scenario.max_batches == 0 ||
+        scenario.max_bytes == 0) {
+        throw std::runtime_error("origins, max_batches, and max_bytes must be positive");
+    }
+    if (scenario.historical_chunks_per_origin == 0 &&
+        scenario.new_chunks_per_origin == 0) {
+        throw std::runtime_error(
+            "historical_chunks_per_origin and new_chunks_per_origin cannot both be zero");
+    }
+    if (scenario.ticks_per_chunk > max_ticks_per_chunk) {
+        throw std::runtime_error("ticks_per_chunk is too large for this benchmark");
+    }
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    if (scenario.historical_chunks_per_origin > max / 2 - scenario.new_chunks_per_origin ||
+        scenario.origins > max / (scenario.historical_chunks_per_origin +
+                                  scenario.new_chunks_per_origin)) {
+        throw std::runtime_error("batch counts overflow benchmark bounds");
+    }
+}
+
+Scenario make_scenario(const std::string& name,
+                       std::uint64_t origins,
+                       std::uint64_t historical_chunks_per_origin,
+                       std::uint64_t new_chunks_per_origin,
+                       std::uint64_t ticks_per_chunk,
+                       std::uint64_t max_batches) {
+    Scenario scenario;
+    scenario.name = name;
+    scenario.origins = origins;
+    scenario.historical_chunks_per_origin = historical_chunks_per_origin;
+    scenario.new_chunks_per_origin = new_chunks_per_origin;
+    scenario.ticks_per_chunk = ticks_per_chunk;
+    scenario.max_batches = max_batches;
+    scenario.max_bytes = default_max_bytes;
+    return scenario;
+}
+
+/// \brief Same matrix as \c sync_tick_hub_benchmark --preset quick.
+std::vector<Scenario> default_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("one_origin_small_chunks", 1, 512, 64, 16, 64));
+    scenarios.push_back(make_scenario("ten_origins_tick_chunks", 10, 512, 32, 128, 64));
+    scenarios.push_back(make_scenario("hundred_origins_paged", 100, 128, 8, 128, 32));
+    return scenarios;
+}
+
+/// \brief Same matrix as \c sync_tick_hub_benchmark --preset realistic.
+std::vector<Scenario> realistic_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("hub_32_origins_large_history", 32, 2048, 16, 64, 128));
+    scenarios.push_back(make_scenario("hub_128_origins_sparse_hot", 128, 512, 2, 64, 64));
+    scenarios.push_back(make_scenario("hub_256_origins_many_small_chunks", 256, 256, 1, 16, 128));
+    return scenarios;
+}
+
+std::vector<Scenario> preset_scenarios(const std::string& preset) {
+    if (preset == "quick") {
+        return default_scenarios();
+    }
+    if (preset == "realistic") {
+        return realistic_scenarios();
+    }
+    throw std::runtime_error("unknown benchmark preset: " + preset);
+}
+
+/// \brief Transports compiled into this build.
+std::vector<std::string> available_transports() {
+    std::vector<std::string> out;
+#if defined(MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT) && MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT
+    out.push_back("simple_web_http");
+#if defined(MDBXC_HAS_KURLYK_HTTP_TRANSPORT) && MDBXC_HAS_KURLYK_HTTP_TRANSPORT
+    out.push_back("kurlyk_http");
+#endif
+#if defined(MDBXC_HAS_CURL_HTTP_TRANSPORT) && MDBXC_HAS_CURL_HTTP_TRANSPORT
+    out.push_back("curl_http");
+#endif
+#endif
+#if defined(MDBXC_HAS_SIMPLE_WEB_WEBSOCKET_TRANSPORT) && MDBXC_HAS_SIMPLE_WEB_WEBSOCKET_TRANSPORT
+    out.push_back("simple_web_websocket");
+#endif
+    return out;
+}
+
+void print_usage() {
+    std::cout
+        << "usage: sync_transport_benchmark [--transport name|all] [--latency-ms n] "
+        << "[--bandwidth-kbps n]\n"
+        << "           [origins historical_chunks_per_origin new_chunks_per_origin "
+        << "ticks_per_chunk max_batches max_bytes]\n"
+        << "       sync_transport_benchmark [options] --preset quick\n"
+        << "       sync_transport_benchmark [options] --preset realistic\n"
+        << "       sync_transport_benchmark --list-presets\n"
+        << "       sync_transport_benchmark --list-transports\n"
+        << "\n"
+        << "Without scenario arguments, runs the quick built-in scenario matrix\n"
+        << "over every compiled transport. Positional arguments match\n"
+        << "sync_tick_hub_benchmark and default to 16 512 8 128 64 4194304.\n"
+        << "--latency-ms adds a round trip per exchange and --bandwidth-kbps\n"
+        << "delays each exchange by its body size; both default to 0 (off).\n";
+}
+
+struct CommandLine {
+    std::vector<std::string> transports;
+    Shaping shaping;
+    std::vector<Scenario> scenarios;
+};
+
+CommandLine parse_options(int argc, char** argv) {
+    CommandLine options;
+    std::string transport = "all";
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--transport" || arg == "--latency-ms" || arg == "--bandwidth-kbps") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error(arg + " expects a value");
+            }
+            const char* value = argv[++i];
+            if (arg == "--transport") {
+                transport = value;
+            } else if (arg == "--latency-ms") {
+                options.shaping.latency_ms = parse_u64(value, "latency_ms");
+            } else {
+                options.shaping.bandwidth_kbps = parse_u64(value, "bandwidth_kbps");
+            }
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    const std::vector<std::string> available = available_transports();
+    if (!args.empty() && args[0] == "--list-transports") {
+        for (std::size_t i = 0; i < available.size(); ++i) {
+            std::cout << available[i] << '\n';
+        }
+        std::exit(0);
+    }
+    if (available.empty()) {
+        throw std::runtime_error(
+            "no transport compiled in; enable MDBXC_SIMPLE_WEB_HTTP_TRANSPORT or "
+            "MDBXC_SIMPLE_WEB_WEBSOCKET_TRANSPORT");
+    }
+    if (transport == "all") {
+        options.transports = available;
+    } else {
+        for (std::size_t i = 0; i < available.size(); ++i) {
+            if (available[i] == transport) {
+                options.transports.push_back(transport);
+            }
+        }
+        if (options.transports.empty()) {
+            throw std::runtime_error("transport not compiled in: " + transport);
+        }
+    }
+
+    std::string preset;
+    if (mdbxc_bench::select_preset(args, print_usage, preset)) {
+        options.scenarios = preset_scenarios(preset);
+        return options;
+    }
+    const std::string& first = args[0];
+    if (first[0] == '-') {
+        throw std::runtime_error("unknown option: " + first);
+    }
+    if (args.size() > 6) {
+        throw std::runtime_error("too many positional arguments");
+    }
+    Scenario scenario = make_scenario(
+        "custom",
+        parse_u64(args[0].c_str(), "origins"),
+        args.size() > 1 ? parse_u64(args[1].c_str(), "historical_chunks_per_origin") : 512,
+        args.size() > 2 ? parse_u64(args[2].c_str(), "new_chunks_per_origin") : 8,
+        args.size() > 3 ? parse_u64(args[3].c_str(), "ticks_per_chunk") : 128,
+        args.size() > 4 ? parse_u64(args[4].c_str(), "max_batches") : 64);
+    if (args.size() > 5) {
+        scenario.max_bytes = parse_u64(args[5].c_str(), "max_bytes");
+    }
+    options.scenarios.push_back(scenario);
+    return options;
+}
+
+// --- Shaped clients ---
+
+void shape_exchange(const Shaping& shaping, std::uint64_t bytes) {
+    std::chrono::microseconds delay(static_cast<std::int64_t>(shaping.latency_ms * 1000));
+    if (shaping.bandwidth_kbps != 0) {
+        delay += std::chrono::microseconds(
+            static_cast<std::int64_t>(bytes * 8ULL * 1000ULL / shaping.bandwidth_kbps));
+    }
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+}
+
+/// \brief Counts message bytes of an HTTP client and applies \c Shaping.
+class ShapedHttpClient : public mdbxc::sync::IHttpSyncClient {
+public:
+    ShapedHttpClient(mdbxc::sync::IHttpSyncClient& next,
+                     const Shaping& shaping,
+                     WireCounters& counters)
+        : m_next(next), m_shaping(shaping), m_counters(counters) {}
+
+    mdbxc::sync::HttpSyncResponse post(
+            const std::string& target,
+            const std::string& content_type,
+            const std::vector<std::uint8_t>& body,
+            const mdbxc::sync::CancellationToken& cancel_token) override {
+        mdbxc::sync::HttpSyncResponse response =
+            m_next.post(target, content_type, body, cancel_token);
+        const std::uint64_t bytes = body.size() + response.body.size();
+        ++m_counters.exchanges;
+        m_counters.request_bytes += body.size();
+        m_counters.response_bytes += response.body.size();
+        shape_exchange(m_shaping, bytes);
+        return response;
+    }
+
+    void request_cancel() override {
+        m_next.request_cancel();
+    }
+
+private:
+    mdbxc::sync::IHttpSyncClient& m_next;
+    Shaping m_shaping;
+    WireCounters& m_counters;
+};
+
+/// \brief Counts message bytes of a WebSocket channel and applies \c Shaping.
+class ShapedWebSocketChannel : public mdbxc::sync::IWebSocketSyncChannel {
+public:
+    ShapedWebSocketChannel(mdbxc::sync::IWebSocketSyncChannel& next,
+                           const Shaping& shaping,
+                           WireCounters& counters)
+        : m_next(next), m_shaping(shaping), m_counters(counters) {}
+
+    std::vector<std::uint8_t> exchange_binary(
+            const std::vector<std::uint8_t>& binary_message,
+            const mdbxc::sync::CancellationToken& cancel_token) override {
+        std::vector<std::uint8_t> response =
+            m_next.exchange_binary(binary_message, cancel_token);
+        ++m_counters.exchanges;
+        m_counters.request_bytes += binary_message.size();
+        m_counters.response_bytes += response.size();
+        shape_exchange(m_shaping, binary_message.size() + response.size());
+        return response;
+    }
+
+    void request_cancel() override {
+        m_next.request_cancel();
+    }
+
+    mdbxc::sync::SyncTransportRetryHint last_retry_hint() const override {
+        return m_next.last_retry_hint();
+    }
+
+private:
+    mdbxc::sync::IWebSocketSyncChannel& m_next;
+    Shaping m_shaping;
+    WireCounters& m_counters;
+};
+
+// --- Transport sessions ---
+
+/// \brief Listeners of both engines plus the replica-side peers that
+/// reach them.
+class TransportSession {
+public:
+    virtual ~TransportSession() {}
+
+    /// \brief Peer whose pulls reach the primary engine.
+    virtual mdbxc::sync::ISyncPeer& pull_peer() = 0;
+    /// \brief Peer whose pushes reach the replica engine.
+    virtual mdbxc::sync::ISyncPeer& push_peer() = 0;
+
+    WireCounters pull_wire;
+    WireCounters push_wire;
+};
+
+#if defined(MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT) && MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT
+
+typedef std::unique_ptr<mdbxc::sync::IHttpSyncClient> (*HttpClientFactory)(std::uint16_t port);
+
+std::unique_ptr<mdbxc::sync::IHttpSyncClient> make_simple_web_client(std::uint16_t port) {
+    mdbxc::sync::simple_web::HttpSyncClientConfig config;
+    config.host = "127.0.0.1";
+    config.port = port;
+    config.timeout = exchange_timeout;
+    return std::unique_ptr<mdbxc::sync::IHttpSyncClient>(
+        new mdbxc::sync::simple_web::HttpSyncClient(config));
+}
+
+#if defined(MDBXC_HAS_KURLYK_HTTP_TRANSPORT) && MDBXC_HAS_KURLYK_HTTP_TRANSPORT
+std::unique_ptr<mdbxc::sync::IHttpSyncClient> make_kurlyk_client(std::uint16_t port) {
+    mdbxc::sync::kurlyk::HttpSyncClientConfig config;
+    config.base_url = "http://127.0.0.1:" + std::to_string(static_cast<unsigned>(port));
+    return std::unique_ptr<mdbxc::sync::IHttpSyncClient>(
+        new mdbxc::sync::kurlyk::HttpSyncClient(config));
+}
+#endif
+
+#if defined(MDBXC_HAS_CURL_HTTP_TRANSPORT) && MDBXC_HAS_CURL_HTTP_TRANSPORT
+std::unique_ptr<mdbxc::sync::IHttpSyncClient> make_curl_client(std::uint16_t port) {
+    mdbxc::sync::curl::HttpSyncClientConfig config;
+    config.base_url = "http://127.0.0.1:" + std::to_string(static_cast<unsigned>(port));
+    // The Simple-Web listener speaks HTTP/1.1 only.
+    config.http_version = mdbxc::sync::curl::HttpVersion::Http1_1;
+    config.request_timeout =
+        std::chrono::duration_cast<std::chrono::milliseconds>(exchange_timeout);
+    return std::unique_ptr<mdbxc::sync::IHttpSyncClient>(
+        new mdbxc::sync::curl::HttpSyncClient(config));
+}
+#endif
+
+/// \brief Simple-Web HTTP listeners with clients made by a factory.
+class HttpSession : public TransportSession {
+public:
+    HttpSession(mdbxc::sync::SyncEngine& primary,
+                mdbxc::sync::SyncEngine& replica,
+                HttpClientFactory make_client,
+                const Shaping& shaping)
+        : m_pull_server(primary),
+          m_push_server(replica) {
+        mdbxc::sync::simple_web::HttpSyncListenerConfig config;
+        config.host = "127.0.0.1";
+        config.port = 0;
+        m_pull_listener.reset(
+            new mdbxc::sync::simple_web::HttpSyncListener(m_pull_server, config));
+        m_push_listener.reset(
+            new mdbxc::sync::simple_web::HttpSyncListener(m_push_server, config));
+        m_pull_listener->start();
+        m_push_listener->start();
+
+        m_pull_client = make_client(m_pull_listener->port());
+        m_push_client = make_client(m_push_listener->port());
+        m_pull_shaped.reset(new ShapedHttpClient(*m_pull_client, shaping, pull_wire));
+        m_push_shaped.reset(new ShapedHttpClient(*m_push_client, shaping, push_wire));
+        m_pull_peer.reset(new mdbxc::sync::HttpSyncPeer(*m_pull_shaped));
+        m_push_peer.reset(new mdbxc::sync::HttpSyncPeer(*m_push_shaped));
+    }
+
+    ~HttpSession() {
+        m_pull_listener->stop();
+        m_push_listener->stop();
+    }
+
+    mdbxc::sync::ISyncPeer& pull_peer() override { return *m_pull_peer; }
+    mdbxc::sync::ISyncPeer& push_peer() override { return *m_push_peer; }
+
+private:
+    mdbxc::sync::HttpSyncServer m_pull_server;
+    mdbxc::sync::HttpSyncServer m_push_server;
+    std::unique_ptr<mdbxc::sync::simple_web::HttpSyncListener> m_pull_listener;
+    std::unique_ptr<mdbxc::sync::simple_web::HttpSyncListener> m_push_listener;
+    std::unique_ptr<mdbxc::sync::IHttpSyncClient> m_pull_client;
+    std::unique_ptr<mdbxc::sync::IHttpSyncClient> m_push_client;
+    std::unique_ptr<ShapedHttpClient> m_pull_shaped;
+    std::unique_ptr<ShapedHttpClient> m_push_shaped;
+    std::unique_ptr<mdbxc::sync::HttpSyncPeer> m_pull_peer;
+    std::unique_ptr<mdbxc::sync::HttpSyncPeer> m_push_peer;
+};
+
+#endif
+
+#if defined(MDBXC_HAS_SIMPLE_WEB_WEBSOCKET_TRANSPORT) && MDBXC_HAS_SIMPLE_WEB_WEBSOCKET_TRANSPORT
+
+/// \brief Simple-WebSocket listeners with one persistent channel each.
+class WebSocketSession : public TransportSession {
+public:
+    WebSocketSession(mdbxc::sync::SyncEngine& primary,
+                     mdbxc::sync::SyncEngine& replica,
+                     const Shaping& shaping)
+        : m_pull_server(primary),
+          m_push_server(replica),
+          m_pull_middleware(m_pull_server),
+          m_push_middleware(m_push_server) {
+        mdbxc::sync::simple_web::WebSocketSyncListenerConfig config;
+        config.host = "127.0.0.1";
+        config.port = 0;
+        m_pull_listener.reset(
+            new mdbxc::sync::simple_web::WebSocketSyncListener(m_pull_middleware, config));
+        m_push_listener.reset(
+            new mdbxc::sync::simple_web::WebSocketSyncListener(m_push_middleware, config));
+        m_pull_listener->start();
+        m_push_listener->start();
+
+        mdbxc::sync::simple_web::WebSocketSyncChannelConfig channel;
+        channel.host = "127.0.0.1";
+        channel.exchange_timeout = exchange_timeout;
+        channel.port = m_pull_listener->port();
+        m_pull_channel.reset(new mdbxc::sync::simple_web::PersistentWebSocketSyncChannel(channel));
+        channel.port = m_push_listener->port();
+        m_push_channel.reset(new mdbxc::sync::simple_web::PersistentWebSocketSyncChannel(channel));
+        m_pull_shaped.reset(new ShapedWebSocketChannel(*m_pull_channel, shaping, pull_wire));
+        m_push_shaped.reset(new ShapedWebSocketChannel(*m_push_channel, shaping, push_wire));
+        m_pull_peer.reset(new mdbxc::sync::WebSocketSyncPeer(*m_pull_shaped));
+        m_push_peer.reset(new mdbxc::sync::WebSocketSyncPeer(*m_push_shaped));
+    }
+
+    ~WebSocketSession() {
+        m_pull_channel.reset();
+        m_push_channel.reset();
+        m_pull_listener->stop();
+        m_push_listener->stop();
+    }
+
+    mdbxc::sync::ISyncPeer& pull_peer() override { return *m_pull_peer; }
+    mdbxc::sync::ISyncPeer& push_peer() override { return *m_push_peer; }
+
+private:
+    mdbxc::sync::WebSocketSyncServer m_pull_server;
+    mdbxc::sync::WebSocketSyncServer m_push_server;
+    mdbxc::sync::WebSocketSyncServerMiddleware m_pull_middleware;
+    mdbxc::sync::WebSocketSyncServerMiddleware m_push_middleware;
+    std::unique_ptr<mdbxc::sync::simple_web::WebSocketSyncListener> m_pull_listener;
+    std::unique_ptr<mdbxc::sync::simple_web::WebSocketSyncListener> m_push_listener;
+    std::unique_ptr<mdbxc::sync::simple_web::PersistentWebSocketSyncChannel> m_pull_channel;
+    std::unique_ptr<mdbxc::sync::simple_web::PersistentWebSocketSyncChannel> m_push_channel;
+    std::unique_ptr<ShapedWebSocketChannel> m_pull_shaped;
+    std::unique_ptr<ShapedWebSocketChannel> m_push_shaped;
+    std::unique_ptr<mdbxc::sync::WebSocketSyncPeer> m_pull_peer;
+    std::unique_ptr<mdbxc::sync::WebSocketSyncPeer> m_push_peer;
+};
+
+#endif
+
+std::unique_ptr<TransportSession> make_session(const std::string& transport,
+                                               mdbxc::sync::SyncEngine& primary,
+                                               mdbxc::sync::SyncEngine& replica,
+                                               const Shaping& shaping) {
+    std::unique_ptr<TransportSession> session;
+#if defined(MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT) && MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT
+    if (transport == "simple_web_http") {
+        session.reset(new HttpSession(primary, replica, &make_simple_web_client, shaping));
+    }
+#if defined(MDBXC_HAS_KURLYK_HTTP_TRANSPORT) && MDBXC_HAS_KURLYK_HTTP_TRANSPORT
+    if (transport == "kurlyk_http") {
+        session.reset(new HttpSession(primary, replica, &make_kurlyk_client, shaping));
+    }
+#endif
+#if defined(MDBXC_HAS_CURL_HTTP_TRANSPORT) && MDBXC_HAS_CURL_HTTP_TRANSPORT
+    if (transport == "curl_http") {
+        session.reset(new HttpSession(primary, replica, &make_curl_client, shaping));
+    }
+#endif
+#endif
+#if defined(MDBXC_HAS_SIMPLE_WEB_WEBSOCKET_TRANSPORT) && MDBXC_HAS_SIMPLE_WEB_WEBSOCKET_TRANSPORT
+    if (transport == "simple_web_websocket") {
+        session.reset(new WebSocketSession(primary, replica, shaping));
+    }
+#endif
+    (void)primary;
+    (void)replica;
+    (void)shaping;
+    if (!session) {
+        throw std::runtime_error("transport not compiled in: " + transport);
+    }
+    return session;
+}
+
+// --- Workload ---
+
+mdbxc::sync::NodeId make_node(std::uint8_t seed) {
+    mdbxc::sync::NodeId node{};
+    for (int i = 0; i < 16; ++i) {
+        node[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return node;
+}
+
+mdbxc::sync::NodeId make_origin(std::uint64_t index) {
+    mdbxc::sync::NodeId node{};
+    node[0] = 0x40;
+    for (int i = 0; i < 8; ++i) {
+        node[8 + i] = static_cast<std::uint8_t>((index >> ((7 - i) * 8)) & 0xff);
+    }
+    return node;
+}
+
+mdbxc::sync::ChangeBatch make_tick_batch(std::uint64_t origin_index,
+                                         const mdbxc::sync::NodeId& origin,
+                                         std::uint64_t seq,
+                                         std::uint64_t ticks_per_chunk) {
+    mdbxc::sync::ChangeBatch batch;
+    batch.origin_node_id = origin;
+    batch.seq = seq;
+    batch.time_unix_ns = seq;
+
+    mdbxc::sync::ChangeOp op;
+    op.op_type = mdbxc::sync::ChangeOpType::Put;
+    op.dbi_name = "tick_chunks";
+    op.storage_key.resize(16);
+    for (int i = 0; i < 8; ++i) {
+        op.storage_key[i] = static_cast<std::uint8_t>((origin_index >> ((7 - i) * 8)) & 0xff);
+        op.storage_key[8 + i] = static_cast<std::uint8_t>((seq >> ((7 - i) * 8)) & 0xff);
+    }
+    op.value.resize(static_cast<std::size_t>(ticks_per_chunk) * tick_payload_bytes);
+    for (std::size_t i = 0; i < op.value.size(); ++i) {
+        op.value[i] = static_cast<std::uint8_t>(
+            (origin_index * 131ULL + seq * 17ULL + i) & 0xff);
+    }
+    batch.ops.push_back(op);
+    return batch;
+}
+
+std::uint64_t append_changelog_range(const std::shared_ptr<mdbxc::Connection>& conn,
+                                     const Scenario& scenario,
+                                     std::uint64_t first_seq,
+                                     std::uint64_t chunks_per_origin) {
+    if (chunks_per_origin == 0) {
+        return 0;
+    }
+    mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+    mdbxc::sync::ChangeLogStore log(conn->env_handle());
+    log.open(txn.handle());
+    for (std::uint64_t origin_index = 0; origin_index < scenario.origins; ++origin_index) {
+        const mdbxc::sync::NodeId origin = make_origin(origin_index);
+        for (std::uint64_t seq = first_seq; seq < first_seq + chunks_per_origin; ++seq) {
+            log.append(txn.handle(), origin, seq,
+                       mdbxc::sync::ChangeBatchCodec::encode(
+                           make_tick_batch(origin_index, origin, seq, scenario.ticks_per_chunk)));
+        }
+    }
+    txn.commit();
+    return scenario.origins * chunks_per_origin;
+}
+
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path) {
+    mdbxc::Config config;
+    config.pathname = path;
+    config.max_dbs = 16;
+    config.no_subdir = true;
+    config.size_now = 512LL * 1024LL * 1024LL;
+    config.size_upper = 16LL * 1024LL * 1024LL * 1024LL;
+    return mdbxc::Connection::create(config);
+}
+
+// --- Measurements ---
+
+/// \brief Pulls pages from the primary and pushes each to the replica,
+/// both through \p session, until the primary reports no more.
+PhaseMetrics pull_and_push(TransportSession& session,
+                           mdbxc::sync::SyncEngine& primary_engine,
+                           mdbxc::sync::SyncEngine& replica_engine,
+                           const Scenario& scenario,
+                           const mdbxc::sync::NodeId& db_id) {
+    const WireCounters pull_before = session.pull_wire;
+    const WireCounters push_before = session.push_wire;
+    const double cpu_before = process_cpu_ms();
+
+    mdbxc::sync::PullRequest request;
+    request.requester = replica_engine.local_node_id();
+    request.db_id = db_id;
+    request.have = replica_engine.applied_cursor();
+    request.max_batches = scenario.max_batches;
+    request.max_bytes = scenario.max_bytes;
+
+    PhaseMetrics metrics;
+    bool has_more = false;
+    do {
+        const std::chrono::steady_clock::time_point pull_start =
+            std::chrono::steady_clock::now();
+        const mdbxc::sync::PullResponse response = session.pull_peer().pull(request);
+        const std::chrono::steady_clock::time_point pull_finish =
+            std::chrono::steady_clock::now();
+        metrics.pull_ms += elapsed_ms(pull_start, pull_finish);
+        if (!response.ok) {
+            throw std::runtime_error("pull failed: " + response.error);
+        }
+        ++metrics.pull_pages;
+        metrics.pulled_batches += static_cast<std::uint64_t>(response.batches.size());
+
+        if (!response.batches.empty()) {
+            mdbxc::sync::PushRequest push;
+            push.sender = primary_engine.local_node_id();
+            push.db_id = db_id;
+            push.batches = response.batches;
+            const std::chrono::steady_clock::time_point push_start =
+                std::chrono::steady_clock::now();
+            const mdbxc::sync::PushResponse pushed = session.push_peer().push(push);
+            metrics.push_ms += elapsed_ms(push_start, std::chrono::steady_clock::now());
+            if (!pushed.ok) {
+                throw std::runtime_error("push failed: " + pushed.error);
+            }
+            request.have = pushed.receiver_have;
+        } else if (response.has_more) {
+            throw std::runtime_error("pull reported has_more without batches");
+        }
+        has_more = response.has_more;
+    } while (has_more);
+
+    metrics.cpu_ms = process_cpu_ms() - cpu_before;
+    metrics.pull_wire.exchanges = session.pull_wire.exchanges - pull_before.exchanges;
+    metrics.pull_wire.request_bytes = session.pull_wire.request_bytes - pull_before.request_bytes;
+    metrics.pull_wire.response_bytes = session.pull_wire.response_bytes - pull_before.response_bytes;
+    metrics.push_wire.exchanges = session.push_wire.exchanges - push_before.exchanges;
+    metrics.push_wire.request_bytes = session.push_wire.request_bytes - push_before.request_bytes;
+    metrics.push_wire.response_bytes = session.push_wire.response_bytes - push_before.response_bytes;
+    return metrics;
+}
+
+void print_csv_header() {
+    std::cout
+        << "scenario,transport,phase,origins,chunks_per_origin,ticks_per_chunk,"
+        << "max_batches,max_bytes,latency_ms,bandwidth_kbps,seeded_batches,"
+        << "pulled_batches,pull_pages,pull_ms,push_ms,sync_ms,batches_per_sec,"
+        << "pull_request_bytes,pull_response_bytes,push_request_bytes,"
+        << "push_response_bytes,wire_bytes_per_batch,cpu_ms,cpu_us_per_batch\n";
+}
+
+void print_csv_row(const Scenario& scenario,
+                   const std::string& transport,
+                   const Shaping& shaping,
+                   const PhaseMetrics& metrics) {
+    const double sync_ms = metrics.pull_ms + metrics.push_ms;
+    const double batches = static_cast<double>(metrics.pulled_batches);
+    const double wire_bytes = static_cast<double>(
+        metrics.pull_wire.request_bytes + metrics.pull_wire.response_bytes +
+        metrics.push_wire.request_bytes + metrics.push_wire.response_bytes);
+    std::cout << scenario.name << ','
+              << transport << ','
+              << metrics.phase << ','
+              << scenario.origins << ','
+              << metrics.chunks_per_origin << ','
+              << scenario.ticks_per_chunk << ','
+              << scenario.max_batches << ','
+              << scenario.max_bytes << ','
+              << shaping.latency_ms << ','
+              << shaping.bandwidth_kbps << ','
+              << metrics.seeded_batches << ','
+              << metrics.pulled_batches << ','
+              << metrics.pull_pages << ','
+              << metrics.pull_ms << ','
+              << metrics.push_ms << ','
+              << sync_ms << ','
+              << (sync_ms <= 0.0 ? 0.0 : batches * 1000.0 / sync_ms) << ','
+              << metrics.pull_wire.request_bytes << ','
+              << metrics.pull_wire.response_bytes << ','
+              << metrics.push_wire.request_bytes << ','
+              << metrics.push_wire.response_bytes << ','
+              << (batches <= 0.0 ? 0.0 : wire_bytes / batches) << ','
+              << metrics.cpu_ms << ','
+              << (batches <= 0.0 ? 0.0 : metrics.cpu_ms * 1000.0 / batches) << '\n';
+    std::cout.flush();
+}
+
+void run_scenario(const Scenario& scenario,
+                  const std::string& transport,
+                  const Shaping& shaping,
+                  const std::string& id) {
+    validate_scenario(scenario);
+    const std::string prefix =
+        "benchmark_sync_transport_" + id + "_" + scenario.name + "_" + transport;
+    const std::string primary_path = prefix + "_primary.mdbx";
+    const std::string replica_path = prefix + "_replica.mdbx";
+    CleanupGuard cleanup_guard(primary_path, replica_path);
+    cleanup(primary_path);
+    cleanup(replica_path);
+
+    std::shared_ptr<mdbxc::Connection> primary_conn = open_env(primary_path);
+    std::shared_ptr<mdbxc::Connection> replica_conn = open_env(replica_path);
+    const mdbxc::sync::NodeId db_id = make_node(0xD0);
+    {
+        mdbxc::sync::SyncEngine primary_engine(primary_conn);
+        mdbxc::sync::SyncEngine replica_engine(replica_conn);
+        primary_engine.initialize_local_identity(make_node(0xA0), db_id);
+        replica_engine.initialize_local_identity(make_node(0xB0), db_id);
+        std::unique_ptr<TransportSession> session =
+            make_session(transport, primary_engine, replica_engine, shaping);
+
+        const std::uint64_t historical_seeded =
+            append_changelog_range(primary_conn, scenario, 1,
+                                   scenario.historical_chunks_per_origin);
+        PhaseMetrics full = pull_and_push(*session, primary_engine, replica_engine,
+                                          scenario, db_id);
+        full.phase = "full_cold_replica";
+        full.chunks_per_origin = scenario.historical_chunks_per_origin;
+        full.seeded_batches = historical_seeded;
+        print_csv_row(scenario, transport, shaping, full);
+
+        const std::uint64_t hot_seeded =
+            append_changelog_range(primary_conn, scenario,
+                                   scenario.historical_chunks_per_origin + 1,
+                                   scenario.new_chunks_per_origin);
+        PhaseMetrics hot = pull_and_push(*session, primary_engine, replica_engine,
+                                         scenario, db_id);
+        hot.phase = "incremental_hot";
+        hot.chunks_per_origin = scenario.new_chunks_per_origin;
+        hot.seeded_batches = hot_seeded;
+        print_csv_row(scenario, transport, shaping, hot);
+
+        if (full.pulled_batches != historical_seeded || hot.pulled_batches != hot_seeded) {
+            throw std::runtime_error("pulled batch count does not match seeded batches");
+        }
+    }
+    primary_conn->disconnect();
+    replica_conn->disconnect();
+}
+
+int run(int argc, char** argv) {
+    const CommandLine options = parse_options(argc, argv);
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        validate_scenario(options.scenarios[i]);
+    }
+    const std::string id = run_id();
+    print_csv_header();
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        for (std::size_t t = 0; t < options.transports.size(); ++t) {
+            run_scenario(options.scenarios[i], options.transports[t], options.shaping, id);
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL sync_transport_benchmark: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "FAIL sync_transport_benchmark: non-std exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,552 @@
+/// \file startup_benchmark.cpp
+/// \brief Manual benchmark of how quickly a node comes back after a restart.
+/// \details A node database is seeded once per scenario with key-value
+/// tables and a VectorStore collection, then closed. Each measured restart
+/// opens the connection, constructs the table wrappers (DBI opens) and the
+/// VectorStore (index load), runs \c VectorStore::rebuild_index(),
+/// reconstructs the SyncEngine and pulls the batches a still-running hub
+/// wrote meanwhile, as \c incremental_after_restart does in
+/// sync_tick_hub_benchmark. Cold rows evict the node file from the OS page
+/// cache before the restart; warm rows restart right after another one.
+
+#include <mdbx_containers.hpp>
+#include <mdbx_containers/sync.hpp>
+
+#include "benchmark_common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const std::uint64_t preload_batch = 1000;
+const std::size_t min_value_bytes = 8;
+const std::size_t max_value_bytes = 1024 * 1024;
+const std::uint64_t max_tables = 64;
+const std::uint64_t max_dim = 4096;
+const std::uint64_t max_restarts = 100;
+const std::uint64_t pull_max_batches = 1000;
+const std::uint64_t pull_max_bytes = 4ULL * 1024ULL * 1024ULL;
+
+struct Scenario {
+    std::string   name;
+    std::uint64_t records;      ///< Key-value records, spread over \c tables.
+    std::uint64_t tables;
+    std::uint64_t value_bytes;
+    std::uint64_t vectors;      ///< VectorStore rows; 0 skips the store.
+    std::uint64_t dim;
+    std::uint64_t new_batches;  ///< Hub batches written before each restart.
+    std::uint64_t restarts;     ///< Restarts per cache state.
+};
+
+struct Paths {
+    std::string node;
+    std::string hub;
+};
+
+struct Row {
+    std::string   cache;        ///< cold or warm.
+    std::uint64_t run = 0;
+    std::uint64_t db_bytes = 0;
+    std::uint64_t applied_batches = 0;
+    double        connect_ms = 0.0;
+    double        open_tables_ms = 0.0;
+    double        vector_open_ms = 0.0;
+    double        rebuild_index_ms = 0.0;
+    double        engine_ms = 0.0;
+    double        first_round_ms = 0.0;
+};
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+struct CleanupGuard {
+    explicit CleanupGuard(const Paths& paths_value) : paths(paths_value) {}
+
+    ~CleanupGuard() {
+        cleanup(paths.node);
+        cleanup(paths.hub);
+    }
+
+    Paths paths;
+};
+
+std::string run_id() {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds ticks =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch());
+    return std::to_string(ticks.count());
+}
+
+using mdbxc_bench::parse_u64;
+
+double elapsed_ms(std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point finish) {
+    const std::chrono::nanoseconds elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start);
+    return static_cast<double>(elapsed.count()) / 1000000.0;
+}
+
+/// \brief Drops the clean pages of \p path from the OS page cache.
+/// \return \c false where this is not supported.
+bool evict_page_cache(const std::string& path) {
+#if defined(__linux__)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    // Dirty pages cannot be dropped; flush them first.
+    ::fsync(fd);
+    const int rc = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+    return rc == 0;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+// --- Scenarios ---
+
+void validate_scenario(const Scenario& scenario) {
+    if (scenario.tables == 0 || scenario.tables > max_tables) {
+        throw std::runtime_error("tables must be in [1, 64]");
+    }
+    if (scenario.value_bytes < min_value_bytes || scenario.value_bytes > max_value_bytes) {
+        throw std::runtime_error("value_bytes must be in [8, 1048576]");
+    }
+    if (scenario.vectors != 0 && (scenario.dim == 0 || scenario.dim > max_dim)) {
+        throw std::runtime_error("dim must be in [1, 4096]");
+    }
+    if (scenario.new_batches == 0) {
+        throw std::runtime_error("new_batches must be positive");
+    }
+    if (scenario.restarts == 0 || scenario.restarts > max_restarts) {
+        throw std::runtime_error("restarts must be in [1, 100]");
+    }
+}
+
+Scenario make_scenario(const std::string& name,
+                       std::uint64_t records,
+                       std::uint64_t tables,
+                       std::uint64_t value_bytes,
+                       std::uint64_t vectors,
+                       std::uint64_t dim,
+                       std::uint64_t new_batches,
+                       std::uint64_t restarts) {
+    Scenario scenario;
+    scenario.name = name;
+    scenario.records = records;
+    scenario.tables = tables;
+    scenario.value_bytes = value_bytes;
+    scenario.vectors = vectors;
+    scenario.dim = dim;
+    scenario.new_batches = new_batches;
+    scenario.restarts = restarts;
+    return scenario;
+}
+
+std::vector<Scenario> default_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("kv_10k", 10000, 8, 128, 1000, 64, 100, 3));
+    scenarios.push_back(make_scenario("kv_100k", 100000, 8, 128, 10000, 64, 1000, 3));
+    return scenarios;
+}
+
+std::vector<Scenario> realistic_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("kv_100k", 100000, 16, 256, 10000, 384, 10000, 3));
+    scenarios.push_back(make_scenario("kv_1m", 1000000, 16, 256, 50000, 384, 10000, 3));
+    scenarios.push_back(make_scenario("kv_4m", 4000000, 16, 256, 100000, 384, 10000, 3));
+    return scenarios;
+}
+
+std::vector<Scenario> preset_scenarios(const std::string& preset) {
+    if (preset == "quick") {
+        return default_scenarios();
+    }
+    if (preset == "realistic") {
+        return realistic_scenarios();
+    }
+    throw std::runtime_error("unknown benchmark preset: " + preset);
+}
+
+void print_usage() {
+    mdbxc_bench::print_usage(
+        "startup_benchmark",
+        "[records tables value_bytes vectors dim new_batches restarts]",
+        "Without scenario arguments, runs the quick built-in scenarios.\n"
+        "records is required; the other positional arguments are optional\n"
+        "from left to right and default to 8 128 10000 64 1000 3. Each\n"
+        "scenario seeds a node database, then restarts it restarts times\n"
+        "with a cold and with a warm page cache, after new_batches hub\n"
+        "writes each time.\n");
+}
+
+struct CommandLine {
+    std::string format = "csv";
+    std::string label;
+    std::vector<Scenario> scenarios;
+};
+
+CommandLine parse_options(int argc, char** argv) {
+    CommandLine options;
+    const std::vector<std::string> args =
+        mdbxc_bench::split_output_options(argc, argv, options.format, options.label);
+    std::string preset;
+    if (mdbxc_bench::select_preset(args, print_usage, preset)) {
+        options.scenarios = preset_scenarios(preset);
+        return options;
+    }
+    const std::string& first = args[0];
+    if (first[0] == '-') {
+        throw std::runtime_error("unknown option: " + first);
+    }
+    if (args.size() > 7) {
+        throw std::runtime_error("too many positional arguments");
+    }
+    const std::uint64_t records = parse_u64(args[0].c_str(), "records");
+    const std::uint64_t tables = args.size() > 1 ? parse_u64(args[1].c_str(), "tables") : 8;
+    const std::uint64_t value_bytes = args.size() > 2 ? parse_u64(args[2].c_str(), "value_bytes") : 128;
+    const std::uint64_t vectors = args.size() > 3 ? parse_u64(args[3].c_str(), "vectors") : 10000;
+    const std::uint64_t dim = args.size() > 4 ? parse_u64(args[4].c_str(), "dim") : 64;
+    const std::uint64_t new_batches = args.size() > 5 ? parse_u64(args[5].c_str(), "new_batches") : 1000;
+    const std::uint64_t restarts = args.size() > 6 ? parse_u64(args[6].c_str(), "restarts") : 3;
+    options.scenarios.push_back(make_scenario("custom", records, tables, value_bytes,
+                                              vectors, dim, new_batches, restarts));
+    return options;
+}
+
+// --- Output ---
+
+using mdbxc_bench::ResultWriter;
+
+void write_row(ResultWriter& writer, const Scenario& scenario, const Row& row) {
+    const double total_ms = row.connect_ms + row.open_tables_ms + row.vector_open_ms +
+                            row.rebuild_index_ms + row.engine_ms + row.first_round_ms;
+    writer.begin_row()
+        .text("scenario", scenario.name)
+        .text("cache", row.cache)
+        .number("run", row.run)
+        .number("records", scenario.records)
+        .number("tables", scenario.tables)
+        .number("value_bytes", scenario.value_bytes)
+        .number("vectors", scenario.vectors)
+        .number("dim", scenario.dim)
+        .number("db_bytes", row.db_bytes)
+        .number("new_batches", scenario.new_batches)
+        .number("applied_batches", row.applied_batches)
+        .number("connect_ms", row.connect_ms)
+        .number("open_tables_ms", row.open_tables_ms)
+        .number("vector_open_ms", row.vector_open_ms)
+        .number("rebuild_index_ms", row.rebuild_index_ms)
+        .number("engine_ms", row.engine_ms)
+        .number("first_round_ms", row.first_round_ms)
+        .number("total_ms", total_ms)
+        .end_row();
+}
+
+// --- Environment ---
+
+mdbxc::sync::NodeId make_node(std::uint8_t seed) {
+    mdbxc::sync::NodeId node{};
+    for (int i = 0; i < 16; ++i) {
+        node[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return node;
+}
+
+/// \brief Value of seed \p seed; its first 8 bytes keep values distinct.
+std::string make_value(std::size_t size, std::uint64_t seed) {
+    std::string out(size, 'v');
+    for (std::size_t i = 0; i < 8; ++i) {
+        out[i] = static_cast<char>((seed >> (56 - 8 * i)) & 0xFF);
+    }
+    return out;
+}
+
+std::string table_name(std::uint64_t index) {
+    return "t" + std::to_string(index);
+}
+
+/// \brief Opens the node durably, so its file has no dirty pages to keep
+/// in the cache, or the hub without syncs.
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path,
+                                            const Scenario& scenario,
+                                            bool durable) {
+    mdbxc::Config config;
+    config.pathname = path;
+    config.max_dbs = static_cast<std::int64_t>(scenario.tables) + 32;
+    config.no_subdir = true;
+    config.size_now = 256LL * 1024LL * 1024LL;
+    config.size_upper = 64LL * 1024LL * 1024LL * 1024LL;
+    if (!durable) {
+        config.sync_mode = mdbxc::SyncMode::UtterlyNoSync;
+    }
+    return mdbxc::Connection::create(config);
+}
+
+std::uint64_t used_database_bytes(const std::shared_ptr<mdbxc::Connection>& conn) {
+    MDBX_envinfo info;
+    std::memset(&info, 0, sizeof(info));
+    mdbxc::check_mdbx(
+        mdbx_env_info_ex(conn->env_handle(), nullptr, &info, sizeof(info)),
+        "startup_benchmark: failed to read MDBX env info");
+    return (static_cast<std::uint64_t>(info.mi_last_pgno) + 1) *
+           static_cast<std::uint64_t>(info.mi_dxb_pagesize);
+}
+
+typedef mdbxc::KeyValueTable<std::uint64_t, std::string> BenchTable;
+
+/// \brief Writes the records and vectors of \p scenario to the node.
+void seed_node(const std::shared_ptr<mdbxc::Connection>& conn, const Scenario& scenario) {
+    std::vector<std::unique_ptr<BenchTable> > tables;
+    for (std::uint64_t t = 0; t < scenario.tables; ++t) {
+        tables.push_back(std::unique_ptr<BenchTable>(new BenchTable(conn, table_name(t))));
+    }
+    const std::size_t value_bytes = static_cast<std::size_t>(scenario.value_bytes);
+    for (std::uint64_t offset = 0; offset < scenario.records; offset += preload_batch) {
+        const std::uint64_t end = std::min(scenario.records, offset + preload_batch);
+        mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        for (std::uint64_t i = offset; i < end; ++i) {
+            tables[static_cast<std::size_t>(i % scenario.tables)]->insert_or_assign(
+                i, make_value(value_bytes, i), txn);
+        }
+        txn.commit();
+    }
+    if (scenario.vectors == 0) {
+        return;
+    }
+    mdbxc::VectorStore store(conn, "docs");
+    std::mt19937 rng(42);
+    std::normal_distribution<float> component(0.0f, 1.0f);
+    for (std::uint64_t offset = 0; offset < scenario.vectors; offset += preload_batch) {
+        const std::uint64_t end = std::min(scenario.vectors, offset + preload_batch);
+        std::vector<mdbxc::VectorRecord> batch(static_cast<std::size_t>(end - offset));
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            batch[i].embedding.dim = static_cast<std::uint32_t>(scenario.dim);
+            batch[i].embedding.values.resize(static_cast<std::size_t>(scenario.dim));
+            for (std::size_t d = 0; d < batch[i].embedding.values.size(); ++d) {
+                batch[i].embedding.values[d] = component(rng);
+            }
+            batch[i].text = "doc " + std::to_string(offset + i);
+        }
+        store.add_batch(batch);
+    }
+}
+
+/// \brief Writes \p count one-record batches on the hub through capture.
+void write_hub_batches(const std::shared_ptr<mdbxc::Connection>& hub,
+                       BenchTable& table,
+                       mdbxc::sync::ThreadLocalChangeAccumulator& capture,
+                       const Scenario& scenario,
+                       std::uint64_t& next_key) {
+    mdbxc::sync::SyncCaptureScope scope(hub, capture);
+    const std::size_t value_bytes = static_cast<std::size_t>(scenario.value_bytes);
+    for (std::uint64_t i = 0; i < scenario.new_batches; ++i) {
+        table.insert_or_assign(next_key, make_value(value_bytes, next_key));
+        ++next_key;
+    }
+}
+
+/// \brief Pulls every page the node misses from \p hub_engine and applies it.
+/// \return Applied batches.
+std::uint64_t pull_and_apply(mdbxc::sync::SyncEngine& hub_engine,
+                             mdbxc::sync::SyncEngine& node_engine,
+                             const mdbxc::sync::NodeId& node_id,
+                             const mdbxc::sync::NodeId& db_id) {
+    mdbxc::sync::DirectSyncPeer peer(&hub_engine);
+    mdbxc::sync::PullRequest request;
+    request.requester = node_id;
+    request.db_id = db_id;
+    request.have = node_engine.applied_cursor();
+    request.max_batches = pull_max_batches;
+    request.max_bytes = pull_max_bytes;
+
+    std::uint64_t applied = 0;
+    bool has_more = false;
+    do {
+        const mdbxc::sync::PullResponse response = peer.pull(request);
+        if (!response.ok) {
+            throw std::runtime_error("pull failed: " + response.error);
+        }
+        if (!response.batches.empty()) {
+            mdbxc::sync::PushRequest push;
+            push.sender = hub_engine.local_node_id();
+            push.db_id = db_id;
+            push.batches = response.batches;
+            const mdbxc::sync::PushResponse pushed = node_engine.handle_push(push);
+            if (!pushed.ok) {
+                throw std::runtime_error("apply failed: " + pushed.error);
+            }
+            applied += static_cast<std::uint64_t>(response.batches.size());
+        } else if (response.has_more) {
+            throw std::runtime_error("pull reported has_more without batches");
+        }
+        has_more = response.has_more;
+        request.have = node_engine.applied_cursor();
+    } while (has_more);
+    return applied;
+}
+
+// --- Measurements ---
+
+/// \brief Restarts the node and times each startup step.
+Row measure_restart(const Paths& paths,
+                    const Scenario& scenario,
+                    mdbxc::sync::SyncEngine& hub_engine,
+                    const mdbxc::sync::NodeId& node_id,
+                    const mdbxc::sync::NodeId& db_id) {
+    Row row;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::shared_ptr<mdbxc::Connection> conn = open_env(paths.node, scenario, true);
+    std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+    row.connect_ms = elapsed_ms(start, finish);
+    {
+        start = std::chrono::steady_clock::now();
+        std::vector<std::unique_ptr<BenchTable> > tables;
+        for (std::uint64_t t = 0; t < scenario.tables; ++t) {
+            tables.push_back(std::unique_ptr<BenchTable>(new BenchTable(conn, table_name(t))));
+        }
+        BenchTable hub_table(conn, "hub");
+        finish = std::chrono::steady_clock::now();
+        row.open_tables_ms = elapsed_ms(start, finish);
+
+        std::unique_ptr<mdbxc::VectorStore> store;
+        if (scenario.vectors != 0) {
+            start = std::chrono::steady_clock::now();
+            store.reset(new mdbxc::VectorStore(conn, "docs"));
+            finish = std::chrono::steady_clock::now();
+            row.vector_open_ms = elapsed_ms(start, finish);
+
+            start = std::chrono::steady_clock::now();
+            if (!store->rebuild_index()) {
+                throw std::runtime_error("rebuild_index did not run");
+            }
+            finish = std::chrono::steady_clock::now();
+            row.rebuild_index_ms = elapsed_ms(start, finish);
+        }
+
+        start = std::chrono::steady_clock::now();
+        mdbxc::sync::SyncEngine engine(conn);
+        engine.initialize_local_identity(node_id, db_id);
+        finish = std::chrono::steady_clock::now();
+        row.engine_ms = elapsed_ms(start, finish);
+
+        start = std::chrono::steady_clock::now();
+        row.applied_batches = pull_and_apply(hub_engine, engine, node_id, db_id);
+        finish = std::chrono::steady_clock::now();
+        row.first_round_ms = elapsed_ms(start, finish);
+        if (row.applied_batches != scenario.new_batches) {
+            throw std::runtime_error("first round applied " +
+                                     std::to_string(row.applied_batches) + " batches, expected " +
+                                     std::to_string(scenario.new_batches));
+        }
+        row.db_bytes = used_database_bytes(conn);
+    }
+    conn->disconnect();
+    return row;
+}
+
+void run_scenario(const Scenario& scenario,
+                  const std::string& id,
+                  bool& cold_warned,
+                  ResultWriter& writer) {
+    validate_scenario(scenario);
+    Paths paths;
+    paths.node = "benchmark_startup_" + id + "_" + scenario.name + "_node.mdbx";
+    paths.hub = "benchmark_startup_" + id + "_" + scenario.name + "_hub.mdbx";
+    CleanupGuard cleanup_guard(paths);
+    cleanup(paths.node);
+    cleanup(paths.hub);
+
+    const mdbxc::sync::NodeId node_id = make_node(0xA0);
+    const mdbxc::sync::NodeId hub_id = make_node(0xB0);
+    const mdbxc::sync::NodeId db_id = make_node(0xD0);
+    {
+        std::shared_ptr<mdbxc::Connection> node = open_env(paths.node, scenario, true);
+        {
+            mdbxc::sync::SyncEngine engine(node);
+            engine.initialize_local_identity(node_id, db_id);
+            seed_node(node, scenario);
+        }
+        node->disconnect();
+    }
+
+    std::shared_ptr<mdbxc::Connection> hub = open_env(paths.hub, scenario, false);
+    {
+        mdbxc::sync::SyncEngine hub_engine(hub);
+        hub_engine.initialize_local_identity(hub_id, db_id);
+        mdbxc::sync::ThreadLocalChangeAccumulator capture(hub);
+        BenchTable hub_table(hub, "hub");
+        std::uint64_t next_key = 0;
+        for (std::uint64_t run = 0; run < scenario.restarts; ++run) {
+            // The cold restart loads the pages the warm one then finds cached.
+            for (int cold = 1; cold >= 0; --cold) {
+                if (cold != 0 && !evict_page_cache(paths.node)) {
+                    if (!cold_warned) {
+                        std::cerr << "startup_benchmark: page cache eviction is not "
+                                  << "supported here; skipping cold rows\n";
+                        cold_warned = true;
+                    }
+                    continue;
+                }
+                write_hub_batches(hub, hub_table, capture, scenario, next_key);
+                Row row = measure_restart(paths, scenario, hub_engine, node_id, db_id);
+                row.cache = cold != 0 ? "cold" : "warm";
+                row.run = run;
+                write_row(writer, scenario, row);
+            }
+        }
+    }
+    hub->disconnect();
+}
+
+int run(int argc, char** argv) {
+    const CommandLine options = parse_options(argc, argv);
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        validate_scenario(options.scenarios[i]);
+    }
+    const std::string id = run_id();
+    ResultWriter writer(options.format, options.label);
+    bool cold_warned = false;
+    writer.begin();
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        run_scenario(options.scenarios[i], id, cold_warned, writer);
+    }
+    writer.end();
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL startup_benchmark: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "FAIL startup_benchmark: non-std exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,938 @@
+/// \file sync_fleet_benchmark.cpp
+/// \brief Manual benchmark of one hub serving many concurrent replicas.
+/// \details Every replica has its own environment and a background
+/// SyncWorker pulling from the hub through DirectSyncPeer, so all pulls run
+/// concurrently on the hub's SyncEngine. Optional writer threads keep
+/// appending origin chunks to the hub while the fleet pulls. Rows report hub
+/// CPU spent serving pulls, the pull latency distribution, per-replica lag
+/// and catch-up time, and how evenly origins progress across the fleet.
+
+#include <mdbx_containers.hpp>
+#include <mdbx_containers/sync.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+#include "benchmark_common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::uint64_t default_max_bytes = 4ULL * 1024ULL * 1024ULL;
+const std::uint64_t max_ticks_per_chunk = 1000000ULL;
+const std::uint64_t max_replicas = 4096;
+const std::size_t tick_payload_bytes = 32;
+const std::chrono::milliseconds sample_interval(50);
+const std::chrono::minutes catch_up_timeout(30);
+
+struct Scenario {
+    std::string   name;
+    std::uint64_t replicas;
+    std::uint64_t origins;
+    std::uint64_t historical_chunks_per_origin;
+    std::uint64_t writers;          ///< Origin writer threads; 0 skips the write phase.
+    std::uint64_t write_rate;       ///< Chunks per second over all writers.
+    std::uint64_t write_seconds;
+    std::uint64_t ticks_per_chunk;
+    std::uint64_t max_batches;
+    std::uint64_t max_bytes;
+    std::uint64_t poll_ms;          ///< SyncWorkerOptions::idle_interval.
+};
+
+struct Row {
+    std::string   phase;
+    std::uint64_t target_batches = 0;   ///< Batches every replica has to apply.
+    std::uint64_t written_batches = 0;
+    double        ms = 0.0;
+    double        drain_ms = 0.0;
+    std::uint64_t pulls = 0;
+    std::uint64_t empty_pulls = 0;
+    std::uint64_t pulled_batches = 0;
+    double        pull_p50_us = 0.0;
+    double        pull_p90_us = 0.0;
+    double        pull_p99_us = 0.0;
+    double        pull_max_us = 0.0;
+    double        hub_pull_cpu_ms = 0.0;
+    double        cpu_ms = 0.0;
+    double        catch_up_p50_ms = 0.0;
+    double        catch_up_p99_ms = 0.0;
+    double        catch_up_max_ms = 0.0;
+    double        lag_p50_batches = 0.0;
+    double        lag_p99_batches = 0.0;
+    double        lag_max_batches = 0.0;
+    double        origin_lag_max_batches = 0.0;
+    double        origin_fairness_min = 1.0;
+};
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+struct CleanupGuard {
+    ~CleanupGuard() {
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            cleanup(paths[i]);
+        }
+    }
+
+    std::vector<std::string> paths;
+};
+
+std::string run_id() {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds ticks =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch());
+    return std::to_string(ticks.count());
+}
+
+using mdbxc_bench::parse_u64;
+using mdbxc_bench::percentile;
+
+double elapsed_ms(std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point finish) {
+    const std::chrono::microseconds elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(finish - start);
+    return static_cast<double>(elapsed.count()) / 1000.0;
+}
+
+/// \brief User plus system CPU time of the whole process.
+double process_cpu_ms() {
+#ifdef _WIN32
+    FILETIME creation;
+    FILETIME exit;
+    FILETIME kernel;
+    FILETIME user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    ULARGE_INTEGER k;
+    ULARGE_INTEGER u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return static_cast<double>(k.QuadPart + u.QuadPart) / 10000.0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    const double user_ms = static_cast<double>(usage.ru_utime.tv_sec) * 1000.0 +
+                           static_cast<double>(usage.ru_utime.tv_usec) / 1000.0;
+    const double system_ms = static_cast<double>(usage.ru_stime.tv_sec) * 1000.0 +
+                             static_cast<double>(usage.ru_stime.tv_usec) / 1000.0;
+    return user_ms + system_ms;
+#endif
+}
+
+/// \brief CPU time of the calling thread in microseconds.
+double thread_cpu_us() {
+#ifdef _WIN32
+    FILETIME creation;
+    FILETIME exit;
+    FILETIME kernel;
+    FILETIME user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    ULARGE_INTEGER k;
+    ULARGE_INTEGER u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return static_cast<double>(k.QuadPart + u.QuadPart) / 10.0;
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(ts.tv_sec) * 1000000.0 +
+           static_cast<double>(ts.tv_nsec) / 1000.0;
+#endif
+}
+
+// --- Scenarios ---
+
+void validate_scenario(const Scenario& scenario) {
+    if (scenario.replicas == 0 || scenario.replicas > max_replicas) {
+        throw std::runtime_error("replicas must be in [1, 4096]");
+    }
+    if (scenario.origins == 0 ||
+        scenario.max_batches == 0 ||
+        scenario.max_bytes == 0) {
+        throw std::runtime_error("origins, max_batches, and max_bytes must be positive");
+    }
+    if (scenario.historical_chunks_per_origin == 0 && scenario.writers == 0) {
+        throw std::runtime_error(
+            "historical_chunks_per_origin and writers cannot both be zero");
+    }
+    if (scenario.writers > scenario.origins) {
+        throw std::runtime_error("writers must not exceed origins");
+    }
+    if (scenario.writers != 0 &&
+        (scenario.write_rate == 0 || scenario.write_seconds == 0)) {
+        throw std::runtime_error("write_rate and write_seconds must be positive with writers");
+    }
+    if (scenario.ticks_per_chunk > max_ticks_per_chunk) {
+        throw std::runtime_error("ticks_per_chunk is too large for this benchmark");
+    }
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    if (scenario.origins > max / (scenario.historical_chunks_per_origin + 1) ||
+        scenario.write_rate > max / (scenario.write_seconds + 1)) {
+        throw std::runtime_error("batch counts overflow benchmark bounds");
+    }
+}
+
+Scenario make_scenario(const std::string& name,
+                       std::uint64_t replicas,
+                       std::uint64_t origins,
+                       std::uint64_t historical_chunks_per_origin,
+                       std::uint64_t writers,
+                       std::uint64_t write_rate,
+                       std::uint64_t write_seconds,
+                       std::uint64_t ticks_per_chunk,
+                       std::uint64_t max_batches) {
+    Scenario scenario;
+    scenario.name = name;
+    scenario.replicas = replicas;
+    scenario.origins = origins;
+    scenario.historical_chunks_per_origin = historical_chunks_per_origin;
+    scenario.writers = writers;
+    scenario.write_rate = write_rate;
+    scenario.write_seconds = write_seconds;
+    scenario.ticks_per_chunk = ticks_per_chunk;
+    scenario.max_batches = max_batches;
+    scenario.max_bytes = default_max_bytes;
+    scenario.poll_ms = 50;
+    return scenario;
+}
+
+std::vector<Scenario> default_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("fleet_16_replicas", 16, 32, 64, 4, 1000, 3, 64, 64));
+    scenarios.push_back(make_scenario("fleet_64_replicas", 64, 64, 32, 4, 2000, 3, 16, 64));
+    return scenarios;
+}
+
+std::vector<Scenario> realistic_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("fleet_500_small_pages", 500, 100, 32, 8, 1000, 5, 16, 64));
+    scenarios.push_back(make_scenario("fleet_500_large_pages", 500, 100, 32, 8, 1000, 5, 16, 512));
+    return scenarios;
+}
+
+std::vector<Scenario> preset_scenarios(const std::string& preset) {
+    if (preset == "quick") {
+        return default_scenarios();
+    }
+    if (preset == "realistic") {
+        return realistic_scenarios();
+    }
+    throw std::runtime_error("unknown benchmark preset: " + preset);
+}
+
+void print_usage() {
+    mdbxc_bench::print_usage(
+        "sync_fleet_benchmark",
+        "\n           [replicas origins historical_chunks_per_origin writers "
+        "write_rate write_seconds\n"
+        "            ticks_per_chunk max_batches max_bytes poll_ms]",
+        "Without scenario arguments, runs the quick built-in scenarios.\n"
+        "Positional arguments are optional from left to right and default to\n"
+        "64 32 64 4 2000 5 128 64 4194304 50. Each replica runs a SyncWorker\n"
+        "against the hub; writers append write_rate chunks per second to the\n"
+        "hub for write_seconds while the fleet keeps pulling.\n");
+}
+
+struct CommandLine {
+    std::string format = "csv";
+    std::string label;
+    std::vector<Scenario> scenarios;
+};
+
+CommandLine parse_options(int argc, char** argv) {
+    CommandLine options;
+    const std::vector<std::string> args =
+        mdbxc_bench::split_output_options(argc, argv, options.format, options.label);
+    std::string preset;
+    if (mdbxc_bench::select_preset(args, print_usage, preset)) {
+        options.scenarios = preset_scenarios(preset);
+        return options;
+    }
+    const std::string& first = args[0];
+    if (first[0] == '-') {
+        throw std::runtime_error("unknown option: " + first);
+    }
+    if (args.size() > 10) {
+        throw std::runtime_error("too many positional arguments");
+    }
+    Scenario scenario = make_scenario(
+        "custom",
+        parse_u64(args[0].c_str(), "replicas"),
+        args.size() > 1 ? parse_u64(args[1].c_str(), "origins") : 32,
+        args.size() > 2 ? parse_u64(args[2].c_str(), "historical_chunks_per_origin") : 64,
+        args.size() > 3 ? parse_u64(args[3].c_str(), "writers") : 4,
+        args.size() > 4 ? parse_u64(args[4].c_str(), "write_rate") : 2000,
+        args.size() > 5 ? parse_u64(args[5].c_str(), "write_seconds") : 5,
+        args.size() > 6 ? parse_u64(args[6].c_str(), "ticks_per_chunk") : 128,
+        args.size() > 7 ? parse_u64(args[7].c_str(), "max_batches") : 64);
+    if (args.size() > 8) {
+        scenario.max_bytes = parse_u64(args[8].c_str(), "max_bytes");
+    }
+    if (args.size() > 9) {
+        scenario.poll_ms = parse_u64(args[9].c_str(), "poll_ms");
+    }
+    options.scenarios.push_back(scenario);
+    return options;
+}
+
+// --- Output ---
+
+using mdbxc_bench::ResultWriter;
+
+void write_row(ResultWriter& writer, const Scenario& scenario, const Row& row) {
+    const double hub_cpu_per_batch = row.pulled_batches == 0
+        ? 0.0
+        : row.hub_pull_cpu_ms * 1000.0 / static_cast<double>(row.pulled_batches);
+    writer.begin_row()
+        .text("scenario", scenario.name)
+        .text("phase", row.phase)
+        .number("replicas", scenario.replicas)
+        .number("origins", scenario.origins)
+        .number("writers", scenario.writers)
+        .number("write_rate", scenario.write_rate)
+        .number("poll_ms", scenario.poll_ms)
+        .number("max_batches", scenario.max_batches)
+        .number("max_bytes", scenario.max_bytes)
+        .number("target_batches", row.target_batches)
+        .number("written_batches", row.written_batches)
+        .number("ms", row.ms)
+        .number("drain_ms", row.drain_ms)
+        .number("pulls", row.pulls)
+        .number("empty_pulls", row.empty_pulls)
+        .number("pulled_batches", row.pulled_batches)
+        .number("pull_p50_us", row.pull_p50_us)
+        .number("pull_p90_us", row.pull_p90_us)
+        .number("pull_p99_us", row.pull_p99_us)
+        .number("pull_max_us", row.pull_max_us)
+        .number("hub_pull_cpu_ms", row.hub_pull_cpu_ms)
+        .number("hub_cpu_us_per_batch", hub_cpu_per_batch)
+        .number("cpu_ms", row.cpu_ms)
+        .number("catch_up_p50_ms", row.catch_up_p50_ms)
+        .number("catch_up_p99_ms", row.catch_up_p99_ms)
+        .number("catch_up_max_ms", row.catch_up_max_ms)
+        .number("lag_p50_batches", row.lag_p50_batches)
+        .number("lag_p99_batches", row.lag_p99_batches)
+        .number("lag_max_batches", row.lag_max_batches)
+        .number("origin_lag_max_batches", row.origin_lag_max_batches)
+        .number("origin_fairness_min", row.origin_fairness_min)
+        .end_row();
+}
+
+// --- Environment ---
+
+mdbxc::sync::NodeId make_node(std::uint8_t prefix, std::uint64_t index) {
+    mdbxc::sync::NodeId node{};
+    node[0] = prefix;
+    for (int i = 0; i < 8; ++i) {
+        node[8 + i] = static_cast<std::uint8_t>((index >> ((7 - i) * 8)) & 0xff);
+    }
+    return node;
+}
+
+const std::uint8_t origin_prefix = 0x40;
+const std::uint8_t hub_prefix = 0xA0;
+const std::uint8_t replica_prefix = 0xB0;
+const std::uint8_t db_prefix = 0xD0;
+
+/// \brief Origin index encoded by \c make_node(origin_prefix, index), or
+/// \p origins when \p node is not an origin of this run.
+std::uint64_t origin_index(const mdbxc::sync::NodeId& node, std::uint64_t origins) {
+    if (node[0] != origin_prefix) {
+        return origins;
+    }
+    std::uint64_t index = 0;
+    for (int i = 0; i < 8; ++i) {
+        index = (index << 8) | node[8 + i];
+    }
+    return index < origins ? index : origins;
+}
+
+mdbxc::sync::ChangeBatch make_tick_batch(std::uint64_t origin,
+                                         std::uint64_t seq,
+                                         std::uint64_t ticks_per_chunk) {
+    mdbxc::sync::ChangeBatch batch;
+    batch.origin_node_id = make_node(origin_prefix, origin);
+    batch.seq = seq;
+    batch.time_unix_ns = seq;
+
+    mdbxc::sync::ChangeOp op;
+    op.op_type = mdbxc::sync::ChangeOpType::Put;
+    op.dbi_name = "tick_chunks";
+    op.storage_key.resize(16);
+    for (int i = 0; i < 8; ++i) {
+        op.storage_key[i] = static_cast<std::uint8_t>((origin >> ((7 - i) * 8)) & 0xff);
+        op.storage_key[8 + i] = static_cast<std::uint8_t>((seq >> ((7 - i) * 8)) & 0xff);
+    }
+    op.value.resize(static_cast<std::size_t>(ticks_per_chunk) * tick_payload_bytes);
+    for (std::size_t i = 0; i < op.value.size(); ++i) {
+        op.value[i] = static_cast<std::uint8_t>((origin * 131ULL + seq * 17ULL + i) & 0xff);
+    }
+    batch.ops.push_back(op);
+    return batch;
+}
+
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path,
+                                            std::int64_t size_now,
+                                            std::int64_t max_readers) {
+    mdbxc::Config config;
+    config.pathname = path;
+    config.max_dbs = 16;
+    config.no_subdir = true;
+    config.size_now = size_now;
+    config.size_upper = 16LL * 1024LL * 1024LL * 1024LL;
+    config.max_readers = max_readers;
+    // The fleet measures hub pull work and lag, not fsync of hundreds of
+    // replica files.
+    config.sync_mode = mdbxc::SyncMode::UtterlyNoSync;
+    return mdbxc::Connection::create(config);
+}
+
+/// \brief Forwards pulls to the hub and records their wall time and the
+/// hub CPU they used.
+/// \details \c DirectSyncPeer runs \c handle_pull() on the calling worker
+/// thread, so that thread's CPU time across the call is hub work. Only the
+/// owning worker thread touches the counters while the worker runs.
+class TimedPeer : public mdbxc::sync::ISyncPeer {
+public:
+    explicit TimedPeer(mdbxc::sync::SyncEngine* hub) : m_hub(hub) {}
+
+    mdbxc::sync::PullResponse pull(const mdbxc::sync::PullRequest& request) override {
+        const double cpu_start = thread_cpu_us();
+        const std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        mdbxc::sync::PullResponse response = m_hub.pull(request);
+        const std::chrono::steady_clock::time_point finish =
+            std::chrono::steady_clock::now();
+        cpu_us += thread_cpu_us() - cpu_start;
+        latencies_us.push_back(elapsed_ms(start, finish) * 1000.0);
+        const std::size_t batches = response.batches.size() + response.encoded_batches.size();
+        pulled_batches += batches;
+        if (batches == 0) {
+            ++empty_pulls;
+        }
+        return response;
+    }
+
+    mdbxc::sync::PushResponse push(const mdbxc::sync::PushRequest& request) override {
+        return m_hub.push(request);
+    }
+
+    void reset() {
+        latencies_us.clear();
+        cpu_us = 0.0;
+        pulled_batches = 0;
+        empty_pulls = 0;
+    }
+
+    std::vector<double> latencies_us;
+    double        cpu_us = 0.0;
+    std::uint64_t pulled_batches = 0;
+    std::uint64_t empty_pulls = 0;
+
+private:
+    mdbxc::sync::DirectSyncPeer m_hub;
+};
+
+/// \brief Tracks one replica's applied cursor from worker page events.
+class ReplicaProgress : public mdbxc::sync::ISyncWorkerObserver {
+public:
+    ReplicaProgress(std::uint64_t origins, const std::atomic<std::uint64_t>& target)
+        : m_target(target), m_seq(static_cast<std::size_t>(origins), 0) {}
+
+    void on_sync_worker_page_applied(const mdbxc::sync::SyncWorkerPageEvent& event) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const mdbxc::sync::OriginSeqMap& seqs = event.applied_cursor.last_seq_by_origin;
+        std::uint64_t total = 0;
+        for (mdbxc::sync::OriginSeqMap::const_iterator it = seqs.begin(); it != seqs.end(); ++it) {
+            const std::uint64_t index = origin_index(it->first, m_seq.size());
+            if (index < m_seq.size()) {
+                m_seq[static_cast<std::size_t>(index)] = it->second;
+                total += it->second;
+            }
+        }
+        m_total = total;
+        mark_if_caught_up_locked();
+    }
+
+    /// \brief Starts a phase; catch-up is measured against \c target later.
+    void begin_phase() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_caught_up = false;
+    }
+
+    /// \brief Records the catch-up time if the replica already reached the
+    /// target before its next page.
+    void check_caught_up() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        mark_if_caught_up_locked();
+    }
+
+    bool caught_up(std::chrono::steady_clock::time_point& at) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        at = m_caught_up_at;
+        return m_caught_up;
+    }
+
+    void copy_seq(std::vector<std::uint64_t>& out) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        out = m_seq;
+    }
+
+private:
+    void mark_if_caught_up_locked() {
+        if (!m_caught_up && m_total >= m_target.load(std::memory_order_acquire)) {
+            m_caught_up = true;
+            m_caught_up_at = std::chrono::steady_clock::now();
+        }
+    }
+
+    const std::atomic<std::uint64_t>& m_target;
+    mutable std::mutex m_mutex;
+    std::vector<std::uint64_t> m_seq;
+    std::uint64_t m_total = 0;
+    bool m_caught_up = false;
+    std::chrono::steady_clock::time_point m_caught_up_at;
+};
+
+struct Replica {
+    std::shared_ptr<mdbxc::Connection> conn;
+    std::unique_ptr<mdbxc::sync::SyncEngine> engine;
+    std::unique_ptr<TimedPeer> peer;
+    std::unique_ptr<ReplicaProgress> progress;
+    std::unique_ptr<mdbxc::sync::SyncWorker> worker;
+};
+
+/// \brief Hub environment, origin tails and the replica fleet of one scenario.
+struct Fleet {
+    std::shared_ptr<mdbxc::Connection> hub_conn;
+    std::unique_ptr<mdbxc::sync::SyncEngine> hub;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> tails;  ///< Committed hub seq per origin.
+    std::atomic<std::uint64_t> target{std::numeric_limits<std::uint64_t>::max()};
+    std::vector<std::unique_ptr<Replica>> replicas;
+};
+
+void append_chunk(Fleet& fleet, const Scenario& scenario,
+                  std::uint64_t origin, std::uint64_t seq) {
+    mdbxc::Transaction txn = fleet.hub_conn->transaction(mdbxc::TransactionMode::WRITABLE);
+    mdbxc::sync::ChangeLogStore log(fleet.hub_conn->env_handle());
+    log.open(txn.handle());
+    log.append(txn.handle(), make_node(origin_prefix, origin), seq,
+               mdbxc::sync::ChangeBatchCodec::encode(
+                   make_tick_batch(origin, seq, scenario.ticks_per_chunk)));
+    txn.commit();
+    fleet.tails[static_cast<std::size_t>(origin)].store(seq, std::memory_order_release);
+}
+
+void seed_history(Fleet& fleet, const Scenario& scenario) {
+    if (scenario.historical_chunks_per_origin == 0) {
+        return;
+    }
+    mdbxc::Transaction txn = fleet.hub_conn->transaction(mdbxc::TransactionMode::WRITABLE);
+    mdbxc::sync::ChangeLogStore log(fleet.hub_conn->env_handle());
+    log.open(txn.handle());
+    for (std::uint64_t origin = 0; origin < scenario.origins; ++origin) {
+        const mdbxc::sync::NodeId node = make_node(origin_prefix, origin);
+        for (std::uint64_t seq = 1; seq <= scenario.historical_chunks_per_origin; ++seq) {
+            log.append(txn.handle(), node, seq,
+                       mdbxc::sync::ChangeBatchCodec::encode(
+                           make_tick_batch(origin, seq, scenario.ticks_per_chunk)));
+        }
+    }
+    txn.commit();
+    for (std::uint64_t origin = 0; origin < scenario.origins; ++origin) {
+        fleet.tails[static_cast<std::size_t>(origin)].store(
+            scenario.historical_chunks_per_origin, std::memory_order_release);
+    }
+}
+
+std::uint64_t tails_total(const Fleet& fleet, const Scenario& scenario) {
+    std::uint64_t total = 0;
+    for (std::uint64_t origin = 0; origin < scenario.origins; ++origin) {
+        total += fleet.tails[static_cast<std::size_t>(origin)].load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+void open_fleet(Fleet& fleet, const Scenario& scenario,
+                const std::string& prefix, CleanupGuard& guard) {
+    const mdbxc::sync::NodeId db_id = make_node(db_prefix, 0);
+    const std::string hub_path = prefix + "_hub.mdbx";
+    guard.paths.push_back(hub_path);
+    cleanup(hub_path);
+    fleet.hub_conn = open_env(hub_path, 256LL * 1024LL * 1024LL,
+                              static_cast<std::int64_t>(scenario.replicas + scenario.writers + 16));
+    fleet.hub.reset(new mdbxc::sync::SyncEngine(fleet.hub_conn));
+    fleet.hub->initialize_local_identity(make_node(hub_prefix, 0), db_id);
+    fleet.tails.reset(new std::atomic<std::uint64_t>[static_cast<std::size_t>(scenario.origins)]);
+    for (std::uint64_t origin = 0; origin < scenario.origins; ++origin) {
+        fleet.tails[static_cast<std::size_t>(origin)].store(0);
+    }
+
+    for (std::uint64_t i = 0; i < scenario.replicas; ++i) {
+        const std::string path = prefix + "_replica_" + std::to_string(i) + ".mdbx";
+        guard.paths.push_back(path);
+        cleanup(path);
+        std::unique_ptr<Replica> replica(new Replica());
+        replica->conn = open_env(path, 16LL * 1024LL * 1024LL, 0);
+        replica->engine.reset(new mdbxc::sync::SyncEngine(replica->conn));
+        replica->engine->initialize_local_identity(make_node(replica_prefix, i), db_id);
+        replica->peer.reset(new TimedPeer(fleet.hub.get()));
+        replica->progress.reset(new ReplicaProgress(scenario.origins, fleet.target));
+        fleet.replicas.push_back(std::move(replica));
+    }
+}
+
+void close_fleet(Fleet& fleet) {
+    for (std::size_t i = 0; i < fleet.replicas.size(); ++i) {
+        fleet.replicas[i]->worker.reset();
+        fleet.replicas[i]->engine.reset();
+        fleet.replicas[i]->conn->disconnect();
+    }
+    fleet.replicas.clear();
+    fleet.hub.reset();
+    if (fleet.hub_conn) {
+        fleet.hub_conn->disconnect();
+    }
+}
+
+// --- Measurements ---
+
+/// \brief Samples replica lag and origin fairness while a phase runs.
+class LagSampler {
+public:
+    /// \brief Takes the fleet's lowest applied seq per origin as the point
+    /// fairness is measured from.
+    LagSampler(const Fleet& fleet, const Scenario& scenario)
+        : m_fleet(fleet), m_scenario(scenario) {
+        m_base.assign(static_cast<std::size_t>(scenario.origins),
+                      std::numeric_limits<std::uint64_t>::max());
+        std::vector<std::uint64_t> seq;
+        for (std::size_t r = 0; r < fleet.replicas.size(); ++r) {
+            fleet.replicas[r]->progress->copy_seq(seq);
+            for (std::size_t o = 0; o < m_base.size(); ++o) {
+                m_base[o] = std::min(m_base[o], seq[o]);
+            }
+        }
+    }
+
+    ~LagSampler() {
+        stop();
+    }
+
+    void start() {
+        m_stop = false;
+        m_thread = std::thread([this]() {
+            while (!m_stop.load()) {
+                sample();
+                std::this_thread::sleep_for(sample_interval);
+            }
+        });
+    }
+
+    void stop() {
+        m_stop = true;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void fill(Row& row) const {
+        row.lag_p50_batches = percentile(m_lags, 0.50);
+        row.lag_p99_batches = percentile(m_lags, 0.99);
+        row.lag_max_batches = m_lags.empty() ? 0.0 : *std::max_element(m_lags.begin(), m_lags.end());
+        row.origin_lag_max_batches = m_origin_lag_max;
+        row.origin_fairness_min = m_fairness_min;
+    }
+
+private:
+    void sample() {
+        const std::size_t origins = static_cast<std::size_t>(m_scenario.origins);
+        std::vector<std::uint64_t> tails(origins);
+        std::uint64_t tail_total = 0;
+        for (std::size_t o = 0; o < origins; ++o) {
+            tails[o] = m_fleet.tails[o].load(std::memory_order_acquire);
+            tail_total += tails[o];
+        }
+        std::vector<double> origin_lag(origins, 0.0);
+        std::vector<std::uint64_t> seq;
+        for (std::size_t r = 0; r < m_fleet.replicas.size(); ++r) {
+            m_fleet.replicas[r]->progress->copy_seq(seq);
+            std::uint64_t applied = 0;
+            for (std::size_t o = 0; o < origins; ++o) {
+                const std::uint64_t s = std::min(seq[o], tails[o]);
+                applied += s;
+                origin_lag[o] += static_cast<double>(tails[o] - s);
+            }
+            m_lags.push_back(static_cast<double>(tail_total - applied));
+        }
+        // Jain's index over the share of new chunks the fleet applied per
+        // origin: 1 when every origin progresses alike.
+        const double replicas = static_cast<double>(m_fleet.replicas.size());
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        std::size_t active = 0;
+        for (std::size_t o = 0; o < origins; ++o) {
+            origin_lag[o] /= replicas;
+            m_origin_lag_max = std::max(m_origin_lag_max, origin_lag[o]);
+            if (tails[o] <= m_base[o]) {
+                continue;
+            }
+            const double fresh = static_cast<double>(tails[o] - m_base[o]);
+            const double share = 1.0 - std::min(origin_lag[o], fresh) / fresh;
+            sum += share;
+            sum_sq += share * share;
+            ++active;
+        }
+        if (active != 0 && sum_sq > 0.0) {
+            m_fairness_min = std::min(
+                m_fairness_min, (sum * sum) / (static_cast<double>(active) * sum_sq));
+        }
+    }
+
+    const Fleet& m_fleet;
+    const Scenario& m_scenario;
+    std::vector<std::uint64_t> m_base;
+    std::vector<double> m_lags;
+    double m_origin_lag_max = 0.0;
+    double m_fairness_min = 1.0;
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+};
+
+void start_workers(Fleet& fleet, const Scenario& scenario) {
+    mdbxc::sync::SyncWorkerOptions options;
+    options.max_batches = scenario.max_batches;
+    options.max_bytes = scenario.max_bytes;
+    options.idle_interval = std::chrono::milliseconds(scenario.poll_ms);
+    for (std::size_t i = 0; i < fleet.replicas.size(); ++i) {
+        Replica& replica = *fleet.replicas[i];
+        replica.peer->reset();
+        replica.progress->begin_phase();
+        options.observer = replica.progress.get();
+        replica.worker.reset(new mdbxc::sync::SyncWorker(*replica.engine, *replica.peer, options));
+    }
+    for (std::size_t i = 0; i < fleet.replicas.size(); ++i) {
+        fleet.replicas[i]->worker->start();
+    }
+}
+
+/// \brief Sets the catch-up target and waits until every replica reaches it.
+void wait_caught_up(Fleet& fleet, std::uint64_t target) {
+    fleet.target.store(target, std::memory_order_release);
+    const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + catch_up_timeout;
+    std::chrono::steady_clock::time_point at;
+    for (std::size_t i = 0; i < fleet.replicas.size(); ++i) {
+        Replica& replica = *fleet.replicas[i];
+        replica.progress->check_caught_up();
+        while (!replica.progress->caught_up(at)) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                throw std::runtime_error("replica " + std::to_string(i) +
+                                         " did not catch up: " +
+                                         replica.worker->last_error());
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+/// \brief Stops every worker and folds pull and catch-up stats into \p row.
+void finish_phase(Fleet& fleet, std::chrono::steady_clock::time_point catch_up_from, Row& row) {
+    for (std::size_t i = 0; i < fleet.replicas.size(); ++i) {
+        fleet.replicas[i]->worker->request_stop();
+    }
+    std::vector<double> latencies;
+    std::vector<double> catch_up;
+    double hub_cpu_us = 0.0;
+    for (std::size_t i = 0; i < fleet.replicas.size(); ++i) {
+        Replica& replica = *fleet.replicas[i];
+        replica.worker->join();
+        replica.worker.reset();
+        const TimedPeer& peer = *replica.peer;
+        latencies.insert(latencies.end(), peer.latencies_us.begin(), peer.latencies_us.end());
+        hub_cpu_us += peer.cpu_us;
+        row.pulled_batches += peer.pulled_batches;
+        row.empty_pulls += peer.empty_pulls;
+        std::chrono::steady_clock::time_point at;
+        replica.progress->caught_up(at);
+        catch_up.push_back(at <= catch_up_from ? 0.0 : elapsed_ms(catch_up_from, at));
+    }
+    row.pulls = static_cast<std::uint64_t>(latencies.size());
+    row.pull_p50_us = percentile(latencies, 0.50);
+    row.pull_p90_us = percentile(latencies, 0.90);
+    row.pull_p99_us = percentile(latencies, 0.99);
+    row.pull_max_us = latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end());
+    row.hub_pull_cpu_ms = hub_cpu_us / 1000.0;
+    row.catch_up_p50_ms = percentile(catch_up, 0.50);
+    row.catch_up_p99_ms = percentile(catch_up, 0.99);
+    row.catch_up_max_ms = catch_up.empty() ? 0.0 : *std::max_element(catch_up.begin(), catch_up.end());
+}
+
+/// \brief Every replica starts empty and catches up on the seeded history.
+Row measure_cold_catch_up(Fleet& fleet, const Scenario& scenario) {
+    Row row;
+    row.phase = "cold_catch_up";
+    row.target_batches = tails_total(fleet, scenario);
+    fleet.target.store(row.target_batches);
+    LagSampler sampler(fleet, scenario);
+    const double cpu_before = process_cpu_ms();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    start_workers(fleet, scenario);
+    sampler.start();
+    wait_caught_up(fleet, row.target_batches);
+    const std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+    sampler.stop();
+    finish_phase(fleet, start, row);
+    row.cpu_ms = process_cpu_ms() - cpu_before;
+    row.ms = elapsed_ms(start, finish);
+    row.drain_ms = row.ms;
+    sampler.fill(row);
+    return row;
+}
+
+/// \brief Writers append origin chunks to the hub while the fleet pulls,
+/// then the fleet drains what is left.
+Row measure_concurrent_writes(Fleet& fleet, const Scenario& scenario) {
+    Row row;
+    row.phase = "concurrent_writes";
+    const std::uint64_t base_total = tails_total(fleet, scenario);
+    fleet.target.store(std::numeric_limits<std::uint64_t>::max());
+    LagSampler sampler(fleet, scenario);
+    const double cpu_before = process_cpu_ms();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    start_workers(fleet, scenario);
+    sampler.start();
+
+    const std::chrono::steady_clock::time_point write_end =
+        start + std::chrono::seconds(scenario.write_seconds);
+    const std::chrono::nanoseconds interval(
+        static_cast<std::int64_t>(1000000000ULL * scenario.writers / scenario.write_rate));
+    std::vector<std::thread> writers;
+    std::vector<std::string> errors(static_cast<std::size_t>(scenario.writers));
+    for (std::uint64_t w = 0; w < scenario.writers; ++w) {
+        writers.push_back(std::thread([&fleet, &scenario, &errors, w, start, write_end, interval]() {
+            try {
+                std::chrono::steady_clock::time_point next = start;
+                std::uint64_t origin = w;
+                while (next < write_end) {
+                    std::this_thread::sleep_until(next);
+                    const std::uint64_t seq =
+                        fleet.tails[static_cast<std::size_t>(origin)].load() + 1;
+                    append_chunk(fleet, scenario, origin, seq);
+                    origin += scenario.writers;
+                    if (origin >= scenario.origins) {
+                        origin = w;
+                    }
+                    next += interval;
+                }
+            } catch (const std::exception& e) {
+                errors[static_cast<std::size_t>(w)] = e.what();
+            }
+        }));
+    }
+    for (std::size_t w = 0; w < writers.size(); ++w) {
+        writers[w].join();
+    }
+    for (std::size_t w = 0; w < errors.size(); ++w) {
+        if (!errors[w].empty()) {
+            sampler.stop();
+            throw std::runtime_error("writer failed: " + errors[w]);
+        }
+    }
+    const std::chrono::steady_clock::time_point drain_start = std::chrono::steady_clock::now();
+    const std::uint64_t final_total = tails_total(fleet, scenario);
+    row.written_batches = final_total - base_total;
+    row.target_batches = row.written_batches;
+    wait_caught_up(fleet, final_total);
+    const std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+    sampler.stop();
+    finish_phase(fleet, drain_start, row);
+    row.cpu_ms = process_cpu_ms() - cpu_before;
+    row.ms = elapsed_ms(start, finish);
+    row.drain_ms = elapsed_ms(drain_start, finish);
+    sampler.fill(row);
+    return row;
+}
+
+void run_scenario(const Scenario& scenario, const std::string& id, ResultWriter& writer) {
+    validate_scenario(scenario);
+    const std::string prefix = "benchmark_sync_fleet_" + id + "_" + scenario.name;
+    CleanupGuard cleanup_guard;
+    Fleet fleet;
+    try {
+        open_fleet(fleet, scenario, prefix, cleanup_guard);
+        seed_history(fleet, scenario);
+        if (scenario.historical_chunks_per_origin != 0) {
+            write_row(writer, scenario, measure_cold_catch_up(fleet, scenario));
+        }
+        if (scenario.writers != 0) {
+            write_row(writer, scenario, measure_concurrent_writes(fleet, scenario));
+        }
+    } catch (...) {
+        close_fleet(fleet);
+        throw;
+    }
+    close_fleet(fleet);
+}
+
+int run(int argc, char** argv) {
+    const CommandLine options = parse_options(argc, argv);
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        validate_scenario(options.scenarios[i]);
+    }
+    const std::string id = run_id();
+    ResultWriter writer(options.format, options.label);
+    writer.begin();
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        run_scenario(options.scenarios[i], id, writer);
+    }
+    writer.end();
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL sync_fleet_benchmark: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "FAIL sync_fleet_benchmark: non-std exception\n";
+    }
+    return 1;
+}
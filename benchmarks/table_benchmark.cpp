@@ -0,0 +1,866 @@
+/// \file table_benchmark.cpp
+/// \brief Manual micro-benchmark for the core table types: point put/get,
+/// range scan, erase_range and reconcile.
+
+#include <mdbx_containers.hpp>
+
+#include "benchmark_common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const std::uint64_t write_batch = 1000;
+const std::uint64_t values_per_key = 4;
+const std::size_t min_value_bytes = 8;
+const std::size_t min_string_key_bytes = 16;
+const std::size_t max_bytes = 1024 * 1024;
+const std::uint64_t max_threads = 256;
+const std::uint64_t max_lookups_per_thread = 200000;
+/// Largest value stored as an MDBX_DUPSORT duplicate; such tables are skipped above it.
+const std::size_t dupsort_value_limit = 1024;
+
+enum BenchOp {
+    OP_PUT         = 1 << 0,
+    OP_GET         = 1 << 1,
+    OP_SCAN        = 1 << 2,
+    OP_ERASE_RANGE = 1 << 3,
+    OP_RECONCILE   = 1 << 4
+};
+
+struct Scenario {
+    std::string   name;
+    std::string   key;          ///< u64 or string.
+    std::uint64_t records;
+    std::uint64_t key_bytes;    ///< 8 for u64 keys.
+    std::uint64_t value_bytes;
+    std::vector<std::uint64_t> threads;
+};
+
+struct Row {
+    std::string   table;
+    std::string   options;
+    std::string   op;
+    std::uint64_t threads = 1;
+    std::uint64_t items = 0;
+    double        ms = 0.0;
+    double        p50_us = 0.0;
+    double        p99_us = 0.0;
+};
+
+/// \brief Per-thread output buffers of point reads.
+struct GetScratch {
+    std::string value;
+    std::vector<std::string> values;
+};
+
+/// \brief One record of a reconcile target: record index and value seed.
+typedef std::pair<std::uint64_t, std::uint64_t> TargetRecord;
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+struct CleanupGuard {
+    explicit CleanupGuard(const std::string& path_value) : path(path_value) {}
+
+    ~CleanupGuard() {
+        cleanup(path);
+    }
+
+    std::string path;
+};
+
+std::string run_id() {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds ticks =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch());
+    return std::to_string(ticks.count());
+}
+
+using mdbxc_bench::parse_u64;
+using mdbxc_bench::percentile;
+
+double elapsed_ms(std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point finish) {
+    const std::chrono::microseconds elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(finish - start);
+    return static_cast<double>(elapsed.count()) / 1000.0;
+}
+
+// --- Scenarios ---
+
+void validate_scenario(const Scenario& scenario) {
+    if (scenario.key != "u64" && scenario.key != "string") {
+        throw std::runtime_error("key must be u64 or string");
+    }
+    if (scenario.records < 4) {
+        throw std::runtime_error("records must be at least 4");
+    }
+    if (scenario.records > std::numeric_limits<std::uint64_t>::max() / 4) {
+        throw std::runtime_error("records overflows benchmark bounds");
+    }
+    if (scenario.key == "string" &&
+        (scenario.key_bytes < min_string_key_bytes || scenario.key_bytes > max_bytes)) {
+        throw std::runtime_error("string key_bytes must be in [16, 1048576]");
+    }
+    if (scenario.value_bytes < min_value_bytes || scenario.value_bytes > max_bytes) {
+        throw std::runtime_error("value_bytes must be in [8, 1048576]");
+    }
+    if (scenario.threads.empty()) {
+        throw std::runtime_error("at least one thread count is required");
+    }
+    for (std::size_t i = 0; i < scenario.threads.size(); ++i) {
+        if (scenario.threads[i] == 0 || scenario.threads[i] > max_threads) {
+            throw std::runtime_error("thread counts must be in [1, 256]");
+        }
+    }
+}
+
+std::vector<std::uint64_t> thread_counts_up_to(std::uint64_t max_count) {
+    std::vector<std::uint64_t> counts;
+    for (std::uint64_t n = 1; n < max_count; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max_count);
+    return counts;
+}
+
+Scenario make_scenario(const std::string& name,
+                       const std::string& key,
+                       std::uint64_t records,
+                       std::uint64_t key_bytes,
+                       std::uint64_t value_bytes,
+                       std::uint64_t threads) {
+    Scenario scenario;
+    scenario.name = name;
+    scenario.key = key;
+    scenario.records = records;
+    scenario.key_bytes = key == "u64" ? 8 : key_bytes;
+    scenario.value_bytes = value_bytes;
+    scenario.threads = thread_counts_up_to(threads);
+    return scenario;
+}
+
+std::vector<Scenario> default_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("u64_50k_v64", "u64", 50000, 8, 64, 4));
+    scenarios.push_back(make_scenario("str32_50k_v256", "string", 50000, 32, 256, 4));
+    return scenarios;
+}
+
+std::vector<Scenario> realistic_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("u64_1m_v32", "u64", 1000000, 8, 32, 16));
+    scenarios.push_back(make_scenario("u64_200k_v4096", "u64", 200000, 8, 4096, 16));
+    scenarios.push_back(make_scenario("str64_500k_v512", "string", 500000, 64, 512, 16));
+    return scenarios;
+}
+
+std::vector<Scenario> preset_scenarios(const std::string& preset) {
+    if (preset == "quick") {
+        return default_scenarios();
+    }
+    if (preset == "realistic") {
+        return realistic_scenarios();
+    }
+    throw std::runtime_error("unknown benchmark preset: " + preset);
+}
+
+void print_usage() {
+    mdbxc_bench::print_usage(
+        "table_benchmark",
+        "[key records value_bytes key_bytes max_threads]",
+        "Without scenario arguments, runs the quick built-in scenario matrix.\n"
+        "key is u64 or string; positional arguments are optional from left to\n"
+        "right and default to u64 100000 64 32 4. Reads run with 1, 2, 4, ...\n"
+        "threads up to max_threads. --label fills the label column, for\n"
+        "example with the release under test.\n");
+}
+
+struct CommandLine {
+    std::string format = "csv";
+    std::string label;
+    std::vector<Scenario> scenarios;
+};
+
+CommandLine parse_options(int argc, char** argv) {
+    CommandLine options;
+    const std::vector<std::string> args =
+        mdbxc_bench::split_output_options(argc, argv, options.format, options.label);
+    std::string preset;
+    if (mdbxc_bench::select_preset(args, print_usage, preset)) {
+        options.scenarios = preset_scenarios(preset);
+        return options;
+    }
+    const std::string& first = args[0];
+    if (first[0] == '-') {
+        throw std::runtime_error("unknown option: " + first);
+    }
+    if (args.size() > 5) {
+        throw std::runtime_error("too many positional arguments");
+    }
+    const std::uint64_t records = args.size() > 1 ? parse_u64(args[1].c_str(), "records") : 100000;
+    const std::uint64_t value_bytes = args.size() > 2 ? parse_u64(args[2].c_str(), "value_bytes") : 64;
+    const std::uint64_t key_bytes = args.size() > 3 ? parse_u64(args[3].c_str(), "key_bytes") : 32;
+    const std::uint64_t threads = args.size() > 4 ? parse_u64(args[4].c_str(), "max_threads") : 4;
+    if (threads == 0 || threads > max_threads) {
+        throw std::runtime_error("max_threads must be in [1, 256]");
+    }
+    options.scenarios.push_back(
+        make_scenario("custom", first, records, key_bytes, value_bytes, threads));
+    return options;
+}
+
+// --- Output ---
+
+using mdbxc_bench::ResultWriter;
+
+void write_row(ResultWriter& writer, const Scenario& scenario, const Row& row) {
+    const double per_sec =
+        row.ms <= 0.0 ? 0.0 : (static_cast<double>(row.items) * 1000.0) / row.ms;
+    writer.begin_row()
+        .text("scenario", scenario.name)
+        .text("table", row.table)
+        .text("options", row.options)
+        .text("key", scenario.key)
+        .number("key_bytes", scenario.key_bytes)
+        .number("value_bytes", scenario.value_bytes)
+        .number("records", scenario.records)
+        .text("op", row.op)
+        .number("threads", row.threads)
+        .number("items", row.items)
+        .number("ms", row.ms)
+        .number("items_per_sec", per_sec)
+        .number("p50_us", row.p50_us)
+        .number("p99_us", row.p99_us)
+        .end_row();
+}
+
+// --- Workload ---
+
+/// \brief Keys and values derived from record indices.
+/// \details Key order follows index order for both key kinds, so index
+/// ranges are key ranges.
+struct Workload {
+    std::uint64_t records = 0;
+    std::size_t key_bytes = 8;
+    std::size_t value_bytes = 0;
+
+    template<class KeyT>
+    KeyT key(std::uint64_t index) const;
+
+    /// \brief Value of seed \p seed; its first 8 bytes keep values distinct.
+    std::string value(std::uint64_t seed) const {
+        std::string out(value_bytes, 'v');
+        for (std::size_t i = 0; i < 8; ++i) {
+            out[i] = static_cast<char>((seed >> (56 - 8 * i)) & 0xFF);
+        }
+        return out;
+    }
+};
+
+template<>
+std::uint64_t Workload::key<std::uint64_t>(std::uint64_t index) const {
+    return index;
+}
+
+template<>
+std::string Workload::key<std::string>(std::uint64_t index) const {
+    static const char digits[] = "0123456789abcdef";
+    std::string out(key_bytes, 'k');
+    for (std::size_t i = 0; i < 16; ++i) {
+        out[key_bytes - 1 - i] = digits[(index >> (4 * i)) & 0xF];
+    }
+    return out;
+}
+
+/// \brief Records kept by the reconcile step: every record except one in
+/// ten, one in ten with a new value, and one tenth of new records.
+std::vector<TargetRecord> reconcile_target(std::uint64_t records) {
+    std::vector<TargetRecord> out;
+    out.reserve(static_cast<std::size_t>(records));
+    for (std::uint64_t i = 0; i < records; ++i) {
+        if (i % 10 == 0) {
+            continue;
+        }
+        out.push_back(TargetRecord(i, i % 10 == 1 ? i + 2 * records : i));
+    }
+    for (std::uint64_t i = records; i < records + records / 10; ++i) {
+        out.push_back(TargetRecord(i, i));
+    }
+    return out;
+}
+
+// --- Table adapters ---
+
+/// \brief Uniform operations over one table; unsupported ones are absent
+/// from \c ops and never called.
+class TableBench {
+public:
+    virtual ~TableBench() {}
+    virtual unsigned ops() const = 0;
+    virtual void put(std::uint64_t index, MDBX_txn* txn) = 0;
+    virtual bool get(std::uint64_t index, GetScratch& scratch, MDBX_txn* txn) const = 0;
+    virtual std::uint64_t scan(MDBX_txn*) const { return 0; }
+    virtual std::uint64_t erase_range(std::uint64_t, std::uint64_t, MDBX_txn*) { return 0; }
+    virtual std::uint64_t reconcile(const std::vector<TargetRecord>&, MDBX_txn*) { return 0; }
+};
+
+template<class KeyT, class Options>
+class KeyValueBench : public TableBench {
+public:
+    KeyValueBench(std::shared_ptr<mdbxc::Connection> conn, const Workload& w)
+        : m_table(conn, "bench"), m_w(w) {}
+
+    unsigned ops() const { return OP_PUT | OP_GET | OP_SCAN | OP_ERASE_RANGE | OP_RECONCILE; }
+
+    void put(std::uint64_t index, MDBX_txn* txn) {
+        m_table.insert_or_assign(m_w.key<KeyT>(index), m_w.value(index), txn);
+    }
+
+    bool get(std::uint64_t index, GetScratch& scratch, MDBX_txn* txn) const {
+        return m_table.try_get(m_w.key<KeyT>(index), scratch.value, txn);
+    }
+
+    std::uint64_t scan(MDBX_txn* txn) const {
+        std::uint64_t count = 0;
+        m_table.for_each_range(m_w.key<KeyT>(0), m_w.key<KeyT>(max_index()),
+            [&count](const KeyT&, const std::string&) -> bool { ++count; return true; }, txn);
+        return count;
+    }
+
+    std::uint64_t erase_range(std::uint64_t from, std::uint64_t to, MDBX_txn* txn) {
+        return m_table.erase_range(m_w.key<KeyT>(from), m_w.key<KeyT>(to), txn);
+    }
+
+    std::uint64_t reconcile(const std::vector<TargetRecord>& target, MDBX_txn* txn) {
+        std::vector<std::pair<KeyT, std::string> > pairs;
+        pairs.reserve(target.size());
+        for (std::size_t i = 0; i < target.size(); ++i) {
+            pairs.push_back(std::make_pair(m_w.key<KeyT>(target[i].first),
+                                           m_w.value(target[i].second)));
+        }
+        m_table.reconcile(pairs, txn);
+        return pairs.size();
+    }
+
+private:
+    static std::uint64_t max_index() { return std::numeric_limits<std::uint64_t>::max(); }
+
+    mdbxc::KeyValueTable<KeyT, std::string, Options> m_table;
+    Workload m_w;
+};
+
+template<class KeyT, class Options>
+class KeyBench : public TableBench {
+public:
+    KeyBench(std::shared_ptr<mdbxc::Connection> conn, const Workload& w)
+        : m_table(conn, "bench"), m_w(w) {}
+
+    unsigned ops() const { return OP_PUT | OP_GET | OP_SCAN | OP_ERASE_RANGE | OP_RECONCILE; }
+
+    void put(std::uint64_t index, MDBX_txn* txn) {
+        m_table.insert(m_w.key<KeyT>(index), txn);
+    }
+
+    bool get(std::uint64_t index, GetScratch&, MDBX_txn* txn) const {
+        return m_table.contains(m_w.key<KeyT>(index), txn);
+    }
+
+    std::uint64_t scan(MDBX_txn* txn) const {
+        std::uint64_t count = 0;
+        m_table.for_each_range(m_w.key<KeyT>(0),
+                               m_w.key<KeyT>(std::numeric_limits<std::uint64_t>::max()),
+            [&count](const KeyT&) -> bool { ++count; return true; }, txn);
+        return count;
+    }
+
+    std::uint64_t erase_range(std::uint64_t from, std::uint64_t to, MDBX_txn* txn) {
+        return m_table.erase_range(m_w.key<KeyT>(from), m_w.key<KeyT>(to), txn);
+    }
+
+    std::uint64_t reconcile(const std::vector<TargetRecord>& target, MDBX_txn* txn) {
+        std::vector<KeyT> keys;
+        keys.reserve(target.size());
+        for (std::size_t i = 0; i < target.size(); ++i) {
+            keys.push_back(m_w.key<KeyT>(target[i].first));
+        }
+        m_table.reconcile(keys, txn);
+        return keys.size();
+    }
+
+private:
+    mdbxc::KeyTable<KeyT, Options> m_table;
+    Workload m_w;
+};
+
+/// \brief \c values_per_key consecutive records share one key.
+template<class KeyT, class Options>
+class MultiValueBench : public TableBench {
+public:
+    MultiValueBench(std::shared_ptr<mdbxc::Connection> conn, const Workload& w)
+        : m_table(conn, "bench"), m_w(w) {}
+
+    unsigned ops() const { return OP_PUT | OP_GET | OP_SCAN | OP_ERASE_RANGE | OP_RECONCILE; }
+
+    void put(std::uint64_t index, MDBX_txn* txn) {
+        m_table.insert(key_of(index), m_w.value(index), txn);
+    }
+
+    bool get(std::uint64_t index, GetScratch& scratch, MDBX_txn* txn) const {
+        scratch.values = m_table.find(key_of(index), txn);
+        return !scratch.values.empty();
+    }
+
+    std::uint64_t scan(MDBX_txn* txn) const {
+        std::uint64_t count = 0;
+        m_table.for_each_range(m_w.key<KeyT>(0),
+                               m_w.key<KeyT>(std::numeric_limits<std::uint64_t>::max()),
+            [&count](const KeyT&, const std::string&) -> bool { ++count; return true; }, txn);
+        return count;
+    }
+
+    std::uint64_t erase_range(std::uint64_t from, std::uint64_t to, MDBX_txn* txn) {
+        return m_table.erase_range(key_of(from), key_of(to), txn);
+    }
+
+    std::uint64_t reconcile(const std::vector<TargetRecord>& target, MDBX_txn* txn) {
+        std::vector<std::pair<KeyT, std::string> > pairs;
+        pairs.reserve(target.size());
+        for (std::size_t i = 0; i < target.size(); ++i) {
+            pairs.push_back(std::make_pair(key_of(target[i].first), m_w.value(target[i].second)));
+        }
+        m_table.reconcile(pairs, txn);
+        return pairs.size();
+    }
+
+private:
+    KeyT key_of(std::uint64_t index) const { return m_w.key<KeyT>(index / values_per_key); }
+
+    mdbxc::KeyMultiValueTable<KeyT, std::string, Options> m_table;
+    Workload m_w;
+};
+
+/// \brief As \ref MultiValueBench; reconcile is \c replace_with(), the
+/// table has no \c erase_range().
+template<class KeyT, class Options>
+class OrderedMultiValueBench : public TableBench {
+public:
+    OrderedMultiValueBench(std::shared_ptr<mdbxc::Connection> conn, const Workload& w)
+        : m_table(conn, "bench"), m_w(w) {}
+
+    unsigned ops() const { return OP_PUT | OP_GET | OP_SCAN | OP_RECONCILE; }
+
+    void put(std::uint64_t index, MDBX_txn* txn) {
+        m_table.append(key_of(index), m_w.value(index), txn);
+    }
+
+    bool get(std::uint64_t index, GetScratch& scratch, MDBX_txn* txn) const {
+        scratch.values = m_table.find(key_of(index), txn);
+        return !scratch.values.empty();
+    }
+
+    std::uint64_t scan(MDBX_txn* txn) const {
+        return m_table.range_vector(m_w.key<KeyT>(0),
+                                    m_w.key<KeyT>(std::numeric_limits<std::uint64_t>::max()),
+                                    txn).size();
+    }
+
+    std::uint64_t reconcile(const std::vector<TargetRecord>& target, MDBX_txn* txn) {
+        std::vector<std::pair<KeyT, std::string> > pairs;
+        pairs.reserve(target.size());
+        for (std::size_t i = 0; i < target.size(); ++i) {
+            pairs.push_back(std::make_pair(key_of(target[i].first), m_w.value(target[i].second)));
+        }
+        m_table.replace_with(pairs, txn);
+        return pairs.size();
+    }
+
+private:
+    KeyT key_of(std::uint64_t index) const { return m_w.key<KeyT>(index / values_per_key); }
+
+    mdbxc::KeyOrderedMultiValueTable<KeyT, std::string, Options> m_table;
+    Workload m_w;
+};
+
+/// \brief Ids are assigned by \c append(), so put order does not matter.
+class SequenceBench : public TableBench {
+public:
+    SequenceBench(std::shared_ptr<mdbxc::Connection> conn, const Workload& w)
+        : m_table(conn, "bench"), m_w(w), m_first(std::numeric_limits<std::uint64_t>::max()) {}
+
+    unsigned ops() const { return OP_PUT | OP_GET | OP_SCAN; }
+
+    void put(std::uint64_t index, MDBX_txn* txn) {
+        const std::uint64_t id = m_table.append(m_w.value(index), txn);
+        if (id < m_first) {
+            m_first = id;
+        }
+    }
+
+    bool get(std::uint64_t index, GetScratch& scratch, MDBX_txn* txn) const {
+        return m_table.try_get(m_first + index, scratch.value, txn);
+    }
+
+    std::uint64_t scan(MDBX_txn* txn) const {
+        return m_table.range(m_first, m_first + m_w.records - 1, txn).size();
+    }
+
+private:
+    mdbxc::SequenceTable<std::string> m_table;
+    Workload m_w;
+    std::uint64_t m_first;
+};
+
+template<mdbxc::HashedStoreLayout Layout>
+class HashedBench : public TableBench {
+public:
+    HashedBench(std::shared_ptr<mdbxc::Connection> conn, const Workload& w)
+        : m_table(conn, "bench"), m_w(w) {}
+
+    unsigned ops() const { return OP_PUT | OP_GET | OP_RECONCILE; }
+
+    void put(std::uint64_t index, MDBX_txn* txn) {
+        m_table.insert_or_assign(m_w.key<std::string>(index), m_w.value(index), txn);
+    }
+
+    bool get(std::uint64_t index, GetScratch& scratch, MDBX_txn* txn) const {
+        return m_table.try_get(m_w.key<std::string>(index), scratch.value, txn);
+    }
+
+    std::uint64_t reconcile(const std::vector<TargetRecord>& target, MDBX_txn* txn) {
+        std::vector<std::pair<std::string, std::string> > pairs;
+        pairs.reserve(target.size());
+        for (std::size_t i = 0; i < target.size(); ++i) {
+            pairs.push_back(std::make_pair(m_w.key<std::string>(target[i].first),
+                                           m_w.value(target[i].second)));
+        }
+        m_table.reconcile(pairs, txn);
+        return pairs.size();
+    }
+
+private:
+    mdbxc::HashedKeyValueStore<std::string, std::string, mdbxc::XXH3Hasher, Layout> m_table;
+    Workload m_w;
+};
+
+template<class KeyT, class Options>
+class AnyValueBench : public TableBench {
+public:
+    AnyValueBench(std::shared_ptr<mdbxc::Connection> conn, const Workload& w)
+        : m_table(conn, "bench"), m_w(w) {}
+
+    unsigned ops() const { return OP_PUT | OP_GET; }
+
+    void put(std::uint64_t index, MDBX_txn* txn) {
+        m_table.set(m_w.key<KeyT>(index), m_w.value(index), txn);
+    }
+
+    bool get(std::uint64_t index, GetScratch& scratch, MDBX_txn* txn) const {
+        // Stored values are never empty, so the empty default marks a miss.
+        scratch.value = m_table.template get_or<std::string>(m_w.key<KeyT>(index),
+                                                             std::string(), txn);
+        return !scratch.value.empty();
+    }
+
+private:
+    mdbxc::AnyValueTable<KeyT, Options> m_table;
+    Workload m_w;
+};
+
+// --- Measurements ---
+
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path) {
+    mdbxc::Config config;
+    config.pathname = path;
+    config.max_dbs = 16;
+    config.no_subdir = true;
+    config.size_now = 512LL * 1024LL * 1024LL;
+    config.size_upper = 64LL * 1024LL * 1024LL * 1024LL;
+    return mdbxc::Connection::create(config);
+}
+
+/// \brief Writes every record in shuffled order, \c write_batch per transaction.
+Row measure_put(mdbxc::Connection& conn, TableBench& bench, std::uint64_t records) {
+    std::vector<std::uint64_t> order(static_cast<std::size_t>(records));
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::mt19937_64 rng(42);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    Row row;
+    row.op = "put";
+    row.items = records;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::size_t offset = 0; offset < order.size(); offset += write_batch) {
+        const std::size_t end = std::min(order.size(), offset + static_cast<std::size_t>(write_batch));
+        mdbxc::Transaction txn = conn.transaction(mdbxc::TransactionMode::WRITABLE);
+        for (std::size_t i = offset; i < end; ++i) {
+            bench.put(order[i], txn.handle());
+        }
+        txn.commit();
+    }
+    row.ms = elapsed_ms(start, std::chrono::steady_clock::now());
+    return row;
+}
+
+/// \brief Runs \p body on \p threads threads, each inside its own
+/// read-only transaction, and returns the wall time in milliseconds.
+template<class BodyT>
+double run_readers(mdbxc::Connection& conn, std::uint64_t threads, BodyT body) {
+    std::atomic<std::size_t> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+    std::vector<std::string> errors(static_cast<std::size_t>(threads));
+    for (std::size_t t = 0; t < static_cast<std::size_t>(threads); ++t) {
+        workers.push_back(std::thread([&conn, &ready, &go, &errors, &body, t]() {
+            try {
+                mdbxc::Transaction txn = conn.transaction(mdbxc::TransactionMode::READ_ONLY);
+                ready.fetch_add(1);
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+                body(t, txn.handle());
+                txn.commit();
+            } catch (const std::exception& e) {
+                errors[t] = e.what();
+                ready.fetch_add(1);
+            }
+        }));
+    }
+    while (ready.load() < workers.size()) {
+        std::this_thread::yield();
+    }
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    go.store(true);
+    for (std::size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    const double ms = elapsed_ms(start, std::chrono::steady_clock::now());
+    for (std::size_t t = 0; t < errors.size(); ++t) {
+        if (!errors[t].empty()) {
+            throw std::runtime_error("reader thread failed: " + errors[t]);
+        }
+    }
+    return ms;
+}
+
+/// \brief Each thread reads up to \c max_lookups_per_thread random
+/// records, timing every call.
+Row measure_get(mdbxc::Connection& conn, const TableBench& bench,
+                std::uint64_t records, std::uint64_t threads) {
+    const std::uint64_t per_thread = std::min(records, max_lookups_per_thread);
+    std::vector<std::vector<std::uint64_t> > lookups(static_cast<std::size_t>(threads));
+    for (std::size_t t = 0; t < lookups.size(); ++t) {
+        std::mt19937_64 rng(1000 + t);
+        std::uniform_int_distribution<std::uint64_t> pick(0, records - 1);
+        lookups[t].resize(static_cast<std::size_t>(per_thread));
+        for (std::size_t i = 0; i < lookups[t].size(); ++i) {
+            lookups[t][i] = pick(rng);
+        }
+    }
+    std::vector<std::vector<double> > latencies(lookups.size());
+    std::vector<std::size_t> misses(lookups.size(), 0);
+
+    Row row;
+    row.op = "get";
+    row.threads = threads;
+    row.items = per_thread * threads;
+    row.ms = run_readers(conn, threads,
+        [&bench, &lookups, &latencies, &misses](std::size_t t, MDBX_txn* txn) {
+            GetScratch scratch;
+            std::vector<double>& out = latencies[t];
+            out.resize(lookups[t].size());
+            for (std::size_t i = 0; i < lookups[t].size(); ++i) {
+                const std::chrono::steady_clock::time_point start =
+                    std::chrono::steady_clock::now();
+                if (!bench.get(lookups[t][i], scratch, txn)) {
+                    ++misses[t];
+                }
+                out[i] = elapsed_ms(start, std::chrono::steady_clock::now()) * 1000.0;
+            }
+        });
+    std::vector<double> all;
+    for (std::size_t t = 0; t < latencies.size(); ++t) {
+        if (misses[t] != 0) {
+            throw std::runtime_error("get missed records written by put");
+        }
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+    }
+    row.p50_us = percentile(all, 0.50);
+    row.p99_us = percentile(all, 0.99);
+    return row;
+}
+
+/// \brief Each thread scans the whole table once.
+Row measure_scan(mdbxc::Connection& conn, const TableBench& bench,
+                 std::uint64_t records, std::uint64_t threads) {
+    std::vector<std::uint64_t> seen(static_cast<std::size_t>(threads), 0);
+    Row row;
+    row.op = "scan";
+    row.threads = threads;
+    row.ms = run_readers(conn, threads, [&bench, &seen](std::size_t t, MDBX_txn* txn) {
+        seen[t] = bench.scan(txn);
+    });
+    for (std::size_t t = 0; t < seen.size(); ++t) {
+        if (seen[t] != records) {
+            throw std::runtime_error("scan visited " + std::to_string(seen[t]) +
+                                     " of " + std::to_string(records) + " records");
+        }
+        row.items += seen[t];
+    }
+    return row;
+}
+
+Row measure_reconcile(mdbxc::Connection& conn, TableBench& bench, std::uint64_t records) {
+    const std::vector<TargetRecord> target = reconcile_target(records);
+    Row row;
+    row.op = "reconcile";
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    mdbxc::Transaction txn = conn.transaction(mdbxc::TransactionMode::WRITABLE);
+    row.items = bench.reconcile(target, txn.handle());
+    txn.commit();
+    row.ms = elapsed_ms(start, std::chrono::steady_clock::now());
+    return row;
+}
+
+/// \brief Erases the middle half of the record index range.
+Row measure_erase_range(mdbxc::Connection& conn, TableBench& bench, std::uint64_t records) {
+    Row row;
+    row.op = "erase_range";
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    mdbxc::Transaction txn = conn.transaction(mdbxc::TransactionMode::WRITABLE);
+    row.items = bench.erase_range(records / 4, records / 4 * 3 - 1, txn.handle());
+    txn.commit();
+    row.ms = elapsed_ms(start, std::chrono::steady_clock::now());
+    return row;
+}
+
+template<class BenchT>
+void run_table(const Scenario& scenario,
+               const std::string& path,
+               const std::string& table,
+               const std::string& options,
+               ResultWriter& writer) {
+    Workload w;
+    w.records = scenario.records;
+    w.key_bytes = static_cast<std::size_t>(scenario.key_bytes);
+    w.value_bytes = static_cast<std::size_t>(scenario.value_bytes);
+
+    cleanup(path);
+    std::shared_ptr<mdbxc::Connection> conn = open_env(path);
+    {
+        BenchT bench(conn, w);
+        const unsigned ops = bench.ops();
+        std::vector<Row> rows;
+        rows.push_back(measure_put(*conn, bench, scenario.records));
+        for (std::size_t i = 0; i < scenario.threads.size(); ++i) {
+            rows.push_back(measure_get(*conn, bench, scenario.records, scenario.threads[i]));
+        }
+        if ((ops & OP_SCAN) != 0) {
+            for (std::size_t i = 0; i < scenario.threads.size(); ++i) {
+                rows.push_back(measure_scan(*conn, bench, scenario.records, scenario.threads[i]));
+            }
+        }
+        if ((ops & OP_RECONCILE) != 0) {
+            rows.push_back(measure_reconcile(*conn, bench, scenario.records));
+        }
+        if ((ops & OP_ERASE_RANGE) != 0) {
+            rows.push_back(measure_erase_range(*conn, bench, scenario.records));
+        }
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            rows[i].table = table;
+            rows[i].options = options;
+            write_row(writer, scenario, rows[i]);
+        }
+    }
+    conn->disconnect();
+}
+
+template<class KeyT, class Options>
+void run_key_tables(const Scenario& scenario,
+                    const std::string& path,
+                    const std::string& options,
+                    ResultWriter& writer) {
+    run_table<KeyValueBench<KeyT, Options> >(scenario, path, "key_value", options, writer);
+    run_table<KeyBench<KeyT, Options> >(scenario, path, "key", options, writer);
+    if (scenario.value_bytes <= dupsort_value_limit) {
+        run_table<MultiValueBench<KeyT, Options> >(
+            scenario, path, "key_multi_value", options, writer);
+        run_table<OrderedMultiValueBench<KeyT, Options> >(
+            scenario, path, "key_ordered_multi_value", options, writer);
+    }
+    run_table<AnyValueBench<KeyT, Options> >(scenario, path, "any_value", options, writer);
+}
+
+void run_scenario(const Scenario& scenario, const std::string& id, ResultWriter& writer) {
+    validate_scenario(scenario);
+    const std::string path = "benchmark_table_" + id + "_" + scenario.name + ".mdbx";
+    CleanupGuard cleanup_guard(path);
+
+    if (scenario.key == "u64") {
+        run_key_tables<std::uint64_t, mdbxc::DefaultTableOptions>(
+            scenario, path, "default", writer);
+        run_key_tables<std::uint64_t, mdbxc::FastIntegerKeyOptions>(
+            scenario, path, "fast_integer_key", writer);
+        run_table<SequenceBench>(scenario, path, "sequence", "default", writer);
+        return;
+    }
+    // FastIntegerKeyOptions only changes integer keys.
+    run_key_tables<std::string, mdbxc::DefaultTableOptions>(scenario, path, "default", writer);
+    run_table<HashedBench<mdbxc::HashedStoreLayout::LargeValues> >(
+        scenario, path, "hashed_large_values", "default", writer);
+    if (scenario.key_bytes + scenario.value_bytes <= dupsort_value_limit) {
+        run_table<HashedBench<mdbxc::HashedStoreLayout::SmallValues> >(
+            scenario, path, "hashed_small_values", "default", writer);
+    }
+    run_table<HashedBench<mdbxc::HashedStoreLayout::Hybrid> >(
+        scenario, path, "hashed_hybrid", "default", writer);
+}
+
+int run(int argc, char** argv) {
+    const CommandLine options = parse_options(argc, argv);
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        validate_scenario(options.scenarios[i]);
+    }
+    const std::string id = run_id();
+    ResultWriter writer(options.format, options.label);
+    writer.begin();
+    for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+        run_scenario(options.scenarios[i], id, writer);
+    }
+    writer.end();
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL table_benchmark: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "FAIL table_benchmark: non-std exception\n";
+    }
+    return 1;
+}
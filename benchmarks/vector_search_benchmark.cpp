@@ -0,0 +1,572 @@
+/// \file vector_search_benchmark.cpp
+/// \brief Manual benchmark for VectorStore ingest, rebuild, search latency and recall.
+
+#include <mdbx_containers.hpp>
+
+#include "benchmark_common.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+const std::size_t add_batch_size = 1000;
+const std::uint32_t max_dim = 65536;
+
+struct Scenario {
+    std::string   name;
+    std::string   dataset;   ///< random, clustered or fvecs.
+    std::uint64_t vectors;
+    std::uint64_t dim;
+    std::uint64_t queries;
+    std::uint64_t clusters;  ///< Centers of the clustered dataset.
+    std::string   base_path; ///< fvecs base file.
+    std::string   query_path; ///< fvecs query file; empty samples the base set.
+};
+
+struct Dataset {
+    std::uint32_t dim = 0;
+    std::vector<mdbxc::Embedding> base;
+    std::vector<mdbxc::Embedding> queries;
+};
+
+struct IndexConfig {
+    std::string name;
+    mdbxc::VectorIndexType index_type;
+    mdbxc::VectorQuantization quantization;
+};
+
+struct IndexMetrics {
+    double        add_ms = 0.0;
+    double        train_ms = 0.0;
+    double        rebuild_ms = 0.0;
+    std::uint64_t index_bytes = 0;
+};
+
+struct SearchMetrics {
+    std::size_t top_k = 0;
+    double      total_ms = 0.0;
+    double      p50_us = 0.0;
+    double      p99_us = 0.0;
+    double      recall = 0.0;
+};
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+struct CleanupGuard {
+    explicit CleanupGuard(const std::string& path_value) : path(path_value) {}
+
+    ~CleanupGuard() {
+        cleanup(path);
+    }
+
+    std::string path;
+};
+
+std::string run_id() {
+    const std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    const std::chrono::nanoseconds ticks =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now.time_since_epoch());
+    return std::to_string(ticks.count());
+}
+
+using mdbxc_bench::parse_u64;
+using mdbxc_bench::percentile;
+
+std::uint64_t parse_arg(int argc,
+                        char** argv,
+                        int index,
+                        std::uint64_t fallback,
+                        const char* name) {
+    if (index >= argc) {
+        return fallback;
+    }
+    return parse_u64(argv[index], name);
+}
+
+void validate_scenario(const Scenario& scenario) {
+    if (scenario.dataset != "random" && scenario.dataset != "clustered" &&
+        scenario.dataset != "fvecs") {
+        throw std::runtime_error("dataset must be random, clustered, or fvecs");
+    }
+    if (scenario.dataset == "fvecs" && scenario.base_path.empty()) {
+        throw std::runtime_error("fvecs dataset requires a base file");
+    }
+    if (scenario.dataset != "fvecs" &&
+        (scenario.dim == 0 || scenario.dim > max_dim)) {
+        throw std::runtime_error("dim must be in [1, 65536]");
+    }
+    if (scenario.vectors == 0 || scenario.queries == 0) {
+        throw std::runtime_error("vectors and queries must be positive");
+    }
+    if (scenario.dataset == "clustered" && scenario.clusters == 0) {
+        throw std::runtime_error("clusters must be positive");
+    }
+}
+
+Scenario make_scenario(const std::string& name,
+                       const std::string& dataset,
+                       std::uint64_t vectors,
+                       std::uint64_t dim,
+                       std::uint64_t queries,
+                       std::uint64_t clusters) {
+    Scenario scenario;
+    scenario.name = name;
+    scenario.dataset = dataset;
+    scenario.vectors = vectors;
+    scenario.dim = dim;
+    scenario.queries = queries;
+    scenario.clusters = clusters;
+    return scenario;
+}
+
+std::vector<Scenario> default_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("random_10k_d64", "random", 10000, 64, 200, 0));
+    scenarios.push_back(make_scenario("clustered_10k_d64", "clustered", 10000, 64, 200, 64));
+    return scenarios;
+}
+
+std::vector<Scenario> realistic_scenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(make_scenario("clustered_100k_d384", "clustered", 100000, 384, 1000, 1024));
+    scenarios.push_back(make_scenario("clustered_100k_d768", "clustered", 100000, 768, 1000, 1024));
+    scenarios.push_back(make_scenario("random_50k_d128", "random", 50000, 128, 1000, 0));
+    return scenarios;
+}
+
+std::vector<Scenario> preset_scenarios(const std::string& preset) {
+    if (preset == "quick") {
+        return default_scenarios();
+    }
+    if (preset == "realistic") {
+        return realistic_scenarios();
+    }
+    throw std::runtime_error("unknown benchmark preset: " + preset);
+}
+
+void print_usage() {
+    std::cout
+        << "usage: vector_search_benchmark "
+        << "[dataset vectors dim queries clusters]\n"
+        << "       vector_search_benchmark --fvecs base.fvecs "
+        << "[query.fvecs|- [vectors queries]]\n"
+        << "       vector_search_benchmark --preset quick\n"
+        << "       vector_search_benchmark --preset realistic\n"
+        << "       vector_search_benchmark --list-presets\n"
+        << "\n"
+        << "Without arguments, runs the quick built-in scenario matrix.\n"
+        << "dataset is random or clustered; positional arguments are optional\n"
+        << "from left to right and default to clustered 20000 128 500 256.\n"
+        << "With --fvecs, vectors caps the base rows read (0 reads all) and\n"
+        << "queries are sampled from the base set when no query file is given.\n";
+}
+
+std::vector<Scenario> parse_scenarios(int argc, char** argv) {
+    const std::vector<std::string> args(argv + 1, argv + argc);
+    std::string preset;
+    if (mdbxc_bench::select_preset(args, print_usage, preset)) {
+        return preset_scenarios(preset);
+    }
+    const std::string& first = args[0];
+    Scenario scenario;
+    if (first == "--fvecs") {
+        if (argc < 3 || argc > 6) {
+            throw std::runtime_error("--fvecs expects a base file and up to three values");
+        }
+        scenario = make_scenario("fvecs", "fvecs", 0, 0, 1000, 0);
+        scenario.base_path = argv[2];
+        if (argc > 3 && std::string(argv[3]) != "-") {
+            scenario.query_path = argv[3];
+        }
+        scenario.vectors = parse_arg(argc, argv, 4, 0, "vectors");
+        scenario.queries = parse_arg(argc, argv, 5, 1000, "queries");
+        if (scenario.vectors == 0) {
+            scenario.vectors = std::numeric_limits<std::uint64_t>::max();
+        }
+    } else {
+        if (first[0] == '-') {
+            throw std::runtime_error("unknown option: " + first);
+        }
+        if (argc > 6) {
+            throw std::runtime_error("too many positional arguments");
+        }
+        scenario = make_scenario("custom", first,
+                                 parse_arg(argc, argv, 2, 20000, "vectors"),
+                                 parse_arg(argc, argv, 3, 128, "dim"),
+                                 parse_arg(argc, argv, 4, 500, "queries"),
+                                 parse_arg(argc, argv, 5, 256, "clusters"));
+    }
+    validate_scenario(scenario);
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(scenario);
+    return scenarios;
+}
+
+mdbxc::Embedding make_embedding(std::vector<float> values) {
+    mdbxc::Embedding embedding;
+    embedding.dim = static_cast<std::uint32_t>(values.size());
+    embedding.values.swap(values);
+    return embedding;
+}
+
+/// \brief Reads up to \p limit rows of an fvecs file: int32 dim, then dim floats per row.
+std::vector<mdbxc::Embedding> read_fvecs(const std::string& path, std::uint64_t limit) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open fvecs file: " + path);
+    }
+    std::vector<mdbxc::Embedding> rows;
+    std::int32_t dim = 0;
+    while (rows.size() < limit && in.read(reinterpret_cast<char*>(&dim), sizeof(dim))) {
+        if (dim <= 0 || static_cast<std::uint32_t>(dim) > max_dim ||
+            (!rows.empty() && static_cast<std::uint32_t>(dim) != rows[0].dim)) {
+            throw std::runtime_error("invalid fvecs row dimension in " + path);
+        }
+        std::vector<float> values(static_cast<std::size_t>(dim));
+        if (!in.read(reinterpret_cast<char*>(values.data()),
+                     static_cast<std::streamsize>(values.size() * sizeof(float)))) {
+            throw std::runtime_error("truncated fvecs file: " + path);
+        }
+        rows.push_back(make_embedding(values));
+    }
+    if (rows.empty()) {
+        throw std::runtime_error("empty fvecs file: " + path);
+    }
+    return rows;
+}
+
+Dataset make_dataset(const Scenario& scenario) {
+    Dataset data;
+    std::mt19937 rng(42);
+    if (scenario.dataset == "fvecs") {
+        data.base = read_fvecs(scenario.base_path, scenario.vectors);
+        data.dim = data.base[0].dim;
+        if (!scenario.query_path.empty()) {
+            data.queries = read_fvecs(scenario.query_path, scenario.queries);
+            if (data.queries[0].dim != data.dim) {
+                throw std::runtime_error("query and base fvecs dimensions differ");
+            }
+            return data;
+        }
+        std::uniform_int_distribution<std::size_t> pick(0, data.base.size() - 1);
+        for (std::uint64_t q = 0; q < scenario.queries; ++q) {
+            data.queries.push_back(data.base[pick(rng)]);
+        }
+        return data;
+    }
+    data.dim = static_cast<std::uint32_t>(scenario.dim);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::normal_distribution<float> noise(0.0f, 0.15f);
+    std::vector<std::vector<float>> centers;
+    if (scenario.dataset == "clustered") {
+        centers.resize(static_cast<std::size_t>(scenario.clusters));
+        for (std::size_t c = 0; c < centers.size(); ++c) {
+            centers[c].resize(data.dim);
+            for (std::size_t d = 0; d < data.dim; ++d) {
+                centers[c][d] = uniform(rng);
+            }
+        }
+    }
+    const std::uint64_t total = scenario.vectors + scenario.queries;
+    for (std::uint64_t i = 0; i < total; ++i) {
+        std::vector<float> values(data.dim);
+        if (centers.empty()) {
+            for (std::size_t d = 0; d < data.dim; ++d) {
+                values[d] = uniform(rng);
+            }
+        } else {
+            const std::vector<float>& center = centers[static_cast<std::size_t>(rng() % centers.size())];
+            for (std::size_t d = 0; d < data.dim; ++d) {
+                values[d] = center[d] + noise(rng);
+            }
+        }
+        if (i < scenario.vectors) {
+            data.base.push_back(make_embedding(values));
+        } else {
+            data.queries.push_back(make_embedding(values));
+        }
+    }
+    return data;
+}
+
+std::vector<IndexConfig> index_configs() {
+    std::vector<IndexConfig> configs;
+    const IndexConfig flat = {"flat", mdbxc::VectorIndexType::FLAT,
+                              mdbxc::VectorQuantization::NONE};
+    const IndexConfig int8 = {"flat_int8", mdbxc::VectorIndexType::FLAT,
+                              mdbxc::VectorQuantization::INT8};
+    const IndexConfig fp16 = {"flat_fp16", mdbxc::VectorIndexType::FLAT,
+                              mdbxc::VectorQuantization::FP16};
+    const IndexConfig pq = {"flat_pq", mdbxc::VectorIndexType::FLAT,
+                            mdbxc::VectorQuantization::PQ};
+    const IndexConfig binary = {"flat_binary", mdbxc::VectorIndexType::FLAT,
+                                mdbxc::VectorQuantization::BINARY};
+    const IndexConfig hnsw = {"hnsw", mdbxc::VectorIndexType::HNSW,
+                              mdbxc::VectorQuantization::NONE};
+    const IndexConfig ivf = {"ivf", mdbxc::VectorIndexType::IVF,
+                             mdbxc::VectorQuantization::NONE};
+    configs.push_back(flat);
+    configs.push_back(int8);
+    configs.push_back(fp16);
+    configs.push_back(pq);
+    configs.push_back(binary);
+    configs.push_back(hnsw);
+    configs.push_back(ivf);
+    return configs;
+}
+
+const char* metric_name(mdbxc::VectorMetric metric) {
+    switch (metric) {
+    case mdbxc::VectorMetric::DOT:
+        return "dot";
+    case mdbxc::VectorMetric::L2:
+        return "l2";
+    default:
+        return "cosine";
+    }
+}
+
+/// \brief Largest subspace count up to 16 that divides \p dim.
+std::size_t pq_subspaces(std::uint32_t dim) {
+    for (std::size_t m = 16; m > 1; --m) {
+        if (dim % m == 0) {
+            return m;
+        }
+    }
+    return 1;
+}
+
+mdbxc::VectorStoreOptions make_options(const IndexConfig& config,
+                                       mdbxc::VectorMetric metric,
+                                       const Dataset& data) {
+    mdbxc::VectorStoreOptions options;
+    options.metric = metric;
+    options.index_type = config.index_type;
+    options.quantization = config.quantization;
+    options.pq.subspaces = pq_subspaces(data.dim);
+    const double root = std::sqrt(static_cast<double>(data.base.size()));
+    options.ivf.nlist = std::max<std::size_t>(1, static_cast<std::size_t>(root));
+    return options;
+}
+
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path) {
+    mdbxc::Config config;
+    config.pathname = path;
+    config.max_dbs = 16;
+    config.no_subdir = true;
+    config.size_now = 512LL * 1024LL * 1024LL;
+    config.size_upper = 64LL * 1024LL * 1024LL * 1024LL;
+    return mdbxc::Connection::create(config);
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point finish) {
+    const std::chrono::microseconds elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(finish - start);
+    return static_cast<double>(elapsed.count()) / 1000.0;
+}
+
+/// \brief Exact top-k ids per query, from an fp32 flat index over the same ids.
+std::vector<std::vector<std::uint64_t>> exact_neighbours(const Dataset& data,
+                                                         mdbxc::VectorMetric metric,
+                                                         std::uint64_t first_id,
+                                                         std::size_t top_k) {
+    mdbxc::FlatVectorIndex exact(metric);
+    for (std::size_t i = 0; i < data.base.size(); ++i) {
+        exact.add(first_id + i, data.base[i]);
+    }
+    std::vector<std::vector<std::uint64_t>> truth(data.queries.size());
+    for (std::size_t q = 0; q < data.queries.size(); ++q) {
+        const std::vector<mdbxc::VectorMatch> matches = exact.search(data.queries[q], top_k);
+        for (std::size_t i = 0; i < matches.size(); ++i) {
+            truth[q].push_back(matches[i].id);
+        }
+    }
+    return truth;
+}
+
+void print_csv_header() {
+    std::cout
+        << "scenario,dataset,vectors,dim,queries,index,metric,top_k,"
+        << "add_ms,adds_per_sec,train_ms,rebuild_ms,index_bytes,"
+        << "search_ms,qps,p50_us,p99_us,recall\n";
+}
+
+void print_csv_row(const Scenario& scenario,
+                   const Dataset& data,
+                   const IndexConfig& config,
+                   mdbxc::VectorMetric metric,
+                   const IndexMetrics& index,
+                   const SearchMetrics& search) {
+    const double adds_per_sec =
+        index.add_ms <= 0.0
+            ? 0.0
+            : (static_cast<double>(data.base.size()) * 1000.0) / index.add_ms;
+    const double qps =
+        search.total_ms <= 0.0
+            ? 0.0
+            : (static_cast<double>(data.queries.size()) * 1000.0) / search.total_ms;
+    std::cout << scenario.name << ','
+              << scenario.dataset << ','
+              << data.base.size() << ','
+              << data.dim << ','
+              << data.queries.size() << ','
+              << config.name << ','
+              << metric_name(metric) << ','
+              << search.top_k << ','
+              << index.add_ms << ','
+              << adds_per_sec << ','
+              << index.train_ms << ','
+              << index.rebuild_ms << ','
+              << index.index_bytes << ','
+              << search.total_ms << ','
+              << qps << ','
+              << search.p50_us << ','
+              << search.p99_us << ','
+              << search.recall << '\n';
+}
+
+IndexMetrics build_index(mdbxc::VectorStore& store,
+                         const IndexConfig& config,
+                         const Dataset& data,
+                         std::uint64_t& first_id) {
+    IndexMetrics metrics;
+    const std::chrono::steady_clock::time_point add_start =
+        std::chrono::steady_clock::now();
+    first_id = 0;
+    for (std::size_t offset = 0; offset < data.base.size(); offset += add_batch_size) {
+        const std::size_t end = std::min(data.base.size(), offset + add_batch_size);
+        std::vector<mdbxc::VectorRecord> batch(end - offset);
+        for (std::size_t i = offset; i < end; ++i) {
+            batch[i - offset].embedding = data.base[i];
+        }
+        const std::pair<std::uint64_t, std::uint64_t> ids = store.add_batch(batch);
+        if (offset == 0) {
+            first_id = ids.first;
+        }
+    }
+    metrics.add_ms = elapsed_ms(add_start, std::chrono::steady_clock::now());
+
+    if (config.index_type == mdbxc::VectorIndexType::IVF ||
+        config.quantization == mdbxc::VectorQuantization::PQ) {
+        const std::chrono::steady_clock::time_point train_start =
+            std::chrono::steady_clock::now();
+        store.train_index(0);
+        metrics.train_ms = elapsed_ms(train_start, std::chrono::steady_clock::now());
+    }
+
+    const std::chrono::steady_clock::time_point rebuild_start =
+        std::chrono::steady_clock::now();
+    store.rebuild_index();
+    metrics.rebuild_ms = elapsed_ms(rebuild_start, std::chrono::steady_clock::now());
+    metrics.index_bytes = store.index_memory_bytes();
+    return metrics;
+}
+
+SearchMetrics measure_search(const mdbxc::VectorStore& store,
+                             const Dataset& data,
+                             const std::vector<std::vector<std::uint64_t>>& truth,
+                             std::size_t top_k) {
+    SearchMetrics metrics;
+    metrics.top_k = top_k;
+    std::vector<double> latencies(data.queries.size());
+    std::size_t hits = 0;
+    std::size_t expected = 0;
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (std::size_t q = 0; q < data.queries.size(); ++q) {
+        const std::chrono::steady_clock::time_point query_start =
+            std::chrono::steady_clock::now();
+        const std::vector<mdbxc::SearchResult> results =
+            store.search(data.queries[q], top_k, mdbxc::SearchPayload::NONE);
+        latencies[q] = elapsed_ms(query_start, std::chrono::steady_clock::now()) * 1000.0;
+        // Recall against the first top_k exact ids.
+        const std::size_t want = std::min(top_k, truth[q].size());
+        const std::unordered_set<std::uint64_t> exact(truth[q].begin(), truth[q].begin() +
+                                                      static_cast<std::ptrdiff_t>(want));
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            hits += exact.count(results[i].id);
+        }
+        expected += want;
+    }
+    metrics.total_ms = elapsed_ms(start, std::chrono::steady_clock::now());
+    metrics.p50_us = percentile(latencies, 0.50);
+    metrics.p99_us = percentile(latencies, 0.99);
+    metrics.recall = expected == 0 ? 1.0 : static_cast<double>(hits) / static_cast<double>(expected);
+    return metrics;
+}
+
+void run_scenario(const Scenario& scenario, const std::string& id) {
+    validate_scenario(scenario);
+    const Dataset data = make_dataset(scenario);
+    const std::string path = "benchmark_vector_search_" + id + "_" + scenario.name + ".mdbx";
+    CleanupGuard cleanup_guard(path);
+
+    const mdbxc::VectorMetric metrics[] = {mdbxc::VectorMetric::COSINE, mdbxc::VectorMetric::L2};
+    const std::size_t top_ks[] = {1, 10, 100};
+    const std::vector<IndexConfig> configs = index_configs();
+    for (std::size_t m = 0; m < sizeof(metrics) / sizeof(metrics[0]); ++m) {
+        std::vector<std::vector<std::uint64_t>> truth;
+        std::uint64_t truth_first_id = 0;
+        for (std::size_t c = 0; c < configs.size(); ++c) {
+            cleanup(path);
+            std::shared_ptr<mdbxc::Connection> conn = open_env(path);
+            {
+                mdbxc::VectorStore store(conn, "bench",
+                                         make_options(configs[c], metrics[m], data));
+                std::uint64_t first_id = 0;
+                const IndexMetrics index = build_index(store, configs[c], data, first_id);
+                if (truth.empty() || truth_first_id != first_id) {
+                    truth = exact_neighbours(data, metrics[m], first_id, 100);
+                    truth_first_id = first_id;
+                }
+                for (std::size_t k = 0; k < sizeof(top_ks) / sizeof(top_ks[0]); ++k) {
+                    const SearchMetrics search = measure_search(store, data, truth, top_ks[k]);
+                    print_csv_row(scenario, data, configs[c], metrics[m], index, search);
+                }
+            }
+            conn->disconnect();
+        }
+    }
+}
+
+int run(int argc, char** argv) {
+    const std::vector<Scenario> scenarios = parse_scenarios(argc, argv);
+    const std::string id = run_id();
+    print_csv_header();
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        run_scenario(scenarios[i], id);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL vector_search_benchmark: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "FAIL vector_search_benchmark: non-std exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,51 @@
+# cmake/deps/curl.cmake
+# Provides a libcurl target for the optional direct libcurl HTTP sync client.
+# Unlike cmake/deps/kurlyk.cmake nothing is fetched: the binding drives
+# libcurl's multi interface itself. HTTP/2 needs a libcurl built with nghttp2;
+# without it requests silently stay on HTTP/1.1.
+#
+# Public API:
+#   curl_http_client_provide(
+#       OUT_TARGET <var>     # returns the INTERFACE target name to link against
+#   )
+
+include(CMakeParseArguments)
+
+function(curl_http_client_provide)
+    set(_options)
+    set(_one_value OUT_TARGET)
+    set(_multi_value)
+    cmake_parse_arguments(CURL_HTTP "${_options}" "${_one_value}"
+        "${_multi_value}" ${ARGN})
+
+    if(NOT CURL_HTTP_OUT_TARGET)
+        message(FATAL_ERROR
+            "curl_http_client_provide requires OUT_TARGET <var>")
+    endif()
+
+    if(NOT TARGET mdbxc_curl_http_client)
+        find_package(CURL QUIET)
+        if(NOT TARGET CURL::libcurl)
+            if(WIN32 AND MINGW AND
+                    MDBXC_KURLYK_HTTP_SYNC_MINGW_CURL_FALLBACK)
+                # The MinGW package fallback lives next to the Kurlyk provider.
+                include("${CMAKE_CURRENT_FUNCTION_LIST_DIR}/kurlyk.cmake")
+                mdbxc_mingw_curl_fallback_provide()
+            else()
+                message(FATAL_ERROR
+                    "libcurl was not found. Install libcurl (with nghttp2 "
+                    "for HTTP/2) or set CURL_LIBRARY/CURL_INCLUDE_DIR.")
+            endif()
+        endif()
+        find_package(Threads REQUIRED)
+
+        add_library(mdbxc_curl_http_client INTERFACE)
+        target_compile_definitions(mdbxc_curl_http_client INTERFACE
+            MDBXC_HAS_CURL_HTTP_TRANSPORT=1)
+        target_link_libraries(mdbxc_curl_http_client INTERFACE
+            CURL::libcurl
+            Threads::Threads)
+    endif()
+
+    set(${CURL_HTTP_OUT_TARGET} mdbxc_curl_http_client PARENT_SCOPE)
+endfunction()
@@ -99,3 +99,28 @@ function(mdbx_containers_kurlyk_http_transport_provide)
 
     set(${_out_var} mdbx_containers::kurlyk_http_transport PARENT_SCOPE)
 endfunction()
+
+function(mdbx_containers_curl_http_transport_provide)
+    _mdbxc_transport_backend_parse_out(
+        "mdbx_containers_curl_http_transport_provide"
+        _out_var ${ARGN})
+
+    include("${CMAKE_CURRENT_FUNCTION_LIST_DIR}/deps/curl.cmake")
+    curl_http_client_provide(OUT_TARGET _mdbxc_curl_target)
+
+    if(NOT TARGET mdbx_containers::curl_http_transport)
+        add_library(mdbx_containers_curl_http_transport INTERFACE)
+        target_compile_features(mdbx_containers_curl_http_transport
+            INTERFACE cxx_std_11)
+        target_compile_definitions(mdbx_containers_curl_http_transport
+            INTERFACE MDBXC_SYNC_ENABLED=1)
+        target_link_libraries(mdbx_containers_curl_http_transport
+            INTERFACE
+                mdbx_containers::mdbx_containers
+                ${_mdbxc_curl_target})
+        add_library(mdbx_containers::curl_http_transport ALIAS
+            mdbx_containers_curl_http_transport)
+    endif()
+
+    set(${_out_var} mdbx_containers::curl_http_transport PARENT_SCOPE)
+endfunction()
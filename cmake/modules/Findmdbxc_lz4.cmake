@@ -0,0 +1,23 @@
+# Finds liblz4 for mdbx_containers and provides the mdbxc::lz4 imported target.
+#
+# Used by the build tree when MDBXC_WITH_LZ4 is ON and by the installed package
+# config through find_dependency(mdbxc_lz4). Set MDBXC_LZ4_INCLUDE_DIR and
+# MDBXC_LZ4_LIBRARY to override the search.
+
+include(FindPackageHandleStandardArgs)
+
+find_path(MDBXC_LZ4_INCLUDE_DIR NAMES lz4.h)
+find_library(MDBXC_LZ4_LIBRARY NAMES lz4 lz4_static)
+
+find_package_handle_standard_args(mdbxc_lz4
+    REQUIRED_VARS MDBXC_LZ4_LIBRARY MDBXC_LZ4_INCLUDE_DIR)
+
+if(mdbxc_lz4_FOUND AND NOT TARGET mdbxc::lz4)
+    add_library(mdbxc::lz4 UNKNOWN IMPORTED)
+    set_target_properties(mdbxc::lz4 PROPERTIES
+        IMPORTED_LOCATION "${MDBXC_LZ4_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${MDBXC_LZ4_INCLUDE_DIR}"
+    )
+endif()
+
+mark_as_advanced(MDBXC_LZ4_INCLUDE_DIR MDBXC_LZ4_LIBRARY)
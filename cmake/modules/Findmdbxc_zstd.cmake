@@ -0,0 +1,23 @@
+# Finds libzstd for mdbx_containers and provides the mdbxc::zstd imported target.
+#
+# Used by the build tree when MDBXC_WITH_ZSTD is ON and by the installed package
+# config through find_dependency(mdbxc_zstd). Set MDBXC_ZSTD_INCLUDE_DIR and
+# MDBXC_ZSTD_LIBRARY to override the search.
+
+include(FindPackageHandleStandardArgs)
+
+find_path(MDBXC_ZSTD_INCLUDE_DIR NAMES zstd.h)
+find_library(MDBXC_ZSTD_LIBRARY NAMES zstd zstd_static)
+
+find_package_handle_standard_args(mdbxc_zstd
+    REQUIRED_VARS MDBXC_ZSTD_LIBRARY MDBXC_ZSTD_INCLUDE_DIR)
+
+if(mdbxc_zstd_FOUND AND NOT TARGET mdbxc::zstd)
+    add_library(mdbxc::zstd UNKNOWN IMPORTED)
+    set_target_properties(mdbxc::zstd PROPERTIES
+        IMPORTED_LOCATION "${MDBXC_ZSTD_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${MDBXC_ZSTD_INCLUDE_DIR}"
+    )
+endif()
+
+mark_as_advanced(MDBXC_ZSTD_INCLUDE_DIR MDBXC_ZSTD_LIBRARY)
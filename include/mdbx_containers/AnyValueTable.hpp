@@ -11,6 +11,8 @@
 #include "common.hpp"
 #include <limits>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace mdbxc {
 
@@ -289,6 +291,78 @@ namespace mdbxc {
         }
 #       endif
 
+        /// \brief Visits a trivially copyable value without deserializing it.
+        /// \tparam T Expected value type; must be trivially copyable and use the raw
+        ///         byte layout (no \c to_bytes()/\c from_bytes()).
+        /// \tparam VisitorT Callable invoked as \c visitor(const T&).
+        /// \param key Key to look up.
+        /// \param visitor Receives the stored value.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the key exists and \p visitor was invoked.
+        /// \throws std::bad_cast if the type tag check or the payload size fails.
+        /// \details The reference points into the MDBX page when the payload is
+        /// suitably aligned and to a stack copy otherwise; it is valid only inside
+        /// \p visitor.
+        template <class T, class VisitorT>
+        bool get_view(const KeyT& key, VisitorT visitor, MDBX_txn* txn = nullptr) const {
+            static_assert(std::is_trivially_copyable<T>::value &&
+                          !has_to_bytes<T>::value && !has_from_bytes<T>::value &&
+                          !has_serializer<T>::value,
+                          "AnyValueTable::get_view requires a trivially copyable raw type");
+            bool found = false;
+            with_transaction([this, &key, &visitor, &found](MDBX_txn* t) {
+                SerializeScratch sc_key;
+                MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+                MDBX_val db_val{};
+                int rc = mdbx_get(t, m_dbi, &db_key, &db_val);
+                if (rc == MDBX_NOTFOUND) return;
+                check_mdbx(rc, "Failed to retrieve value");
+                visit_raw<T>(unwrap_and_check_type_tag<T>(db_val), visitor);
+                found = true;
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Visits a trivially copyable value using an external transaction.
+        /// \tparam T Expected value type.
+        /// \tparam VisitorT Callable invoked as \c visitor(const T&).
+        /// \param key Key to look up.
+        /// \param visitor Receives the stored value.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the key exists and \p visitor was invoked.
+        template <class T, class VisitorT>
+        bool get_view(const KeyT& key, VisitorT visitor, const Transaction& txn) const {
+            return get_view<T>(key, visitor, txn.handle());
+        }
+
+        /// \brief Looks up several keys of the same value type with one cursor.
+        /// \tparam T Expected value type.
+        /// \param keys Keys to search for.
+        /// \param txn Optional transaction handle.
+        /// \return Found (key, value) pairs in the order of \p keys.
+        /// \note Missing keys and values failing the type tag check are skipped.
+        template <class T>
+        std::vector<std::pair<KeyT, T>> get_many(const std::vector<KeyT>& keys,
+                                                 MDBX_txn* txn = nullptr) const {
+            std::vector<std::pair<KeyT, T>> result;
+            with_transaction([this, &keys, &result](MDBX_txn* t) {
+                result.clear();
+                db_get_many<T>(keys, result, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Looks up several keys of the same value type using an external transaction.
+        /// \tparam T Expected value type.
+        /// \param keys Keys to search for.
+        /// \param txn Active transaction wrapper.
+        /// \return Found (key, value) pairs in the order of \p keys.
+        template <class T>
+        std::vector<std::pair<KeyT, T>> get_many(const std::vector<KeyT>& keys,
+                                                 const Transaction& txn) const {
+            return get_many<T>(keys, txn.handle());
+        }
+
         // --- Meta ---
 
         /// \brief Check if key exists.
@@ -374,6 +448,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
             auto txn_guard = m_connection->transaction(mode);
             try {
                 action(txn_guard.handle());
@@ -414,6 +489,43 @@ namespace mdbxc {
             return true;
         }
 
+        template <class T>
+        void db_get_many(const std::vector<KeyT>& keys, std::vector<std::pair<KeyT, T>>& out,
+                         MDBX_txn* txn) const {
+            out.reserve(keys.size());
+            CachedCursor cursor(*this, txn);
+            SerializeScratch sc_key;
+            for (typename std::vector<KeyT>::const_iterator it = keys.begin(); it != keys.end(); ++it) {
+                MDBX_val db_key = serialize_key<Options::safe_integer_key>(*it, sc_key);
+                MDBX_val db_val{};
+                int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+                if (rc == MDBX_NOTFOUND) continue;
+                check_mdbx(rc, "Failed to retrieve value");
+                try {
+                    MDBX_val checked = unwrap_and_check_type_tag<T>(db_val);
+                    out.push_back(std::make_pair(*it, deserialize_value<T>(checked)));
+                } catch (const std::bad_cast&) {
+                    // type mismatch -> treat as not found
+                }
+            }
+        }
+
+        /// \brief Passes a raw payload to \p visitor as \c T, copying it when misaligned.
+        template <class T, class VisitorT>
+        static void visit_raw(const MDBX_val& payload, VisitorT& visitor) {
+            if (payload.iov_len != sizeof(T)) {
+                throw std::bad_cast();
+            }
+            const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(payload.iov_base);
+            if (addr % alignof(T) == 0) {
+                visitor(*static_cast<const T*>(payload.iov_base));
+                return;
+            }
+            T copy;
+            std::memcpy(&copy, payload.iov_base, sizeof(T));
+            visitor(static_cast<const T&>(copy));
+        }
+
         bool db_contains(const KeyT& key, MDBX_txn* txn) const {
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -458,7 +570,7 @@ namespace mdbxc {
         MDBX_val wrap_with_type_tag(const MDBX_val& raw, SerializeScratch& sc) const {
             if (!m_check_type_tag) return raw;
 
-            const std::string tag = type_tag<T>();
+            const std::string& tag = type_tag<T>();
             if (tag.size() > static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max())) {
                 throw std::length_error("AnyValueTable type tag is too large");
             }
@@ -494,7 +606,7 @@ namespace mdbxc {
                 throw std::bad_cast();
             }
 
-            const std::string expected = type_tag<T>();
+            const std::string& expected = type_tag<T>();
             if (expected.size() != tag_size ||
                 std::memcmp(data + type_tag_header_size(), expected.data(), tag_size) != 0) {
                 throw std::bad_cast();
@@ -539,9 +651,11 @@ namespace mdbxc {
                    (static_cast<std::uint32_t>(data[3]) << 24);
         }
 
+        /// \brief Returns the type tag of \c T, built once per type.
         template <class T>
-        static std::string type_tag() {
-            return std::string(AnyValueTypeTag<T>::value());
+        static const std::string& type_tag() {
+            static const std::string tag(AnyValueTypeTag<T>::value());
+            return tag;
         }
     };
 
@@ -0,0 +1,919 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_BITMAP_KEY_TABLE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_BITMAP_KEY_TABLE_HPP_INCLUDED
+
+/// \file BitmapKeyTable.hpp
+/// \brief Compressed set of unsigned integers persisted as roaring-style chunks.
+/// \details
+/// Splits every member into its high bits and its low 16 bits. One MDBX
+/// record holds all members sharing the high bits, either as a sorted array
+/// of low halves or as a 65536-bit bitmap, like the containers of a roaring
+/// bitmap. Dense sets take about one bit per member instead of one B-tree
+/// entry per key.
+
+#include "common.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace mdbxc {
+
+    namespace detail {
+
+        /// \brief Index of the lowest set bit of a non-zero \p x.
+        inline unsigned bitmap_ctz64(std::uint64_t x) noexcept {
+#       if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_ctzll(x));
+#       else
+            unsigned n = 0;
+            while ((x & 1) == 0) {
+                x >>= 1;
+                ++n;
+            }
+            return n;
+#       endif
+        }
+
+        /// \brief Number of set bits in \p x.
+        inline std::uint32_t bitmap_popcount64(std::uint64_t x) noexcept {
+#       if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::uint32_t>(__builtin_popcountll(x));
+#       else
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            return static_cast<std::uint32_t>((x * 0x0101010101010101ULL) >> 56);
+#       endif
+        }
+
+        /// \brief Read-only access to one stored chunk of a \ref BitmapKeyTable.
+        /// \details A chunk starts with a 32-bit member count. Up to
+        /// \ref array_limit members follow as sorted 16-bit low halves;
+        /// larger chunks store 1024 64-bit words with one bit per low half.
+        /// Fields use native byte order, like MDBX integer keys. Values in
+        /// the page may be unaligned, so every field is read with \c memcpy.
+        struct BitmapChunkView {
+            static const std::uint32_t array_limit = 4096;
+            static const std::size_t bitmap_words = 1024;
+            static const std::size_t header_size = sizeof(std::uint32_t);
+            static const std::size_t bitmap_size = header_size + bitmap_words * sizeof(std::uint64_t);
+
+            /// \brief Returns the member count after checking the chunk size.
+            /// \throws std::runtime_error if the record is not a valid chunk.
+            static std::uint32_t cardinality(const MDBX_val& val) {
+                std::uint32_t count = 0;
+                if (val.iov_len >= header_size) {
+                    std::memcpy(&count, val.iov_base, header_size);
+                }
+                if (count == 0 || count > 65536 || val.iov_len != stored_size(count)) {
+                    throw std::runtime_error("BitmapKeyTable: corrupt chunk");
+                }
+                return count;
+            }
+
+            /// \brief Size in bytes of a chunk with \p count members.
+            static std::size_t stored_size(std::uint32_t count) noexcept {
+                return count > array_limit
+                    ? bitmap_size
+                    : header_size + count * sizeof(std::uint16_t);
+            }
+
+            static std::uint16_t array_at(const MDBX_val& val, std::size_t i) noexcept {
+                std::uint16_t low;
+                std::memcpy(&low, static_cast<const std::uint8_t*>(val.iov_base) +
+                                  header_size + i * sizeof(low), sizeof(low));
+                return low;
+            }
+
+            static std::uint64_t word_at(const MDBX_val& val, std::size_t i) noexcept {
+                std::uint64_t word;
+                std::memcpy(&word, static_cast<const std::uint8_t*>(val.iov_base) +
+                                   header_size + i * sizeof(word), sizeof(word));
+                return word;
+            }
+
+            /// \brief Index of the first array entry not below \p low.
+            static std::size_t array_lower_bound(const MDBX_val& val, std::uint32_t count,
+                                                 std::uint16_t low) noexcept {
+                std::size_t first = 0;
+                std::size_t len = count;
+                while (len > 0) {
+                    const std::size_t half = len / 2;
+                    if (array_at(val, first + half) < low) {
+                        first += half + 1;
+                        len -= half + 1;
+                    } else {
+                        len = half;
+                    }
+                }
+                return first;
+            }
+
+            static bool contains(const MDBX_val& val, std::uint16_t low) {
+                const std::uint32_t count = cardinality(val);
+                if (count > array_limit) {
+                    return ((word_at(val, low >> 6) >> (low & 63)) & 1) != 0;
+                }
+                const std::size_t i = array_lower_bound(val, count, low);
+                return i < count && array_at(val, i) == low;
+            }
+
+            /// \brief Visits the low halves in <tt>[lo, hi]</tt> in ascending order.
+            /// \return \c false if \p visit stopped early.
+            template<typename VisitT>
+            static bool for_each(const MDBX_val& val, std::uint16_t lo, std::uint16_t hi,
+                                 VisitT& visit) {
+                const std::uint32_t count = cardinality(val);
+                if (count <= array_limit) {
+                    for (std::size_t i = array_lower_bound(val, count, lo); i < count; ++i) {
+                        const std::uint16_t low = array_at(val, i);
+                        if (low > hi) break;
+                        if (!visit(low)) return false;
+                    }
+                    return true;
+                }
+                for (std::size_t w = lo >> 6; w <= static_cast<std::size_t>(hi >> 6); ++w) {
+                    std::uint64_t word = word_at(val, w);
+                    if (w == static_cast<std::size_t>(lo >> 6)) word &= ~0ULL << (lo & 63);
+                    if (w == static_cast<std::size_t>(hi >> 6) && (hi & 63) != 63) {
+                        word &= (1ULL << ((hi & 63) + 1)) - 1;
+                    }
+                    if (!visit_word(w, word, visit)) return false;
+                }
+                return true;
+            }
+
+            /// \brief Visits the low halves present in both chunks in ascending order.
+            /// \return \c false if \p visit stopped early.
+            template<typename VisitT>
+            static bool for_each_common(const MDBX_val& a, const MDBX_val& b, VisitT& visit) {
+                const std::uint32_t count_a = cardinality(a);
+                const std::uint32_t count_b = cardinality(b);
+                if (count_a > array_limit && count_b > array_limit) {
+                    for (std::size_t w = 0; w < bitmap_words; ++w) {
+                        if (!visit_word(w, word_at(a, w) & word_at(b, w), visit)) return false;
+                    }
+                    return true;
+                }
+                if (count_a > array_limit || count_b > array_limit) {
+                    const MDBX_val& array = count_a > array_limit ? b : a;
+                    const MDBX_val& bitmap = count_a > array_limit ? a : b;
+                    const std::uint32_t count = count_a > array_limit ? count_b : count_a;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        const std::uint16_t low = array_at(array, i);
+                        if (((word_at(bitmap, low >> 6) >> (low & 63)) & 1) != 0 && !visit(low)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                std::size_t i = 0;
+                std::size_t j = 0;
+                while (i < count_a && j < count_b) {
+                    const std::uint16_t low_a = array_at(a, i);
+                    const std::uint16_t low_b = array_at(b, j);
+                    if (low_a < low_b) {
+                        ++i;
+                    } else if (low_b < low_a) {
+                        ++j;
+                    } else {
+                        if (!visit(low_a)) return false;
+                        ++i;
+                        ++j;
+                    }
+                }
+                return true;
+            }
+
+            /// \brief Counts the low halves present in both chunks.
+            static std::uint64_t common_count(const MDBX_val& a, const MDBX_val& b) {
+                if (cardinality(a) > array_limit && cardinality(b) > array_limit) {
+                    std::uint64_t total = 0;
+                    for (std::size_t w = 0; w < bitmap_words; ++w) {
+                        total += bitmap_popcount64(word_at(a, w) & word_at(b, w));
+                    }
+                    return total;
+                }
+                std::uint64_t total = 0;
+                auto counter = [&total](std::uint16_t) {
+                    ++total;
+                    return true;
+                };
+                for_each_common(a, b, counter);
+                return total;
+            }
+
+        private:
+            template<typename VisitT>
+            static bool visit_word(std::size_t w, std::uint64_t word, VisitT& visit) {
+                while (word != 0) {
+                    const unsigned bit = bitmap_ctz64(word);
+                    if (!visit(static_cast<std::uint16_t>((w << 6) | bit))) return false;
+                    word &= word - 1;
+                }
+                return true;
+            }
+        };
+
+        /// \brief Decoded chunk modified by \ref BitmapKeyTable writes.
+        /// \details Converts between the array and bitmap forms when the
+        /// member count crosses \ref BitmapChunkView::array_limit.
+        class BitmapChunk {
+        public:
+            BitmapChunk() : m_count(0) {}
+
+            /// \brief Loads a stored chunk.
+            void load(const MDBX_val& val) {
+                m_count = BitmapChunkView::cardinality(val);
+                m_array.clear();
+                m_words.clear();
+                if (m_count > BitmapChunkView::array_limit) {
+                    m_words.resize(BitmapChunkView::bitmap_words);
+                    std::memcpy(&m_words[0],
+                                static_cast<const std::uint8_t*>(val.iov_base) +
+                                BitmapChunkView::header_size,
+                                BitmapChunkView::bitmap_words * sizeof(std::uint64_t));
+                } else {
+                    m_array.resize(m_count);
+                    std::memcpy(&m_array[0],
+                                static_cast<const std::uint8_t*>(val.iov_base) +
+                                BitmapChunkView::header_size,
+                                m_count * sizeof(std::uint16_t));
+                }
+            }
+
+            std::uint32_t cardinality() const noexcept { return m_count; }
+
+            /// \return \c true if \p low was absent.
+            bool add(std::uint16_t low) {
+                if (!m_words.empty()) {
+                    std::uint64_t& word = m_words[low >> 6];
+                    const std::uint64_t bit = 1ULL << (low & 63);
+                    if ((word & bit) != 0) return false;
+                    word |= bit;
+                    ++m_count;
+                    return true;
+                }
+                std::vector<std::uint16_t>::iterator it =
+                    std::lower_bound(m_array.begin(), m_array.end(), low);
+                if (it != m_array.end() && *it == low) return false;
+                m_array.insert(it, low);
+                ++m_count;
+                if (m_count > BitmapChunkView::array_limit) to_bitmap();
+                return true;
+            }
+
+            /// \return \c true if \p low was present.
+            bool remove(std::uint16_t low) {
+                if (!m_words.empty()) {
+                    std::uint64_t& word = m_words[low >> 6];
+                    const std::uint64_t bit = 1ULL << (low & 63);
+                    if ((word & bit) == 0) return false;
+                    word &= ~bit;
+                    --m_count;
+                    if (m_count <= BitmapChunkView::array_limit) to_array();
+                    return true;
+                }
+                std::vector<std::uint16_t>::iterator it =
+                    std::lower_bound(m_array.begin(), m_array.end(), low);
+                if (it == m_array.end() || *it != low) return false;
+                m_array.erase(it);
+                --m_count;
+                return true;
+            }
+
+            /// \brief Serializes the chunk into \p bytes.
+            /// \return View of \p bytes, valid until \p bytes changes.
+            MDBX_val encode(std::vector<std::uint8_t>& bytes) const {
+                bytes.resize(BitmapChunkView::stored_size(m_count));
+                std::memcpy(&bytes[0], &m_count, BitmapChunkView::header_size);
+                if (!m_words.empty()) {
+                    std::memcpy(&bytes[BitmapChunkView::header_size], &m_words[0],
+                                BitmapChunkView::bitmap_words * sizeof(std::uint64_t));
+                } else if (m_count > 0) {
+                    std::memcpy(&bytes[BitmapChunkView::header_size], &m_array[0],
+                                m_count * sizeof(std::uint16_t));
+                }
+                MDBX_val val;
+                val.iov_base = &bytes[0];
+                val.iov_len = bytes.size();
+                return val;
+            }
+
+        private:
+            std::uint32_t m_count;
+            std::vector<std::uint16_t> m_array;
+            std::vector<std::uint64_t> m_words;
+
+            void to_bitmap() {
+                m_words.assign(BitmapChunkView::bitmap_words, 0);
+                for (std::size_t i = 0; i < m_array.size(); ++i) {
+                    m_words[m_array[i] >> 6] |= 1ULL << (m_array[i] & 63);
+                }
+                std::vector<std::uint16_t>().swap(m_array);
+            }
+
+            void to_array() {
+                m_array.clear();
+                m_array.reserve(m_count);
+                for (std::size_t w = 0; w < m_words.size(); ++w) {
+                    std::uint64_t word = m_words[w];
+                    while (word != 0) {
+                        m_array.push_back(static_cast<std::uint16_t>((w << 6) | bitmap_ctz64(word)));
+                        word &= word - 1;
+                    }
+                }
+                std::vector<std::uint64_t>().swap(m_words);
+            }
+        };
+
+    } // namespace detail
+
+    /// \class BitmapKeyTable
+    /// \ingroup mdbxc_tables
+    /// \brief Set of unsigned integers stored as compressed 65536-member chunks.
+    /// \tparam KeyT \c std::uint32_t or \c std::uint64_t.
+    /// \details
+    /// Offers the \ref KeyTable set operations for dense integer key sets
+    /// with hundreds of millions of members. Each MDBX record holds every
+    /// member sharing <tt>key >> 16</tt>: up to 4096 members as a sorted
+    /// array of 2-byte low halves, more as an 8 KiB bitmap. A full chunk
+    /// thus costs about one bit per member, and scans read whole chunks
+    /// instead of walking one B-tree entry per key. \c count() reads only
+    /// chunk headers, and \c intersection_count() ANDs bitmap words.
+    ///
+    /// Every write rewrites the affected chunk, so single-key writes into
+    /// large bitmap chunks cost more than in \ref KeyTable; use
+    /// \c insert_many() to update a chunk once per batch. The storage format
+    /// differs from \ref KeyTable, so the two cannot share a table name.
+    /// With sync capture, writes are recorded as puts and deletes of whole
+    /// chunks.
+    template<class KeyT>
+    class BitmapKeyTable final : public BaseTable {
+        static_assert(std::is_same<KeyT, std::uint32_t>::value ||
+                      std::is_same<KeyT, std::uint64_t>::value,
+                      "BitmapKeyTable supports std::uint32_t and std::uint64_t keys");
+    public:
+        /// \brief Constructs table using existing connection.
+        /// \param connection Existing connection.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param flags Additional MDBX database flags.
+        BitmapKeyTable(std::shared_ptr<Connection> connection,
+                       std::string name = "bitmap_key_store",
+                       MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : BaseTable(std::move(connection),
+                        std::move(name),
+                        flags | get_mdbx_flags<std::uint64_t>()) {}
+
+        /// \brief Constructs table using configuration.
+        /// \param config Configuration settings.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param flags Additional MDBX database flags.
+        explicit BitmapKeyTable(const Config& config,
+                                std::string name = "bitmap_key_store",
+                                MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : BaseTable(Connection::create(config),
+                        std::move(name),
+                        flags | get_mdbx_flags<std::uint64_t>()) {}
+
+        /// \brief Destructor.
+        ~BitmapKeyTable() override = default;
+
+        /// \brief Inserts a key if it is absent.
+        /// \param key Key to insert.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if inserted, \c false if the key already exists.
+        /// \throws MdbxException if a database error occurs.
+        bool insert(KeyT key, MDBX_txn* txn = nullptr) {
+            bool res = false;
+            with_transaction([this, key, &res](MDBX_txn* t) {
+                res = db_insert_run(&key, &key + 1, t) != 0;
+            }, TransactionMode::WRITABLE, txn);
+            return res;
+        }
+
+        /// \brief Inserts a key if it is absent.
+        /// \param key Key to insert.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if inserted, \c false if the key already exists.
+        bool insert(KeyT key, const Transaction& txn) {
+            return insert(key, txn.handle());
+        }
+
+        /// \brief Inserts a batch of keys, rewriting each touched chunk once.
+        /// \param first Start of the input keys, in any order, duplicates allowed.
+        /// \param last End of the input keys.
+        /// \param txn Optional transaction handle.
+        /// \return Number of keys that were absent.
+        /// \throws MdbxException if a database error occurs.
+        template<typename InputIt>
+        std::size_t insert_many(InputIt first, InputIt last, MDBX_txn* txn = nullptr) {
+            std::vector<KeyT> keys(first, last);
+            std::sort(keys.begin(), keys.end());
+            std::size_t res = 0;
+            with_transaction([this, &keys, &res](MDBX_txn* t) {
+                res = 0;
+                typename std::vector<KeyT>::const_iterator it = keys.begin();
+                while (it != keys.end()) {
+                    const std::uint64_t chunk = high_bits(*it);
+                    typename std::vector<KeyT>::const_iterator run_end = it;
+                    while (run_end != keys.end() && high_bits(*run_end) == chunk) ++run_end;
+                    res += db_insert_run(&*it, &*it + (run_end - it), t);
+                    it = run_end;
+                }
+            }, TransactionMode::WRITABLE, txn);
+            return res;
+        }
+
+        /// \brief Inserts a batch of keys, rewriting each touched chunk once.
+        /// \param first Start of the input keys.
+        /// \param last End of the input keys.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of keys that were absent.
+        template<typename InputIt>
+        std::size_t insert_many(InputIt first, InputIt last, const Transaction& txn) {
+            return insert_many(first, last, txn.handle());
+        }
+
+        /// \brief Checks whether a key exists.
+        /// \param key Key to look up.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the key exists.
+        /// \throws MdbxException if a database error occurs.
+        bool contains(KeyT key, MDBX_txn* txn = nullptr) const {
+            bool res = false;
+            with_transaction([this, key, &res](MDBX_txn* t) {
+                res = db_contains(key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Checks whether a key exists.
+        /// \param key Key to look up.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the key exists.
+        bool contains(KeyT key, const Transaction& txn) const {
+            return contains(key, txn.handle());
+        }
+
+        /// \brief Erases a key.
+        /// \param key Key to remove.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the key was removed.
+        /// \throws MdbxException if a database error occurs.
+        bool erase(KeyT key, MDBX_txn* txn = nullptr) {
+            bool res = false;
+            with_transaction([this, key, &res](MDBX_txn* t) {
+                res = db_erase(key, t);
+            }, TransactionMode::WRITABLE, txn);
+            return res;
+        }
+
+        /// \brief Erases a key.
+        /// \param key Key to remove.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the key was removed.
+        bool erase(KeyT key, const Transaction& txn) {
+            return erase(key, txn.handle());
+        }
+
+        /// \brief Counts stored keys.
+        /// \details Reads the header of every chunk, one record per 65536
+        /// possible keys.
+        /// \param txn Optional transaction handle.
+        /// \return Number of keys in the table.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t count(MDBX_txn* txn = nullptr) const {
+            std::uint64_t res = 0;
+            with_transaction([this, &res](MDBX_txn* t) {
+                res = db_count(t);
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Counts stored keys.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of keys in the table.
+        std::uint64_t count(const Transaction& txn) const {
+            return count(txn.handle());
+        }
+
+        /// \brief Checks whether the table has no keys.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the table is empty.
+        bool empty(MDBX_txn* txn = nullptr) const {
+            std::size_t chunks = 0;
+            with_transaction([this, &chunks](MDBX_txn* t) {
+                MDBX_stat stat;
+                check_mdbx(mdbx_dbi_stat(t, m_dbi, &stat, sizeof(stat)),
+                           "Failed to query database statistics");
+                chunks = static_cast<std::size_t>(stat.ms_entries);
+            }, TransactionMode::READ_ONLY, txn);
+            return chunks == 0;
+        }
+
+        /// \brief Checks whether the table has no keys.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the table is empty.
+        bool empty(const Transaction& txn) const {
+            return empty(txn.handle());
+        }
+
+        /// \brief Calls a callback for every key in an inclusive range, in ascending order.
+        /// \param from_key Start key.
+        /// \param to_key End key.
+        /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every key was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_range(KeyT from_key, KeyT to_key,
+                            CallbackT callback, MDBX_txn* txn = nullptr) const {
+            bool completed = false;
+            with_transaction([this, from_key, to_key, &callback, &completed](MDBX_txn* t) {
+                completed = db_for_each_range(from_key, to_key, callback, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Calls a callback for every key in an inclusive range, in ascending order.
+        /// \param from_key Start key.
+        /// \param to_key End key.
+        /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every key was visited, \c false if the callback stopped early.
+        template<typename CallbackT>
+        bool for_each_range(KeyT from_key, KeyT to_key,
+                            CallbackT callback, const Transaction& txn) const {
+            return for_each_range(from_key, to_key, callback, txn.handle());
+        }
+
+        /// \brief Calls a callback for every key in ascending order.
+        /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every key was visited, \c false if the callback stopped early.
+        template<typename CallbackT>
+        bool for_each(CallbackT callback, MDBX_txn* txn = nullptr) const {
+            return for_each_range(0, std::numeric_limits<KeyT>::max(), callback, txn);
+        }
+
+        /// \brief Calls a callback for every key in ascending order.
+        /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every key was visited, \c false if the callback stopped early.
+        template<typename CallbackT>
+        bool for_each(CallbackT callback, const Transaction& txn) const {
+            return for_each(callback, txn.handle());
+        }
+
+        /// \brief Retrieves keys within an inclusive range in ascending order.
+        /// \param from_key Start key.
+        /// \param to_key End key.
+        /// \param txn Optional transaction handle.
+        /// \return Keys from the requested range.
+        std::vector<KeyT> range(KeyT from_key, KeyT to_key, MDBX_txn* txn = nullptr) const {
+            std::vector<KeyT> out;
+            for_each_range(from_key, to_key, [&out](const KeyT& key) {
+                out.push_back(key);
+                return true;
+            }, txn);
+            return out;
+        }
+
+        /// \brief Retrieves keys within an inclusive range in ascending order.
+        /// \param from_key Start key.
+        /// \param to_key End key.
+        /// \param txn Active transaction wrapper.
+        /// \return Keys from the requested range.
+        std::vector<KeyT> range(KeyT from_key, KeyT to_key, const Transaction& txn) const {
+            return range(from_key, to_key, txn.handle());
+        }
+
+        /// \brief Retrieves all keys in ascending order.
+        /// \param txn Optional transaction handle.
+        /// \return All stored keys.
+        std::vector<KeyT> retrieve_all(MDBX_txn* txn = nullptr) const {
+            return range(0, std::numeric_limits<KeyT>::max(), txn);
+        }
+
+        /// \brief Retrieves all keys in ascending order.
+        /// \param txn Active transaction wrapper.
+        /// \return All stored keys.
+        std::vector<KeyT> retrieve_all(const Transaction& txn) const {
+            return retrieve_all(txn.handle());
+        }
+
+        /// \brief Calls a callback for every key present in both tables, in ascending order.
+        /// \details Skips chunks missing from either table with \c MDBX_SET_RANGE
+        /// seeks and intersects matching chunks container by container.
+        /// \param other Table of the same connection.
+        /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every key was visited, \c false if the callback stopped early.
+        /// \throws std::invalid_argument if \p other belongs to another connection.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_intersection(const BitmapKeyTable& other, CallbackT callback,
+                                   MDBX_txn* txn = nullptr) const {
+            check_same_connection(other);
+            bool completed = false;
+            with_transaction([this, &other, &callback, &completed](MDBX_txn* t) {
+                completed = db_intersect(other, t, [&callback](std::uint64_t chunk,
+                                                               const MDBX_val& a,
+                                                               const MDBX_val& b) {
+                    auto emit = [&callback, chunk](std::uint16_t low) {
+                        return static_cast<bool>(callback(make_key(chunk, low)));
+                    };
+                    return detail::BitmapChunkView::for_each_common(a, b, emit);
+                });
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Calls a callback for every key present in both tables, in ascending order.
+        /// \param other Table of the same connection.
+        /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every key was visited, \c false if the callback stopped early.
+        template<typename CallbackT>
+        bool for_each_intersection(const BitmapKeyTable& other, CallbackT callback,
+                                   const Transaction& txn) const {
+            return for_each_intersection(other, callback, txn.handle());
+        }
+
+        /// \brief Returns the keys present in both tables, in ascending order.
+        /// \param other Table of the same connection.
+        /// \param txn Optional transaction handle.
+        std::vector<KeyT> intersect(const BitmapKeyTable& other, MDBX_txn* txn = nullptr) const {
+            std::vector<KeyT> out;
+            for_each_intersection(other, [&out](const KeyT& key) {
+                out.push_back(key);
+                return true;
+            }, txn);
+            return out;
+        }
+
+        /// \brief Returns the keys present in both tables, in ascending order.
+        /// \param other Table of the same connection.
+        /// \param txn Active transaction wrapper.
+        std::vector<KeyT> intersect(const BitmapKeyTable& other, const Transaction& txn) const {
+            return intersect(other, txn.handle());
+        }
+
+        /// \brief Counts the keys present in both tables without visiting them.
+        /// \details Two bitmap chunks are combined with a word-wise AND and a
+        /// population count.
+        /// \param other Table of the same connection.
+        /// \param txn Optional transaction handle.
+        /// \return Size of the intersection.
+        /// \throws std::invalid_argument if \p other belongs to another connection.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t intersection_count(const BitmapKeyTable& other, MDBX_txn* txn = nullptr) const {
+            check_same_connection(other);
+            std::uint64_t res = 0;
+            with_transaction([this, &other, &res](MDBX_txn* t) {
+                res = 0;
+                db_intersect(other, t, [&res](std::uint64_t, const MDBX_val& a, const MDBX_val& b) {
+                    res += detail::BitmapChunkView::common_count(a, b);
+                    return true;
+                });
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Counts the keys present in both tables without visiting them.
+        /// \param other Table of the same connection.
+        /// \param txn Active transaction wrapper.
+        /// \return Size of the intersection.
+        std::uint64_t intersection_count(const BitmapKeyTable& other, const Transaction& txn) const {
+            return intersection_count(other, txn.handle());
+        }
+
+        /// \brief Removes all keys.
+        /// \param txn Optional transaction handle.
+        void clear(MDBX_txn* txn = nullptr) {
+            with_transaction([this](MDBX_txn* t) {
+                db_clear(t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Removes all keys.
+        /// \param txn Active transaction wrapper.
+        void clear(const Transaction& txn) {
+            clear(txn.handle());
+        }
+
+    private:
+        template<typename F>
+        void with_transaction(F&& action, TransactionMode mode, MDBX_txn* txn = nullptr) const {
+            if (txn) {
+                action(checked_external_txn(txn));
+                return;
+            }
+            txn = thread_txn();
+            if (txn) {
+                action(txn);
+                return;
+            }
+            if (try_group_write(action, mode)) return;
+
+            auto txn_guard = m_connection->transaction(mode);
+            try {
+                action(txn_guard.handle());
+                txn_guard.commit();
+            } catch (...) {
+                try { txn_guard.rollback(); } catch (...) {}
+                throw;
+            }
+        }
+
+        static std::uint64_t high_bits(KeyT key) noexcept {
+            return static_cast<std::uint64_t>(key) >> 16;
+        }
+
+        static std::uint16_t low_bits(KeyT key) noexcept {
+            return static_cast<std::uint16_t>(key & 0xFFFFu);
+        }
+
+        static KeyT make_key(std::uint64_t chunk, std::uint16_t low) noexcept {
+            return static_cast<KeyT>((chunk << 16) | low);
+        }
+
+        static MDBX_val chunk_key(std::uint64_t& chunk) noexcept {
+            MDBX_val key;
+            key.iov_base = &chunk;
+            key.iov_len = sizeof(chunk);
+            return key;
+        }
+
+        static std::uint64_t read_chunk_key(const MDBX_val& key) {
+            if (key.iov_len != sizeof(std::uint64_t)) {
+                throw std::runtime_error("BitmapKeyTable: corrupt chunk key");
+            }
+            std::uint64_t chunk;
+            std::memcpy(&chunk, key.iov_base, sizeof(chunk));
+            return chunk;
+        }
+
+        void check_same_connection(const BitmapKeyTable& other) const {
+            if (other.m_connection.get() != m_connection.get()) {
+                throw std::invalid_argument("BitmapKeyTable: tables belong to different connections");
+            }
+        }
+
+        /// \brief Adds a sorted run of keys sharing one chunk.
+        /// \return Number of keys that were absent.
+        std::size_t db_insert_run(const KeyT* first, const KeyT* last, MDBX_txn* txn) {
+            std::uint64_t chunk = high_bits(*first);
+            MDBX_val db_key = chunk_key(chunk);
+            MDBX_val db_val;
+            detail::BitmapChunk bits;
+            const int rc = mdbx_get(txn, m_dbi, &db_key, &db_val);
+            if (rc == MDBX_SUCCESS) {
+                bits.load(db_val);
+            } else if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read bitmap chunk");
+            }
+            std::size_t added = 0;
+            for (; first != last; ++first) {
+                if (bits.add(low_bits(*first))) ++added;
+            }
+            if (added != 0) db_put_chunk(chunk, bits, txn);
+            return added;
+        }
+
+        void db_put_chunk(std::uint64_t chunk, const detail::BitmapChunk& bits, MDBX_txn* txn) {
+            std::vector<std::uint8_t> bytes;
+            MDBX_val db_key = chunk_key(chunk);
+            MDBX_val db_val = bits.encode(bytes);
+            check_mdbx(mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT),
+                       "Failed to write bitmap chunk");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put, db_key, db_val);
+#           endif
+        }
+
+        bool db_contains(KeyT key, MDBX_txn* txn) const {
+            std::uint64_t chunk = high_bits(key);
+            MDBX_val db_key = chunk_key(chunk);
+            MDBX_val db_val;
+            const int rc = mdbx_get(txn, m_dbi, &db_key, &db_val);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to read bitmap chunk");
+            return detail::BitmapChunkView::contains(db_val, low_bits(key));
+        }
+
+        bool db_erase(KeyT key, MDBX_txn* txn) {
+            std::uint64_t chunk = high_bits(key);
+            MDBX_val db_key = chunk_key(chunk);
+            MDBX_val db_val;
+            const int rc = mdbx_get(txn, m_dbi, &db_key, &db_val);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to read bitmap chunk");
+            detail::BitmapChunk bits;
+            bits.load(db_val);
+            if (!bits.remove(low_bits(key))) return false;
+            if (bits.cardinality() != 0) {
+                db_put_chunk(chunk, bits, txn);
+                return true;
+            }
+            check_mdbx(mdbx_del(txn, m_dbi, &db_key, nullptr), "Failed to erase bitmap chunk");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Delete, db_key, MDBX_val());
+#           endif
+            return true;
+        }
+
+        std::uint64_t db_count(MDBX_txn* txn) const {
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key, db_val;
+            std::uint64_t total = 0;
+            int rc = MDBX_SUCCESS;
+            while ((rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT)) == MDBX_SUCCESS) {
+                total += detail::BitmapChunkView::cardinality(db_val);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to count bitmap keys");
+            }
+            return total;
+        }
+
+        template<typename CallbackT>
+        bool db_for_each_range(KeyT from_key, KeyT to_key, CallbackT& callback, MDBX_txn* txn) const {
+            if (from_key > to_key) return true;
+            const std::uint64_t from_chunk = high_bits(from_key);
+            const std::uint64_t to_chunk = high_bits(to_key);
+            CachedCursor cursor(*this, txn);
+            std::uint64_t target = from_chunk;
+            MDBX_val db_key = chunk_key(target);
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                const std::uint64_t chunk = read_chunk_key(db_key);
+                if (chunk > to_chunk) return true;
+                const std::uint16_t lo = chunk == from_chunk ? low_bits(from_key) : 0;
+                const std::uint16_t hi = chunk == to_chunk ? low_bits(to_key) : 0xFFFF;
+                auto emit = [&callback, chunk](std::uint16_t low) {
+                    return static_cast<bool>(callback(make_key(chunk, low)));
+                };
+                if (!detail::BitmapChunkView::for_each(db_val, lo, hi, emit)) return false;
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read bitmap range");
+            }
+            return true;
+        }
+
+        /// \brief Walks the chunks present in both tables.
+        /// \param visit Invoked as \c visit(chunk, this_value, other_value);
+        ///        returns \c false to stop.
+        /// \return \c false if \p visit stopped early.
+        template<typename VisitT>
+        bool db_intersect(const BitmapKeyTable& other, MDBX_txn* txn, VisitT visit) const {
+            CachedCursor a(*this, txn);
+            CachedCursor b(other, txn);
+            MDBX_val key_a, val_a, key_b, val_b;
+            int rc_a = mdbx_cursor_get(a.get(), &key_a, &val_a, MDBX_FIRST);
+            int rc_b = mdbx_cursor_get(b.get(), &key_b, &val_b, MDBX_FIRST);
+            std::uint64_t target = 0;
+            while (rc_a == MDBX_SUCCESS && rc_b == MDBX_SUCCESS) {
+                const std::uint64_t chunk_a = read_chunk_key(key_a);
+                const std::uint64_t chunk_b = read_chunk_key(key_b);
+                if (chunk_a < chunk_b) {
+                    target = chunk_b;
+                    key_a = chunk_key(target);
+                    rc_a = mdbx_cursor_get(a.get(), &key_a, &val_a, MDBX_SET_RANGE);
+                } else if (chunk_b < chunk_a) {
+                    target = chunk_a;
+                    key_b = chunk_key(target);
+                    rc_b = mdbx_cursor_get(b.get(), &key_b, &val_b, MDBX_SET_RANGE);
+                } else {
+                    if (!visit(chunk_a, val_a, val_b)) return false;
+                    rc_a = mdbx_cursor_get(a.get(), &key_a, &val_a, MDBX_NEXT);
+                    rc_b = mdbx_cursor_get(b.get(), &key_b, &val_b, MDBX_NEXT);
+                }
+            }
+            if (rc_a != MDBX_SUCCESS && rc_a != MDBX_NOTFOUND) {
+                check_mdbx(rc_a, "Failed to intersect bitmap tables");
+            }
+            if (rc_b != MDBX_SUCCESS && rc_b != MDBX_NOTFOUND) {
+                check_mdbx(rc_b, "Failed to intersect bitmap tables");
+            }
+            return true;
+        }
+
+        void db_clear(MDBX_txn* txn) {
+            check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear table");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
+#           endif
+        }
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_BITMAP_KEY_TABLE_HPP_INCLUDED
@@ -0,0 +1,865 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_BLOB_TABLE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_BLOB_TABLE_HPP_INCLUDED
+
+/// \file BlobTable.hpp
+/// \brief Large values stored as fixed-size chunks with streaming and ranged access.
+/// \details
+/// A value of tens of megabytes stored as one record occupies one long run
+/// of overflow pages, is read and rewritten in full, and a small update is
+/// captured as a put of the whole value. \ref BlobTable splits each value
+/// into chunks under <tt>(key, chunk_no)</tt> records, so ranged reads and
+/// partial overwrites read, write and replicate only the chunks they touch.
+
+#include "common.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \class BlobTable
+    /// \ingroup mdbxc_tables
+    /// \brief Chunked byte values addressed by a key.
+    /// \tparam KeyT Key type; any type allowed as a composite key field
+    ///         (integers, floating point, strings, byte vectors, pairs and tuples).
+    ///
+    /// Each blob is one header record under the composite encoding of its key,
+    /// holding the blob size and chunk size, followed by chunk records under
+    /// the key encoding plus a big-endian \c std::uint64_t chunk number. All
+    /// chunks except the last hold exactly the chunk size. A chunk that is
+    /// missing, or shorter than the blob size implies, reads as zero bytes,
+    /// so writing past the end stores only the touched chunks.
+    ///
+    /// The chunk size is stored per blob: \c chunk_size applies to blobs the
+    /// table creates or replaces, and existing blobs keep their own. With sync
+    /// capture, writes are recorded as puts and deletes of the header and the
+    /// touched chunks.
+    ///
+    /// \thread_safety Same as other table wrappers: not thread-safe for
+    /// simultaneous operations on the same instance. A \ref Reader or
+    /// \ref Writer must be used by one thread at a time and must not outlive
+    /// its table or transaction.
+    template<class KeyT>
+    class BlobTable final : public BaseTable {
+        static_assert(is_composite_key_field<KeyT>::value,
+                      "BlobTable requires a key type usable as a composite key field");
+
+        /// \brief Header record of one blob, stored in host byte order.
+        struct Header {
+            std::uint64_t size = 0;
+            std::uint32_t chunk_size = 0;
+            std::uint32_t reserved = 0;
+        };
+
+    public:
+        /// \brief Default chunk size; a multiple of the common 4 KiB page.
+        static const std::uint32_t default_chunk_size = 64 * 1024;
+
+        class Reader;
+        class Writer;
+
+        /// \brief Constructs table using existing connection.
+        /// \param connection Existing connection.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param chunk_size Bytes per chunk of new blobs.
+        /// \param flags Additional MDBX database flags.
+        /// \throws std::invalid_argument if \p chunk_size is zero.
+        BlobTable(std::shared_ptr<Connection> connection,
+                  std::string name = "blobs",
+                  std::uint32_t chunk_size = default_chunk_size,
+                  MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : BaseTable(std::move(connection), std::move(name), flags),
+              m_chunk_size(validate_chunk_size(chunk_size)) {}
+
+        /// \brief Constructs table using configuration.
+        /// \param config Configuration settings.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param chunk_size Bytes per chunk of new blobs.
+        /// \param flags Additional MDBX database flags.
+        explicit BlobTable(const Config& config,
+                           std::string name = "blobs",
+                           std::uint32_t chunk_size = default_chunk_size,
+                           MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : BlobTable(Connection::create(config), std::move(name), chunk_size, flags) {}
+
+        /// \brief Destructor.
+        ~BlobTable() override = default;
+
+        /// \brief Returns the chunk size of blobs this table creates.
+        std::uint32_t chunk_size() const noexcept { return m_chunk_size; }
+
+        /// \brief Stores \p size bytes as the whole blob of \p key, replacing any old one.
+        /// \param key Blob key.
+        /// \param data Bytes to store; may be \c nullptr when \p size is zero.
+        /// \param size Number of bytes.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs.
+        void put(const KeyT& key, const void* data, std::size_t size, MDBX_txn* txn = nullptr) {
+            const std::vector<std::uint8_t> prefix = key_prefix(key);
+            with_transaction([this, &prefix, data, size](MDBX_txn* t) {
+                db_put(prefix, static_cast<const std::uint8_t*>(data), size, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Stores \p size bytes as the whole blob of \p key, replacing any old one.
+        /// \param key Blob key.
+        /// \param data Bytes to store.
+        /// \param size Number of bytes.
+        /// \param txn Active transaction wrapper.
+        void put(const KeyT& key, const void* data, std::size_t size, const Transaction& txn) {
+            put(key, data, size, txn.handle());
+        }
+
+        /// \brief Stores \p value as the whole blob of \p key, replacing any old one.
+        /// \param key Blob key.
+        /// \param value Bytes to store.
+        /// \param txn Optional transaction handle.
+        void put(const KeyT& key, const std::vector<std::uint8_t>& value, MDBX_txn* txn = nullptr) {
+            put(key, value.empty() ? nullptr : value.data(), value.size(), txn);
+        }
+
+        /// \brief Stores \p value as the whole blob of \p key, replacing any old one.
+        /// \param key Blob key.
+        /// \param value Bytes to store.
+        /// \param txn Active transaction wrapper.
+        void put(const KeyT& key, const std::vector<std::uint8_t>& value, const Transaction& txn) {
+            put(key, value, txn.handle());
+        }
+
+        /// \brief Reads the whole blob of \p key.
+        /// \param key Blob key.
+        /// \param out Receives the bytes; left unchanged when the blob is absent.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the blob exists.
+        /// \throws MdbxException if a database error occurs.
+        bool get(const KeyT& key, std::vector<std::uint8_t>& out, MDBX_txn* txn = nullptr) const {
+            const std::vector<std::uint8_t> prefix = key_prefix(key);
+            bool found = false;
+            with_transaction([this, &prefix, &out, &found](MDBX_txn* t) {
+                Header header;
+                if (!db_header(prefix, header, t)) return;
+                check_addressable(header.size);
+                std::vector<std::uint8_t> bytes(static_cast<std::size_t>(header.size));
+                db_read(prefix, header, 0, bytes.data(), bytes.size(), t);
+                out.swap(bytes);
+                found = true;
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Reads the whole blob of \p key.
+        /// \param key Blob key.
+        /// \param out Receives the bytes.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the blob exists.
+        bool get(const KeyT& key, std::vector<std::uint8_t>& out, const Transaction& txn) const {
+            return get(key, out, txn.handle());
+        }
+
+        /// \brief Copies up to \p size bytes of the blob of \p key starting at \p offset.
+        /// \details Reads only the chunks overlapping the range.
+        /// \param key Blob key.
+        /// \param offset First byte to read.
+        /// \param out Destination of at least \p size bytes.
+        /// \param size Maximum number of bytes to read.
+        /// \param txn Optional transaction handle.
+        /// \return Bytes copied; 0 when the blob is absent or \p offset is at or past its end.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t read(const KeyT& key, std::uint64_t offset, void* out, std::size_t size,
+                         MDBX_txn* txn = nullptr) const {
+            const std::vector<std::uint8_t> prefix = key_prefix(key);
+            std::size_t copied = 0;
+            with_transaction([this, &prefix, offset, out, size, &copied](MDBX_txn* t) {
+                Header header;
+                if (!db_header(prefix, header, t)) return;
+                copied = db_read(prefix, header, offset, static_cast<std::uint8_t*>(out), size, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return copied;
+        }
+
+        /// \brief Copies up to \p size bytes of the blob of \p key starting at \p offset.
+        /// \param key Blob key.
+        /// \param offset First byte to read.
+        /// \param out Destination of at least \p size bytes.
+        /// \param size Maximum number of bytes to read.
+        /// \param txn Active transaction wrapper.
+        /// \return Bytes copied.
+        std::size_t read(const KeyT& key, std::uint64_t offset, void* out, std::size_t size,
+                         const Transaction& txn) const {
+            return read(key, offset, out, size, txn.handle());
+        }
+
+        /// \brief Returns up to \p size bytes of the blob of \p key starting at \p offset.
+        /// \param key Blob key.
+        /// \param offset First byte to read.
+        /// \param size Maximum number of bytes to read.
+        /// \param txn Optional transaction handle.
+        /// \return The bytes read; empty when the blob is absent or \p offset is past its end.
+        std::vector<std::uint8_t> read_range(const KeyT& key, std::uint64_t offset, std::size_t size,
+                                             MDBX_txn* txn = nullptr) const {
+            const std::vector<std::uint8_t> prefix = key_prefix(key);
+            std::vector<std::uint8_t> out;
+            with_transaction([this, &prefix, offset, size, &out](MDBX_txn* t) {
+                Header header;
+                if (!db_header(prefix, header, t) || offset >= header.size) return;
+                const std::uint64_t available = header.size - offset;
+                out.resize(available < size ? static_cast<std::size_t>(available) : size);
+                db_read(prefix, header, offset, out.data(), out.size(), t);
+            }, TransactionMode::READ_ONLY, txn);
+            return out;
+        }
+
+        /// \brief Returns up to \p size bytes of the blob of \p key starting at \p offset.
+        /// \param key Blob key.
+        /// \param offset First byte to read.
+        /// \param size Maximum number of bytes to read.
+        /// \param txn Active transaction wrapper.
+        std::vector<std::uint8_t> read_range(const KeyT& key, std::uint64_t offset, std::size_t size,
+                                             const Transaction& txn) const {
+            return read_range(key, offset, size, txn.handle());
+        }
+
+        /// \brief Overwrites \p size bytes of the blob of \p key starting at \p offset.
+        /// \details Creates the blob when absent and extends it when the range
+        /// ends past its size; a gap before \p offset reads as zero bytes.
+        /// Chunks covered entirely are written without being read; at most
+        /// the first and last touched chunks are read and rewritten.
+        /// \param key Blob key.
+        /// \param offset First byte to write.
+        /// \param data Bytes to write; may be \c nullptr when \p size is zero.
+        /// \param size Number of bytes.
+        /// \param txn Optional transaction handle.
+        /// \throws std::length_error if the range ends past the largest \c std::uint64_t offset.
+        /// \throws MdbxException if a database error occurs.
+        void write(const KeyT& key, std::uint64_t offset, const void* data, std::size_t size,
+                   MDBX_txn* txn = nullptr) {
+            const std::vector<std::uint8_t> prefix = key_prefix(key);
+            with_transaction([this, &prefix, offset, data, size](MDBX_txn* t) {
+                db_write(prefix, offset, static_cast<const std::uint8_t*>(data), size, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Overwrites \p size bytes of the blob of \p key starting at \p offset.
+        /// \param key Blob key.
+        /// \param offset First byte to write.
+        /// \param data Bytes to write.
+        /// \param size Number of bytes.
+        /// \param txn Active transaction wrapper.
+        void write(const KeyT& key, std::uint64_t offset, const void* data, std::size_t size,
+                   const Transaction& txn) {
+            write(key, offset, data, size, txn.handle());
+        }
+
+        /// \brief Overwrites the bytes of the blob of \p key starting at \p offset with \p value.
+        /// \param key Blob key.
+        /// \param offset First byte to write.
+        /// \param value Bytes to write.
+        /// \param txn Optional transaction handle.
+        void write(const KeyT& key, std::uint64_t offset, const std::vector<std::uint8_t>& value,
+                   MDBX_txn* txn = nullptr) {
+            write(key, offset, value.empty() ? nullptr : value.data(), value.size(), txn);
+        }
+
+        /// \brief Overwrites the bytes of the blob of \p key starting at \p offset with \p value.
+        /// \param key Blob key.
+        /// \param offset First byte to write.
+        /// \param value Bytes to write.
+        /// \param txn Active transaction wrapper.
+        void write(const KeyT& key, std::uint64_t offset, const std::vector<std::uint8_t>& value,
+                   const Transaction& txn) {
+            write(key, offset, value, txn.handle());
+        }
+
+        /// \brief Shortens the blob of \p key to \p size bytes.
+        /// \details Deletes the chunks past the new end and trims the new last
+        /// chunk. A blob that is not longer than \p size is left unchanged.
+        /// \param key Blob key.
+        /// \param size New size.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the blob exists.
+        /// \throws MdbxException if a database error occurs.
+        bool truncate(const KeyT& key, std::uint64_t size, MDBX_txn* txn = nullptr) {
+            const std::vector<std::uint8_t> prefix = key_prefix(key);
+            bool found = false;
+            with_transaction([this, &prefix, size, &found](MDBX_txn* t) {
+                found = db_truncate(prefix, size, t);
+            }, TransactionMode::WRITABLE, txn);
+            return found;
+        }
+
+        /// \brief Shortens the blob of \p key to \p size bytes.
+        /// \param key Blob key.
+        /// \param size New size.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the blob exists.
+        bool truncate(const KeyT& key, std::uint64_t size, const Transaction& txn) {
+            return truncate(key, size, txn.handle());
+        }
+
+        /// \brief Returns the size of the blob of \p key.
+        /// \param key Blob key.
+        /// \param size Receives the size in bytes; left unchanged when the blob is absent.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the blob exists.
+        bool size(const KeyT& key, std::uint64_t& size, MDBX_txn* txn = nullptr) const {
+            const std::vector<std::uint8_t> prefix = key_prefix(key);
+            bool found = false;
+            with_transaction([this, &prefix, &size, &found](MDBX_txn* t) {
+                Header header;
+                found = db_header(prefix, header, t);
+                if (found) size = header.size;
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Returns the size of the blob of \p key.
+        /// \param key Blob key.
+        /// \param size Receives the size in bytes.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the blob exists.
+        bool size(const KeyT& key, std::uint64_t& size, const Transaction& txn) const {
+            return this->size(key, size, txn.handle());
+        }
+
+        /// \brief Checks whether a blob exists for \p key.
+        /// \param key Blob key.
+        /// \param txn Optional transaction handle.
+        bool contains(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            std::uint64_t ignored = 0;
+            return size(key, ignored, txn);
+        }
+
+        /// \brief Checks whether a blob exists for \p key.
+        /// \param key Blob key.
+        /// \param txn Active transaction wrapper.
+        bool contains(const KeyT& key, const Transaction& txn) const {
+            return contains(key, txn.handle());
+        }
+
+        /// \brief Removes the blob of \p key with all its chunks.
+        /// \param key Blob key.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the blob existed.
+        /// \throws MdbxException if a database error occurs.
+        bool erase(const KeyT& key, MDBX_txn* txn = nullptr) {
+            const std::vector<std::uint8_t> prefix = key_prefix(key);
+            bool found = false;
+            with_transaction([this, &prefix, &found](MDBX_txn* t) {
+                found = db_erase(prefix, t);
+            }, TransactionMode::WRITABLE, txn);
+            return found;
+        }
+
+        /// \brief Removes the blob of \p key with all its chunks.
+        /// \param key Blob key.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the blob existed.
+        bool erase(const KeyT& key, const Transaction& txn) {
+            return erase(key, txn.handle());
+        }
+
+        /// \brief Removes all blobs.
+        /// \param txn Optional transaction handle.
+        void clear(MDBX_txn* txn = nullptr) {
+            with_transaction([this](MDBX_txn* t) {
+                db_clear(t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Removes all blobs.
+        /// \param txn Active transaction wrapper.
+        void clear(const Transaction& txn) {
+            clear(txn.handle());
+        }
+
+        /// \brief Opens a sequential reader over the blob of \p key.
+        /// \details The size and chunk size are read once here. Without
+        /// \p txn every \ref Reader::read() runs in its own read transaction,
+        /// so a concurrent writer may be observed mid-stream; pass a
+        /// transaction to read one snapshot.
+        /// \param key Blob key.
+        /// \param txn Optional transaction handle that outlives the reader.
+        /// \throws std::out_of_range if the blob does not exist.
+        Reader reader(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            Reader out(*this, key_prefix(key), txn);
+            bool found = false;
+            with_transaction([this, &out, &found](MDBX_txn* t) {
+                found = db_header(out.m_prefix, out.m_header, t);
+            }, TransactionMode::READ_ONLY, txn);
+            if (!found) {
+                throw std::out_of_range("BlobTable::reader: blob not found");
+            }
+            return out;
+        }
+
+        /// \brief Opens a sequential reader over the blob of \p key.
+        /// \param key Blob key.
+        /// \param txn Active transaction wrapper that outlives the reader.
+        Reader reader(const KeyT& key, const Transaction& txn) const {
+            return reader(key, txn.handle());
+        }
+
+        /// \brief Opens a writer that replaces the blob of \p key with streamed bytes.
+        /// \details Opening empties the blob. Full chunks are written as soon
+        /// as they are filled, so at most one chunk is buffered; the size is
+        /// stored by \ref Writer::close(). Without \p txn the reset and every
+        /// chunk commit on their own and readers see an empty blob until
+        /// \c close(); pass a transaction to replace the blob atomically.
+        /// \param key Blob key.
+        /// \param txn Optional transaction handle that outlives the writer.
+        /// \throws MdbxException if a database error occurs.
+        Writer writer(const KeyT& key, MDBX_txn* txn = nullptr) {
+            Writer out(*this, key_prefix(key), txn);
+            with_transaction([this, &out](MDBX_txn* t) {
+                db_put(out.m_prefix, nullptr, 0, t);
+            }, TransactionMode::WRITABLE, txn);
+            return out;
+        }
+
+        /// \brief Opens a writer that replaces the blob of \p key with streamed bytes.
+        /// \param key Blob key.
+        /// \param txn Active transaction wrapper that outlives the writer.
+        Writer writer(const KeyT& key, const Transaction& txn) {
+            return writer(key, txn.handle());
+        }
+
+        /// \class Reader
+        /// \brief Sequential, seekable reader over one blob.
+        class Reader {
+        public:
+            /// \brief Copies up to \p size bytes at the current position and advances it.
+            /// \return Bytes copied; 0 at the end of the blob.
+            /// \throws MdbxException if a database error occurs.
+            std::size_t read(void* out, std::size_t size) {
+                std::size_t copied = 0;
+                m_table->with_transaction([this, out, size, &copied](MDBX_txn* t) {
+                    copied = m_table->db_read(m_prefix, m_header, m_position,
+                                              static_cast<std::uint8_t*>(out), size, t);
+                }, TransactionMode::READ_ONLY, m_txn);
+                m_position += copied;
+                return copied;
+            }
+
+            /// \brief Moves the position to \p position; past the end, reads return 0.
+            void seek(std::uint64_t position) noexcept { m_position = position; }
+
+            /// \brief Returns the current position.
+            std::uint64_t tell() const noexcept { return m_position; }
+
+            /// \brief Returns the blob size read when the reader was opened.
+            std::uint64_t size() const noexcept { return m_header.size; }
+
+        private:
+            friend class BlobTable;
+
+            Reader(const BlobTable& table, std::vector<std::uint8_t> prefix, MDBX_txn* txn)
+                : m_table(&table), m_prefix(std::move(prefix)), m_txn(txn) {}
+
+            const BlobTable*          m_table;
+            std::vector<std::uint8_t> m_prefix;
+            MDBX_txn*                 m_txn;
+            Header                    m_header;
+            std::uint64_t             m_position = 0;
+        };
+
+        /// \class Writer
+        /// \brief Streams bytes into one blob, one chunk at a time.
+        /// \details Destroying an open writer calls \ref close() and ignores
+        /// its errors; call \c close() to see them.
+        class Writer {
+        public:
+            Writer(Writer&& other) noexcept
+                : m_table(other.m_table), m_prefix(std::move(other.m_prefix)),
+                  m_txn(other.m_txn), m_chunk_size(other.m_chunk_size),
+                  m_written(other.m_written), m_next_chunk(other.m_next_chunk),
+                  m_buffer(std::move(other.m_buffer)), m_open(other.m_open) {
+                other.m_open = false;
+            }
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+            Writer& operator=(Writer&&) = delete;
+
+            ~Writer() {
+                if (!m_open) return;
+                try {
+                    close();
+                } catch (...) {
+                    // Destructors must not throw; close() reports errors.
+                }
+            }
+
+            /// \brief Appends \p size bytes, writing every chunk that fills up.
+            /// \throws std::logic_error if the writer is closed.
+            /// \throws MdbxException if a database error occurs.
+            void write(const void* data, std::size_t size) {
+                if (!m_open) {
+                    throw std::logic_error("BlobTable::Writer: write after close");
+                }
+                const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+                while (size != 0) {
+                    if (m_buffer.empty() && size >= m_chunk_size) {
+                        put_chunk(p, m_chunk_size);
+                        p += m_chunk_size;
+                        size -= m_chunk_size;
+                        continue;
+                    }
+                    const std::size_t take = std::min<std::size_t>(size, m_chunk_size - m_buffer.size());
+                    m_buffer.insert(m_buffer.end(), p, p + take);
+                    p += take;
+                    size -= take;
+                    if (m_buffer.size() == m_chunk_size) {
+                        put_chunk(m_buffer.data(), m_buffer.size());
+                        m_buffer.clear();
+                    }
+                }
+            }
+
+            /// \brief Appends \p value.
+            void write(const std::vector<std::uint8_t>& value) {
+                write(value.empty() ? nullptr : value.data(), value.size());
+            }
+
+            /// \brief Returns the bytes written so far.
+            std::uint64_t size() const noexcept { return m_written + m_buffer.size(); }
+
+            /// \brief Writes the buffered tail and the blob size; later calls do nothing.
+            /// \throws MdbxException if a database error occurs.
+            void close() {
+                if (!m_open) return;
+                m_open = false;
+                const std::uint64_t total = size();
+                const std::vector<std::uint8_t> tail(std::move(m_buffer));
+                const std::uint64_t chunk = m_next_chunk;
+                m_table->with_transaction([this, &tail, total, chunk](MDBX_txn* t) {
+                    if (!tail.empty()) {
+                        m_table->db_put_chunk(m_prefix, chunk, tail.data(), tail.size(), t);
+                    }
+                    Header header;
+                    header.size = total;
+                    header.chunk_size = m_chunk_size;
+                    m_table->db_put_header(m_prefix, header, t);
+                }, TransactionMode::WRITABLE, m_txn);
+            }
+
+        private:
+            friend class BlobTable;
+
+            Writer(BlobTable& table, std::vector<std::uint8_t> prefix, MDBX_txn* txn)
+                : m_table(&table), m_prefix(std::move(prefix)), m_txn(txn),
+                  m_chunk_size(table.m_chunk_size) {
+                m_buffer.reserve(m_chunk_size);
+            }
+
+            void put_chunk(const std::uint8_t* data, std::size_t size) {
+                const std::uint64_t chunk = m_next_chunk;
+                m_table->with_transaction([this, chunk, data, size](MDBX_txn* t) {
+                    m_table->db_put_chunk(m_prefix, chunk, data, size, t);
+                }, TransactionMode::WRITABLE, m_txn);
+                ++m_next_chunk;
+                m_written += size;
+            }
+
+            BlobTable*                m_table;
+            std::vector<std::uint8_t> m_prefix;
+            MDBX_txn*                 m_txn;
+            std::uint32_t             m_chunk_size;
+            std::uint64_t             m_written = 0;
+            std::uint64_t             m_next_chunk = 0;
+            std::vector<std::uint8_t> m_buffer;
+            bool                      m_open = true;
+        };
+
+    private:
+        static const std::size_t chunk_suffix_size = sizeof(std::uint64_t);
+
+        std::uint32_t m_chunk_size;
+
+        template<typename F>
+        void with_transaction(F&& action, TransactionMode mode, MDBX_txn* txn = nullptr) const {
+            if (txn) {
+                action(checked_external_txn(txn));
+                return;
+            }
+            txn = thread_txn();
+            if (txn) {
+                action(txn);
+                return;
+            }
+            if (try_group_write(action, mode)) return;
+
+            auto txn_guard = m_connection->transaction(mode);
+            try {
+                action(txn_guard.handle());
+                txn_guard.commit();
+            } catch (...) {
+                try { txn_guard.rollback(); } catch (...) {}
+                throw;
+            }
+        }
+
+        static std::uint32_t validate_chunk_size(std::uint32_t chunk_size) {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("BlobTable: chunk_size must be positive");
+            }
+            return chunk_size;
+        }
+
+        static void check_addressable(std::uint64_t size) {
+            if (size > static_cast<std::uint64_t>(std::numeric_limits<std::size_t>::max())) {
+                throw std::length_error("BlobTable: blob does not fit in memory");
+            }
+        }
+
+        static std::vector<std::uint8_t> key_prefix(const KeyT& key) {
+            std::vector<std::uint8_t> prefix;
+            detail::append_composite_field(key, prefix);
+            return prefix;
+        }
+
+        static MDBX_val view(const std::vector<std::uint8_t>& bytes) noexcept {
+            MDBX_val val;
+            val.iov_base = const_cast<std::uint8_t*>(bytes.data());
+            val.iov_len = bytes.size();
+            return val;
+        }
+
+        /// \brief Builds the key of chunk \p chunk in \p out and returns a view of it.
+        static MDBX_val chunk_key(const std::vector<std::uint8_t>& prefix, std::uint64_t chunk,
+                                  std::vector<std::uint8_t>& out) {
+            out.assign(prefix.begin(), prefix.end());
+            detail::append_composite_field(chunk, out);
+            return view(out);
+        }
+
+        /// \brief Whether \p key is a chunk key of the blob with \p prefix.
+        static bool is_chunk_key(const MDBX_val& key, const std::vector<std::uint8_t>& prefix) noexcept {
+            return key.iov_len == prefix.size() + chunk_suffix_size &&
+                   mdbx_val_has_prefix(key, view(prefix));
+        }
+
+        bool db_header(const std::vector<std::uint8_t>& prefix, Header& header, MDBX_txn* txn) const {
+            MDBX_val db_key = view(prefix);
+            MDBX_val db_val;
+            const int rc = mdbx_get(txn, m_dbi, &db_key, &db_val);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to read blob header");
+            if (db_val.iov_len != sizeof(Header)) {
+                throw std::runtime_error("BlobTable: unexpected blob header size");
+            }
+            std::memcpy(&header, db_val.iov_base, sizeof(Header));
+            if (header.chunk_size == 0) {
+                throw std::runtime_error("BlobTable: blob header has zero chunk size");
+            }
+            return true;
+        }
+
+        void db_put_header(const std::vector<std::uint8_t>& prefix, const Header& header, MDBX_txn* txn) {
+            MDBX_val db_key = view(prefix);
+            MDBX_val db_val;
+            db_val.iov_base = const_cast<Header*>(&header);
+            db_val.iov_len = sizeof(Header);
+            check_mdbx(mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT),
+                       "Failed to write blob header");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put, db_key, db_val);
+#           endif
+        }
+
+        void db_put_chunk(const std::vector<std::uint8_t>& prefix, std::uint64_t chunk,
+                          const std::uint8_t* data, std::size_t size, MDBX_txn* txn) {
+            std::vector<std::uint8_t> key_bytes;
+            MDBX_val db_key = chunk_key(prefix, chunk, key_bytes);
+            MDBX_val db_val;
+            db_val.iov_base = const_cast<std::uint8_t*>(data);
+            db_val.iov_len = size;
+            check_mdbx(mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT),
+                       "Failed to write blob chunk");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put, db_key, db_val);
+#           endif
+        }
+
+        /// \brief Deletes the chunks numbered \p first and above.
+        void db_erase_chunks_from(const std::vector<std::uint8_t>& prefix, std::uint64_t first,
+                                  MDBX_txn* txn) {
+            std::vector<std::uint8_t> key_bytes;
+            MDBX_val db_key = chunk_key(prefix, first, key_bytes);
+            MDBX_val db_val;
+            CachedCursor cursor(*this, txn);
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS && is_chunk_key(db_key, prefix)) {
+#               if MDBXC_SYNC_ENABLED
+                const std::vector<std::uint8_t> kbytes = capture_bytes(db_key);
+#               endif
+                check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to erase blob chunk");
+#               if MDBXC_SYNC_ENABLED
+                record_op(txn, sync::ChangeOpType::Delete, kbytes, MDBX_val());
+#               endif
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to erase blob chunks");
+            }
+        }
+
+        /// \brief Replaces the blob with \p size bytes; \p data may be null when empty.
+        void db_put(const std::vector<std::uint8_t>& prefix, const std::uint8_t* data,
+                    std::size_t size, MDBX_txn* txn) {
+            std::uint64_t chunk = 0;
+            for (std::size_t offset = 0; offset < size; offset += m_chunk_size, ++chunk) {
+                const std::size_t take = std::min<std::size_t>(m_chunk_size, size - offset);
+                db_put_chunk(prefix, chunk, data + offset, take, txn);
+            }
+            db_erase_chunks_from(prefix, chunk, txn);
+            Header header;
+            header.size = size;
+            header.chunk_size = m_chunk_size;
+            db_put_header(prefix, header, txn);
+        }
+
+        /// \brief Copies up to \p size bytes at \p offset; missing bytes read as zero.
+        std::size_t db_read(const std::vector<std::uint8_t>& prefix, const Header& header,
+                            std::uint64_t offset, std::uint8_t* out, std::size_t size,
+                            MDBX_txn* txn) const {
+            if (offset >= header.size) return 0;
+            const std::uint64_t available = header.size - offset;
+            const std::size_t total = available < size ? static_cast<std::size_t>(available) : size;
+            const std::uint64_t chunk_size = header.chunk_size;
+            std::vector<std::uint8_t> key_bytes;
+            std::uint64_t position = offset;
+            std::size_t done = 0;
+            while (done < total) {
+                const std::uint64_t chunk = position / chunk_size;
+                const std::size_t in_chunk = static_cast<std::size_t>(position % chunk_size);
+                const std::size_t take = static_cast<std::size_t>(
+                    std::min<std::uint64_t>(total - done, chunk_size - in_chunk));
+                MDBX_val db_key = chunk_key(prefix, chunk, key_bytes);
+                MDBX_val db_val;
+                const int rc = mdbx_get(txn, m_dbi, &db_key, &db_val);
+                std::size_t copied = 0;
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to read blob chunk");
+                    if (db_val.iov_len > in_chunk) {
+                        copied = std::min(take, db_val.iov_len - in_chunk);
+                        std::memcpy(out + done, static_cast<const std::uint8_t*>(db_val.iov_base) + in_chunk,
+                                    copied);
+                    }
+                }
+                if (copied < take) std::memset(out + done + copied, 0, take - copied);
+                done += take;
+                position += take;
+            }
+            return total;
+        }
+
+        void db_write(const std::vector<std::uint8_t>& prefix, std::uint64_t offset,
+                      const std::uint8_t* data, std::size_t size, MDBX_txn* txn) {
+            Header header;
+            const bool exists = db_header(prefix, header, txn);
+            if (!exists) {
+                header.size = 0;
+                header.chunk_size = m_chunk_size;
+            }
+            if (offset > std::numeric_limits<std::uint64_t>::max() - size) {
+                throw std::length_error("BlobTable::write: range ends past the largest offset");
+            }
+            const std::uint64_t end = offset + size;
+            const std::uint64_t new_size = std::max(header.size, end);
+            const std::uint64_t chunk_size = header.chunk_size;
+            std::vector<std::uint8_t> key_bytes;
+            std::vector<std::uint8_t> buffer;
+            std::uint64_t position = offset;
+            while (position < end) {
+                const std::uint64_t chunk = position / chunk_size;
+                const std::uint64_t chunk_start = chunk * chunk_size;
+                const std::size_t in_chunk = static_cast<std::size_t>(position - chunk_start);
+                const std::size_t take = static_cast<std::size_t>(
+                    std::min<std::uint64_t>(end - position, chunk_size - in_chunk));
+                const std::size_t chunk_len = static_cast<std::size_t>(
+                    std::min<std::uint64_t>(chunk_size, new_size - chunk_start));
+                if (in_chunk == 0 && take == chunk_len) {
+                    db_put_chunk(prefix, chunk, data, take, txn);
+                } else {
+                    // Keep the old bytes of a partly covered chunk; bytes past
+                    // the old size read as zero even if a stale chunk holds more.
+                    buffer.assign(chunk_len, 0);
+                    if (chunk_start < header.size) {
+                        MDBX_val db_key = chunk_key(prefix, chunk, key_bytes);
+                        MDBX_val db_val;
+                        const int rc = mdbx_get(txn, m_dbi, &db_key, &db_val);
+                        if (rc != MDBX_NOTFOUND) {
+                            check_mdbx(rc, "Failed to read blob chunk");
+                            const std::size_t keep = static_cast<std::size_t>(std::min<std::uint64_t>(
+                                std::min<std::uint64_t>(db_val.iov_len, chunk_len),
+                                header.size - chunk_start));
+                            std::memcpy(buffer.data(), db_val.iov_base, keep);
+                        }
+                    }
+                    std::memcpy(buffer.data() + in_chunk, data, take);
+                    db_put_chunk(prefix, chunk, buffer.data(), buffer.size(), txn);
+                }
+                data += take;
+                position += take;
+            }
+            if (!exists || new_size != header.size) {
+                header.size = new_size;
+                db_put_header(prefix, header, txn);
+            }
+        }
+
+        bool db_truncate(const std::vector<std::uint8_t>& prefix, std::uint64_t size, MDBX_txn* txn) {
+            Header header;
+            if (!db_header(prefix, header, txn)) return false;
+            if (size >= header.size) return true;
+            const std::uint64_t chunk_size = header.chunk_size;
+            const std::uint64_t last = size / chunk_size;
+            const std::size_t last_len = static_cast<std::size_t>(size % chunk_size);
+            db_erase_chunks_from(prefix, last_len == 0 ? last : last + 1, txn);
+            if (last_len != 0) {
+                std::vector<std::uint8_t> key_bytes;
+                MDBX_val db_key = chunk_key(prefix, last, key_bytes);
+                MDBX_val db_val;
+                const int rc = mdbx_get(txn, m_dbi, &db_key, &db_val);
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to read blob chunk");
+                    if (db_val.iov_len > last_len) {
+                        const std::uint8_t* bytes = static_cast<const std::uint8_t*>(db_val.iov_base);
+                        const std::vector<std::uint8_t> kept(bytes, bytes + last_len);
+                        db_put_chunk(prefix, last, kept.data(), kept.size(), txn);
+                    }
+                }
+            }
+            header.size = size;
+            db_put_header(prefix, header, txn);
+            return true;
+        }
+
+        bool db_erase(const std::vector<std::uint8_t>& prefix, MDBX_txn* txn) {
+            MDBX_val db_key = view(prefix);
+            const int rc = mdbx_del(txn, m_dbi, &db_key, nullptr);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to erase blob header");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Delete, db_key, MDBX_val());
+#           endif
+            db_erase_chunks_from(prefix, 0, txn);
+            return true;
+        }
+
+        void db_clear(MDBX_txn* txn) {
+            check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear table");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
+#           endif
+        }
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_BLOB_TABLE_HPP_INCLUDED
@@ -0,0 +1,450 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_CACHED_KEY_VALUE_TABLE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_CACHED_KEY_VALUE_TABLE_HPP_INCLUDED
+
+/// \file CachedKeyValueTable.hpp
+/// \brief Read-through LRU cache of deserialized values over a \ref KeyValueTable.
+
+#include "KeyValueTable.hpp"
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace mdbxc {
+
+    /// \struct CacheStats
+    /// \brief Counters of a \ref CachedKeyValueTable cache.
+    struct CacheStats {
+        std::uint64_t hits = 0;          ///< Lookups answered from the cache.
+        std::uint64_t misses = 0;        ///< Lookups that read the table.
+        std::uint64_t evictions = 0;     ///< Entries dropped to stay within the memory budget.
+        std::uint64_t invalidations = 0; ///< Entries dropped by writes or remote sync applies.
+        std::size_t   entries = 0;       ///< Entries currently cached, absent keys included.
+        std::size_t   bytes = 0;         ///< Estimated memory charged to cached entries.
+
+        /// \brief Returns the share of lookups answered from the cache.
+        double hit_ratio() const {
+            const std::uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+        }
+    };
+
+    /// \class CachedKeyValueTable
+    /// \ingroup mdbxc_tables
+    /// \brief \ref KeyValueTable with an in-process cache of deserialized values.
+    /// \tparam KeyT Type of the keys.
+    /// \tparam ValueT Type of the values.
+    /// \tparam Options Compile-time table policy, as for \ref KeyValueTable.
+    /// \details
+    /// Point reads return values from a sharded LRU cache keyed by the
+    /// serialized key; a miss reads the table and caches the result, absent
+    /// keys included. Each shard has its own mutex and an equal part of the
+    /// memory budget, charged with the serialized key and value sizes plus a
+    /// fixed per-entry overhead.
+    ///
+    /// Writes through this wrapper commit their own transaction and then drop
+    /// the written keys. Remote sync applies drop the keys they wrote to this
+    /// table, or the whole cache on a remote clear. A miss that raced with an
+    /// invalidation in its shard is returned but not cached, so a read never
+    /// re-inserts a value older than a committed write.
+    ///
+    /// \note Every operation opens its own transaction and throws
+    ///       \c std::logic_error when the calling thread already has one on
+    ///       the connection. Writes made through \ref table() or another
+    ///       table object on the same DBI are not seen; call
+    ///       \ref invalidate() or \ref invalidate_all() after committing them.
+    template<class KeyT, class ValueT, class Options = DefaultTableOptions>
+    class CachedKeyValueTable {
+    public:
+        typedef KeyValueTable<KeyT, ValueT, Options> table_type;
+
+        /// \brief Default memory budget in bytes.
+        static const std::size_t default_budget_bytes = std::size_t(64) << 20;
+
+        /// \brief Default number of cache shards.
+        static const std::size_t default_shard_count = 16;
+
+        /// \brief Opens table \p name and an empty cache.
+        /// \param connection Existing \ref Connection instance.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param budget_bytes Memory budget of the cache.
+        /// \param shard_count Number of independently locked cache shards.
+        /// \param flags Additional MDBX database flags.
+        /// \throws std::invalid_argument if \p shard_count is zero.
+        CachedKeyValueTable(std::shared_ptr<Connection> connection,
+                            std::string name = "kv_store",
+                            std::size_t budget_bytes = default_budget_bytes,
+                            std::size_t shard_count = default_shard_count,
+                            MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : m_connection(std::move(connection)),
+              m_name(name),
+              m_table(m_connection, std::move(name), flags),
+              m_budget_bytes(budget_bytes),
+              m_shards(make_shards(shard_count)) {
+#           if MDBXC_SYNC_ENABLED
+            m_apply_observer.reset(new ApplyObserver(*this));
+            m_apply_observer_token = m_connection->add_sync_apply_observer(m_apply_observer.get());
+#           endif
+        }
+
+        /// \brief Constructor with configuration.
+        /// \param config Configuration settings for the database.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param budget_bytes Memory budget of the cache.
+        /// \param shard_count Number of independently locked cache shards.
+        /// \param flags Additional MDBX database flags.
+        explicit CachedKeyValueTable(const Config& config,
+                                     std::string name = "kv_store",
+                                     std::size_t budget_bytes = default_budget_bytes,
+                                     std::size_t shard_count = default_shard_count,
+                                     MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : CachedKeyValueTable(Connection::create(config), std::move(name),
+                                  budget_bytes, shard_count, flags) {}
+
+        ~CachedKeyValueTable() {
+#           if MDBXC_SYNC_ENABLED
+            // Waits for callbacks in flight on other threads.
+            m_connection->remove_sync_apply_observer(m_apply_observer_token);
+#           endif
+        }
+
+        CachedKeyValueTable(const CachedKeyValueTable&) = delete;
+        CachedKeyValueTable& operator=(const CachedKeyValueTable&) = delete;
+
+        /// \brief Returns the connection.
+        const std::shared_ptr<Connection>& connection() const noexcept { return m_connection; }
+
+        /// \brief Returns the underlying table for uncached access.
+        table_type& table() noexcept { return m_table; }
+
+        /// \brief Returns the underlying table for uncached access.
+        const table_type& table() const noexcept { return m_table; }
+
+        /// \brief Returns the memory budget in bytes.
+        std::size_t budget_bytes() const noexcept { return m_budget_bytes; }
+
+        /// \brief Returns the number of cache shards.
+        std::size_t shard_count() const noexcept { return m_shards.size(); }
+
+        // --- Reads ---
+
+        /// \brief Returns the cached value of \p key, reading the table on a miss.
+        /// \return Shared immutable value, or \c nullptr if the key is absent.
+        /// \throws MdbxException if a database error occurs.
+        std::shared_ptr<const ValueT> get(const KeyT& key) const {
+            SerializeScratch sc;
+            const MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc);
+            const std::string storage_key(static_cast<const char*>(db_key.iov_base), db_key.iov_len);
+            Shard& shard = shard_of(storage_key);
+            std::uint64_t epoch = 0;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                typename Shard::Index::iterator it = shard.index.find(storage_key);
+                if (it != shard.index.end()) {
+                    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                    m_hits.fetch_add(1, std::memory_order_relaxed);
+                    return it->second->value;
+                }
+                // Taken before the read transaction starts, see cache_loaded().
+                epoch = shard.epoch;
+            }
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+
+            std::shared_ptr<const ValueT> value;
+            std::size_t value_bytes = 0;
+            Transaction txn = m_connection->transaction(TransactionMode::READ_ONLY);
+            m_table.find_view(key, [&value, &value_bytes](const ByteView& view) {
+                MDBX_val db_val;
+                db_val.iov_base = const_cast<void*>(view.data);
+                db_val.iov_len = view.size;
+                value = std::make_shared<const ValueT>(deserialize_value<ValueT>(db_val));
+                value_bytes = view.size;
+            }, txn);
+            txn.commit();
+
+            cache_loaded(shard, storage_key, value, value_bytes, epoch);
+            return value;
+        }
+
+        /// \brief Returns a copy of the value of \p key.
+        /// \throws std::out_of_range if the key is absent.
+        /// \throws MdbxException if a database error occurs.
+        ValueT at(const KeyT& key) const {
+            std::shared_ptr<const ValueT> value = get(key);
+            if (!value) throw std::out_of_range("Key not found");
+            return *value;
+        }
+
+#       if __cplusplus >= 201703L
+        /// \brief Finds the value of \p key.
+        /// \throws MdbxException if a database error occurs.
+        std::optional<ValueT> find(const KeyT& key) const {
+            std::shared_ptr<const ValueT> value = get(key);
+            if (!value) return std::nullopt;
+            return *value;
+        }
+#       else
+        /// \brief Finds the value of \p key.
+        /// \return Pair of success flag and value.
+        /// \throws MdbxException if a database error occurs.
+        std::pair<bool, ValueT> find(const KeyT& key) const {
+            std::shared_ptr<const ValueT> value = get(key);
+            if (!value) return std::make_pair(false, ValueT());
+            return std::make_pair(true, *value);
+        }
+#       endif
+
+        /// \brief Checks whether \p key is stored, using the cache.
+        /// \throws MdbxException if a database error occurs.
+        bool contains(const KeyT& key) const {
+            return static_cast<bool>(get(key));
+        }
+
+        // --- Writes ---
+
+        /// \brief Inserts \p value if \p key is absent, see \c KeyValueTable::insert().
+        /// \return \c true if the pair was inserted.
+        /// \throws MdbxException if a database error occurs.
+        bool insert(const KeyT& key, const ValueT& value) {
+            bool inserted = false;
+            write(key, [this, &key, &value, &inserted](const Transaction& txn) {
+                inserted = m_table.insert(key, value, txn);
+            });
+            return inserted;
+        }
+
+        /// \brief Inserts or replaces the value of \p key.
+        /// \throws MdbxException if a database error occurs.
+        void insert_or_assign(const KeyT& key, const ValueT& value) {
+            write(key, [this, &key, &value](const Transaction& txn) {
+                m_table.insert_or_assign(key, value, txn);
+            });
+        }
+
+        /// \brief Updates an existing value, see \c KeyValueTable::update().
+        /// \param key Key to update.
+        /// \param fn Mutator function invoked as \c fn(ValueT&).
+        /// \return \c true if the key existed and was updated.
+        /// \throws MdbxException if a database error occurs.
+        template<typename Fn>
+        bool update(const KeyT& key, Fn fn) {
+            bool updated = false;
+            write(key, [this, &key, &fn, &updated](const Transaction& txn) {
+                updated = m_table.update(key, fn, txn);
+            });
+            return updated;
+        }
+
+        /// \brief Removes \p key.
+        /// \return \c true if the key was present.
+        /// \throws MdbxException if a database error occurs.
+        bool erase(const KeyT& key) {
+            bool erased = false;
+            write(key, [this, &key, &erased](const Transaction& txn) {
+                erased = m_table.erase(key, txn);
+            });
+            return erased;
+        }
+
+        /// \brief Removes every record and empties the cache.
+        /// \throws MdbxException if a database error occurs.
+        void clear() {
+            Transaction txn = m_connection->transaction(TransactionMode::WRITABLE);
+            m_table.clear(txn);
+            txn.commit();
+            invalidate_all();
+        }
+
+        // --- Cache control ---
+
+        /// \brief Drops the cached entry of \p key, if any.
+        void invalidate(const KeyT& key) {
+            SerializeScratch sc;
+            const MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc);
+            invalidate_storage_key(std::string(static_cast<const char*>(db_key.iov_base),
+                                               db_key.iov_len));
+        }
+
+        /// \brief Drops every cached entry.
+        void invalidate_all() {
+            for (std::size_t i = 0; i < m_shards.size(); ++i) {
+                Shard& shard = *m_shards[i];
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                ++shard.epoch;
+                m_invalidations.fetch_add(shard.index.size(), std::memory_order_relaxed);
+                shard.index.clear();
+                shard.lru.clear();
+                shard.bytes = 0;
+            }
+        }
+
+        /// \brief Returns the cache counters and current occupancy.
+        CacheStats cache_stats() const {
+            CacheStats stats;
+            stats.hits = m_hits.load(std::memory_order_relaxed);
+            stats.misses = m_misses.load(std::memory_order_relaxed);
+            stats.evictions = m_evictions.load(std::memory_order_relaxed);
+            stats.invalidations = m_invalidations.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < m_shards.size(); ++i) {
+                const Shard& shard = *m_shards[i];
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                stats.entries += shard.index.size();
+                stats.bytes += shard.bytes;
+            }
+            return stats;
+        }
+
+        /// \brief Resets the hit, miss, eviction and invalidation counters.
+        void reset_cache_stats() {
+            m_hits.store(0, std::memory_order_relaxed);
+            m_misses.store(0, std::memory_order_relaxed);
+            m_evictions.store(0, std::memory_order_relaxed);
+            m_invalidations.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        /// \brief Cached result of one lookup.
+        struct Entry {
+            std::string key;                     ///< Serialized key.
+            std::shared_ptr<const ValueT> value; ///< Value, or \c nullptr for an absent key.
+            std::size_t cost;                    ///< Bytes charged to the shard.
+        };
+
+        struct Shard {
+            typedef std::list<Entry> List;
+            typedef std::unordered_map<std::string, typename List::iterator> Index;
+
+            mutable std::mutex mutex;
+            List               lru;       ///< Most recently used first.
+            Index              index;
+            std::size_t        bytes = 0;
+            std::uint64_t      epoch = 0; ///< Bumped by every invalidation in the shard.
+        };
+
+        /// \brief Fixed charge per entry for list, map and control block nodes.
+        static const std::size_t entry_overhead = sizeof(Entry) + sizeof(ValueT) + 128;
+
+        std::shared_ptr<Connection> m_connection;
+        std::string                 m_name;
+        table_type                  m_table;
+        std::size_t                 m_budget_bytes;
+        std::vector<std::unique_ptr<Shard>> m_shards;
+        XXH3Hasher                  m_hasher;
+        mutable std::atomic<std::uint64_t> m_hits{0};
+        mutable std::atomic<std::uint64_t> m_misses{0};
+        mutable std::atomic<std::uint64_t> m_evictions{0};
+        std::atomic<std::uint64_t>         m_invalidations{0};
+
+#       if MDBXC_SYNC_ENABLED
+        /// \brief Drops keys written to this table by remote sync applies.
+        class ApplyObserver final : public sync::ISyncApplyObserver {
+        public:
+            explicit ApplyObserver(CachedKeyValueTable& owner) : m_owner(owner) {}
+
+            void on_sync_apply_committed(const sync::SyncApplyEvent& event) override {
+                m_owner.on_sync_apply(event);
+            }
+
+        private:
+            CachedKeyValueTable& m_owner;
+        };
+
+        std::unique_ptr<ApplyObserver> m_apply_observer;
+        std::uint64_t m_apply_observer_token = 0;
+
+        void on_sync_apply(const sync::SyncApplyEvent& event) {
+            bool affected = false;
+            for (std::size_t i = 0; i < event.affected_dbi_names.size(); ++i) {
+                if (event.affected_dbi_names[i] == m_name) {
+                    affected = true;
+                    break;
+                }
+            }
+            if (!affected) return;
+            bool matched = false;
+            for (std::size_t i = 0; i < event.applied_keys.size(); ++i) {
+                const sync::SyncAppliedKey& applied = event.applied_keys[i];
+                if (applied.dbi_name != m_name) continue;
+                if (applied.op_type == sync::ChangeOpType::ClearTable) {
+                    invalidate_all();
+                    return;
+                }
+                matched = true;
+                invalidate_storage_key(std::string(applied.storage_key.begin(),
+                                                   applied.storage_key.end()));
+            }
+            // The table changed but its keys are unknown.
+            if (!matched) invalidate_all();
+        }
+#       endif
+
+        static std::vector<std::unique_ptr<Shard>> make_shards(std::size_t count) {
+            if (count == 0) {
+                throw std::invalid_argument("CachedKeyValueTable requires at least one shard");
+            }
+            std::vector<std::unique_ptr<Shard>> shards;
+            shards.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                shards.emplace_back(new Shard());
+            }
+            return shards;
+        }
+
+        Shard& shard_of(const std::string& storage_key) const {
+            const std::uint64_t hash = m_hasher(ByteView(storage_key.data(), storage_key.size()));
+            return *m_shards[static_cast<std::size_t>(hash % m_shards.size())];
+        }
+
+        /// \brief Commits \p action in its own write transaction, then drops \p key.
+        template<typename F>
+        void write(const KeyT& key, F action) {
+            Transaction txn = m_connection->transaction(TransactionMode::WRITABLE);
+            action(txn);
+            txn.commit();
+            invalidate(key);
+        }
+
+        void invalidate_storage_key(const std::string& storage_key) {
+            Shard& shard = shard_of(storage_key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            ++shard.epoch;
+            typename Shard::Index::iterator it = shard.index.find(storage_key);
+            if (it == shard.index.end()) return;
+            shard.bytes -= it->second->cost;
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+            m_invalidations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// \brief Caches a value read on a miss.
+        /// \details Skipped when the shard saw an invalidation since \p epoch:
+        /// the read snapshot may predate a write that committed meanwhile.
+        /// Writers invalidate after their commit, so a read that started
+        /// later than the last invalidation cannot be older than any
+        /// committed write.
+        void cache_loaded(Shard& shard, const std::string& storage_key,
+                          const std::shared_ptr<const ValueT>& value,
+                          std::size_t value_bytes, std::uint64_t epoch) const {
+            const std::size_t cost = storage_key.size() + value_bytes + entry_overhead;
+            const std::size_t shard_budget = m_budget_bytes / m_shards.size();
+            if (cost > shard_budget) return;
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.epoch != epoch) return;
+            if (shard.index.find(storage_key) != shard.index.end()) return;
+            while (shard.bytes + cost > shard_budget && !shard.lru.empty()) {
+                const Entry& victim = shard.lru.back();
+                shard.bytes -= victim.cost;
+                shard.index.erase(victim.key);
+                shard.lru.pop_back();
+                m_evictions.fetch_add(1, std::memory_order_relaxed);
+            }
+            shard.lru.push_front(Entry{storage_key, value, cost});
+            shard.index.emplace(storage_key, shard.lru.begin());
+            shard.bytes += cost;
+        }
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_CACHED_KEY_VALUE_TABLE_HPP_INCLUDED
@@ -6,9 +6,12 @@
 /// \brief Hash-indexed key-value store for string and byte-vector keys.
 
 #include "common.hpp"
+#include "detail/HashFilter.hpp"
+#include "detail/ParallelDecode.hpp"
 #include "detail/ResultContainers.hpp"
 #include "Hash.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <set>
@@ -22,7 +25,8 @@ namespace mdbxc {
     /// \brief Physical storage layout used by \ref HashedKeyValueStore.
     enum class HashedStoreLayout {
         LargeValues, ///< Two DBIs; payloads live outside DUPSORT duplicate values.
-        SmallValues  ///< One MDBX_DUPSORT DBI; duplicate values contain key and payload bytes.
+        SmallValues, ///< One MDBX_DUPSORT DBI; duplicate values contain key and payload bytes.
+        Hybrid       ///< MDBX_DUPSORT bucket DBI with small payloads inline and large ones in a payload DBI.
     };
 
     template<class KeyT,
@@ -33,6 +37,25 @@ namespace mdbxc {
 
     namespace detail {
 
+        /// \brief Compares two equal-length original keys.
+        /// \details Long keys such as URLs usually share a prefix and differ near
+        /// the end, so the trailing 8 bytes are compared first; this rejects most
+        /// collision candidates before \c std::memcmp, which the C library
+        /// already vectorizes, walks the remaining bytes.
+        inline bool hashed_key_bytes_equal(const uint8_t* a, const uint8_t* b, std::size_t size) noexcept {
+            if (size >= 16) {
+                std::uint64_t tail_a = 0;
+                std::uint64_t tail_b = 0;
+                std::memcpy(&tail_a, a + size - 8, 8);
+                std::memcpy(&tail_b, b + size - 8, 8);
+                if (tail_a != tail_b) {
+                    return false;
+                }
+                return std::memcmp(a, b, size - 8) == 0;
+            }
+            return size == 0 || std::memcmp(a, b, size) == 0;
+        }
+
         template<class Derived, class KeyT, class ValueT>
         class HashedKeyValueStorePublicApi {
         public:
@@ -124,6 +147,36 @@ namespace mdbxc {
                 return retrieve_all<ContainerT>(txn.handle());
             }
 
+            void parallel_load(std::vector<value_type>& container, std::size_t threads,
+                               MDBX_txn* txn = nullptr) const {
+                const Derived& self = derived();
+                self.with_transaction([&self, &container, threads](MDBX_txn* t) {
+                    self.db_parallel_load(container, threads, t);
+                }, TransactionMode::READ_ONLY, txn);
+            }
+
+            void parallel_load(std::vector<value_type>& container, std::size_t threads,
+                               const Transaction& txn) const {
+                parallel_load(container, threads, txn.handle());
+            }
+
+            template<template<class...> class ContainerT>
+            void parallel_load(ContainerT<KeyT, ValueT>& container, std::size_t threads,
+                               MDBX_txn* txn = nullptr) const {
+                std::vector<value_type> pairs;
+                parallel_load(pairs, threads, txn);
+                detail::reserve_if_supported(container, container.size() + pairs.size(), 0);
+                for (std::size_t i = 0; i < pairs.size(); ++i) {
+                    container.emplace(std::move(pairs[i].first), std::move(pairs[i].second));
+                }
+            }
+
+            template<template<class...> class ContainerT>
+            void parallel_load(ContainerT<KeyT, ValueT>& container, std::size_t threads,
+                               const Transaction& txn) const {
+                parallel_load(container, threads, txn.handle());
+            }
+
             template<template<class...> class ContainerT>
             void append(const ContainerT<KeyT, ValueT>& container, MDBX_txn* txn = nullptr) {
                 Derived& self = derived();
@@ -281,6 +334,71 @@ namespace mdbxc {
                 return find_compat(key, txn.handle());
             }
 
+#if __cplusplus >= 201703L
+            std::size_t find_many_batch(const std::vector<KeyT>& keys,
+                                        std::vector<std::optional<ValueT> >& out,
+                                        MDBX_txn* txn = nullptr) const {
+                out.assign(keys.size(), std::nullopt);
+                std::size_t found = 0;
+                const Derived& self = derived();
+                self.with_transaction([&self, &keys, &out, &found](MDBX_txn* t) {
+                    found = self.db_find_many_batch(keys, [&out](std::size_t index, ValueT&& value) {
+                        out[index] = std::move(value);
+                    }, t);
+                }, TransactionMode::READ_ONLY, txn);
+                return found;
+            }
+
+            std::size_t find_many_batch(const std::vector<KeyT>& keys,
+                                        std::vector<std::optional<ValueT> >& out,
+                                        const Transaction& txn) const {
+                return find_many_batch(keys, out, txn.handle());
+            }
+#endif
+
+            std::size_t find_many_batch_compat(const std::vector<KeyT>& keys,
+                                               std::vector<std::pair<bool, ValueT> >& out,
+                                               MDBX_txn* txn = nullptr) const {
+                out.assign(keys.size(), std::pair<bool, ValueT>(false, ValueT()));
+                std::size_t found = 0;
+                const Derived& self = derived();
+                self.with_transaction([&self, &keys, &out, &found](MDBX_txn* t) {
+                    found = self.db_find_many_batch(keys, [&out](std::size_t index, ValueT&& value) {
+                        out[index].first = true;
+                        out[index].second = std::move(value);
+                    }, t);
+                }, TransactionMode::READ_ONLY, txn);
+                return found;
+            }
+
+            std::size_t find_many_batch_compat(const std::vector<KeyT>& keys,
+                                               std::vector<std::pair<bool, ValueT> >& out,
+                                               const Transaction& txn) const {
+                return find_many_batch_compat(keys, out, txn.handle());
+            }
+
+            bool read_buckets(std::uint64_t from_hash,
+                              std::size_t max_records,
+                              std::vector<value_type>& out,
+                              std::uint64_t& next_hash,
+                              MDBX_txn* txn = nullptr) const {
+                out.clear();
+                bool more = false;
+                const Derived& self = derived();
+                self.with_transaction([&self, from_hash, max_records, &out, &next_hash, &more](MDBX_txn* t) {
+                    more = self.db_read_buckets(from_hash, max_records, out, next_hash, t);
+                }, TransactionMode::READ_ONLY, txn);
+                return more;
+            }
+
+            bool read_buckets(std::uint64_t from_hash,
+                              std::size_t max_records,
+                              std::vector<value_type>& out,
+                              std::uint64_t& next_hash,
+                              const Transaction& txn) const {
+                return read_buckets(from_hash, max_records, out, next_hash, txn.handle());
+            }
+
             bool contains(const KeyT& key, MDBX_txn* txn = nullptr) const {
                 bool res = false;
                 const Derived& self = derived();
@@ -525,6 +643,58 @@ namespace mdbxc {
             load(container, txn.handle());
         }
 
+        /// \brief Loads all pairs into a vector, deserializing them on several threads.
+        /// \details The calling thread walks one read snapshot and hands raw
+        /// records to \p threads workers; \p container is reserved from the
+        /// record count first.
+        /// \param container Output vector; existing contents are kept.
+        /// \param threads Worker count; 0 uses the hardware concurrency.
+        /// \param txn Optional transaction handle.
+        void parallel_load(std::vector<value_type>& container, std::size_t threads,
+                           MDBX_txn* txn = nullptr) const {
+            with_transaction([this, &container, threads](MDBX_txn* t) {
+                db_parallel_load(container, threads, t);
+            }, TransactionMode::READ_ONLY, txn);
+        }
+
+        /// \brief Loads all pairs into a vector, deserializing them on several threads.
+        /// \param container Output vector; existing contents are kept.
+        /// \param threads Worker count; 0 uses the hardware concurrency.
+        /// \param txn Active transaction wrapper.
+        void parallel_load(std::vector<value_type>& container, std::size_t threads,
+                           const Transaction& txn) const {
+            parallel_load(container, threads, txn.handle());
+        }
+
+        /// \brief Loads all pairs into a container, deserializing them on several threads.
+        /// \details Insertions run on the calling thread after \c reserve() when
+        /// the container provides it (e.g. \c std::unordered_map).
+        /// \tparam ContainerT Container type storing key-value pairs.
+        /// \param container Output container.
+        /// \param threads Worker count; 0 uses the hardware concurrency.
+        /// \param txn Optional transaction handle.
+        template<template<class...> class ContainerT>
+        void parallel_load(ContainerT<KeyT, ValueT>& container, std::size_t threads,
+                           MDBX_txn* txn = nullptr) const {
+            std::vector<value_type> pairs;
+            parallel_load(pairs, threads, txn);
+            detail::reserve_if_supported(container, container.size() + pairs.size(), 0);
+            for (std::size_t i = 0; i < pairs.size(); ++i) {
+                container.emplace(std::move(pairs[i].first), std::move(pairs[i].second));
+            }
+        }
+
+        /// \brief Loads all pairs into a container, deserializing them on several threads.
+        /// \tparam ContainerT Container type storing key-value pairs.
+        /// \param container Output container.
+        /// \param threads Worker count; 0 uses the hardware concurrency.
+        /// \param txn Active transaction wrapper.
+        template<template<class...> class ContainerT>
+        void parallel_load(ContainerT<KeyT, ValueT>& container, std::size_t threads,
+                           const Transaction& txn) const {
+            parallel_load(container, threads, txn.handle());
+        }
+
         /// \brief Retrieves all pairs into the requested container.
         /// \tparam ContainerT Container type, defaulting to \c std::map.
         /// \param txn Optional transaction handle.
@@ -797,6 +967,110 @@ namespace mdbxc {
             return find_compat(key, txn.handle());
         }
 
+#if __cplusplus >= 201703L
+        /// \brief Looks up multiple keys with one forward walk of the hash index.
+        /// \details All keys are hashed first and sorted by hash, which is the
+        /// \c MDBX_INTEGERKEY order of the index, so one cursor visits the
+        /// buckets front to back and steps with \c MDBX_NEXT_NODUP between
+        /// neighbours instead of descending the tree for every key.
+        /// \param keys Keys to search.
+        /// \param out Output resized to \c keys.size(); slot \c i holds the value
+        /// of \c keys[i] or \c std::nullopt when it is missing.
+        /// \param txn Optional transaction handle.
+        /// \return Number of input keys that were found.
+        std::size_t find_many_batch(const std::vector<KeyT>& keys,
+                                    std::vector<std::optional<ValueT> >& out,
+                                    MDBX_txn* txn = nullptr) const {
+            out.assign(keys.size(), std::nullopt);
+            std::size_t found = 0;
+            with_transaction([this, &keys, &out, &found](MDBX_txn* t) {
+                found = db_find_many_batch(keys, [&out](std::size_t index, ValueT&& value) {
+                    out[index] = std::move(value);
+                }, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Looks up multiple keys with one forward walk of the hash index.
+        /// \param keys Keys to search.
+        /// \param out Output aligned with \c keys; missing keys are \c std::nullopt.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of input keys that were found.
+        std::size_t find_many_batch(const std::vector<KeyT>& keys,
+                                    std::vector<std::optional<ValueT> >& out,
+                                    const Transaction& txn) const {
+            return find_many_batch(keys, out, txn.handle());
+        }
+#endif
+
+        /// \brief Looks up multiple keys with one forward walk of the hash index (C++11 form).
+        /// \param keys Keys to search.
+        /// \param out Output resized to \c keys.size(); slot \c i is
+        /// \c {true, value} for a found key and \c {false, ValueT()} otherwise.
+        /// \param txn Optional transaction handle.
+        /// \return Number of input keys that were found.
+        std::size_t find_many_batch_compat(const std::vector<KeyT>& keys,
+                                           std::vector<std::pair<bool, ValueT> >& out,
+                                           MDBX_txn* txn = nullptr) const {
+            out.assign(keys.size(), std::pair<bool, ValueT>(false, ValueT()));
+            std::size_t found = 0;
+            with_transaction([this, &keys, &out, &found](MDBX_txn* t) {
+                found = db_find_many_batch(keys, [&out](std::size_t index, ValueT&& value) {
+                    out[index].first = true;
+                    out[index].second = std::move(value);
+                }, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Looks up multiple keys with one forward walk of the hash index (C++11 form).
+        /// \param keys Keys to search.
+        /// \param out Output aligned with \c keys.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of input keys that were found.
+        std::size_t find_many_batch_compat(const std::vector<KeyT>& keys,
+                                           std::vector<std::pair<bool, ValueT> >& out,
+                                           const Transaction& txn) const {
+            return find_many_batch_compat(keys, out, txn.handle());
+        }
+
+        /// \brief Reads whole hash buckets in index order.
+        /// \details Used to walk a store in bounded chunks, see
+        /// \ref migrate_hashed_store(). A bucket is never split between calls.
+        /// \param from_hash First bucket hash to read.
+        /// \param max_records Records after which reading stops at the next bucket boundary.
+        /// \param out Cleared and filled with the read pairs.
+        /// \param next_hash Receives the hash to resume from when more buckets remain.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if buckets after \p next_hash remain.
+        bool read_buckets(std::uint64_t from_hash,
+                          std::size_t max_records,
+                          std::vector<value_type>& out,
+                          std::uint64_t& next_hash,
+                          MDBX_txn* txn = nullptr) const {
+            out.clear();
+            bool more = false;
+            with_transaction([this, from_hash, max_records, &out, &next_hash, &more](MDBX_txn* t) {
+                more = db_read_buckets(from_hash, max_records, out, next_hash, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return more;
+        }
+
+        /// \brief Reads whole hash buckets in index order.
+        /// \param from_hash First bucket hash to read.
+        /// \param max_records Records after which reading stops at the next bucket boundary.
+        /// \param out Cleared and filled with the read pairs.
+        /// \param next_hash Receives the hash to resume from when more buckets remain.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if buckets after \p next_hash remain.
+        bool read_buckets(std::uint64_t from_hash,
+                          std::size_t max_records,
+                          std::vector<value_type>& out,
+                          std::uint64_t& next_hash,
+                          const Transaction& txn) const {
+            return read_buckets(from_hash, max_records, out, next_hash, txn.handle());
+        }
+
         /// \brief Checks whether a key exists.
         /// \param key Key to look up.
         /// \param txn Optional transaction handle.
@@ -883,9 +1157,50 @@ namespace mdbxc {
             clear(txn.handle());
         }
 
+        /// \brief Enables an in-memory Bloom filter over key hashes.
+        /// \param expected_keys Key count the filter is sized for; raised to the
+        ///        current record count when the table is already larger.
+        /// \param bits_per_key Filter bits per key; 10 gives about 1% false positives.
+        /// \details The filter is filled from the stored hash buckets in one
+        /// write transaction, so no concurrent writer can be missed. Afterwards
+        /// lookups, \ref contains() and \ref erase() of a key whose hash the
+        /// filter rejects return without touching MDBX. Inserts set filter bits;
+        /// erased keys keep theirs until \ref rebuild_hash_filter(). The filter
+        /// lives in this object only: do not enable it when another process or
+        /// another store instance writes the same table.
+        /// \throws std::invalid_argument if \p bits_per_key is zero.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        void enable_hash_filter(std::size_t expected_keys, std::size_t bits_per_key = 10) {
+            if (!bits_per_key) {
+                throw std::invalid_argument("HashedKeyValueStore: bits_per_key must be positive");
+            }
+            db_build_hash_filter(expected_keys, bits_per_key);
+        }
+
+        /// \brief Rebuilds the hash filter from the table, dropping bits of erased keys.
+        /// \details Does nothing when the filter is disabled.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        void rebuild_hash_filter() {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            if (filter) {
+                db_build_hash_filter(filter->expected_keys(), filter->bits_per_key());
+            }
+        }
+
+        /// \brief Disables the hash filter and releases its memory.
+        void disable_hash_filter() {
+            std::atomic_store(&m_hash_filter, std::shared_ptr<detail::HashFilter>());
+        }
+
+        /// \brief Checks whether the hash filter is enabled.
+        bool hash_filter_enabled() const {
+            return static_cast<bool>(std::atomic_load(&m_hash_filter));
+        }
+
     private:
         MDBX_dbi m_index_dbi;
         Hasher m_hasher;
+        std::shared_ptr<detail::HashFilter> m_hash_filter; ///< Accessed with std::atomic_load/atomic_store.
 
         struct PackedRecordView {
             const uint8_t* key_data;
@@ -911,6 +1226,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
 
             auto txn_guard = m_connection->transaction(mode);
             try {
@@ -922,36 +1238,70 @@ namespace mdbxc {
             }
         }
 
-        static std::string index_name_for(const std::string& name) {
-            return name + "__hash_index";
+        bool hash_filter_rejects(std::uint64_t hash, MDBX_txn* txn) const {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            return filter && filter->covers(mdbx_txn_id(txn)) && !filter->may_contain(hash);
         }
 
-        void open_index(const std::string& index_name, MDBX_db_flags_t flags) {
-            bool read_only = m_connection->is_read_only();
-            MDBX_db_flags_t index_flags = static_cast<MDBX_db_flags_t>(
-                flags | MDBX_DUPSORT | MDBX_INTEGERKEY
-            );
-            if (read_only) {
-                index_flags = static_cast<MDBX_db_flags_t>(index_flags & ~MDBX_CREATE);
+        void hash_filter_add(std::uint64_t hash) {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            if (filter) {
+                filter->add(hash);
+            }
+        }
+
+        void db_build_hash_filter(std::size_t expected_keys, std::size_t bits_per_key) {
+            if (thread_txn()) {
+                throw std::logic_error("HashedKeyValueStore: hash filter cannot be built inside an active transaction");
             }
+            const bool read_only = m_connection->is_read_only();
             auto txn = m_connection->transaction(
                 read_only ? TransactionMode::READ_ONLY : TransactionMode::WRITABLE
             );
             try {
-                check_mdbx(
-                    mdbx_dbi_open(txn.handle(),
-                                  index_name.c_str(),
-                                  index_flags,
-                                  &m_index_dbi),
-                    "Failed to open hashed key-value index"
+                MDBX_txn* t = txn.handle();
+                // A write txn id is one past the snapshot it reads.
+                const std::uint64_t txnid = mdbx_txn_id(t);
+                std::shared_ptr<detail::HashFilter> filter = std::make_shared<detail::HashFilter>(
+                    (std::max)(expected_keys, db_count(t)),
+                    bits_per_key,
+                    read_only ? txnid : txnid - 1
                 );
-                txn.commit();
+                MDBX_cursor* cursor = nullptr;
+                check_mdbx(mdbx_cursor_open(t, m_index_dbi, &cursor), "Failed to open hashed key-value cursor");
+                try {
+                    MDBX_val db_hash, db_val;
+                    int rc = MDBX_SUCCESS;
+                    while ((rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_NODUP)) == MDBX_SUCCESS) {
+                        filter->add(deserialize_key<std::uint64_t>(db_hash));
+                    }
+                    if (rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "Failed to scan hashed key-value buckets");
+                    }
+                    mdbx_cursor_close(cursor);
+                } catch (...) {
+                    mdbx_cursor_close(cursor);
+                    throw;
+                }
+                std::atomic_store(&m_hash_filter, filter);
+                txn.rollback();
             } catch (...) {
                 try { txn.rollback(); } catch (...) {}
                 throw;
             }
         }
 
+        static std::string index_name_for(const std::string& name) {
+            return name + "__hash_index";
+        }
+
+        void open_index(const std::string& index_name, MDBX_db_flags_t flags) {
+            m_index_dbi = m_connection->open_dbi(
+                index_name,
+                static_cast<MDBX_db_flags_t>(flags | MDBX_DUPSORT | MDBX_INTEGERKEY)
+            );
+        }
+
         static void write_u64_le(std::uint64_t value, uint8_t* out) noexcept {
             for (int i = 0; i < 8; ++i) {
                 out[i] = static_cast<uint8_t>((value >> (8 * i)) & 0xffu);
@@ -1048,10 +1398,7 @@ namespace mdbxc {
             if (record.key_size != key.size()) {
                 return false;
             }
-            if (key.empty()) {
-                return true;
-            }
-            return std::memcmp(record.key_data, key.data(), key.size()) == 0;
+            return detail::hashed_key_bytes_equal(record.key_data, key.data(), key.size());
         }
 
         template<class T>
@@ -1230,6 +1577,7 @@ namespace mdbxc {
                             std::uint64_t hash,
                             const ValueT& value,
                             MDBX_txn* txn) {
+            hash_filter_add(hash);
             const std::uint64_t ordinal = next_ordinal(hash, txn);
             std::vector<uint8_t> record_key = make_record_key(hash, ordinal);
             put_record(record_key, original_key, value, MDBX_NOOVERWRITE, txn);
@@ -1240,7 +1588,8 @@ namespace mdbxc {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
             LocatedRecord located;
-            if (!db_find_record_bytes(original_key, hash, located, txn)) {
+            if (hash_filter_rejects(hash, txn) ||
+                !db_find_record_bytes(original_key, hash, located, txn)) {
                 return false;
             }
 
@@ -1255,18 +1604,150 @@ namespace mdbxc {
             return true;
         }
 
+        template<typename EmitT>
+        std::size_t db_find_many_batch(const std::vector<KeyT>& keys, EmitT emit, MDBX_txn* txn) const {
+            const std::size_t count = keys.size();
+            std::vector<std::vector<uint8_t> > original_keys(count);
+            std::vector<std::uint64_t> hashes(count);
+            std::vector<std::size_t> order;
+            order.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                original_keys[i] = key_bytes(keys[i]);
+                hashes[i] = hash_key_bytes(original_keys[i]);
+                if (!hash_filter_rejects(hashes[i], txn)) {
+                    order.push_back(i);
+                }
+            }
+            if (order.empty()) {
+                return 0;
+            }
+            std::stable_sort(order.begin(), order.end(), [&hashes](std::size_t lhs, std::size_t rhs) {
+                return hashes[lhs] < hashes[rhs];
+            });
+
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_index_dbi, &cursor), "Failed to open hashed key-value index cursor");
+            try {
+                std::size_t found = 0;
+                bool positioned = false;
+                std::uint64_t current = 0;
+                MDBX_val db_hash{};
+                MDBX_val db_val{};
+                for (std::size_t pos = 0; pos < order.size(); ++pos) {
+                    const std::size_t index = order[pos];
+                    const std::uint64_t target = hashes[index];
+                    if (positioned && current < target) {
+                        // Neighbouring hashes often share a page: try one step first.
+                        int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_NODUP);
+                        if (rc == MDBX_NOTFOUND) break;
+                        check_mdbx(rc, "Failed to step hashed key-value batch cursor");
+                        current = deserialize_key<std::uint64_t>(db_hash);
+                    }
+                    if (!positioned || current < target) {
+                        SerializeScratch sc_hash;
+                        db_hash = hash_key_view(target, sc_hash);
+                        int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_SET_RANGE);
+                        if (rc == MDBX_NOTFOUND) break;
+                        check_mdbx(rc, "Failed to seek hashed key-value batch cursor");
+                        positioned = true;
+                        current = deserialize_key<std::uint64_t>(db_hash);
+                    }
+                    if (current != target) {
+                        continue;
+                    }
+
+                    int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_FIRST_DUP);
+                    while (rc == MDBX_SUCCESS) {
+                        const std::uint64_t ordinal = read_ordinal(db_val);
+                        std::vector<uint8_t> record_key = make_record_key(target, ordinal);
+                        MDBX_val db_record_key = record_key_view(record_key);
+                        MDBX_val db_payload;
+                        int get_rc = mdbx_get(txn, m_dbi, &db_record_key, &db_payload);
+                        if (get_rc == MDBX_NOTFOUND) {
+                            throw std::runtime_error("Hashed key-value index references a missing record");
+                        }
+                        check_mdbx(get_rc, "Failed to read hashed key-value record");
+                        PackedRecordView record = parse_record(db_payload);
+                        if (key_matches(record, original_keys[index])) {
+                            emit(index, deserialize_payload_value(record));
+                            ++found;
+                            break;
+                        }
+                        rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_DUP);
+                    }
+                    if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "Failed to scan hashed key-value bucket");
+                    }
+                }
+                mdbx_cursor_close(cursor);
+                return found;
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        bool db_read_buckets(std::uint64_t from_hash,
+                             std::size_t max_records,
+                             std::vector<value_type>& out,
+                             std::uint64_t& next_hash,
+                             MDBX_txn* txn) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_index_dbi, &cursor), "Failed to open hashed key-value index cursor");
+            try {
+                SerializeScratch sc_hash;
+                MDBX_val db_hash = hash_key_view(from_hash, sc_hash);
+                MDBX_val db_val;
+                std::size_t taken = 0;
+                std::uint64_t current = 0;
+                int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_SET_RANGE);
+                while (rc == MDBX_SUCCESS) {
+                    const std::uint64_t hash = deserialize_key<std::uint64_t>(db_hash);
+                    if (taken && hash != current && taken >= max_records) {
+                        next_hash = hash;
+                        mdbx_cursor_close(cursor);
+                        return true;
+                    }
+                    current = hash;
+                    std::vector<uint8_t> record_key = make_record_key(hash, read_ordinal(db_val));
+                    MDBX_val db_record_key = record_key_view(record_key);
+                    MDBX_val db_payload;
+                    int get_rc = mdbx_get(txn, m_dbi, &db_record_key, &db_payload);
+                    if (get_rc == MDBX_NOTFOUND) {
+                        throw std::runtime_error("Hashed key-value index references a missing record");
+                    }
+                    check_mdbx(get_rc, "Failed to read hashed key-value record");
+                    PackedRecordView record = parse_record(db_payload);
+                    out.emplace_back(deserialize_key_bytes(record.key_data, record.key_size),
+                                     deserialize_payload_value(record));
+                    ++taken;
+                    rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT);
+                }
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to scan hashed key-value buckets");
+                }
+                mdbx_cursor_close(cursor);
+                return false;
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
         bool db_contains(const KeyT& key, MDBX_txn* txn) const {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
             LocatedRecord located;
-            return db_find_record_bytes(original_key, hash, located, txn);
+            return !hash_filter_rejects(hash, txn) &&
+                db_find_record_bytes(original_key, hash, located, txn);
         }
 
         bool db_insert_if_absent(const KeyT& key, const ValueT& value, MDBX_txn* txn) {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
             LocatedRecord located;
-            if (db_find_record_bytes(original_key, hash, located, txn)) {
+            if (!hash_filter_rejects(hash, txn) &&
+                db_find_record_bytes(original_key, hash, located, txn)) {
                 return false;
             }
             put_new_record(original_key, hash, value, txn);
@@ -1277,7 +1758,8 @@ namespace mdbxc {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
             LocatedRecord located;
-            if (db_find_record_bytes(original_key, hash, located, txn)) {
+            if (!hash_filter_rejects(hash, txn) &&
+                db_find_record_bytes(original_key, hash, located, txn)) {
                 put_record(located.record_key, original_key, value, MDBX_UPSERT, txn);
                 return;
             }
@@ -1288,7 +1770,8 @@ namespace mdbxc {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
             LocatedRecord located;
-            if (!db_find_record_bytes(original_key, hash, located, txn)) {
+            if (hash_filter_rejects(hash, txn) ||
+                !db_find_record_bytes(original_key, hash, located, txn)) {
                 return false;
             }
 
@@ -1355,6 +1838,31 @@ namespace mdbxc {
             }
         }
 
+        void db_parallel_load(std::vector<value_type>& container, std::size_t threads,
+                              MDBX_txn* txn) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                detail::parallel_decode(threads, db_count(txn),
+                    [cursor](detail::RawRecord& raw) -> bool {
+                        const int rc = mdbx_cursor_get(cursor, &raw.key, &raw.value, MDBX_NEXT);
+                        if (rc == MDBX_NOTFOUND) return false;
+                        check_mdbx(rc, "Failed to read hashed key-value records");
+                        return true;
+                    },
+                    [](const detail::RawRecord& raw) {
+                        PackedRecordView record = parse_record(raw.value);
+                        return value_type(deserialize_key_bytes(record.key_data, record.key_size),
+                                          deserialize_payload_value(record));
+                    },
+                    container);
+                mdbx_cursor_close(cursor);
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
         template<template<class...> class ContainerT>
         void db_append(const ContainerT<KeyT, ValueT>& container, MDBX_txn* txn) {
             for (typename ContainerT<KeyT, ValueT>::const_iterator it = container.begin();
@@ -1488,8 +1996,49 @@ namespace mdbxc {
         /// \brief Destructor.
         ~HashedKeyValueStore() override = default;
 
+        /// \brief Enables an in-memory Bloom filter over key hashes.
+        /// \param expected_keys Key count the filter is sized for; raised to the
+        ///        current record count when the table is already larger.
+        /// \param bits_per_key Filter bits per key; 10 gives about 1% false positives.
+        /// \details The filter is filled from the stored hash buckets in one
+        /// write transaction, so no concurrent writer can be missed. Afterwards
+        /// lookups, \ref contains() and \ref erase() of a key whose hash the
+        /// filter rejects return without touching MDBX. Inserts set filter bits;
+        /// erased keys keep theirs until \ref rebuild_hash_filter(). The filter
+        /// lives in this object only: do not enable it when another process or
+        /// another store instance writes the same table.
+        /// \throws std::invalid_argument if \p bits_per_key is zero.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        void enable_hash_filter(std::size_t expected_keys, std::size_t bits_per_key = 10) {
+            if (!bits_per_key) {
+                throw std::invalid_argument("HashedKeyValueStore: bits_per_key must be positive");
+            }
+            db_build_hash_filter(expected_keys, bits_per_key);
+        }
+
+        /// \brief Rebuilds the hash filter from the table, dropping bits of erased keys.
+        /// \details Does nothing when the filter is disabled.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        void rebuild_hash_filter() {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            if (filter) {
+                db_build_hash_filter(filter->expected_keys(), filter->bits_per_key());
+            }
+        }
+
+        /// \brief Disables the hash filter and releases its memory.
+        void disable_hash_filter() {
+            std::atomic_store(&m_hash_filter, std::shared_ptr<detail::HashFilter>());
+        }
+
+        /// \brief Checks whether the hash filter is enabled.
+        bool hash_filter_enabled() const {
+            return static_cast<bool>(std::atomic_load(&m_hash_filter));
+        }
+
     private:
         Hasher m_hasher;
+        std::shared_ptr<detail::HashFilter> m_hash_filter; ///< Accessed with std::atomic_load/atomic_store.
 
         struct PackedRecordView {
             const uint8_t* key_data;
@@ -1509,6 +2058,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
 
             auto txn_guard = m_connection->transaction(mode);
             try {
@@ -1520,6 +2070,59 @@ namespace mdbxc {
             }
         }
 
+        bool hash_filter_rejects(std::uint64_t hash, MDBX_txn* txn) const {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            return filter && filter->covers(mdbx_txn_id(txn)) && !filter->may_contain(hash);
+        }
+
+        void hash_filter_add(std::uint64_t hash) {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            if (filter) {
+                filter->add(hash);
+            }
+        }
+
+        void db_build_hash_filter(std::size_t expected_keys, std::size_t bits_per_key) {
+            if (thread_txn()) {
+                throw std::logic_error("HashedKeyValueStore: hash filter cannot be built inside an active transaction");
+            }
+            const bool read_only = m_connection->is_read_only();
+            auto txn = m_connection->transaction(
+                read_only ? TransactionMode::READ_ONLY : TransactionMode::WRITABLE
+            );
+            try {
+                MDBX_txn* t = txn.handle();
+                // A write txn id is one past the snapshot it reads.
+                const std::uint64_t txnid = mdbx_txn_id(t);
+                std::shared_ptr<detail::HashFilter> filter = std::make_shared<detail::HashFilter>(
+                    (std::max)(expected_keys, db_count(t)),
+                    bits_per_key,
+                    read_only ? txnid : txnid - 1
+                );
+                MDBX_cursor* cursor = nullptr;
+                check_mdbx(mdbx_cursor_open(t, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+                try {
+                    MDBX_val db_hash, db_val;
+                    int rc = MDBX_SUCCESS;
+                    while ((rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_NODUP)) == MDBX_SUCCESS) {
+                        filter->add(deserialize_key<std::uint64_t>(db_hash));
+                    }
+                    if (rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "Failed to scan hashed key-value buckets");
+                    }
+                    mdbx_cursor_close(cursor);
+                } catch (...) {
+                    mdbx_cursor_close(cursor);
+                    throw;
+                }
+                std::atomic_store(&m_hash_filter, filter);
+                txn.rollback();
+            } catch (...) {
+                try { txn.rollback(); } catch (...) {}
+                throw;
+            }
+        }
+
         static void write_u64_le(std::uint64_t value, uint8_t* out) noexcept {
             for (int i = 0; i < 8; ++i) {
                 out[i] = static_cast<uint8_t>((value >> (8 * i)) & 0xffu);
@@ -1579,10 +2182,7 @@ namespace mdbxc {
             if (record.key_size != key.size()) {
                 return false;
             }
-            if (key.empty()) {
-                return true;
-            }
-            return std::memcmp(record.key_data, key.data(), key.size()) == 0;
+            return detail::hashed_key_bytes_equal(record.key_data, key.data(), key.size());
         }
 
         template<class T>
@@ -1682,6 +2282,7 @@ namespace mdbxc {
         void put_duplicate_payload(std::uint64_t hash,
                                    const std::vector<uint8_t>& payload,
                                    MDBX_txn* txn) {
+            hash_filter_add(hash);
             SerializeScratch sc_hash;
             MDBX_val db_hash = hash_key_view(hash, sc_hash);
             MDBX_val db_val = SerializeScratch::view(payload.empty() ? nullptr : payload.data(), payload.size());
@@ -1704,6 +2305,9 @@ namespace mdbxc {
         bool db_get(const KeyT& key, ValueT& value, MDBX_txn* txn) const {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
+            if (hash_filter_rejects(hash, txn)) {
+                return false;
+            }
             return with_matching_duplicate(
                 original_key,
                 hash,
@@ -1717,6 +2321,9 @@ namespace mdbxc {
         bool db_contains(const KeyT& key, MDBX_txn* txn) const {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
+            if (hash_filter_rejects(hash, txn)) {
+                return false;
+            }
             return with_matching_duplicate(
                 original_key,
                 hash,
@@ -1725,10 +2332,124 @@ namespace mdbxc {
             );
         }
 
+        template<typename EmitT>
+        std::size_t db_find_many_batch(const std::vector<KeyT>& keys, EmitT emit, MDBX_txn* txn) const {
+            const std::size_t count = keys.size();
+            std::vector<std::vector<uint8_t> > original_keys(count);
+            std::vector<std::uint64_t> hashes(count);
+            std::vector<std::size_t> order;
+            order.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                original_keys[i] = key_bytes(keys[i]);
+                hashes[i] = hash_key_bytes(original_keys[i]);
+                if (!hash_filter_rejects(hashes[i], txn)) {
+                    order.push_back(i);
+                }
+            }
+            if (order.empty()) {
+                return 0;
+            }
+            std::stable_sort(order.begin(), order.end(), [&hashes](std::size_t lhs, std::size_t rhs) {
+                return hashes[lhs] < hashes[rhs];
+            });
+
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                std::size_t found = 0;
+                bool positioned = false;
+                std::uint64_t current = 0;
+                MDBX_val db_hash{};
+                MDBX_val db_val{};
+                for (std::size_t pos = 0; pos < order.size(); ++pos) {
+                    const std::size_t index = order[pos];
+                    const std::uint64_t target = hashes[index];
+                    if (positioned && current < target) {
+                        // Neighbouring hashes often share a page: try one step first.
+                        int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_NODUP);
+                        if (rc == MDBX_NOTFOUND) break;
+                        check_mdbx(rc, "Failed to step hashed key-value batch cursor");
+                        current = deserialize_key<std::uint64_t>(db_hash);
+                    }
+                    if (!positioned || current < target) {
+                        SerializeScratch sc_hash;
+                        db_hash = hash_key_view(target, sc_hash);
+                        int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_SET_RANGE);
+                        if (rc == MDBX_NOTFOUND) break;
+                        check_mdbx(rc, "Failed to seek hashed key-value batch cursor");
+                        positioned = true;
+                        current = deserialize_key<std::uint64_t>(db_hash);
+                    }
+                    if (current != target) {
+                        continue;
+                    }
+
+                    int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_FIRST_DUP);
+                    while (rc == MDBX_SUCCESS) {
+                        PackedRecordView record = parse_record(db_val);
+                        if (key_matches(record, original_keys[index])) {
+                            emit(index, deserialize_payload_value(record));
+                            ++found;
+                            break;
+                        }
+                        rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_DUP);
+                    }
+                    if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "Failed to scan hashed key-value bucket");
+                    }
+                }
+                mdbx_cursor_close(cursor);
+                return found;
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        bool db_read_buckets(std::uint64_t from_hash,
+                             std::size_t max_records,
+                             std::vector<value_type>& out,
+                             std::uint64_t& next_hash,
+                             MDBX_txn* txn) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                SerializeScratch sc_hash;
+                MDBX_val db_hash = hash_key_view(from_hash, sc_hash);
+                MDBX_val db_val;
+                std::size_t taken = 0;
+                std::uint64_t current = 0;
+                int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_SET_RANGE);
+                while (rc == MDBX_SUCCESS) {
+                    const std::uint64_t hash = deserialize_key<std::uint64_t>(db_hash);
+                    if (taken && hash != current && taken >= max_records) {
+                        next_hash = hash;
+                        mdbx_cursor_close(cursor);
+                        return true;
+                    }
+                    current = hash;
+                    PackedRecordView record = parse_record(db_val);
+                    out.emplace_back(deserialize_key_bytes(record.key_data, record.key_size),
+                                     deserialize_payload_value(record));
+                    ++taken;
+                    rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT);
+                }
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to scan hashed key-value buckets");
+                }
+                mdbx_cursor_close(cursor);
+                return false;
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
         bool db_insert_if_absent(const KeyT& key, const ValueT& value, MDBX_txn* txn) {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
-            if (with_matching_duplicate(
+            if (!hash_filter_rejects(hash, txn) &&
+                with_matching_duplicate(
                     original_key,
                     hash,
                     txn,
@@ -1743,20 +2464,25 @@ namespace mdbxc {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
             std::vector<uint8_t> payload = make_checked_record_payload(original_key, value);
-            with_matching_duplicate(
-                original_key,
-                hash,
-                txn,
-                [](MDBX_cursor* cursor, MDBX_val&, MDBX_val&, const PackedRecordView&) {
-                    check_mdbx(mdbx_cursor_del(cursor, MDBX_CURRENT), "Failed to replace hashed key-value duplicate");
-                }
-            );
-            put_duplicate_payload(hash, payload, txn);
+            if (!hash_filter_rejects(hash, txn)) {
+                with_matching_duplicate(
+                    original_key,
+                    hash,
+                    txn,
+                    [](MDBX_cursor* cursor, MDBX_val&, MDBX_val&, const PackedRecordView&) {
+                        check_mdbx(mdbx_cursor_del(cursor, MDBX_CURRENT), "Failed to replace hashed key-value duplicate");
+                    }
+                );
+            }
+            put_duplicate_payload(hash, payload, txn);
         }
 
         bool db_erase(const KeyT& key, MDBX_txn* txn) {
             std::vector<uint8_t> original_key = key_bytes(key);
             const std::uint64_t hash = hash_key_bytes(original_key);
+            if (hash_filter_rejects(hash, txn)) {
+                return false;
+            }
             return with_matching_duplicate(
                 original_key,
                 hash,
@@ -1820,6 +2546,31 @@ namespace mdbxc {
             }
         }
 
+        void db_parallel_load(std::vector<value_type>& container, std::size_t threads,
+                              MDBX_txn* txn) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                detail::parallel_decode(threads, db_count(txn),
+                    [cursor](detail::RawRecord& raw) -> bool {
+                        const int rc = mdbx_cursor_get(cursor, &raw.key, &raw.value, MDBX_NEXT);
+                        if (rc == MDBX_NOTFOUND) return false;
+                        check_mdbx(rc, "Failed to read hashed key-value duplicates");
+                        return true;
+                    },
+                    [](const detail::RawRecord& raw) {
+                        PackedRecordView record = parse_record(raw.value);
+                        return value_type(deserialize_key_bytes(record.key_data, record.key_size),
+                                          deserialize_payload_value(record));
+                    },
+                    container);
+                mdbx_cursor_close(cursor);
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
         template<template<class...> class ContainerT>
         void db_append(const ContainerT<KeyT, ValueT>& container, MDBX_txn* txn) {
             for (typename ContainerT<KeyT, ValueT>::const_iterator it = container.begin();
@@ -1891,6 +2642,866 @@ namespace mdbxc {
         }
     };
 
+    /// \class HashedKeyValueStore
+    /// \ingroup mdbxc_tables
+    /// \brief Hybrid specialization with inline small payloads and spilled large ones.
+    /// \details
+    /// Uses an MDBX_DUPSORT bucket DBI like the SmallValues layout. Each
+    /// duplicate value holds the original key bytes and either the serialized
+    /// payload itself or the id of a record in a payload DBI named
+    /// \c name + "__payload". The choice is made per record: payloads up to
+    /// \ref inline_limit() bytes that also fit the MDBX_DUPSORT value limit are
+    /// stored inline and read with one bucket seek, larger ones spill.
+    ///
+    /// \note The layout opens two MDBX DBIs. Duplicate values are not
+    ///       compatible with the other layouts; use \ref migrate_hashed_store()
+    ///       to move data between layouts.
+    template<class KeyT, class ValueT, class Hasher>
+    class HashedKeyValueStore<KeyT, ValueT, Hasher, HashedStoreLayout::Hybrid> final
+        : public BaseTable,
+          public detail::HashedKeyValueStorePublicApi<
+              HashedKeyValueStore<KeyT, ValueT, Hasher, HashedStoreLayout::Hybrid>,
+              KeyT,
+              ValueT> {
+        static_assert(is_hashed_key_type<KeyT>::value,
+                      "HashedKeyValueStore key must be std::string or a supported byte vector");
+
+        typedef detail::HashedKeyValueStorePublicApi<
+            HashedKeyValueStore<KeyT, ValueT, Hasher, HashedStoreLayout::Hybrid>,
+            KeyT,
+            ValueT> ApiBase;
+
+        friend class detail::HashedKeyValueStorePublicApi<
+            HashedKeyValueStore<KeyT, ValueT, Hasher, HashedStoreLayout::Hybrid>,
+            KeyT,
+            ValueT>;
+
+    public:
+        typedef std::pair<KeyT, ValueT> value_type;
+        using ApiBase::operator=;
+
+        static const std::size_t default_inline_limit = 256; ///< Default largest inline payload in bytes.
+
+        /// \brief Constructs a hybrid store using an existing connection.
+        /// \param connection Existing \ref Connection instance.
+        /// \param name Name of the DUPSORT bucket table within the MDBX environment.
+        /// \param hasher Hashing strategy used for key lookup.
+        /// \param inline_limit Largest serialized payload stored inline, in bytes.
+        /// \param flags Additional MDBX database flags for table creation.
+        explicit HashedKeyValueStore(std::shared_ptr<Connection> connection,
+                                     std::string name = "hashed_kv_store",
+                                     Hasher hasher = Hasher(),
+                                     std::size_t inline_limit = default_inline_limit,
+                                     MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : BaseTable(std::move(connection), name, flags | MDBX_DUPSORT | MDBX_INTEGERKEY),
+              m_payload_dbi(),
+              m_hasher(std::move(hasher)),
+              m_inline_limit(inline_limit) {
+            open_payload(payload_name_for(name), flags);
+        }
+
+        /// \brief Constructs a hybrid store using a database configuration.
+        /// \param config Configuration settings for the database.
+        /// \param name Name of the DUPSORT bucket table within the MDBX environment.
+        /// \param hasher Hashing strategy used for key lookup.
+        /// \param inline_limit Largest serialized payload stored inline, in bytes.
+        /// \param flags Additional MDBX database flags for table creation.
+        explicit HashedKeyValueStore(const Config& config,
+                                     std::string name = "hashed_kv_store",
+                                     Hasher hasher = Hasher(),
+                                     std::size_t inline_limit = default_inline_limit,
+                                     MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : BaseTable(Connection::create(config), name, flags | MDBX_DUPSORT | MDBX_INTEGERKEY),
+              m_payload_dbi(),
+              m_hasher(std::move(hasher)),
+              m_inline_limit(inline_limit) {
+            open_payload(payload_name_for(name), flags);
+        }
+
+        /// \brief Destructor.
+        ~HashedKeyValueStore() override = default;
+
+        /// \brief Returns the largest serialized payload stored inline, in bytes.
+        std::size_t inline_limit() const noexcept {
+            return m_inline_limit;
+        }
+        /// \brief Enables an in-memory Bloom filter over key hashes.
+        /// \param expected_keys Key count the filter is sized for; raised to the
+        ///        current record count when the table is already larger.
+        /// \param bits_per_key Filter bits per key; 10 gives about 1% false positives.
+        /// \details The filter is filled from the stored hash buckets in one
+        /// write transaction, so no concurrent writer can be missed. Afterwards
+        /// lookups, \ref contains() and \ref erase() of a key whose hash the
+        /// filter rejects return without touching MDBX. Inserts set filter bits;
+        /// erased keys keep theirs until \ref rebuild_hash_filter(). The filter
+        /// lives in this object only: do not enable it when another process or
+        /// another store instance writes the same table.
+        /// \throws std::invalid_argument if \p bits_per_key is zero.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        void enable_hash_filter(std::size_t expected_keys, std::size_t bits_per_key = 10) {
+            if (!bits_per_key) {
+                throw std::invalid_argument("HashedKeyValueStore: bits_per_key must be positive");
+            }
+            db_build_hash_filter(expected_keys, bits_per_key);
+        }
+
+        /// \brief Rebuilds the hash filter from the table, dropping bits of erased keys.
+        /// \details Does nothing when the filter is disabled.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        void rebuild_hash_filter() {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            if (filter) {
+                db_build_hash_filter(filter->expected_keys(), filter->bits_per_key());
+            }
+        }
+
+        /// \brief Disables the hash filter and releases its memory.
+        void disable_hash_filter() {
+            std::atomic_store(&m_hash_filter, std::shared_ptr<detail::HashFilter>());
+        }
+
+        /// \brief Checks whether the hash filter is enabled.
+        bool hash_filter_enabled() const {
+            return static_cast<bool>(std::atomic_load(&m_hash_filter));
+        }
+
+    private:
+        MDBX_dbi m_payload_dbi;
+        Hasher m_hasher;
+        std::size_t m_inline_limit;
+        std::shared_ptr<detail::HashFilter> m_hash_filter; ///< Accessed with std::atomic_load/atomic_store.
+
+        enum RecordKind : uint8_t {
+            inline_kind = 0, ///< Duplicate value carries the payload.
+            spilled_kind = 1 ///< Duplicate value carries a payload DBI id.
+        };
+        static const std::size_t header_size = 9; ///< Key length and payload kind.
+
+        struct PackedRecordView {
+            const uint8_t* key_data;
+            std::size_t key_size;
+            bool spilled;
+            const uint8_t* value_data;
+            std::size_t value_size;
+        };
+
+        template<typename F>
+        void with_transaction(F&& action, TransactionMode mode, MDBX_txn* txn = nullptr) const {
+            if (txn) {
+                action(checked_external_txn(txn));
+                return;
+            }
+            txn = thread_txn();
+            if (txn) {
+                action(txn);
+                return;
+            }
+            if (try_group_write(action, mode)) return;
+
+            auto txn_guard = m_connection->transaction(mode);
+            try {
+                action(txn_guard.handle());
+                txn_guard.commit();
+            } catch (...) {
+                try { txn_guard.rollback(); } catch (...) {}
+                throw;
+            }
+        }
+
+        bool hash_filter_rejects(std::uint64_t hash, MDBX_txn* txn) const {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            return filter && filter->covers(mdbx_txn_id(txn)) && !filter->may_contain(hash);
+        }
+
+        void hash_filter_add(std::uint64_t hash) {
+            std::shared_ptr<detail::HashFilter> filter = std::atomic_load(&m_hash_filter);
+            if (filter) {
+                filter->add(hash);
+            }
+        }
+
+        void db_build_hash_filter(std::size_t expected_keys, std::size_t bits_per_key) {
+            if (thread_txn()) {
+                throw std::logic_error("HashedKeyValueStore: hash filter cannot be built inside an active transaction");
+            }
+            const bool read_only = m_connection->is_read_only();
+            auto txn = m_connection->transaction(
+                read_only ? TransactionMode::READ_ONLY : TransactionMode::WRITABLE
+            );
+            try {
+                MDBX_txn* t = txn.handle();
+                // A write txn id is one past the snapshot it reads.
+                const std::uint64_t txnid = mdbx_txn_id(t);
+                std::shared_ptr<detail::HashFilter> filter = std::make_shared<detail::HashFilter>(
+                    (std::max)(expected_keys, db_count(t)),
+                    bits_per_key,
+                    read_only ? txnid : txnid - 1
+                );
+                MDBX_cursor* cursor = nullptr;
+                check_mdbx(mdbx_cursor_open(t, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+                try {
+                    MDBX_val db_hash, db_val;
+                    int rc = MDBX_SUCCESS;
+                    while ((rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_NODUP)) == MDBX_SUCCESS) {
+                        filter->add(deserialize_key<std::uint64_t>(db_hash));
+                    }
+                    if (rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "Failed to scan hashed key-value buckets");
+                    }
+                    mdbx_cursor_close(cursor);
+                } catch (...) {
+                    mdbx_cursor_close(cursor);
+                    throw;
+                }
+                std::atomic_store(&m_hash_filter, filter);
+                txn.rollback();
+            } catch (...) {
+                try { txn.rollback(); } catch (...) {}
+                throw;
+            }
+        }
+
+        static std::string payload_name_for(const std::string& name) {
+            return name + "__payload";
+        }
+
+        void open_payload(const std::string& payload_name, MDBX_db_flags_t flags) {
+            m_payload_dbi = m_connection->open_dbi(
+                payload_name,
+                static_cast<MDBX_db_flags_t>(flags | MDBX_INTEGERKEY)
+            );
+        }
+
+        static void write_u64_le(std::uint64_t value, uint8_t* out) noexcept {
+            for (int i = 0; i < 8; ++i) {
+                out[i] = static_cast<uint8_t>((value >> (8 * i)) & 0xffu);
+            }
+        }
+
+        static std::uint64_t read_u64_le(const uint8_t* data) noexcept {
+            std::uint64_t value = 0;
+            for (int i = 0; i < 8; ++i) {
+                value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        static std::vector<uint8_t> copy_bytes(const void* data, std::size_t size) {
+            std::vector<uint8_t> out(size);
+            if (size) {
+                std::memcpy(out.data(), data, size);
+            }
+            return out;
+        }
+
+        static std::vector<uint8_t> key_bytes(const KeyT& key) {
+            ByteView view = make_byte_view(key);
+            return copy_bytes(view.data, view.size);
+        }
+
+        std::uint64_t hash_key_bytes(const std::vector<uint8_t>& bytes) const {
+            return m_hasher(ByteView(bytes.empty() ? nullptr : bytes.data(), bytes.size()));
+        }
+
+        MDBX_val hash_key_view(std::uint64_t hash, SerializeScratch& sc_hash) const {
+            return serialize_key<true>(hash, sc_hash);
+        }
+
+        static PackedRecordView parse_record(const MDBX_val& db_val) {
+            if (db_val.iov_len < header_size || !db_val.iov_base) {
+                throw std::runtime_error("Corrupted hashed key-value duplicate value");
+            }
+
+            const uint8_t* data = static_cast<const uint8_t*>(db_val.iov_base);
+            const std::uint64_t key_size64 = read_u64_le(data);
+            const uint8_t kind = data[8];
+            const std::size_t available = db_val.iov_len - header_size;
+            if (key_size64 > static_cast<std::uint64_t>(available) ||
+                (kind != inline_kind && kind != spilled_kind)) {
+                throw std::runtime_error("Corrupted hashed key-value duplicate value");
+            }
+
+            PackedRecordView view;
+            view.key_data = data + header_size;
+            view.key_size = static_cast<std::size_t>(key_size64);
+            view.spilled = kind == spilled_kind;
+            view.value_data = view.key_data + view.key_size;
+            view.value_size = available - view.key_size;
+            if (view.spilled && view.value_size != 8) {
+                throw std::runtime_error("Corrupted hashed key-value duplicate value");
+            }
+            return view;
+        }
+
+        static bool key_matches(const PackedRecordView& record, const std::vector<uint8_t>& key) {
+            if (record.key_size != key.size()) {
+                return false;
+            }
+            return detail::hashed_key_bytes_equal(record.key_data, key.data(), key.size());
+        }
+
+        template<class T>
+        static typename std::enable_if<std::is_same<T, std::string>::value, T>::type
+        make_key_from_bytes(const uint8_t* data, std::size_t size) {
+            if (!size) {
+                return T();
+            }
+            return T(reinterpret_cast<const char*>(data), size);
+        }
+
+        template<class T>
+        static typename std::enable_if<!std::is_same<T, std::string>::value, T>::type
+        make_key_from_bytes(const uint8_t* data, std::size_t size) {
+            T out;
+            out.resize(size);
+            if (size) {
+                std::memcpy(out.data(), data, size);
+            }
+            return out;
+        }
+
+        static KeyT deserialize_key_bytes(const uint8_t* data, std::size_t size) {
+            return make_key_from_bytes<KeyT>(data, size);
+        }
+
+        static std::uint64_t spill_id(const PackedRecordView& record) {
+            return read_u64_le(record.value_data);
+        }
+
+        /// \brief Returns the serialized payload, inline or from the payload DBI.
+        MDBX_val payload_view(const PackedRecordView& record, MDBX_txn* txn) const {
+            if (!record.spilled) {
+                return SerializeScratch::view(
+                    record.value_size ? record.value_data : nullptr,
+                    record.value_size
+                );
+            }
+            SerializeScratch sc_id;
+            MDBX_val db_id = serialize_key<true>(spill_id(record), sc_id);
+            MDBX_val db_payload;
+            int rc = mdbx_get(txn, m_payload_dbi, &db_id, &db_payload);
+            if (rc == MDBX_NOTFOUND) {
+                throw std::runtime_error("Hashed key-value duplicate references a missing payload");
+            }
+            check_mdbx(rc, "Failed to read hashed key-value payload");
+            return db_payload;
+        }
+
+        ValueT read_payload_value(const PackedRecordView& record, MDBX_txn* txn) const {
+            return deserialize_value<ValueT>(payload_view(record, txn));
+        }
+
+        bool fits_inline(std::size_t key_size, std::size_t value_size) const {
+            if (value_size > m_inline_limit) {
+                return false;
+            }
+            const int64_t limit = m_connection->max_dupsort_value_size();
+            return limit <= 0 || header_size + key_size + value_size <= static_cast<std::size_t>(limit);
+        }
+
+        std::uint64_t next_spill_id(MDBX_txn* txn) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_payload_dbi, &cursor), "Failed to open hashed key-value payload cursor");
+            try {
+                MDBX_val db_id, db_payload;
+                int rc = mdbx_cursor_get(cursor, &db_id, &db_payload, MDBX_LAST);
+                std::uint64_t next = 0;
+                if (rc == MDBX_SUCCESS) {
+                    const std::uint64_t last = deserialize_key<std::uint64_t>(db_id);
+                    if (last == std::numeric_limits<std::uint64_t>::max()) {
+                        throw std::overflow_error("Hashed key-value payload id exhausted");
+                    }
+                    next = last + 1;
+                } else if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to read last hashed key-value payload id");
+                }
+                mdbx_cursor_close(cursor);
+                return next;
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        void put_spill(std::uint64_t id, const MDBX_val& raw_value, MDBX_put_flags_t flags, MDBX_txn* txn) {
+            SerializeScratch sc_id;
+            MDBX_val db_id = serialize_key<true>(id, sc_id);
+            MDBX_val db_payload = raw_value;
+            check_mdbx(mdbx_put(txn, m_payload_dbi, &db_id, &db_payload, flags),
+                       "Failed to write hashed key-value payload");
+        }
+
+        void delete_spill(std::uint64_t id, MDBX_txn* txn) {
+            SerializeScratch sc_id;
+            MDBX_val db_id = serialize_key<true>(id, sc_id);
+            int rc = mdbx_del(txn, m_payload_dbi, &db_id, nullptr);
+            if (rc == MDBX_NOTFOUND) {
+                throw std::runtime_error("Hashed key-value duplicate references a missing payload");
+            }
+            check_mdbx(rc, "Failed to delete hashed key-value payload");
+        }
+
+        void put_new_duplicate(const std::vector<uint8_t>& original_key,
+                               std::uint64_t hash,
+                               const MDBX_val& raw_value,
+                               MDBX_txn* txn) {
+            const bool inline_value = fits_inline(original_key.size(), raw_value.iov_len);
+            const std::size_t tail_size = inline_value ? raw_value.iov_len : 8;
+            std::vector<uint8_t> payload(header_size + original_key.size() + tail_size);
+            write_u64_le(static_cast<std::uint64_t>(original_key.size()), payload.data());
+            payload[8] = static_cast<uint8_t>(inline_value ? inline_kind : spilled_kind);
+            if (!original_key.empty()) {
+                std::memcpy(payload.data() + header_size, original_key.data(), original_key.size());
+            }
+            uint8_t* tail = payload.data() + header_size + original_key.size();
+            MDBX_val db_val = SerializeScratch::view(payload.data(), payload.size());
+            check_dupsort_value_size(db_val);
+            if (inline_value) {
+                if (raw_value.iov_len) {
+                    std::memcpy(tail, raw_value.iov_base, raw_value.iov_len);
+                }
+            } else {
+                const std::uint64_t id = next_spill_id(txn);
+                put_spill(id, raw_value, MDBX_NOOVERWRITE, txn);
+                write_u64_le(id, tail);
+            }
+
+            hash_filter_add(hash);
+            SerializeScratch sc_hash;
+            MDBX_val db_hash = hash_key_view(hash, sc_hash);
+            int rc = mdbx_put(txn, m_dbi, &db_hash, &db_val, MDBX_NODUPDATA);
+            if (rc == MDBX_KEYEXIST) {
+                throw std::runtime_error("Hashed key-value duplicate already exists");
+            }
+            check_mdbx(rc, "Failed to write hashed key-value duplicate");
+        }
+
+        template<typename Found>
+        bool with_matching_duplicate(const std::vector<uint8_t>& key,
+                                     std::uint64_t hash,
+                                     MDBX_txn* txn,
+                                     Found found) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                SerializeScratch sc_hash;
+                MDBX_val db_hash = hash_key_view(hash, sc_hash);
+                MDBX_val db_val;
+                int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_SET_KEY);
+                if (rc == MDBX_NOTFOUND) {
+                    mdbx_cursor_close(cursor);
+                    return false;
+                }
+                check_mdbx(rc, "Failed to seek hashed key-value bucket");
+
+                while (rc == MDBX_SUCCESS) {
+                    PackedRecordView record = parse_record(db_val);
+                    if (key_matches(record, key)) {
+                        found(cursor, record);
+                        mdbx_cursor_close(cursor);
+                        return true;
+                    }
+                    rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_DUP);
+                }
+
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to scan hashed key-value bucket");
+                }
+                mdbx_cursor_close(cursor);
+                return false;
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        bool db_get(const KeyT& key, ValueT& value, MDBX_txn* txn) const {
+            std::vector<uint8_t> original_key = key_bytes(key);
+            const std::uint64_t hash = hash_key_bytes(original_key);
+            if (hash_filter_rejects(hash, txn)) {
+                return false;
+            }
+            return with_matching_duplicate(
+                original_key,
+                hash,
+                txn,
+                [this, &value, txn](MDBX_cursor*, const PackedRecordView& record) {
+                    value = read_payload_value(record, txn);
+                }
+            );
+        }
+
+        bool db_contains(const KeyT& key, MDBX_txn* txn) const {
+            std::vector<uint8_t> original_key = key_bytes(key);
+            const std::uint64_t hash = hash_key_bytes(original_key);
+            if (hash_filter_rejects(hash, txn)) {
+                return false;
+            }
+            return with_matching_duplicate(
+                original_key,
+                hash,
+                txn,
+                [](MDBX_cursor*, const PackedRecordView&) {}
+            );
+        }
+
+        template<typename EmitT>
+        std::size_t db_find_many_batch(const std::vector<KeyT>& keys, EmitT emit, MDBX_txn* txn) const {
+            const std::size_t count = keys.size();
+            std::vector<std::vector<uint8_t> > original_keys(count);
+            std::vector<std::uint64_t> hashes(count);
+            std::vector<std::size_t> order;
+            order.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                original_keys[i] = key_bytes(keys[i]);
+                hashes[i] = hash_key_bytes(original_keys[i]);
+                if (!hash_filter_rejects(hashes[i], txn)) {
+                    order.push_back(i);
+                }
+            }
+            if (order.empty()) {
+                return 0;
+            }
+            std::stable_sort(order.begin(), order.end(), [&hashes](std::size_t lhs, std::size_t rhs) {
+                return hashes[lhs] < hashes[rhs];
+            });
+
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                std::size_t found = 0;
+                bool positioned = false;
+                std::uint64_t current = 0;
+                MDBX_val db_hash{};
+                MDBX_val db_val{};
+                for (std::size_t pos = 0; pos < order.size(); ++pos) {
+                    const std::size_t index = order[pos];
+                    const std::uint64_t target = hashes[index];
+                    if (positioned && current < target) {
+                        // Neighbouring hashes often share a page: try one step first.
+                        int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_NODUP);
+                        if (rc == MDBX_NOTFOUND) break;
+                        check_mdbx(rc, "Failed to step hashed key-value batch cursor");
+                        current = deserialize_key<std::uint64_t>(db_hash);
+                    }
+                    if (!positioned || current < target) {
+                        SerializeScratch sc_hash;
+                        db_hash = hash_key_view(target, sc_hash);
+                        int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_SET_RANGE);
+                        if (rc == MDBX_NOTFOUND) break;
+                        check_mdbx(rc, "Failed to seek hashed key-value batch cursor");
+                        positioned = true;
+                        current = deserialize_key<std::uint64_t>(db_hash);
+                    }
+                    if (current != target) {
+                        continue;
+                    }
+
+                    int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_FIRST_DUP);
+                    while (rc == MDBX_SUCCESS) {
+                        PackedRecordView record = parse_record(db_val);
+                        if (key_matches(record, original_keys[index])) {
+                            emit(index, read_payload_value(record, txn));
+                            ++found;
+                            break;
+                        }
+                        rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT_DUP);
+                    }
+                    if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "Failed to scan hashed key-value bucket");
+                    }
+                }
+                mdbx_cursor_close(cursor);
+                return found;
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        bool db_read_buckets(std::uint64_t from_hash,
+                             std::size_t max_records,
+                             std::vector<value_type>& out,
+                             std::uint64_t& next_hash,
+                             MDBX_txn* txn) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                SerializeScratch sc_hash;
+                MDBX_val db_hash = hash_key_view(from_hash, sc_hash);
+                MDBX_val db_val;
+                std::size_t taken = 0;
+                std::uint64_t current = 0;
+                int rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_SET_RANGE);
+                while (rc == MDBX_SUCCESS) {
+                    const std::uint64_t hash = deserialize_key<std::uint64_t>(db_hash);
+                    if (taken && hash != current && taken >= max_records) {
+                        next_hash = hash;
+                        mdbx_cursor_close(cursor);
+                        return true;
+                    }
+                    current = hash;
+                    PackedRecordView record = parse_record(db_val);
+                    out.emplace_back(deserialize_key_bytes(record.key_data, record.key_size),
+                                     read_payload_value(record, txn));
+                    ++taken;
+                    rc = mdbx_cursor_get(cursor, &db_hash, &db_val, MDBX_NEXT);
+                }
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to scan hashed key-value buckets");
+                }
+                mdbx_cursor_close(cursor);
+                return false;
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        bool db_insert_if_absent(const KeyT& key, const ValueT& value, MDBX_txn* txn) {
+            std::vector<uint8_t> original_key = key_bytes(key);
+            const std::uint64_t hash = hash_key_bytes(original_key);
+            if (!hash_filter_rejects(hash, txn) &&
+                with_matching_duplicate(
+                    original_key,
+                    hash,
+                    txn,
+                    [](MDBX_cursor*, const PackedRecordView&) {})) {
+                return false;
+            }
+            SerializeScratch sc_value;
+            MDBX_val raw_value = serialize_value(value, sc_value);
+            put_new_duplicate(original_key, hash, raw_value, txn);
+            return true;
+        }
+
+        void db_insert_or_assign(const KeyT& key, const ValueT& value, MDBX_txn* txn) {
+            std::vector<uint8_t> original_key = key_bytes(key);
+            const std::uint64_t hash = hash_key_bytes(original_key);
+            SerializeScratch sc_value;
+            MDBX_val raw_value = serialize_value(value, sc_value);
+            const bool inline_value = fits_inline(original_key.size(), raw_value.iov_len);
+
+            bool old_spilled = false;
+            std::uint64_t old_id = 0;
+            if (!hash_filter_rejects(hash, txn)) {
+                with_matching_duplicate(
+                    original_key,
+                    hash,
+                    txn,
+                    [inline_value, &old_spilled, &old_id](MDBX_cursor* cursor, const PackedRecordView& record) {
+                        if (record.spilled) {
+                            old_spilled = true;
+                            old_id = spill_id(record);
+                        }
+                        // A spilled record that stays spilled keeps its duplicate and id.
+                        if (!(record.spilled && !inline_value)) {
+                            check_mdbx(mdbx_cursor_del(cursor, MDBX_CURRENT), "Failed to replace hashed key-value duplicate");
+                        }
+                    }
+                );
+            }
+            if (old_spilled && !inline_value) {
+                put_spill(old_id, raw_value, MDBX_UPSERT, txn);
+                return;
+            }
+            if (old_spilled) {
+                delete_spill(old_id, txn);
+            }
+            put_new_duplicate(original_key, hash, raw_value, txn);
+        }
+
+        bool db_erase(const KeyT& key, MDBX_txn* txn) {
+            std::vector<uint8_t> original_key = key_bytes(key);
+            const std::uint64_t hash = hash_key_bytes(original_key);
+            if (hash_filter_rejects(hash, txn)) {
+                return false;
+            }
+            return with_matching_duplicate(
+                original_key,
+                hash,
+                txn,
+                [this, txn](MDBX_cursor* cursor, const PackedRecordView& record) {
+                    if (record.spilled) {
+                        delete_spill(spill_id(record), txn);
+                    }
+                    check_mdbx(mdbx_cursor_del(cursor, MDBX_CURRENT), "Failed to delete hashed key-value duplicate");
+                }
+            );
+        }
+
+        std::size_t db_count(MDBX_txn* txn) const {
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat)), "Failed to query hashed key-value statistics");
+            return stat.ms_entries;
+        }
+
+        template<typename Fn>
+        void db_for_each(Fn fn, MDBX_txn* txn) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                MDBX_val db_key, db_val;
+                int rc = MDBX_SUCCESS;
+                while ((rc = mdbx_cursor_get(cursor, &db_key, &db_val, MDBX_NEXT)) == MDBX_SUCCESS) {
+                    PackedRecordView record = parse_record(db_val);
+                    fn(deserialize_key_bytes(record.key_data, record.key_size), read_payload_value(record, txn));
+                }
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to read hashed key-value duplicates");
+                }
+                mdbx_cursor_close(cursor);
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        template<template<class...> class ContainerT>
+        void db_load(ContainerT<KeyT, ValueT>& container, MDBX_txn* txn) const {
+            db_for_each([&container](KeyT&& key, ValueT&& value) {
+                container.emplace(std::move(key), std::move(value));
+            }, txn);
+        }
+
+        void db_load(std::vector<value_type>& container, MDBX_txn* txn) const {
+            db_for_each([&container](KeyT&& key, ValueT&& value) {
+                container.emplace_back(std::move(key), std::move(value));
+            }, txn);
+        }
+
+        /// \brief Decodes records on workers; spilled payloads are looked up
+        ///        here on the transaction's thread and passed as raw views.
+        void db_parallel_load(std::vector<value_type>& container, std::size_t threads,
+                              MDBX_txn* txn) const {
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                detail::parallel_decode(threads, db_count(txn),
+                    [this, cursor, txn](detail::RawRecord& raw) -> bool {
+                        MDBX_val db_key;
+                        MDBX_val db_val;
+                        const int rc = mdbx_cursor_get(cursor, &db_key, &db_val, MDBX_NEXT);
+                        if (rc == MDBX_NOTFOUND) return false;
+                        check_mdbx(rc, "Failed to read hashed key-value duplicates");
+                        PackedRecordView record = parse_record(db_val);
+                        raw.key = SerializeScratch::view(record.key_size ? record.key_data : nullptr,
+                                                         record.key_size);
+                        raw.value = payload_view(record, txn);
+                        return true;
+                    },
+                    [](const detail::RawRecord& raw) {
+                        return value_type(deserialize_key_bytes(static_cast<const uint8_t*>(raw.key.iov_base),
+                                                                raw.key.iov_len),
+                                          deserialize_value<ValueT>(raw.value));
+                    },
+                    container);
+                mdbx_cursor_close(cursor);
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        template<template<class...> class ContainerT>
+        void db_append(const ContainerT<KeyT, ValueT>& container, MDBX_txn* txn) {
+            for (typename ContainerT<KeyT, ValueT>::const_iterator it = container.begin();
+                 it != container.end(); ++it) {
+                db_insert_or_assign(it->first, it->second, txn);
+            }
+        }
+
+        void db_append(const std::vector<value_type>& container, MDBX_txn* txn) {
+            for (typename std::vector<value_type>::const_iterator it = container.begin();
+                 it != container.end(); ++it) {
+                db_insert_or_assign(it->first, it->second, txn);
+            }
+        }
+
+        template<class ContainerT>
+        void db_reconcile_impl(const ContainerT& container, MDBX_txn* txn) {
+            std::set<std::vector<uint8_t> > desired_keys;
+            for (typename ContainerT::const_iterator it = container.begin(); it != container.end(); ++it) {
+                desired_keys.insert(key_bytes(it->first));
+                db_insert_or_assign(it->first, it->second, txn);
+            }
+
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &cursor), "Failed to open hashed key-value cursor");
+            try {
+                MDBX_val db_key, db_val;
+                int rc = MDBX_SUCCESS;
+                while ((rc = mdbx_cursor_get(cursor, &db_key, &db_val, MDBX_NEXT)) == MDBX_SUCCESS) {
+                    PackedRecordView record = parse_record(db_val);
+                    std::vector<uint8_t> stored_key = copy_bytes(record.key_data, record.key_size);
+                    if (desired_keys.find(stored_key) == desired_keys.end()) {
+                        if (record.spilled) {
+                            delete_spill(spill_id(record), txn);
+                        }
+                        check_mdbx(mdbx_cursor_del(cursor, MDBX_CURRENT), "Failed to delete stale hashed key-value duplicate");
+                    }
+                }
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to scan hashed key-value duplicates");
+                }
+                mdbx_cursor_close(cursor);
+            } catch (...) {
+                mdbx_cursor_close(cursor);
+                throw;
+            }
+        }
+
+        template<template<class...> class ContainerT>
+        void db_reconcile(const ContainerT<KeyT, ValueT>& container, MDBX_txn* txn) {
+            db_reconcile_impl(container, txn);
+        }
+
+        void db_reconcile(const std::vector<value_type>& container, MDBX_txn* txn) {
+            db_reconcile_impl(container, txn);
+        }
+
+        void db_clear(MDBX_txn* txn) {
+            check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear hashed key-value duplicates");
+            check_mdbx(mdbx_drop(txn, m_payload_dbi, 0), "Failed to clear hashed key-value payloads");
+        }
+    };
+
+    /// \brief Copies every record of one hashed store into another in chunked transactions.
+    /// \details Works between any two layouts and hashers with the same key and
+    /// value types. The source is read bucket by bucket with
+    /// \c read_buckets() in short read transactions and each chunk is written
+    /// to the target with \c append() in its own write transaction, so readers
+    /// and writers of both stores keep running. Source writes made behind the
+    /// migration cursor are not carried over; run a final pass, or
+    /// \c reconcile() the target, once source writers have stopped.
+    /// \param source Store to read from.
+    /// \param target Store to write into; existing keys are overwritten.
+    /// \param chunk_size Records per write transaction; buckets are not split.
+    /// \return Number of records copied.
+    /// \throws std::invalid_argument if \p chunk_size is zero.
+    template<class SourceStore, class TargetStore>
+    std::size_t migrate_hashed_store(const SourceStore& source,
+                                     TargetStore& target,
+                                     std::size_t chunk_size = 1024) {
+        if (!chunk_size) {
+            throw std::invalid_argument("migrate_hashed_store: chunk_size must be positive");
+        }
+        std::vector<typename SourceStore::value_type> chunk;
+        std::uint64_t from_hash = 0;
+        std::size_t copied = 0;
+        bool more = true;
+        while (more) {
+            std::uint64_t next_hash = 0;
+            more = source.read_buckets(from_hash, chunk_size, chunk, next_hash);
+            if (!chunk.empty()) {
+                target.append(chunk);
+                copied += chunk.size();
+            }
+            from_hash = next_hash;
+        }
+        return copied;
+    }
+
 } // namespace mdbxc
 
 #endif // MDBX_CONTAINERS_HEADER_HASHED_KEY_VALUE_STORE_HPP_INCLUDED
@@ -14,6 +14,7 @@
 /// or missing records.
 
 #include "common.hpp"
+#include "detail/ResultContainers.hpp"
 #include <limits>
 #include <map>
 
@@ -24,8 +25,8 @@ namespace mdbxc {
     /// \brief Multi-value table persisted in MDBX.
     /// \tparam KeyT Type of the keys.
     /// \tparam ValueT Type of the values.
-    /// \tparam Options Compile-time table policy. Does not change the database
-    ///         storage format.
+    /// \tparam Options Compile-time table policy. Only \c Options::dup_fixed
+    ///         changes the database layout; see \c DupFixedTableOptions.
     /// \details
     /// Provides a \c std::multimap -like API over an MDBX \c MDBX_DUPSORT table.
     /// Each insert creates a separate stored pair. Exact repeated
@@ -40,6 +41,9 @@ namespace mdbxc {
     ///       preserves existing matching records, removes surplus records, and
     ///       inserts missing records. It does not reorder existing records to
     ///       match source iteration order.
+    /// \note With \c DupFixedTableOptions the DBI is opened with
+    ///       \c MDBX_DUPFIXED and \c find(key) copies whole pages of duplicates
+    ///       per cursor call. \c ValueT must be trivially copyable.
     template<class KeyT, class ValueT, class Options = DefaultTableOptions>
     class KeyMultiValueTable final : public BaseTable {
     public:
@@ -54,7 +58,7 @@ namespace mdbxc {
                            MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
             : BaseTable(std::move(connection),
                         std::move(name),
-                        flags | MDBX_DUPSORT | get_mdbx_flags<KeyT>()) {}
+                        flags | MDBX_DUPSORT | dup_fixed_flags() | get_mdbx_flags<KeyT>()) {}
 
         /// \brief Constructs table using configuration.
         /// \param config Configuration settings.
@@ -65,7 +69,7 @@ namespace mdbxc {
                                     MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
             : BaseTable(Connection::create(config),
                         std::move(name),
-                        flags | MDBX_DUPSORT | get_mdbx_flags<KeyT>()) {}
+                        flags | MDBX_DUPSORT | dup_fixed_flags() | get_mdbx_flags<KeyT>()) {}
 
         /// \brief Destructor.
         ~KeyMultiValueTable() override = default;
@@ -786,6 +790,62 @@ namespace mdbxc {
             return count_range(from_key, to_key, txn.handle());
         }
 
+        /// \brief Estimates the number of physical pairs within an inclusive range.
+        /// \details O(log n): uses \c mdbx_estimate_range() instead of walking the
+        /// range, so the result is approximate. Use \ref count_range() for an exact count.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Optional transaction handle.
+        /// \return Estimated number of physical pairs in the requested range.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t estimate_count_range(const KeyT& from_key, const KeyT& to_key,
+                                         MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = db_estimate_count_range(from_key, to_key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Estimates the number of physical pairs within an inclusive range.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Active transaction wrapper.
+        /// \return Estimated number of physical pairs in the requested range.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t estimate_count_range(const KeyT& from_key, const KeyT& to_key,
+                                         const Transaction& txn) const {
+            return estimate_count_range(from_key, to_key, txn.handle());
+        }
+
+        /// \brief Estimates the storage size of physical pairs within an inclusive range.
+        /// \details Scales \ref estimate_count_range() by the average per-entry page
+        /// footprint reported by \c mdbx_dbi_stat(), including page overhead.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Optional transaction handle.
+        /// \return Estimated size in bytes.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t estimate_bytes_range(const KeyT& from_key, const KeyT& to_key,
+                                           MDBX_txn* txn = nullptr) const {
+            std::uint64_t result = 0;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = estimate_range_bytes(t, db_estimate_count_range(from_key, to_key, t));
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Estimates the storage size of physical pairs within an inclusive range.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Active transaction wrapper.
+        /// \return Estimated size in bytes.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t estimate_bytes_range(const KeyT& from_key, const KeyT& to_key,
+                                           const Transaction& txn) const {
+            return estimate_bytes_range(from_key, to_key, txn.handle());
+        }
+
         /// \brief Removes all physical pairs within an inclusive key range.
         /// \param from_key Start key in MDBX key order.
         /// \param to_key End key in MDBX key order.
@@ -931,6 +991,34 @@ namespace mdbxc {
             insert(pair, txn.handle());
         }
 
+        /// \brief Inserts several values under one key.
+        /// \tparam InputIt Input iterator over \c ValueT.
+        /// \param key Key to insert under.
+        /// \param first Start of the value range.
+        /// \param last End of the value range.
+        /// \param txn Optional transaction handle.
+        /// \details Values keep iteration order after the existing values of
+        /// \p key. The key is located once and each value is appended with
+        /// \c MDBX_APPENDDUP through the same cursor; with
+        /// \c DupFixedTableOptions values are written in \c MDBX_MULTIPLE batches.
+        template<typename InputIt>
+        void insert_many(const KeyT& key, InputIt first, InputIt last, MDBX_txn* txn = nullptr) {
+            with_transaction([this, &key, &first, &last](MDBX_txn* t) {
+                db_insert_many(key, first, last, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Inserts several values under one key.
+        /// \tparam InputIt Input iterator over \c ValueT.
+        /// \param key Key to insert under.
+        /// \param first Start of the value range.
+        /// \param last End of the value range.
+        /// \param txn Active transaction wrapper.
+        template<typename InputIt>
+        void insert_many(const KeyT& key, InputIt first, InputIt last, const Transaction& txn) {
+            insert_many(key, first, last, txn.handle());
+        }
+
         /// \brief Finds all values for a key.
         /// \param key Key to search for.
         /// \param txn Optional transaction handle.
@@ -951,6 +1039,70 @@ namespace mdbxc {
             return find(key, txn.handle());
         }
 
+        /// \brief Appends all values for a key to a caller container.
+        /// \details \p out may be any sequence or set container constructible
+        /// from a value, including \c std::pmr containers; elements are built
+        /// with the container's allocator, and in C++17 string values are passed
+        /// as \c std::string_view so \c std::pmr::string elements are copied
+        /// straight into the arena.
+        /// \param key Key to search for.
+        /// \param out Container receiving the values in insertion order.
+        /// \param txn Optional transaction handle.
+        /// \return Number of values appended.
+        template<class OutT>
+        std::size_t find_into(const KeyT& key, OutT& out, MDBX_txn* txn = nullptr) const {
+            std::size_t appended = 0;
+            with_transaction([this, &key, &out, &appended](MDBX_txn* t) {
+                auto emit = [&out, &appended](const MDBX_val& stored) -> bool {
+                    detail::emplace_result(out, detail::result_arg<ValueT>::value(stored));
+                    ++appended;
+                    return true;
+                };
+                db_for_each_raw_value(key, emit, t, std::integral_constant<bool, dup_fixed_layout>());
+            }, TransactionMode::READ_ONLY, txn);
+            return appended;
+        }
+
+        /// \brief Appends all values for a key to a caller container.
+        /// \param key Key to search for.
+        /// \param out Container receiving the values in insertion order.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of values appended.
+        template<class OutT>
+        std::size_t find_into(const KeyT& key, OutT& out, const Transaction& txn) const {
+            return find_into(key, out, txn.handle());
+        }
+
+        /// \brief Calls a callback for every value of a key without collecting them.
+        /// \details Walks the duplicates with \c MDBX_NEXT_DUP, or a page at a time
+        /// with \c MDBX_GET_MULTIPLE for fixed-size values, and deserializes each
+        /// value only when it is visited.
+        /// \param key Key to visit.
+        /// \param callback Invoked as \c callback(const ValueT&). Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every value was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_value(const KeyT& key, CallbackT callback, MDBX_txn* txn = nullptr) const {
+            bool completed = false;
+            with_transaction([this, &key, &callback, &completed](MDBX_txn* t) {
+                completed = db_for_each_value(key, callback, t,
+                                              std::integral_constant<bool, dup_fixed_layout>());
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Calls a callback for every value of a key without collecting them.
+        /// \param key Key to visit.
+        /// \param callback Invoked as \c callback(const ValueT&). Return \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every value was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_value(const KeyT& key, CallbackT callback, const Transaction& txn) const {
+            return for_each_value(key, callback, txn.handle());
+        }
+
         /// \brief Checks whether a key exists.
         /// \param key Key to look up.
         /// \param txn Optional transaction handle.
@@ -1053,6 +1205,57 @@ namespace mdbxc {
             return count(key, value, txn.handle());
         }
 
+        /// \brief Counts values stored for each key without reading the values.
+        /// \details Uses \c mdbx_cursor_count() on one cursor, so each key costs a
+        /// single seek regardless of how many duplicates it holds.
+        /// \param keys Keys to count.
+        /// \param txn Optional transaction handle.
+        /// \return Value counts in the order of \p keys; zero for missing keys.
+        /// \throws MdbxException if a database error occurs.
+        std::vector<std::size_t> count_many(const std::vector<KeyT>& keys, MDBX_txn* txn = nullptr) const {
+            std::vector<std::size_t> res;
+            with_transaction([this, &keys, &res](MDBX_txn* t) {
+                res = db_count_many(keys, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Counts values stored for each key without reading the values.
+        /// \param keys Keys to count.
+        /// \param txn Active transaction wrapper.
+        /// \return Value counts in the order of \p keys; zero for missing keys.
+        /// \throws MdbxException if a database error occurs.
+        std::vector<std::size_t> count_many(const std::vector<KeyT>& keys, const Transaction& txn) const {
+            return count_many(keys, txn.handle());
+        }
+
+        /// \brief Lists each distinct key of an inclusive range with its value count.
+        /// \details Steps key by key with \c MDBX_NEXT_NODUP and never deserializes values.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Optional transaction handle.
+        /// \return Pairs of key and number of values, in key order.
+        /// \throws MdbxException if a database error occurs.
+        std::vector<std::pair<KeyT, std::size_t>> key_cardinalities(const KeyT& from_key, const KeyT& to_key,
+                                                                    MDBX_txn* txn = nullptr) const {
+            std::vector<std::pair<KeyT, std::size_t>> res;
+            with_transaction([this, &from_key, &to_key, &res](MDBX_txn* t) {
+                res = db_key_cardinalities(from_key, to_key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Lists each distinct key of an inclusive range with its value count.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Active transaction wrapper.
+        /// \return Pairs of key and number of values, in key order.
+        /// \throws MdbxException if a database error occurs.
+        std::vector<std::pair<KeyT, std::size_t>> key_cardinalities(const KeyT& from_key, const KeyT& to_key,
+                                                                    const Transaction& txn) const {
+            return key_cardinalities(from_key, to_key, txn.handle());
+        }
+
         /// \brief Checks whether the table has no pairs.
         /// \param txn Optional transaction handle.
         /// \return \c true if the table is empty.
@@ -1126,6 +1329,17 @@ namespace mdbxc {
     private:
         static const std::size_t sequence_size = sizeof(uint64_t);
 
+        /// True when duplicates use the \c MDBX_DUPFIXED layout.
+        static const bool dup_fixed_layout = Options::dup_fixed;
+        static_assert(!dup_fixed_layout ||
+                      (std::is_trivially_copyable<ValueT>::value && !has_to_bytes<ValueT>::value &&
+                       !has_serializer<ValueT>::value),
+                      "DUPFIXED layout requires a trivially copyable value type");
+
+        static MDBX_db_flags_t dup_fixed_flags() {
+            return dup_fixed_layout ? MDBX_DUPFIXED : static_cast<MDBX_db_flags_t>(0);
+        }
+
         struct SerializedPairKey {
             std::vector<uint8_t> key;
             std::vector<uint8_t> value;
@@ -1158,6 +1372,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
 
             auto txn_guard = m_connection->transaction(mode);
             try {
@@ -1257,8 +1472,7 @@ namespace mdbxc {
         }
 
         uint64_t next_sequence(const KeyT& key, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -1279,8 +1493,7 @@ namespace mdbxc {
 
         template<template<class...> class ContainerT>
         void db_load(ContainerT<KeyT, ValueT>& container, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             MDBX_val db_key, db_val;
             int rc = MDBX_SUCCESS;
@@ -1295,8 +1508,7 @@ namespace mdbxc {
         }
 
         void db_load(std::vector<value_type>& container, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             MDBX_val db_key, db_val;
             int rc = MDBX_SUCCESS;
@@ -1318,8 +1530,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_from_key;
@@ -1349,8 +1560,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_from_key;
@@ -1378,8 +1588,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) {
                 return true;
             }
@@ -1413,8 +1622,7 @@ namespace mdbxc {
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
             MDBX_val db_val;
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return std::nullopt;
@@ -1429,8 +1637,7 @@ namespace mdbxc {
             MDBX_val db_key_exact = db_key;
             MDBX_val db_val;
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return std::nullopt;
@@ -1448,8 +1655,7 @@ namespace mdbxc {
         }
 
         std::optional<value_type> db_first(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1460,8 +1666,7 @@ namespace mdbxc {
         }
 
         std::optional<value_type> db_last(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1472,8 +1677,7 @@ namespace mdbxc {
         }
 
         std::optional<KeyT> db_min_key(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1484,8 +1688,7 @@ namespace mdbxc {
         }
 
         std::optional<KeyT> db_max_key(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1502,8 +1705,7 @@ namespace mdbxc {
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
             MDBX_val db_val;
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return std::make_pair(false, value_type(KeyT(), ValueT()));
@@ -1518,8 +1720,7 @@ namespace mdbxc {
             MDBX_val db_key_exact = db_key;
             MDBX_val db_val;
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return std::make_pair(false, value_type(KeyT(), ValueT()));
@@ -1537,8 +1738,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, value_type> db_first_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1549,8 +1749,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, value_type> db_last_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1561,8 +1760,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, KeyT> db_min_key_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1573,8 +1771,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, KeyT> db_max_key_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1593,8 +1790,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_to_key;
@@ -1635,8 +1831,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_to_key;
@@ -1682,8 +1877,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return false;
 
             MDBX_val db_key = db_from_key;
@@ -1694,14 +1888,21 @@ namespace mdbxc {
             return mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) <= 0;
         }
 
+        std::size_t db_estimate_count_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+            return estimate_range_items(txn, db_from_key, db_to_key);
+        }
+
         std::size_t db_count_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return 0;
 
             MDBX_val db_key = db_from_key;
@@ -1730,20 +1931,37 @@ namespace mdbxc {
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
             std::size_t removed = 0;
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return 0;
 
             MDBX_val db_key = db_from_key;
             MDBX_val db_val;
             bool stopped_by_upper_bound = false;
+#           if MDBXC_SYNC_ENABLED
+            std::vector<std::uint8_t> recorded_key;
+#           endif
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             while (rc == MDBX_SUCCESS) {
                 if (mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) > 0) {
                     stopped_by_upper_bound = true;
                     break;
                 }
+#               if MDBXC_SYNC_ENABLED
+                // One Delete per key removes all of its values on apply.
+                const bool first_of_key = removed == 0 ||
+                    recorded_key.size() != db_key.iov_len ||
+                    (db_key.iov_len != 0 &&
+                     std::memcmp(recorded_key.data(), db_key.iov_base, db_key.iov_len) != 0);
+                if (first_of_key) {
+                    recorded_key = capture_bytes(db_key);
+                }
+#               endif
                 check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to erase pair in range");
+#               if MDBXC_SYNC_ENABLED
+                if (first_of_key) {
+                    record_op(txn, sync::ChangeOpType::Delete, recorded_key, MDBX_val());
+                }
+#               endif
                 ++removed;
                 rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
             }
@@ -1800,8 +2018,7 @@ namespace mdbxc {
 
             PairCountMap kept;
             {
-                CursorGuard cursor;
-                check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+                CachedCursor cursor(*this, txn);
 
                 MDBX_val db_key, db_val;
                 int rc = MDBX_SUCCESS;
@@ -1812,6 +2029,11 @@ namespace mdbxc {
                         ++kept[serialized];
                     } else {
                         check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to erase surplus record");
+#                       if MDBXC_SYNC_ENABLED
+                        record_op(txn, sync::ChangeOpType::MultiEraseOne, serialized.key,
+                                  SerializeScratch::view(serialized.value.data(),
+                                                         serialized.value.size()));
+#                       endif
                     }
                 }
                 if (rc != MDBX_NOTFOUND) {
@@ -1847,11 +2069,144 @@ namespace mdbxc {
             MDBX_val db_val = make_stored_value(sequence, value, sc_value);
             check_dupsort_value_size(db_val);
             check_mdbx(mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT), "Failed to insert multi-value record");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::MultiInsert, db_key, strip_sequence(db_val));
+#           endif
+        }
+
+        template<typename InputIt>
+        void db_insert_many(const KeyT& key, InputIt first, InputIt last, MDBX_txn* txn) {
+            if (first == last) {
+                return;
+            }
+            db_insert_many(key, first, last, txn, std::integral_constant<bool, dup_fixed_layout>());
+        }
+
+        template<typename InputIt>
+        void db_insert_many(const KeyT& key, InputIt first, InputIt last, MDBX_txn* txn, std::false_type) {
+            uint64_t sequence = next_sequence(key, txn);
+            CachedCursor cursor(*this, txn);
+
+            SerializeScratch sc_key;
+            SerializeScratch sc_value;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            bool exhausted = false;
+            for (; first != last; ++first, ++sequence) {
+                if (exhausted) {
+                    throw std::overflow_error("Per-key multi-value sequence exhausted");
+                }
+                MDBX_val db_val = make_stored_value(sequence, *first, sc_value);
+                check_dupsort_value_size(db_val);
+                check_mdbx(mdbx_cursor_put(cursor.get(), &db_key, &db_val, MDBX_APPENDDUP),
+                           "Failed to insert multi-value record");
+#               if MDBXC_SYNC_ENABLED
+                record_op(txn, sync::ChangeOpType::MultiInsert, db_key, strip_sequence(db_val));
+#               endif
+                exhausted = sequence == std::numeric_limits<uint64_t>::max();
+            }
+        }
+
+        /// \brief Packs values into fixed-size records and writes them with
+        /// \c MDBX_MULTIPLE, at most \c insert_many_batch records per call.
+        template<typename InputIt>
+        void db_insert_many(const KeyT& key, InputIt first, InputIt last, MDBX_txn* txn, std::true_type) {
+            static const std::size_t record_size = sequence_size + sizeof(ValueT);
+            static const std::size_t insert_many_batch = 1024;
+            uint64_t sequence = next_sequence(key, txn);
+            CachedCursor cursor(*this, txn);
+
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val record = SerializeScratch::view(nullptr, record_size);
+            check_dupsort_value_size(record);
+
+            std::vector<uint8_t> batch;
+            batch.reserve(insert_many_batch * record_size);
+            bool exhausted = false;
+            while (first != last) {
+                batch.clear();
+                std::size_t n = 0;
+                for (; first != last && n < insert_many_batch; ++first, ++n, ++sequence) {
+                    if (exhausted) {
+                        throw std::overflow_error("Per-key multi-value sequence exhausted");
+                    }
+                    const ValueT& value = *first;
+                    batch.resize(batch.size() + record_size);
+                    uint8_t* out = batch.data() + batch.size() - record_size;
+                    encode_sequence(sequence, out);
+                    std::memcpy(out + sequence_size, &value, sizeof(ValueT));
+                    exhausted = sequence == std::numeric_limits<uint64_t>::max();
+                }
+
+                std::size_t offset = 0;
+                while (offset < n) {
+                    MDBX_val multi[2];
+                    multi[0].iov_base = batch.data() + offset * record_size;
+                    multi[0].iov_len = record_size;
+                    multi[1].iov_base = nullptr;
+                    multi[1].iov_len = n - offset;
+                    check_mdbx(mdbx_cursor_put(cursor.get(), &db_key, multi, MDBX_MULTIPLE),
+                               "Failed to insert multi-value records");
+                    if (multi[1].iov_len == 0) {
+                        throw std::runtime_error("MDBX_MULTIPLE wrote no multi-value records");
+                    }
+                    offset += multi[1].iov_len;
+                }
+#               if MDBXC_SYNC_ENABLED
+                for (std::size_t i = 0; i < n; ++i) {
+                    record_op(txn, sync::ChangeOpType::MultiInsert, db_key,
+                              SerializeScratch::view(batch.data() + i * record_size + sequence_size,
+                                                     sizeof(ValueT)));
+                }
+#               endif
+            }
         }
 
         void db_find(const KeyT& key, std::vector<ValueT>& values, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            db_find(key, values, txn, std::integral_constant<bool, dup_fixed_layout>());
+        }
+
+        /// \brief Reads the duplicates of \p key a page at a time.
+        /// \details \c MDBX_GET_MULTIPLE / \c MDBX_NEXT_MULTIPLE return contiguous
+        /// runs of fixed-size records; each record is the sequence prefix
+        /// followed by the raw value bytes, copied straight into \p values.
+        void db_find(const KeyT& key, std::vector<ValueT>& values, MDBX_txn* txn, std::true_type) const {
+            static const std::size_t record_size = sequence_size + sizeof(ValueT);
+            CachedCursor cursor(*this, txn);
+
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+            if (rc == MDBX_NOTFOUND) {
+                return;
+            }
+            check_mdbx(rc, "Failed to seek key");
+            std::size_t count = 0;
+            check_mdbx(mdbx_cursor_count(cursor.get(), &count), "Failed to count duplicate values");
+            values.reserve(values.size() + count);
+
+            rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_GET_MULTIPLE);
+            while (rc == MDBX_SUCCESS) {
+                if (db_val.iov_len % record_size != 0) {
+                    throw std::runtime_error("DUPFIXED multi-value record size mismatch");
+                }
+                const uint8_t* page = static_cast<const uint8_t*>(db_val.iov_base);
+                const std::size_t n = db_val.iov_len / record_size;
+                const std::size_t base = values.size();
+                values.resize(base + n);
+                for (std::size_t i = 0; i < n; ++i) {
+                    std::memcpy(&values[base + i], page + i * record_size + sequence_size, sizeof(ValueT));
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT_MULTIPLE);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read duplicate values");
+            }
+        }
+
+        void db_find(const KeyT& key, std::vector<ValueT>& values, MDBX_txn* txn, std::false_type) const {
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -1870,6 +2225,77 @@ namespace mdbxc {
             }
         }
 
+        template<typename CallbackT, typename LayoutT>
+        bool db_for_each_value(const KeyT& key, CallbackT& callback, MDBX_txn* txn, LayoutT layout) const {
+            auto visit = [&callback](const MDBX_val& stored) -> bool {
+                const ValueT value = deserialize_value<ValueT>(stored);
+                return callback(value);
+            };
+            return db_for_each_raw_value(key, visit, txn, layout);
+        }
+
+        /// \brief Passes the stored bytes of every value of \p key, without the
+        ///        sequence prefix, to \p visit; DUPFIXED pages are read whole.
+        template<typename VisitT>
+        bool db_for_each_raw_value(const KeyT& key, VisitT& visit, MDBX_txn* txn, std::true_type) const {
+            static const std::size_t record_size = sequence_size + sizeof(ValueT);
+            CachedCursor cursor(*this, txn);
+
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+            if (rc == MDBX_NOTFOUND) {
+                return true;
+            }
+            check_mdbx(rc, "Failed to seek key");
+
+            rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_GET_MULTIPLE);
+            while (rc == MDBX_SUCCESS) {
+                if (db_val.iov_len % record_size != 0) {
+                    throw std::runtime_error("DUPFIXED multi-value record size mismatch");
+                }
+                const uint8_t* page = static_cast<const uint8_t*>(db_val.iov_base);
+                const std::size_t n = db_val.iov_len / record_size;
+                for (std::size_t i = 0; i < n; ++i) {
+                    const MDBX_val stored = SerializeScratch::view(page + i * record_size + sequence_size,
+                                                                   sizeof(ValueT));
+                    if (!visit(stored)) {
+                        return false;
+                    }
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT_MULTIPLE);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read duplicate values");
+            }
+            return true;
+        }
+
+        template<typename VisitT>
+        bool db_for_each_raw_value(const KeyT& key, VisitT& visit, MDBX_txn* txn, std::false_type) const {
+            CachedCursor cursor(*this, txn);
+
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+            if (rc == MDBX_NOTFOUND) {
+                return true;
+            }
+            check_mdbx(rc, "Failed to seek key");
+            while (rc == MDBX_SUCCESS) {
+                if (!visit(strip_sequence(db_val))) {
+                    return false;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT_DUP);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read duplicate values");
+            }
+            return true;
+        }
+
         bool db_contains_key(const KeyT& key, MDBX_txn* txn) const {
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -1892,8 +2318,7 @@ namespace mdbxc {
         }
 
         std::size_t db_count_key(const KeyT& key, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -1908,9 +2333,49 @@ namespace mdbxc {
             return found;
         }
 
+        std::vector<std::size_t> db_count_many(const std::vector<KeyT>& keys, MDBX_txn* txn) const {
+            std::vector<std::size_t> counts(keys.size(), 0);
+            if (keys.empty()) return counts;
+            CachedCursor cursor(*this, txn);
+            SerializeScratch sc_key;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                MDBX_val db_key = serialize_key<Options::safe_integer_key>(keys[i], sc_key);
+                MDBX_val db_val;
+                int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+                if (rc == MDBX_NOTFOUND) continue;
+                check_mdbx(rc, "Failed to seek key");
+                check_mdbx(mdbx_cursor_count(cursor.get(), &counts[i]), "Failed to count duplicate values");
+            }
+            return counts;
+        }
+
+        std::vector<std::pair<KeyT, std::size_t>> db_key_cardinalities(const KeyT& from_key, const KeyT& to_key,
+                                                                       MDBX_txn* txn) const {
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+
+            std::vector<std::pair<KeyT, std::size_t>> result;
+            CachedCursor cursor(*this, txn);
+            if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return result;
+
+            MDBX_val db_key = db_from_key;
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                if (mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) > 0) return result;
+                std::size_t found = 0;
+                check_mdbx(mdbx_cursor_count(cursor.get(), &found), "Failed to count duplicate values");
+                result.emplace_back(deserialize_key<KeyT>(db_key), found);
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT_NODUP);
+            }
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to scan key cardinalities");
+            return result;
+        }
+
         std::size_t db_count_pair(const KeyT& key, const ValueT& value, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             SerializeScratch sc_value;
@@ -1939,15 +2404,19 @@ namespace mdbxc {
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
             int rc = mdbx_del(txn, m_dbi, &db_key, nullptr);
-            if (rc == MDBX_SUCCESS) return true;
+            if (rc == MDBX_SUCCESS) {
+#               if MDBXC_SYNC_ENABLED
+                record_op(txn, sync::ChangeOpType::Delete, db_key, MDBX_val());
+#               endif
+                return true;
+            }
             if (rc == MDBX_NOTFOUND) return false;
             check_mdbx(rc, "Failed to erase key");
             return false;
         }
 
         std::size_t db_erase_pair(const KeyT& key, const ValueT& value, MDBX_txn* txn) {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             SerializeScratch sc_value;
@@ -1971,11 +2440,21 @@ namespace mdbxc {
             if (rc != MDBX_NOTFOUND) {
                 check_mdbx(rc, "Failed to scan duplicate values");
             }
+#           if MDBXC_SYNC_ENABLED
+            if (removed != 0) {
+                SerializeScratch sc_record_key;
+                record_op(txn, sync::ChangeOpType::MultiEraseAll,
+                          serialize_key<Options::safe_integer_key>(key, sc_record_key), raw_value);
+            }
+#           endif
             return removed;
         }
 
         void db_clear(MDBX_txn* txn) {
             check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear table");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
+#           endif
         }
     };
 
@@ -47,6 +47,8 @@ namespace mdbxc {
     class KeyOrderedMultiValueTable final : public BaseTable {
     public:
         typedef std::pair<KeyT, ValueT> value_type;
+        /// \brief Value paired with its internal order number, used as a page token.
+        typedef std::pair<std::uint64_t, ValueT> ordered_entry;
 
         /// \brief Constructs table using existing connection.
         /// \param connection Existing connection.
@@ -146,6 +148,26 @@ namespace mdbxc {
             return range_vector(from_key, to_key, txn.handle());
         }
 
+        /// \brief Calls a callback for every pair in an inclusive key range.
+        /// \param callback Invoked as \c callback(const KeyT&, const ValueT&). Return \c true to continue.
+        /// \return \c true if every pair was visited, \c false if the callback stopped early.
+        template<typename CallbackT>
+        bool for_each_range(const KeyT& from_key, const KeyT& to_key,
+                            CallbackT callback, MDBX_txn* txn = nullptr) const {
+            bool completed = false;
+            with_transaction([this, &from_key, &to_key, &callback, &completed](MDBX_txn* t) {
+                completed = db_for_each_range(from_key, to_key, callback, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Calls a callback for every pair in an inclusive key range.
+        template<typename CallbackT>
+        bool for_each_range(const KeyT& from_key, const KeyT& to_key,
+                            CallbackT callback, const Transaction& txn) const {
+            return for_each_range(from_key, to_key, callback, txn.handle());
+        }
+
         /// \brief Appends one value under a key.
         /// \param key Key to append to.
         /// \param value Value to append.
@@ -174,6 +196,44 @@ namespace mdbxc {
             append(key, value, txn.handle());
         }
 
+        /// \brief Appends several values under one key in iteration order.
+        /// \tparam InputIt Input iterator over \c ValueT.
+        /// \param key Key to append to.
+        /// \param first Start of the value range.
+        /// \param last End of the value range.
+        /// \param txn Optional transaction handle.
+        /// \details The last order number of \p key is read once and every value
+        /// is written with \c MDBX_APPENDDUP through the same cursor.
+        template<typename InputIt>
+        void append_many(const KeyT& key, InputIt first, InputIt last, MDBX_txn* txn = nullptr) {
+            with_transaction([this, &key, &first, &last](MDBX_txn* t) {
+                db_append_many(key, first, last, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Appends several values under one key in iteration order.
+        /// \tparam InputIt Input iterator over \c ValueT.
+        /// \param key Key to append to.
+        /// \param first Start of the value range.
+        /// \param last End of the value range.
+        /// \param txn Active transaction wrapper.
+        template<typename InputIt>
+        void append_many(const KeyT& key, InputIt first, InputIt last, const Transaction& txn) {
+            append_many(key, first, last, txn.handle());
+        }
+
+        /// \brief Alias for \ref append_many().
+        template<typename InputIt>
+        void insert_many(const KeyT& key, InputIt first, InputIt last, MDBX_txn* txn = nullptr) {
+            append_many(key, first, last, txn);
+        }
+
+        /// \brief Alias for \ref append_many().
+        template<typename InputIt>
+        void insert_many(const KeyT& key, InputIt first, InputIt last, const Transaction& txn) {
+            append_many(key, first, last, txn.handle());
+        }
+
         /// \brief Appends pairs from a vector in vector iteration order.
         /// \param container Source pairs.
         /// \param txn Optional transaction handle.
@@ -227,6 +287,130 @@ namespace mdbxc {
             return find(key, txn.handle());
         }
 
+        /// \brief Calls a callback for every value of a key in append order.
+        /// \details Walks the duplicates with \c MDBX_NEXT_DUP and deserializes each
+        /// value only when it is visited, so no result vector is built.
+        /// \param callback Invoked as \c callback(const ValueT&). Return \c true to continue.
+        /// \return \c true if every value was visited, \c false if the callback stopped early.
+        template<typename CallbackT>
+        bool for_each_value(const KeyT& key, CallbackT callback, MDBX_txn* txn = nullptr) const {
+            bool completed = false;
+            with_transaction([this, &key, &callback, &completed](MDBX_txn* t) {
+                completed = db_for_each_value(key, callback, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Calls a callback for every value of a key in append order.
+        template<typename CallbackT>
+        bool for_each_value(const KeyT& key, CallbackT callback, const Transaction& txn) const {
+            return for_each_value(key, callback, txn.handle());
+        }
+
+        /// \brief Reads a bounded page of values for a key.
+        /// \param key Key to read.
+        /// \param offset Number of values to skip from the start, or from the end
+        ///        when \p reverse is \c true.
+        /// \param limit Maximum number of values to return.
+        /// \param reverse Walk from the newest value towards the oldest.
+        /// \param txn Optional transaction handle.
+        /// \return Up to \p limit values in append order, or in reverse order.
+        /// \details Streams the page from the duplicate cursor; skipping \p offset
+        /// values costs one cursor step each.
+        std::vector<ValueT> find_window(const KeyT& key, std::size_t offset, std::size_t limit,
+                                        bool reverse = false, MDBX_txn* txn = nullptr) const {
+            std::vector<ValueT> values;
+            with_transaction([this, &key, offset, limit, reverse, &values](MDBX_txn* t) {
+                db_find_window(key, false, offset, limit, reverse, t, [&values](const MDBX_val& stored) {
+                    values.push_back(deserialize_value<ValueT>(strip_order(stored)));
+                });
+            }, TransactionMode::READ_ONLY, txn);
+            return values;
+        }
+
+        /// \brief Reads a bounded page of values for a key.
+        /// \param key Key to read.
+        /// \param offset Number of values to skip from the selected end.
+        /// \param limit Maximum number of values to return.
+        /// \param reverse Walk from the newest value towards the oldest.
+        /// \param txn Active transaction wrapper.
+        /// \return Up to \p limit values.
+        std::vector<ValueT> find_window(const KeyT& key, std::size_t offset, std::size_t limit,
+                                        bool reverse, const Transaction& txn) const {
+            return find_window(key, offset, limit, reverse, txn.handle());
+        }
+
+        /// \brief Reads a bounded page of values with their order numbers.
+        /// \param key Key to read.
+        /// \param offset Number of values to skip from the selected end.
+        /// \param limit Maximum number of entries to return.
+        /// \param reverse Walk from the newest value towards the oldest.
+        /// \param txn Optional transaction handle.
+        /// \return Up to \p limit entries. Pass the order of the last entry to
+        ///         \c find_window_after() to fetch the next page.
+        std::vector<ordered_entry> find_window_entries(const KeyT& key, std::size_t offset,
+                                                       std::size_t limit, bool reverse = false,
+                                                       MDBX_txn* txn = nullptr) const {
+            std::vector<ordered_entry> entries;
+            with_transaction([this, &key, offset, limit, reverse, &entries](MDBX_txn* t) {
+                db_find_window(key, false, offset, limit, reverse, t, [&entries](const MDBX_val& stored) {
+                    entries.push_back(ordered_entry(decode_order(stored),
+                                                    deserialize_value<ValueT>(strip_order(stored))));
+                });
+            }, TransactionMode::READ_ONLY, txn);
+            return entries;
+        }
+
+        /// \brief Reads a bounded page of values with their order numbers.
+        /// \param key Key to read.
+        /// \param offset Number of values to skip from the selected end.
+        /// \param limit Maximum number of entries to return.
+        /// \param reverse Walk from the newest value towards the oldest.
+        /// \param txn Active transaction wrapper.
+        /// \return Up to \p limit entries.
+        std::vector<ordered_entry> find_window_entries(const KeyT& key, std::size_t offset,
+                                                       std::size_t limit, bool reverse,
+                                                       const Transaction& txn) const {
+            return find_window_entries(key, offset, limit, reverse, txn.handle());
+        }
+
+        /// \brief Reads the page that follows an order number.
+        /// \param key Key to read.
+        /// \param after_order Order of the last entry of the previous page.
+        /// \param limit Maximum number of entries to return.
+        /// \param reverse Return entries with lower orders, newest first.
+        /// \param txn Optional transaction handle.
+        /// \return Up to \p limit entries with orders above \p after_order, or
+        ///         below it when \p reverse is \c true.
+        /// \details Seeks with \c MDBX_GET_BOTH_RANGE, so a page costs one
+        /// duplicate-tree descent regardless of its depth in the key. Order
+        /// numbers stay attached to their values until those values are erased.
+        std::vector<ordered_entry> find_window_after(const KeyT& key, std::uint64_t after_order,
+                                                     std::size_t limit, bool reverse = false,
+                                                     MDBX_txn* txn = nullptr) const {
+            std::vector<ordered_entry> entries;
+            with_transaction([this, &key, after_order, limit, reverse, &entries](MDBX_txn* t) {
+                db_find_window(key, true, after_order, limit, reverse, t, [&entries](const MDBX_val& stored) {
+                    entries.push_back(ordered_entry(decode_order(stored),
+                                                    deserialize_value<ValueT>(strip_order(stored))));
+                });
+            }, TransactionMode::READ_ONLY, txn);
+            return entries;
+        }
+
+        /// \brief Reads the page that follows an order number.
+        /// \param key Key to read.
+        /// \param after_order Order of the last entry of the previous page.
+        /// \param limit Maximum number of entries to return.
+        /// \param reverse Return entries with lower orders, newest first.
+        /// \param txn Active transaction wrapper.
+        /// \return Up to \p limit entries.
+        std::vector<ordered_entry> find_window_after(const KeyT& key, std::uint64_t after_order,
+                                                     std::size_t limit, bool reverse,
+                                                     const Transaction& txn) const {
+            return find_window_after(key, after_order, limit, reverse, txn.handle());
+        }
+
         /// \brief Checks whether a key exists.
         bool contains(const KeyT& key, MDBX_txn* txn = nullptr) const {
             bool result = false;
@@ -293,6 +477,72 @@ namespace mdbxc {
             return count(key, value, txn.handle());
         }
 
+        /// \brief Counts values stored for each key without reading the values.
+        /// \return Value counts in the order of \p keys; zero for missing keys.
+        std::vector<std::size_t> count_many(const std::vector<KeyT>& keys, MDBX_txn* txn = nullptr) const {
+            std::vector<std::size_t> result;
+            with_transaction([this, &keys, &result](MDBX_txn* t) {
+                result = db_count_many(keys, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Counts values stored for each key without reading the values.
+        std::vector<std::size_t> count_many(const std::vector<KeyT>& keys, const Transaction& txn) const {
+            return count_many(keys, txn.handle());
+        }
+
+        /// \brief Lists each distinct key of an inclusive range with its value count.
+        /// \details Steps key by key with \c MDBX_NEXT_NODUP and never deserializes values.
+        std::vector<std::pair<KeyT, std::size_t>> key_cardinalities(const KeyT& from_key, const KeyT& to_key,
+                                                                    MDBX_txn* txn = nullptr) const {
+            std::vector<std::pair<KeyT, std::size_t>> result;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = db_key_cardinalities(from_key, to_key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Lists each distinct key of an inclusive range with its value count.
+        std::vector<std::pair<KeyT, std::size_t>> key_cardinalities(const KeyT& from_key, const KeyT& to_key,
+                                                                    const Transaction& txn) const {
+            return key_cardinalities(from_key, to_key, txn.handle());
+        }
+
+        /// \brief Estimates the number of pairs within an inclusive key range.
+        /// \details O(log n) via \c mdbx_estimate_range(); the result is approximate.
+        std::size_t estimate_count_range(const KeyT& from_key, const KeyT& to_key,
+                                         MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = db_estimate_count_range(from_key, to_key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Estimates the number of pairs within an inclusive key range.
+        std::size_t estimate_count_range(const KeyT& from_key, const KeyT& to_key,
+                                         const Transaction& txn) const {
+            return estimate_count_range(from_key, to_key, txn.handle());
+        }
+
+        /// \brief Estimates the storage size in bytes of pairs within an inclusive key range.
+        /// \details Scales \ref estimate_count_range() by the average page footprint per entry.
+        std::uint64_t estimate_bytes_range(const KeyT& from_key, const KeyT& to_key,
+                                           MDBX_txn* txn = nullptr) const {
+            std::uint64_t result = 0;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = estimate_range_bytes(t, db_estimate_count_range(from_key, to_key, t));
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Estimates the storage size in bytes of pairs within an inclusive key range.
+        std::uint64_t estimate_bytes_range(const KeyT& from_key, const KeyT& to_key,
+                                           const Transaction& txn) const {
+            return estimate_bytes_range(from_key, to_key, txn.handle());
+        }
+
         /// \brief Checks whether the table has no pairs.
         bool empty(MDBX_txn* txn = nullptr) const {
             return count(txn) == 0;
@@ -308,6 +558,7 @@ namespace mdbxc {
         bool erase(const KeyT& key, MDBX_txn* txn = nullptr) {
             bool result = false;
             with_transaction([this, &key, &result](MDBX_txn* t) {
+                freeze_order_cache(t);
                 result = db_erase_key(key, t);
             }, TransactionMode::WRITABLE, txn);
             return result;
@@ -324,6 +575,7 @@ namespace mdbxc {
         std::size_t erase(const KeyT& key, const ValueT& value, MDBX_txn* txn = nullptr) {
             std::size_t removed = 0;
             with_transaction([this, &key, &value, &removed](MDBX_txn* t) {
+                freeze_order_cache(t);
                 removed = db_erase_pair(key, value, t);
             }, TransactionMode::WRITABLE, txn);
             return removed;
@@ -343,6 +595,7 @@ namespace mdbxc {
         bool erase_at(const KeyT& key, std::size_t index, MDBX_txn* txn = nullptr) {
             bool removed = false;
             with_transaction([this, &key, &index, &removed](MDBX_txn* t) {
+                freeze_order_cache(t);
                 removed = db_erase_at(key, index, t);
             }, TransactionMode::WRITABLE, txn);
             return removed;
@@ -365,7 +618,41 @@ namespace mdbxc {
             clear(txn.handle());
         }
 
+        /// \brief Sets the capacity of the in-memory next-order cache.
+        /// \param max_keys Maximum number of cached keys; \c 0 disables the cache.
+        /// \details When enabled, \c append() and \c append_many() take the next
+        /// order number of a key from memory instead of seeking its last
+        /// duplicate. At the first write of each transaction the cache is checked
+        /// against the DBI modification txnid and dropped if another transaction
+        /// changed the table. Any write transaction or savepoint aborted through
+        /// the connection drops it too, because MDBX reuses the aborted txnid
+        /// (see Connection::abort_sequence()). Cached numbers may run ahead of
+        /// the stored values after deletes; that leaves gaps but keeps append order.
+        /// \note Writes to the same DBI through another wrapper inside the same
+        ///       write transaction are not detected. Disabled by default.
+        void set_order_cache_size(std::size_t max_keys) {
+            m_order_cache_size = max_keys;
+            m_order_cache.clear();
+            m_order_cache_txn = nullptr;
+            m_order_cache_txnid = 0;
+            m_order_cache_mod_txnid = 0;
+            m_order_cache_abort_seq = 0;
+        }
+
+        /// \brief Returns the next-order cache capacity; \c 0 when disabled.
+        std::size_t order_cache_size() const noexcept {
+            return m_order_cache_size;
+        }
+
     private:
+        mutable std::unordered_map<std::string, std::uint64_t> m_order_cache; ///< Next order number by serialized key.
+        std::size_t                    m_order_cache_size = 0;        ///< Cache capacity in keys; 0 disables it.
+        mutable const MDBX_txn*        m_order_cache_txn = nullptr;   ///< Write transaction that last validated the cache.
+        mutable std::uint64_t          m_order_cache_txnid = 0;       ///< Txnid of \c m_order_cache_txn.
+        mutable std::uint64_t          m_order_cache_mod_txnid = 0;   ///< DBI modification txnid the cache reflects.
+        mutable std::uint64_t          m_order_cache_abort_seq = 0;   ///< Connection::abort_sequence() at validation.
+        mutable bool                   m_order_cache_frozen = false;  ///< New entries are not cached after a delete in this txn.
+
         static const std::size_t order_size = sizeof(std::uint64_t);
 
         static MDBX_db_flags_t make_open_flags(MDBX_db_flags_t flags) {
@@ -503,6 +790,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
 
             auto txn_guard = m_connection->transaction(mode);
             try {
@@ -576,12 +864,94 @@ namespace mdbxc {
             return std::memcmp(stored_raw.iov_base, raw_value.iov_base, stored_raw.iov_len) == 0;
         }
 
-        std::uint64_t next_order(const KeyT& key, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+        std::size_t db_estimate_count_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+            return estimate_range_items(txn, db_from_key, db_to_key);
+        }
+
+        /// \brief Drops the order cache if the table changed since it was filled.
+        /// \details Runs once per write transaction. The cache stays valid only if
+        /// the DBI was last modified by an earlier transaction that used it.
+        void validate_order_cache(MDBX_txn* txn) const {
+            const std::uint64_t txnid = mdbx_txn_id(txn);
+            const std::uint64_t abort_seq = m_connection->abort_sequence();
+            if (txn == m_order_cache_txn && txnid == m_order_cache_txnid &&
+                abort_seq == m_order_cache_abort_seq) {
+                return;
+            }
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat)),
+                       "Failed to query ordered multi-value table statistics");
+            if (stat.ms_mod_txnid != m_order_cache_mod_txnid || m_order_cache_mod_txnid >= txnid ||
+                abort_seq != m_order_cache_abort_seq) {
+                m_order_cache.clear();
+            }
+            m_order_cache_txn = txn;
+            m_order_cache_txnid = txnid;
+            m_order_cache_mod_txnid = txnid;
+            m_order_cache_abort_seq = abort_seq;
+            m_order_cache_frozen = false;
+        }
+
+        /// \brief Stops caching newly read order numbers for the current transaction.
+        /// \details After a delete, a number read from the table may be lower than
+        /// the one a rollback would restore, so only existing entries stay usable.
+        void freeze_order_cache(MDBX_txn* txn) const {
+            if (m_order_cache_size == 0) {
+                return;
+            }
+            validate_order_cache(txn);
+            m_order_cache_frozen = true;
+        }
+
+        std::uint64_t next_order(const MDBX_val& db_key, MDBX_txn* txn) const {
+            if (m_order_cache_size == 0) {
+                return read_next_order(db_key, txn);
+            }
+            validate_order_cache(txn);
+            const std::string cache_key(static_cast<const char*>(db_key.iov_base), db_key.iov_len);
+            typename std::unordered_map<std::string, std::uint64_t>::const_iterator it =
+                m_order_cache.find(cache_key);
+            if (it != m_order_cache.end()) {
+                return it->second;
+            }
+            return read_next_order(db_key, txn);
+        }
+
+        /// \brief Records the next free order number of a key after a write.
+        /// \param last_order Order number of the last value just written.
+        void store_next_order(const MDBX_val& db_key, std::uint64_t last_order) const {
+            if (m_order_cache_size == 0) {
+                return;
+            }
+            const std::string cache_key(static_cast<const char*>(db_key.iov_base), db_key.iov_len);
+            typename std::unordered_map<std::string, std::uint64_t>::iterator it =
+                m_order_cache.find(cache_key);
+            if (last_order == std::numeric_limits<std::uint64_t>::max()) {
+                if (it != m_order_cache.end()) {
+                    m_order_cache.erase(it);
+                }
+                return;
+            }
+            if (it != m_order_cache.end()) {
+                it->second = last_order + 1;
+                return;
+            }
+            if (m_order_cache_frozen) {
+                return;
+            }
+            if (m_order_cache.size() >= m_order_cache_size) {
+                m_order_cache.clear();
+            }
+            m_order_cache.insert(std::make_pair(cache_key, last_order + 1));
+        }
+
+        std::uint64_t read_next_order(MDBX_val db_key, MDBX_txn* txn) const {
+            CachedCursor cursor(*this, txn);
 
-            SerializeScratch sc_key;
-            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
             MDBX_val db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
             if (rc == MDBX_NOTFOUND) {
@@ -598,8 +968,7 @@ namespace mdbxc {
         }
 
         void db_load(std::vector<value_type>& container, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             MDBX_val db_key, db_val;
             int rc = MDBX_SUCCESS;
@@ -615,15 +984,24 @@ namespace mdbxc {
 
         void db_range(const KeyT& from_key, const KeyT& to_key,
                       std::vector<value_type>& pairs, MDBX_txn* txn) const {
+            auto collect = [&pairs](const KeyT& key, const ValueT& value) -> bool {
+                pairs.push_back(value_type(key, value));
+                return true;
+            };
+            db_for_each_range(from_key, to_key, collect, txn);
+        }
+
+        template<typename CallbackT>
+        bool db_for_each_range(const KeyT& from_key, const KeyT& to_key,
+                               CallbackT& callback, MDBX_txn* txn) const {
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) {
-                return;
+                return true;
             }
 
             MDBX_val db_key = db_from_key;
@@ -635,25 +1013,54 @@ namespace mdbxc {
                     stopped_by_upper_bound = true;
                     break;
                 }
-                KeyT key = deserialize_key<KeyT>(db_key);
-                ValueT value = deserialize_value<ValueT>(strip_order(db_val));
-                pairs.push_back(value_type(std::move(key), std::move(value)));
+                const KeyT key = deserialize_key<KeyT>(db_key);
+                const ValueT value = deserialize_value<ValueT>(strip_order(db_val));
+                if (!callback(key, value)) {
+                    return false;
+                }
                 rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
             }
             if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
                 check_mdbx(rc, "Failed to read ordered multi-value key range");
             }
+            return true;
         }
 
         void db_append_one(const KeyT& key, const ValueT& value, MDBX_txn* txn) {
             SerializeScratch sc_key;
             SerializeScratch sc_value;
-            const std::uint64_t order = next_order(key, txn);
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            const std::uint64_t order = next_order(db_key, txn);
             MDBX_val db_val = make_stored_value(order, value, sc_value);
             check_dupsort_value_size(db_val);
             check_mdbx(mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT),
                        "Failed to append ordered multi-value record");
+            store_next_order(db_key, order);
+        }
+
+        template<typename InputIt>
+        void db_append_many(const KeyT& key, InputIt first, InputIt last, MDBX_txn* txn) {
+            if (first == last) {
+                return;
+            }
+            SerializeScratch sc_key;
+            SerializeScratch sc_value;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            std::uint64_t order = next_order(db_key, txn);
+            CachedCursor cursor(*this, txn);
+
+            bool exhausted = false;
+            for (; first != last; ++first, ++order) {
+                if (exhausted) {
+                    throw std::overflow_error("Per-key ordered multi-value sequence exhausted");
+                }
+                MDBX_val db_val = make_stored_value(order, *first, sc_value);
+                check_dupsort_value_size(db_val);
+                check_mdbx(mdbx_cursor_put(cursor.get(), &db_key, &db_val, MDBX_APPENDDUP),
+                           "Failed to append ordered multi-value record");
+                exhausted = order == std::numeric_limits<std::uint64_t>::max();
+            }
+            store_next_order(db_key, order - 1);
         }
 
         void db_append(const std::vector<value_type>& container, MDBX_txn* txn) {
@@ -664,8 +1071,7 @@ namespace mdbxc {
         }
 
         void db_find(const KeyT& key, std::vector<ValueT>& values, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -684,6 +1090,109 @@ namespace mdbxc {
             }
         }
 
+        template<typename CallbackT>
+        bool db_for_each_value(const KeyT& key, CallbackT& callback, MDBX_txn* txn) const {
+            CachedCursor cursor(*this, txn);
+
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+            if (rc == MDBX_NOTFOUND) {
+                return true;
+            }
+            check_mdbx(rc, "Failed to seek key");
+            while (rc == MDBX_SUCCESS) {
+                const ValueT value = deserialize_value<ValueT>(strip_order(db_val));
+                if (!callback(value)) {
+                    return false;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT_DUP);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read ordered duplicate values");
+            }
+            return true;
+        }
+
+        /// \brief Positions a duplicate cursor and emits up to \p limit values.
+        /// \param after_mode Treat \p start as an order number instead of an offset.
+        template<typename EmitT>
+        void db_find_window(const KeyT& key, bool after_mode, std::uint64_t start,
+                            std::size_t limit, bool reverse, MDBX_txn* txn, EmitT emit) const {
+            if (limit == 0) {
+                return;
+            }
+            CachedCursor cursor(*this, txn);
+
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+            if (rc == MDBX_NOTFOUND) {
+                return;
+            }
+            check_mdbx(rc, "Failed to seek key");
+
+            const MDBX_cursor_op step = reverse ? MDBX_PREV_DUP : MDBX_NEXT_DUP;
+            if (after_mode) {
+                rc = seek_after_order(cursor.get(), db_key, db_val, start, reverse);
+            } else {
+                std::size_t found = 0;
+                check_mdbx(mdbx_cursor_count(cursor.get(), &found), "Failed to count ordered duplicate values");
+                if (start >= found) {
+                    return;
+                }
+                if (reverse) {
+                    rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST_DUP);
+                }
+                for (std::uint64_t skipped = 0; skipped < start && rc == MDBX_SUCCESS; ++skipped) {
+                    rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, step);
+                }
+            }
+
+            std::size_t emitted = 0;
+            while (rc == MDBX_SUCCESS) {
+                emit(db_val);
+                if (++emitted == limit) {
+                    return;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, step);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read ordered duplicate window");
+            }
+        }
+
+        /// \brief Moves a cursor on \p db_key to the first value after \p after_order.
+        /// \return \c MDBX_SUCCESS when positioned, \c MDBX_NOTFOUND when no value follows.
+        int seek_after_order(MDBX_cursor* cursor, MDBX_val& db_key, MDBX_val& db_val,
+                             std::uint64_t after_order, bool reverse) const {
+            std::uint8_t bound[order_size];
+            if (!reverse) {
+                if (after_order == std::numeric_limits<std::uint64_t>::max()) {
+                    return MDBX_NOTFOUND;
+                }
+                encode_order(after_order + 1, bound);
+                db_val = SerializeScratch::view(bound, order_size);
+                return mdbx_cursor_get(cursor, &db_key, &db_val, MDBX_GET_BOTH_RANGE);
+            }
+            encode_order(after_order, bound);
+            db_val = SerializeScratch::view(bound, order_size);
+            int rc = mdbx_cursor_get(cursor, &db_key, &db_val, MDBX_GET_BOTH_RANGE);
+            if (rc == MDBX_SUCCESS) {
+                return mdbx_cursor_get(cursor, &db_key, &db_val, MDBX_PREV_DUP);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                return rc;
+            }
+            rc = mdbx_cursor_get(cursor, &db_key, &db_val, MDBX_SET_KEY);
+            if (rc != MDBX_SUCCESS) {
+                return rc;
+            }
+            return mdbx_cursor_get(cursor, &db_key, &db_val, MDBX_LAST_DUP);
+        }
+
         bool db_contains_key(const KeyT& key, MDBX_txn* txn) const {
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -703,8 +1212,7 @@ namespace mdbxc {
         }
 
         std::size_t db_count_key(const KeyT& key, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -719,9 +1227,49 @@ namespace mdbxc {
             return found;
         }
 
+        std::vector<std::size_t> db_count_many(const std::vector<KeyT>& keys, MDBX_txn* txn) const {
+            std::vector<std::size_t> counts(keys.size(), 0);
+            if (keys.empty()) return counts;
+            CachedCursor cursor(*this, txn);
+            SerializeScratch sc_key;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                MDBX_val db_key = serialize_key<Options::safe_integer_key>(keys[i], sc_key);
+                MDBX_val db_val;
+                int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+                if (rc == MDBX_NOTFOUND) continue;
+                check_mdbx(rc, "Failed to seek key");
+                check_mdbx(mdbx_cursor_count(cursor.get(), &counts[i]), "Failed to count ordered duplicate values");
+            }
+            return counts;
+        }
+
+        std::vector<std::pair<KeyT, std::size_t>> db_key_cardinalities(const KeyT& from_key, const KeyT& to_key,
+                                                                       MDBX_txn* txn) const {
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+
+            std::vector<std::pair<KeyT, std::size_t>> result;
+            CachedCursor cursor(*this, txn);
+            if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return result;
+
+            MDBX_val db_key = db_from_key;
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                if (mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) > 0) return result;
+                std::size_t found = 0;
+                check_mdbx(mdbx_cursor_count(cursor.get(), &found), "Failed to count ordered duplicate values");
+                result.emplace_back(deserialize_key<KeyT>(db_key), found);
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT_NODUP);
+            }
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to scan ordered key cardinalities");
+            return result;
+        }
+
         std::size_t db_count_pair(const KeyT& key, const ValueT& value, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             SerializeScratch sc_value;
@@ -757,8 +1305,7 @@ namespace mdbxc {
         }
 
         std::size_t db_erase_pair(const KeyT& key, const ValueT& value, MDBX_txn* txn) {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             SerializeScratch sc_value;
@@ -786,8 +1333,7 @@ namespace mdbxc {
         }
 
         bool db_erase_at(const KeyT& key, std::size_t index, MDBX_txn* txn) {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -814,6 +1360,8 @@ namespace mdbxc {
         }
 
         void db_clear(MDBX_txn* txn) {
+            freeze_order_cache(txn);
+            m_order_cache.clear();
             check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear ordered multi-value table");
         }
     };
@@ -0,0 +1,407 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_KEY_SET_OPS_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_KEY_SET_OPS_HPP_INCLUDED
+
+/// \file KeySetOps.hpp
+/// \brief Streaming intersection, union and difference of table key sets.
+/// \details
+/// Joins the keys of several \ref KeyTable and \ref KeyValueTable instances
+/// inside one transaction without loading them into memory. Intersection is
+/// a leapfrog join: each cursor jumps with \c MDBX_SET_RANGE to the largest
+/// key seen so far, so the work grows with the output and the number of
+/// jumps rather than with the table sizes. Difference walks the first table
+/// and seeks the others only to its keys. Union merges all cursors in key
+/// order.
+///
+/// All tables must belong to one \ref Connection and share the key type,
+/// the table options and therefore the key order. Keys are reported in MDBX
+/// key order.
+
+#include "KeyTable.hpp"
+#include "KeyValueTable.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \class KeySetRef
+    /// \ingroup mdbxc_tables
+    /// \brief Non-owning reference to the key set of a table.
+    /// \details Converts implicitly from \ref KeyTable and \ref KeyValueTable
+    /// with the same key type and options, so a braced list of tables can be
+    /// passed to \ref intersect(), \ref unite() and \ref difference(). The
+    /// table must outlive the reference.
+    /// \tparam KeyT Key type shared by the tables.
+    /// \tparam Options Table options shared by the tables.
+    template<class KeyT, class Options = DefaultTableOptions>
+    class KeySetRef {
+    public:
+        /// \brief References the keys of a key-only table.
+        KeySetRef(const KeyTable<KeyT, Options>& table) : m_table(&table) {}
+
+        /// \brief References the keys of a key-value table.
+        template<class ValueT>
+        KeySetRef(const KeyValueTable<KeyT, ValueT, Options>& table) : m_table(&table) {}
+
+    private:
+        friend class detail::KeySetJoin<KeyT, Options>;
+
+        const BaseTable* m_table;
+    };
+
+    namespace detail {
+
+        /// \brief Cursor loops behind the key set operations.
+        template<class KeyT, class Options>
+        class KeySetJoin {
+        public:
+            typedef std::vector<KeySetRef<KeyT, Options>> Sets;
+
+            /// \brief Runs \p action with \p txn, the thread-bound transaction,
+            /// or a new read-only transaction.
+            /// \throws std::invalid_argument if \p sets is empty, spans several
+            ///         connections or mixes key orders.
+            template<typename ActionT>
+            static void run(const Sets& sets, ActionT& action, MDBX_txn* txn) {
+                if (sets.empty()) {
+                    throw std::invalid_argument("Key set operation needs at least one table");
+                }
+                const BaseTable& first = *sets[0].m_table;
+                const std::uint32_t order_flags =
+                    static_cast<std::uint32_t>(MDBX_INTEGERKEY) |
+                    static_cast<std::uint32_t>(MDBX_REVERSEKEY);
+                for (std::size_t i = 1; i < sets.size(); ++i) {
+                    const BaseTable& table = *sets[i].m_table;
+                    if (table.m_connection.get() != first.m_connection.get()) {
+                        throw std::invalid_argument("Key set operation needs tables of one Connection");
+                    }
+                    if (((table.m_dbi_flags ^ first.m_dbi_flags) & order_flags) != 0) {
+                        throw std::invalid_argument("Key set operation needs tables with the same key order");
+                    }
+                }
+                if (txn) {
+                    action(first.checked_external_txn(txn));
+                    return;
+                }
+                txn = first.thread_txn();
+                if (txn) {
+                    action(txn);
+                    return;
+                }
+                auto txn_guard = first.m_connection->transaction(TransactionMode::READ_ONLY);
+                try {
+                    action(txn_guard.handle());
+                    txn_guard.commit();
+                } catch (...) {
+                    try { txn_guard.rollback(); } catch (...) {}
+                    throw;
+                }
+            }
+
+            template<typename CallbackT>
+            static bool intersect(const Sets& sets, CallbackT& callback, MDBX_txn* txn) {
+                std::vector<Cursor> cursors;
+                open(sets, txn, cursors);
+                const std::size_t k = cursors.size();
+                for (std::size_t i = 0; i < k; ++i) {
+                    if (!cursors[i].move(MDBX_FIRST)) return true;
+                }
+                // Leapfrog invariant: in cyclic order starting at p, cursors
+                // hold ascending keys, so the one before p holds the largest.
+                std::vector<std::size_t> order(k);
+                for (std::size_t i = 0; i < k; ++i) order[i] = i;
+                const KeyLess less(txn, cursors[0].dbi, cursors);
+                std::sort(order.begin(), order.end(), less);
+
+                std::vector<std::uint8_t> max_bytes;
+                MDBX_val max_key = copy_key(cursors[order[k - 1]].key, max_bytes);
+                const MDBX_dbi dbi = cursors[0].dbi;
+                for (std::size_t p = 0;; p = (p + 1) % k) {
+                    Cursor& cursor = cursors[order[p]];
+                    if (mdbx_cmp(txn, dbi, &cursor.key, &max_key) == 0) {
+                        // The smallest key equals the largest: every cursor agrees.
+                        if (!callback(deserialize_key<KeyT>(cursor.key))) return false;
+                        if (!cursor.move(MDBX_NEXT)) return true;
+                    } else if (!cursor.seek(max_key)) {
+                        return true;
+                    }
+                    max_key = copy_key(cursor.key, max_bytes);
+                }
+            }
+
+            template<typename CallbackT>
+            static bool unite(const Sets& sets, CallbackT& callback, MDBX_txn* txn) {
+                std::vector<Cursor> cursors;
+                open(sets, txn, cursors);
+                const std::size_t k = cursors.size();
+                const MDBX_dbi dbi = cursors[0].dbi;
+                std::vector<char> live(k, 0);
+                for (std::size_t i = 0; i < k; ++i) {
+                    live[i] = cursors[i].move(MDBX_FIRST) ? 1 : 0;
+                }
+                for (;;) {
+                    std::size_t min = k;
+                    for (std::size_t i = 0; i < k; ++i) {
+                        if (live[i] && (min == k ||
+                                        mdbx_cmp(txn, dbi, &cursors[i].key, &cursors[min].key) < 0)) {
+                            min = i;
+                        }
+                    }
+                    if (min == k) return true;
+                    if (!callback(deserialize_key<KeyT>(cursors[min].key))) return false;
+                    // Advance the duplicates first; they compare against the
+                    // key still held by cursors[min].
+                    for (std::size_t i = 0; i < k; ++i) {
+                        if (i != min && live[i] &&
+                            mdbx_cmp(txn, dbi, &cursors[i].key, &cursors[min].key) == 0) {
+                            live[i] = cursors[i].move(MDBX_NEXT) ? 1 : 0;
+                        }
+                    }
+                    live[min] = cursors[min].move(MDBX_NEXT) ? 1 : 0;
+                }
+            }
+
+            template<typename CallbackT>
+            static bool difference(const Sets& sets, CallbackT& callback, MDBX_txn* txn) {
+                std::vector<Cursor> cursors;
+                open(sets, txn, cursors);
+                const std::size_t k = cursors.size();
+                const MDBX_dbi dbi = cursors[0].dbi;
+                Cursor& base = cursors[0];
+                // 0: not positioned yet, 1: at a key, 2: past the last key.
+                std::vector<char> state(k, 0);
+                for (bool more = base.move(MDBX_FIRST); more; more = base.move(MDBX_NEXT)) {
+                    bool excluded = false;
+                    for (std::size_t i = 1; i < k && !excluded; ++i) {
+                        if (state[i] == 2) continue;
+                        if (state[i] == 0 || mdbx_cmp(txn, dbi, &cursors[i].key, &base.key) < 0) {
+                            state[i] = cursors[i].seek(base.key) ? 1 : 2;
+                            if (state[i] == 2) continue;
+                        }
+                        excluded = mdbx_cmp(txn, dbi, &cursors[i].key, &base.key) == 0;
+                    }
+                    if (!excluded && !callback(deserialize_key<KeyT>(base.key))) return false;
+                }
+                return true;
+            }
+
+        private:
+            /// \brief Table cursor and the key it is positioned at.
+            struct Cursor {
+                std::unique_ptr<BaseTable::CachedCursor> cursor;
+                MDBX_dbi dbi;
+                MDBX_val key;
+
+                /// \return \c false when the cursor ran past the last key.
+                bool move(MDBX_cursor_op op) {
+                    MDBX_val value;
+                    const int rc = mdbx_cursor_get(cursor->get(), &key, &value, op);
+                    if (rc == MDBX_NOTFOUND) return false;
+                    check_mdbx(rc, "Failed to walk key set");
+                    return true;
+                }
+
+                /// \brief Positions at the first key not below \p target.
+                bool seek(const MDBX_val& target) {
+                    key = target;
+                    return move(MDBX_SET_RANGE);
+                }
+            };
+
+            /// \brief Orders cursor indices by their current keys.
+            struct KeyLess {
+                KeyLess(MDBX_txn* txn_handle, MDBX_dbi dbi_handle, const std::vector<Cursor>& all)
+                    : txn(txn_handle), dbi(dbi_handle), cursors(&all) {}
+
+                bool operator()(std::size_t a, std::size_t b) const {
+                    return mdbx_cmp(txn, dbi, &(*cursors)[a].key, &(*cursors)[b].key) < 0;
+                }
+
+                MDBX_txn* txn;
+                MDBX_dbi dbi;
+                const std::vector<Cursor>* cursors;
+            };
+
+            static void open(const Sets& sets, MDBX_txn* txn, std::vector<Cursor>& cursors) {
+                cursors.resize(sets.size());
+                for (std::size_t i = 0; i < sets.size(); ++i) {
+                    const BaseTable& table = *sets[i].m_table;
+                    cursors[i].cursor.reset(new BaseTable::CachedCursor(table, txn));
+                    cursors[i].dbi = table.m_dbi;
+                    cursors[i].key.iov_base = nullptr;
+                    cursors[i].key.iov_len = 0;
+                }
+            }
+
+            /// \brief Copies \p key so it survives cursor moves.
+            static MDBX_val copy_key(const MDBX_val& key, std::vector<std::uint8_t>& bytes) {
+                const std::uint8_t* begin = static_cast<const std::uint8_t*>(key.iov_base);
+                bytes.assign(begin, begin + key.iov_len);
+                MDBX_val out;
+                out.iov_base = bytes.empty() ? nullptr : &bytes[0];
+                out.iov_len = bytes.size();
+                return out;
+            }
+        };
+
+    } // namespace detail
+
+    // --- Streaming operations ---
+
+    /// \brief Visits the keys present in every table of \p sets.
+    /// \details Leapfrog join over \c MDBX_SET_RANGE seeks; a table with no
+    /// keys in a stretch of the others skips that stretch in one seek.
+    /// \param sets Tables to intersect; at least one.
+    /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+    /// The callback must not write to the joined tables in the same transaction.
+    /// \param txn Optional transaction handle.
+    /// \return \c true if every key was visited, \c false if the callback stopped early.
+    /// \throws std::invalid_argument if \p sets is empty, spans several
+    ///         connections or mixes key orders.
+    /// \throws MdbxException if a database error occurs.
+    template<class KeyT, class Options = DefaultTableOptions, typename CallbackT>
+    bool for_each_intersection(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                               CallbackT callback, MDBX_txn* txn = nullptr) {
+        bool completed = false;
+        auto action = [&sets, &callback, &completed](MDBX_txn* t) {
+            completed = detail::KeySetJoin<KeyT, Options>::intersect(sets, callback, t);
+        };
+        detail::KeySetJoin<KeyT, Options>::run(sets, action, txn);
+        return completed;
+    }
+
+    /// \brief Visits the keys present in every table of \p sets.
+    /// \param txn Active transaction wrapper.
+    template<class KeyT, class Options = DefaultTableOptions, typename CallbackT>
+    bool for_each_intersection(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                               CallbackT callback, const Transaction& txn) {
+        return for_each_intersection<KeyT, Options>(sets, callback, txn.handle());
+    }
+
+    /// \brief Visits the keys present in at least one table of \p sets, once each.
+    /// \param sets Tables to unite; at least one.
+    /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+    /// The callback must not write to the joined tables in the same transaction.
+    /// \param txn Optional transaction handle.
+    /// \return \c true if every key was visited, \c false if the callback stopped early.
+    /// \throws std::invalid_argument if \p sets is empty, spans several
+    ///         connections or mixes key orders.
+    /// \throws MdbxException if a database error occurs.
+    template<class KeyT, class Options = DefaultTableOptions, typename CallbackT>
+    bool for_each_union(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                        CallbackT callback, MDBX_txn* txn = nullptr) {
+        bool completed = false;
+        auto action = [&sets, &callback, &completed](MDBX_txn* t) {
+            completed = detail::KeySetJoin<KeyT, Options>::unite(sets, callback, t);
+        };
+        detail::KeySetJoin<KeyT, Options>::run(sets, action, txn);
+        return completed;
+    }
+
+    /// \brief Visits the keys present in at least one table of \p sets, once each.
+    /// \param txn Active transaction wrapper.
+    template<class KeyT, class Options = DefaultTableOptions, typename CallbackT>
+    bool for_each_union(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                        CallbackT callback, const Transaction& txn) {
+        return for_each_union<KeyT, Options>(sets, callback, txn.handle());
+    }
+
+    /// \brief Visits the keys of the first table of \p sets that no other table holds.
+    /// \details Walks the first table and seeks each other table only when
+    /// its cursor falls behind, so large subtracted tables are not scanned.
+    /// \param sets First table, then the tables to subtract.
+    /// \param callback Invoked as \c callback(const KeyT&). Return \c true to continue.
+    /// The callback must not write to the joined tables in the same transaction.
+    /// \param txn Optional transaction handle.
+    /// \return \c true if every key was visited, \c false if the callback stopped early.
+    /// \throws std::invalid_argument if \p sets is empty, spans several
+    ///         connections or mixes key orders.
+    /// \throws MdbxException if a database error occurs.
+    template<class KeyT, class Options = DefaultTableOptions, typename CallbackT>
+    bool for_each_difference(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                             CallbackT callback, MDBX_txn* txn = nullptr) {
+        bool completed = false;
+        auto action = [&sets, &callback, &completed](MDBX_txn* t) {
+            completed = detail::KeySetJoin<KeyT, Options>::difference(sets, callback, t);
+        };
+        detail::KeySetJoin<KeyT, Options>::run(sets, action, txn);
+        return completed;
+    }
+
+    /// \brief Visits the keys of the first table of \p sets that no other table holds.
+    /// \param txn Active transaction wrapper.
+    template<class KeyT, class Options = DefaultTableOptions, typename CallbackT>
+    bool for_each_difference(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                             CallbackT callback, const Transaction& txn) {
+        return for_each_difference<KeyT, Options>(sets, callback, txn.handle());
+    }
+
+    // --- Collecting operations ---
+
+    /// \brief Returns the keys present in every table of \p sets, in key order.
+    template<class KeyT, class Options = DefaultTableOptions>
+    std::vector<KeyT> intersect(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                                MDBX_txn* txn = nullptr) {
+        std::vector<KeyT> out;
+        for_each_intersection<KeyT, Options>(sets, [&out](const KeyT& key) {
+            out.push_back(key);
+            return true;
+        }, txn);
+        return out;
+    }
+
+    /// \brief Returns the keys present in every table of \p sets, in key order.
+    template<class KeyT, class Options = DefaultTableOptions>
+    std::vector<KeyT> intersect(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                                const Transaction& txn) {
+        return intersect<KeyT, Options>(sets, txn.handle());
+    }
+
+    /// \brief Returns the keys present in at least one table of \p sets, in key order.
+    template<class KeyT, class Options = DefaultTableOptions>
+    std::vector<KeyT> unite(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                            MDBX_txn* txn = nullptr) {
+        std::vector<KeyT> out;
+        for_each_union<KeyT, Options>(sets, [&out](const KeyT& key) {
+            out.push_back(key);
+            return true;
+        }, txn);
+        return out;
+    }
+
+    /// \brief Returns the keys present in at least one table of \p sets, in key order.
+    template<class KeyT, class Options = DefaultTableOptions>
+    std::vector<KeyT> unite(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                            const Transaction& txn) {
+        return unite<KeyT, Options>(sets, txn.handle());
+    }
+
+    /// \brief Returns the keys of the first table of \p sets that no other
+    /// table holds, in key order.
+    template<class KeyT, class Options = DefaultTableOptions>
+    std::vector<KeyT> difference(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                                 MDBX_txn* txn = nullptr) {
+        std::vector<KeyT> out;
+        for_each_difference<KeyT, Options>(sets, [&out](const KeyT& key) {
+            out.push_back(key);
+            return true;
+        }, txn);
+        return out;
+    }
+
+    /// \brief Returns the keys of the first table of \p sets that no other
+    /// table holds, in key order.
+    template<class KeyT, class Options = DefaultTableOptions>
+    std::vector<KeyT> difference(const std::vector<KeySetRef<KeyT, Options>>& sets,
+                                 const Transaction& txn) {
+        return difference<KeyT, Options>(sets, txn.handle());
+    }
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_KEY_SET_OPS_HPP_INCLUDED
@@ -189,6 +189,79 @@ namespace mdbxc {
             return for_each_range(from_key, to_key, callback, txn.handle());
         }
 
+        /// \brief Visits every key whose key starts with \p prefix.
+        /// \details Positions with \c MDBX_SET_RANGE at \p prefix and stops at the
+        /// first key that no longer matches, so only matching keys are read.
+        /// Available for \c std::string and byte-vector keys.
+        /// \param prefix Key prefix; an empty prefix visits the whole table.
+        /// \param callback Invoked as \c callback(const KeyT&); returns \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the scan reached the end of the prefix, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_prefix(const KeyT& prefix, CallbackT callback, MDBX_txn* txn = nullptr) const {
+            bool completed = false;
+            with_transaction([this, &prefix, &callback, &completed](MDBX_txn* t) {
+                completed = db_for_each_prefix(prefix, callback, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Visits every key whose key starts with \p prefix.
+        /// \param prefix Key prefix.
+        /// \param callback Invoked as \c callback(const KeyT&); returns \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the scan reached the end of the prefix, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_prefix(const KeyT& prefix, CallbackT callback, const Transaction& txn) const {
+            return for_each_prefix(prefix, callback, txn.handle());
+        }
+
+        /// \brief Counts keys whose key starts with \p prefix.
+        /// \param prefix Key prefix.
+        /// \param txn Optional transaction handle.
+        /// \return Number of matching keys.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t count_prefix(const KeyT& prefix, MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            with_transaction([this, &prefix, &result](MDBX_txn* t) {
+                result = db_count_prefix(prefix, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Counts keys whose key starts with \p prefix.
+        /// \param prefix Key prefix.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of matching keys.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t count_prefix(const KeyT& prefix, const Transaction& txn) const {
+            return count_prefix(prefix, txn.handle());
+        }
+
+        /// \brief Removes every key whose key starts with \p prefix.
+        /// \param prefix Key prefix; an empty prefix clears the table.
+        /// \param txn Optional transaction handle.
+        /// \return Number of deleted records.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t erase_prefix(const KeyT& prefix, MDBX_txn* txn = nullptr) {
+            std::size_t result = 0;
+            with_transaction([this, &prefix, &result](MDBX_txn* t) {
+                result = db_erase_prefix(prefix, t);
+            }, TransactionMode::WRITABLE, txn);
+            return result;
+        }
+
+        /// \brief Removes every key whose key starts with \p prefix.
+        /// \param prefix Key prefix.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of deleted records.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t erase_prefix(const KeyT& prefix, const Transaction& txn) {
+            return erase_prefix(prefix, txn.handle());
+        }
+
         /// \brief Collects keys matching a predicate within an inclusive range.
         /// \tparam ContainerT Container type storing keys (default \c std::vector).
         /// \param from_key Start key in MDBX key order.
@@ -616,6 +689,62 @@ namespace mdbxc {
             return count_range(from_key, to_key, txn.handle());
         }
 
+        /// \brief Estimates the number of keys within an inclusive range.
+        /// \details O(log n): uses \c mdbx_estimate_range() instead of walking the
+        /// range, so the result is approximate. Use \ref count_range() for an exact count.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Optional transaction handle.
+        /// \return Estimated number of keys in the requested range.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t estimate_count_range(const KeyT& from_key, const KeyT& to_key,
+                                         MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = db_estimate_count_range(from_key, to_key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Estimates the number of keys within an inclusive range.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Active transaction wrapper.
+        /// \return Estimated number of keys in the requested range.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t estimate_count_range(const KeyT& from_key, const KeyT& to_key,
+                                         const Transaction& txn) const {
+            return estimate_count_range(from_key, to_key, txn.handle());
+        }
+
+        /// \brief Estimates the storage size of keys within an inclusive range.
+        /// \details Scales \ref estimate_count_range() by the average per-entry page
+        /// footprint reported by \c mdbx_dbi_stat(), including page overhead.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Optional transaction handle.
+        /// \return Estimated size in bytes.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t estimate_bytes_range(const KeyT& from_key, const KeyT& to_key,
+                                           MDBX_txn* txn = nullptr) const {
+            std::uint64_t result = 0;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = estimate_range_bytes(t, db_estimate_count_range(from_key, to_key, t));
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Estimates the storage size of keys within an inclusive range.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Active transaction wrapper.
+        /// \return Estimated size in bytes.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t estimate_bytes_range(const KeyT& from_key, const KeyT& to_key,
+                                           const Transaction& txn) const {
+            return estimate_bytes_range(from_key, to_key, txn.handle());
+        }
+
         /// \brief Removes all keys within an inclusive range.
         /// \param from_key Start key in MDBX key order.
         /// \param to_key End key in MDBX key order.
@@ -642,6 +771,38 @@ namespace mdbxc {
             return erase_range(from_key, to_key, txn.handle());
         }
 
+        /// \brief Removes all keys within an inclusive range, committing every \p chunk_size deletions.
+        /// \details Each chunk runs in its own write transaction, so a large purge
+        /// releases the writer lock and flushes its dirty pages between chunks.
+        /// Other writers may interleave; each chunk resumes at the first key still
+        /// present in the range. Already committed chunks stay deleted if a later
+        /// chunk fails.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param chunk_size Maximum deletions per write transaction.
+        /// \return Total number of deleted records.
+        /// \throws std::invalid_argument if \p chunk_size is zero.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t erase_range_chunked(const KeyT& from_key, const KeyT& to_key,
+                                        std::size_t chunk_size) {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("erase_range_chunked: chunk_size must be positive");
+            }
+            if (thread_txn()) {
+                throw std::logic_error("erase_range_chunked: transaction already started for this thread.");
+            }
+            std::size_t total = 0;
+            for (;;) {
+                std::size_t removed = 0;
+                with_transaction([this, &from_key, &to_key, chunk_size, &removed](MDBX_txn* t) {
+                    removed = db_erase_range(from_key, to_key, t, chunk_size);
+                }, TransactionMode::WRITABLE);
+                total += removed;
+                if (removed < chunk_size) return total;
+            }
+        }
+
         // --- Existing bulk / point API ---
 
         /// \brief Appends keys to the table.
@@ -666,6 +827,42 @@ namespace mdbxc {
             append(container, txn.handle());
         }
 
+        /// \brief Inserts keys sorted in MDBX key order using \c MDBX_APPEND.
+        /// \tparam ContainerT Container type iterated in ascending key order.
+        /// \param container Source keys; each must be greater than the last key
+        /// already stored in the table.
+        /// \param mode Reaction to out-of-order keys.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every key was written through the append fast path,
+        /// \c false if \ref BulkLoadMode::Fallback switched to regular inserts.
+        /// \throws MdbxException with \c MDBX_EKEYMISMATCH in \ref BulkLoadMode::Strict
+        /// when a key is out of order, or on other database errors.
+        /// \note In fallback mode duplicate and already stored keys are ignored
+        ///       by set semantics, as in \ref append().
+        template<template<class...> class ContainerT>
+        bool bulk_load_sorted(const ContainerT<KeyT>& container,
+                              BulkLoadMode mode = BulkLoadMode::Fallback,
+                              MDBX_txn* txn = nullptr) {
+            bool appended = false;
+            with_transaction([this, &container, mode, &appended](MDBX_txn* t) {
+                appended = db_bulk_load_sorted(container, mode, t);
+            }, TransactionMode::WRITABLE, txn);
+            return appended;
+        }
+
+        /// \brief Inserts keys sorted in MDBX key order using \c MDBX_APPEND.
+        /// \tparam ContainerT Container type iterated in ascending key order.
+        /// \param container Source keys.
+        /// \param mode Reaction to out-of-order keys.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every key used the append fast path.
+        /// \throws MdbxException if a key is out of order in strict mode or a database error occurs.
+        template<template<class...> class ContainerT>
+        bool bulk_load_sorted(const ContainerT<KeyT>& container,
+                              BulkLoadMode mode, const Transaction& txn) {
+            return bulk_load_sorted(container, mode, txn.handle());
+        }
+
         /// \brief Replaces table content with keys from a container.
         /// \tparam ContainerT Container type storing keys.
         /// \param container Source keys.
@@ -689,6 +886,67 @@ namespace mdbxc {
             reconcile(container, txn.handle());
         }
 
+        /// \brief Reconciles the table with a sorted input stream in bounded write chunks.
+        ///
+        /// Merge-joins keys from [\p first, \p last) with the table in MDBX
+        /// key order: keys absent from the input are erased and
+        /// missing keys are inserted.
+        /// A write transaction is committed every \p chunk_size changes and
+        /// \p progress is called after each commit, so memory use is independent
+        /// of the table and input sizes.
+        /// \tparam InputIt Single-pass iterator over keys in strictly ascending MDBX key order.
+        /// \tparam ProgressT Callable invoked as \c progress(const ReconcileProgress&).
+        /// \param first Start of the sorted input.
+        /// \param last End of the sorted input.
+        /// \param chunk_size Maximum changes per write transaction.
+        /// \param progress Receives cumulative counters after every committed chunk.
+        /// \return Final counters.
+        /// \throws std::invalid_argument if \p chunk_size is zero or input keys are not
+        ///         strictly ascending; chunks committed before the error remain applied.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        /// \throws MdbxException if a database error occurs.
+        /// \note Unlike \ref reconcile(), the result is not atomic: readers and other
+        /// writers may observe or modify the table between chunks.
+        template<typename InputIt, typename ProgressT>
+        ReconcileProgress reconcile_sorted(InputIt first, InputIt last,
+                                           std::size_t chunk_size, ProgressT progress) {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("reconcile_sorted: chunk_size must be positive");
+            }
+            if (thread_txn()) {
+                throw std::logic_error("reconcile_sorted: transaction already started for this thread.");
+            }
+            SerializeScratch sc_key;
+            auto encode = [&sc_key](const KeyT& key, MDBX_val& db_key, MDBX_val& db_val) {
+                db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+                db_val = empty_value();
+            };
+            detail::SortedReconcileState state;
+            ReconcileProgress stats;
+            bool done = false;
+            while (!done) {
+                with_transaction([this, &done, &first, &last, chunk_size, &encode, &state, &stats](MDBX_txn* t) {
+                    done = db_reconcile_sorted_chunk(t, first, last, chunk_size, encode, state, stats);
+                }, TransactionMode::WRITABLE);
+                ++stats.chunks;
+                progress(static_cast<const ReconcileProgress&>(stats));
+            }
+            return stats;
+        }
+
+        /// \brief Reconciles the table with a sorted input stream in bounded write chunks.
+        /// \param first Start of the sorted input.
+        /// \param last End of the sorted input.
+        /// \param chunk_size Maximum changes per write transaction.
+        /// \return Final counters.
+        /// \throws std::invalid_argument if \p chunk_size is zero or input is not strictly ascending.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        /// \throws MdbxException if a database error occurs.
+        template<typename InputIt>
+        ReconcileProgress reconcile_sorted(InputIt first, InputIt last, std::size_t chunk_size) {
+            return reconcile_sorted(first, last, chunk_size, detail::NoReconcileProgress());
+        }
+
         /// \brief Inserts a key if it is absent.
         /// \param key Key to insert.
         /// \param txn Optional transaction handle.
@@ -809,6 +1067,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
 
             auto txn_guard = m_connection->transaction(mode);
             try {
@@ -829,8 +1088,7 @@ namespace mdbxc {
 
         template<template<class...> class ContainerT>
         void db_load(ContainerT<KeyT>& container, MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             MDBX_val db_key, db_val;
             int rc = MDBX_SUCCESS;
@@ -850,8 +1108,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_from_key;
@@ -881,8 +1138,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) {
                 return true;
             }
@@ -920,8 +1176,7 @@ namespace mdbxc {
                 return deserialize_key<KeyT>(db_key);
             }
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_SUCCESS) {
                 return deserialize_key<KeyT>(db_key);
@@ -939,8 +1194,7 @@ namespace mdbxc {
             MDBX_val db_key_exact = db_key;
             MDBX_val db_val;
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return std::nullopt;
@@ -959,8 +1213,7 @@ namespace mdbxc {
         }
 
         std::optional<KeyT> db_first(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -971,8 +1224,7 @@ namespace mdbxc {
         }
 
         std::optional<KeyT> db_last(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -993,8 +1245,7 @@ namespace mdbxc {
                 return std::make_pair(true, deserialize_key<KeyT>(db_key));
             }
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_SUCCESS) {
                 return std::make_pair(true, deserialize_key<KeyT>(db_key));
@@ -1012,8 +1263,7 @@ namespace mdbxc {
             MDBX_val db_key_exact = db_key;
             MDBX_val db_val;
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return std::make_pair(false, KeyT());
@@ -1031,8 +1281,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, KeyT> db_first_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1043,8 +1292,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, KeyT> db_last_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1065,8 +1313,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_to_key;
@@ -1104,8 +1351,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_to_key;
@@ -1148,8 +1394,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return false;
 
             MDBX_val db_key = db_from_key;
@@ -1160,14 +1405,21 @@ namespace mdbxc {
             return mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) <= 0;
         }
 
+        std::size_t db_estimate_count_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+            return estimate_range_items(txn, db_from_key, db_to_key);
+        }
+
         std::size_t db_count_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return 0;
 
             MDBX_val db_key = db_from_key;
@@ -1189,15 +1441,90 @@ namespace mdbxc {
             return count;
         }
 
-        std::size_t db_erase_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
+        template<typename CallbackT>
+        bool db_for_each_prefix(const KeyT& prefix, CallbackT& callback, MDBX_txn* txn) const {
+            auto visit = [&callback](const MDBX_val& db_key, const MDBX_val&) -> bool {
+                KeyT key = deserialize_key<KeyT>(db_key);
+                return callback(static_cast<const KeyT&>(key));
+            };
+            return db_walk_prefix(prefix, visit, txn, "Failed to iterate key prefix");
+        }
+
+        std::size_t db_count_prefix(const KeyT& prefix, MDBX_txn* txn) const {
+            std::size_t count = 0;
+            auto counter = [&count](const MDBX_val&, const MDBX_val&) -> bool {
+                ++count;
+                return true;
+            };
+            db_walk_prefix(prefix, counter, txn, "Failed to count key prefix");
+            return count;
+        }
+
+        std::size_t db_erase_prefix(const KeyT& prefix, MDBX_txn* txn) const {
+            static_assert(is_byte_string_key<KeyT>::value,
+                          "Prefix scans require std::string or byte-vector keys");
+            SerializeScratch sc_prefix;
+            MDBX_val db_prefix = serialize_key<Options::safe_integer_key>(prefix, sc_prefix);
+
+            std::size_t removed = 0;
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key = db_prefix;
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val,
+                                     db_prefix.iov_len ? MDBX_SET_RANGE : MDBX_FIRST);
+            while (rc == MDBX_SUCCESS && mdbx_val_has_prefix(db_key, db_prefix)) {
+#               if MDBXC_SYNC_ENABLED
+                const std::vector<std::uint8_t> kbytes = capture_bytes(db_key);
+#               endif
+                check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to erase key in prefix");
+#               if MDBXC_SYNC_ENABLED
+                record_op(txn, sync::ChangeOpType::Delete, kbytes, MDBX_val());
+#               endif
+                ++removed;
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to erase key prefix");
+            }
+            return removed;
+        }
+
+        /// \brief Calls \p visit with each serialized pair whose key starts with \p prefix.
+        /// \return \c false if \p visit returned \c false, otherwise \c true.
+        template<typename VisitT>
+        bool db_walk_prefix(const KeyT& prefix, VisitT& visit, MDBX_txn* txn, const char* error) const {
+            static_assert(is_byte_string_key<KeyT>::value,
+                          "Prefix scans require std::string or byte-vector keys");
+            SerializeScratch sc_prefix;
+            MDBX_val db_prefix = serialize_key<Options::safe_integer_key>(prefix, sc_prefix);
+
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key = db_prefix;
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val,
+                                     db_prefix.iov_len ? MDBX_SET_RANGE : MDBX_FIRST);
+            while (rc == MDBX_SUCCESS && mdbx_val_has_prefix(db_key, db_prefix)) {
+                if (!visit(static_cast<const MDBX_val&>(db_key), static_cast<const MDBX_val&>(db_val))) {
+                    return false;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, error);
+            }
+            return true;
+        }
+
+        /// \brief Deletes up to \p limit records of an inclusive range with \c mdbx_cursor_del().
+        std::size_t db_erase_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn,
+                                   std::size_t limit = static_cast<std::size_t>(-1)) const {
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
             std::size_t removed = 0;
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return 0;
 
             MDBX_val db_key = db_from_key;
@@ -1214,9 +1541,9 @@ namespace mdbxc {
 #               endif
                 check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to erase key in range");
 #               if MDBXC_SYNC_ENABLED
-                record_op(txn, sync::ChangeOpType::Delete, kbytes, {});
+                record_op(txn, sync::ChangeOpType::Delete, kbytes, MDBX_val());
 #               endif
-                ++removed;
+                if (++removed == limit) return removed;
                 rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
             }
             if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
@@ -1235,6 +1562,37 @@ namespace mdbxc {
             }
         }
 
+        template<template<class...> class ContainerT>
+        bool db_bulk_load_sorted(const ContainerT<KeyT>& container, BulkLoadMode mode, MDBX_txn* txn) {
+            SerializeScratch sc_key;
+            bool appending = true;
+            for (typename ContainerT<KeyT>::const_iterator it = container.begin();
+                 it != container.end(); ++it) {
+                if (!appending) {
+                    db_insert(*it, txn);
+                    continue;
+                }
+                MDBX_val db_key = serialize_key<Options::safe_integer_key>(*it, sc_key);
+                MDBX_val db_val = empty_value();
+                int rc = mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_NOOVERWRITE | MDBX_APPEND);
+                if (rc == MDBX_EKEYMISMATCH || rc == MDBX_KEYEXIST) {
+                    if (mode == BulkLoadMode::Strict) {
+                        check_mdbx(MDBX_EKEYMISMATCH,
+                                   "bulk_load_sorted: key is not greater than the last table key");
+                    }
+                    appending = false;
+                    db_insert(*it, txn);
+                    continue;
+                }
+                check_mdbx(rc, "Failed to insert key");
+#               if MDBXC_SYNC_ENABLED
+                record_op(txn, sync::ChangeOpType::Put,
+                          db_key, MDBX_val());
+#               endif
+            }
+            return appending;
+        }
+
         bool db_insert(const KeyT& key, MDBX_txn* txn) {
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
@@ -1243,7 +1601,7 @@ namespace mdbxc {
             if (rc == MDBX_SUCCESS) {
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), {});
+                          db_key, MDBX_val());
 #               endif
                 return true;
             }
@@ -1276,7 +1634,7 @@ namespace mdbxc {
             if (rc == MDBX_SUCCESS) {
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn, sync::ChangeOpType::Delete,
-                          capture_bytes(db_key), {});
+                          db_key, MDBX_val());
 #               endif
                 return true;
             }
@@ -1288,7 +1646,7 @@ namespace mdbxc {
         void db_clear(MDBX_txn* txn) {
             check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear table");
 #           if MDBXC_SYNC_ENABLED
-            record_op(txn, sync::ChangeOpType::ClearTable, {}, {});
+            record_op(txn, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
 #           endif
         }
     };
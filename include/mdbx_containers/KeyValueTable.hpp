@@ -9,6 +9,14 @@
 /// overloads and bulk synchronization helpers.
 
 #include "common.hpp"
+#include "Hash.hpp"
+#include "detail/ParallelDecode.hpp"
+#include "detail/RangeAggregateIndex.hpp"
+#include "detail/ResultContainers.hpp"
+#include "detail/SecondaryIndex.hpp"
+#include <atomic>
+#include <exception>
+#include <iterator>
 #include <map>
 #include <unordered_set>
 
@@ -53,6 +61,183 @@ namespace mdbxc {
     public:
         typedef std::pair<KeyT, ValueT> value_type;
 
+        static const std::size_t no_limit = static_cast<std::size_t>(-1); ///< Unbounded \c limit for scan helpers.
+
+        /// \class const_iterator
+        /// \brief Bidirectional cursor iterator over table pairs in MDBX key order.
+        /// \details Wraps an \c MDBX_cursor bound to the transaction passed to
+        /// \ref iter_begin(), \ref iter_end(), \ref iter_lower_bound() or
+        /// \ref iter_upper_bound(). The pair under the cursor is deserialized
+        /// lazily on first dereference and cached until the iterator moves, so a
+        /// scan holds one pair in memory and can stop at any point.
+        /// Copying an iterator duplicates its cursor position.
+        /// \warning Iterators must not outlive the transaction they were created
+        /// in and must not be used after the table is modified through another
+        /// handle in that transaction.
+        class const_iterator {
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef std::pair<KeyT, ValueT> value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const value_type* pointer;
+            typedef const value_type& reference;
+
+            /// \brief Constructs a detached end iterator.
+            const_iterator() noexcept = default;
+
+            /// \brief Copies cursor position and cached pair of another iterator.
+            /// \param other Iterator to copy.
+            /// \throws MdbxException if the cursor cannot be duplicated.
+            const_iterator(const const_iterator& other)
+                : m_at_end(other.m_at_end),
+                  m_cached(other.m_cached),
+                  m_current(other.m_current) {
+                if (!other.m_cursor) return;
+                CursorGuard cursor(mdbx_cursor_create(nullptr));
+                if (!cursor.get()) {
+                    check_mdbx(MDBX_ENOMEM, "Failed to create MDBX cursor");
+                }
+                check_mdbx(mdbx_cursor_copy(other.m_cursor, cursor.get()),
+                           "Failed to copy MDBX cursor");
+                m_cursor = cursor.cursor;
+                cursor.cursor = nullptr;
+            }
+
+            /// \brief Takes over the cursor of another iterator.
+            /// \param other Iterator left detached at end.
+            const_iterator(const_iterator&& other) noexcept
+                : m_cursor(other.m_cursor),
+                  m_at_end(other.m_at_end),
+                  m_cached(other.m_cached),
+                  m_current(std::move(other.m_current)) {
+                other.m_cursor = nullptr;
+                other.m_at_end = true;
+                other.m_cached = false;
+            }
+
+            const_iterator& operator=(const_iterator other) noexcept {
+                swap(other);
+                return *this;
+            }
+
+            ~const_iterator() noexcept {
+                if (m_cursor) mdbx_cursor_close(m_cursor);
+            }
+
+            /// \brief Returns the pair under the cursor.
+            /// \return Reference valid until the iterator moves or is destroyed.
+            /// \throws std::out_of_range if the iterator is at end.
+            /// \throws MdbxException if a database error occurs.
+            reference operator*() const {
+                load_current();
+                return m_current;
+            }
+
+            pointer operator->() const {
+                load_current();
+                return &m_current;
+            }
+
+            /// \brief Advances to the next key.
+            /// \throws std::out_of_range if the iterator is already at end.
+            /// \throws MdbxException if a database error occurs.
+            const_iterator& operator++() {
+                if (m_at_end) {
+                    throw std::out_of_range("KeyValueTable iterator: increment past end");
+                }
+                step(MDBX_NEXT);
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator prev(*this);
+                ++*this;
+                return prev;
+            }
+
+            /// \brief Moves to the previous key; from end moves to the last key.
+            /// \throws std::out_of_range if the iterator is detached.
+            /// \throws MdbxException if a database error occurs.
+            const_iterator& operator--() {
+                if (!m_cursor) {
+                    throw std::out_of_range("KeyValueTable iterator: decrement of detached iterator");
+                }
+                step(m_at_end ? MDBX_LAST : MDBX_PREV);
+                return *this;
+            }
+
+            const_iterator operator--(int) {
+                const_iterator prev(*this);
+                --*this;
+                return prev;
+            }
+
+            /// \brief Compares positions; all end iterators are equal.
+            /// \throws MdbxException if a database error occurs.
+            bool operator==(const const_iterator& other) const {
+                if (m_at_end || other.m_at_end) return m_at_end == other.m_at_end;
+                MDBX_val lhs = current_key();
+                MDBX_val rhs = other.current_key();
+                return lhs.iov_len == rhs.iov_len &&
+                       (lhs.iov_len == 0 || std::memcmp(lhs.iov_base, rhs.iov_base, lhs.iov_len) == 0);
+            }
+
+            bool operator!=(const const_iterator& other) const {
+                return !(*this == other);
+            }
+
+            void swap(const_iterator& other) noexcept {
+                std::swap(m_cursor, other.m_cursor);
+                std::swap(m_at_end, other.m_at_end);
+                std::swap(m_cached, other.m_cached);
+                std::swap(m_current, other.m_current);
+            }
+
+        private:
+            friend class KeyValueTable;
+
+            /// \brief Takes ownership of an opened cursor.
+            const_iterator(MDBX_cursor* cursor, bool at_end) noexcept
+                : m_cursor(cursor), m_at_end(at_end) {}
+
+            void step(MDBX_cursor_op op) {
+                m_cached = false;
+                MDBX_val db_key, db_val;
+                int rc = mdbx_cursor_get(m_cursor, &db_key, &db_val, op);
+                if (rc == MDBX_NOTFOUND) {
+                    m_at_end = true;
+                    return;
+                }
+                check_mdbx(rc, "Failed to move key-value iterator");
+                m_at_end = false;
+            }
+
+            MDBX_val current_key() const {
+                MDBX_val db_key, db_val;
+                check_mdbx(mdbx_cursor_get(m_cursor, &db_key, &db_val, MDBX_GET_CURRENT),
+                           "Failed to read key-value iterator position");
+                return db_key;
+            }
+
+            void load_current() const {
+                if (m_at_end) {
+                    throw std::out_of_range("KeyValueTable iterator: dereference of end iterator");
+                }
+                if (m_cached) return;
+                MDBX_val db_key, db_val;
+                check_mdbx(mdbx_cursor_get(m_cursor, &db_key, &db_val, MDBX_GET_CURRENT),
+                           "Failed to read key-value iterator position");
+                m_current.first = deserialize_key<KeyT>(db_key);
+                m_current.second = deserialize_value<ValueT>(db_val);
+                m_cached = true;
+            }
+
+            MDBX_cursor*       m_cursor = nullptr; ///< Owned cursor, null for detached end.
+            bool               m_at_end = true;    ///< Cursor is past the last key.
+            mutable bool       m_cached = false;   ///< \c m_current holds the pair under the cursor.
+            mutable value_type m_current;          ///< Lazily deserialized current pair.
+        };
+
         /// \brief Default constructor.
         /// \param connection Existing \ref Connection instance.
         /// \param name Name of the table within the MDBX environment.
@@ -243,6 +428,100 @@ namespace mdbxc {
             load(container, txn.handle());
         }
 
+        /// \brief Appends every pair of the table to a caller container.
+        /// \details Accepts the same containers as \ref range_into(), including
+        /// \c std::pmr containers, which \ref load() cannot take because it is
+        /// keyed on the container template.
+        /// \param out Container receiving the pairs after its existing contents.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs.
+        template<class OutT>
+        void load_into(OutT& out, MDBX_txn* txn = nullptr) const {
+            with_transaction([this, &out](MDBX_txn* t) {
+                CachedCursor cursor(*this, t);
+                MDBX_val db_key;
+                MDBX_val db_val;
+                int rc = MDBX_SUCCESS;
+                while ((rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT)) == MDBX_SUCCESS) {
+                    detail::emplace_result(out, detail::result_arg<KeyT>::key(db_key),
+                                           detail::result_arg<ValueT>::value(db_val));
+                }
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to load key-value table");
+                }
+            }, TransactionMode::READ_ONLY, txn);
+        }
+
+        /// \brief Appends every pair of the table to a caller container.
+        /// \param out Container receiving the pairs after its existing contents.
+        /// \param txn Active transaction wrapper.
+        /// \throws MdbxException if a database error occurs.
+        template<class OutT>
+        void load_into(OutT& out, const Transaction& txn) const {
+            load_into(out, txn.handle());
+        }
+
+        /// \brief Loads all pairs, deserializing them on several threads.
+        /// \details The calling thread walks one read snapshot and hands raw
+        /// record views to \p threads workers, so startup loads of large tables
+        /// scale with cores while pairs stay in key order. \p container is
+        /// reserved from the DBI entry count first.
+        /// \param container Receives the pairs after its existing contents.
+        /// \param threads Worker count; 0 uses the hardware concurrency and 1
+        ///        behaves like \ref load().
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs; the first
+        ///         deserialization error is rethrown after all workers stop.
+        void parallel_load(std::vector<std::pair<KeyT, ValueT>>& container, std::size_t threads,
+                           MDBX_txn* txn = nullptr) {
+            with_transaction([this, &container, threads](MDBX_txn* t) {
+                db_parallel_load(container, threads, t);
+            }, TransactionMode::READ_ONLY, txn);
+        }
+
+        /// \brief Loads all pairs, deserializing them on several threads.
+        /// \param container Receives the pairs after its existing contents.
+        /// \param threads Worker count; 0 uses the hardware concurrency.
+        /// \param txn Active transaction wrapper.
+        /// \throws MdbxException if a database error occurs.
+        void parallel_load(std::vector<std::pair<KeyT, ValueT>>& container, std::size_t threads,
+                           const Transaction& txn) {
+            parallel_load(container, threads, txn.handle());
+        }
+
+        /// \brief Loads all pairs into an associative container, deserializing on several threads.
+        /// \details Records are decoded in parallel as for the vector overload;
+        /// the insertions into \p container then run on the calling thread,
+        /// after \c reserve() when the container provides it (e.g.
+        /// \c std::unordered_map).
+        /// \tparam ContainerT Container type (e.g., std::map or std::unordered_map).
+        /// \param container Receives the pairs; existing contents are kept.
+        /// \param threads Worker count; 0 uses the hardware concurrency.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs.
+        template<template <class...> class ContainerT>
+        void parallel_load(ContainerT<KeyT, ValueT>& container, std::size_t threads,
+                           MDBX_txn* txn = nullptr) {
+            std::vector<std::pair<KeyT, ValueT>> pairs;
+            parallel_load(pairs, threads, txn);
+            detail::reserve_if_supported(container, container.size() + pairs.size(), 0);
+            for (std::size_t i = 0; i < pairs.size(); ++i) {
+                container.emplace(std::move(pairs[i].first), std::move(pairs[i].second));
+            }
+        }
+
+        /// \brief Loads all pairs into an associative container, deserializing on several threads.
+        /// \tparam ContainerT Container type (e.g., std::map or std::unordered_map).
+        /// \param container Receives the pairs; existing contents are kept.
+        /// \param threads Worker count; 0 uses the hardware concurrency.
+        /// \param txn Active transaction wrapper.
+        /// \throws MdbxException if a database error occurs.
+        template<template <class...> class ContainerT>
+        void parallel_load(ContainerT<KeyT, ValueT>& container, std::size_t threads,
+                           const Transaction& txn) {
+            parallel_load(container, threads, txn.handle());
+        }
+
         /// \brief Retrieves all key-value pairs into the specified container type.
         /// \tparam ContainerT Container type (e.g., std::map, std::unordered_map, std::vector).
         /// \param txn Optional transaction handle.
@@ -345,6 +624,41 @@ namespace mdbxc {
             return range<ContainerT>(from_key, to_key, txn.handle());
         }
 
+        /// \brief Appends key-value pairs within an inclusive key range to a caller container.
+        /// \details \p out may be any sequence container (\c emplace_back) or
+        /// associative container (\c emplace) whose elements are constructible
+        /// from a key and a value, including \c std::pmr containers: elements
+        /// are constructed with the container's allocator, and in C++17 string
+        /// keys and values are passed as \c std::string_view so
+        /// \c std::pmr::string elements are copied straight into the arena.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param out Container receiving the pairs after its existing contents.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs.
+        template<class OutT>
+        void range_into(const KeyT& from_key, const KeyT& to_key, OutT& out,
+                        MDBX_txn* txn = nullptr) const {
+            with_transaction([this, &from_key, &to_key, &out](MDBX_txn* t) {
+                db_for_each_raw_range(from_key, to_key, t, [&out](const MDBX_val& db_key, const MDBX_val& db_val) {
+                    detail::emplace_result(out, detail::result_arg<KeyT>::key(db_key),
+                                           detail::result_arg<ValueT>::value(db_val));
+                });
+            }, TransactionMode::READ_ONLY, txn);
+        }
+
+        /// \brief Appends key-value pairs within an inclusive key range to a caller container.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param out Container receiving the pairs after its existing contents.
+        /// \param txn Active transaction wrapper.
+        /// \throws MdbxException if a database error occurs.
+        template<class OutT>
+        void range_into(const KeyT& from_key, const KeyT& to_key, OutT& out,
+                        const Transaction& txn) const {
+            range_into(from_key, to_key, out, txn.handle());
+        }
+
         /// \brief Retrieves values whose keys are within an inclusive key range.
         /// \tparam ContainerT Container type storing values.
         /// \param from_key Start key in MDBX key order.
@@ -381,6 +695,83 @@ namespace mdbxc {
 
         // --- Streaming and range helpers ---
 
+        /// \brief Returns a cursor iterator positioned at the first key.
+        /// \param txn Transaction handle; when null, the transaction bound to
+        /// the current thread is used.
+        /// \return Iterator at the first pair, or an end iterator for an empty table.
+        /// \throws std::logic_error if no transaction is available.
+        /// \throws MdbxException if a database error occurs.
+        /// \note Iterators do not open transactions of their own; keep \p txn
+        /// alive while the iterator is in use.
+        const_iterator iter_begin(MDBX_txn* txn = nullptr) const {
+            return make_iterator(txn, MDBX_FIRST, nullptr, false);
+        }
+
+        /// \brief Returns a cursor iterator positioned at the first key.
+        /// \param txn Active transaction wrapper.
+        /// \return Iterator at the first pair, or an end iterator for an empty table.
+        /// \throws MdbxException if a database error occurs.
+        const_iterator iter_begin(const Transaction& txn) const {
+            return iter_begin(txn.handle());
+        }
+
+        /// \brief Returns an end iterator bound to a transaction.
+        /// \details Unlike a default-constructed iterator, it can be decremented
+        /// to reach the last key.
+        /// \param txn Transaction handle; when null, the thread-bound transaction is used.
+        /// \return End iterator.
+        /// \throws std::logic_error if no transaction is available.
+        /// \throws MdbxException if a database error occurs.
+        const_iterator iter_end(MDBX_txn* txn = nullptr) const {
+            return const_iterator(open_iterator_cursor(txn), true);
+        }
+
+        /// \brief Returns an end iterator bound to a transaction.
+        /// \param txn Active transaction wrapper.
+        /// \return End iterator.
+        /// \throws MdbxException if a database error occurs.
+        const_iterator iter_end(const Transaction& txn) const {
+            return iter_end(txn.handle());
+        }
+
+        /// \brief Returns a cursor iterator at the first key not less than \p key.
+        /// \param key Key to bound.
+        /// \param txn Transaction handle; when null, the thread-bound transaction is used.
+        /// \return Positioned iterator, or an end iterator if no such key exists.
+        /// \throws std::logic_error if no transaction is available.
+        /// \throws MdbxException if a database error occurs.
+        const_iterator iter_lower_bound(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            return make_iterator(txn, MDBX_SET_RANGE, &key, false);
+        }
+
+        /// \brief Returns a cursor iterator at the first key not less than \p key.
+        /// \param key Key to bound.
+        /// \param txn Active transaction wrapper.
+        /// \return Positioned iterator, or an end iterator if no such key exists.
+        /// \throws MdbxException if a database error occurs.
+        const_iterator iter_lower_bound(const KeyT& key, const Transaction& txn) const {
+            return iter_lower_bound(key, txn.handle());
+        }
+
+        /// \brief Returns a cursor iterator at the first key greater than \p key.
+        /// \param key Key to bound.
+        /// \param txn Transaction handle; when null, the thread-bound transaction is used.
+        /// \return Positioned iterator, or an end iterator if no such key exists.
+        /// \throws std::logic_error if no transaction is available.
+        /// \throws MdbxException if a database error occurs.
+        const_iterator iter_upper_bound(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            return make_iterator(txn, MDBX_SET_RANGE, &key, true);
+        }
+
+        /// \brief Returns a cursor iterator at the first key greater than \p key.
+        /// \param key Key to bound.
+        /// \param txn Active transaction wrapper.
+        /// \return Positioned iterator, or an end iterator if no such key exists.
+        /// \throws MdbxException if a database error occurs.
+        const_iterator iter_upper_bound(const KeyT& key, const Transaction& txn) const {
+            return iter_upper_bound(key, txn.handle());
+        }
+
         /// \brief Calls a callback for every key-value pair in an inclusive range.
         /// \param from_key Start key in MDBX key order.
         /// \param to_key End key in MDBX key order.
@@ -411,6 +802,90 @@ namespace mdbxc {
             return for_each_range(from_key, to_key, callback, txn.handle());
         }
 
+        /// \brief Visits every pair in an inclusive range by reference into the MDBX page.
+        /// \details Requires a raw trivially copyable \c ValueT. A value whose
+        /// page address is aligned for \c ValueT is passed as a reference into
+        /// the page; others are copied to the stack first. MDBX packs nodes on
+        /// 2-byte boundaries, so alignment is not guaranteed in general. With
+        /// 8-byte keys (e.g. \c uint64_t under \ref FastIntegerKeyOptions) and
+        /// \c sizeof(ValueT) a multiple of 8, every node size is a multiple of
+        /// 8 and values normally stay 8-byte aligned, so none are copied.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param callback Invoked as \c callback(const KeyT&, const ValueT&). Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every pair was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        /// \note The reference is valid only while \p callback runs.
+        template<typename CallbackT>
+        bool for_each_range_ref(const KeyT& from_key, const KeyT& to_key,
+                                CallbackT callback, MDBX_txn* txn = nullptr) const {
+            static_assert(is_raw_value<ValueT>::value,
+                          "for_each_range_ref requires a raw trivially copyable value type");
+            auto visit = [&callback](const KeyT& key, const MDBX_val& db_val) -> bool {
+                bool keep_going = true;
+                auto forward = [&callback, &key, &keep_going](const ValueT& value) {
+                    keep_going = callback(key, value);
+                };
+                visit_raw_value(db_val, forward);
+                return keep_going;
+            };
+            bool completed = false;
+            with_transaction([this, &from_key, &to_key, &visit, &completed](MDBX_txn* t) {
+                completed = db_for_each_range_raw(from_key, to_key, visit, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Visits every pair in an inclusive range by reference into the MDBX page.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param callback Invoked as \c callback(const KeyT&, const ValueT&). Return \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every pair was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_range_ref(const KeyT& from_key, const KeyT& to_key,
+                                CallbackT callback, const Transaction& txn) const {
+            return for_each_range_ref(from_key, to_key, callback, txn.handle());
+        }
+
+        /// \brief Visits the serialized value bytes of every pair in an inclusive range.
+        /// \details Nothing is deserialized, so a value type with an aligned
+        /// layout (e.g. \ref Embedding::view()) can be read straight from the page.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param callback Invoked as \c callback(const KeyT&, const ByteView&). Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every pair was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        /// \note The view is valid only while \p callback runs.
+        template<typename CallbackT>
+        bool for_each_range_view(const KeyT& from_key, const KeyT& to_key,
+                                 CallbackT callback, MDBX_txn* txn = nullptr) const {
+            auto visit = [&callback](const KeyT& key, const MDBX_val& db_val) -> bool {
+                return callback(key, ByteView(db_val.iov_len ? db_val.iov_base : nullptr, db_val.iov_len));
+            };
+            bool completed = false;
+            with_transaction([this, &from_key, &to_key, &visit, &completed](MDBX_txn* t) {
+                completed = db_for_each_range_raw(from_key, to_key, visit, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Visits the serialized value bytes of every pair in an inclusive range.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param callback Invoked as \c callback(const KeyT&, const ByteView&). Return \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every pair was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_range_view(const KeyT& from_key, const KeyT& to_key,
+                                 CallbackT callback, const Transaction& txn) const {
+            return for_each_range_view(from_key, to_key, callback, txn.handle());
+        }
+
         /// \brief Collects key-value pairs matching a predicate within an inclusive range.
         /// \tparam ContainerT Pair-associative container template such as \c std::map or
         /// \c std::multimap, or \c std::vector for \c std::vector<std::pair<KeyT,ValueT>>.
@@ -451,92 +926,397 @@ namespace mdbxc {
             return filter_range<ContainerT>(from_key, to_key, pred, txn.handle());
         }
 
-        // --- Bounds / edges ---
+        /// \brief Visits an inclusive range with several worker threads.
+        ///
+        /// The range is split into partitions of roughly equal size using
+        /// \c mdbx_estimate_range(), and up to \p threads workers each open one
+        /// read-only transaction and walk partitions pulled from a shared queue.
+        /// Partitioning needs integral keys whose MDBX order matches numeric
+        /// order; other key types, small ranges and \p threads <= 1 fall back to
+        /// \ref for_each_range() on the calling thread.
+        ///
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param threads Maximum number of worker threads.
+        /// \param callback Invoked as \c callback(const KeyT&, const ValueT&) from
+        ///        several threads at once; it must be thread-safe. Return \c true
+        ///        to continue, \c false to stop all workers.
+        /// \return \c true if every pair was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs; the first worker
+        ///         exception is rethrown after all workers have joined.
+        /// \note Workers read committed data only. Each worker has its own
+        /// snapshot (MDBX read transactions cannot be shared across threads), so
+        /// partitions may observe different commits if a writer commits while
+        /// workers are starting.
+        /// \note Pair order is preserved within a partition only.
+        template<typename CallbackT>
+        bool parallel_for_each_range(const KeyT& from_key, const KeyT& to_key,
+                                     std::size_t threads, CallbackT callback) const {
+            std::vector<std::pair<KeyT, KeyT>> parts;
+            if (threads > 1) {
+                with_transaction([this, &from_key, &to_key, threads, &parts](MDBX_txn* t) {
+                    parts = db_scan_partitions(from_key, to_key, threads * 4, t,
+                                               std::integral_constant<bool,
+                                                   std::is_integral<KeyT>::value &&
+                                                   !std::is_same<KeyT, bool>::value>());
+                }, TransactionMode::READ_ONLY);
+            }
+            if (parts.size() <= 1) {
+                return for_each_range(from_key, to_key, callback);
+            }
+            return run_parallel_scan(parts, std::min(threads, parts.size()), callback);
+        }
 
-#       if __cplusplus >= 201703L
+        /// \brief Scans a range, filtering on keys before any value is deserialized.
+        ///
+        /// Rows whose key fails \p key_pred are skipped without touching their
+        /// values. Matching rows are deserialized and passed to \p project until
+        /// it returns \c false or \p limit rows have been projected.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param key_pred Invoked as \c key_pred(const KeyT&); returns \c true to keep the row.
+        /// \param project Invoked as \c project(const KeyT&, const ValueT&); returns
+        ///        \c true to continue, \c false to stop.
+        /// \param limit Maximum number of projected rows.
+        /// \param txn Optional transaction handle.
+        /// \return Number of rows passed to \p project.
+        /// \throws MdbxException if a database error occurs.
+        template<typename KeyPredT, typename ProjectT>
+        std::size_t scan_range(const KeyT& from_key, const KeyT& to_key,
+                               KeyPredT key_pred, ProjectT project,
+                               std::size_t limit = no_limit, MDBX_txn* txn = nullptr) const {
+            return scan_range_view(from_key, to_key, key_pred, AcceptView(), project, limit, txn);
+        }
 
-        /// \brief Finds the first key-value pair whose key is not less than the given key.
-        /// \param key Key to bound.
+        /// \brief Scans a range, filtering on keys before any value is deserialized.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param key_pred Invoked as \c key_pred(const KeyT&); returns \c true to keep the row.
+        /// \param project Invoked as \c project(const KeyT&, const ValueT&).
+        /// \param limit Maximum number of projected rows.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of rows passed to \p project.
+        /// \throws MdbxException if a database error occurs.
+        template<typename KeyPredT, typename ProjectT>
+        std::size_t scan_range(const KeyT& from_key, const KeyT& to_key,
+                               KeyPredT key_pred, ProjectT project,
+                               std::size_t limit, const Transaction& txn) const {
+            return scan_range(from_key, to_key, key_pred, project, limit, txn.handle());
+        }
+
+        /// \brief Scans a range with key and raw-value predicates before deserializing values.
+        ///
+        /// \p view_pred sees the serialized value bytes of rows accepted by
+        /// \p key_pred, so rows can be rejected on a stored header or prefix
+        /// without materializing \c ValueT.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param key_pred Invoked as \c key_pred(const KeyT&).
+        /// \param view_pred Invoked as \c view_pred(const KeyT&, const ByteView&).
+        /// \param project Invoked as \c project(const KeyT&, const ValueT&); returns
+        ///        \c true to continue, \c false to stop.
+        /// \param limit Maximum number of projected rows.
         /// \param txn Optional transaction handle.
-        /// \return \c std::optional<value_type> with the lower-bound pair, or empty if none.
-        std::optional<value_type> lower_bound(const KeyT& key, MDBX_txn* txn = nullptr) const {
-            std::optional<value_type> result;
-            with_transaction([this, &key, &result](MDBX_txn* t) {
-                result = db_lower_bound(key, t);
+        /// \return Number of rows passed to \p project.
+        /// \throws MdbxException if a database error occurs.
+        /// \note The view points into the MDBX page and is valid only while
+        ///       \p view_pred runs.
+        template<typename KeyPredT, typename ViewPredT, typename ProjectT>
+        std::size_t scan_range_view(const KeyT& from_key, const KeyT& to_key,
+                                    KeyPredT key_pred, ViewPredT view_pred, ProjectT project,
+                                    std::size_t limit = no_limit, MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            auto sink = [&project](const KeyT& key, const MDBX_val& db_val) -> bool {
+                return project(key, deserialize_value<ValueT>(db_val));
+            };
+            with_transaction([this, &from_key, &to_key, &key_pred, &view_pred, &sink, limit, &result](MDBX_txn* t) {
+                result = db_scan_range(from_key, to_key, key_pred, view_pred, sink, limit, t);
             }, TransactionMode::READ_ONLY, txn);
             return result;
         }
 
-        /// \brief Finds the first key-value pair whose key is not less than the given key.
-        /// \param key Key to bound.
+        /// \brief Scans a range with key and raw-value predicates before deserializing values.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param key_pred Invoked as \c key_pred(const KeyT&).
+        /// \param view_pred Invoked as \c view_pred(const KeyT&, const ByteView&).
+        /// \param project Invoked as \c project(const KeyT&, const ValueT&).
+        /// \param limit Maximum number of projected rows.
         /// \param txn Active transaction wrapper.
-        /// \return \c std::optional<value_type> with the lower-bound pair, or empty if none.
-        std::optional<value_type> lower_bound(const KeyT& key, const Transaction& txn) const {
-            return lower_bound(key, txn.handle());
+        /// \return Number of rows passed to \p project.
+        /// \throws MdbxException if a database error occurs.
+        template<typename KeyPredT, typename ViewPredT, typename ProjectT>
+        std::size_t scan_range_view(const KeyT& from_key, const KeyT& to_key,
+                                    KeyPredT key_pred, ViewPredT view_pred, ProjectT project,
+                                    std::size_t limit, const Transaction& txn) const {
+            return scan_range_view(from_key, to_key, key_pred, view_pred, project, limit, txn.handle());
         }
 
-        /// \brief Finds the first key-value pair whose key is strictly greater than the given key.
-        /// \param key Key to bound.
+        /// \brief Scans keys of a range without deserializing any value.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param key_pred Invoked as \c key_pred(const KeyT&); returns \c true to keep the key.
+        /// \param project Invoked as \c project(const KeyT&); returns \c true to continue.
+        /// \param limit Maximum number of projected keys.
         /// \param txn Optional transaction handle.
-        /// \return \c std::optional<value_type> with the upper-bound pair, or empty if none.
-        std::optional<value_type> upper_bound(const KeyT& key, MDBX_txn* txn = nullptr) const {
-            std::optional<value_type> result;
-            with_transaction([this, &key, &result](MDBX_txn* t) {
-                result = db_upper_bound(key, t);
+        /// \return Number of keys passed to \p project.
+        /// \throws MdbxException if a database error occurs.
+        template<typename KeyPredT, typename ProjectT>
+        std::size_t scan_keys_range(const KeyT& from_key, const KeyT& to_key,
+                                    KeyPredT key_pred, ProjectT project,
+                                    std::size_t limit = no_limit, MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            AcceptView view_pred;
+            auto sink = [&project](const KeyT& key, const MDBX_val&) -> bool {
+                return project(key);
+            };
+            with_transaction([this, &from_key, &to_key, &key_pred, &view_pred, &sink, limit, &result](MDBX_txn* t) {
+                result = db_scan_range(from_key, to_key, key_pred, view_pred, sink, limit, t);
             }, TransactionMode::READ_ONLY, txn);
             return result;
         }
 
-        /// \brief Finds the first key-value pair whose key is strictly greater than the given key.
-        /// \param key Key to bound.
+        /// \brief Scans keys of a range without deserializing any value.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param key_pred Invoked as \c key_pred(const KeyT&).
+        /// \param project Invoked as \c project(const KeyT&).
+        /// \param limit Maximum number of projected keys.
         /// \param txn Active transaction wrapper.
-        /// \return \c std::optional<value_type> with the upper-bound pair, or empty if none.
-        std::optional<value_type> upper_bound(const KeyT& key, const Transaction& txn) const {
-            return upper_bound(key, txn.handle());
-        }
-
-        /// \brief Retrieves the pair with the smallest key.
+        /// \return Number of keys passed to \p project.
+        /// \throws MdbxException if a database error occurs.
+        template<typename KeyPredT, typename ProjectT>
+        std::size_t scan_keys_range(const KeyT& from_key, const KeyT& to_key,
+                                    KeyPredT key_pred, ProjectT project,
+                                    std::size_t limit, const Transaction& txn) const {
+            return scan_keys_range(from_key, to_key, key_pred, project, limit, txn.handle());
+        }
+
+        /// \brief Visits every pair whose key starts with \p prefix.
+        /// \details Positions with \c MDBX_SET_RANGE at \p prefix and stops at the
+        /// first key that no longer matches, so only matching keys are read.
+        /// Available for \c std::string, byte-vector and composite keys; a
+        /// composite key may also be scanned by a tuple of its leading fields.
+        /// \param prefix Key prefix; an empty prefix visits the whole table.
+        /// \param callback Invoked as \c callback(const KeyT&, const ValueT&); returns \c true to continue.
         /// \param txn Optional transaction handle.
-        /// \return \c std::optional<value_type> with the first pair, or empty if the table is empty.
-        std::optional<value_type> first(MDBX_txn* txn = nullptr) const {
-            std::optional<value_type> result;
-            with_transaction([this, &result](MDBX_txn* t) {
-                result = db_first(t);
+        /// \return \c true if the scan reached the end of the prefix, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_prefix(const KeyT& prefix, CallbackT callback, MDBX_txn* txn = nullptr) const {
+            bool completed = false;
+            with_transaction([this, &prefix, &callback, &completed](MDBX_txn* t) {
+                completed = db_for_each_prefix(prefix, callback, t);
             }, TransactionMode::READ_ONLY, txn);
-            return result;
+            return completed;
         }
 
-        /// \brief Retrieves the pair with the smallest key.
+        /// \brief Visits every pair whose key starts with \p prefix.
+        /// \param prefix Key prefix.
+        /// \param callback Invoked as \c callback(const KeyT&, const ValueT&); returns \c true to continue.
         /// \param txn Active transaction wrapper.
-        /// \return \c std::optional<value_type> with the first pair, or empty if the table is empty.
-        std::optional<value_type> first(const Transaction& txn) const {
-            return first(txn.handle());
+        /// \return \c true if the scan reached the end of the prefix, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_prefix(const KeyT& prefix, CallbackT callback, const Transaction& txn) const {
+            return for_each_prefix(prefix, callback, txn.handle());
         }
 
-        /// \brief Retrieves the pair with the largest key.
+        /// \brief Counts pairs whose key starts with \p prefix.
+        /// \param prefix Key prefix.
         /// \param txn Optional transaction handle.
-        /// \return \c std::optional<value_type> with the last pair, or empty if the table is empty.
-        std::optional<value_type> last(MDBX_txn* txn = nullptr) const {
-            std::optional<value_type> result;
-            with_transaction([this, &result](MDBX_txn* t) {
-                result = db_last(t);
+        /// \return Number of matching pairs.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t count_prefix(const KeyT& prefix, MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            with_transaction([this, &prefix, &result](MDBX_txn* t) {
+                result = db_count_prefix(prefix, t);
             }, TransactionMode::READ_ONLY, txn);
             return result;
         }
 
-        /// \brief Retrieves the pair with the largest key.
+        /// \brief Counts pairs whose key starts with \p prefix.
+        /// \param prefix Key prefix.
         /// \param txn Active transaction wrapper.
-        /// \return \c std::optional<value_type> with the last pair, or empty if the table is empty.
-        std::optional<value_type> last(const Transaction& txn) const {
-            return last(txn.handle());
+        /// \return Number of matching pairs.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t count_prefix(const KeyT& prefix, const Transaction& txn) const {
+            return count_prefix(prefix, txn.handle());
         }
 
-        /// \brief Retrieves the smallest key without deserializing the value.
+        /// \brief Removes every pair whose key starts with \p prefix.
+        /// \param prefix Key prefix; an empty prefix clears the table.
         /// \param txn Optional transaction handle.
-        /// \return \c std::optional<KeyT> with the smallest key, or empty if the table is empty.
-        std::optional<KeyT> min_key(MDBX_txn* txn = nullptr) const {
-            std::optional<KeyT> result;
-            with_transaction([this, &result](MDBX_txn* t) {
+        /// \return Number of deleted records.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t erase_prefix(const KeyT& prefix, MDBX_txn* txn = nullptr) {
+            std::size_t result = 0;
+            with_transaction([this, &prefix, &result](MDBX_txn* t) {
+                result = db_erase_prefix(prefix, t);
+            }, TransactionMode::WRITABLE, txn);
+            return result;
+        }
+
+        /// \brief Removes every pair whose key starts with \p prefix.
+        /// \param prefix Key prefix.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of deleted records.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t erase_prefix(const KeyT& prefix, const Transaction& txn) {
+            return erase_prefix(prefix, txn.handle());
+        }
+
+        /// \brief Visits every pair whose composite key starts with the fields in \p prefix.
+        /// \details \p prefix is a \c std::tuple of the leading field types of
+        /// \c KeyT, e.g. \c std::make_tuple(user_id) for a
+        /// \c std::tuple<int, std::string> key. Composite key fields are
+        /// self-delimiting, so the scan reads only matching keys.
+        /// \param prefix Leading key fields.
+        /// \param callback Invoked as \c callback(const KeyT&, const ValueT&); returns \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the scan reached the end of the prefix, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename... PrefixFieldsT, typename CallbackT>
+        typename std::enable_if<is_composite_key_prefix<std::tuple<PrefixFieldsT...>, KeyT>::value, bool>::type
+        for_each_prefix(const std::tuple<PrefixFieldsT...>& prefix, CallbackT callback,
+                        MDBX_txn* txn = nullptr) const {
+            bool completed = false;
+            with_transaction([this, &prefix, &callback, &completed](MDBX_txn* t) {
+                completed = db_for_each_prefix(prefix, callback, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Visits every pair whose composite key starts with the fields in \p prefix.
+        template<typename... PrefixFieldsT, typename CallbackT>
+        typename std::enable_if<is_composite_key_prefix<std::tuple<PrefixFieldsT...>, KeyT>::value, bool>::type
+        for_each_prefix(const std::tuple<PrefixFieldsT...>& prefix, CallbackT callback,
+                        const Transaction& txn) const {
+            return for_each_prefix(prefix, callback, txn.handle());
+        }
+
+        /// \brief Counts pairs whose composite key starts with the fields in \p prefix.
+        template<typename... PrefixFieldsT>
+        typename std::enable_if<is_composite_key_prefix<std::tuple<PrefixFieldsT...>, KeyT>::value, std::size_t>::type
+        count_prefix(const std::tuple<PrefixFieldsT...>& prefix, MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            with_transaction([this, &prefix, &result](MDBX_txn* t) {
+                result = db_count_prefix(prefix, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Counts pairs whose composite key starts with the fields in \p prefix.
+        template<typename... PrefixFieldsT>
+        typename std::enable_if<is_composite_key_prefix<std::tuple<PrefixFieldsT...>, KeyT>::value, std::size_t>::type
+        count_prefix(const std::tuple<PrefixFieldsT...>& prefix, const Transaction& txn) const {
+            return count_prefix(prefix, txn.handle());
+        }
+
+        /// \brief Removes every pair whose composite key starts with the fields in \p prefix.
+        template<typename... PrefixFieldsT>
+        typename std::enable_if<is_composite_key_prefix<std::tuple<PrefixFieldsT...>, KeyT>::value, std::size_t>::type
+        erase_prefix(const std::tuple<PrefixFieldsT...>& prefix, MDBX_txn* txn = nullptr) {
+            std::size_t result = 0;
+            with_transaction([this, &prefix, &result](MDBX_txn* t) {
+                result = db_erase_prefix(prefix, t);
+            }, TransactionMode::WRITABLE, txn);
+            return result;
+        }
+
+        /// \brief Removes every pair whose composite key starts with the fields in \p prefix.
+        template<typename... PrefixFieldsT>
+        typename std::enable_if<is_composite_key_prefix<std::tuple<PrefixFieldsT...>, KeyT>::value, std::size_t>::type
+        erase_prefix(const std::tuple<PrefixFieldsT...>& prefix, const Transaction& txn) {
+            return erase_prefix(prefix, txn.handle());
+        }
+
+        // --- Bounds / edges ---
+
+#       if __cplusplus >= 201703L
+
+        /// \brief Finds the first key-value pair whose key is not less than the given key.
+        /// \param key Key to bound.
+        /// \param txn Optional transaction handle.
+        /// \return \c std::optional<value_type> with the lower-bound pair, or empty if none.
+        std::optional<value_type> lower_bound(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            std::optional<value_type> result;
+            with_transaction([this, &key, &result](MDBX_txn* t) {
+                result = db_lower_bound(key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Finds the first key-value pair whose key is not less than the given key.
+        /// \param key Key to bound.
+        /// \param txn Active transaction wrapper.
+        /// \return \c std::optional<value_type> with the lower-bound pair, or empty if none.
+        std::optional<value_type> lower_bound(const KeyT& key, const Transaction& txn) const {
+            return lower_bound(key, txn.handle());
+        }
+
+        /// \brief Finds the first key-value pair whose key is strictly greater than the given key.
+        /// \param key Key to bound.
+        /// \param txn Optional transaction handle.
+        /// \return \c std::optional<value_type> with the upper-bound pair, or empty if none.
+        std::optional<value_type> upper_bound(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            std::optional<value_type> result;
+            with_transaction([this, &key, &result](MDBX_txn* t) {
+                result = db_upper_bound(key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Finds the first key-value pair whose key is strictly greater than the given key.
+        /// \param key Key to bound.
+        /// \param txn Active transaction wrapper.
+        /// \return \c std::optional<value_type> with the upper-bound pair, or empty if none.
+        std::optional<value_type> upper_bound(const KeyT& key, const Transaction& txn) const {
+            return upper_bound(key, txn.handle());
+        }
+
+        /// \brief Retrieves the pair with the smallest key.
+        /// \param txn Optional transaction handle.
+        /// \return \c std::optional<value_type> with the first pair, or empty if the table is empty.
+        std::optional<value_type> first(MDBX_txn* txn = nullptr) const {
+            std::optional<value_type> result;
+            with_transaction([this, &result](MDBX_txn* t) {
+                result = db_first(t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Retrieves the pair with the smallest key.
+        /// \param txn Active transaction wrapper.
+        /// \return \c std::optional<value_type> with the first pair, or empty if the table is empty.
+        std::optional<value_type> first(const Transaction& txn) const {
+            return first(txn.handle());
+        }
+
+        /// \brief Retrieves the pair with the largest key.
+        /// \param txn Optional transaction handle.
+        /// \return \c std::optional<value_type> with the last pair, or empty if the table is empty.
+        std::optional<value_type> last(MDBX_txn* txn = nullptr) const {
+            std::optional<value_type> result;
+            with_transaction([this, &result](MDBX_txn* t) {
+                result = db_last(t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Retrieves the pair with the largest key.
+        /// \param txn Active transaction wrapper.
+        /// \return \c std::optional<value_type> with the last pair, or empty if the table is empty.
+        std::optional<value_type> last(const Transaction& txn) const {
+            return last(txn.handle());
+        }
+
+        /// \brief Retrieves the smallest key without deserializing the value.
+        /// \param txn Optional transaction handle.
+        /// \return \c std::optional<KeyT> with the smallest key, or empty if the table is empty.
+        std::optional<KeyT> min_key(MDBX_txn* txn = nullptr) const {
+            std::optional<KeyT> result;
+            with_transaction([this, &result](MDBX_txn* t) {
                 result = db_min_key(t);
             }, TransactionMode::READ_ONLY, txn);
             return result;
@@ -881,6 +1661,62 @@ namespace mdbxc {
             return count_range(from_key, to_key, txn.handle());
         }
 
+        /// \brief Estimates the number of key-value pairs within an inclusive range.
+        /// \details O(log n): uses \c mdbx_estimate_range() instead of walking the
+        /// range, so the result is approximate. Use \ref count_range() for an exact count.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Optional transaction handle.
+        /// \return Estimated number of key-value pairs in the requested range.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t estimate_count_range(const KeyT& from_key, const KeyT& to_key,
+                                         MDBX_txn* txn = nullptr) const {
+            std::size_t result = 0;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = db_estimate_count_range(from_key, to_key, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Estimates the number of key-value pairs within an inclusive range.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Active transaction wrapper.
+        /// \return Estimated number of key-value pairs in the requested range.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t estimate_count_range(const KeyT& from_key, const KeyT& to_key,
+                                         const Transaction& txn) const {
+            return estimate_count_range(from_key, to_key, txn.handle());
+        }
+
+        /// \brief Estimates the storage size of key-value pairs within an inclusive range.
+        /// \details Scales \ref estimate_count_range() by the average per-entry page
+        /// footprint reported by \c mdbx_dbi_stat(), including page overhead.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Optional transaction handle.
+        /// \return Estimated size in bytes.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t estimate_bytes_range(const KeyT& from_key, const KeyT& to_key,
+                                           MDBX_txn* txn = nullptr) const {
+            std::uint64_t result = 0;
+            with_transaction([this, &from_key, &to_key, &result](MDBX_txn* t) {
+                result = estimate_range_bytes(t, db_estimate_count_range(from_key, to_key, t));
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Estimates the storage size of key-value pairs within an inclusive range.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param txn Active transaction wrapper.
+        /// \return Estimated size in bytes.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t estimate_bytes_range(const KeyT& from_key, const KeyT& to_key,
+                                           const Transaction& txn) const {
+            return estimate_bytes_range(from_key, to_key, txn.handle());
+        }
+
         /// \brief Removes all key-value pairs within an inclusive range.
         /// \param from_key Start key in MDBX key order.
         /// \param to_key End key in MDBX key order.
@@ -907,6 +1743,38 @@ namespace mdbxc {
             return erase_range(from_key, to_key, txn.handle());
         }
 
+        /// \brief Removes all key-value pairs within an inclusive range, committing every \p chunk_size deletions.
+        /// \details Each chunk runs in its own write transaction, so a large purge
+        /// releases the writer lock and flushes its dirty pages between chunks.
+        /// Other writers may interleave; each chunk resumes at the first key still
+        /// present in the range. Already committed chunks stay deleted if a later
+        /// chunk fails.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \param chunk_size Maximum deletions per write transaction.
+        /// \return Total number of deleted records.
+        /// \throws std::invalid_argument if \p chunk_size is zero.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t erase_range_chunked(const KeyT& from_key, const KeyT& to_key,
+                                        std::size_t chunk_size) {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("erase_range_chunked: chunk_size must be positive");
+            }
+            if (thread_txn()) {
+                throw std::logic_error("erase_range_chunked: transaction already started for this thread.");
+            }
+            std::size_t total = 0;
+            for (;;) {
+                std::size_t removed = 0;
+                with_transaction([this, &from_key, &to_key, chunk_size, &removed](MDBX_txn* t) {
+                    removed = db_erase_range(from_key, to_key, t, chunk_size);
+                }, TransactionMode::WRITABLE);
+                total += removed;
+                if (removed < chunk_size) return total;
+            }
+        }
+
         /// \brief Appends data to the database.
         /// \tparam ContainerT Container type (e.g., std::map or std::unordered_map).
         /// \param container Container with content to be synchronized.
@@ -952,6 +1820,69 @@ namespace mdbxc {
             append(container, txn.handle());
         }
 
+        /// \brief Upserts pairs sorted in MDBX key order using \c MDBX_APPEND.
+        /// \tparam ContainerT Pair-associative container template iterated in key order.
+        /// \param container Source pairs; keys must be ascending in MDBX key order and
+        /// greater than the last key already stored in the table.
+        /// \param mode Reaction to out-of-order keys.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every pair was written through the append fast path,
+        /// \c false if \ref BulkLoadMode::Fallback switched to regular upserts.
+        /// \throws MdbxException with \c MDBX_EKEYMISMATCH in \ref BulkLoadMode::Strict
+        /// when a key is out of order, or on other database errors.
+        /// \note Pairs written before a strict-mode failure stay in \p txn; an
+        /// automatic transaction is rolled back.
+        template<template <class...> class ContainerT>
+        bool bulk_load_sorted(const ContainerT<KeyT, ValueT>& container,
+                              BulkLoadMode mode = BulkLoadMode::Fallback,
+                              MDBX_txn* txn = nullptr) {
+            bool appended = false;
+            with_transaction([this, &container, mode, &appended](MDBX_txn* t) {
+                appended = db_bulk_load_sorted(container, mode, t);
+            }, TransactionMode::WRITABLE, txn);
+            return appended;
+        }
+
+        /// \brief Upserts pairs sorted in MDBX key order using \c MDBX_APPEND.
+        /// \tparam ContainerT Pair-associative container template iterated in key order.
+        /// \param container Source pairs in ascending key order.
+        /// \param mode Reaction to out-of-order keys.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every pair used the append fast path.
+        /// \throws MdbxException if a key is out of order in strict mode or a database error occurs.
+        template<template <class...> class ContainerT>
+        bool bulk_load_sorted(const ContainerT<KeyT, ValueT>& container,
+                              BulkLoadMode mode, const Transaction& txn) {
+            return bulk_load_sorted(container, mode, txn.handle());
+        }
+
+        /// \brief Upserts a pre-sorted vector of pairs using \c MDBX_APPEND.
+        /// \param container Source pairs in ascending MDBX key order.
+        /// \param mode Reaction to out-of-order keys.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every pair used the append fast path.
+        /// \throws MdbxException if a key is out of order in strict mode or a database error occurs.
+        bool bulk_load_sorted(const std::vector<std::pair<KeyT, ValueT>>& container,
+                              BulkLoadMode mode = BulkLoadMode::Fallback,
+                              MDBX_txn* txn = nullptr) {
+            bool appended = false;
+            with_transaction([this, &container, mode, &appended](MDBX_txn* t) {
+                appended = db_bulk_load_sorted(container, mode, t);
+            }, TransactionMode::WRITABLE, txn);
+            return appended;
+        }
+
+        /// \brief Upserts a pre-sorted vector of pairs using \c MDBX_APPEND.
+        /// \param container Source pairs in ascending MDBX key order.
+        /// \param mode Reaction to out-of-order keys.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every pair used the append fast path.
+        /// \throws MdbxException if a key is out of order in strict mode or a database error occurs.
+        bool bulk_load_sorted(const std::vector<std::pair<KeyT, ValueT>>& container,
+                              BulkLoadMode mode, const Transaction& txn) {
+            return bulk_load_sorted(container, mode, txn.handle());
+        }
+
         /// \brief Reconciles the database with the container.
         /// \tparam ContainerT Container type (e.g., std::map or std::unordered_map).
         /// \param container Container to be reconciled with the database.
@@ -998,6 +1929,66 @@ namespace mdbxc {
             reconcile(container, txn.handle());
         }
 
+        /// \brief Reconciles the table with a sorted input stream in bounded write chunks.
+        ///
+        /// Merge-joins key-value pairs from [\p first, \p last) with the table in MDBX
+        /// key order: keys absent from the input are
+        /// erased, new keys are inserted, and existing keys are rewritten only when
+        /// their serialized value differs.
+        /// A write transaction is committed every \p chunk_size changes and
+        /// \p progress is called after each commit, so memory use is independent
+        /// of the table and input sizes.
+        /// \tparam InputIt Single-pass iterator over key-value pairs in strictly ascending MDBX key order.
+        /// \tparam ProgressT Callable invoked as \c progress(const ReconcileProgress&).
+        /// \param first Start of the sorted input.
+        /// \param last End of the sorted input.
+        /// \param chunk_size Maximum changes per write transaction.
+        /// \param progress Receives cumulative counters after every committed chunk.
+        /// \return Final counters.
+        /// \throws std::invalid_argument if \p chunk_size is zero or input keys are not
+        ///         strictly ascending; chunks committed before the error remain applied.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        /// \throws MdbxException if a database error occurs.
+        /// \note Unlike \ref reconcile(), the result is not atomic: readers and other
+        /// writers may observe or modify the table between chunks.
+        template<typename InputIt, typename ProgressT>
+        ReconcileProgress reconcile_sorted(InputIt first, InputIt last,
+                                           std::size_t chunk_size, ProgressT progress) {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("reconcile_sorted: chunk_size must be positive");
+            }
+            if (thread_txn()) {
+                throw std::logic_error("reconcile_sorted: transaction already started for this thread.");
+            }
+            SerializeScratch sc_key;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
+            SortedPairEncoder encode(sc_key, sc_value.get());
+            detail::SortedReconcileState state;
+            ReconcileProgress stats;
+            bool done = false;
+            while (!done) {
+                with_transaction([this, &done, &first, &last, chunk_size, &encode, &state, &stats](MDBX_txn* t) {
+                    done = db_reconcile_sorted_chunk(t, first, last, chunk_size, encode, state, stats);
+                }, TransactionMode::WRITABLE);
+                ++stats.chunks;
+                progress(static_cast<const ReconcileProgress&>(stats));
+            }
+            return stats;
+        }
+
+        /// \brief Reconciles the table with a sorted input stream in bounded write chunks.
+        /// \param first Start of the sorted input.
+        /// \param last End of the sorted input.
+        /// \param chunk_size Maximum changes per write transaction.
+        /// \return Final counters.
+        /// \throws std::invalid_argument if \p chunk_size is zero or input is not strictly ascending.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        /// \throws MdbxException if a database error occurs.
+        template<typename InputIt>
+        ReconcileProgress reconcile_sorted(InputIt first, InputIt last, std::size_t chunk_size) {
+            return reconcile_sorted(first, last, chunk_size, detail::NoReconcileProgress());
+        }
+
         /// \brief Inserts key-value only if key is absent.
         /// \param key The key to be inserted.
         /// \param value The value to be inserted.
@@ -1005,11 +1996,10 @@ namespace mdbxc {
         /// \return \c true if the pair was inserted, \c false when the key already exists.
         /// \throws MdbxException if a database error occurs.
         bool insert(const KeyT &key, const ValueT &value, MDBX_txn* txn = nullptr) {
-            bool res;
-            with_transaction([this, &key, &value, &res](MDBX_txn* txn) {
-                res = db_insert_if_absent(key, value, txn);
-            }, TransactionMode::WRITABLE, txn);
-            return res;
+            const Status status = insert_status(key, value, txn);
+            if (status.code() == StatusCode::KeyExists) return false;
+            check_status(status);
+            return true;
         }
         
         /// \brief Inserts key-value only if key is absent.
@@ -1028,11 +2018,7 @@ namespace mdbxc {
         /// \return \c true if the pair was inserted, \c false when the key already exists.
         /// \throws MdbxException if a database error occurs.
         bool insert(const std::pair<KeyT, ValueT> &pair, MDBX_txn* txn = nullptr) {
-            bool res;
-            with_transaction([this, &pair, &res](MDBX_txn* txn) {
-                res = db_insert_if_absent(pair.first, pair.second, txn);
-            }, TransactionMode::WRITABLE, txn);
-            return res;
+            return insert(pair.first, pair.second, txn);
         }
         
         /// \brief Inserts key-value only if key is absent.
@@ -1043,6 +2029,30 @@ namespace mdbxc {
         bool insert(const std::pair<KeyT, ValueT> &pair, const Transaction& txn) {
             return insert(pair, txn.handle());
         }
+
+        /// \brief Inserts key-value only if key is absent, without throwing.
+        /// \param key The key to be inserted.
+        /// \param value The value to be inserted.
+        /// \param txn Active MDBX transaction.
+        /// \return Ok if inserted, \c StatusCode::KeyExists when the key already
+        ///         exists, otherwise the error that the throwing overload would raise.
+        ///         MDBX errors, e.g. \c StatusCode::Busy, are returned without unwinding.
+        Status insert(std::nothrow_t, const KeyT &key, const ValueT &value, MDBX_txn* txn = nullptr) noexcept {
+            try {
+                return insert_status(key, value, txn);
+            } catch (...) {
+                return Status::from_current_exception();
+            }
+        }
+
+        /// \brief Inserts key-value only if key is absent, without throwing.
+        /// \param key The key to be inserted.
+        /// \param value The value to be inserted.
+        /// \param txn Transaction wrapper used for the insertion.
+        /// \return Same as the \c MDBX_txn* overload.
+        Status insert(std::nothrow_t, const KeyT &key, const ValueT &value, const Transaction& txn) noexcept {
+            return insert(std::nothrow, key, value, txn.handle());
+        }
         
         /// \brief Inserts or replaces key-value pair.
         /// \param key The key to be inserted.
@@ -1113,11 +2123,10 @@ namespace mdbxc {
         /// \return True if key exists, false otherwise.
         /// \throws MdbxException if DB error occurs.
         bool try_get(const KeyT& key, ValueT& out, MDBX_txn* txn) const {
-            bool res;
-            with_transaction([this, &key, &out, &res](MDBX_txn* txn) {
-                res = db_get(key, out, txn);
-            }, TransactionMode::READ_ONLY, txn);
-            return res;
+            const Status status = get_status(key, out, txn);
+            if (status.code() == StatusCode::NotFound) return false;
+            check_status(status);
+            return true;
         }
         
         /// \brief Tries to find value by key.
@@ -1207,6 +2216,96 @@ namespace mdbxc {
             return find_compat(key, txn.handle());
         }
 
+        /// \brief Finds value by key without throwing.
+        /// \param key Key to search for.
+        /// \param txn Optional active MDBX transaction.
+        /// \return The value, \c StatusCode::NotFound when the key is absent,
+        ///         otherwise the error that the throwing overload would raise.
+        ///         MDBX errors, e.g. \c StatusCode::Busy, are returned without unwinding.
+        Result<ValueT> find(std::nothrow_t, const KeyT& key, MDBX_txn* txn = nullptr) const noexcept {
+            try {
+                ValueT value;
+                const Status status = get_status(key, value, txn);
+                if (!status) {
+                    return Result<ValueT>(status);
+                }
+                return Result<ValueT>(std::move(value));
+            } catch (...) {
+                return Result<ValueT>(Status::from_current_exception());
+            }
+        }
+
+        /// \brief Finds value by key without throwing.
+        /// \param key Key to search for.
+        /// \param txn Transaction wrapper used for the lookup.
+        /// \return Same as the \c MDBX_txn* overload.
+        Result<ValueT> find(std::nothrow_t, const KeyT& key, const Transaction& txn) const noexcept {
+            return find(std::nothrow, key, txn.handle());
+        }
+
+        /// \brief Visits the stored value bytes for a key without deserializing them.
+        /// \tparam VisitorT Callable invoked as \c visitor(const ByteView&).
+        /// \param key Key to look up.
+        /// \param visitor Receives a view over the serialized value bytes.
+        /// \param txn Optional active MDBX transaction.
+        /// \return \c true if the key exists and \p visitor was invoked, \c false otherwise.
+        /// \throws MdbxException on DB error.
+        /// \note The view points into the MDBX page and is valid only while
+        ///       \p visitor runs. Copy any bytes that must outlive the call.
+        template<typename VisitorT>
+        bool find_view(const KeyT& key, VisitorT visitor, MDBX_txn* txn = nullptr) const {
+            bool found = false;
+            with_transaction([this, &key, &visitor, &found](MDBX_txn* txn) {
+                found = db_find_view(key, visitor, txn);
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Visits the stored value bytes for a key without deserializing them.
+        /// \tparam VisitorT Callable invoked as \c visitor(const ByteView&).
+        /// \param key Key to look up.
+        /// \param visitor Receives a view over the serialized value bytes.
+        /// \param txn Transaction wrapper used for the lookup.
+        /// \return \c true if the key exists and \p visitor was invoked, \c false otherwise.
+        /// \throws MdbxException on DB error.
+        template<typename VisitorT>
+        bool find_view(const KeyT& key, VisitorT visitor, const Transaction& txn) const {
+            return find_view(key, visitor, txn.handle());
+        }
+
+        /// \brief Visits the stored value for a key by reference into the MDBX page.
+        /// \details Same alignment rules as \ref for_each_range_ref().
+        /// \tparam VisitorT Callable invoked as \c visitor(const ValueT&).
+        /// \param key Key to look up.
+        /// \param visitor Receives the stored value.
+        /// \param txn Optional active MDBX transaction.
+        /// \return \c true if the key exists and \p visitor was invoked, \c false otherwise.
+        /// \throws MdbxException on DB error.
+        /// \note The reference is valid only while \p visitor runs.
+        template<typename VisitorT>
+        bool find_ref(const KeyT& key, VisitorT visitor, MDBX_txn* txn = nullptr) const {
+            static_assert(is_raw_value<ValueT>::value,
+                          "find_ref requires a raw trivially copyable value type");
+            return find_view(key, [&visitor](const ByteView& view) {
+                MDBX_val db_val;
+                db_val.iov_base = const_cast<void*>(view.data);
+                db_val.iov_len = view.size;
+                visit_raw_value(db_val, visitor);
+            }, txn);
+        }
+
+        /// \brief Visits the stored value for a key by reference into the MDBX page.
+        /// \tparam VisitorT Callable invoked as \c visitor(const ValueT&).
+        /// \param key Key to look up.
+        /// \param visitor Receives the stored value.
+        /// \param txn Transaction wrapper used for the lookup.
+        /// \return \c true if the key exists and \p visitor was invoked, \c false otherwise.
+        /// \throws MdbxException on DB error.
+        template<typename VisitorT>
+        bool find_ref(const KeyT& key, VisitorT visitor, const Transaction& txn) const {
+            return find_ref(key, visitor, txn.handle());
+        }
+
         /// \brief Updates an existing value by calling a mutator function.
         /// \param key Key to update.
         /// \param fn Mutator function invoked as \c fn(ValueT&).
@@ -1237,21 +2336,117 @@ namespace mdbxc {
             return update(key, fn, txn.handle());
         }
 
-        /// \brief Looks up multiple keys and returns found pairs in a map.
-        /// \param keys Vector of keys to search.
+        /// \brief Patches the serialized bytes of an existing value in place.
+        /// \param key Key to update.
+        /// \param fn Mutator invoked as \c fn(MutableByteView&) on the stored bytes.
         /// \param txn Optional transaction handle.
-        /// \return \c std::map with found keys and their values. Missing keys are omitted.
+        /// \return \c true if the key existed and was patched, \c false if the key was missing.
         /// \throws MdbxException if a database error occurs.
-        std::map<KeyT, ValueT> find_many(const std::vector<KeyT>& keys,
-                                         MDBX_txn* txn = nullptr) const {
-            std::map<KeyT, ValueT> result;
-            with_transaction([this, &keys, &result](MDBX_txn* t) {
-                db_find_many(keys, result, t);
-            }, TransactionMode::READ_ONLY, txn);
+        /// \details Unlike update(), the value is neither deserialized nor
+        /// serialized: \c fn edits the bytes on the dirty page of the write
+        /// transaction, which is the mapped page itself in
+        /// \ref Config::writemap_mode. The value size cannot change, so this suits
+        /// fixed offsets such as counters inside trivially copyable structs or
+        /// \c write_bytes() layouts.
+        /// \note If \c fn throws after writing, the partial patch is kept until the
+        /// transaction is rolled back; an internally created transaction is.
+        template<typename Fn>
+        bool update_bytes(const KeyT& key, Fn fn, MDBX_txn* txn = nullptr) {
+            bool result = false;
+            with_transaction([this, &key, &fn, &result](MDBX_txn* t) {
+                result = db_update_bytes(key, fn, t);
+            }, TransactionMode::WRITABLE, txn);
             return result;
         }
 
-        /// \brief Looks up multiple keys and returns found pairs in a map.
+        /// \brief Patches the serialized bytes of an existing value in place using an external transaction.
+        /// \param key Key to update.
+        /// \param fn Mutator invoked as \c fn(MutableByteView&) on the stored bytes.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the key existed and was patched, \c false if the key was missing.
+        /// \throws MdbxException if a database error occurs.
+        template<typename Fn>
+        bool update_bytes(const KeyT& key, Fn fn, const Transaction& txn) {
+            return update_bytes(key, fn, txn.handle());
+        }
+
+        /// \brief Skips writes that would store the value already present.
+        /// \details When enabled, \ref insert_or_assign(), \ref append() and
+        /// the upsert half of \ref reconcile() serialize the value, position a
+        /// cursor on the key and compare the stored bytes first. Equal bytes
+        /// leave the table untouched: no page is dirtied, no secondary index is
+        /// updated and, with sync capture, no \c Put op reaches the changelog.
+        /// Other values are written through the same cursor. Off by default,
+        /// because the comparison costs a lookup that plain upserts avoid.
+        /// \param enabled \c true to compare before writing.
+        /// \warning Lifecycle-only. Do not call concurrently with writes.
+        void set_suppress_unchanged(bool enabled) noexcept {
+            m_suppress_unchanged = enabled;
+        }
+
+        /// \brief Checks whether \ref set_suppress_unchanged() is enabled.
+        bool suppress_unchanged() const noexcept { return m_suppress_unchanged; }
+
+        /// \brief Registers the merge operator used by \ref merge().
+        /// \param kind \c AddInteger, \c Max or \c Min for integer values;
+        ///        \c Append or \c SetUnion for vectors, deques or lists of
+        ///        integers; \c SetUnion for sets; \c Append for strings.
+        /// \throws std::invalid_argument if \p kind does not fit \p ValueT.
+        /// \warning Lifecycle-only. Do not call concurrently with \ref merge().
+        void set_merge_operator(MergeKind kind) {
+            m_merge_operator = make_merge_operator<ValueT>(kind);
+            m_has_merge_operator = true;
+        }
+
+        /// \brief Checks whether \ref set_merge_operator() was called.
+        bool has_merge_operator() const noexcept { return m_has_merge_operator; }
+
+        /// \brief Combines \p operand with the stored value of \p key.
+        /// \details Positions one cursor on the key, merges the stored bytes
+        /// with the serialized operand and writes the result in place, so the
+        /// value is never deserialized. An absent key stores the operand.
+        /// With sync capture the operand is replicated as a merge op instead
+        /// of the full value, and replicas apply it to their own value.
+        /// \param key Key to merge into.
+        /// \param operand Value combined by the registered operator.
+        /// \param txn Optional active MDBX transaction.
+        /// \throws std::logic_error if no merge operator is registered.
+        /// \throws std::invalid_argument if the stored value does not fit the operator.
+        /// \throws MdbxException if a database error occurs.
+        void merge(const KeyT& key, const ValueT& operand, MDBX_txn* txn = nullptr) {
+            if (!m_has_merge_operator) {
+                throw std::logic_error("KeyValueTable::merge requires set_merge_operator()");
+            }
+            with_transaction([this, &key, &operand](MDBX_txn* t) {
+                db_merge(key, operand, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Combines \p operand with the stored value of \p key.
+        /// \param key Key to merge into.
+        /// \param operand Value combined by the registered operator.
+        /// \param txn Active transaction wrapper.
+        /// \throws std::logic_error if no merge operator is registered.
+        /// \throws MdbxException if a database error occurs.
+        void merge(const KeyT& key, const ValueT& operand, const Transaction& txn) {
+            merge(key, operand, txn.handle());
+        }
+
+        /// \brief Looks up multiple keys and returns found pairs in a map.
+        /// \param keys Vector of keys to search.
+        /// \param txn Optional transaction handle.
+        /// \return \c std::map with found keys and their values. Missing keys are omitted.
+        /// \throws MdbxException if a database error occurs.
+        std::map<KeyT, ValueT> find_many(const std::vector<KeyT>& keys,
+                                         MDBX_txn* txn = nullptr) const {
+            std::map<KeyT, ValueT> result;
+            with_transaction([this, &keys, &result](MDBX_txn* t) {
+                db_find_many(keys, result, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Looks up multiple keys and returns found pairs in a map.
         /// \param keys Vector of keys to search.
         /// \param txn Active transaction wrapper.
         /// \return \c std::map with found keys and their values. Missing keys are omitted.
@@ -1261,6 +2456,45 @@ namespace mdbxc {
             return find_many(keys, txn.handle());
         }
 
+        /// \brief Looks up multiple keys and appends the found pairs to a caller container.
+        /// \details Accepts the same containers as \ref range_into(); found
+        /// pairs are added in input order and missing keys are skipped.
+        /// \param keys Vector of keys to search.
+        /// \param out Container receiving the found pairs.
+        /// \param txn Optional transaction handle.
+        /// \return Number of keys found.
+        /// \throws MdbxException if a database error occurs.
+        template<class OutT>
+        std::size_t find_many_into(const std::vector<KeyT>& keys, OutT& out,
+                                   MDBX_txn* txn = nullptr) const {
+            std::size_t found = 0;
+            with_transaction([this, &keys, &out, &found](MDBX_txn* t) {
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    SerializeScratch sc_key;
+                    MDBX_val db_key = serialize_key<Options::safe_integer_key>(keys[i], sc_key);
+                    MDBX_val db_val;
+                    const int rc = mdbx_get(t, m_dbi, &db_key, &db_val);
+                    if (rc == MDBX_NOTFOUND) continue;
+                    check_mdbx(rc, "Failed to retrieve value");
+                    detail::emplace_result(out, keys[i], detail::result_arg<ValueT>::value(db_val));
+                    ++found;
+                }
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Looks up multiple keys and appends the found pairs to a caller container.
+        /// \param keys Vector of keys to search.
+        /// \param out Container receiving the found pairs.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of keys found.
+        /// \throws MdbxException if a database error occurs.
+        template<class OutT>
+        std::size_t find_many_into(const std::vector<KeyT>& keys, OutT& out,
+                                   const Transaction& txn) const {
+            return find_many_into(keys, out, txn.handle());
+        }
+
         /// \brief Looks up multiple keys and returns found pairs in input order.
         /// \param keys Vector of keys to search.
         /// \param txn Optional transaction handle.
@@ -1285,6 +2519,80 @@ namespace mdbxc {
             return find_many_vector(keys, txn.handle());
         }
 
+#       if __cplusplus >= 201703L
+
+        /// \brief Looks up multiple keys with one forward cursor walk.
+        /// \details Serialized keys are sorted in MDBX key order and resolved by a
+        /// single cursor that steps with \c MDBX_NEXT when the next key is adjacent
+        /// and re-seeks with \c MDBX_SET_RANGE otherwise, which saves B-tree
+        /// descents for clustered keys. Duplicate input keys are looked up once.
+        /// \param keys Keys to search.
+        /// \param out Output resized to \c keys.size(); slot \c i holds the value
+        /// of \c keys[i] or \c std::nullopt when it is missing.
+        /// \param txn Optional transaction handle.
+        /// \return Number of input keys that were found.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t find_many_batch(const std::vector<KeyT>& keys,
+                                    std::vector<std::optional<ValueT>>& out,
+                                    MDBX_txn* txn = nullptr) const {
+            out.assign(keys.size(), std::nullopt);
+            std::size_t found = 0;
+            with_transaction([this, &keys, &out, &found](MDBX_txn* t) {
+                found = db_find_many_batch(keys, [&out](std::size_t index, const MDBX_val& db_val) {
+                    out[index] = deserialize_value<ValueT>(db_val);
+                }, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Looks up multiple keys with one forward cursor walk.
+        /// \param keys Keys to search.
+        /// \param out Output aligned with \c keys; missing keys are \c std::nullopt.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of input keys that were found.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t find_many_batch(const std::vector<KeyT>& keys,
+                                    std::vector<std::optional<ValueT>>& out,
+                                    const Transaction& txn) const {
+            return find_many_batch(keys, out, txn.handle());
+        }
+
+#       endif // __cplusplus >= 201703L
+
+        /// \brief Looks up multiple keys with one forward cursor walk (C++11 form).
+        /// \details Same lookup strategy as \c find_many_batch().
+        /// \param keys Keys to search.
+        /// \param out Output resized to \c keys.size(); slot \c i is
+        /// \c {true, value} for a found key and \c {false, ValueT()} otherwise.
+        /// \param txn Optional transaction handle.
+        /// \return Number of input keys that were found.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t find_many_batch_compat(const std::vector<KeyT>& keys,
+                                           std::vector<std::pair<bool, ValueT> >& out,
+                                           MDBX_txn* txn = nullptr) const {
+            out.assign(keys.size(), std::pair<bool, ValueT>(false, ValueT()));
+            std::size_t found = 0;
+            with_transaction([this, &keys, &out, &found](MDBX_txn* t) {
+                found = db_find_many_batch(keys, [&out](std::size_t index, const MDBX_val& db_val) {
+                    out[index].first = true;
+                    out[index].second = deserialize_value<ValueT>(db_val);
+                }, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return found;
+        }
+
+        /// \brief Looks up multiple keys with one forward cursor walk (C++11 form).
+        /// \param keys Keys to search.
+        /// \param out Output aligned with \c keys.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of input keys that were found.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t find_many_batch_compat(const std::vector<KeyT>& keys,
+                                           std::vector<std::pair<bool, ValueT> >& out,
+                                           const Transaction& txn) const {
+            return find_many_batch_compat(keys, out, txn.handle());
+        }
+
         /// \brief Checks whether a key exists in the database.
         /// \param key The key to look up.
         /// \param txn Active transaction.
@@ -1353,11 +2661,10 @@ namespace mdbxc {
         /// \return True if the key was found and deleted, false if the key was not found.
         /// \throws MdbxException if deletion fails.
         bool erase(const KeyT &key, MDBX_txn* txn = nullptr) {
-            bool res;
-            with_transaction([this, &key, &res](MDBX_txn* txn) {
-                res = db_erase(key, txn);
-            }, TransactionMode::WRITABLE, txn);
-            return res;
+            const Status status = erase_status(key, txn);
+            if (status.code() == StatusCode::NotFound) return false;
+            check_status(status);
+            return true;
         }
         
         /// \brief Removes key from DB.
@@ -1369,6 +2676,28 @@ namespace mdbxc {
             return erase(key, txn.handle());
         }
 
+        /// \brief Removes key from DB without throwing.
+        /// \param key The key of the pair to be removed.
+        /// \param txn Active transaction.
+        /// \return Ok if deleted, \c StatusCode::NotFound when the key was absent,
+        ///         otherwise the error that the throwing overload would raise.
+        ///         MDBX errors, e.g. \c StatusCode::Busy, are returned without unwinding.
+        Status erase(std::nothrow_t, const KeyT &key, MDBX_txn* txn = nullptr) noexcept {
+            try {
+                return erase_status(key, txn);
+            } catch (...) {
+                return Status::from_current_exception();
+            }
+        }
+
+        /// \brief Removes key from DB without throwing.
+        /// \param key The key of the pair to be removed.
+        /// \param txn Transaction wrapper used for the operation.
+        /// \return Same as the \c MDBX_txn* overload.
+        Status erase(std::nothrow_t, const KeyT &key, const Transaction& txn) noexcept {
+            return erase(std::nothrow, key, txn.handle());
+        }
+
         /// \brief Clears all key-value pairs from the database.
         /// \param txn Active transaction.
         /// \throws MdbxException if a database error occurs.
@@ -1385,8 +2714,422 @@ namespace mdbxc {
             clear(txn.handle());
         }
 
+        // --- Secondary indexes ---
+
+        /// \brief Attaches a secondary index kept up to date by every write of this table.
+        /// \details Index entries live in the \c MDBX_DUPSORT table
+        /// <tt>name + "__index_" + index_name</tt>: the key is
+        /// \c extractor(value), the duplicates are the primary keys. They change
+        /// in the same transaction as the records, so readers never see an index
+        /// that disagrees with the table. Writes that replace or delete a record
+        /// read its previous value once to drop the old entry; tables without
+        /// indexes skip that read. If the index table is empty while this table
+        /// is not, it is filled from the existing records.
+        /// \tparam IndexKeyT Index key type; any type supported as a table key.
+        /// \param index_name Name passed to the query helpers.
+        /// \param extractor Invoked as \c extractor(const ValueT&); returns \c IndexKeyT.
+        /// \throws std::invalid_argument if an index named \p index_name is already attached.
+        /// \throws MdbxException if a database error occurs.
+        /// \note Attach indexes before the table is shared between threads, and
+        /// attach the same indexes to every wrapper that writes this table;
+        /// writes through a wrapper without them leave the index stale until
+        /// \ref rebuild_index(). Index tables are not captured by sync, so
+        /// replicas rebuild them after applying changes.
+        template<class IndexKeyT, typename ExtractorT>
+        void add_index(const std::string& index_name, ExtractorT extractor) {
+            for (std::size_t i = 0; i < m_indexes.size(); ++i) {
+                if (m_indexes[i]->name() == index_name) {
+                    throw std::invalid_argument(
+                        "KeyValueTable: index '" + index_name + "' is already attached");
+                }
+            }
+            const MDBX_db_flags_t dup_flags = (get_mdbx_flags<KeyT>() & MDBX_INTEGERKEY)
+                ? static_cast<MDBX_db_flags_t>(MDBX_DUPFIXED | MDBX_INTEGERDUP)
+                : static_cast<MDBX_db_flags_t>(0);
+            const MDBX_dbi dbi = m_connection->open_dbi(
+                m_name + "__index_" + index_name,
+                static_cast<MDBX_db_flags_t>(MDBX_CREATE | MDBX_DUPSORT | dup_flags |
+                                             get_mdbx_flags<IndexKeyT>()));
+            std::shared_ptr<const detail::SecondaryIndex<ValueT>> index =
+                std::make_shared<detail::ExtractorIndex<ValueT, IndexKeyT, Options, ExtractorT>>(
+                    index_name, dbi, std::move(extractor));
+            if (!m_connection->is_read_only()) {
+                with_transaction([this, &index](MDBX_txn* t) {
+                    if (db_count(t) != 0 && db_index_entries(*index, t) == 0) {
+                        db_fill_index(*index, t);
+                    }
+                }, TransactionMode::WRITABLE);
+            }
+            m_indexes.push_back(index);
+        }
+
+        /// \brief Checks whether an index is attached to this wrapper.
+        /// \param index_name Index name passed to \ref add_index().
+        bool has_index(const std::string& index_name) const {
+            for (std::size_t i = 0; i < m_indexes.size(); ++i) {
+                if (m_indexes[i]->name() == index_name) return true;
+            }
+            return false;
+        }
+
+        /// \brief Recreates the entries of an index from the records.
+        /// \param index_name Index name passed to \ref add_index().
+        /// \param txn Optional transaction handle.
+        /// \throws std::invalid_argument if no such index is attached.
+        /// \throws MdbxException if a database error occurs.
+        void rebuild_index(const std::string& index_name, MDBX_txn* txn = nullptr) {
+            const detail::SecondaryIndex<ValueT>& index = find_index(index_name);
+            with_transaction([this, &index](MDBX_txn* t) {
+                check_mdbx(mdbx_drop(t, index.dbi(), 0), "Failed to clear secondary index");
+                db_fill_index(index, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Recreates the entries of an index from the records.
+        /// \param index_name Index name passed to \ref add_index().
+        /// \param txn Active transaction wrapper.
+        void rebuild_index(const std::string& index_name, const Transaction& txn) {
+            rebuild_index(index_name, txn.handle());
+        }
+
+        /// \brief Visits index entries in an inclusive index key range without reading the records.
+        /// \details Covers projections that need only the index key and the
+        /// primary key: each entry costs one cursor step in the index table.
+        /// \tparam IndexKeyT Index key type passed to \ref add_index().
+        /// \param index_name Index name.
+        /// \param from Start index key.
+        /// \param to End index key.
+        /// \param callback Invoked as \c callback(const IndexKeyT&, const KeyT&). Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every entry was visited, \c false if the callback stopped early.
+        /// \throws std::invalid_argument if no such index is attached or \p IndexKeyT differs.
+        /// \throws MdbxException if a database error occurs.
+        template<class IndexKeyT, typename CallbackT>
+        bool for_each_index_range(const std::string& index_name,
+                                  const IndexKeyT& from, const IndexKeyT& to,
+                                  CallbackT callback, MDBX_txn* txn = nullptr) const {
+            const detail::SecondaryIndex<ValueT>& index = find_index<IndexKeyT>(index_name);
+            bool completed = false;
+            with_transaction([this, &index, &from, &to, &callback, &completed](MDBX_txn* t) {
+                auto visit = [&callback](const MDBX_val& index_key, const MDBX_val& primary_key) {
+                    return static_cast<bool>(callback(deserialize_key<IndexKeyT>(index_key),
+                                                      deserialize_key<KeyT>(primary_key)));
+                };
+                completed = db_walk_index(index, from, to, visit, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Visits index entries in an inclusive index key range without reading the records.
+        /// \param index_name Index name.
+        /// \param from Start index key.
+        /// \param to End index key.
+        /// \param callback Invoked as \c callback(const IndexKeyT&, const KeyT&). Return \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every entry was visited, \c false if the callback stopped early.
+        template<class IndexKeyT, typename CallbackT>
+        bool for_each_index_range(const std::string& index_name,
+                                  const IndexKeyT& from, const IndexKeyT& to,
+                                  CallbackT callback, const Transaction& txn) const {
+            return for_each_index_range<IndexKeyT>(index_name, from, to, callback, txn.handle());
+        }
+
+        /// \brief Streams the records of an inclusive index key range in index order.
+        /// \details Reads each record once with a point lookup by the primary
+        /// key stored in the index; nothing is materialized.
+        /// \tparam IndexKeyT Index key type passed to \ref add_index().
+        /// \param index_name Index name.
+        /// \param from Start index key.
+        /// \param to End index key.
+        /// \param callback Invoked as \c callback(const IndexKeyT&, const KeyT&, const ValueT&).
+        ///        Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every record was visited, \c false if the callback stopped early.
+        /// \throws std::invalid_argument if no such index is attached or \p IndexKeyT differs.
+        /// \throws MdbxException if a database error occurs.
+        template<class IndexKeyT, typename CallbackT>
+        bool for_each_by_index_range(const std::string& index_name,
+                                     const IndexKeyT& from, const IndexKeyT& to,
+                                     CallbackT callback, MDBX_txn* txn = nullptr) const {
+            const detail::SecondaryIndex<ValueT>& index = find_index<IndexKeyT>(index_name);
+            bool completed = false;
+            with_transaction([this, &index, &from, &to, &callback, &completed](MDBX_txn* t) {
+                auto visit = [this, &callback, t](const MDBX_val& index_key, const MDBX_val& primary_key) {
+                    MDBX_val db_key = primary_key;
+                    MDBX_val db_val;
+                    const int rc = mdbx_get(t, m_dbi, &db_key, &db_val);
+                    if (rc == MDBX_NOTFOUND) return true;
+                    check_mdbx(rc, "Failed to read indexed record");
+                    return static_cast<bool>(callback(deserialize_key<IndexKeyT>(index_key),
+                                                      deserialize_key<KeyT>(primary_key),
+                                                      deserialize_value<ValueT>(db_val)));
+                };
+                completed = db_walk_index(index, from, to, visit, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Streams the records of an inclusive index key range in index order.
+        /// \param index_name Index name.
+        /// \param from Start index key.
+        /// \param to End index key.
+        /// \param callback Invoked as \c callback(const IndexKeyT&, const KeyT&, const ValueT&).
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every record was visited, \c false if the callback stopped early.
+        template<class IndexKeyT, typename CallbackT>
+        bool for_each_by_index_range(const std::string& index_name,
+                                     const IndexKeyT& from, const IndexKeyT& to,
+                                     CallbackT callback, const Transaction& txn) const {
+            return for_each_by_index_range<IndexKeyT>(index_name, from, to, callback, txn.handle());
+        }
+
+        /// \brief Returns the primary keys of the records with index key \p index_key.
+        /// \details Reads only the index table. Keys come in index duplicate order.
+        /// \param index_name Index name.
+        /// \param index_key Index key to look up.
+        /// \param txn Optional transaction handle.
+        /// \return Matching primary keys.
+        template<class IndexKeyT>
+        std::vector<KeyT> find_keys_by_index(const std::string& index_name,
+                                             const IndexKeyT& index_key,
+                                             MDBX_txn* txn = nullptr) const {
+            std::vector<KeyT> out;
+            for_each_index_range<IndexKeyT>(index_name, index_key, index_key,
+                [&out](const IndexKeyT&, const KeyT& key) {
+                    out.push_back(key);
+                    return true;
+                }, txn);
+            return out;
+        }
+
+        /// \brief Returns the primary keys of the records with index key \p index_key.
+        /// \param index_name Index name.
+        /// \param index_key Index key to look up.
+        /// \param txn Active transaction wrapper.
+        /// \return Matching primary keys.
+        template<class IndexKeyT>
+        std::vector<KeyT> find_keys_by_index(const std::string& index_name,
+                                             const IndexKeyT& index_key,
+                                             const Transaction& txn) const {
+            return find_keys_by_index<IndexKeyT>(index_name, index_key, txn.handle());
+        }
+
+        /// \brief Returns the records with index key \p index_key.
+        /// \param index_name Index name.
+        /// \param index_key Index key to look up.
+        /// \param txn Optional transaction handle.
+        /// \return Matching pairs.
+        template<class IndexKeyT>
+        std::vector<value_type> find_by_index(const std::string& index_name,
+                                              const IndexKeyT& index_key,
+                                              MDBX_txn* txn = nullptr) const {
+            std::vector<value_type> out;
+            for_each_by_index_range<IndexKeyT>(index_name, index_key, index_key,
+                [&out](const IndexKeyT&, const KeyT& key, const ValueT& value) {
+                    out.push_back(value_type(key, value));
+                    return true;
+                }, txn);
+            return out;
+        }
+
+        /// \brief Returns the records with index key \p index_key.
+        /// \param index_name Index name.
+        /// \param index_key Index key to look up.
+        /// \param txn Active transaction wrapper.
+        /// \return Matching pairs.
+        template<class IndexKeyT>
+        std::vector<value_type> find_by_index(const std::string& index_name,
+                                              const IndexKeyT& index_key,
+                                              const Transaction& txn) const {
+            return find_by_index<IndexKeyT>(index_name, index_key, txn.handle());
+        }
+
+        /// \brief Counts the records with index key \p index_key.
+        /// \details Uses \c mdbx_cursor_count() on the index entry.
+        /// \param index_name Index name.
+        /// \param index_key Index key to look up.
+        /// \param txn Optional transaction handle.
+        /// \return Number of matching records.
+        template<class IndexKeyT>
+        std::size_t count_by_index(const std::string& index_name,
+                                   const IndexKeyT& index_key,
+                                   MDBX_txn* txn = nullptr) const {
+            const detail::SecondaryIndex<ValueT>& index = find_index<IndexKeyT>(index_name);
+            std::size_t result = 0;
+            with_transaction([&index, &index_key, &result](MDBX_txn* t) {
+                SerializeScratch sc_key;
+                MDBX_val db_key = serialize_key<Options::safe_integer_key>(index_key, sc_key);
+                MDBX_val db_val;
+                CursorGuard cursor;
+                check_mdbx(mdbx_cursor_open(t, index.dbi(), cursor.out()),
+                           "Failed to open secondary index cursor");
+                const int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+                if (rc == MDBX_NOTFOUND) return;
+                check_mdbx(rc, "Failed to read secondary index");
+                check_mdbx(mdbx_cursor_count(cursor.get(), &result),
+                           "Failed to count secondary index entries");
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Counts the records with index key \p index_key.
+        /// \param index_name Index name.
+        /// \param index_key Index key to look up.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of matching records.
+        template<class IndexKeyT>
+        std::size_t count_by_index(const std::string& index_name,
+                                   const IndexKeyT& index_key,
+                                   const Transaction& txn) const {
+            return count_by_index<IndexKeyT>(index_name, index_key, txn.handle());
+        }
+
+        // --- Range aggregates ---
+
+        /// \brief Attaches block summaries that answer \ref range_aggregate() without a full scan.
+        /// \details Summaries live in the \c MDBX_INTEGERKEY table
+        /// <tt>name + "__aggregates"</tt> and are maintained like a secondary
+        /// index: every write updates one summary per level (10 levels for
+        /// 64-bit keys, 5 for 32-bit keys) in the same transaction. A range
+        /// query then reads at most 128 summaries or records per level. If the
+        /// summary table is empty while this table is not, it is filled from
+        /// the existing records.
+        /// \throws std::logic_error if summaries are already attached.
+        /// \throws MdbxException if a database error occurs.
+        /// \note Requires \c std::uint32_t or \c std::uint64_t keys and an
+        /// arithmetic value type. Attach the summaries to every wrapper that
+        /// writes this table. Like index tables they are not captured by sync,
+        /// so replicas call \ref rebuild_range_aggregates() after applying changes.
+        void add_range_aggregates() {
+            if (m_range_aggregates) {
+                throw std::logic_error("KeyValueTable: range aggregates are already attached");
+            }
+            const MDBX_dbi dbi = m_connection->open_dbi(
+                m_name + "__aggregates",
+                static_cast<MDBX_db_flags_t>(MDBX_CREATE | MDBX_INTEGERKEY));
+            std::shared_ptr<const range_aggregate_index> index =
+                std::make_shared<range_aggregate_index>("__range_aggregates", dbi, m_dbi);
+            if (!m_connection->is_read_only()) {
+                with_transaction([this, &index](MDBX_txn* t) {
+                    if (db_count(t) != 0 && db_index_entries(*index, t) == 0) {
+                        db_fill_index(*index, t);
+                    }
+                }, TransactionMode::WRITABLE);
+            }
+            m_indexes.push_back(index);
+            m_range_aggregates = index;
+        }
+
+        /// \brief Checks whether range aggregates are attached to this wrapper.
+        bool has_range_aggregates() const noexcept {
+            return static_cast<bool>(m_range_aggregates);
+        }
+
+        /// \brief Recreates the range aggregates from the records.
+        /// \param txn Optional transaction handle.
+        /// \throws std::logic_error if range aggregates are not attached.
+        void rebuild_range_aggregates(MDBX_txn* txn = nullptr) {
+            check_range_aggregates();
+            rebuild_index("__range_aggregates", txn);
+        }
+
+        /// \brief Recreates the range aggregates from the records.
+        /// \param txn Active transaction wrapper.
+        void rebuild_range_aggregates(const Transaction& txn) {
+            rebuild_range_aggregates(txn.handle());
+        }
+
+        /// \brief Computes count, sum, min and max of the values with keys in <tt>[from, to]</tt>.
+        /// \param from First key of the range.
+        /// \param to Last key of the range.
+        /// \param txn Optional transaction handle.
+        /// \return The aggregate; empty when no key lies in the range.
+        /// \throws std::logic_error if range aggregates are not attached.
+        /// \throws MdbxException if a database error occurs.
+        RangeAggregate range_aggregate(const KeyT& from, const KeyT& to, MDBX_txn* txn = nullptr) const {
+            check_range_aggregates();
+            RangeAggregate result;
+            with_transaction([this, &from, &to, &result](MDBX_txn* t) {
+                result = m_range_aggregates->query(t, from, to);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Computes count, sum, min and max of the values with keys in <tt>[from, to]</tt>.
+        /// \param from First key of the range.
+        /// \param to Last key of the range.
+        /// \param txn Active transaction wrapper.
+        /// \return The aggregate; empty when no key lies in the range.
+        RangeAggregate range_aggregate(const KeyT& from, const KeyT& to, const Transaction& txn) const {
+            return range_aggregate(from, to, txn.handle());
+        }
+
     private:
+
+        /// \brief Opens a cursor for an iterator in a caller-owned or thread-bound transaction.
+        /// \param txn Optional transaction handle.
+        /// \return Owned cursor handle.
+        /// \throws std::logic_error if no transaction is available.
+        /// \throws MdbxException if the cursor cannot be opened.
+        MDBX_cursor* open_iterator_cursor(MDBX_txn* txn) const {
+            MDBX_txn* txn_handle = txn ? checked_external_txn(txn) : thread_txn();
+            if (!txn_handle) {
+                throw std::logic_error("KeyValueTable iterator requires an active transaction");
+            }
+            MDBX_cursor* cursor = nullptr;
+            check_mdbx(mdbx_cursor_open(txn_handle, m_dbi, &cursor), "Failed to open MDBX cursor");
+            return cursor;
+        }
+
+        /// \brief Creates an iterator positioned by a cursor operation.
+        /// \param txn Optional transaction handle.
+        /// \param op \c MDBX_FIRST or \c MDBX_SET_RANGE.
+        /// \param key Seek key for \c MDBX_SET_RANGE, otherwise null.
+        /// \param skip_equal Step past an exactly matching key (upper bound).
+        /// \return Positioned iterator or a bound end iterator.
+        const_iterator make_iterator(MDBX_txn* txn, MDBX_cursor_op op,
+                                     const KeyT* key, bool skip_equal) const {
+            const_iterator it(open_iterator_cursor(txn), true);
+            SerializeScratch sc_key;
+            MDBX_val db_key{};
+            MDBX_val db_key_exact{};
+            if (key) {
+                db_key = serialize_key<Options::safe_integer_key>(*key, sc_key);
+                db_key_exact = db_key;
+            }
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(it.m_cursor, &db_key, &db_val, op);
+            if (rc == MDBX_NOTFOUND) return it;
+            check_mdbx(rc, "Failed to position key-value iterator");
+            it.m_at_end = false;
+            if (skip_equal &&
+                mdbx_cmp(mdbx_cursor_txn(it.m_cursor), m_dbi, &db_key, &db_key_exact) == 0) {
+                it.step(MDBX_NEXT);
+            }
+            return it;
+        }
     
+        /// \brief Shared core of the throwing and \c std::nothrow_t \c insert().
+        Status insert_status(const KeyT& key, const ValueT& value, MDBX_txn* txn) {
+            return with_transaction_status([this, &key, &value](MDBX_txn* t) {
+                return db_insert_if_absent(std::nothrow, key, value, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Shared core of \c try_get() and the \c std::nothrow_t \c find().
+        Status get_status(const KeyT& key, ValueT& out, MDBX_txn* txn) const {
+            return with_transaction_status([this, &key, &out](MDBX_txn* t) {
+                return db_get(std::nothrow, key, out, t);
+            }, TransactionMode::READ_ONLY, txn);
+        }
+
+        /// \brief Shared core of the throwing and \c std::nothrow_t \c erase().
+        Status erase_status(const KeyT& key, MDBX_txn* txn) {
+            return with_transaction_status([this, &key](MDBX_txn* t) {
+                return db_erase(std::nothrow, key, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
         /// \brief Executes a functor within a transaction context.
         /// \tparam F Callable type accepting `MDBX_txn*`.
         /// \param action Functor to execute.
@@ -1403,6 +3146,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
             
             auto txn_guard = m_connection->transaction(mode);
             try {
@@ -1426,8 +3170,7 @@ namespace mdbxc {
         /// \throws MdbxException if a database error occurs.
         template<template <class...> class ContainerT>
         void db_load(ContainerT<KeyT, ValueT>& container, MDBX_txn* txn_handle) {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn_handle, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn_handle);
 
             MDBX_val db_key, db_val;
             int rc = MDBX_SUCCESS;
@@ -1446,8 +3189,7 @@ namespace mdbxc {
         /// \param txn Optional transaction.
         /// \throws MdbxException if a database error occurs.
         void db_load(std::vector<std::pair<KeyT, ValueT>>& out_vector, MDBX_txn* txn) {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
 
             MDBX_val db_key, db_val;
             int rc = MDBX_SUCCESS;
@@ -1461,16 +3203,43 @@ namespace mdbxc {
             }
         }
 
-        template<class ContainerT>
-        void db_range(const KeyT& from_key, const KeyT& to_key,
-                      ContainerT& pairs, MDBX_txn* txn) const {
+        void db_parallel_load(std::vector<std::pair<KeyT, ValueT>>& out, std::size_t threads,
+                              MDBX_txn* txn) {
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat)), "Failed to query database statistics");
+            CachedCursor cursor(*this, txn);
+            MDBX_cursor* handle = cursor.get();
+            detail::parallel_decode(threads, static_cast<std::size_t>(stat.ms_entries),
+                [handle](detail::RawRecord& raw) -> bool {
+                    const int rc = mdbx_cursor_get(handle, &raw.key, &raw.value, MDBX_NEXT);
+                    if (rc == MDBX_NOTFOUND) return false;
+                    check_mdbx(rc, "Failed to load key-value table");
+                    return true;
+                },
+                [](const detail::RawRecord& raw) {
+                    return std::pair<KeyT, ValueT>(deserialize_key<KeyT>(raw.key),
+                                                   deserialize_value<ValueT>(raw.value));
+                },
+                out);
+        }
+
+        /// \brief Passes the raw key and value of every pair in an inclusive range to \p fn.
+        template<typename FnT>
+        void db_for_each_raw_range(const KeyT& from_key, const KeyT& to_key,
+                                   MDBX_txn* txn, FnT fn) const {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Range);
+#           endif
+            MDBXC_TRACE_SCOPE(TableRange);
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_from_key);
+#           endif
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_from_key;
@@ -1482,9 +3251,7 @@ namespace mdbxc {
                     stopped_by_upper_bound = true;
                     break;
                 }
-                KeyT key = deserialize_key<KeyT>(db_key);
-                ValueT value = deserialize_value<ValueT>(db_val);
-                pairs.insert(pairs.end(), value_type(std::move(key), std::move(value)));
+                fn(db_key, db_val);
                 rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
             }
             if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
@@ -1492,75 +3259,347 @@ namespace mdbxc {
             }
         }
 
+        template<class ContainerT>
+        void db_range(const KeyT& from_key, const KeyT& to_key,
+                      ContainerT& pairs, MDBX_txn* txn) const {
+            db_for_each_raw_range(from_key, to_key, txn, [&pairs](const MDBX_val& db_key, const MDBX_val& db_val) {
+                pairs.insert(pairs.end(), value_type(deserialize_key<KeyT>(db_key),
+                                                     deserialize_value<ValueT>(db_val)));
+            });
+        }
+
         template<class ContainerT>
         void db_range_values(const KeyT& from_key, const KeyT& to_key,
                              ContainerT& values, MDBX_txn* txn) const {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Range);
+#           endif
+            MDBXC_TRACE_SCOPE(TableRange);
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_from_key);
+#           endif
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_from_key;
             MDBX_val db_val;
-            bool stopped_by_upper_bound = false;
+            bool stopped_by_upper_bound = false;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                if (mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) > 0) {
+                    stopped_by_upper_bound = true;
+                    break;
+                }
+                values.insert(values.end(), deserialize_value<ValueT>(db_val));
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read key-value range values");
+            }
+        }
+
+        /// \brief Gets a value by key from the database.
+        /// \param key The key to search for.
+        /// \param value Reference to store the retrieved value.
+        /// \param txn_handle The active transaction.
+        /// \return True if found, false otherwise.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool db_for_each_range(const KeyT& from_key, const KeyT& to_key,
+                               CallbackT& callback, MDBX_txn* txn) const {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Range);
+#           endif
+            MDBXC_TRACE_SCOPE(TableRange);
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_from_key);
+#           endif
+
+            CachedCursor cursor(*this, txn);
+            if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) {
+                return true;
+            }
+
+            MDBX_val db_key = db_from_key;
+            MDBX_val db_val;
+            bool stopped_by_upper_bound = false;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                if (mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) > 0) {
+                    stopped_by_upper_bound = true;
+                    break;
+                }
+                KeyT key = deserialize_key<KeyT>(db_key);
+                ValueT value = deserialize_value<ValueT>(db_val);
+                if (!callback(key, value)) {
+                    return false;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to iterate key-value range");
+            }
+            return true;
+        }
+
+        /// \brief Range walk that hands \p visit the raw value bytes.
+        /// \details Same bounds handling as \ref db_for_each_range().
+        template<typename VisitT>
+        bool db_for_each_range_raw(const KeyT& from_key, const KeyT& to_key,
+                                   VisitT& visit, MDBX_txn* txn) const {
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+
+            CachedCursor cursor(*this, txn);
+            if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) {
+                return true;
+            }
+
+            MDBX_val db_key = db_from_key;
+            MDBX_val db_val;
+            bool stopped_by_upper_bound = false;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                if (mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) > 0) {
+                    stopped_by_upper_bound = true;
+                    break;
+                }
+                if (!visit(deserialize_key<KeyT>(db_key), static_cast<const MDBX_val&>(db_val))) {
+                    return false;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to iterate key-value range");
+            }
+            return true;
+        }
+
+        /// \brief Passes a raw value to \p visitor in place or through an aligned copy.
+        /// \throws std::runtime_error if the stored size differs from \c sizeof(ValueT).
+        template<typename VisitorT>
+        static void visit_raw_value(const MDBX_val& db_val, VisitorT& visitor) {
+            if (db_val.iov_len != sizeof(ValueT)) {
+                throw std::runtime_error("KeyValueTable: stored value size mismatch");
+            }
+            const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(db_val.iov_base);
+            if (addr % alignof(ValueT) == 0) {
+                visitor(*static_cast<const ValueT*>(db_val.iov_base));
+                return;
+            }
+            ValueT copy;
+            std::memcpy(&copy, db_val.iov_base, sizeof(ValueT));
+            visitor(static_cast<const ValueT&>(copy));
+        }
+
+        /// \brief Serializes \c reconcile_sorted() input pairs without copying them.
+        /// \details Templated on the record type so \c std::map entries
+        /// (\c std::pair<const KeyT, ValueT>) are not converted to temporaries.
+        struct SortedPairEncoder {
+            SerializeScratch& key_scratch;
+            SerializeScratch& value_scratch;
+
+            SortedPairEncoder(SerializeScratch& key_sc, SerializeScratch& value_sc)
+                : key_scratch(key_sc), value_scratch(value_sc) {}
+
+            template<typename RecordT>
+            void operator()(const RecordT& record, MDBX_val& db_key, MDBX_val& db_val) {
+                db_key = serialize_key<Options::safe_integer_key>(static_cast<const KeyT&>(record.first), key_scratch);
+                db_val = serialize_value(static_cast<const ValueT&>(record.second), value_scratch);
+            }
+        };
+
+        /// \brief Raw-value predicate that accepts every row.
+        struct AcceptView {
+            bool operator()(const KeyT&, const ByteView&) const { return true; }
+        };
+
+        /// \brief Shared cursor loop of \ref scan_range() and friends.
+        /// \param sink Invoked as \c sink(const KeyT&, const MDBX_val&) for accepted rows.
+        /// \return Number of rows passed to \p sink.
+        template<typename KeyPredT, typename ViewPredT, typename SinkT>
+        std::size_t db_scan_range(const KeyT& from_key, const KeyT& to_key,
+                                  KeyPredT& key_pred, ViewPredT& view_pred, SinkT& sink,
+                                  std::size_t limit, MDBX_txn* txn) const {
+            if (limit == 0) return 0;
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+
+            CachedCursor cursor(*this, txn);
+            if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return 0;
+
+            MDBX_val db_key = db_from_key;
+            MDBX_val db_val;
+            std::size_t count = 0;
+            bool stopped = false;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             while (rc == MDBX_SUCCESS) {
                 if (mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) > 0) {
-                    stopped_by_upper_bound = true;
+                    stopped = true;
                     break;
                 }
-                values.insert(values.end(), deserialize_value<ValueT>(db_val));
+                KeyT key = deserialize_key<KeyT>(db_key);
+                if (key_pred(static_cast<const KeyT&>(key)) &&
+                    view_pred(static_cast<const KeyT&>(key),
+                              ByteView(db_val.iov_len ? db_val.iov_base : nullptr, db_val.iov_len))) {
+                    ++count;
+                    if (!sink(key, db_val) || count == limit) {
+                        stopped = true;
+                        break;
+                    }
+                }
                 rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
             }
-            if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
-                check_mdbx(rc, "Failed to read key-value range values");
+            if (!stopped && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to scan key-value range");
             }
+            return count;
         }
 
-        /// \brief Gets a value by key from the database.
-        /// \param key The key to search for.
-        /// \param value Reference to store the retrieved value.
-        /// \param txn_handle The active transaction.
-        /// \return True if found, false otherwise.
-        /// \throws MdbxException if a database error occurs.
-        template<typename CallbackT>
-        bool db_for_each_range(const KeyT& from_key, const KeyT& to_key,
-                               CallbackT& callback, MDBX_txn* txn) const {
+        static std::uint64_t scan_key_offset(KeyT key) {
+            // Maps signed keys onto an unsigned domain while preserving order.
+            return std::is_signed<KeyT>::value
+                ? static_cast<std::uint64_t>(static_cast<std::int64_t>(key)) ^ (std::uint64_t(1) << 63)
+                : static_cast<std::uint64_t>(key);
+        }
+
+        static KeyT scan_offset_key(std::uint64_t offset) {
+            return std::is_signed<KeyT>::value
+                ? static_cast<KeyT>(static_cast<std::int64_t>(offset ^ (std::uint64_t(1) << 63)))
+                : static_cast<KeyT>(offset);
+        }
+
+        /// \brief Estimates the number of pairs in [from, key) in MDBX order.
+        std::size_t db_estimate_prefix(const MDBX_val& db_from, KeyT key, MDBX_txn* txn) const {
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            ptrdiff_t items = 0;
+            check_mdbx(mdbx_estimate_range(txn, m_dbi, &db_from, nullptr, &db_key, nullptr, &items),
+                       "Failed to estimate key-value range");
+            return items > 0 ? static_cast<std::size_t>(items) : 0;
+        }
+
+        std::vector<std::pair<KeyT, KeyT>> db_scan_partitions(const KeyT&, const KeyT&, std::size_t,
+                                                              MDBX_txn*, std::false_type) const {
+            return std::vector<std::pair<KeyT, KeyT>>();
+        }
+
+        /// \brief Splits [from_key, to_key] into at most \p parts ranges of similar size.
+        /// \return Partitions in key order, or an empty vector when splitting is not useful.
+        std::vector<std::pair<KeyT, KeyT>> db_scan_partitions(const KeyT& from_key, const KeyT& to_key,
+                                                              std::size_t parts, MDBX_txn* txn,
+                                                              std::true_type) const {
+            std::vector<std::pair<KeyT, KeyT>> out;
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
-
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
-            if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) {
-                return true;
+            if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return out;
+
+            const std::uint64_t lo = scan_key_offset(from_key);
+            const std::uint64_t hi = scan_key_offset(to_key);
+            if (hi < lo || hi - lo < parts) return out;
+            const std::size_t total = db_estimate_prefix(db_from_key, to_key, txn) + 1;
+            if (total < parts * 2) return out;
+
+            std::uint64_t start = lo;
+            for (std::size_t i = 1; i < parts; ++i) {
+                const std::size_t target = total / parts * i;
+                // Smallest split with at least `target` pairs before it.
+                std::uint64_t a = start + 1;
+                std::uint64_t b = hi;
+                if (a > b) break;
+                while (a < b) {
+                    const std::uint64_t mid = a + (b - a) / 2;
+                    if (db_estimate_prefix(db_from_key, scan_offset_key(mid), txn) >= target) {
+                        b = mid;
+                    } else {
+                        a = mid + 1;
+                    }
+                }
+                if (a >= hi) break;
+                out.push_back(std::make_pair(scan_offset_key(start), scan_offset_key(a - 1)));
+                start = a;
+            }
+            out.push_back(std::make_pair(scan_offset_key(start), to_key));
+
+            // Bisection assumes MDBX order equals numeric order; verify it.
+            for (std::size_t i = 1; i < out.size(); ++i) {
+                SerializeScratch sc_prev;
+                SerializeScratch sc_next;
+                MDBX_val prev = serialize_key<Options::safe_integer_key>(out[i - 1].second, sc_prev);
+                MDBX_val next = serialize_key<Options::safe_integer_key>(out[i].first, sc_next);
+                if (mdbx_cmp(txn, m_dbi, &prev, &next) >= 0) {
+                    return std::vector<std::pair<KeyT, KeyT>>();
+                }
             }
+            return out;
+        }
 
-            MDBX_val db_key = db_from_key;
-            MDBX_val db_val;
-            bool stopped_by_upper_bound = false;
-            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
-            while (rc == MDBX_SUCCESS) {
-                if (mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) > 0) {
-                    stopped_by_upper_bound = true;
-                    break;
+        /// \brief Runs \p callback over \p parts on \p threads workers.
+        template<typename CallbackT>
+        bool run_parallel_scan(const std::vector<std::pair<KeyT, KeyT>>& parts,
+                               std::size_t threads, CallbackT& callback) const {
+            std::atomic<std::size_t> next_part(0);
+            std::atomic<bool> stop(false);
+            std::atomic<bool> stopped_by_callback(false);
+            std::mutex error_mutex;
+            std::exception_ptr error;
+
+            auto worker = [this, &parts, &callback, &next_part, &stop,
+                           &stopped_by_callback, &error_mutex, &error]() {
+                try {
+                    Transaction txn = m_connection->transaction(TransactionMode::READ_ONLY);
+                    auto visit = [&callback, &stop, &stopped_by_callback](const KeyT& key,
+                                                                         const ValueT& value) -> bool {
+                        if (stop.load(std::memory_order_relaxed)) return false;
+                        if (!callback(key, value)) {
+                            stopped_by_callback.store(true);
+                            stop.store(true);
+                            return false;
+                        }
+                        return true;
+                    };
+                    for (;;) {
+                        const std::size_t i = next_part.fetch_add(1);
+                        if (i >= parts.size() || stop.load()) break;
+                        db_for_each_range(parts[i].first, parts[i].second, visit, txn.handle());
+                    }
+                    txn.commit();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    stop.store(true);
                 }
-                KeyT key = deserialize_key<KeyT>(db_key);
-                ValueT value = deserialize_value<ValueT>(db_val);
-                if (!callback(key, value)) {
-                    return false;
+            };
+
+            std::vector<std::thread> pool;
+            pool.reserve(threads);
+            try {
+                for (std::size_t i = 0; i < threads; ++i) {
+                    pool.push_back(std::thread(worker));
                 }
-                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
-            }
-            if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
-                check_mdbx(rc, "Failed to iterate key-value range");
+            } catch (...) {
+                stop.store(true);
+                for (std::size_t i = 0; i < pool.size(); ++i) pool[i].join();
+                throw;
             }
-            return true;
+            for (std::size_t i = 0; i < pool.size(); ++i) pool[i].join();
+            if (error) std::rethrow_exception(error);
+            return !stopped_by_callback.load();
         }
 
 #       if __cplusplus >= 201703L
@@ -1573,8 +3612,7 @@ namespace mdbxc {
                 return value_type(deserialize_key<KeyT>(db_key), deserialize_value<ValueT>(db_val));
             }
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_SUCCESS) {
                 return value_type(deserialize_key<KeyT>(db_key), deserialize_value<ValueT>(db_val));
@@ -1592,8 +3630,7 @@ namespace mdbxc {
             MDBX_val db_key_exact = db_key;
             MDBX_val db_val;
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return std::nullopt;
@@ -1611,8 +3648,7 @@ namespace mdbxc {
         }
 
         std::optional<value_type> db_first(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1623,8 +3659,7 @@ namespace mdbxc {
         }
 
         std::optional<value_type> db_last(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1635,8 +3670,7 @@ namespace mdbxc {
         }
 
         std::optional<KeyT> db_min_key(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1647,8 +3681,7 @@ namespace mdbxc {
         }
 
         std::optional<KeyT> db_max_key(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1667,8 +3700,7 @@ namespace mdbxc {
                 return std::make_pair(true, value_type(deserialize_key<KeyT>(db_key), deserialize_value<ValueT>(db_val)));
             }
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_SUCCESS) {
                 return std::make_pair(true, value_type(deserialize_key<KeyT>(db_key), deserialize_value<ValueT>(db_val)));
@@ -1686,8 +3718,7 @@ namespace mdbxc {
             MDBX_val db_key_exact = db_key;
             MDBX_val db_val;
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return std::make_pair(false, value_type(KeyT(), ValueT()));
@@ -1705,8 +3736,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, value_type> db_first_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1717,8 +3747,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, value_type> db_last_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1729,8 +3758,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, KeyT> db_min_key_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
             if (rc == MDBX_NOTFOUND) {
@@ -1741,8 +3769,7 @@ namespace mdbxc {
         }
 
         std::pair<bool, KeyT> db_max_key_compat(MDBX_txn* txn) const {
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
             if (rc == MDBX_NOTFOUND) {
@@ -1760,8 +3787,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_to_key;
@@ -1797,8 +3823,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return;
 
             MDBX_val db_key = db_to_key;
@@ -1839,8 +3864,7 @@ namespace mdbxc {
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return false;
 
             MDBX_val db_key = db_from_key;
@@ -1851,14 +3875,21 @@ namespace mdbxc {
             return mdbx_cmp(txn, m_dbi, &db_key, &db_to_key) <= 0;
         }
 
+        std::size_t db_estimate_count_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
+            SerializeScratch sc_from_key;
+            SerializeScratch sc_to_key;
+            MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
+            MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
+            return estimate_range_items(txn, db_from_key, db_to_key);
+        }
+
         std::size_t db_count_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return 0;
 
             MDBX_val db_key = db_from_key;
@@ -1880,15 +3911,94 @@ namespace mdbxc {
             return count;
         }
 
-        std::size_t db_erase_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn) const {
+        template<typename PrefixT, typename CallbackT>
+        bool db_for_each_prefix(const PrefixT& prefix, CallbackT& callback, MDBX_txn* txn) const {
+            auto visit = [&callback](const MDBX_val& db_key, const MDBX_val& db_val) -> bool {
+                KeyT key = deserialize_key<KeyT>(db_key);
+                ValueT value = deserialize_value<ValueT>(db_val);
+                return callback(static_cast<const KeyT&>(key), static_cast<const ValueT&>(value));
+            };
+            return db_walk_prefix(prefix, visit, txn, "Failed to iterate key-value prefix");
+        }
+
+        template<typename PrefixT>
+        std::size_t db_count_prefix(const PrefixT& prefix, MDBX_txn* txn) const {
+            std::size_t count = 0;
+            auto counter = [&count](const MDBX_val&, const MDBX_val&) -> bool {
+                ++count;
+                return true;
+            };
+            db_walk_prefix(prefix, counter, txn, "Failed to count key-value prefix");
+            return count;
+        }
+
+        template<typename PrefixT>
+        std::size_t db_erase_prefix(const PrefixT& prefix, MDBX_txn* txn) const {
+            static_assert(is_byte_string_key<KeyT>::value || is_composite_key<KeyT>::value,
+                          "Prefix scans require std::string, byte-vector or composite keys");
+            SerializeScratch sc_prefix;
+            MDBX_val db_prefix = serialize_key<Options::safe_integer_key>(prefix, sc_prefix);
+
+            std::size_t removed = 0;
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key = db_prefix;
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val,
+                                     db_prefix.iov_len ? MDBX_SET_RANGE : MDBX_FIRST);
+            while (rc == MDBX_SUCCESS && mdbx_val_has_prefix(db_key, db_prefix)) {
+#               if MDBXC_SYNC_ENABLED
+                const std::vector<std::uint8_t> kbytes = capture_bytes(db_key);
+#               endif
+                index_update(txn, db_key, index_value(db_val).get(), nullptr);
+                check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to erase key-value in prefix");
+#               if MDBXC_SYNC_ENABLED
+                record_op(txn, sync::ChangeOpType::Delete, kbytes, MDBX_val());
+#               endif
+                ++removed;
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to erase key-value prefix");
+            }
+            return removed;
+        }
+
+        /// \brief Calls \p visit with each serialized pair whose key starts with \p prefix.
+        /// \return \c false if \p visit returned \c false, otherwise \c true.
+        template<typename PrefixT, typename VisitT>
+        bool db_walk_prefix(const PrefixT& prefix, VisitT& visit, MDBX_txn* txn, const char* error) const {
+            static_assert(is_byte_string_key<KeyT>::value || is_composite_key<KeyT>::value,
+                          "Prefix scans require std::string, byte-vector or composite keys");
+            SerializeScratch sc_prefix;
+            MDBX_val db_prefix = serialize_key<Options::safe_integer_key>(prefix, sc_prefix);
+
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key = db_prefix;
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val,
+                                     db_prefix.iov_len ? MDBX_SET_RANGE : MDBX_FIRST);
+            while (rc == MDBX_SUCCESS && mdbx_val_has_prefix(db_key, db_prefix)) {
+                if (!visit(static_cast<const MDBX_val&>(db_key), static_cast<const MDBX_val&>(db_val))) {
+                    return false;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, error);
+            }
+            return true;
+        }
+
+        /// \brief Deletes up to \p limit records of an inclusive range with \c mdbx_cursor_del().
+        std::size_t db_erase_range(const KeyT& from_key, const KeyT& to_key, MDBX_txn* txn,
+                                   std::size_t limit = static_cast<std::size_t>(-1)) const {
             SerializeScratch sc_from_key;
             SerializeScratch sc_to_key;
             MDBX_val db_from_key = serialize_key<Options::safe_integer_key>(from_key, sc_from_key);
             MDBX_val db_to_key = serialize_key<Options::safe_integer_key>(to_key, sc_to_key);
 
             std::size_t removed = 0;
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn);
             if (mdbx_cmp(txn, m_dbi, &db_from_key, &db_to_key) > 0) return 0;
 
             MDBX_val db_key = db_from_key;
@@ -1903,11 +4013,12 @@ namespace mdbxc {
 #               if MDBXC_SYNC_ENABLED
                 const std::vector<std::uint8_t> kbytes = capture_bytes(db_key);
 #               endif
+                index_update(txn, db_key, index_value(db_val).get(), nullptr);
                 check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to erase pair in range");
 #               if MDBXC_SYNC_ENABLED
-                record_op(txn, sync::ChangeOpType::Delete, kbytes, {});
+                record_op(txn, sync::ChangeOpType::Delete, kbytes, MDBX_val());
 #               endif
-                ++removed;
+                if (++removed == limit) return removed;
                 rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
             }
             if (!stopped_by_upper_bound && rc != MDBX_NOTFOUND) {
@@ -1917,13 +4028,62 @@ namespace mdbxc {
         }
 
         bool db_get(const KeyT& key, ValueT& value, MDBX_txn* txn_handle) const {
+            const Status status = db_get(std::nothrow, key, value, txn_handle);
+            if (status.code() == StatusCode::NotFound) return false;
+            check_status(status);
+            return true;
+        }
+
+        /// \brief Reads the value of \p key, returning MDBX errors as a status.
+        /// \return Ok, \c StatusCode::NotFound, or the MDBX error.
+        /// \throws Only what deserialization throws.
+        Status db_get(std::nothrow_t, const KeyT& key, ValueT& value, MDBX_txn* txn_handle) const {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Find);
+#           endif
+            MDBXC_TRACE_SCOPE(TableFind);
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_key);
+#           endif
             MDBX_val db_val;
             int rc = mdbx_get(txn_handle, m_dbi, &db_key, &db_val);
-            if (rc == MDBX_NOTFOUND) return false;
-            check_mdbx(rc, "Failed to retrieve value");
+            if (rc != MDBX_SUCCESS) return Status::from_mdbx(rc, "Failed to retrieve value");
+#           if MDBXC_METRICS_ENABLED
+            timer.bytes = db_key.iov_len + db_val.iov_len;
+#           endif
+            MDBXC_TRACE_SCOPE(Deserialize);
             value = deserialize_value<ValueT>(db_val);
+            return Status();
+        }
+
+        /// \brief Passes the raw value bytes for a key to a visitor.
+        /// \param key The key to look up.
+        /// \param visitor Callable invoked as \c visitor(const ByteView&).
+        /// \param txn_handle The active transaction.
+        /// \return True if key exists, false otherwise.
+        /// \throws MdbxException if a database error occurs.
+        template<typename VisitorT>
+        bool db_find_view(const KeyT& key, VisitorT& visitor, MDBX_txn* txn_handle) const {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Find);
+#           endif
+            MDBXC_TRACE_SCOPE(TableFind);
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_key);
+#           endif
+            MDBX_val db_val;
+            int rc = mdbx_get(txn_handle, m_dbi, &db_key, &db_val);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to retrieve value view");
+#           if MDBXC_METRICS_ENABLED
+            timer.bytes = db_key.iov_len + db_val.iov_len;
+#           endif
+            const ByteView view(db_val.iov_len ? db_val.iov_base : nullptr, db_val.iov_len);
+            visitor(view);
             return true;
         }
 
@@ -1933,8 +4093,15 @@ namespace mdbxc {
         /// \return True if key exists, false otherwise.
         /// \throws MdbxException if a database error occurs.
         bool db_contains(const KeyT& key, MDBX_txn* txn_handle) const {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Find);
+#           endif
+            MDBXC_TRACE_SCOPE(TableFind);
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_key);
+#           endif
             MDBX_val db_val; // dummy
             int rc = mdbx_get(txn_handle, m_dbi, &db_key, &db_val);
             if (rc == MDBX_NOTFOUND) return false;
@@ -1960,42 +4127,81 @@ namespace mdbxc {
         template<template <class...> class ContainerT>
         void db_append(const ContainerT<KeyT, ValueT>& container, MDBX_txn* txn_handle) {
             SerializeScratch sc_key;
-            SerializeScratch sc_value;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
             
             for (const auto& pair : container) {
                 MDBX_val db_key = serialize_key<Options::safe_integer_key>(pair.first, sc_key);
-                MDBX_val db_val = serialize_value(pair.second, sc_value);
-                check_mdbx(
-                    mdbx_put(txn_handle, m_dbi, &db_key, &db_val, MDBX_UPSERT),
-                    "Failed to write record"
-                );
+                MDBX_val db_val;
+                std::unique_ptr<ValueT> old_value = index_old_value(txn_handle, db_key);
+                if (!upsert_value(txn_handle, db_key, pair.second, db_val, sc_value,
+                                  "Failed to write record")) {
+                    continue;
+                }
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn_handle, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), capture_bytes(db_val));
+                          db_key, db_val);
 #               endif
+                index_update(txn_handle, db_key, old_value.get(), &pair.second);
             }
         }
         
+        /// \brief Writes pairs with \c MDBX_APPEND until a key is out of order.
+        /// \param pairs Range of key-value pairs.
+        /// \param mode Reaction to out-of-order keys.
+        /// \param txn_handle Active transaction handle.
+        /// \return \c true if all pairs were appended.
+        template<class RangeT>
+        bool db_bulk_load_sorted(const RangeT& pairs, BulkLoadMode mode, MDBX_txn* txn_handle) {
+            SerializeScratch sc_key;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
+            bool appending = true;
+            for (typename RangeT::const_iterator it = pairs.begin(); it != pairs.end(); ++it) {
+                MDBX_val db_key = serialize_key<Options::safe_integer_key>(it->first, sc_key);
+                MDBX_val db_val;
+                std::unique_ptr<ValueT> old_value = index_old_value(txn_handle, db_key);
+                int rc = put_serialized_value(txn_handle, m_dbi, &db_key, it->second, db_val,
+                                              appending ? MDBX_UPSERT | MDBX_APPEND : MDBX_UPSERT,
+                                              sc_value);
+                if (appending && rc == MDBX_EKEYMISMATCH) {
+                    if (mode == BulkLoadMode::Strict) {
+                        check_mdbx(rc, "bulk_load_sorted: key is not greater than the last table key");
+                    }
+                    appending = false;
+                    rc = put_serialized_value(txn_handle, m_dbi, &db_key, it->second,
+                                              db_val, MDBX_UPSERT, sc_value);
+                }
+                check_mdbx(rc, "Failed to write record");
+#               if MDBXC_SYNC_ENABLED
+                record_op(txn_handle, sync::ChangeOpType::Put,
+                          db_key, db_val);
+#               endif
+                index_update(txn_handle, db_key, old_value.get(), &it->second);
+            }
+            return appending;
+        }
+
         /// \brief Appends the content of the vector to the database.
         /// \param container Vector with key-value pairs to append.
         /// \param txn_handle Active transaction handle.
         /// \throws MdbxException if a database error occurs.
         void db_append(const std::vector<std::pair<KeyT, ValueT>>& container, MDBX_txn* txn_handle) {
             SerializeScratch sc_key;
-            SerializeScratch sc_value;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
             
 #           if __cplusplus >= 201703L
             for (const auto& [key, value] : container) {
                 MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
-                MDBX_val db_val = serialize_value(value, sc_value);
-                check_mdbx(
-                    mdbx_put(txn_handle, m_dbi, &db_key, &db_val, MDBX_UPSERT),
-                    "Failed to write record"
-                );
+                MDBX_val db_val;
+                std::unique_ptr<ValueT> old_value = index_old_value(txn_handle, db_key);
+                if (!upsert_value(txn_handle, db_key, value, db_val, sc_value,
+                                  "Failed to write record")) {
+                    continue;
+                }
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn_handle, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), capture_bytes(db_val));
+                          db_key, db_val);
 #               endif
+                index_update(txn_handle, db_key, old_value.get(), &value);
             }
 #           else
             for (typename std::vector<std::pair<KeyT, ValueT> >::const_iterator it = container.begin();
@@ -2003,15 +4209,17 @@ namespace mdbxc {
                 const KeyT& key = it->first;
                 const ValueT& value = it->second;
                 MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
-                MDBX_val db_val = serialize_value(value, sc_value);
-                check_mdbx(
-                    mdbx_put(txn_handle, m_dbi, &db_key, &db_val, MDBX_UPSERT),
-                    "Failed to write record"
-                );
+                MDBX_val db_val;
+                std::unique_ptr<ValueT> old_value = index_old_value(txn_handle, db_key);
+                if (!upsert_value(txn_handle, db_key, value, db_val, sc_value,
+                                  "Failed to write record")) {
+                    continue;
+                }
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn_handle, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), capture_bytes(db_val));
+                          db_key, db_val);
 #               endif
+                index_update(txn_handle, db_key, old_value.get(), &value);
             }
 #           endif
         }
@@ -2026,27 +4234,28 @@ namespace mdbxc {
         template<template <class...> class ContainerT>
         void db_reconcile(const ContainerT<KeyT, ValueT>& container, MDBX_txn* txn_handle) {
             SerializeScratch sc_key;
-            SerializeScratch sc_value;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
             
             // 1. Collect all keys from the container
             std::unordered_set<KeyT> new_keys;
             for (const auto& pair : container) {
                 new_keys.insert(pair.first);
                 MDBX_val db_key = serialize_key<Options::safe_integer_key>(pair.first, sc_key);
-                MDBX_val db_val = serialize_value(pair.second, sc_value);
-                check_mdbx(
-                    mdbx_put(txn_handle, m_dbi, &db_key, &db_val, MDBX_UPSERT),
-                    "Failed to write record"
-                );
+                MDBX_val db_val;
+                std::unique_ptr<ValueT> old_value = index_old_value(txn_handle, db_key);
+                if (!upsert_value(txn_handle, db_key, pair.second, db_val, sc_value,
+                                  "Failed to write record")) {
+                    continue;
+                }
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn_handle, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), capture_bytes(db_val));
+                          db_key, db_val);
 #               endif
+                index_update(txn_handle, db_key, old_value.get(), &pair.second);
             }
 
             // 2. Iterate over existing keys in the DB and remove the extras
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn_handle, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn_handle);
 
             MDBX_val db_key, db_val;
             int rc = MDBX_SUCCESS;
@@ -2056,9 +4265,10 @@ namespace mdbxc {
 #                   if MDBXC_SYNC_ENABLED
                     const std::vector<std::uint8_t> kbytes = capture_bytes(db_key);
 #                   endif
+                    index_update(txn_handle, db_key, index_value(db_val).get(), nullptr);
                     check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to delete record using cursor");
 #                   if MDBXC_SYNC_ENABLED
-                    record_op(txn_handle, sync::ChangeOpType::Delete, kbytes, {});
+                    record_op(txn_handle, sync::ChangeOpType::Delete, kbytes, MDBX_val());
 #                   endif
                 }
             }
@@ -2074,7 +4284,7 @@ namespace mdbxc {
         /// \throws MdbxException if a database error occurs.
         void db_reconcile(const std::vector<std::pair<KeyT, ValueT>>& container, MDBX_txn* txn_handle) {
             SerializeScratch sc_key;
-            SerializeScratch sc_value;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
             
             // 1. Collect keys and upsert values
             std::unordered_set<KeyT> new_keys;
@@ -2085,20 +4295,21 @@ namespace mdbxc {
                 new_keys.insert(key);
 
                 MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
-                MDBX_val db_val = serialize_value(value, sc_value);
-                check_mdbx(
-                    mdbx_put(txn_handle, m_dbi, &db_key, &db_val, MDBX_UPSERT),
-                    "Failed to write record"
-                );
+                MDBX_val db_val;
+                std::unique_ptr<ValueT> old_value = index_old_value(txn_handle, db_key);
+                if (!upsert_value(txn_handle, db_key, value, db_val, sc_value,
+                                  "Failed to write record")) {
+                    continue;
+                }
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn_handle, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), capture_bytes(db_val));
+                          db_key, db_val);
 #               endif
+                index_update(txn_handle, db_key, old_value.get(), &value);
             }
 
             // 2. Delete stale keys from DB
-            CursorGuard cursor;
-            check_mdbx(mdbx_cursor_open(txn_handle, m_dbi, cursor.out()), "Failed to open MDBX cursor");
+            CachedCursor cursor(*this, txn_handle);
 
             MDBX_val db_key, db_val;
             int rc = MDBX_SUCCESS;
@@ -2108,9 +4319,10 @@ namespace mdbxc {
 #                   if MDBXC_SYNC_ENABLED
                     const std::vector<std::uint8_t> kbytes = capture_bytes(db_key);
 #                   endif
+                    index_update(txn_handle, db_key, index_value(db_val).get(), nullptr);
                     check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT), "Failed to delete record using cursor");
 #                   if MDBXC_SYNC_ENABLED
-                    record_op(txn_handle, sync::ChangeOpType::Delete, kbytes, {});
+                    record_op(txn_handle, sync::ChangeOpType::Delete, kbytes, MDBX_val());
 #                   endif
                 }
             }
@@ -2126,24 +4338,42 @@ namespace mdbxc {
         /// \return true if the key-value pair was inserted, false if the key already existed.
         /// \throws MdbxException if the insert fails for reasons other than key existence.
         bool db_insert_if_absent(const KeyT& key, const ValueT& value, MDBX_txn* txn_handle) {
+            const Status status = db_insert_if_absent(std::nothrow, key, value, txn_handle);
+            if (status.code() == StatusCode::KeyExists) return false;
+            check_status(status);
+            return true;
+        }
+
+        /// \brief Inserts a key-value pair if absent, returning MDBX errors as a status.
+        /// \return Ok, \c StatusCode::KeyExists, or the MDBX error of the put.
+        /// \throws Only what serialization and index maintenance throw.
+        Status db_insert_if_absent(std::nothrow_t, const KeyT& key, const ValueT& value, MDBX_txn* txn_handle) {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Insert);
+#           endif
+            MDBXC_TRACE_SCOPE(TableInsert);
             SerializeScratch sc_key;
-            SerializeScratch sc_value;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
-            MDBX_val db_val = serialize_value(value, sc_value);
-            int rc = mdbx_put(txn_handle, m_dbi, &db_key, &db_val, MDBX_NOOVERWRITE);
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_key);
+#           endif
+            MDBX_val db_val;
+            int rc = put_serialized_value(txn_handle, m_dbi, &db_key, value,
+                                          db_val, MDBX_NOOVERWRITE, sc_value);
 
             if (rc == MDBX_SUCCESS) {
+#               if MDBXC_METRICS_ENABLED
+                timer.bytes = db_key.iov_len + db_val.iov_len;
+#               endif
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn_handle, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), capture_bytes(db_val));
+                          db_key, db_val);
 #               endif
-                return true;
+                index_update(txn_handle, db_key, nullptr, &value);
+                return Status();
             }
-            if (rc == MDBX_KEYEXIST)
-                return false;
-
-            check_mdbx(rc, "Failed to insert key-value pair");
-            return false;
+            return Status::from_mdbx(rc, "Failed to insert key-value pair");
         }
 
         /// \brief Inserts or replaces the key-value pair.
@@ -2152,18 +4382,85 @@ namespace mdbxc {
         /// \param txn_handle The active MDBX transaction.
         /// \throws MdbxException if the operation fails.
         void db_insert_or_assign(const KeyT& key, const ValueT& value, MDBX_txn* txn_handle) {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Insert);
+#           endif
+            MDBXC_TRACE_SCOPE(TableInsert);
             SerializeScratch sc_key;
-            SerializeScratch sc_value;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
-            MDBX_val db_val = serialize_value(value, sc_value);
-            check_mdbx(
-                mdbx_put(txn_handle, m_dbi, &db_key, &db_val, MDBX_UPSERT),  // or 0
-                "Failed to insert or assign key-value pair"
-            );
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_key);
+#           endif
+            MDBX_val db_val;
+            std::unique_ptr<ValueT> old_value = index_old_value(txn_handle, db_key);
+            if (!upsert_value(txn_handle, db_key, value, db_val, sc_value,
+                              "Failed to insert or assign key-value pair")) {
+                return;
+            }
+#           if MDBXC_METRICS_ENABLED
+            timer.bytes = db_key.iov_len + db_val.iov_len;
+#           endif
 #           if MDBXC_SYNC_ENABLED
             record_op(txn_handle, sync::ChangeOpType::Put,
-                      capture_bytes(db_key), capture_bytes(db_val));
+                      db_key, db_val);
+#           endif
+            index_update(txn_handle, db_key, old_value.get(), &value);
+        }
+
+        template<typename Fn>
+        bool db_update_bytes(const KeyT& key, Fn& fn, MDBX_txn* txn) {
+            SerializeScratch sc_key;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val db_val;
+            std::unique_ptr<ValueT> old_value = index_old_value(txn, db_key);
+            int rc = patch_value_bytes(txn, m_dbi, &db_key, fn, db_val, sc_value);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to patch value bytes");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put,
+                      db_key, db_val);
+#           endif
+            index_update(txn, db_key, old_value.get(), index_value(db_val).get());
+            return true;
+        }
+
+        void db_merge(const KeyT& key, const ValueT& operand, MDBX_txn* txn) {
+            SerializeScratch sc_key;
+            detail::ScratchLease sc_operand(m_connection->scratch_pool());
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            const MDBX_val db_operand = serialize_value(operand, sc_operand.get());
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_KEY);
+            const bool exists = rc == MDBX_SUCCESS;
+            if (!exists && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read value for merge");
+            }
+            std::unique_ptr<ValueT> old_value = exists ? index_value(db_val) : std::unique_ptr<ValueT>();
+            std::vector<std::uint8_t> merged;
+            m_merge_operator.apply(db_val.iov_base, exists ? db_val.iov_len : 0, exists,
+                                   db_operand.iov_base, db_operand.iov_len, merged);
+            MDBX_val db_merged;
+            db_merged.iov_base = merged.empty() ? nullptr : &merged[0];
+            db_merged.iov_len = merged.size();
+            check_mdbx(mdbx_cursor_put(cursor.get(), &db_key, &db_merged,
+                                       exists ? MDBX_CURRENT : MDBX_UPSERT),
+                       "Failed to write merged value");
+#           if MDBXC_SYNC_ENABLED
+            std::vector<std::uint8_t> merge_op(MergeOperator::encoded_size + db_operand.iov_len);
+            m_merge_operator.encode(&merge_op[0]);
+            if (db_operand.iov_len) {
+                std::memcpy(&merge_op[MergeOperator::encoded_size], db_operand.iov_base,
+                            db_operand.iov_len);
+            }
+            MDBX_val db_merge_op;
+            db_merge_op.iov_base = &merge_op[0];
+            db_merge_op.iov_len = merge_op.size();
+            record_op(txn, sync::ChangeOpType::Merge, db_key, db_merge_op);
 #           endif
+            index_update(txn, db_key, old_value.get(), index_value(db_merged).get());
         }
 
         template<typename Fn>
@@ -2200,25 +4497,262 @@ namespace mdbxc {
             }
         }
 
+        /// \brief Resolves keys in sorted order with a single cursor.
+        /// \param keys Keys to search.
+        /// \param emit Invoked as \c emit(index, value) for every found input key.
+        /// \param txn Active transaction handle.
+        /// \return Number of input keys that were found.
+        template<typename EmitT>
+        std::size_t db_find_many_batch(const std::vector<KeyT>& keys,
+                                       EmitT emit, MDBX_txn* txn) const {
+            const std::size_t count = keys.size();
+            if (count == 0) return 0;
+
+            std::vector<SerializeScratch> scratch(count);
+            std::vector<MDBX_val> db_keys(count);
+            std::vector<std::size_t> order(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                db_keys[i] = serialize_key<Options::safe_integer_key>(keys[i], scratch[i]);
+                order[i] = i;
+            }
+            const MDBX_dbi dbi = m_dbi;
+            std::stable_sort(order.begin(), order.end(),
+                             [&db_keys, txn, dbi](std::size_t lhs, std::size_t rhs) {
+                return mdbx_cmp(txn, dbi, &db_keys[lhs], &db_keys[rhs]) < 0;
+            });
+
+            CachedCursor cursor(*this, txn);
+
+            std::size_t found = 0;
+            bool positioned = false;
+            MDBX_val db_key{};
+            MDBX_val db_val{};
+            for (std::size_t pos = 0; pos < count; ++pos) {
+                const MDBX_val& target = db_keys[order[pos]];
+                int cmp = positioned ? mdbx_cmp(txn, m_dbi, &db_key, &target) : -1;
+                if (cmp < 0 && positioned) {
+                    // Adjacent keys are usually on the same page: try one step first.
+                    int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+                    if (rc == MDBX_NOTFOUND) break;
+                    check_mdbx(rc, "Failed to step batch lookup cursor");
+                    cmp = mdbx_cmp(txn, m_dbi, &db_key, &target);
+                }
+                if (cmp < 0) {
+                    db_key = target;
+                    int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+                    if (rc == MDBX_NOTFOUND) break;
+                    check_mdbx(rc, "Failed to seek batch lookup cursor");
+                    positioned = true;
+                    cmp = mdbx_cmp(txn, m_dbi, &db_key, &target);
+                }
+                if (cmp == 0) {
+                    emit(order[pos], db_val);
+                    ++found;
+                }
+            }
+            return found;
+        }
+
         /// \brief Removes a key from the database.
         /// \param key The key of the pair to be removed.
         /// \param txn_handle The active MDBX transaction.
         /// \return True if the key was found and deleted, false if the key was not found.
         /// \throws MdbxException if deletion fails for other reasons.
         bool db_erase(const KeyT& key, MDBX_txn* txn_handle) {
+            const Status status = db_erase(std::nothrow, key, txn_handle);
+            if (status.code() == StatusCode::NotFound) return false;
+            check_status(status);
+            return true;
+        }
+
+        /// \brief Removes a key, returning MDBX errors as a status.
+        /// \return Ok, \c StatusCode::NotFound, or the MDBX error of the delete.
+        /// \throws Only what serialization and index maintenance throw.
+        Status db_erase(std::nothrow_t, const KeyT& key, MDBX_txn* txn_handle) {
+#           if MDBXC_METRICS_ENABLED
+            OperationTimer timer(*this, TableOperation::Erase);
+#           endif
+            MDBXC_TRACE_SCOPE(TableErase);
             SerializeScratch sc_key;
             MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+#           if MDBXC_METRICS_ENABLED
+            timer.sample_key(db_key);
+#           endif
+            std::unique_ptr<ValueT> old_value = index_old_value(txn_handle, db_key);
             const int rc = mdbx_del(txn_handle, m_dbi, &db_key, nullptr);
             if (rc == MDBX_SUCCESS) {
+#               if MDBXC_METRICS_ENABLED
+                timer.bytes = db_key.iov_len;
+#               endif
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn_handle, sync::ChangeOpType::Delete,
-                          capture_bytes(db_key), {});
+                          db_key, MDBX_val());
 #               endif
+                index_update(txn_handle, db_key, old_value.get(), nullptr);
+                return Status();
+            }
+            return Status::from_mdbx(rc, "Failed to erase key");
+        }
+
+        // --- Secondary index maintenance ---
+
+        /// \brief Returns the attached index named \p index_name.
+        /// \throws std::invalid_argument if no such index is attached.
+        const detail::SecondaryIndex<ValueT>& find_index(const std::string& index_name) const {
+            for (std::size_t i = 0; i < m_indexes.size(); ++i) {
+                if (m_indexes[i]->name() == index_name) return *m_indexes[i];
+            }
+            throw std::invalid_argument("KeyValueTable: no index named '" + index_name + "'");
+        }
+
+        /// \brief Returns the attached index named \p index_name keyed by \p IndexKeyT.
+        /// \throws std::invalid_argument if no such index is attached or its key type differs.
+        template<class IndexKeyT>
+        const detail::SecondaryIndex<ValueT>& find_index(const std::string& index_name) const {
+            const detail::SecondaryIndex<ValueT>& index = find_index(index_name);
+            if (index.key_type() != detail::secondary_index_type_tag<IndexKeyT>()) {
+                throw std::invalid_argument(
+                    "KeyValueTable: index '" + index_name + "' has a different key type");
+            }
+            return index;
+        }
+
+        /// \brief Upserts \p value, or skips it when it is already stored.
+        /// \details Without \ref set_suppress_unchanged() this is a plain
+        /// \c MDBX_UPSERT. With it, one cursor lookup finds the stored value,
+        /// equal bytes end the call and other values are written with
+        /// \c MDBX_CURRENT (or \c MDBX_UPSERT for a new key) through the same
+        /// cursor, so the key is located once.
+        /// \param db_val Receives the written value bytes.
+        /// \return \c false if the stored value was equal and nothing was written.
+        bool upsert_value(MDBX_txn* txn, const MDBX_val& db_key, const ValueT& value,
+                          MDBX_val& db_val, SerializeScratch& sc, const char* error) {
+            if (!m_suppress_unchanged) {
+                check_mdbx(put_serialized_value(txn, m_dbi, &db_key, value,
+                                                db_val, MDBX_UPSERT, sc), error);
                 return true;
             }
-            if (rc == MDBX_NOTFOUND) return false;
-            check_mdbx(rc, "Failed to erase key");
-            return false;
+            db_val = serialize_value_to_scratch(value, sc);
+            CachedCursor cursor(*this, txn);
+            MDBX_val found_key = db_key;
+            MDBX_val stored;
+            const int rc = mdbx_cursor_get(cursor.get(), &found_key, &stored, MDBX_SET_KEY);
+            if (rc == MDBX_SUCCESS) {
+                if (stored.iov_len == db_val.iov_len &&
+                    (db_val.iov_len == 0 ||
+                     std::memcmp(stored.iov_base, db_val.iov_base, db_val.iov_len) == 0)) {
+                    return false;
+                }
+            } else if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read value for comparison");
+            }
+            MDBX_val put_key = db_key;
+            check_mdbx(mdbx_cursor_put(cursor.get(), &put_key, &db_val,
+                                       rc == MDBX_SUCCESS ? MDBX_CURRENT : MDBX_UPSERT),
+                       error);
+            return true;
+        }
+
+        /// \brief Reads the stored value of \p db_key before a write replaces it.
+        /// \return The value, or \c nullptr if no index is attached or the key is absent.
+        std::unique_ptr<ValueT> index_old_value(MDBX_txn* txn, const MDBX_val& db_key) const {
+            if (m_indexes.empty()) return std::unique_ptr<ValueT>();
+            MDBX_val key = db_key;
+            MDBX_val val;
+            const int rc = mdbx_get(txn, m_dbi, &key, &val);
+            if (rc == MDBX_NOTFOUND) return std::unique_ptr<ValueT>();
+            check_mdbx(rc, "Failed to read value for secondary indexes");
+            return index_value(val);
+        }
+
+        /// \brief Decodes stored bytes for the indexes.
+        /// \return The value, or \c nullptr if no index is attached.
+        std::unique_ptr<ValueT> index_value(const MDBX_val& val) const {
+            if (m_indexes.empty()) return std::unique_ptr<ValueT>();
+            return std::unique_ptr<ValueT>(new ValueT(deserialize_value<ValueT>(val)));
+        }
+
+        /// \brief Moves the index entries of one record. No-op without indexes.
+        /// \details Copies \p db_key first: it may point into a page that the
+        /// index writes invalidate.
+        void index_update(MDBX_txn* txn, const MDBX_val& db_key,
+                          const ValueT* old_value, const ValueT* new_value) const {
+            if (m_indexes.empty() || (!old_value && !new_value)) return;
+            const std::uint8_t* begin = static_cast<const std::uint8_t*>(db_key.iov_base);
+            std::vector<std::uint8_t> key_bytes(begin, begin + db_key.iov_len);
+            MDBX_val primary_key;
+            primary_key.iov_base = key_bytes.empty() ? nullptr : &key_bytes[0];
+            primary_key.iov_len = key_bytes.size();
+            for (std::size_t i = 0; i < m_indexes.size(); ++i) {
+                m_indexes[i]->update(txn, primary_key, old_value, new_value);
+            }
+        }
+
+        void before_sorted_reconcile_write(MDBX_txn* txn, const MDBX_val& key,
+                                           const MDBX_val* old_val,
+                                           const MDBX_val* new_val) const override {
+            if (m_indexes.empty()) return;
+            std::unique_ptr<ValueT> old_value = old_val ? index_value(*old_val) : std::unique_ptr<ValueT>();
+            std::unique_ptr<ValueT> new_value = new_val ? index_value(*new_val) : std::unique_ptr<ValueT>();
+            index_update(txn, key, old_value.get(), new_value.get());
+        }
+
+        std::size_t db_index_entries(const detail::SecondaryIndex<ValueT>& index, MDBX_txn* txn) const {
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, index.dbi(), &stat, sizeof(stat)),
+                       "Failed to query secondary index statistics");
+            return stat.ms_entries;
+        }
+
+        /// \brief Adds the entry of every record to \p index.
+        void db_fill_index(const detail::SecondaryIndex<ValueT>& index, MDBX_txn* txn) const {
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key, db_val;
+            std::vector<std::uint8_t> key_bytes;
+            int rc = MDBX_SUCCESS;
+            while ((rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT)) == MDBX_SUCCESS) {
+                const ValueT value = deserialize_value<ValueT>(db_val);
+                const std::uint8_t* begin = static_cast<const std::uint8_t*>(db_key.iov_base);
+                key_bytes.assign(begin, begin + db_key.iov_len);
+                MDBX_val primary_key;
+                primary_key.iov_base = key_bytes.empty() ? nullptr : &key_bytes[0];
+                primary_key.iov_len = key_bytes.size();
+                index.update(txn, primary_key, nullptr, &value);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to fill secondary index");
+            }
+        }
+
+        /// \brief Calls \p visit with each index entry whose key lies in <tt>[from, to]</tt>.
+        /// \return \c false if \p visit returned \c false, otherwise \c true.
+        template<class IndexKeyT, typename VisitT>
+        bool db_walk_index(const detail::SecondaryIndex<ValueT>& index,
+                           const IndexKeyT& from, const IndexKeyT& to,
+                           VisitT& visit, MDBX_txn* txn) const {
+            SerializeScratch sc_from;
+            SerializeScratch sc_to;
+            MDBX_val db_from = serialize_key<Options::safe_integer_key>(from, sc_from);
+            MDBX_val db_to = serialize_key<Options::safe_integer_key>(to, sc_to);
+            if (mdbx_cmp(txn, index.dbi(), &db_from, &db_to) > 0) return true;
+
+            CursorGuard cursor;
+            check_mdbx(mdbx_cursor_open(txn, index.dbi(), cursor.out()),
+                       "Failed to open secondary index cursor");
+            MDBX_val db_key = db_from;
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                if (mdbx_cmp(txn, index.dbi(), &db_key, &db_to) > 0) return true;
+                if (!visit(static_cast<const MDBX_val&>(db_key), static_cast<const MDBX_val&>(db_val))) {
+                    return false;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read secondary index");
+            }
+            return true;
         }
 
         /// \brief Clears all key-value pairs from the database.
@@ -2226,10 +4760,27 @@ namespace mdbxc {
         void db_clear(MDBX_txn* txn_handle) {
             check_mdbx(mdbx_drop(txn_handle, m_dbi, 0), "Failed to clear table");
 #           if MDBXC_SYNC_ENABLED
-            record_op(txn_handle, sync::ChangeOpType::ClearTable, {}, {});
+            record_op(txn_handle, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
 #           endif
+            for (std::size_t i = 0; i < m_indexes.size(); ++i) {
+                check_mdbx(mdbx_drop(txn_handle, m_indexes[i]->dbi(), 0),
+                           "Failed to clear secondary index");
+            }
         }
 
+        void check_range_aggregates() const {
+            if (!m_range_aggregates) {
+                throw std::logic_error("KeyValueTable: range aggregates are not attached");
+            }
+        }
+
+        typedef detail::RangeAggregateIndex<KeyT, ValueT, Options> range_aggregate_index;
+
+        std::vector<std::shared_ptr<const detail::SecondaryIndex<ValueT>>> m_indexes; ///< Indexes maintained by writes.
+        std::shared_ptr<const range_aggregate_index> m_range_aggregates; ///< Also listed in \c m_indexes.
+        MergeOperator m_merge_operator;      ///< Operator used by merge().
+        bool          m_has_merge_operator = false;
+        bool          m_suppress_unchanged = false;
     }; // KeyValueTable
 
 }; // namespace mdbxc
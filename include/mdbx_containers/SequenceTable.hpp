@@ -9,9 +9,12 @@
 /// Indices do not shift when records are erased; append() uses max(existing)+1.
 
 #include "common.hpp"
+#include <atomic>
+#include <iterator>
 #include <vector>
 #include <utility>
 #include <limits>
+#include <mutex>
 
 namespace mdbxc {
 
@@ -26,6 +29,21 @@ namespace mdbxc {
     /// \warning append() is not a global atomic sequence allocator.
     ///          Concurrent writers appending without external synchronization
     ///          may race for the same next index.
+    ///
+    /// The next append index is cached in memory together with the DBI
+    /// modification txnid it was derived from and Connection::abort_sequence(),
+    /// and records are written with \c MDBX_APPEND. MDBX reuses the txnid of
+    /// an aborted write transaction, so any abort through the connection drops
+    /// the cache. A cached index that fell behind the table is caught by
+    /// \c MDBX_EKEYMISMATCH and recomputed from the last key.
+    /// \warning Appends through raw \c MDBX_txn* handles that are later
+    ///          aborted with \c mdbx_txn_abort() bypass the abort counter;
+    ///          use \c Transaction for writes that may be rolled back.
+    ///
+    /// Concurrent producers may use reserve_ids() instead: it hands out index
+    /// ranges from an in-memory atomic counter, and the reserved indices are
+    /// written with insert_reserved(). Copies start with empty caches and an
+    /// unseeded counter, like a newly constructed wrapper.
     template<class ValueT>
     class SequenceTable final : public BaseTable {
     public:
@@ -51,6 +69,46 @@ namespace mdbxc {
                         std::move(name),
                         flags | get_mdbx_flags<uint64_t>()) {}
 
+        /// \brief Copies the table accessor without its caches or reservation counter.
+        SequenceTable(const SequenceTable& other)
+            : BaseTable(other) {}
+
+        /// \brief Moves the table accessor together with its reservation counter.
+        SequenceTable(SequenceTable&& other) noexcept
+            : BaseTable(std::move(other)),
+              m_next_id_known(other.m_next_id_known),
+              m_next_id(other.m_next_id),
+              m_next_id_mod_txnid(other.m_next_id_mod_txnid),
+              m_next_id_abort_seq(other.m_next_id_abort_seq),
+              m_reserve_seeded(other.m_reserve_seeded.load(std::memory_order_acquire)),
+              m_reserve_next(other.m_reserve_next.load(std::memory_order_relaxed)) {}
+
+        /// \brief Copies the table accessor; caches and the reservation counter are reset.
+        SequenceTable& operator=(const SequenceTable& other) {
+            if (this != &other) {
+                BaseTable::operator=(other);
+                forget_next_id();
+                reset_reservations();
+            }
+            return *this;
+        }
+
+        /// \brief Moves the table accessor together with its reservation counter.
+        SequenceTable& operator=(SequenceTable&& other) noexcept {
+            if (this != &other) {
+                BaseTable::operator=(std::move(other));
+                m_next_id_known = other.m_next_id_known;
+                m_next_id = other.m_next_id;
+                m_next_id_mod_txnid = other.m_next_id_mod_txnid;
+                m_next_id_abort_seq = other.m_next_id_abort_seq;
+                m_reserve_next.store(other.m_reserve_next.load(std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+                m_reserve_seeded.store(other.m_reserve_seeded.load(std::memory_order_acquire),
+                                       std::memory_order_release);
+            }
+            return *this;
+        }
+
         /// \brief Destructor.
         ~SequenceTable() override = default;
 
@@ -62,11 +120,9 @@ namespace mdbxc {
         /// \warning append() computes next id from current max key; concurrent
         ///          unsynchronized writers may race for the same next index.
         uint64_t append(const ValueT& value, MDBX_txn* txn = nullptr) {
-            uint64_t result = 0;
-            with_transaction([this, &value, &result](MDBX_txn* t) {
-                result = db_append(value, t);
-            }, TransactionMode::WRITABLE, txn);
-            return result;
+            uint64_t id = 0;
+            check_append_status(append_status(value, txn, id));
+            return id;
         }
 
         /// \brief Appends a value at the next available index using an external transaction.
@@ -77,6 +133,32 @@ namespace mdbxc {
             return append(value, txn.handle());
         }
 
+        /// \brief Appends a value at the next available index without throwing.
+        /// \param value Value to store.
+        /// \param txn Optional transaction handle.
+        /// \return Index assigned to the value, or the error that the throwing
+        ///         overload would raise.
+        Result<uint64_t> append(std::nothrow_t, const ValueT& value, MDBX_txn* txn = nullptr) noexcept {
+            try {
+                uint64_t id = 0;
+                const Status status = append_status(value, txn, id);
+                if (!status) {
+                    return Result<uint64_t>(status);
+                }
+                return Result<uint64_t>(id);
+            } catch (...) {
+                return Result<uint64_t>(Status::from_current_exception());
+            }
+        }
+
+        /// \brief Appends a value at the next available index without throwing.
+        /// \param value Value to store.
+        /// \param txn Active transaction wrapper.
+        /// \return Same as the \c MDBX_txn* overload.
+        Result<uint64_t> append(std::nothrow_t, const ValueT& value, const Transaction& txn) noexcept {
+            return append(std::nothrow, value, txn.handle());
+        }
+
         /// \brief Appends multiple values from a container.
         /// \tparam ContainerT Container type with const_iterator.
         /// \param values Source container of values.
@@ -87,9 +169,10 @@ namespace mdbxc {
         std::vector<uint64_t> append_many(const ContainerT& values, MDBX_txn* txn = nullptr) {
             std::vector<uint64_t> result;
             with_transaction([this, &values, &result](MDBX_txn* t) {
-                for (typename ContainerT::const_iterator it = values.begin();
-                     it != values.end(); ++it) {
-                    result.push_back(db_append(*it, t));
+                result.clear();
+                std::pair<uint64_t, uint64_t> ids = db_append_run(values.begin(), values.end(), t);
+                for (uint64_t id = ids.first; id != ids.second; ++id) {
+                    result.push_back(id);
                 }
             }, TransactionMode::WRITABLE, txn);
             return result;
@@ -105,6 +188,132 @@ namespace mdbxc {
             return append_many(values, txn.handle());
         }
 
+        /// \brief Appends a run of values at consecutive indices.
+        /// \tparam InputIt Input iterator over \c ValueT.
+        /// \param first Start of the value range.
+        /// \param last End of the value range.
+        /// \param txn Optional transaction handle.
+        /// \return Half-open index range <tt>[first_id, end_id)</tt> assigned to
+        ///         the values; <tt>(0, 0)</tt> for an empty input.
+        /// \throws std::overflow_error if the index space is exhausted.
+        /// \details The next index is looked up once for the whole run.
+        /// \warning Same concurrency warning as append().
+        template<class InputIt>
+        std::pair<uint64_t, uint64_t> append_many(InputIt first, InputIt last, MDBX_txn* txn = nullptr) {
+            std::pair<uint64_t, uint64_t> result(0, 0);
+            with_transaction([this, &first, &last, &result](MDBX_txn* t) {
+                result = db_append_run(first, last, t);
+            }, TransactionMode::WRITABLE, txn);
+            return result;
+        }
+
+        /// \brief Appends a run of values at consecutive indices using an external transaction.
+        /// \tparam InputIt Input iterator over \c ValueT.
+        /// \param first Start of the value range.
+        /// \param last End of the value range.
+        /// \param txn Active transaction wrapper.
+        /// \return Half-open index range assigned to the values.
+        template<class InputIt>
+        std::pair<uint64_t, uint64_t> append_many(InputIt first, InputIt last, const Transaction& txn) {
+            return append_many(first, last, txn.handle());
+        }
+
+        /// \brief Reserves consecutive indices without opening a write transaction.
+        /// \param count Number of indices to reserve.
+        /// \return Half-open index range <tt>[first_id, end_id)</tt>;
+        ///         <tt>(0, 0)</tt> when \p count is zero.
+        /// \throws std::overflow_error if the index space is exhausted.
+        /// \details The first call seeds an atomic counter from the last persisted
+        /// index; later calls only advance it with a compare-and-swap, so several
+        /// producer threads may reserve through one table instance. Reserved
+        /// indices are written with insert_reserved() in any order, e.g. through
+        /// \ref Config::group_commit. Once the counter is seeded, append() and
+        /// append_many() draw their indices from it as well, after moving it
+        /// past the last stored index inside their write transaction.
+        /// \note The counter lives in memory. Indices that are reserved but never
+        /// written, or written by a rolled back transaction, stay as holes.
+        /// Other table instances and processes do not see the counter, so ranges
+        /// reserved here may already be taken by their writes; insert_reserved()
+        /// then throws \c MDBX_KEYEXIST and moves the counter past the last stored
+        /// index. clear() resets the counter; reservations made before it should
+        /// not be written afterwards.
+        std::pair<uint64_t, uint64_t> reserve_ids(uint64_t count) {
+            if (count == 0) {
+                return std::make_pair(uint64_t(0), uint64_t(0));
+            }
+            seed_reservations();
+            uint64_t first_id = m_reserve_next.load(std::memory_order_relaxed);
+            do {
+                if (count > std::numeric_limits<uint64_t>::max() - first_id) {
+                    throw std::overflow_error("SequenceTable::reserve_ids: id overflow");
+                }
+            } while (!m_reserve_next.compare_exchange_weak(first_id, first_id + count,
+                                                           std::memory_order_relaxed));
+            return std::make_pair(first_id, first_id + count);
+        }
+
+        /// \brief Writes a value at an index obtained from reserve_ids().
+        /// \param id Reserved index.
+        /// \param value Value to store.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException with \c MDBX_KEYEXIST if \p id is already stored;
+        /// the reservation counter is then moved past the last stored index.
+        /// \details Uses \c MDBX_APPEND when \p id is past the last key and a
+        /// regular insert otherwise. Does not touch the next-id cache, so
+        /// producer threads may call it concurrently with their own transactions.
+        void insert_reserved(uint64_t id, const ValueT& value, MDBX_txn* txn = nullptr) {
+            with_transaction([this, id, &value](MDBX_txn* t) {
+                SerializeScratch sc_key;
+                detail::ScratchLease sc_value(m_connection->scratch_pool());
+                db_insert_reserved(id, value, sc_key, sc_value, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Writes a value at a reserved index using an external transaction.
+        /// \param id Reserved index.
+        /// \param value Value to store.
+        /// \param txn Active transaction wrapper.
+        /// \throws MdbxException with \c MDBX_KEYEXIST if \p id is already stored.
+        void insert_reserved(uint64_t id, const ValueT& value, const Transaction& txn) {
+            insert_reserved(id, value, txn.handle());
+        }
+
+        /// \brief Stores (index, value) pairs sorted by index using \c MDBX_APPEND.
+        /// \tparam ContainerT Container of \c std::pair<uint64_t,ValueT> with const_iterator,
+        /// such as \c std::map<uint64_t,ValueT> or a pre-sorted vector.
+        /// \param records Source records; indices must be ascending and greater than
+        /// the last index already stored in the table.
+        /// \param mode Reaction to out-of-order indices.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every record was written through the append fast path,
+        /// \c false if \ref BulkLoadMode::Fallback switched to regular writes.
+        /// \throws MdbxException with \c MDBX_EKEYMISMATCH in \ref BulkLoadMode::Strict
+        /// when an index is out of order, or on other database errors.
+        /// \note Records overwrite existing indices like \ref set().
+        template<class ContainerT>
+        bool bulk_load_sorted(const ContainerT& records,
+                              BulkLoadMode mode = BulkLoadMode::Fallback,
+                              MDBX_txn* txn = nullptr) {
+            bool appended = false;
+            with_transaction([this, &records, mode, &appended](MDBX_txn* t) {
+                appended = db_bulk_load_sorted(records, mode, t);
+            }, TransactionMode::WRITABLE, txn);
+            return appended;
+        }
+
+        /// \brief Stores (index, value) pairs sorted by index using \c MDBX_APPEND.
+        /// \tparam ContainerT Container of \c std::pair<uint64_t,ValueT> with const_iterator.
+        /// \param records Source records in ascending index order.
+        /// \param mode Reaction to out-of-order indices.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every record used the append fast path.
+        /// \throws MdbxException if an index is out of order in strict mode or a database error occurs.
+        template<class ContainerT>
+        bool bulk_load_sorted(const ContainerT& records, BulkLoadMode mode,
+                              const Transaction& txn) {
+            return bulk_load_sorted(records, mode, txn.handle());
+        }
+
         /// \brief Retrieves the value at the given index or throws.
         /// \param id Index to look up.
         /// \param txn Optional transaction handle.
@@ -272,6 +481,53 @@ namespace mdbxc {
             return erase(id, txn.handle());
         }
 
+        /// \brief Erases every record with an index lower than \p id, committing every \p chunk_size deletions.
+        /// \param id First index to keep.
+        /// \param chunk_size Maximum deletions per write transaction.
+        /// \param reclaim When \c true, forces a durable sync after the last chunk.
+        /// \return Erased record and chunk counts with table page and datafile sizes
+        ///         measured before and after the truncation.
+        /// \throws std::invalid_argument if \p chunk_size is zero.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        /// \throws MdbxException if a database error occurs.
+        /// \details Each chunk deletes from the first key with one cursor and runs in
+        /// its own write transaction, so the writer lock is released between chunks
+        /// and appends keep a bounded latency. Already committed chunks stay erased
+        /// if a later chunk fails. Freed pages go to the MDBX garbage collector;
+        /// in lazy durability modes they can only be recycled after a steady sync,
+        /// which \p reclaim requests. The datafile shrinks once trailing free space
+        /// exceeds \ref Config::shrink_threshold.
+        RetentionStats truncate_before(uint64_t id, std::size_t chunk_size = 4096,
+                                       bool reclaim = false) {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("truncate_before: chunk_size must be positive");
+            }
+            if (thread_txn()) {
+                throw std::logic_error("truncate_before: transaction already started for this thread.");
+            }
+            RetentionStats stats;
+            with_transaction([this, &stats](MDBX_txn* t) {
+                db_space_usage(stats.table_pages_before, stats.file_bytes_before, t);
+            }, TransactionMode::READ_ONLY);
+            for (;;) {
+                std::size_t removed = 0;
+                with_transaction([this, id, chunk_size, &removed](MDBX_txn* t) {
+                    removed = db_erase_prefix(id, chunk_size, t);
+                }, TransactionMode::WRITABLE);
+                if (removed == 0) break;
+                stats.removed += removed;
+                ++stats.chunks;
+                if (removed < chunk_size) break;
+            }
+            if (reclaim && stats.removed != 0) {
+                m_connection->sync_to_disk(true);
+            }
+            with_transaction([this, &stats](MDBX_txn* t) {
+                db_space_usage(stats.table_pages_after, stats.file_bytes_after, t);
+            }, TransactionMode::READ_ONLY);
+            return stats;
+        }
+
         /// \brief Removes all records from the table.
         /// \param txn Optional transaction handle.
         void clear(MDBX_txn* txn = nullptr) {
@@ -486,7 +742,49 @@ namespace mdbxc {
             return range(from, to, txn.handle());
         }
 
+        /// \brief Reads the next records of the table, waiting for commits if none exist yet.
+        /// \param from_id First index of interest (inclusive).
+        /// \param max_items Maximum number of records to return.
+        /// \param timeout Maximum time to wait for a record with index >= \p from_id.
+        /// \return Up to \p max_items (index, value) pairs in ascending index order;
+        ///         empty on timeout or when \p max_items is zero.
+        /// \details Each attempt reads in a fresh read-only transaction. While
+        /// nothing is found, the call sleeps in \ref Connection::wait_for_commit()
+        /// and retries as soon as a write transaction of this connection commits.
+        /// A consumer passes the last returned index + 1 as the next \p from_id.
+        /// \note Commits of raw \c MDBX_txn handles and of other processes do not
+        /// wake the waiter; they are seen on the next commit or after \p timeout.
+        /// If the calling thread has a bound transaction, its snapshot cannot
+        /// change, so the call returns after a single read.
+        template<class Rep, class Period>
+        std::vector<std::pair<uint64_t, ValueT>> tail(uint64_t from_id, std::size_t max_items,
+                                                       const std::chrono::duration<Rep, Period>& timeout) const {
+            std::vector<std::pair<uint64_t, ValueT>> result;
+            if (max_items == 0) return result;
+            const std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+            for (;;) {
+                const std::uint64_t seen = m_connection->commit_sequence();
+                with_transaction([this, from_id, max_items, &result](MDBX_txn* t) {
+                    db_tail(from_id, max_items, result, t);
+                }, TransactionMode::READ_ONLY);
+                if (!result.empty() || thread_txn()) return result;
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if (now >= deadline) return result;
+                m_connection->wait_for_commit(seen, deadline - now);
+            }
+        }
+
     private:
+        mutable bool     m_next_id_known = false;    ///< Whether \c m_next_id may be used.
+        mutable uint64_t m_next_id = 0;              ///< Cached next append index.
+        mutable uint64_t m_next_id_mod_txnid = 0;    ///< DBI modification txnid \c m_next_id reflects.
+        mutable uint64_t m_next_id_abort_seq = 0;    ///< Connection::abort_sequence() when \c m_next_id was cached.
+        std::atomic<bool>     m_reserve_seeded{false}; ///< Whether reserve_ids() seeded \c m_reserve_next.
+        std::atomic<uint64_t> m_reserve_next{0};       ///< Next index handed out by reserve_ids().
+        std::mutex            m_reserve_mutex;         ///< Serializes seeding of \c m_reserve_next.
+
         template<typename F>
         void with_transaction(F&& action, TransactionMode mode, MDBX_txn* txn = nullptr) const {
             if (txn) {
@@ -498,6 +796,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
 
             auto txn_guard = m_connection->transaction(mode);
             try {
@@ -509,6 +808,22 @@ namespace mdbxc {
             }
         }
 
+        /// \brief Shared core of the throwing and \c std::nothrow_t \c append().
+        Status append_status(const ValueT& value, MDBX_txn* txn, uint64_t& id) {
+            return with_transaction_status([this, &value, &id](MDBX_txn* t) {
+                return db_append(std::nothrow, value, t, id);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Throws for a failed append status; a lost index race keeps
+        /// its \c std::runtime_error.
+        static void check_append_status(const Status& status) {
+            if (status.code() == StatusCode::Conflict) {
+                throw std::runtime_error(status.context());
+            }
+            check_status(status);
+        }
+
         static uint64_t read_index_key(const MDBX_val& db_key) {
             if (!db_key.iov_base || db_key.iov_len != sizeof(uint64_t)) {
                 throw std::runtime_error("SequenceTable: invalid index key");
@@ -522,58 +837,329 @@ namespace mdbxc {
             return serialize_key<true>(id, sc);
         }
 
-        uint64_t db_append(const ValueT& value, MDBX_txn* txn) {
+        /// \brief Returns the next append index, from the cache when the DBI is unchanged.
+        /// \param cached Set to \c true when the cached index was used.
+        uint64_t next_append_id(MDBX_txn* txn, bool& cached) const {
             uint64_t next_id = 0;
-            MDBX_cursor* raw = nullptr;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw),
-                       "Failed to open cursor for append");
-            CursorGuard cursor(raw);
+            check_status(next_append_id(std::nothrow, txn, cached, next_id));
+            return next_id;
+        }
+
+        /// \brief Status-returning core of \ref next_append_id(MDBX_txn*, bool&) const.
+        Status next_append_id(std::nothrow_t, MDBX_txn* txn, bool& cached, uint64_t& next_id) const {
+            cached = false;
+            if (m_next_id_known) {
+                MDBX_stat stat;
+                const int rc = mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat));
+                if (rc != MDBX_SUCCESS) {
+                    return Status::from_mdbx(rc, "Failed to query statistics");
+                }
+                if (stat.ms_mod_txnid == m_next_id_mod_txnid &&
+                    m_connection->abort_sequence() == m_next_id_abort_seq) {
+                    cached = true;
+                    next_id = m_next_id;
+                    return Status();
+                }
+                m_next_id_known = false;
+            }
+            return read_next_id(std::nothrow, txn, next_id);
+        }
+
+        uint64_t read_next_id(MDBX_txn* txn) const {
+            uint64_t next_id = 0;
+            check_status(read_next_id(std::nothrow, txn, next_id));
+            return next_id;
+        }
 
+        /// \brief Reads the index following the last stored one into \p next_id.
+        /// \return Ok or the MDBX error of the cursor seek.
+        /// \throws std::overflow_error if the last index is the largest one.
+        Status read_next_id(std::nothrow_t, MDBX_txn* txn, uint64_t& next_id) const {
+            CachedCursor cursor(*this, txn);
             MDBX_val db_key, db_val;
             int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_LAST);
-            if (rc == MDBX_SUCCESS) {
-                uint64_t last_id = read_index_key(db_key);
+            if (rc == MDBX_NOTFOUND) {
+                next_id = 0;
+                return Status();
+            }
+            if (rc != MDBX_SUCCESS) {
+                return Status::from_mdbx(rc, "Failed to seek last key in SequenceTable");
+            }
+            uint64_t last_id = read_index_key(db_key);
+            if (last_id == std::numeric_limits<uint64_t>::max()) {
+                throw std::overflow_error("SequenceTable::append: id overflow");
+            }
+            next_id = last_id + 1;
+            return Status();
+        }
+
+        /// \brief Caches the index following \p last_id after a successful append.
+        void remember_next_id(uint64_t last_id, MDBX_txn* txn) const {
+            if (last_id == std::numeric_limits<uint64_t>::max()) {
+                m_next_id_known = false;
+                return;
+            }
+            m_next_id = last_id + 1;
+            m_next_id_mod_txnid = mdbx_txn_id(txn);
+            m_next_id_abort_seq = m_connection->abort_sequence();
+            m_next_id_known = true;
+        }
+
+        void forget_next_id() const {
+            m_next_id_known = false;
+        }
+
+        /// \brief Writes one record at \p id with \c MDBX_APPEND.
+        /// \return \c MDBX_SUCCESS, \c MDBX_EKEYMISMATCH when \p id is not past
+        ///         the last key, or another MDBX error of the put.
+        int put_append(uint64_t id, const ValueT& value, SerializeScratch& sc_key,
+                       SerializeScratch& sc_value, MDBX_txn* txn) {
+            MDBX_val db_key = make_key(id, sc_key);
+            MDBX_val db_val = serialize_value(value, sc_value);
+            int rc = mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT | MDBX_APPEND);
+            if (rc != MDBX_SUCCESS) {
+                return rc;
+            }
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put,
+                      db_key, db_val);
+#           endif
+            return rc;
+        }
+
+        /// \brief Appends one value at \p next_id, recomputing the index once if
+        /// the cached value fell behind the table.
+        uint64_t append_at(uint64_t next_id, bool cached, const ValueT& value,
+                           SerializeScratch& sc_key, SerializeScratch& sc_value, MDBX_txn* txn) {
+            check_append_status(append_at(std::nothrow, next_id, cached, value, sc_key, sc_value, txn));
+            return next_id;
+        }
+
+        /// \brief Status-returning core of \ref append_at(); \p next_id receives
+        /// the index written. A lost index race is \c StatusCode::Conflict.
+        Status append_at(std::nothrow_t, uint64_t& next_id, bool cached, const ValueT& value,
+                         SerializeScratch& sc_key, SerializeScratch& sc_value, MDBX_txn* txn) {
+            int rc = put_append(next_id, value, sc_key, sc_value, txn);
+            if (rc == MDBX_EKEYMISMATCH && cached) {
+                forget_next_id();
+                const Status status = read_next_id(std::nothrow, txn, next_id);
+                if (!status) return status;
+                rc = put_append(next_id, value, sc_key, sc_value, txn);
+            }
+            if (rc == MDBX_EKEYMISMATCH) {
+                return Status(StatusCode::Conflict,
+                              "SequenceTable::append: computed next index already exists; "
+                              "concurrent append requires external synchronization or retry",
+                              rc);
+            }
+            return Status::from_mdbx(rc, "Failed to append value");
+        }
+
+        /// \brief Seeds the reservation counter from the last persisted index once.
+        void seed_reservations() {
+            if (m_reserve_seeded.load(std::memory_order_acquire)) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(m_reserve_mutex);
+            if (m_reserve_seeded.load(std::memory_order_relaxed)) {
+                return;
+            }
+            uint64_t next_id = 0;
+            with_transaction([this, &next_id](MDBX_txn* t) {
+                next_id = read_next_id(t);
+            }, TransactionMode::READ_ONLY);
+            m_reserve_next.store(next_id, std::memory_order_relaxed);
+            m_reserve_seeded.store(true, std::memory_order_release);
+        }
+
+        /// \brief Drops the reservation counter; the next reserve_ids() seeds it again.
+        void reset_reservations() {
+            std::lock_guard<std::mutex> lock(m_reserve_mutex);
+            m_reserve_seeded.store(false, std::memory_order_release);
+            m_reserve_next.store(0, std::memory_order_relaxed);
+        }
+
+        /// \brief Moves the reservation counter past an index written directly.
+        void advance_reservations(uint64_t id) {
+            raise_reservations(id == std::numeric_limits<uint64_t>::max() ? id : id + 1);
+        }
+
+        /// \brief Moves the reservation counter past the last index stored in \p txn.
+        void sync_reservations(MDBX_txn* txn) {
+            check_status(sync_reservations(std::nothrow, txn));
+        }
+
+        /// \brief Status-returning core of \ref sync_reservations(MDBX_txn*).
+        Status sync_reservations(std::nothrow_t, MDBX_txn* txn) {
+            uint64_t next_id = 0;
+            const Status status = read_next_id(std::nothrow, txn, next_id);
+            if (status) {
+                raise_reservations(next_id);
+            }
+            return status;
+        }
+
+        /// \brief Raises the reservation counter to at least \p next_id.
+        void raise_reservations(uint64_t next_id) {
+            if (!m_reserve_seeded.load(std::memory_order_acquire)) {
+                return;
+            }
+            uint64_t current = m_reserve_next.load(std::memory_order_relaxed);
+            while (current < next_id &&
+                   !m_reserve_next.compare_exchange_weak(current, next_id,
+                                                         std::memory_order_relaxed)) {
+            }
+        }
+
+        void db_insert_reserved(uint64_t id, const ValueT& value, SerializeScratch& sc_key,
+                                SerializeScratch& sc_value, MDBX_txn* txn) {
+            check_status(db_insert_reserved(std::nothrow, id, value, sc_key, sc_value, txn));
+        }
+
+        /// \brief Status-returning core of \ref db_insert_reserved(); an index
+        /// stored already is \c StatusCode::KeyExists.
+        Status db_insert_reserved(std::nothrow_t, uint64_t id, const ValueT& value,
+                                  SerializeScratch& sc_key, SerializeScratch& sc_value,
+                                  MDBX_txn* txn) {
+            MDBX_val db_key = make_key(id, sc_key);
+            MDBX_val db_val = serialize_value(value, sc_value);
+            int rc = mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_NOOVERWRITE | MDBX_APPEND);
+            if (rc == MDBX_EKEYMISMATCH) {
+                rc = mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_NOOVERWRITE);
+            }
+            if (rc == MDBX_KEYEXIST) {
+                // Written by another instance or process; skip past it for later reservations.
+                const Status synced = sync_reservations(std::nothrow, txn);
+                if (!synced) return synced;
+            }
+            if (rc != MDBX_SUCCESS) {
+                return Status::from_mdbx(rc, "Failed to insert value at reserved index");
+            }
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put,
+                      db_key, db_val);
+#           endif
+            return Status();
+        }
+
+        template<class ForwardIt>
+        std::pair<uint64_t, uint64_t> db_append_reserved_run(ForwardIt first, ForwardIt last,
+                                                             MDBX_txn* txn,
+                                                             std::forward_iterator_tag) {
+            sync_reservations(txn);
+            std::pair<uint64_t, uint64_t> ids =
+                reserve_ids(static_cast<uint64_t>(std::distance(first, last)));
+            SerializeScratch sc_key;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
+            for (uint64_t id = ids.first; first != last; ++first, ++id) {
+                db_insert_reserved(id, *first, sc_key, sc_value, txn);
+            }
+            return ids;
+        }
+
+        template<class InputIt>
+        std::pair<uint64_t, uint64_t> db_append_reserved_run(InputIt first, InputIt last,
+                                                             MDBX_txn* txn,
+                                                             std::input_iterator_tag) {
+            std::vector<ValueT> values(first, last);
+            return db_append_reserved_run(values.begin(), values.end(), txn,
+                                          std::forward_iterator_tag());
+        }
+
+        /// \brief Appends one value; \p id receives its index.
+        /// \return Ok or the MDBX error; see \ref append_at() and
+        ///         \ref db_insert_reserved() for the other codes.
+        Status db_append(std::nothrow_t, const ValueT& value, MDBX_txn* txn, uint64_t& id) {
+            if (m_reserve_seeded.load(std::memory_order_acquire)) {
+                const Status synced = sync_reservations(std::nothrow, txn);
+                if (!synced) return synced;
+                id = reserve_ids(1).first;
+                SerializeScratch sc_key;
+                detail::ScratchLease sc_value(m_connection->scratch_pool());
+                return db_insert_reserved(std::nothrow, id, value, sc_key, sc_value, txn);
+            }
+            bool cached = false;
+            Status status = next_append_id(std::nothrow, txn, cached, id);
+            if (!status) return status;
+            SerializeScratch sc_key;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
+            status = append_at(std::nothrow, id, cached, value, sc_key, sc_value, txn);
+            if (status) {
+                remember_next_id(id, txn);
+            }
+            return status;
+        }
+
+        template<class InputIt>
+        std::pair<uint64_t, uint64_t> db_append_run(InputIt first, InputIt last, MDBX_txn* txn) {
+            if (first == last) {
+                return std::make_pair(uint64_t(0), uint64_t(0));
+            }
+            if (m_reserve_seeded.load(std::memory_order_acquire)) {
+                return db_append_reserved_run(
+                    first, last, txn,
+                    typename std::iterator_traits<InputIt>::iterator_category());
+            }
+            bool cached = false;
+            uint64_t next_id = next_append_id(txn, cached);
+            SerializeScratch sc_key;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
+            const uint64_t first_id = append_at(next_id, cached, *first, sc_key, sc_value, txn);
+            uint64_t last_id = first_id;
+            for (++first; first != last; ++first) {
                 if (last_id == std::numeric_limits<uint64_t>::max()) {
+                    forget_next_id();
                     throw std::overflow_error("SequenceTable::append: id overflow");
                 }
-                next_id = last_id + 1;
-            } else if (rc != MDBX_NOTFOUND) {
-                check_mdbx(rc, "Failed to seek last key in SequenceTable");
+                last_id = append_at(last_id + 1, false, *first, sc_key, sc_value, txn);
             }
-            cursor.close();
+            remember_next_id(last_id, txn);
+            return std::make_pair(first_id, last_id + 1);
+        }
 
+        template<class ContainerT>
+        bool db_bulk_load_sorted(const ContainerT& records, BulkLoadMode mode, MDBX_txn* txn) {
+            forget_next_id();
             SerializeScratch sc_key;
-            SerializeScratch sc_value;
-            db_key = make_key(next_id, sc_key);
-            db_val = serialize_value(value, sc_value);
-            rc = mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_NOOVERWRITE);
-            if (rc == MDBX_KEYEXIST) {
-                throw std::runtime_error(
-                    "SequenceTable::append: computed next index already exists; "
-                    "concurrent append requires external synchronization or retry"
-                );
-            }
-            check_mdbx(rc, "Failed to append value");
-            {
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
+            bool appending = true;
+            for (typename ContainerT::const_iterator it = records.begin();
+                 it != records.end(); ++it) {
+                MDBX_val db_key = make_key(it->first, sc_key);
+                MDBX_val db_val = serialize_value(it->second, sc_value);
+                int rc = appending
+                    ? mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT | MDBX_APPEND)
+                    : mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT);
+                if (appending && rc == MDBX_EKEYMISMATCH) {
+                    if (mode == BulkLoadMode::Strict) {
+                        check_mdbx(rc, "bulk_load_sorted: index is not greater than the last table index");
+                    }
+                    appending = false;
+                    rc = mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT);
+                }
+                check_mdbx(rc, "Failed to set value");
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), capture_bytes(db_val));
+                          db_key, db_val);
 #               endif
+                advance_reservations(it->first);
             }
-            return next_id;
+            return appending;
         }
 
         void db_set(uint64_t id, const ValueT& value, MDBX_txn* txn) {
+            forget_next_id();
             SerializeScratch sc_key;
-            SerializeScratch sc_value;
+            detail::ScratchLease sc_value(m_connection->scratch_pool());
             MDBX_val db_key = make_key(id, sc_key);
             MDBX_val db_val = serialize_value(value, sc_value);
             check_mdbx(mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT),
                        "Failed to set value");
 #           if MDBXC_SYNC_ENABLED
             record_op(txn, sync::ChangeOpType::Put,
-                      capture_bytes(db_key), capture_bytes(db_val));
+                      db_key, db_val);
 #           endif
+            advance_reservations(id);
         }
 
         bool db_get(uint64_t id, ValueT& out, MDBX_txn* txn) const {
@@ -599,13 +1185,14 @@ namespace mdbxc {
         }
 
         bool db_erase(uint64_t id, MDBX_txn* txn) {
+            forget_next_id();
             SerializeScratch sc_key;
             MDBX_val db_key = make_key(id, sc_key);
             int rc = mdbx_del(txn, m_dbi, &db_key, nullptr);
             if (rc == MDBX_SUCCESS) {
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn, sync::ChangeOpType::Delete,
-                          capture_bytes(db_key), {});
+                          db_key, MDBX_val());
 #               endif
                 return true;
             }
@@ -614,10 +1201,49 @@ namespace mdbxc {
             return false;
         }
 
+        std::size_t db_erase_prefix(uint64_t id, std::size_t limit, MDBX_txn* txn) {
+            forget_next_id();
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key, db_val;
+            std::size_t removed = 0;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
+            while (rc == MDBX_SUCCESS) {
+                if (read_index_key(db_key) >= id) return removed;
+#               if MDBXC_SYNC_ENABLED
+                const std::vector<std::uint8_t> kbytes = capture_bytes(db_key);
+#               endif
+                check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT),
+                           "Failed to erase sequence prefix");
+#               if MDBXC_SYNC_ENABLED
+                record_op(txn, sync::ChangeOpType::Delete, kbytes, MDBX_val());
+#               endif
+                if (++removed == limit) return removed;
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to erase sequence prefix");
+            }
+            return removed;
+        }
+
+        void db_space_usage(std::uint64_t& table_pages, std::uint64_t& file_bytes,
+                            MDBX_txn* txn) const {
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat)),
+                       "Failed to query statistics");
+            table_pages = stat.ms_branch_pages + stat.ms_leaf_pages + stat.ms_overflow_pages;
+            MDBX_envinfo info;
+            check_mdbx(mdbx_env_info_ex(m_connection->env_handle(), txn, &info, sizeof(info)),
+                       "Failed to query environment info");
+            file_bytes = info.mi_geo.current;
+        }
+
         void db_clear(MDBX_txn* txn) {
+            forget_next_id();
+            reset_reservations();
             check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear SequenceTable");
 #           if MDBXC_SYNC_ENABLED
-            record_op(txn, sync::ChangeOpType::ClearTable, {}, {});
+            record_op(txn, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
 #           endif
         }
 
@@ -698,6 +1324,24 @@ namespace mdbxc {
             }
         }
 
+        void db_tail(uint64_t from_id, std::size_t max_items,
+                     std::vector<std::pair<uint64_t, ValueT>>& out, MDBX_txn* txn) const {
+            CachedCursor cursor(*this, txn);
+            SerializeScratch sc_key;
+            MDBX_val db_key = make_key(from_id, sc_key);
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                out.push_back(std::make_pair(read_index_key(db_key),
+                                             deserialize_value<ValueT>(db_val)));
+                if (out.size() >= max_items) return;
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to iterate tail");
+            }
+        }
+
         std::vector<std::pair<uint64_t, ValueT>> db_range(uint64_t from, uint64_t to,
                                                            MDBX_txn* txn) const {
             std::vector<std::pair<uint64_t, ValueT>> result;
@@ -0,0 +1,201 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SHARDED_KEY_VALUE_TABLE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SHARDED_KEY_VALUE_TABLE_HPP_INCLUDED
+
+/// \file ShardedKeyValueTable.hpp
+/// \brief Map-like table partitioned by key hash over a \ref ShardedConnection.
+
+#include "KeyValueTable.hpp"
+#include "common/ShardedConnection.hpp"
+
+namespace mdbxc {
+
+    /// \class ShardedKeyValueTable
+    /// \ingroup mdbxc_tables
+    /// \brief \ref KeyValueTable spread over the shards of a \ref ShardedConnection.
+    /// \tparam KeyT Type of the keys.
+    /// \tparam ValueT Type of the values.
+    /// \tparam Hasher Callable taking \ref ByteView and returning a 64-bit hash.
+    /// \tparam Options Compile-time table policy, as for \ref KeyValueTable.
+    /// \details
+    /// Each key is stored in shard <tt>Hasher(serialized key) % shard_count()</tt>.
+    /// Point operations run on the owning shard only, so writers that hit
+    /// different shards commit in parallel. Whole-table operations scatter
+    /// to every shard in parallel and gather the results.
+    ///
+    /// \note There is no cross-shard transaction. Batch writes commit once per
+    ///       shard; a failure can leave some shards written and others not.
+    /// \warning The hasher and shard count decide where existing keys live;
+    ///          changing either makes stored keys unreachable.
+    template<class KeyT, class ValueT, class Hasher = XXH3Hasher,
+             class Options = DefaultTableOptions>
+    class ShardedKeyValueTable {
+    public:
+        typedef KeyValueTable<KeyT, ValueT, Options> shard_table;
+        typedef std::pair<KeyT, ValueT> value_type;
+
+        /// \brief Opens table \p name in every shard.
+        /// \param connection Sharded connection.
+        /// \param name Name of the table within each shard environment.
+        /// \param hasher Hashing strategy used for routing.
+        /// \param flags Additional MDBX database flags for table creation.
+        explicit ShardedKeyValueTable(std::shared_ptr<ShardedConnection> connection,
+                                      std::string name = "kv_store",
+                                      Hasher hasher = Hasher(),
+                                      MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : m_connection(std::move(connection)),
+              m_hasher(std::move(hasher)) {
+            m_tables.reserve(m_connection->shard_count());
+            for (std::size_t i = 0; i < m_connection->shard_count(); ++i) {
+                m_tables.emplace_back(new shard_table(m_connection->shard(i), name, flags));
+            }
+        }
+
+        /// \brief Returns the sharded connection.
+        const std::shared_ptr<ShardedConnection>& connection() const noexcept { return m_connection; }
+
+        /// \brief Returns the number of shards.
+        std::size_t shard_count() const noexcept { return m_tables.size(); }
+
+        /// \brief Returns the index of the shard that stores \p key.
+        std::size_t shard_of(const KeyT& key) const {
+            SerializeScratch sc;
+            const MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc);
+            const std::uint64_t hash = m_hasher(ByteView(db_key.iov_base, db_key.iov_len));
+            return static_cast<std::size_t>(hash % m_tables.size());
+        }
+
+        /// \brief Returns the table of shard \p index.
+        /// \details Use it with \c connection()->shard(i)->transaction() to
+        ///          group several writes to one shard into a single transaction.
+        shard_table& shard(std::size_t index) { return *m_tables.at(index); }
+
+        /// \brief Returns the table of shard \p index.
+        const shard_table& shard(std::size_t index) const { return *m_tables.at(index); }
+
+        /// \brief Inserts \p value if \p key is absent, see \c KeyValueTable::insert().
+        bool insert(const KeyT& key, const ValueT& value) {
+            return owner(key).insert(key, value);
+        }
+
+        /// \brief Inserts or replaces the value of \p key.
+        void insert_or_assign(const KeyT& key, const ValueT& value) {
+            owner(key).insert_or_assign(key, value);
+        }
+
+        /// \brief Upserts \p pairs, writing all shards in parallel.
+        /// \details Pairs are partitioned by shard and every shard commits its
+        /// part in one write transaction. Later pairs win over earlier pairs
+        /// with the same key.
+        /// \throws MdbxException if a database error occurs; shards that
+        ///         committed before the failure keep their writes.
+        void insert_or_assign(const std::vector<value_type>& pairs) {
+            std::vector<std::vector<const value_type*>> parts(m_tables.size());
+            for (std::size_t i = 0; i < pairs.size(); ++i) {
+                parts[shard_of(pairs[i].first)].push_back(&pairs[i]);
+            }
+            m_connection->for_each_shard([this, &parts](std::size_t index) {
+                const std::vector<const value_type*>& part = parts[index];
+                if (part.empty()) return;
+                shard_table& table = *m_tables[index];
+                Transaction txn = m_connection->shard(index)->transaction();
+                for (std::size_t i = 0; i < part.size(); ++i) {
+                    table.insert_or_assign(part[i]->first, part[i]->second, txn);
+                }
+                txn.commit();
+            });
+        }
+
+        /// \brief Returns the value of \p key.
+        /// \throws std::out_of_range if the key is absent.
+        ValueT at(const KeyT& key) const {
+            return owner(key).at(key);
+        }
+
+#       if __cplusplus >= 201703L
+        /// \brief Finds the value of \p key.
+        std::optional<ValueT> find(const KeyT& key) const {
+            return owner(key).find(key);
+        }
+#       else
+        /// \brief Finds the value of \p key.
+        /// \return Pair of success flag and value.
+        std::pair<bool, ValueT> find(const KeyT& key) const {
+            return owner(key).find(key);
+        }
+#       endif
+
+        /// \brief Checks whether \p key is stored.
+        bool contains(const KeyT& key) const {
+            return owner(key).contains(key);
+        }
+
+        /// \brief Removes \p key.
+        /// \return \c true if the key was present.
+        bool erase(const KeyT& key) {
+            return owner(key).erase(key);
+        }
+
+        /// \brief Returns the number of records over all shards.
+        /// \note Each shard is counted in its own snapshot.
+        std::size_t count() const {
+            std::vector<std::size_t> counts(m_tables.size(), 0);
+            m_connection->for_each_shard([this, &counts](std::size_t index) {
+                counts[index] = m_tables[index]->count();
+            });
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < counts.size(); ++i) total += counts[i];
+            return total;
+        }
+
+        /// \brief Removes every record from every shard.
+        void clear() {
+            m_connection->for_each_shard([this](std::size_t index) {
+                m_tables[index]->clear();
+            });
+        }
+
+        /// \brief Retrieves pairs within an inclusive key range from all shards.
+        /// \param from_key Start key in MDBX key order.
+        /// \param to_key End key in MDBX key order.
+        /// \return Pairs of every shard merged into one \c std::map.
+        /// \note Shards are scanned in parallel, each in its own snapshot.
+        std::map<KeyT, ValueT> range(const KeyT& from_key, const KeyT& to_key) const {
+            return gather([&from_key, &to_key](shard_table& table) {
+                return table.range(from_key, to_key);
+            });
+        }
+
+        /// \brief Retrieves every pair from all shards.
+        /// \note Shards are scanned in parallel, each in its own snapshot.
+        std::map<KeyT, ValueT> retrieve_all() const {
+            return gather([](shard_table& table) {
+                return table.template retrieve_all<std::map>();
+            });
+        }
+
+    private:
+        std::shared_ptr<ShardedConnection> m_connection;
+        std::vector<std::unique_ptr<shard_table>> m_tables;
+        Hasher m_hasher;
+
+        shard_table& owner(const KeyT& key) { return *m_tables[shard_of(key)]; }
+        const shard_table& owner(const KeyT& key) const { return *m_tables[shard_of(key)]; }
+
+        template<typename ScanT>
+        std::map<KeyT, ValueT> gather(ScanT scan) const {
+            std::vector<std::map<KeyT, ValueT>> parts(m_tables.size());
+            m_connection->for_each_shard([this, &parts, &scan](std::size_t index) {
+                parts[index] = scan(*m_tables[index]);
+            });
+            std::map<KeyT, ValueT> result;
+            for (std::size_t i = 0; i < parts.size(); ++i) {
+                result.insert(parts[i].begin(), parts[i].end());
+            }
+            return result;
+        }
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SHARDED_KEY_VALUE_TABLE_HPP_INCLUDED
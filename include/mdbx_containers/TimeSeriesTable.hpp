@@ -0,0 +1,799 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_TIME_SERIES_TABLE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_TIME_SERIES_TABLE_HPP_INCLUDED
+
+/// \file TimeSeriesTable.hpp
+/// \brief Time series stored as compressed, time-bucketed columnar chunks.
+/// \details
+/// Groups the points of one time bucket into a single MDBX record. Inside a
+/// record, timestamps form one column of delta-of-delta varints and each
+/// 8-byte word of the value forms one column XORed with the previous row,
+/// so regular sampling and slowly changing values take a few bytes per point
+/// instead of one B-tree entry each.
+
+#include "common.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \struct TimeSeriesPoint
+    /// \brief One timestamped value of a \ref TimeSeriesTable.
+    template<class T>
+    struct TimeSeriesPoint {
+        std::uint64_t timestamp = 0;
+        T             value = T();
+
+        TimeSeriesPoint() = default;
+        TimeSeriesPoint(std::uint64_t ts, const T& v) : timestamp(ts), value(v) {}
+    };
+
+    /// \struct TimeSeriesAggregate
+    /// \brief Summary of the points of one downsampling step.
+    struct TimeSeriesAggregate {
+        std::uint64_t start = 0; ///< First timestamp of the step; a multiple of the step width.
+        std::size_t   count = 0; ///< Points in the step.
+        double        min = 0;
+        double        max = 0;
+        double        sum = 0;
+        double        first = 0; ///< Value of the earliest point.
+        double        last = 0;  ///< Value of the latest point.
+
+        /// \brief Returns the mean value of the step.
+        double mean() const { return count ? sum / static_cast<double>(count) : 0.0; }
+    };
+
+    namespace detail {
+
+        /// \brief Index of the lowest set bit of a non-zero \p x.
+        inline unsigned series_ctz64(std::uint64_t x) noexcept {
+#       if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_ctzll(x));
+#       else
+            unsigned n = 0;
+            while ((x & 1) == 0) {
+                x >>= 1;
+                ++n;
+            }
+            return n;
+#       endif
+        }
+
+        /// \brief Columnar chunk of a \ref TimeSeriesTable.
+        /// \details Layout, in host byte order:
+        /// - \c u32 row count, \c u32 column count (words + 1);
+        /// - \c u64 first timestamp, \c u64 last timestamp, \c u64 last delta;
+        /// - \c u64 last row, one per word;
+        /// - \c u32 byte size of each column;
+        /// - the timestamp column, then one column per word.
+        ///
+        /// The first row stores no timestamp; later rows store the ZigZag
+        /// varint of the change between consecutive deltas. A word is stored
+        /// as the count of trailing zero bits of its XOR with the previous
+        /// row (64 when equal) followed by the varint of the shifted XOR.
+        /// The header keeps the encoder state, so rows that are not older
+        /// than the last one are appended without decoding the chunk.
+        class SeriesChunk {
+        public:
+            explicit SeriesChunk(std::size_t words)
+                : m_last_words(words, 0), m_columns(words + 1) {}
+
+            static std::size_t header_size(std::size_t words) noexcept {
+                return 32 + 8 * words + 4 * (words + 1);
+            }
+
+            std::uint32_t count() const noexcept { return m_count; }
+            std::uint64_t first_timestamp() const noexcept { return m_first; }
+            std::uint64_t last_timestamp() const noexcept { return m_last; }
+
+            /// \brief Reads the row count and the timestamp bounds of encoded chunk bytes.
+            /// \throws std::runtime_error if the header is malformed.
+            static void read_header(const MDBX_val& data, std::size_t words, std::uint32_t& count,
+                                    std::uint64_t& first, std::uint64_t& last) {
+                check_header(data, words);
+                const std::uint8_t* p = static_cast<const std::uint8_t*>(data.iov_base);
+                std::memcpy(&count, p, 4);
+                std::memcpy(&first, p + 8, 8);
+                std::memcpy(&last, p + 16, 8);
+            }
+
+            /// \brief Replaces the contents with encoded chunk bytes.
+            /// \throws std::runtime_error if the chunk is malformed.
+            void load(const MDBX_val& data) {
+                const std::size_t words = m_last_words.size();
+                const std::uint8_t* p = column_sizes(data, words);
+                const std::uint8_t* base = static_cast<const std::uint8_t*>(data.iov_base);
+                std::memcpy(&m_count, base, 4);
+                std::memcpy(&m_first, base + 8, 8);
+                std::memcpy(&m_last, base + 16, 8);
+                std::memcpy(&m_last_delta, base + 24, 8);
+                std::memcpy(m_last_words.data(), base + 32, 8 * words);
+                const std::uint8_t* column = base + header_size(words);
+                for (std::size_t i = 0; i < m_columns.size(); ++i) {
+                    std::uint32_t size = 0;
+                    std::memcpy(&size, p + 4 * i, 4);
+                    m_columns[i].assign(column, column + size);
+                    column += size;
+                }
+            }
+
+            /// \brief Appends one row.
+            /// \pre The chunk is empty or \p timestamp is not below \ref last_timestamp().
+            void append(std::uint64_t timestamp, const std::uint64_t* row) {
+                std::uint8_t buf[10];
+                if (m_count == 0) {
+                    m_first = timestamp;
+                    m_last_delta = 0;
+                } else {
+                    const std::uint64_t delta = timestamp - m_last;
+                    const std::int64_t dod = static_cast<std::int64_t>(delta - m_last_delta);
+                    std::uint8_t* end = compact::write_varint(compact::zigzag_encode(dod), buf);
+                    m_columns[0].insert(m_columns[0].end(), buf, end);
+                    m_last_delta = delta;
+                }
+                m_last = timestamp;
+                for (std::size_t i = 0; i < m_last_words.size(); ++i) {
+                    std::vector<std::uint8_t>& column = m_columns[i + 1];
+                    const std::uint64_t x = row[i] ^ m_last_words[i];
+                    if (x == 0) {
+                        column.push_back(64);
+                        continue;
+                    }
+                    const unsigned tz = series_ctz64(x);
+                    column.push_back(static_cast<std::uint8_t>(tz));
+                    std::uint8_t* end = compact::write_varint(x >> tz, buf);
+                    column.insert(column.end(), buf, end);
+                    m_last_words[i] = row[i];
+                }
+                ++m_count;
+            }
+
+            /// \brief Encodes the chunk into \p out and returns a view of it.
+            MDBX_val encode(std::vector<std::uint8_t>& out) const {
+                const std::size_t words = m_last_words.size();
+                std::size_t size = header_size(words);
+                for (std::size_t i = 0; i < m_columns.size(); ++i) size += m_columns[i].size();
+                out.resize(size);
+                std::uint8_t* p = out.data();
+                const std::uint32_t columns = static_cast<std::uint32_t>(m_columns.size());
+                std::memcpy(p, &m_count, 4);
+                std::memcpy(p + 4, &columns, 4);
+                std::memcpy(p + 8, &m_first, 8);
+                std::memcpy(p + 16, &m_last, 8);
+                std::memcpy(p + 24, &m_last_delta, 8);
+                std::memcpy(p + 32, m_last_words.data(), 8 * words);
+                std::uint8_t* sizes = p + 32 + 8 * words;
+                std::uint8_t* column = p + header_size(words);
+                for (std::size_t i = 0; i < m_columns.size(); ++i) {
+                    const std::uint32_t column_size = static_cast<std::uint32_t>(m_columns[i].size());
+                    std::memcpy(sizes + 4 * i, &column_size, 4);
+                    if (column_size) std::memcpy(column, m_columns[i].data(), column_size);
+                    column += column_size;
+                }
+                MDBX_val val;
+                val.iov_base = out.data();
+                val.iov_len = out.size();
+                return val;
+            }
+
+            /// \brief Decodes encoded chunk bytes row by row.
+            /// \param visit Invoked as \c visit(timestamp, const std::uint64_t* row);
+            ///        return \c false to stop.
+            /// \return \c false if \p visit stopped the walk.
+            /// \throws std::runtime_error if the chunk is malformed.
+            template<typename VisitorT>
+            static bool decode(const MDBX_val& data, std::size_t words, VisitorT&& visit) {
+                const std::uint8_t* p = column_sizes(data, words);
+                const std::uint8_t* base = static_cast<const std::uint8_t*>(data.iov_base);
+                std::uint32_t count = 0;
+                std::uint64_t ts = 0;
+                std::memcpy(&count, base, 4);
+                std::memcpy(&ts, base + 8, 8);
+                std::vector<const std::uint8_t*> pos(words + 1);
+                std::vector<const std::uint8_t*> end(words + 1);
+                const std::uint8_t* column = base + header_size(words);
+                for (std::size_t i = 0; i <= words; ++i) {
+                    std::uint32_t size = 0;
+                    std::memcpy(&size, p + 4 * i, 4);
+                    pos[i] = column;
+                    column += size;
+                    end[i] = column;
+                }
+                std::vector<std::uint64_t> row(words, 0);
+                std::uint64_t delta = 0;
+                for (std::uint32_t r = 0; r < count; ++r) {
+                    if (r != 0) {
+                        delta += static_cast<std::uint64_t>(
+                            compact::zigzag_decode(compact::read_varint(pos[0], end[0])));
+                        ts += delta;
+                    }
+                    for (std::size_t i = 0; i < words; ++i) {
+                        if (pos[i + 1] == end[i + 1]) corrupted();
+                        const unsigned tz = *pos[i + 1]++;
+                        if (tz == 64) continue;
+                        if (tz > 63) corrupted();
+                        row[i] ^= compact::read_varint(pos[i + 1], end[i + 1]) << tz;
+                    }
+                    if (!visit(ts, static_cast<const std::uint64_t*>(row.data()))) return false;
+                }
+                for (std::size_t i = 0; i <= words; ++i) {
+                    if (pos[i] != end[i]) corrupted();
+                }
+                return true;
+            }
+
+        private:
+            std::uint32_t                          m_count = 0;
+            std::uint64_t                          m_first = 0;
+            std::uint64_t                          m_last = 0;
+            std::uint64_t                          m_last_delta = 0;
+            std::vector<std::uint64_t>             m_last_words;
+            std::vector<std::vector<std::uint8_t>> m_columns;
+
+            [[noreturn]] static void corrupted() {
+                throw std::runtime_error("TimeSeriesTable: corrupted chunk");
+            }
+
+            static void check_header(const MDBX_val& data, std::size_t words) {
+                if (data.iov_len < header_size(words)) corrupted();
+                std::uint32_t columns = 0;
+                std::memcpy(&columns, static_cast<const std::uint8_t*>(data.iov_base) + 4, 4);
+                if (columns != words + 1) corrupted();
+            }
+
+            /// \brief Validates the column sizes and returns a pointer to them.
+            static const std::uint8_t* column_sizes(const MDBX_val& data, std::size_t words) {
+                check_header(data, words);
+                const std::uint8_t* p = static_cast<const std::uint8_t*>(data.iov_base) + 32 + 8 * words;
+                std::size_t total = header_size(words);
+                for (std::size_t i = 0; i <= words; ++i) {
+                    std::uint32_t size = 0;
+                    std::memcpy(&size, p + 4 * i, 4);
+                    total += size;
+                }
+                if (total != data.iov_len) corrupted();
+                return p;
+            }
+        };
+
+    } // namespace detail
+
+    /// \class TimeSeriesTable
+    /// \ingroup mdbxc_tables
+    /// \brief Append-optimized time series of fixed-size values.
+    /// \tparam T Trivially copyable value type, e.g. a tick struct or a \c double.
+    /// \details
+    /// Points are grouped into chunks covering \c chunk_span timestamp units;
+    /// each chunk is one MDBX record keyed by the first timestamp of its
+    /// span. Timestamps are unsigned integers in units chosen by the caller.
+    /// Appending points that are not older than the last point of their
+    /// chunk extends the encoded columns without decoding them; older points
+    /// make the chunk be decoded, merged and re-encoded. Points with equal
+    /// timestamps are kept in insertion order.
+    ///
+    /// Range reads seek to the chunk holding \c from and decode only chunks
+    /// overlapping the range; \c count() reads only chunk headers. Values
+    /// are compared word by word, so zero the padding of struct values to
+    /// keep their XOR columns small.
+    ///
+    /// The chunk span is not stored; reopen a table with the span it was
+    /// written with. With sync capture, writes are recorded as puts and
+    /// deletes of whole chunks.
+    template<class T>
+    class TimeSeriesTable final : public BaseTable {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "TimeSeriesTable requires a trivially copyable value type");
+    public:
+        typedef TimeSeriesPoint<T> point_type;
+
+        /// \brief Constructs table using existing connection.
+        /// \param connection Existing connection.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param chunk_span Timestamp units covered by one chunk.
+        /// \param flags Additional MDBX database flags.
+        /// \throws std::invalid_argument if \p chunk_span is zero.
+        TimeSeriesTable(std::shared_ptr<Connection> connection,
+                        std::string name = "time_series",
+                        std::uint64_t chunk_span = 60000,
+                        MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : BaseTable(std::move(connection),
+                        std::move(name),
+                        flags | get_mdbx_flags<std::uint64_t>()),
+              m_chunk_span(validate_span(chunk_span)) {}
+
+        /// \brief Constructs table using configuration.
+        /// \param config Configuration settings.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param chunk_span Timestamp units covered by one chunk.
+        /// \param flags Additional MDBX database flags.
+        explicit TimeSeriesTable(const Config& config,
+                                 std::string name = "time_series",
+                                 std::uint64_t chunk_span = 60000,
+                                 MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : TimeSeriesTable(Connection::create(config), std::move(name), chunk_span, flags) {}
+
+        /// \brief Destructor.
+        ~TimeSeriesTable() override = default;
+
+        /// \brief Returns the timestamp units covered by one chunk.
+        std::uint64_t chunk_span() const noexcept { return m_chunk_span; }
+
+        /// \brief Appends one point.
+        /// \param timestamp Timestamp of the point.
+        /// \param value Value of the point.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs.
+        void append(std::uint64_t timestamp, const T& value, MDBX_txn* txn = nullptr) {
+            const point_type point(timestamp, value);
+            with_transaction([this, &point](MDBX_txn* t) {
+                db_append(&point, &point + 1, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Appends one point.
+        /// \param timestamp Timestamp of the point.
+        /// \param value Value of the point.
+        /// \param txn Active transaction wrapper.
+        void append(std::uint64_t timestamp, const T& value, const Transaction& txn) {
+            append(timestamp, value, txn.handle());
+        }
+
+        /// \brief Appends points, rewriting each affected chunk once.
+        /// \param points Points in any order.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs.
+        void append(const std::vector<point_type>& points, MDBX_txn* txn = nullptr) {
+            if (points.empty()) return;
+            with_transaction([this, &points](MDBX_txn* t) {
+                if (is_sorted(points)) {
+                    db_append(points.data(), points.data() + points.size(), t);
+                    return;
+                }
+                std::vector<point_type> sorted(points);
+                std::stable_sort(sorted.begin(), sorted.end(), timestamp_less);
+                db_append(sorted.data(), sorted.data() + sorted.size(), t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Appends points, rewriting each affected chunk once.
+        /// \param points Points in any order.
+        /// \param txn Active transaction wrapper.
+        void append(const std::vector<point_type>& points, const Transaction& txn) {
+            append(points, txn.handle());
+        }
+
+        /// \brief Calls a callback for every point with a timestamp in <tt>[from, to]</tt>.
+        /// \param from First timestamp of the range.
+        /// \param to Last timestamp of the range.
+        /// \param callback Invoked as \c callback(std::uint64_t, const T&). Return \c true to continue.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if every point was visited, \c false if the callback stopped early.
+        /// \throws MdbxException if a database error occurs.
+        template<typename CallbackT>
+        bool for_each_range(std::uint64_t from, std::uint64_t to,
+                            CallbackT callback, MDBX_txn* txn = nullptr) const {
+            bool completed = false;
+            with_transaction([this, from, to, &callback, &completed](MDBX_txn* t) {
+                completed = db_for_each_range(from, to, callback, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return completed;
+        }
+
+        /// \brief Calls a callback for every point with a timestamp in <tt>[from, to]</tt>.
+        /// \param from First timestamp of the range.
+        /// \param to Last timestamp of the range.
+        /// \param callback Invoked as \c callback(std::uint64_t, const T&). Return \c true to continue.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if every point was visited.
+        template<typename CallbackT>
+        bool for_each_range(std::uint64_t from, std::uint64_t to,
+                            CallbackT callback, const Transaction& txn) const {
+            return for_each_range(from, to, callback, txn.handle());
+        }
+
+        /// \brief Returns the points with a timestamp in <tt>[from, to]</tt> in time order.
+        /// \param from First timestamp of the range.
+        /// \param to Last timestamp of the range.
+        /// \param txn Optional transaction handle.
+        std::vector<point_type> range(std::uint64_t from, std::uint64_t to,
+                                      MDBX_txn* txn = nullptr) const {
+            std::vector<point_type> out;
+            for_each_range(from, to, [&out](std::uint64_t ts, const T& value) {
+                out.push_back(point_type(ts, value));
+                return true;
+            }, txn);
+            return out;
+        }
+
+        /// \brief Returns the points with a timestamp in <tt>[from, to]</tt> in time order.
+        /// \param from First timestamp of the range.
+        /// \param to Last timestamp of the range.
+        /// \param txn Active transaction wrapper.
+        std::vector<point_type> range(std::uint64_t from, std::uint64_t to,
+                                      const Transaction& txn) const {
+            return range(from, to, txn.handle());
+        }
+
+        /// \brief Summarizes the points of <tt>[from, to]</tt> per \p step timestamp units.
+        /// \param from First timestamp of the range.
+        /// \param to Last timestamp of the range.
+        /// \param step Width of one aggregate; steps start at multiples of \p step.
+        /// \param extract Invoked as \c extract(const T&); returns the value to aggregate.
+        /// \param txn Optional transaction handle.
+        /// \return Aggregates of the non-empty steps in time order.
+        /// \throws std::invalid_argument if \p step is zero.
+        template<typename ExtractorT>
+        std::vector<TimeSeriesAggregate> downsample(std::uint64_t from, std::uint64_t to,
+                                                    std::uint64_t step, ExtractorT extract,
+                                                    MDBX_txn* txn = nullptr) const {
+            if (step == 0) {
+                throw std::invalid_argument("TimeSeriesTable::downsample: step must be positive");
+            }
+            std::vector<TimeSeriesAggregate> out;
+            for_each_range(from, to, [&out, &extract, step](std::uint64_t ts, const T& value) {
+                const double v = static_cast<double>(extract(value));
+                const std::uint64_t start = ts - ts % step;
+                if (out.empty() || out.back().start != start) {
+                    TimeSeriesAggregate agg;
+                    agg.start = start;
+                    agg.min = agg.max = agg.first = v;
+                    out.push_back(agg);
+                }
+                TimeSeriesAggregate& agg = out.back();
+                ++agg.count;
+                agg.sum += v;
+                agg.last = v;
+                if (v < agg.min) agg.min = v;
+                if (v > agg.max) agg.max = v;
+                return true;
+            }, txn);
+            return out;
+        }
+
+        /// \brief Summarizes arithmetic values of <tt>[from, to]</tt> per \p step timestamp units.
+        /// \param from First timestamp of the range.
+        /// \param to Last timestamp of the range.
+        /// \param step Width of one aggregate.
+        /// \param txn Optional transaction handle.
+        std::vector<TimeSeriesAggregate> downsample(std::uint64_t from, std::uint64_t to,
+                                                    std::uint64_t step,
+                                                    MDBX_txn* txn = nullptr) const {
+            static_assert(std::is_arithmetic<T>::value,
+                          "downsample without an extractor requires an arithmetic value type");
+            return downsample(from, to, step, [](const T& value) { return value; }, txn);
+        }
+
+        /// \brief Summarizes the points of <tt>[from, to]</tt> per \p step timestamp units.
+        /// \param from First timestamp of the range.
+        /// \param to Last timestamp of the range.
+        /// \param step Width of one aggregate.
+        /// \param extract Invoked as \c extract(const T&); returns the value to aggregate.
+        /// \param txn Active transaction wrapper.
+        template<typename ExtractorT>
+        std::vector<TimeSeriesAggregate> downsample(std::uint64_t from, std::uint64_t to,
+                                                    std::uint64_t step, ExtractorT extract,
+                                                    const Transaction& txn) const {
+            return downsample(from, to, step, extract, txn.handle());
+        }
+
+        /// \brief Summarizes arithmetic values of <tt>[from, to]</tt> per \p step timestamp units.
+        /// \param from First timestamp of the range.
+        /// \param to Last timestamp of the range.
+        /// \param step Width of one aggregate.
+        /// \param txn Active transaction wrapper.
+        std::vector<TimeSeriesAggregate> downsample(std::uint64_t from, std::uint64_t to,
+                                                    std::uint64_t step, const Transaction& txn) const {
+            return downsample(from, to, step, txn.handle());
+        }
+
+        /// \brief Counts stored points from the chunk headers.
+        /// \param txn Optional transaction handle.
+        std::size_t count(MDBX_txn* txn = nullptr) const {
+            std::size_t res = 0;
+            with_transaction([this, &res](MDBX_txn* t) {
+                res = db_count(t);
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Counts stored points from the chunk headers.
+        /// \param txn Active transaction wrapper.
+        std::size_t count(const Transaction& txn) const {
+            return count(txn.handle());
+        }
+
+        /// \brief Removes every point older than \p timestamp.
+        /// \details Chunks entirely before \p timestamp are deleted without
+        /// being decoded; only the chunk holding \p timestamp is rewritten.
+        /// \param timestamp First timestamp to keep.
+        /// \param txn Optional transaction handle.
+        /// \return Number of points removed.
+        std::size_t erase_before(std::uint64_t timestamp, MDBX_txn* txn = nullptr) {
+            std::size_t removed = 0;
+            with_transaction([this, timestamp, &removed](MDBX_txn* t) {
+                removed = db_erase_before(timestamp, t);
+            }, TransactionMode::WRITABLE, txn);
+            return removed;
+        }
+
+        /// \brief Removes every point older than \p timestamp.
+        /// \param timestamp First timestamp to keep.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of points removed.
+        std::size_t erase_before(std::uint64_t timestamp, const Transaction& txn) {
+            return erase_before(timestamp, txn.handle());
+        }
+
+        /// \brief Removes all points.
+        /// \param txn Optional transaction handle.
+        void clear(MDBX_txn* txn = nullptr) {
+            with_transaction([this](MDBX_txn* t) {
+                db_clear(t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Removes all points.
+        /// \param txn Active transaction wrapper.
+        void clear(const Transaction& txn) {
+            clear(txn.handle());
+        }
+
+    private:
+        static const std::size_t word_count = (sizeof(T) + 7) / 8;
+
+        std::uint64_t m_chunk_span;
+
+        template<typename F>
+        void with_transaction(F&& action, TransactionMode mode, MDBX_txn* txn = nullptr) const {
+            if (txn) {
+                action(checked_external_txn(txn));
+                return;
+            }
+            txn = thread_txn();
+            if (txn) {
+                action(txn);
+                return;
+            }
+            if (try_group_write(action, mode)) return;
+
+            auto txn_guard = m_connection->transaction(mode);
+            try {
+                action(txn_guard.handle());
+                txn_guard.commit();
+            } catch (...) {
+                try { txn_guard.rollback(); } catch (...) {}
+                throw;
+            }
+        }
+
+        static std::uint64_t validate_span(std::uint64_t span) {
+            if (span == 0) {
+                throw std::invalid_argument("TimeSeriesTable: chunk_span must be positive");
+            }
+            return span;
+        }
+
+        static bool timestamp_less(const point_type& a, const point_type& b) noexcept {
+            return a.timestamp < b.timestamp;
+        }
+
+        static bool is_sorted(const std::vector<point_type>& points) noexcept {
+            for (std::size_t i = 1; i < points.size(); ++i) {
+                if (points[i].timestamp < points[i - 1].timestamp) return false;
+            }
+            return true;
+        }
+
+        std::uint64_t chunk_of(std::uint64_t timestamp) const noexcept {
+            return timestamp - timestamp % m_chunk_span;
+        }
+
+        static MDBX_val chunk_key(std::uint64_t& chunk) noexcept {
+            MDBX_val key;
+            key.iov_base = &chunk;
+            key.iov_len = sizeof(chunk);
+            return key;
+        }
+
+        static std::uint64_t read_chunk_key(const MDBX_val& key) {
+            if (key.iov_len != sizeof(std::uint64_t)) {
+                throw std::runtime_error("TimeSeriesTable: unexpected chunk key size");
+            }
+            std::uint64_t chunk = 0;
+            std::memcpy(&chunk, key.iov_base, sizeof(chunk));
+            return chunk;
+        }
+
+        static void to_words(const T& value, std::uint64_t* row) noexcept {
+            std::memset(row, 0, 8 * word_count);
+            std::memcpy(row, &value, sizeof(T));
+        }
+
+        static T from_words(const std::uint64_t* row) noexcept {
+            T value;
+            std::memcpy(&value, row, sizeof(T));
+            return value;
+        }
+
+        void db_put_chunk(std::uint64_t chunk, const detail::SeriesChunk& rows, MDBX_txn* txn) {
+            std::vector<std::uint8_t> bytes;
+            MDBX_val db_key = chunk_key(chunk);
+            MDBX_val db_val = rows.encode(bytes);
+            check_mdbx(mdbx_put(txn, m_dbi, &db_key, &db_val, MDBX_UPSERT),
+                       "Failed to write time series chunk");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put, db_key, db_val);
+#           endif
+        }
+
+        void db_del_chunk(std::uint64_t chunk, MDBX_txn* txn) {
+            MDBX_val db_key = chunk_key(chunk);
+            check_mdbx(mdbx_del(txn, m_dbi, &db_key, nullptr), "Failed to erase time series chunk");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Delete, db_key, MDBX_val());
+#           endif
+        }
+
+        /// \brief Adds a time-sorted run of points.
+        void db_append(const point_type* first, const point_type* last, MDBX_txn* txn) {
+            std::uint64_t row[word_count];
+            while (first != last) {
+                std::uint64_t chunk = chunk_of(first->timestamp);
+                const point_type* run_end = first;
+                while (run_end != last && chunk_of(run_end->timestamp) == chunk) ++run_end;
+
+                detail::SeriesChunk rows(word_count);
+                MDBX_val db_key = chunk_key(chunk);
+                MDBX_val db_val;
+                const int rc = mdbx_get(txn, m_dbi, &db_key, &db_val);
+                if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to read time series chunk");
+                std::uint32_t count = 0;
+                std::uint64_t first_ts = 0;
+                std::uint64_t last_ts = 0;
+                if (rc == MDBX_SUCCESS) {
+                    detail::SeriesChunk::read_header(db_val, word_count, count, first_ts, last_ts);
+                }
+                if (count != 0 && first->timestamp < last_ts) {
+                    // Older points: decode, merge after equal timestamps, re-encode.
+                    std::vector<point_type> merged;
+                    merged.reserve(rows.count() + static_cast<std::size_t>(run_end - first));
+                    detail::SeriesChunk::decode(db_val, word_count,
+                        [&merged](std::uint64_t ts, const std::uint64_t* words) {
+                            merged.push_back(point_type(ts, from_words(words)));
+                            return true;
+                        });
+                    const std::size_t stored = merged.size();
+                    merged.insert(merged.end(), first, run_end);
+                    std::inplace_merge(merged.begin(), merged.begin() + stored, merged.end(),
+                                       timestamp_less);
+                    for (std::size_t i = 0; i < merged.size(); ++i) {
+                        to_words(merged[i].value, row);
+                        rows.append(merged[i].timestamp, row);
+                    }
+                } else {
+                    if (count != 0) rows.load(db_val);
+                    for (const point_type* p = first; p != run_end; ++p) {
+                        to_words(p->value, row);
+                        rows.append(p->timestamp, row);
+                    }
+                }
+                db_put_chunk(chunk, rows, txn);
+                first = run_end;
+            }
+        }
+
+        template<typename CallbackT>
+        bool db_for_each_range(std::uint64_t from, std::uint64_t to,
+                               CallbackT& callback, MDBX_txn* txn) const {
+            if (from > to) return true;
+            std::uint64_t chunk = chunk_of(from);
+            MDBX_val db_key = chunk_key(chunk);
+            MDBX_val db_val;
+            CachedCursor cursor(*this, txn);
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                if (read_chunk_key(db_key) > to) return true;
+                std::uint32_t count = 0;
+                std::uint64_t first_ts = 0;
+                std::uint64_t last_ts = 0;
+                detail::SeriesChunk::read_header(db_val, word_count, count, first_ts, last_ts);
+                if (first_ts > to) return true;
+                if (last_ts >= from) {
+                    bool stopped = false;
+                    bool past_end = false;
+                    detail::SeriesChunk::decode(db_val, word_count,
+                        [from, to, &past_end, &stopped, &callback](std::uint64_t ts, const std::uint64_t* words) {
+                            if (ts < from) return true;
+                            if (ts > to) {
+                                past_end = true;
+                                return false;
+                            }
+                            if (!static_cast<bool>(callback(ts, from_words(words)))) {
+                                stopped = true;
+                                return false;
+                            }
+                            return true;
+                        });
+                    if (stopped) return false;
+                    if (past_end) return true;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to read time series chunk");
+            return true;
+        }
+
+        std::size_t db_count(MDBX_txn* txn) const {
+            std::size_t total = 0;
+            MDBX_val db_key;
+            MDBX_val db_val;
+            CachedCursor cursor(*this, txn);
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
+            while (rc == MDBX_SUCCESS) {
+                std::uint32_t count = 0;
+                std::uint64_t first_ts = 0;
+                std::uint64_t last_ts = 0;
+                detail::SeriesChunk::read_header(db_val, word_count, count, first_ts, last_ts);
+                total += count;
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+            }
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to read time series chunk");
+            return total;
+        }
+
+        std::size_t db_erase_before(std::uint64_t timestamp, MDBX_txn* txn) {
+            const std::uint64_t keep_chunk = chunk_of(timestamp);
+            std::size_t removed = 0;
+            for (;;) {
+                MDBX_val db_key;
+                MDBX_val db_val;
+                int rc = MDBX_SUCCESS;
+                {
+                    CachedCursor cursor(*this, txn);
+                    rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
+                }
+                if (rc == MDBX_NOTFOUND) return removed;
+                check_mdbx(rc, "Failed to read time series chunk");
+                std::uint64_t chunk = read_chunk_key(db_key);
+                if (chunk > keep_chunk) return removed;
+                std::uint32_t count = 0;
+                std::uint64_t first_ts = 0;
+                std::uint64_t last_ts = 0;
+                detail::SeriesChunk::read_header(db_val, word_count, count, first_ts, last_ts);
+                if (first_ts >= timestamp) return removed;
+                if (last_ts < timestamp) {
+                    db_del_chunk(chunk, txn);
+                    removed += count;
+                    continue;
+                }
+                // The chunk holding the cut-off keeps its newer points.
+                detail::SeriesChunk rows(word_count);
+                detail::SeriesChunk::decode(db_val, word_count,
+                    [&rows, &removed, timestamp](std::uint64_t ts, const std::uint64_t* words) {
+                        if (ts < timestamp) {
+                            ++removed;
+                        } else {
+                            rows.append(ts, words);
+                        }
+                        return true;
+                    });
+                db_put_chunk(chunk, rows, txn);
+                return removed;
+            }
+        }
+
+        void db_clear(MDBX_txn* txn) {
+            check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear table");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
+#           endif
+        }
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_TIME_SERIES_TABLE_HPP_INCLUDED
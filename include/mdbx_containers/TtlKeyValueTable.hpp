@@ -0,0 +1,797 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_TTL_KEY_VALUE_TABLE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_TTL_KEY_VALUE_TABLE_HPP_INCLUDED
+
+/// \file TtlKeyValueTable.hpp
+/// \brief Key-value table whose entries expire after a time-to-live.
+/// \details
+/// Each record stores its expiry time in front of the value, and a companion
+/// \c MDBX_DUPSORT table orders keys by expiry time. Reads hide expired
+/// entries without writing; \c purge_expired() walks the expiry order from
+/// the oldest entry and deletes in bounded batches.
+
+#include "common.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \struct TtlPurgeStats
+    /// \brief Counters of the background purge of a \ref TtlKeyValueTable.
+    struct TtlPurgeStats {
+        std::uint64_t purged = 0;        ///< Expired records deleted.
+        std::uint64_t batches = 0;       ///< Committed purge transactions.
+        std::uint64_t failed_batches = 0; ///< Purge transactions that threw.
+    };
+
+    /// \class TtlKeyValueTable
+    /// \ingroup mdbxc_tables
+    /// \brief Key-value table with per-entry expiry and batched purging.
+    /// \tparam KeyT Type of the keys.
+    /// \tparam ValueT Type of the values.
+    /// \tparam Options Compile-time table policy, as for \ref KeyValueTable.
+    /// \details
+    /// Records hold an 8-byte expiry time in milliseconds since the
+    /// \c std::chrono::system_clock epoch, zero for entries that never
+    /// expire, followed by the serialized value. The table
+    /// <tt>name + "__expiry"</tt> maps each expiry time to the keys expiring
+    /// then and changes in the same transaction as the records, so a write
+    /// costs one extra index put and, when the expiry moves, one index
+    /// delete.
+    ///
+    /// Reads treat entries whose expiry time has passed as absent but leave
+    /// them in place, so read-only transactions never write. Expired records
+    /// are deleted by \ref purge_expired(), which removes at most
+    /// \c batch_size records in the oldest expiry order per transaction, or
+    /// by the background thread of \ref start_purge(), which commits one
+    /// batch per transaction so writers never wait for a long purge.
+    ///
+    /// The storage format differs from \ref KeyValueTable, so the two cannot
+    /// share a table name. With sync capture, records and purges are
+    /// recorded as puts and deletes; the expiry table is not captured and
+    /// replicas index the applied keys after each sync apply.
+    /// \note Expiry uses the wall clock of the reading process; nodes with
+    ///       skewed clocks disagree on entries close to their expiry time.
+    template<class KeyT, class ValueT, class Options = DefaultTableOptions>
+    class TtlKeyValueTable final : public BaseTable {
+    public:
+        typedef std::chrono::system_clock clock_type;
+        typedef clock_type::time_point    time_point;
+
+        /// \brief Constructs table using existing connection.
+        /// \param connection Existing connection.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param flags Additional MDBX database flags.
+        TtlKeyValueTable(std::shared_ptr<Connection> connection,
+                         std::string name = "ttl_kv_store",
+                         MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : BaseTable(std::move(connection),
+                        std::move(name),
+                        flags | get_mdbx_flags<KeyT>()),
+              m_expiry_dbi(open_expiry_dbi()) {
+#           if MDBXC_SYNC_ENABLED
+            m_apply_observer.reset(new ApplyObserver(*this));
+            m_apply_observer_token = m_connection->add_sync_apply_observer(m_apply_observer.get());
+#           endif
+        }
+
+        /// \brief Constructs table using configuration.
+        /// \param config Configuration settings.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param flags Additional MDBX database flags.
+        explicit TtlKeyValueTable(const Config& config,
+                                  std::string name = "ttl_kv_store",
+                                  MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : TtlKeyValueTable(Connection::create(config), std::move(name), flags) {}
+
+        /// \brief Stops the purge thread.
+        ~TtlKeyValueTable() override {
+            stop_purge();
+#           if MDBXC_SYNC_ENABLED
+            // Waits for callbacks in flight on other threads.
+            m_connection->remove_sync_apply_observer(m_apply_observer_token);
+#           endif
+        }
+
+        TtlKeyValueTable(const TtlKeyValueTable&) = delete;
+        TtlKeyValueTable& operator=(const TtlKeyValueTable&) = delete;
+
+        // --- Writes ---
+
+        /// \brief Stores \p value under \p key without an expiry time.
+        /// \param key Key to write.
+        /// \param value Value to store.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs.
+        void insert_or_assign(const KeyT& key, const ValueT& value, MDBX_txn* txn = nullptr) {
+            with_transaction([this, &key, &value](MDBX_txn* t) {
+                db_put(key, value, 0, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Stores \p value under \p key without an expiry time.
+        /// \param key Key to write.
+        /// \param value Value to store.
+        /// \param txn Active transaction wrapper.
+        void insert_or_assign(const KeyT& key, const ValueT& value, const Transaction& txn) {
+            insert_or_assign(key, value, txn.handle());
+        }
+
+        /// \brief Stores \p value under \p key until \p ttl has passed.
+        /// \param key Key to write.
+        /// \param value Value to store.
+        /// \param ttl Time to live from now; non-positive values store an expired entry.
+        /// \param txn Optional transaction handle.
+        /// \throws MdbxException if a database error occurs.
+        void insert_or_assign(const KeyT& key, const ValueT& value,
+                              std::chrono::milliseconds ttl, MDBX_txn* txn = nullptr) {
+            const std::uint64_t expires = to_stored(clock_type::now() + ttl);
+            with_transaction([this, &key, &value, expires](MDBX_txn* t) {
+                db_put(key, value, expires, t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Stores \p value under \p key until \p ttl has passed.
+        /// \param key Key to write.
+        /// \param value Value to store.
+        /// \param ttl Time to live from now.
+        /// \param txn Active transaction wrapper.
+        void insert_or_assign(const KeyT& key, const ValueT& value,
+                              std::chrono::milliseconds ttl, const Transaction& txn) {
+            insert_or_assign(key, value, ttl, txn.handle());
+        }
+
+        /// \brief Sets the expiry time of a live entry.
+        /// \param key Key of the entry.
+        /// \param when New expiry time; a past time expires the entry.
+        /// \param txn Optional transaction handle.
+        /// \return \c false if the key is absent or already expired.
+        /// \throws MdbxException if a database error occurs.
+        bool expire_at(const KeyT& key, time_point when, MDBX_txn* txn = nullptr) {
+            bool res = false;
+            const std::uint64_t expires = to_stored(when);
+            with_transaction([this, &key, expires, &res](MDBX_txn* t) {
+                res = db_set_expiry(key, expires, t);
+            }, TransactionMode::WRITABLE, txn);
+            return res;
+        }
+
+        /// \brief Sets the expiry time of a live entry.
+        /// \param key Key of the entry.
+        /// \param when New expiry time.
+        /// \param txn Active transaction wrapper.
+        /// \return \c false if the key is absent or already expired.
+        bool expire_at(const KeyT& key, time_point when, const Transaction& txn) {
+            return expire_at(key, when, txn.handle());
+        }
+
+        /// \brief Restarts the time to live of a live entry.
+        /// \param key Key of the entry.
+        /// \param ttl Time to live from now.
+        /// \param txn Optional transaction handle.
+        /// \return \c false if the key is absent or already expired.
+        bool expire_after(const KeyT& key, std::chrono::milliseconds ttl, MDBX_txn* txn = nullptr) {
+            return expire_at(key, clock_type::now() + ttl, txn);
+        }
+
+        /// \brief Restarts the time to live of a live entry.
+        /// \param key Key of the entry.
+        /// \param ttl Time to live from now.
+        /// \param txn Active transaction wrapper.
+        /// \return \c false if the key is absent or already expired.
+        bool expire_after(const KeyT& key, std::chrono::milliseconds ttl, const Transaction& txn) {
+            return expire_after(key, ttl, txn.handle());
+        }
+
+        /// \brief Removes the expiry time of a live entry.
+        /// \param key Key of the entry.
+        /// \param txn Optional transaction handle.
+        /// \return \c false if the key is absent or already expired.
+        bool persist(const KeyT& key, MDBX_txn* txn = nullptr) {
+            bool res = false;
+            with_transaction([this, &key, &res](MDBX_txn* t) {
+                res = db_set_expiry(key, 0, t);
+            }, TransactionMode::WRITABLE, txn);
+            return res;
+        }
+
+        /// \brief Removes the expiry time of a live entry.
+        /// \param key Key of the entry.
+        /// \param txn Active transaction wrapper.
+        /// \return \c false if the key is absent or already expired.
+        bool persist(const KeyT& key, const Transaction& txn) {
+            return persist(key, txn.handle());
+        }
+
+        /// \brief Erases \p key.
+        /// \param key Key to erase.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if a live entry was erased.
+        /// \throws MdbxException if a database error occurs.
+        bool erase(const KeyT& key, MDBX_txn* txn = nullptr) {
+            bool res = false;
+            with_transaction([this, &key, &res](MDBX_txn* t) {
+                res = db_erase(key, t);
+            }, TransactionMode::WRITABLE, txn);
+            return res;
+        }
+
+        /// \brief Erases \p key.
+        /// \param key Key to erase.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if a live entry was erased.
+        bool erase(const KeyT& key, const Transaction& txn) {
+            return erase(key, txn.handle());
+        }
+
+        /// \brief Removes all entries.
+        /// \param txn Optional transaction handle.
+        void clear(MDBX_txn* txn = nullptr) {
+            with_transaction([this](MDBX_txn* t) {
+                db_clear(t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Removes all entries.
+        /// \param txn Active transaction wrapper.
+        void clear(const Transaction& txn) {
+            clear(txn.handle());
+        }
+
+        // --- Reads ---
+
+        /// \brief Reads the value of a live entry.
+        /// \param key Key to look up.
+        /// \param out Receives the value.
+        /// \param txn Optional transaction handle.
+        /// \return \c false if the key is absent or expired.
+        /// \throws MdbxException if a database error occurs.
+        bool try_get(const KeyT& key, ValueT& out, MDBX_txn* txn = nullptr) const {
+            bool res = false;
+            const std::uint64_t now = to_stored(clock_type::now());
+            with_transaction([this, &key, &out, now, &res](MDBX_txn* t) {
+                res = db_get(key, now, &out, nullptr, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Reads the value of a live entry.
+        /// \param key Key to look up.
+        /// \param out Receives the value.
+        /// \param txn Active transaction wrapper.
+        /// \return \c false if the key is absent or expired.
+        bool try_get(const KeyT& key, ValueT& out, const Transaction& txn) const {
+            return try_get(key, out, txn.handle());
+        }
+
+        /// \brief Reads the value of a live entry or throws.
+        /// \param key Key to look up.
+        /// \param txn Optional transaction handle.
+        /// \throws std::out_of_range if the key is absent or expired.
+        ValueT at(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            ValueT value;
+            if (!try_get(key, value, txn)) {
+                throw std::out_of_range("Key not found in database");
+            }
+            return value;
+        }
+
+        /// \brief Reads the value of a live entry or throws.
+        /// \param key Key to look up.
+        /// \param txn Active transaction wrapper.
+        /// \throws std::out_of_range if the key is absent or expired.
+        ValueT at(const KeyT& key, const Transaction& txn) const {
+            return at(key, txn.handle());
+        }
+
+#       if __cplusplus >= 201703L
+        /// \brief Finds the value of a live entry.
+        /// \param key Key to look up.
+        /// \param txn Optional transaction handle.
+        /// \return The value, or \c std::nullopt if absent or expired.
+        std::optional<ValueT> find(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            ValueT value;
+            if (!try_get(key, value, txn)) return std::nullopt;
+            return value;
+        }
+
+        /// \brief Finds the value of a live entry.
+        /// \param key Key to look up.
+        /// \param txn Active transaction wrapper.
+        /// \return The value, or \c std::nullopt if absent or expired.
+        std::optional<ValueT> find(const KeyT& key, const Transaction& txn) const {
+            return find(key, txn.handle());
+        }
+#       else
+        /// \brief Finds the value of a live entry.
+        /// \param key Key to look up.
+        /// \param txn Optional transaction handle.
+        /// \return Pair of success flag and value.
+        std::pair<bool, ValueT> find(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            std::pair<bool, ValueT> result(false, ValueT());
+            result.first = try_get(key, result.second, txn);
+            return result;
+        }
+
+        /// \brief Finds the value of a live entry.
+        /// \param key Key to look up.
+        /// \param txn Active transaction wrapper.
+        /// \return Pair of success flag and value.
+        std::pair<bool, ValueT> find(const KeyT& key, const Transaction& txn) const {
+            return find(key, txn.handle());
+        }
+#       endif
+
+        /// \brief Checks whether \p key holds a live entry.
+        /// \param key Key to look up.
+        /// \param txn Optional transaction handle.
+        bool contains(const KeyT& key, MDBX_txn* txn = nullptr) const {
+            bool res = false;
+            const std::uint64_t now = to_stored(clock_type::now());
+            with_transaction([this, &key, now, &res](MDBX_txn* t) {
+                res = db_get(key, now, nullptr, nullptr, t);
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Checks whether \p key holds a live entry.
+        /// \param key Key to look up.
+        /// \param txn Active transaction wrapper.
+        bool contains(const KeyT& key, const Transaction& txn) const {
+            return contains(key, txn.handle());
+        }
+
+        /// \brief Reads the expiry time of a live entry.
+        /// \param key Key to look up.
+        /// \param out Receives the expiry time, or \c time_point::max() if the
+        ///        entry never expires.
+        /// \param txn Optional transaction handle.
+        /// \return \c false if the key is absent or expired.
+        bool try_get_expiry(const KeyT& key, time_point& out, MDBX_txn* txn = nullptr) const {
+            bool res = false;
+            std::uint64_t expires = 0;
+            const std::uint64_t now = to_stored(clock_type::now());
+            with_transaction([this, &key, now, &expires, &res](MDBX_txn* t) {
+                res = db_get(key, now, nullptr, &expires, t);
+            }, TransactionMode::READ_ONLY, txn);
+            if (res) out = from_stored(expires);
+            return res;
+        }
+
+        /// \brief Reads the expiry time of a live entry.
+        /// \param key Key to look up.
+        /// \param out Receives the expiry time.
+        /// \param txn Active transaction wrapper.
+        /// \return \c false if the key is absent or expired.
+        bool try_get_expiry(const KeyT& key, time_point& out, const Transaction& txn) const {
+            return try_get_expiry(key, out, txn.handle());
+        }
+
+        /// \brief Counts stored records, including expired ones not yet purged.
+        /// \param txn Optional transaction handle.
+        std::size_t stored_count(MDBX_txn* txn = nullptr) const {
+            std::size_t res = 0;
+            with_transaction([this, &res](MDBX_txn* t) {
+                MDBX_stat st;
+                check_mdbx(mdbx_dbi_stat(t, m_dbi, &st, sizeof(st)), "Failed to query table stats");
+                res = static_cast<std::size_t>(st.ms_entries);
+            }, TransactionMode::READ_ONLY, txn);
+            return res;
+        }
+
+        /// \brief Counts stored records, including expired ones not yet purged.
+        /// \param txn Active transaction wrapper.
+        std::size_t stored_count(const Transaction& txn) const {
+            return stored_count(txn.handle());
+        }
+
+        // --- Purging ---
+
+        /// \brief Deletes up to \p batch_size expired records, oldest expiry first.
+        /// \details Reads only the expired prefix of the expiry table, so the
+        /// cost is proportional to the records deleted.
+        /// \param batch_size Maximum number of records to delete.
+        /// \param txn Optional transaction handle.
+        /// \return Number of records deleted; less than \p batch_size once
+        ///         no expired record is left.
+        /// \throws std::invalid_argument if \p batch_size is zero.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t purge_expired(std::size_t batch_size = 1024, MDBX_txn* txn = nullptr) {
+            if (batch_size == 0) {
+                throw std::invalid_argument("purge_expired: batch_size must be positive");
+            }
+            std::size_t removed = 0;
+            const std::uint64_t now = to_stored(clock_type::now());
+            with_transaction([this, batch_size, now, &removed](MDBX_txn* t) {
+                removed = db_purge(now, batch_size, t);
+            }, TransactionMode::WRITABLE, txn);
+            return removed;
+        }
+
+        /// \brief Deletes up to \p batch_size expired records, oldest expiry first.
+        /// \param batch_size Maximum number of records to delete.
+        /// \param txn Active transaction wrapper.
+        /// \return Number of records deleted.
+        std::size_t purge_expired(std::size_t batch_size, const Transaction& txn) {
+            return purge_expired(batch_size, txn.handle());
+        }
+
+        /// \brief Starts a thread that purges expired records every \p interval.
+        /// \details Each wake-up commits batches of \p batch_size records in
+        /// separate write transactions until fewer than \p batch_size expired
+        /// records remain. Errors are counted in \ref purge_stats() and the
+        /// next wake-up retries.
+        /// \param interval Time between purge rounds.
+        /// \param batch_size Maximum records deleted per transaction.
+        /// \throws std::invalid_argument if \p interval or \p batch_size is not positive.
+        /// \throws std::logic_error if the purge thread is already running.
+        void start_purge(std::chrono::milliseconds interval = std::chrono::milliseconds(1000),
+                         std::size_t batch_size = 1024) {
+            if (interval.count() <= 0 || batch_size == 0) {
+                throw std::invalid_argument("start_purge: interval and batch_size must be positive");
+            }
+            std::lock_guard<std::mutex> lock(m_purge_mutex);
+            if (m_purge_worker.joinable()) {
+                throw std::logic_error("start_purge: purge thread is already running");
+            }
+            m_purge_stop = false;
+            m_purge_interval = interval;
+            m_purge_batch = batch_size;
+            m_purge_worker = std::thread(&TtlKeyValueTable::run_purge, this);
+        }
+
+        /// \brief Stops the purge thread, waiting for the batch in progress.
+        void stop_purge() {
+            std::thread worker;
+            {
+                std::lock_guard<std::mutex> lock(m_purge_mutex);
+                m_purge_stop = true;
+                worker.swap(m_purge_worker);
+            }
+            m_purge_wake.notify_all();
+            if (worker.joinable()) worker.join();
+        }
+
+        /// \brief Returns the counters of the purge thread.
+        TtlPurgeStats purge_stats() const {
+            std::lock_guard<std::mutex> lock(m_purge_mutex);
+            return m_purge_stats;
+        }
+
+        /// \brief Recreates the expiry table from the records.
+        /// \details Needed only after records were written without this
+        /// wrapper, e.g. restored from a backup of the main table alone.
+        /// \param txn Optional transaction handle.
+        void rebuild_expiry_index(MDBX_txn* txn = nullptr) {
+            with_transaction([this](MDBX_txn* t) {
+                db_rebuild_index(t);
+            }, TransactionMode::WRITABLE, txn);
+        }
+
+        /// \brief Recreates the expiry table from the records.
+        /// \param txn Active transaction wrapper.
+        void rebuild_expiry_index(const Transaction& txn) {
+            rebuild_expiry_index(txn.handle());
+        }
+
+    private:
+        static const std::size_t header_size = sizeof(std::uint64_t);
+
+        MDBX_dbi                     m_expiry_dbi;
+        mutable std::mutex           m_purge_mutex; ///< Guards the purge thread state and stats.
+        std::condition_variable      m_purge_wake;
+        std::thread                  m_purge_worker;
+        bool                         m_purge_stop = false;
+        std::chrono::milliseconds    m_purge_interval{1000};
+        std::size_t                  m_purge_batch = 1024;
+        TtlPurgeStats                m_purge_stats;
+
+        template<typename F>
+        void with_transaction(F&& action, TransactionMode mode, MDBX_txn* txn = nullptr) const {
+            if (txn) {
+                action(checked_external_txn(txn));
+                return;
+            }
+            txn = thread_txn();
+            if (txn) {
+                action(txn);
+                return;
+            }
+            if (try_group_write(action, mode)) return;
+
+            auto txn_guard = m_connection->transaction(mode);
+            try {
+                action(txn_guard.handle());
+                txn_guard.commit();
+            } catch (...) {
+                try { txn_guard.rollback(); } catch (...) {}
+                throw;
+            }
+        }
+
+        MDBX_dbi open_expiry_dbi() {
+            const MDBX_db_flags_t dup_flags = (get_mdbx_flags<KeyT>() & MDBX_INTEGERKEY)
+                ? static_cast<MDBX_db_flags_t>(MDBX_DUPFIXED | MDBX_INTEGERDUP)
+                : static_cast<MDBX_db_flags_t>(0);
+            return m_connection->open_dbi(
+                m_name + "__expiry",
+                static_cast<MDBX_db_flags_t>(MDBX_CREATE | MDBX_DUPSORT | MDBX_INTEGERKEY | dup_flags));
+        }
+
+        /// \brief Converts a time point to stored milliseconds; never returns the "no expiry" zero.
+        static std::uint64_t to_stored(time_point when) {
+            const std::int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                when.time_since_epoch()).count();
+            return ms > 0 ? static_cast<std::uint64_t>(ms) : 1;
+        }
+
+        static time_point from_stored(std::uint64_t expires) {
+            if (expires == 0) return time_point::max();
+            return time_point(std::chrono::duration_cast<clock_type::duration>(
+                std::chrono::milliseconds(static_cast<std::int64_t>(expires))));
+        }
+
+        static std::uint64_t record_expiry(const MDBX_val& record) {
+            if (record.iov_len < header_size) {
+                throw std::runtime_error("TtlKeyValueTable: record is shorter than its expiry header");
+            }
+            std::uint64_t expires = 0;
+            std::memcpy(&expires, record.iov_base, header_size);
+            return expires;
+        }
+
+        static bool is_live(std::uint64_t expires, std::uint64_t now) noexcept {
+            return expires == 0 || expires > now;
+        }
+
+        static MDBX_val record_value(const MDBX_val& record) noexcept {
+            MDBX_val val;
+            val.iov_len = record.iov_len - header_size;
+            val.iov_base = val.iov_len
+                ? static_cast<void*>(static_cast<std::uint8_t*>(record.iov_base) + header_size)
+                : nullptr;
+            return val;
+        }
+
+        /// \brief Adds or removes the expiry table entry of \p db_key.
+        void index_set(MDBX_txn* txn, const MDBX_val& db_key, std::uint64_t expires, bool add) {
+            if (expires == 0) return;
+            MDBX_val index_key = SerializeScratch::view(&expires, sizeof(expires));
+            MDBX_val dup = db_key;
+            if (add) {
+                check_mdbx(mdbx_put(txn, m_expiry_dbi, &index_key, &dup, MDBX_UPSERT),
+                           "Failed to index expiry time");
+                return;
+            }
+            const int rc = mdbx_del(txn, m_expiry_dbi, &index_key, &dup);
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to drop expiry index entry");
+        }
+
+        /// \brief Writes the record of \p db_key and moves its expiry table entry.
+        void db_write_record(const MDBX_val& db_key, std::uint64_t expires,
+                             const MDBX_val& value, MDBX_txn* txn) {
+            MDBX_val key = db_key;
+            MDBX_val old_record;
+            const int get_rc = mdbx_get(txn, m_dbi, &key, &old_record);
+            if (get_rc != MDBX_NOTFOUND) check_mdbx(get_rc, "Failed to read record");
+            const std::uint64_t old_expires = get_rc == MDBX_SUCCESS ? record_expiry(old_record) : 0;
+
+            MDBX_val record;
+            record.iov_base = nullptr;
+            record.iov_len = header_size + value.iov_len;
+            check_mdbx(mdbx_put(txn, m_dbi, &key, &record, MDBX_UPSERT | MDBX_RESERVE),
+                       "Failed to insert or assign record");
+            std::uint8_t* out = static_cast<std::uint8_t*>(record.iov_base);
+            std::memcpy(out, &expires, header_size);
+            if (value.iov_len) std::memcpy(out + header_size, value.iov_base, value.iov_len);
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put, db_key, record);
+#           endif
+            if (old_expires != expires) {
+                index_set(txn, db_key, old_expires, false);
+                index_set(txn, db_key, expires, true);
+            }
+        }
+
+        void db_put(const KeyT& key, const ValueT& value, std::uint64_t expires, MDBX_txn* txn) {
+            SerializeScratch sc_key;
+            SerializeScratch sc_value;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val db_val = serialize_value(value, sc_value);
+            db_write_record(db_key, expires, db_val, txn);
+        }
+
+        bool db_set_expiry(const KeyT& key, std::uint64_t expires, MDBX_txn* txn) {
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val record;
+            const int rc = mdbx_get(txn, m_dbi, &db_key, &record);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to read record");
+            if (!is_live(record_expiry(record), to_stored(clock_type::now()))) return false;
+            // The record is rewritten in place, so its value must be copied first.
+            const MDBX_val stored = record_value(record);
+            SerializeScratch sc_value;
+            db_write_record(db_key, expires, sc_value.view_copy(stored.iov_base, stored.iov_len), txn);
+            return true;
+        }
+
+        bool db_get(const KeyT& key, std::uint64_t now, ValueT* out,
+                    std::uint64_t* expires_out, MDBX_txn* txn) const {
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val record;
+            const int rc = mdbx_get(txn, m_dbi, &db_key, &record);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to read record");
+            const std::uint64_t expires = record_expiry(record);
+            if (!is_live(expires, now)) return false;
+            if (out) *out = deserialize_value<ValueT>(record_value(record));
+            if (expires_out) *expires_out = expires;
+            return true;
+        }
+
+        bool db_erase(const KeyT& key, MDBX_txn* txn) {
+            SerializeScratch sc_key;
+            MDBX_val db_key = serialize_key<Options::safe_integer_key>(key, sc_key);
+            MDBX_val record;
+            const int rc = mdbx_get(txn, m_dbi, &db_key, &record);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to read record");
+            const std::uint64_t expires = record_expiry(record);
+            check_mdbx(mdbx_del(txn, m_dbi, &db_key, nullptr), "Failed to erase key");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Delete, db_key, MDBX_val());
+#           endif
+            index_set(txn, db_key, expires, false);
+            return is_live(expires, to_stored(clock_type::now()));
+        }
+
+        void db_clear(MDBX_txn* txn) {
+            check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear table");
+            check_mdbx(mdbx_drop(txn, m_expiry_dbi, 0), "Failed to clear expiry index");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
+#           endif
+        }
+
+        std::size_t db_purge(std::uint64_t now, std::size_t limit, MDBX_txn* txn) {
+            CursorGuard cursor;
+            check_mdbx(mdbx_cursor_open(txn, m_expiry_dbi, cursor.out()),
+                       "Failed to open expiry cursor");
+            std::size_t removed = 0;
+            std::vector<std::uint8_t> kbytes;
+            MDBX_val index_key;
+            MDBX_val dup;
+            int rc = mdbx_cursor_get(cursor.get(), &index_key, &dup, MDBX_FIRST);
+            while (rc == MDBX_SUCCESS && removed < limit) {
+                std::uint64_t expires = 0;
+                std::memcpy(&expires, index_key.iov_base, sizeof(expires));
+                if (expires > now) break;
+                const std::uint8_t* begin = static_cast<const std::uint8_t*>(dup.iov_base);
+                kbytes.assign(begin, begin + dup.iov_len);
+                check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT),
+                           "Failed to drop expiry index entry");
+                MDBX_val db_key = SerializeScratch::view(kbytes.data(), kbytes.size());
+                MDBX_val record;
+                const int get_rc = mdbx_get(txn, m_dbi, &db_key, &record);
+                if (get_rc != MDBX_NOTFOUND) check_mdbx(get_rc, "Failed to read record");
+                // Entries left behind by a sync apply may point at a newer record.
+                if (get_rc == MDBX_SUCCESS && record_expiry(record) == expires) {
+                    check_mdbx(mdbx_del(txn, m_dbi, &db_key, nullptr), "Failed to purge record");
+#                   if MDBXC_SYNC_ENABLED
+                    record_op(txn, sync::ChangeOpType::Delete, kbytes, MDBX_val());
+#                   endif
+                    ++removed;
+                }
+                rc = mdbx_cursor_get(cursor.get(), &index_key, &dup, MDBX_NEXT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to read expiry index");
+            }
+            return removed;
+        }
+
+        void db_rebuild_index(MDBX_txn* txn) {
+            check_mdbx(mdbx_drop(txn, m_expiry_dbi, 0), "Failed to clear expiry index");
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key;
+            MDBX_val record;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &record, MDBX_FIRST);
+            while (rc == MDBX_SUCCESS) {
+                index_set(txn, db_key, record_expiry(record), true);
+                rc = mdbx_cursor_get(cursor.get(), &db_key, &record, MDBX_NEXT);
+            }
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to scan records");
+        }
+
+        void run_purge() {
+            std::unique_lock<std::mutex> lock(m_purge_mutex);
+            while (!m_purge_stop) {
+                m_purge_wake.wait_for(lock, m_purge_interval, [this]() { return m_purge_stop; });
+                const std::size_t batch_size = m_purge_batch;
+                while (!m_purge_stop) {
+                    lock.unlock();
+                    std::size_t removed = 0;
+                    bool failed = false;
+                    try {
+                        removed = purge_expired(batch_size);
+                    } catch (...) {
+                        failed = true;
+                    }
+                    lock.lock();
+                    if (failed) {
+                        ++m_purge_stats.failed_batches;
+                        break;
+                    }
+                    ++m_purge_stats.batches;
+                    m_purge_stats.purged += removed;
+                    if (removed < batch_size) break;
+                }
+            }
+        }
+
+#       if MDBXC_SYNC_ENABLED
+        class ApplyObserver final : public sync::ISyncApplyObserver {
+        public:
+            explicit ApplyObserver(TtlKeyValueTable& owner) : m_owner(owner) {}
+
+            void on_sync_apply_committed(const sync::SyncApplyEvent& event) override {
+                m_owner.on_sync_apply(event);
+            }
+
+        private:
+            TtlKeyValueTable& m_owner;
+        };
+
+        std::unique_ptr<ApplyObserver> m_apply_observer;
+        std::uint64_t m_apply_observer_token = 0;
+
+        /// \brief Indexes records written by a remote apply.
+        /// \details Old entries of rewritten or deleted records stay in the
+        /// expiry table; \c db_purge() skips them because the record no
+        /// longer carries their expiry time.
+        void on_sync_apply(const sync::SyncApplyEvent& event) {
+            if (m_connection->is_read_only()) return;
+            bool affected = false;
+            for (std::size_t i = 0; i < event.affected_dbi_names.size(); ++i) {
+                if (event.affected_dbi_names[i] == m_name) {
+                    affected = true;
+                    break;
+                }
+            }
+            if (!affected) return;
+            with_transaction([this, &event](MDBX_txn* t) {
+                bool matched = false;
+                for (std::size_t i = 0; i < event.applied_keys.size(); ++i) {
+                    const sync::SyncAppliedKey& applied = event.applied_keys[i];
+                    if (applied.dbi_name != m_name) continue;
+                    if (applied.op_type == sync::ChangeOpType::ClearTable) {
+                        db_rebuild_index(t);
+                        return;
+                    }
+                    matched = true;
+                    if (applied.op_type == sync::ChangeOpType::Delete) continue;
+                    MDBX_val db_key = SerializeScratch::view(applied.storage_key.data(),
+                                                             applied.storage_key.size());
+                    MDBX_val record;
+                    const int rc = mdbx_get(t, m_dbi, &db_key, &record);
+                    if (rc == MDBX_NOTFOUND) continue;
+                    check_mdbx(rc, "Failed to read record");
+                    index_set(t, db_key, record_expiry(record), true);
+                }
+                // The table changed but its keys are unknown.
+                if (!matched) db_rebuild_index(t);
+            }, TransactionMode::WRITABLE);
+        }
+#       endif
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_TTL_KEY_VALUE_TABLE_HPP_INCLUDED
@@ -9,6 +9,8 @@
 /// at most one user value.
 
 #include "common.hpp"
+#include <atomic>
+#include <memory>
 #include <utility>
 
 namespace mdbxc {
@@ -27,6 +29,10 @@ namespace mdbxc {
     ///       through ValueTable. Opening the same MDBX DBI through another table
     ///       type can intentionally create extra physical rows; \c clear()
     ///       removes all rows in the DBI.
+    ///
+    /// get_shared() can keep the last deserialized value in memory, see
+    /// set_value_cache(). The cached value is tagged with the DBI modification
+    /// txnid and reused while that txnid is unchanged.
     template<class ValueT>
     class ValueTable final : public BaseTable {
     public:
@@ -52,6 +58,22 @@ namespace mdbxc {
                         std::move(name),
                         flags | get_mdbx_flags<std::uint32_t>()) {}
 
+        /// \brief Copies the table accessor, its cache setting and the cached value.
+        ValueTable(const ValueTable& other)
+            : BaseTable(other),
+              m_value_cache_enabled(other.value_cache_enabled()),
+              m_value_cache(std::atomic_load(&other.m_value_cache)) {}
+
+        /// \brief Copies the table accessor, its cache setting and the cached value.
+        ValueTable& operator=(const ValueTable& other) {
+            if (this != &other) {
+                BaseTable::operator=(other);
+                m_value_cache_enabled.store(other.value_cache_enabled(), std::memory_order_relaxed);
+                std::atomic_store(&m_value_cache, std::atomic_load(&other.m_value_cache));
+            }
+            return *this;
+        }
+
         /// \brief Destructor.
         ~ValueTable() override = default;
 
@@ -214,6 +236,46 @@ namespace mdbxc {
             return get_or(std::move(default_value), txn.handle());
         }
 
+        /// \brief Enables or disables the deserialized value cache of get_shared().
+        /// \param enabled \c true to keep the last value read by get_shared().
+        /// \details Disabling the cache drops the cached value.
+        void set_value_cache(bool enabled) {
+            m_value_cache_enabled.store(enabled, std::memory_order_relaxed);
+            if (!enabled) {
+                std::atomic_store(&m_value_cache, std::shared_ptr<const ValueCacheEntry>());
+            }
+        }
+
+        /// \brief Checks whether get_shared() caches the deserialized value.
+        /// \return \c true if the cache is enabled.
+        bool value_cache_enabled() const {
+            return m_value_cache_enabled.load(std::memory_order_relaxed);
+        }
+
+        /// \brief Returns the singleton value as a shared immutable object.
+        /// \param txn Optional transaction handle.
+        /// \return Shared pointer to the value, or an empty pointer if absent.
+        /// \details With set_value_cache() enabled, the last result is kept
+        /// together with the DBI modification txnid it was read at. A later call
+        /// only queries the DBI statistics and returns the same object while the
+        /// txnid is unchanged, skipping the lookup and deserialization. Values
+        /// written by the current, not yet committed transaction are never cached.
+        /// Safe to call from several threads on one table instance.
+        std::shared_ptr<const ValueT> get_shared(MDBX_txn* txn = nullptr) const {
+            std::shared_ptr<const ValueT> result;
+            with_transaction([this, &result](MDBX_txn* t) {
+                result = db_get_shared(t);
+            }, TransactionMode::READ_ONLY, txn);
+            return result;
+        }
+
+        /// \brief Returns the singleton value as a shared immutable object using an external transaction.
+        /// \param txn Active transaction wrapper.
+        /// \return Shared pointer to the value, or an empty pointer if absent.
+        std::shared_ptr<const ValueT> get_shared(const Transaction& txn) const {
+            return get_shared(txn.handle());
+        }
+
         /// \brief Updates the stored value in place.
         /// \tparam Fn Functor accepting \c ValueT&.
         /// \param fn Function applied to the stored value.
@@ -244,6 +306,34 @@ namespace mdbxc {
             return update(std::forward<Fn>(fn), txn.handle());
         }
 
+        /// \brief Patches the serialized bytes of the stored value in place.
+        /// \tparam Fn Functor accepting \c MutableByteView&.
+        /// \param fn Mutator applied to the stored bytes.
+        /// \param txn Optional transaction handle.
+        /// \return \c true if the value existed and was patched.
+        /// \details Skips the deserialize/serialize round trip of update(): \p fn
+        /// edits the bytes on the dirty page of the write transaction, which is the
+        /// mapped page itself in \ref Config::writemap_mode. The value size cannot
+        /// change.
+        template<class Fn>
+        bool update_bytes(Fn&& fn, MDBX_txn* txn = nullptr) {
+            bool res = false;
+            with_transaction([this, &fn, &res](MDBX_txn* t) {
+                res = db_update_bytes(fn, t);
+            }, TransactionMode::WRITABLE, txn);
+            return res;
+        }
+
+        /// \brief Patches the serialized bytes of the stored value using an external transaction.
+        /// \tparam Fn Functor accepting \c MutableByteView&.
+        /// \param fn Mutator applied to the stored bytes.
+        /// \param txn Active transaction wrapper.
+        /// \return \c true if the value existed and was patched.
+        template<class Fn>
+        bool update_bytes(Fn&& fn, const Transaction& txn) {
+            return update_bytes(std::forward<Fn>(fn), txn.handle());
+        }
+
         /// \brief Checks whether the singleton value exists.
         /// \param txn Optional transaction handle.
         /// \return \c true if the value exists.
@@ -323,6 +413,15 @@ namespace mdbxc {
         }
 
     private:
+        /// \brief Deserialized value and the DBI modification txnid it reflects.
+        struct ValueCacheEntry {
+            std::uint64_t mod_txnid;
+            std::shared_ptr<const ValueT> value; ///< Empty when the value was absent.
+        };
+
+        std::atomic<bool> m_value_cache_enabled{false};  ///< Whether get_shared() caches values.
+        mutable std::shared_ptr<const ValueCacheEntry> m_value_cache; ///< Accessed with std::atomic_load/atomic_store.
+
         template<typename F>
         void with_transaction(F&& action, TransactionMode mode, MDBX_txn* txn = nullptr) const {
             if (txn) {
@@ -334,6 +433,7 @@ namespace mdbxc {
                 action(txn);
                 return;
             }
+            if (try_group_write(action, mode)) return;
 
             auto txn_guard = m_connection->transaction(mode);
             try {
@@ -363,7 +463,7 @@ namespace mdbxc {
                        "Failed to set value");
 #           if MDBXC_SYNC_ENABLED
             record_op(txn, sync::ChangeOpType::Put,
-                      capture_bytes(db_key), capture_bytes(db_val));
+                      db_key, db_val);
 #           endif
         }
 
@@ -376,7 +476,7 @@ namespace mdbxc {
             if (rc == MDBX_SUCCESS) {
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn, sync::ChangeOpType::Put,
-                          capture_bytes(db_key), capture_bytes(db_val));
+                          db_key, db_val);
 #               endif
                 return true;
             }
@@ -396,6 +496,50 @@ namespace mdbxc {
             return true;
         }
 
+        std::shared_ptr<const ValueT> db_get_shared(MDBX_txn* txn) const {
+            if (!value_cache_enabled()) {
+                ValueT value;
+                if (!db_get(value, txn)) return std::shared_ptr<const ValueT>();
+                return std::make_shared<const ValueT>(std::move(value));
+            }
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat)),
+                       "Failed to query statistics");
+            std::shared_ptr<const ValueCacheEntry> entry = std::atomic_load(&m_value_cache);
+            if (entry && entry->mod_txnid == stat.ms_mod_txnid) {
+                return entry->value;
+            }
+            std::shared_ptr<const ValueT> value;
+            ValueT tmp;
+            if (db_get(tmp, txn)) {
+                value = std::make_shared<const ValueT>(std::move(tmp));
+            }
+            // A txnid not below the reading txn belongs to uncommitted changes,
+            // and aborted write txnids are reused by the next writer.
+            if (stat.ms_mod_txnid < mdbx_txn_id(txn)) {
+                std::shared_ptr<const ValueCacheEntry> fresh(
+                    new ValueCacheEntry{stat.ms_mod_txnid, value});
+                std::atomic_store(&m_value_cache, fresh);
+            }
+            return value;
+        }
+
+        template<class Fn>
+        bool db_update_bytes(Fn& fn, MDBX_txn* txn) {
+            SerializeScratch sc_key;
+            SerializeScratch sc_value;
+            MDBX_val db_key = make_key(sc_key);
+            MDBX_val db_val;
+            int rc = patch_value_bytes(txn, m_dbi, &db_key, fn, db_val, sc_value);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to patch value bytes");
+#           if MDBXC_SYNC_ENABLED
+            record_op(txn, sync::ChangeOpType::Put,
+                      db_key, db_val);
+#           endif
+            return true;
+        }
+
         bool db_has_value(MDBX_txn* txn) const {
             SerializeScratch sc_key;
             MDBX_val db_key = make_key(sc_key);
@@ -414,7 +558,7 @@ namespace mdbxc {
             if (rc == MDBX_SUCCESS) {
 #               if MDBXC_SYNC_ENABLED
                 record_op(txn, sync::ChangeOpType::Delete,
-                          capture_bytes(db_key), {});
+                          db_key, MDBX_val());
 #               endif
                 return true;
             }
@@ -426,7 +570,7 @@ namespace mdbxc {
         void db_clear(MDBX_txn* txn) {
             check_mdbx(mdbx_drop(txn, m_dbi, 0), "Failed to clear value table");
 #           if MDBXC_SYNC_ENABLED
-            record_op(txn, sync::ChangeOpType::ClearTable, {}, {});
+            record_op(txn, sync::ChangeOpType::ClearTable, MDBX_val(), MDBX_val());
 #           endif
         }
     };
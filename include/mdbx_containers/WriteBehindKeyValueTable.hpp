@@ -0,0 +1,406 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_WRITE_BEHIND_KEY_VALUE_TABLE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_WRITE_BEHIND_KEY_VALUE_TABLE_HPP_INCLUDED
+
+/// \file WriteBehindKeyValueTable.hpp
+/// \brief \ref KeyValueTable that coalesces writes in memory and flushes them in batches.
+
+#include "KeyValueTable.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace mdbxc {
+
+    /// \struct WriteBehindOptions
+    /// \brief When a \ref WriteBehindKeyValueTable flushes its buffer.
+    struct WriteBehindOptions {
+        /// \brief Buffered keys that wake the flush thread.
+        /// \details Writers flush inline once the buffer holds twice as many
+        /// keys, or at this size when there is no flush thread.
+        std::size_t max_entries = 4096;
+        /// \brief Period of the background flush; zero disables the thread.
+        std::chrono::milliseconds flush_interval{100};
+    };
+
+    /// \struct WriteBehindStats
+    /// \brief Counters of a \ref WriteBehindKeyValueTable buffer.
+    struct WriteBehindStats {
+        std::uint64_t writes = 0;          ///< Buffered puts, updates and erases.
+        std::uint64_t coalesced = 0;       ///< Writes merged into a key already buffered.
+        std::uint64_t flushes = 0;         ///< Committed flush transactions.
+        std::uint64_t flushed_records = 0; ///< Records written or erased by flushes.
+        std::uint64_t failed_flushes = 0;  ///< Flushes rolled back; their keys stay buffered.
+        std::size_t   pending = 0;         ///< Keys waiting for the next flush.
+    };
+
+    /// \class WriteBehindKeyValueTable
+    /// \ingroup mdbxc_tables
+    /// \brief Write-behind buffer over a \ref KeyValueTable for high-rate updates.
+    /// \tparam KeyT Type of the keys.
+    /// \tparam ValueT Type of the values.
+    /// \tparam Options Compile-time table policy, as for \ref KeyValueTable.
+    /// \details
+    /// Writes change an in-memory map from key to the latest value or an
+    /// erase marker, so repeated updates of one key (counters, last-seen
+    /// timestamps) cost one record write per flush. A flush writes the whole
+    /// buffer in key order in one write transaction. It runs on a background
+    /// thread every \c flush_interval, when the buffer reaches
+    /// \c max_entries, on \ref flush() and in the destructor.
+    ///
+    /// Reads look at the buffer first, then at the records being flushed,
+    /// then at the table, so they always see the latest write made through
+    /// this object.
+    ///
+    /// \note Buffered writes are lost if the process dies before a flush;
+    ///       call \ref flush() at durability points. A flush that fails is
+    ///       rolled back and its keys stay buffered unless written again.
+    /// \note Flushes open their own transaction and throw
+    ///       \c std::logic_error when the calling thread already has one on
+    ///       the connection.
+    template<class KeyT, class ValueT, class Options = DefaultTableOptions>
+    class WriteBehindKeyValueTable {
+    public:
+        typedef KeyValueTable<KeyT, ValueT, Options> table_type;
+
+        /// \brief Opens table \p name and starts the flush thread.
+        /// \param connection Existing \ref Connection instance.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param options Flush thresholds.
+        /// \param flags Additional MDBX database flags.
+        /// \throws std::invalid_argument if \c options.max_entries is zero.
+        WriteBehindKeyValueTable(std::shared_ptr<Connection> connection,
+                                 std::string name = "kv_store",
+                                 WriteBehindOptions options = WriteBehindOptions(),
+                                 MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : m_connection(std::move(connection)),
+              m_table(m_connection, std::move(name), flags),
+              m_options(validate_options(options)) {
+            if (m_options.flush_interval.count() > 0) {
+                m_worker = std::thread(&WriteBehindKeyValueTable::run_worker, this);
+            }
+        }
+
+        /// \brief Constructor with configuration.
+        /// \param config Configuration settings for the database.
+        /// \param name Name of the table within the MDBX environment.
+        /// \param options Flush thresholds.
+        /// \param flags Additional MDBX database flags.
+        explicit WriteBehindKeyValueTable(const Config& config,
+                                          std::string name = "kv_store",
+                                          WriteBehindOptions options = WriteBehindOptions(),
+                                          MDBX_db_flags_t flags = MDBX_DB_DEFAULTS | MDBX_CREATE)
+            : WriteBehindKeyValueTable(Connection::create(config), std::move(name),
+                                       options, flags) {}
+
+        /// \brief Stops the flush thread and flushes the buffer.
+        /// \details Errors of the final flush are swallowed; call \ref flush()
+        ///          before destruction to observe them.
+        ~WriteBehindKeyValueTable() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            if (m_worker.joinable()) m_worker.join();
+            try {
+                flush();
+            } catch (...) {
+            }
+        }
+
+        WriteBehindKeyValueTable(const WriteBehindKeyValueTable&) = delete;
+        WriteBehindKeyValueTable& operator=(const WriteBehindKeyValueTable&) = delete;
+
+        /// \brief Returns the connection.
+        const std::shared_ptr<Connection>& connection() const noexcept { return m_connection; }
+
+        /// \brief Returns the underlying table.
+        /// \details Reads through it do not see buffered writes.
+        table_type& table() noexcept { return m_table; }
+
+        /// \brief Returns the underlying table.
+        const table_type& table() const noexcept { return m_table; }
+
+        /// \brief Returns the flush thresholds.
+        const WriteBehindOptions& options() const noexcept { return m_options; }
+
+        // --- Writes ---
+
+        /// \brief Buffers \p value as the new value of \p key.
+        void insert_or_assign(const KeyT& key, const ValueT& value) {
+            buffer_write(key, [&value](Pending& pending) {
+                pending.erased = false;
+                pending.value = value;
+            });
+        }
+
+        /// \brief Applies \p fn to the current value of \p key and buffers the result.
+        /// \details The current value is the buffered one, otherwise the stored
+        /// one, otherwise \p initial. Only the first update of a key between
+        /// flushes reads the table.
+        /// \param key Key to update.
+        /// \param fn Mutator invoked as \c fn(ValueT&).
+        /// \param initial Value used when the key is absent.
+        /// \throws MdbxException if reading the stored value fails.
+        template<typename Fn>
+        void update(const KeyT& key, Fn fn, const ValueT& initial = ValueT()) {
+            std::size_t pending_count = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                typename Buffer::iterator it = m_pending.find(key);
+                if (it != m_pending.end()) {
+                    ++m_stats.coalesced;
+                } else {
+                    Pending base;
+                    const Pending* flushing = find_in(m_flushing, key);
+                    if (flushing) {
+                        base = *flushing;
+                    } else {
+                        // A flush in progress does not touch keys missing from both buffers.
+                        base.value = initial;
+                        load_stored(key, base.value);
+                    }
+                    it = m_pending.insert(std::make_pair(key, std::move(base))).first;
+                }
+                if (it->second.erased) {
+                    it->second.erased = false;
+                    it->second.value = initial;
+                }
+                fn(it->second.value);
+                ++m_stats.writes;
+                pending_count = m_pending.size();
+            }
+            after_write(pending_count);
+        }
+
+        /// \brief Buffers the removal of \p key.
+        void erase(const KeyT& key) {
+            buffer_write(key, [](Pending& pending) {
+                pending.erased = true;
+                pending.value = ValueT();
+            });
+        }
+
+        /// \brief Drops the buffer and removes every stored record.
+        /// \throws MdbxException if a database error occurs.
+        void clear() {
+            std::lock_guard<std::mutex> flush_lock(m_flush_mutex);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pending.clear();
+            }
+            Transaction txn = m_connection->transaction(TransactionMode::WRITABLE);
+            m_table.clear(txn);
+            txn.commit();
+        }
+
+        // --- Reads ---
+
+#       if __cplusplus >= 201703L
+        /// \brief Finds the latest value of \p key.
+        /// \throws MdbxException if a database error occurs.
+        std::optional<ValueT> find(const KeyT& key) const {
+            ValueT value;
+            if (!lookup(key, value)) return std::nullopt;
+            return value;
+        }
+#       else
+        /// \brief Finds the latest value of \p key.
+        /// \return Pair of success flag and value.
+        /// \throws MdbxException if a database error occurs.
+        std::pair<bool, ValueT> find(const KeyT& key) const {
+            ValueT value;
+            const bool found = lookup(key, value);
+            return std::make_pair(found, found ? value : ValueT());
+        }
+#       endif
+
+        /// \brief Returns the latest value of \p key.
+        /// \throws std::out_of_range if the key is absent.
+        /// \throws MdbxException if a database error occurs.
+        ValueT at(const KeyT& key) const {
+            ValueT value;
+            if (!lookup(key, value)) throw std::out_of_range("Key not found");
+            return value;
+        }
+
+        /// \brief Checks whether \p key has a value, buffered or stored.
+        /// \throws MdbxException if a database error occurs.
+        bool contains(const KeyT& key) const {
+            ValueT value;
+            return lookup(key, value);
+        }
+
+        // --- Flushing ---
+
+        /// \brief Writes every buffered key in one transaction.
+        /// \return Number of records written or erased.
+        /// \throws MdbxException if a database error occurs; the keys stay
+        ///         buffered unless written again meanwhile.
+        /// \throws std::logic_error if the calling thread has an active
+        ///         transaction on the connection.
+        std::size_t flush() {
+            std::lock_guard<std::mutex> flush_lock(m_flush_mutex);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_pending.empty()) return 0;
+                m_flushing.swap(m_pending);
+            }
+            // m_flushing only changes under both mutexes, so it can be read
+            // here while readers look at it under m_mutex.
+            try {
+                Transaction txn = m_connection->transaction(TransactionMode::WRITABLE);
+                for (typename Buffer::const_iterator it = m_flushing.begin();
+                     it != m_flushing.end(); ++it) {
+                    if (it->second.erased) {
+                        m_table.erase(it->first, txn);
+                    } else {
+                        m_table.insert_or_assign(it->first, it->second.value, txn);
+                    }
+                }
+                txn.commit();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                // Writes buffered during the flush are newer and win.
+                for (typename Buffer::iterator it = m_flushing.begin();
+                     it != m_flushing.end(); ++it) {
+                    m_pending.insert(std::move(*it));
+                }
+                m_flushing.clear();
+                ++m_stats.failed_flushes;
+                throw;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const std::size_t flushed = m_flushing.size();
+            m_flushing.clear();
+            ++m_stats.flushes;
+            m_stats.flushed_records += flushed;
+            return flushed;
+        }
+
+        /// \brief Returns the number of keys waiting for a flush.
+        std::size_t pending_count() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_pending.size();
+        }
+
+        /// \brief Returns the buffer counters.
+        WriteBehindStats stats() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            WriteBehindStats stats = m_stats;
+            stats.pending = m_pending.size();
+            return stats;
+        }
+
+    private:
+        /// \brief Latest buffered write of one key.
+        struct Pending {
+            bool   erased = false; ///< Erase marker; \c value is unused when set.
+            ValueT value = ValueT();
+        };
+
+        typedef std::map<KeyT, Pending> Buffer;
+
+        std::shared_ptr<Connection> m_connection;
+        table_type                  m_table;
+        WriteBehindOptions          m_options;
+        mutable std::mutex          m_mutex;       ///< Guards the buffers, stats and stop flag.
+        std::mutex                  m_flush_mutex; ///< Serializes flushes and clear().
+        Buffer                      m_pending;     ///< Writes since the last flush started.
+        Buffer                      m_flushing;    ///< Writes of the flush in progress.
+        WriteBehindStats            m_stats;
+        std::condition_variable     m_wake;
+        bool                        m_stop = false;
+        std::thread                 m_worker;
+
+        static WriteBehindOptions validate_options(const WriteBehindOptions& options) {
+            if (options.max_entries == 0) {
+                throw std::invalid_argument("WriteBehindOptions::max_entries must be positive");
+            }
+            return options;
+        }
+
+        template<typename F>
+        void buffer_write(const KeyT& key, F apply) {
+            std::size_t pending_count = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::pair<typename Buffer::iterator, bool> slot =
+                    m_pending.insert(std::make_pair(key, Pending()));
+                if (!slot.second) ++m_stats.coalesced;
+                apply(slot.first->second);
+                ++m_stats.writes;
+                pending_count = m_pending.size();
+            }
+            after_write(pending_count);
+        }
+
+        /// \brief Wakes the flush thread or flushes inline once the buffer is full.
+        void after_write(std::size_t pending_count) {
+            if (pending_count < m_options.max_entries) return;
+            if (m_worker.joinable() && pending_count < 2 * m_options.max_entries) {
+                m_wake.notify_one();
+                return;
+            }
+            flush();
+        }
+
+        /// \brief Returns the buffered write of \p key in \p buffer, or \c nullptr.
+        /// \pre \c m_mutex is held.
+        static const Pending* find_in(const Buffer& buffer, const KeyT& key) {
+            typename Buffer::const_iterator it = buffer.find(key);
+            return it == buffer.end() ? nullptr : &it->second;
+        }
+
+        /// \brief Reads the stored value of \p key into \p out if present.
+        bool load_stored(const KeyT& key, ValueT& out) const {
+#           if __cplusplus >= 201703L
+            std::optional<ValueT> stored = m_table.find(key);
+            if (!stored) return false;
+            out = std::move(*stored);
+#           else
+            std::pair<bool, ValueT> stored = m_table.find(key);
+            if (!stored.first) return false;
+            out = std::move(stored.second);
+#           endif
+            return true;
+        }
+
+        bool lookup(const KeyT& key, ValueT& out) const {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            const Pending* pending = find_in(m_pending, key);
+            if (!pending) pending = find_in(m_flushing, key);
+            if (pending) {
+                if (pending->erased) return false;
+                out = pending->value;
+                return true;
+            }
+            lock.unlock();
+            // A flush committing meanwhile only makes the table newer.
+            return load_stored(key, out);
+        }
+
+        void run_worker() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_stop) {
+                m_wake.wait_for(lock, m_options.flush_interval, [this]() {
+                    return m_stop || m_pending.size() >= m_options.max_entries;
+                });
+                if (m_stop || m_pending.empty()) continue;
+                lock.unlock();
+                try {
+                    flush();
+                } catch (...) {
+                    // Counted in failed_flushes; the keys stay buffered.
+                }
+                lock.lock();
+            }
+        }
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_WRITE_BEHIND_KEY_VALUE_TABLE_HPP_INCLUDED
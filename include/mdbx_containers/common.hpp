@@ -41,10 +41,22 @@
 #endif
 
 #include "common/MdbxException.hpp"
+#include "common/Status.hpp"
 #include "common/Config.hpp"
+#include "common/TraceScope.hpp"
 #include "common/TransactionTracker.hpp"
 #include "detail/utils.hpp"
+#include "detail/CompositeKey.hpp"
 #include "common/Transaction.hpp"
+#include "common/Snapshot.hpp"
+#include "common/TableMetrics.hpp"
+#include "common/KeyAccessSampler.hpp"
+#include "common/BulkLoad.hpp"
+#include "common/Reconcile.hpp"
+#include "common/Retention.hpp"
+#include "common/MergeOperator.hpp"
+#include "common/CompactCodec.hpp"
+#include "common/Compression.hpp"
 #include "detail/path_utils.hpp"
 #if MDBXC_SYNC_ENABLED
 #include "sync/ISyncCaptureSink.hpp"
@@ -8,7 +8,12 @@
 /// Provides thin wrappers over libmdbx backup primitives (`mdbx_env_copy`,
 /// `mdbx_env_sync_ex`). Operations are scoped at the \ref Connection level
 /// because backup copies the whole MDBX environment, not an individual
-/// logical table.
+/// logical table. Besides a target path, a backup can be written to an open
+/// file handle or streamed through a \ref BackupSink without a temporary file.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 
 namespace mdbxc {
 
@@ -28,8 +33,19 @@ namespace mdbxc {
         /// \ref Connection::sync_to_disk or external fsync.
         bool dont_flush = false;
         bool force_dynamic_size = false; ///< Allow the copy to dynamically resize the target environment instead of inheriting the source geometry.
+
+        /// \brief I/O cap for \ref Connection::backup_to_stream and
+        /// \ref Connection::backup_to_fd, in bytes per second; 0 is unlimited.
+        /// Throttling the consumer of the copy pipe stalls MDBX's copier, so
+        /// the cap also bounds read I/O on the live database.
+        std::uint64_t max_bytes_per_sec = 0;
     };
 
+    /// \brief Consumer of a streamed backup, see \ref Connection::backup_to_stream.
+    /// \details Receives the environment image in order, in chunks of at most
+    /// 1 MiB. An exception thrown by the sink aborts the backup and is rethrown.
+    typedef std::function<void(const void* data, std::size_t size)> BackupSink;
+
 } // namespace mdbxc
 
 #endif // MDBX_CONTAINERS_HEADER_BACKUP_HPP_INCLUDED
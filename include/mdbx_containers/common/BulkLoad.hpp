@@ -0,0 +1,23 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_BULK_LOAD_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_BULK_LOAD_HPP_INCLUDED
+
+/// \file BulkLoad.hpp
+/// \brief Options for sorted bulk loading through \c MDBX_APPEND.
+/// \details
+/// Tables that expose \c bulk_load_sorted() write records with \c MDBX_APPEND,
+/// which skips the per-key tree search and fills pages densely. The fast path
+/// requires every record key to be greater than the last key already stored
+/// in the table, which MDBX itself verifies on each put.
+
+namespace mdbxc {
+
+    /// \brief Reaction of \c bulk_load_sorted() to out-of-order input.
+    enum class BulkLoadMode {
+        Strict,  ///< Throw \ref MdbxException with \c MDBX_EKEYMISMATCH on the first out-of-order key.
+        Fallback ///< Switch to regular per-key writes for the remaining records.
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_BULK_LOAD_HPP_INCLUDED
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_COMMIT_LATENCY_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_COMMIT_LATENCY_HPP_INCLUDED
+
+/// \file CommitLatency.hpp
+/// \brief Phase breakdown of one MDBX write commit.
+
+#include <chrono>
+#include <cstdint>
+
+namespace mdbxc {
+
+    /// \struct CommitLatency
+    /// \brief Where the time of a write commit went, as reported by
+    /// \c mdbx_txn_commit_ex().
+    /// \details MDBX measures in 1/65536 s, so values are rounded to about
+    /// 15 us. A large \c sync points to fsync stalls, a large \c gc to
+    /// free-list (GC) maintenance. All fields are zero before the first
+    /// successful commit.
+    struct CommitLatency {
+        std::chrono::nanoseconds preparation{0}; ///< Merging nested transactions and collecting dirty pages.
+        std::chrono::nanoseconds gc{0};          ///< Wall time updating the GC (free-list).
+        std::chrono::nanoseconds audit{0};       ///< Internal audit, when MDBX was built with it.
+        std::chrono::nanoseconds write{0};       ///< Writing dirty pages.
+        std::chrono::nanoseconds sync{0};        ///< \c fdatasync or \c msync of the written pages.
+        std::chrono::nanoseconds ending{0};      ///< Releasing the transaction.
+        std::chrono::nanoseconds whole{0};       ///< Whole commit as measured by MDBX.
+        std::chrono::nanoseconds gc_cpu{0};      ///< CPU time updating the GC.
+
+        /// \brief Converts an MDBX duration in 1/65536 s to nanoseconds.
+        static std::chrono::nanoseconds from_mdbx_units(std::uint32_t value) noexcept {
+            return std::chrono::nanoseconds(
+                static_cast<std::int64_t>((static_cast<std::uint64_t>(value) * 1000000000ULL) >> 16));
+        }
+
+        /// \brief Adds every phase of \p other.
+        CommitLatency& operator+=(const CommitLatency& other) noexcept {
+            preparation += other.preparation;
+            gc += other.gc;
+            audit += other.audit;
+            write += other.write;
+            sync += other.sync;
+            ending += other.ending;
+            whole += other.whole;
+            gc_cpu += other.gc_cpu;
+            return *this;
+        }
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_COMMIT_LATENCY_HPP_INCLUDED
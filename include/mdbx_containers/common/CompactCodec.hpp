@@ -0,0 +1,306 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_COMPACT_CODEC_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_COMPACT_CODEC_HPP_INCLUDED
+
+/// \file CompactCodec.hpp
+/// \brief Opt-in compact value encodings for integer vectors.
+/// \details
+/// The default value serializer stores vectors of integers as raw fixed-width
+/// elements. The wrappers here store them as LEB128 varints (ZigZag for
+/// signed types), optionally as deltas between neighbours, which is several
+/// times smaller for small or sorted values. They plug into the regular
+/// \c to_bytes()/from_bytes() and \c serialized_size()/write_bytes() hooks,
+/// so any table accepts them as \c ValueT. The encoding is a storage format:
+/// a table must keep using the same wrapper for its existing records.
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \brief LEB128 varint primitives used by the compact value wrappers.
+    namespace compact {
+
+        /// \brief Returns the encoded size of an unsigned varint.
+        inline std::size_t varint_size(std::uint64_t value) noexcept {
+            std::size_t size = 1;
+            while (value >= 0x80u) {
+                value >>= 7;
+                ++size;
+            }
+            return size;
+        }
+
+        /// \brief Writes an unsigned varint.
+        /// \return Pointer past the last written byte.
+        inline std::uint8_t* write_varint(std::uint64_t value, std::uint8_t* out) noexcept {
+            while (value >= 0x80u) {
+                *out++ = static_cast<std::uint8_t>(value | 0x80u);
+                value >>= 7;
+            }
+            *out++ = static_cast<std::uint8_t>(value);
+            return out;
+        }
+
+        /// \brief Reads an unsigned varint and advances \p ptr.
+        /// \throws std::runtime_error on truncated or over-long input.
+        inline std::uint64_t read_varint(const std::uint8_t*& ptr, const std::uint8_t* end) {
+            std::uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (ptr == end) {
+                    throw std::runtime_error("compact codec: truncated varint");
+                }
+                const std::uint8_t byte = *ptr++;
+                if (shift == 63 && byte > 1) {
+                    throw std::runtime_error("compact codec: varint overflow");
+                }
+                value |= static_cast<std::uint64_t>(byte & 0x7fu) << shift;
+                if (!(byte & 0x80u)) {
+                    return value;
+                }
+            }
+            throw std::runtime_error("compact codec: varint overflow");
+        }
+
+        /// \brief Maps a signed value to unsigned so small magnitudes stay short.
+        inline std::uint64_t zigzag_encode(std::int64_t value) noexcept {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        /// \brief Inverse of \ref zigzag_encode().
+        inline std::int64_t zigzag_decode(std::uint64_t value) noexcept {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1u);
+        }
+
+        /// \brief Element encoding for one integer type.
+        template<class T, bool Signed = std::is_signed<T>::value>
+        struct IntegerCodec {
+            static std::uint64_t encode(T value) noexcept {
+                return static_cast<std::uint64_t>(value);
+            }
+            static T decode(std::uint64_t value) {
+                if (value > static_cast<std::uint64_t>((std::numeric_limits<T>::max)())) {
+                    throw std::runtime_error("compact codec: value out of range");
+                }
+                return static_cast<T>(value);
+            }
+            static std::uint64_t delta(T prev, T value) noexcept {
+                return static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(prev);
+            }
+            static T undelta(T prev, std::uint64_t delta) {
+                const std::uint64_t sum = static_cast<std::uint64_t>(prev) + delta;
+                if (sum < static_cast<std::uint64_t>(prev)) {
+                    throw std::runtime_error("compact codec: delta overflow");
+                }
+                return decode(sum);
+            }
+        };
+
+        template<class T>
+        struct IntegerCodec<T, true> {
+            static std::uint64_t encode(T value) noexcept {
+                return zigzag_encode(static_cast<std::int64_t>(value));
+            }
+            static T decode(std::uint64_t value) {
+                return narrow(zigzag_decode(value));
+            }
+            static std::uint64_t delta(T prev, T value) noexcept {
+                return static_cast<std::uint64_t>(static_cast<std::int64_t>(value)) -
+                       static_cast<std::uint64_t>(static_cast<std::int64_t>(prev));
+            }
+            static T undelta(T prev, std::uint64_t delta) {
+                const std::uint64_t sum = static_cast<std::uint64_t>(static_cast<std::int64_t>(prev)) + delta;
+                const std::int64_t value = static_cast<std::int64_t>(sum);
+                if (value < static_cast<std::int64_t>(prev)) {
+                    throw std::runtime_error("compact codec: delta overflow");
+                }
+                return narrow(value);
+            }
+            static T narrow(std::int64_t value) {
+                if (value < static_cast<std::int64_t>((std::numeric_limits<T>::min)()) ||
+                    value > static_cast<std::int64_t>((std::numeric_limits<T>::max)())) {
+                    throw std::runtime_error("compact codec: value out of range");
+                }
+                return static_cast<T>(value);
+            }
+        };
+
+        /// \brief Returns the encoded size of one integer run.
+        /// \throws std::invalid_argument if \p Delta is set and the run is not sorted.
+        template<class T, bool Delta>
+        std::size_t run_size(const std::vector<T>& values) {
+            std::size_t size = 0;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                if (Delta && i) {
+                    if (values[i] < values[i - 1]) {
+                        throw std::invalid_argument("compact codec: delta-encoded values must be sorted");
+                    }
+                    size += varint_size(IntegerCodec<T>::delta(values[i - 1], values[i]));
+                } else {
+                    size += varint_size(IntegerCodec<T>::encode(values[i]));
+                }
+            }
+            return size;
+        }
+
+        /// \brief Writes one integer run sized by \ref run_size().
+        template<class T, bool Delta>
+        std::uint8_t* write_run(const std::vector<T>& values, std::uint8_t* out) noexcept {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                out = write_varint(Delta && i
+                    ? IntegerCodec<T>::delta(values[i - 1], values[i])
+                    : IntegerCodec<T>::encode(values[i]), out);
+            }
+            return out;
+        }
+
+        /// \brief Appends one decoded element to \p out.
+        template<class T, bool Delta>
+        void read_element(const std::uint8_t*& ptr, const std::uint8_t* end, std::vector<T>& out) {
+            const std::uint64_t raw = read_varint(ptr, end);
+            out.push_back(Delta && !out.empty()
+                ? IntegerCodec<T>::undelta(out.back(), raw)
+                : IntegerCodec<T>::decode(raw));
+        }
+
+    } // namespace compact
+
+    /// \class CompactVector
+    /// \brief \c std::vector of integers stored as varints.
+    /// \tparam T Integer element type other than \c bool.
+    /// \tparam Delta Store each element as the difference to its predecessor.
+    ///         Requires non-decreasing values; writes of unsorted data throw
+    ///         \c std::invalid_argument.
+    /// \details The record is the bare varint stream; the element count is
+    /// implied by its length.
+    template<class T, bool Delta = false>
+    struct CompactVector {
+        static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                      "CompactVector requires an integer element type");
+
+        std::vector<T> values; ///< Decoded elements.
+
+        CompactVector() = default;
+
+        /// \brief Wraps existing elements.
+        CompactVector(std::vector<T> v) : values(std::move(v)) {}
+
+        /// \brief Returns the encoded size in bytes.
+        std::size_t serialized_size() const {
+            return compact::run_size<T, Delta>(values);
+        }
+
+        /// \brief Writes exactly \ref serialized_size() bytes.
+        void write_bytes(void* out) const {
+            compact::write_run<T, Delta>(values, static_cast<std::uint8_t*>(out));
+        }
+
+        /// \brief Returns the encoded record.
+        std::vector<std::uint8_t> to_bytes() const {
+            std::vector<std::uint8_t> out(serialized_size());
+            if (!out.empty()) {
+                write_bytes(out.data());
+            }
+            return out;
+        }
+
+        /// \brief Decodes a record written by \ref write_bytes().
+        /// \throws std::runtime_error on malformed input.
+        static CompactVector from_bytes(const void* data, std::size_t size) {
+            CompactVector result;
+            const std::uint8_t* ptr = static_cast<const std::uint8_t*>(data);
+            const std::uint8_t* end = ptr + size;
+            while (ptr != end) {
+                compact::read_element<T, Delta>(ptr, end, result.values);
+            }
+            return result;
+        }
+
+        bool operator==(const CompactVector& other) const { return values == other.values; }
+        bool operator!=(const CompactVector& other) const { return values != other.values; }
+    };
+
+    /// \class CompactNestedVector
+    /// \brief \c std::vector<std::vector<T>> of integers stored as varints.
+    /// \tparam T Integer element type other than \c bool.
+    /// \tparam Delta Delta-encode each inner vector; inner vectors must be sorted.
+    /// \details Each inner vector is a varint element count followed by its
+    /// varint run. Deltas restart at every inner vector.
+    template<class T, bool Delta = false>
+    struct CompactNestedVector {
+        static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                      "CompactNestedVector requires an integer element type");
+
+        std::vector<std::vector<T> > values; ///< Decoded inner vectors.
+
+        CompactNestedVector() = default;
+
+        /// \brief Wraps existing inner vectors.
+        CompactNestedVector(std::vector<std::vector<T> > v) : values(std::move(v)) {}
+
+        /// \brief Returns the encoded size in bytes.
+        std::size_t serialized_size() const {
+            std::size_t size = 0;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                size += compact::varint_size(values[i].size());
+                size += compact::run_size<T, Delta>(values[i]);
+            }
+            return size;
+        }
+
+        /// \brief Writes exactly \ref serialized_size() bytes.
+        void write_bytes(void* out) const {
+            std::uint8_t* ptr = static_cast<std::uint8_t*>(out);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                ptr = compact::write_varint(values[i].size(), ptr);
+                ptr = compact::write_run<T, Delta>(values[i], ptr);
+            }
+        }
+
+        /// \brief Returns the encoded record.
+        std::vector<std::uint8_t> to_bytes() const {
+            std::vector<std::uint8_t> out(serialized_size());
+            if (!out.empty()) {
+                write_bytes(out.data());
+            }
+            return out;
+        }
+
+        /// \brief Decodes a record written by \ref write_bytes().
+        /// \throws std::runtime_error on malformed input.
+        static CompactNestedVector from_bytes(const void* data, std::size_t size) {
+            CompactNestedVector result;
+            const std::uint8_t* ptr = static_cast<const std::uint8_t*>(data);
+            const std::uint8_t* end = ptr + size;
+            while (ptr != end) {
+                const std::uint64_t count = compact::read_varint(ptr, end);
+                // Every element takes at least one byte.
+                if (count > static_cast<std::uint64_t>(end - ptr)) {
+                    throw std::runtime_error("compact codec: corrupted element count");
+                }
+                result.values.push_back(std::vector<T>());
+                std::vector<T>& inner = result.values.back();
+                inner.reserve(static_cast<std::size_t>(count));
+                for (std::uint64_t i = 0; i < count; ++i) {
+                    compact::read_element<T, Delta>(ptr, end, inner);
+                }
+            }
+            return result;
+        }
+
+        bool operator==(const CompactNestedVector& other) const { return values == other.values; }
+        bool operator!=(const CompactNestedVector& other) const { return values != other.values; }
+    };
+
+    /// \brief Delta-encoded varint vector for sorted integers.
+    template<class T>
+    using DeltaVector = CompactVector<T, true>;
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_COMPACT_CODEC_HPP_INCLUDED
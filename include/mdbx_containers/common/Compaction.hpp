@@ -0,0 +1,56 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_COMPACTION_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_COMPACTION_HPP_INCLUDED
+
+/// \file Compaction.hpp
+/// \brief Options and results of \c Connection::compact_to().
+/// \details
+/// Compaction rebuilds every named DBI into a new environment with sorted
+/// \c MDBX_APPEND writes, which fill pages densely. The calling thread reads
+/// every DBI from one read transaction and appends the records straight from
+/// the source pages, so the target is a single snapshot of the source.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace mdbxc {
+
+    /// \brief Progress of one DBI during compaction.
+    struct CompactProgress {
+        std::string   table;              ///< DBI name.
+        std::uint64_t entries_copied = 0; ///< Records written to the target so far.
+        std::uint64_t entries_total = 0;  ///< Records in the source when compaction started.
+        std::uint64_t bytes = 0;          ///< Key and value bytes written so far.
+        bool          done = false;       ///< The DBI is fully copied.
+    };
+
+    /// \brief Callback type of \ref CompactOptions::progress.
+    typedef std::function<void(const CompactProgress&)> CompactProgressHandler;
+
+    /// \brief Options of \c Connection::compact_to().
+    struct CompactOptions {
+        /// \brief Unused; kept for source compatibility. The copy runs on the
+        /// calling thread so that every DBI comes from one read transaction.
+        std::size_t threads = 0;
+        /// \brief Records per batch; each batch is one target write transaction.
+        std::size_t batch_entries = 65536;
+        /// \brief Optional callback invoked on the calling thread after each batch.
+        CompactProgressHandler progress;
+    };
+
+    /// \brief Outcome of \c Connection::compact_to().
+    struct CompactResult {
+        std::size_t   tables = 0;            ///< DBIs copied.
+        std::uint64_t entries = 0;           ///< Records copied.
+        std::uint64_t bytes = 0;             ///< Key and value bytes copied.
+        std::uint64_t source_used_bytes = 0; ///< Used size of the source before compaction.
+        std::uint64_t target_used_bytes = 0; ///< Used size of the target after compaction.
+        std::chrono::milliseconds elapsed{0}; ///< Wall time spent.
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_COMPACTION_HPP_INCLUDED
@@ -0,0 +1,325 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_COMPRESSION_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_COMPRESSION_HPP_INCLUDED
+
+/// \file Compression.hpp
+/// \brief Opt-in transparent value compression.
+/// \details
+/// \ref Compressed wraps any serializable value type. Every record starts with
+/// a one-byte header: \c 0 marks the plain serialized value, any other value
+/// is the id of the codec that compressed it, followed by the varint length of
+/// the plain value and the codec payload. Values shorter than the threshold,
+/// or ones the codec cannot shrink, are stored plain, so a table may mix both
+/// forms and raising or lowering the threshold never breaks existing records.
+///
+/// A codec is a type with these static members:
+/// \code
+/// static std::uint8_t id();   // non-zero, unique per codec
+/// // Appends the compressed form of src to out; returns false to store plain.
+/// static bool compress(const void* src, std::size_t size, std::vector<std::uint8_t>& out);
+/// // Expands exactly raw_size bytes into dst; throws on corrupted input.
+/// static void decompress(const void* src, std::size_t size, void* dst, std::size_t raw_size);
+/// \endcode
+///
+/// \ref ZstdCodec (requires \c MDBXC_HAS_ZSTD=1 and libzstd) and \ref Lz4Codec
+/// (requires \c MDBXC_HAS_LZ4=1 and liblz4) are provided.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+#include <zstd.h>
+#include <zdict.h>
+#endif
+
+#if defined(MDBXC_HAS_LZ4) && MDBXC_HAS_LZ4
+#include <lz4.h>
+#endif
+
+namespace mdbxc {
+
+    /// \brief Record framing shared by the compressed value wrappers.
+    namespace compression {
+
+        /// \brief Header byte of a record stored without compression.
+        enum : std::uint8_t { plain_tag = 0 };
+
+        /// \brief Largest plain value size accepted when decoding.
+        enum : std::uint32_t { max_raw_size = 0x7fffffffu };
+
+        /// \brief Frames \p size bytes at \p src, compressing them with \p Codec
+        /// when they reach \p min_size bytes and the result is smaller.
+        template<class Codec>
+        std::vector<std::uint8_t> encode(const void* src, std::size_t size, std::size_t min_size) {
+            std::vector<std::uint8_t> out;
+            if (size && size >= min_size) {
+                out.resize(1 + compact::varint_size(size));
+                out[0] = Codec::id();
+                compact::write_varint(size, &out[1]);
+                if (Codec::compress(src, size, out) && out.size() < 1 + size) {
+                    return out;
+                }
+                out.clear();
+            }
+            out.resize(1 + size);
+            out[0] = plain_tag;
+            if (size) {
+                std::memcpy(&out[1], src, size);
+            }
+            return out;
+        }
+
+        /// \brief Returns the plain value bytes of a framed record.
+        /// \param buffer Receives the expanded bytes of a compressed record;
+        ///        plain records are returned as a view into \p data.
+        /// \throws std::runtime_error on an unknown codec id or malformed input.
+        template<class Codec>
+        MDBX_val decode(const void* data, std::size_t size, std::vector<std::uint8_t>& buffer) {
+            const std::uint8_t* ptr = static_cast<const std::uint8_t*>(data);
+            const std::uint8_t* end = ptr + size;
+            if (ptr == end) {
+                throw std::runtime_error("compression: missing record header");
+            }
+            const std::uint8_t tag = *ptr++;
+            if (tag == plain_tag) {
+                return SerializeScratch::view(ptr, static_cast<std::size_t>(end - ptr));
+            }
+            if (tag != Codec::id()) {
+                throw std::runtime_error("compression: record written by another codec");
+            }
+            const std::uint64_t raw_size = compact::read_varint(ptr, end);
+            if (raw_size > max_raw_size) {
+                throw std::runtime_error("compression: corrupted value size");
+            }
+            buffer.resize(static_cast<std::size_t>(raw_size));
+            Codec::decompress(ptr, static_cast<std::size_t>(end - ptr), buffer.data(), buffer.size());
+            return SerializeScratch::view(buffer.data(), buffer.size());
+        }
+
+        /// \brief Returns the reserved table name for a table's dictionary.
+        /// \details Store the trained dictionary of table \p table_name under
+        /// this name, e.g. in a \c ValueTable<std::vector<uint8_t>>, and load
+        /// it into the codec before the table is read.
+        inline std::string dictionary_table_name(const std::string& table_name) {
+            return table_name + "__dict";
+        }
+
+    } // namespace compression
+
+    /// \class Compressed
+    /// \brief Value wrapper that compresses the serialized form of \p T.
+    /// \tparam T Any type the table could store directly.
+    /// \tparam Codec Codec type, see \ref Compression.hpp.
+    /// \tparam MinSize Serialized values shorter than this are stored plain.
+    /// \details The record header identifies the codec, so a table must keep
+    /// the same \p Codec; rows written by a plain \c T table have no header
+    /// and cannot be read through this wrapper.
+    template<class T, class Codec, std::size_t MinSize = 256>
+    struct Compressed {
+        T value; ///< Decoded value.
+
+        Compressed() : value() {}
+
+        /// \brief Wraps an existing value.
+        Compressed(T v) : value(std::move(v)) {}
+
+        /// \brief Returns the framed record.
+        std::vector<std::uint8_t> to_bytes() const {
+            SerializeScratch sc;
+            const MDBX_val raw = serialize_value(value, sc);
+            return compression::encode<Codec>(raw.iov_base, raw.iov_len, MinSize);
+        }
+
+        /// \brief Decodes a record written by \ref to_bytes().
+        /// \throws std::runtime_error on malformed input.
+        static Compressed from_bytes(const void* data, std::size_t size) {
+            std::vector<std::uint8_t> buffer;
+            return Compressed(deserialize_value<T>(compression::decode<Codec>(data, size, buffer)));
+        }
+
+        bool operator==(const Compressed& other) const { return value == other.value; }
+        bool operator!=(const Compressed& other) const { return !(value == other.value); }
+    };
+
+    /// \brief Compressed text value, e.g. JSON documents.
+    template<class Codec, std::size_t MinSize = 256>
+    using CompressedString = Compressed<std::string, Codec, MinSize>;
+
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+
+    /// \class ZstdDictionary
+    /// \brief Trained Zstd dictionary with its prepared compression contexts.
+    /// \thread_safety Immutable after construction; safe to share between threads.
+    class ZstdDictionary {
+    public:
+        /// \brief Prepares a dictionary.
+        /// \param bytes Dictionary content, e.g. from \ref train().
+        /// \param level Compression level used with this dictionary.
+        /// \throws std::runtime_error if Zstd rejects the dictionary.
+        explicit ZstdDictionary(std::vector<std::uint8_t> bytes, int level = 3)
+            : m_bytes(std::move(bytes)), m_cdict(nullptr), m_ddict(nullptr) {
+            m_cdict = ZSTD_createCDict(m_bytes.data(), m_bytes.size(), level);
+            m_ddict = ZSTD_createDDict(m_bytes.data(), m_bytes.size());
+            if (!m_cdict || !m_ddict) {
+                ZSTD_freeCDict(m_cdict);
+                ZSTD_freeDDict(m_ddict);
+                throw std::runtime_error("zstd: cannot load dictionary");
+            }
+        }
+
+        ZstdDictionary(const ZstdDictionary&) = delete;
+        ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+        ~ZstdDictionary() {
+            ZSTD_freeCDict(m_cdict);
+            ZSTD_freeDDict(m_ddict);
+        }
+
+        /// \brief Trains a dictionary from representative values.
+        /// \param samples Sample records; a few hundred typical values work well.
+        /// \param capacity Maximum dictionary size in bytes.
+        /// \throws std::runtime_error if training fails, e.g. too few samples.
+        static std::vector<std::uint8_t> train(const std::vector<std::string>& samples,
+                                               std::size_t capacity = 64 * 1024) {
+            std::string joined;
+            std::vector<std::size_t> sizes;
+            sizes.reserve(samples.size());
+            for (std::size_t i = 0; i < samples.size(); ++i) {
+                joined += samples[i];
+                sizes.push_back(samples[i].size());
+            }
+            std::vector<std::uint8_t> dict(capacity);
+            const std::size_t size = ZDICT_trainFromBuffer(
+                dict.data(), dict.size(), joined.data(), sizes.data(),
+                static_cast<unsigned>(sizes.size()));
+            if (ZDICT_isError(size)) {
+                throw std::runtime_error(std::string("zstd: dictionary training failed: ") +
+                                         ZDICT_getErrorName(size));
+            }
+            dict.resize(size);
+            return dict;
+        }
+
+        /// \brief Returns the dictionary content for persisting.
+        const std::vector<std::uint8_t>& bytes() const noexcept { return m_bytes; }
+
+        const ZSTD_CDict* cdict() const noexcept { return m_cdict; }
+        const ZSTD_DDict* ddict() const noexcept { return m_ddict; }
+
+    private:
+        std::vector<std::uint8_t> m_bytes;
+        ZSTD_CDict* m_cdict;
+        ZSTD_DDict* m_ddict;
+    };
+
+    /// \class ZstdCodec
+    /// \brief Zstd codec with an optional process-wide dictionary.
+    /// \tparam Tag Distinguishes dictionaries; use one tag type per table.
+    /// \tparam Level Compression level used without a dictionary.
+    /// \details Frames record the dictionary id, so records compressed with a
+    /// dictionary fail to decode unless the same dictionary is loaded.
+    template<class Tag = void, int Level = 3>
+    struct ZstdCodec {
+        static std::uint8_t id() noexcept { return 2; }
+
+        /// \brief Installs the dictionary used by subsequent reads and writes.
+        /// \param dict Dictionary, or \c nullptr to compress without one.
+        static void set_dictionary(std::shared_ptr<const ZstdDictionary> dict) {
+            std::atomic_store(&dictionary_slot(), std::move(dict));
+        }
+
+        /// \brief Returns the installed dictionary or \c nullptr.
+        static std::shared_ptr<const ZstdDictionary> dictionary() {
+            return std::atomic_load(&dictionary_slot());
+        }
+
+        static bool compress(const void* src, std::size_t size, std::vector<std::uint8_t>& out) {
+            const std::size_t offset = out.size();
+            out.resize(offset + ZSTD_compressBound(size));
+            ZSTD_CCtx* ctx = ZSTD_createCCtx();
+            if (!ctx) {
+                throw std::bad_alloc();
+            }
+            const std::shared_ptr<const ZstdDictionary> dict = dictionary();
+            const std::size_t written = dict
+                ? ZSTD_compress_usingCDict(ctx, &out[offset], out.size() - offset, src, size, dict->cdict())
+                : ZSTD_compressCCtx(ctx, &out[offset], out.size() - offset, src, size, Level);
+            ZSTD_freeCCtx(ctx);
+            if (ZSTD_isError(written)) {
+                return false;
+            }
+            out.resize(offset + written);
+            return true;
+        }
+
+        static void decompress(const void* src, std::size_t size, void* dst, std::size_t raw_size) {
+            ZSTD_DCtx* ctx = ZSTD_createDCtx();
+            if (!ctx) {
+                throw std::bad_alloc();
+            }
+            const std::shared_ptr<const ZstdDictionary> dict = dictionary();
+            const std::size_t written = dict
+                ? ZSTD_decompress_usingDDict(ctx, dst, raw_size, src, size, dict->ddict())
+                : ZSTD_decompressDCtx(ctx, dst, raw_size, src, size);
+            ZSTD_freeDCtx(ctx);
+            if (ZSTD_isError(written)) {
+                throw std::runtime_error(std::string("zstd: ") + ZSTD_getErrorName(written));
+            }
+            if (written != raw_size) {
+                throw std::runtime_error("zstd: decompressed size mismatch");
+            }
+        }
+
+    private:
+        static std::shared_ptr<const ZstdDictionary>& dictionary_slot() {
+            static std::shared_ptr<const ZstdDictionary> slot;
+            return slot;
+        }
+    };
+
+#endif // MDBXC_HAS_ZSTD
+
+#if defined(MDBXC_HAS_LZ4) && MDBXC_HAS_LZ4
+
+    /// \class Lz4Codec
+    /// \brief LZ4 block codec: lower ratio than Zstd, much faster decoding.
+    struct Lz4Codec {
+        static std::uint8_t id() noexcept { return 1; }
+
+        static bool compress(const void* src, std::size_t size, std::vector<std::uint8_t>& out) {
+            if (size > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+                return false;
+            }
+            const std::size_t offset = out.size();
+            out.resize(offset + static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(size))));
+            const int written = LZ4_compress_default(
+                static_cast<const char*>(src), reinterpret_cast<char*>(&out[offset]),
+                static_cast<int>(size), static_cast<int>(out.size() - offset));
+            if (written <= 0) {
+                return false;
+            }
+            out.resize(offset + static_cast<std::size_t>(written));
+            return true;
+        }
+
+        static void decompress(const void* src, std::size_t size, void* dst, std::size_t raw_size) {
+            const int written = LZ4_decompress_safe(
+                static_cast<const char*>(src), static_cast<char*>(dst),
+                static_cast<int>(size), static_cast<int>(raw_size));
+            if (written < 0 || static_cast<std::size_t>(written) != raw_size) {
+                throw std::runtime_error("lz4: corrupted record");
+            }
+        }
+    };
+
+#endif // MDBXC_HAS_LZ4
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_COMPRESSION_HPP_INCLUDED
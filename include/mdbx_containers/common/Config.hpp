@@ -9,6 +9,14 @@
 
 namespace mdbxc {
 
+    /// \enum SyncMode
+    /// \brief How write commits reach stable storage.
+    enum class SyncMode {
+        Durable,       ///< Every commit is flushed (\c Config::sync_durable applies).
+        SafeNoSync,    ///< \c MDBX_SAFE_NOSYNC: commits are not flushed; a crash loses only unflushed commits.
+        UtterlyNoSync  ///< \c MDBX_UTTERLY_NOSYNC: fastest; a system crash may corrupt unflushed data.
+    };
+
     /// \class Config
     /// \ingroup mdbxc_core
     /// \brief Parameters used by \ref Connection to create the MDBX environment.
@@ -28,15 +36,53 @@ namespace mdbxc {
         int64_t max_readers = 0;                ///< Maximum reader slots; use 0 for the default (twice the CPU count).
         int64_t max_dbs = 10;                   ///< Maximum number of named databases (DBI) in the environment.
         int64_t max_dupsort_value_size = -1;        ///< Proactive MDBX_DUPSORT duplicate value size limit; <= 0 disables it.
+        /// Number of reset read-only transactions kept parked for reuse by
+        /// \ref Connection::transaction(); 0 disables the cache.
+        /// Parked handles hold a reader slot but no snapshot.
+        int64_t read_txn_cache_size = 0;
+        int64_t read_txn_cache_max_idle_ms = 1000;  ///< Parked read transactions idle longer than this are aborted.
+        /// Merge concurrent table auto-transaction writes into shared write
+        /// transactions (one commit and durable sync per batch).
+        bool group_commit = false;
+        int64_t group_commit_max_batch = 128;       ///< Maximum writes merged into one grouped transaction.
+        /// Raise \ref growth_step at runtime when the database grows faster
+        /// than one step per sampling window, and pre-extend the file on the
+        /// connection's writer thread.
+        bool adaptive_growth = false;
+        int64_t growth_step_max = 1024ll * 1024 * 1024; ///< Upper bound for the adaptive growth step.
+        int64_t adaptive_growth_window_ms = 1000;   ///< Minimum interval between growth samples.
+        /// Record start times of read-only transactions for
+        /// \ref Connection::oldest_read_txn_age(). Costs one mutex
+        /// acquisition per read transaction start and end.
+        bool track_read_txn_age = false;
+        /// Longest sleep between two checks of \ref Connection::wait_for_txn()
+        /// for commits made by other processes. Commits made through the same
+        /// connection wake waiters immediately.
+        int64_t commit_poll_max_ms = 10;
         /// Open the environment with MDBX_RDONLY.
         /// Table wrappers open existing DBIs only in this mode, and missing
         /// directories are not created.
         bool read_only = false;
+        /// Commit durability. Non-durable modes rely on \ref sync_period_ms,
+        /// \ref sync_bytes or explicit \ref Connection::wait_for_durable() calls.
+        SyncMode sync_mode = SyncMode::Durable;
+        int64_t sync_period_ms = 0;             ///< Background flush interval in non-durable modes; 0 disables the sync thread.
+        int64_t sync_bytes = 0;                 ///< Unflushed bytes that make a commit flush (mdbx_env_set_syncbytes); 0 disables.
         bool readahead = true;                  ///< Whether to enable OS readahead for sequential access.
         bool no_subdir = true;                  ///< Whether to store the database in a single file instead of a directory.
         bool sync_durable = true;               ///< Whether to enforce synchronous durable writes (MDBX_SYNC_DURABLE).
         bool writemap_mode = false;             ///< Whether to map the database with MDBX_WRITEMAP for direct modification.
         bool relative_to_exe = false;           ///< Whether to resolve a relative path relative to the executable directory.
+        /// Open the environment with MDBX_NOSTICKYTHREADS so read views from
+        /// \ref Connection::detached_snapshot() may move between threads.
+        /// Other transactions stay bound to the thread that opened them.
+        bool no_sticky_threads = false;
+        /// Longest sync apply write transaction while local writers wait for
+        /// the writer, in milliseconds. \c SyncEngine::handle_push() then
+        /// commits the batches applied so far and lets them begin first;
+        /// 0 applies each push in one transaction. See \ref WriterScheduler.
+        int64_t apply_write_slice_ms = 0;
+        int64_t apply_yield_max_ms = 50;        ///< Longest wait of a sliced apply for local writers to begin.
         
         /// \brief Validate the MDBX configuration.
         /// \return True if the configuration is valid, false otherwise.
@@ -52,7 +98,17 @@ namespace mdbxc {
                 max_readers >= 0 &&
                 max_readers <= static_cast<int64_t>(std::numeric_limits<int>::max());
             const bool dbs_ok = max_dbs >= 1;
-            return !pathname.empty() && page_ok && size_ok && readers_ok && dbs_ok;
+            const bool read_cache_ok = read_txn_cache_size >= 0 && read_txn_cache_max_idle_ms >= 0;
+            const bool group_ok = group_commit_max_batch >= 1;
+            const bool growth_ok = !adaptive_growth ||
+                (growth_step > 0 && growth_step_max >= growth_step &&
+                 adaptive_growth_window_ms >= 0);
+            const bool sync_ok = sync_period_ms >= 0 && sync_bytes >= 0;
+            const bool commit_poll_ok = commit_poll_max_ms >= 1;
+            const bool apply_slice_ok = apply_write_slice_ms >= 0 && apply_yield_max_ms >= 0;
+            return !pathname.empty() && page_ok && size_ok && readers_ok && dbs_ok &&
+                   read_cache_ok && group_ok && growth_ok && sync_ok && commit_poll_ok &&
+                   apply_slice_ok;
         }
     };
 
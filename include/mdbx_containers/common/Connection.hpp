@@ -5,12 +5,21 @@
 /// \file Connection.hpp
 /// \brief Manages an MDBX database connection using a provided configuration.
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -24,8 +33,17 @@
 #include <mdbx.h>
 
 #include "Backup.hpp"
+#include "Compaction.hpp"
 #include "Config.hpp"
+#include "EnvStats.hpp"
+#include "GeometryAdvice.hpp"
 #include "Transaction.hpp"
+#include "Snapshot.hpp"
+#include "TableMetrics.hpp"
+#include "KeyAccessSampler.hpp"
+#include "Warmup.hpp"
+#include "../detail/ScratchPool.hpp"
+#include "../detail/BackupPipe.hpp"
 
 namespace mdbxc {
     class VectorStore;
@@ -37,6 +55,27 @@ namespace mdbxc {
         class SyncEngine;
     }
 
+    /// \brief Reader that blocks page reuse, passed to a slow-reader handler.
+    struct SlowReaderInfo {
+        std::uint64_t txn_id = 0;  ///< Snapshot id pinned by the lagging reader.
+        unsigned      gap = 0;     ///< Committed transactions the reader is behind.
+        std::size_t   space = 0;   ///< Bytes that become reusable once the reader ends.
+        int           pid = 0;     ///< Process id of the reader.
+        /// \brief Attempt number starting from 0. A negative value marks the
+        /// end of a handling loop in which the handler returned \c Retry.
+        int           retry = 0;
+    };
+
+    /// \brief What MDBX should do about a reader reported to a slow-reader handler.
+    enum class SlowReaderAction {
+        Fail,  ///< Give up; the write fails with \c MDBX_MAP_FULL.
+        Retry, ///< The reader was asked to finish; rescan the reader table and retry.
+        Kick   ///< Clear the reader slot; the reader's transaction fails on its next use.
+    };
+
+    /// \brief Callback type of \ref Connection::set_slow_reader_handler().
+    typedef std::function<SlowReaderAction(const SlowReaderInfo&)> SlowReaderHandler;
+
     /// \class Connection
     /// \ingroup mdbxc_core
     /// \brief Manages a single MDBX environment and per-thread transaction tracking.
@@ -58,6 +97,7 @@ namespace mdbxc {
     public:
         void on_pre_commit(MDBX_txn* txn) override;
         void on_discard(MDBX_txn* txn) noexcept override;
+        void on_committed(std::uint64_t txn_id) noexcept override;
 #   endif
     private:
         friend class BaseTable;
@@ -104,6 +144,8 @@ namespace mdbxc {
         /// \brief Disconnects from the MDBX environment and releases resources.
         /// \throws MdbxException if closing the environment fails.
         /// \throws MdbxException with MDBX_BUSY if any transaction handle is open.
+        /// On failure the environment stays open and the periodic flush for
+        /// Config::sync_period_ms keeps running.
         /// \warning Lifecycle-only. Call after all concurrent table activity,
         /// transactions, and MDBX cursors have ended. This method does not wait
         /// for worker threads and does not abort transactions owned by another
@@ -129,6 +171,7 @@ namespace mdbxc {
         /// `shutdown()` after worker threads finish.
         template<class Rep, class Period>
         bool shutdown_for(const std::chrono::duration<Rep, Period>& timeout) {
+            stop_writer_thread();
             if (!request_shutdown()) {
                 return true;
             }
@@ -148,12 +191,55 @@ namespace mdbxc {
         bool is_read_only() const;
 
         /// \brief Creates a RAII transaction object.
+        ///
+        /// When \ref Config::read_txn_cache_size is positive, read-only guards
+        /// renew a reset handle parked earlier by the calling thread instead of
+        /// beginning a new MDBX transaction, and park their handle on release.
+        ///
         /// \param mode Transaction mode to open (default: WRITABLE).
         /// \throws MdbxException on MDBX errors.
         /// \return Transaction guard managing the MDBX_txn handle.
         /// \warning The returned transaction belongs to the calling thread.
         /// Do not use or destroy it from another thread.
         Transaction transaction(TransactionMode mode = TransactionMode::WRITABLE);
+
+        /// \brief Creates a RAII transaction object without throwing.
+        /// \param mode Transaction mode to open.
+        /// \param status Receives Ok, or the error \c transaction(mode) would
+        ///        raise; MDBX errors such as \c MDBX_BUSY are not thrown.
+        /// \return Transaction guard; inactive unless \p status is ok.
+        /// \warning The returned transaction belongs to the calling thread.
+        Transaction transaction(std::nothrow_t, TransactionMode mode, Status& status) noexcept;
+
+        /// \brief Pins a read view for consistent reads across several tables.
+        ///
+        /// Opens one read-only transaction like
+        /// <tt>transaction(TransactionMode::READ_ONLY)</tt> and wraps it in a
+        /// copyable \ref Snapshot.
+        ///
+        /// \param max_age Age after which the next access renews the view;
+        ///        zero (the default) keeps it until the last copy is destroyed.
+        /// \throws MdbxException on MDBX errors.
+        /// \throws std::logic_error if the calling thread already has a transaction.
+        /// \return Snapshot owning the read transaction.
+        /// \warning The snapshot belongs to the calling thread.
+        Snapshot snapshot(Snapshot::clock::duration max_age = Snapshot::clock::duration::zero());
+
+        /// \brief Pins a read view that may move between threads.
+        ///
+        /// Like \ref snapshot(), but the read transaction is not bound to the
+        /// calling thread, so a long streaming scan survives a task that
+        /// resumes on another executor thread. Pass the snapshot to table
+        /// reads explicitly; calls without a transaction do not see it, and
+        /// the calling thread may still open its own transactions. Use it
+        /// from one thread at a time.
+        ///
+        /// \param max_age Age after which the next access renews the view.
+        /// \throws MdbxException on MDBX errors.
+        /// \throws std::logic_error if the environment was not opened with
+        ///         \c Config::no_sticky_threads.
+        /// \return Snapshot owning the detached read transaction.
+        Snapshot detached_snapshot(Snapshot::clock::duration max_age = Snapshot::clock::duration::zero());
         
         /// \brief Begins a manual transaction (must be committed or rolled back later).
         /// \param mode The transaction mode (default: WRITABLE).
@@ -182,6 +268,167 @@ namespace mdbxc {
         /// \return Maximum duplicate value size, or a non-positive value when disabled.
         int64_t max_dupsort_value_size() const;
 
+        /// \brief Checks whether table auto-transaction writes use group commit.
+        /// \return Value of \ref Config::group_commit for the open environment.
+        bool group_commit_enabled() const noexcept {
+            return m_group_commit.load(std::memory_order_relaxed);
+        }
+
+        /// \brief Queues a write for the next grouped write transaction.
+        ///
+        /// Concurrent submissions are merged: the first submitter with no
+        /// leader active becomes the leader, runs up to
+        /// \ref Config::group_commit_max_batch queued actions in one write
+        /// transaction, commits once and completes their futures. Once the
+        /// batch holding its own action has committed, the leader returns and
+        /// hands any writes queued meanwhile to the connection's writer thread,
+        /// starting it if needed. Other submitters return at once with a
+        /// pending future.
+        ///
+        /// If an action throws, the batch is rolled back, that action alone
+        /// fails, and the remaining actions are retried together in a new
+        /// transaction. Actions must therefore be safe to run more than once
+        /// and must only touch the database through the given handle.
+        ///
+        /// \param action Callable receiving the grouped \c MDBX_txn*. It runs on
+        ///        the leader thread; everything it references must outlive the future.
+        /// \return Future completed after the transaction containing \p action commits.
+        /// \throws std::logic_error if the calling thread has an active transaction.
+        std::future<void> submit_write(std::function<void(MDBX_txn*)> action);
+
+        /// \brief Queues a write for the connection's dedicated writer thread.
+        ///
+        /// The first call starts a writer thread owned by the connection. It
+        /// drains the same queue as \ref submit_write(), so actions run in
+        /// submission order, up to \ref Config::group_commit_max_batch per write
+        /// transaction, with the same per-action failure isolation. The caller
+        /// never waits for the writer lock or the commit sync. A
+        /// \ref submit_write() leader may run queued actions in the batch that
+        /// holds its own action.
+        ///
+        /// Unlike \ref submit_write(), this may be called from a thread with an
+        /// active transaction, but that thread must not wait on the future while
+        /// it holds a write transaction.
+        ///
+        /// \param action Callable receiving the grouped \c MDBX_txn*. It must be
+        ///        safe to run more than once, and everything it references must
+        ///        outlive the future.
+        /// \return Future completed after the transaction containing \p action
+        ///         commits, or holding the action's or the commit's exception.
+        /// \note \ref disconnect(), \ref shutdown() and the destructor drain the
+        ///       queue and join the writer thread first.
+        std::future<void> async_write(std::function<void(MDBX_txn*)> action);
+
+        /// \brief Queues a write for the writer thread and reports its outcome to a callback.
+        ///
+        /// Same as \ref async_write(std::function<void(MDBX_txn*)>), but instead
+        /// of a future \p on_done is called once the transaction containing
+        /// \p action has committed (with a null pointer) or failed (with the
+        /// error). It runs on the thread that drained the queue, after that
+        /// thread's transaction has ended, so it may queue further writes; it
+        /// should hand longer work to an executor. Exceptions from \p on_done
+        /// are ignored.
+        ///
+        /// \param action Callable receiving the grouped \c MDBX_txn*.
+        /// \param on_done Completion callback receiving the error, if any.
+        void async_write(std::function<void(MDBX_txn*)> action,
+                         std::function<void(std::exception_ptr)> on_done);
+
+        /// \brief Runs \p action through \ref submit_write() and waits for its commit.
+        /// \param action Callable receiving the grouped \c MDBX_txn*.
+        /// \throws Any exception raised by \p action or by the commit.
+        template<class F>
+        void write_grouped(F&& action) {
+            submit_write(std::function<void(MDBX_txn*)>(std::forward<F>(action))).get();
+        }
+
+        /// \brief Returns the number of write transactions committed through this connection.
+        /// \details Counts commits of \c Transaction objects, including table
+        /// auto-transactions and group-commit batches. Commits of raw handles
+        /// made with \c mdbx_txn_commit() and writes of other processes are not
+        /// counted.
+        /// \return Monotonic commit counter.
+        std::uint64_t commit_sequence() const noexcept {
+            return TransactionTracker::commit_sequence();
+        }
+
+        /// \brief Returns the number of write transactions and savepoints aborted through this connection.
+        /// \details Counts rollbacks, failed commits and write \c Transaction
+        /// objects destroyed without commit. Raw handles aborted with
+        /// \c mdbx_txn_abort() are not counted. MDBX reuses the txnid of an
+        /// aborted write transaction, so caches tagged with a txnid of the
+        /// calling process also compare this counter.
+        /// \return Monotonic abort counter.
+        std::uint64_t abort_sequence() const noexcept {
+            return TransactionTracker::abort_sequence();
+        }
+
+        /// \brief Blocks until a write transaction commits after \p seen was read.
+        /// \param seen Value previously returned by \ref commit_sequence().
+        /// \param timeout Maximum time to wait.
+        /// \return \c true if a commit was observed, \c false on timeout.
+        template<class Rep, class Period>
+        bool wait_for_commit(std::uint64_t seen,
+                             const std::chrono::duration<Rep, Period>& timeout) const {
+            return wait_for_commit_for(seen, timeout);
+        }
+
+        /// \brief Returns the id of the newest committed write transaction.
+        /// \details Read from the shared lock file, so commits of other
+        /// processes are visible, including on \c Config::read_only connections.
+        /// \throws MdbxException if the connection is closed.
+        std::uint64_t last_txn_id() const;
+
+        /// \brief Blocks until a transaction newer than \p after_txn_id is committed
+        ///        by any process.
+        /// \details Unlike \ref wait_for_commit(), which sees only commits made
+        /// through this connection, this also observes other processes, which
+        /// makes it the change notification of read-only replicas. Local
+        /// commits wake the waiter at once. Foreign commits are detected by
+        /// polling \ref last_txn_id() with a backoff that starts at 100 us and
+        /// doubles up to \c Config::commit_poll_max_ms; each poll is one
+        /// shared-memory read. Pass the result back in to wait for the next commit.
+        /// \param after_txn_id Newest transaction id the caller has seen.
+        /// \param timeout Maximum time to wait.
+        /// \return The newest committed transaction id; not greater than
+        ///         \p after_txn_id when the timeout expired.
+        /// \throws MdbxException if the connection is closed.
+        std::uint64_t wait_for_txn(std::uint64_t after_txn_id,
+                                   std::chrono::milliseconds timeout) const;
+
+        /// \brief Returns the serialization scratch pool shared by tables of this connection.
+        /// \return Pool reference valid for the connection lifetime.
+        detail::ScratchPool& scratch_pool() const noexcept { return m_scratch_pool; }
+
+#       if MDBXC_METRICS_ENABLED
+        /// \brief Attaches a non-owning \c ITableObserver, or detaches it with \c nullptr.
+        /// \details Tables of this connection report finished operations to the
+        /// observer, and top-level write commits are reported as
+        /// \c TableOperation::Commit with an empty table name. The observer must
+        /// outlive the period during which it is attached.
+        void attach_table_observer(ITableObserver* observer) noexcept {
+            m_table_observer.store(observer, std::memory_order_release);
+        }
+
+        /// \brief Returns the attached \c ITableObserver or \c nullptr.
+        ITableObserver* table_observer() const noexcept {
+            return m_table_observer.load(std::memory_order_acquire);
+        }
+
+        /// \brief Attaches a non-owning \c KeyAccessSampler, or detaches it with \c nullptr.
+        /// \details Tables of this connection offer the serialized keys of
+        /// their operations to the sampler. The sampler must outlive the
+        /// period during which it is attached.
+        void attach_key_sampler(KeyAccessSampler* sampler) noexcept {
+            m_key_sampler.store(sampler, std::memory_order_release);
+        }
+
+        /// \brief Returns the attached \c KeyAccessSampler or \c nullptr.
+        KeyAccessSampler* key_sampler() const noexcept {
+            return m_key_sampler.load(std::memory_order_acquire);
+        }
+#       endif
+
 #       if MDBXC_SYNC_ENABLED
         /// \brief Attaches a non-owning \c ISyncCaptureSink.
         /// \details Pass \c nullptr to disable change capture. The pointer is
@@ -247,6 +494,53 @@ namespace mdbxc {
         ///       other state-mutating calls are blocked until backup completes.
         void backup_to(const std::string& path, const BackupOptions& options = BackupOptions());
 
+        /// \brief Streams a backup of the environment to \p sink.
+        ///
+        /// MDBX writes the copy (\c mdbx_env_copy2fd) into an anonymous pipe on
+        /// a helper thread, and the calling thread forwards it to \p sink, so
+        /// the image can be piped into a compressor or a socket without a
+        /// temporary file. \c BackupOptions::max_bytes_per_sec paces the sink
+        /// and, through the pipe, the copier itself.
+        ///
+        /// Unlike \ref backup_to(), the connection mutex is held only to
+        /// validate state. The copy counts as an open transaction handle of the
+        /// calling thread, so \c shutdown() waits for it and \c disconnect()
+        /// fails with \c MDBX_BUSY while it runs.
+        ///
+        /// \param sink Receives the image in order.
+        /// \param options Backup behavior; see \ref BackupOptions.
+        /// \throws MdbxException on any MDBX or pipe error.
+        /// \throws Any exception thrown by \p sink; the copy is then abandoned.
+        void backup_to_stream(const BackupSink& sink, const BackupOptions& options = BackupOptions());
+
+        /// \brief Writes a backup of the environment to an open file handle.
+        /// \details Uses \c mdbx_env_copy2fd() directly, or streams through
+        /// \ref backup_to_stream() when \c BackupOptions::max_bytes_per_sec is
+        /// set. The handle must be open for writing; it is not closed.
+        /// \param fd Destination file, pipe, or socket.
+        /// \param options Backup behavior; see \ref BackupOptions.
+        /// \throws MdbxException on any MDBX or write error.
+        void backup_to_fd(mdbx_filehandle_t fd, const BackupOptions& options = BackupOptions());
+
+        /// \brief Rebuilds every named DBI into a new, densely packed environment.
+        ///
+        /// Opens \p target as a fresh connection (raising \c max_dbs to the
+        /// number of DBIs and inheriting the source page size when unset) and
+        /// copies each DBI with sorted \c MDBX_APPEND writes, plus
+        /// \c MDBX_APPENDDUP for \c MDBX_DUPSORT tables. All DBIs are read
+        /// in one read-only transaction, so the copy is a single point-in-time
+        /// snapshot, and records are appended straight from its mapped pages
+        /// without intermediate copies. Records stored directly in the main
+        /// DBI are not copied.
+        ///
+        /// \param target Configuration of the new environment. Its tables must be empty.
+        /// \param options Batch size and progress callback.
+        /// \return Copied totals and used sizes before and after.
+        /// \throws MdbxException on any MDBX error.
+        /// \throws std::logic_error if a target table is not empty or this thread
+        ///         has an active transaction.
+        CompactResult compact_to(const Config& target, const CompactOptions& options = CompactOptions());
+
         /// \brief Flushes the environment to disk.
         /// \param force When \c true forces a synchronous durable flush.
         /// \param nonblock When \c true returns immediately if a flush is
@@ -258,6 +552,147 @@ namespace mdbxc {
         ///       \c sync.hpp for changelog-based replication.
         void sync_to_disk(bool force = true, bool nonblock = false);
 
+        /// \brief Returns the id of the newest write transaction known to be on disk.
+        /// \details With \c SyncMode::Durable every commit is durable, so this is
+        /// the last committed transaction id. In non-durable modes it advances
+        /// on each forced flush: the background sync thread,
+        /// \ref wait_for_durable() and \c sync_to_disk(true). Flushes that MDBX
+        /// performs on its own for \c Config::sync_bytes are not observed
+        /// until the next forced flush.
+        std::uint64_t durable_txn_id() const;
+
+        /// \brief Makes write transaction \p txn_id durable, flushing if needed.
+        /// \details Obtain the id with \c mdbx_txn_id() before committing. Pass 0
+        /// to flush everything committed so far. Returns immediately when
+        /// \ref durable_txn_id() already covers \p txn_id. Unlike
+        /// \c sync_to_disk(), does not take the connection mutex.
+        /// \param txn_id Write transaction id, or 0 for the latest commit.
+        /// \throws std::logic_error if this thread has an active transaction.
+        /// \throws MdbxException if the flush fails.
+        void wait_for_durable(std::uint64_t txn_id = 0);
+
+        /// \brief Opens a named DBI, reusing the handle of an earlier open.
+        ///
+        /// Handles are cached per name and flags (ignoring \c MDBX_CREATE) until
+        /// the environment is closed, so table wrappers constructed repeatedly
+        /// over the same DBI open no transaction after the first one. A cache
+        /// miss first tries a read-only transaction, which succeeds for
+        /// existing DBIs without taking the writer lock. A write transaction
+        /// is opened only when the DBI is missing and \p flags contain
+        /// \c MDBX_CREATE on a writable connection.
+        ///
+        /// \param name DBI name.
+        /// \param flags Requested DBI flags.
+        /// \param dbi_flags Optional output for the persistent DBI flags.
+        /// \return DBI handle valid for every transaction of this environment.
+        /// \throws MdbxException if the DBI is missing or its flags are incompatible.
+        /// \throws std::logic_error on a cache miss when the calling thread
+        ///         already has an active transaction.
+        MDBX_dbi open_dbi(const std::string& name,
+                          MDBX_db_flags_t flags,
+                          std::uint32_t* dbi_flags = nullptr);
+
+        /// \brief Returns the age of the oldest active read-only transaction.
+        /// \details Requires \c Config::track_read_txn_age; otherwise returns zero.
+        /// Covers transactions started through this connection, including
+        /// \ref Snapshot read views.
+        /// \return Age of the oldest reader, or zero when none is active.
+        std::chrono::steady_clock::duration oldest_read_txn_age() const {
+            return oldest_read_age();
+        }
+
+        /// \brief Returns the scheduler that shares the writer between local
+        /// writes and sync apply.
+        /// \details Configured from \c Config::apply_write_slice_ms on connect;
+        /// \ref WriterScheduler::configure() changes it at runtime.
+        WriterScheduler& writer_scheduler() noexcept {
+            return TransactionTracker::writer_scheduler();
+        }
+
+        /// \brief Installs a handler for readers that prevent page reuse.
+        ///
+        /// MDBX calls the handler (its "handle slow readers" hook) from a
+        /// writer that cannot allocate pages, because the oldest reader pins
+        /// them and the map cannot grow further. The handler runs with the
+        /// writer lock held and must return quickly. It may log and return
+        /// \c Fail, wait for the reader and return \c Retry, or return
+        /// \c Kick to reset the reader slot. Pass an empty handler to restore
+        /// the default, which fails with \c MDBX_MAP_FULL. The handler stays
+        /// installed across reconnects.
+        ///
+        /// \param handler Callback, or an empty function to remove it.
+        void set_slow_reader_handler(SlowReaderHandler handler);
+
+        /// \brief Returns a snapshot of environment and table statistics.
+        ///
+        /// Reads \c mdbx_env_info_ex(), \c mdbx_env_stat_ex() and
+        /// \c mdbx_dbi_stat() in one read-only transaction. Per-table entries
+        /// cover DBIs opened through \ref open_dbi(), which includes every table
+        /// wrapper, so no extra DBI handles are opened.
+        ///
+        /// \return Statistics snapshot.
+        /// \throws MdbxException if an MDBX call fails.
+        /// \throws std::logic_error if the calling thread already has an active
+        ///         transaction.
+        EnvStats stats();
+
+        /// \brief Samples the environment and recommends its page size and geometry.
+        ///
+        /// Reads up to \c GeometryAdviceOptions::sample_entries records of every
+        /// named DBI in one read-only transaction, builds key and value size
+        /// histograms and compares them with the DBI statistics. For each
+        /// candidate page size it estimates how many values would spill to
+        /// overflow pages and the resulting file size, and recommends the
+        /// smallest. With \c GeometryAdviceOptions::measure_dir the sampled
+        /// records are also copied into a scratch environment per page size
+        /// and the real sizes reported.
+        ///
+        /// The result is advisory; the page size of an existing file only
+        /// changes through \ref compact_to() into a new environment.
+        ///
+        /// \param options Sampling, candidates and measuring.
+        /// \return Profiles, estimates and recommended \c Config values.
+        /// \throws MdbxException if an MDBX call fails.
+        /// \throws std::logic_error if the calling thread already has an active
+        ///         transaction.
+        GeometryAdvice advise_geometry(const GeometryAdviceOptions& options = GeometryAdviceOptions());
+
+        /// \brief Pages the environment and selected tables into memory.
+        ///
+        /// Runs \c mdbx_env_warmup() over the used part of the file (unless
+        /// \c WarmupOptions::prefault_env is false), then scans each table in
+        /// \p tables with a cursor, touching keys and every page of large
+        /// values. Everything runs in one read-only transaction on the calling
+        /// thread. Call it from one or more background threads, each with its
+        /// own tables, before admitting traffic.
+        ///
+        /// \param tables DBI names to scan, in order; may be empty.
+        /// \param budget Time limit; zero means unlimited. When it runs out,
+        ///        the warm-up stops and reports \c completed = false.
+        /// \param options Warm-up flags and progress callback.
+        /// \return Touched entries, bytes and elapsed time.
+        /// \throws MdbxException if a table does not exist or an MDBX call fails.
+        /// \throws std::logic_error if the calling thread already has an active
+        ///         transaction.
+        WarmupResult warmup(const std::vector<std::string>& tables,
+                            std::chrono::milliseconds budget = std::chrono::milliseconds(0),
+                            const WarmupOptions& options = WarmupOptions());
+
+        /// \brief Runs \ref warmup() on a new thread.
+        /// \details The connection must stay connected until the future is ready.
+        /// \return Future with the warm-up result or its exception.
+        std::future<WarmupResult> warmup_async(std::vector<std::string> tables,
+                                               std::chrono::milliseconds budget = std::chrono::milliseconds(0),
+                                               WarmupOptions options = WarmupOptions());
+
+        /// \brief Returns the growth step currently applied to the environment.
+        /// \details Equals \c Config::growth_step unless \c Config::adaptive_growth
+        /// raised it. Adjustments are applied asynchronously, so the value
+        /// may lag the last sample by one writer-thread wakeup.
+        std::int64_t growth_step() const noexcept {
+            return m_growth_step.load(std::memory_order_relaxed);
+        }
+
     private:
         friend class Transaction;
 
@@ -271,6 +706,173 @@ namespace mdbxc {
         using config_t = std::unique_ptr<Config>;
 #       endif
         config_t m_config;                  ///< Database configuration object.
+        // Lock-free mirrors of m_config fields read inside write transactions,
+        // where taking m_mdbx_mutex could deadlock against a thread blocked in
+        // transaction() waiting for the MDBX writer lock.
+        std::atomic<bool> m_read_only{false};
+        std::atomic<int64_t> m_max_dupsort_value_size{-1};
+        mutable detail::ScratchPool m_scratch_pool; ///< Reusable serialization buffers for table writes.
+#       if MDBXC_METRICS_ENABLED
+        std::atomic<ITableObserver*> m_table_observer{nullptr}; ///< Receives table operation metrics.
+        std::atomic<KeyAccessSampler*> m_key_sampler{nullptr}; ///< Receives sampled table keys.
+
+        /// \brief Reports a write commit to the attached table observer.
+        void on_commit_latency(std::chrono::nanoseconds latency,
+                               const CommitLatency& phases) noexcept override {
+            ITableObserver* observer = table_observer();
+            if (!observer) return;
+            try {
+                observer->on_table_operation(std::string(), TableOperation::Commit, 0, latency);
+                observer->on_commit_phases(phases);
+            } catch (...) {
+                // Metrics must not change transaction outcomes.
+            }
+        }
+#       endif
+
+        /// \brief Reset read-only handle waiting for reuse by its parking thread.
+        struct ParkedReadTxn {
+            std::thread::id owner;
+            MDBX_txn* txn;
+            std::chrono::steady_clock::time_point parked_at;
+        };
+
+        std::mutex m_read_cache_mutex;              ///< Protects m_parked_reads; taken after m_mdbx_mutex.
+        std::vector<ParkedReadTxn> m_parked_reads;  ///< Reset read-only handles available for renew.
+        std::size_t m_read_cache_size = 0;          ///< Parked handle limit; 0 disables the cache. Written under both mutexes.
+        std::chrono::milliseconds m_read_cache_max_idle{0}; ///< Idle bound for parked handles.
+
+        mutable std::mutex m_slow_reader_mutex;     ///< Protects m_slow_reader_handler.
+        std::shared_ptr<const SlowReaderHandler> m_slow_reader_handler; ///< Set by set_slow_reader_handler().
+
+        /// \brief MDBX HSR callback; forwards to the handler of the owning connection.
+        static int slow_reader_callback(const MDBX_env* env, const MDBX_txn* txn,
+                                        mdbx_pid_t pid, mdbx_tid_t tid,
+                                        std::uint64_t laggard, unsigned gap,
+                                        std::size_t space, int retry) noexcept;
+
+        /// \brief Lists the named DBIs: keys of the main DBI that open as sub-databases.
+        /// \param flags Receives the persistent flags of each DBI when not null.
+        /// \param dbis Receives the handle of each DBI when not null.
+        std::vector<std::string> list_named_dbis(std::vector<std::uint32_t>* flags = nullptr,
+                                                 std::vector<MDBX_dbi>* dbis = nullptr);
+
+        /// \brief DBI handle cached by open_dbi().
+        struct CachedDbi {
+            MDBX_dbi      dbi;
+            std::uint32_t flags;
+        };
+
+        std::mutex m_dbi_cache_mutex;               ///< Protects m_dbi_cache.
+        std::map<std::pair<std::string, unsigned>, CachedDbi> m_dbi_cache; ///< Open DBIs by name and flags.
+
+        /// \brief Write queued for group commit.
+        struct GroupWrite {
+            std::function<void(MDBX_txn*)> action;
+            std::promise<void> done;
+            std::function<void(std::exception_ptr)> on_done; ///< Optional completion callback.
+        };
+
+        std::atomic<bool> m_group_commit{false};    ///< Mirrors Config::group_commit while connected.
+        std::mutex m_group_mutex;                   ///< Protects the group-commit queue and leader flag.
+        std::deque<std::shared_ptr<GroupWrite>> m_group_queue; ///< Writes waiting for a leader.
+        std::size_t m_group_max_batch = 1;          ///< Maximum actions per grouped transaction.
+        bool m_group_leader_active = false;         ///< Whether a thread is draining the queue.
+        std::condition_variable m_writer_cv;        ///< Wakes the async writer thread.
+        std::thread m_writer_thread;                ///< Dedicated writer started by async_write().
+        bool m_writer_signal = false;               ///< Leadership was handed to the writer thread.
+        bool m_writer_stop = false;                 ///< Asks the writer thread to exit once idle.
+
+        std::mutex m_growth_mutex;                  ///< Guards growth sampling; commits only try_lock it.
+        std::atomic<bool> m_adaptive_growth{false}; ///< Config::adaptive_growth on a writable connection.
+        std::atomic<std::int64_t> m_growth_step{0}; ///< Growth step applied to the environment.
+        std::int64_t m_growth_base = 0;             ///< Config::growth_step; floor of the adaptive step.
+        std::int64_t m_growth_max = 0;              ///< Config::growth_step_max.
+        std::int64_t m_growth_shrink = -1;          ///< Config::shrink_threshold.
+        std::int64_t m_growth_used = -1;            ///< Used bytes at the last sample; -1 before the first one.
+        std::chrono::milliseconds m_growth_window{0}; ///< Minimum interval between samples.
+        std::chrono::steady_clock::time_point m_growth_sampled_at; ///< Time of the last sample.
+        std::int64_t m_growth_pending = 0;          ///< Step waiting for the writer thread; guarded by m_group_mutex.
+
+        std::atomic<bool> m_lazy_sync{false};       ///< Connected with a non-durable SyncMode.
+        std::atomic<std::uint64_t> m_durable_txn_id{0}; ///< Newest transaction id covered by a flush.
+        std::mutex m_sync_mutex;                    ///< Protects the sync thread state.
+        std::condition_variable m_sync_cv;          ///< Wakes the sync thread for shutdown.
+        std::thread m_sync_thread;                  ///< Periodic flusher for Config::sync_period_ms.
+        bool m_sync_stop = false;                   ///< Asks the sync thread to exit.
+        std::atomic<std::int64_t> m_commit_poll_max_ms{10}; ///< Mirrors Config::commit_poll_max_ms.
+
+        /// \brief Forces a durable flush and advances m_durable_txn_id on success.
+        /// \return MDBX result of \c mdbx_env_sync_ex().
+        int flush_durable(bool nonblock) noexcept;
+
+        /// \brief Body of the sync thread.
+        void sync_loop(std::chrono::milliseconds period);
+
+        /// \brief Starts the sync thread when the connection uses a lazy SyncMode
+        /// with a positive Config::sync_period_ms and the thread is not running.
+        void start_sync_thread();
+
+        /// \brief Stops and joins the sync thread.
+        void stop_sync_thread() noexcept;
+
+        /// \brief Samples database growth and schedules a new growth step.
+        void on_write_commit() noexcept override;
+
+        /// \brief Applies \p step and pre-extends the file by one step.
+        /// \details Runs on the writer thread, outside any transaction.
+        void apply_growth_step(std::int64_t step) noexcept;
+
+        /// \brief Chooses the growth step for \p grown bytes written in one window.
+        /// \details Doubles \p base until one step covers the window, capped at
+        /// \p max_step, and steps down by at most half of \p current at a time.
+        static std::int64_t plan_growth_step(std::int64_t grown, std::int64_t base,
+                                             std::int64_t max_step, std::int64_t current) noexcept;
+
+        /// \brief Maps \ref BackupOptions to MDBX copy flags.
+        static MDBX_copy_flags_t backup_copy_flags(const BackupOptions& options) noexcept;
+
+        /// \brief Drains the group-commit queue on the calling (leader) thread.
+        /// \param own Write queued by a \ref submit_write() leader; after the
+        ///        batch holding it, the rest goes to the writer thread. With
+        ///        \c nullptr the queue is drained until empty.
+        void drain_group_writes(const GroupWrite* own = nullptr);
+
+        /// \brief Passes group-commit leadership to the writer thread.
+        /// \details Called with \c m_group_mutex held; the caller notifies
+        /// \c m_writer_cv after unlocking.
+        /// \return \c false if the writer thread could not be started.
+        bool hand_off_group_writes() noexcept;
+
+        /// \brief Completes a queued write's future and callback.
+        static void finish_group_write(GroupWrite& item, std::exception_ptr error) noexcept;
+
+        /// \brief Queues an async write and wakes the writer thread.
+        std::future<void> enqueue_async_write(std::shared_ptr<GroupWrite> item);
+
+        /// \brief Runs one batch in a shared transaction, isolating failures.
+        /// \details A failing action is removed and the rest rerun together.
+        void run_group_batch(std::vector<std::shared_ptr<GroupWrite>>& batch);
+
+        /// \brief Body of the async writer thread.
+        void writer_loop();
+
+        /// \brief Drains pending async writes and joins the writer thread.
+        /// \details No-op when called from the writer thread itself.
+        void stop_writer_thread() noexcept;
+
+        /// \brief Parks a reset read-only handle if the cache has room.
+        bool park_read_txn(MDBX_txn* txn) noexcept override;
+
+        /// \brief Takes a parked handle of the calling thread, evicting idle ones.
+        /// \return Reset handle or nullptr when none is available.
+        MDBX_txn* take_parked_read_txn();
+
+        /// \brief Aborts every parked read-only handle and disables parking.
+        void clear_parked_read_txns() noexcept;
+
+        /// \brief Copies lock-free config mirrors from m_config (under m_mdbx_mutex).
+        void publish_config_flags() noexcept;
 
         /// \brief Initializes the MDBX environment.
         void initialize();
@@ -304,13 +906,15 @@ namespace mdbxc {
             std::size_t applied_batches = 0;
             std::size_t applied_ops = 0;
             std::vector<std::string> affected_dbi_names;
+            std::vector<sync::SyncAppliedKey> applied_keys;
             std::vector<SyncApplyObserverCallback> callbacks;
         };
 
         SyncApplyNotification mark_sync_apply_committed(
             std::size_t applied_batches,
             std::size_t applied_ops,
-            const std::vector<std::string>& affected_dbi_names);
+            const std::vector<std::string>& affected_dbi_names,
+            std::vector<sync::SyncAppliedKey> applied_keys);
         void notify_sync_apply_observers(
             const SyncApplyNotification& notification);
         void begin_sync_apply_observer_callback(
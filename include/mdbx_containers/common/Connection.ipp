@@ -1,6 +1,7 @@
 #include <string>
 #include <memory>
 #include <mutex>
+#include <exception>
 #include <thread>
 #include <unordered_map>
 #include <cassert>
@@ -25,6 +26,8 @@ namespace mdbxc {
     }
 
     inline Connection::~Connection() {
+        stop_writer_thread();
+        stop_sync_thread();
         std::lock_guard<std::mutex> locker(m_mdbx_mutex);
         assert(!has_txn_handles() && "Destroying Connection with live transaction handles");
         cleanup(false);
@@ -43,6 +46,7 @@ namespace mdbxc {
 #       else
         m_config.reset(new Config(config));
 #       endif
+        publish_config_flags();
     }
 
     inline void Connection::connect() {
@@ -61,16 +65,31 @@ namespace mdbxc {
 #       else
         m_config.reset(new Config(config));
 #       endif
+        publish_config_flags();
         m_shutdown_requested = false;
         initialize();
     }
 
     inline void Connection::disconnect() {
+        stop_writer_thread();
+        stop_sync_thread();
         std::lock_guard<std::mutex> locker(m_mdbx_mutex);
-        cleanup();
+        try {
+            cleanup();
+        } catch (...) {
+            // The environment stays open, so it still needs its periodic flush.
+            if (m_env) {
+                try {
+                    start_sync_thread();
+                } catch (...) {
+                }
+            }
+            throw;
+        }
     }
 
     inline void Connection::shutdown() {
+        stop_writer_thread();
         if (!request_shutdown()) {
             return;
         }
@@ -84,11 +103,56 @@ namespace mdbxc {
     }
 
     inline bool Connection::is_read_only() const {
-        std::lock_guard<std::mutex> locker(m_mdbx_mutex);
-        return m_config ? m_config->read_only : false;
+        return m_read_only.load(std::memory_order_relaxed);
+    }
+
+    inline void Connection::publish_config_flags() noexcept {
+        m_read_only.store(m_config ? m_config->read_only : false, std::memory_order_relaxed);
+        m_max_dupsort_value_size.store(
+            m_config ? m_config->max_dupsort_value_size : Config().max_dupsort_value_size,
+            std::memory_order_relaxed);
     }
 
     inline Transaction Connection::transaction(TransactionMode mode) {
+        Status status;
+        Transaction txn = transaction(std::nothrow, mode, status);
+        check_status(status);
+        return txn;
+    }
+
+    inline Transaction Connection::transaction(std::nothrow_t, TransactionMode mode, Status& status) noexcept {
+        Transaction txn(static_cast<TransactionTracker*>(this), nullptr, mode, Transaction::DeferredTag());
+        try {
+            std::lock_guard<std::mutex> locker(m_mdbx_mutex);
+            const char* misuse = nullptr;
+            if (m_shutdown_requested) {
+                misuse = "Connection shutdown is in progress.";
+            } else if (!m_env) {
+                misuse = "Connection is not connected.";
+            } else if (current_thread_has_txn()) {
+                misuse = "A transaction is already active on this connection's thread. "
+                         "Reuse it through table operations or pass the active transaction explicitly.";
+            }
+            if (misuse) {
+                status = Status::from_exception(std::make_exception_ptr(std::logic_error(misuse)));
+                return txn;
+            }
+            txn.m_env = m_env;
+            if (mode == TransactionMode::READ_ONLY && m_read_cache_size > 0) {
+                txn.adopt_parked(take_parked_read_txn());
+            }
+            status = txn.begin(std::nothrow);
+        } catch (...) {
+            status = Status::from_current_exception();
+        }
+        return txn;
+    }
+
+    inline Snapshot Connection::snapshot(Snapshot::clock::duration max_age) {
+        return Snapshot(std::make_shared<Snapshot::State>(transaction(TransactionMode::READ_ONLY), max_age));
+    }
+
+    inline Snapshot Connection::detached_snapshot(Snapshot::clock::duration max_age) {
         std::lock_guard<std::mutex> locker(m_mdbx_mutex);
         if (m_shutdown_requested) {
             throw std::logic_error("Connection shutdown is in progress.");
@@ -96,13 +160,333 @@ namespace mdbxc {
         if (!m_env) {
             throw std::logic_error("Connection is not connected.");
         }
+        unsigned flags = 0;
+        check_mdbx(mdbx_env_get_flags(m_env, &flags), "Failed to read environment flags");
+        if ((flags & MDBX_NOSTICKYTHREADS) == 0) {
+            throw std::logic_error("Detached snapshots require Config::no_sticky_threads.");
+        }
+        return Snapshot(std::make_shared<Snapshot::State>(
+            Transaction(static_cast<TransactionTracker*>(this), m_env, Transaction::DetachedTag()),
+            max_age, true));
+    }
+
+    inline std::future<void> Connection::submit_write(std::function<void(MDBX_txn*)> action) {
         if (current_thread_has_txn()) {
             throw std::logic_error(
                 "A transaction is already active on this connection's thread. "
-                "Reuse it through table operations or pass the active transaction explicitly."
+                "Pass it explicitly instead of submitting a grouped write."
             );
         }
-        return Transaction(static_cast<TransactionTracker*>(this), m_env, mode);
+        std::shared_ptr<GroupWrite> item = std::make_shared<GroupWrite>();
+        item->action = std::move(action);
+        std::future<void> result = item->done.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_group_mutex);
+            m_group_queue.push_back(item);
+            if (m_group_leader_active) {
+                return result;
+            }
+            m_group_leader_active = true;
+        }
+        drain_group_writes(item.get());
+        return result;
+    }
+
+    inline std::future<void> Connection::async_write(std::function<void(MDBX_txn*)> action) {
+        std::shared_ptr<GroupWrite> item = std::make_shared<GroupWrite>();
+        item->action = std::move(action);
+        return enqueue_async_write(std::move(item));
+    }
+
+    inline void Connection::async_write(std::function<void(MDBX_txn*)> action,
+                                        std::function<void(std::exception_ptr)> on_done) {
+        std::shared_ptr<GroupWrite> item = std::make_shared<GroupWrite>();
+        item->action = std::move(action);
+        item->on_done = std::move(on_done);
+        enqueue_async_write(std::move(item));
+    }
+
+    inline std::future<void> Connection::enqueue_async_write(std::shared_ptr<GroupWrite> item) {
+        std::future<void> result = item->done.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_group_mutex);
+            if (!m_writer_thread.joinable()) {
+                m_writer_thread = std::thread(&Connection::writer_loop, this);
+            }
+            m_group_queue.push_back(std::move(item));
+            if (m_group_leader_active) {
+                return result;
+            }
+            m_group_leader_active = true;
+            m_writer_signal = true;
+        }
+        m_writer_cv.notify_one();
+        return result;
+    }
+
+    inline void Connection::finish_group_write(GroupWrite& item, std::exception_ptr error) noexcept {
+        try {
+            if (error) {
+                item.done.set_exception(error);
+            } else {
+                item.done.set_value();
+            }
+        } catch (...) {}
+        if (item.on_done) {
+            try { item.on_done(error); } catch (...) {}
+        }
+    }
+
+    inline void Connection::writer_loop() {
+        for (;;) {
+            bool drain = false;
+            std::int64_t step = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_group_mutex);
+                m_writer_cv.wait(lock, [this]() {
+                    return m_writer_signal || m_growth_pending != 0 || m_writer_stop;
+                });
+                drain = m_writer_signal;
+                step = m_growth_pending;
+                m_writer_signal = false;
+                m_growth_pending = 0;
+                if (!drain && step == 0) {
+                    return;
+                }
+            }
+            if (step != 0) {
+                apply_growth_step(step);
+            }
+            if (drain) {
+                drain_group_writes();
+            }
+        }
+    }
+
+    inline void Connection::stop_writer_thread() noexcept {
+        std::thread worker;
+        {
+            std::lock_guard<std::mutex> lock(m_group_mutex);
+            if (!m_writer_thread.joinable() ||
+                m_writer_thread.get_id() == std::this_thread::get_id()) {
+                return;
+            }
+            m_writer_stop = true;
+            worker.swap(m_writer_thread);
+        }
+        m_writer_cv.notify_all();
+        worker.join();
+        std::lock_guard<std::mutex> lock(m_group_mutex);
+        m_writer_stop = false;
+    }
+
+    inline void Connection::drain_group_writes(const GroupWrite* own) {
+        std::vector<std::shared_ptr<GroupWrite>> batch;
+        bool own_done = false;
+        for (;;) {
+            batch.clear();
+            bool handed_off = false;
+            {
+                std::lock_guard<std::mutex> lock(m_group_mutex);
+                if (m_group_queue.empty()) {
+                    m_group_leader_active = false;
+                    return;
+                }
+                if (own_done) {
+                    handed_off = hand_off_group_writes();
+                }
+                if (!handed_off) {
+                    const std::size_t limit = m_group_max_batch > 0 ? m_group_max_batch : 1;
+                    while (!m_group_queue.empty() && batch.size() < limit) {
+                        if (m_group_queue.front().get() == own) {
+                            own_done = true;
+                        }
+                        batch.push_back(m_group_queue.front());
+                        m_group_queue.pop_front();
+                    }
+                }
+            }
+            if (handed_off) {
+                m_writer_cv.notify_one();
+                return;
+            }
+            run_group_batch(batch);
+        }
+    }
+
+    inline bool Connection::hand_off_group_writes() noexcept {
+        try {
+            if (!m_writer_thread.joinable()) {
+                m_writer_thread = std::thread(&Connection::writer_loop, this);
+            }
+        } catch (...) {
+            // No writer thread; the caller keeps draining.
+            return false;
+        }
+        m_writer_signal = true;
+        return true;
+    }
+
+    inline void Connection::run_group_batch(std::vector<std::shared_ptr<GroupWrite>>& batch) {
+        // A failing action is dropped and the others are retried together, so
+        // each failure costs one more transaction instead of one per action.
+        std::vector<std::exception_ptr> errors(batch.size());
+        std::vector<std::size_t> pending(batch.size());
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            pending[i] = i;
+        }
+        std::exception_ptr shared_error;
+        while (!pending.empty()) {
+            std::size_t failed = pending.size();
+            try {
+                Transaction txn = transaction(TransactionMode::WRITABLE);
+                for (std::size_t i = 0; i < pending.size(); ++i) {
+                    try {
+                        batch[pending[i]]->action(txn.handle());
+                    } catch (...) {
+                        failed = i;
+                        errors[pending[i]] = std::current_exception();
+                        break;
+                    }
+                }
+                if (failed == pending.size()) {
+                    txn.commit();
+                }
+            } catch (...) {
+                // Begin or commit failed: every remaining write shares the outcome.
+                shared_error = std::current_exception();
+            }
+            if (failed == pending.size()) {
+                break;
+            }
+            pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(failed));
+        }
+        // Completions run after the transaction ended, so callbacks may queue writes.
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            finish_group_write(*batch[i], errors[i] ? errors[i] : shared_error);
+        }
+    }
+
+    inline std::int64_t Connection::plan_growth_step(std::int64_t grown, std::int64_t base,
+                                                     std::int64_t max_step,
+                                                     std::int64_t current) noexcept {
+        std::int64_t target = base;
+        while (target < grown && target <= max_step / 2) {
+            target *= 2;
+        }
+        if (target > max_step) target = max_step;
+        // Step down gradually so a short pause does not undo a burst.
+        if (target < current / 2) target = current / 2;
+        return target;
+    }
+
+    inline void Connection::on_write_commit() noexcept {
+        if (!m_adaptive_growth.load(std::memory_order_relaxed)) return;
+        std::unique_lock<std::mutex> lock(m_growth_mutex, std::try_to_lock);
+        if (!lock.owns_lock()) return;
+        const auto now = std::chrono::steady_clock::now();
+        if (m_growth_used >= 0 && now - m_growth_sampled_at < m_growth_window) return;
+
+        MDBX_envinfo info;
+        if (!m_env || mdbx_env_info_ex(m_env, nullptr, &info, sizeof(info)) != MDBX_SUCCESS) return;
+        const std::int64_t used = static_cast<std::int64_t>(
+            (info.mi_last_pgno + 1) * static_cast<std::uint64_t>(info.mi_dxb_pagesize));
+        const std::int64_t grown = m_growth_used >= 0 && used > m_growth_used ? used - m_growth_used : 0;
+        const bool first = m_growth_used < 0;
+        m_growth_used = used;
+        m_growth_sampled_at = now;
+        if (first) return;
+
+        const std::int64_t current = m_growth_step.load(std::memory_order_relaxed);
+        const std::int64_t step = plan_growth_step(grown, m_growth_base, m_growth_max, current);
+        if (step == current) return;
+        lock.unlock();
+
+        try {
+            {
+                std::lock_guard<std::mutex> group_lock(m_group_mutex);
+                if (!m_writer_thread.joinable()) {
+                    m_writer_thread = std::thread(&Connection::writer_loop, this);
+                }
+                m_growth_pending = step;
+            }
+            m_writer_cv.notify_one();
+        } catch (...) {
+            // Thread creation failed; keep the current step.
+        }
+    }
+
+    inline void Connection::apply_growth_step(std::int64_t step) noexcept {
+        if (!m_env) return;
+        MDBX_envinfo info;
+        if (mdbx_env_info_ex(m_env, nullptr, &info, sizeof(info)) != MDBX_SUCCESS) return;
+        const std::int64_t used = static_cast<std::int64_t>(
+            (info.mi_last_pgno + 1) * static_cast<std::uint64_t>(info.mi_dxb_pagesize));
+        const std::int64_t upper = static_cast<std::int64_t>(info.mi_geo.upper);
+        // Pre-extend the file by one step so the next writes need no remap.
+        std::int64_t size_now = used + step;
+        if (size_now > upper) size_now = upper;
+        if (size_now <= static_cast<std::int64_t>(info.mi_geo.current)) size_now = -1;
+        // Keep the shrink threshold above the step, or the fresh tail is trimmed again.
+        std::int64_t shrink = -1;
+        {
+            std::lock_guard<std::mutex> lock(m_growth_mutex);
+            shrink = m_growth_shrink;
+        }
+        if (shrink >= 0 && shrink < 2 * step) shrink = 2 * step;
+        if (mdbx_env_set_geometry(m_env, -1, size_now, -1, step, shrink, -1) == MDBX_SUCCESS) {
+            m_growth_step.store(step, std::memory_order_relaxed);
+        }
+    }
+
+    inline bool Connection::park_read_txn(MDBX_txn* txn) noexcept {
+        std::lock_guard<std::mutex> lock(m_read_cache_mutex);
+        if (m_parked_reads.size() >= m_read_cache_size) {
+            return false;
+        }
+        try {
+            ParkedReadTxn entry;
+            entry.owner = std::this_thread::get_id();
+            entry.txn = txn;
+            entry.parked_at = std::chrono::steady_clock::now();
+            m_parked_reads.push_back(entry);
+        } catch (...) {
+            return false;
+        }
+        return true;
+    }
+
+    inline MDBX_txn* Connection::take_parked_read_txn() {
+        std::lock_guard<std::mutex> lock(m_read_cache_mutex);
+        if (m_parked_reads.empty()) return nullptr;
+        const auto now = std::chrono::steady_clock::now();
+        const auto self = std::this_thread::get_id();
+        MDBX_txn* found = nullptr;
+        std::size_t keep = 0;
+        for (std::size_t i = 0; i < m_parked_reads.size(); ++i) {
+            ParkedReadTxn& entry = m_parked_reads[i];
+            if (!found && entry.owner == self) {
+                found = entry.txn;
+                continue;
+            }
+            if (now - entry.parked_at > m_read_cache_max_idle) {
+                // Reset handles own no snapshot and may be aborted from any thread.
+                mdbx_txn_abort(entry.txn);
+                continue;
+            }
+            m_parked_reads[keep++] = entry;
+        }
+        m_parked_reads.resize(keep);
+        return found;
+    }
+
+    inline void Connection::clear_parked_read_txns() noexcept {
+        std::lock_guard<std::mutex> lock(m_read_cache_mutex);
+        for (std::size_t i = 0; i < m_parked_reads.size(); ++i) {
+            mdbx_txn_abort(m_parked_reads[i].txn);
+        }
+        m_parked_reads.clear();
+        m_read_cache_size = 0;
     }
 
     inline void Connection::begin(TransactionMode mode) {
@@ -166,8 +550,7 @@ namespace mdbxc {
     }
 
     inline int64_t Connection::max_dupsort_value_size() const {
-        std::lock_guard<std::mutex> locker(m_mdbx_mutex);
-        return m_config ? m_config->max_dupsort_value_size : Config().max_dupsort_value_size;
+        return m_max_dupsort_value_size.load(std::memory_order_relaxed);
     }
 
 #   if MDBXC_SYNC_ENABLED
@@ -277,7 +660,8 @@ namespace mdbxc {
     inline Connection::SyncApplyNotification Connection::mark_sync_apply_committed(
         std::size_t applied_batches,
         std::size_t applied_ops,
-        const std::vector<std::string>& affected_dbi_names) {
+        const std::vector<std::string>& affected_dbi_names,
+        std::vector<sync::SyncAppliedKey> applied_keys) {
         SyncApplyNotification notification;
         std::lock_guard<std::mutex> locker(m_mdbx_mutex);
         ++m_sync_apply_generation;
@@ -285,6 +669,7 @@ namespace mdbxc {
         notification.applied_batches = applied_batches;
         notification.applied_ops = applied_ops;
         notification.affected_dbi_names = affected_dbi_names;
+        notification.applied_keys.swap(applied_keys);
         notification.callbacks.reserve(m_sync_apply_observers.size());
         for (std::size_t i = 0; i < m_sync_apply_observers.size(); ++i) {
             const std::shared_ptr<SyncApplyObserverState>& state =
@@ -310,6 +695,7 @@ namespace mdbxc {
         event.applied_batches = notification.applied_batches;
         event.applied_ops = notification.applied_ops;
         event.affected_dbi_names = notification.affected_dbi_names;
+        event.applied_keys = notification.applied_keys;
         for (std::size_t i = 0; i < notification.callbacks.size(); ++i) {
             try {
                 begin_sync_apply_observer_callback(
@@ -368,17 +754,16 @@ namespace mdbxc {
             // discard must not throw; sink contract is noexcept.
         }
     }
-#   endif
 
-    inline void Connection::backup_to(const std::string& path, const BackupOptions& options) {
-        std::lock_guard<std::mutex> locker(m_mdbx_mutex);
-        if (!m_env) {
-            throw MdbxException("Connection is not connected.", MDBX_EINVAL);
-        }
-        if (m_shutdown_requested) {
-            throw std::logic_error("Cannot backup during connection shutdown.");
+    inline void Connection::on_committed(std::uint64_t txn_id) noexcept {
+        sync::ISyncCaptureSink* sink = sync_capture();
+        if (sink != nullptr) {
+            sink->committed_txn(txn_id);
         }
+    }
+#   endif
 
+    inline MDBX_copy_flags_t Connection::backup_copy_flags(const BackupOptions& options) noexcept {
         MDBX_copy_flags_t flags = MDBX_CP_DEFAULTS;
         if (options.mode == BackupMode::Compact) {
             flags = static_cast<MDBX_copy_flags_t>(flags | MDBX_CP_COMPACT);
@@ -392,19 +777,108 @@ namespace mdbxc {
         if (options.force_dynamic_size) {
             flags = static_cast<MDBX_copy_flags_t>(flags | MDBX_CP_FORCE_DYNAMIC_SIZE);
         }
+        return flags;
+    }
+
+    inline void Connection::backup_to(const std::string& path, const BackupOptions& options) {
+        std::lock_guard<std::mutex> locker(m_mdbx_mutex);
+        if (!m_env) {
+            throw MdbxException("Connection is not connected.", MDBX_EINVAL);
+        }
+        if (m_shutdown_requested) {
+            throw std::logic_error("Cannot backup during connection shutdown.");
+        }
 
-        const int rc = mdbx_env_copy(m_env, path.c_str(), flags);
+        const int rc = mdbx_env_copy(m_env, path.c_str(), backup_copy_flags(options));
         if (rc != MDBX_SUCCESS) {
             check_mdbx(rc, "mdbx_env_copy failed");
         }
     }
 
+    inline void Connection::backup_to_stream(const BackupSink& sink, const BackupOptions& options) {
+        {
+            std::lock_guard<std::mutex> locker(m_mdbx_mutex);
+            if (!m_env) {
+                throw MdbxException("Connection is not connected.", MDBX_EINVAL);
+            }
+            if (m_shutdown_requested) {
+                throw std::logic_error("Cannot backup during connection shutdown.");
+            }
+            // Holds off shutdown()/disconnect() until the copier is joined.
+            register_txn_handle();
+        }
+        struct HandleGuard {
+            Connection* self;
+            ~HandleGuard() { self->unregister_txn_handle(); }
+        } handle_guard = { this };
+
+        detail::BackupPipe pipe;
+        check_mdbx(pipe.open(), "Failed to create backup pipe");
+
+        const MDBX_copy_flags_t flags = backup_copy_flags(options);
+        MDBX_env* env = m_env;
+        int copy_rc = MDBX_SUCCESS;
+        std::thread copier([env, flags, &pipe, &copy_rc]() {
+            detail::BackupPipe::ignore_broken_pipe_signal();
+            copy_rc = mdbx_env_copy2fd(env, pipe.write_handle(), flags);
+            pipe.close_write();
+        });
+
+        typedef std::chrono::steady_clock clock;
+        const clock::time_point start = clock::now();
+        std::uint64_t total = 0;
+        std::exception_ptr sink_error;
+        std::vector<char> buffer(1024 * 1024);
+        int read_rc = MDBX_SUCCESS;
+        for (;;) {
+            std::size_t got = 0;
+            read_rc = pipe.read(buffer.data(), buffer.size(), got);
+            if (read_rc != MDBX_SUCCESS || got == 0) break;
+            try {
+                sink(buffer.data(), got);
+            } catch (...) {
+                sink_error = std::current_exception();
+                break;
+            }
+            total += got;
+            if (options.max_bytes_per_sec > 0) {
+                const auto due = start + std::chrono::microseconds(
+                    total * 1000000u / options.max_bytes_per_sec);
+                std::this_thread::sleep_until(due);
+            }
+        }
+        // Unblocks the copier if we stopped reading early.
+        pipe.close_read();
+        copier.join();
+
+        if (sink_error) std::rethrow_exception(sink_error);
+        check_mdbx(copy_rc, "mdbx_env_copy2fd failed");
+        check_mdbx(read_rc, "Failed to read backup pipe");
+    }
+
+    inline void Connection::backup_to_fd(mdbx_filehandle_t fd, const BackupOptions& options) {
+        if (options.max_bytes_per_sec > 0) {
+            backup_to_stream([fd](const void* data, std::size_t size) {
+                check_mdbx(detail::BackupPipe::write_all(fd, data, size), "Failed to write backup");
+            }, options);
+            return;
+        }
+        std::lock_guard<std::mutex> locker(m_mdbx_mutex);
+        if (!m_env) {
+            throw MdbxException("Connection is not connected.", MDBX_EINVAL);
+        }
+        if (m_shutdown_requested) {
+            throw std::logic_error("Cannot backup during connection shutdown.");
+        }
+        check_mdbx(mdbx_env_copy2fd(m_env, fd, backup_copy_flags(options)), "mdbx_env_copy2fd failed");
+    }
+
     inline void Connection::sync_to_disk(bool force, bool nonblock) {
         std::lock_guard<std::mutex> locker(m_mdbx_mutex);
         if (!m_env) {
             throw MdbxException("Connection is not connected.", MDBX_EINVAL);
         }
-        const int rc = mdbx_env_sync_ex(m_env, force, nonblock);
+        const int rc = force ? flush_durable(nonblock) : mdbx_env_sync_ex(m_env, false, nonblock);
         // mdbx_env_sync_ex returns MDBX_SUCCESS on flushed data and
         // MDBX_RESULT_TRUE when nothing was pending; both are success.
         if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE) {
@@ -412,9 +886,796 @@ namespace mdbxc {
         }
     }
 
+    inline MDBX_dbi Connection::open_dbi(const std::string& name,
+                                         MDBX_db_flags_t flags,
+                                         std::uint32_t* dbi_flags) {
+        const MDBX_db_flags_t open_flags = static_cast<MDBX_db_flags_t>(flags & ~MDBX_CREATE);
+        const std::pair<std::string, unsigned> key(name, static_cast<unsigned>(open_flags));
+        {
+            std::lock_guard<std::mutex> lock(m_dbi_cache_mutex);
+            auto it = m_dbi_cache.find(key);
+            if (it != m_dbi_cache.end()) {
+                if (dbi_flags) *dbi_flags = it->second.flags;
+                return it->second.dbi;
+            }
+        }
+
+        CachedDbi entry = CachedDbi();
+        unsigned persistent = 0;
+        bool opened = false;
+        {
+            auto txn = transaction(TransactionMode::READ_ONLY);
+            const int rc = mdbx_dbi_open(txn.handle(), name.c_str(), open_flags, &entry.dbi);
+            if (rc == MDBX_SUCCESS) {
+                check_mdbx(mdbx_dbi_flags(txn.handle(), entry.dbi, &persistent),
+                           "Failed to read table flags");
+                opened = true;
+            } else if (rc != MDBX_NOTFOUND || !(flags & MDBX_CREATE) || is_read_only()) {
+                check_mdbx(rc, "Failed to open table '" + name + "'");
+            }
+            txn.commit();
+        }
+        if (!opened) {
+            auto txn = transaction(TransactionMode::WRITABLE);
+            check_mdbx(mdbx_dbi_open(txn.handle(), name.c_str(), flags, &entry.dbi),
+                       "Failed to open table '" + name + "'");
+            check_mdbx(mdbx_dbi_flags(txn.handle(), entry.dbi, &persistent),
+                       "Failed to read table flags");
+            txn.commit();
+        }
+        entry.flags = static_cast<std::uint32_t>(persistent);
+
+        std::lock_guard<std::mutex> lock(m_dbi_cache_mutex);
+        // MDBX returns the same handle for a name, so a racing insert is equivalent.
+        m_dbi_cache.insert(std::make_pair(key, entry));
+        if (dbi_flags) *dbi_flags = entry.flags;
+        return entry.dbi;
+    }
+
+    inline std::uint64_t Connection::durable_txn_id() const {
+        if (m_lazy_sync.load(std::memory_order_relaxed)) {
+            return m_durable_txn_id.load(std::memory_order_acquire);
+        }
+        // Durable commits are on disk once mdbx_txn_commit returns.
+        MDBX_envinfo info;
+        if (!m_env || mdbx_env_info_ex(m_env, nullptr, &info, sizeof(info)) != MDBX_SUCCESS) {
+            return m_durable_txn_id.load(std::memory_order_acquire);
+        }
+        return info.mi_recent_txnid;
+    }
+
+    inline void Connection::wait_for_durable(std::uint64_t txn_id) {
+        if (txn_id != 0 && durable_txn_id() >= txn_id) return;
+        if (current_thread_has_txn()) {
+            throw std::logic_error("Cannot flush while this thread has an active transaction.");
+        }
+        if (!m_env) {
+            throw MdbxException("Connection is not connected.", MDBX_EINVAL);
+        }
+        const int rc = flush_durable(false);
+        if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE) {
+            check_mdbx(rc, "mdbx_env_sync_ex failed");
+        }
+    }
+
+    inline std::uint64_t Connection::last_txn_id() const {
+        if (!m_env) {
+            throw MdbxException("Connection is not connected.", MDBX_EINVAL);
+        }
+        MDBX_envinfo info;
+        check_mdbx(mdbx_env_info_ex(m_env, nullptr, &info, sizeof(info)),
+                   "Failed to read environment info");
+        return info.mi_recent_txnid;
+    }
+
+    inline std::uint64_t Connection::wait_for_txn(std::uint64_t after_txn_id,
+                                                  std::chrono::milliseconds timeout) const {
+        typedef std::chrono::steady_clock clock;
+        const clock::time_point deadline = clock::now() + timeout;
+        const std::chrono::microseconds max_poll(
+            m_commit_poll_max_ms.load(std::memory_order_relaxed) * 1000);
+        std::chrono::microseconds poll(100);
+        for (;;) {
+            // Read the local sequence first so a commit between the two reads still wakes us.
+            const std::uint64_t seen = commit_sequence();
+            const std::uint64_t txn_id = last_txn_id();
+            const clock::time_point now = clock::now();
+            if (txn_id > after_txn_id || now >= deadline) return txn_id;
+            const clock::duration left = deadline - now;
+            wait_for_commit_for(seen, left < poll ? left : clock::duration(poll));
+            if (poll < max_poll) poll = poll * 2 < max_poll ? poll * 2 : max_poll;
+        }
+    }
+
+    inline int Connection::flush_durable(bool nonblock) noexcept {
+        MDBX_envinfo info;
+        int rc = mdbx_env_info_ex(m_env, nullptr, &info, sizeof(info));
+        if (rc != MDBX_SUCCESS) return rc;
+        // Commits made after this point may or may not be covered by the flush.
+        const std::uint64_t target = info.mi_recent_txnid;
+        rc = mdbx_env_sync_ex(m_env, true, nonblock);
+        if (rc == MDBX_SUCCESS || rc == MDBX_RESULT_TRUE) {
+            std::uint64_t seen = m_durable_txn_id.load(std::memory_order_relaxed);
+            while (seen < target &&
+                   !m_durable_txn_id.compare_exchange_weak(seen, target, std::memory_order_release,
+                                                           std::memory_order_relaxed)) {
+            }
+        }
+        return rc;
+    }
+
+    inline void Connection::sync_loop(std::chrono::milliseconds period) {
+        std::unique_lock<std::mutex> lock(m_sync_mutex);
+        while (!m_sync_stop) {
+            if (m_sync_cv.wait_for(lock, period, [this]() { return m_sync_stop; })) break;
+            lock.unlock();
+            // A failed flush is retried on the next period.
+            flush_durable(false);
+            lock.lock();
+        }
+    }
+
+    inline void Connection::start_sync_thread() {
+        if (!m_lazy_sync.load(std::memory_order_relaxed) || !m_config || m_config->sync_period_ms <= 0) return;
+        std::lock_guard<std::mutex> lock(m_sync_mutex);
+        if (m_sync_thread.joinable()) return;
+        m_sync_thread = std::thread(&Connection::sync_loop, this,
+                                    std::chrono::milliseconds(m_config->sync_period_ms));
+    }
+
+    inline void Connection::stop_sync_thread() noexcept {
+        std::thread worker;
+        {
+            std::lock_guard<std::mutex> lock(m_sync_mutex);
+            if (!m_sync_thread.joinable()) return;
+            m_sync_stop = true;
+            worker.swap(m_sync_thread);
+        }
+        m_sync_cv.notify_all();
+        worker.join();
+        std::lock_guard<std::mutex> lock(m_sync_mutex);
+        m_sync_stop = false;
+    }
+
+    inline void Connection::set_slow_reader_handler(SlowReaderHandler handler) {
+        std::shared_ptr<const SlowReaderHandler> installed;
+        if (handler) {
+            installed = std::make_shared<const SlowReaderHandler>(std::move(handler));
+        }
+        std::lock_guard<std::mutex> lock(m_slow_reader_mutex);
+        m_slow_reader_handler.swap(installed);
+    }
+
+    inline int Connection::slow_reader_callback(const MDBX_env* env, const MDBX_txn* txn,
+                                                mdbx_pid_t pid, mdbx_tid_t tid,
+                                                std::uint64_t laggard, unsigned gap,
+                                                std::size_t space, int retry) noexcept {
+        (void)txn;
+        (void)tid;
+        Connection* self = static_cast<Connection*>(mdbx_env_get_userctx(env));
+        if (!self) return -1;
+        std::shared_ptr<const SlowReaderHandler> handler;
+        {
+            std::lock_guard<std::mutex> lock(self->m_slow_reader_mutex);
+            handler = self->m_slow_reader_handler;
+        }
+        if (!handler) return -1;
+        SlowReaderInfo info;
+        info.txn_id = laggard;
+        info.gap = gap;
+        info.space = space;
+        info.pid = static_cast<int>(pid);
+        info.retry = retry;
+        try {
+            switch ((*handler)(info)) {
+            case SlowReaderAction::Retry: return 0;
+            case SlowReaderAction::Kick:  return 1;
+            case SlowReaderAction::Fail:  break;
+            }
+        } catch (...) {
+            // A throwing handler must not unwind through MDBX.
+        }
+        return -1;
+    }
+
+    inline EnvStats Connection::stats() {
+        std::vector<std::pair<std::string, MDBX_dbi> > dbis;
+        {
+            std::lock_guard<std::mutex> lock(m_dbi_cache_mutex);
+            dbis.reserve(m_dbi_cache.size());
+            for (auto it = m_dbi_cache.begin(); it != m_dbi_cache.end(); ++it) {
+                dbis.push_back(std::make_pair(it->first.first, it->second.dbi));
+            }
+        }
+
+        EnvStats result;
+        auto txn = transaction(TransactionMode::READ_ONLY);
+
+        MDBX_envinfo info;
+        check_mdbx(mdbx_env_info_ex(m_env, txn.handle(), &info, sizeof(info)),
+                   "Failed to query environment info");
+        result.page_size = info.mi_dxb_pagesize;
+        result.map_size_bytes = info.mi_geo.current;
+        result.map_upper_bytes = info.mi_geo.upper;
+        result.used_pages = info.mi_last_pgno + 1;
+        result.readers_max = info.mi_maxreaders;
+        result.readers_in_use = info.mi_numreaders;
+        result.last_txn_id = info.mi_recent_txnid;
+        result.oldest_reader_txn_id = info.mi_latter_reader_txnid;
+        result.oldest_reader_lag = info.mi_recent_txnid > info.mi_latter_reader_txnid
+            ? info.mi_recent_txnid - info.mi_latter_reader_txnid : 0;
+
+        MDBX_stat stat;
+        check_mdbx(mdbx_env_stat_ex(m_env, txn.handle(), &stat, sizeof(stat)),
+                   "Failed to query environment statistics");
+        result.tree_pages = stat.ms_branch_pages + stat.ms_leaf_pages + stat.ms_overflow_pages;
+        result.entries = stat.ms_entries;
+
+        // Handle 0 is the GC (freelist) tree in MDBX.
+        if (mdbx_dbi_stat(txn.handle(), 0, &stat, sizeof(stat)) == MDBX_SUCCESS) {
+            result.gc_pages = stat.ms_branch_pages + stat.ms_leaf_pages + stat.ms_overflow_pages;
+            result.gc_entries = stat.ms_entries;
+        }
+
+        result.tables.reserve(dbis.size());
+        for (std::size_t i = 0; i < dbis.size(); ++i) {
+            check_mdbx(mdbx_dbi_stat(txn.handle(), dbis[i].second, &stat, sizeof(stat)),
+                       "Failed to query table statistics");
+            DbiStats table;
+            table.name = dbis[i].first;
+            table.depth = stat.ms_depth;
+            table.branch_pages = stat.ms_branch_pages;
+            table.leaf_pages = stat.ms_leaf_pages;
+            table.overflow_pages = stat.ms_overflow_pages;
+            table.entries = stat.ms_entries;
+            result.tables.push_back(table);
+        }
+        txn.commit();
+        return result;
+    }
+
+    inline WarmupResult Connection::warmup(const std::vector<std::string>& tables,
+                                           std::chrono::milliseconds budget,
+                                           const WarmupOptions& options) {
+        typedef std::chrono::steady_clock clock;
+        const clock::time_point start = clock::now();
+        const bool limited = budget > std::chrono::milliseconds::zero();
+        const clock::time_point deadline = start + budget;
+
+        WarmupResult result;
+        WarmupProgress progress;
+        progress.tables_total = tables.size();
+        auto finish = [&result, &progress, start]() {
+            result.tables_done = progress.tables_done;
+            result.entries = progress.entries;
+            result.bytes = progress.bytes;
+            result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start);
+            return result;
+        };
+
+        // Resolve handles first: a cache miss cannot open a DBI inside our transaction.
+        std::vector<MDBX_dbi> dbis;
+        dbis.reserve(tables.size());
+        for (std::size_t i = 0; i < tables.size(); ++i) {
+            dbis.push_back(open_dbi(tables[i], MDBX_DB_ACCEDE));
+        }
+
+        Transaction txn = transaction(TransactionMode::READ_ONLY);
+        if (options.prefault_env) {
+            MDBX_warmup_flags_t flags = MDBX_warmup_default;
+            if (options.force) flags |= MDBX_warmup_force;
+            if (options.lock)  flags |= MDBX_warmup_lock;
+            unsigned timeout_16dot16 = 0;
+            if (limited) {
+                const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now());
+                if (left <= std::chrono::milliseconds::zero()) return finish();
+                const std::uint64_t scaled = static_cast<std::uint64_t>(left.count()) * 65536u / 1000u;
+                timeout_16dot16 = scaled > 0xFFFFFFFFu ? 0xFFFFFFFFu
+                                                       : static_cast<unsigned>(scaled > 0 ? scaled : 1);
+            }
+            if (options.progress) options.progress(progress);
+            const int rc = mdbx_env_warmup(m_env, txn.handle(), flags, timeout_16dot16);
+            if (rc == MDBX_RESULT_TRUE) return finish();
+            check_mdbx(rc, "Failed to warm up environment");
+        }
+
+        // Reading one byte per page faults in large values that a key scan skips.
+        const std::size_t page = 4096;
+        const std::size_t every = options.progress_every > 0 ? options.progress_every : 1;
+        for (std::size_t i = 0; i < dbis.size(); ++i) {
+            progress.table = tables[i];
+            if (options.progress) options.progress(progress);
+            struct CursorCloser {
+                MDBX_cursor* cursor = nullptr;
+                ~CursorCloser() { if (cursor) mdbx_cursor_close(cursor); }
+            } guard;
+            check_mdbx(mdbx_cursor_open(txn.handle(), dbis[i], &guard.cursor), "Failed to open warm-up cursor");
+            MDBX_cursor* cursor = guard.cursor;
+            std::size_t scanned = 0;
+            MDBX_val key, data;
+            int rc = mdbx_cursor_get(cursor, &key, &data, MDBX_FIRST);
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(cursor, &key, &data, MDBX_NEXT)) {
+                volatile unsigned char sink = 0;
+                const unsigned char* bytes = static_cast<const unsigned char*>(data.iov_base);
+                for (std::size_t off = 0; off < data.iov_len; off += page) {
+                    sink = static_cast<unsigned char>(sink ^ bytes[off]);
+                }
+                (void)sink;
+                ++progress.entries;
+                progress.bytes += key.iov_len + data.iov_len;
+                if (++scanned % every == 0) {
+                    if (options.progress) options.progress(progress);
+                    if (limited && clock::now() >= deadline) break;
+                }
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to scan table during warm-up");
+            }
+            if (rc == MDBX_SUCCESS) return finish(); // budget exhausted mid-table
+            ++progress.tables_done;
+            if (limited && clock::now() >= deadline && progress.tables_done < dbis.size()) {
+                return finish();
+            }
+        }
+        txn.commit();
+        progress.table.clear();
+        if (options.progress) options.progress(progress);
+        result.completed = true;
+        return finish();
+    }
+
+    inline std::future<WarmupResult> Connection::warmup_async(std::vector<std::string> tables,
+                                                              std::chrono::milliseconds budget,
+                                                              WarmupOptions options) {
+        return std::async(std::launch::async,
+            [this, tables, budget, options]() { return warmup(tables, budget, options); });
+    }
+
+    inline std::vector<std::string> Connection::list_named_dbis(std::vector<std::uint32_t>* flags,
+                                                                std::vector<MDBX_dbi>* dbis) {
+        // Named DBIs are the keys of the main DBI that open as sub-databases.
+        std::vector<std::string> keys;
+        {
+            Transaction txn = transaction(TransactionMode::READ_ONLY);
+            MDBX_dbi main_dbi = 0;
+            check_mdbx(mdbx_dbi_open(txn.handle(), nullptr, MDBX_DB_DEFAULTS, &main_dbi),
+                       "Failed to open main DBI");
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn.handle(), main_dbi, &raw), "Failed to open main DBI cursor");
+            std::unique_ptr<MDBX_cursor, void (*)(MDBX_cursor*)> cursor(raw, &mdbx_cursor_close);
+            MDBX_val key, data;
+            int rc = mdbx_cursor_get(raw, &key, &data, MDBX_FIRST);
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &key, &data, MDBX_NEXT)) {
+                keys.push_back(std::string(static_cast<const char*>(key.iov_base), key.iov_len));
+            }
+            cursor.reset();
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to list DBIs");
+            txn.commit();
+        }
+        std::vector<std::string> names;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            std::uint32_t dbi_flags = 0;
+            MDBX_dbi dbi = 0;
+            try {
+                dbi = open_dbi(keys[i], MDBX_DB_ACCEDE, &dbi_flags);
+            } catch (const MdbxException& e) {
+                if (e.error_code() == MDBX_INCOMPATIBLE) continue; // plain record, not a DBI
+                throw;
+            }
+            names.push_back(keys[i]);
+            if (flags) flags->push_back(dbi_flags);
+            if (dbis) dbis->push_back(dbi);
+        }
+        return names;
+    }
+
+    inline GeometryAdvice Connection::advise_geometry(const GeometryAdviceOptions& options) {
+        const MDBX_db_flags_t persistent_flags = MDBX_REVERSEKEY | MDBX_DUPSORT | MDBX_INTEGERKEY |
+                                                 MDBX_DUPFIXED | MDBX_INTEGERDUP | MDBX_REVERSEDUP;
+        typedef std::pair<std::uint32_t, std::uint32_t> SizePair;
+        typedef std::pair<std::string, std::string> Record;
+
+        std::vector<std::uint32_t> dbi_flags;
+        std::vector<MDBX_dbi> dbis;
+        const std::vector<std::string> names = list_named_dbis(&dbi_flags, &dbis);
+
+        std::vector<std::uint32_t> candidates = options.page_sizes;
+        if (candidates.empty()) {
+            for (std::uint32_t size = 4096; size <= 65536; size *= 2) candidates.push_back(size);
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            const std::uint32_t size = candidates[i];
+            if (size < 256 || size > 65536 || (size & (size - 1)) != 0) {
+                throw std::invalid_argument("advise_geometry: page sizes must be powers of two from 256 to 65536.");
+            }
+        }
+
+        GeometryAdvice advice;
+        const EnvStats env = stats();
+        advice.current_page_size = env.page_size;
+        advice.used_bytes = env.used_pages * env.page_size;
+
+        // Key and value sizes are kept in pairs: whether a node spills depends on both.
+        std::vector<std::vector<SizePair> > sizes(names.size());
+        std::vector<std::vector<Record> > kept(names.size());
+        const bool measure = !options.measure_dir.empty();
+        {
+            Transaction txn = transaction(TransactionMode::READ_ONLY);
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                DbiProfile profile;
+                profile.name = names[i];
+                profile.flags = dbi_flags[i] & static_cast<std::uint32_t>(persistent_flags);
+                MDBX_stat stat;
+                check_mdbx(mdbx_dbi_stat(txn.handle(), dbis[i], &stat, sizeof(stat)),
+                           "Failed to query DBI statistics");
+                profile.depth = stat.ms_depth;
+                profile.entries = stat.ms_entries;
+                profile.branch_pages = stat.ms_branch_pages;
+                profile.leaf_pages = stat.ms_leaf_pages;
+                profile.overflow_pages = stat.ms_overflow_pages;
+
+                MDBX_cursor* raw = nullptr;
+                check_mdbx(mdbx_cursor_open(txn.handle(), dbis[i], &raw), "Failed to open sampling cursor");
+                std::unique_ptr<MDBX_cursor, void (*)(MDBX_cursor*)> cursor(raw, &mdbx_cursor_close);
+                const bool dupsort = (profile.flags & MDBX_DUPSORT) != 0;
+                std::uint64_t node_bytes = 0;
+                MDBX_val key, data;
+                int rc = mdbx_cursor_get(raw, &key, &data, MDBX_FIRST);
+                for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &key, &data, MDBX_NEXT)) {
+                    profile.key_sizes.add(key.iov_len);
+                    profile.value_sizes.add(data.iov_len);
+                    sizes[i].push_back(SizePair(static_cast<std::uint32_t>(key.iov_len),
+                                                static_cast<std::uint32_t>(data.iov_len)));
+                    if (!dupsort && detail::geometry_overflows(env.page_size, key.iov_len, data.iov_len)) {
+                        ++profile.sampled_overflow;
+                        node_bytes += detail::geometry_node_header + key.iov_len + sizeof(std::uint32_t);
+                    } else {
+                        node_bytes += detail::geometry_node_header + key.iov_len + data.iov_len;
+                    }
+                    if (measure && kept[i].size() < options.measure_entries) {
+                        kept[i].push_back(Record(
+                            std::string(static_cast<const char*>(key.iov_base), key.iov_len),
+                            std::string(static_cast<const char*>(data.iov_base), data.iov_len)));
+                    }
+                    if (++profile.sampled == options.sample_entries) break;
+                }
+                if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to sample table");
+                }
+                if (profile.sampled != 0 && profile.leaf_pages != 0 && !dupsort) {
+                    const double nodes = static_cast<double>(node_bytes) *
+                        static_cast<double>(profile.entries) / static_cast<double>(profile.sampled);
+                    const double space = static_cast<double>(profile.leaf_pages) *
+                        static_cast<double>(env.page_size - detail::geometry_page_header);
+                    profile.leaf_fill = std::min(1.0, nodes / space);
+                }
+                advice.tables.push_back(profile);
+            }
+            txn.commit();
+        }
+
+        // Fill observed on this file carries over to other page sizes; a
+        // fresh or dupsort table assumes the usual fill of random inserts.
+        bool any_dupsort = false;
+        for (std::size_t c = 0; c < candidates.size(); ++c) {
+            const std::uint32_t page = candidates[c];
+            PageSizeEstimate estimate;
+            estimate.page_size = page;
+            double total = 0.0;
+            for (std::size_t i = 0; i < advice.tables.size(); ++i) {
+                const DbiProfile& profile = advice.tables[i];
+                const bool dupsort = (profile.flags & MDBX_DUPSORT) != 0;
+                any_dupsort = any_dupsort || dupsort;
+                if (profile.sampled == 0) continue;
+                const std::uint64_t key_max = static_cast<std::uint64_t>(
+                    mdbx_limits_keysize_max(page, static_cast<MDBX_db_flags_t>(profile.flags)));
+                const std::uint64_t dup_max = dupsort ? static_cast<std::uint64_t>(
+                    mdbx_limits_valsize_max(page, static_cast<MDBX_db_flags_t>(profile.flags))) : 0;
+                double node_bytes = 0.0;
+                double overflow_pages = 0.0;
+                std::uint64_t overflow_entries = 0;
+                for (std::size_t k = 0; k < sizes[i].size(); ++k) {
+                    const std::uint64_t key_size = sizes[i][k].first;
+                    const std::uint64_t value_size = sizes[i][k].second;
+                    if (key_size > key_max || (dupsort && value_size > dup_max)) {
+                        estimate.keys_fit = false;
+                    }
+                    if (!dupsort && detail::geometry_overflows(page, key_size, value_size)) {
+                        ++overflow_entries;
+                        overflow_pages += static_cast<double>(detail::geometry_overflow_pages(page, value_size));
+                        node_bytes += detail::geometry_node_header + key_size + sizeof(std::uint32_t);
+                    } else {
+                        node_bytes += detail::geometry_node_header + key_size + value_size;
+                    }
+                }
+                const double scale = static_cast<double>(profile.entries) /
+                                     static_cast<double>(profile.sampled);
+                const double fill = profile.leaf_fill >= 0.3 ? profile.leaf_fill : 0.7;
+                const double leaf_pages = node_bytes * scale /
+                    (fill * static_cast<double>(page - detail::geometry_page_header));
+                total += (leaf_pages + overflow_pages * scale) * static_cast<double>(page);
+                estimate.overflow_entries += static_cast<std::uint64_t>(
+                    static_cast<double>(overflow_entries) * scale + 0.5);
+                estimate.overflow_pages += static_cast<std::uint64_t>(overflow_pages * scale + 0.5);
+            }
+            estimate.estimated_bytes = static_cast<std::uint64_t>(total + 0.5);
+            advice.estimates.push_back(estimate);
+        }
+
+        // Smallest fitting estimate; a smaller page within the tolerance wins.
+        std::uint64_t best = 0;
+        for (std::size_t c = 0; c < advice.estimates.size(); ++c) {
+            const PageSizeEstimate& estimate = advice.estimates[c];
+            if (estimate.keys_fit && (best == 0 || estimate.estimated_bytes < best)) {
+                best = estimate.estimated_bytes;
+            }
+        }
+        const double limit = static_cast<double>(best) * (1.0 + std::max(0.0, options.size_tolerance));
+        for (std::size_t c = 0; c < advice.estimates.size(); ++c) {
+            const PageSizeEstimate& estimate = advice.estimates[c];
+            if (estimate.keys_fit && static_cast<double>(estimate.estimated_bytes) <= limit) {
+                advice.recommended_page_size = estimate.page_size;
+                break;
+            }
+        }
+        if (advice.recommended_page_size == 0) {
+            advice.recommended_page_size = env.page_size;
+            advice.notes.push_back("No candidate page size fits every sampled key; keeping the current one.");
+        }
+
+        const std::int64_t min_step = 16ll * 1024 * 1024;
+        const std::int64_t max_step = 1024ll * 1024 * 1024;
+        std::int64_t step = min_step;
+        while (step < max_step && static_cast<std::uint64_t>(step) < advice.used_bytes / 8) step *= 2;
+        advice.recommended_growth_step = step;
+        advice.recommended_shrink_threshold = step * 4;
+        if (any_dupsort) {
+            advice.recommended_max_dupsort_value_size = static_cast<std::int64_t>(
+                mdbx_limits_valsize_max(advice.recommended_page_size, MDBX_DUPSORT));
+        }
+
+        const std::uint32_t page = advice.recommended_page_size;
+        const std::uint64_t dup_limit = static_cast<std::uint64_t>(mdbx_limits_valsize_max(page, MDBX_DUPSORT));
+        for (std::size_t i = 0; i < advice.tables.size(); ++i) {
+            DbiProfile& profile = advice.tables[i];
+            if (profile.value_sizes.percentile(0.99) <= dup_limit) {
+                profile.layout = ValueLayoutHint::Inline;
+            } else if (profile.value_sizes.percentile(0.5) <= dup_limit) {
+                profile.layout = ValueLayoutHint::Mixed;
+            } else {
+                profile.layout = ValueLayoutHint::Large;
+            }
+            if (profile.sampled != 0 && profile.sampled_overflow * 10 >= profile.sampled) {
+                advice.notes.push_back("Table '" + profile.name + "': " +
+                    std::to_string(profile.sampled_overflow) + " of " + std::to_string(profile.sampled) +
+                    " sampled values use overflow pages at page size " + std::to_string(env.page_size) + ".");
+            }
+        }
+        if (page != env.page_size) {
+            advice.notes.push_back("Page size " + std::to_string(page) +
+                " is estimated smaller than the current " + std::to_string(env.page_size) +
+                "; apply it with compact_to() into a new environment.");
+        }
+
+        if (measure) {
+            for (std::size_t c = 0; c < candidates.size(); ++c) {
+                typedef std::chrono::steady_clock clock;
+                PageSizeMeasurement measurement;
+                measurement.page_size = candidates[c];
+                Config cfg;
+                cfg.pathname = options.measure_dir + "/mdbxc_geometry_" + std::to_string(candidates[c]) + ".mdbx";
+                cfg.page_size = candidates[c];
+                cfg.max_dbs = static_cast<int64_t>(names.size()) + 1;
+                cfg.no_subdir = true;
+                cfg.sync_mode = SyncMode::UtterlyNoSync;
+                std::remove(cfg.pathname.c_str());
+                std::remove((cfg.pathname + "-lck").c_str());
+                {
+                    std::shared_ptr<Connection> scratch = Connection::create(cfg);
+                    std::vector<MDBX_dbi> scratch_dbis(names.size());
+                    for (std::size_t i = 0; i < names.size(); ++i) {
+                        scratch_dbis[i] = scratch->open_dbi(names[i],
+                            static_cast<MDBX_db_flags_t>(advice.tables[i].flags | MDBX_CREATE));
+                    }
+                    const clock::time_point start = clock::now();
+                    {
+                        Transaction txn = scratch->transaction(TransactionMode::WRITABLE);
+                        for (std::size_t i = 0; i < names.size(); ++i) {
+                            const MDBX_put_flags_t flags = (advice.tables[i].flags & MDBX_DUPSORT)
+                                ? MDBX_APPEND | MDBX_APPENDDUP : MDBX_APPEND;
+                            for (std::size_t k = 0; k < kept[i].size(); ++k) {
+                                MDBX_val key;
+                                MDBX_val data;
+                                key.iov_base = const_cast<char*>(kept[i][k].first.data());
+                                key.iov_len = kept[i][k].first.size();
+                                data.iov_base = const_cast<char*>(kept[i][k].second.data());
+                                data.iov_len = kept[i][k].second.size();
+                                check_mdbx(mdbx_put(txn.handle(), scratch_dbis[i], &key, &data, flags),
+                                           "Failed to copy sampled record");
+                            }
+                            measurement.entries += kept[i].size();
+                        }
+                        txn.commit();
+                    }
+                    measurement.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start);
+                    const EnvStats copied = scratch->stats();
+                    measurement.used_bytes = copied.used_pages * copied.page_size;
+                    for (std::size_t i = 0; i < copied.tables.size(); ++i) {
+                        measurement.overflow_pages += copied.tables[i].overflow_pages;
+                    }
+                    scratch->disconnect();
+                }
+                std::remove(cfg.pathname.c_str());
+                std::remove((cfg.pathname + "-lck").c_str());
+                advice.measurements.push_back(measurement);
+            }
+        }
+        return advice;
+    }
+
+    inline CompactResult Connection::compact_to(const Config& target, const CompactOptions& options) {
+        typedef std::chrono::steady_clock clock;
+        const clock::time_point start = clock::now();
+        const MDBX_db_flags_t persistent_flags = MDBX_REVERSEKEY | MDBX_DUPSORT | MDBX_INTEGERKEY |
+                                                 MDBX_DUPFIXED | MDBX_INTEGERDUP | MDBX_REVERSEDUP;
+
+        struct SourceTable {
+            std::string   name;
+            MDBX_dbi      dbi;
+            unsigned      flags;
+            std::uint64_t entries;
+        };
+
+        std::vector<std::uint32_t> dbi_flags;
+        std::vector<MDBX_dbi> dbi_handles;
+        const std::vector<std::string> names = list_named_dbis(&dbi_flags, &dbi_handles);
+        std::vector<SourceTable> tables;
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            SourceTable table;
+            table.name = names[i];
+            table.dbi = dbi_handles[i];
+            table.flags = dbi_flags[i] & static_cast<unsigned>(persistent_flags);
+            table.entries = 0;
+            tables.push_back(table);
+        }
+
+        CompactResult result;
+        const EnvStats before = stats();
+        result.source_used_bytes = before.used_pages * before.page_size;
+
+        Config target_cfg = target;
+        if (target_cfg.page_size == 0) {
+            // Keep the source page size so the overflow layout does not change.
+            target_cfg.page_size = before.page_size;
+        }
+        if (target_cfg.max_dbs < static_cast<int64_t>(tables.size())) {
+            target_cfg.max_dbs = static_cast<int64_t>(tables.size());
+        }
+        std::shared_ptr<Connection> dest = Connection::create(target_cfg);
+        std::vector<MDBX_dbi> dest_dbis(tables.size());
+        for (std::size_t i = 0; i < tables.size(); ++i) {
+            dest_dbis[i] = dest->open_dbi(tables[i].name,
+                static_cast<MDBX_db_flags_t>(tables[i].flags | MDBX_CREATE));
+        }
+        {
+            Transaction txn = dest->transaction(TransactionMode::READ_ONLY);
+            for (std::size_t i = 0; i < dest_dbis.size(); ++i) {
+                MDBX_stat stat;
+                check_mdbx(mdbx_dbi_stat(txn.handle(), dest_dbis[i], &stat, sizeof(stat)),
+                           "Failed to query target DBI statistics");
+                if (stat.ms_entries != 0) {
+                    throw std::logic_error("compact_to: target table '" + tables[i].name + "' is not empty.");
+                }
+            }
+            txn.commit();
+        }
+
+        // One read transaction covers every DBI, so the copy is a single
+        // snapshot. Its pages stay mapped until it ends, so records go to the
+        // target straight from the source views.
+        Transaction source = transaction(TransactionMode::READ_ONLY);
+        for (std::size_t i = 0; i < tables.size(); ++i) {
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(source.handle(), tables[i].dbi, &stat, sizeof(stat)),
+                       "Failed to query DBI statistics");
+            tables[i].entries = stat.ms_entries;
+        }
+
+        const std::size_t batch_entries = options.batch_entries > 0 ? options.batch_entries : 1;
+        for (std::size_t i = 0; i < tables.size(); ++i) {
+            CompactProgress progress;
+            progress.table = tables[i].name;
+            progress.entries_total = tables[i].entries;
+            const MDBX_put_flags_t flags = (tables[i].flags & MDBX_DUPSORT)
+                ? MDBX_APPEND | MDBX_APPENDDUP : MDBX_APPEND;
+
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(source.handle(), tables[i].dbi, &raw),
+                       "Failed to open compaction cursor");
+            std::unique_ptr<MDBX_cursor, void (*)(MDBX_cursor*)> cursor(raw, &mdbx_cursor_close);
+            MDBX_val key, data;
+            int rc = mdbx_cursor_get(raw, &key, &data, MDBX_FIRST);
+            while (rc == MDBX_SUCCESS) {
+                Transaction txn = dest->transaction(TransactionMode::WRITABLE);
+                std::size_t copied = 0;
+                for (; rc == MDBX_SUCCESS && copied < batch_entries;
+                     rc = mdbx_cursor_get(raw, &key, &data, MDBX_NEXT)) {
+                    check_mdbx(mdbx_put(txn.handle(), dest_dbis[i], &key, &data, flags),
+                               "Failed to append record during compaction");
+                    progress.bytes += key.iov_len + data.iov_len;
+                    ++copied;
+                }
+                txn.commit();
+                progress.entries_copied += copied;
+                progress.done = rc == MDBX_NOTFOUND;
+                if (options.progress) options.progress(progress);
+            }
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to scan table during compaction");
+            if (!progress.done) {
+                progress.done = true;
+                if (options.progress) options.progress(progress);
+            }
+            result.entries += progress.entries_copied;
+            result.bytes += progress.bytes;
+        }
+        source.commit();
+
+        result.tables = tables.size();
+        const EnvStats after = dest->stats();
+        result.target_used_bytes = after.used_pages * after.page_size;
+        result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start);
+        return result;
+    }
+
     inline void Connection::initialize() {
         try {
             db_init();
+            {
+                std::lock_guard<std::mutex> group_lock(m_group_mutex);
+                m_group_max_batch = m_config->group_commit_max_batch > 0
+                    ? static_cast<std::size_t>(m_config->group_commit_max_batch) : 1;
+            }
+            m_group_commit.store(m_config->group_commit, std::memory_order_relaxed);
+            set_read_age_tracking(m_config->track_read_txn_age);
+            {
+                std::lock_guard<std::mutex> growth_lock(m_growth_mutex);
+                m_growth_base = m_config->growth_step;
+                m_growth_max = m_config->growth_step_max > m_config->growth_step
+                    ? m_config->growth_step_max : m_config->growth_step;
+                m_growth_window = std::chrono::milliseconds(
+                    m_config->adaptive_growth_window_ms > 0 ? m_config->adaptive_growth_window_ms : 0);
+                m_growth_shrink = m_config->shrink_threshold;
+                m_growth_used = -1;
+                m_growth_step.store(m_config->growth_step, std::memory_order_relaxed);
+            }
+            m_adaptive_growth.store(m_config->adaptive_growth && !m_config->read_only &&
+                                    m_config->growth_step > 0, std::memory_order_relaxed);
+            {
+                // Everything on disk at open time is durable.
+                MDBX_envinfo info;
+                check_mdbx(mdbx_env_info_ex(m_env, nullptr, &info, sizeof(info)),
+                           "Failed to read environment info");
+                m_durable_txn_id.store(info.mi_recent_txnid, std::memory_order_release);
+            }
+            const bool lazy_sync = m_config->sync_mode != SyncMode::Durable && !m_config->read_only;
+            m_lazy_sync.store(lazy_sync, std::memory_order_relaxed);
+            m_commit_poll_max_ms.store(m_config->commit_poll_max_ms > 0
+                                       ? m_config->commit_poll_max_ms : 1,
+                                       std::memory_order_relaxed);
+            writer_scheduler().configure(
+                std::chrono::milliseconds(m_config->apply_write_slice_ms),
+                std::chrono::milliseconds(m_config->apply_yield_max_ms));
+            {
+                std::lock_guard<std::mutex> lock(m_read_cache_mutex);
+                m_read_cache_size = m_config->read_txn_cache_size > 0
+                    ? static_cast<std::size_t>(m_config->read_txn_cache_size) : 0;
+                m_read_cache_max_idle = std::chrono::milliseconds(
+                    m_config->read_txn_cache_max_idle_ms > 0 ? m_config->read_txn_cache_max_idle_ms : 0);
+            }
+            // Started last, so a failure above never leaves the thread running.
+            start_sync_thread();
         } catch (...) {
             if (m_env && mdbx_env_close(m_env) == MDBX_SUCCESS) {
                 m_env = nullptr;
@@ -431,6 +1692,7 @@ namespace mdbxc {
             return;
         }
         m_transactions.clear();
+        clear_parked_read_txns();
         if (m_env) {
             int rc = mdbx_env_close(m_env);
             if (rc != MDBX_SUCCESS && use_throw) {
@@ -439,6 +1701,13 @@ namespace mdbxc {
             if (rc == MDBX_SUCCESS) {
                 m_env = nullptr;
                 m_shutdown_requested = false;
+#               if MDBXC_SYNC_ENABLED
+                if (m_sync_capture != nullptr) {
+                    m_sync_capture->env_closed();
+                }
+#               endif
+                std::lock_guard<std::mutex> lock(m_dbi_cache_mutex);
+                m_dbi_cache.clear();
             }
         }
     }
@@ -453,6 +1722,7 @@ namespace mdbxc {
             throw std::logic_error("Cannot shutdown from a thread with an open transaction handle.");
         }
         m_shutdown_requested = true;
+        clear_parked_read_txns();
         return true;
     }
     
@@ -485,6 +1755,11 @@ namespace mdbxc {
             "Failed to set max databases"
         );
 
+        // The HSR hook is always installed; it fails fast without a handler.
+        check_mdbx(mdbx_env_set_userctx(m_env, this), "Failed to set environment context");
+        check_mdbx(mdbx_env_set_hsr(m_env, &Connection::slow_reader_callback),
+                   "Failed to set slow reader handler");
+
         int readers = m_config->max_readers > 0
             ? static_cast<int>(m_config->max_readers)
             : static_cast<int>(std::thread::hardware_concurrency()) * 2;
@@ -495,10 +1770,17 @@ namespace mdbxc {
 
         MDBX_env_flags_t env_flags = MDBX_ACCEDE;
         if (m_config->no_subdir)     env_flags |= MDBX_NOSUBDIR;
-        if (m_config->sync_durable)  env_flags |= MDBX_SYNC_DURABLE;
+        switch (m_config->sync_mode) {
+        case SyncMode::SafeNoSync:    env_flags |= MDBX_SAFE_NOSYNC; break;
+        case SyncMode::UtterlyNoSync: env_flags |= MDBX_UTTERLY_NOSYNC; break;
+        case SyncMode::Durable:
+            if (m_config->sync_durable) env_flags |= MDBX_SYNC_DURABLE;
+            break;
+        }
         if (m_config->read_only)     env_flags |= MDBX_RDONLY;
         if (!m_config->readahead)    env_flags |= MDBX_NORDAHEAD;
         if (m_config->writemap_mode) env_flags |= MDBX_WRITEMAP;
+        if (m_config->no_sticky_threads) env_flags |= MDBX_NOSTICKYTHREADS;
 
         std::string pathname = m_config->pathname;
         if (m_config->relative_to_exe && 
@@ -550,6 +1832,13 @@ namespace mdbxc {
             "Failed to open environment"
         );
 #endif
+
+        if (m_config->sync_bytes > 0 && !m_config->read_only) {
+            check_mdbx(
+                mdbx_env_set_syncbytes(m_env, static_cast<std::size_t>(m_config->sync_bytes)),
+                "Failed to set sync threshold"
+            );
+        }
     }
 
 } // namespace mdbxc
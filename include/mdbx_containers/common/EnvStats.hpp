@@ -0,0 +1,53 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_ENV_STATS_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_ENV_STATS_HPP_INCLUDED
+
+/// \file EnvStats.hpp
+/// \brief Declares the snapshot returned by \c Connection::stats().
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \brief B-tree statistics of one DBI, from \c mdbx_dbi_stat().
+    struct DbiStats {
+        std::string   name;               ///< DBI name.
+        std::uint32_t depth = 0;          ///< B-tree depth.
+        std::uint64_t branch_pages = 0;   ///< Internal pages.
+        std::uint64_t leaf_pages = 0;     ///< Leaf pages.
+        std::uint64_t overflow_pages = 0; ///< Large-value pages.
+        std::uint64_t entries = 0;        ///< Key-value pairs.
+    };
+
+    /// \brief Point-in-time environment statistics.
+    /// \details Taken from \c mdbx_env_info_ex() and \c mdbx_env_stat_ex()
+    /// inside one read-only transaction. Sizes are in pages of \ref page_size
+    /// unless the name says bytes.
+    struct EnvStats {
+        std::uint32_t page_size = 0;       ///< Database page size in bytes.
+        std::uint64_t map_size_bytes = 0;  ///< Current data file size.
+        std::uint64_t map_upper_bytes = 0; ///< Configured upper size limit.
+        std::uint64_t used_pages = 0;      ///< Pages up to the last allocated one.
+        std::uint64_t tree_pages = 0;      ///< Branch, leaf and overflow pages of all DBIs.
+        std::uint64_t entries = 0;         ///< Entries of all DBIs.
+        std::uint64_t gc_pages = 0;        ///< Pages of the GC (freelist) tree.
+        std::uint64_t gc_entries = 0;      ///< Records in the GC tree.
+
+        std::uint32_t readers_max = 0;     ///< Reader slot capacity.
+        std::uint32_t readers_in_use = 0;  ///< Used reader slots, including the one of this snapshot.
+        std::uint64_t last_txn_id = 0;     ///< Last committed transaction id.
+        std::uint64_t oldest_reader_txn_id = 0; ///< Snapshot id of the oldest active reader.
+        /// \brief Committed transactions the oldest reader is behind.
+        /// \details A large, growing value means a long-lived reader is
+        /// pinning old pages and the GC cannot reuse them.
+        std::uint64_t oldest_reader_lag = 0;
+
+        /// \brief Tables opened through this connection, see \c Connection::open_dbi().
+        std::vector<DbiStats> tables;
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_ENV_STATS_HPP_INCLUDED
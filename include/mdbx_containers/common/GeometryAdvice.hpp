@@ -0,0 +1,198 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_GEOMETRY_ADVICE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_GEOMETRY_ADVICE_HPP_INCLUDED
+
+/// \file GeometryAdvice.hpp
+/// \brief Options and results of \c Connection::advise_geometry().
+/// \details
+/// The advisor samples the key and value sizes of every named DBI, compares
+/// them with the B-tree statistics MDBX keeps, and estimates the file size
+/// each candidate page size would give. A value whose leaf node does not fit
+/// in half a page moves to large (overflow) pages, whose unused tail is
+/// wasted, so the page size that keeps the common values inline is usually
+/// the smallest file. The estimate can be checked by copying the sampled
+/// records into scratch environments of each page size.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \brief Power-of-two histogram of byte sizes.
+    /// \details Bucket 0 counts empty items; bucket \c i > 0 counts sizes in
+    /// <tt>[2^(i-1), 2^i)</tt>.
+    struct SizeHistogram {
+        static const std::size_t bucket_count = 34;
+
+        std::uint64_t buckets[bucket_count] = {};
+        std::uint64_t count = 0;   ///< Items added.
+        std::uint64_t bytes = 0;   ///< Sum of their sizes.
+        std::uint64_t max = 0;     ///< Largest size added.
+
+        /// \brief Returns the bucket of \p size.
+        static std::size_t bucket_of(std::uint64_t size) noexcept {
+            std::size_t bucket = 0;
+            while (size != 0 && bucket + 1 < bucket_count) {
+                size >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        void add(std::uint64_t size) noexcept {
+            ++buckets[bucket_of(size)];
+            ++count;
+            bytes += size;
+            if (size > max) max = size;
+        }
+
+        /// \brief Returns an upper bound of the size below which \p fraction
+        /// of the items lie, e.g. 0.99 for the 99th percentile.
+        /// \details Rounded up to the bucket limit and capped at \ref max.
+        std::uint64_t percentile(double fraction) const noexcept {
+            if (count == 0) return 0;
+            const double wanted = fraction * static_cast<double>(count);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                seen += buckets[i];
+                if (static_cast<double>(seen) >= wanted) {
+                    const std::uint64_t limit = i == 0 ? 0 : (std::uint64_t(1) << i) - 1;
+                    return limit < max ? limit : max;
+                }
+            }
+            return max;
+        }
+
+        /// \brief Returns the mean size, or zero when empty.
+        double mean() const noexcept {
+            return count ? static_cast<double>(bytes) / static_cast<double>(count) : 0.0;
+        }
+    };
+
+    /// \brief Which \c HashedStoreLayout the sampled values of a DBI suit.
+    enum class ValueLayoutHint {
+        Inline, ///< Nearly all values fit a duplicate slot; \c HashedStoreLayout::SmallValues.
+        Mixed,  ///< Most values fit but a tail does not; \c HashedStoreLayout::Hybrid.
+        Large   ///< Typical values are too large for duplicates; \c HashedStoreLayout::LargeValues.
+    };
+
+    /// \brief Estimated footprint of one page size.
+    struct PageSizeEstimate {
+        std::uint32_t page_size = 0;
+        /// \brief Sampled keys exceed the key size limit of this page size.
+        bool          keys_fit = true;
+        /// \brief Estimated overflow entries, extrapolated to the whole environment.
+        std::uint64_t overflow_entries = 0;
+        /// \brief Estimated overflow pages of those entries.
+        std::uint64_t overflow_pages = 0;
+        /// \brief Estimated size of all sampled DBIs in bytes.
+        std::uint64_t estimated_bytes = 0;
+    };
+
+    /// \brief Size of the sampled records copied into a scratch environment.
+    struct PageSizeMeasurement {
+        std::uint32_t page_size = 0;
+        std::uint64_t entries = 0;          ///< Records copied.
+        std::uint64_t used_bytes = 0;       ///< Used size of the scratch environment.
+        std::uint64_t overflow_pages = 0;   ///< Overflow pages of all copied DBIs.
+        std::chrono::milliseconds elapsed{0}; ///< Time spent writing the copy.
+    };
+
+    /// \brief Sampled profile of one named DBI.
+    struct DbiProfile {
+        std::string   name;
+        std::uint32_t flags = 0;           ///< Persistent DBI flags (\c MDBX_DUPSORT, ...).
+        std::uint32_t depth = 0;           ///< B-tree depth.
+        std::uint64_t entries = 0;         ///< Entries in the DBI.
+        std::uint64_t sampled = 0;         ///< Entries read to build the histograms.
+        std::uint64_t branch_pages = 0;
+        std::uint64_t leaf_pages = 0;
+        std::uint64_t overflow_pages = 0;
+        /// \brief Sampled values that overflow at the current page size.
+        std::uint64_t sampled_overflow = 0;
+        /// \brief Fraction of leaf page space holding nodes, estimated from the sample.
+        double        leaf_fill = 0.0;
+        SizeHistogram key_sizes;
+        SizeHistogram value_sizes;
+        /// \brief Layout suggestion at the recommended page size.
+        ValueLayoutHint layout = ValueLayoutHint::Inline;
+    };
+
+    /// \brief Options of \c Connection::advise_geometry().
+    struct GeometryAdviceOptions {
+        /// \brief Entries read per DBI, from its first key; 0 reads all of them.
+        /// \details The sample is the key-order prefix of each DBI, which is
+        /// representative unless value sizes depend on the key range.
+        std::uint64_t sample_entries = 100000;
+        /// \brief Page sizes to compare; empty compares 4 KiB to 64 KiB.
+        std::vector<std::uint32_t> page_sizes;
+        /// \brief Fraction of the smallest estimate within which a smaller
+        /// page size wins, since smaller pages copy less on each update.
+        double size_tolerance = 0.02;
+        /// \brief Directory for scratch environments; empty skips measuring.
+        /// \details Each candidate page size gets a file
+        /// <tt>mdbxc_geometry_<page size>.mdbx</tt> there, removed afterwards.
+        std::string measure_dir;
+        /// \brief Sampled entries per DBI kept for the measured copies.
+        std::uint64_t measure_entries = 10000;
+    };
+
+    /// \brief Recommendations of \c Connection::advise_geometry().
+    struct GeometryAdvice {
+        std::uint32_t current_page_size = 0;
+        std::uint64_t used_bytes = 0;          ///< Used size of the environment.
+        /// \brief Page size with the smallest estimate, for \c Config::page_size.
+        std::uint32_t recommended_page_size = 0;
+        /// \brief Growth step for \c Config::growth_step: about an eighth of
+        /// the used size, a power of two between 16 MiB and 1 GiB.
+        std::int64_t  recommended_growth_step = 0;
+        /// \brief Shrink threshold for \c Config::shrink_threshold; four
+        /// growth steps, so a file does not shrink and regrow in turn.
+        std::int64_t  recommended_shrink_threshold = 0;
+        /// \brief Limit for \c Config::max_dupsort_value_size at the
+        /// recommended page size, or -1 when no DBI is \c MDBX_DUPSORT.
+        std::int64_t  recommended_max_dupsort_value_size = -1;
+        std::vector<DbiProfile>          tables;
+        std::vector<PageSizeEstimate>    estimates;    ///< One per candidate, ascending.
+        std::vector<PageSizeMeasurement> measurements; ///< Empty unless \c measure_dir is set.
+        std::vector<std::string>         notes;        ///< Human-readable findings.
+    };
+
+    namespace detail {
+
+        /// \brief Page header size of MDBX pages.
+        static const std::uint32_t geometry_page_header = 20;
+        /// \brief Node header size of MDBX leaf nodes.
+        static const std::uint32_t geometry_node_header = 8;
+
+        /// \brief Largest leaf node MDBX keeps on a page of \p page_size.
+        /// \details Mirrors MDBX's leaf node limit: half of the page space
+        /// after the header and one slot, rounded down to even, minus a slot.
+        /// A node of \c NODESIZE + key + value above it moves the value to
+        /// large pages.
+        inline std::uint32_t geometry_leaf_node_max(std::uint32_t page_size) noexcept {
+            const std::uint32_t space = page_size - geometry_page_header;
+            return (((space - 2u - geometry_node_header) / 2u) & ~1u) - 2u;
+        }
+
+        /// \brief Returns \c true if a value of \p value_size under a key of
+        /// \p key_size spills to large pages.
+        inline bool geometry_overflows(std::uint32_t page_size, std::uint64_t key_size,
+                                       std::uint64_t value_size) noexcept {
+            return geometry_node_header + key_size + value_size > geometry_leaf_node_max(page_size);
+        }
+
+        /// \brief Large pages taken by a value of \p value_size.
+        inline std::uint64_t geometry_overflow_pages(std::uint32_t page_size,
+                                                     std::uint64_t value_size) noexcept {
+            return (geometry_page_header + value_size + page_size - 1) / page_size;
+        }
+
+    } // namespace detail
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_GEOMETRY_ADVICE_HPP_INCLUDED
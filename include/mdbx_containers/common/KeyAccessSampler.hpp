@@ -0,0 +1,219 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_KEY_ACCESS_SAMPLER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_KEY_ACCESS_SAMPLER_HPP_INCLUDED
+
+/// \file KeyAccessSampler.hpp
+/// \brief Opt-in sampling of accessed keys into per-table heavy-hitter sketches.
+/// \details
+/// Like \ref TableMetrics.hpp, table hooks are compiled only when
+/// \c MDBXC_METRICS_ENABLED is non-zero. Attach a \ref KeyAccessSampler
+/// through \c Connection::attach_key_sampler(); \c KeyValueTable point reads,
+/// inserts, erases and range starts then offer their serialized keys. Without
+/// an attached sampler a table pays one atomic load per operation, and with
+/// one a thread-local countdown decides which accesses are recorded.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "TableMetrics.hpp"
+
+namespace mdbxc {
+
+    /// \brief One key reported by a \ref SpaceSavingSketch.
+    struct HotKey {
+        std::string   key;       ///< Serialized key bytes.
+        std::uint64_t count = 0; ///< Sampled accesses; overestimates by at most \c error.
+        std::uint64_t error = 0; ///< Count inherited from the key this one replaced.
+    };
+
+    /// \class SpaceSavingSketch
+    /// \brief Space-Saving heavy-hitter sketch over byte-string keys.
+    /// \details Keeps at most \c capacity counters. A key that is not tracked
+    /// while the sketch is full replaces the smallest counter and inherits its
+    /// count as \c error. Every key accessed more than <tt>total / capacity</tt>
+    /// times is guaranteed to be tracked. Replacement scans all counters, so
+    /// keep the capacity small; sampling makes misses rare anyway.
+    class SpaceSavingSketch {
+    public:
+        explicit SpaceSavingSketch(std::size_t capacity = 64)
+            : m_capacity(capacity ? capacity : 1) {}
+
+        /// \brief Counts one access of \p key.
+        void offer(const std::string& key) {
+            ++m_total;
+            std::unordered_map<std::string, std::size_t>::const_iterator it = m_index.find(key);
+            if (it != m_index.end()) {
+                ++m_counters[it->second].count;
+                return;
+            }
+            if (m_counters.size() < m_capacity) {
+                HotKey entry;
+                entry.key = key;
+                entry.count = 1;
+                m_index[key] = m_counters.size();
+                m_counters.push_back(entry);
+                return;
+            }
+            std::size_t min = 0;
+            for (std::size_t i = 1; i < m_counters.size(); ++i) {
+                if (m_counters[i].count < m_counters[min].count) min = i;
+            }
+            HotKey& entry = m_counters[min];
+            m_index.erase(entry.key);
+            entry.key = key;
+            entry.error = entry.count;
+            ++entry.count;
+            m_index[key] = min;
+        }
+
+        /// \brief Returns up to \p n tracked keys, highest count first.
+        std::vector<HotKey> top(std::size_t n) const {
+            std::vector<HotKey> out(m_counters);
+            std::sort(out.begin(), out.end(), [](const HotKey& a, const HotKey& b) {
+                return a.count != b.count ? a.count > b.count : a.key < b.key;
+            });
+            if (out.size() > n) out.resize(n);
+            return out;
+        }
+
+        /// \brief Returns the number of offered accesses.
+        std::uint64_t total() const noexcept { return m_total; }
+
+        /// \brief Returns the maximum number of tracked keys.
+        std::size_t capacity() const noexcept { return m_capacity; }
+
+    private:
+        std::size_t m_capacity;
+        std::uint64_t m_total = 0;
+        std::vector<HotKey> m_counters;
+        std::unordered_map<std::string, std::size_t> m_index;
+    };
+
+    /// \brief Sketches of one table, indexed by \ref TableOperation.
+    /// \details \c TableOperation::Range counts the start key of each range;
+    /// \c TableOperation::Commit stays empty.
+    struct TableKeySketches {
+        std::vector<SpaceSavingSketch> operations;
+
+        explicit TableKeySketches(std::size_t capacity = 64)
+            : operations(table_operation_count, SpaceSavingSketch(capacity)) {}
+
+        SpaceSavingSketch& operator[](TableOperation op) {
+            return operations[static_cast<std::size_t>(op)];
+        }
+        const SpaceSavingSketch& operator[](TableOperation op) const {
+            return operations[static_cast<std::size_t>(op)];
+        }
+    };
+
+    /// \class KeyAccessSampler
+    /// \brief Thread-safe sampler that keeps a \ref TableKeySketches per table.
+    /// \details Records about one access in \c sample_every. The gap to the
+    /// next recorded access is drawn per thread from <tt>[1, 2 * sample_every)</tt>,
+    /// so strided access patterns do not alias with the sampling period.
+    /// Multiply sketch counts by \ref sample_every() to estimate accesses.
+    /// The mutex is taken only for recorded accesses.
+    class KeyAccessSampler {
+    public:
+        /// \param sample_every Mean number of accesses per recorded one; 1 records all.
+        /// \param capacity Keys tracked per table and operation.
+        /// \throws std::invalid_argument if \p sample_every is zero.
+        explicit KeyAccessSampler(std::uint32_t sample_every = 64, std::size_t capacity = 64)
+            : m_sample_every(sample_every), m_capacity(capacity) {
+            if (sample_every == 0) {
+                throw std::invalid_argument("KeyAccessSampler sample_every must be positive");
+            }
+        }
+
+        KeyAccessSampler(const KeyAccessSampler&) = delete;
+        KeyAccessSampler& operator=(const KeyAccessSampler&) = delete;
+
+        /// \brief Offers one access of the serialized \p key of \p table.
+        /// \details Cheap unless this access is selected for recording.
+        void offer(const std::string& table, TableOperation op,
+                   const void* key, std::size_t key_size) {
+            if (!take_sample()) return;
+            const std::string bytes(static_cast<const char*>(key), key_size);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<std::string, TableKeySketches>::iterator it = m_tables.find(table);
+            if (it == m_tables.end()) {
+                it = m_tables.insert(std::make_pair(table, TableKeySketches(m_capacity))).first;
+            }
+            it->second[op].offer(bytes);
+        }
+
+        /// \brief Returns the mean number of accesses per recorded one.
+        std::uint32_t sample_every() const noexcept { return m_sample_every; }
+
+        /// \brief Returns up to \p n hottest sampled keys of \p table for \p op.
+        /// \details Unknown tables yield an empty list.
+        std::vector<HotKey> top(const std::string& table, TableOperation op, std::size_t n = 10) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<std::string, TableKeySketches>::const_iterator it = m_tables.find(table);
+            return it != m_tables.end() ? it->second[op].top(n) : std::vector<HotKey>();
+        }
+
+        /// \brief Returns a copy of the sketches of \p table.
+        TableKeySketches sketches(const std::string& table) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<std::string, TableKeySketches>::const_iterator it = m_tables.find(table);
+            return it != m_tables.end() ? it->second : TableKeySketches(m_capacity);
+        }
+
+        /// \brief Returns the names of all tables with recorded accesses.
+        std::vector<std::string> tables() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::vector<std::string> names;
+            names.reserve(m_tables.size());
+            for (std::map<std::string, TableKeySketches>::const_iterator it = m_tables.begin();
+                 it != m_tables.end(); ++it) {
+                names.push_back(it->first);
+            }
+            return names;
+        }
+
+        /// \brief Forgets all recorded accesses.
+        void reset() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tables.clear();
+        }
+
+    private:
+        bool take_sample() noexcept {
+            if (m_sample_every == 1) return true;
+            static thread_local std::uint32_t countdown = 0;
+            static thread_local std::uint32_t state = 0;
+            if (countdown > 1) {
+                --countdown;
+                return false;
+            }
+            if (state == 0) {
+                state = static_cast<std::uint32_t>(
+                    reinterpret_cast<std::uintptr_t>(&countdown)) | 1u;
+            }
+            // xorshift32
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            const std::uint64_t span = 2ull * m_sample_every - 1;
+            countdown = 1 + static_cast<std::uint32_t>(state % span);
+            return true;
+        }
+
+        const std::uint32_t m_sample_every;
+        const std::size_t m_capacity;
+        mutable std::mutex m_mutex;
+        std::map<std::string, TableKeySketches> m_tables;
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_KEY_ACCESS_SAMPLER_HPP_INCLUDED
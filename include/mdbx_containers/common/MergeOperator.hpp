@@ -0,0 +1,263 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_MERGE_OPERATOR_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_MERGE_OPERATOR_HPP_INCLUDED
+
+/// \file MergeOperator.hpp
+/// \brief Built-in merge operators applied to stored value bytes.
+/// \details
+/// A merge combines an operand with the stored value without decoding it
+/// into the C++ value type, so \c KeyValueTable::merge() and the sync apply
+/// path run the same byte-level code. The operator descriptor travels with
+/// each replicated operand; replicas need no registration.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \brief Kind of a built-in merge operator.
+    enum class MergeKind : std::uint8_t {
+        AddInteger = 0, ///< Wrapping integer addition; an absent value counts as zero.
+        Max        = 1, ///< Larger of the stored value and the operand.
+        Min        = 2, ///< Smaller of the stored value and the operand.
+        Append     = 3, ///< Operand elements appended after the stored ones.
+        SetUnion   = 4, ///< Sorted union of distinct elements.
+    };
+
+    /// \struct MergeOperator
+    /// \brief Merge kind plus the integer element layout it works on.
+    /// \details \c AddInteger, \c Max and \c Min take one element; \c Append
+    /// and \c SetUnion take a packed array of elements. Elements are integers
+    /// of \c element_size bytes in host byte order, as serialized by the
+    /// tables. Every kind except \c Append gives the same result whatever
+    /// order concurrent operands are applied in.
+    struct MergeOperator {
+        MergeKind     kind = MergeKind::AddInteger;
+        std::uint8_t  element_size = 0; ///< 1, 2, 4 or 8.
+        bool          is_signed = false;
+
+        /// \brief Bytes of the encoded descriptor that prefixes replicated operands.
+        static const std::size_t encoded_size = 3;
+
+        /// \brief Checks the kind and element size.
+        bool valid() const noexcept {
+            return static_cast<std::uint8_t>(kind) <= static_cast<std::uint8_t>(MergeKind::SetUnion) &&
+                   (element_size == 1 || element_size == 2 ||
+                    element_size == 4 || element_size == 8);
+        }
+
+        /// \brief Writes the descriptor to \p out, which holds \ref encoded_size bytes.
+        void encode(std::uint8_t* out) const noexcept {
+            out[0] = static_cast<std::uint8_t>(kind);
+            out[1] = element_size;
+            out[2] = is_signed ? 1 : 0;
+        }
+
+        /// \brief Reads a descriptor written by \ref encode().
+        /// \return \c false if \p size is too small or the descriptor is invalid.
+        static bool decode(const std::uint8_t* data, std::size_t size, MergeOperator& out) noexcept {
+            if (size < encoded_size || data[2] > 1) return false;
+            out.kind = static_cast<MergeKind>(data[0]);
+            out.element_size = data[1];
+            out.is_signed = data[2] != 0;
+            return out.valid();
+        }
+
+        /// \brief Computes the merged value bytes.
+        /// \param existing Stored value bytes; ignored when \p exists is \c false.
+        /// \param existing_size Size of \p existing.
+        /// \param exists Whether a value is stored.
+        /// \param operand Operand bytes.
+        /// \param operand_size Size of \p operand.
+        /// \param out Receives the new value bytes.
+        /// \throws std::invalid_argument if a size does not fit the element layout.
+        void apply(const void* existing, std::size_t existing_size, bool exists,
+                   const void* operand, std::size_t operand_size,
+                   std::vector<std::uint8_t>& out) const {
+            if (!valid()) {
+                throw std::invalid_argument("Invalid merge operator");
+            }
+            const std::uint8_t* stored = static_cast<const std::uint8_t*>(existing);
+            const std::uint8_t* arg = static_cast<const std::uint8_t*>(operand);
+            if (!exists) existing_size = 0;
+            switch (kind) {
+                case MergeKind::AddInteger:
+                case MergeKind::Max:
+                case MergeKind::Min: {
+                    if (operand_size != element_size || (exists && existing_size != element_size)) {
+                        throw std::invalid_argument("Merge operand or stored value is not one integer");
+                    }
+                    out.assign(arg, arg + element_size);
+                    if (!exists) return;
+                    if (kind == MergeKind::AddInteger) {
+                        // Unsigned addition wraps the same way for both signednesses.
+                        store_bits(load_bits(stored) + load_bits(arg), &out[0]);
+                        return;
+                    }
+                    const bool stored_less = less(stored, arg);
+                    const bool keep_stored = kind == MergeKind::Max ? !stored_less : stored_less;
+                    if (keep_stored) out.assign(stored, stored + element_size);
+                    return;
+                }
+                case MergeKind::Append: {
+                    check_array(existing_size, operand_size);
+                    out.resize(existing_size + operand_size);
+                    if (existing_size) std::memcpy(&out[0], stored, existing_size);
+                    if (operand_size) std::memcpy(&out[existing_size], arg, operand_size);
+                    return;
+                }
+                case MergeKind::SetUnion: {
+                    check_array(existing_size, operand_size);
+                    std::vector<const std::uint8_t*> items;
+                    items.reserve((existing_size + operand_size) / element_size);
+                    for (std::size_t i = 0; i < existing_size; i += element_size) items.push_back(stored + i);
+                    for (std::size_t i = 0; i < operand_size; i += element_size) items.push_back(arg + i);
+                    const MergeOperator& self = *this;
+                    std::sort(items.begin(), items.end(),
+                              [&self](const std::uint8_t* a, const std::uint8_t* b) {
+                        return self.less(a, b);
+                    });
+                    out.clear();
+                    out.reserve(items.size() * element_size);
+                    const std::uint8_t* prev = nullptr;
+                    for (std::size_t i = 0; i < items.size(); ++i) {
+                        if (prev && std::memcmp(prev, items[i], element_size) == 0) continue;
+                        out.insert(out.end(), items[i], items[i] + element_size);
+                        prev = items[i];
+                    }
+                    return;
+                }
+            }
+        }
+
+    private:
+        std::uint64_t load_bits(const std::uint8_t* p) const noexcept {
+            switch (element_size) {
+                case 1: { std::uint8_t v; std::memcpy(&v, p, 1); return v; }
+                case 2: { std::uint16_t v; std::memcpy(&v, p, 2); return v; }
+                case 4: { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+                default: { std::uint64_t v; std::memcpy(&v, p, 8); return v; }
+            }
+        }
+
+        void store_bits(std::uint64_t bits, std::uint8_t* p) const noexcept {
+            switch (element_size) {
+                case 1: { const std::uint8_t v = static_cast<std::uint8_t>(bits); std::memcpy(p, &v, 1); return; }
+                case 2: { const std::uint16_t v = static_cast<std::uint16_t>(bits); std::memcpy(p, &v, 2); return; }
+                case 4: { const std::uint32_t v = static_cast<std::uint32_t>(bits); std::memcpy(p, &v, 4); return; }
+                default: std::memcpy(p, &bits, 8); return;
+            }
+        }
+
+        /// \brief Numeric order of two elements.
+        bool less(const std::uint8_t* a, const std::uint8_t* b) const noexcept {
+            std::uint64_t x = load_bits(a);
+            std::uint64_t y = load_bits(b);
+            if (is_signed) {
+                // Flipping the sign bit maps signed order onto unsigned order.
+                const std::uint64_t sign = std::uint64_t(1) << (element_size * 8 - 1);
+                x ^= sign;
+                y ^= sign;
+            }
+            return x < y;
+        }
+
+        void check_array(std::size_t existing_size, std::size_t operand_size) const {
+            if (existing_size % element_size != 0 || operand_size % element_size != 0) {
+                throw std::invalid_argument("Merge operand or stored value is not an element array");
+            }
+        }
+    };
+
+namespace detail {
+
+    template<class T>
+    struct is_merge_integer {
+        static const bool value = std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                  (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+    };
+
+    /// \brief Element layout of a value type accepted by merge operators.
+    /// \details \c scalar types take \c AddInteger, \c Max and \c Min;
+    /// \c sequence types take \c Append and \c SetUnion; \c set types take
+    /// \c SetUnion only; strings take \c Append only.
+    template<class T, class Enable = void>
+    struct merge_value_traits {
+        static const bool supported = false;
+    };
+
+    template<class T>
+    struct merge_value_traits<T, typename std::enable_if<is_merge_integer<T>::value>::type> {
+        static const bool supported = true;
+        typedef T element_type;
+        static bool accepts(MergeKind kind) {
+            return kind == MergeKind::AddInteger || kind == MergeKind::Max || kind == MergeKind::Min;
+        }
+    };
+
+    template<class E>
+    struct merge_sequence_traits {
+        static const bool supported = is_merge_integer<E>::value;
+        typedef E element_type;
+        static bool accepts(MergeKind kind) {
+            return kind == MergeKind::Append || kind == MergeKind::SetUnion;
+        }
+    };
+
+    template<class E>
+    struct merge_value_traits<std::vector<E>, void> : merge_sequence_traits<E> {};
+
+    template<class E>
+    struct merge_value_traits<std::deque<E>, void> : merge_sequence_traits<E> {};
+
+    template<class E>
+    struct merge_value_traits<std::list<E>, void> : merge_sequence_traits<E> {};
+
+    template<class E>
+    struct merge_value_traits<std::set<E>, void> {
+        static const bool supported = is_merge_integer<E>::value;
+        typedef E element_type;
+        static bool accepts(MergeKind kind) { return kind == MergeKind::SetUnion; }
+    };
+
+    template<>
+    struct merge_value_traits<std::string, void> {
+        static const bool supported = true;
+        typedef unsigned char element_type;
+        static bool accepts(MergeKind kind) { return kind == MergeKind::Append; }
+    };
+
+} // namespace detail
+
+    /// \brief Builds the merge operator \p kind for values of type \p ValueT.
+    /// \tparam ValueT An integer, a \c std::vector, \c std::deque, \c std::list
+    ///         or \c std::set of integers, or \c std::string.
+    /// \throws std::invalid_argument if \p kind does not fit \p ValueT.
+    template<class ValueT>
+    MergeOperator make_merge_operator(MergeKind kind) {
+        typedef detail::merge_value_traits<ValueT> traits;
+        static_assert(traits::supported,
+                      "Merge operators need an integer value or a container of integers");
+        if (!traits::accepts(kind)) {
+            throw std::invalid_argument("Merge kind does not fit the value type");
+        }
+        typedef typename traits::element_type element_type;
+        MergeOperator op;
+        op.kind = kind;
+        op.element_size = static_cast<std::uint8_t>(sizeof(element_type));
+        op.is_signed = std::is_signed<element_type>::value;
+        return op;
+    }
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_MERGE_OPERATOR_HPP_INCLUDED
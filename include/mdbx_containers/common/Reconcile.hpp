@@ -0,0 +1,46 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_RECONCILE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_RECONCILE_HPP_INCLUDED
+
+/// \file Reconcile.hpp
+/// \brief Progress counters and resume state for chunked sorted reconcile.
+/// \details
+/// Tables that expose \c reconcile_sorted() merge a sorted input stream with
+/// the table in key order and commit a write transaction every few changes.
+/// Between chunks only the last processed key is kept, so neither the input
+/// nor the table contents are materialized in memory.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \brief Counters reported by \c reconcile_sorted() after every committed chunk.
+    struct ReconcileProgress {
+        std::size_t scanned = 0;  ///< Input records consumed so far.
+        std::size_t inserted = 0; ///< Records written for keys missing from the table.
+        std::size_t updated = 0;  ///< Records rewritten because the stored value differed.
+        std::size_t erased = 0;   ///< Table records removed because the input lacks their key.
+        std::size_t chunks = 0;   ///< Committed write transactions.
+    };
+
+namespace detail {
+
+    /// \brief Merge position carried between \c reconcile_sorted() chunks.
+    struct SortedReconcileState {
+        std::vector<std::uint8_t> resume;     ///< Serialized key of the last processed table position.
+        std::vector<std::uint8_t> last_input; ///< Serialized key of the last consumed input record.
+        bool has_resume = false;
+        bool has_last_input = false;
+    };
+
+    /// \brief Progress callback that ignores every report.
+    struct NoReconcileProgress {
+        void operator()(const ReconcileProgress&) const {}
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_RECONCILE_HPP_INCLUDED
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_RETENTION_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_RETENTION_HPP_INCLUDED
+
+/// \file Retention.hpp
+/// \brief Counters reported by chunked prefix truncation.
+/// \details
+/// Retention drops a whole key prefix in bounded write transactions. The
+/// freed pages go to the MDBX garbage collector and are reused by later
+/// writes; the datafile itself shrinks only when trailing pages are free and
+/// exceed \ref Config::shrink_threshold.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mdbxc {
+
+    /// \brief Result of \c SequenceTable::truncate_before().
+    struct RetentionStats {
+        std::size_t   removed = 0;          ///< Records erased.
+        std::size_t   chunks = 0;           ///< Committed write transactions.
+        std::uint64_t table_pages_before = 0; ///< Branch, leaf and large pages of the table before truncation.
+        std::uint64_t table_pages_after = 0;  ///< Branch, leaf and large pages of the table after truncation.
+        std::uint64_t file_bytes_before = 0;  ///< Datafile size before truncation.
+        std::uint64_t file_bytes_after = 0;   ///< Datafile size after truncation.
+
+        /// \brief Returns the number of table pages released to the garbage collector.
+        std::uint64_t reclaimed_pages() const {
+            return table_pages_before > table_pages_after
+                ? table_pages_before - table_pages_after : 0;
+        }
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_RETENTION_HPP_INCLUDED
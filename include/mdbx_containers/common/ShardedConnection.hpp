@@ -0,0 +1,122 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_SHARDED_CONNECTION_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_SHARDED_CONNECTION_HPP_INCLUDED
+
+/// \file ShardedConnection.hpp
+/// \brief Fixed set of independent environments used as write shards.
+/// \details
+/// MDBX admits one write transaction per environment. Splitting data over
+/// several environments, each in its own file, lets writers to different
+/// shards commit in parallel. Routing of keys to shards is done by
+/// \ref ShardedKeyValueTable.
+
+#include "Connection.hpp"
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \class ShardedConnection
+    /// \ingroup mdbxc_core
+    /// \brief Owns one \ref Connection per shard.
+    /// \details Shard \c i lives in the file returned by \ref shard_pathname()
+    /// for the base path. Every shard uses the base configuration otherwise.
+    /// \warning Keys are routed by <tt>hash % shard_count()</tt>, so the shard
+    ///          count of an existing data set must not change.
+    /// \note Transactions never span shards: a multi-key write that touches
+    ///       several shards commits once per shard and is not atomic as a whole.
+    /// \thread_safety Thread-safe; every shard is an ordinary \ref Connection.
+    class ShardedConnection {
+    public:
+        /// \brief Opens \p shards environments derived from \p config.
+        /// \param config Base configuration; \c pathname names the data set.
+        /// \param shards Number of shards, at least one.
+        /// \return Shared pointer to the new sharded connection.
+        /// \throws std::invalid_argument if \p shards is zero.
+        /// \throws MdbxException if a shard cannot be opened.
+        static std::shared_ptr<ShardedConnection> create(const Config& config, std::size_t shards) {
+            return std::shared_ptr<ShardedConnection>(new ShardedConnection(config, shards));
+        }
+
+        /// \brief Returns the path of shard \p index for the base path \p pathname.
+        /// \details Inserts \c -shardN before a trailing \c .mdbx extension, or
+        /// appends it when there is none: \c data/kv.mdbx becomes
+        /// \c data/kv-shard0.mdbx.
+        static std::string shard_pathname(const std::string& pathname, std::size_t index) {
+            static const std::string ext = ".mdbx";
+            const std::string suffix = "-shard" + std::to_string(index);
+            if (pathname.size() > ext.size() &&
+                pathname.compare(pathname.size() - ext.size(), ext.size(), ext) == 0) {
+                return pathname.substr(0, pathname.size() - ext.size()) + suffix + ext;
+            }
+            return pathname + suffix;
+        }
+
+        /// \brief Returns the number of shards.
+        std::size_t shard_count() const noexcept { return m_shards.size(); }
+
+        /// \brief Returns the connection of shard \p index.
+        /// \throws std::out_of_range if \p index is not below \ref shard_count().
+        const std::shared_ptr<Connection>& shard(std::size_t index) const {
+            return m_shards.at(index);
+        }
+
+        /// \brief Runs \p fn for every shard index, shards in parallel.
+        /// \details Shard 0 runs on the calling thread and the others on
+        /// \c std::async threads, so \p fn must not rely on a transaction bound
+        /// to the caller. Waits for all shards before returning.
+        /// \param fn Invoked as <tt>fn(std::size_t index)</tt>.
+        /// \throws Rethrows the exception of the lowest failing shard.
+        template<typename FnT>
+        void for_each_shard(FnT fn) const {
+            std::vector<std::future<void>> futures;
+            futures.reserve(m_shards.size());
+            for (std::size_t i = 1; i < m_shards.size(); ++i) {
+                futures.push_back(std::async(std::launch::async, [&fn, i]() { fn(i); }));
+            }
+            std::exception_ptr error;
+            try {
+                fn(0);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            for (std::size_t i = 0; i < futures.size(); ++i) {
+                try {
+                    futures[i].get();
+                } catch (...) {
+                    if (!error) error = std::current_exception();
+                }
+            }
+            if (error) std::rethrow_exception(error);
+        }
+
+        /// \brief Syncs every shard to disk, see \c Connection::sync_to_disk().
+        void sync_to_disk(bool force = true) {
+            for (std::size_t i = 0; i < m_shards.size(); ++i) {
+                m_shards[i]->sync_to_disk(force);
+            }
+        }
+
+    private:
+        ShardedConnection(const Config& config, std::size_t shards) {
+            if (shards == 0) {
+                throw std::invalid_argument("ShardedConnection: shard count must be positive");
+            }
+            m_shards.reserve(shards);
+            for (std::size_t i = 0; i < shards; ++i) {
+                Config shard_config = config;
+                shard_config.pathname = shard_pathname(config.pathname, i);
+                m_shards.push_back(Connection::create(shard_config));
+            }
+        }
+
+        std::vector<std::shared_ptr<Connection>> m_shards;
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_SHARDED_CONNECTION_HPP_INCLUDED
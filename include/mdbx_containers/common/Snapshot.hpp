@@ -0,0 +1,122 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_SNAPSHOT_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_SNAPSHOT_HPP_INCLUDED
+
+/// \file Snapshot.hpp
+/// \brief Declares Snapshot, a shared read view for consistent multi-table reads.
+
+#include "Transaction.hpp"
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+namespace mdbxc {
+
+    class Connection;
+
+    /// \class Snapshot
+    /// \ingroup mdbxc_core
+    /// \brief Pins one MVCC read view shared by all of its copies.
+    ///
+    /// Created by \ref Connection::snapshot(). A snapshot converts to
+    /// <tt>const Transaction&</tt>, so it can be passed to every table read
+    /// overload that accepts a transaction wrapper. All copies share one
+    /// read-only transaction and therefore one reader slot. The transaction is
+    /// also bound to the creating thread, so table calls without an explicit
+    /// transaction read from the snapshot too.
+    ///
+    /// With a non-zero \c max_age, the first access after the view is older
+    /// than \c max_age renews it in place (\c mdbx_txn_reset + \c mdbx_txn_renew)
+    /// and all copies move to the newest committed data. Renewal never happens
+    /// during a table call, but views and references obtained from the previous
+    /// read view become invalid.
+    ///
+    /// A snapshot made by \ref Connection::detached_snapshot() is not bound to
+    /// any thread: table calls must receive it explicitly, and it may move to
+    /// another thread between calls, e.g. when a task of a work-stealing
+    /// executor resumes elsewhere in the middle of a scan.
+    ///
+    /// \thread_safety Not thread-safe. A snapshot and its copies belong to the
+    /// thread that created them, like the underlying \ref Transaction. A
+    /// detached snapshot belongs to whichever thread uses it; hand it over
+    /// with the synchronization of the executor, and never use its copies
+    /// from two threads at once.
+    class Snapshot {
+        friend class Connection;
+    public:
+        typedef std::chrono::steady_clock clock;
+
+        /// \brief Constructs an empty snapshot that holds no read view.
+        Snapshot() = default;
+
+        /// \brief Checks whether the snapshot holds a read view.
+        bool valid() const noexcept { return static_cast<bool>(m_state); }
+
+        /// \brief Returns the read transaction, renewing it first if it is too old.
+        /// \throws std::logic_error if the snapshot is empty.
+        /// \throws MdbxException if renewal fails.
+        const Transaction& transaction() const {
+            State& state = checked_state();
+            if (state.max_age != clock::duration::zero() &&
+                clock::now() - state.started >= state.max_age) {
+                renew_state(state);
+            }
+            return state.txn;
+        }
+
+        /// \brief Converts to the read transaction for table read APIs.
+        operator const Transaction&() const { return transaction(); }
+
+        /// \brief Returns the MDBX handle of the read transaction.
+        MDBX_txn* handle() const { return transaction().handle(); }
+
+        /// \brief Returns the MDBX id of the pinned read view.
+        std::uint64_t txn_id() const { return mdbx_txn_id(handle()); }
+
+        /// \brief Moves the snapshot and all its copies to the newest committed data.
+        /// \throws std::logic_error if the snapshot is empty.
+        /// \throws MdbxException if renewal fails.
+        void renew() { renew_state(checked_state()); }
+
+        /// \brief Returns the time since the read view was pinned or renewed.
+        clock::duration age() const { return clock::now() - checked_state().started; }
+
+        /// \brief Returns the configured maximum age; zero disables auto-renewal.
+        clock::duration max_age() const { return checked_state().max_age; }
+
+        /// \brief Checks whether the view is detached from the creating thread.
+        bool detached() const { return checked_state().detached; }
+
+    private:
+        struct State {
+            Transaction       txn;
+            clock::time_point started;
+            clock::duration   max_age;
+            bool              detached;
+
+            State(Transaction&& t, clock::duration age, bool is_detached = false)
+                : txn(std::move(t)), started(clock::now()), max_age(age),
+                  detached(is_detached) {}
+        };
+
+        explicit Snapshot(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+
+        State& checked_state() const {
+            if (!m_state) {
+                throw std::logic_error("Snapshot is empty.");
+            }
+            return *m_state;
+        }
+
+        static void renew_state(State& state) {
+            state.txn.commit();
+            state.txn.begin();
+            state.started = clock::now();
+        }
+
+        std::shared_ptr<State> m_state;
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_SNAPSHOT_HPP_INCLUDED
@@ -0,0 +1,214 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_STATUS_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_STATUS_HPP_INCLUDED
+
+/// \file Status.hpp
+/// \brief Compact outcome of the \c std::nothrow_t overloads of hot table
+///        and sync calls.
+/// \details
+/// The \c std::nothrow_t overloads return expected failures such as an
+/// existing or missing key as a status code instead of a \c bool, and an
+/// MDBX error from the transaction or the write as a status without
+/// unwinding. Other exceptions, e.g. from serialization, are caught at the
+/// call boundary. A \ref Status is a code, an MDBX error code, a static
+/// context string and, for a caught exception, an \c std::exception_ptr;
+/// its text is formatted only by \ref Status::message(). The throwing
+/// overloads wrap the same Status-returning code and turn a failure into an
+/// exception with \ref check_status().
+
+#include <exception>
+#include <new>
+#include <string>
+#include <utility>
+
+#include <mdbx.h>
+
+#include "MdbxException.hpp"
+
+namespace mdbxc {
+
+    /// \enum StatusCode
+    /// \brief Outcome class of a \ref Status.
+    enum class StatusCode {
+        Ok,         ///< The call succeeded.
+        KeyExists,  ///< Insert-if-absent found the key.
+        NotFound,   ///< The key is absent.
+        Busy,       ///< MDBX reported \c MDBX_BUSY.
+        Conflict,   ///< A sync apply conflict; the context names the reason.
+        Rejected,   ///< A sync request refused before apply; the context names why.
+        MdbxError,  ///< Another MDBX error; see \ref Status::mdbx_error().
+        Error       ///< Any other exception; see \ref Status::message().
+    };
+
+    /// \brief Returns a stable diagnostic name for \p code.
+    inline const char* status_code_name(StatusCode code) noexcept {
+        switch (code) {
+            case StatusCode::Ok:        return "ok";
+            case StatusCode::KeyExists: return "key exists";
+            case StatusCode::NotFound:  return "not found";
+            case StatusCode::Busy:      return "busy";
+            case StatusCode::Conflict:  return "conflict";
+            case StatusCode::Rejected:  return "rejected";
+            case StatusCode::MdbxError: return "mdbx error";
+            case StatusCode::Error:     return "error";
+        }
+        return "unknown";
+    }
+
+    /// \class Status
+    /// \ingroup mdbxc_core
+    /// \brief Outcome of a non-throwing call; builds no string until asked.
+    class Status {
+    public:
+        /// \brief Constructs a successful status.
+        Status() noexcept = default;
+
+        /// \brief Constructs a status with a static \p context, e.g. a reason name.
+        /// \param context String literal or other storage that outlives the status.
+        explicit Status(StatusCode code, const char* context = nullptr, int mdbx_error = 0) noexcept
+            : m_code(code), m_mdbx_error(mdbx_error), m_context(context) {}
+
+        /// \brief Classifies an MDBX return code.
+        static Status from_mdbx(int rc, const char* context = nullptr) noexcept {
+            switch (rc) {
+                case MDBX_SUCCESS:  return Status();
+                case MDBX_KEYEXIST: return Status(StatusCode::KeyExists, context, rc);
+                case MDBX_NOTFOUND: return Status(StatusCode::NotFound, context, rc);
+                case MDBX_BUSY:     return Status(StatusCode::Busy, context, rc);
+                default:            return Status(StatusCode::MdbxError, context, rc);
+            }
+        }
+
+        /// \brief Classifies the exception being handled; call only inside a \c catch block.
+        static Status from_current_exception() noexcept {
+            return from_exception(std::current_exception());
+        }
+
+        /// \brief Classifies \p e and keeps it for \ref message() and \ref check_status().
+        static Status from_exception(std::exception_ptr e) noexcept {
+            Status out;
+            try {
+                std::rethrow_exception(e);
+            } catch (const MdbxException& ex) {
+                out = from_mdbx(ex.error_code());
+                if (out.ok()) {
+                    out.m_code = StatusCode::MdbxError;
+                }
+            } catch (const std::bad_alloc&) {
+                out = Status(StatusCode::Error, "out of memory", MDBX_ENOMEM);
+            } catch (...) {
+                out.m_code = StatusCode::Error;
+            }
+            out.m_exception = std::move(e);
+            return out;
+        }
+
+        /// \brief Whether the call succeeded.
+        bool ok() const noexcept { return m_code == StatusCode::Ok; }
+
+        /// \brief Whether the call failed; \c KeyExists and \c NotFound are
+        ///        outcomes of a completed call, not failures.
+        bool failed() const noexcept {
+            return m_code != StatusCode::Ok &&
+                   m_code != StatusCode::KeyExists &&
+                   m_code != StatusCode::NotFound;
+        }
+
+        /// \brief Same as \ref ok().
+        explicit operator bool() const noexcept { return ok(); }
+
+        /// \brief Returns the outcome class.
+        StatusCode code() const noexcept { return m_code; }
+
+        /// \brief Returns the MDBX error code, or 0 when there is none.
+        int mdbx_error() const noexcept { return m_mdbx_error; }
+
+        /// \brief Returns the static context, or \c nullptr.
+        const char* context() const noexcept { return m_context; }
+
+        /// \brief Returns the caught exception, or null when none was thrown.
+        const std::exception_ptr& exception() const noexcept { return m_exception; }
+
+        /// \brief Formats a diagnostic; the only member that allocates.
+        std::string message() const {
+            if (m_exception) {
+                try {
+                    std::rethrow_exception(m_exception);
+                } catch (const std::exception& e) {
+                    return e.what();
+                } catch (...) {
+                    return "unknown exception";
+                }
+            }
+            std::string out = status_code_name(m_code);
+            if (m_context) {
+                out += ": ";
+                out += m_context;
+            }
+            if (m_mdbx_error != 0 && m_code == StatusCode::MdbxError) {
+                out += " (";
+                out += mdbx_strerror(m_mdbx_error);
+                out += ")";
+            }
+            return out;
+        }
+
+    private:
+        StatusCode         m_code = StatusCode::Ok;
+        int                m_mdbx_error = 0;
+        const char*        m_context = nullptr;
+        std::exception_ptr m_exception;
+    };
+
+    /// \brief Throws what the throwing overload of the call would have thrown.
+    /// \details Rethrows a caught exception, raises an \ref MdbxException
+    /// worded like \c check_mdbx() for an MDBX error code, and otherwise an
+    /// \ref MdbxException with the context. Does nothing for an ok status.
+    inline void check_status(const Status& status) {
+        if (status.ok()) return;
+        if (status.exception()) {
+            std::rethrow_exception(status.exception());
+        }
+        const std::string context = status.context()
+            ? status.context()
+            : status_code_name(status.code());
+        const int rc = status.mdbx_error();
+        if (rc == 0) {
+            throw MdbxException(context);
+        }
+        throw MdbxException(context + ": (" + std::to_string(rc) + ") " +
+                            std::string(mdbx_strerror(rc)), rc);
+    }
+
+    /// \class Result
+    /// \ingroup mdbxc_core
+    /// \brief A value, or the \ref Status explaining why there is none.
+    /// \tparam T Value type; must be default-constructible.
+    template <class T>
+    class Result {
+    public:
+        /// \brief Constructs a successful result holding \p value.
+        Result(T value) : m_value(std::move(value)) {}
+
+        /// \brief Constructs a failed result; \p status must not be ok.
+        Result(Status status) : m_status(std::move(status)) {}
+
+        bool ok() const noexcept { return m_status.ok(); }
+        explicit operator bool() const noexcept { return ok(); }
+
+        /// \brief Returns the outcome; ok when a value is held.
+        const Status& status() const noexcept { return m_status; }
+
+        /// \brief Returns the value; default-constructed when \ref ok() is \c false.
+        const T& value() const& noexcept { return m_value; }
+        T& value() & noexcept { return m_value; }
+        T&& value() && noexcept { return std::move(m_value); }
+
+    private:
+        Status m_status;
+        T      m_value{};
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_STATUS_HPP_INCLUDED
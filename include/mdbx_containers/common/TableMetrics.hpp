@@ -0,0 +1,290 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_TABLE_METRICS_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_TABLE_METRICS_HPP_INCLUDED
+
+/// \file TableMetrics.hpp
+/// \brief Opt-in per-table operation metrics and latency histograms.
+/// \details
+/// Table instrumentation is compiled only when \c MDBXC_METRICS_ENABLED is
+/// non-zero. Otherwise tables and transactions contain no timing code, and
+/// the types below are plain utilities. With metrics enabled, attach an
+/// \ref ITableObserver through \c Connection::attach_table_observer(). Tables
+/// read the clock only while an observer is attached.
+
+#ifndef MDBXC_METRICS_ENABLED
+#define MDBXC_METRICS_ENABLED 0
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "CommitLatency.hpp"
+
+namespace mdbxc {
+
+    /// \enum TableOperation
+    /// \brief Operation classes reported to \ref ITableObserver.
+    enum class TableOperation {
+        Find,   ///< Point lookup (\c find, \c at, \c contains, views).
+        Insert, ///< Single-record insert or assignment.
+        Erase,  ///< Single-record erase.
+        Range,  ///< Bounded range read.
+        Commit  ///< Write transaction commit; reported with an empty table name.
+    };
+
+    /// \brief Number of \ref TableOperation values.
+    static const std::size_t table_operation_count = 5;
+
+    /// \class LatencyHistogram
+    /// \brief Log-linear latency histogram in the style of HdrHistogram.
+    /// \details Values are nanoseconds. Each power of two is split into 16
+    /// linear sub-buckets, so a reported percentile is at most 1/16 (6.25%)
+    /// above the recorded value. Values below 16 ns are exact.
+    class LatencyHistogram {
+    public:
+        static const unsigned sub_bucket_bits = 4;
+        static const std::size_t sub_bucket_count = std::size_t(1) << sub_bucket_bits;
+        static const std::size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+        LatencyHistogram() : m_counts(bucket_count, 0) {}
+
+        /// \brief Records one value.
+        void record(std::uint64_t value_ns) {
+            ++m_counts[bucket_index(value_ns)];
+            ++m_total;
+            if (value_ns > m_max) m_max = value_ns;
+            if (m_total == 1 || value_ns < m_min) m_min = value_ns;
+        }
+
+        /// \brief Records one duration; negative durations count as zero.
+        void record(std::chrono::nanoseconds value) {
+            record(value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0u);
+        }
+
+        /// \brief Adds all values recorded by \p other.
+        void merge(const LatencyHistogram& other) {
+            if (other.m_total == 0) return;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                m_counts[i] += other.m_counts[i];
+            }
+            if (m_total == 0 || other.m_min < m_min) m_min = other.m_min;
+            if (other.m_max > m_max) m_max = other.m_max;
+            m_total += other.m_total;
+        }
+
+        /// \brief Returns the number of recorded values.
+        std::uint64_t count() const noexcept { return m_total; }
+
+        /// \brief Returns the smallest recorded value, or 0 when empty.
+        std::uint64_t min() const noexcept { return m_min; }
+
+        /// \brief Returns the largest recorded value, or 0 when empty.
+        std::uint64_t max() const noexcept { return m_max; }
+
+        /// \brief Returns the value at quantile \p q in [0, 1].
+        /// \details Reports the upper bound of the bucket holding the quantile,
+        /// clamped to \ref max(). Returns 0 when empty.
+        std::uint64_t percentile(double q) const {
+            if (m_total == 0) return 0;
+            if (q <= 0.0) return m_min;
+            if (q >= 1.0) return m_max;
+            std::uint64_t target = static_cast<std::uint64_t>(q * static_cast<double>(m_total));
+            if (static_cast<double>(target) < q * static_cast<double>(m_total)) ++target;
+            if (target == 0) target = 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                seen += m_counts[i];
+                if (seen >= target) {
+                    const std::uint64_t upper = bucket_upper(i);
+                    return upper < m_max ? upper : m_max;
+                }
+            }
+            return m_max;
+        }
+
+        /// \brief Returns how many values fall into buckets ending at or below
+        /// \p value_ns.
+        /// \details Values sharing a bucket with \p value_ns are counted only
+        /// when the bucket ends at or below it, so this is a lower bound
+        /// within the bucket resolution. Used for cumulative exposition.
+        std::uint64_t count_at_or_below(std::uint64_t value_ns) const {
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                if (bucket_upper(i) > value_ns) break;
+                seen += m_counts[i];
+            }
+            return seen;
+        }
+
+        /// \brief Forgets all recorded values.
+        void reset() {
+            std::fill(m_counts.begin(), m_counts.end(), 0);
+            m_total = 0;
+            m_min = 0;
+            m_max = 0;
+        }
+
+        /// \brief Returns the bucket of \p value.
+        static std::size_t bucket_index(std::uint64_t value) noexcept {
+            if (value < sub_bucket_count) return static_cast<std::size_t>(value);
+            unsigned msb = 0;
+            for (std::uint64_t v = value; v >>= 1;) ++msb;
+            const unsigned shift = msb - sub_bucket_bits;
+            return (msb - sub_bucket_bits + 1) * sub_bucket_count +
+                   static_cast<std::size_t>((value >> shift) & (sub_bucket_count - 1));
+        }
+
+        /// \brief Returns the largest value that falls into bucket \p index.
+        static std::uint64_t bucket_upper(std::size_t index) noexcept {
+            if (index < sub_bucket_count) return index;
+            const unsigned shift = static_cast<unsigned>(index / sub_bucket_count) - 1;
+            const std::uint64_t lower =
+                (static_cast<std::uint64_t>(sub_bucket_count + index % sub_bucket_count)) << shift;
+            return lower + ((std::uint64_t(1) << shift) - 1);
+        }
+
+    private:
+        std::vector<std::uint64_t> m_counts;
+        std::uint64_t m_total = 0;
+        std::uint64_t m_min = 0;
+        std::uint64_t m_max = 0;
+    };
+
+    /// \brief Counters of one operation class.
+    struct OperationMetrics {
+        std::uint64_t    count = 0; ///< Completed operations, including failed ones.
+        std::uint64_t    bytes = 0; ///< Key and value bytes read or written.
+        LatencyHistogram latency;   ///< Wall time per operation.
+    };
+
+    /// \brief Metrics of one table, indexed by \ref TableOperation.
+    struct TableMetrics {
+        OperationMetrics operations[table_operation_count];
+
+        OperationMetrics& operator[](TableOperation op) {
+            return operations[static_cast<std::size_t>(op)];
+        }
+        const OperationMetrics& operator[](TableOperation op) const {
+            return operations[static_cast<std::size_t>(op)];
+        }
+    };
+
+    /// \brief Histograms of the MDBX commit phases of \ref CommitLatency.
+    struct CommitPhaseMetrics {
+        std::uint64_t    count = 0; ///< Reported write commits.
+        LatencyHistogram preparation;
+        LatencyHistogram gc;
+        LatencyHistogram audit;
+        LatencyHistogram write;
+        LatencyHistogram sync;
+        LatencyHistogram ending;
+        LatencyHistogram gc_cpu;
+
+        /// \brief Records the phases of one commit.
+        void record(const CommitLatency& phases) {
+            ++count;
+            preparation.record(phases.preparation);
+            gc.record(phases.gc);
+            audit.record(phases.audit);
+            write.record(phases.write);
+            sync.record(phases.sync);
+            ending.record(phases.ending);
+            gc_cpu.record(phases.gc_cpu);
+        }
+    };
+
+    /// \class ITableObserver
+    /// \brief Receives one event per instrumented table operation.
+    /// \details Called on the thread that ran the operation, after it
+    /// finished, inside any enclosing transaction. Implementations must be
+    /// thread-safe. Exceptions thrown by observers are swallowed.
+    class ITableObserver {
+    public:
+        virtual ~ITableObserver() {}
+
+        /// \brief Reports one finished operation.
+        /// \param table DBI name, or an empty string for \c TableOperation::Commit.
+        /// \param op Operation class.
+        /// \param bytes Key and value bytes read or written; 0 for range and commit.
+        /// \param latency Wall time of the operation.
+        virtual void on_table_operation(const std::string& table,
+                                        TableOperation op,
+                                        std::size_t bytes,
+                                        std::chrono::nanoseconds latency) = 0;
+
+        /// \brief Reports the MDBX phase breakdown of one write commit.
+        /// \details Called right after the \c TableOperation::Commit event of
+        /// the same commit. Default is no-op.
+        virtual void on_commit_phases(const CommitLatency& phases) {
+            (void)phases;
+        }
+    };
+
+    /// \class TableMetricsObserver
+    /// \brief Thread-safe observer that aggregates \ref TableMetrics per table.
+    class TableMetricsObserver : public ITableObserver {
+    public:
+        void on_table_operation(const std::string& table,
+                                TableOperation op,
+                                std::size_t bytes,
+                                std::chrono::nanoseconds latency) override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            OperationMetrics& metrics = m_tables[table][op];
+            ++metrics.count;
+            metrics.bytes += bytes;
+            metrics.latency.record(latency);
+        }
+
+        void on_commit_phases(const CommitLatency& phases) override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_commit_phases.record(phases);
+        }
+
+        /// \brief Returns a copy of the commit phase histograms.
+        CommitPhaseMetrics commit_phases() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_commit_phases;
+        }
+
+        /// \brief Returns a copy of the metrics of \p table.
+        /// \details Pass an empty name for write commits. Unknown tables yield
+        /// zeroed metrics.
+        TableMetrics metrics(const std::string& table) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_tables.find(table);
+            return it != m_tables.end() ? it->second : TableMetrics();
+        }
+
+        /// \brief Returns the names of all tables with recorded operations.
+        std::vector<std::string> tables() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::vector<std::string> names;
+            names.reserve(m_tables.size());
+            for (auto it = m_tables.begin(); it != m_tables.end(); ++it) {
+                names.push_back(it->first);
+            }
+            return names;
+        }
+
+        /// \brief Forgets all recorded metrics.
+        void reset() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tables.clear();
+            m_commit_phases = CommitPhaseMetrics();
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        std::map<std::string, TableMetrics> m_tables;
+        CommitPhaseMetrics m_commit_phases;
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_TABLE_METRICS_HPP_INCLUDED
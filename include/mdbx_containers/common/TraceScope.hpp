@@ -0,0 +1,153 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_TRACE_SCOPE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_TRACE_SCOPE_HPP_INCLUDED
+
+/// \file TraceScope.hpp
+/// \brief Opt-in trace scopes around library hot paths.
+/// \details
+/// Hot paths open a scope with \ref MDBXC_TRACE_SCOPE. The macro expands to
+/// nothing unless \c MDBXC_TRACE_ENABLED is non-zero, so default builds carry
+/// no tracing code at all. With tracing enabled, each scope reports a
+/// begin/end pair to the process-wide \ref ITraceSink installed through
+/// \ref set_trace_sink(); with no sink installed a scope costs one atomic
+/// load.
+///
+/// A build may also define \c MDBXC_TRACE_SCOPE(point) itself before
+/// including the library, for example to open a Tracy zone named
+/// \c trace_point_name(point) or to fire a USDT probe, bypassing the sink.
+
+#ifndef MDBXC_TRACE_ENABLED
+#define MDBXC_TRACE_ENABLED 0
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mdbxc {
+
+    /// \enum TracePoint
+    /// \brief Hot path covered by a trace scope.
+    enum class TracePoint : std::uint8_t {
+        TableFind,    ///< \c KeyValueTable point lookup.
+        TableInsert,  ///< \c KeyValueTable single-record insert or assignment.
+        TableErase,   ///< \c KeyValueTable single-record erase.
+        TableRange,   ///< \c KeyValueTable bounded range read.
+        TxnBegin,     ///< \c Transaction::begin().
+        TxnCommit,    ///< \c Transaction::commit(), including pre-commit hooks.
+        Serialize,    ///< Value serialization into an MDBX put.
+        Deserialize,  ///< Value deserialization after a point lookup.
+        CodecEncode,  ///< \c sync::ChangeBatchCodec::encode().
+        CodecDecode,  ///< \c sync::ChangeBatchCodec::decode().
+        SyncApply     ///< One batch applied by \c sync::SyncEngine.
+    };
+
+    /// \brief Number of \ref TracePoint values.
+    static const std::size_t trace_point_count = 11;
+
+    /// \brief Stable scope name, e.g. \c "mdbxc.table.find".
+    inline const char* trace_point_name(TracePoint point) {
+        switch (point) {
+        case TracePoint::TableFind:   return "mdbxc.table.find";
+        case TracePoint::TableInsert: return "mdbxc.table.insert";
+        case TracePoint::TableErase:  return "mdbxc.table.erase";
+        case TracePoint::TableRange:  return "mdbxc.table.range";
+        case TracePoint::TxnBegin:    return "mdbxc.txn.begin";
+        case TracePoint::TxnCommit:   return "mdbxc.txn.commit";
+        case TracePoint::Serialize:   return "mdbxc.value.serialize";
+        case TracePoint::Deserialize: return "mdbxc.value.deserialize";
+        case TracePoint::CodecEncode: return "mdbxc.sync.batch.encode";
+        case TracePoint::CodecDecode: return "mdbxc.sync.batch.decode";
+        case TracePoint::SyncApply:   return "mdbxc.sync.apply";
+        }
+        return "mdbxc.unknown";
+    }
+
+    /// \class ITraceSink
+    /// \brief Receives trace scopes.
+    /// \details Called on the thread running the scope; scopes on one thread
+    /// nest. Implementations must be thread-safe and cheap, since scopes
+    /// surround single-record operations. Exceptions are swallowed.
+    class ITraceSink {
+    public:
+        virtual ~ITraceSink() {}
+
+        /// \brief Opens a scope and returns a token passed to its end, such as
+        /// a cycle count or a start timestamp.
+        virtual std::uint64_t begin_trace_scope(TracePoint point) = 0;
+
+        /// \brief Closes a scope opened by \ref begin_trace_scope().
+        virtual void end_trace_scope(TracePoint point, std::uint64_t token) = 0;
+    };
+
+    namespace detail {
+        inline std::atomic<ITraceSink*>& trace_sink_slot() {
+            static std::atomic<ITraceSink*> slot(nullptr);
+            return slot;
+        }
+    } // namespace detail
+
+    /// \brief Installs \p sink process-wide; \c nullptr disables reporting.
+    /// \details The sink must outlive every scope opened while it was
+    /// installed. Has no effect on builds without \c MDBXC_TRACE_ENABLED.
+    inline void set_trace_sink(ITraceSink* sink) {
+        detail::trace_sink_slot().store(sink, std::memory_order_release);
+    }
+
+    /// \brief Returns the installed sink, or \c nullptr.
+    inline ITraceSink* trace_sink() {
+        return detail::trace_sink_slot().load(std::memory_order_acquire);
+    }
+
+    /// \class TraceScope
+    /// \brief RAII scope reported to the installed \ref ITraceSink.
+    /// \details The end is reported on scope exit, including when the traced
+    /// code throws.
+    class TraceScope {
+    public:
+        explicit TraceScope(TracePoint point) noexcept
+            : m_sink(trace_sink()), m_point(point), m_token(0) {
+            if (m_sink == nullptr) return;
+            try {
+                m_token = m_sink->begin_trace_scope(point);
+            } catch (...) {
+                m_sink = nullptr;
+            }
+        }
+
+        ~TraceScope() noexcept {
+            if (m_sink == nullptr) return;
+            try {
+                m_sink->end_trace_scope(m_point, m_token);
+            } catch (...) {
+                // Tracing must not change library behavior.
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        ITraceSink*   m_sink;
+        TracePoint    m_point;
+        std::uint64_t m_token;
+    };
+
+} // namespace mdbxc
+
+#define MDBXC_TRACE_CONCAT_IMPL(a, b) a##b
+#define MDBXC_TRACE_CONCAT(a, b) MDBXC_TRACE_CONCAT_IMPL(a, b)
+
+/// \def MDBXC_TRACE_SCOPE(point)
+/// \brief Traces the rest of the enclosing block as \c mdbxc::TracePoint::point.
+#ifndef MDBXC_TRACE_SCOPE
+#   if MDBXC_TRACE_ENABLED
+#       define MDBXC_TRACE_SCOPE(point) \
+            ::mdbxc::TraceScope MDBXC_TRACE_CONCAT(mdbxc_trace_scope_, __LINE__)( \
+                ::mdbxc::TracePoint::point)
+#   else
+#       define MDBXC_TRACE_SCOPE(point) ((void)0)
+#   endif
+#endif
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_TRACE_SCOPE_HPP_INCLUDED
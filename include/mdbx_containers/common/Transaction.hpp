@@ -5,6 +5,9 @@
 /// \file Transaction.hpp
 /// \brief Declares the Transaction class, a wrapper for managing MDBX transactions.
 
+#include "CommitLatency.hpp"
+#include "Status.hpp"
+#include "TraceScope.hpp"
 #include "TransactionTracker.hpp"
 
 namespace mdbxc {
@@ -28,9 +31,12 @@ namespace mdbxc {
     /// \thread_safety Not thread-safe. A transaction and its MDBX cursors belong
     /// to the thread that created or currently owns the guard. Do not use,
     /// commit, roll back, destroy, or move it for use by another thread.
+    /// The exception is the read transaction of a
+    /// \ref Connection::detached_snapshot(), which is not bound to a thread
+    /// and may be handed to another thread while no thread uses it.
     ///
-    /// \note mdbx-containers does not enable `MDBX_NOSTICKYTHREADS`; follow the
-    /// default MDBX transaction ownership rules.
+    /// \note `MDBX_NOSTICKYTHREADS` is enabled only by
+    /// \c Config::no_sticky_threads, and only detached snapshots rely on it.
     /// \see https://libmdbx.dqdkfa.ru/group__c__transactions.html
     class Transaction {
         friend class Connection;
@@ -54,6 +60,12 @@ namespace mdbxc {
         /// \warning The started MDBX transaction is owned by the calling thread.
         void begin();
 
+        /// \brief Starts the transaction without throwing.
+        /// \return Ok, or the MDBX error \c begin() would raise, e.g.
+        ///         \c StatusCode::Busy. The guard stays inactive on failure.
+        /// \warning The started MDBX transaction is owned by the calling thread.
+        Status begin(std::nothrow_t) noexcept;
+
         /// \brief Commits the transaction.
         ///
         /// For read-only transactions, resets the handle for reuse.
@@ -63,6 +75,12 @@ namespace mdbxc {
         /// \warning Must be called on the owning thread.
         void commit();
 
+        /// \brief Commits the transaction without throwing.
+        /// \return Ok, or the error \c commit() would raise. A failed
+        ///         \c mdbx_txn_commit() has ended the transaction, as with \c commit().
+        /// \warning Must be called on the owning thread.
+        Status commit(std::nothrow_t) noexcept;
+
         /// \brief Rolls back the transaction.
         ///
         /// For read-only transactions, resets the handle.
@@ -76,6 +94,33 @@ namespace mdbxc {
         /// \return Raw pointer to MDBX_txn, or nullptr if not active.
         /// \warning The returned handle must stay on the owning thread.
         MDBX_txn *handle() const noexcept;
+
+        /// \brief Returns the MDBX phase breakdown of the last successful
+        /// writable commit of this guard.
+        /// \details Zero before that commit and for read-only transactions.
+        /// Stays readable after \c commit() ends the transaction.
+        const CommitLatency& commit_latency() const noexcept;
+
+        /// \brief Starts a savepoint: a nested write transaction inside this one.
+        ///
+        /// The returned guard is bound to the calling thread in place of this
+        /// transaction, so table calls without an explicit transaction write
+        /// into the savepoint. \c commit() merges its changes into this
+        /// transaction and \c rollback() (or destruction) discards only them;
+        /// either way this transaction is bound again and stays active. After
+        /// \c commit() or \c rollback(), \c begin() opens a new savepoint under
+        /// the same parent, so one guard can serve a sequence of sub-batches.
+        ///
+        /// Nothing is durable until this transaction commits. While the
+        /// savepoint is active, do not use this transaction directly, and end
+        /// the savepoint before committing, rolling back, or destroying it.
+        ///
+        /// \return Active nested writable transaction.
+        /// \throws MdbxException if this is not an active writable transaction,
+        ///         or if MDBX rejects the nested transaction (\c MDBX_INCOMPATIBLE
+        ///         when the environment uses \c MDBX_WRITEMAP).
+        /// \warning Must be called on the owning thread.
+        Transaction savepoint();
         
         /// \brief Constructs a new transaction object.
         /// \param registry Transaction tracker used to associate the
@@ -104,15 +149,63 @@ namespace mdbxc {
         Transaction(const Transaction&) = delete;
         Transaction& operator=(const Transaction&) = delete;
 
+        /// \brief Constructs a read-only guard that may return its handle to the tracker.
+        /// \param registry Transaction tracker that receives the handle on release.
+        /// \param env Pointer to the MDBX environment handle.
+        /// \param parked Reset handle taken from the tracker cache, or nullptr.
+        Transaction(TransactionTracker* registry,
+                    MDBX_env* env,
+                    MDBX_txn* parked);
+
+        /// \brief Tag selecting the detached read-only constructor.
+        struct DetachedTag {};
+
+        /// \brief Constructs and begins a read-only transaction that no thread owns.
+        /// \details Never bound in the tracker, so table calls without an
+        /// explicit transaction do not see it. Requires \c MDBX_NOSTICKYTHREADS.
+        Transaction(TransactionTracker* registry,
+                    MDBX_env* env,
+                    DetachedTag);
+
+        /// \brief Tag selecting the constructor that does not begin the transaction.
+        struct DeferredTag {};
+
+        /// \brief Constructs an inactive guard; \c begin() starts it.
+        Transaction(TransactionTracker* registry,
+                    MDBX_env* env,
+                    TransactionMode mode,
+                    DeferredTag) noexcept;
+
+        /// \brief Hands a reset handle from the tracker cache to an inactive
+        /// read-only guard, or only marks it parkable when \p parked is nullptr.
+        void adopt_parked(MDBX_txn* parked);
+
+        /// \brief Tag selecting the nested-transaction constructor.
+        struct NestedTag {};
+
+        /// \brief Constructs and begins a writable transaction nested in \p parent.
+        Transaction(TransactionTracker* registry,
+                    MDBX_env* env,
+                    MDBX_txn* parent,
+                    NestedTag);
+
         TransactionTracker* m_registry = nullptr;
         MDBX_env*       m_env = nullptr;            ///< Pointer to the MDBX environment handle.
         MDBX_txn*       m_txn = nullptr;            ///< MDBX transaction handle.
         TransactionMode m_mode = TransactionMode::WRITABLE; ///< Current transaction mode.
         bool            m_started = false;
+        bool            m_parkable = false;         ///< Offer the reset handle to the tracker on release.
+        MDBX_txn*       m_parent = nullptr;         ///< Parent of a savepoint, rebound when it ends.
+        bool            m_detached = false;         ///< Read handle not bound to any thread.
+        CommitLatency   m_commit_latency;           ///< Phases of the last successful writable commit.
 
         /// \brief Releases any owned transaction without throwing.
         void release() noexcept;
 
+        /// \brief Resets and hands a read-only handle back to the tracker.
+        /// \return true if the handle was consumed (parked or aborted).
+        bool release_to_tracker(TransactionTracker* registry, MDBX_txn* txn, bool was_started) noexcept;
+
         /// \brief Transfers ownership from another transaction object.
         void move_from(Transaction& other) noexcept;
 
@@ -120,9 +213,18 @@ namespace mdbxc {
         /// Never throws; asserts in debug if the tracker call fails.
         void safe_unbind_txn(TransactionTracker* registry, MDBX_txn* txn) noexcept;
 
+        /// \brief Unbinds \p txn, or rebinds \p parent when \p txn was a savepoint.
+        /// Never throws; asserts in debug if the tracker call fails.
+        void safe_restore_binding(TransactionTracker* registry, MDBX_txn* txn, MDBX_txn* parent) noexcept;
+
         /// \brief Best-effort unregister of a transaction handle from the tracker.
         /// Never throws; asserts in debug if the tracker call fails.
-        void safe_unregister_txn_handle(TransactionTracker* registry) noexcept;
+        void safe_unregister_txn_handle(TransactionTracker* registry,
+                                        bool detached = false) noexcept;
+
+        /// \brief Ends the read of a reset read-only handle: unbinds it, or
+        /// only forgets its start time when it is detached.
+        void safe_end_read(TransactionTracker* registry, MDBX_txn* txn, bool detached) noexcept;
     }; // Transaction
 
 }; // namespace mdbxc
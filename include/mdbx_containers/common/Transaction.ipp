@@ -5,6 +5,34 @@ namespace mdbxc {
         begin();
     }
 
+    inline Transaction::Transaction(TransactionTracker* registry, MDBX_env* env, MDBX_txn* parked)
+        : Transaction(registry, env, TransactionMode::READ_ONLY, DeferredTag()) {
+        adopt_parked(parked);
+        begin();
+    }
+
+    inline Transaction::Transaction(TransactionTracker* registry, MDBX_env* env,
+                                    TransactionMode mode, DeferredTag) noexcept
+        : m_registry(registry), m_env(env), m_mode(mode) {}
+
+    inline void Transaction::adopt_parked(MDBX_txn* parked) {
+        m_parkable = true;
+        if (!parked) return;
+        // Parked handles are not counted while they wait in the cache.
+        m_registry->register_txn_handle();
+        m_txn = parked;
+    }
+
+    inline Transaction::Transaction(TransactionTracker* registry, MDBX_env* env, DetachedTag)
+        : m_registry(registry), m_env(env), m_mode(TransactionMode::READ_ONLY), m_detached(true) {
+        begin();
+    }
+
+    inline Transaction::Transaction(TransactionTracker* registry, MDBX_env* env, MDBX_txn* parent, NestedTag)
+        : m_registry(registry), m_env(env), m_mode(TransactionMode::WRITABLE), m_parent(parent) {
+        begin();
+    }
+
     inline Transaction::Transaction(Transaction&& other) noexcept {
         move_from(other);
     }
@@ -30,25 +58,87 @@ namespace mdbxc {
         }
     }
 
-    inline void Transaction::safe_unregister_txn_handle(TransactionTracker* registry) noexcept {
+    inline void Transaction::safe_restore_binding(TransactionTracker* registry,
+                                                  MDBX_txn* txn,
+                                                  MDBX_txn* parent) noexcept {
+        if (!parent) {
+            safe_unbind_txn(registry, txn);
+            return;
+        }
+        if (!registry) return;
+        try {
+            registry->bind_txn(parent);
+        } catch (...) {
+            assert(!"TransactionTracker::bind_txn() failed while ending a savepoint");
+        }
+    }
+
+    inline void Transaction::safe_unregister_txn_handle(TransactionTracker* registry,
+                                                        bool detached) noexcept {
         if (!registry) return;
         try {
-            registry->unregister_txn_handle();
+            if (detached) {
+                registry->unregister_detached_txn_handle();
+            } else {
+                registry->unregister_txn_handle();
+            }
         } catch (...) {
             assert(!"TransactionTracker::unregister_txn_handle() failed during Transaction cleanup");
         }
     }
 
+    inline void Transaction::safe_end_read(TransactionTracker* registry,
+                                           MDBX_txn* txn,
+                                           bool detached) noexcept {
+        if (!detached) {
+            safe_unbind_txn(registry, txn);
+            return;
+        }
+        if (!registry || !txn) return;
+        try {
+            registry->note_detached_read(txn, false);
+        } catch (...) {
+            assert(!"TransactionTracker::note_detached_read() failed during Transaction cleanup");
+        }
+    }
+
+    inline bool Transaction::release_to_tracker(TransactionTracker* registry,
+                                                MDBX_txn* txn,
+                                                bool was_started) noexcept {
+        if (was_started && mdbx_txn_reset(txn) != MDBX_SUCCESS) {
+            return false;
+        }
+        if (was_started) {
+            safe_unbind_txn(registry, txn);
+        }
+        safe_unregister_txn_handle(registry);
+        if (!registry->park_read_txn(txn)) {
+            mdbx_txn_abort(txn);
+        }
+        return true;
+    }
+
     inline void Transaction::release() noexcept {
         TransactionTracker* registry = m_registry;
         MDBX_txn* txn = m_txn;
         const TransactionMode mode = m_mode;
         const bool was_started = m_started;
+        const bool parkable = m_parkable;
+        MDBX_txn* parent = m_parent;
+        const bool detached = m_detached;
 
         m_registry = nullptr;
         m_env = nullptr;
         m_txn = nullptr;
         m_started = false;
+        m_parkable = false;
+        m_parent = nullptr;
+        m_detached = false;
+
+        if (txn && registry && parkable && mode == TransactionMode::READ_ONLY &&
+            release_to_tracker(registry, txn, was_started)) {
+            return;
+        }
 
         if (txn) {
             const int rc = mdbx_txn_abort(txn);
@@ -57,18 +147,23 @@ namespace mdbxc {
             (void)rc;
         }
 
-#       if MDBXC_SYNC_ENABLED
         if (registry && txn && was_started && mode == TransactionMode::WRITABLE) {
+            registry->notify_write_abort();
+#           if MDBXC_SYNC_ENABLED
             registry->on_discard(txn);
+#           endif
         }
-#       endif
 
         if (registry && txn && was_started) {
-            safe_unbind_txn(registry, txn);
+            if (detached) {
+                safe_end_read(registry, txn, true);
+            } else {
+                safe_restore_binding(registry, txn, parent);
+            }
         }
 
         if (registry && txn) {
-            safe_unregister_txn_handle(registry);
+            safe_unregister_txn_handle(registry, detached);
         }
     }
 
@@ -78,55 +173,101 @@ namespace mdbxc {
         m_txn = other.m_txn;
         m_mode = other.m_mode;
         m_started = other.m_started;
+        m_parkable = other.m_parkable;
+        m_parent = other.m_parent;
+        m_detached = other.m_detached;
+        m_commit_latency = other.m_commit_latency;
 
         other.m_registry = nullptr;
         other.m_env = nullptr;
         other.m_txn = nullptr;
         other.m_started = false;
+        other.m_parkable = false;
+        other.m_parent = nullptr;
+        other.m_detached = false;
     }
 
     inline void Transaction::begin() {
-        if (m_started) return;
+        check_status(begin(std::nothrow));
+    }
+
+    inline Status Transaction::begin(std::nothrow_t) noexcept {
+        if (m_started) return Status();
+        MDBXC_TRACE_SCOPE(TxnBegin);
         bool new_handle = false;
         bool registered_handle = false;
         if (m_txn && m_mode == TransactionMode::READ_ONLY) {
-            check_mdbx(mdbx_txn_renew(m_txn), "Failed to renew transaction");
+            const int rc = mdbx_txn_renew(m_txn);
+            if (rc != MDBX_SUCCESS) {
+                // The reset handle cannot be reused; drop it so the guard is inactive.
+                mdbx_txn_abort(m_txn);
+                m_txn = nullptr;
+                safe_unregister_txn_handle(m_registry, m_detached);
+                return Status::from_mdbx(rc, "Failed to renew transaction");
+            }
         } else {
             MDBX_txn_flags_t flags = (m_mode == TransactionMode::READ_ONLY) ? MDBX_TXN_RDONLY : MDBX_TXN_READWRITE;
-            check_mdbx(mdbx_txn_begin(m_env, nullptr, flags, &m_txn), "Failed to begin transaction");
+            int rc = MDBX_SUCCESS;
+            if (m_mode == TransactionMode::WRITABLE && !m_parent) {
+                const WriterScheduler::WaitScope wait(m_registry->writer_scheduler());
+                rc = mdbx_txn_begin(m_env, nullptr, flags, &m_txn);
+            } else {
+                rc = mdbx_txn_begin(m_env, m_parent, flags, &m_txn);
+            }
+            if (rc != MDBX_SUCCESS) {
+                m_txn = nullptr;
+                return Status::from_mdbx(rc, m_parent ? "Failed to begin savepoint" : "Failed to begin transaction");
+            }
             new_handle = true;
         }
         try {
             if (new_handle) {
-                m_registry->register_txn_handle();
+                if (m_detached) {
+                    m_registry->register_detached_txn_handle();
+                } else {
+                    m_registry->register_txn_handle();
+                }
                 registered_handle = true;
             }
-            m_registry->bind_txn(m_txn);
+            if (m_detached) {
+                m_registry->note_detached_read(m_txn, true);
+            } else {
+                m_registry->bind_txn(m_txn);
+            }
             m_started = true;
         } catch (...) {
             if (new_handle && m_txn) {
                 mdbx_txn_abort(m_txn);
                 if (registered_handle) {
-                    m_registry->unregister_txn_handle();
+                    safe_unregister_txn_handle(m_registry, m_detached);
                 }
                 m_txn = nullptr;
             } else if (m_txn && m_mode == TransactionMode::READ_ONLY) {
                 mdbx_txn_reset(m_txn);
             }
-            throw;
+            return Status::from_current_exception();
         }
+        return Status();
     }
 
     inline void Transaction::commit() {
-        if (!m_txn || !m_started) throw MdbxException("No active transaction to commit.");
+        check_status(commit(std::nothrow));
+    }
+
+    inline Status Transaction::commit(std::nothrow_t) noexcept {
+        if (!m_txn || !m_started) return Status(StatusCode::Error, "No active transaction to commit.");
+        MDBXC_TRACE_SCOPE(TxnCommit);
 
         switch (m_mode) {
         case TransactionMode::READ_ONLY:
         {
             MDBX_txn* txn = m_txn;
-            check_mdbx(mdbx_txn_reset(txn), "Failed to reset read-only transaction");
+            const int rc = mdbx_txn_reset(txn);
+            if (rc != MDBX_SUCCESS) {
+                return Status::from_mdbx(rc, "Failed to reset read-only transaction");
+            }
             m_started = false;
-            safe_unbind_txn(m_registry, txn);
+            safe_end_read(m_registry, txn, m_detached);
             break;
         }
         case TransactionMode::WRITABLE:
@@ -138,31 +279,71 @@ namespace mdbxc {
             // Runs inside the write transaction, before mdbx_txn_commit. 
             // MdbxException raised here aborts the commit so 
             // user-visible writes and changelog rows stay atomic.
-            m_registry->on_pre_commit(txn);
+            try {
+                m_registry->on_pre_commit(txn);
+            } catch (...) {
+                return Status::from_current_exception();
+            }
+            const std::uint64_t txn_id = mdbx_txn_id(txn);
 #           endif
 
-            const int rc = mdbx_txn_commit(txn);
+#           if MDBXC_METRICS_ENABLED
+            const std::chrono::steady_clock::time_point commit_start = std::chrono::steady_clock::now();
+#           endif
+            MDBX_commit_latency latency = MDBX_commit_latency();
+            const int rc = mdbx_txn_commit_ex(txn, &latency);
 
             if (rc == MDBX_THREAD_MISMATCH) {
-                check_mdbx(rc, "Failed to commit writable transaction");
+                return Status::from_mdbx(rc, "Failed to commit writable transaction");
             }
 
             // MDBX_SUCCESS or any other error: the native handle is already
-            // terminated (or we threw above for THREAD_MISMATCH). Null the
+            // terminated (or we returned above for THREAD_MISMATCH). Null the
             // wrapper state before tracker cleanup so that a tracker throw
-            // does not cause a double-abort in the destructor.
+            // does not cause a double-abort in the destructor. A failed
+            // savepoint commit leaves its parent active, so rebind it.
             TransactionTracker* registry = m_registry;
 
             m_txn = nullptr;
             m_started = false;
 
-            safe_unbind_txn(registry, txn);
+            safe_restore_binding(registry, txn, m_parent);
             safe_unregister_txn_handle(registry);
 
-            check_mdbx(rc, "Failed to commit writable transaction");
+            // A failed commit has aborted the transaction.
+            if (registry && rc != MDBX_SUCCESS) {
+                registry->notify_write_abort();
+#               if MDBXC_SYNC_ENABLED
+                registry->on_discard(txn);
+#               endif
+            }
+            if (rc != MDBX_SUCCESS) {
+                return Status::from_mdbx(rc, "Failed to commit writable transaction");
+            }
+            m_commit_latency.preparation = CommitLatency::from_mdbx_units(latency.preparation);
+            m_commit_latency.gc = CommitLatency::from_mdbx_units(latency.gc_wallclock);
+            m_commit_latency.audit = CommitLatency::from_mdbx_units(latency.audit);
+            m_commit_latency.write = CommitLatency::from_mdbx_units(latency.write);
+            m_commit_latency.sync = CommitLatency::from_mdbx_units(latency.sync);
+            m_commit_latency.ending = CommitLatency::from_mdbx_units(latency.ending);
+            m_commit_latency.whole = CommitLatency::from_mdbx_units(latency.whole);
+            m_commit_latency.gc_cpu = CommitLatency::from_mdbx_units(latency.gc_cputime);
+            // A savepoint commit only merges into the parent.
+            if (registry && !m_parent) {
+                registry->notify_write_commit();
+                registry->on_write_commit();
+#               if MDBXC_SYNC_ENABLED
+                registry->on_committed(txn_id);
+#               endif
+#               if MDBXC_METRICS_ENABLED
+                registry->on_commit_latency(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - commit_start), m_commit_latency);
+#               endif
+            }
             break;
         }
         };
+        return Status();
     }
 
     inline void Transaction::rollback() {
@@ -180,7 +361,7 @@ namespace mdbxc {
             check_mdbx(rc, "Failed to reset read-only transaction");
 
             m_started = false;
-            safe_unbind_txn(m_registry, txn);
+            safe_end_read(m_registry, txn, m_detached);
             break;
         }
         case TransactionMode::WRITABLE:
@@ -199,10 +380,11 @@ namespace mdbxc {
             m_txn = nullptr;
             m_started = false;
 
+            if (registry) registry->notify_write_abort();
 #           if MDBXC_SYNC_ENABLED
             registry->on_discard(txn);
 #           endif
-            safe_unbind_txn(registry, txn);
+            safe_restore_binding(registry, txn, m_parent);
             safe_unregister_txn_handle(registry);
 
             break;
@@ -214,4 +396,15 @@ namespace mdbxc {
         return m_txn;
     }
 
+    inline const CommitLatency& Transaction::commit_latency() const noexcept {
+        return m_commit_latency;
+    }
+
+    inline Transaction Transaction::savepoint() {
+        if (!m_txn || !m_started || m_mode != TransactionMode::WRITABLE) {
+            throw MdbxException("Savepoints require an active writable transaction.", MDBX_EINVAL);
+        }
+        return Transaction(m_registry, m_env, m_txn, NestedTag());
+    }
+
 } // namespace mdbxc
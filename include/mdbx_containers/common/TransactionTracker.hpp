@@ -5,8 +5,11 @@
 /// \file TransactionTracker.hpp
 /// \brief Tracks MDBX transactions per thread for reuse and cleanup.
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -15,19 +18,32 @@
 #define MDBXC_SYNC_ENABLED 0
 #endif
 
-#if MDBXC_SYNC_ENABLED
-#include <mdbx.h>
+#ifndef MDBXC_METRICS_ENABLED
+#define MDBXC_METRICS_ENABLED 0
 #endif
 
+#include <mdbx.h>
+
+#include "CommitLatency.hpp"
+#include "WriterScheduler.hpp"
+
 namespace mdbxc {
 
     /// \class TransactionTracker
     /// \ingroup mdbxc_core
     /// \brief Associates MDBX transactions with threads.
     ///
-    /// Manages a map from thread IDs to MDBX transaction pointers,
+    /// Manages the association from threads to MDBX transaction pointers,
     /// allowing reuse and cleanup of transactions for specific threads.
     ///
+    /// The hot lookups used by every auto-transaction table call
+    /// (\c thread_txn(), \c current_thread_has_txn()) read a small per-thread
+    /// slot array keyed by a unique tracker id and take no lock. The slots are
+    /// trivially destructible, so they are safe as \c thread_local storage on
+    /// MinGW. A thread that serves more trackers at once than there are slots
+    /// spills into mutex-protected overflow maps. The open-handle total is an
+    /// atomic counter; the mutex is taken only to wake shutdown waiters.
+    ///
     /// \thread_safety Internally synchronized only for registry access. This
     /// class does not make `MDBX_txn*` handles safe to use from another thread.
     class TransactionTracker {
@@ -38,12 +54,29 @@ namespace mdbxc {
         /// \param txn Pointer to the MDBX transaction.
         void bind_txn(MDBX_txn* txn);
 
+        /// \brief Returns the scheduler that top-level write transactions
+        /// report their wait for the MDBX writer to.
+        WriterScheduler& writer_scheduler() noexcept { return m_writer_scheduler; }
+
         /// \brief Registers a newly created MDBX transaction handle.
         void register_txn_handle();
 
         /// \brief Unregisters a closed MDBX transaction handle.
         void unregister_txn_handle();
 
+        /// \brief Registers a read-only handle that no thread owns.
+        /// \details Counted for shutdown like every handle, but never bound
+        /// to a thread. Only valid with \c MDBX_NOSTICKYTHREADS.
+        void register_detached_txn_handle();
+
+        /// \brief Unregisters a handle registered by \ref register_detached_txn_handle().
+        /// \details May run on any thread.
+        void unregister_detached_txn_handle();
+
+        /// \brief Records the start or end of a read on a detached handle
+        /// for \ref oldest_read_age().
+        void note_detached_read(MDBX_txn* txn, bool started);
+
         /// \brief Unregisters the expected transaction for the current thread.
         /// \param expected_txn Transaction pointer that must match the current
         ///        thread's registered transaction.
@@ -75,12 +108,74 @@ namespace mdbxc {
             const std::chrono::duration<Rep, Period>& timeout) const {
             std::unique_lock<std::mutex> lock(m_mutex);
             return m_txn_cv.wait_for(lock, timeout, [this]() {
-                return m_open_txn_handles == 0;
+                return m_open_txn_handles.load(std::memory_order_acquire) == 0;
             });
         }
-        
+
+        /// \brief Counts a successful write commit and wakes commit waiters.
+        void notify_write_commit() noexcept;
+
+        /// \brief Counts an aborted write transaction or savepoint.
+        void notify_write_abort() noexcept {
+            m_abort_seq.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        /// \brief Enables or disables recording of read-only transaction start times.
+        /// \details Disabling forgets all recorded start times.
+        void set_read_age_tracking(bool enabled);
+
+        /// \brief Returns the age of the oldest active read-only transaction.
+        /// \return Zero when tracking is disabled or no read transaction is active.
+        std::chrono::steady_clock::duration oldest_read_age() const;
+
+        /// \brief Returns the number of write commits made through \c Transaction.
+        std::uint64_t commit_sequence() const noexcept {
+            return m_commit_seq.load(std::memory_order_seq_cst);
+        }
+
+        /// \brief Returns the number of write transactions and savepoints aborted through \c Transaction.
+        std::uint64_t abort_sequence() const noexcept {
+            return m_abort_seq.load(std::memory_order_acquire);
+        }
+
+        /// \brief Waits until \c commit_sequence() differs from \p seen.
+        /// \return true if a commit was observed, false on timeout.
+        template<class Rep, class Period>
+        bool wait_for_commit_for(std::uint64_t seen,
+                                 const std::chrono::duration<Rep, Period>& timeout) const {
+            if (commit_sequence() != seen) return true;
+            m_commit_waiters.fetch_add(1, std::memory_order_seq_cst);
+            bool committed = false;
+            {
+                std::unique_lock<std::mutex> lock(m_commit_mutex);
+                committed = m_commit_cv.wait_for(lock, timeout, [this, seen]() {
+                    return commit_sequence() != seen;
+                });
+            }
+            m_commit_waiters.fetch_sub(1, std::memory_order_seq_cst);
+            return committed;
+        }
+
+        TransactionTracker() noexcept : m_id(next_tracker_id()) {}
+        TransactionTracker(const TransactionTracker&) = delete;
+        TransactionTracker& operator=(const TransactionTracker&) = delete;
+
         virtual ~TransactionTracker() = default;
 
+        /// \brief Offers a reset read-only transaction for later reuse.
+        /// \param txn Reset read-only handle that is no longer bound or counted.
+        /// \return true if the tracker took ownership; otherwise the caller aborts it.
+        virtual bool park_read_txn(MDBX_txn* txn) noexcept {
+            (void)txn;
+            return false;
+        }
+
+        /// \brief Hook for a successful top-level write commit.
+        /// \details Called by \c Transaction::commit after \c notify_write_commit(),
+        /// once the writer lock is released. Default is no-op; \c Connection
+        /// samples database growth here.
+        virtual void on_write_commit() noexcept {}
+
 #       if MDBXC_SYNC_ENABLED
         /// \brief Pre-commit hook for sync capture.
         /// \details Called by \c Transaction::commit before \c mdbx_txn_commit
@@ -96,14 +191,84 @@ namespace mdbxc {
         virtual void on_discard(MDBX_txn* txn) noexcept {
             (void)txn;
         }
+
+        /// \brief Post-commit hook for sync capture.
+        /// \details Called by \c Transaction::commit after a successful
+        /// top-level write commit with the \c mdbx_txn_id() read before the
+        /// commit. Default is no-op; \c Connection forwards to the attached
+        /// \c ISyncCaptureSink.
+        virtual void on_committed(std::uint64_t txn_id) noexcept {
+            (void)txn_id;
+        }
+#       endif
+
+#       if MDBXC_METRICS_ENABLED
+        /// \brief Metrics hook for a successful top-level write commit.
+        /// \param latency Wall time of \c mdbx_txn_commit_ex().
+        /// \param phases MDBX phase breakdown of the same commit.
+        /// \details Default is no-op; \c Connection forwards to the attached
+        /// \c ITableObserver.
+        virtual void on_commit_latency(std::chrono::nanoseconds latency,
+                                       const CommitLatency& phases) noexcept {
+            (void)latency;
+            (void)phases;
+        }
 #       endif
 
     private:
-        mutable std::mutex m_mutex;  ///< Protects access to m_thread_txns.
+        /// \brief Per-thread transaction state of one tracker.
+        struct ThreadSlot {
+            std::uint64_t owner;   ///< Tracker id, 0 for a free slot.
+            MDBX_txn*     txn;     ///< Bound transaction or nullptr.
+            std::size_t   handles; ///< Open transaction handles of this thread.
+        };
+
+        static const std::size_t thread_slot_count = 8; ///< Lock-free slots per thread.
+
+        /// \brief Returns the calling thread's slot array.
+        static ThreadSlot* thread_slots() noexcept;
+
+        /// \brief Returns a process-unique tracker id (never 0, never reused).
+        static std::uint64_t next_tracker_id() noexcept;
+
+        /// \brief Finds the calling thread's slot for this tracker.
+        ThreadSlot* find_thread_slot() const noexcept;
+
+        /// \brief Finds or claims the calling thread's slot for this tracker.
+        /// \return Slot pointer or nullptr when all slots are taken.
+        ThreadSlot* acquire_thread_slot() noexcept;
+
+        /// \brief Frees a slot that no longer holds a transaction or handles.
+        static void release_idle_thread_slot(ThreadSlot* slot) noexcept;
+
+        /// \brief Decrements the open-handle total and wakes shutdown waiters
+        /// when it reaches zero.
+        void release_open_handle();
+
+        /// \brief Records or forgets the start time of a read-only transaction.
+        void track_read_txn(MDBX_txn* txn, bool started);
+
+        /// \brief Whether overflow maps may hold entries and must be probed.
+        bool has_overflow() const noexcept {
+            return m_overflow_entries.load(std::memory_order_acquire) != 0;
+        }
+
+        const std::uint64_t m_id;    ///< Key of this tracker in per-thread slots.
+        mutable std::mutex m_mutex;  ///< Protects overflow maps and waiter wake-ups.
         mutable std::condition_variable m_txn_cv; ///< Notifies waiters when transactions end.
-        std::unordered_map<std::thread::id, MDBX_txn*> m_thread_txns; ///< Map of thread IDs to transaction pointers.
-        std::unordered_map<std::thread::id, std::size_t> m_thread_txn_handle_counts; ///< Open transaction handles per thread.
-        std::size_t m_open_txn_handles = 0; ///< Total number of open transaction handles.
+        std::unordered_map<std::thread::id, MDBX_txn*> m_thread_txns; ///< Overflow map of thread IDs to transaction pointers.
+        std::unordered_map<std::thread::id, std::size_t> m_thread_txn_handle_counts; ///< Overflow open handles per thread.
+        std::atomic<std::size_t> m_overflow_entries{0}; ///< Number of entries in both overflow maps.
+        std::atomic<std::size_t> m_open_txn_handles{0}; ///< Total number of open transaction handles.
+        std::atomic<std::uint64_t> m_commit_seq{0};     ///< Successful write commits.
+        std::atomic<std::uint64_t> m_abort_seq{0};      ///< Aborted write transactions and savepoints.
+        mutable std::atomic<std::size_t> m_commit_waiters{0}; ///< Threads blocked in wait_for_commit_for().
+        mutable std::mutex m_commit_mutex;              ///< Orders commit wake-ups against waiters.
+        mutable std::condition_variable m_commit_cv;    ///< Notifies waiters after write commits.
+        std::atomic<bool> m_track_read_age{false};      ///< Whether read start times are recorded.
+        mutable std::mutex m_read_age_mutex;            ///< Protects m_read_started.
+        std::unordered_map<MDBX_txn*, std::chrono::steady_clock::time_point> m_read_started; ///< Active read transactions.
+        WriterScheduler m_writer_scheduler;             ///< Shares the writer with sync apply.
     };
 
 } // namespace mdbxc
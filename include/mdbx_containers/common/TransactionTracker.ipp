@@ -1,79 +1,210 @@
 namespace mdbxc {
 
+    inline TransactionTracker::ThreadSlot* TransactionTracker::thread_slots() noexcept {
+        // Trivially destructible POD: no TLS destructor is registered.
+        static thread_local ThreadSlot slots[thread_slot_count];
+        return slots;
+    }
+
+    inline std::uint64_t TransactionTracker::next_tracker_id() noexcept {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    inline TransactionTracker::ThreadSlot* TransactionTracker::find_thread_slot() const noexcept {
+        ThreadSlot* slots = thread_slots();
+        for (std::size_t i = 0; i < thread_slot_count; ++i) {
+            if (slots[i].owner == m_id) return &slots[i];
+        }
+        return nullptr;
+    }
+
+    inline TransactionTracker::ThreadSlot* TransactionTracker::acquire_thread_slot() noexcept {
+        ThreadSlot* slots = thread_slots();
+        ThreadSlot* free_slot = nullptr;
+        for (std::size_t i = 0; i < thread_slot_count; ++i) {
+            if (slots[i].owner == m_id) return &slots[i];
+            if (!free_slot && slots[i].owner == 0) free_slot = &slots[i];
+        }
+        if (free_slot) {
+            free_slot->owner = m_id;
+            free_slot->txn = nullptr;
+            free_slot->handles = 0;
+        }
+        return free_slot;
+    }
+
+    inline void TransactionTracker::release_idle_thread_slot(ThreadSlot* slot) noexcept {
+        if (slot->txn == nullptr && slot->handles == 0) {
+            slot->owner = 0;
+        }
+    }
+
     inline void TransactionTracker::bind_txn(MDBX_txn* txn) {
+        if (m_track_read_age.load(std::memory_order_relaxed)) {
+            track_read_txn(txn, true);
+        }
+        if (ThreadSlot* slot = acquire_thread_slot()) {
+            slot->txn = txn;
+            return;
+        }
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_thread_txns[std::this_thread::get_id()] = txn;
+        auto res = m_thread_txns.insert(std::make_pair(std::this_thread::get_id(), txn));
+        if (res.second) {
+            m_overflow_entries.fetch_add(1, std::memory_order_release);
+        } else {
+            res.first->second = txn;
+        }
     }
 
     inline void TransactionTracker::register_txn_handle() {
+        m_open_txn_handles.fetch_add(1, std::memory_order_acq_rel);
+        if (ThreadSlot* slot = acquire_thread_slot()) {
+            ++slot->handles;
+            return;
+        }
         std::lock_guard<std::mutex> lock(m_mutex);
-        ++m_open_txn_handles;
-        ++m_thread_txn_handle_counts[std::this_thread::get_id()];
+        std::size_t& count = m_thread_txn_handle_counts[std::this_thread::get_id()];
+        if (count++ == 0) {
+            m_overflow_entries.fetch_add(1, std::memory_order_release);
+        }
     }
 
     inline void TransactionTracker::unregister_txn_handle() {
-        bool empty = false;
-        {
+        ThreadSlot* slot = find_thread_slot();
+        if (slot && slot->handles > 0) {
+            --slot->handles;
+            release_idle_thread_slot(slot);
+        } else if (has_overflow()) {
             std::lock_guard<std::mutex> lock(m_mutex);
-            if (m_open_txn_handles > 0) {
-                --m_open_txn_handles;
-            }
             auto it = m_thread_txn_handle_counts.find(std::this_thread::get_id());
             if (it != m_thread_txn_handle_counts.end()) {
                 if (it->second > 1) {
                     --it->second;
                 } else {
                     m_thread_txn_handle_counts.erase(it);
+                    m_overflow_entries.fetch_sub(1, std::memory_order_release);
                 }
             }
-            empty = (m_open_txn_handles == 0);
         }
-        if (empty) {
+
+        release_open_handle();
+    }
+
+    inline void TransactionTracker::register_detached_txn_handle() {
+        m_open_txn_handles.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    inline void TransactionTracker::unregister_detached_txn_handle() {
+        release_open_handle();
+    }
+
+    inline void TransactionTracker::note_detached_read(MDBX_txn* txn, bool started) {
+        if (m_track_read_age.load(std::memory_order_relaxed)) {
+            track_read_txn(txn, started);
+        }
+    }
+
+    inline void TransactionTracker::release_open_handle() {
+        std::size_t open = m_open_txn_handles.load(std::memory_order_acquire);
+        while (open > 0 &&
+               !m_open_txn_handles.compare_exchange_weak(open, open - 1,
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_acquire)) {
+        }
+        if (open == 1) {
+            // Waiters check the counter under the mutex; passing through it
+            // orders this wake-up after any waiter that already tested it.
+            { std::lock_guard<std::mutex> lock(m_mutex); }
             m_txn_cv.notify_all();
         }
     }
 
     inline void TransactionTracker::unbind_txn(MDBX_txn* expected_txn) {
-        bool erased = false;
-        {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            auto it = m_thread_txns.find(std::this_thread::get_id());
-            if (it != m_thread_txns.end() && it->second == expected_txn) {
-                m_thread_txns.erase(it);
-                erased = true;
-            }
+        if (m_track_read_age.load(std::memory_order_relaxed)) {
+            track_read_txn(expected_txn, false);
         }
-        if (erased) {
-            m_txn_cv.notify_all();
+        ThreadSlot* slot = find_thread_slot();
+        if (slot && slot->txn == expected_txn && slot->txn != nullptr) {
+            slot->txn = nullptr;
+            release_idle_thread_slot(slot);
+            return;
+        }
+        if (!has_overflow()) return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_thread_txns.find(std::this_thread::get_id());
+        if (it != m_thread_txns.end() && it->second == expected_txn) {
+            m_thread_txns.erase(it);
+            m_overflow_entries.fetch_sub(1, std::memory_order_release);
         }
     }
 
     inline MDBX_txn* TransactionTracker::thread_txn() const {
+        const ThreadSlot* slot = find_thread_slot();
+        if (slot && slot->txn) return slot->txn;
+        if (!has_overflow()) return nullptr;
         std::lock_guard<std::mutex> lock(m_mutex);
         auto it = m_thread_txns.find(std::this_thread::get_id());
         return (it != m_thread_txns.end()) ? it->second : nullptr;
     }
 
     inline bool TransactionTracker::current_thread_has_txn() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_thread_txns.find(std::this_thread::get_id()) != m_thread_txns.end();
+        return thread_txn() != nullptr;
     }
 
     inline bool TransactionTracker::current_thread_has_txn_handle() const {
+        const ThreadSlot* slot = find_thread_slot();
+        if (slot && slot->handles > 0) return true;
+        if (!has_overflow()) return false;
         std::lock_guard<std::mutex> lock(m_mutex);
         return m_thread_txn_handle_counts.find(std::this_thread::get_id()) !=
                m_thread_txn_handle_counts.end();
     }
 
     inline bool TransactionTracker::has_txn_handles() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_open_txn_handles != 0;
+        return m_open_txn_handles.load(std::memory_order_acquire) != 0;
+    }
+
+    inline void TransactionTracker::notify_write_commit() noexcept {
+        m_commit_seq.fetch_add(1, std::memory_order_seq_cst);
+        // Skip the mutex when nobody waits; a waiter registers before it
+        // re-checks the sequence, so either side sees the other's update.
+        if (m_commit_waiters.load(std::memory_order_seq_cst) == 0) return;
+        { std::lock_guard<std::mutex> lock(m_commit_mutex); }
+        m_commit_cv.notify_all();
+    }
+
+    inline void TransactionTracker::track_read_txn(MDBX_txn* txn, bool started) {
+        if (!txn) return;
+        if (started && !(mdbx_txn_flags(txn) & MDBX_TXN_RDONLY)) return;
+        std::lock_guard<std::mutex> lock(m_read_age_mutex);
+        if (started) {
+            m_read_started[txn] = std::chrono::steady_clock::now();
+        } else {
+            m_read_started.erase(txn);
+        }
+    }
+
+    inline void TransactionTracker::set_read_age_tracking(bool enabled) {
+        std::lock_guard<std::mutex> lock(m_read_age_mutex);
+        m_track_read_age.store(enabled, std::memory_order_relaxed);
+        if (!enabled) m_read_started.clear();
+    }
+
+    inline std::chrono::steady_clock::duration TransactionTracker::oldest_read_age() const {
+        std::lock_guard<std::mutex> lock(m_read_age_mutex);
+        if (m_read_started.empty()) return std::chrono::steady_clock::duration::zero();
+        std::chrono::steady_clock::time_point oldest = m_read_started.begin()->second;
+        for (auto it = m_read_started.begin(); it != m_read_started.end(); ++it) {
+            if (it->second < oldest) oldest = it->second;
+        }
+        return std::chrono::steady_clock::now() - oldest;
     }
 
     inline void TransactionTracker::wait_for_no_txn_handles() const {
         std::unique_lock<std::mutex> lock(m_mutex);
         m_txn_cv.wait(lock, [this]() {
-            return m_open_txn_handles == 0;
+            return m_open_txn_handles.load(std::memory_order_acquire) == 0;
         });
     }
 
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_WARMUP_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_WARMUP_HPP_INCLUDED
+
+/// \file Warmup.hpp
+/// \brief Options and results of \c Connection::warmup().
+/// \details
+/// Warm-up pages the database into memory before traffic is admitted, so the
+/// first requests after a restart do not pay for page faults. It combines
+/// \c mdbx_env_warmup() over the used part of the file with sequential cursor
+/// scans of selected tables.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace mdbxc {
+
+    /// \brief Progress of a running warm-up.
+    struct WarmupProgress {
+        std::string   table;            ///< Table being scanned; empty during the environment pass.
+        std::size_t   tables_done = 0;  ///< Tables scanned completely.
+        std::size_t   tables_total = 0; ///< Tables requested.
+        std::uint64_t entries = 0;      ///< Entries touched so far, over all tables.
+        std::uint64_t bytes = 0;        ///< Key and value bytes touched so far.
+    };
+
+    /// \brief Callback type of \ref WarmupOptions::progress.
+    typedef std::function<void(const WarmupProgress&)> WarmupProgressHandler;
+
+    /// \brief Options of \c Connection::warmup().
+    struct WarmupOptions {
+        /// \brief Run \c mdbx_env_warmup() over the used part of the file first.
+        bool prefault_env = true;
+        /// \brief Touch every page instead of relying on OS prefetch hints (\c MDBX_warmup_force).
+        bool force = false;
+        /// \brief Lock warmed pages in memory (\c MDBX_warmup_lock); needs a large enough \c RLIMIT_MEMLOCK.
+        bool lock = false;
+        /// \brief Entries scanned between two progress callbacks.
+        std::size_t progress_every = 4096;
+        /// \brief Optional progress callback, invoked on the warming thread.
+        WarmupProgressHandler progress;
+    };
+
+    /// \brief Outcome of \c Connection::warmup().
+    struct WarmupResult {
+        bool          completed = false; ///< False when the time budget ran out first.
+        std::size_t   tables_done = 0;   ///< Tables scanned completely.
+        std::uint64_t entries = 0;       ///< Entries touched.
+        std::uint64_t bytes = 0;         ///< Key and value bytes touched.
+        std::chrono::milliseconds elapsed{0}; ///< Wall time spent.
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_WARMUP_HPP_INCLUDED
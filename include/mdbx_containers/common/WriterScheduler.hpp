@@ -0,0 +1,175 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COMMON_WRITER_SCHEDULER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COMMON_WRITER_SCHEDULER_HPP_INCLUDED
+
+/// \file WriterScheduler.hpp
+/// \brief Shares the single MDBX writer between local writes and sync apply.
+/// \details MDBX admits one write transaction at a time and does not queue
+/// writers in order, so a long replication apply delays every local write
+/// that arrives meanwhile. Local writers announce themselves here while they
+/// wait to begin; an apply that sees them commits its current slice and lets
+/// them start before it begins the next one.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace mdbxc {
+
+    /// \enum WriterClass
+    /// \brief Priority class of the write transactions a thread begins.
+    enum class WriterClass {
+        Local,       ///< Application writes; never wait for a yielding apply.
+        Replication  ///< Sync apply; yields the writer to waiting local writes.
+    };
+
+    /// \class WriterScheduler
+    /// \ingroup mdbxc_core
+    /// \brief Time slicing of replication writes in favour of local writers.
+    /// \details Every top-level write transaction begun through a
+    /// \ref Connection counts as a waiting writer of its thread's
+    /// \ref WriterClass until \c mdbx_txn_begin() returns. A replication
+    /// writer with slicing enabled checks \ref should_yield() between
+    /// batches: once its transaction has run for the slice while local
+    /// writers wait, it commits and calls \ref yield_to_local(), which
+    /// returns when the local writers waiting at that moment have begun, or
+    /// after the yield limit so a stream of local writes cannot starve
+    /// replication. A local write then waits for at most about one slice.
+    /// \thread_safety Thread-safe. Counting a local writer costs two atomic
+    /// operations; the mutex is taken only while an apply is yielding.
+    class WriterScheduler {
+    public:
+        /// \brief Counters since construction.
+        struct Stats {
+            std::uint64_t yields = 0;         ///< Apply transactions committed early for local writers.
+            std::uint64_t yield_timeouts = 0; ///< Yields that ended at the limit.
+        };
+
+        /// \brief Marks write transactions begun by this thread as \p cls while alive.
+        class ClassScope {
+        public:
+            explicit ClassScope(WriterClass cls) noexcept : m_prev(current()) {
+                current() = cls;
+            }
+            ~ClassScope() { current() = m_prev; }
+
+            ClassScope(const ClassScope&) = delete;
+            ClassScope& operator=(const ClassScope&) = delete;
+
+        private:
+            WriterClass m_prev;
+        };
+
+        /// \brief Counts the calling thread as a waiting local writer while alive.
+        /// \details Does nothing on a \ref WriterClass::Replication thread.
+        class WaitScope {
+        public:
+            explicit WaitScope(WriterScheduler& scheduler) noexcept
+                : m_scheduler(current() == WriterClass::Local ? &scheduler : nullptr) {
+                if (m_scheduler) {
+                    m_scheduler->m_waiting.fetch_add(1);
+                }
+            }
+            ~WaitScope() {
+                if (m_scheduler) {
+                    m_scheduler->end_wait();
+                }
+            }
+
+            WaitScope(const WaitScope&) = delete;
+            WaitScope& operator=(const WaitScope&) = delete;
+
+        private:
+            WriterScheduler* m_scheduler;
+        };
+
+        WriterScheduler() = default;
+        WriterScheduler(const WriterScheduler&) = delete;
+        WriterScheduler& operator=(const WriterScheduler&) = delete;
+
+        /// \brief Sets the apply slice and the yield limit.
+        /// \param slice Longest replication write transaction while local
+        ///        writers wait; zero disables slicing.
+        /// \param yield_max Longest wait of one \ref yield_to_local().
+        void configure(std::chrono::milliseconds slice,
+                       std::chrono::milliseconds yield_max) noexcept {
+            m_slice_ms.store(slice.count() > 0 ? slice.count() : 0);
+            m_yield_max_ms.store(yield_max.count() > 0 ? yield_max.count() : 0);
+        }
+
+        /// \brief Whether replication writes are sliced.
+        bool slicing() const noexcept { return m_slice_ms.load() > 0; }
+
+        /// \brief Returns the class of the calling thread's writes.
+        static WriterClass current_class() noexcept { return current(); }
+
+        /// \brief Returns the local writers waiting to begin now.
+        std::size_t local_waiters() const noexcept { return m_waiting.load(); }
+
+        /// \brief Whether a replication transaction begun at \p started
+        /// should commit and yield now.
+        bool should_yield(std::chrono::steady_clock::time_point started) const noexcept {
+            const std::int64_t slice = m_slice_ms.load();
+            return slice > 0 && m_waiting.load() != 0 &&
+                   std::chrono::steady_clock::now() - started >= std::chrono::milliseconds(slice);
+        }
+
+        /// \brief Waits until the local writers waiting now have begun.
+        /// \details Call after committing and before beginning the next
+        /// replication transaction. Returns after the yield limit at the latest.
+        void yield_to_local() {
+            const std::uint64_t target = m_started.load() + m_waiting.load();
+            const std::chrono::milliseconds limit(m_yield_max_ms.load());
+            bool served = true;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_yielders.fetch_add(1);
+                served = m_cv.wait_for(lock, limit, [this, target]() {
+                    return m_started.load() >= target;
+                });
+                m_yielders.fetch_sub(1);
+                ++m_stats.yields;
+                if (!served) {
+                    ++m_stats.yield_timeouts;
+                }
+            }
+        }
+
+        /// \brief Returns the counters.
+        Stats stats() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stats;
+        }
+
+    private:
+        static WriterClass& current() noexcept {
+            static thread_local WriterClass cls = WriterClass::Local;
+            return cls;
+        }
+
+        void end_wait() {
+            m_waiting.fetch_sub(1);
+            m_started.fetch_add(1);
+            if (m_yielders.load() != 0) {
+                // Taking the mutex orders the wake-up after the yielder's check.
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_cv.notify_all();
+            }
+        }
+
+        std::atomic<std::size_t> m_waiting{0};      ///< Local writers inside mdbx_txn_begin().
+        std::atomic<std::uint64_t> m_started{0};    ///< Local waits ended so far.
+        std::atomic<std::size_t> m_yielders{0};     ///< Applies inside yield_to_local().
+        std::atomic<std::int64_t> m_slice_ms{0};
+        std::atomic<std::int64_t> m_yield_max_ms{50};
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        Stats m_stats;
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_COMMON_WRITER_SCHEDULER_HPP_INCLUDED
@@ -0,0 +1,371 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_COROUTINE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_COROUTINE_HPP_INCLUDED
+
+/// \file coroutine.hpp
+/// \brief Optional C++20 coroutine layer over the callback-based async APIs.
+/// \details
+/// The awaitables here are executor-neutral: an operation completes on the
+/// thread that finished it (the connection's writer thread, a transport's
+/// I/O thread, a timer) and, unless a \ref mdbxc::coro::Resumer is given,
+/// resumes the awaiting coroutine right there. Pass a resumer that posts the
+/// handle to your executor to continue on its threads instead. Without
+/// C++20 coroutine support the header only defines \c MDBXC_HAS_COROUTINES
+/// as 0.
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine) && defined(__has_include)
+#   if __has_include(<coroutine>)
+#       define MDBXC_HAS_COROUTINES 1
+#   endif
+#endif
+#ifndef MDBXC_HAS_COROUTINES
+/// \brief Non-zero when the C++20 coroutine layer is available.
+#define MDBXC_HAS_COROUTINES 0
+#endif
+
+#if MDBXC_HAS_COROUTINES
+
+#include "common.hpp"
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mdbxc {
+namespace coro {
+
+    /// \brief Continues a suspended coroutine, e.g. by posting it to an executor.
+    /// \details An empty resumer resumes inline on the completing thread.
+    using Resumer = std::function<void(std::coroutine_handle<>)>;
+
+    /// \brief Runs a callback after a delay; supplied by the caller's timer facility.
+    using Scheduler = std::function<void(std::chrono::milliseconds, std::function<void()>)>;
+
+    template<class T>
+    class Task;
+
+namespace detail {
+
+    template<class T>
+    struct CallbackState {
+        std::atomic<int> phase{0}; ///< 0 pending, 1 completed, 2 suspended.
+        std::coroutine_handle<> handle;
+        Resumer resume;
+        std::exception_ptr error;
+        std::optional<T> value;
+    };
+
+    template<>
+    struct CallbackState<void> {
+        std::atomic<int> phase{0};
+        std::coroutine_handle<> handle;
+        Resumer resume;
+        std::exception_ptr error;
+    };
+
+    /// \brief Marks \p state completed and resumes the awaiter if it already suspended.
+    template<class T>
+    void complete(const std::shared_ptr<CallbackState<T>>& state) {
+        if (state->phase.exchange(1, std::memory_order_acq_rel) != 2) {
+            return; // await_suspend() sees the result and does not suspend.
+        }
+        if (state->resume) {
+            state->resume(state->handle);
+        } else {
+            state->handle.resume();
+        }
+    }
+
+    template<class T>
+    struct CallbackSignature {
+        using type = std::function<void(std::exception_ptr, T)>;
+
+        static type make(std::shared_ptr<CallbackState<T>> state) {
+            return [state](std::exception_ptr error, T value) {
+                if (error) {
+                    state->error = error;
+                } else {
+                    state->value.emplace(std::move(value));
+                }
+                complete(state);
+            };
+        }
+    };
+
+    template<>
+    struct CallbackSignature<void> {
+        using type = std::function<void(std::exception_ptr)>;
+
+        static type make(std::shared_ptr<CallbackState<void>> state) {
+            return [state](std::exception_ptr error) {
+                state->error = error;
+                complete(state);
+            };
+        }
+    };
+
+} // namespace detail
+
+    /// \class CallbackAwaiter
+    /// \brief Awaits an operation that reports its outcome to a completion callback.
+    /// \details The starter receives the callback, <tt>void(std::exception_ptr, T)</tt>
+    /// or <tt>void(std::exception_ptr)</tt> for \c void, and must arrange for
+    /// it to be called exactly once. A callback that runs before the starter
+    /// returns does not suspend the coroutine. Awaiting yields the value or
+    /// rethrows the reported error.
+    template<class T>
+    class CallbackAwaiter {
+    public:
+        using Callback = typename detail::CallbackSignature<T>::type;
+        using Starter = std::function<void(Callback)>;
+
+        CallbackAwaiter(Starter start, Resumer resume = Resumer())
+            : m_start(std::move(start)),
+              m_state(std::make_shared<detail::CallbackState<T>>()) {
+            m_state->resume = std::move(resume);
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            m_state->handle = handle;
+            m_start(detail::CallbackSignature<T>::make(m_state));
+            return m_state->phase.exchange(2, std::memory_order_acq_rel) == 0;
+        }
+
+        T await_resume() {
+            if (m_state->error) {
+                std::rethrow_exception(m_state->error);
+            }
+            if constexpr (std::is_void<T>::value) {
+                return;
+            } else {
+                return std::move(*m_state->value);
+            }
+        }
+
+    private:
+        Starter m_start;
+        std::shared_ptr<detail::CallbackState<T>> m_state;
+    };
+
+    /// \brief Awaits a grouped write on the connection's writer thread.
+    /// \details Queues \p action with \c Connection::async_write() and resumes
+    /// once its transaction committed, rethrowing the action's or the
+    /// commit's error. The awaiting thread is never blocked, so thousands of
+    /// coroutines can wait on one writer thread. Tables are written by
+    /// passing the received \c MDBX_txn* to their methods.
+    /// \param conn Connection whose writer thread runs \p action.
+    /// \param action Callable receiving the grouped \c MDBX_txn*; everything it
+    ///        references must outlive the await.
+    /// \param resume Optional resumer; by default the coroutine continues on
+    ///        the writer thread.
+    inline CallbackAwaiter<void> write(Connection& conn,
+                                       std::function<void(MDBX_txn*)> action,
+                                       Resumer resume = Resumer()) {
+        Connection* target = &conn;
+        return CallbackAwaiter<void>(
+            [target, action](std::function<void(std::exception_ptr)> done) {
+                target->async_write(action, std::move(done));
+            },
+            std::move(resume));
+    }
+
+    /// \brief Awaits \p delay on the caller's scheduler.
+    inline CallbackAwaiter<void> sleep_for(const Scheduler& scheduler,
+                                           std::chrono::milliseconds delay,
+                                           Resumer resume = Resumer()) {
+        Scheduler timer = scheduler;
+        return CallbackAwaiter<void>(
+            [timer, delay](std::function<void(std::exception_ptr)> done) {
+                timer(delay, [done]() { done(std::exception_ptr()); });
+            },
+            std::move(resume));
+    }
+
+namespace detail {
+
+    struct TaskPromiseBase {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr error;
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            template<class PromiseT>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> handle) noexcept {
+                std::coroutine_handle<> next = handle.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+
+    template<class T>
+    struct TaskPromise : TaskPromiseBase {
+        std::optional<T> value;
+
+        Task<T> get_return_object() noexcept;
+
+        template<class U>
+        void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+        T result() {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return std::move(*value);
+        }
+    };
+
+    template<>
+    struct TaskPromise<void> : TaskPromiseBase {
+        Task<void> get_return_object() noexcept;
+
+        void return_void() noexcept {}
+
+        void result() {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    };
+
+} // namespace detail
+
+    /// \class Task
+    /// \brief Lazily started coroutine returning \c T.
+    /// \details The body starts when the task is awaited, and the awaiting
+    /// coroutine continues when it finishes. Use \ref spawn() or
+    /// \ref sync_wait() to start a task from ordinary code.
+    template<class T = void>
+    class Task {
+    public:
+        using promise_type = detail::TaskPromise<T>;
+
+        Task() noexcept = default;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+            : m_handle(handle) {}
+
+        Task(Task&& other) noexcept
+            : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (m_handle) m_handle.destroy();
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task() {
+            if (m_handle) m_handle.destroy();
+        }
+
+        bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            m_handle.promise().continuation = awaiting;
+            return m_handle;
+        }
+
+        T await_resume() {
+            if (!m_handle) {
+                throw std::logic_error("mdbxc::coro::Task: awaiting an empty task");
+            }
+            return m_handle.promise().result();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+namespace detail {
+
+    template<class T>
+    Task<T> TaskPromise<T>::get_return_object() noexcept {
+        return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+        return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+    }
+
+    /// \brief Eagerly started coroutine that destroys itself when done.
+    struct DetachedTask {
+        struct promise_type {
+            DetachedTask get_return_object() const noexcept { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+    };
+
+    template<class T>
+    DetachedTask run_detached(Task<T> task, std::function<void(std::exception_ptr)> done) {
+        std::exception_ptr error;
+        try {
+            co_await std::move(task);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        if (done) {
+            try { done(error); } catch (...) {}
+        }
+    }
+
+} // namespace detail
+
+    /// \brief Starts \p task on the calling thread and lets it run to completion on its own.
+    /// \param task Task to run; its frame is destroyed when it finishes.
+    /// \param done Optional callback receiving the task's error, if any.
+    template<class T>
+    void spawn(Task<T> task, std::function<void(std::exception_ptr)> done = {}) {
+        detail::run_detached(std::move(task), std::move(done));
+    }
+
+    /// \brief Runs \p task and blocks the calling thread until it finishes.
+    /// \details For tests and for bridging into blocking code; the task must
+    /// complete on another thread or inline, never on the blocked one.
+    template<class T>
+    T sync_wait(Task<T> task) {
+        std::promise<T> result;
+        std::future<T> future = result.get_future();
+        auto body = [](Task<T> inner, std::promise<T>& out) -> Task<void> {
+            if constexpr (std::is_void<T>::value) {
+                co_await std::move(inner);
+                out.set_value();
+            } else {
+                out.set_value(co_await std::move(inner));
+            }
+        };
+        spawn(body(std::move(task), result),
+              [&result](std::exception_ptr error) {
+                  if (error) result.set_exception(error);
+              });
+        return future.get();
+    }
+
+} // namespace coro
+} // namespace mdbxc
+
+#endif // MDBXC_HAS_COROUTINES
+
+#endif // MDBX_CONTAINERS_HEADER_COROUTINE_HPP_INCLUDED
@@ -0,0 +1,158 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_BACKUP_PIPE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_BACKUP_PIPE_HPP_INCLUDED
+
+/// \file detail/BackupPipe.hpp
+/// \brief Anonymous pipe used to stream \c mdbx_env_copy2fd() output.
+/// \details
+/// MDBX writes the copy into the write end on a helper thread while
+/// \c Connection::backup_to_stream() reads the other end and forwards chunks
+/// to the caller. Closing the read end early makes the writer fail instead of
+/// blocking forever; on POSIX the helper thread blocks \c SIGPIPE so that
+/// failure surfaces as \c EPIPE rather than a signal.
+
+#include <cerrno>
+#include <cstddef>
+
+#include <mdbx.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace mdbxc {
+namespace detail {
+
+    /// \class BackupPipe
+    /// \brief Owns both ends of an anonymous pipe.
+    /// \thread_safety Each end is used by one thread at a time.
+    class BackupPipe {
+    public:
+        BackupPipe() = default;
+        BackupPipe(const BackupPipe&) = delete;
+        BackupPipe& operator=(const BackupPipe&) = delete;
+
+        ~BackupPipe() {
+            close_read();
+            close_write();
+        }
+
+        /// \brief Creates the pipe.
+        /// \return \c MDBX_SUCCESS or a system error code.
+        int open() noexcept {
+#           ifdef _WIN32
+            if (!CreatePipe(&m_read, &m_write, nullptr, 0)) {
+                return static_cast<int>(GetLastError());
+            }
+#           else
+            int fds[2];
+            if (::pipe(fds) != 0) return errno;
+            m_read = fds[0];
+            m_write = fds[1];
+#           endif
+            return MDBX_SUCCESS;
+        }
+
+        /// \brief Returns the write end for \c mdbx_env_copy2fd().
+        mdbx_filehandle_t write_handle() const noexcept { return m_write; }
+
+        /// \brief Reads up to \p size bytes.
+        /// \param got Bytes read; 0 at end of stream.
+        /// \return \c MDBX_SUCCESS or a system error code.
+        int read(void* buffer, std::size_t size, std::size_t& got) noexcept {
+            got = 0;
+#           ifdef _WIN32
+            DWORD n = 0;
+            if (!ReadFile(m_read, buffer, static_cast<DWORD>(size), &n, nullptr)) {
+                const DWORD error = GetLastError();
+                return error == ERROR_BROKEN_PIPE ? MDBX_SUCCESS : static_cast<int>(error);
+            }
+            got = static_cast<std::size_t>(n);
+            return MDBX_SUCCESS;
+#           else
+            for (;;) {
+                const ssize_t n = ::read(m_read, buffer, size);
+                if (n >= 0) {
+                    got = static_cast<std::size_t>(n);
+                    return MDBX_SUCCESS;
+                }
+                if (errno != EINTR) return errno;
+            }
+#           endif
+        }
+
+        /// \brief Closes the read end; a blocked writer then fails.
+        void close_read() noexcept {
+            if (m_read == invalid_handle()) return;
+#           ifdef _WIN32
+            CloseHandle(m_read);
+#           else
+            ::close(m_read);
+#           endif
+            m_read = invalid_handle();
+        }
+
+        /// \brief Closes the write end; the reader then sees end of stream.
+        void close_write() noexcept {
+            if (m_write == invalid_handle()) return;
+#           ifdef _WIN32
+            CloseHandle(m_write);
+#           else
+            ::close(m_write);
+#           endif
+            m_write = invalid_handle();
+        }
+
+        /// \brief Makes writes to a closed pipe fail with \c EPIPE on the calling thread.
+        static void ignore_broken_pipe_signal() noexcept {
+#           ifndef _WIN32
+            sigset_t set;
+            sigemptyset(&set);
+            sigaddset(&set, SIGPIPE);
+            pthread_sigmask(SIG_BLOCK, &set, nullptr);
+#           endif
+        }
+
+        /// \brief Writes all of \p size bytes to \p handle.
+        /// \return \c MDBX_SUCCESS or a system error code.
+        static int write_all(mdbx_filehandle_t handle, const void* data, std::size_t size) noexcept {
+            const char* ptr = static_cast<const char*>(data);
+            while (size > 0) {
+#               ifdef _WIN32
+                DWORD written = 0;
+                if (!WriteFile(handle, ptr, static_cast<DWORD>(size), &written, nullptr)) {
+                    return static_cast<int>(GetLastError());
+                }
+#               else
+                const ssize_t written = ::write(handle, ptr, size);
+                if (written < 0) {
+                    if (errno == EINTR) continue;
+                    return errno;
+                }
+#               endif
+                ptr += written;
+                size -= static_cast<std::size_t>(written);
+            }
+            return MDBX_SUCCESS;
+        }
+
+    private:
+        static mdbx_filehandle_t invalid_handle() noexcept {
+#           ifdef _WIN32
+            return INVALID_HANDLE_VALUE;
+#           else
+            return -1;
+#           endif
+        }
+
+        mdbx_filehandle_t m_read = invalid_handle();
+        mdbx_filehandle_t m_write = invalid_handle();
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_BACKUP_PIPE_HPP_INCLUDED
@@ -5,22 +5,33 @@
 /// \file BaseTable.hpp
 /// \brief Base class for working with MDBX databases (tables).
 
+#include <atomic>
 #include <cstdint>
 
 #ifndef MDBXC_SYNC_ENABLED
 #define MDBXC_SYNC_ENABLED 0
 #endif
 
+#ifndef MDBXC_METRICS_ENABLED
+#define MDBXC_METRICS_ENABLED 0
+#endif
+
 #include <string>
 #include <vector>
 
 namespace mdbxc {
+
+    namespace detail {
+        template<class KeyT, class Options> class KeySetJoin;
+    } // namespace detail
     
     /// \class BaseTable
     /// \ingroup mdbxc_core
     /// \brief Base class providing common functionality for MDBX database access.
     ///
     /// Opens or creates a table (DBI handle) and offers basic transaction management.
+    /// The handle comes from \ref Connection::open_dbi(), so constructing
+    /// another wrapper over an already opened DBI starts no transaction.
     /// In read-only connections, opens an existing DBI in a read-only
     /// transaction and ignores `MDBX_CREATE`.
     ///
@@ -33,6 +44,7 @@ namespace mdbxc {
     /// through separate wrapper instances while the shared Connection lifecycle
     /// remains stable.
     class BaseTable {
+        template<class KeyT, class Options> friend class detail::KeySetJoin;
     public:
         /// \brief Construct the database table accessor.
         /// \param connection Shared MDBX connection.
@@ -46,28 +58,48 @@ namespace mdbxc {
                 throw std::invalid_argument(
                     "MDBX Containers table name uses reserved internal prefix '_mdbxc_'");
             }
-            bool read_only = m_connection->is_read_only();
-            MDBX_db_flags_t open_flags = read_only
-                ? static_cast<MDBX_db_flags_t>(flags & ~MDBX_CREATE)
-                : flags;
-            auto txn = m_connection->transaction(
-                read_only ? TransactionMode::READ_ONLY : TransactionMode::WRITABLE
-            );
-            check_mdbx(
-                mdbx_dbi_open(txn.handle(), m_name.c_str(), open_flags, &m_dbi),
-                "Failed to open table"
-            );
-            unsigned dbi_flags = 0;
-            check_mdbx(
-                mdbx_dbi_flags(txn.handle(), m_dbi, &dbi_flags),
-                "Failed to read table flags"
-            );
-            m_dbi_flags = static_cast<std::uint32_t>(dbi_flags);
-            txn.commit();
+            m_dbi = m_connection->open_dbi(m_name, flags, &m_dbi_flags);
         }
         
-        virtual ~BaseTable() = default;
-        
+        /// \brief Copies the table accessor; the copy starts with an empty cursor cache.
+        BaseTable(const BaseTable& other)
+            : m_connection(other.m_connection), m_dbi(other.m_dbi),
+              m_dbi_flags(other.m_dbi_flags), m_name(other.m_name) {}
+
+        /// \brief Moves the table accessor together with its idle cached cursor.
+        BaseTable(BaseTable&& other) noexcept
+            : m_connection(std::move(other.m_connection)), m_dbi(other.m_dbi),
+              m_dbi_flags(other.m_dbi_flags), m_name(std::move(other.m_name)),
+              m_cursor_cache(other.m_cursor_cache.exchange(nullptr, std::memory_order_acq_rel)) {}
+
+        /// \brief Copies the table accessor; the cached cursor is closed, not shared.
+        BaseTable& operator=(const BaseTable& other) {
+            if (this != &other) {
+                m_connection = other.m_connection;
+                m_dbi = other.m_dbi;
+                m_dbi_flags = other.m_dbi_flags;
+                m_name = other.m_name;
+                reset_cursor_cache(nullptr);
+            }
+            return *this;
+        }
+
+        /// \brief Moves the table accessor together with its idle cached cursor.
+        BaseTable& operator=(BaseTable&& other) noexcept {
+            if (this != &other) {
+                m_connection = std::move(other.m_connection);
+                m_dbi = other.m_dbi;
+                m_dbi_flags = other.m_dbi_flags;
+                m_name = std::move(other.m_name);
+                reset_cursor_cache(other.m_cursor_cache.exchange(nullptr, std::memory_order_acq_rel));
+            }
+            return *this;
+        }
+
+        virtual ~BaseTable() {
+            reset_cursor_cache(nullptr);
+        }
+
         /// \brief Checks if the connection is currently active.
         /// \return true if connected, false otherwise.
         bool is_connected() const {
@@ -151,10 +183,164 @@ namespace mdbxc {
             CursorGuard& operator=(CursorGuard&&) = delete;
         };
 
+        /// \brief Cursor borrowed from the table's one-slot cursor cache.
+        /// \details Recycles one \c mdbx_cursor_create() cursor across helper
+        /// calls by rebinding it with \c mdbx_cursor_bind() instead of paying
+        /// \c mdbx_cursor_open()/close each time. When the slot is taken (nested
+        /// use) a fresh cursor is created and closed or cached on release.
+        /// The cursor is unbound on release, so each borrow starts unpositioned
+        /// exactly like a newly opened cursor.
+        class CachedCursor {
+        public:
+            CachedCursor(const BaseTable& table, MDBX_txn* txn)
+                : m_table(table), m_cursor(table.acquire_cursor(txn)) {}
+            ~CachedCursor() noexcept { m_table.release_cursor(m_cursor); }
+
+            MDBX_cursor* get() const noexcept { return m_cursor; }
+
+            CachedCursor(const CachedCursor&) = delete;
+            CachedCursor& operator=(const CachedCursor&) = delete;
+
+        private:
+            const BaseTable& m_table;
+            MDBX_cursor*     m_cursor;
+        };
+
+#       if MDBXC_METRICS_ENABLED
+        /// \brief Reports one operation of this table to the connection's \c ITableObserver.
+        /// \details Reads the clock only when an observer is attached. The event
+        /// is sent on scope exit, including when the operation throws.
+        class OperationTimer {
+        public:
+            OperationTimer(const BaseTable& table, TableOperation op) noexcept
+                : m_table(table), m_observer(table.m_connection->table_observer()), m_op(op) {
+                if (m_observer) m_start = std::chrono::steady_clock::now();
+            }
+
+            ~OperationTimer() noexcept {
+                if (!m_observer) return;
+                try {
+                    m_observer->on_table_operation(
+                        m_table.m_name, m_op, bytes,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - m_start));
+                } catch (...) {
+                    // Metrics must not change table behavior.
+                }
+            }
+
+            /// \brief Offers the serialized key of this operation to the
+            /// connection's \c KeyAccessSampler, if one is attached.
+            void sample_key(const MDBX_val& key) const noexcept {
+                KeyAccessSampler* sampler = m_table.m_connection->key_sampler();
+                if (!sampler) return;
+                try {
+                    sampler->offer(m_table.m_name, m_op, key.iov_base, key.iov_len);
+                } catch (...) {
+                    // Metrics must not change table behavior.
+                }
+            }
+
+            std::size_t bytes = 0; ///< Key and value bytes to report.
+
+            OperationTimer(const OperationTimer&) = delete;
+            OperationTimer& operator=(const OperationTimer&) = delete;
+
+        private:
+            const BaseTable& m_table;
+            ITableObserver*  m_observer;
+            TableOperation   m_op;
+            std::chrono::steady_clock::time_point m_start;
+        };
+#       endif
+
         std::shared_ptr<Connection>  m_connection;   ///< Shared connection to MDBX environment.
         MDBX_dbi                     m_dbi{};         ///< DBI handle for the opened table.
         std::uint32_t                m_dbi_flags{};   ///< Persistent MDBX DBI flags for sync capture.
         std::string                  m_name;          ///< DBI name (used for sync capture).
+        mutable std::atomic<MDBX_cursor*> m_cursor_cache{nullptr}; ///< Idle cursor reused by CachedCursor.
+
+        /// \brief Takes the cached cursor (or creates one) and binds it to \p txn.
+        /// \throws MdbxException if the cursor cannot be created or bound.
+        MDBX_cursor* acquire_cursor(MDBX_txn* txn) const {
+            MDBX_cursor* cursor = m_cursor_cache.exchange(nullptr, std::memory_order_acquire);
+            if (!cursor) {
+                cursor = mdbx_cursor_create(nullptr);
+                if (!cursor) {
+                    check_mdbx(MDBX_ENOMEM, "Failed to create MDBX cursor");
+                }
+            }
+            const int rc = mdbx_cursor_bind(txn, cursor, m_dbi);
+            if (rc != MDBX_SUCCESS) {
+                mdbx_cursor_close(cursor);
+                check_mdbx(rc, "Failed to bind MDBX cursor");
+            }
+            return cursor;
+        }
+
+        /// \brief Stores \p cursor in the cache slot and closes the previous idle cursor.
+        void reset_cursor_cache(MDBX_cursor* cursor) noexcept {
+            MDBX_cursor* previous = m_cursor_cache.exchange(cursor, std::memory_order_acq_rel);
+            if (previous) mdbx_cursor_close(previous);
+        }
+
+        /// \brief Unbinds a cursor and returns it to the cache slot.
+        /// \details Closes the cursor instead when unbinding fails or the slot is full.
+        void release_cursor(MDBX_cursor* cursor) const noexcept {
+            MDBX_cursor* expected = nullptr;
+            if (mdbx_cursor_unbind(cursor) != MDBX_SUCCESS ||
+                !m_cursor_cache.compare_exchange_strong(expected, cursor,
+                                                        std::memory_order_release,
+                                                        std::memory_order_relaxed)) {
+                mdbx_cursor_close(cursor);
+            }
+        }
+
+        /// \brief Estimates the number of pairs in an inclusive key range.
+        /// \details Uses \c mdbx_estimate_range() for <tt>[from, to)</tt>, which walks
+        /// only the B-tree paths to both bounds, and adds the exact number of
+        /// values stored under \p to. The result is approximate for large ranges.
+        /// \param txn Active transaction.
+        /// \param from Serialized start key.
+        /// \param to Serialized end key.
+        /// \return Estimated pair count, \c 0 when \p from sorts after \p to.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t estimate_range_items(MDBX_txn* txn, const MDBX_val& from, const MDBX_val& to) const {
+            if (mdbx_cmp(txn, m_dbi, &from, &to) > 0) return 0;
+            ptrdiff_t items = 0;
+            check_mdbx(mdbx_estimate_range(txn, m_dbi, &from, nullptr, &to, nullptr, &items),
+                       "Failed to estimate range");
+            std::size_t result = items > 0 ? static_cast<std::size_t>(items) : 0;
+
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key = to;
+            MDBX_val db_val;
+            int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET);
+            if (rc == MDBX_NOTFOUND) return result;
+            check_mdbx(rc, "Failed to seek range end for estimate");
+            std::size_t dups = 0;
+            check_mdbx(mdbx_cursor_count(cursor.get(), &dups), "Failed to count range end values");
+            return result + dups;
+        }
+
+        /// \brief Scales a pair estimate to bytes using the DBI page statistics.
+        /// \details The average footprint is taken from leaf and overflow pages
+        /// divided by the number of entries, so it includes page overhead and
+        /// large values stored out of line.
+        /// \param txn Active transaction.
+        /// \param items Estimated pair count, e.g. from \ref estimate_range_items().
+        /// \return Estimated storage size in bytes.
+        /// \throws MdbxException if a database error occurs.
+        std::uint64_t estimate_range_bytes(MDBX_txn* txn, std::size_t items) const {
+            if (items == 0) return 0;
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat)), "Failed to query database statistics");
+            if (stat.ms_entries == 0) return 0;
+            const long double pages = static_cast<long double>(stat.ms_leaf_pages + stat.ms_overflow_pages);
+            const long double bytes = pages * stat.ms_psize * static_cast<long double>(items) /
+                                      static_cast<long double>(stat.ms_entries);
+            return static_cast<std::uint64_t>(bytes);
+        }
 
         /// \brief Returns the transaction bound to the current thread, if any.
         /// \return Pointer to the MDBX transaction or nullptr.
@@ -162,6 +348,179 @@ namespace mdbxc {
                 return m_connection->thread_txn();
         }
 
+        /// \brief Routes an auto-transaction write through group commit when enabled.
+        /// \param action Functor accepting \c MDBX_txn*; it may run on another thread
+        ///        while the caller waits.
+        /// \param mode Mode the caller would open; only writable actions are grouped.
+        /// \return true if \p action ran and committed through the group-commit queue.
+        template<typename F>
+        bool try_group_write(F& action, TransactionMode mode) const {
+            if (mode != TransactionMode::WRITABLE || !m_connection->group_commit_enabled()) {
+                return false;
+            }
+            m_connection->write_grouped([&action](MDBX_txn* t) { action(t); });
+            return true;
+        }
+
+        /// \brief Runs a Status-returning functor within a transaction context.
+        /// \details The \c std::nothrow_t table calls run through this instead
+        /// of \c with_transaction(). A failure to begin or commit an own
+        /// transaction is returned, not thrown, and a failed \p action rolls
+        /// the own transaction back; \c KeyExists and \c NotFound still commit.
+        /// A grouped write reports a failed \p action through the group as an
+        /// exception, so that only that action is dropped from the batch.
+        /// \param action Functor accepting \c MDBX_txn* and returning \ref Status.
+        /// \param mode Mode the caller would open.
+        /// \param txn Optional existing transaction handle.
+        template<typename F>
+        Status with_transaction_status(F&& action, TransactionMode mode, MDBX_txn* txn) const {
+            if (txn) return action(checked_external_txn(txn));
+            txn = thread_txn();
+            if (txn) return action(txn);
+            if (mode == TransactionMode::WRITABLE && m_connection->group_commit_enabled()) {
+                Status status;
+                m_connection->write_grouped([&action, &status](MDBX_txn* t) {
+                    status = action(t);
+                    if (status.failed()) check_status(status);
+                });
+                return status;
+            }
+            Status status;
+            Transaction txn_guard = m_connection->transaction(std::nothrow, mode, status);
+            if (!status) return status;
+            status = action(txn_guard.handle());
+            if (status.failed()) return status;
+            const Status committed = txn_guard.commit(std::nothrow);
+            return committed ? status : committed;
+        }
+
+        /// \brief Called by \ref db_reconcile_sorted_chunk() before it changes a record.
+        /// \details Lets a derived table update data derived from stored
+        /// values, such as secondary indexes. \p old_val is \c nullptr for an
+        /// insert and \p new_val for a delete. The views are valid only until
+        /// the hook writes to the transaction.
+        virtual void before_sorted_reconcile_write(MDBX_txn* txn, const MDBX_val& key,
+                                                   const MDBX_val* old_val,
+                                                   const MDBX_val* new_val) const {
+            (void)txn;
+            (void)key;
+            (void)old_val;
+            (void)new_val;
+        }
+
+        /// \brief Runs one write chunk of a sorted merge-join reconcile.
+        /// \details Walks the table cursor and the input stream in key order:
+        /// table keys missing from the input are deleted, input records missing
+        /// from the table or with a different serialized value are written, and
+        /// equal records are skipped. Stops after \p chunk_size changes.
+        /// \param txn Active write transaction.
+        /// \param it Input position; advanced past every consumed record.
+        /// \param last Input end.
+        /// \param chunk_size Maximum number of changes in this chunk.
+        /// \param encode Invoked as \c encode(record, MDBX_val& key, MDBX_val& value);
+        ///        the views must stay valid until the next call.
+        /// \param state Resume position shared between chunks.
+        /// \param stats Counters updated in place.
+        /// \return \c true when both the table and the input are exhausted.
+        /// \throws std::invalid_argument if input keys are not strictly ascending.
+        /// \throws MdbxException if a database error occurs.
+        template<typename InputIt, typename EncodeT>
+        bool db_reconcile_sorted_chunk(MDBX_txn* txn, InputIt& it, const InputIt& last,
+                                       std::size_t chunk_size, EncodeT& encode,
+                                       detail::SortedReconcileState& state,
+                                       ReconcileProgress& stats) const {
+            CachedCursor cursor(*this, txn);
+            MDBX_val db_key;
+            MDBX_val db_val;
+            // Positions the cursor on the first table key after `bytes`.
+            auto seek_after = [&cursor, &db_key, &db_val](const std::vector<std::uint8_t>& bytes) -> int {
+                db_key.iov_base = bytes.empty() ? nullptr : const_cast<std::uint8_t*>(bytes.data());
+                db_key.iov_len = bytes.size();
+                int rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_SET_RANGE);
+                if (rc == MDBX_SUCCESS && db_key.iov_len == bytes.size() &&
+                    (bytes.empty() || std::memcmp(db_key.iov_base, bytes.data(), bytes.size()) == 0)) {
+                    rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+                }
+                return rc;
+            };
+            auto remember = [](std::vector<std::uint8_t>& out, const MDBX_val& val) {
+                const std::uint8_t* begin = static_cast<const std::uint8_t*>(val.iov_base);
+                out.assign(begin, begin + val.iov_len);
+            };
+
+            int rc = state.has_resume
+                ? seek_after(state.resume)
+                : mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_FIRST);
+            std::size_t changes = 0;
+            while (changes < chunk_size) {
+                if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to iterate table during sorted reconcile");
+                }
+                const bool db_end = rc == MDBX_NOTFOUND;
+                const bool in_end = !(it != last);
+                if (db_end && in_end) return true;
+
+                MDBX_val in_key;
+                MDBX_val in_val;
+                int order = db_end ? 1 : -1;
+                if (!in_end) {
+                    encode(*it, in_key, in_val);
+                    if (state.has_last_input) {
+                        MDBX_val prev;
+                        prev.iov_base = state.last_input.empty() ? nullptr : state.last_input.data();
+                        prev.iov_len = state.last_input.size();
+                        if (mdbx_cmp(txn, m_dbi, &prev, &in_key) >= 0) {
+                            throw std::invalid_argument(
+                                "reconcile_sorted: input keys must be strictly ascending");
+                        }
+                    }
+                    if (!db_end) order = mdbx_cmp(txn, m_dbi, &db_key, &in_key);
+                }
+
+                if (order < 0) {
+                    remember(state.resume, db_key);
+                    state.has_resume = true;
+                    before_sorted_reconcile_write(txn, db_key, &db_val, nullptr);
+                    check_mdbx(mdbx_cursor_del(cursor.get(), MDBX_CURRENT),
+                               "Failed to delete record during sorted reconcile");
+#                   if MDBXC_SYNC_ENABLED
+                    record_op(txn, sync::ChangeOpType::Delete, state.resume, MDBX_val());
+#                   endif
+                    ++stats.erased;
+                    ++changes;
+                    rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+                    continue;
+                }
+
+                remember(state.last_input, in_key);
+                state.has_last_input = true;
+                state.resume = state.last_input;
+                state.has_resume = true;
+                const bool differs = order > 0 || db_val.iov_len != in_val.iov_len ||
+                    (in_val.iov_len != 0 && std::memcmp(db_val.iov_base, in_val.iov_base, in_val.iov_len) != 0);
+                if (differs) {
+                    before_sorted_reconcile_write(txn, in_key, order > 0 ? nullptr : &db_val, &in_val);
+                    check_mdbx(mdbx_put(txn, m_dbi, &in_key, &in_val, MDBX_UPSERT),
+                               "Failed to write record during sorted reconcile");
+#                   if MDBXC_SYNC_ENABLED
+                    record_op(txn, sync::ChangeOpType::Put, in_key, in_val);
+#                   endif
+                    if (order > 0) ++stats.inserted; else ++stats.updated;
+                    ++changes;
+                    // The put may move the cursor; continue after the written key.
+                    rc = seek_after(state.resume);
+                } else {
+                    rc = mdbx_cursor_get(cursor.get(), &db_key, &db_val, MDBX_NEXT);
+                }
+                ++stats.scanned;
+                ++it;
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "Failed to iterate table during sorted reconcile");
+            }
+            return rc == MDBX_NOTFOUND && !(it != last);
+        }
+
         /// \brief Validates a caller-supplied transaction for this table env.
         MDBX_txn* checked_external_txn(MDBX_txn* txn) const {
             return checked_txn_env(txn,
@@ -197,17 +556,34 @@ namespace mdbxc {
 
         /// \brief Forwards a successful write to the attached sync capture sink.
         /// \details Called from derived table \c db_* helpers right after a
-        /// successful \c mdbx_put / \c mdbx_del. No-op when no sink is attached
-        /// or when the connection is read-only.
+        /// successful \c mdbx_put / \c mdbx_del, with the key and value
+        /// buffers that were passed to MDBX; the sink encodes them straight
+        /// into its per-transaction arena. Keys read from a cursor must be
+        /// copied with \c capture_bytes() before \c mdbx_cursor_del, which
+        /// may invalidate them. No-op when no sink is attached or when the
+        /// connection is read-only.
         void record_op(MDBX_txn* txn,
                        sync::ChangeOpType op_type,
-                       const std::vector<std::uint8_t>& storage_key,
-                       const std::vector<std::uint8_t>& value) const {
+                       const MDBX_val& storage_key,
+                       const MDBX_val& value) const {
             if (m_connection->is_read_only()) return;
             sync::ISyncCaptureSink* sink = m_connection->sync_capture();
             if (sink == nullptr) return;
-            sink->record_change(txn, m_name, op_type, m_dbi_flags,
-                                storage_key, value);
+            sink->record_change_view(txn, m_name, op_type, m_dbi_flags,
+                                     storage_key, value);
+        }
+
+        /// \brief Forwards a write whose key was copied before the delete.
+        void record_op(MDBX_txn* txn,
+                       sync::ChangeOpType op_type,
+                       const std::vector<std::uint8_t>& storage_key,
+                       const MDBX_val& value) const {
+            MDBX_val key;
+            key.iov_base = storage_key.empty()
+                ? nullptr
+                : const_cast<std::uint8_t*>(&storage_key[0]);
+            key.iov_len = storage_key.size();
+            record_op(txn, op_type, key, value);
         }
 #       endif
     };
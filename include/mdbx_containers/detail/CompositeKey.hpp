@@ -0,0 +1,258 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_COMPOSITE_KEY_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_COMPOSITE_KEY_HPP_INCLUDED
+
+/// \file CompositeKey.hpp
+/// \brief Order-preserving encoding of \c std::pair and \c std::tuple keys.
+/// \details Fields are encoded one after another so that \c memcmp over the
+/// result orders keys like \c std::tuple's \c operator<:
+/// - integers: big-endian, with the sign bit flipped for signed types
+///   (character code units are unsigned); \c bool is one byte;
+/// - \c float and \c double: big-endian \c sortable_key_from_float() /
+///   \c sortable_key_from_double() bits, NaN rejected;
+/// - strings and byte vectors: bytes with each \c 0x00 written as
+///   \c 0x00 \c 0xFF, terminated by \c 0x00 \c 0x01;
+/// - nested pairs and tuples: their fields in order.
+///
+/// Every field is self-delimiting, so the encoding of the first fields of a
+/// key is a byte prefix of the whole key. Composite keys never use
+/// \c MDBX_INTEGERKEY, and their width differs from \c serialize_key() of
+/// the same field type alone.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utils.hpp"
+
+namespace mdbxc {
+
+    namespace detail {
+
+        template<std::size_t I, std::size_t N>
+        struct composite_key_fields;
+
+        inline void composite_key_truncated() {
+            throw std::runtime_error("deserialize_key: truncated composite key");
+        }
+
+        template<typename T>
+        typename std::enable_if<std::is_same<T, bool>::value>::type
+        append_composite_field(const T& value, std::vector<uint8_t>& out) {
+            out.push_back(value ? 1u : 0u);
+        }
+
+        template<typename T>
+        typename std::enable_if<is_key_integral<T>::value && !std::is_same<T, bool>::value>::type
+        append_composite_field(const T& value, std::vector<uint8_t>& out) {
+            typedef typename make_key_unsigned<T>::type UnsignedT;
+            UnsignedT bits = 0;
+            std::memcpy(&bits, &value, sizeof(T));
+            if (is_key_signed_integral<T>::value && !is_key_character_code_unit<T>::value) {
+                bits ^= UnsignedT(1) << (sizeof(T) * 8u - 1u);
+            }
+            for (std::size_t i = sizeof(T); i-- > 0;) {
+                out.push_back(static_cast<uint8_t>(bits >> (i * 8u)));
+            }
+        }
+
+        template<typename T>
+        typename std::enable_if<std::is_same<T, float>::value>::type
+        append_composite_field(const T& value, std::vector<uint8_t>& out) {
+            append_composite_field(sortable_key_from_float(value), out);
+        }
+
+        template<typename T>
+        typename std::enable_if<std::is_same<T, double>::value>::type
+        append_composite_field(const T& value, std::vector<uint8_t>& out) {
+            append_composite_field(sortable_key_from_double(value), out);
+        }
+
+        template<typename T>
+        typename std::enable_if<is_byte_string_key<T>::value>::type
+        append_composite_field(const T& value, std::vector<uint8_t>& out) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(value.data());
+            for (std::size_t i = 0; i < value.size(); ++i) {
+                out.push_back(bytes[i]);
+                if (bytes[i] == 0u) out.push_back(0xFFu);
+            }
+            out.push_back(0x00u);
+            out.push_back(0x01u);
+        }
+
+        template<typename T>
+        typename std::enable_if<is_composite_key<T>::value>::type
+        append_composite_field(const T& value, std::vector<uint8_t>& out) {
+            composite_key_fields<0, std::tuple_size<T>::value>::append(value, out);
+        }
+
+        template<typename T>
+        typename std::enable_if<std::is_same<T, bool>::value>::type
+        read_composite_field(const uint8_t*& p, const uint8_t* end, T& out) {
+            if (p == end) composite_key_truncated();
+            if (*p > 1u) throw std::runtime_error("deserialize_key: invalid bool in composite key");
+            out = *p++ != 0u;
+        }
+
+        template<typename T>
+        typename std::enable_if<is_key_integral<T>::value && !std::is_same<T, bool>::value>::type
+        read_composite_field(const uint8_t*& p, const uint8_t* end, T& out) {
+            typedef typename make_key_unsigned<T>::type UnsignedT;
+            if (static_cast<std::size_t>(end - p) < sizeof(T)) composite_key_truncated();
+            UnsignedT bits = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i) {
+                bits = static_cast<UnsignedT>((bits << 8) | UnsignedT(*p++));
+            }
+            if (is_key_signed_integral<T>::value && !is_key_character_code_unit<T>::value) {
+                bits ^= UnsignedT(1) << (sizeof(T) * 8u - 1u);
+            }
+            std::memcpy(&out, &bits, sizeof(T));
+        }
+
+        template<typename T>
+        typename std::enable_if<std::is_same<T, float>::value>::type
+        read_composite_field(const uint8_t*& p, const uint8_t* end, T& out) {
+            uint32_t bits = 0;
+            read_composite_field(p, end, bits);
+            out = float_from_sortable_key(bits);
+        }
+
+        template<typename T>
+        typename std::enable_if<std::is_same<T, double>::value>::type
+        read_composite_field(const uint8_t*& p, const uint8_t* end, T& out) {
+            uint64_t bits = 0;
+            read_composite_field(p, end, bits);
+            out = double_from_sortable_key(bits);
+        }
+
+        template<typename T>
+        typename std::enable_if<is_byte_string_key<T>::value>::type
+        read_composite_field(const uint8_t*& p, const uint8_t* end, T& out) {
+            typedef typename T::value_type Byte;
+            out.clear();
+            for (;;) {
+                if (p == end) composite_key_truncated();
+                const uint8_t byte = *p++;
+                if (byte != 0u) {
+                    out.push_back(static_cast<Byte>(byte));
+                    continue;
+                }
+                if (p == end) composite_key_truncated();
+                const uint8_t escape = *p++;
+                if (escape == 0x01u) return;
+                if (escape != 0xFFu) {
+                    throw std::runtime_error("deserialize_key: invalid escape in composite key");
+                }
+                out.push_back(static_cast<Byte>(0));
+            }
+        }
+
+        template<typename T>
+        typename std::enable_if<is_composite_key<T>::value>::type
+        read_composite_field(const uint8_t*& p, const uint8_t* end, T& out) {
+            composite_key_fields<0, std::tuple_size<T>::value>::read(p, end, out);
+        }
+
+        template<std::size_t I, std::size_t N>
+        struct composite_key_fields {
+            template<typename T>
+            static void append(const T& key, std::vector<uint8_t>& out) {
+                append_composite_field(std::get<I>(key), out);
+                composite_key_fields<I + 1, N>::append(key, out);
+            }
+
+            template<typename T>
+            static void read(const uint8_t*& p, const uint8_t* end, T& key) {
+                read_composite_field(p, end, std::get<I>(key));
+                composite_key_fields<I + 1, N>::read(p, end, key);
+            }
+        };
+
+        template<std::size_t N>
+        struct composite_key_fields<N, N> {
+            template<typename T>
+            static void append(const T&, std::vector<uint8_t>&) {}
+
+            template<typename T>
+            static void read(const uint8_t*&, const uint8_t*, T&) {}
+        };
+
+    } // namespace detail
+
+    /// \brief Serializes a \c std::pair or \c std::tuple key in field order.
+    /// \details See \c CompositeKey.hpp for the encoding. A tuple of the
+    /// leading fields of a key serializes to a byte prefix of that key.
+    template<bool SafeIntegerKey = true, typename T>
+    typename std::enable_if<is_composite_key<T>::value, MDBX_val>::type
+    serialize_key(const T& key, SerializeScratch& sc) {
+        (void)SafeIntegerKey;
+        sc.bytes.clear();
+        detail::append_composite_field(key, sc.bytes);
+        return sc.view_bytes();
+    }
+
+    template<typename T>
+    typename std::enable_if<is_composite_key<T>::value, T>::type
+    deserialize_key(const MDBX_val& val) {
+        T out;
+        const uint8_t* p = static_cast<const uint8_t*>(val.iov_base);
+        const uint8_t* end = p + val.iov_len;
+        detail::read_composite_field(p, end, out);
+        if (p != end) {
+            throw std::runtime_error("deserialize_key: trailing bytes after composite key");
+        }
+        return out;
+    }
+
+    template<typename T>
+    typename std::enable_if<is_composite_key<T>::value, size_t>::type
+    get_key_size(const T& key) {
+        std::vector<uint8_t> bytes;
+        detail::append_composite_field(key, bytes);
+        return bytes.size();
+    }
+
+    /// \brief True when \p PrefixT holds the leading field types of composite key \p KeyT.
+    /// \details Such a prefix is accepted by the prefix scans of
+    /// \c KeyValueTable with a composite key.
+    template<typename PrefixT, typename KeyT, typename Enable = void>
+    struct is_composite_key_prefix {
+        static const bool value = false;
+    };
+
+    namespace detail {
+
+        template<std::size_t I, std::size_t N, typename PrefixT, typename KeyT>
+        struct composite_prefix_fields_match {
+            static const bool value =
+                std::is_same<typename std::tuple_element<I, PrefixT>::type,
+                             typename std::tuple_element<I, KeyT>::type>::value &&
+                composite_prefix_fields_match<I + 1, N, PrefixT, KeyT>::value;
+        };
+
+        template<std::size_t N, typename PrefixT, typename KeyT>
+        struct composite_prefix_fields_match<N, N, PrefixT, KeyT> {
+            static const bool value = true;
+        };
+
+    } // namespace detail
+
+    template<typename... Ps, typename KeyT>
+    struct is_composite_key_prefix<
+        std::tuple<Ps...>, KeyT,
+        typename std::enable_if<
+            is_composite_key<KeyT>::value && (sizeof...(Ps) > 0) &&
+            (sizeof...(Ps) <= std::tuple_size<KeyT>::value)>::type> {
+        static const bool value =
+            detail::composite_prefix_fields_match<0, sizeof...(Ps), std::tuple<Ps...>, KeyT>::value;
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_COMPOSITE_KEY_HPP_INCLUDED
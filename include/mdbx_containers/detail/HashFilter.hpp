@@ -0,0 +1,122 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_HASH_FILTER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_HASH_FILTER_HPP_INCLUDED
+
+/// \file detail/HashFilter.hpp
+/// \brief In-memory Bloom filter over 64-bit key hashes.
+/// \details
+/// Used by \ref mdbxc::HashedKeyValueStore to reject absent keys before any
+/// MDBX access. Bits are only ever set, so an aborted write leaves a harmless
+/// false positive and never a false negative. Erased keys keep their bits
+/// until the filter is rebuilt from the table.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace mdbxc {
+namespace detail {
+
+    /// \class HashFilter
+    /// \brief Fixed-size Bloom filter with lock-free insertion.
+    /// \thread_safety Thread-safe. \ref add() and \ref may_contain() may run concurrently.
+    class HashFilter {
+    public:
+        /// \brief Creates an empty filter.
+        /// \param expected_keys Number of hashes the filter is sized for.
+        /// \param bits_per_key Filter bits per expected hash; 10 gives about 1% false positives.
+        /// \param snapshot_txnid Oldest MDBX transaction id whose data the filter covers.
+        HashFilter(std::size_t expected_keys, std::size_t bits_per_key, std::uint64_t snapshot_txnid)
+            : m_words(), m_mask(0), m_probes(probes_for(bits_per_key)),
+              m_expected_keys(expected_keys), m_bits_per_key(bits_per_key),
+              m_snapshot_txnid(snapshot_txnid) {
+            std::uint64_t wanted = static_cast<std::uint64_t>(expected_keys) * bits_per_key;
+            std::uint64_t bits = 64;
+            while (bits < wanted && bits < (std::uint64_t(1) << 40)) {
+                bits <<= 1;
+            }
+            const std::size_t words = static_cast<std::size_t>(bits / 64);
+            m_words.reset(new std::atomic<std::uint64_t>[words]);
+            for (std::size_t i = 0; i < words; ++i) {
+                m_words[i].store(0, std::memory_order_relaxed);
+            }
+            m_mask = bits - 1;
+        }
+
+        HashFilter(const HashFilter&) = delete;
+        HashFilter& operator=(const HashFilter&) = delete;
+
+        /// \brief Records a hash as possibly present.
+        void add(std::uint64_t hash) noexcept {
+            std::uint64_t h1 = mix(hash);
+            const std::uint64_t h2 = mix(h1) | 1u;
+            for (unsigned i = 0; i < m_probes; ++i, h1 += h2) {
+                const std::uint64_t bit = h1 & m_mask;
+                m_words[bit >> 6].fetch_or(std::uint64_t(1) << (bit & 63), std::memory_order_release);
+            }
+        }
+
+        /// \brief Returns \c false only if the hash was never added.
+        bool may_contain(std::uint64_t hash) const noexcept {
+            std::uint64_t h1 = mix(hash);
+            const std::uint64_t h2 = mix(h1) | 1u;
+            for (unsigned i = 0; i < m_probes; ++i, h1 += h2) {
+                const std::uint64_t bit = h1 & m_mask;
+                if (!(m_words[bit >> 6].load(std::memory_order_acquire) & (std::uint64_t(1) << (bit & 63)))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// \brief Checks whether a transaction sees data the filter was built from.
+        /// \details Older snapshots may still contain keys erased before the
+        /// rebuild, so they must bypass the filter.
+        bool covers(std::uint64_t txnid) const noexcept {
+            return txnid >= m_snapshot_txnid;
+        }
+
+        /// \brief Returns the number of filter bits.
+        std::uint64_t bit_count() const noexcept { return m_mask + 1; }
+
+        /// \brief Returns the number of probes per hash.
+        unsigned probe_count() const noexcept { return m_probes; }
+
+        /// \brief Returns the key count the filter was sized for.
+        std::size_t expected_keys() const noexcept { return m_expected_keys; }
+
+        /// \brief Returns the requested bits per key.
+        std::size_t bits_per_key() const noexcept { return m_bits_per_key; }
+
+    private:
+        std::unique_ptr<std::atomic<std::uint64_t>[]> m_words;
+        std::uint64_t m_mask;
+        unsigned      m_probes;
+        std::size_t   m_expected_keys;
+        std::size_t   m_bits_per_key;
+        std::uint64_t m_snapshot_txnid;
+
+        /// \brief Optimal probe count k = bits_per_key * ln 2, clamped to [1, 16].
+        static unsigned probes_for(std::size_t bits_per_key) noexcept {
+            std::size_t k = (bits_per_key * 69 + 50) / 100;
+            if (k < 1) k = 1;
+            if (k > 16) k = 16;
+            return static_cast<unsigned>(k);
+        }
+
+        /// \brief SplitMix64 finalizer; spreads weak user hashes over all bits.
+        static std::uint64_t mix(std::uint64_t x) noexcept {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return x;
+        }
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_HASH_FILTER_HPP_INCLUDED
@@ -0,0 +1,142 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_MAPPED_FILE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_MAPPED_FILE_HPP_INCLUDED
+
+/// \file MappedFile.hpp
+/// \ingroup mdbxc_utils
+/// \brief Copy-on-write file mapping used for shared read-mostly data.
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "path_utils.hpp"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mdbxc {
+namespace detail {
+
+    /// \brief Maps a whole file privately with copy-on-write pages.
+    ///
+    /// Untouched pages are backed by the page cache and shared with every
+    /// process mapping the same file; a write copies only the touched page
+    /// into the writer's private memory and never reaches the file.
+    ///
+    /// \warning The file must not be modified in place while mapped; replace
+    /// it with a new file instead.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        /// \brief Maps \p path.
+        /// \throws std::runtime_error if the file cannot be opened, is empty,
+        ///         or cannot be mapped.
+        explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+            HANDLE file = CreateFileW(utf8_to_wide(path).c_str(), GENERIC_READ,
+                                      FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (file == INVALID_HANDLE_VALUE) {
+                throw std::runtime_error("Failed to open mapped file: " + path);
+            }
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+                CloseHandle(file);
+                throw std::runtime_error("Mapped file is empty or unreadable: " + path);
+            }
+            HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+            CloseHandle(file);
+            if (mapping == NULL) {
+                throw std::runtime_error("Failed to map file: " + path);
+            }
+            void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+            CloseHandle(mapping);
+            if (view == NULL) {
+                throw std::runtime_error("Failed to map file: " + path);
+            }
+            m_data = static_cast<unsigned char*>(view);
+            m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Failed to open mapped file: " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+                ::close(fd);
+                throw std::runtime_error("Mapped file is empty or unreadable: " + path);
+            }
+            const std::size_t size = static_cast<std::size_t>(st.st_size);
+            void* view = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (view == MAP_FAILED) {
+                throw std::runtime_error("Failed to map file: " + path);
+            }
+            m_data = static_cast<unsigned char*>(view);
+            m_size = size;
+#endif
+        }
+
+        ~MappedFile() {
+            reset();
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+            : m_data(other.m_data), m_size(other.m_size) {
+            other.m_data = nullptr;
+            other.m_size = 0;
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                reset();
+                std::swap(m_data, other.m_data);
+                std::swap(m_size, other.m_size);
+            }
+            return *this;
+        }
+
+        /// \brief Unmaps the file.
+        void reset() noexcept {
+            if (m_data == nullptr) {
+                return;
+            }
+#ifdef _WIN32
+            UnmapViewOfFile(m_data);
+#else
+            ::munmap(m_data, m_size);
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        /// \brief Returns the first mapped byte, or null when nothing is mapped.
+        unsigned char* data() const noexcept {
+            return m_data;
+        }
+
+        /// \brief Returns the mapped length in bytes.
+        std::size_t size() const noexcept {
+            return m_size;
+        }
+
+    private:
+        unsigned char* m_data = nullptr;
+        std::size_t m_size = 0;
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_MAPPED_FILE_HPP_INCLUDED
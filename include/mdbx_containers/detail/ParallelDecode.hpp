@@ -0,0 +1,185 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_PARALLEL_DECODE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_PARALLEL_DECODE_HPP_INCLUDED
+
+/// \file detail/ParallelDecode.hpp
+/// \brief Deserializes records of one read snapshot on several threads.
+/// \details The calling thread owns the transaction and walks the cursor,
+/// handing batches of raw \c MDBX_val views to workers. The views point into
+/// pages of the snapshot, which stay mapped and unchanged until the
+/// transaction ends, so workers only read memory and never call MDBX.
+
+#include <mdbx.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mdbxc {
+namespace detail {
+
+    /// \brief Raw key and value views of one record.
+    struct RawRecord {
+        MDBX_val key;
+        MDBX_val value;
+    };
+
+    /// \brief Records handed to a worker at a time.
+    static const std::size_t parallel_decode_batch = 4096;
+
+    /// \brief Calls \p c.reserve(n) when the container supports it.
+    template<class ContainerT>
+    auto reserve_if_supported(ContainerT& c, std::size_t n, int) -> decltype(c.reserve(n), void()) {
+        c.reserve(n);
+    }
+
+    template<class ContainerT>
+    void reserve_if_supported(ContainerT&, std::size_t, long) {}
+
+    /// \brief Decodes every record produced by \p next into \p out, in order.
+    /// \param threads Worker count; 0 uses the hardware concurrency and 1
+    ///        decodes on the calling thread.
+    /// \param expected Expected record count, used to size \p out.
+    /// \param next Called on the calling thread as \c next(RawRecord&); returns
+    ///        \c false after the last record.
+    /// \param decode Called on workers as \c decode(const RawRecord&) and
+    ///        returns an \c ItemT. Must not touch the transaction.
+    /// \param out Receives the decoded items after its existing contents.
+    /// \throws Rethrows the first exception from \p next or \p decode after all
+    ///         workers have stopped.
+    template<class ItemT, class NextT, class DecodeT>
+    void parallel_decode(std::size_t threads, std::size_t expected,
+                         NextT next, DecodeT decode, std::vector<ItemT>& out) {
+        if (threads == 0) {
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+        out.reserve(out.size() + expected);
+        RawRecord raw;
+        if (threads < 2) {
+            while (next(raw)) out.push_back(decode(raw));
+            return;
+        }
+
+        struct Batch {
+            std::vector<RawRecord> raw;
+            std::vector<ItemT> items;
+            bool done = false;
+        };
+        std::deque<Batch> batches;   // Stable addresses; appended by the reader only.
+        std::size_t next_batch = 0;  // First batch not yet taken by a worker.
+        bool finished = false;
+        bool failed = false;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable work_cv;
+        std::condition_variable space_cv;
+        const std::size_t max_pending = threads * 4;
+
+        auto worker = [&batches, &next_batch, &finished, &failed, &error, &mutex, &work_cv, &space_cv, &decode]() {
+            for (;;) {
+                Batch* batch = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    work_cv.wait(lock, [&batches, &next_batch, &finished, &failed]() { return failed || finished || next_batch < batches.size(); });
+                    if (failed || next_batch >= batches.size()) return;
+                    batch = &batches[next_batch++];
+                }
+                try {
+                    batch->items.reserve(batch->raw.size());
+                    for (std::size_t i = 0; i < batch->raw.size(); ++i) {
+                        batch->items.push_back(decode(batch->raw[i]));
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) error = std::current_exception();
+                    failed = true;
+                    work_cv.notify_all();
+                    space_cv.notify_all();
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    batch->done = true;
+                    std::vector<RawRecord>().swap(batch->raw);
+                }
+                space_cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        std::size_t flushed = 0; // Batches already moved into out.
+        auto flush_done = [&batches, &flushed, &out](std::unique_lock<std::mutex>& lock) {
+            while (flushed < batches.size() && batches[flushed].done) {
+                std::vector<ItemT> items;
+                items.swap(batches[flushed].items);
+                ++flushed;
+                lock.unlock();
+                for (std::size_t i = 0; i < items.size(); ++i) {
+                    out.push_back(std::move(items[i]));
+                }
+                lock.lock();
+            }
+        };
+        auto stop = [&finished, &mutex, &work_cv, &pool]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished = true;
+            }
+            work_cv.notify_all();
+            for (std::size_t i = 0; i < pool.size(); ++i) pool[i].join();
+        };
+
+        try {
+            pool.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) {
+                pool.push_back(std::thread(worker));
+            }
+            bool more = true;
+            while (more) {
+                std::vector<RawRecord> chunk;
+                chunk.reserve(parallel_decode_batch);
+                while (chunk.size() < parallel_decode_batch && (more = next(raw))) {
+                    chunk.push_back(raw);
+                }
+                std::unique_lock<std::mutex> lock(mutex);
+                if (!chunk.empty()) {
+                    batches.push_back(Batch());
+                    batches.back().raw.swap(chunk);
+                    work_cv.notify_one();
+                }
+                // Bound the decoded-but-unflushed backlog.
+                for (;;) {
+                    flush_done(lock);
+                    if (failed || batches.size() - flushed < max_pending) break;
+                    space_cv.wait(lock);
+                }
+                if (failed) break;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            finished = true;
+            work_cv.notify_all();
+            while (!failed && flushed < batches.size()) {
+                flush_done(lock);
+                if (flushed < batches.size()) space_cv.wait(lock);
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                failed = true;
+            }
+            stop();
+            throw;
+        }
+        stop();
+        if (error) std::rethrow_exception(error);
+    }
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_PARALLEL_DECODE_HPP_INCLUDED
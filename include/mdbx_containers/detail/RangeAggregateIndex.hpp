@@ -0,0 +1,238 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_RANGE_AGGREGATE_INDEX_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_RANGE_AGGREGATE_INDEX_HPP_INCLUDED
+
+/// \file detail/RangeAggregateIndex.hpp
+/// \brief Count, sum, min and max summaries of key blocks, maintained by
+///        \ref mdbxc::KeyValueTable writes.
+/// \details
+/// Level \c L summarizes the records whose keys share <tt>key >> (6 * L)</tt>,
+/// i.e. blocks of 64 level <tt>L - 1</tt> entries. A range query reads the
+/// partial blocks at both ends of each level and climbs one level for the
+/// full blocks in between, so it visits at most <tt>2 * 64</tt> entries per
+/// level instead of every record.
+
+#include "SecondaryIndex.hpp"
+#include <cstring>
+#include <type_traits>
+
+namespace mdbxc {
+
+    /// \struct RangeAggregate
+    /// \brief Count, sum, min and max of the values in a key range.
+    /// \details \c min and \c max are meaningful only when \c count is non-zero.
+    struct RangeAggregate {
+        std::uint64_t count = 0;
+        double        sum = 0;
+        double        min = 0;
+        double        max = 0;
+
+        /// \brief Returns the mean value, or zero for an empty range.
+        double mean() const { return count ? sum / static_cast<double>(count) : 0.0; }
+
+        /// \brief Adds one value.
+        void add(double value) {
+            if (count == 0 || value < min) min = value;
+            if (count == 0 || value > max) max = value;
+            sum += value;
+            ++count;
+        }
+
+        /// \brief Adds the values summarized by \p other.
+        void merge(const RangeAggregate& other) {
+            if (other.count == 0) return;
+            if (count == 0 || other.min < min) min = other.min;
+            if (count == 0 || other.max > max) max = other.max;
+            sum += other.sum;
+            count += other.count;
+        }
+    };
+
+namespace detail {
+
+    /// \class RangeAggregateIndex
+    /// \brief Block summaries over unsigned integer keys and arithmetic values.
+    /// \details Entries live in an \c MDBX_INTEGERKEY table keyed by
+    /// <tt>(level << 60) | (key >> (6 * level))</tt>; each value is a
+    /// \ref RangeAggregate. A write updates count and sum on every level.
+    /// Min and max are updated in place unless the old value was an extreme,
+    /// in which case the block is recomputed from its 64 children, so sums
+    /// drift from repeated floating-point updates only until then.
+    template<class KeyT, class ValueT, class Options>
+    class RangeAggregateIndex final : public SecondaryIndex<ValueT> {
+        static_assert(std::is_integral<KeyT>::value && std::is_unsigned<KeyT>::value &&
+                      (sizeof(KeyT) == 4 || sizeof(KeyT) == 8),
+                      "Range aggregates require std::uint32_t or std::uint64_t keys");
+        static_assert(std::is_arithmetic<ValueT>::value,
+                      "Range aggregates require an arithmetic value type");
+    public:
+        static const unsigned block_bits = 6;
+        static const unsigned levels = (sizeof(KeyT) * 8 - 1) / block_bits;
+
+        RangeAggregateIndex(std::string name, MDBX_dbi dbi, MDBX_dbi table_dbi)
+            : SecondaryIndex<ValueT>(std::move(name), dbi, secondary_index_type_tag<RangeAggregate>()),
+              m_table_dbi(table_dbi) {}
+
+        void update(MDBX_txn* txn, const MDBX_val& primary_key,
+                    const ValueT* old_value, const ValueT* new_value) const override {
+            if (old_value && new_value && *old_value == *new_value) return;
+            const std::uint64_t key = static_cast<std::uint64_t>(deserialize_key<KeyT>(primary_key));
+            const double old_v = old_value ? static_cast<double>(*old_value) : 0.0;
+            const double new_v = new_value ? static_cast<double>(*new_value) : 0.0;
+            for (unsigned level = 1; level <= levels; ++level) {
+                const std::uint64_t block = key >> (block_bits * level);
+                RangeAggregate agg;
+                const bool exists = read_entry(txn, level, block, agg);
+                bool recompute = !exists && old_value;
+                if (old_value && exists) {
+                    recompute = agg.count <= 1 || old_v <= agg.min || old_v >= agg.max;
+                    --agg.count;
+                    agg.sum -= old_v;
+                }
+                if (recompute) {
+                    // The lower level already reflects the write.
+                    agg = RangeAggregate();
+                    scan(txn, level - 1, block << block_bits,
+                         (block << block_bits) | block_mask(), agg);
+                } else if (new_value) {
+                    agg.add(new_v);
+                }
+                write_entry(txn, level, block, agg);
+            }
+        }
+
+        /// \brief Aggregates the values of the keys in <tt>[from, to]</tt>.
+        RangeAggregate query(MDBX_txn* txn, KeyT from, KeyT to) const {
+            RangeAggregate result;
+            std::uint64_t lo = from;
+            std::uint64_t hi = to;
+            if (lo > hi) return result;
+            for (unsigned level = 0;; ++level) {
+                if ((lo >> block_bits) == (hi >> block_bits)) {
+                    const bool full = (lo & block_mask()) == 0 && (hi & block_mask()) == block_mask();
+                    if (!full || level == levels) {
+                        scan(txn, level, lo, hi, result);
+                        return result;
+                    }
+                } else {
+                    if (level == levels) {
+                        scan(txn, level, lo, hi, result);
+                        return result;
+                    }
+                    if (lo & block_mask()) {
+                        scan(txn, level, lo, lo | block_mask(), result);
+                        lo = (lo | block_mask()) + 1;
+                    }
+                    if ((hi & block_mask()) != block_mask()) {
+                        scan(txn, level, hi & ~block_mask(), hi, result);
+                        hi = (hi & ~block_mask()) - 1;
+                    }
+                    if (lo > hi) return result;
+                }
+                lo >>= block_bits;
+                hi >>= block_bits;
+            }
+        }
+
+    private:
+        struct Cursor {
+            MDBX_cursor* handle = nullptr;
+            ~Cursor() { if (handle) mdbx_cursor_close(handle); }
+        };
+
+        MDBX_dbi m_table_dbi;
+
+        static std::uint64_t block_mask() noexcept {
+            return (std::uint64_t(1) << block_bits) - 1;
+        }
+
+        static std::uint64_t entry_key(unsigned level, std::uint64_t block) noexcept {
+            return (static_cast<std::uint64_t>(level) << 60) | block;
+        }
+
+        static void decode(const MDBX_val& val, RangeAggregate& out) {
+            if (val.iov_len != 32) {
+                throw std::runtime_error("KeyValueTable: corrupted range aggregate entry");
+            }
+            const std::uint8_t* p = static_cast<const std::uint8_t*>(val.iov_base);
+            std::memcpy(&out.count, p, 8);
+            std::memcpy(&out.sum, p + 8, 8);
+            std::memcpy(&out.min, p + 16, 8);
+            std::memcpy(&out.max, p + 24, 8);
+        }
+
+        bool read_entry(MDBX_txn* txn, unsigned level, std::uint64_t block, RangeAggregate& out) const {
+            std::uint64_t k = entry_key(level, block);
+            MDBX_val db_key = SerializeScratch::view(&k, sizeof(k));
+            MDBX_val db_val;
+            const int rc = mdbx_get(txn, this->dbi(), &db_key, &db_val);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to read range aggregate");
+            decode(db_val, out);
+            return true;
+        }
+
+        void write_entry(MDBX_txn* txn, unsigned level, std::uint64_t block,
+                         const RangeAggregate& agg) const {
+            std::uint64_t k = entry_key(level, block);
+            MDBX_val db_key = SerializeScratch::view(&k, sizeof(k));
+            if (agg.count == 0) {
+                const int rc = mdbx_del(txn, this->dbi(), &db_key, nullptr);
+                if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to remove range aggregate");
+                return;
+            }
+            std::uint8_t bytes[32];
+            std::memcpy(bytes, &agg.count, 8);
+            std::memcpy(bytes + 8, &agg.sum, 8);
+            std::memcpy(bytes + 16, &agg.min, 8);
+            std::memcpy(bytes + 24, &agg.max, 8);
+            MDBX_val db_val = SerializeScratch::view(bytes, sizeof(bytes));
+            check_mdbx(mdbx_put(txn, this->dbi(), &db_key, &db_val, MDBX_UPSERT),
+                       "Failed to write range aggregate");
+        }
+
+        /// \brief Adds the entries of <tt>[lo, hi]</tt> at \p level to \p out;
+        ///        level 0 reads the records themselves.
+        void scan(MDBX_txn* txn, unsigned level, std::uint64_t lo, std::uint64_t hi,
+                  RangeAggregate& out) const {
+            Cursor cursor;
+            int rc = MDBX_SUCCESS;
+            MDBX_val db_key;
+            MDBX_val db_val;
+            if (level == 0) {
+                check_mdbx(mdbx_cursor_open(txn, m_table_dbi, &cursor.handle),
+                           "Failed to open range aggregate cursor");
+                SerializeScratch sc;
+                const KeyT from = static_cast<KeyT>(lo);
+                db_key = serialize_key<Options::safe_integer_key>(from, sc);
+                rc = mdbx_cursor_get(cursor.handle, &db_key, &db_val, MDBX_SET_RANGE);
+                while (rc == MDBX_SUCCESS) {
+                    if (static_cast<std::uint64_t>(deserialize_key<KeyT>(db_key)) > hi) return;
+                    out.add(static_cast<double>(deserialize_value<ValueT>(db_val)));
+                    rc = mdbx_cursor_get(cursor.handle, &db_key, &db_val, MDBX_NEXT);
+                }
+            } else {
+                check_mdbx(mdbx_cursor_open(txn, this->dbi(), &cursor.handle),
+                           "Failed to open range aggregate cursor");
+                std::uint64_t k = entry_key(level, lo);
+                const std::uint64_t last = entry_key(level, hi);
+                db_key = SerializeScratch::view(&k, sizeof(k));
+                rc = mdbx_cursor_get(cursor.handle, &db_key, &db_val, MDBX_SET_RANGE);
+                while (rc == MDBX_SUCCESS) {
+                    std::uint64_t found = 0;
+                    std::memcpy(&found, db_key.iov_base, sizeof(found));
+                    if (found > last) return;
+                    RangeAggregate agg;
+                    decode(db_val, agg);
+                    out.merge(agg);
+                    rc = mdbx_cursor_get(cursor.handle, &db_key, &db_val, MDBX_NEXT);
+                }
+            }
+            if (rc != MDBX_NOTFOUND) check_mdbx(rc, "Failed to read range aggregates");
+        }
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_RANGE_AGGREGATE_INDEX_HPP_INCLUDED
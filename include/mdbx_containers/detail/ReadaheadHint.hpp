@@ -0,0 +1,93 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_READAHEAD_HINT_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_READAHEAD_HINT_HPP_INCLUDED
+
+/// \file ReadaheadHint.hpp
+/// \ingroup mdbxc_utils
+/// \brief Asks the kernel to page in mapped database bytes ahead of use.
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace mdbxc {
+namespace detail {
+
+    /// \brief Size of an OS memory page.
+    inline std::size_t os_page_size() noexcept {
+#ifdef _WIN32
+        return 4096;
+#else
+        static const long size = ::sysconf(_SC_PAGESIZE);
+        return size > 0 ? static_cast<std::size_t>(size) : 4096;
+#endif
+    }
+
+    /// \brief Hints that the mapped pages covering [\p data, \p data + \p size)
+    /// will be read soon.
+    /// \details Issues \c MADV_WILLNEED, which starts the reads without
+    /// waiting for them. Advice only: failures are ignored. No-op on Windows.
+    inline void advise_willneed(const void* data, std::size_t size) noexcept {
+#ifndef _WIN32
+        if (data == nullptr || size == 0) return;
+        const std::uintptr_t page = os_page_size();
+        const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data) & ~(page - 1);
+        const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(data) + size;
+        (void)::madvise(reinterpret_cast<void*>(begin),
+                        static_cast<std::size_t>(end - begin), MADV_WILLNEED);
+#else
+        (void)data;
+        (void)size;
+#endif
+    }
+
+    /// \class ReadaheadHint
+    /// \brief Merges nearby byte spans into few \ref advise_willneed() calls.
+    /// \details Spans that start within one page of the end of the pending
+    /// span extend it; any other span flushes it first. The pending span is
+    /// flushed on destruction.
+    class ReadaheadHint {
+    public:
+        ReadaheadHint() noexcept : m_begin(0), m_end(0) {}
+        ~ReadaheadHint() { flush(); }
+
+        ReadaheadHint(const ReadaheadHint&) = delete;
+        ReadaheadHint& operator=(const ReadaheadHint&) = delete;
+
+        /// \brief Queues [\p data, \p data + \p size).
+        void add(const void* data, std::size_t size) noexcept {
+            if (data == nullptr || size == 0) return;
+            const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data);
+            const std::uintptr_t end = begin + size;
+            if (m_end != 0 && begin >= m_begin && begin <= m_end + os_page_size()) {
+                if (end > m_end) m_end = end;
+                return;
+            }
+            flush();
+            m_begin = begin;
+            m_end = end;
+        }
+
+        /// \brief Hints the pending span.
+        void flush() noexcept {
+            if (m_end != 0) {
+                advise_willneed(reinterpret_cast<const void*>(m_begin),
+                                static_cast<std::size_t>(m_end - m_begin));
+            }
+            m_begin = 0;
+            m_end = 0;
+        }
+
+    private:
+        std::uintptr_t m_begin;
+        std::uintptr_t m_end;
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_READAHEAD_HINT_HPP_INCLUDED
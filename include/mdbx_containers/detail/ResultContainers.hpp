@@ -3,10 +3,27 @@
 #define MDBX_CONTAINERS_HEADER_DETAIL_RESULT_CONTAINERS_HPP_INCLUDED
 
 /// \file detail/ResultContainers.hpp
-/// \brief Internal traits for selecting result container shapes.
+/// \brief Internal traits for selecting result container shapes and filling
+///        caller-provided result containers.
 
+#include "utils.hpp"
+#include <string>
 #include <utility>
 #include <vector>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#   if __has_include(<memory_resource>)
+#       include <memory_resource>
+#       define MDBXC_HAS_PMR 1
+#   endif
+#endif
+#ifndef MDBXC_HAS_PMR
+/// \brief Non-zero when \c std::pmr containers are available (C++17).
+#define MDBXC_HAS_PMR 0
+#endif
 
 namespace mdbxc {
 namespace detail {
@@ -21,6 +38,47 @@ namespace detail {
         typedef std::vector<std::pair<KeyT, ValueT> > type;
     };
 
+    template<class ContainerT, class... Args>
+    auto emplace_result_impl(int, ContainerT& out, Args&&... args)
+        -> decltype(out.emplace_back(std::forward<Args>(args)...), void()) {
+        out.emplace_back(std::forward<Args>(args)...);
+    }
+
+    template<class ContainerT, class... Args>
+    void emplace_result_impl(long, ContainerT& out, Args&&... args) {
+        out.emplace(std::forward<Args>(args)...);
+    }
+
+    /// \brief Appends to sequence containers and inserts into associative ones.
+    /// \details The element is constructed in place with the container's own
+    /// allocator, so \c std::pmr containers place it in their memory resource.
+    template<class ContainerT, class... Args>
+    void emplace_result(ContainerT& out, Args&&... args) {
+        emplace_result_impl(0, out, std::forward<Args>(args)...);
+    }
+
+    /// \brief Arguments used to construct result elements from stored bytes.
+    /// \details Deserializes \c T, except that in C++17 \c std::string keys
+    /// and values are passed as \c std::string_view into the page, so an
+    /// allocator-aware element such as \c std::pmr::string is built directly
+    /// in its arena without a heap temporary.
+    template<class T>
+    struct result_arg {
+        static T key(const MDBX_val& val) { return deserialize_key<T>(val); }
+        static T value(const MDBX_val& val) { return deserialize_value<T>(val); }
+    };
+
+#   if __cplusplus >= 201703L
+    template<>
+    struct result_arg<std::string> {
+        static std::string_view key(const MDBX_val& val) { return value(val); }
+        static std::string_view value(const MDBX_val& val) {
+            return val.iov_len ? std::string_view(static_cast<const char*>(val.iov_base), val.iov_len)
+                               : std::string_view();
+        }
+    };
+#   endif
+
 } // namespace detail
 } // namespace mdbxc
 
@@ -0,0 +1,107 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_SCRATCH_POOL_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_SCRATCH_POOL_HPP_INCLUDED
+
+/// \file detail/ScratchPool.hpp
+/// \brief Connection-owned pool of reusable serialization scratch buffers.
+/// \details
+/// Table write helpers borrow a \ref mdbxc::SerializeScratch from the pool so
+/// the heap capacity of \c SerializeScratch::bytes survives between calls.
+/// The pool is a fixed set of slots claimed with atomic flags; it does not use
+/// \c thread_local storage, which is unsafe for STL buffers on MinGW at thread
+/// shutdown. When every slot is busy the lease falls back to a local scratch.
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "utils.hpp"
+
+namespace mdbxc {
+namespace detail {
+
+    /// \class ScratchPool
+    /// \brief Fixed-size lock-free pool of \ref mdbxc::SerializeScratch slots.
+    /// \thread_safety Thread-safe. Each slot is owned by at most one lease.
+    class ScratchPool {
+    public:
+        static const std::size_t slot_count = 8; ///< Number of pooled slots.
+        static const std::size_t default_retained_capacity = 256u * 1024u; ///< Per-slot capacity kept after release.
+
+        /// \brief Creates a pool.
+        /// \param retained_capacity Largest buffer capacity kept in a slot after
+        /// release; larger buffers are freed so one huge value does not pin memory.
+        explicit ScratchPool(std::size_t retained_capacity = default_retained_capacity) noexcept
+            : m_retained_capacity(retained_capacity) {
+            for (std::size_t i = 0; i < slot_count; ++i) {
+                m_busy[i].store(false, std::memory_order_relaxed);
+            }
+        }
+
+        ScratchPool(const ScratchPool&) = delete;
+        ScratchPool& operator=(const ScratchPool&) = delete;
+
+        /// \brief Claims a free slot.
+        /// \return Pointer to the slot scratch, or \c nullptr if every slot is busy.
+        SerializeScratch* acquire() noexcept {
+            for (std::size_t i = 0; i < slot_count; ++i) {
+                if (!m_busy[i].load(std::memory_order_relaxed) &&
+                    !m_busy[i].exchange(true, std::memory_order_acquire)) {
+                    return &m_slots[i];
+                }
+            }
+            return nullptr;
+        }
+
+        /// \brief Returns a slot claimed by \ref acquire().
+        /// \param scratch Slot pointer returned by \ref acquire().
+        void release(SerializeScratch* scratch) noexcept {
+            const std::size_t index = static_cast<std::size_t>(scratch - m_slots);
+            scratch->bytes.clear();
+            if (scratch->bytes.capacity() > m_retained_capacity) {
+                std::vector<uint8_t>().swap(scratch->bytes);
+            }
+            m_busy[index].store(false, std::memory_order_release);
+        }
+
+        /// \brief Returns the per-slot retained capacity limit in bytes.
+        std::size_t retained_capacity() const noexcept { return m_retained_capacity; }
+
+    private:
+        SerializeScratch  m_slots[slot_count];
+        std::atomic<bool> m_busy[slot_count];
+        std::size_t       m_retained_capacity;
+    };
+
+    /// \class ScratchLease
+    /// \brief Scoped borrow of a pooled \ref mdbxc::SerializeScratch.
+    /// \details Uses an embedded scratch when the pool is exhausted, so a lease
+    /// never fails. \c MDBX_val views produced through the lease are valid only
+    /// while the lease is alive, as with a local \c SerializeScratch.
+    class ScratchLease {
+    public:
+        explicit ScratchLease(ScratchPool& pool) noexcept
+            : m_pool(pool), m_borrowed(pool.acquire()) {}
+
+        ~ScratchLease() noexcept {
+            if (m_borrowed) m_pool.release(m_borrowed);
+        }
+
+        ScratchLease(const ScratchLease&) = delete;
+        ScratchLease& operator=(const ScratchLease&) = delete;
+
+        /// \brief Returns the borrowed scratch.
+        SerializeScratch& get() noexcept { return m_borrowed ? *m_borrowed : m_local; }
+
+        operator SerializeScratch&() noexcept { return get(); }
+
+    private:
+        ScratchPool&      m_pool;
+        SerializeScratch* m_borrowed;
+        SerializeScratch  m_local;
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_SCRATCH_POOL_HPP_INCLUDED
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_SECONDARY_INDEX_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_SECONDARY_INDEX_HPP_INCLUDED
+
+/// \file detail/SecondaryIndex.hpp
+/// \brief Secondary index entries maintained by \ref mdbxc::KeyValueTable writes.
+/// \details
+/// An index lives in its own \c MDBX_DUPSORT DBI: the key is the serialized
+/// index key extracted from a value, the duplicates are the serialized
+/// primary keys of the records carrying it.
+
+#include <string>
+#include <utility>
+
+namespace mdbxc {
+namespace detail {
+
+    /// \brief Distinct address per type, used to check index key types at lookup.
+    template<class T>
+    inline const void* secondary_index_type_tag() noexcept {
+        static const char tag = 0;
+        return &tag;
+    }
+
+    /// \class SecondaryIndex
+    /// \brief Type-erased secondary index of a table with values of type \p ValueT.
+    template<class ValueT>
+    class SecondaryIndex {
+    public:
+        SecondaryIndex(std::string name, MDBX_dbi dbi, const void* key_type)
+            : m_name(std::move(name)), m_dbi(dbi), m_key_type(key_type) {}
+
+        virtual ~SecondaryIndex() {}
+
+        /// \brief Index name passed to \c KeyValueTable::add_index().
+        const std::string& name() const noexcept { return m_name; }
+
+        /// \brief DUPSORT DBI holding the entries.
+        MDBX_dbi dbi() const noexcept { return m_dbi; }
+
+        /// \brief Tag of the index key type from \ref secondary_index_type_tag().
+        const void* key_type() const noexcept { return m_key_type; }
+
+        /// \brief Moves the entry of one record from \p old_value to \p new_value.
+        /// \param txn Active write transaction.
+        /// \param primary_key Serialized primary key of the record.
+        /// \param old_value Value before the write, or \c nullptr for a new record.
+        /// \param new_value Value after the write, or \c nullptr for a deletion.
+        /// \throws MdbxException if a database error occurs.
+        virtual void update(MDBX_txn* txn, const MDBX_val& primary_key,
+                            const ValueT* old_value, const ValueT* new_value) const = 0;
+
+    private:
+        std::string m_name;
+        MDBX_dbi    m_dbi;
+        const void* m_key_type;
+    };
+
+    /// \class ExtractorIndex
+    /// \brief Secondary index keyed by \c extractor(value).
+    template<class ValueT, class IndexKeyT, class Options, typename ExtractorT>
+    class ExtractorIndex final : public SecondaryIndex<ValueT> {
+    public:
+        ExtractorIndex(std::string name, MDBX_dbi dbi, ExtractorT extractor)
+            : SecondaryIndex<ValueT>(std::move(name), dbi, secondary_index_type_tag<IndexKeyT>()),
+              m_extractor(std::move(extractor)) {}
+
+        void update(MDBX_txn* txn, const MDBX_val& primary_key,
+                    const ValueT* old_value, const ValueT* new_value) const override {
+            MDBX_val db_primary = primary_key;
+            SerializeScratch sc_old;
+            SerializeScratch sc_new;
+            // The keys stay alive while their serialized views are in use.
+            IndexKeyT old_key = IndexKeyT();
+            IndexKeyT new_key = IndexKeyT();
+            MDBX_val db_old{};
+            MDBX_val db_new{};
+            if (old_value) {
+                old_key = m_extractor(*old_value);
+                db_old = serialize_key<Options::safe_integer_key>(old_key, sc_old);
+            }
+            if (new_value) {
+                new_key = m_extractor(*new_value);
+                db_new = serialize_key<Options::safe_integer_key>(new_key, sc_new);
+            }
+            if (old_value && new_value && db_old.iov_len == db_new.iov_len &&
+                (db_old.iov_len == 0 ||
+                 std::memcmp(db_old.iov_base, db_new.iov_base, db_old.iov_len) == 0)) {
+                return;
+            }
+            if (old_value) {
+                const int rc = mdbx_del(txn, this->dbi(), &db_old, &db_primary);
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "Failed to remove secondary index entry");
+                }
+            }
+            if (new_value) {
+                const int rc = mdbx_put(txn, this->dbi(), &db_new, &db_primary, MDBX_NODUPDATA);
+                if (rc != MDBX_KEYEXIST) {
+                    check_mdbx(rc, "Failed to write secondary index entry");
+                }
+            }
+        }
+
+    private:
+        ExtractorT m_extractor;
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_SECONDARY_INDEX_HPP_INCLUDED
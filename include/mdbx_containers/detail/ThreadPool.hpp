@@ -0,0 +1,117 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_DETAIL_THREAD_POOL_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_DETAIL_THREAD_POOL_HPP_INCLUDED
+
+/// \file detail/ThreadPool.hpp
+/// \brief Fixed set of worker threads draining a FIFO task queue.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mdbxc {
+namespace detail {
+
+    /// \class ThreadPool
+    /// \brief Runs posted tasks on a fixed number of worker threads.
+    /// \details Tasks run in posting order as workers become free. The
+    /// destructor runs the tasks still queued, then joins the workers.
+    /// \thread_safety Thread-safe.
+    class ThreadPool {
+    public:
+        /// \brief Starts the workers.
+        /// \param threads Worker count; 0 uses the hardware concurrency.
+        explicit ThreadPool(std::size_t threads = 0) {
+            if (threads == 0) {
+                threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+            }
+            m_workers.reserve(threads);
+            try {
+                for (std::size_t i = 0; i < threads; ++i) {
+                    m_workers.push_back(std::thread(&ThreadPool::worker_loop, this));
+                }
+            } catch (...) {
+                stop();
+                throw;
+            }
+        }
+
+        ~ThreadPool() {
+            stop();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// \brief Queues \p task for a worker.
+        /// \details Exceptions escaping \p task are swallowed; wrap it in a
+        /// \c std::packaged_task to observe them.
+        /// \throws std::logic_error if the pool is stopping.
+        void post(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stopping) {
+                    throw std::logic_error("ThreadPool is stopping");
+                }
+                m_tasks.push_back(std::move(task));
+            }
+            m_cv.notify_one();
+        }
+
+        /// \brief Returns the number of worker threads.
+        std::size_t size() const noexcept {
+            return m_workers.size();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::deque<std::function<void()>> m_tasks;
+        std::vector<std::thread> m_workers;
+        bool m_stopping = false;
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_cv.notify_all();
+            for (std::size_t i = 0; i < m_workers.size(); ++i) {
+                if (m_workers[i].joinable()) {
+                    m_workers[i].join();
+                }
+            }
+            m_workers.clear();
+        }
+
+        void worker_loop() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_cv.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+                    if (m_tasks.empty()) {
+                        return;
+                    }
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                try {
+                    task();
+                } catch (...) {
+                }
+            }
+        }
+    };
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_DETAIL_THREAD_POOL_HPP_INCLUDED
@@ -25,11 +25,14 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "../common/TraceScope.hpp"
+
 #if __cplusplus >= 201703L
 #   define MDBXC_NODISCARD [[nodiscard]]
 #else
@@ -193,6 +196,100 @@ namespace mdbxc {
             std::is_same<T, std::unordered_set<std::string>>::value;
     };
 
+    /// \brief Trait to check if a type can serialize itself into caller memory.
+    /// \details Types opt in by providing \c serialized_size() and
+    /// \c write_bytes(void*) members. \c write_bytes() must write exactly
+    /// \c serialized_size() bytes in the same format that \c from_bytes() reads.
+    /// \tparam T Type under inspection.
+    template <typename T>
+    struct has_write_bytes {
+    private:
+        template <typename U>
+        static auto check(U*) -> decltype(
+            static_cast<std::size_t>(std::declval<const U>().serialized_size()),
+            std::declval<const U>().write_bytes(static_cast<void*>(0)),
+            std::true_type());
+        template <typename>
+        static std::false_type check(...);
+    public:
+        static const bool value = decltype(check<T>(0))::value;
+    };
+
+    /// \brief Non-intrusive serialization hook for value types.
+    /// \details Specialize for a user-defined type that cannot carry member hooks:
+    /// \code
+    /// template<> struct mdbxc::serializer<Price> {
+    ///     static std::size_t size(const Price& v);
+    ///     static void write(const Price& v, uint8_t* out); // exactly size(v) bytes
+    ///     static Price read(const uint8_t* data, std::size_t size);
+    /// };
+    /// \endcode
+    /// A specialization takes precedence over \c to_bytes()/from_bytes(),
+    /// \c write_bytes() and the raw copy of trivially copyable types. Values
+    /// are written with \c MDBX_RESERVE wherever the table supports it.
+    /// \tparam T Value type.
+    template <typename T, typename Enable = void>
+    struct serializer {};
+
+    /// \brief Trait to check if \ref serializer is specialized for \p T.
+    /// \tparam T Type under inspection.
+    template <typename T>
+    struct has_serializer {
+    private:
+        template <typename U>
+        static auto check(U*) -> decltype(
+            static_cast<std::size_t>(serializer<U>::size(std::declval<const U&>())),
+            serializer<U>::write(std::declval<const U&>(), static_cast<uint8_t*>(0)),
+            static_cast<U>(serializer<U>::read(static_cast<const uint8_t*>(0), std::size_t(0))),
+            std::true_type());
+        template <typename>
+        static std::false_type check(...);
+    public:
+        static const bool value = decltype(check<T>(0))::value;
+    };
+
+    /// \brief Trait for values stored as their raw object bytes.
+    /// \details Only such values may be read through a pointer into the MDBX page.
+    template <typename T>
+    struct is_raw_value {
+        static const bool value =
+            std::is_trivially_copyable<T>::value &&
+            !has_to_bytes<T>::value &&
+            !has_from_bytes<T>::value &&
+            !has_serializer<T>::value;
+    };
+
+    /// \brief Trait for node-based containers of trivially copyable elements.
+    /// \details These containers are not contiguous, so their serialized form is
+    /// assembled element by element.
+    template <typename T, bool = has_value_type<T>::value>
+    struct is_trivial_node_container {
+        static const bool value = false;
+    };
+
+    template <typename T>
+    struct is_trivial_node_container<T, true> {
+        static const bool value =
+            std::is_trivially_copyable<typename T::value_type>::value &&
+            (std::is_same<T, std::deque<typename T::value_type>>::value ||
+             std::is_same<T, std::list<typename T::value_type>>::value ||
+             std::is_same<T, std::set<typename T::value_type>>::value ||
+             std::is_same<T, std::unordered_set<typename T::value_type>>::value);
+    };
+
+    /// \brief Trait for values whose serialized size is known before writing.
+    /// \details Such values are written with \c MDBX_RESERVE straight into the
+    /// MDBX page instead of being assembled in \c SerializeScratch first.
+    template <typename T>
+    struct is_reserved_value {
+        static const bool value =
+            has_serializer<T>::value ||
+            has_write_bytes<T>::value ||
+            is_trivial_node_container<T>::value ||
+            is_string_sequence_container<T>::value ||
+            is_string_set_container<T>::value;
+    };
+
     /// \brief Integral trait used by key serialization.
     /// \details Some compilers expose 128-bit integers as extensions without
     /// necessarily treating them exactly like standard integer types in all
@@ -263,6 +360,76 @@ namespace mdbxc {
             std::is_same<T, char32_t>::value;
     };
 
+    /// \brief True for key types stored as their raw bytes in bytewise order.
+    /// \details Only these keys support prefix scans: a serialized prefix is
+    /// then a byte prefix of every matching serialized key.
+    template<typename T>
+    struct is_byte_string_key {
+        static const bool value =
+            std::is_same<T, std::string>::value ||
+#           if __cplusplus >= 201703L
+            std::is_same<T, std::vector<std::byte>>::value ||
+#           endif
+            std::is_same<T, std::vector<uint8_t>>::value ||
+            std::is_same<T, std::vector<char>>::value ||
+            std::is_same<T, std::vector<unsigned char>>::value;
+    };
+
+    template<typename T>
+    struct is_composite_key;
+
+    /// \brief True for types allowed as fields of a composite key.
+    /// \details Integers, \c float, \c double, strings, byte vectors and
+    /// nested composite keys; see \c CompositeKey.hpp for their encoding.
+    template<typename T>
+    struct is_composite_key_field {
+        static const bool value =
+            is_key_integral<T>::value ||
+            std::is_same<T, float>::value ||
+            std::is_same<T, double>::value ||
+            is_byte_string_key<T>::value ||
+            is_composite_key<T>::value;
+    };
+
+    template<typename... Ts>
+    struct are_composite_key_fields {
+        static const bool value = true;
+    };
+
+    template<typename T, typename... Ts>
+    struct are_composite_key_fields<T, Ts...> {
+        static const bool value =
+            is_composite_key_field<T>::value && are_composite_key_fields<Ts...>::value;
+    };
+
+    /// \brief True for \c std::pair and non-empty \c std::tuple keys whose
+    ///        fields are all composite key fields.
+    /// \details Such keys are stored in bytewise order with an encoding whose
+    /// \c memcmp order is the lexicographic order of the fields, so range
+    /// scans need no custom comparator and a leading subset of the fields
+    /// forms a byte prefix of every matching key.
+    template<typename T>
+    struct is_composite_key {
+        static const bool value = false;
+    };
+
+    template<typename A, typename B>
+    struct is_composite_key<std::pair<A, B> > {
+        static const bool value = are_composite_key_fields<A, B>::value;
+    };
+
+    template<typename... Ts>
+    struct is_composite_key<std::tuple<Ts...> > {
+        static const bool value = sizeof...(Ts) > 0 && are_composite_key_fields<Ts...>::value;
+    };
+
+    /// \brief Returns true when serialized \p key starts with serialized \p prefix.
+    inline bool mdbx_val_has_prefix(const MDBX_val& key, const MDBX_val& prefix) noexcept {
+        return key.iov_len >= prefix.iov_len &&
+               (prefix.iov_len == 0 ||
+                std::memcmp(key.iov_base, prefix.iov_base, prefix.iov_len) == 0);
+    }
+
     /// \brief True when an integral key uses 8-byte MDBX_INTEGERKEY storage.
     /// \details \c long is intentionally widened to 8 bytes on LLP64 targets
     /// so \c KeyValueTable<long, V> does not switch between 4-byte Windows
@@ -329,9 +496,14 @@ namespace mdbxc {
     /// \brief Compile-time policy options for table behavior.
     /// \tparam SafeIntegerKey Copy direct-view-compatible integer keys into
     ///         aligned scratch storage before MDBX calls when true.
-    template<bool SafeIntegerKey = true>
+    /// \tparam DupFixed Store \c KeyMultiValueTable duplicates in an
+    ///         \c MDBX_DUPFIXED DBI. Requires a trivially copyable value type
+    ///         and changes the DBI flags, so it must match for an existing table.
+    ///         Other tables ignore it.
+    template<bool SafeIntegerKey = true, bool DupFixed = false>
     struct TableOptions {
         static const bool safe_integer_key = SafeIntegerKey;
+        static const bool dup_fixed = DupFixed;
     };
 
     /// \brief Default table policy using safe integer key serialization.
@@ -345,6 +517,10 @@ namespace mdbxc {
     ///          the database storage format.
     typedef TableOptions<false> FastIntegerKeyOptions;
 
+    /// \brief Table policy storing fixed-size multi-value duplicates with
+    ///        \c MDBX_DUPFIXED so \c find(key) reads whole pages per call.
+    typedef TableOptions<true, true> DupFixedTableOptions;
+
 //-----------------------------------------------------------------------------
     
     /// \brief Returns MDBX flags for a given key type.
@@ -424,12 +600,32 @@ namespace mdbxc {
         !is_key_byte_vector<T>::value &&
         !is_key_bitset<T>::value &&
         !is_key_integral<T>::value &&
+        !is_composite_key<T>::value &&
         !std::is_same<T, float>::value &&
         !std::is_same<T, double>::value, size_t>::type
     get_key_size(const T&) {
         return sizeof(T);
     }
     
+    /// \struct MutableByteView
+    /// \ingroup mdbxc_utils
+    /// \brief Non-owning C++11-compatible view over writable contiguous bytes.
+    /// \details Passed to \c update_bytes() callbacks; the bytes live on a
+    /// dirty page of the write transaction and the view is valid only for the
+    /// duration of the callback.
+    struct MutableByteView {
+        void*       data;
+        std::size_t size;
+
+        /// \brief Constructs an empty view.
+        MutableByteView() noexcept : data(nullptr), size(0) {}
+
+        /// \brief Constructs a view over \p data with \p size bytes.
+        /// \param data Pointer to the first byte.
+        /// \param size Number of bytes in the view.
+        MutableByteView(void* data, std::size_t size) noexcept : data(data), size(size) {}
+    };
+
     /// \class SerializeScratch
     /// \brief Per-call scratch buffer to produce \c MDBX_val without using \c thread_local.
     ///
@@ -553,7 +749,7 @@ namespace mdbxc {
     /// \param key The key to convert.
     /// \return MDBX_val representing the key.
     template <bool SafeIntegerKey = true, typename T>
-    typename std::enable_if<!has_to_bytes<T>::value && !std::is_same<T, std::string>::value && !std::is_trivially_copyable<T>::value, MDBX_val>::type
+    typename std::enable_if<!has_to_bytes<T>::value && !is_byte_string_key<T>::value && !is_composite_key<T>::value && !std::is_trivially_copyable<T>::value, MDBX_val>::type
     serialize_key(const T& key, SerializeScratch& sc) {
         (void)SafeIntegerKey;
         (void)key; 
@@ -722,6 +918,7 @@ namespace mdbxc {
         std::is_trivially_copyable<T>::value &&
         !std::is_same<T, std::string>::value &&
         !is_key_integral<T>::value &&
+        !is_composite_key<T>::value &&
         !std::is_same<T, float>::value &&
         !std::is_same<T, double>::value, MDBX_val>::type
     serialize_key(const T& key, SerializeScratch& sc) {
@@ -804,6 +1001,7 @@ namespace mdbxc {
     }
 
     /// \brief Serializes a vector of trivially copyable elements.
+    /// \details Returns a view over the vector storage without copying it.
     /// \tparam T Vector type.
     template<typename T>
     typename std::enable_if<
@@ -813,11 +1011,19 @@ namespace mdbxc {
         MDBX_val>::type
     serialize_value(const T& container, SerializeScratch& sc) {
         using Elem = typename T::value_type;
-        sc.bytes.resize(container.size() * sizeof(Elem));
+        (void)sc;
+        return SerializeScratch::view(static_cast<const void*>(container.data()),
+                                      container.size() * sizeof(Elem));
+    }
+
+    /// \brief Serializes a value through its \ref serializer specialization.
+    /// \tparam T Type with a \ref serializer specialization.
+    template<typename T>
+    typename std::enable_if<has_serializer<T>::value, MDBX_val>::type
+    serialize_value(const T& value, SerializeScratch& sc) {
+        sc.bytes.resize(static_cast<std::size_t>(serializer<T>::size(value)));
         if (!sc.bytes.empty()) {
-            std::memcpy(sc.bytes.data(),
-                        container.data(),
-                        sc.bytes.size());
+            serializer<T>::write(value, sc.bytes.data());
         }
         return sc.view_bytes();
     }
@@ -825,7 +1031,7 @@ namespace mdbxc {
     /// \brief Serializes a value using its `to_bytes()` method.
     /// \tparam T Type providing `to_bytes`.
     template<typename T>
-    typename std::enable_if<has_to_bytes<T>::value, MDBX_val>::type
+    typename std::enable_if<has_to_bytes<T>::value && !has_serializer<T>::value, MDBX_val>::type
     serialize_value(const T& value, SerializeScratch& sc) {
         sc.bytes = value.to_bytes();
         return sc.view_bytes();
@@ -836,6 +1042,7 @@ namespace mdbxc {
     template<typename T>
     typename std::enable_if<
         !has_to_bytes<T>::value &&
+        !has_serializer<T>::value &&
         std::is_trivially_copyable<T>::value,
         MDBX_val>::type
     serialize_value(const T& value, SerializeScratch& sc) {
@@ -875,6 +1082,198 @@ namespace mdbxc {
         return sc.view_bytes();
     }
 
+    // --- MDBX_RESERVE value writes ---
+
+    /// \brief Returns the serialized size of a value with a \ref serializer.
+    template<typename T>
+    typename std::enable_if<has_serializer<T>::value, std::size_t>::type
+    reserved_value_size(const T& value) {
+        return static_cast<std::size_t>(serializer<T>::size(value));
+    }
+
+    /// \brief Returns the serialized size of a self-writing value.
+    template<typename T>
+    typename std::enable_if<has_write_bytes<T>::value && !has_serializer<T>::value, std::size_t>::type
+    reserved_value_size(const T& value) {
+        return static_cast<std::size_t>(value.serialized_size());
+    }
+
+    /// \brief Returns the serialized size of a node container of trivially copyable elements.
+    template<typename T>
+    typename std::enable_if<
+        !has_write_bytes<T>::value && is_trivial_node_container<T>::value,
+        std::size_t>::type
+    reserved_value_size(const T& container) {
+        return container.size() * sizeof(typename T::value_type);
+    }
+
+    /// \brief Returns the serialized size of a container of strings.
+    template<typename T>
+    typename std::enable_if<
+        !has_write_bytes<T>::value &&
+        (is_string_sequence_container<T>::value || is_string_set_container<T>::value),
+        std::size_t>::type
+    reserved_value_size(const T& container) {
+        std::size_t size = 0;
+        for (typename T::const_iterator it = container.begin(); it != container.end(); ++it) {
+            size += sizeof(uint32_t) + it->size();
+        }
+        return size;
+    }
+
+    /// \brief Writes a value with a \ref serializer into reserved memory.
+    template<typename T>
+    typename std::enable_if<has_serializer<T>::value>::type
+    write_reserved_value(const T& value, void* dst) {
+        serializer<T>::write(value, static_cast<uint8_t*>(dst));
+    }
+
+    /// \brief Writes a self-writing value into reserved memory.
+    template<typename T>
+    typename std::enable_if<has_write_bytes<T>::value && !has_serializer<T>::value>::type
+    write_reserved_value(const T& value, void* dst) {
+        value.write_bytes(dst);
+    }
+
+    /// \brief Writes a node container of trivially copyable elements into reserved memory.
+    template<typename T>
+    typename std::enable_if<
+        !has_write_bytes<T>::value && is_trivial_node_container<T>::value>::type
+    write_reserved_value(const T& container, void* dst) {
+        typedef typename T::value_type Elem;
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        for (typename T::const_iterator it = container.begin(); it != container.end(); ++it) {
+            std::memcpy(out, &(*it), sizeof(Elem));
+            out += sizeof(Elem);
+        }
+    }
+
+    /// \brief Writes a container of strings into reserved memory.
+    /// \details Uses the same length-prefixed layout as \c serialize_value().
+    template<typename T>
+    typename std::enable_if<
+        !has_write_bytes<T>::value &&
+        (is_string_sequence_container<T>::value || is_string_set_container<T>::value)>::type
+    write_reserved_value(const T& container, void* dst) {
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        for (typename T::const_iterator it = container.begin(); it != container.end(); ++it) {
+            const uint32_t len = static_cast<uint32_t>(it->size());
+            std::memcpy(out, &len, sizeof(uint32_t));
+            out += sizeof(uint32_t);
+            if (len) std::memcpy(out, it->data(), len);
+            out += len;
+        }
+    }
+
+    /// \brief Stores a value with \c mdbx_put, serializing it directly into the MDBX page.
+    /// \details Reserve-capable values ask MDBX for \c MDBX_RESERVE space of the
+    /// exact serialized size and are written in place, skipping the scratch
+    /// buffer and the copy \c mdbx_put would make from it.
+    /// \param txn Write transaction.
+    /// \param dbi Target table; must not be \c MDBX_DUPSORT.
+    /// \param key Serialized key.
+    /// \param value Value to store.
+    /// \param db_val Receives the stored value bytes; valid until the next write in \p txn.
+    /// \param flags Put flags without \c MDBX_RESERVE.
+    /// \param sc Scratch storage (unused for reserve-capable values).
+    /// \return MDBX return code of \c mdbx_put.
+    template<typename T>
+    typename std::enable_if<is_reserved_value<T>::value, int>::type
+    put_serialized_value(MDBX_txn* txn, MDBX_dbi dbi, const MDBX_val* key, const T& value,
+                         MDBX_val& db_val, MDBX_put_flags_t flags, SerializeScratch& sc) {
+        MDBXC_TRACE_SCOPE(Serialize);
+        (void)sc;
+        const std::size_t size = reserved_value_size(value);
+        if (size == 0) {
+            db_val = SerializeScratch::view(nullptr, 0);
+            return mdbx_put(txn, dbi, key, &db_val, flags);
+        }
+        db_val.iov_base = nullptr;
+        db_val.iov_len = size;
+        const int rc = mdbx_put(txn, dbi, key, &db_val, flags | MDBX_RESERVE);
+        if (rc == MDBX_SUCCESS) {
+            write_reserved_value(value, db_val.iov_base);
+        }
+        return rc;
+    }
+
+    /// \brief Stores a value with \c mdbx_put through \c serialize_value().
+    /// \details Fallback for values that are already contiguous (strings,
+    /// \c std::vector of trivially copyable elements, trivially copyable
+    /// objects) or whose size is unknown before serialization (\c to_bytes()).
+    template<typename T>
+    typename std::enable_if<!is_reserved_value<T>::value, int>::type
+    put_serialized_value(MDBX_txn* txn, MDBX_dbi dbi, const MDBX_val* key, const T& value,
+                         MDBX_val& db_val, MDBX_put_flags_t flags, SerializeScratch& sc) {
+        MDBXC_TRACE_SCOPE(Serialize);
+        db_val = serialize_value(value, sc);
+        return mdbx_put(txn, dbi, key, &db_val, flags);
+    }
+
+    /// \brief Serializes a reserve-capable value into \p sc.
+    /// \details For callers that need the bytes before deciding to write,
+    /// such as a comparison with the stored value.
+    /// \return View of the serialized bytes; valid while \p sc is unchanged.
+    template<typename T>
+    typename std::enable_if<is_reserved_value<T>::value, MDBX_val>::type
+    serialize_value_to_scratch(const T& value, SerializeScratch& sc) {
+        MDBXC_TRACE_SCOPE(Serialize);
+        const std::size_t size = reserved_value_size(value);
+        sc.bytes.resize(size);
+        if (size) write_reserved_value(value, sc.bytes.data());
+        return sc.view_bytes();
+    }
+
+    /// \brief Serializes any other value through \c serialize_value().
+    template<typename T>
+    typename std::enable_if<!is_reserved_value<T>::value, MDBX_val>::type
+    serialize_value_to_scratch(const T& value, SerializeScratch& sc) {
+        MDBXC_TRACE_SCOPE(Serialize);
+        return serialize_value(value, sc);
+    }
+
+    /// \brief Lets \p fn edit the stored bytes of an existing value in place.
+    /// \details Re-puts the value with \c MDBX_CURRENT | \c MDBX_RESERVE at its
+    /// current size, which makes its page dirty (copy-on-write) and returns the
+    /// value location on that page. The previous bytes are restored there from
+    /// \p sc and \p fn then mutates them directly, so no deserialization or
+    /// serialization takes place. With \c MDBX_WRITEMAP the dirty page is the
+    /// mapped page itself.
+    /// \param txn Write transaction.
+    /// \param dbi Target table; must not be \c MDBX_DUPSORT.
+    /// \param key Serialized key.
+    /// \param fn Invoked as \c fn(MutableByteView&).
+    /// \param db_val Receives the stored value bytes; valid until the next write in \p txn.
+    /// \param sc Scratch storage for the previous bytes.
+    /// \return \c MDBX_SUCCESS, \c MDBX_NOTFOUND when \p key is absent, or another MDBX error.
+    template<typename Fn>
+    int patch_value_bytes(MDBX_txn* txn, MDBX_dbi dbi, const MDBX_val* key, Fn& fn,
+                          MDBX_val& db_val, SerializeScratch& sc) {
+        MDBX_val old_val;
+        int rc = mdbx_get(txn, dbi, key, &old_val);
+        if (rc != MDBX_SUCCESS) return rc;
+        const MDBX_val saved = sc.view_copy(old_val.iov_base, old_val.iov_len);
+        db_val.iov_base = nullptr;
+        db_val.iov_len = saved.iov_len;
+        rc = mdbx_put(txn, dbi, key, &db_val, MDBX_CURRENT | MDBX_RESERVE);
+        if (rc != MDBX_SUCCESS) return rc;
+        if (saved.iov_len) std::memcpy(db_val.iov_base, saved.iov_base, saved.iov_len);
+        MutableByteView view(db_val.iov_len ? db_val.iov_base : nullptr, db_val.iov_len);
+        fn(view);
+        return MDBX_SUCCESS;
+    }
+
+    /// \brief Returns \p data as an element array if it is aligned for \p Elem.
+    /// \details MDBX values are only byte-aligned. Aligned ones are copied
+    /// with a single range construction; others return \c nullptr and take
+    /// the \c memcpy path.
+    template<typename Elem>
+    inline const Elem* aligned_elements(const void* data) noexcept {
+        return (reinterpret_cast<std::uintptr_t>(data) % alignof(Elem)) == 0
+            ? static_cast<const Elem*>(data)
+            : nullptr;
+    }
+
     // --- deserialize_value overloads ---
     
     /// \brief Deserializes a value from MDBX_val into type \c T.
@@ -885,6 +1284,7 @@ namespace mdbxc {
     typename std::enable_if<
         !has_value_type<T>::value &&
         !has_from_bytes<T>::value &&
+        !has_serializer<T>::value &&
         !std::is_same<T, std::string>::value &&
         !std::is_trivially_copyable<T>::value, T>::type
     deserialize_value(const MDBX_val& val) {
@@ -977,6 +1377,9 @@ namespace mdbxc {
         if (val.iov_len % sizeof(Elem) != 0)
             throw std::runtime_error("deserialize_value: size not aligned");
         const size_t count = val.iov_len / sizeof(Elem);
+        if (const Elem* first = aligned_elements<Elem>(val.iov_base)) {
+            return T(first, first + count);
+        }
         T out(count);
         if (count) {
             std::memcpy(out.data(), val.iov_base, val.iov_len);
@@ -1007,12 +1410,14 @@ namespace mdbxc {
             throw std::runtime_error("deserialize_value: size not aligned");
         }
         const size_t count = val.iov_len / sizeof(Elem);
+        if (const Elem* first = aligned_elements<Elem>(val.iov_base)) {
+            return T(first, first + count);
+        }
         const uint8_t* data = static_cast<const uint8_t*>(val.iov_base);
-        T out;
-        for (size_t i = 0; i < count; ++i) {
-            Elem elem;
-            std::memcpy(&elem, data + i * sizeof(Elem), sizeof(Elem));
-            out.push_back(elem);
+        T out(count);
+        typename T::iterator it = out.begin();
+        for (size_t i = 0; i < count; ++i, ++it) {
+            std::memcpy(&*it, data + i * sizeof(Elem), sizeof(Elem));
         }
         return out;
     }
@@ -1067,7 +1472,8 @@ namespace mdbxc {
     /// \tparam T Trivially copyable type.
     template<typename T>
     typename std::enable_if<
-        !has_from_bytes<T>::value && std::is_trivially_copyable<T>::value, T>::type
+        !has_from_bytes<T>::value && !has_serializer<T>::value &&
+        std::is_trivially_copyable<T>::value, T>::type
     deserialize_value(const MDBX_val& val) {
         if (val.iov_len != sizeof(T)) {
             throw std::runtime_error("deserialize_value: size mismatch");
@@ -1080,11 +1486,19 @@ namespace mdbxc {
     /// \brief Deserializes a value using its `from_bytes()` method.
     /// \tparam T Type providing `from_bytes`.
     template<typename T>
-    typename std::enable_if<has_from_bytes<T>::value, T>::type
+    typename std::enable_if<has_from_bytes<T>::value && !has_serializer<T>::value, T>::type
     deserialize_value(const MDBX_val& val) {
         return T::from_bytes(val.iov_base, val.iov_len);
     }
 
+    /// \brief Deserializes a value through its \ref serializer specialization.
+    /// \tparam T Type with a \ref serializer specialization.
+    template<typename T>
+    typename std::enable_if<has_serializer<T>::value, T>::type
+    deserialize_value(const MDBX_val& val) {
+        return serializer<T>::read(static_cast<const uint8_t*>(val.iov_base), val.iov_len);
+    }
+
     /// \brief Deserializes a sequence container of strings.
     /// \tparam T `std::vector`, `std::deque`, or `std::list` of `std::string`.
     template<typename T>
@@ -1304,6 +1718,7 @@ namespace mdbxc {
         std::is_trivially_copyable<T>::value &&
         !std::is_same<T, std::string>::value &&
         !is_key_integral<T>::value &&
+        !is_composite_key<T>::value &&
         !std::is_same<T, float>::value &&
         !std::is_same<T, double>::value, T>::type
     deserialize_key(const MDBX_val& val) {
@@ -19,30 +19,51 @@
 #include "sync/CodecBounds.hpp"
 #include "sync/ChangeBatch.hpp"
 #include "sync/ChangeBatchCodec.hpp"
+#include "sync/ChangeBatchView.hpp"
 #include "sync/ChangeAccumulator.hpp"
 #include "sync/SyncCaptureScope.hpp"
 #include "sync/cancellation.hpp"
 #include "sync/ConflictPolicy.hpp"
 #include "sync/ISyncCaptureSink.hpp"
 #include "sync/SyncApplyObserver.hpp"
+#include "sync/SyncTracing.hpp"
 #include "sync/IdentityProvider.hpp"
 #include "sync/ISyncPeer.hpp"
+#include "sync/IAsyncSyncPeer.hpp"
 #include "sync/SyncCursor.hpp"
 #include "sync/protocol.hpp"
 #include "sync/TransportMessageCodec.hpp"
+#include "sync/SnapshotExport.hpp"
+#include "sync/ChangeLogCompaction.hpp"
+#include "sync/ChangeLogRetention.hpp"
 #include "sync/SyncEngine.hpp"
+#include "sync/ChangeLogPruner.hpp"
 #include "sync/SyncWorker.hpp"
+#include "sync/MultiPeerSyncWorker.hpp"
+#include "sync/SyncPusher.hpp"
+#include "sync/RangeHashVerifier.hpp"
 #include "sync/SyncWorkerGuard.hpp"
 #include "sync/SyncNodeSession.hpp"
 #include "sync/DirectSyncPeer.hpp"
+#include "sync/ShardedPushApplier.hpp"
+#include "sync/PushApplyQueue.hpp"
+#include "sync/PullPageCache.hpp"
 #include "sync/HttpTransport.hpp"
 #include "sync/WebSocketTransport.hpp"
+#include "sync/SharedMemoryTransport.hpp"
 #include "sync/TransportMiddleware.hpp"
+#include "sync/OpenMetrics.hpp"
 #include "sync/stores/MetaStore.hpp"
 #include "sync/stores/OriginIndexStore.hpp"
+#include "sync/stores/PeerWatermarkStore.hpp"
+#include "sync/stores/PushStagingStore.hpp"
+#include "sync/OriginTailCache.hpp"
+#include "sync/AppliedCursorCache.hpp"
+#include "sync/stores/ChangeLogDbiIndexStore.hpp"
 #include "sync/stores/ChangeLogStore.hpp"
 #include "sync/stores/AppliedStore.hpp"
 #include "sync/stores/IdentityIndexStore.hpp"
+#include "sync/stores/RangeHashStore.hpp"
 #endif
 
 #endif // MDBX_CONTAINERS_HEADER_SYNC_HPP_INCLUDED
@@ -0,0 +1,137 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_APPLIED_CURSOR_CACHE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_APPLIED_CURSOR_CACHE_HPP_INCLUDED
+
+/// \file AppliedCursorCache.hpp
+/// \brief In-memory copy of the \c _mdbxc_applied cursor.
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "SyncCursor.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Applied cursor of one \c _mdbxc_applied version.
+    /// \details A version is the \c ms_mod_txnid of the applied DBI, as with
+    /// \c OriginTailCache. The cache also remembers the newest environment
+    /// transaction id known to carry that version, so a reader that finds
+    /// the same id through \c mdbx_env_info_ex() needs no transaction at all.
+    /// \c SyncEngine fills the cache from a read that missed and advances it
+    /// after each push commit while the sync-apply write guard is held, so
+    /// response construction and worker rounds do not walk the store.
+    /// \thread_safety Thread-safe.
+    class AppliedCursorCache {
+    public:
+        /// \brief Copies the cursor when nothing committed since \p env_txnid.
+        /// \return \c false when the cache was filled at another transaction.
+        bool lookup(std::uint64_t env_txnid, SyncCursor& out) const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (!m_valid || m_env_txnid != env_txnid) {
+                return false;
+            }
+            out = m_cursor;
+            return true;
+        }
+
+        /// \brief As \ref lookup(), also reporting the store version of the
+        /// cursor in \p applied_txnid.
+        bool lookup(std::uint64_t env_txnid,
+                    SyncCursor& out,
+                    std::uint64_t& applied_txnid) const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (!m_valid || m_env_txnid != env_txnid) {
+                return false;
+            }
+            out = m_cursor;
+            applied_txnid = m_applied_txnid;
+            return true;
+        }
+
+        /// \brief Copies the cursor of store version \p applied_txnid.
+        /// \param env_txnid Snapshot the version was read from; later
+        ///        \ref lookup() calls with it hit.
+        /// \return \c false when the cache holds another version or none.
+        bool lookup_version(std::uint64_t applied_txnid,
+                            std::uint64_t env_txnid,
+                            SyncCursor& out) {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (!m_valid || m_applied_txnid != applied_txnid) {
+                return false;
+            }
+            if (env_txnid > m_env_txnid) {
+                m_env_txnid = env_txnid;
+            }
+            out = m_cursor;
+            return true;
+        }
+
+        /// \brief Caches \p cursor read from store version \p applied_txnid
+        /// in snapshot \p env_txnid.
+        /// \details An older version than the cached one is ignored.
+        void store(std::uint64_t applied_txnid,
+                   std::uint64_t env_txnid,
+                   SyncCursor cursor) {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (m_valid && applied_txnid < m_applied_txnid) {
+                return;
+            }
+            if (m_valid && applied_txnid == m_applied_txnid) {
+                if (env_txnid > m_env_txnid) {
+                    m_env_txnid = env_txnid;
+                }
+                return;
+            }
+            m_cursor = std::move(cursor);
+            m_applied_txnid = applied_txnid;
+            m_env_txnid = env_txnid;
+            m_valid = true;
+        }
+
+        /// \brief Applies a committed push that raised the origins in \p tails.
+        /// \param base_txnid Store version the pushing transaction started from.
+        /// \param applied_txnid Store version the push committed.
+        /// \param env_txnid Id of the committed transaction.
+        /// \details Ignored unless the cache holds \p base_txnid; the next
+        /// read then refills it.
+        void committed_advance(std::uint64_t base_txnid,
+                               std::uint64_t applied_txnid,
+                               std::uint64_t env_txnid,
+                               const std::map<NodeId, std::uint64_t>& tails) {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (!m_valid || m_applied_txnid != base_txnid) {
+                return;
+            }
+            std::map<NodeId, std::uint64_t>::const_iterator it = tails.begin();
+            for (; it != tails.end(); ++it) {
+                std::uint64_t& seq = m_cursor.last_seq_by_origin[it->first];
+                if (seq < it->second) {
+                    seq = it->second;
+                }
+            }
+            m_applied_txnid = applied_txnid;
+            m_env_txnid = env_txnid;
+        }
+
+        /// \brief Drops the cached cursor.
+        void invalidate() noexcept {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_valid = false;
+            m_cursor.last_seq_by_origin.clear();
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        bool m_valid = false;
+        std::uint64_t m_applied_txnid = 0; ///< Store \c ms_mod_txnid the cursor reflects.
+        std::uint64_t m_env_txnid = 0;     ///< Newest snapshot known to carry that version.
+        SyncCursor m_cursor;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_APPLIED_CURSOR_CACHE_HPP_INCLUDED
@@ -6,7 +6,21 @@
 /// \brief Default \c ISyncCaptureSink that buffers per-transaction ops and
 /// writes a single \c ChangeBatch to \c _mdbxc_changelog on flush.
 /// \details
-/// Pending ops are kept in a \c std::unordered_map keyed by the
+/// Each transaction owns a capture arena: one byte buffer that starts with
+/// a reserved batch header, followed by ops encoded in \c ChangeBatchCodec
+/// wire format as they are recorded. Key and value bytes are copied once,
+/// from the MDBX buffers into the arena, and the arena itself is the
+/// changelog value, so no \c ChangeOp or \c ChangeBatch is materialised.
+/// Flushed arenas are kept for reuse by later transactions.
+///
+/// Recording takes no lock on the hot path. MDBX write transactions are
+/// bound to their thread, so each thread caches the arena of its current
+/// transaction in a trivially destructible \c thread_local slot keyed by a
+/// unique accumulator id and an epoch. Only the first op of a transaction,
+/// \c flush_in_txn and \c discard_txn take the mutex; the latter two bump
+/// the epoch, which sends every thread back to the map once.
+///
+/// Pending arenas are owned by a \c std::unordered_map keyed by the
 /// \c MDBX_txn* pointer of the about-to-commit write transaction. A thread
 /// may have multiple distinct write transactions in different RAII guards;
 /// the pointer key keeps their pending lists separate, so a transaction
@@ -14,27 +28,45 @@
 /// the next transaction on the same thread.
 ///
 /// On \c flush_in_txn the accumulator:
-///  1. moves the pending ops for this \p txn out of the map under one
+///  1. moves the arena for this \p txn out of the map under one
 ///     mutex acquisition;
-///  2. opens the system stores \c _mdbxc_meta and \c _mdbxc_changelog on
-///     first use, then resolves the local \c node_id from \c _mdbxc_meta
-///     and refuses to flush when \c node_id is still the all-zero
-///     placeholder (the \c SyncEngine must initialise it before capture
-///     is enabled);
-///  3. builds one \c ChangeBatch, increments \c local_seq on \c _mdbxc_meta,
-///     encodes the batch and appends it to \c _mdbxc_changelog inside the
-///     same write transaction;
-///  4. on any exception, restores the moved-out ops back into the map keyed
+///  2. opens the system stores \c _mdbxc_meta and \c _mdbxc_changelog
+///     unless their handles were opened by a transaction that committed,
+///     then resolves the local \c node_id from \c _mdbxc_meta and refuses
+///     to flush when \c node_id is still the all-zero placeholder (the
+///     \c SyncEngine must initialise it before capture is enabled);
+///  3. increments \c local_seq on \c _mdbxc_meta, writes the batch header
+///     into the arena and appends it to \c _mdbxc_changelog inside the
+///     same write transaction. The seq is kept in memory and only written;
+///     it is read back from \c _mdbxc_meta unless the previous flush
+///     committed in the transaction just before this one, so commits by
+///     other writers or processes are never missed;
+///  4. on any exception, restores the moved-out arena back into the map keyed
 ///     by \p txn so a retry of the same write transaction can re-emit them;
 ///  5. on \c discard_txn, drops the pending ops for an aborted transaction
 ///     so a future commit on the same address (allocator reuse) cannot pick
 ///     them up as if they were committed.
+///
+/// With \c BatchCompression::enabled, an arena whose ops reach
+/// \c min_bytes is stored with \c BATCH_COMPRESSED_ZSTD, so the changelog
+/// and pulls by peers that accept compressed batches both shrink.
+///
+/// Each committed append also raises the local origin in the sink's
+/// \c OriginTailCache, which \c SyncEngine serves pulls from.
+///
+/// When \c _mdbxc_range_hash exists, the flush also updates the range
+/// hashes of the enabled tables the batch wrote, in the same transaction.
 
 #if MDBXC_SYNC_ENABLED
 
+#include <chrono>
+
+#include "ChangeBatchCodec.hpp"
 #include "ISyncCaptureSink.hpp"
+#include "OriginTailCache.hpp"
 #include "stores/ChangeLogStore.hpp"
 #include "stores/MetaStore.hpp"
+#include "stores/RangeHashStore.hpp"
 
 namespace mdbxc {
 namespace sync {
@@ -45,10 +77,18 @@ namespace sync {
         /// \brief Constructs an accumulator bound to \p conn.
         /// \param conn Shared connection whose \c _mdbxc_changelog and
         ///        \c _mdbxc_meta DBIs will be opened lazily on first flush.
-        explicit ThreadLocalChangeAccumulator(std::shared_ptr<Connection> conn)
+        /// \param compression Compression of stored batches; ignored in
+        ///        builds without \c MDBXC_HAS_ZSTD.
+        explicit ThreadLocalChangeAccumulator(std::shared_ptr<Connection> conn,
+                                              const BatchCompression& compression =
+                                                  BatchCompression())
             : m_env(conn->env_handle()),
+              m_id(next_accumulator_id()),
+              m_compression(compression),
               m_meta(m_env),
-              m_change_log(m_env) {}
+              m_change_log(m_env),
+              m_range_hash(m_env),
+              m_tail_cache(std::make_shared<OriginTailCache>()) {}
 
         void record_change(MDBX_txn* txn,
                            const std::string& dbi_name,
@@ -57,57 +97,166 @@ namespace sync {
                            const std::vector<std::uint8_t>& storage_key,
                            const std::vector<std::uint8_t>& value) override {
             txn = checked_txn_env(txn, m_env, "ThreadLocalChangeAccumulator::record_change");
-            PendingOp op;
-            op.op_type = op_type;
-            op.dbi_flags = dbi_flags;
-            op.dbi_name = dbi_name;
-            op.storage_key = storage_key;
-            op.value = value;
-            std::lock_guard<std::mutex> lk(m_mutex);
-            m_pending[txn].push_back(std::move(op));
+            append_op(txn, dbi_name, op_type, dbi_flags,
+                      storage_key.empty() ? nullptr : &storage_key[0], storage_key.size(),
+                      value.empty() ? nullptr : &value[0], value.size());
+        }
+
+        void record_change_view(MDBX_txn* txn,
+                                const std::string& dbi_name,
+                                ChangeOpType op_type,
+                                std::uint32_t dbi_flags,
+                                const MDBX_val& storage_key,
+                                const MDBX_val& value) override {
+            txn = checked_txn_env(txn, m_env, "ThreadLocalChangeAccumulator::record_change");
+            append_op(txn, dbi_name, op_type, dbi_flags,
+                      storage_key.iov_base, storage_key.iov_len,
+                      value.iov_base, value.iov_len);
         }
 
         void flush_in_txn(MDBX_txn* txn) override {
             txn = checked_txn_env(txn, m_env, "ThreadLocalChangeAccumulator::flush_in_txn");
-            std::vector<PendingOp> ops;
+            PendingBatch batch;
+            const std::uint64_t txn_id = mdbx_txn_id(txn);
+            bool stores_ready = false;
+            bool range_hash_ready = false;
+            bool seq_known = false;
+            std::uint64_t seq = 0;
             {
                 std::lock_guard<std::mutex> lk(m_mutex);
                 auto it = m_pending.find(txn);
-                if (it == m_pending.end() || it->second.empty()) {
+                if (it == m_pending.end() || it->second.ops_count == 0) {
                     return;
                 }
-                ops.swap(it->second);
+                batch.bytes.swap(it->second.bytes);
+                batch.ops_count = it->second.ops_count;
+                batch.names.names.swap(it->second.names.names);
+                it->second.ops_count = 0;
+                stores_ready = m_stores_ready;
+                range_hash_ready = m_range_hash_ready;
+                // Ids grow by one per commit, so no other commit came between.
+                seq_known = m_seq_ready && txn_id == m_seq_txn_id + 1;
+                seq = m_local_seq;
             }
 
             try {
-                open_stores(txn);
-                build_and_append_batch(txn, ops);
+                if (!stores_ready) {
+                    open_stores(txn);
+                }
+                seq = (seq_known ? seq : m_meta.get_local_seq(txn)) + 1;
+                std::uint64_t index_base = 0;
+                std::uint64_t index_after = 0;
+                append_batch(txn, batch, seq, index_base, index_after);
+                if (!range_hash_ready) {
+                    // Looked up per flush until a table enables range hashes.
+                    m_range_hash.reset_open();
+                    m_range_hash.open_existing(txn);
+                }
+                if (m_range_hash.is_open()) {
+                    m_range_hash.refresh_batch(txn, &batch.bytes[0], batch.bytes.size());
+                }
                 std::lock_guard<std::mutex> lk(m_mutex);
                 m_pending.erase(txn);
+                m_epoch.fetch_add(1, std::memory_order_release);
+                recycle(batch.bytes);
+                m_flush_pending = true;
+                m_flush_txn_id = txn_id;
+                m_flush_seq = seq;
+                m_flush_index_base = index_base;
+                m_flush_index_after = index_after;
+                m_flush_range_hash = m_range_hash.is_open();
             } catch (...) {
                 std::lock_guard<std::mutex> lk(m_mutex);
-                m_pending[txn] = std::move(ops);
+                m_pending[txn] = std::move(batch);
                 throw;
             }
         }
 
+        std::shared_ptr<OriginTailCache> origin_tail_cache() const override {
+            return m_tail_cache;
+        }
+
     private:
-        struct PendingOp {
-            ChangeOpType op_type = ChangeOpType::Put;
-            std::uint32_t dbi_flags = 0;
-            std::string dbi_name;
-            std::vector<std::uint8_t> storage_key;
-            std::vector<std::uint8_t> value;
+        /// \brief Capture arena of one write transaction.
+        struct PendingBatch {
+            std::vector<std::uint8_t> bytes; ///< Reserved header, then encoded ops.
+            std::uint32_t ops_count = 0;
+            ChangeBatchCodec::NameDictionary names; ///< Table names written to \c bytes.
         };
 
+        /// \brief Per-thread cache of the arena of the current transaction.
+        /// \details Trivially destructible, so it is safe as \c thread_local
+        /// storage on MinGW. \c batch is valid only while \c owner and
+        /// \c epoch match the accumulator.
+        struct ThreadSlot {
+            std::uint64_t owner;
+            std::uint64_t epoch;
+            MDBX_txn* txn;
+            PendingBatch* batch;
+        };
+
+        static ThreadSlot& thread_slot() noexcept {
+            static thread_local ThreadSlot slot = { 0, 0, nullptr, nullptr };
+            return slot;
+        }
+
+        static std::uint64_t next_accumulator_id() noexcept {
+            static std::atomic<std::uint64_t> counter{0};
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        /// \brief Spare arenas kept for reuse, and the largest capacity kept.
+        static const std::size_t max_spare_buffers = 4;
+        static const std::size_t max_spare_capacity = 1u << 20;
+
+        void append_op(MDBX_txn* txn,
+                       const std::string& dbi_name,
+                       ChangeOpType op_type,
+                       std::uint32_t dbi_flags,
+                       const void* storage_key,
+                       std::size_t storage_key_len,
+                       const void* value,
+                       std::size_t value_len) {
+            ThreadSlot& slot = thread_slot();
+            const std::uint64_t epoch = m_epoch.load(std::memory_order_acquire);
+            PendingBatch* batch = slot.batch;
+            if (slot.owner != m_id || slot.epoch != epoch || slot.txn != txn) {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                batch = &m_pending[txn];
+                if (batch->bytes.empty()) {
+                    if (!m_spare.empty()) {
+                        batch->bytes.swap(m_spare.back());
+                        m_spare.pop_back();
+                    }
+                    batch->bytes.resize(ChangeBatchCodec::header_size());
+                }
+                slot.owner = m_id;
+                slot.epoch = epoch;
+                slot.txn = txn;
+                slot.batch = batch;
+            }
+            // Map nodes never move, and only this thread writes to its txn.
+            ChangeBatchCodec::append_op(batch->bytes, batch->names, op_type, dbi_flags, dbi_name,
+                                        storage_key, storage_key_len, value, value_len);
+            ++batch->ops_count;
+        }
+
+        /// \brief Keeps a flushed arena for reuse; call with \c m_mutex held.
+        void recycle(std::vector<std::uint8_t>& bytes) {
+            if (m_spare.size() >= max_spare_buffers || bytes.capacity() > max_spare_capacity) {
+                return;
+            }
+            bytes.clear();
+            m_spare.push_back(std::vector<std::uint8_t>());
+            m_spare.back().swap(bytes);
+        }
+
         void open_stores(MDBX_txn* txn) {
-            /// \note Each flush_in_txn call must reopen the stores inside the
-            /// about-to-commit write transaction. \c m_open is set on first
-            /// \c open() and never reset; if a previous flush_in_txn succeeded
-            /// and committed, the wrapped \c m_dbi handle refers to a previous
-            /// transaction and any subsequent \c mdbx_put/\c mdbx_get on it
-            /// returns MDBX_EINVAL. Force-reopen here to keep one accumulator
-            /// alive across many transactions.
+            /// \note Handles opened by a transaction that later aborts are
+            /// closed by MDBX, so the stores are reopened inside the
+            /// about-to-commit transaction until \c committed_txn() confirms
+            /// that a transaction which opened them committed; from then on
+            /// they stay valid until \c env_closed().
             m_meta.reset_open();
             m_meta.open(txn);
             m_change_log.reset_open();
@@ -124,35 +273,102 @@ namespace sync {
             }
         }
 
-        void build_and_append_batch(MDBX_txn* txn, const std::vector<PendingOp>& ops) {
-            ChangeBatch batch;
-            batch.version = 1;
-            batch.origin_node_id = m_node_id;
-            batch.seq = m_meta.increment_local_seq(txn);
-            batch.ops.reserve(ops.size());
-            for (const PendingOp& op : ops) {
-                ChangeOp co;
-                co.op_type = op.op_type;
-                co.dbi_flags = op.dbi_flags;
-                co.dbi_name = op.dbi_name;
-                co.storage_key = op.storage_key;
-                co.value = op.value;
-                batch.ops.push_back(std::move(co));
+        /// \brief Writes the batch; \p index_base and \p index_after receive
+        /// the origin index version before and after the append.
+        void append_batch(MDBX_txn* txn, PendingBatch& batch, std::uint64_t seq,
+                          std::uint64_t& index_base, std::uint64_t& index_after) {
+            m_meta.set_local_seq(txn, seq);
+            // The commit time lets retention prune by age.
+            const std::uint64_t time_unix_ns = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+            ChangeBatchCodec::write_header(&batch.bytes[0], BATCH_NONE, m_node_id,
+                                           seq, time_unix_ns, batch.ops_count);
+            index_base = m_change_log.origin_index_txnid(txn);
+            // The arena stays plain, so a retried flush can rewrite its header.
+            std::vector<std::uint8_t> packed;
+            if (m_compression.enabled &&
+                ChangeBatchCodec::compress(batch.bytes, packed, m_compression.min_bytes,
+                                           m_compression.level)) {
+                m_change_log.append(txn, m_node_id, seq, packed);
+            } else {
+                m_change_log.append(txn, m_node_id, seq, batch.bytes);
             }
-            const std::vector<std::uint8_t> bytes = ChangeBatchCodec::encode(batch);
-            m_change_log.append(txn, m_node_id, batch.seq, bytes);
+            index_after = m_change_log.origin_index_txnid(txn);
         }
 
         MDBX_env* m_env;
+        const std::uint64_t m_id;
+        const BatchCompression m_compression;
+        std::atomic<std::uint64_t> m_epoch{0};
         NodeId m_node_id{};
         MetaStore m_meta;
         ChangeLogStore m_change_log;
+        RangeHashStore m_range_hash;
         std::mutex m_mutex;
-        std::unordered_map<MDBX_txn*, std::vector<PendingOp>> m_pending;
+        std::unordered_map<MDBX_txn*, PendingBatch> m_pending;
+        std::vector<std::vector<std::uint8_t>> m_spare;
+        bool m_stores_ready = false;      ///< Store handles were opened by a committed transaction.
+        bool m_range_hash_ready = false;  ///< Same for \c m_range_hash.
+        bool m_flush_range_hash = false;  ///< The pending flush had \c m_range_hash open.
+        bool m_seq_ready = false;         ///< \c m_local_seq was committed in \c m_seq_txn_id.
+        std::uint64_t m_seq_txn_id = 0;
+        std::uint64_t m_local_seq = 0;
+        bool m_flush_pending = false;     ///< A flush waits for its commit or discard.
+        std::uint64_t m_flush_txn_id = 0;
+        std::uint64_t m_flush_seq = 0;
+        std::uint64_t m_flush_index_base = 0;  ///< Origin index version before the pending flush.
+        std::uint64_t m_flush_index_after = 0; ///< Origin index version the pending flush wrote.
+        const std::shared_ptr<OriginTailCache> m_tail_cache;
 
         void discard_txn(MDBX_txn* txn) noexcept override {
             std::lock_guard<std::mutex> lk(m_mutex);
-            m_pending.erase(txn);
+            // A flushed transaction that aborts leaves the committed seq as is.
+            m_flush_pending = false;
+            if (!m_range_hash_ready) {
+                m_range_hash.reset_open();
+            }
+            auto it = m_pending.find(txn);
+            if (it == m_pending.end()) {
+                return;
+            }
+            try {
+                recycle(it->second.bytes);
+            } catch (...) {
+            }
+            m_pending.erase(it);
+            m_epoch.fetch_add(1, std::memory_order_release);
+        }
+
+        void committed_txn(std::uint64_t txn_id) noexcept override {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (!m_flush_pending || txn_id != m_flush_txn_id) {
+                return;
+            }
+            m_flush_pending = false;
+            m_stores_ready = true;
+            m_range_hash_ready = m_flush_range_hash;
+            m_seq_ready = true;
+            m_seq_txn_id = txn_id;
+            m_local_seq = m_flush_seq;
+            if (m_flush_index_after == m_flush_index_base) {
+                return;
+            }
+            try {
+                m_tail_cache->committed_append(m_flush_index_base, m_flush_index_after,
+                                               m_node_id, m_flush_seq);
+            } catch (...) {
+                m_tail_cache->invalidate();
+            }
+        }
+
+        void env_closed() noexcept override {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_stores_ready = false;
+            m_range_hash_ready = false;
+            m_seq_ready = false;
+            m_flush_pending = false;
+            m_tail_cache->invalidate();
         }
     };
 
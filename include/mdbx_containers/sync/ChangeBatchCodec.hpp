@@ -8,7 +8,7 @@
 /// Wire layout:
 /// \code
 ///   magic            "MDBXCSYN"   8 bytes
-///   codec_version    u16 le       = 1
+///   codec_version    u16 le       = 2
 ///   batch_version    u32 le       = 1
 ///   batch_flags      u32 le
 ///   origin_node_id   16 bytes
@@ -17,34 +17,120 @@
 ///   ops_count        u32 le
 ///   for each op:
 ///     op_type        u8
-///     op_flags       u32 le
-///     dbi_flags      u32 le
-///     dbi_name_len   u32 le
-///     dbi_name       [u8; ...]
-///     storage_key_len u32 le
+///     op_flags       varint
+///     dbi_flags      varint
+///     dbi_ref        varint       index of the table name in this batch
+///     dbi_name_len   varint       (only when dbi_ref is a new index)
+///     dbi_name       [u8; ...]    (only when dbi_ref is a new index)
+///     storage_key_len varint
 ///     storage_key    [u8; ...]
-///     value_len      u32 le       (0xFFFFFFFF = absent)
-///     value          [u8; ...]    (omitted if value_len == 0xFFFFFFFF)
-///     identity_key_len u32 le     (omitted if !(op_flags & OP_HAS_IDENTITY_KEY))
+///     value_len      varint       (0 = absent)
+///     value          [u8; ...]
+///     identity_key_len varint     (omitted if !(op_flags & OP_HAS_IDENTITY_KEY))
 ///     identity_key   [u8; ...]
-///     revision_key_len u32 le     (omitted if !(op_flags & OP_HAS_REVISION_KEY))
+///     revision_key_len varint     (omitted if !(op_flags & OP_HAS_REVISION_KEY))
 ///     revision_key   [u8; ...]
 /// \endcode
+/// Varints are unsigned LEB128 and must fit in 32 bits. Table names form a
+/// per-batch dictionary built in op order: \c dbi_ref equal to the number
+/// of names seen so far introduces the next name, a smaller one reuses it,
+/// so a table name is stored once per batch and a streaming writer never
+/// goes back to patch a table of names.
+///
+/// Codec version 1 batches are still decoded. They store every field of an
+/// op as u32 le and repeat \c dbi_name_len and \c dbi_name in every op
+/// instead of \c dbi_ref, with \c value_len 0xFFFFFFFF for an absent value.
+///
 /// Mandatory unknown bits in either \c batch_flags or \c op_flags trigger a
-/// decode error. \c BATCH_COMPRESSED_ZSTD is reserved and explicitly
-/// rejected.
+/// decode error.
+///
+/// With \c BATCH_COMPRESSED_ZSTD set, everything after \c ops_count is
+/// replaced by:
+/// \code
+///   ops_raw_len      u32 le       size of the plain ops section
+///   ops_packed_len   u32 le
+///   ops_packed       [u8; ...]    one Zstd frame of the plain ops section
+/// \endcode
+/// Compressed batches need a build with \c MDBXC_HAS_ZSTD=1; other builds
+/// reject the flag on both paths, see \ref batch_compression_supported().
 
 #include "ChangeBatch.hpp"
 #include "CodecBounds.hpp"
 #include "codec_flags.hpp"
 #include "common.hpp"
+#include "../common/CompactCodec.hpp"
+#include "../common/TraceScope.hpp"
+
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+#include <zstd.h>
+#endif
 
 namespace mdbxc {
 namespace sync {
 
+    /// \brief When a writer stores or sends batches with \c BATCH_COMPRESSED_ZSTD.
+    struct BatchCompression {
+        /// \brief Compress batches; has no effect without \c MDBXC_HAS_ZSTD.
+        bool enabled = false;
+        /// \brief Plain ops sections smaller than this stay uncompressed.
+        std::size_t min_bytes = 1024;
+        /// \brief Zstd compression level.
+        int level = 3;
+    };
+
+    /// \brief One encoded op as views into the batch bytes.
+    /// \details Filled by \ref ChangeBatchCodec::Reader; the pointers stay
+    /// valid while the bytes the op was read from live. Absent fields have
+    /// a null pointer and length 0.
+    struct ChangeOpView {
+        ChangeOpType op_type = ChangeOpType::Put;
+        std::uint32_t op_flags = 0;
+        std::uint32_t dbi_flags = 0;
+        const char* dbi_name = nullptr;
+        std::size_t dbi_name_len = 0;
+        const std::uint8_t* storage_key = nullptr;
+        std::size_t storage_key_len = 0;
+        const std::uint8_t* value = nullptr;
+        std::size_t value_len = 0;
+        const std::uint8_t* identity_key = nullptr;
+        std::size_t identity_key_len = 0;
+        const std::uint8_t* revision_key = nullptr;
+        std::size_t revision_key_len = 0;
+
+        /// \brief Copies the op into an owning \c ChangeOp.
+        ChangeOp to_op() const {
+            ChangeOp op;
+            op.op_type = op_type;
+            op.op_flags = op_flags;
+            op.dbi_flags = dbi_flags;
+            if (dbi_name_len != 0) {
+                op.dbi_name.assign(dbi_name, dbi_name_len);
+            }
+            op.storage_key.assign(storage_key, storage_key + storage_key_len);
+            op.value.assign(value, value + value_len);
+            op.identity_key.assign(identity_key, identity_key + identity_key_len);
+            op.revision_key.assign(revision_key, revision_key + revision_key_len);
+            return op;
+        }
+    };
+
     /// \brief Stable binary codec for \c ChangeBatch.
     class ChangeBatchCodec {
     public:
+        /// \brief Table names already written to one batch.
+        /// \details Used by writers that stream ops with \ref append_op();
+        /// start every batch with an empty dictionary.
+        struct NameDictionary {
+            std::vector<std::string> names; ///< Names in order of first use.
+            std::size_t last = 0;           ///< Index of the last name looked up.
+
+            /// \brief Forgets all names for the next batch.
+            void clear() {
+                names.clear();
+                last = 0;
+            }
+        };
+
         /// \brief Encoded magic prefix (8 bytes, no NUL terminator).
         static const std::uint8_t* magic() {
             static const std::uint8_t m[8] = { 'M','D','B','X','C','S','Y','N' };
@@ -54,27 +140,36 @@ namespace sync {
         /// \brief Magic prefix length in bytes.
         static std::size_t magic_size() { return 8; }
 
-        /// \brief Supported codec version.
-        static std::uint16_t codec_version() { return 1; }
+        /// \brief Codec version written by the encoder.
+        static std::uint16_t codec_version() { return 2; }
+
+        /// \brief Oldest codec version the decoder accepts.
+        static std::uint16_t min_codec_version() { return 1; }
 
         /// \brief Supported batch schema version.
         static std::uint32_t batch_version() { return 1; }
 
         /// \brief Encodes a batch into a byte vector.
+        /// \details With \c BATCH_COMPRESSED_ZSTD in \c batch.batch_flags the
+        /// ops section is compressed; when that does not make it smaller the
+        /// batch is written plain and the flag is cleared in the output.
         /// \param batch Source batch.
         /// \param bounds Structural limits; null disables validation.
         /// \throws std::length_error if any bound is exceeded.
-        /// \throws std::logic_error for invalid combinations.
+        /// \throws std::logic_error for invalid combinations, including
+        ///         \c BATCH_COMPRESSED_ZSTD in a build without Zstd.
         static std::vector<std::uint8_t> encode(const ChangeBatch& batch,
                                                 const CodecBounds* bounds = nullptr) {
+            MDBXC_TRACE_SCOPE(CodecEncode);
             if (bounds != nullptr) {
                 validate_bounds(batch, *bounds);
             }
             if (batch.version != batch_version()) {
                 throw std::logic_error("Unsupported ChangeBatch::version");
             }
-            if ((batch.batch_flags & BATCH_COMPRESSED_ZSTD) != 0) {
-                throw std::logic_error("BATCH_COMPRESSED_ZSTD is not supported in v0.1");
+            const bool compressed = (batch.batch_flags & BATCH_COMPRESSED_ZSTD) != 0;
+            if (compressed && !batch_compression_supported()) {
+                throw std::logic_error("BATCH_COMPRESSED_ZSTD requires MDBXC_HAS_ZSTD");
             }
             const std::uint32_t known_batch_mask = static_cast<std::uint32_t>(
                 BATCH_COMPRESSED_ZSTD | BATCH_HAS_MORE);
@@ -84,18 +179,15 @@ namespace sync {
 
             std::vector<std::uint8_t> out;
             out.reserve(256 + batch.ops.size() * 32);
-            append_bytes(out, reinterpret_cast<const char*>(magic()), magic_size());
-            detail::append_u16_le(out, codec_version());
-            detail::append_u32_le(out, batch_version());
-            detail::append_u32_le(out, batch.batch_flags);
-            append_bytes(out, reinterpret_cast<const char*>(batch.origin_node_id.data()), 16);
-            detail::append_u64_le(out, batch.seq);
-            detail::append_u64_le(out, batch.time_unix_ns);
-            detail::append_u32_le(out, static_cast<std::uint32_t>(batch.ops.size()));
+            NameDictionary names;
+            out.resize(header_size());
+            write_header(&out[0], batch.batch_flags & ~static_cast<std::uint32_t>(BATCH_COMPRESSED_ZSTD),
+                         batch.origin_node_id, batch.seq, batch.time_unix_ns,
+                         static_cast<std::uint32_t>(batch.ops.size()));
 
             for (std::size_t i = 0; i < batch.ops.size(); ++i) {
                 const ChangeOp& op = batch.ops[i];
-                if (op.op_type > ChangeOpType::ClearTable) {
+                if (op.op_type > ChangeOpType::MultiEraseAll) {
                     throw std::logic_error("Unknown ChangeOpType");
                 }
                 if ((op.op_flags & ~static_cast<std::uint32_t>(
@@ -112,177 +204,152 @@ namespace sync {
                     throw std::logic_error("OP_TOMBSTONE set with non-empty value");
                 }
 
-                append_u8(out, static_cast<std::uint8_t>(op.op_type));
-                detail::append_u32_le(out, op.op_flags);
-                detail::append_u32_le(out, op.dbi_flags);
-                detail::append_u32_le(out, static_cast<std::uint32_t>(op.dbi_name.size()));
-                if (!op.dbi_name.empty()) {
-                    append_bytes(out, op.dbi_name.data(), op.dbi_name.size());
-                }
-                detail::append_u32_le(out,
-                                      static_cast<std::uint32_t>(op.storage_key.size()));
-                if (!op.storage_key.empty()) {
-                    append_bytes(out, reinterpret_cast<const char*>(op.storage_key.data()),
-                                 op.storage_key.size());
-                }
-                if (op.value.empty()) {
-                    detail::append_u32_le(out, 0xFFFFFFFFu);
-                } else {
-                    detail::append_u32_le(out, static_cast<std::uint32_t>(op.value.size()));
-                    append_bytes(out, reinterpret_cast<const char*>(op.value.data()),
-                                 op.value.size());
-                }
-                if ((op.op_flags & OP_HAS_IDENTITY_KEY) != 0) {
-                    detail::append_u32_le(out,
-                                          static_cast<std::uint32_t>(op.identity_key.size()));
-                    append_bytes(out, reinterpret_cast<const char*>(op.identity_key.data()),
-                                 op.identity_key.size());
-                }
-                if ((op.op_flags & OP_HAS_REVISION_KEY) != 0) {
-                    detail::append_u32_le(out,
-                                          static_cast<std::uint32_t>(op.revision_key.size()));
-                    append_bytes(out, reinterpret_cast<const char*>(op.revision_key.data()),
-                                 op.revision_key.size());
-                }
+                write_op(out, names, op.op_type, op.op_flags, op.dbi_flags, op.dbi_name,
+                         op.storage_key.data(), op.storage_key.size(),
+                         op.value.data(), op.value.size(),
+                         (op.op_flags & OP_HAS_IDENTITY_KEY) != 0 ? &op.identity_key : nullptr,
+                         (op.op_flags & OP_HAS_REVISION_KEY) != 0 ? &op.revision_key : nullptr);
+            }
+            std::vector<std::uint8_t> packed;
+            if (compressed && compress(out, packed)) {
+                out.swap(packed);
             }
             return out;
         }
 
+        /// \brief Writes the compressed form of a plain encoded batch to \p out.
+        /// \details The copy has \c BATCH_COMPRESSED_ZSTD set in its header.
+        /// Returns \c false, leaving \p out unspecified, when the build has
+        /// no Zstd, the batch is already compressed, the ops section is
+        /// shorter than \p min_bytes, or compression would not shrink it.
+        /// \param encoded Output of \ref encode() or of \ref write_header()
+        ///        followed by \ref append_op() calls.
+        /// \param out Receives the compressed batch.
+        /// \param min_bytes Smallest plain ops section worth compressing.
+        /// \param level Zstd compression level.
+        /// \return \c true if \p out holds the compressed batch.
+        /// \throws std::logic_error if \p encoded is shorter than a header.
+        static bool compress(const std::vector<std::uint8_t>& encoded,
+                             std::vector<std::uint8_t>& out,
+                             std::size_t min_bytes = 0,
+                             int level = 3) {
+            if (encoded.size() < header_size()) {
+                throw std::logic_error("ChangeBatchCodec::compress: truncated batch");
+            }
+            const std::uint32_t flags = detail::read_u32_le(&encoded[14]);
+            const std::size_t raw_len = encoded.size() - header_size();
+            if ((flags & BATCH_COMPRESSED_ZSTD) != 0 || raw_len == 0 || raw_len < min_bytes ||
+                raw_len > 0xFFFFFFFFu) {
+                return false;
+            }
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+            const std::size_t prefix = header_size() + 8;
+            out.resize(prefix + ZSTD_compressBound(raw_len));
+            const std::size_t packed_len = ZSTD_compress(&out[prefix], out.size() - prefix,
+                                                         &encoded[header_size()], raw_len, level);
+            if (ZSTD_isError(packed_len) || prefix + packed_len >= encoded.size()) {
+                return false;
+            }
+            std::memcpy(&out[0], &encoded[0], header_size());
+            detail::write_u32_le(flags | BATCH_COMPRESSED_ZSTD, &out[14]);
+            detail::write_u32_le(static_cast<std::uint32_t>(raw_len), &out[header_size()]);
+            detail::write_u32_le(static_cast<std::uint32_t>(packed_len), &out[header_size() + 4]);
+            out.resize(prefix + packed_len);
+            return true;
+#else
+            (void)out;
+            (void)level;
+            return false;
+#endif
+        }
+
+        /// \brief Size of the fixed batch header that precedes the ops.
+        static std::size_t header_size() { return 54; }
+
+        /// \brief Writes a batch header into the first \ref header_size() bytes of \p out.
+        /// \details Lets a writer that streamed ops with \ref append_op()
+        /// after a reserved header fill it in once \p seq and \p ops_count
+        /// are known. \p batch_flags is written as is.
+        static void write_header(std::uint8_t* out,
+                                 std::uint32_t batch_flags,
+                                 const NodeId& origin_node_id,
+                                 std::uint64_t seq,
+                                 std::uint64_t time_unix_ns,
+                                 std::uint32_t ops_count) {
+            std::memcpy(out, magic(), magic_size());
+            detail::write_u16_le(codec_version(), out + 8);
+            detail::write_u32_le(batch_version(), out + 10);
+            detail::write_u32_le(batch_flags, out + 14);
+            std::memcpy(out + 18, origin_node_id.data(), 16);
+            detail::write_u64_le(seq, out + 34);
+            detail::write_u64_le(time_unix_ns, out + 42);
+            detail::write_u32_le(ops_count, out + 50);
+        }
+
+        /// \brief Appends one op without identity or revision keys to \p out.
+        /// \details Produces the same bytes as \ref encode() for a \c ChangeOp
+        /// with zero \c op_flags when \p names has seen the same ops,
+        /// growing \p out once. An empty \p value is encoded as absent.
+        /// \param names Table names of the batch being written; updated.
+        /// \throws std::logic_error if \p op_type is unknown.
+        static void append_op(std::vector<std::uint8_t>& out,
+                              NameDictionary& names,
+                              ChangeOpType op_type,
+                              std::uint32_t dbi_flags,
+                              const std::string& dbi_name,
+                              const void* storage_key,
+                              std::size_t storage_key_len,
+                              const void* value,
+                              std::size_t value_len) {
+            if (op_type > ChangeOpType::MultiEraseAll) {
+                throw std::logic_error("Unknown ChangeOpType");
+            }
+            write_op(out, names, op_type, 0, dbi_flags, dbi_name, storage_key, storage_key_len,
+                     value, value_len, nullptr, nullptr);
+        }
+
         /// \brief Decodes a batch from a byte span.
         /// \param data Source bytes.
         /// \param bytes_read Optional output of bytes consumed. When null, any
         ///        trailing bytes after a valid batch cause a decode error; pass
         ///        a non-null pointer to use \c decode() as a stream parser.
         /// \param bounds Structural limits; null disables validation.
-        /// \throws std::runtime_error on any format violation.
-        /// \throws std::length_error when structural bounds are exceeded.
+        /// \throws std::runtime_error on any format violation, including
+        ///         \c BATCH_COMPRESSED_ZSTD in a build without Zstd.
+        /// \throws std::length_error when structural bounds are exceeded;
+        ///         compressed batches are checked by their plain size.
+        /// \note A compressed batch keeps \c BATCH_COMPRESSED_ZSTD in
+        ///       \c batch_flags, so encoding it again compresses it again.
         static ChangeBatch decode(const std::vector<std::uint8_t>& data,
                                   std::size_t* bytes_read = nullptr,
                                   const CodecBounds* bounds = nullptr) {
-            Cursor cur;
-            cur.data = data.empty() ? nullptr : &data[0];
-            cur.size = data.size();
-            cur.pos = 0;
+            return decode(data.empty() ? nullptr : &data[0], data.size(), bytes_read, bounds);
+        }
 
+        /// \brief Decodes a batch from \p size bytes at \p data.
+        /// \details Same as the vector overload, for bytes the caller does
+        /// not own, such as an MDBX value or a slice of a transport message.
+        static ChangeBatch decode(const std::uint8_t* data,
+                                  std::size_t size,
+                                  std::size_t* bytes_read = nullptr,
+                                  const CodecBounds* bounds = nullptr) {
+            MDBXC_TRACE_SCOPE(CodecDecode);
+            Reader reader(data, size, bounds);
             ChangeBatch batch;
-            check_magic(cur);
-            const std::uint16_t cv = read_u16_le(cur);
-            if (cv != codec_version()) {
-                throw std::runtime_error("Unsupported codec_version");
-            }
-            const std::uint32_t bv = read_u32_le(cur);
-            if (bv != batch_version()) {
-                throw std::runtime_error("Unsupported batch_version");
-            }
-            batch.version = bv;
-            batch.batch_flags = read_u32_le(cur);
-            if ((batch.batch_flags & BATCH_COMPRESSED_ZSTD) != 0) {
-                throw std::runtime_error("BATCH_COMPRESSED_ZSTD is not supported in v0.1");
-            }
-            const std::uint32_t known_batch_mask =
-                static_cast<std::uint32_t>(BATCH_COMPRESSED_ZSTD | BATCH_HAS_MORE);
-            if ((batch.batch_flags & ~known_batch_mask) != 0) {
-                throw std::runtime_error("Unknown mandatory batch flag bits set");
-            }
-
-            read_bytes(cur, reinterpret_cast<char*>(batch.origin_node_id.data()), 16);
-            batch.seq = read_u64_le(cur);
-            batch.time_unix_ns = read_u64_le(cur);
-            const std::uint32_t ops_count = read_u32_le(cur);
-
-            if (bounds != nullptr) {
-                if (ops_count > bounds->max_ops_per_batch) {
-                    throw std::length_error("ops_count exceeds max_ops_per_batch");
-                }
-            }
-
-            batch.ops.resize(ops_count);
-            for (std::uint32_t i = 0; i < ops_count; ++i) {
-                ChangeOp& op = batch.ops[i];
-                const std::uint8_t op_type = read_u8(cur);
-                if (op_type > static_cast<std::uint8_t>(ChangeOpType::ClearTable)) {
-                    throw std::runtime_error("Unknown ChangeOpType");
-                }
-                op.op_type = static_cast<ChangeOpType>(op_type);
-                op.op_flags = read_u32_le(cur);
-                const std::uint32_t known_op_mask = static_cast<std::uint32_t>(
-                    OP_HAS_IDENTITY_KEY | OP_HAS_REVISION_KEY | OP_TOMBSTONE);
-                if ((op.op_flags & ~known_op_mask) != 0) {
-                    throw std::runtime_error("Unknown mandatory op flag bits set");
-                }
-                op.dbi_flags = read_u32_le(cur);
-
-                const std::uint32_t dbi_name_len = read_u32_le(cur);
-                if (bounds != nullptr && dbi_name_len > bounds->max_dbi_name_len) {
-                    throw std::length_error("dbi_name_len exceeds max_dbi_name_len");
-                }
-                op.dbi_name.assign(read_bytes_ptr(cur, dbi_name_len), dbi_name_len);
-
-                const std::uint32_t storage_key_len = read_u32_le(cur);
-                if (bounds != nullptr && storage_key_len > bounds->max_storage_key_len) {
-                    throw std::length_error("storage_key_len exceeds max_storage_key_len");
-                }
-                const char* sk = read_bytes_ptr(cur, storage_key_len);
-                op.storage_key.resize(storage_key_len);
-                if (storage_key_len > 0) {
-                    std::memcpy(op.storage_key.data(), sk, storage_key_len);
-                }
-
-                const std::uint32_t value_len = read_u32_le(cur);
-                if (value_len == 0xFFFFFFFFu) {
-                    // value absent (e.g. delete or tombstone)
-                } else {
-                    if (bounds != nullptr && value_len > bounds->max_value_len) {
-                        throw std::length_error("value_len exceeds max_value_len");
-                    }
-                    const char* v = read_bytes_ptr(cur, value_len);
-                    op.value.resize(value_len);
-                    if (value_len > 0) {
-                        std::memcpy(op.value.data(), v, value_len);
-                    }
-                }
-
-                if ((op.op_flags & OP_HAS_IDENTITY_KEY) != 0) {
-                    const std::uint32_t id_len = read_u32_le(cur);
-                    if (bounds != nullptr && id_len > bounds->max_identity_key_len) {
-                        throw std::length_error("identity_key_len exceeds max_identity_key_len");
-                    }
-                    const char* id = read_bytes_ptr(cur, id_len);
-                    op.identity_key.resize(id_len);
-                    if (id_len > 0) {
-                        std::memcpy(op.identity_key.data(), id, id_len);
-                    }
-                }
-                if ((op.op_flags & OP_HAS_REVISION_KEY) != 0) {
-                    const std::uint32_t rv_len = read_u32_le(cur);
-                    if (bounds != nullptr && rv_len > bounds->max_revision_key_len) {
-                        throw std::length_error("revision_key_len exceeds max_revision_key_len");
-                    }
-                    const char* rv = read_bytes_ptr(cur, rv_len);
-                    op.revision_key.resize(rv_len);
-                    if (rv_len > 0) {
-                        std::memcpy(op.revision_key.data(), rv, rv_len);
-                    }
-                }
-
-                if ((op.op_flags & OP_TOMBSTONE) != 0 && !op.value.empty()) {
-                    throw std::runtime_error("OP_TOMBSTONE with non-empty value");
-                }
-                if ((op.op_flags & OP_HAS_IDENTITY_KEY) != 0 && op.identity_key.empty()) {
-                    throw std::runtime_error("OP_HAS_IDENTITY_KEY with empty identity_key");
-                }
-                if ((op.op_flags & OP_HAS_REVISION_KEY) != 0 && op.revision_key.empty()) {
-                    throw std::runtime_error("OP_HAS_REVISION_KEY with empty revision_key");
-                }
-            }
-
-            if (bounds != nullptr && cur.pos > bounds->max_batch_total_bytes) {
-                throw std::length_error("total batch bytes exceeds max_batch_total_bytes");
+            batch.version = batch_version();
+            batch.batch_flags = reader.batch_flags();
+            batch.origin_node_id = reader.origin_node_id();
+            batch.seq = reader.seq();
+            batch.time_unix_ns = reader.time_unix_ns();
+            batch.ops.resize(reader.ops_count());
+            ChangeOpView view;
+            for (std::size_t i = 0; reader.next(view); ++i) {
+                batch.ops[i] = view.to_op();
             }
 
             if (bytes_read != nullptr) {
-                *bytes_read = cur.pos;
-            } else if (cur.pos != cur.size) {
+                *bytes_read = reader.bytes_read();
+            } else if (reader.bytes_read() != size) {
                 throw std::runtime_error("Trailing bytes after ChangeBatch");
             }
             return batch;
@@ -302,6 +369,13 @@ namespace sync {
             return batch;
         }
 
+        /// \brief Strict decoder over \p size bytes at \p data.
+        static ChangeBatch decode_exact(const std::uint8_t* data,
+                                        std::size_t size,
+                                        const CodecBounds* bounds = nullptr) {
+            return decode(data, size, nullptr, bounds);
+        }
+
         /// \brief Validates encoder input against the given bounds.
         static void validate_bounds(const ChangeBatch& batch, const CodecBounds& bounds) {
             if (batch.ops.size() > bounds.max_ops_per_batch) {
@@ -334,20 +408,128 @@ namespace sync {
             std::size_t pos = 0;
         };
 
+        /// \brief Expands one Zstd frame of exactly \p raw_len bytes into \p out.
+        static void expand(const char* src,
+                           std::size_t size,
+                           std::size_t raw_len,
+                           std::vector<std::uint8_t>& out) {
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+            // Checked before allocating, so a forged size cannot inflate memory.
+            if (ZSTD_getFrameContentSize(src, size) != raw_len) {
+                throw std::runtime_error("Compressed ops section size mismatch");
+            }
+            out.resize(raw_len);
+            const std::size_t written =
+                ZSTD_decompress(out.empty() ? nullptr : &out[0], raw_len, src, size);
+            if (ZSTD_isError(written)) {
+                throw std::runtime_error(std::string("Compressed ops section: ") +
+                                         ZSTD_getErrorName(written));
+            }
+            if (written != raw_len) {
+                throw std::runtime_error("Compressed ops section size mismatch");
+            }
+#else
+            (void)src;
+            (void)size;
+            (void)raw_len;
+            (void)out;
+            throw std::runtime_error("BATCH_COMPRESSED_ZSTD requires MDBXC_HAS_ZSTD");
+#endif
+        }
+
         static void check_bounds(const Cursor& cur, std::size_t n) {
             if (cur.pos + n > cur.size) {
                 throw std::runtime_error("Codec buffer underrun");
             }
         }
 
-        static void append_bytes(std::vector<std::uint8_t>& out, const char* src, std::size_t n) {
+        /// \brief Returns the dictionary index of \p name; the size of the
+        /// dictionary when the name is new.
+        static std::size_t find_name(NameDictionary& names, const std::string& name) {
+            if (names.last < names.names.size() && names.names[names.last] == name) {
+                return names.last;
+            }
+            for (std::size_t i = 0; i < names.names.size(); ++i) {
+                if (names.names[i] == name) {
+                    names.last = i;
+                    return i;
+                }
+            }
+            return names.names.size();
+        }
+
+        static std::uint8_t* write_blob(std::uint8_t* p, const void* src, std::size_t n) {
+            p = compact::write_varint(n, p);
+            if (n != 0) {
+                std::memcpy(p, src, n);
+                p += n;
+            }
+            return p;
+        }
+
+        /// \brief Appends one v2 op, growing \p out once.
+        static void write_op(std::vector<std::uint8_t>& out,
+                             NameDictionary& names,
+                             ChangeOpType op_type,
+                             std::uint32_t op_flags,
+                             std::uint32_t dbi_flags,
+                             const std::string& dbi_name,
+                             const void* storage_key,
+                             std::size_t storage_key_len,
+                             const void* value,
+                             std::size_t value_len,
+                             const std::vector<std::uint8_t>* identity_key,
+                             const std::vector<std::uint8_t>* revision_key) {
+            const std::size_t ref = find_name(names, dbi_name);
+            const bool new_name = ref == names.names.size();
+            std::size_t size = 1 + compact::varint_size(op_flags) +
+                               compact::varint_size(dbi_flags) + compact::varint_size(ref) +
+                               compact::varint_size(storage_key_len) + storage_key_len +
+                               compact::varint_size(value_len) + value_len;
+            if (new_name) {
+                size += compact::varint_size(dbi_name.size()) + dbi_name.size();
+            }
+            if (identity_key != nullptr) {
+                size += compact::varint_size(identity_key->size()) + identity_key->size();
+            }
+            if (revision_key != nullptr) {
+                size += compact::varint_size(revision_key->size()) + revision_key->size();
+            }
             const std::size_t base = out.size();
-            out.resize(base + n);
-            std::memcpy(&out[base], src, n);
+            out.resize(base + size);
+            std::uint8_t* p = &out[base];
+            *p++ = static_cast<std::uint8_t>(op_type);
+            p = compact::write_varint(op_flags, p);
+            p = compact::write_varint(dbi_flags, p);
+            p = compact::write_varint(ref, p);
+            if (new_name) {
+                p = write_blob(p, dbi_name.data(), dbi_name.size());
+                names.names.push_back(dbi_name);
+                names.last = ref;
+            }
+            p = write_blob(p, storage_key, storage_key_len);
+            p = write_blob(p, value, value_len);
+            if (identity_key != nullptr) {
+                p = write_blob(p, identity_key->data(), identity_key->size());
+            }
+            if (revision_key != nullptr) {
+                write_blob(p, revision_key->data(), revision_key->size());
+            }
         }
 
-        static void append_u8(std::vector<std::uint8_t>& out, std::uint8_t v) {
-            out.push_back(v);
+        /// \brief Reads a u32 field: fixed width in v1, a varint since v2.
+        static std::uint32_t read_field(Cursor& cur, bool v1) {
+            if (v1) {
+                return read_u32_le(cur);
+            }
+            check_bounds(cur, 1);
+            const std::uint8_t* p = cur.data + cur.pos;
+            const std::uint64_t v = compact::read_varint(p, cur.data + cur.size);
+            if (v > 0xFFFFFFFFu) {
+                throw std::runtime_error("Codec varint exceeds u32");
+            }
+            cur.pos = static_cast<std::size_t>(p - cur.data);
+            return static_cast<std::uint32_t>(v);
         }
 
         static void check_magic(Cursor& cur) {
@@ -398,6 +580,228 @@ namespace sync {
             cur.pos += n;
             return p;
         }
+
+    public:
+        /// \brief Reads one encoded batch op by op without copying payloads.
+        /// \details The header is parsed and validated on construction; each
+        /// \ref next() call decodes one op as views into the input, or into
+        /// the ops section of a compressed batch, which the first call
+        /// expands into a buffer the reader owns. \ref decode() and \ref ChangeBatchView are built on it.
+        class Reader {
+        public:
+            /// \brief Parses the batch header at \p data.
+            /// \param data Source bytes; must outlive the reader.
+            /// \param size Bytes available at \p data; may extend past the batch.
+            /// \param bounds Structural limits; null disables validation.
+            /// \throws std::runtime_error or std::length_error as \ref decode().
+            Reader(const std::uint8_t* data, std::size_t size,
+                   const CodecBounds* bounds = nullptr)
+                : m_bounds(bounds) {
+                m_cur.data = data;
+                m_cur.size = size;
+                check_magic(m_cur);
+                m_codec_version = ChangeBatchCodec::read_u16_le(m_cur);
+                if (m_codec_version < min_codec_version() || m_codec_version > ChangeBatchCodec::codec_version()) {
+                    throw std::runtime_error("Unsupported codec_version");
+                }
+                if (ChangeBatchCodec::read_u32_le(m_cur) != batch_version()) {
+                    throw std::runtime_error("Unsupported batch_version");
+                }
+                m_batch_flags = ChangeBatchCodec::read_u32_le(m_cur);
+                m_compressed = (m_batch_flags & BATCH_COMPRESSED_ZSTD) != 0;
+                if (m_compressed && !batch_compression_supported()) {
+                    throw std::runtime_error("BATCH_COMPRESSED_ZSTD requires MDBXC_HAS_ZSTD");
+                }
+                const std::uint32_t known_batch_mask =
+                    static_cast<std::uint32_t>(BATCH_COMPRESSED_ZSTD | BATCH_HAS_MORE);
+                if ((m_batch_flags & ~known_batch_mask) != 0) {
+                    throw std::runtime_error("Unknown mandatory batch flag bits set");
+                }
+                read_bytes(m_cur, reinterpret_cast<char*>(m_origin_node_id.data()), 16);
+                m_seq = ChangeBatchCodec::read_u64_le(m_cur);
+                m_time_unix_ns = ChangeBatchCodec::read_u64_le(m_cur);
+                m_ops_count = ChangeBatchCodec::read_u32_le(m_cur);
+                if (bounds != nullptr && m_ops_count > bounds->max_ops_per_batch) {
+                    throw std::length_error("ops_count exceeds max_ops_per_batch");
+                }
+                if (m_compressed) {
+                    const std::uint32_t raw_len = ChangeBatchCodec::read_u32_le(m_cur);
+                    const std::uint32_t packed_len = ChangeBatchCodec::read_u32_le(m_cur);
+                    if (bounds != nullptr &&
+                        header_size() + raw_len > bounds->max_batch_total_bytes) {
+                        throw std::length_error("total batch bytes exceeds max_batch_total_bytes");
+                    }
+                    m_packed_src = read_bytes_ptr(m_cur, packed_len);
+                    m_packed_len = packed_len;
+                    m_raw_len = raw_len;
+                }
+            }
+
+            // Views may point into m_expanded: a move keeps its buffer, a copy would not.
+            Reader(Reader&&) = default;
+            Reader& operator=(Reader&&) = default;
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            /// \brief Codec version of the batch.
+            std::uint16_t codec_version() const noexcept { return m_codec_version; }
+            /// \brief Batch flags as stored, including \c BATCH_COMPRESSED_ZSTD.
+            std::uint32_t batch_flags() const noexcept { return m_batch_flags; }
+            /// \brief Node that produced the batch.
+            const NodeId& origin_node_id() const noexcept { return m_origin_node_id; }
+            /// \brief Origin sequence number.
+            std::uint64_t seq() const noexcept { return m_seq; }
+            /// \brief Creation time in Unix nanoseconds.
+            std::uint64_t time_unix_ns() const noexcept { return m_time_unix_ns; }
+            /// \brief Number of ops declared by the header.
+            std::uint32_t ops_count() const noexcept { return m_ops_count; }
+
+            /// \brief Decodes the next op into \p op.
+            /// \details Views stay valid while the input and the reader live.
+            /// After the last op, checks the end of the batch and returns
+            /// \c false.
+            /// \throws std::runtime_error or std::length_error as \ref decode().
+            bool next(ChangeOpView& op) {
+                if (m_compressed && m_packed_src != nullptr) {
+                    expand(m_packed_src, m_packed_len, m_raw_len, m_expanded);
+                    m_packed_src = nullptr;
+                    m_packed.data = m_expanded.empty() ? nullptr : &m_expanded[0];
+                    m_packed.size = m_expanded.size();
+                }
+                if (m_read == m_ops_count) {
+                    finish();
+                    return false;
+                }
+                read_op(m_compressed ? m_packed : m_cur, op);
+                ++m_read;
+                return true;
+            }
+
+            /// \brief Bytes the batch occupies in the input.
+            /// \details Valid once \ref next() has returned \c false.
+            std::size_t bytes_read() const noexcept { return m_cur.pos; }
+
+        private:
+            Cursor m_cur;
+            Cursor m_packed;
+            std::vector<std::uint8_t> m_expanded;
+            const char* m_packed_src = nullptr; ///< Zstd frame, until expanded by next().
+            std::size_t m_packed_len = 0;
+            std::size_t m_raw_len = 0;
+            const CodecBounds* m_bounds;
+            std::uint16_t m_codec_version = 0;
+            std::uint32_t m_batch_flags = 0;
+            bool m_compressed = false;
+            NodeId m_origin_node_id{};
+            std::uint64_t m_seq = 0;
+            std::uint64_t m_time_unix_ns = 0;
+            std::uint32_t m_ops_count = 0;
+            std::uint32_t m_read = 0;
+            bool m_finished = false;
+            /// \brief Table names seen so far (v2 only), pointing into the ops bytes.
+            std::vector<std::pair<const char*, std::uint32_t>> m_names;
+
+            void read_op(Cursor& ops, ChangeOpView& op) {
+                const bool v1 = m_codec_version == 1;
+                const std::uint8_t op_type = read_u8(ops);
+                if (op_type > static_cast<std::uint8_t>(ChangeOpType::MultiEraseAll)) {
+                    throw std::runtime_error("Unknown ChangeOpType");
+                }
+                op.op_type = static_cast<ChangeOpType>(op_type);
+                op.op_flags = read_field(ops, v1);
+                const std::uint32_t known_op_mask = static_cast<std::uint32_t>(
+                    OP_HAS_IDENTITY_KEY | OP_HAS_REVISION_KEY | OP_TOMBSTONE);
+                if ((op.op_flags & ~known_op_mask) != 0) {
+                    throw std::runtime_error("Unknown mandatory op flag bits set");
+                }
+                op.dbi_flags = read_field(ops, v1);
+
+                const std::uint32_t dbi_ref = v1 ? 0 : read_field(ops, v1);
+                if (!v1 && dbi_ref < m_names.size()) {
+                    op.dbi_name = m_names[dbi_ref].first;
+                    op.dbi_name_len = m_names[dbi_ref].second;
+                } else if (v1 || dbi_ref == m_names.size()) {
+                    const std::uint32_t dbi_name_len = read_field(ops, v1);
+                    if (m_bounds != nullptr && dbi_name_len > m_bounds->max_dbi_name_len) {
+                        throw std::length_error("dbi_name_len exceeds max_dbi_name_len");
+                    }
+                    op.dbi_name = read_bytes_ptr(ops, dbi_name_len);
+                    op.dbi_name_len = dbi_name_len;
+                    if (!v1) {
+                        m_names.push_back(std::make_pair(op.dbi_name, dbi_name_len));
+                    }
+                } else {
+                    throw std::runtime_error("Invalid dbi_ref");
+                }
+
+                op.storage_key_len = read_field(ops, v1);
+                if (m_bounds != nullptr && op.storage_key_len > m_bounds->max_storage_key_len) {
+                    throw std::length_error("storage_key_len exceeds max_storage_key_len");
+                }
+                op.storage_key = read_view(ops, op.storage_key_len);
+
+                const std::uint32_t value_len = read_field(ops, v1);
+                if (v1 && value_len == 0xFFFFFFFFu) {
+                    // value absent (e.g. delete or tombstone)
+                    op.value = nullptr;
+                    op.value_len = 0;
+                } else {
+                    if (m_bounds != nullptr && value_len > m_bounds->max_value_len) {
+                        throw std::length_error("value_len exceeds max_value_len");
+                    }
+                    op.value_len = value_len;
+                    op.value = read_view(ops, value_len);
+                }
+
+                op.identity_key = nullptr;
+                op.identity_key_len = 0;
+                if ((op.op_flags & OP_HAS_IDENTITY_KEY) != 0) {
+                    op.identity_key_len = read_field(ops, v1);
+                    if (m_bounds != nullptr &&
+                        op.identity_key_len > m_bounds->max_identity_key_len) {
+                        throw std::length_error("identity_key_len exceeds max_identity_key_len");
+                    }
+                    op.identity_key = read_view(ops, op.identity_key_len);
+                }
+                op.revision_key = nullptr;
+                op.revision_key_len = 0;
+                if ((op.op_flags & OP_HAS_REVISION_KEY) != 0) {
+                    op.revision_key_len = read_field(ops, v1);
+                    if (m_bounds != nullptr &&
+                        op.revision_key_len > m_bounds->max_revision_key_len) {
+                        throw std::length_error("revision_key_len exceeds max_revision_key_len");
+                    }
+                    op.revision_key = read_view(ops, op.revision_key_len);
+                }
+
+                if ((op.op_flags & OP_TOMBSTONE) != 0 && op.value_len != 0) {
+                    throw std::runtime_error("OP_TOMBSTONE with non-empty value");
+                }
+                if ((op.op_flags & OP_HAS_IDENTITY_KEY) != 0 && op.identity_key_len == 0) {
+                    throw std::runtime_error("OP_HAS_IDENTITY_KEY with empty identity_key");
+                }
+                if ((op.op_flags & OP_HAS_REVISION_KEY) != 0 && op.revision_key_len == 0) {
+                    throw std::runtime_error("OP_HAS_REVISION_KEY with empty revision_key");
+                }
+            }
+
+            static const std::uint8_t* read_view(Cursor& cur, std::size_t n) {
+                return reinterpret_cast<const std::uint8_t*>(read_bytes_ptr(cur, n));
+            }
+
+            void finish() {
+                if (m_finished) {
+                    return;
+                }
+                if (m_compressed && m_packed.pos != m_packed.size) {
+                    throw std::runtime_error("Trailing bytes in compressed ops section");
+                }
+                if (m_bounds != nullptr && m_cur.pos > m_bounds->max_batch_total_bytes) {
+                    throw std::length_error("total batch bytes exceeds max_batch_total_bytes");
+                }
+                m_finished = true;
+            }
+        };
     };
 
 } // namespace sync
@@ -0,0 +1,108 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_CHANGE_BATCH_VIEW_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_CHANGE_BATCH_VIEW_HPP_INCLUDED
+
+/// \file ChangeBatchView.hpp
+/// \brief Non-owning, lazily decoded view of one encoded \c ChangeBatch.
+
+#include <cstdint>
+#include <vector>
+
+#include "ChangeBatchCodec.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Encoded batch read in place from borrowed bytes.
+    /// \details Construction validates only the header, so origin, \c seq
+    /// and flags can be checked without decoding the ops. Ops are decoded
+    /// on demand by \ref ops() as \c ChangeOpView values pointing into the
+    /// span; \ref to_batch() materializes an owning copy.
+    /// \note The span must hold exactly one batch and outlive the view and
+    /// every reader or op view taken from it.
+    class ChangeBatchView {
+    public:
+        /// \brief Parses the header of the batch at \p data.
+        /// \param bounds Structural limits for later decoding; null disables
+        ///        validation. The pointee must outlive the view.
+        /// \throws std::runtime_error or std::length_error as
+        ///         \c ChangeBatchCodec::decode().
+        ChangeBatchView(const std::uint8_t* data,
+                        std::size_t size,
+                        const CodecBounds* bounds = nullptr)
+            : m_data(data)
+            , m_size(size)
+            , m_bounds(bounds) {
+            const ChangeBatchCodec::Reader header(data, size, bounds);
+            m_codec_version = header.codec_version();
+            m_batch_flags = header.batch_flags();
+            m_origin_node_id = header.origin_node_id();
+            m_seq = header.seq();
+            m_time_unix_ns = header.time_unix_ns();
+            m_ops_count = header.ops_count();
+        }
+
+        /// \brief Views the batch held by \p data.
+        explicit ChangeBatchView(const std::vector<std::uint8_t>& data,
+                                 const CodecBounds* bounds = nullptr)
+            : ChangeBatchView(data.empty() ? nullptr : &data[0], data.size(), bounds) {}
+
+        /// \brief Borrowed batch bytes.
+        const std::uint8_t* data() const noexcept { return m_data; }
+
+        /// \brief Size of the batch in bytes.
+        std::size_t size() const noexcept { return m_size; }
+
+        /// \brief Codec version the batch was written with.
+        std::uint16_t codec_version() const noexcept { return m_codec_version; }
+
+        /// \brief Batch flags as stored.
+        std::uint32_t batch_flags() const noexcept { return m_batch_flags; }
+
+        /// \brief Whether the ops section is Zstd-compressed.
+        bool compressed() const noexcept {
+            return (m_batch_flags & BATCH_COMPRESSED_ZSTD) != 0;
+        }
+
+        /// \brief Node that produced the batch.
+        const NodeId& origin_node_id() const noexcept { return m_origin_node_id; }
+
+        /// \brief Origin sequence number.
+        std::uint64_t seq() const noexcept { return m_seq; }
+
+        /// \brief Creation time in Unix nanoseconds.
+        std::uint64_t time_unix_ns() const noexcept { return m_time_unix_ns; }
+
+        /// \brief Number of ops in the batch.
+        std::uint32_t ops_count() const noexcept { return m_ops_count; }
+
+        /// \brief Starts decoding the ops from the first one.
+        /// \details A compressed ops section is expanded by the first
+        /// \c Reader::next() call into a buffer owned by the reader.
+        ChangeBatchCodec::Reader ops() const {
+            return ChangeBatchCodec::Reader(m_data, m_size, m_bounds);
+        }
+
+        /// \brief Decodes the whole batch into an owning \c ChangeBatch.
+        /// \throws std::runtime_error on any format violation, including
+        ///         bytes after the batch.
+        ChangeBatch to_batch() const {
+            return ChangeBatchCodec::decode_exact(m_data, m_size, m_bounds);
+        }
+
+    private:
+        const std::uint8_t* m_data;
+        std::size_t m_size;
+        const CodecBounds* m_bounds;
+        std::uint16_t m_codec_version = 0;
+        std::uint32_t m_batch_flags = 0;
+        NodeId m_origin_node_id{};
+        std::uint64_t m_seq = 0;
+        std::uint64_t m_time_unix_ns = 0;
+        std::uint32_t m_ops_count = 0;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_CHANGE_BATCH_VIEW_HPP_INCLUDED
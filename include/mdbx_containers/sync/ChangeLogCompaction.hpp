@@ -0,0 +1,61 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_COMPACTION_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_COMPACTION_HPP_INCLUDED
+
+/// \file ChangeLogCompaction.hpp
+/// \brief Options of \c SyncEngine::compact_changelog().
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Which \c _mdbxc_changelog batches are compacted, and in what steps.
+    /// \details Compaction removes ops that a later op of the same origin
+    /// on the same \c (dbi_name, storage_key) overwrites, and every op a
+    /// later \c ClearTable of the same DBI discards. Batches keep their
+    /// \c seq, so a batch left without ops stays in place.
+    struct ChangeLogCompaction {
+        /// \brief Newest batches of each origin left as written.
+        /// \details A replica that stops inside a compacted range may see
+        /// some keys at older values than the batch it stopped at. It
+        /// reaches the exact state at the end of the range, so keep the
+        /// batches peers are still likely to stop in.
+        std::uint64_t keep_recent = 1000;
+
+        /// \brief Batches read per write transaction.
+        /// \details Bounds how long each compaction transaction holds the writer.
+        std::size_t max_batches_per_txn = 1000;
+
+        /// \brief Distinct keys remembered per origin before compaction of
+        /// that origin stops.
+        /// \details Bounds memory; the older batches are left as written.
+        std::size_t max_tracked_keys = 1000000;
+
+        /// \brief Throws \c std::invalid_argument for unusable options.
+        void validate() const {
+            if (max_batches_per_txn == 0) {
+                throw std::invalid_argument(
+                    "ChangeLogCompaction::max_batches_per_txn must be greater than zero");
+            }
+            if (max_tracked_keys == 0) {
+                throw std::invalid_argument(
+                    "ChangeLogCompaction::max_tracked_keys must be greater than zero");
+            }
+        }
+    };
+
+    /// \brief What one \c SyncEngine::compact_changelog() call changed.
+    struct ChangeLogCompactResult {
+        std::size_t batches_rewritten = 0; ///< Batches stored again with fewer ops.
+        std::size_t ops_removed = 0;       ///< Superseded ops dropped.
+        std::uint64_t bytes_saved = 0;     ///< Shrinkage of the rewritten values.
+        std::size_t transactions = 0;      ///< Write transactions committed.
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_COMPACTION_HPP_INCLUDED
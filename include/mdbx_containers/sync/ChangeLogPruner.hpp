@@ -0,0 +1,141 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_PRUNER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_PRUNER_HPP_INCLUDED
+
+/// \file ChangeLogPruner.hpp
+/// \brief Background thread that applies a \c ChangeLogRetention policy.
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "cancellation.hpp"
+#include "ChangeLogRetention.hpp"
+#include "SyncEngine.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Runs \c SyncEngine::prune_changelog() every \c interval.
+    /// \details The first pass runs one \c interval after \ref start(). Each
+    /// pass removes batches in write transactions of bounded size, so it
+    /// only briefly delays other writers; \ref stop() cancels a pass
+    /// between two of them. Errors are recorded in \ref last_error() and
+    /// the next pass runs as scheduled.
+    /// \note The engine must outlive the pruner.
+    /// \thread_safety \ref start(), \ref stop() and \ref run_once() must be
+    /// serialized by the caller; the status getters are thread-safe.
+    class ChangeLogPruner {
+    public:
+        /// \throws std::invalid_argument when \p policy is invalid or
+        ///         \p interval is not positive.
+        ChangeLogPruner(SyncEngine& engine,
+                        const ChangeLogRetention& policy,
+                        std::chrono::milliseconds interval = std::chrono::milliseconds(60000))
+            : m_engine(engine), m_policy(policy), m_interval(interval) {
+            m_policy.validate();
+            if (m_interval.count() <= 0) {
+                throw std::invalid_argument("ChangeLogPruner: interval must be positive");
+            }
+        }
+
+        ~ChangeLogPruner() {
+            stop();
+        }
+
+        ChangeLogPruner(const ChangeLogPruner&) = delete;
+        ChangeLogPruner& operator=(const ChangeLogPruner&) = delete;
+
+        /// \brief Starts the background thread; no-op when it runs.
+        void start() {
+            if (m_thread.joinable()) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                m_stop_requested = false;
+            }
+            m_cancel = CancellationSource();
+            m_thread = std::thread([this]() { run_loop(); });
+        }
+
+        /// \brief Cancels the running pass, if any, and joins the thread.
+        void stop() {
+            if (!m_thread.joinable()) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                m_stop_requested = true;
+            }
+            m_cancel.request_cancel();
+            m_wake.notify_all();
+            m_thread.join();
+        }
+
+        /// \brief Runs one pass on the calling thread.
+        /// \throws What \c SyncEngine::prune_changelog() throws.
+        ChangeLogPruneResult run_once() {
+            const ChangeLogPruneResult result = m_engine.prune_changelog(m_policy);
+            record(result, std::string());
+            return result;
+        }
+
+        /// \brief Result of the last completed pass.
+        ChangeLogPruneResult last_result() const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            return m_last_result;
+        }
+
+        /// \brief Error of the last pass; empty when it succeeded.
+        std::string last_error() const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            return m_last_error;
+        }
+
+    private:
+        void run_loop() {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            for (;;) {
+                m_wake.wait_for(lk, m_interval, [this]() { return m_stop_requested; });
+                if (m_stop_requested) {
+                    return;
+                }
+                lk.unlock();
+                try {
+                    record(m_engine.prune_changelog(m_policy, m_cancel.token()), std::string());
+                } catch (const std::exception& e) {
+                    record(ChangeLogPruneResult(), e.what());
+                } catch (...) {
+                    record(ChangeLogPruneResult(), "unknown changelog prune error");
+                }
+                lk.lock();
+            }
+        }
+
+        void record(const ChangeLogPruneResult& result, const std::string& error) {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_last_result = result;
+            m_last_error = error;
+        }
+
+        SyncEngine&                 m_engine;
+        ChangeLogRetention          m_policy;
+        std::chrono::milliseconds   m_interval;
+        CancellationSource          m_cancel;
+        std::thread                 m_thread;
+        mutable std::mutex          m_mutex;
+        std::condition_variable     m_wake;
+        bool                        m_stop_requested = false;
+        ChangeLogPruneResult        m_last_result;
+        std::string                 m_last_error;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_PRUNER_HPP_INCLUDED
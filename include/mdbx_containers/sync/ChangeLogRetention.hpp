@@ -0,0 +1,72 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_RETENTION_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_RETENTION_HPP_INCLUDED
+
+/// \file ChangeLogRetention.hpp
+/// \brief Rules that decide which \c _mdbxc_changelog batches are pruned.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Retention policy for \c SyncEngine::prune_changelog().
+    /// \details Only the oldest batches of an origin are ever removed, so the
+    /// retained batches of each origin stay contiguous. A peer whose cursor
+    /// falls below them gets \c SnapshotRequired on its next pull.
+    struct ChangeLogRetention {
+        /// \brief Prunes batches every tracked peer reported having.
+        /// \details Peers are tracked from the \c have cursors of their pulls
+        /// and from \c SyncEngine::note_peer_have(). With no tracked peer
+        /// nothing counts as acknowledged.
+        bool prune_acknowledged = true;
+
+        /// \brief Prunes batches older than this even if unacknowledged; 0 disables.
+        /// \details Age comes from the batch's \c time_unix_ns. Batches
+        /// without one, written before it was stamped, are never too old.
+        std::chrono::milliseconds max_age = std::chrono::milliseconds(0);
+
+        /// \brief Prunes the oldest batches while the changelog occupies more
+        /// than this many bytes of pages; 0 disables.
+        std::uint64_t max_bytes = 0;
+
+        /// \brief Peers not heard from for this long are forgotten; 0 keeps them.
+        /// \details A forgotten peer no longer holds back acknowledged
+        /// pruning until it pulls again.
+        std::chrono::milliseconds peer_timeout = std::chrono::milliseconds(0);
+
+        /// \brief Batches removed per write transaction.
+        /// \details Bounds how long each prune transaction holds the writer.
+        std::size_t max_batches_per_txn = 1000;
+
+        /// \brief Throws \c std::invalid_argument for an unusable policy.
+        void validate() const {
+            if (max_age.count() < 0) {
+                throw std::invalid_argument("ChangeLogRetention::max_age must not be negative");
+            }
+            if (peer_timeout.count() < 0) {
+                throw std::invalid_argument(
+                    "ChangeLogRetention::peer_timeout must not be negative");
+            }
+            if (max_batches_per_txn == 0) {
+                throw std::invalid_argument(
+                    "ChangeLogRetention::max_batches_per_txn must be greater than zero");
+            }
+        }
+    };
+
+    /// \brief What one \c SyncEngine::prune_changelog() call removed.
+    struct ChangeLogPruneResult {
+        std::size_t batches_removed = 0; ///< Changelog records deleted.
+        std::uint64_t bytes_removed = 0; ///< Key and value bytes of those records.
+        std::size_t transactions = 0;    ///< Write transactions committed.
+        std::size_t peers_forgotten = 0; ///< Peers dropped by \c peer_timeout.
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_CHANGE_LOG_RETENTION_HPP_INCLUDED
@@ -19,6 +19,10 @@ namespace sync {
         Put         = 0, ///< mdbx_put (upsert).
         Delete      = 1, ///< mdbx_del + identity_index tombstone.
         ClearTable  = 2, ///< Drop the entire DBI contents.
+        Merge       = 3, ///< Merge operand into the stored value, see \ref MergeOperator.
+        MultiInsert   = 4, ///< Add one occurrence of a \c KeyMultiValueTable value.
+        MultiEraseOne = 5, ///< Remove the newest occurrence of a \c KeyMultiValueTable value.
+        MultiEraseAll = 6, ///< Remove every occurrence of a \c KeyMultiValueTable value.
     };
 
     /// \brief Single raw DBI operation captured by the change recorder.
@@ -27,8 +31,12 @@ namespace sync {
     /// destination DBI compatibly during apply. \c identity_key is the
     /// application-level identity (empty when equal to storage_key).
     /// \c revision_key is an optional application-level version.
+    /// For \c Merge, \c value is the encoded \ref MergeOperator followed by
+    /// the serialized operand. For the \c Multi* kinds, \c value is the
+    /// serialized public value without the local duplicate sequence prefix;
+    /// the receiver assigns its own prefix.
     struct ChangeOp {
-        ChangeOpType           op_type   = ChangeOpType::Put; ///< Operation kind: Put/Delete/ClearTable.
+        ChangeOpType           op_type   = ChangeOpType::Put; ///< Operation kind.
         std::uint32_t          op_flags  = OP_NONE;           ///< Per-op feature flags.
         std::uint32_t          dbi_flags = 0;                 ///< Raw MDBX DBI flags for \c dbi_name.
         std::string            dbi_name;                      ///< User table name (MDBX DBI name).
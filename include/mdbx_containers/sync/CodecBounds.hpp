@@ -25,6 +25,7 @@ namespace sync {
         std::uint32_t max_cursor_origins       = 10000;               ///< Max origins in one transport cursor.
         std::uint32_t max_batches_per_message  = 10000;               ///< Max batches in one pull/push transport message.
         std::uint32_t max_error_len            = 16u * 1024u;         ///< Max transport error string bytes.
+        std::uint32_t max_subscription_entries = 1024;                ///< Max tables plus key prefixes in one pull subscription.
         std::uint32_t max_transport_message_bytes =
             128u * 1024u * 1024u; ///< Max encoded transport message bytes.
     };
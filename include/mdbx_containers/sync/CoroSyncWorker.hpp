@@ -0,0 +1,300 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_CORO_SYNC_WORKER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_CORO_SYNC_WORKER_HPP_INCLUDED
+
+/// \file CoroSyncWorker.hpp
+/// \brief C++20 coroutine pull/apply loop over an \c IAsyncSyncPeer.
+/// \details A \c SyncWorker blocks its own thread for every network round
+/// trip. \c CoroSyncWorker runs the same rounds as coroutines that suspend
+/// while a pull is in flight, so many replication sessions can share the
+/// threads of one executor. Without C++20 coroutine support the header is
+/// empty.
+
+#include "../coroutine.hpp"
+
+#if MDBXC_HAS_COROUTINES
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+
+#include "IAsyncSyncPeer.hpp"
+#include "SyncEngine.hpp"
+#include "SyncWorker.hpp"
+#include "cancellation.hpp"
+#include "protocol.hpp"
+
+namespace mdbxc {
+namespace coro {
+
+    /// \brief Awaits \c IAsyncSyncPeer::async_pull().
+    inline CallbackAwaiter<sync::PullResponse> pull(sync::IAsyncSyncPeer& peer,
+                                                    const sync::PullRequest& request,
+                                                    Resumer resume = Resumer()) {
+        sync::IAsyncSyncPeer* target = &peer;
+        return CallbackAwaiter<sync::PullResponse>(
+            [target, request](sync::IAsyncSyncPeer::PullCallback done) {
+                target->async_pull(request, std::move(done));
+            },
+            std::move(resume));
+    }
+
+    /// \brief Awaits \c IAsyncSyncPeer::async_push().
+    inline CallbackAwaiter<sync::PushResponse> push(sync::IAsyncSyncPeer& peer,
+                                                    const sync::PushRequest& request,
+                                                    Resumer resume = Resumer()) {
+        sync::IAsyncSyncPeer* target = &peer;
+        return CallbackAwaiter<sync::PushResponse>(
+            [target, request](sync::IAsyncSyncPeer::PushCallback done) {
+                target->async_push(request, std::move(done));
+            },
+            std::move(resume));
+    }
+
+} // namespace coro
+
+namespace sync {
+
+    /// \class CoroSyncWorker
+    /// \brief Coroutine-driven counterpart of \c SyncWorker.
+    /// \details Honors the paging, long-poll, snapshot bootstrap,
+    /// subscription, backoff and permanent-failure settings of
+    /// \c SyncWorkerOptions. \c pipeline_depth, \c adaptive_paging and
+    /// \c observer are not used: pages are pulled one at a time and results
+    /// are returned from \ref run_once(). Pulled pages are applied inline on
+    /// the resumed thread, as \c SyncWorker applies them on its own thread.
+    /// One worker runs one round at a time; the engine and peer must outlive
+    /// it.
+    class CoroSyncWorker {
+    public:
+        /// \param engine Local engine that pulled pages are applied to.
+        /// \param peer Asynchronous peer to pull from.
+        /// \param options Timing and paging settings.
+        /// \param resume Optional resumer for every await; by default rounds
+        ///        continue on the thread that completed the pull or timer.
+        CoroSyncWorker(SyncEngine& engine,
+                       IAsyncSyncPeer& peer,
+                       const SyncWorkerOptions& options = SyncWorkerOptions(),
+                       coro::Resumer resume = coro::Resumer())
+            : m_engine(engine),
+              m_peer(peer),
+              m_options(options),
+              m_resume(std::move(resume)),
+              m_stop_requested(false) {}
+
+        CoroSyncWorker(const CoroSyncWorker&) = delete;
+        CoroSyncWorker& operator=(const CoroSyncWorker&) = delete;
+
+        /// \brief Runs one pull/apply round.
+        /// \return Round result; errors are reported in it, not thrown.
+        coro::Task<SyncWorkerRoundResult> run_once() {
+            SyncWorkerRoundResult result;
+            try {
+                PullRequest request;
+                request.requester = m_engine.local_node_id();
+                request.db_id = m_engine.db_uuid();
+                request.have = m_engine.applied_cursor();
+                request.max_batches = m_options.max_batches;
+                request.max_bytes = m_options.max_bytes;
+                request.max_single_batch_bytes = m_options.max_single_batch_bytes;
+                request.subscription = m_options.subscription;
+                request.request_full_snapshot = snapshot_wanted(request.have);
+                request.wait_timeout_ms = request.request_full_snapshot
+                    ? 0
+                    : static_cast<std::uint64_t>(m_options.pull_wait.count());
+                request.batch_form = PullBatchForm::Encoded;
+                request.cancel_token = m_cancel.token();
+
+                bool has_more = false;
+                do {
+                    if (stop_requested()) {
+                        result.has_more = has_more;
+                        co_return result;
+                    }
+                    const SyncCursor before = request.have;
+                    PullResponse response = co_await coro::pull(m_peer, request, m_resume);
+                    if (!response.ok) {
+                        if (response.error_code == SyncResponseErrorCode::SnapshotRequired &&
+                            m_options.snapshot_bootstrap) {
+                            m_snapshot_wanted = true;
+                        }
+                        result.ok = false;
+                        result.error = response.error.empty() ? "pull failed" : response.error;
+                        result.retry_hint = m_peer.last_retry_hint();
+                        result.sync_error_code = response.error_code;
+                        result.sync_error_retryable = response.error_retryable;
+                        co_return result;
+                    }
+                    ++result.pages_pulled;
+                    // Only the first page of a round long-polls.
+                    request.wait_timeout_ms = 0;
+                    has_more = response.has_more;
+                    if (stop_requested()) {
+                        result.has_more = has_more;
+                        co_return result;
+                    }
+
+                    const std::size_t page_batches =
+                        response.batches.size() + response.encoded_batches.size();
+                    if (page_batches != 0) {
+                        PushResponse applied;
+                        if (request.request_full_snapshot) {
+                            applied = m_engine.apply_snapshot_page(
+                                response, request.snapshot_token.empty());
+                        } else {
+                            PushRequest apply;
+                            apply.db_id = request.db_id;
+                            apply.batches.swap(response.batches);
+                            apply.encoded_batches.swap(response.encoded_batches);
+                            applied = m_engine.handle_push(apply);
+                        }
+                        result.commit_latency += applied.commit_latency;
+                        if (!applied.ok) {
+                            result.ok = false;
+                            result.error = applied.error.empty() ? "apply failed" : applied.error;
+                            result.sync_error_code = applied.error_code;
+                            result.sync_error_retryable = applied.error_retryable;
+                            co_return result;
+                        }
+                        result.batches_applied += page_batches;
+                        request.have = m_engine.applied_cursor();
+                    } else if (has_more) {
+                        result.ok = false;
+                        result.error = "pull reported has_more without batches";
+                        co_return result;
+                    }
+
+                    if (request.request_full_snapshot) {
+                        if (has_more) {
+                            if (response.snapshot_token.empty()) {
+                                result.ok = false;
+                                result.error = "snapshot page reported has_more without snapshot_token";
+                                co_return result;
+                            }
+                            request.snapshot_token = response.snapshot_token;
+                        } else {
+                            // Loaded; continue with changes since the snapshot.
+                            m_snapshot_wanted = false;
+                            request.request_full_snapshot = false;
+                            request.snapshot_token.clear();
+                            has_more = true;
+                        }
+                    } else if (has_more &&
+                        request.have.last_seq_by_origin == before.last_seq_by_origin) {
+                        result.ok = false;
+                        result.error = "pull pagination made no cursor progress";
+                        co_return result;
+                    }
+                    result.has_more = has_more;
+                } while (has_more && m_options.drain_pages);
+            } catch (const std::exception& e) {
+                result.ok = false;
+                result.error = e.what();
+                result.retry_hint = m_peer.last_retry_hint();
+            } catch (...) {
+                result.ok = false;
+                result.error = "unknown sync worker error";
+                result.retry_hint = m_peer.last_retry_hint();
+            }
+            co_return result;
+        }
+
+        /// \brief Runs rounds until \ref request_stop(), sleeping between them.
+        /// \details Waits \c idle_interval after a successful round and the
+        /// exponential backoff, or a shorter transport retry-after hint,
+        /// after a failed one. Ends after a classified permanent failure when
+        /// \c permanent_failure_policy is \c StopWorker. A stop requested
+        /// during a delay takes effect when the delay ends.
+        /// \param scheduler Timer used for the delays.
+        coro::Task<void> run(coro::Scheduler scheduler) {
+            std::chrono::milliseconds backoff = m_options.initial_backoff;
+            while (!stop_requested()) {
+                const SyncWorkerRoundResult result = co_await run_once();
+                if (stop_requested()) {
+                    break;
+                }
+                std::chrono::milliseconds delay = m_options.idle_interval;
+                if (result.ok) {
+                    backoff = m_options.initial_backoff;
+                } else {
+                    set_last_error(result.error);
+                    if (m_options.permanent_failure_policy ==
+                            SyncWorkerPermanentFailurePolicy::StopWorker &&
+                        result.retry_hint.available && !result.retry_hint.retryable) {
+                        break;
+                    }
+                    delay = backoff;
+                    if (result.retry_hint.retryable && result.retry_hint.has_retry_after) {
+                        const std::uint64_t max_seconds = static_cast<std::uint64_t>(
+                            m_options.max_backoff.count() / 1000);
+                        delay = result.retry_hint.retry_after_seconds >= max_seconds
+                            ? m_options.max_backoff
+                            : std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(
+                                  result.retry_hint.retry_after_seconds * 1000u));
+                    }
+                    backoff = backoff >= m_options.max_backoff / 2
+                        ? m_options.max_backoff
+                        : backoff + backoff;
+                }
+                if (delay.count() > 0) {
+                    co_await coro::sleep_for(scheduler, delay, m_resume);
+                }
+            }
+        }
+
+        /// \brief Asks the rounds to stop and cancels an in-flight pull.
+        void request_stop() {
+            m_stop_requested.store(true, std::memory_order_release);
+            m_cancel.request_cancel();
+            m_peer.request_cancel();
+        }
+
+        /// \brief Returns whether \ref request_stop() was called.
+        bool stop_requested() const {
+            return m_stop_requested.load(std::memory_order_acquire);
+        }
+
+        /// \brief Returns the error of the last failed round run by \ref run().
+        std::string last_error() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_last_error;
+        }
+
+    private:
+        bool snapshot_wanted(const SyncCursor& have) {
+            if (!m_options.snapshot_bootstrap) {
+                return false;
+            }
+            if (!m_bootstrap_checked) {
+                m_bootstrap_checked = true;
+                m_snapshot_wanted = have.last_seq_by_origin.empty();
+            }
+            return m_snapshot_wanted || m_engine.snapshot_import_pending();
+        }
+
+        void set_last_error(const std::string& error) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_last_error = error;
+        }
+
+        SyncEngine&        m_engine;
+        IAsyncSyncPeer&    m_peer;
+        SyncWorkerOptions  m_options;
+        coro::Resumer      m_resume;
+        CancellationSource m_cancel;
+        std::atomic<bool>  m_stop_requested;
+        bool               m_bootstrap_checked = false;
+        bool               m_snapshot_wanted = false;
+        mutable std::mutex m_mutex;
+        std::string        m_last_error;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBXC_HAS_COROUTINES
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_CORO_SYNC_WORKER_HPP_INCLUDED
@@ -25,7 +25,7 @@ namespace sync {
 
         PullResponse pull(const PullRequest& request) override {
             assert(m_remote != nullptr);
-            return m_remote->handle_pull(request);
+            return m_remote->handle_pull(request, request.batch_form);
         }
 
         PushResponse push(const PushRequest& request) override {
@@ -33,6 +33,11 @@ namespace sync {
             return m_remote->handle_push(request);
         }
 
+        RangeHashResponse range_hash(const RangeHashRequest& request) override {
+            assert(m_remote != nullptr);
+            return m_remote->handle_range_hash(request);
+        }
+
     private:
         SyncEngine* m_remote;
     };
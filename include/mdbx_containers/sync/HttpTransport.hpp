@@ -13,13 +13,19 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "IAsyncSyncPeer.hpp"
 #include "ISyncPeer.hpp"
+#include "PullPageCache.hpp"
 #include "SyncEngine.hpp"
 #include "TransportMessageCodec.hpp"
 
@@ -127,6 +133,9 @@ namespace sync {
         std::vector<HttpSyncHeader> headers;
         std::string remote_address;
         std::vector<std::uint8_t> body;
+        /// \brief Set by bindings that can write
+        /// \c HttpSyncResponse::body_chunks.
+        bool accept_chunked_body = false;
     };
 
     /// \brief Minimal response shape produced by \c HttpSyncServer.
@@ -139,6 +148,11 @@ namespace sync {
         std::string content_type;
         std::vector<HttpSyncHeader> headers;
         std::vector<std::uint8_t> body;
+        /// \brief Body as chunks, used instead of \c body when non-empty.
+        /// \details Set only for pull responses to requests with
+        /// \c HttpSyncRequest::accept_chunked_body, so a page is written
+        /// without being joined into one buffer first.
+        ChunkedTransportMessage body_chunks;
         std::string error;
     };
 
@@ -251,6 +265,29 @@ namespace sync {
         virtual void request_cancel() {}
     };
 
+    /// \brief Non-blocking client bridge implemented by an asynchronous HTTP library.
+    class IAsyncHttpSyncClient {
+    public:
+        /// \brief Receives the response, or the transport error and an empty response.
+        typedef std::function<void(std::exception_ptr, HttpSyncResponse)> Callback;
+
+        virtual ~IAsyncHttpSyncClient() {}
+
+        /// \brief Starts one binary sync request to \p target.
+        /// \details Same responsibilities as \c IHttpSyncClient::post().
+        /// \p body is only valid until the call returns. \p done runs exactly
+        /// once, on any thread, possibly before the call returns.
+        virtual void async_post(
+                const std::string& target,
+                const std::string& content_type,
+                const std::vector<std::uint8_t>& body,
+                const CancellationToken& cancel_token,
+                Callback done) = 0;
+
+        /// \brief Best-effort cancellation hook for an in-flight \c async_post().
+        virtual void request_cancel() {}
+    };
+
     /// \brief Shared constants for HTTP sync adapters.
     class HttpSyncRoutes {
     public:
@@ -269,19 +306,37 @@ namespace sync {
         static const char* push_target() {
             return "/mdbxc/sync/v1/push";
         }
+
+        static const char* range_hash_target() {
+            return "/mdbxc/sync/v1/range-hash";
+        }
     };
 
     /// \brief Server-side dispatcher from HTTP-shaped requests to SyncEngine.
+    /// \details Keeps the last \c have of up to \p max_cursor_baselines
+    /// requesters so their later pulls can send it as a delta; 0 turns
+    /// cursor deltas off. Copies share the baselines. Pull responses are
+    /// compressed per \ref set_compression() for requesters that accept it,
+    /// and shared between requesters per \ref set_pull_page_cache().
     class HttpSyncServer {
     public:
+        /// \brief Applies a decoded push in place of the engine.
+        typedef std::function<PushResponse(const PushRequest&)> PushHandler;
+
         explicit HttpSyncServer(SyncEngine& engine,
-                                const CodecBounds& bounds = CodecBounds())
-            : m_engine(engine), m_bounds(bounds) {}
+                                const CodecBounds& bounds = CodecBounds(),
+                                std::size_t max_cursor_baselines = 1024)
+            : m_engine(engine),
+              m_bounds(bounds),
+              m_cursor_baselines(
+                  std::make_shared<CursorBaselineCache>(max_cursor_baselines)) {}
 
         /// \brief Handles one already-parsed HTTP request.
         /// \details Returns HTTP-style status codes for transport/framing
         /// failures. Sync-level failures such as db_id mismatch are encoded
-        /// inside the binary PullResponse/PushResponse with status 200.
+        /// inside the binary PullResponse/PushResponse with status 200,
+        /// except a \c Busy push, which is answered with status 503 and
+        /// \c Retry-After so senders back off through \c SyncTransportRetryHint.
         HttpSyncResponse handle(const HttpSyncRequest& request) const {
             HttpSyncResponse response;
             if (request.method != HttpSyncRoutes::method_post()) {
@@ -289,9 +344,12 @@ namespace sync {
             } else if (request.content_type != HttpSyncRoutes::content_type()) {
                 response = make_error(415, "unsupported content type");
             } else if (request.target == HttpSyncRoutes::pull_target()) {
-                response = handle_pull(request.body);
+                response = handle_pull(request.body,
+                                       request.accept_chunked_body);
             } else if (request.target == HttpSyncRoutes::push_target()) {
                 response = handle_push(request.body);
+            } else if (request.target == HttpSyncRoutes::range_hash_target()) {
+                response = handle_range_hash(request.body);
             } else {
                 response = make_error(404, "unknown sync route");
             }
@@ -300,13 +358,33 @@ namespace sync {
             return response;
         }
 
+        /// \brief Sets when pull responses are sent compressed.
+        /// \details Call before serving; compression is off by default.
+        void set_compression(const TransportCompression& compression) {
+            m_compression = compression;
+        }
+
+        /// \brief Answers pulls from \p cache, or reads every page when null.
+        /// \details Call before serving. A cached page is one body chunk.
+        void set_pull_page_cache(std::shared_ptr<PullPageCache> cache) {
+            m_pull_pages = std::move(cache);
+        }
+
+        /// \brief Routes pushes through \p handler, e.g. a bound
+        /// \c PushApplyQueue::handle_push(); an empty handler restores the engine.
+        /// \details Call before serving.
+        void set_push_handler(PushHandler handler) {
+            m_push_handler = std::move(handler);
+        }
+
     private:
         HttpSyncResponse handle_pull(
-                const std::vector<std::uint8_t>& body) const {
+                const std::vector<std::uint8_t>& body,
+                bool accept_chunked_body) const {
             PullRequest decoded;
             try {
                 decoded = TransportMessageCodec::decode_pull_request(
-                    body, &m_bounds);
+                    body, &m_bounds, m_cursor_baselines.get());
             } catch (const std::length_error& e) {
                 return make_error(413, e.what());
             } catch (const std::exception& e) {
@@ -314,21 +392,90 @@ namespace sync {
             }
 
             try {
-                const PullResponse response = m_engine.handle_pull(decoded);
+                if (m_pull_pages && PullPageCache::cacheable(decoded)) {
+                    std::vector<std::uint8_t> bytes = cached_pull(decoded);
+                    if (!accept_chunked_body) {
+                        return make_binary(bytes);
+                    }
+                    HttpSyncResponse out = make_binary(std::vector<std::uint8_t>());
+                    out.body_chunks = ChunkedTransportMessage(std::move(bytes));
+                    return out;
+                }
+                PullResponse response =
+                    m_engine.handle_pull(decoded, PullBatchForm::Encoded);
+                m_cursor_baselines->remember(decoded, response);
+                const SyncCursor* cursor_baseline =
+                    decoded.accept_cursor_deltas && decoded.have_baseline_digest == 0
+                        ? &decoded.have
+                        : nullptr;
+                if (m_compression.enabled && decoded.accept_compressed_messages) {
+                    // Compression needs the whole message, so skip chunking.
+                    std::vector<std::uint8_t> bytes =
+                        TransportMessageCodec::encode_pull_response(
+                            response, &m_bounds, cursor_baseline);
+                    TransportMessageCodec::compress_message(bytes, m_compression);
+                    if (!accept_chunked_body) {
+                        return make_binary(bytes);
+                    }
+                    HttpSyncResponse out = make_binary(std::vector<std::uint8_t>());
+                    out.body_chunks = ChunkedTransportMessage(std::move(bytes));
+                    return out;
+                }
+                if (accept_chunked_body) {
+                    HttpSyncResponse out = make_binary(std::vector<std::uint8_t>());
+                    out.body_chunks =
+                        TransportMessageCodec::encode_pull_response_chunked(
+                            std::move(response), &m_bounds, cursor_baseline);
+                    return out;
+                }
                 return make_binary(
                     TransportMessageCodec::encode_pull_response(
-                        response, &m_bounds));
+                        response, &m_bounds, cursor_baseline));
             } catch (const std::exception& e) {
                 return make_error(500, e.what());
             }
         }
 
+        /// \brief Copies the page for \p request out of \c m_pull_pages,
+        /// reading and encoding it on a miss.
+        std::vector<std::uint8_t> cached_pull(const PullRequest& request) const {
+            const bool compress =
+                m_compression.enabled && request.accept_compressed_messages;
+            const PullPageCache::Key key = PullPageCache::make_key(
+                request, m_engine.connection()->last_txn_id(), compress);
+            bool hit = false;
+            const PullPageCache::Page page = m_pull_pages->find_or_fill(
+                key, request.wait_timeout_ms == 0, hit,
+                [this, &request, compress](bool& store) {
+                    PullResponse response =
+                        m_engine.handle_pull(request, PullBatchForm::Encoded);
+                    m_cursor_baselines->remember(request, response);
+                    store = response.ok && (response.has_more ||
+                                            !response.encoded_batches.empty());
+                    std::vector<std::uint8_t> bytes =
+                        TransportMessageCodec::encode_pull_response(
+                            response, &m_bounds,
+                            request.accept_cursor_deltas ? &request.have : nullptr);
+                    if (compress) {
+                        TransportMessageCodec::compress_message(bytes, m_compression);
+                    }
+                    return bytes;
+                });
+            if (hit) {
+                // The bookkeeping handle_pull() does for each requester.
+                PullResponse stored;
+                m_cursor_baselines->remember(request, stored);
+                m_engine.note_peer_have(request.requester, request.have);
+            }
+            return *page;
+        }
+
         HttpSyncResponse handle_push(
                 const std::vector<std::uint8_t>& body) const {
             PushRequest decoded;
             try {
                 decoded = TransportMessageCodec::decode_push_request(
-                    body, &m_bounds);
+                    body, &m_bounds, PullBatchForm::Encoded);
             } catch (const std::length_error& e) {
                 return make_error(413, e.what());
             } catch (const std::exception& e) {
@@ -336,7 +483,17 @@ namespace sync {
             }
 
             try {
-                const PushResponse response = m_engine.handle_push(decoded);
+                const PushResponse response = m_push_handler
+                    ? m_push_handler(decoded)
+                    : m_engine.handle_push(decoded);
+                if (response.error_code == SyncResponseErrorCode::Busy) {
+                    HttpSyncResponse busy = make_error(503, response.error);
+                    if (response.retry_after_seconds != 0) {
+                        http_add_header(busy.headers, "Retry-After",
+                                        std::to_string(response.retry_after_seconds));
+                    }
+                    return busy;
+                }
                 return make_binary(
                     TransportMessageCodec::encode_push_response(
                         response, &m_bounds));
@@ -345,6 +502,29 @@ namespace sync {
             }
         }
 
+        HttpSyncResponse handle_range_hash(
+                const std::vector<std::uint8_t>& body) const {
+            RangeHashRequest decoded;
+            try {
+                decoded = TransportMessageCodec::decode_range_hash_request(
+                    body, &m_bounds);
+            } catch (const std::length_error& e) {
+                return make_error(413, e.what());
+            } catch (const std::exception& e) {
+                return make_error(400, e.what());
+            }
+
+            try {
+                return make_binary(
+                    TransportMessageCodec::encode_range_hash_response(
+                        m_engine.handle_range_hash(decoded), &m_bounds));
+            } catch (const std::invalid_argument& e) {
+                return make_error(400, e.what());
+            } catch (const std::exception& e) {
+                return make_error(500, e.what());
+            }
+        }
+
         static HttpSyncResponse make_binary(
                 const std::vector<std::uint8_t>& body) {
             HttpSyncResponse response;
@@ -366,54 +546,71 @@ namespace sync {
 
         SyncEngine& m_engine;
         CodecBounds m_bounds;
+        std::shared_ptr<CursorBaselineCache> m_cursor_baselines;
+        TransportCompression m_compression;
+        std::shared_ptr<PullPageCache> m_pull_pages;
+        PushHandler m_push_handler;
     };
 
-    /// \brief \c ISyncPeer implementation over an abstract HTTP client.
-    class HttpSyncPeer : public ISyncPeer {
+    /// \brief Request encoding and response checks shared by the HTTP peers.
+    /// \details Holds the cursor-delta baseline, push compression state and
+    /// the last retry hint; only the retry hint may be read concurrently.
+    class HttpSyncPeerCodec {
     public:
-        explicit HttpSyncPeer(IHttpSyncClient& client,
-                              const CodecBounds& bounds = CodecBounds())
-            : m_client(client), m_bounds(bounds) {}
+        explicit HttpSyncPeerCodec(const CodecBounds& bounds)
+            : m_bounds(bounds) {}
 
-        PullResponse pull(const PullRequest& request) override {
+        std::vector<std::uint8_t> encode_pull(const PullRequest& request) {
             clear_last_retry_hint();
-            const std::vector<std::uint8_t> body =
-                TransportMessageCodec::encode_pull_request(
-                    request, &m_bounds);
-            const HttpSyncResponse response = m_client.post(
-                HttpSyncRoutes::pull_target(),
-                HttpSyncRoutes::content_type(),
-                body,
-                request.cancel_token);
+            return m_cursor_baseline.encode_request(request, &m_bounds);
+        }
+
+        PullResponse decode_pull(const PullRequest& request,
+                                 const HttpSyncResponse& response) {
             require_ok_response(response, "pull");
-            return TransportMessageCodec::decode_pull_response(
-                response.body, &m_bounds);
+            return m_cursor_baseline.decode_response(
+                request, response.body, &m_bounds);
         }
 
-        PushResponse push(const PushRequest& request) override {
+        std::vector<std::uint8_t> encode_push(const PushRequest& request) {
             clear_last_retry_hint();
-            const std::vector<std::uint8_t> body =
+            std::vector<std::uint8_t> body =
                 TransportMessageCodec::encode_push_request(
                     request, &m_bounds);
-            const HttpSyncResponse response = m_client.post(
-                HttpSyncRoutes::push_target(),
-                HttpSyncRoutes::content_type(),
-                body,
-                request.cancel_token);
+            if (m_remote_accepts_compression) {
+                TransportMessageCodec::compress_message(body, m_compression);
+            }
+            return body;
+        }
+
+        PushResponse decode_push(const HttpSyncResponse& response) {
             require_ok_response(response, "push");
-            return TransportMessageCodec::decode_push_response(
+            PushResponse decoded = TransportMessageCodec::decode_push_response(
                 response.body, &m_bounds);
+            m_remote_accepts_compression = decoded.accept_compressed_messages;
+            return decoded;
         }
 
-        void request_cancel() override {
-            m_client.request_cancel();
+        std::vector<std::uint8_t> encode_range_hash(const RangeHashRequest& request) {
+            clear_last_retry_hint();
+            return TransportMessageCodec::encode_range_hash_request(request, &m_bounds);
         }
 
-        SyncTransportRetryHint last_retry_hint() const override {
+        RangeHashResponse decode_range_hash(const HttpSyncResponse& response) {
+            require_ok_response(response, "range hash");
+            return TransportMessageCodec::decode_range_hash_response(
+                response.body, &m_bounds);
+        }
+
+        SyncTransportRetryHint last_retry_hint() const {
             std::lock_guard<std::mutex> lock(m_retry_mutex);
             return m_last_retry_hint;
         }
 
+        void set_compression(const TransportCompression& compression) {
+            m_compression = compression;
+        }
+
     private:
         void require_ok_response(const HttpSyncResponse& response,
                                  const char* operation) const {
@@ -456,12 +653,175 @@ namespace sync {
                 response.body.size());
         }
 
-        IHttpSyncClient& m_client;
         CodecBounds m_bounds;
+        PullCursorBaseline m_cursor_baseline;
+        TransportCompression m_compression;
+        bool m_remote_accepts_compression = false;
         mutable std::mutex m_retry_mutex;
         mutable SyncTransportRetryHint m_last_retry_hint;
     };
 
+    /// \brief \c ISyncPeer implementation over an abstract HTTP client.
+    /// \details Sends \c have as a delta once the server stored a baseline,
+    /// and resends a pull once with the full cursor when the server lost it.
+    /// Push requests are compressed per \ref set_compression() once a push
+    /// response advertised \c accept_compressed_messages.
+    class HttpSyncPeer : public ISyncPeer {
+    public:
+        explicit HttpSyncPeer(IHttpSyncClient& client,
+                              const CodecBounds& bounds = CodecBounds())
+            : m_client(client), m_codec(bounds) {}
+
+        PullResponse pull(const PullRequest& request) override {
+            PullResponse response = post_pull(request);
+            if (PullCursorBaseline::baseline_mismatch(response)) {
+                response = post_pull(request);
+            }
+            return response;
+        }
+
+        PushResponse push(const PushRequest& request) override {
+            const std::vector<std::uint8_t> body = m_codec.encode_push(request);
+            const HttpSyncResponse response = m_client.post(
+                HttpSyncRoutes::push_target(),
+                HttpSyncRoutes::content_type(),
+                body,
+                request.cancel_token);
+            return m_codec.decode_push(response);
+        }
+
+        RangeHashResponse range_hash(const RangeHashRequest& request) override {
+            const std::vector<std::uint8_t> body = m_codec.encode_range_hash(request);
+            const HttpSyncResponse response = m_client.post(
+                HttpSyncRoutes::range_hash_target(),
+                HttpSyncRoutes::content_type(),
+                body,
+                request.cancel_token);
+            return m_codec.decode_range_hash(response);
+        }
+
+        void request_cancel() override {
+            m_client.request_cancel();
+        }
+
+        SyncTransportRetryHint last_retry_hint() const override {
+            return m_codec.last_retry_hint();
+        }
+
+        /// \brief Sets when push requests are sent compressed.
+        /// \details Call before syncing; compression is off by default.
+        void set_compression(const TransportCompression& compression) {
+            m_codec.set_compression(compression);
+        }
+
+    private:
+        PullResponse post_pull(const PullRequest& request) {
+            const std::vector<std::uint8_t> body = m_codec.encode_pull(request);
+            const HttpSyncResponse response = m_client.post(
+                HttpSyncRoutes::pull_target(),
+                HttpSyncRoutes::content_type(),
+                body,
+                request.cancel_token);
+            return m_codec.decode_pull(request, response);
+        }
+
+        IHttpSyncClient& m_client;
+        HttpSyncPeerCodec m_codec;
+    };
+
+    /// \brief \c IAsyncSyncPeer implementation over an asynchronous HTTP client.
+    /// \details Same wire behaviour as \c HttpSyncPeer, including the single
+    /// full-cursor resend after a lost baseline; callbacks run on the
+    /// client's completion thread.
+    class AsyncHttpSyncPeer : public IAsyncSyncPeer {
+    public:
+        explicit AsyncHttpSyncPeer(IAsyncHttpSyncClient& client,
+                                   const CodecBounds& bounds = CodecBounds())
+            : m_client(client), m_codec(bounds) {}
+
+        void async_pull(const PullRequest& request, PullCallback done) override {
+            post_pull(std::make_shared<PullRequest>(request), std::move(done), true);
+        }
+
+        void async_push(const PushRequest& request, PushCallback done) override {
+            std::vector<std::uint8_t> body;
+            try {
+                body = m_codec.encode_push(request);
+            } catch (...) {
+                done(std::current_exception(), PushResponse());
+                return;
+            }
+            HttpSyncPeerCodec* codec = &m_codec;
+            m_client.async_post(
+                HttpSyncRoutes::push_target(),
+                HttpSyncRoutes::content_type(),
+                body,
+                request.cancel_token,
+                [codec, done](std::exception_ptr error, HttpSyncResponse response) {
+                    PushResponse decoded;
+                    if (!error) {
+                        try {
+                            decoded = codec->decode_push(response);
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    }
+                    done(error, std::move(decoded));
+                });
+        }
+
+        void request_cancel() override {
+            m_client.request_cancel();
+        }
+
+        SyncTransportRetryHint last_retry_hint() const override {
+            return m_codec.last_retry_hint();
+        }
+
+        /// \brief Sets when push requests are sent compressed.
+        /// \details Call before syncing; compression is off by default.
+        void set_compression(const TransportCompression& compression) {
+            m_codec.set_compression(compression);
+        }
+
+    private:
+        void post_pull(std::shared_ptr<PullRequest> request, PullCallback done,
+                       bool resend_on_mismatch) {
+            std::vector<std::uint8_t> body;
+            try {
+                body = m_codec.encode_pull(*request);
+            } catch (...) {
+                done(std::current_exception(), PullResponse());
+                return;
+            }
+            m_client.async_post(
+                HttpSyncRoutes::pull_target(),
+                HttpSyncRoutes::content_type(),
+                body,
+                request->cancel_token,
+                [this, request, done, resend_on_mismatch](
+                        std::exception_ptr error, HttpSyncResponse response) {
+                    PullResponse decoded;
+                    if (!error) {
+                        try {
+                            decoded = m_codec.decode_pull(*request, response);
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    }
+                    if (!error && resend_on_mismatch &&
+                        PullCursorBaseline::baseline_mismatch(decoded)) {
+                        post_pull(request, done, false);
+                        return;
+                    }
+                    done(error, std::move(decoded));
+                });
+        }
+
+        IAsyncHttpSyncClient& m_client;
+        HttpSyncPeerCodec m_codec;
+    };
+
 } // namespace sync
 } // namespace mdbxc
 
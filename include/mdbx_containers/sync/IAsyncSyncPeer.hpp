@@ -0,0 +1,114 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_I_ASYNC_SYNC_PEER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_I_ASYNC_SYNC_PEER_HPP_INCLUDED
+
+/// \file IAsyncSyncPeer.hpp
+/// \brief Completion-callback counterpart of \c ISyncPeer.
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "ISyncPeer.hpp"
+#include "protocol.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Peer that exchanges pull and push requests without blocking.
+    /// \details Each call returns once the request is handed to the transport
+    /// and reports the result to its callback, on whatever thread the
+    /// transport completes on. The callback receives a null pointer and the
+    /// response, or the transport error and a default response. It is called
+    /// exactly once, possibly before the call returns, and must not throw.
+    /// Like \c ISyncPeer, one peer serves one exchange at a time; callers
+    /// start the next exchange from the previous callback.
+    class IAsyncSyncPeer {
+    public:
+        /// \brief Receives the outcome of \ref async_pull().
+        typedef std::function<void(std::exception_ptr, PullResponse)> PullCallback;
+
+        /// \brief Receives the outcome of \ref async_push().
+        typedef std::function<void(std::exception_ptr, PushResponse)> PushCallback;
+
+        virtual ~IAsyncSyncPeer() {}
+
+        /// \brief Sends a pull request and reports the response to \p done.
+        virtual void async_pull(const PullRequest& request, PullCallback done) = 0;
+
+        /// \brief Sends a push request and reports the response to \p done.
+        virtual void async_push(const PushRequest& request, PushCallback done) = 0;
+
+        /// \brief Requests cancellation of the in-flight exchange.
+        /// \details Same contract as \c ISyncPeer::request_cancel(); the
+        /// callback still runs, usually with an error.
+        virtual void request_cancel() {}
+
+        /// \brief Returns retry advice for the most recent transport failure.
+        virtual SyncTransportRetryHint last_retry_hint() const {
+            return SyncTransportRetryHint();
+        }
+    };
+
+    /// \brief Runs a blocking \c ISyncPeer on a caller-supplied executor.
+    /// \details For transports without a native asynchronous client: the
+    /// blocking \c pull() / \c push() runs as a task posted to \p executor,
+    /// typically a small pool shared by many sessions, and the callback runs
+    /// on that pool thread. The peer and executor must outlive every
+    /// exchange.
+    class AsyncSyncPeerAdapter : public IAsyncSyncPeer {
+    public:
+        /// \brief Posts a task to the thread that runs blocking exchanges.
+        typedef std::function<void(std::function<void()>)> Executor;
+
+        AsyncSyncPeerAdapter(ISyncPeer& peer, Executor executor)
+            : m_peer(peer), m_executor(std::move(executor)) {}
+
+        void async_pull(const PullRequest& request, PullCallback done) override {
+            ISyncPeer* peer = &m_peer;
+            std::shared_ptr<PullRequest> copy = std::make_shared<PullRequest>(request);
+            m_executor([peer, copy, done]() {
+                PullResponse response;
+                std::exception_ptr error;
+                try {
+                    response = peer->pull(*copy);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                done(error, std::move(response));
+            });
+        }
+
+        void async_push(const PushRequest& request, PushCallback done) override {
+            ISyncPeer* peer = &m_peer;
+            std::shared_ptr<PushRequest> copy = std::make_shared<PushRequest>(request);
+            m_executor([peer, copy, done]() {
+                PushResponse response;
+                std::exception_ptr error;
+                try {
+                    response = peer->push(*copy);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                done(error, std::move(response));
+            });
+        }
+
+        void request_cancel() override {
+            m_peer.request_cancel();
+        }
+
+        SyncTransportRetryHint last_retry_hint() const override {
+            return m_peer.last_retry_hint();
+        }
+
+    private:
+        ISyncPeer& m_peer;
+        Executor   m_executor;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_I_ASYNC_SYNC_PEER_HPP_INCLUDED
@@ -8,11 +8,13 @@
 /// \details
 /// \c Connection holds a non-owning pointer to an \c ISyncCaptureSink set via
 /// \c Connection::attach_sync_capture(). \c BaseTable::record_op() forwards
-/// every successful write through this sink. \c Transaction::commit() calls
+/// every successful write through this sink, as borrowed \c MDBX_val buffers
+/// via \c record_change_view(). \c Transaction::commit() calls
 /// \c flush_in_txn() on the same write transaction so the captured batch is
 /// written to \c _mdbxc_changelog atomically with the user-visible change.
 
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -27,6 +29,8 @@
 namespace mdbxc {
 namespace sync {
 
+    class OriginTailCache;
+
     /// \brief Interface between mdbxc-core write paths and the sync recorder.
     /// \details The implementation owns thread-local pending state, decides
     /// when to assemble a batch, and writes it to \c _mdbxc_changelog inside
@@ -55,6 +59,28 @@ namespace sync {
                                    const std::vector<std::uint8_t>& storage_key,
                                    const std::vector<std::uint8_t>& value) = 0;
 
+        /// \brief Zero-copy form of \ref record_change() used by \c BaseTable.
+        /// \details \p storage_key and \p value are the buffers just passed
+        /// to MDBX and stay valid only during the call; implementations copy
+        /// what they keep. The default copies both into vectors and calls
+        /// \ref record_change(), so sinks overriding only that one still work.
+        virtual void record_change_view(MDBX_txn* txn,
+                                        const std::string& dbi_name,
+                                        ChangeOpType op_type,
+                                        std::uint32_t dbi_flags,
+                                        const MDBX_val& storage_key,
+                                        const MDBX_val& value) {
+            const std::uint8_t* key_begin = static_cast<const std::uint8_t*>(storage_key.iov_base);
+            const std::uint8_t* value_begin = static_cast<const std::uint8_t*>(value.iov_base);
+            record_change(txn, dbi_name, op_type, dbi_flags,
+                          storage_key.iov_len == 0
+                              ? std::vector<std::uint8_t>()
+                              : std::vector<std::uint8_t>(key_begin, key_begin + storage_key.iov_len),
+                          value.iov_len == 0
+                              ? std::vector<std::uint8_t>()
+                              : std::vector<std::uint8_t>(value_begin, value_begin + value.iov_len));
+        }
+
         /// \brief Called by \c Transaction::commit() before the actual commit.
         /// \param txn The about-to-commit write transaction.
         /// \details Implementations must write any pending captured changes to
@@ -71,6 +97,28 @@ namespace sync {
         virtual void discard_txn(MDBX_txn* txn) noexcept {
             (void)txn;
         }
+
+        /// \brief Called after a top-level write transaction committed.
+        /// \param txn_id \c mdbx_txn_id() of the committed transaction.
+        /// \details Default implementation is a no-op; implementations may
+        /// trust state cached by the \c flush_in_txn of that transaction.
+        virtual void committed_txn(std::uint64_t txn_id) noexcept {
+            (void)txn_id;
+        }
+
+        /// \brief Origin tails kept current by the changelog appends of
+        /// this sink.
+        /// \details \c SyncEngine serves pulls from it. Default returns null;
+        /// the engine then uses a cache of its own that is refilled whenever
+        /// \c _mdbxc_origins changes.
+        virtual std::shared_ptr<OriginTailCache> origin_tail_cache() const {
+            return std::shared_ptr<OriginTailCache>();
+        }
+
+        /// \brief Called when the connection closes its environment.
+        /// \details DBI handles cached by the sink are invalid afterwards.
+        /// Default implementation is a no-op.
+        virtual void env_closed() noexcept {}
     };
 
 } // namespace sync
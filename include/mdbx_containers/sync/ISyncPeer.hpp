@@ -46,6 +46,18 @@ namespace sync {
         /// \brief Sends a push request and returns the response.
         virtual PushResponse push(const PushRequest& request) = 0;
 
+        /// \brief Sends a range-hash request and returns the response.
+        /// \details Used by \c RangeHashVerifier. The default answers that
+        /// the peer does not serve range hashes, so transports without the
+        /// message stay valid.
+        virtual RangeHashResponse range_hash(const RangeHashRequest&) {
+            RangeHashResponse response;
+            response.ok = false;
+            response.error = "peer does not serve range hashes";
+            response.error_code = SyncResponseErrorCode::RangeHashUnavailable;
+            return response;
+        }
+
         /// \brief Requests cancellation of in-flight transport operations.
         /// \details Best-effort hook for blocking transports. The default
         /// implementation is a no-op, so token-only and non-interruptible
@@ -0,0 +1,467 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_MULTI_PEER_SYNC_WORKER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_MULTI_PEER_SYNC_WORKER_HPP_INCLUDED
+
+/// \file MultiPeerSyncWorker.hpp
+/// \brief Background fan-in that pulls from several peers into one apply thread.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ChangeBatchView.hpp"
+#include "ISyncPeer.hpp"
+#include "cancellation.hpp"
+#include "SyncEngine.hpp"
+#include "protocol.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Timing, pagination and queue settings for \c MultiPeerSyncWorker.
+    struct MultiPeerSyncWorkerOptions {
+        /// \brief Max batches requested from a peer per pull page.
+        std::uint64_t max_batches = 1000;
+
+        /// \brief Max encoded batch bytes requested from a peer per pull page.
+        std::uint64_t max_bytes = 4ULL * 1024ULL * 1024ULL;
+
+        /// \brief Hard limit for one encoded retained changelog batch.
+        std::uint64_t max_single_batch_bytes = 4ULL * 1024ULL * 1024ULL;
+
+        /// \brief Sent as \c PullRequest::subscription to every peer; empty
+        /// pulls every table.
+        std::vector<SyncTableSubscription> subscription;
+
+        /// \brief Delay before a peer is pulled again once it had nothing more.
+        /// \details With \c pull_wait that pull already waits for changes,
+        /// so this can be lowered, even to 0.
+        std::chrono::milliseconds idle_interval =
+            std::chrono::milliseconds(1000);
+
+        /// \brief Long-poll time sent as \c PullRequest::wait_timeout_ms
+        /// after a peer had nothing more; 0 disables long-poll.
+        std::chrono::milliseconds pull_wait = std::chrono::milliseconds(0);
+
+        /// \brief Initial delay after a failed pull from a peer.
+        std::chrono::milliseconds initial_backoff =
+            std::chrono::milliseconds(100);
+
+        /// \brief Maximum delay after repeated failed pulls from a peer.
+        std::chrono::milliseconds max_backoff =
+            std::chrono::milliseconds(5000);
+
+        /// \brief Pulled pages waiting for apply before pullers block.
+        /// \details Each page may hold up to \c max_bytes.
+        std::size_t max_queued_pages = 8;
+
+        /// \brief Batches merged into one apply transaction at most.
+        /// \details The apply thread takes every waiting page, up to this
+        /// many batches, and applies them with one \c handle_push().
+        std::size_t max_apply_batches = 4096;
+    };
+
+    /// \brief Counters of one peer of a \c MultiPeerSyncWorker.
+    struct MultiPeerSyncPeerStatus {
+        std::uint64_t pages_pulled = 0;   ///< Successful pull pages.
+        std::uint64_t batches_pulled = 0; ///< Batches in those pages.
+        std::uint64_t failures = 0;       ///< Failed pulls, in total.
+        std::string last_error;           ///< Error of the last failed pull.
+    };
+
+    /// \brief Thread-safe snapshot of a \c MultiPeerSyncWorker.
+    struct MultiPeerSyncWorkerStatus {
+        bool running = false;                 ///< Between \c start() and \c stop().
+        std::uint64_t transactions = 0;       ///< Committed apply transactions.
+        std::uint64_t pages_applied = 0;      ///< Pulled pages merged into them.
+        std::uint64_t batches_applied = 0;    ///< Batches handed to \c handle_push().
+        std::uint64_t duplicates_dropped = 0; ///< Batches already queued or applied.
+        std::string last_apply_error;         ///< Error of the last failed apply.
+        std::vector<MultiPeerSyncPeerStatus> peers; ///< In constructor order.
+    };
+
+    /// \brief Pulls from several peers at once and applies on one thread.
+    /// \details Each peer gets a puller thread; all feed one queue drained
+    /// by a single apply thread, so only that thread takes the writer.
+    /// Pullers ask for changes past the applied cursor raised by what is
+    /// already queued, so peers serving the same origins mostly return
+    /// different ranges. The apply thread merges the waiting pages, drops
+    /// batches whose \c (origin, seq) is already queued or applied, and
+    /// commits the rest with one \c SyncEngine::handle_push(). After a
+    /// failed apply the queue is discarded and pulling restarts from the
+    /// applied cursor. Full snapshot bootstrap is left to \c SyncWorker.
+    /// \note The engine and peers must outlive the worker.
+    /// \thread_safety \ref start() and \ref stop() must be serialized by the
+    /// caller; \ref status() is thread-safe.
+    class MultiPeerSyncWorker {
+    public:
+        /// \throws std::invalid_argument when \p peers is empty or holds a
+        ///         null pointer, or \p options is unusable.
+        MultiPeerSyncWorker(SyncEngine& engine,
+                            const std::vector<ISyncPeer*>& peers,
+                            const MultiPeerSyncWorkerOptions& options =
+                                MultiPeerSyncWorkerOptions())
+            : m_engine(engine), m_peers(peers), m_options(options) {
+            if (m_peers.empty()) {
+                throw std::invalid_argument("MultiPeerSyncWorker: no peers");
+            }
+            for (std::size_t i = 0; i < m_peers.size(); ++i) {
+                if (m_peers[i] == nullptr) {
+                    throw std::invalid_argument("MultiPeerSyncWorker: null peer");
+                }
+            }
+            validate_options(m_options);
+            m_status.peers.resize(m_peers.size());
+        }
+
+        /// \brief Stops and joins every thread.
+        ~MultiPeerSyncWorker() {
+            stop();
+        }
+
+        MultiPeerSyncWorker(const MultiPeerSyncWorker&) = delete;
+        MultiPeerSyncWorker& operator=(const MultiPeerSyncWorker&) = delete;
+
+        /// \brief Starts the puller and apply threads.
+        /// \throws std::logic_error if the worker is already running.
+        void start() {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                if (m_status.running) {
+                    throw std::logic_error("MultiPeerSyncWorker is already running");
+                }
+                m_stop_requested = false;
+                m_queue.clear();
+                m_queued_tail.clear();
+                m_cancel = CancellationSource();
+                m_status.running = true;
+            }
+            try {
+                m_apply_thread = std::thread(&MultiPeerSyncWorker::apply_main, this);
+                for (std::size_t i = 0; i < m_peers.size(); ++i) {
+                    m_pull_threads.push_back(
+                        std::thread(&MultiPeerSyncWorker::pull_main, this, i));
+                }
+            } catch (...) {
+                stop();
+                throw;
+            }
+        }
+
+        /// \brief Cancels in-flight pulls and joins every thread.
+        /// \details A merged apply in progress finishes first. May block
+        /// until in-flight \c ISyncPeer::pull() calls return.
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                if (!m_status.running) {
+                    return;
+                }
+                m_stop_requested = true;
+            }
+            m_cancel.request_cancel();
+            for (std::size_t i = 0; i < m_peers.size(); ++i) {
+                m_peers[i]->request_cancel();
+            }
+            m_changed.notify_all();
+            for (std::size_t i = 0; i < m_pull_threads.size(); ++i) {
+                if (m_pull_threads[i].joinable()) {
+                    m_pull_threads[i].join();
+                }
+            }
+            m_pull_threads.clear();
+            if (m_apply_thread.joinable()) {
+                m_apply_thread.join();
+            }
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_status.running = false;
+        }
+
+        /// \brief Returns a snapshot of the counters.
+        MultiPeerSyncWorkerStatus status() const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            return m_status;
+        }
+
+    private:
+        /// \brief Page waiting for the apply thread.
+        struct QueuedPage {
+            std::vector<ChangeBatch> batches;
+            std::vector<std::vector<std::uint8_t>> encoded_batches;
+        };
+
+        static void validate_options(const MultiPeerSyncWorkerOptions& options) {
+            if (options.max_batches == 0 || options.max_bytes == 0 ||
+                options.max_single_batch_bytes == 0) {
+                throw std::invalid_argument(
+                    "MultiPeerSyncWorkerOptions: page limits must be positive");
+            }
+            if (options.idle_interval.count() < 0 || options.pull_wait.count() < 0 ||
+                options.initial_backoff.count() <= 0 ||
+                options.max_backoff < options.initial_backoff) {
+                throw std::invalid_argument(
+                    "MultiPeerSyncWorkerOptions: invalid intervals");
+            }
+            if (options.max_queued_pages == 0 || options.max_apply_batches == 0) {
+                throw std::invalid_argument(
+                    "MultiPeerSyncWorkerOptions: queue limits must be positive");
+            }
+        }
+
+        /// \brief Puller loop of peer \p index.
+        void pull_main(std::size_t index) {
+            ISyncPeer& peer = *m_peers[index];
+            std::chrono::milliseconds backoff = m_options.initial_backoff;
+            bool caught_up = false;
+            while (!stop_requested()) {
+                PullRequest request;
+                PullResponse response;
+                std::string error;
+                bool stopped = false;
+                try {
+                    request.requester = m_engine.local_node_id();
+                    request.db_id = m_engine.db_uuid();
+                    request.have = pull_cursor();
+                    request.max_batches = m_options.max_batches;
+                    request.max_bytes = m_options.max_bytes;
+                    request.max_single_batch_bytes = m_options.max_single_batch_bytes;
+                    request.subscription = m_options.subscription;
+                    request.wait_timeout_ms = caught_up
+                        ? static_cast<std::uint64_t>(m_options.pull_wait.count())
+                        : 0;
+                    // Pulled batches are only applied, so keep them encoded.
+                    request.batch_form = PullBatchForm::Encoded;
+                    request.cancel_token = m_cancel.token();
+                    response = peer.pull(request);
+                    if (!response.ok) {
+                        error = response.error.empty() ? "pull failed" : response.error;
+                    } else if (!response.batches.empty() || !response.encoded_batches.empty()) {
+                        stopped = !enqueue(index, request.have, response);
+                    }
+                } catch (const std::exception& e) {
+                    error = e.what();
+                } catch (...) {
+                    error = "unknown pull error";
+                }
+                if (stopped || stop_requested()) {
+                    return;
+                }
+                if (!error.empty()) {
+                    {
+                        std::lock_guard<std::mutex> lk(m_mutex);
+                        ++m_status.peers[index].failures;
+                        m_status.peers[index].last_error = error;
+                    }
+                    caught_up = false;
+                    if (wait_for_stop(backoff)) {
+                        return;
+                    }
+                    backoff = (std::min)(backoff * 2, m_options.max_backoff);
+                    continue;
+                }
+                backoff = m_options.initial_backoff;
+                caught_up = !response.has_more;
+                if (caught_up && wait_for_stop(m_options.idle_interval)) {
+                    return;
+                }
+            }
+        }
+
+        /// \brief Applied cursor raised by the batches already queued.
+        SyncCursor pull_cursor() const {
+            SyncCursor have = m_engine.applied_cursor();
+            std::lock_guard<std::mutex> lk(m_mutex);
+            for (std::map<NodeId, std::uint64_t>::const_iterator it = m_queued_tail.begin();
+                 it != m_queued_tail.end(); ++it) {
+                std::uint64_t& seq = have.last_seq_by_origin[it->first];
+                seq = (std::max)(seq, it->second);
+            }
+            return have;
+        }
+
+        /// \brief Queues a page pulled with \p have, waiting for room.
+        /// \return \c false when stop was requested.
+        /// \throws std::runtime_error when a batch header is malformed.
+        bool enqueue(std::size_t index, const SyncCursor& have, PullResponse& response) {
+            QueuedPage page;
+            page.batches.swap(response.batches);
+            page.encoded_batches.swap(response.encoded_batches);
+            SyncCursor tail = have;
+            for (std::size_t i = 0; i < page.batches.size(); ++i) {
+                raise(tail, page.batches[i].origin_node_id, page.batches[i].seq);
+            }
+            for (std::size_t i = 0; i < page.encoded_batches.size(); ++i) {
+                const ChangeBatchView view(page.encoded_batches[i]);
+                raise(tail, view.origin_node_id(), view.seq());
+            }
+            const std::size_t count = page.batches.size() + page.encoded_batches.size();
+            std::unique_lock<std::mutex> lk(m_mutex);
+            m_changed.wait(lk, [this]() {
+                return m_stop_requested || m_queue.size() < m_options.max_queued_pages;
+            });
+            if (m_stop_requested) {
+                return false;
+            }
+            for (OriginSeqMap::const_iterator it =
+                     tail.last_seq_by_origin.begin();
+                 it != tail.last_seq_by_origin.end(); ++it) {
+                std::uint64_t& seq = m_queued_tail[it->first];
+                seq = (std::max)(seq, it->second);
+            }
+            m_queue.push_back(std::move(page));
+            ++m_status.peers[index].pages_pulled;
+            m_status.peers[index].batches_pulled += count;
+            lk.unlock();
+            m_changed.notify_all();
+            return true;
+        }
+
+        static void raise(SyncCursor& cursor, const NodeId& origin, std::uint64_t seq) {
+            std::uint64_t& last = cursor.last_seq_by_origin[origin];
+            last = (std::max)(last, seq);
+        }
+
+        /// \brief Apply thread: merges waiting pages into one push each time.
+        void apply_main() {
+            for (;;) {
+                std::vector<QueuedPage> pages;
+                {
+                    std::unique_lock<std::mutex> lk(m_mutex);
+                    m_changed.wait(lk, [this]() { return m_stop_requested || !m_queue.empty(); });
+                    if (m_stop_requested) {
+                        return;
+                    }
+                    std::size_t batches = 0;
+                    while (!m_queue.empty() && (pages.empty() || batches < m_options.max_apply_batches)) {
+                        batches += m_queue.front().batches.size() +
+                                   m_queue.front().encoded_batches.size();
+                        pages.push_back(std::move(m_queue.front()));
+                        m_queue.pop_front();
+                    }
+                }
+                m_changed.notify_all();
+                apply_pages(pages);
+            }
+        }
+
+        /// \brief Applies \p pages in one transaction, skipping duplicates.
+        /// \details Pages were pulled against a cursor at least as far as
+        /// every earlier page, so within each origin they overlap or follow
+        /// each other in queue order. A batch that would leave a gap means
+        /// the queue no longer matches the database; it and the queue are
+        /// dropped and pulling restarts from the applied cursor.
+        void apply_pages(std::vector<QueuedPage>& pages) {
+            PushRequest push;
+            std::size_t duplicates = 0;
+            bool gap = false;
+            std::string error;
+            try {
+                push.db_id = m_engine.db_uuid();
+                SyncCursor next = m_engine.applied_cursor();
+                for (std::size_t p = 0; p < pages.size(); ++p) {
+                    for (std::size_t i = 0; i < pages[p].batches.size(); ++i) {
+                        ChangeBatch& batch = pages[p].batches[i];
+                        switch (admit(next, batch.origin_node_id, batch.seq)) {
+                            case 0: push.batches.push_back(std::move(batch)); break;
+                            case 1: ++duplicates; break;
+                            default: gap = true; break;
+                        }
+                    }
+                    for (std::size_t i = 0; i < pages[p].encoded_batches.size(); ++i) {
+                        const ChangeBatchView view(pages[p].encoded_batches[i]);
+                        switch (admit(next, view.origin_node_id(), view.seq())) {
+                            case 0:
+                                push.encoded_batches.push_back(
+                                    std::move(pages[p].encoded_batches[i]));
+                                break;
+                            case 1: ++duplicates; break;
+                            default: gap = true; break;
+                        }
+                    }
+                }
+                if (!push.batches.empty() || !push.encoded_batches.empty()) {
+                    const PushResponse applied = m_engine.handle_push(push);
+                    if (!applied.ok) {
+                        error = applied.error.empty() ? "apply failed" : applied.error;
+                    }
+                }
+            } catch (const std::exception& e) {
+                error = e.what();
+            } catch (...) {
+                error = "unknown apply error";
+            }
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                m_status.duplicates_dropped += duplicates;
+                if (error.empty()) {
+                    ++m_status.transactions;
+                    m_status.pages_applied += pages.size();
+                    m_status.batches_applied +=
+                        push.batches.size() + push.encoded_batches.size();
+                } else {
+                    m_status.last_apply_error = error;
+                }
+                if (!error.empty() || gap) {
+                    m_queue.clear();
+                    m_queued_tail.clear();
+                }
+            }
+            m_changed.notify_all();
+        }
+
+        /// \brief Classifies a batch against \p next, the last \c seq taken
+        /// per origin: 0 to apply, 1 for a duplicate, 2 for a gap.
+        static int admit(SyncCursor& next, const NodeId& origin, std::uint64_t seq) {
+            std::uint64_t& last = next.last_seq_by_origin[origin];
+            if (seq <= last) {
+                return 1;
+            }
+            if (seq != last + 1) {
+                return 2;
+            }
+            last = seq;
+            return 0;
+        }
+
+        /// \brief Sleeps for \p duration unless stop is requested first.
+        /// \return \c true when stop was requested.
+        bool wait_for_stop(std::chrono::milliseconds duration) const {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            return m_changed.wait_for(lk, duration, [this]() { return m_stop_requested; });
+        }
+
+        bool stop_requested() const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            return m_stop_requested;
+        }
+
+        SyncEngine&                        m_engine;
+        std::vector<ISyncPeer*>            m_peers;
+        MultiPeerSyncWorkerOptions         m_options;
+        CancellationSource                 m_cancel;
+        std::vector<std::thread>           m_pull_threads;
+        std::thread                        m_apply_thread;
+        mutable std::mutex                 m_mutex;
+        mutable std::condition_variable    m_changed;
+        bool                               m_stop_requested = false;
+        std::deque<QueuedPage>             m_queue;
+        std::map<NodeId, std::uint64_t>    m_queued_tail; ///< Highest queued seq per origin.
+        MultiPeerSyncWorkerStatus          m_status;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_MULTI_PEER_SYNC_WORKER_HPP_INCLUDED
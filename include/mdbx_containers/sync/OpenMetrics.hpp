@@ -0,0 +1,453 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_OPEN_METRICS_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_OPEN_METRICS_HPP_INCLUDED
+
+/// \file OpenMetrics.hpp
+/// \brief OpenMetrics text exposition of sync and table metrics.
+/// \details
+/// Renders \c SyncWorkerStatus, \c MultiPeerSyncWorkerStatus,
+/// \c SyncTransportMetricsSnapshot, \c TableMetricsObserver and
+/// \c KeyAccessSampler in the OpenMetrics 1.0 text format scraped by
+/// Prometheus. Nothing here opens a socket: serve
+/// \ref OpenMetricsWriter::str() from any HTTP endpoint, for example
+/// \c simple_web::HttpSyncListenerConfig::metrics_provider.
+///
+/// Latencies are exported as histograms in seconds with fixed boundaries
+/// from 100 us to 10 s.
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/KeyAccessSampler.hpp"
+#include "../common/TableMetrics.hpp"
+#include "MultiPeerSyncWorker.hpp"
+#include "SyncWorker.hpp"
+#include "TransportMiddleware.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief One \c name="value" pair attached to a sample.
+    struct OpenMetricsLabel {
+        std::string name;
+        std::string value;
+    };
+
+    typedef std::vector<OpenMetricsLabel> OpenMetricsLabels;
+
+    /// \brief Content type of \ref OpenMetricsWriter::str().
+    inline const char* openmetrics_content_type() {
+        return "application/openmetrics-text; version=1.0.0; charset=utf-8";
+    }
+
+    /// \brief Collects samples and renders them as OpenMetrics text.
+    /// \details Samples are grouped by metric family in first-seen order, so
+    /// several workers or tables may be appended one after another while the
+    /// output still lists each family once. Not thread-safe; build one writer
+    /// per scrape.
+    class OpenMetricsWriter {
+    public:
+        /// \brief Adds a counter sample; \p name is the family name without
+        /// the \c _total suffix.
+        void counter(const std::string& name,
+                     const std::string& help,
+                     std::uint64_t value,
+                     const OpenMetricsLabels& labels = OpenMetricsLabels()) {
+            family(name, "counter", help) +=
+                name + "_total" + format_labels(labels) + " " +
+                std::to_string(value) + "\n";
+        }
+
+        /// \brief Adds a gauge sample.
+        void gauge(const std::string& name,
+                   const std::string& help,
+                   double value,
+                   const OpenMetricsLabels& labels = OpenMetricsLabels()) {
+            family(name, "gauge", help) +=
+                name + format_labels(labels) + " " + format_double(value) +
+                "\n";
+        }
+
+        /// \brief Adds a latency histogram, converted from nanoseconds to
+        /// seconds.
+        void histogram(const std::string& name,
+                       const std::string& help,
+                       const LatencyHistogram& latency,
+                       const OpenMetricsLabels& labels = OpenMetricsLabels()) {
+            static const std::uint64_t bounds_ns[] = {
+                100000ull, 250000ull, 500000ull,
+                1000000ull, 2500000ull, 5000000ull,
+                10000000ull, 25000000ull, 50000000ull,
+                100000000ull, 250000000ull, 500000000ull,
+                1000000000ull, 2500000000ull, 5000000000ull,
+                10000000000ull
+            };
+            std::string& out = family(name, "histogram", help);
+            for (std::size_t i = 0; i < sizeof(bounds_ns) / sizeof(bounds_ns[0]);
+                 ++i) {
+                OpenMetricsLabels bucket = labels;
+                bucket.push_back(OpenMetricsLabel{
+                    "le", format_double(static_cast<double>(bounds_ns[i]) / 1e9)});
+                out += name + "_bucket" + format_labels(bucket) + " " +
+                       std::to_string(latency.count_at_or_below(bounds_ns[i])) +
+                       "\n";
+            }
+            OpenMetricsLabels inf = labels;
+            inf.push_back(OpenMetricsLabel{"le", "+Inf"});
+            out += name + "_bucket" + format_labels(inf) + " " +
+                   std::to_string(latency.count()) + "\n";
+            out += name + "_count" + format_labels(labels) + " " +
+                   std::to_string(latency.count()) + "\n";
+        }
+
+        /// \brief Returns the exposition, terminated by \c # \c EOF.
+        std::string str() const {
+            std::string out;
+            for (std::size_t i = 0; i < m_families.size(); ++i) {
+                const Family& f = m_families[i];
+                out += "# TYPE " + f.name + " " + f.type + "\n";
+                if (!f.help.empty()) {
+                    out += "# HELP " + f.name + " " + escape(f.help, false) +
+                           "\n";
+                }
+                out += f.samples;
+            }
+            out += "# EOF\n";
+            return out;
+        }
+
+    private:
+        struct Family {
+            std::string name;
+            std::string type;
+            std::string help;
+            std::string samples;
+        };
+
+        std::string& family(const std::string& name,
+                            const char* type,
+                            const std::string& help) {
+            std::map<std::string, std::size_t>::const_iterator it =
+                m_index.find(name);
+            if (it != m_index.end()) {
+                return m_families[it->second].samples;
+            }
+            Family f;
+            f.name = name;
+            f.type = type;
+            f.help = help;
+            m_index[name] = m_families.size();
+            m_families.push_back(f);
+            return m_families.back().samples;
+        }
+
+        static std::string escape(const std::string& text, bool quote) {
+            std::string out;
+            out.reserve(text.size());
+            for (std::size_t i = 0; i < text.size(); ++i) {
+                const char c = text[i];
+                if (c == '\\') {
+                    out += "\\\\";
+                } else if (c == '\n') {
+                    out += "\\n";
+                } else if (quote && c == '"') {
+                    out += "\\\"";
+                } else {
+                    out += c;
+                }
+            }
+            return out;
+        }
+
+        static std::string format_labels(const OpenMetricsLabels& labels) {
+            if (labels.empty()) {
+                return std::string();
+            }
+            std::string out = "{";
+            for (std::size_t i = 0; i < labels.size(); ++i) {
+                if (i != 0) {
+                    out += ",";
+                }
+                out += labels[i].name + "=\"" + escape(labels[i].value, true) +
+                       "\"";
+            }
+            out += "}";
+            return out;
+        }
+
+        /// \brief Formats \p value independently of the global locale, with the
+        /// \c NaN, \c +Inf and \c -Inf spellings OpenMetrics requires.
+        static std::string format_double(double value) {
+            if (std::isnan(value)) {
+                return "NaN";
+            }
+            if (std::isinf(value)) {
+                return value > 0 ? "+Inf" : "-Inf";
+            }
+            std::ostringstream out;
+            out.imbue(std::locale::classic());
+            out.precision(9);
+            out << value;
+            return out.str();
+        }
+
+        std::vector<Family> m_families;
+        std::map<std::string, std::size_t> m_index;
+    };
+
+    namespace detail {
+        inline const char* table_operation_label(std::size_t op) {
+            static const char* const names[table_operation_count] = {
+                "find", "insert", "erase", "range", "commit"
+            };
+            return op < table_operation_count ? names[op] : "unknown";
+        }
+
+        /// \brief Hex-encodes at most \p max_bytes of \p key, marking a cut with "...".
+        inline std::string hex_key_label(const std::string& key, std::size_t max_bytes) {
+            static const char digits[] = "0123456789abcdef";
+            const std::size_t n = key.size() < max_bytes ? key.size() : max_bytes;
+            std::string out;
+            out.reserve(n * 2 + 3);
+            for (std::size_t i = 0; i < n; ++i) {
+                const unsigned char c = static_cast<unsigned char>(key[i]);
+                out += digits[c >> 4];
+                out += digits[c & 0x0F];
+            }
+            if (n < key.size()) out += "...";
+            return out;
+        }
+
+        inline double to_seconds(std::chrono::steady_clock::duration d) {
+            return std::chrono::duration_cast<
+                       std::chrono::duration<double> >(d).count();
+        }
+    } // namespace detail
+
+    /// \brief Appends the state of one \c SyncWorker.
+    /// \details \p peer labels every sample so that workers syncing with
+    /// different hubs or origins can share one writer. Replication lag is
+    /// exported as \c mdbxc_sync_worker_lag_batches once the remote tail is
+    /// known.
+    inline void append_sync_worker_metrics(OpenMetricsWriter& writer,
+                                           const SyncWorkerStatus& status,
+                                           const std::string& peer) {
+        OpenMetricsLabels labels;
+        labels.push_back(OpenMetricsLabel{"peer", peer});
+
+        writer.counter("mdbxc_sync_worker_rounds_started",
+                       "Sync rounds started.", status.rounds_started, labels);
+        writer.counter("mdbxc_sync_worker_rounds_succeeded",
+                       "Sync rounds completed without error.",
+                       status.rounds_succeeded, labels);
+        writer.counter("mdbxc_sync_worker_rounds_failed",
+                       "Sync rounds that failed and led to a backoff.",
+                       status.rounds_failed, labels);
+        writer.gauge("mdbxc_sync_worker_backoff_active",
+                     "1 while the worker waits before a retry.",
+                     status.backoff_active ? 1.0 : 0.0, labels);
+        writer.gauge("mdbxc_sync_worker_backoff_delay_seconds",
+                     "Last scheduled backoff delay.",
+                     detail::to_seconds(status.last_backoff_delay), labels);
+        writer.gauge("mdbxc_sync_worker_page_max_bytes",
+                     "Current pull page byte budget.",
+                     static_cast<double>(status.page_max_bytes), labels);
+        writer.gauge("mdbxc_sync_worker_page_max_batches",
+                     "Current pull page batch budget.",
+                     static_cast<double>(status.page_max_batches), labels);
+        if (status.last_progress.remote_tail_known) {
+            writer.gauge("mdbxc_sync_worker_lag_batches",
+                         "Batches the peer reported beyond the last page.",
+                         static_cast<double>(
+                             status.last_progress.batches_remaining),
+                         labels);
+        }
+
+        const std::chrono::steady_clock::time_point unset;
+        if (status.last_round_finished_at != unset) {
+            if (status.last_round_started_at != unset &&
+                status.last_round_finished_at >= status.last_round_started_at) {
+                writer.gauge("mdbxc_sync_worker_last_round_duration_seconds",
+                             "Wall time of the last completed round.",
+                             detail::to_seconds(status.last_round_finished_at -
+                                                status.last_round_started_at),
+                             labels);
+            }
+            writer.gauge("mdbxc_sync_worker_last_round_age_seconds",
+                         "Time since the last round completed.",
+                         detail::to_seconds(std::chrono::steady_clock::now() -
+                                            status.last_round_finished_at),
+                         labels);
+        }
+    }
+
+    /// \brief Appends the state of a \c MultiPeerSyncWorker.
+    /// \details Per-peer samples are labelled with the peer's constructor
+    /// index.
+    inline void append_multi_peer_sync_worker_metrics(
+            OpenMetricsWriter& writer,
+            const MultiPeerSyncWorkerStatus& status) {
+        writer.counter("mdbxc_multi_peer_transactions",
+                       "Committed apply transactions.", status.transactions);
+        writer.counter("mdbxc_multi_peer_pages_applied",
+                       "Pulled pages merged into apply transactions.",
+                       status.pages_applied);
+        writer.counter("mdbxc_multi_peer_batches_applied",
+                       "Batches handed to SyncEngine::handle_push().",
+                       status.batches_applied);
+        writer.counter("mdbxc_multi_peer_duplicates_dropped",
+                       "Batches dropped as already queued or applied.",
+                       status.duplicates_dropped);
+        for (std::size_t i = 0; i < status.peers.size(); ++i) {
+            OpenMetricsLabels labels;
+            labels.push_back(OpenMetricsLabel{"peer", std::to_string(i)});
+            writer.counter("mdbxc_multi_peer_pages_pulled",
+                           "Successful pull pages.",
+                           status.peers[i].pages_pulled, labels);
+            writer.counter("mdbxc_multi_peer_batches_pulled",
+                           "Batches in successful pull pages.",
+                           status.peers[i].batches_pulled, labels);
+            writer.counter("mdbxc_multi_peer_pull_failures",
+                           "Failed pulls.", status.peers[i].failures, labels);
+        }
+    }
+
+    /// \brief Appends a \c SyncTransportMetricsSnapshot.
+    /// \details \p labels, for example \c layer="http", are attached to every
+    /// sample so that several observers can be exported side by side.
+    inline void append_sync_transport_metrics(
+            OpenMetricsWriter& writer,
+            const SyncTransportMetricsSnapshot& snapshot,
+            const OpenMetricsLabels& labels = OpenMetricsLabels()) {
+        const struct {
+            const char* operation;
+            std::uint64_t value;
+        } calls[] = {
+            {"pull", snapshot.pull_calls},
+            {"push", snapshot.push_calls},
+            {"http_post", snapshot.http_post_calls},
+            {"http_request", snapshot.http_request_calls},
+            {"websocket_message", snapshot.websocket_message_calls},
+            {"request_cancel", snapshot.request_cancel_calls}
+        };
+        for (std::size_t i = 0; i < sizeof(calls) / sizeof(calls[0]); ++i) {
+            OpenMetricsLabels with_op = labels;
+            with_op.push_back(OpenMetricsLabel{"operation", calls[i].operation});
+            writer.counter("mdbxc_sync_transport_calls",
+                           "Transport middleware hook invocations.",
+                           calls[i].value, with_op);
+        }
+        writer.counter("mdbxc_sync_transport_rejected",
+                       "Calls rejected by transport policy.",
+                       snapshot.rejected_calls, labels);
+        writer.counter("mdbxc_sync_transport_failed",
+                       "Failed or throwing transport calls.",
+                       snapshot.failed_calls, labels);
+        writer.counter("mdbxc_sync_transport_pulled_batches",
+                       "Batches returned by pulls.",
+                       snapshot.pulled_batches, labels);
+        writer.counter("mdbxc_sync_transport_pushed_batches",
+                       "Batches sent by pushes.",
+                       snapshot.pushed_batches, labels);
+
+        const struct {
+            const char* operation;
+            const LatencyHistogram* latency;
+        } latencies[] = {
+            {"pull", &snapshot.pull_latency},
+            {"push", &snapshot.push_latency},
+            {"http_post", &snapshot.http_post_latency},
+            {"websocket_message", &snapshot.websocket_message_latency}
+        };
+        for (std::size_t i = 0; i < sizeof(latencies) / sizeof(latencies[0]);
+             ++i) {
+            OpenMetricsLabels with_op = labels;
+            with_op.push_back(
+                OpenMetricsLabel{"operation", latencies[i].operation});
+            writer.histogram("mdbxc_sync_transport_latency_seconds",
+                             "Wall time of forwarded transport calls.",
+                             *latencies[i].latency, with_op);
+        }
+    }
+
+    /// \brief Appends every table recorded by a \c TableMetricsObserver.
+    /// \details Commits are reported under \c table="" and
+    /// \c operation="commit".
+    inline void append_table_metrics(OpenMetricsWriter& writer,
+                                     const TableMetricsObserver& observer) {
+        const std::vector<std::string> tables = observer.tables();
+        for (std::size_t t = 0; t < tables.size(); ++t) {
+            const TableMetrics metrics = observer.metrics(tables[t]);
+            for (std::size_t op = 0; op < table_operation_count; ++op) {
+                const OperationMetrics& m = metrics.operations[op];
+                if (m.count == 0) {
+                    continue;
+                }
+                OpenMetricsLabels labels;
+                labels.push_back(OpenMetricsLabel{"table", tables[t]});
+                labels.push_back(
+                    OpenMetricsLabel{"operation", detail::table_operation_label(op)});
+                writer.counter("mdbxc_table_operations",
+                               "Completed table operations.", m.count, labels);
+                writer.counter("mdbxc_table_bytes",
+                               "Key and value bytes read or written.",
+                               m.bytes, labels);
+                writer.histogram("mdbxc_table_operation_latency_seconds",
+                                 "Wall time of table operations.",
+                                 m.latency, labels);
+            }
+        }
+    }
+
+    /// \brief Appends the hottest sampled keys of every table recorded by a
+    /// \c KeyAccessSampler.
+    /// \details Each of the \p top_n keys per table and operation becomes a
+    /// gauge sample labelled with the hex-encoded key, cut to \p key_bytes
+    /// bytes, so the series count stays bounded. The value is the sampled
+    /// count times \c sample_every(), an estimate of the accesses since the
+    /// last reset.
+    inline void append_key_sampler_metrics(OpenMetricsWriter& writer,
+                                           const KeyAccessSampler& sampler,
+                                           std::size_t top_n = 10,
+                                           std::size_t key_bytes = 32) {
+        const std::vector<std::string> tables = sampler.tables();
+        for (std::size_t t = 0; t < tables.size(); ++t) {
+            const TableKeySketches sketches = sampler.sketches(tables[t]);
+            for (std::size_t op = 0; op < table_operation_count; ++op) {
+                const SpaceSavingSketch& sketch = sketches.operations[op];
+                if (sketch.total() == 0) {
+                    continue;
+                }
+                OpenMetricsLabels labels;
+                labels.push_back(OpenMetricsLabel{"table", tables[t]});
+                labels.push_back(
+                    OpenMetricsLabel{"operation", detail::table_operation_label(op)});
+                writer.counter("mdbxc_table_key_samples",
+                               "Table key accesses recorded by the sampler.",
+                               sketch.total(), labels);
+                const std::vector<HotKey> hot = sketch.top(top_n);
+                for (std::size_t i = 0; i < hot.size(); ++i) {
+                    OpenMetricsLabels with_key = labels;
+                    with_key.push_back(OpenMetricsLabel{
+                        "key", detail::hex_key_label(hot[i].key, key_bytes)});
+                    writer.gauge("mdbxc_table_hot_key_accesses",
+                                 "Estimated accesses of the hottest sampled keys.",
+                                 static_cast<double>(hot[i].count) *
+                                     static_cast<double>(sampler.sample_every()),
+                                 with_key);
+                }
+            }
+        }
+    }
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_OPEN_METRICS_HPP_INCLUDED
@@ -0,0 +1,101 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_ORIGIN_TAIL_CACHE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_ORIGIN_TAIL_CACHE_HPP_INCLUDED
+
+/// \file OriginTailCache.hpp
+/// \brief In-memory copy of the \c _mdbxc_origins tails used by pulls.
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "stores/OriginIndexStore.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Origin tails of one \c _mdbxc_origins version.
+    /// \details A version is the \c ms_mod_txnid of the index DBI, so a
+    /// reader that sees the same value sees exactly the cached tails; any
+    /// other writer, process or maintenance pass that touches the index
+    /// changes the value and turns lookups into misses. \c SyncEngine fills
+    /// the cache from a pull that missed, and \c ThreadLocalChangeAccumulator
+    /// raises the local origin after each committed changelog append, so an
+    /// up-to-date replica is answered without walking the index.
+    /// \thread_safety Thread-safe.
+    class OriginTailCache {
+    public:
+        typedef OriginIndexStore::OriginTail OriginTail;
+
+        /// \brief Copies the tails cached for index version \p index_txnid.
+        /// \return \c false when the cache holds another version or none.
+        bool lookup(std::uint64_t index_txnid, std::vector<OriginTail>& out) const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (!m_valid || m_index_txnid != index_txnid) {
+                return false;
+            }
+            out = m_tails;
+            return true;
+        }
+
+        /// \brief Caches \p tails read from index version \p index_txnid.
+        /// \details Tails must be in DB key order. An older version than the
+        /// cached one is ignored.
+        void store(std::uint64_t index_txnid, std::vector<OriginTail> tails) {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (m_valid && index_txnid <= m_index_txnid) {
+                return;
+            }
+            m_tails.swap(tails);
+            m_index_txnid = index_txnid;
+            m_valid = true;
+        }
+
+        /// \brief Applies a committed append of \p origin at \p seq.
+        /// \param base_txnid Index version the appending transaction started from.
+        /// \param index_txnid Index version the append committed.
+        /// \details Ignored unless the cache holds \p base_txnid; the next
+        /// pull then refills it.
+        void committed_append(std::uint64_t base_txnid,
+                              std::uint64_t index_txnid,
+                              const NodeId& origin,
+                              std::uint64_t seq) {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if (!m_valid || m_index_txnid != base_txnid) {
+                return;
+            }
+            std::vector<OriginTail>::iterator it =
+                std::lower_bound(m_tails.begin(), m_tails.end(), origin,
+                                 [](const OriginTail& tail, const NodeId& key) {
+                                     return compare_node_id(tail.origin, key) < 0;
+                                 });
+            if (it == m_tails.end() || compare_node_id(it->origin, origin) != 0) {
+                OriginTail tail;
+                tail.origin = origin;
+                tail.last_seq = seq;
+                m_tails.insert(it, tail);
+            } else if (it->last_seq < seq) {
+                it->last_seq = seq;
+            }
+            m_index_txnid = index_txnid;
+        }
+
+        /// \brief Drops the cached tails.
+        void invalidate() noexcept {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_valid = false;
+            m_tails.clear();
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        bool m_valid = false;
+        std::uint64_t m_index_txnid = 0;  ///< Index \c ms_mod_txnid the tails reflect.
+        std::vector<OriginTail> m_tails;  ///< In DB key order.
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_ORIGIN_TAIL_CACHE_HPP_INCLUDED
@@ -0,0 +1,298 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_PULL_PAGE_CACHE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_PULL_PAGE_CACHE_HPP_INCLUDED
+
+/// \file PullPageCache.hpp
+/// \brief Encoded pull responses shared by requesters that ask for the same
+///        page of the same database state.
+/// \details During a fleet catch-up many replicas pull with the same cursor
+/// and limits, and each pull reads the changelog and encodes the page again.
+/// A responder that shares a \c PullPageCache reads and encodes such a page
+/// once per committed transaction and copies the bytes for the others.
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "SyncCursor.hpp"
+#include "common.hpp"
+#include "protocol.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief LRU cache of encoded pull responses keyed by database state
+    /// and request shape.
+    /// \details A key holds the newest committed transaction id read before
+    /// the pull, so any commit, local or from another process, moves new
+    /// requests to new keys; a cached page is never older than its key.
+    /// The rest of the key is what the page depends on: \c db_id, \c have,
+    /// the page limits, \c accept_compressed_batches, \c accept_cursor_deltas
+    /// and whether the message is compressed. Only ok pages that carry
+    /// batches are stored, so idle long-polls still wait. Requests with a
+    /// subscription, a snapshot or an unresolved cursor delta are not
+    /// cached. A page filled for one requester follows that requester's
+    /// round-robin origin order; any page after \c have is a valid answer.
+    /// Concurrent misses on one key, except long-polls, wait for the first
+    /// instead of reading the same page.
+    /// \thread_safety Thread-safe; share one cache between the servers of
+    /// one engine through \c std::shared_ptr.
+    class PullPageCache {
+    public:
+        /// \brief Encoded response bytes shared by the cache and its readers.
+        typedef std::shared_ptr<const std::vector<std::uint8_t>> Page;
+
+        /// \brief What an encoded page depends on.
+        struct Key {
+            std::uint64_t txn_id = 0;
+            DbId db_id{};
+            SyncCursor have;
+            std::uint64_t max_batches = 0;
+            std::uint64_t max_bytes = 0;
+            std::uint64_t max_single_batch_bytes = 0;
+            bool accept_compressed_batches = false;
+            bool accept_cursor_deltas = false;
+            bool compressed = false;
+        };
+
+        /// \brief Counters since construction and the current occupancy.
+        struct Stats {
+            std::uint64_t hits = 0;    ///< Pulls answered from the cache.
+            std::uint64_t misses = 0;  ///< Cacheable pulls that were read and encoded.
+            std::size_t entries = 0;   ///< Pages held now.
+            std::uint64_t bytes = 0;   ///< Encoded bytes held now.
+        };
+
+        /// \param max_entries Pages kept at most; 0 caches nothing.
+        /// \param max_bytes Encoded bytes kept at most; larger pages are not stored.
+        explicit PullPageCache(std::size_t max_entries = 64,
+                               std::uint64_t max_bytes = 64ULL * 1024ULL * 1024ULL)
+            : m_max_entries(max_entries), m_max_bytes(max_bytes) {}
+
+        PullPageCache(const PullPageCache&) = delete;
+        PullPageCache& operator=(const PullPageCache&) = delete;
+
+        /// \brief Whether responses to \p request may be shared.
+        static bool cacheable(const PullRequest& request) {
+            return !request.request_full_snapshot && request.snapshot_token.empty() &&
+                   request.subscription.empty() && request.have_baseline_digest == 0;
+        }
+
+        /// \brief Builds the key of \p request against transaction \p txn_id.
+        static Key make_key(const PullRequest& request,
+                            std::uint64_t txn_id,
+                            bool compressed) {
+            Key key;
+            key.txn_id = txn_id;
+            key.db_id = request.db_id;
+            key.have = request.have;
+            key.max_batches = request.max_batches;
+            key.max_bytes = request.max_bytes;
+            key.max_single_batch_bytes = request.max_single_batch_bytes;
+            key.accept_compressed_batches = request.accept_compressed_batches;
+            key.accept_cursor_deltas = request.accept_cursor_deltas;
+            key.compressed = compressed;
+            return key;
+        }
+
+        /// \brief Returns the page of \p key, calling \p fill on a miss.
+        /// \param fill Callable as \c std::vector<std::uint8_t>(bool& store);
+        ///        reads and encodes the page and clears \c store for a page
+        ///        that must not be shared.
+        /// \param wait Wait for a concurrent \p fill of the same key; pass
+        ///        \c false for long-polls.
+        /// \param hit Set to \c true when the page came from the cache.
+        /// \details Exceptions from \p fill propagate; waiters then fill
+        /// their own pages.
+        template <class Fill>
+        Page find_or_fill(const Key& key, bool wait, bool& hit, Fill fill) {
+            hit = false;
+            const Index index = make_index(key);
+            std::shared_ptr<Flight> flight;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if (find_locked(index, key)) {
+                    hit = true;
+                    return touch_locked(index);
+                }
+                const std::map<Index, std::shared_ptr<Flight>>::iterator it =
+                    m_flights.find(index);
+                if (it != m_flights.end() && wait) {
+                    std::shared_ptr<Flight> leader = it->second;
+                    m_cv.wait(lock, [&leader]() { return leader->done; });
+                    if (leader->page && same_have(leader->key, key)) {
+                        hit = true;
+                        ++m_stats.hits;
+                        return leader->page;
+                    }
+                } else if (it == m_flights.end() && m_max_entries != 0) {
+                    flight = std::make_shared<Flight>();
+                    flight->key = key;
+                    m_flights[index] = flight;
+                }
+                ++m_stats.misses;
+            }
+            FlightGuard guard(*this, index, flight);
+            bool store = true;
+            Page page = std::make_shared<const std::vector<std::uint8_t>>(fill(store));
+            if (store) {
+                store_page(index, key, page);
+                guard.publish(page);
+            }
+            return page;
+        }
+
+        /// \brief Returns the counters and the current occupancy.
+        Stats stats() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Stats out = m_stats;
+            out.entries = m_entries.size();
+            return out;
+        }
+
+        /// \brief Drops every page.
+        void clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_entries.clear();
+            m_stats.bytes = 0;
+        }
+
+    private:
+        /// \brief Ordered part of a key; \c have is compared by digest here
+        /// and in full on a hit.
+        typedef std::tuple<std::uint64_t, std::uint64_t, DbId, std::uint64_t,
+                           std::uint64_t, std::uint64_t, unsigned> Index;
+
+        struct Entry {
+            SyncCursor have;
+            Page page;
+            std::uint64_t stamp = 0;
+        };
+
+        struct Flight {
+            Key key;
+            Page page;
+            bool done = false;
+        };
+
+        /// \brief Ends a fill: wakes its waiters even when \c fill threw.
+        class FlightGuard {
+        public:
+            FlightGuard(PullPageCache& cache, const Index& index,
+                        const std::shared_ptr<Flight>& flight)
+                : m_cache(cache), m_index(index), m_flight(flight) {}
+
+            ~FlightGuard() {
+                if (!m_flight) return;
+                {
+                    std::lock_guard<std::mutex> lock(m_cache.m_mutex);
+                    m_flight->done = true;
+                    m_cache.m_flights.erase(m_index);
+                }
+                m_cache.m_cv.notify_all();
+            }
+
+            void publish(const Page& page) {
+                if (!m_flight) return;
+                std::lock_guard<std::mutex> lock(m_cache.m_mutex);
+                m_flight->page = page;
+            }
+
+            FlightGuard(const FlightGuard&) = delete;
+            FlightGuard& operator=(const FlightGuard&) = delete;
+
+        private:
+            PullPageCache& m_cache;
+            Index m_index;
+            std::shared_ptr<Flight> m_flight;
+        };
+
+        static Index make_index(const Key& key) {
+            const unsigned flags = (key.accept_compressed_batches ? 1u : 0u) |
+                                   (key.accept_cursor_deltas ? 2u : 0u) |
+                                   (key.compressed ? 4u : 0u);
+            return Index(key.txn_id, sync_cursor_digest(key.have), key.db_id,
+                         key.max_batches, key.max_bytes, key.max_single_batch_bytes, flags);
+        }
+
+        static bool same_have(const Key& a, const Key& b) {
+            return a.have.last_seq_by_origin == b.have.last_seq_by_origin;
+        }
+
+        bool find_locked(const Index& index, const Key& key) {
+            const std::map<Index, Entry>::iterator it = m_entries.find(index);
+            if (it == m_entries.end() ||
+                it->second.have.last_seq_by_origin != key.have.last_seq_by_origin) {
+                return false;
+            }
+            ++m_stats.hits;
+            return true;
+        }
+
+        Page touch_locked(const Index& index) {
+            Entry& entry = m_entries[index];
+            entry.stamp = ++m_clock;
+            return entry.page;
+        }
+
+        void store_page(const Index& index, const Key& key, const Page& page) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_max_entries == 0 || page->size() > m_max_bytes ||
+                key.txn_id < m_newest_txn_id) {
+                return;
+            }
+            if (key.txn_id > m_newest_txn_id) {
+                // Newer requests no longer look up older transactions.
+                m_newest_txn_id = key.txn_id;
+                m_entries.clear();
+                m_stats.bytes = 0;
+            }
+            const std::map<Index, Entry>::iterator old = m_entries.find(index);
+            if (old != m_entries.end()) {
+                m_stats.bytes -= old->second.page->size();
+                m_entries.erase(old);
+            }
+            while (!m_entries.empty() &&
+                   (m_entries.size() >= m_max_entries ||
+                    m_stats.bytes + page->size() > m_max_bytes)) {
+                evict_oldest();
+            }
+            Entry& entry = m_entries[index];
+            entry.have = key.have;
+            entry.page = page;
+            entry.stamp = ++m_clock;
+            m_stats.bytes += page->size();
+        }
+
+        void evict_oldest() {
+            std::map<Index, Entry>::iterator oldest = m_entries.begin();
+            for (std::map<Index, Entry>::iterator it = m_entries.begin();
+                 it != m_entries.end(); ++it) {
+                if (it->second.stamp < oldest->second.stamp) {
+                    oldest = it;
+                }
+            }
+            m_stats.bytes -= oldest->second.page->size();
+            m_entries.erase(oldest);
+        }
+
+        const std::size_t m_max_entries;
+        const std::uint64_t m_max_bytes;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::map<Index, Entry> m_entries;
+        std::map<Index, std::shared_ptr<Flight>> m_flights;
+        std::uint64_t m_newest_txn_id = 0;
+        std::uint64_t m_clock = 0;
+        Stats m_stats;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_PULL_PAGE_CACHE_HPP_INCLUDED
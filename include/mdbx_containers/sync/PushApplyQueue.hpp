@@ -0,0 +1,310 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_PUSH_APPLY_QUEUE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_PUSH_APPLY_QUEUE_HPP_INCLUDED
+
+/// \file PushApplyQueue.hpp
+/// \brief Bounds the pushes a receiver holds in memory while they wait for
+///        the single MDBX writer.
+/// \details
+/// Every \c SyncEngine::handle_push() decodes its batches and then queues on
+/// the writer, so a burst of peers pushing at once keeps all of their
+/// batches in memory. \c PushApplyQueue admits a bounded number of pushes
+/// and bytes; the rest are refused with the retryable \c Busy error code, or,
+/// with spilling on, written as received to the \c _mdbxc_push_staging DBI
+/// and applied from there once the writer is free.
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "CodecBounds.hpp"
+#include "SyncEngine.hpp"
+#include "TransportMessageCodec.hpp"
+#include "protocol.hpp"
+#include "stores/PushStagingStore.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Limits of a \c PushApplyQueue.
+    struct PushApplyQueueOptions {
+        /// \brief Pushes applying or waiting for the writer at once.
+        std::size_t max_pending_pushes = 4;
+        /// \brief Batch bytes of the pending pushes.
+        /// \details A push larger than this is admitted only while nothing
+        /// else is pending, so it is never refused forever.
+        std::uint64_t max_pending_bytes = 64ULL * 1024ULL * 1024ULL;
+        /// \brief Delay suggested to refused senders, see
+        /// \c PushResponse::retry_after_seconds.
+        std::uint64_t retry_after_seconds = 1;
+        /// \brief Stage pushes beyond the limits on disk instead of refusing them.
+        bool spill = false;
+        /// \brief Encoded bytes staged at most; beyond it pushes are refused.
+        std::uint64_t max_spilled_bytes = 1ULL << 30;
+    };
+
+    /// \brief Applies pushes through a \c SyncEngine with bounded memory.
+    /// \details Admitted pushes go straight to \c SyncEngine::handle_push().
+    /// Others get \c ok=false with \c SyncResponseErrorCode::Busy,
+    /// \c error_retryable and \c retry_after_seconds, and should be resent
+    /// after that delay. With \c spill, they are encoded with
+    /// \c TransportMessageCodec and committed to the staging DBI instead, and
+    /// answered \c ok=true with the current applied cursor; the sender keeps
+    /// resending what that cursor does not cover, and the engine skips the
+    /// copies that arrive after the staged ones were applied. While pushes
+    /// are staged, admitted ones are staged behind them to keep arrival
+    /// order, and the admitted caller applies the backlog. Staged pushes
+    /// survive restarts; \ref drain_spilled() applies them.
+    /// A staged push that fails to decode or to apply is dropped and counted.
+    /// The engine is borrowed and must outlive the queue.
+    /// \thread_safety Thread-safe; use one queue per engine.
+    class PushApplyQueue {
+    public:
+        /// \brief Counters since construction and the current occupancy.
+        struct Stats {
+            std::uint64_t applied = 0;        ///< Pushes applied on arrival.
+            std::uint64_t refused = 0;        ///< Pushes answered with \c Busy.
+            std::uint64_t spilled = 0;        ///< Pushes written to the staging DBI.
+            std::uint64_t drained = 0;        ///< Staged pushes applied.
+            std::uint64_t dropped = 0;        ///< Staged pushes that failed to decode or apply.
+            std::size_t pending_pushes = 0;   ///< Pushes holding an admission now.
+            std::uint64_t pending_bytes = 0;  ///< Batch bytes of those pushes.
+            std::uint64_t staged_pushes = 0;  ///< Pushes in the staging DBI now.
+            std::uint64_t staged_bytes = 0;   ///< Encoded bytes in the staging DBI now.
+        };
+
+        /// \brief Binds the queue to \p engine and counts pushes staged by
+        /// an earlier run.
+        /// \param bounds Limits used to decode staged pushes.
+        /// \throws std::invalid_argument if \c max_pending_pushes is zero.
+        explicit PushApplyQueue(SyncEngine& engine,
+                                const PushApplyQueueOptions& options = PushApplyQueueOptions(),
+                                const CodecBounds& bounds = CodecBounds())
+            : m_engine(engine), m_options(options), m_bounds(bounds),
+              m_staging(engine.connection()->env_handle()) {
+            if (m_options.max_pending_pushes == 0) {
+                throw std::invalid_argument("PushApplyQueue: max_pending_pushes must be positive");
+            }
+            auto txn = m_engine.connection()->transaction(TransactionMode::READ_ONLY);
+            if (m_staging.open_existing(txn.handle())) {
+                const PushStagingStore::Totals totals = m_staging.totals(txn.handle());
+                m_stats.staged_pushes = totals.count;
+                m_stats.staged_bytes = totals.bytes;
+                m_last_seq = totals.last_seq;
+            }
+            txn.commit();
+        }
+
+        PushApplyQueue(const PushApplyQueue&) = delete;
+        PushApplyQueue& operator=(const PushApplyQueue&) = delete;
+
+        /// \brief Applies, stages or refuses \p request.
+        /// \details Engine exceptions propagate as from
+        /// \c SyncEngine::handle_push().
+        PushResponse handle_push(const PushRequest& request) {
+            const std::uint64_t bytes = push_bytes(request);
+            bool behind_staged = false;
+            if (admit(bytes, behind_staged)) {
+                const Admission admission(*this, bytes);
+                if (!behind_staged) {
+                    PushResponse out = m_engine.handle_push(request);
+                    // Pushes staged while this one held the writer.
+                    drain_spilled();
+                    return out;
+                }
+                if (!stage(request)) {
+                    return busy();
+                }
+                drain_spilled();
+                return staged();
+            }
+            if (m_options.spill && stage(request)) {
+                return staged();
+            }
+            return busy();
+        }
+
+        /// \brief Applies the pushes staged before the call, oldest first.
+        /// \details Returns at once when another thread is draining.
+        /// \return Number of staged pushes applied.
+        std::size_t drain_spilled() {
+            std::unique_lock<std::mutex> drain(m_drain_mutex, std::try_to_lock);
+            if (!drain.owns_lock()) {
+                return 0;
+            }
+            std::uint64_t end = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_stage_mutex);
+                end = m_last_seq;
+            }
+            std::size_t applied = 0;
+            for (;;) {
+                std::uint64_t seq = 0;
+                std::vector<std::uint8_t> message;
+                {
+                    std::lock_guard<std::mutex> lock(m_stage_mutex);
+                    if (!m_staging.is_open()) {
+                        break;
+                    }
+                    auto txn = m_engine.connection()->transaction(TransactionMode::READ_ONLY);
+                    const bool found = m_staging.front(txn.handle(), seq, message);
+                    txn.commit();
+                    if (!found || seq > end) {
+                        break;
+                    }
+                }
+                PushRequest request;
+                bool decoded = true;
+                try {
+                    request = TransportMessageCodec::decode_push_request(
+                        message, &m_bounds, PullBatchForm::Encoded);
+                } catch (const std::exception&) {
+                    decoded = false;
+                }
+                std::vector<std::uint8_t>().swap(message);
+                const bool ok = decoded && m_engine.handle_push(request).ok;
+                unstage(seq, ok);
+                if (ok) {
+                    ++applied;
+                }
+            }
+            return applied;
+        }
+
+        /// \brief Returns the counters and the current occupancy.
+        Stats stats() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stats;
+        }
+
+        /// \brief Returns the limits the queue was built with.
+        const PushApplyQueueOptions& options() const noexcept { return m_options; }
+
+    private:
+        /// \brief Releases an admission when the push is done.
+        class Admission {
+        public:
+            Admission(PushApplyQueue& queue, std::uint64_t bytes)
+                : m_queue(queue), m_bytes(bytes) {}
+
+            ~Admission() {
+                std::lock_guard<std::mutex> lock(m_queue.m_mutex);
+                --m_queue.m_stats.pending_pushes;
+                m_queue.m_stats.pending_bytes -= m_bytes;
+            }
+
+            Admission(const Admission&) = delete;
+            Admission& operator=(const Admission&) = delete;
+
+        private:
+            PushApplyQueue& m_queue;
+            std::uint64_t m_bytes;
+        };
+
+        /// \brief Approximate memory of the batches of \p request.
+        static std::uint64_t push_bytes(const PushRequest& request) {
+            std::uint64_t bytes = 0;
+            for (std::size_t i = 0; i < request.encoded_batches.size(); ++i) {
+                bytes += request.encoded_batches[i].size();
+            }
+            for (std::size_t i = 0; i < request.batches.size(); ++i) {
+                const std::vector<ChangeOp>& ops = request.batches[i].ops;
+                for (std::size_t j = 0; j < ops.size(); ++j) {
+                    bytes += sizeof(ChangeOp) + ops[j].dbi_name.size() +
+                             ops[j].storage_key.size() + ops[j].value.size() +
+                             ops[j].identity_key.size() + ops[j].revision_key.size();
+                }
+            }
+            return bytes;
+        }
+
+        bool admit(std::uint64_t bytes, bool& behind_staged) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Stats& s = m_stats;
+            if (s.pending_pushes >= m_options.max_pending_pushes ||
+                (s.pending_pushes != 0 && s.pending_bytes + bytes > m_options.max_pending_bytes)) {
+                return false;
+            }
+            ++s.pending_pushes;
+            s.pending_bytes += bytes;
+            behind_staged = s.staged_pushes != 0;
+            if (!behind_staged) {
+                ++s.applied;
+            }
+            return true;
+        }
+
+        /// \brief Commits \p request to the staging DBI.
+        /// \return \c false when the staging budget is exhausted.
+        bool stage(const PushRequest& request) {
+            const std::vector<std::uint8_t> message =
+                TransportMessageCodec::encode_push_request(request, &m_bounds);
+            std::lock_guard<std::mutex> lock(m_stage_mutex);
+            {
+                std::lock_guard<std::mutex> stats_lock(m_mutex);
+                if (m_stats.staged_bytes + message.size() > m_options.max_spilled_bytes) {
+                    return false;
+                }
+            }
+            auto txn = m_engine.connection()->transaction(TransactionMode::WRITABLE);
+            m_staging.open(txn.handle());
+            m_staging.put(txn.handle(), m_last_seq + 1, message);
+            txn.commit();
+            ++m_last_seq;
+            std::lock_guard<std::mutex> stats_lock(m_mutex);
+            ++m_stats.spilled;
+            ++m_stats.staged_pushes;
+            m_stats.staged_bytes += message.size();
+            return true;
+        }
+
+        void unstage(std::uint64_t seq, bool applied) {
+            std::lock_guard<std::mutex> lock(m_stage_mutex);
+            auto txn = m_engine.connection()->transaction(TransactionMode::WRITABLE);
+            const std::uint64_t bytes = m_staging.erase(txn.handle(), seq);
+            txn.commit();
+            std::lock_guard<std::mutex> stats_lock(m_mutex);
+            --m_stats.staged_pushes;
+            m_stats.staged_bytes -= bytes;
+            ++(applied ? m_stats.drained : m_stats.dropped);
+        }
+
+        PushResponse staged() const {
+            PushResponse out;
+            out.receiver_have = m_engine.applied_cursor();
+            return out;
+        }
+
+        PushResponse busy() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_stats.refused;
+            }
+            PushResponse out;
+            out.ok = false;
+            out.error = "receiver apply queue is full";
+            out.error_code = SyncResponseErrorCode::Busy;
+            out.error_retryable = true;
+            out.retry_after_seconds = m_options.retry_after_seconds;
+            out.receiver_have = m_engine.applied_cursor();
+            return out;
+        }
+
+        SyncEngine& m_engine;
+        PushApplyQueueOptions m_options;
+        CodecBounds m_bounds;
+        PushStagingStore m_staging;       ///< Guarded by \c m_stage_mutex.
+        std::uint64_t m_last_seq = 0;     ///< Guarded by \c m_stage_mutex.
+        Stats m_stats;                    ///< Guarded by \c m_mutex.
+        mutable std::mutex m_mutex;
+        std::mutex m_stage_mutex;
+        std::mutex m_drain_mutex;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_PUSH_APPLY_QUEUE_HPP_INCLUDED
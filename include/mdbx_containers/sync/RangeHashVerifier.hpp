@@ -0,0 +1,293 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_RANGE_HASH_VERIFIER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_RANGE_HASH_VERIFIER_HPP_INCLUDED
+
+/// \file RangeHashVerifier.hpp
+/// \brief Anti-entropy check of one table against a peer by range hashes.
+/// \details Both sides must keep range hashes of the table with the same
+/// \c leaf_bits (\c SyncEngine::enable_range_hash()). The verifier compares
+/// the tree roots, descends only into children that differ, compares the
+/// leaves of the differing buckets and, with \c repair, fetches the
+/// records of the divergent key ranges from the peer and applies them
+/// locally through \c SyncEngine::apply_range_page(). Equal replicas cost
+/// two root requests; a few differing records cost about one request per
+/// tree level plus one per range.
+///
+/// Repairs make the local table equal to the peer's in those ranges,
+/// whoever is right, and are not captured, so run it from the replica that
+/// should follow. Writes racing with the check can leave
+/// \c consistent_after_repair false; the next check picks them up.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ISyncPeer.hpp"
+#include "SyncEngine.hpp"
+#include "cancellation.hpp"
+#include "protocol.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Settings of \c RangeHashVerifier.
+    struct RangeHashVerifyOptions {
+        /// \brief Fetch and apply the divergent ranges from the peer.
+        bool repair = true;
+        /// \brief Node or bucket indexes asked for in one request.
+        std::size_t max_indexes_per_request = 4096;
+        /// \brief Soft limits of one page of fetched records.
+        std::uint64_t max_records = 4096;
+        std::uint64_t max_bytes = 4ULL * 1024ULL * 1024ULL;
+    };
+
+    /// \brief Outcome of \c RangeHashVerifier::verify().
+    struct RangeHashVerifyResult {
+        bool ok = true;              ///< \c false when a request failed; see \c error.
+        std::string error;
+        SyncResponseErrorCode error_code = SyncResponseErrorCode::None;
+        bool consistent = false;     ///< The tables matched before any repair.
+        /// \brief The tables matched after the repair; \c consistent when
+        /// nothing was repaired.
+        bool consistent_after_repair = false;
+        std::size_t requests = 0;            ///< Requests sent to either side.
+        std::size_t divergent_buckets = 0;
+        std::size_t divergent_ranges = 0;    ///< Key ranges fetched from the peer.
+        std::uint64_t records_fetched = 0;
+    };
+
+    /// \brief Compares one table of a local engine with a peer.
+    /// \details Not thread-safe; the engine and the peer must outlive it.
+    class RangeHashVerifier {
+    public:
+        RangeHashVerifier(SyncEngine& local,
+                          ISyncPeer& remote,
+                          const RangeHashVerifyOptions& options = RangeHashVerifyOptions())
+            : m_local(local), m_remote(remote), m_options(options) {
+            if (m_options.max_indexes_per_request == 0) {
+                m_options.max_indexes_per_request = 1;
+            }
+        }
+
+        /// \brief Compares \p dbi_name with the peer and, with \c repair,
+        /// makes the local table equal to it.
+        RangeHashVerifyResult verify(const std::string& dbi_name,
+                                     const CancellationToken& cancel_token = CancellationToken()) {
+            RangeHashVerifyResult result;
+            RangeHashRequest request;
+            request.requester = m_local.local_node_id();
+            request.db_id = m_local.db_uuid();
+            request.dbi_name = dbi_name;
+            request.cancel_token = cancel_token;
+
+            std::vector<std::uint32_t> differing(1, 0);
+            if (!compare_nodes(request, 0, differing, result)) {
+                return result;
+            }
+            if (differing.empty()) {
+                result.consistent = true;
+                result.consistent_after_repair = true;
+                return result;
+            }
+            const std::uint8_t buckets = RangeHashStore::bucket_depth();
+            const std::uint32_t fanout = 1u << RangeHashStore::fanout_bits();
+            for (std::uint8_t depth = 1; depth <= buckets; ++depth) {
+                std::vector<std::uint32_t> children;
+                for (std::size_t i = 0; i < differing.size(); ++i) {
+                    for (std::uint32_t j = 0; j < fanout; ++j) {
+                        children.push_back(differing[i] * fanout + j);
+                    }
+                }
+                differing.swap(children);
+                if (!compare_nodes(request, depth, differing, result)) {
+                    return result;
+                }
+            }
+            result.divergent_buckets = differing.size();
+
+            std::vector<RangeHashLeaf> starts;
+            if (!compare_leaves(request, differing, starts, result)) {
+                return result;
+            }
+            if (!m_options.repair) {
+                return result;
+            }
+            const std::vector<RangeHashRange> ranges =
+                m_local.divergent_ranges(dbi_name, starts);
+            result.divergent_ranges = ranges.size();
+            for (std::size_t i = 0; i < ranges.size(); ++i) {
+                if (!repair_range(request, ranges[i], result)) {
+                    return result;
+                }
+            }
+            std::vector<std::uint32_t> root(1, 0);
+            if (!compare_nodes(request, 0, root, result)) {
+                return result;
+            }
+            result.consistent_after_repair = root.empty();
+            return result;
+        }
+
+    private:
+        typedef std::pair<bool, std::vector<std::uint8_t> > LeafKey;
+        typedef std::map<LeafKey, std::pair<std::uint64_t, std::uint64_t> > LeafMap;
+
+        /// \brief Sends \p request to one side and checks the answer.
+        bool ask(bool remote, const RangeHashRequest& request,
+                 RangeHashResponse& out, RangeHashVerifyResult& result) {
+            if (request.cancel_token.is_cancellation_requested()) {
+                return fail(result, "range hash verification cancelled",
+                            SyncResponseErrorCode::None);
+            }
+            ++result.requests;
+            out = remote ? m_remote.range_hash(request) : m_local.handle_range_hash(request);
+            if (!out.ok) {
+                return fail(result, (remote ? "peer: " : "local: ") + out.error, out.error_code);
+            }
+            return true;
+        }
+
+        /// \brief Asks both sides and checks that their settings match.
+        bool ask_both(const RangeHashRequest& request, RangeHashResponse& local,
+                      RangeHashResponse& remote, RangeHashVerifyResult& result) {
+            if (!ask(false, request, local, result) || !ask(true, request, remote, result)) {
+                return false;
+            }
+            if (local.leaf_bits != remote.leaf_bits || local.dbi_flags != remote.dbi_flags) {
+                return fail(result, "table '" + request.dbi_name +
+                                    "' has other range hash settings on the peer",
+                            SyncResponseErrorCode::RangeHashUnavailable);
+            }
+            return true;
+        }
+
+        /// \brief Keeps in \p indexes the nodes at \p depth that differ.
+        bool compare_nodes(RangeHashRequest request, std::uint8_t depth,
+                           std::vector<std::uint32_t>& indexes,
+                           RangeHashVerifyResult& result) {
+            request.query = RangeHashQuery::Nodes;
+            request.depth = depth;
+            std::vector<std::uint32_t> out;
+            for (std::size_t begin = 0; begin < indexes.size();
+                 begin += m_options.max_indexes_per_request) {
+                const std::size_t end =
+                    std::min(indexes.size(), begin + m_options.max_indexes_per_request);
+                request.indexes.assign(indexes.begin() + begin, indexes.begin() + end);
+                RangeHashResponse local;
+                RangeHashResponse remote;
+                if (!ask_both(request, local, remote, result)) {
+                    return false;
+                }
+                if (local.nodes.size() != request.indexes.size() ||
+                    remote.nodes.size() != request.indexes.size()) {
+                    return fail(result, "range hash node count mismatch",
+                                SyncResponseErrorCode::None);
+                }
+                for (std::size_t i = 0; i < request.indexes.size(); ++i) {
+                    if (local.nodes[i].count != remote.nodes[i].count ||
+                        local.nodes[i].hash != remote.nodes[i].hash) {
+                        out.push_back(request.indexes[i]);
+                    }
+                }
+            }
+            indexes.swap(out);
+            return true;
+        }
+
+        /// \brief Collects the leaf starts of \p buckets whose leaves differ.
+        bool compare_leaves(RangeHashRequest request, const std::vector<std::uint32_t>& buckets,
+                            std::vector<RangeHashLeaf>& starts,
+                            RangeHashVerifyResult& result) {
+            request.query = RangeHashQuery::Leaves;
+            LeafMap local;
+            LeafMap remote;
+            for (std::size_t begin = 0; begin < buckets.size();
+                 begin += m_options.max_indexes_per_request) {
+                const std::size_t end =
+                    std::min(buckets.size(), begin + m_options.max_indexes_per_request);
+                request.indexes.assign(buckets.begin() + begin, buckets.begin() + end);
+                RangeHashResponse local_page;
+                RangeHashResponse remote_page;
+                if (!ask_both(request, local_page, remote_page, result)) {
+                    return false;
+                }
+                add_leaves(local_page.leaves, local);
+                add_leaves(remote_page.leaves, remote);
+            }
+            add_divergent(local, remote, starts);
+            add_divergent(remote, local, starts);
+            return true;
+        }
+
+        static void add_leaves(const std::vector<RangeHashLeaf>& leaves, LeafMap& out) {
+            for (std::size_t i = 0; i < leaves.size(); ++i) {
+                out[LeafKey(leaves[i].head, leaves[i].start_key)] =
+                    std::make_pair(leaves[i].count, leaves[i].hash);
+            }
+        }
+
+        /// \brief Adds the starts of \p from that \p other lacks or holds
+        /// with other contents; a start found twice is merged later.
+        static void add_divergent(const LeafMap& from, const LeafMap& other,
+                                  std::vector<RangeHashLeaf>& starts) {
+            for (LeafMap::const_iterator it = from.begin(); it != from.end(); ++it) {
+                const LeafMap::const_iterator match = other.find(it->first);
+                if (match != other.end() && match->second == it->second) {
+                    continue;
+                }
+                RangeHashLeaf leaf;
+                leaf.head = it->first.first;
+                leaf.start_key = it->first.second;
+                starts.push_back(std::move(leaf));
+            }
+        }
+
+        /// \brief Fetches \p range from the peer page by page and applies it.
+        bool repair_range(RangeHashRequest request, const RangeHashRange& range,
+                          RangeHashVerifyResult& result) {
+            request.query = RangeHashQuery::Records;
+            request.from_head = range.from_head;
+            request.lo = range.lo;
+            request.has_hi = range.has_hi;
+            request.hi = range.hi;
+            request.max_records = m_options.max_records;
+            request.max_bytes = m_options.max_bytes;
+            for (;;) {
+                RangeHashResponse page;
+                if (!ask(true, request, page, result)) {
+                    return false;
+                }
+                const PushResponse applied = m_local.apply_range_page(request, page);
+                if (!applied.ok) {
+                    return fail(result, "local: " + applied.error, applied.error_code);
+                }
+                result.records_fetched += page.records.size();
+                if (!page.has_more) {
+                    return true;
+                }
+                request.from_head = false;
+                request.lo.swap(page.resume_key);
+            }
+        }
+
+        static bool fail(RangeHashVerifyResult& result, const std::string& error,
+                         SyncResponseErrorCode code) {
+            result.ok = false;
+            result.error = error;
+            result.error_code = code;
+            return false;
+        }
+
+        SyncEngine& m_local;
+        ISyncPeer& m_remote;
+        RangeHashVerifyOptions m_options;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_RANGE_HASH_VERIFIER_HPP_INCLUDED
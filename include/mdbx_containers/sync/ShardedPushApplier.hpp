@@ -0,0 +1,202 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_SHARDED_PUSH_APPLIER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_SHARDED_PUSH_APPLIER_HPP_INCLUDED
+
+/// \file ShardedPushApplier.hpp
+/// \brief Applies one push to several environments with one writer thread each.
+/// \details
+/// A receiver that spreads replicated data over the environments of a
+/// \c ShardedConnection runs one \c SyncEngine per environment. Applied
+/// cursors require every batch of an origin to reach the same engine in
+/// \c seq order, so batches are routed by origin: a push that carries
+/// several origins, as hub relays do, is split into one request per shard
+/// and the shards commit in parallel.
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "ChangeBatchView.hpp"
+#include "SyncEngine.hpp"
+#include "protocol.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Default shard of \p origin: FNV-1a of its bytes modulo \p shard_count.
+    inline std::size_t sync_origin_shard(const NodeId& origin, std::size_t shard_count) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (std::size_t i = 0; i < origin.size(); ++i) {
+            hash = (hash ^ origin[i]) * 1099511628211ULL;
+        }
+        return static_cast<std::size_t>(hash % shard_count);
+    }
+
+    /// \brief Splits pushes by origin over per-shard \c SyncEngine instances.
+    /// \details Engines are borrowed and must outlive the applier; all of them
+    /// must share the \c db_id pushes name. Shards that receive no batch are
+    /// not written. The response merges every shard: \c receiver_have is the
+    /// union of the applied cursors, the capability flags hold only when every
+    /// shard has them, and the first failing shard, by index, supplies the
+    /// error. A failure on one shard does not undo the commits of the others;
+    /// the sender re-pushes from the merged cursor as after any partial push.
+    /// \thread_safety Thread-safe as far as the engines are.
+    class ShardedPushApplier {
+    public:
+        /// \brief Maps an origin to a shard index below the engine count.
+        typedef std::function<std::size_t(const NodeId&)> OriginRouter;
+
+        /// \brief Routes by \c sync_origin_shard() unless \p router is set.
+        /// \throws std::invalid_argument if \p engines is empty or holds null.
+        explicit ShardedPushApplier(const std::vector<SyncEngine*>& engines,
+                                    OriginRouter router = OriginRouter())
+            : m_engines(engines), m_router(router) {
+            if (m_engines.empty()) {
+                throw std::invalid_argument("ShardedPushApplier: no engines");
+            }
+            for (std::size_t i = 0; i < m_engines.size(); ++i) {
+                if (m_engines[i] == nullptr) {
+                    throw std::invalid_argument("ShardedPushApplier: null engine");
+                }
+            }
+        }
+
+        /// \brief Number of shards.
+        std::size_t shard_count() const noexcept { return m_engines.size(); }
+
+        /// \brief Engine of shard \p index.
+        /// \throws std::out_of_range if \p index is not below \ref shard_count().
+        SyncEngine& shard(std::size_t index) const { return *m_engines.at(index); }
+
+        /// \brief Shard that applies the batches of \p origin.
+        /// \throws std::out_of_range when the router returns an invalid index.
+        std::size_t shard_of(const NodeId& origin) const {
+            const std::size_t index = m_router
+                ? m_router(origin)
+                : sync_origin_shard(origin, m_engines.size());
+            if (index >= m_engines.size()) {
+                throw std::out_of_range("ShardedPushApplier: router returned an invalid shard");
+            }
+            return index;
+        }
+
+        /// \brief Splits \p request into one request per shard, keeping the
+        /// order of batches and of encoded batches.
+        /// \details An encoded batch whose header cannot be read goes to shard
+        /// 0, whose engine then reports it.
+        std::vector<PushRequest> plan(const PushRequest& request) const {
+            std::vector<PushRequest> out(m_engines.size());
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                out[i].sender = request.sender;
+                out[i].db_id = request.db_id;
+                out[i].cancel_token = request.cancel_token;
+            }
+            for (std::size_t i = 0; i < request.batches.size(); ++i) {
+                out[shard_of(request.batches[i].origin_node_id)].batches.push_back(
+                    request.batches[i]);
+            }
+            for (std::size_t i = 0; i < request.encoded_batches.size(); ++i) {
+                NodeId origin{};
+                bool header_read = false;
+                try {
+                    origin = ChangeBatchView(request.encoded_batches[i]).origin_node_id();
+                    header_read = true;
+                } catch (const std::exception&) {
+                }
+                out[header_read ? shard_of(origin) : 0].encoded_batches.push_back(
+                    request.encoded_batches[i]);
+            }
+            return out;
+        }
+
+        /// \brief Applies \p request, running each shard's part on its own
+        /// thread when more than one shard is involved.
+        /// \details The first involved shard runs on the calling thread.
+        /// Engine exceptions are rethrown after every shard finished, the
+        /// lowest failing shard's first.
+        PushResponse handle_push(const PushRequest& request) const {
+            const std::vector<PushRequest> parts = plan(request);
+            std::vector<PushResponse> responses(parts.size());
+            std::vector<std::size_t> involved;
+            for (std::size_t i = 0; i < parts.size(); ++i) {
+                if (!parts[i].batches.empty() || !parts[i].encoded_batches.empty()) {
+                    involved.push_back(i);
+                }
+            }
+
+            std::vector<std::future<void>> futures;
+            futures.reserve(involved.empty() ? 0 : involved.size() - 1);
+            for (std::size_t k = 1; k < involved.size(); ++k) {
+                const std::size_t i = involved[k];
+                futures.push_back(std::async(std::launch::async, [this, &parts, &responses, i]() {
+                    responses[i] = m_engines[i]->handle_push(parts[i]);
+                }));
+            }
+            std::exception_ptr error;
+            if (!involved.empty()) {
+                try {
+                    responses[involved[0]] = m_engines[involved[0]]->handle_push(parts[involved[0]]);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            for (std::size_t k = 0; k < futures.size(); ++k) {
+                try {
+                    futures[k].get();
+                } catch (...) {
+                    if (!error) error = std::current_exception();
+                }
+            }
+            if (error) std::rethrow_exception(error);
+
+            PushResponse merged;
+            for (std::size_t i = 0; i < responses.size(); ++i) {
+                const bool ran = parts[i].batches.size() + parts[i].encoded_batches.size() != 0;
+                const PushResponse& part = responses[i];
+                merge_cursor(merged.receiver_have,
+                             ran ? part.receiver_have : m_engines[i]->applied_cursor());
+                if (!ran) continue;
+                merged.accept_compressed_batches =
+                    merged.accept_compressed_batches && part.accept_compressed_batches;
+                merged.accept_compressed_messages =
+                    merged.accept_compressed_messages && part.accept_compressed_messages;
+                if (merged.ok && !part.ok) {
+                    merged.ok = false;
+                    merged.error = part.error;
+                    merged.error_code = part.error_code;
+                    merged.error_retryable = part.error_retryable;
+                }
+            }
+            return merged;
+        }
+
+        /// \brief Union of the applied cursors of every shard.
+        SyncCursor applied_cursor() const {
+            SyncCursor out;
+            for (std::size_t i = 0; i < m_engines.size(); ++i) {
+                merge_cursor(out, m_engines[i]->applied_cursor());
+            }
+            return out;
+        }
+
+    private:
+        static void merge_cursor(SyncCursor& into, const SyncCursor& from) {
+            OriginSeqMap::const_iterator it = from.last_seq_by_origin.begin();
+            for (; it != from.last_seq_by_origin.end(); ++it) {
+                std::uint64_t& seq = into.last_seq_by_origin[it->first];
+                if (seq < it->second) seq = it->second;
+            }
+        }
+
+        std::vector<SyncEngine*> m_engines;
+        OriginRouter m_router;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_SHARDED_PUSH_APPLIER_HPP_INCLUDED
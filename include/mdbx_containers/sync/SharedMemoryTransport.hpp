@@ -0,0 +1,710 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_SHARED_MEMORY_TRANSPORT_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_SHARED_MEMORY_TRANSPORT_HPP_INCLUDED
+
+/// \file SharedMemoryTransport.hpp
+/// \brief Sync transport between processes on one host over a shared mapping.
+/// \details
+/// A \c SharedMemorySyncServer creates a region file, best placed on a
+/// memory-backed file system such as \c /dev/shm, and maps it shared. The
+/// region holds two single-producer byte rings, one per direction. Messages
+/// are the \c TransportMessageCodec messages of the WebSocket seam, tagged
+/// with \c websocket_sync_tag_message() ids and framed by a u32 le length:
+/// a sender encodes straight into the ring and the receiver copies each
+/// message out once, with no socket or kernel buffer in between. Blocked
+/// sides sleep on futexes on Linux and poll briefly elsewhere. Not available
+/// on Windows.
+///
+/// A region serves one client process at a time. A client attaches before
+/// its first exchange, which resets both rings, so a restarted reader picks
+/// up a clean session. A side that stalls inside a message for longer than
+/// \c SharedMemorySyncOptions::exchange_timeout breaks the session; the
+/// client reattaches on its next exchange.
+
+#if !defined(_WIN32)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+#include "ISyncPeer.hpp"
+#include "SyncEngine.hpp"
+#include "TransportMessageCodec.hpp"
+#include "WebSocketTransport.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Sizing and timing of a shared-memory sync region.
+    struct SharedMemorySyncOptions {
+        /// \brief Capacity of each ring; larger messages stream through.
+        /// \details Rounded up to a multiple of 64 bytes, at least 4 KiB.
+        std::size_t ring_bytes = 1024 * 1024;
+        /// \brief Longest wait for an attach, a response, or ring space.
+        std::chrono::milliseconds exchange_timeout = std::chrono::milliseconds(30000);
+    };
+
+    namespace detail {
+
+        static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+                      "shared-memory sync transport needs lock-free atomics");
+
+        /// \brief Control words of one ring; producer and consumer fields sit
+        /// on separate cache lines.
+        struct SharedMemoryRingHeader {
+            alignas(64) std::atomic<std::uint64_t> write_pos;
+            std::atomic<std::uint32_t> data_event;
+            std::atomic<std::uint32_t> data_waiters;
+            alignas(64) std::atomic<std::uint64_t> read_pos;
+            std::atomic<std::uint32_t> space_event;
+            std::atomic<std::uint32_t> space_waiters;
+        };
+
+        /// \brief Start of a region file, followed by the request and
+        /// response ring headers and then their data.
+        struct SharedMemoryRegionHeader {
+            std::uint8_t magic[8];
+            std::uint32_t version;
+            std::uint32_t ring_bytes;
+            std::atomic<std::uint32_t> state;          ///< 0 building, 1 serving, 2 closed.
+            std::atomic<std::uint32_t> attach_request; ///< Session id asked for by the client.
+            std::atomic<std::uint32_t> attached;       ///< Session id the server runs.
+            std::atomic<std::uint32_t> attached_waiters;
+        };
+
+        static_assert(sizeof(SharedMemoryRegionHeader) <= 64,
+                      "region header must fit before the ring headers");
+
+        inline const std::uint8_t* shared_memory_sync_magic() {
+            static const std::uint8_t magic[8] = {
+                'M', 'D', 'B', 'X', 'C', 'S', 'H', 'M'
+            };
+            return magic;
+        }
+
+        inline std::size_t shared_memory_sync_header_bytes() {
+            return 64 + 2 * sizeof(SharedMemoryRingHeader);
+        }
+
+        /// \brief Sleeps while \p word holds \p expected, at most \p timeout.
+        inline void shared_memory_wait(std::atomic<std::uint32_t>& word,
+                                       std::uint32_t expected,
+                                       std::chrono::microseconds timeout) {
+#if defined(__linux__)
+            struct timespec ts;
+            ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+            ts.tv_nsec = static_cast<long>((timeout.count() % 1000000) * 1000);
+            ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                      FUTEX_WAIT, expected, &ts, nullptr, 0);
+#else
+            if (word.load() == expected) {
+                std::this_thread::sleep_for(
+                    std::min(timeout, std::chrono::microseconds(100)));
+            }
+#endif
+        }
+
+        /// \brief Wakes the sleepers on \p word, if any, after it changed.
+        inline void shared_memory_wake(std::atomic<std::uint32_t>& word,
+                                       std::atomic<std::uint32_t>& waiters) {
+#if defined(__linux__)
+            if (waiters.load() != 0) {
+                ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                          FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+            }
+#else
+            (void)word;
+            (void)waiters;
+#endif
+        }
+
+        /// \brief Bumps the event counter \p word and wakes its sleepers.
+        inline void shared_memory_signal(std::atomic<std::uint32_t>& word,
+                                         std::atomic<std::uint32_t>& waiters) {
+            word.fetch_add(1);
+            shared_memory_wake(word, waiters);
+        }
+
+        /// \brief Why a shared-memory wait stopped early.
+        enum class SharedMemoryWaitResult { Ready, TimedOut, Cancelled, Closed };
+
+        /// \brief Waits until \p ready() holds, spinning briefly before it
+        /// sleeps on \p word.
+        /// \param stop Returns \c true to abandon the wait as cancelled.
+        template<class Ready, class Stop>
+        SharedMemoryWaitResult shared_memory_wait_for(
+                std::atomic<std::uint32_t>& word,
+                std::atomic<std::uint32_t>& waiters,
+                const SharedMemoryRegionHeader& region,
+                std::chrono::steady_clock::time_point deadline,
+                Ready ready,
+                Stop stop) {
+            for (int spin = 0; spin < 128; ++spin) {
+                if (ready()) return SharedMemoryWaitResult::Ready;
+            }
+            for (;;) {
+                waiters.fetch_add(1);
+                const std::uint32_t seen = word.load();
+                const bool done = ready();
+                if (!done && region.state.load() == 1 && !stop()) {
+                    const std::chrono::steady_clock::time_point now =
+                        std::chrono::steady_clock::now();
+                    if (now < deadline) {
+                        // Short slices keep cancellation and close responsive.
+                        const std::chrono::microseconds slice =
+                            std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::min<std::chrono::steady_clock::duration>(
+                                    deadline - now, std::chrono::milliseconds(10)));
+                        shared_memory_wait(word, seen, slice);
+                    }
+                }
+                waiters.fetch_sub(1);
+                if (done || ready()) return SharedMemoryWaitResult::Ready;
+                if (region.state.load() != 1) return SharedMemoryWaitResult::Closed;
+                if (stop()) return SharedMemoryWaitResult::Cancelled;
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    return SharedMemoryWaitResult::TimedOut;
+                }
+            }
+        }
+
+        /// \brief One direction of a region: a byte ring with one writer and
+        /// one reader process.
+        class SharedMemorySyncRing {
+        public:
+            SharedMemorySyncRing() : m_header(nullptr), m_data(nullptr), m_capacity(0) {}
+
+            SharedMemorySyncRing(SharedMemoryRingHeader* header,
+                                 std::uint8_t* data,
+                                 std::size_t capacity)
+                : m_header(header), m_data(data), m_capacity(capacity) {}
+
+            /// \brief Bytes written and not yet read.
+            std::size_t readable() const {
+                return static_cast<std::size_t>(
+                    m_header->write_pos.load(std::memory_order_acquire) -
+                    m_header->read_pos.load(std::memory_order_relaxed));
+            }
+
+            /// \brief Waits until a byte can be read.
+            template<class Stop>
+            SharedMemoryWaitResult wait_readable(
+                    const SharedMemoryRegionHeader& region,
+                    std::chrono::steady_clock::time_point deadline,
+                    Stop stop) const {
+                const SharedMemorySyncRing* self = this;
+                return shared_memory_wait_for(
+                    m_header->data_event, m_header->data_waiters, region, deadline,
+                    [self]() { return self->readable() != 0; }, stop);
+            }
+
+            /// \brief Copies \p size bytes into the ring as space frees up.
+            /// \return \c false when \p deadline passed or the region closed
+            /// before all bytes were written.
+            bool write(const SharedMemoryRegionHeader& region,
+                       const std::uint8_t* bytes,
+                       std::size_t size,
+                       std::chrono::steady_clock::time_point deadline) {
+                SharedMemoryRingHeader* header = m_header;
+                const std::size_t capacity = m_capacity;
+                while (size != 0) {
+                    const std::uint64_t write_pos =
+                        header->write_pos.load(std::memory_order_relaxed);
+                    std::size_t free_bytes = 0;
+                    const SharedMemoryWaitResult result = shared_memory_wait_for(
+                        header->space_event, header->space_waiters, region, deadline,
+                        [header, capacity, write_pos, &free_bytes]() {
+                            free_bytes = capacity - static_cast<std::size_t>(
+                                write_pos - header->read_pos.load(std::memory_order_acquire));
+                            return free_bytes != 0;
+                        },
+                        []() { return false; });
+                    if (result != SharedMemoryWaitResult::Ready) return false;
+                    const std::size_t offset = static_cast<std::size_t>(write_pos % capacity);
+                    std::size_t n = std::min(size, free_bytes);
+                    n = std::min(n, capacity - offset);
+                    std::memcpy(m_data + offset, bytes, n);
+                    header->write_pos.store(write_pos + n, std::memory_order_release);
+                    shared_memory_signal(header->data_event, header->data_waiters);
+                    bytes += n;
+                    size -= n;
+                }
+                return true;
+            }
+
+            /// \brief Copies \p size bytes out of the ring as they arrive.
+            /// \return \c false when \p deadline passed or the region closed
+            /// before all bytes were read.
+            bool read(const SharedMemoryRegionHeader& region,
+                      std::uint8_t* out,
+                      std::size_t size,
+                      std::chrono::steady_clock::time_point deadline) {
+                SharedMemoryRingHeader* header = m_header;
+                const std::size_t capacity = m_capacity;
+                while (size != 0) {
+                    if (wait_readable(region, deadline, []() { return false; }) !=
+                        SharedMemoryWaitResult::Ready) {
+                        return false;
+                    }
+                    const std::uint64_t read_pos =
+                        header->read_pos.load(std::memory_order_relaxed);
+                    const std::size_t offset = static_cast<std::size_t>(read_pos % capacity);
+                    std::size_t n = std::min(size, readable());
+                    n = std::min(n, capacity - offset);
+                    std::memcpy(out, m_data + offset, n);
+                    header->read_pos.store(read_pos + n, std::memory_order_release);
+                    shared_memory_signal(header->space_event, header->space_waiters);
+                    out += n;
+                    size -= n;
+                }
+                return true;
+            }
+
+            /// \brief Drops unread bytes; only the reader may call it.
+            void discard() {
+                m_header->read_pos.store(m_header->write_pos.load(std::memory_order_acquire),
+                                         std::memory_order_release);
+                shared_memory_signal(m_header->space_event, m_header->space_waiters);
+            }
+
+            /// \brief Wakes the reader without writing, e.g. for an attach.
+            void wake_reader() {
+                shared_memory_signal(m_header->data_event, m_header->data_waiters);
+            }
+
+            /// \brief Wakes sleepers on both ends, e.g. when the region closes.
+            void wake_all() {
+                shared_memory_signal(m_header->data_event, m_header->data_waiters);
+                shared_memory_signal(m_header->space_event, m_header->space_waiters);
+            }
+
+        private:
+            SharedMemoryRingHeader* m_header;
+            std::uint8_t* m_data;
+            std::size_t m_capacity;
+        };
+
+        /// \brief \c MAP_SHARED mapping of a region file and its two rings.
+        class SharedMemorySyncMapping {
+        public:
+            SharedMemorySyncMapping() : m_base(nullptr), m_size(0) {}
+
+            ~SharedMemorySyncMapping() { reset(); }
+
+            SharedMemorySyncMapping(const SharedMemorySyncMapping&) = delete;
+            SharedMemorySyncMapping& operator=(const SharedMemorySyncMapping&) = delete;
+
+            /// \brief Replaces any file at \p path with a new, initialized region.
+            void create(const std::string& path, std::size_t ring_bytes) {
+                reset();
+                if (ring_bytes < 4096) ring_bytes = 4096;
+                ring_bytes = (ring_bytes + 63) & ~static_cast<std::size_t>(63);
+                if (ring_bytes > 0xFFFFFFFFu) {
+                    throw std::invalid_argument("shared-memory sync ring_bytes is too large");
+                }
+                // A new inode keeps clients of an old region off the new one.
+                ::unlink(path.c_str());
+                const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+                if (fd < 0) {
+                    throw std::runtime_error("Failed to create shared-memory sync region: " + path);
+                }
+                const std::size_t size = shared_memory_sync_header_bytes() + 2 * ring_bytes;
+                if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                    ::close(fd);
+                    ::unlink(path.c_str());
+                    throw std::runtime_error("Failed to size shared-memory sync region: " + path);
+                }
+                map(fd, size, path);
+                SharedMemoryRegionHeader* region = new (m_base) SharedMemoryRegionHeader();
+                new (request_header()) SharedMemoryRingHeader();
+                new (response_header()) SharedMemoryRingHeader();
+                std::memcpy(region->magic, shared_memory_sync_magic(), 8);
+                region->version = 1;
+                region->ring_bytes = static_cast<std::uint32_t>(ring_bytes);
+                bind_rings(ring_bytes);
+                region->state.store(1);
+            }
+
+            /// \brief Maps the region a server created at \p path.
+            void open(const std::string& path) {
+                reset();
+                const int fd = ::open(path.c_str(), O_RDWR);
+                if (fd < 0) {
+                    throw std::runtime_error("Failed to open shared-memory sync region: " + path);
+                }
+                struct stat st;
+                if (::fstat(fd, &st) != 0 ||
+                    static_cast<std::size_t>(st.st_size) < shared_memory_sync_header_bytes()) {
+                    ::close(fd);
+                    throw std::runtime_error("Shared-memory sync region is truncated: " + path);
+                }
+                map(fd, static_cast<std::size_t>(st.st_size), path);
+                const SharedMemoryRegionHeader& header = region();
+                if (header.state.load() != 1 ||
+                    std::memcmp(header.magic, shared_memory_sync_magic(), 8) != 0 ||
+                    header.version != 1 ||
+                    shared_memory_sync_header_bytes() + 2 * std::size_t(header.ring_bytes) != m_size) {
+                    reset();
+                    throw std::runtime_error("Shared-memory sync region is not being served: " + path);
+                }
+                bind_rings(header.ring_bytes);
+            }
+
+            void reset() {
+                if (m_base == nullptr) return;
+                ::munmap(m_base, m_size);
+                m_base = nullptr;
+                m_size = 0;
+            }
+
+            bool is_open() const { return m_base != nullptr; }
+
+            SharedMemoryRegionHeader& region() const {
+                return *static_cast<SharedMemoryRegionHeader*>(m_base);
+            }
+
+            /// \brief Client-to-server ring.
+            SharedMemorySyncRing& requests() { return m_requests; }
+            /// \brief Server-to-client ring.
+            SharedMemorySyncRing& responses() { return m_responses; }
+
+        private:
+            void map(int fd, std::size_t size, const std::string& path) {
+                void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (base == MAP_FAILED) {
+                    throw std::runtime_error("Failed to map shared-memory sync region: " + path);
+                }
+                m_base = base;
+                m_size = size;
+            }
+
+            SharedMemoryRingHeader* request_header() const {
+                return reinterpret_cast<SharedMemoryRingHeader*>(
+                    static_cast<std::uint8_t*>(m_base) + 64);
+            }
+
+            SharedMemoryRingHeader* response_header() const {
+                return request_header() + 1;
+            }
+
+            void bind_rings(std::size_t ring_bytes) {
+                std::uint8_t* data =
+                    static_cast<std::uint8_t*>(m_base) + shared_memory_sync_header_bytes();
+                m_requests = SharedMemorySyncRing(request_header(), data, ring_bytes);
+                m_responses = SharedMemorySyncRing(response_header(), data + ring_bytes, ring_bytes);
+            }
+
+            void* m_base;
+            std::size_t m_size;
+            SharedMemorySyncRing m_requests;
+            SharedMemorySyncRing m_responses;
+        };
+
+    } // namespace detail
+
+    /// \brief \c IWebSocketSyncChannel over a shared-memory region.
+    /// \details Opens and attaches to the region lazily, and again after a
+    /// broken session. Exchanges on one channel must not overlap. A response
+    /// that arrives after its exchange was cancelled is dropped by its tag.
+    class SharedMemorySyncChannel : public IWebSocketSyncChannel {
+    public:
+        explicit SharedMemorySyncChannel(
+                const std::string& path,
+                const SharedMemorySyncOptions& options = SharedMemorySyncOptions(),
+                const CodecBounds& bounds = CodecBounds())
+            : m_path(path),
+              m_options(options),
+              m_bounds(bounds),
+              m_next_id(0),
+              m_cancel_generation(0) {}
+
+        std::vector<std::uint8_t> exchange_binary(
+                const std::vector<std::uint8_t>& binary_message,
+                const CancellationToken& cancel_token) override {
+            const std::uint32_t generation = m_cancel_generation.load();
+            auto stop = [this, generation, &cancel_token]() {
+                return cancel_token.is_cancellation_requested() ||
+                       m_cancel_generation.load() != generation;
+            };
+            if (!m_mapping.is_open()) {
+                attach(stop);
+            }
+            const std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() + m_options.exchange_timeout;
+            const std::uint64_t id = ++m_next_id;
+            std::uint8_t head[4 + 16];
+            detail::write_u32_le(static_cast<std::uint32_t>(16 + binary_message.size()), head);
+            websocket_sync_write_tag(id, head + 4);
+            detail::SharedMemoryRegionHeader& region = m_mapping.region();
+            if (!m_mapping.requests().write(region, head, sizeof(head), deadline) ||
+                !m_mapping.requests().write(region,
+                                            binary_message.empty() ? nullptr : &binary_message[0],
+                                            binary_message.size(), deadline)) {
+                fail("request timed out");
+            }
+
+            std::vector<std::uint8_t> response;
+            for (;;) {
+                switch (m_mapping.responses().wait_readable(region, deadline, stop)) {
+                case detail::SharedMemoryWaitResult::Ready:
+                    break;
+                case detail::SharedMemoryWaitResult::Cancelled:
+                    throw std::runtime_error("Shared-memory sync exchange cancelled");
+                case detail::SharedMemoryWaitResult::Closed:
+                    fail("server closed the region");
+                case detail::SharedMemoryWaitResult::TimedOut:
+                    fail("response timed out");
+                }
+                // Started frames are read whole so the session stays framed.
+                if (!m_mapping.responses().read(region, head, sizeof(head), deadline)) {
+                    fail("response timed out");
+                }
+                const std::size_t size = detail::read_u32_le(head);
+                if (size < 16 || size - 16 > m_bounds.max_transport_message_bytes ||
+                    std::memcmp(head + 4, websocket_sync_tag_magic(), 8) != 0) {
+                    fail("malformed response frame");
+                }
+                response.resize(size - 16);
+                if (!m_mapping.responses().read(region,
+                                                response.empty() ? nullptr : &response[0],
+                                                response.size(), deadline)) {
+                    fail("response timed out");
+                }
+                if (detail::read_u64_le(head + 12) == id) {
+                    return response;
+                }
+            }
+        }
+
+        void request_cancel() override {
+            m_cancel_generation.fetch_add(1);
+        }
+
+    private:
+        template<class Stop>
+        void attach(Stop stop) {
+            m_mapping.open(m_path);
+            detail::SharedMemoryRegionHeader& region = m_mapping.region();
+            const std::uint32_t session = region.attach_request.fetch_add(1) + 1;
+            m_mapping.requests().wake_reader();
+            const std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() + m_options.exchange_timeout;
+            const detail::SharedMemoryWaitResult result = detail::shared_memory_wait_for(
+                region.attached, region.attached_waiters, region, deadline,
+                [&region, session]() { return region.attached.load() == session; },
+                stop);
+            if (result != detail::SharedMemoryWaitResult::Ready) {
+                m_mapping.reset();
+                throw std::runtime_error("Shared-memory sync attach failed: " + m_path);
+            }
+            m_mapping.responses().discard();
+        }
+
+        [[noreturn]] void fail(const char* reason) {
+            m_mapping.reset();
+            throw std::runtime_error(std::string("Shared-memory sync ") + reason +
+                                     ": " + m_path);
+        }
+
+        std::string m_path;
+        SharedMemorySyncOptions m_options;
+        CodecBounds m_bounds;
+        detail::SharedMemorySyncMapping m_mapping;
+        std::uint64_t m_next_id;
+        std::atomic<std::uint32_t> m_cancel_generation;
+    };
+
+    /// \brief \c ISyncPeer for a \c SharedMemorySyncServer on the same host.
+    /// \details A \c WebSocketSyncPeer over a \c SharedMemorySyncChannel, so
+    /// cursor deltas and message compression work as over WebSocket.
+    class SharedMemorySyncPeer : public ISyncPeer {
+    public:
+        explicit SharedMemorySyncPeer(
+                const std::string& path,
+                const SharedMemorySyncOptions& options = SharedMemorySyncOptions(),
+                const CodecBounds& bounds = CodecBounds())
+            : m_channel(path, options, bounds), m_peer(m_channel, bounds) {}
+
+        PullResponse pull(const PullRequest& request) override {
+            return m_peer.pull(request);
+        }
+
+        PushResponse push(const PushRequest& request) override {
+            return m_peer.push(request);
+        }
+
+        void request_cancel() override {
+            m_peer.request_cancel();
+        }
+
+        /// \brief See \c WebSocketSyncPeer::set_compression().
+        void set_compression(const TransportCompression& compression) {
+            m_peer.set_compression(compression);
+        }
+
+    private:
+        SharedMemorySyncChannel m_channel;
+        WebSocketSyncPeer m_peer;
+    };
+
+    /// \brief Owns a shared-memory region and answers its client's requests
+    /// from a \c SyncEngine.
+    /// \details Call \ref serve_one() or \ref serve() from one thread. The
+    /// region file is replaced on construction and removed on destruction.
+    class SharedMemorySyncServer {
+    public:
+        SharedMemorySyncServer(SyncEngine& engine,
+                               const std::string& path,
+                               const SharedMemorySyncOptions& options = SharedMemorySyncOptions(),
+                               const CodecBounds& bounds = CodecBounds())
+            : m_server(engine, bounds),
+              m_path(path),
+              m_options(options),
+              m_bounds(bounds),
+              m_desynced(false) {
+            m_mapping.create(path, options.ring_bytes);
+        }
+
+        ~SharedMemorySyncServer() {
+            detail::SharedMemoryRegionHeader& region = m_mapping.region();
+            region.state.store(2);
+            m_mapping.requests().wake_all();
+            m_mapping.responses().wake_all();
+            detail::shared_memory_wake(region.attached, region.attached_waiters);
+            ::unlink(m_path.c_str());
+        }
+
+        SharedMemorySyncServer(const SharedMemorySyncServer&) = delete;
+        SharedMemorySyncServer& operator=(const SharedMemorySyncServer&) = delete;
+
+        /// \brief Sets when pull responses are sent compressed.
+        void set_compression(const TransportCompression& compression) {
+            m_server.set_compression(compression);
+        }
+
+        /// \brief Answers at most one request, waiting up to \p wait for it.
+        /// \return \c false when no request arrived.
+        /// \throws std::runtime_error when the client stalls inside a message
+        /// or sends a malformed one; the session then waits for a reattach.
+        bool serve_one(std::chrono::milliseconds wait) {
+            detail::SharedMemoryRegionHeader& region = m_mapping.region();
+            detail::SharedMemorySyncRing& requests = m_mapping.requests();
+            accept_attach();
+            const detail::SharedMemoryWaitResult result = requests.wait_readable(
+                region, std::chrono::steady_clock::now() + wait,
+                [&region]() { return region.attach_request.load() != region.attached.load(); });
+            if (result != detail::SharedMemoryWaitResult::Ready ||
+                region.attach_request.load() != region.attached.load()) {
+                return false;
+            }
+            if (m_desynced) {
+                // Leftovers of a broken session until the client reattaches.
+                requests.discard();
+                return false;
+            }
+
+            const std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() + m_options.exchange_timeout;
+            std::uint8_t head[4 + 16];
+            if (!requests.read(region, head, sizeof(head), deadline)) {
+                desync("request timed out");
+            }
+            const std::size_t size = detail::read_u32_le(head);
+            if (size < 16 || size - 16 > m_bounds.max_transport_message_bytes ||
+                std::memcmp(head + 4, websocket_sync_tag_magic(), 8) != 0) {
+                desync("malformed request frame");
+            }
+            std::vector<std::uint8_t> request(size - 16);
+            if (!requests.read(region, request.empty() ? nullptr : &request[0],
+                               request.size(), deadline)) {
+                desync("request timed out");
+            }
+
+            ChunkedTransportMessage response;
+            try {
+                response = m_server.handle_binary_message_chunked(request);
+            } catch (const std::exception&) {
+                // The empty response fails the client's decode at once.
+                response = ChunkedTransportMessage();
+            }
+            if (response.size() > 0xFFFFFFFFu - 16) {
+                desync("response too large");
+            }
+            detail::write_u32_le(static_cast<std::uint32_t>(16 + response.size()), head);
+            detail::SharedMemorySyncRing& responses = m_mapping.responses();
+            bool ok = responses.write(region, head, sizeof(head), deadline);
+            response.write_to([&ok, &responses, &region, &deadline](const std::uint8_t* bytes, std::size_t n) {
+                ok = ok && responses.write(region, bytes, n, deadline);
+            });
+            if (!ok) {
+                desync("response timed out");
+            }
+            return true;
+        }
+
+        /// \brief Serves requests until \p stop is cancelled.
+        /// \details Broken sessions are dropped silently until the client
+        /// reattaches.
+        void serve(const CancellationToken& stop) {
+            while (!stop.is_cancellation_requested()) {
+                try {
+                    serve_one(std::chrono::milliseconds(100));
+                } catch (const std::runtime_error&) {
+                }
+            }
+        }
+
+    private:
+        void accept_attach() {
+            detail::SharedMemoryRegionHeader& region = m_mapping.region();
+            const std::uint32_t session = region.attach_request.load();
+            if (session == region.attached.load()) {
+                return;
+            }
+            m_mapping.requests().discard();
+            m_desynced = false;
+            region.attached.store(session);
+            detail::shared_memory_wake(region.attached, region.attached_waiters);
+        }
+
+        [[noreturn]] void desync(const char* reason) {
+            m_desynced = true;
+            throw std::runtime_error(std::string("Shared-memory sync ") + reason +
+                                     ": " + m_path);
+        }
+
+        WebSocketSyncServer m_server;
+        std::string m_path;
+        SharedMemorySyncOptions m_options;
+        CodecBounds m_bounds;
+        detail::SharedMemorySyncMapping m_mapping;
+        bool m_desynced;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // !defined(_WIN32)
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_SHARED_MEMORY_TRANSPORT_HPP_INCLUDED
@@ -0,0 +1,168 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_SNAPSHOT_EXPORT_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_SNAPSHOT_EXPORT_HPP_INCLUDED
+
+/// \file SnapshotExport.hpp
+/// \brief Read snapshot pinned for the pages of one full snapshot export.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <mdbx.h>
+
+#include "../common.hpp"
+#include "../detail/ThreadPool.hpp"
+#include "../detail/utils.hpp"
+#include "common.hpp"
+#include "SyncCursor.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief One full snapshot export served page by page from one MVCC view.
+    /// \details MDBX read transactions belong to the thread that began them,
+    /// while the pages of an export arrive on arbitrary transport threads.
+    /// The session keeps its transaction on a thread of its own and runs
+    /// each page there through \ref run(), so every page reads the same
+    /// snapshot. Like any long reader it keeps the pages of that snapshot
+    /// from being reused until \ref end_txn() or destruction.
+    /// \thread_safety Thread-safe; \ref run() calls are serialized.
+    class SnapshotExportSession {
+    public:
+        /// \brief User table exported by the session.
+        struct Table {
+            std::string name;        ///< DBI name.
+            std::uint32_t flags = 0; ///< Persistent MDBX DBI flags.
+            MDBX_dbi dbi = 0;        ///< Handle opened in the session transaction.
+        };
+
+        /// \brief Export position kept between pages.
+        /// \details Only touched by \ref run() tasks.
+        struct State {
+            NodeId source{};              ///< Node whose data is exported.
+            SyncCursor snapshot_cursor;   ///< Batches the snapshot reflects.
+            std::vector<Table> tables;    ///< In DBI name order.
+            bool manifest_sent = false;   ///< Whether the \c ClearTable ops went out.
+            std::size_t table_index = 0;  ///< Table being read.
+            MDBX_cursor* reader = nullptr;
+            bool positioned = false;      ///< \c reader is at an entry not sent yet.
+            bool finished = false;        ///< No page follows the last one built.
+            std::uint64_t next_page = 0;  ///< Page the next token names.
+            std::vector<std::uint8_t> last_chunk; ///< Page \c next_page-1, for retries.
+        };
+
+        /// \brief Begins the read transaction on the session thread.
+        /// \throws MdbxException if the transaction cannot be started.
+        SnapshotExportSession(MDBX_env* env, const NodeId& id)
+            : m_id(id)
+            , m_last_used(now_ticks())
+            , m_thread(new mdbxc::detail::ThreadPool(1)) {
+            run_on_thread([this, env]() {
+                check_mdbx(mdbx_txn_begin(env, nullptr, MDBX_TXN_RDONLY, &m_txn),
+                           "SnapshotExportSession: failed to begin read txn");
+            });
+        }
+
+        /// \brief Ends the transaction and stops the session thread.
+        ~SnapshotExportSession() {
+            try {
+                end_txn();
+            } catch (...) {
+            }
+            m_thread.reset();
+        }
+
+        SnapshotExportSession(const SnapshotExportSession&) = delete;
+        SnapshotExportSession& operator=(const SnapshotExportSession&) = delete;
+
+        /// \brief Random id carried by the session's tokens.
+        const NodeId& id() const noexcept { return m_id; }
+
+        /// \brief Runs \p task with the snapshot transaction on the session thread.
+        /// \details The transaction is null after \ref end_txn(). Rethrows
+        /// what \p task throws.
+        void run(const std::function<void(MDBX_txn*, State&)>& task) {
+            std::lock_guard<std::mutex> lk(m_run_mutex);
+            m_last_used.store(now_ticks(), std::memory_order_relaxed);
+            run_on_thread([this, &task]() { task(m_txn, m_state); });
+        }
+
+        /// \brief Releases the snapshot once the last page is built.
+        /// \details The state, including the cached last page, stays readable.
+        void end_txn() {
+            std::lock_guard<std::mutex> lk(m_run_mutex);
+            run_on_thread([this]() {
+                if (m_state.reader != nullptr) {
+                    mdbx_cursor_close(m_state.reader);
+                    m_state.reader = nullptr;
+                }
+                if (m_txn != nullptr) {
+                    mdbx_txn_abort(m_txn);
+                    m_txn = nullptr;
+                }
+            });
+        }
+
+        /// \brief Whether the last \ref run() started at least \p timeout ago.
+        bool idle_for(std::chrono::milliseconds timeout) const {
+            const std::chrono::steady_clock::duration idle =
+                std::chrono::steady_clock::duration(now_ticks() -
+                                                    m_last_used.load(std::memory_order_relaxed));
+            return idle >= timeout;
+        }
+
+        /// \brief Builds the token that names page \p page of session \p id.
+        static std::string make_token(const NodeId& id, std::uint64_t page) {
+            std::string token(token_size(), '\0');
+            std::memcpy(&token[0], id.data(), 16);
+            std::uint8_t buf[8];
+            detail::write_u64_le(page, buf);
+            std::memcpy(&token[16], buf, 8);
+            return token;
+        }
+
+        /// \brief Splits a token from \ref make_token().
+        /// \return \c false when \p token is not a snapshot token.
+        static bool parse_token(const std::string& token, NodeId& id, std::uint64_t& page) {
+            if (token.size() != token_size()) {
+                return false;
+            }
+            std::memcpy(id.data(), token.data(), 16);
+            page = detail::read_u64_le(reinterpret_cast<const std::uint8_t*>(token.data() + 16));
+            return true;
+        }
+
+    private:
+        NodeId m_id;
+        std::mutex m_run_mutex;
+        std::atomic<std::chrono::steady_clock::rep> m_last_used;
+        MDBX_txn* m_txn = nullptr;
+        State m_state;
+        std::unique_ptr<mdbxc::detail::ThreadPool> m_thread; ///< Declared last so it stops first.
+
+        static std::size_t token_size() { return 24; }
+
+        static std::chrono::steady_clock::rep now_ticks() {
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+        }
+
+        void run_on_thread(const std::function<void()>& fn) {
+            std::packaged_task<void()> job(fn);
+            std::future<void> done = job.get_future();
+            m_thread->post([&job]() { job(); });
+            done.get();
+        }
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_SNAPSHOT_EXPORT_HPP_INCLUDED
@@ -10,9 +10,18 @@
 #include <string>
 #include <vector>
 
+#include "ChangeOp.hpp"
+
 namespace mdbxc {
 namespace sync {
 
+    /// \brief One key written by a committed remote sync apply.
+    struct SyncAppliedKey {
+        std::string dbi_name;                     ///< User table name.
+        ChangeOpType op_type = ChangeOpType::Put; ///< Kind of the applied op.
+        std::vector<std::uint8_t> storage_key;    ///< Serialized MDBX key; empty for ClearTable.
+    };
+
     /// \brief Summary of one committed remote sync apply.
     /// \details Emitted after \c SyncEngine::handle_push() commits at least
     /// one non-empty incoming batch, after the connection apply generation
@@ -26,6 +35,10 @@ namespace sync {
         /// \details Names are reported in first-seen order across applied
         /// batches. Idempotent replays and skipped batches do not emit events.
         std::vector<std::string> affected_dbi_names;
+        /// \brief Keys of applied operations in apply order, without values.
+        /// \details Lets observers such as \c VectorStore refresh only the
+        /// changed records instead of reloading whole tables.
+        std::vector<SyncAppliedKey> applied_keys;
     };
 
     /// \brief Non-owning observer for successful remote sync apply commits.
@@ -5,25 +5,117 @@
 /// \file SyncCursor.hpp
 /// \brief Vector-clock style replication cursor.
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <map>
+#include <utility>
+#include <vector>
 
 #include "common.hpp"
 
 namespace mdbxc {
 namespace sync {
 
+    /// \brief Origin to \c seq map kept as one vector sorted by origin.
+    /// \details Offers the subset of the \c std::map interface cursors use.
+    /// Copying a cursor is one allocation, lookups are binary searches over
+    /// contiguous entries, and inserting origins in ascending order, as the
+    /// codec and stores do, appends without shifting. Inserts elsewhere shift
+    /// the tail and invalidate iterators and references. Keys are not
+    /// \c const in \c value_type; do not change them through an iterator.
+    class OriginSeqMap {
+    public:
+        typedef NodeId key_type;
+        typedef std::uint64_t mapped_type;
+        typedef std::pair<NodeId, std::uint64_t> value_type;
+        typedef std::vector<value_type>::iterator iterator;
+        typedef std::vector<value_type>::const_iterator const_iterator;
+        typedef std::size_t size_type;
+
+        iterator begin() { return m_items.begin(); }
+        iterator end() { return m_items.end(); }
+        const_iterator begin() const { return m_items.begin(); }
+        const_iterator end() const { return m_items.end(); }
+
+        bool empty() const { return m_items.empty(); }
+        size_type size() const { return m_items.size(); }
+        void clear() { m_items.clear(); }
+        void reserve(size_type n) { m_items.reserve(n); }
+
+        iterator find(const NodeId& origin) {
+            const iterator it = lower_bound(origin);
+            return it != m_items.end() && it->first == origin ? it : m_items.end();
+        }
+
+        const_iterator find(const NodeId& origin) const {
+            const const_iterator it = lower_bound(origin);
+            return it != m_items.end() && it->first == origin ? it : m_items.end();
+        }
+
+        size_type count(const NodeId& origin) const {
+            return find(origin) == end() ? 0u : 1u;
+        }
+
+        /// \brief Returns the \c seq of \p origin, inserting 0 when absent.
+        std::uint64_t& operator[](const NodeId& origin) {
+            if (m_items.empty() || m_items.back().first < origin) {
+                m_items.push_back(value_type(origin, 0));
+                return m_items.back().second;
+            }
+            iterator it = lower_bound(origin);
+            if (it->first != origin) {
+                it = m_items.insert(it, value_type(origin, 0));
+            }
+            return it->second;
+        }
+
+        size_type erase(const NodeId& origin) {
+            const iterator it = find(origin);
+            if (it == m_items.end()) {
+                return 0;
+            }
+            m_items.erase(it);
+            return 1;
+        }
+
+        iterator erase(const_iterator pos) {
+            return m_items.erase(m_items.begin() + (pos - m_items.begin()));
+        }
+
+        friend bool operator==(const OriginSeqMap& a, const OriginSeqMap& b) {
+            return a.m_items == b.m_items;
+        }
+
+        friend bool operator!=(const OriginSeqMap& a, const OriginSeqMap& b) {
+            return !(a == b);
+        }
+
+    private:
+        static bool origin_less(const value_type& item, const NodeId& origin) {
+            return item.first < origin;
+        }
+
+        iterator lower_bound(const NodeId& origin) {
+            return std::lower_bound(m_items.begin(), m_items.end(), origin, &origin_less);
+        }
+
+        const_iterator lower_bound(const NodeId& origin) const {
+            return std::lower_bound(m_items.begin(), m_items.end(), origin, &origin_less);
+        }
+
+        std::vector<value_type> m_items;
+    };
+
     /// \brief Per-origin sequence cursor used by sync peers.
     /// \details The cursor maps an origin \c NodeId to the highest contiguous
     /// \c seq number already applied locally. Incremental sync asks the remote
     /// for batches strictly above these numbers.
     struct SyncCursor {
-        std::map<NodeId, std::uint64_t> last_seq_by_origin;
+        OriginSeqMap last_seq_by_origin;
 
         /// \brief Returns the last contiguous applied \c seq for \p origin.
         std::uint64_t last_seq_for(const NodeId& origin) const {
-            const std::map<NodeId, std::uint64_t>::const_iterator it =
-                last_seq_by_origin.find(origin);
+            const OriginSeqMap::const_iterator it = last_seq_by_origin.find(origin);
             return it == last_seq_by_origin.end() ? 0ULL : it->second;
         }
 
@@ -33,6 +125,24 @@ namespace sync {
         }
     };
 
+    /// \brief 64-bit FNV-1a digest of the entries of \p cursor; never 0.
+    /// \details Stable across platforms: hashes each origin followed by its
+    /// \c seq in little-endian order. Transport cursor deltas use it to name
+    /// the baseline they apply to.
+    inline std::uint64_t sync_cursor_digest(const SyncCursor& cursor) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        OriginSeqMap::const_iterator it = cursor.last_seq_by_origin.begin();
+        for (; it != cursor.last_seq_by_origin.end(); ++it) {
+            for (std::size_t i = 0; i < it->first.size(); ++i) {
+                hash = (hash ^ it->first[i]) * 1099511628211ULL;
+            }
+            for (int shift = 0; shift < 64; shift += 8) {
+                hash = (hash ^ ((it->second >> shift) & 0xFFu)) * 1099511628211ULL;
+            }
+        }
+        return hash == 0 ? 1 : hash;
+    }
+
 } // namespace sync
 } // namespace mdbxc
 
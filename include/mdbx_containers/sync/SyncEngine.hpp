@@ -23,30 +23,50 @@
 /// supplied transaction and are therefore valid only for its lifetime.
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <exception>
+#include <future>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <mdbx.h>
 
 #include "../common.hpp"
+#include "../detail/ReadaheadHint.hpp"
+#include "../detail/ThreadPool.hpp"
 #include "common.hpp"
+#include "AppliedCursorCache.hpp"
 #include "ConflictPolicy.hpp"
 #include "ChangeBatch.hpp"
 #include "ChangeBatchCodec.hpp"
+#include "ChangeBatchView.hpp"
+#include "ChangeLogCompaction.hpp"
+#include "ChangeLogRetention.hpp"
 #include "ChangeOp.hpp"
+#include "ISyncCaptureSink.hpp"
+#include "OriginTailCache.hpp"
 #include "protocol.hpp"
+#include "SnapshotExport.hpp"
 #include "SyncCursor.hpp"
+#include "SyncTracing.hpp"
 #include "stores/AppliedStore.hpp"
+#include "stores/ChangeLogDbiIndexStore.hpp"
 #include "stores/ChangeLogStore.hpp"
 #include "stores/MetaStore.hpp"
 #include "stores/OriginIndexStore.hpp"
+#include "stores/PeerWatermarkStore.hpp"
+#include "stores/RangeHashStore.hpp"
 
 namespace mdbxc {
 namespace sync {
@@ -119,6 +139,14 @@ namespace sync {
         int                  mdbx_error_code = MDBX_SUCCESS;
     };
 
+    /// \brief Order in which a pull page is filled from the origins the
+    /// requester lags behind on.
+    enum class PullSchedule {
+        KeyOrder,   ///< Drain origins one after another in NodeId order.
+        RoundRobin, ///< One batch per lagging origin in turn, resuming at the
+                    ///< origin the requester's previous page stopped at.
+    };
+
     /// \brief Pull/push/apply coordinator bound to a single \c Connection.
     class SyncEngine {
         struct PullOrigin {
@@ -133,7 +161,12 @@ namespace sync {
         /// \param policy Conflict resolution policy (default: \c Reject).
         explicit SyncEngine(std::shared_ptr<Connection> conn,
                             ConflictPolicy policy = ConflictPolicy::Reject)
-            : m_conn(std::move(conn)), m_policy(policy) {
+            : m_conn(std::move(conn)), m_policy(policy),
+              m_tail_cache(std::make_shared<OriginTailCache>()),
+              m_applied_cache(std::make_shared<AppliedCursorCache>()),
+              m_pull_resume(std::make_shared<PullResumeTable>()),
+              m_snapshot_sessions(std::make_shared<SnapshotSessionTable>()),
+              m_peer_watermarks(std::make_shared<PeerWatermarkTable>()) {
             if (m_policy == ConflictPolicy::LastWriterWins) {
                 throw std::invalid_argument(
                     "ConflictPolicy::LastWriterWins is not implemented");
@@ -184,9 +217,104 @@ namespace sync {
             return meta.get_db_uuid(txn.handle());
         }
 
+        /// \brief Returns the \c seq of the newest local batch; 0 before the first.
+        std::uint64_t local_seq() const {
+            auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
+            MetaStore meta(m_conn->env_handle());
+            meta.open(txn.handle());
+            return meta.get_local_seq(txn.handle());
+        }
+
+        /// \brief Sets how the changelog keys its records.
+        /// \details \c ChangeLogLayout::PerOrigin gives every origin its own
+        /// DBI keyed by \c seq alone; the layout is stored in \c _mdbxc_meta
+        /// and read by every later capture and pull. Call it right after
+        /// \ref initialize_local_identity(), before the first capture.
+        /// \throws std::logic_error when the changelog holds records in
+        ///         another layout.
+        void set_changelog_layout(ChangeLogLayout layout) {
+            auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+            MetaStore meta(m_conn->env_handle());
+            meta.open(txn.handle());
+            ChangeLogStore log(m_conn->env_handle());
+            log.open(txn.handle());
+            if (log.layout() == layout) {
+                return;
+            }
+            if (!log.keyspace(txn.handle()).origins().empty()) {
+                throw std::logic_error(
+                    "SyncEngine::set_changelog_layout: changelog is not empty");
+            }
+            meta.set_changelog_layout(txn.handle(), static_cast<std::uint8_t>(layout));
+            txn.commit();
+        }
+
+        /// \brief Returns the changelog layout recorded in \c _mdbxc_meta.
+        ChangeLogLayout changelog_layout() const {
+            auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
+            return ChangeLogKeyspace::read_layout(txn.handle(), m_conn->env_handle());
+        }
+
+        /// \brief Returns the connection the engine is bound to.
+        const std::shared_ptr<Connection>& connection() const noexcept {
+            return m_conn;
+        }
+
         /// \brief Returns the conflict resolution policy.
         ConflictPolicy policy() const noexcept { return m_policy; }
 
+        /// \brief Sets the workers that decode pushed batches.
+        /// \details \c handle_push() decodes every batch, walks its ops and
+        /// checks its DBI flags before taking the writer. With \p threads
+        /// above 0 that work is split between a pool of \p threads workers
+        /// and the calling thread; 0, the default, does it all on the
+        /// calling thread.
+        /// \note Must not be called concurrently with \c handle_push().
+        void set_push_prepare_threads(std::size_t threads) {
+            m_prepare_pool.reset();
+            if (threads != 0) {
+                m_prepare_pool = std::make_shared<mdbxc::detail::ThreadPool>(threads);
+            }
+        }
+
+        /// \brief Returns the push prepare workers; 0 when disabled.
+        std::size_t push_prepare_threads() const noexcept {
+            return m_prepare_pool ? m_prepare_pool->size() : 0;
+        }
+
+        /// \brief Sets how pull pages are shared between origins.
+        /// \details \c PullSchedule::KeyOrder, the default, drains origins in
+        /// NodeId order, so during catch-up high NodeIds wait until lower
+        /// ones are drained. With \c PullSchedule::RoundRobin a page takes
+        /// one batch from each lagging origin in turn, and the next page for
+        /// the same \c PullRequest::requester starts at the origin where the
+        /// previous page stopped, so all origins advance together.
+        /// \note Must not be called concurrently with \c handle_pull().
+        void set_pull_schedule(PullSchedule schedule) noexcept {
+            m_pull_schedule = schedule;
+        }
+
+        /// \brief Returns the pull page schedule.
+        PullSchedule pull_schedule() const noexcept { return m_pull_schedule; }
+
+        /// \brief Enables read-ahead hints on changelog walks; on by default.
+        /// \details With \c PullSchedule::KeyOrder each origin run a page
+        /// reads is first walked by a second cursor, up to the batches and
+        /// bytes left in the page and at most 256 batches, and the values
+        /// that live outside the leaf pages are passed to
+        /// \c madvise(MADV_WILLNEED). A cold replica catching up then has
+        /// the overflow pages of later batches read while earlier ones are
+        /// copied. Turn it off when the changelog is known to be resident or
+        /// for environments opened with \c Config::readahead off, where
+        /// random access is expected. No effect on Windows.
+        /// \note Must not be called concurrently with \c handle_pull().
+        void set_pull_readahead(bool enabled) noexcept {
+            m_pull_readahead = enabled;
+        }
+
+        /// \brief Returns whether changelog walks issue read-ahead hints.
+        bool pull_readahead() const noexcept { return m_pull_readahead; }
+
         /// \brief Applies a single \c ChangeBatch to local DBIs inside \p txn.
         /// \details See class-level docs for the seq / apply rules. The
         /// caller commits the transaction. User DBIs are opened lazily by
@@ -202,45 +330,26 @@ namespace sync {
         /// sequence gap, an inconsistent batch schema, or a destination DBI
         /// flag mismatch.
         ApplyOutcome apply_batch_ex(MDBX_txn* txn, const ChangeBatch& batch) {
-            txn = checked_external_txn(txn, "SyncEngine::apply_batch_ex");
-            ApplyOutcome outcome = make_apply_outcome(ApplyResult::Applied, batch, 0);
-            MetaStore meta(m_conn->env_handle());
-            AppliedStore applied(m_conn->env_handle());
-            meta.open(txn);
-            applied.open(txn);
-
-            const NodeId local_node = meta.get_node_id(txn);
-            if (compare_node_id(batch.origin_node_id, local_node) == 0) {
-                outcome.result = ApplyResult::Skipped;
-                return outcome;
-            }
+            std::vector<ChangeOpView> ops;
+            return apply_changes(txn, batch, ops);
+        }
 
-            const std::uint64_t last = applied.last_applied_seq(txn, batch.origin_node_id);
-            outcome.last_applied_seq = last;
-            if (batch.seq <= last) {
-                outcome.result = ApplyResult::Skipped;
-                return outcome;
-            }
-            if (batch.seq != last + 1) {
-                outcome.result = ApplyResult::Conflict;
-                outcome.conflict_reason = ApplyConflictReason::SequenceGap;
-                return outcome;
-            }
-            std::vector<BatchDbiFlags> batch_dbis;
-            if (!collect_batch_dbi_flags(batch, batch_dbis, &outcome)) return outcome;
+        /// \brief Applies an encoded batch read in place.
+        /// \details Same rules as the \c ChangeBatch overload. Origin and
+        /// \c seq come from the header, so skipped batches and gaps are
+        /// reported without decoding any op, and op payloads are written to
+        /// MDBX straight from the batch bytes.
+        /// \throws std::runtime_error or std::length_error on a malformed batch.
+        ApplyOutcome apply_batch_ex(MDBX_txn* txn, const ChangeBatchView& batch) {
+            ChangeBatchCodec::Reader reader = batch.ops();
+            std::vector<ChangeOpView> ops;
+            return apply_encoded(txn, batch, reader, ops);
+        }
 
-            std::unordered_map<std::string, MDBX_dbi> dbi_cache;
-            if (!preflight_batch_user_dbis(txn, batch_dbis, dbi_cache, &outcome)) {
-                return outcome;
-            }
-            for (const ChangeOp& op : batch.ops) {
-                apply_one_op(txn, op, dbi_cache);
-            }
-            applied.set_last_applied_seq(txn, batch.origin_node_id, batch.seq);
-            outcome.result = ApplyResult::Applied;
-            outcome.conflict_reason = ApplyConflictReason::None;
-            outcome.last_applied_seq = batch.seq;
-            return outcome;
+        /// \brief Compact form of the \c ChangeBatchView overload of
+        /// \c apply_batch_ex().
+        ApplyResult apply_batch(MDBX_txn* txn, const ChangeBatchView& batch) {
+            return apply_batch_ex(txn, batch).result;
         }
 
         /// \brief Returns a stable short name for an apply conflict reason.
@@ -274,7 +383,24 @@ namespace sync {
         /// \c request.max_bytes rather than running out of changelog entries.
         /// A single retained batch may exceed \c max_bytes but is rejected
         /// when it exceeds \c request.max_single_batch_bytes.
-        PullResponse handle_pull(const PullRequest& request) {
+        /// An empty page with \c request.wait_timeout_ms set is a long-poll:
+        /// the call blocks for up to that long, capped by
+        /// \ref max_pull_wait(), until a commit gives the requester a
+        /// non-empty page or \c request.cancel_token is cancelled. Each
+        /// commit wakes it to read the page again, so commits for origins
+        /// the requester already has keep it waiting.
+        /// With \c request.request_full_snapshot the call serves the next
+        /// page of a full snapshot export instead: every user table, read in
+        /// key order from one MVCC snapshot held open between pages, as
+        /// \c seq=0 chunks of \c Put ops after a \c ClearTable manifest.
+        /// Pages chain through \c snapshot_token, \c remote_tail is the
+        /// cursor the snapshot reflects, and snapshot pages never long-poll.
+        /// Receivers load them with \ref apply_snapshot_page().
+        /// \param form With \c PullBatchForm::Encoded, batches are returned
+        ///        in \c encoded_batches as stored, for transports that only
+        ///        serialize the response.
+        PullResponse handle_pull(const PullRequest& request,
+                                 PullBatchForm form = PullBatchForm::Decoded) {
             PullResponse out;
             if (!db_id_matches(request.db_id)) {
                 out.ok = false;
@@ -282,144 +408,189 @@ namespace sync {
                 out.error_code = SyncResponseErrorCode::DbIdMismatch;
                 return out;
             }
-            if (request.request_full_snapshot) {
+            if (request.have_baseline_digest != 0) {
+                // A transport decoded a cursor delta it had no baseline for.
                 out.ok = false;
-                out.error = "PullRequest::request_full_snapshot is not implemented";
-                out.error_code =
-                    SyncResponseErrorCode::UnsupportedFullSnapshot;
+                out.error = "unknown cursor baseline";
+                out.error_code = SyncResponseErrorCode::CursorBaselineMismatch;
+                out.error_retryable = true;
                 return out;
             }
-
-            MDBX_txn* txn = nullptr;
-            check_mdbx(mdbx_txn_begin(m_conn->env_handle(), nullptr,
-                                      MDBX_TXN_RDONLY, &txn),
-                       "SyncEngine: failed to begin read txn for pull");
-            /// RAII guard: aborts (releases handle + reader slot) instead of
-            /// reset, because we never renew the same transaction here — reset
-            /// would leak the MDBX_txn object across calls.
-            struct Guard {
-                MDBX_txn* t;
-                ~Guard() { if (t) mdbx_txn_abort(t); }
-            } guard{txn};
-
-            MDBX_dbi changelog_dbi = open_changelog_ro(txn);
-            if (changelog_dbi == 0) {
-                out.remote_have = read_applied_cursor(txn, out.remote_have);
-                out.remote_tail_known = true;
-                return out;
+            if (request.request_full_snapshot) {
+                return pull_full_snapshot(request, form);
             }
+            note_peer_have(request.requester, request.have);
 
-            return pull_changelog_page(txn, changelog_dbi, request);
-        }
-
-        /// \brief Returns retained changelog batches newer than
-        /// \c request.have.
-        /// \details Empty \c request.have replays all retained changelog
-        /// batches from seq=1 for all known origins. This is not a full
-        /// database snapshot. Non-empty cursors filter each origin
-        /// independently and still include origins missing from the cursor.
-        /// Origin discovery uses \c _mdbxc_origins when available, with a
-        /// changelog scan fallback for pre-index databases. Indexed origin
-        /// tails skip origins that have no new batches; changelog keys are
-        /// still used for exact \c have_seq+1 seeks so old values are not
-        /// decoded.
-        /// Sets \c has_more=true when the walk stopped because of
-        /// \c request.max_batches or the soft page budget
-        /// \c request.max_bytes. A single retained batch may exceed
-        /// \c max_bytes but is rejected when it exceeds
-        /// \c request.max_single_batch_bytes.
-        PullResponse pull_changelog_page(MDBX_txn* txn, MDBX_dbi dbi,
-                                        const PullRequest& request) {
-            PullResponse out;
-            if (request.request_full_snapshot) {
-                out.ok = false;
-                out.error = "PullRequest::request_full_snapshot is not implemented";
-                out.error_code =
-                    SyncResponseErrorCode::UnsupportedFullSnapshot;
+            std::uint64_t snapshot_txn_id = 0;
+            out = pull_snapshot(request, form, snapshot_txn_id);
+            std::chrono::milliseconds wait(request.wait_timeout_ms);
+            if (wait > m_max_pull_wait) {
+                wait = m_max_pull_wait;
+            }
+            if (wait.count() <= 0 || !pull_is_idle(out)) {
                 return out;
             }
-            txn = checked_external_txn(txn, "SyncEngine::pull_changelog_page");
-            out.remote_have = read_applied_cursor(txn, out.remote_have);
-            const std::vector<PullOrigin> origins = collect_known_origins(txn, dbi);
-            out.remote_tail_known = copy_known_tail(origins, out.remote_tail);
-            for (std::size_t i = 0; i < origins.size(); ++i) {
-                if (!request_has_retained_start(txn, dbi, origins[i], request,
-                                                out)) {
-                    return out;
+            const std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() + wait;
+            while (!request.cancel_token.is_cancellation_requested()) {
+                const std::chrono::steady_clock::time_point now =
+                    std::chrono::steady_clock::now();
+                if (now >= deadline) {
+                    break;
                 }
-            }
-            std::size_t total_bytes = 0;
-            bool truncated = false;
-            for (std::size_t i = 0; i < origins.size(); ++i) {
-                if (origin_is_at_tail(origins[i], request)) {
+                // Slices bound how late a cancellation is noticed.
+                std::chrono::milliseconds slice =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+                if (slice > pull_wait_slice()) {
+                    slice = pull_wait_slice();
+                }
+                if (m_conn->wait_for_txn(snapshot_txn_id, slice) <= snapshot_txn_id) {
                     continue;
                 }
-                if (pull_origin_batches(txn, dbi, origins[i].origin,
-                                        request, out, total_bytes)) {
-                    if (!out.ok) {
-                        return out;
-                    }
-                    truncated = true;
+                out = pull_snapshot(request, form, snapshot_txn_id);
+                if (!pull_is_idle(out)) {
                     break;
                 }
             }
-            out.has_more = truncated;
             return out;
         }
 
-        /// \brief Handles a push request: applies each batch in order.
-        /// \details Atomic: when \c apply_batch returns \c Conflict for any
-        /// batch, the transaction is rolled back (no partial commit) and
-        /// \c ok is set to \c false. Validates \c request.db_id against the
-        /// local \c db_uuid; mismatched peers receive \c ok=false with no
-        /// side effects.
-        PushResponse handle_push(const PushRequest& request) {
+        /// \brief Sets the longest time \c handle_pull() holds a long-poll.
+        /// \details Requests ask for \c PullRequest::wait_timeout_ms and get
+        /// at most this. The default of 0 answers every pull at once. A
+        /// waiting pull occupies its transport handler thread, so size
+        /// server thread pools for the replicas that long-poll.
+        /// \note Must not be called concurrently with \c handle_pull().
+        void set_max_pull_wait(std::chrono::milliseconds wait) {
+            if (wait.count() < 0) {
+                throw std::invalid_argument(
+                    "SyncEngine::set_max_pull_wait: wait must not be negative");
+            }
+            m_max_pull_wait = wait;
+        }
+
+        /// \brief Returns the long-poll cap; 0 when long-poll is disabled.
+        std::chrono::milliseconds max_pull_wait() const noexcept {
+            return m_max_pull_wait;
+        }
+
+        /// \brief Sets how long an unfinished full snapshot export is kept.
+        /// \details An export whose last page was served this long ago is
+        /// dropped when another one starts, and its tokens then get
+        /// \c SnapshotExpired. Each live export holds a read transaction,
+        /// which keeps MDBX from reusing the pages of its snapshot. Default
+        /// 5 minutes.
+        /// \note Must not be called concurrently with \c handle_pull().
+        void set_snapshot_session_timeout(std::chrono::milliseconds timeout) {
+            if (timeout.count() < 0) {
+                throw std::invalid_argument(
+                    "SyncEngine::set_snapshot_session_timeout: timeout must not be negative");
+            }
+            m_snapshot_session_timeout = timeout;
+        }
+
+        /// \brief Returns the idle time after which a snapshot export is dropped.
+        std::chrono::milliseconds snapshot_session_timeout() const noexcept {
+            return m_snapshot_session_timeout;
+        }
+
+        /// \brief Applies one page of a full snapshot pulled from a peer.
+        /// \details Pass \p first_page for the page requested without a
+        /// \c snapshot_token. Its \c ClearTable manifest empties every table
+        /// the snapshot lists, and a marker naming the source is stored
+        /// until the import ends. Later pages must come from the same
+        /// source; their puts are bulk-loaded with \c MDBX_APPEND. The last
+        /// page (\c has_more=false) replaces the applied cursor with the
+        /// page's \c remote_tail and clears the marker, so incremental pulls
+        /// continue from the snapshot. Each page commits on its own; after an
+        /// interruption \ref snapshot_import_pending() stays \c true and the
+        /// import must start again from the first page. Tables the snapshot
+        /// does not list and the local node's own cursor entry are kept.
+        /// Pages are decoded and checked before the writer is taken.
+        /// \return \c ok=false with \c ApplyConflict, and nothing written,
+        ///         when the page is not the next page of the import, holds
+        ///         ops other than \c Put or \c ClearTable, or names a table
+        ///         with a reserved name or incompatible flags.
+        /// \throws std::invalid_argument when \p page is an error response.
+        PushResponse apply_snapshot_page(const PullResponse& page, bool first_page) {
+            if (!page.ok) {
+                throw std::invalid_argument(
+                    "SyncEngine::apply_snapshot_page: page is an error response");
+            }
             PushResponse out;
-            if (!db_id_matches(request.db_id)) {
-                out.ok = false;
-                out.error = "db_id mismatch";
-                out.error_code = SyncResponseErrorCode::DbIdMismatch;
-                out.receiver_have = applied_cursor();
-                return out;
+            std::string error;
+            SnapshotPage chunks;
+            std::vector<BatchDbiFlags> dbis;
+            if (!prepare_snapshot_page(page, first_page, chunks, error)) {
+                return snapshot_import_rejected(error);
+            }
+            ApplyOutcome outcome;
+            if (!collect_batch_dbi_flags(chunks.ops, dbis, &outcome)) {
+                return snapshot_import_rejected(apply_conflict_message(outcome));
             }
             Connection::SyncApplyNotification notification;
-            std::size_t applied_batches = 0;
-            std::size_t applied_ops = 0;
             std::vector<std::string> affected_dbi_names;
+            std::vector<SyncAppliedKey> applied_keys;
             {
                 const Connection::SyncApplyWriteGuard sync_apply_guard =
                     m_conn->sync_apply_write_guard();
                 auto txn = m_conn->transaction(TransactionMode::WRITABLE);
-                for (const ChangeBatch& batch : request.batches) {
-                    const ApplyOutcome outcome =
-                        apply_batch_ex(txn.handle(), batch);
-                    if (outcome.result == ApplyResult::Conflict) {
-                        txn.rollback();
-                        out.ok = false;
-                        out.error = apply_conflict_message(outcome);
-                        out.error_code = SyncResponseErrorCode::ApplyConflict;
-                        out.error_retryable =
-                            outcome.conflict_reason ==
-                                ApplyConflictReason::SequenceGap;
-                        out.receiver_have = applied_cursor();
-                        return out;
-                    }
-                    if (outcome.result == ApplyResult::Applied &&
-                        !batch.ops.empty()) {
-                        ++applied_batches;
-                        applied_ops += batch.ops.size();
-                        for (std::size_t i = 0; i < batch.ops.size(); ++i) {
-                            add_unique_dbi_name(affected_dbi_names,
-                                                batch.ops[i].dbi_name);
-                        }
-                    }
+                MetaStore meta(m_conn->env_handle());
+                meta.open(txn.handle());
+                const NodeId local_node = meta.get_node_id(txn.handle());
+                NodeId importing{};
+                const bool pending = meta.get_snapshot_import(txn.handle(), importing);
+                if (compare_node_id(chunks.source, local_node) == 0) {
+                    error = "snapshot source is the local node";
+                } else if (!first_page &&
+                           (!pending || compare_node_id(importing, chunks.source) != 0)) {
+                    error = "no snapshot import from this source is in progress";
+                } else if (!page.has_more && !page.remote_tail_known) {
+                    error = "last snapshot page carries no remote_tail";
+                }
+                std::unordered_map<std::string, MDBX_dbi> dbi_cache;
+                if (error.empty() &&
+                    !preflight_batch_user_dbis(txn.handle(), dbis, dbi_cache, &outcome)) {
+                    error = apply_conflict_message(outcome);
+                }
+                if (!error.empty()) {
+                    txn.rollback();
+                    return snapshot_import_rejected(error);
+                }
+                if (first_page) {
+                    meta.set_snapshot_import(txn.handle(), chunks.source);
+                }
+                std::string name;
+                for (std::size_t i = 0; i < chunks.ops.size(); ++i) {
+                    const ChangeOpView& op = chunks.ops[i];
+                    name.assign(op.dbi_name, op.dbi_name_len);
+                    load_snapshot_op(txn.handle(), op, name, dbi_cache);
+                    SyncAppliedKey key;
+                    key.dbi_name = name;
+                    key.op_type = op.op_type;
+                    key.storage_key.assign(op.storage_key,
+                                           op.storage_key + op.storage_key_len);
+                    add_unique_dbi_name(affected_dbi_names, key.dbi_name);
+                    applied_keys.push_back(std::move(key));
+                }
+                RangeHashStore range_hash(m_conn->env_handle());
+                if (range_hash.open_existing(txn.handle())) {
+                    RangeHashStore::TouchedTables touched;
+                    RangeHashStore::collect(chunks.ops, touched);
+                    range_hash.refresh(txn.handle(), touched);
+                }
+                if (!page.has_more) {
+                    replace_applied_cursor(txn.handle(), page.remote_tail, local_node);
+                    meta.clear_snapshot_import(txn.handle());
                 }
                 txn.commit();
-                if (applied_batches != 0u) {
+                out.commit_latency = txn.commit_latency();
+                if (!applied_keys.empty()) {
                     notification =
-                        m_conn->mark_sync_apply_committed(applied_batches,
-                                                          applied_ops,
-                                                          affected_dbi_names);
+                        m_conn->mark_sync_apply_committed(chunks.count,
+                                                          applied_keys.size(),
+                                                          affected_dbi_names,
+                                                          std::move(applied_keys));
                 }
             }
             m_conn->notify_sync_apply_observers(notification);
@@ -428,102 +599,2172 @@ namespace sync {
             return out;
         }
 
-        /// \brief Returns the current applied cursor across all known origins.
-        SyncCursor applied_cursor() const {
-            SyncCursor cur;
+        /// \brief Whether a snapshot import was started and not finished.
+        /// \details Stays \c true from the first \ref apply_snapshot_page()
+        /// until the last one commits, including across restarts, so a
+        /// replica with partially loaded tables can tell it must pull a
+        /// snapshot again before it pulls changes.
+        bool snapshot_import_pending() const {
             auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
-            return read_applied_cursor(txn.handle(), cur);
+            if (open_store_ro(txn.handle(), "_mdbxc_meta") == 0) {
+                return false;
+            }
+            MetaStore meta(m_conn->env_handle());
+            meta.open(txn.handle());
+            NodeId source{};
+            return meta.get_snapshot_import(txn.handle(), source);
         }
 
-        /// \brief Reads the applied cursor using the caller-supplied txn.
-        /// \details Used inside \c handle_pull to avoid opening a second
-        /// sticky-thread transaction on the same thread.
-        SyncCursor applied_cursor(MDBX_txn* txn) const {
-            txn = checked_external_txn(txn, "SyncEngine::applied_cursor");
-            SyncCursor cur;
-            return read_applied_cursor(txn, cur);
+        /// \brief Starts keeping range hashes of \p dbi_name and builds them.
+        /// \details Range hashes summarise the table as a Merkle tree in
+        /// \c _mdbxc_range_hash so \c RangeHashVerifier can compare it with
+        /// a peer and fetch only the key ranges that differ. Captured
+        /// commits and every apply by this engine keep them current in
+        /// their own transaction; writes made with neither leave them stale
+        /// until \ref rebuild_range_hash(). Peers must use the same
+        /// \p leaf_bits, which sets the average leaf to 2^leaf_bits keys.
+        /// \throws std::invalid_argument for a reserved name or bad
+        ///         \p leaf_bits, std::runtime_error when the table does not exist.
+        void enable_range_hash(const std::string& dbi_name,
+                               unsigned leaf_bits = RangeHashStore::default_leaf_bits()) {
+            auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+            RangeHashStore store(m_conn->env_handle());
+            store.open(txn.handle());
+            store.enable(txn.handle(), dbi_name, leaf_bits);
+            txn.commit();
         }
 
-        /// \brief Builds a \c PushRequest that carries every local batch with
-        /// \c seq in \c [from_seq, to_seq] (inclusive).
-        /// \details Hides the system stores from callers: example code and
-        /// future transports can call this instead of touching
-        /// \c MetaStore / \c ChangeLogStore directly. The sender is always
-        /// the local node id (derived from \c _mdbxc_meta); sending batches
-        /// of other origins is not supported at this layer.
-        ///
-        /// Opens its own short-lived read-only transaction on the bound
-        /// connection. The caller must not have another active transaction
-        /// for the same connection on the current thread (Mdbx would return
-        /// \c MDBX_BUSY). Right after a writable commit is fine.
-        /// \param from_seq First \c seq to include (use 1 to send from the
-        /// beginning; use the peer's \c applied_cursor + 1 to send a delta).
-        /// \param to_seq Last \c seq to include (use 0 to send up to the
-        /// current local tail, inclusive).
-        /// \return A \c PushRequest ready to send to the peer. Empty
-        /// \c batches when the requested range is empty (or past the tail).
-        /// \throws std::runtime_error if the requested range is not
-        /// contiguous in the local changelog (a hole means pruning,
-        /// corruption, or a wrong origin).
-        /// \throws MdbxException on database error.
-        PushRequest make_push_request(std::uint64_t from_seq,
-                                      std::uint64_t to_seq) const {
-            PushRequest req;
-            req.db_id  = db_uuid();
-            if (to_seq != 0 && to_seq < from_seq) return req;
+        /// \brief Recomputes the range hashes of \p dbi_name from its records.
+        /// \return \c false when the table keeps none.
+        bool rebuild_range_hash(const std::string& dbi_name) {
+            auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+            RangeHashStore store(m_conn->env_handle());
+            unsigned leaf_bits = 0;
+            if (!store.open_existing(txn.handle()) ||
+                !store.leaf_bits(txn.handle(), dbi_name, leaf_bits)) {
+                return false;
+            }
+            store.enable(txn.handle(), dbi_name, leaf_bits);
+            txn.commit();
+            return true;
+        }
+
+        /// \brief Stops keeping range hashes of \p dbi_name and drops them.
+        /// \return \c false when the table kept none.
+        bool disable_range_hash(const std::string& dbi_name) {
+            auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+            RangeHashStore store(m_conn->env_handle());
+            if (!store.open_existing(txn.handle()) ||
+                !store.disable(txn.handle(), dbi_name)) {
+                return false;
+            }
+            txn.commit();
+            return true;
+        }
+
+        /// \brief Handles a range-hash request from one read snapshot.
+        /// \details Tables without range hashes get \c ok=false with
+        /// \c SyncResponseErrorCode::RangeHashUnavailable.
+        /// \throws std::invalid_argument on node depths, indexes or buckets
+        ///         out of range.
+        RangeHashResponse handle_range_hash(const RangeHashRequest& request) const {
+            RangeHashResponse out;
+            if (!db_id_matches(request.db_id)) {
+                out.ok = false;
+                out.error = "db_id mismatch";
+                out.error_code = SyncResponseErrorCode::DbIdMismatch;
+                return out;
+            }
             auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
-            MetaStore meta(m_conn->env_handle());
-            meta.open(txn.handle());
-            ChangeLogStore log(m_conn->env_handle());
-            log.open(txn.handle());
-            req.sender = meta.get_node_id(txn.handle());
-            if (to_seq == 0) {
-                to_seq = meta.get_local_seq(txn.handle());
+            RangeHashStore store(m_conn->env_handle());
+            unsigned leaf_bits = 0;
+            MDBX_dbi data = 0;
+            if (!open_range_hashed(txn.handle(), store, request.dbi_name, leaf_bits, data)) {
+                out.ok = false;
+                out.error = "table '" + request.dbi_name + "' keeps no range hashes";
+                out.error_code = SyncResponseErrorCode::RangeHashUnavailable;
+                return out;
             }
-            if (to_seq < from_seq) return req;
-            std::vector<std::uint8_t> buf;
-            for (std::uint64_t s = from_seq;; ++s) {
-                if (!log.get(txn.handle(), req.sender, s, buf)) {
-                    throw std::runtime_error(
-                        "SyncEngine::make_push_request: changelog gap at seq " +
-                        std::to_string(s) +
-                        " (pruning, corruption, or wrong origin)");
+            out.leaf_bits = static_cast<std::uint8_t>(leaf_bits);
+            out.dbi_flags = table_dbi_flags(txn.handle(), data, request.dbi_name);
+            switch (request.query) {
+            case RangeHashQuery::Nodes:
+                store.nodes(txn.handle(), request.dbi_name, request.depth,
+                            request.indexes, out.nodes);
+                break;
+            case RangeHashQuery::Leaves:
+                store.leaves(txn.handle(), request.dbi_name, request.indexes, out.leaves);
+                break;
+            case RangeHashQuery::Records:
+                RangeHashStore::records(txn.handle(), data, request, out);
+                break;
+            default:
+                throw std::invalid_argument("SyncEngine::handle_range_hash: unknown query");
+            }
+            return out;
+        }
+
+        /// \brief Splits the local table at divergent leaf starts into the
+        /// ranges a \c RangeHashVerifier fetches from its peer.
+        /// \details Each range runs from a start to the next local leaf
+        /// start or the next divergent start, whichever comes first, and
+        /// adjacent ranges are merged.
+        std::vector<RangeHashRange> divergent_ranges(const std::string& dbi_name,
+                                                     std::vector<RangeHashLeaf> starts) const {
+            std::vector<RangeHashRange> out;
+            auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
+            RangeHashStore store(m_conn->env_handle());
+            unsigned leaf_bits = 0;
+            MDBX_dbi data = 0;
+            if (starts.empty() ||
+                !open_range_hashed(txn.handle(), store, dbi_name, leaf_bits, data)) {
+                return out;
+            }
+            MDBX_txn* raw = txn.handle();
+            const auto less = [raw, data](const RangeHashLeaf& a, const RangeHashLeaf& b) {
+                if (a.head || b.head) {
+                    return a.head && !b.head;
+                }
+                const MDBX_val ka = { a.start_key.empty() ? nullptr
+                                          : const_cast<std::uint8_t*>(&a.start_key[0]),
+                                      a.start_key.size() };
+                const MDBX_val kb = { b.start_key.empty() ? nullptr
+                                          : const_cast<std::uint8_t*>(&b.start_key[0]),
+                                      b.start_key.size() };
+                return mdbx_cmp(raw, data, &ka, &kb) < 0;
+            };
+            std::sort(starts.begin(), starts.end(), less);
+            for (std::size_t i = 0; i < starts.size(); ++i) {
+                if (i != 0 && !less(starts[i - 1], starts[i])) {
+                    continue;
+                }
+                std::vector<std::uint8_t> next;
+                const bool has_next = RangeHashStore::next_leaf_start(
+                    raw, data, leaf_bits, starts[i].head, starts[i].start_key, next);
+                RangeHashRange range;
+                range.from_head = starts[i].head;
+                range.lo = starts[i].start_key;
+                range.has_hi = has_next;
+                range.hi.swap(next);
+                std::size_t j = i + 1;
+                while (j < starts.size() && !less(starts[i], starts[j])) {
+                    ++j;
+                }
+                if (j < starts.size()) {
+                    RangeHashLeaf hi;
+                    hi.start_key = range.hi;
+                    if (!range.has_hi || less(starts[j], hi)) {
+                        range.has_hi = true;
+                        range.hi = starts[j].start_key;
+                    }
+                }
+                if (!out.empty() && out.back().has_hi && !range.from_head &&
+                    out.back().hi == range.lo) {
+                    out.back().has_hi = range.has_hi;
+                    out.back().hi.swap(range.hi);
+                } else {
+                    out.push_back(std::move(range));
+                }
+            }
+            return out;
+        }
+
+        /// \brief Makes the local records of a range equal to a page of
+        /// records fetched from a peer.
+        /// \details Replaces the records of <tt>[request.lo, end)</tt>,
+        /// where \c end is \c page.resume_key when the page has more and
+        /// \c request.hi otherwise, with those of \p page, and refreshes
+        /// the range hashes. Like other applies, the writes are not
+        /// captured, so they are not pushed on to other peers.
+        PushResponse apply_range_page(const RangeHashRequest& request,
+                                      const RangeHashResponse& page) {
+            if (!page.ok || request.query != RangeHashQuery::Records) {
+                throw std::invalid_argument(
+                    "SyncEngine::apply_range_page: not a records page");
+            }
+            PushResponse out;
+            Connection::SyncApplyNotification notification;
+            std::vector<std::string> affected_dbi_names;
+            std::vector<SyncAppliedKey> applied_keys;
+            {
+                const Connection::SyncApplyWriteGuard sync_apply_guard =
+                    m_conn->sync_apply_write_guard();
+                auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+                RangeHashStore store(m_conn->env_handle());
+                unsigned leaf_bits = 0;
+                MDBX_dbi data = 0;
+                std::string error;
+                if (!open_range_hashed(txn.handle(), store, request.dbi_name, leaf_bits, data)) {
+                    error = "table '" + request.dbi_name + "' keeps no range hashes";
+                } else if (leaf_bits != page.leaf_bits ||
+                           table_dbi_flags(txn.handle(), data, request.dbi_name) !=
+                               page.dbi_flags) {
+                    error = "table '" + request.dbi_name + "' has other range hash settings";
+                }
+                if (!error.empty()) {
+                    txn.rollback();
+                    out.ok = false;
+                    out.error = error;
+                    out.error_code = SyncResponseErrorCode::RangeHashUnavailable;
+                    out.receiver_have = applied_cursor();
+                    return out;
+                }
+                RangeHashStore::TouchedTables touched;
+                std::vector<std::vector<std::uint8_t> >& keys = touched[request.dbi_name].keys;
+                read_range_keys(txn.handle(), data, request, page, keys);
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    MDBX_val k = { keys[i].empty() ? nullptr : &keys[i][0], keys[i].size() };
+                    check_mdbx(mdbx_del(txn.handle(), data, &k, nullptr),
+                               "SyncEngine: mdbx_del failed for DBI '" + request.dbi_name + "'");
+                    SyncAppliedKey key;
+                    key.dbi_name = request.dbi_name;
+                    key.op_type = ChangeOpType::Delete;
+                    key.storage_key = keys[i];
+                    applied_keys.push_back(std::move(key));
+                }
+                for (std::size_t i = 0; i < page.records.size(); ++i) {
+                    const RangeHashRecord& record = page.records[i];
+                    MDBX_val k = { record.key.empty() ? nullptr
+                                       : const_cast<std::uint8_t*>(&record.key[0]),
+                                   record.key.size() };
+                    MDBX_val v = { record.value.empty() ? nullptr
+                                       : const_cast<std::uint8_t*>(&record.value[0]),
+                                   record.value.size() };
+                    check_mdbx(mdbx_put(txn.handle(), data, &k, &v, MDBX_UPSERT),
+                               "SyncEngine: mdbx_put failed for DBI '" + request.dbi_name + "'");
+                    keys.push_back(record.key);
+                    SyncAppliedKey key;
+                    key.dbi_name = request.dbi_name;
+                    key.op_type = ChangeOpType::Put;
+                    key.storage_key = record.key;
+                    applied_keys.push_back(std::move(key));
+                }
+                store.refresh(txn.handle(), touched);
+                txn.commit();
+                out.commit_latency = txn.commit_latency();
+                if (!applied_keys.empty()) {
+                    affected_dbi_names.push_back(request.dbi_name);
+                    notification =
+                        m_conn->mark_sync_apply_committed(1, applied_keys.size(),
+                                                          affected_dbi_names,
+                                                          std::move(applied_keys));
+                }
+            }
+            m_conn->notify_sync_apply_observers(notification);
+            out.ok = true;
+            out.receiver_have = applied_cursor();
+            return out;
+        }
+
+    private:
+        /// \brief Reads one pull page from a fresh read snapshot.
+        /// \param snapshot_txn_id Receives the id of the snapshot read.
+        PullResponse pull_snapshot(const PullRequest& request,
+                                   PullBatchForm form,
+                                   std::uint64_t& snapshot_txn_id) {
+            SyncSpan span(SyncSpanKind::PullRead);
+            PullResponse out;
+            MDBX_txn* txn = nullptr;
+            check_mdbx(mdbx_txn_begin(m_conn->env_handle(), nullptr,
+                                      MDBX_TXN_RDONLY, &txn),
+                       "SyncEngine: failed to begin read txn for pull");
+            /// RAII guard: aborts (releases handle + reader slot) instead of
+            /// reset, because we never renew the same transaction here — reset
+            /// would leak the MDBX_txn object across calls.
+            struct Guard {
+                MDBX_txn* t;
+                ~Guard() { if (t) mdbx_txn_abort(t); }
+            } guard{txn};
+            snapshot_txn_id = mdbx_txn_id(txn);
+
+            MDBX_dbi changelog_dbi = open_changelog_ro(txn);
+            if (changelog_dbi == 0) {
+                out.remote_have = read_applied_cursor(txn, out.remote_have);
+                out.remote_tail_known = true;
+                span.finish(true, 0);
+                return out;
+            }
+
+            PullResponse page = pull_changelog_page(txn, changelog_dbi, request, form);
+            span.finish(page.ok, page.batches.size() + page.encoded_batches.size());
+            return page;
+        }
+
+        /// \brief Whether \p out is a successful page with nothing to apply.
+        static bool pull_is_idle(const PullResponse& out) {
+            return out.ok && !out.has_more && out.batches.empty() &&
+                   out.encoded_batches.empty();
+        }
+
+        /// \brief Longest single wait of a long-poll between cancellation checks.
+        static std::chrono::milliseconds pull_wait_slice() {
+            return std::chrono::milliseconds(100);
+        }
+
+        /// \brief Live full snapshot exports by session id.
+        struct SnapshotSessionTable {
+            SnapshotSessionTable()
+                : random(static_cast<std::uint64_t>(std::random_device()()) ^
+                         static_cast<std::uint64_t>(
+                             std::chrono::steady_clock::now().time_since_epoch().count())) {}
+
+            std::mutex mutex;
+            std::map<NodeId, std::shared_ptr<SnapshotExportSession>> sessions;
+            std::mt19937_64 random; ///< Session ids; tokens only need to be unguessable by accident.
+        };
+
+        /// \brief Exports served at once; each holds a thread and a read txn.
+        static const std::size_t max_snapshot_sessions = 4;
+
+        /// \brief Ops of one snapshot page decoded before the writer is taken.
+        struct SnapshotPage {
+            std::size_t count = 0;  ///< Chunks on the page.
+            NodeId source{};
+            std::vector<std::unique_ptr<ChangeBatchCodec::Reader>> readers; // own ops of compressed chunks
+            std::vector<ChangeOpView> ops;
+        };
+
+        /// \brief Serves one page of a full snapshot export.
+        /// \details A request without a token starts an export: a
+        /// \c SnapshotExportSession pins a read snapshot and lists its user
+        /// tables, and page 0 opens with a \c ClearTable op for each. Later
+        /// pages continue the key-order walk from where the previous one
+        /// stopped. The token names the next page, so a retried request for
+        /// the page just served gets the same bytes again; any other page
+        /// number ends in \c SnapshotExpired.
+        PullResponse pull_full_snapshot(const PullRequest& request, PullBatchForm form) {
+            PullResponse out;
+            std::shared_ptr<SnapshotExportSession> session;
+            std::uint64_t page = 0;
+            if (request.snapshot_token.empty()) {
+                session = open_snapshot_session(out);
+            } else {
+                NodeId id{};
+                if (SnapshotExportSession::parse_token(request.snapshot_token, id, page)) {
+                    session = find_snapshot_session(id);
+                }
+                if (!session) {
+                    snapshot_expired(out, "unknown or expired snapshot_token", false);
+                }
+            }
+            if (!session) {
+                return out;
+            }
+            std::vector<std::uint8_t> chunk;
+            bool served = false;
+            bool finished = false;
+            session->run([this, &served, &finished, page, &request, &chunk, &out](MDBX_txn* txn, SnapshotExportSession::State& state) {
+                served = serve_snapshot_page(txn, state, page, request, chunk, out);
+                finished = state.finished;
+            });
+            if (finished) {
+                // Only retries of the last page remain; they need no snapshot.
+                session->end_txn();
+            }
+            if (!served) {
+                return out;
+            }
+            if (out.has_more) {
+                out.snapshot_token = SnapshotExportSession::make_token(session->id(), page + 1);
+            }
+            if (form == PullBatchForm::Encoded) {
+                out.encoded_batches.push_back(std::move(chunk));
+            } else {
+                out.batches.push_back(ChangeBatchCodec::decode_exact(chunk));
+            }
+            return out;
+        }
+
+        /// \brief Starts an export; null with \p out set when none can start.
+        std::shared_ptr<SnapshotExportSession> open_snapshot_session(PullResponse& out) {
+            const std::shared_ptr<SnapshotSessionTable> table = m_snapshot_sessions;
+            NodeId id{};
+            {
+                std::lock_guard<std::mutex> lk(table->mutex);
+                for (std::map<NodeId, std::shared_ptr<SnapshotExportSession>>::iterator it =
+                         table->sessions.begin();
+                     it != table->sessions.end();) {
+                    if (it->second->idle_for(m_snapshot_session_timeout)) {
+                        it = table->sessions.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                if (table->sessions.size() >= max_snapshot_sessions) {
+                    snapshot_expired(out, "too many full snapshot exports in progress", true);
+                    return std::shared_ptr<SnapshotExportSession>();
+                }
+                for (std::size_t i = 0; i < id.size(); i += 8) {
+                    detail::write_u64_le(table->random(), id.data() + i);
+                }
+            }
+            std::shared_ptr<SnapshotExportSession> session =
+                std::make_shared<SnapshotExportSession>(m_conn->env_handle(), id);
+            session->run([this](MDBX_txn* txn, SnapshotExportSession::State& state) {
+                init_snapshot_export(txn, state);
+            });
+            std::lock_guard<std::mutex> lk(table->mutex);
+            if (table->sessions.size() >= max_snapshot_sessions) {
+                snapshot_expired(out, "too many full snapshot exports in progress", true);
+                return std::shared_ptr<SnapshotExportSession>();
+            }
+            table->sessions[id] = session;
+            return session;
+        }
+
+        /// \brief Returns the export named by \p id; null when it is gone.
+        std::shared_ptr<SnapshotExportSession> find_snapshot_session(const NodeId& id) const {
+            std::lock_guard<std::mutex> lk(m_snapshot_sessions->mutex);
+            std::map<NodeId, std::shared_ptr<SnapshotExportSession>>::const_iterator it =
+                m_snapshot_sessions->sessions.find(id);
+            return it == m_snapshot_sessions->sessions.end()
+                       ? std::shared_ptr<SnapshotExportSession>()
+                       : it->second;
+        }
+
+        static void snapshot_expired(PullResponse& out, const char* error, bool retryable) {
+            out.ok = false;
+            out.error = error;
+            out.error_code = SyncResponseErrorCode::SnapshotExpired;
+            out.error_retryable = retryable;
+        }
+
+        /// \brief Reads the source, cursor and table list of a new export.
+        /// \details The cursor is the applied cursor plus the local tail, so
+        /// it names every batch the snapshot's data reflects.
+        void init_snapshot_export(MDBX_txn* txn, SnapshotExportSession::State& state) const {
+            MetaStore meta(m_conn->env_handle());
+            meta.open(txn);
+            state.source = meta.get_node_id(txn);
+            state.snapshot_cursor = read_applied_cursor(txn, SyncCursor());
+            const std::uint64_t local_seq = meta.get_local_seq(txn);
+            if (local_seq != 0) {
+                state.snapshot_cursor.last_seq_by_origin[state.source] = local_seq;
+            }
+            collect_snapshot_tables(txn, state.tables);
+        }
+
+        /// \brief Lists the named user DBIs of \p txn in name order.
+        /// \details Main DBI records that are not sub-databases, and names
+        /// that are empty, hold NUL or are reserved, are skipped.
+        static void collect_snapshot_tables(MDBX_txn* txn,
+                                            std::vector<SnapshotExportSession::Table>& tables) {
+            MDBX_dbi main_dbi = 0;
+            check_mdbx(mdbx_dbi_open(txn, nullptr, static_cast<MDBX_db_flags_t>(0), &main_dbi),
+                       "SyncEngine: failed to open the main DBI for a snapshot");
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, main_dbi, &raw),
+                       "SyncEngine: failed to open a cursor on the main DBI");
+            CursorGuard guard(raw);
+            MDBX_val k, v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT)) {
+                SnapshotExportSession::Table table;
+                table.name.assign(static_cast<const char*>(k.iov_base), k.iov_len);
+                if (table.name.empty() || table.name.find('\0') != std::string::npos ||
+                    is_reserved_dbi_name(table.name)) {
+                    continue;
+                }
+                const int open_rc = mdbx_dbi_open(txn, table.name.c_str(), MDBX_DB_ACCEDE,
+                                                  &table.dbi);
+                if (open_rc == MDBX_NOTFOUND || open_rc == MDBX_INCOMPATIBLE) {
+                    continue;
+                }
+                check_mdbx(open_rc, "SyncEngine: failed to open user DBI '" + table.name +
+                                        "' for a snapshot");
+                unsigned raw_flags = 0;
+                check_mdbx(mdbx_dbi_flags(txn, table.dbi, &raw_flags),
+                           "SyncEngine: failed to read flags of user DBI '" + table.name + "'");
+                table.flags = persistent_dbi_flags(raw_flags);
+                tables.push_back(table);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "SyncEngine: failed to list user DBIs for a snapshot");
+            }
+        }
+
+        /// \brief Puts page \p page of an export into \p chunk and \p out.
+        /// \return \c false with \p out set to the error.
+        static bool serve_snapshot_page(MDBX_txn* txn,
+                                        SnapshotExportSession::State& state,
+                                        std::uint64_t page,
+                                        const PullRequest& request,
+                                        std::vector<std::uint8_t>& chunk,
+                                        PullResponse& out) {
+            if (page + 1 != state.next_page || state.last_chunk.empty()) {
+                if (page != state.next_page || state.finished || txn == nullptr) {
+                    snapshot_expired(out, "snapshot_token does not name the next page", false);
+                    return false;
+                }
+                if (!build_snapshot_chunk(txn, state, request, out)) {
+                    state.finished = true;
+                    state.last_chunk.clear();
+                    return false;
+                }
+            }
+            chunk = state.last_chunk;
+            out.remote_have = state.snapshot_cursor;
+            out.remote_tail = state.snapshot_cursor;
+            out.remote_tail_known = true;
+            out.has_more = !state.finished;
+            return true;
+        }
+
+        /// \brief Encodes the next chunk of an export into \c state.last_chunk.
+        /// \details Fills up to \c request.max_bytes, capped by
+        /// \c max_single_batch_bytes, and up to the codec's op limit. The
+        /// cursor stays on an entry that did not fit, so the next page starts
+        /// with it.
+        /// \return \c false with \c BatchTooLarge when one entry alone
+        ///         exceeds \c request.max_single_batch_bytes.
+        static bool build_snapshot_chunk(MDBX_txn* txn,
+                                         SnapshotExportSession::State& state,
+                                         const PullRequest& request,
+                                         PullResponse& out) {
+            const std::size_t limit = request.max_single_batch_bytes;
+            const std::size_t budget = (std::min)(limit, request.max_bytes);
+            const std::size_t max_ops = CodecBounds().max_ops_per_batch;
+            std::vector<std::uint8_t> bytes(ChangeBatchCodec::header_size());
+            ChangeBatchCodec::NameDictionary names;
+            std::uint32_t ops = 0;
+            if (!state.manifest_sent) {
+                for (std::size_t i = 0; i < state.tables.size(); ++i) {
+                    ChangeBatchCodec::append_op(bytes, names, ChangeOpType::ClearTable,
+                                                state.tables[i].flags, state.tables[i].name,
+                                                nullptr, 0, nullptr, 0);
+                    ++ops;
+                }
+                state.manifest_sent = true;
+            }
+            while (state.table_index < state.tables.size() && ops < max_ops &&
+                   bytes.size() <= limit) {
+                const SnapshotExportSession::Table& table = state.tables[state.table_index];
+                MDBX_val k, v;
+                int rc = MDBX_SUCCESS;
+                if (state.reader == nullptr) {
+                    check_mdbx(mdbx_cursor_open(txn, table.dbi, &state.reader),
+                               "SyncEngine: failed to open a snapshot cursor on '" +
+                                   table.name + "'");
+                    rc = mdbx_cursor_get(state.reader, &k, &v, MDBX_FIRST);
+                } else {
+                    rc = mdbx_cursor_get(state.reader, &k, &v,
+                                         state.positioned ? MDBX_GET_CURRENT : MDBX_NEXT);
+                }
+                if (rc == MDBX_NOTFOUND) {
+                    mdbx_cursor_close(state.reader);
+                    state.reader = nullptr;
+                    state.positioned = false;
+                    ++state.table_index;
+                    continue;
+                }
+                check_mdbx(rc, "SyncEngine: snapshot read failed on '" + table.name + "'");
+                state.positioned = true;
+                const std::size_t bytes_before = bytes.size();
+                const std::size_t names_before = names.names.size();
+                ChangeBatchCodec::append_op(bytes, names, ChangeOpType::Put, table.flags,
+                                            table.name, k.iov_base, k.iov_len,
+                                            v.iov_base, v.iov_len);
+                if (ops != 0 && bytes.size() > budget) {
+                    bytes.resize(bytes_before);
+                    names.names.resize(names_before);
+                    break;
+                }
+                ++ops;
+                state.positioned = false;
+            }
+            if (bytes.size() > limit) {
+                out.ok = false;
+                out.error = "snapshot entry exceeds max_single_batch_bytes";
+                out.error_code = SyncResponseErrorCode::BatchTooLarge;
+                return false;
+            }
+            state.finished = state.table_index >= state.tables.size();
+            ChangeBatchCodec::write_header(&bytes[0],
+                                           state.finished ? BATCH_NONE : BATCH_HAS_MORE,
+                                           state.source, 0, 0, ops);
+            std::vector<std::uint8_t> packed;
+            if (request.accept_compressed_batches &&
+                ChangeBatchCodec::compress(bytes, packed)) {
+                bytes.swap(packed);
+            }
+            state.last_chunk.swap(bytes);
+            ++state.next_page;
+            return true;
+        }
+
+        /// \brief Decodes and checks a snapshot page without the writer.
+        /// \return \c false with \p error set when the page cannot be applied.
+        static bool prepare_snapshot_page(const PullResponse& page,
+                                          bool first_page,
+                                          SnapshotPage& out,
+                                          std::string& error) {
+            out.count = page.batches.size() + page.encoded_batches.size();
+            if (out.count == 0) {
+                error = "snapshot page carries no chunk";
+                return false;
+            }
+            for (std::size_t i = 0; i < out.count; ++i) {
+                NodeId origin{};
+                std::uint64_t seq = 0;
+                std::uint32_t flags = 0;
+                const std::size_t first_op = out.ops.size();
+                if (i < page.batches.size()) {
+                    const ChangeBatch& batch = page.batches[i];
+                    origin = batch.origin_node_id;
+                    seq = batch.seq;
+                    flags = batch.batch_flags;
+                    for (std::size_t j = 0; j < batch.ops.size(); ++j) {
+                        out.ops.push_back(view_of(batch.ops[j]));
+                    }
+                } else {
+                    const ChangeBatchView view(page.encoded_batches[i - page.batches.size()]);
+                    origin = view.origin_node_id();
+                    seq = view.seq();
+                    flags = view.batch_flags();
+                    out.readers.emplace_back(new ChangeBatchCodec::Reader(view.ops()));
+                    std::vector<ChangeOpView> ops;
+                    read_op_views(view, *out.readers.back(), ops);
+                    out.ops.insert(out.ops.end(), ops.begin(), ops.end());
+                }
+                if (seq != 0) {
+                    error = "snapshot chunk has a non-zero seq";
+                    return false;
+                }
+                if (i == 0) {
+                    out.source = origin;
+                } else if (compare_node_id(origin, out.source) != 0) {
+                    error = "snapshot chunks disagree on the source";
+                    return false;
+                }
+                const bool more = (flags & BATCH_HAS_MORE) != 0;
+                if (more != (i + 1 < out.count || page.has_more)) {
+                    error = "snapshot chunk HAS_MORE flag disagrees with the page";
+                    return false;
+                }
+                for (std::size_t j = first_op; j < out.ops.size(); ++j) {
+                    const ChangeOpType type = out.ops[j].op_type;
+                    if (type != ChangeOpType::Put &&
+                        (type != ChangeOpType::ClearTable || !first_page)) {
+                        error = "snapshot page holds an op other than Put or a first-page ClearTable";
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static PushResponse snapshot_import_rejected(const std::string& error) {
+            PushResponse out;
+            out.ok = false;
+            out.error = error;
+            out.error_code = SyncResponseErrorCode::ApplyConflict;
+            return out;
+        }
+
+        /// \brief Writes one snapshot op; puts are appended while keys arrive in order.
+        static void load_snapshot_op(MDBX_txn* txn,
+                                     const ChangeOpView& op,
+                                     const std::string& dbi_name,
+                                     std::unordered_map<std::string, MDBX_dbi>& cache) {
+            if (op.op_type != ChangeOpType::Put) {
+                apply_one_op(txn, op, dbi_name, cache);
+                return;
+            }
+            const MDBX_dbi dbi = resolve_user_dbi(txn, dbi_name, op.dbi_flags, cache);
+            MDBX_val k = { op.storage_key_len == 0 ? nullptr
+                                                   : const_cast<std::uint8_t*>(op.storage_key),
+                           op.storage_key_len };
+            MDBX_val v = { op.value_len == 0 ? nullptr : const_cast<std::uint8_t*>(op.value),
+                           op.value_len };
+            const MDBX_put_flags_t append =
+                (persistent_dbi_flags(op.dbi_flags) & static_cast<std::uint32_t>(MDBX_DUPSORT)) != 0
+                    ? static_cast<MDBX_put_flags_t>(MDBX_APPEND | MDBX_APPENDDUP)
+                    : MDBX_APPEND;
+            int rc = mdbx_put(txn, dbi, &k, &v, append);
+            if (rc == MDBX_EKEYMISMATCH) {
+                // Out of order for this table, e.g. it already held later
+                // keys from an import that was not finished.
+                rc = mdbx_put(txn, dbi, &k, &v, MDBX_UPSERT);
+            }
+            check_mdbx(rc, "SyncEngine: mdbx_put failed for DBI '" + dbi_name + "'");
+        }
+
+        /// \brief Makes \p tail the applied cursor, keeping \p local_node's entry.
+        void replace_applied_cursor(MDBX_txn* txn,
+                                    const SyncCursor& tail,
+                                    const NodeId& local_node) const {
+            AppliedStore applied(m_conn->env_handle());
+            applied.open(txn);
+            const SyncCursor current = read_applied_cursor(txn, SyncCursor());
+            for (OriginSeqMap::const_iterator it =
+                     current.last_seq_by_origin.begin();
+                 it != current.last_seq_by_origin.end(); ++it) {
+                if (compare_node_id(it->first, local_node) != 0 &&
+                    tail.last_seq_by_origin.find(it->first) == tail.last_seq_by_origin.end()) {
+                    applied.clear(txn, it->first);
+                }
+            }
+            for (OriginSeqMap::const_iterator it =
+                     tail.last_seq_by_origin.begin();
+                 it != tail.last_seq_by_origin.end(); ++it) {
+                if (compare_node_id(it->first, local_node) != 0) {
+                    applied.set_last_applied_seq(txn, it->first, it->second);
+                }
+            }
+        }
+
+    public:
+        /// \brief Returns retained changelog batches newer than
+        /// \c request.have.
+        /// \details Empty \c request.have replays all retained changelog
+        /// batches from seq=1 for all known origins. This is not a full
+        /// database snapshot. Non-empty cursors filter each origin
+        /// independently and still include origins missing from the cursor.
+        /// Origin discovery uses \c _mdbxc_origins when available, with a
+        /// changelog scan fallback for pre-index databases. The index is read
+        /// from an \c OriginTailCache while its version is unchanged, so a
+        /// caught-up requester is answered without walking it. Indexed origin
+        /// tails skip origins that have no new batches; changelog keys are
+        /// still used for exact \c have_seq+1 seeks so old values are not
+        /// decoded.
+        /// Origins fill the page in the order set by \ref set_pull_schedule().
+        /// Sets \c has_more=true when the walk stopped because of
+        /// \c request.max_batches or the soft page budget
+        /// \c request.max_bytes. A single retained batch may exceed
+        /// \c max_bytes but is rejected when it exceeds
+        /// \c request.max_single_batch_bytes.
+        /// With \c PullBatchForm::Encoded each changelog value is copied into
+        /// \c encoded_batches after checking only its header against the
+        /// key; ops are neither decoded nor encoded again. A batch stored
+        /// compressed for a requester without \c accept_compressed_batches
+        /// is the exception and is re-encoded plain.
+        /// A non-empty \c request.subscription drops the ops outside it;
+        /// a batch that loses ops is re-encoded plain, possibly with none.
+        /// When \c ChangeLogStore::rebuild_dbi_index() has created
+        /// \c _mdbxc_changelog_dbis, batches it does not list for a
+        /// subscribed table are sent as headers without reading their ops.
+        PullResponse pull_changelog_page(MDBX_txn* txn, MDBX_dbi dbi,
+                                        const PullRequest& request,
+                                        PullBatchForm form = PullBatchForm::Decoded) {
+            PullResponse out;
+            if (request.request_full_snapshot) {
+                out.ok = false;
+                out.error = "PullRequest::request_full_snapshot is served by handle_pull only";
+                out.error_code =
+                    SyncResponseErrorCode::UnsupportedFullSnapshot;
+                return out;
+            }
+            txn = checked_external_txn(txn, "SyncEngine::pull_changelog_page");
+            out.remote_have = read_applied_cursor(txn, out.remote_have);
+            const ChangeLogKeyspace log(
+                txn, dbi, ChangeLogKeyspace::read_layout(txn, m_conn->env_handle()));
+            const std::vector<PullOrigin> origins = collect_known_origins(txn, log);
+            out.remote_tail_known = copy_known_tail(origins, out.remote_tail);
+            for (std::size_t i = 0; i < origins.size(); ++i) {
+                if (!request_has_retained_start(log, origins[i], request,
+                                                out)) {
+                    return out;
+                }
+            }
+            std::size_t total_bytes = 0;
+            bool truncated = false;
+            PullPageScratch scratch;
+            std::unique_ptr<PullSubscriptionFilter> filter;
+            if (!request.subscription.empty()) {
+                filter.reset(new PullSubscriptionFilter(request.subscription));
+                filter->use_dbi_index(txn, m_conn->env_handle());
+            }
+            if (m_pull_schedule == PullSchedule::RoundRobin) {
+                if (pull_round_robin(log, origins, request, form, filter.get(),
+                                     scratch, out, total_bytes) && out.ok) {
+                    out.has_more = true;
+                }
+                return out;
+            }
+            for (std::size_t i = 0; i < origins.size(); ++i) {
+                if (origin_is_at_tail(origins[i], request)) {
+                    continue;
+                }
+                if (pull_origin_batches(log, origins[i].origin, request, form,
+                                        filter.get(), scratch, out, total_bytes)) {
+                    if (!out.ok) {
+                        return out;
+                    }
+                    truncated = true;
+                    break;
+                }
+            }
+            out.has_more = truncated;
+            return out;
+        }
+
+        /// \brief Handles a push request: applies each batch in order.
+        /// \details Atomic: when \c apply_batch returns \c Conflict for any
+        /// batch, the transaction is rolled back (no partial commit) and
+        /// \c ok is set to \c false. Validates \c request.db_id against the
+        /// local \c db_uuid; mismatched peers receive \c ok=false with no
+        /// side effects. \c request.encoded_batches are applied after
+        /// \c request.batches, straight from their bytes. All batches are
+        /// decoded and checked before \c sync_apply_write_guard() is taken,
+        /// on \ref set_push_prepare_threads() workers when configured, so
+        /// the writer is held only for the writes. Ops that a later
+        /// admitted op of the same push overwrites on the same key are not
+        /// written; the committed state and applied cursors match writing
+        /// every op. Batches whose \c seq the applied cursor already covers
+        /// are skipped from their header, checked against the cached
+        /// cursor before decoding; a push made only of them, or of no batch
+        /// at all, returns without a write transaction.
+        /// With \c Config::apply_write_slice_ms set, a push whose transaction
+        /// has run that long while local writers wait commits the batches
+        /// written so far and continues in a new transaction after they began
+        /// (see \ref WriterScheduler). Conflicts found before the first write
+        /// still leave nothing committed; a later one keeps the committed
+        /// slices, which \c receiver_have reports.
+        PushResponse handle_push(const PushRequest& request) {
+            PushResponse out;
+            check_status(apply_push(request, nullptr, out));
+            return out;
+        }
+
+        /// \brief Handles a push request without throwing.
+        /// \param request Push to apply, as for \ref handle_push(const PushRequest&).
+        /// \param out Response; \c error is left empty on failure, the returned
+        ///        status carries the reason instead.
+        /// \return Ok when applied, \c StatusCode::Conflict with the
+        ///         \ref apply_conflict_reason_name() as context,
+        ///         \c StatusCode::Rejected with the
+        ///         \c sync_response_error_code_name() as context, or the error
+        ///         that the throwing overload would raise.
+        Status handle_push(std::nothrow_t, const PushRequest& request, PushResponse& out) noexcept {
+            try {
+                ApplyConflictReason reason = ApplyConflictReason::None;
+                const Status status = apply_push(request, &reason, out);
+                if (!status) {
+                    return status;
+                }
+                if (out.ok) {
+                    return Status();
+                }
+                if (reason != ApplyConflictReason::None) {
+                    return Status(StatusCode::Conflict, apply_conflict_reason_name(reason));
+                }
+                return Status(StatusCode::Rejected, sync_response_error_code_name(out.error_code));
+            } catch (...) {
+                return Status::from_current_exception();
+            }
+        }
+
+        /// \brief Returns the current applied cursor across all known origins.
+        /// \details Served from \ref applied_cursor_cache() while no
+        /// transaction committed since it was filled, without opening one.
+        /// Otherwise a read transaction checks the store version and walks
+        /// the store only when that changed too.
+        SyncCursor applied_cursor() const {
+            SyncCursor cur;
+            if (m_applied_cache->lookup(m_conn->last_txn_id(), cur)) {
+                return cur;
+            }
+            auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
+            return cached_applied_cursor(txn.handle());
+        }
+
+        /// \brief Reads the applied cursor using the caller-supplied txn.
+        /// \details Used inside \c handle_pull to avoid opening a second
+        /// sticky-thread transaction on the same thread. Write transactions
+        /// bypass the cache, which only holds committed versions.
+        SyncCursor applied_cursor(MDBX_txn* txn) const {
+            txn = checked_external_txn(txn, "SyncEngine::applied_cursor");
+            if ((mdbx_txn_flags(txn) & MDBX_TXN_RDONLY) == 0) {
+                return read_applied_cursor(txn, SyncCursor());
+            }
+            return cached_applied_cursor(txn);
+        }
+
+        /// \brief Returns the cache behind \ref applied_cursor().
+        std::shared_ptr<AppliedCursorCache> applied_cursor_cache() const {
+            return m_applied_cache;
+        }
+
+        /// \brief Builds a \c PushRequest that carries every local batch with
+        /// \c seq in \c [from_seq, to_seq] (inclusive).
+        /// \details Hides the system stores from callers: example code and
+        /// future transports can call this instead of touching
+        /// \c MetaStore / \c ChangeLogStore directly. The sender is always
+        /// the local node id (derived from \c _mdbxc_meta); sending batches
+        /// of other origins is not supported at this layer.
+        ///
+        /// Opens its own short-lived read-only transaction on the bound
+        /// connection. The caller must not have another active transaction
+        /// for the same connection on the current thread (Mdbx would return
+        /// \c MDBX_BUSY). Right after a writable commit is fine.
+        /// \param from_seq First \c seq to include (use 1 to send from the
+        /// beginning; use the peer's \c applied_cursor + 1 to send a delta).
+        /// \param to_seq Last \c seq to include (use 0 to send up to the
+        /// current local tail, inclusive).
+        /// \return A \c PushRequest ready to send to the peer. Empty
+        /// \c batches when the requested range is empty (or past the tail).
+        /// \throws std::runtime_error if the requested range is not
+        /// contiguous in the local changelog (a hole means pruning,
+        /// corruption, or a wrong origin).
+        /// \throws MdbxException on database error.
+        PushRequest make_push_request(std::uint64_t from_seq,
+                                      std::uint64_t to_seq) const {
+            PushRequest req;
+            req.db_id  = db_uuid();
+            if (to_seq != 0 && to_seq < from_seq) return req;
+            auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
+            MetaStore meta(m_conn->env_handle());
+            meta.open(txn.handle());
+            ChangeLogStore log(m_conn->env_handle());
+            log.open(txn.handle());
+            req.sender = meta.get_node_id(txn.handle());
+            if (to_seq == 0) {
+                to_seq = meta.get_local_seq(txn.handle());
+            }
+            if (to_seq < from_seq) return req;
+            std::vector<std::uint8_t> buf;
+            for (std::uint64_t s = from_seq;; ++s) {
+                if (!log.get(txn.handle(), req.sender, s, buf)) {
+                    throw std::runtime_error(
+                        "SyncEngine::make_push_request: changelog gap at seq " +
+                        std::to_string(s) +
+                        " (pruning, corruption, or wrong origin)");
+                }
+                req.batches.push_back(ChangeBatchCodec::decode_exact(buf));
+                // The receiver's codec support is unknown until it answers.
+                req.batches.back().batch_flags &=
+                    ~static_cast<std::uint32_t>(BATCH_COMPRESSED_ZSTD);
+                if (s == to_seq) break;
+            }
+            return req;
+        }
+
+        /// \brief Records that \p peer has the batches named by \p have.
+        /// \details Feeds acknowledged pruning in \ref prune_changelog().
+        /// \c handle_pull() calls it with each requester's \c have; a node
+        /// that pushes can pass the \c receiver_have of each \c PushResponse.
+        /// Reports are kept in memory and written to \c _mdbxc_peers by the
+        /// next prune, so this never takes the writer. A zero \p peer is
+        /// ignored, and so are new peers while reports from
+        /// \c max_pending_watermarks peers wait for a prune.
+        /// \thread_safety Thread-safe.
+        void note_peer_have(const NodeId& peer, const SyncCursor& have) {
+            const NodeId zero{};
+            if (compare_node_id(peer, zero) == 0) {
+                return;
+            }
+            std::lock_guard<std::mutex> lk(m_peer_watermarks->mutex);
+            std::map<NodeId, PendingWatermark>& pending = m_peer_watermarks->pending;
+            if (pending.size() >= max_pending_watermarks && pending.find(peer) == pending.end()) {
+                return;
+            }
+            PendingWatermark& entry = pending[peer];
+            for (OriginSeqMap::const_iterator it =
+                     have.last_seq_by_origin.begin();
+                 it != have.last_seq_by_origin.end(); ++it) {
+                entry.have.last_seq_by_origin[it->first] = it->second;
+            }
+            entry.seen_unix_ms = unix_time_ms();
+            ++entry.version;
+        }
+
+        /// \brief Returns the tracked peers and what each last reported.
+        /// \details Includes reports that no prune has written yet.
+        std::vector<PeerWatermarkStore::PeerWatermark> peer_watermarks() const {
+            std::map<NodeId, PeerWatermarkStore::PeerWatermark> by_peer;
+            {
+                auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
+                if (open_store_ro(txn.handle(), "_mdbxc_peers") != 0) {
+                    PeerWatermarkStore store(m_conn->env_handle());
+                    store.open(txn.handle());
+                    const std::vector<PeerWatermarkStore::PeerWatermark> stored =
+                        store.peers(txn.handle());
+                    for (std::size_t i = 0; i < stored.size(); ++i) {
+                        by_peer[stored[i].peer] = stored[i];
+                    }
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lk(m_peer_watermarks->mutex);
+                for (std::map<NodeId, PendingWatermark>::const_iterator it =
+                         m_peer_watermarks->pending.begin();
+                     it != m_peer_watermarks->pending.end(); ++it) {
+                    PeerWatermarkStore::PeerWatermark& mark = by_peer[it->first];
+                    mark.peer = it->first;
+                    for (OriginSeqMap::const_iterator seq =
+                             it->second.have.last_seq_by_origin.begin();
+                         seq != it->second.have.last_seq_by_origin.end(); ++seq) {
+                        mark.have.last_seq_by_origin[seq->first] = seq->second;
+                    }
+                    if (it->second.seen_unix_ms > mark.seen_unix_ms) {
+                        mark.seen_unix_ms = it->second.seen_unix_ms;
+                    }
+                }
+            }
+            std::vector<PeerWatermarkStore::PeerWatermark> out;
+            out.reserve(by_peer.size());
+            for (std::map<NodeId, PeerWatermarkStore::PeerWatermark>::const_iterator it =
+                     by_peer.begin();
+                 it != by_peer.end(); ++it) {
+                out.push_back(it->second);
+            }
+            return out;
+        }
+
+        /// \brief Forgets \p peer, so it no longer holds back pruning.
+        /// \return \c true when the peer was tracked.
+        bool forget_peer(const NodeId& peer) {
+            bool pending = false;
+            {
+                std::lock_guard<std::mutex> lk(m_peer_watermarks->mutex);
+                pending = m_peer_watermarks->pending.erase(peer) != 0;
+            }
+            auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+            PeerWatermarkStore store(m_conn->env_handle());
+            store.open(txn.handle());
+            const std::size_t removed = store.forget(txn.handle(), peer);
+            txn.commit();
+            return pending || removed != 0;
+        }
+
+        /// \brief Removes the changelog batches \p policy allows.
+        /// \details First writes the peer reports gathered since the last
+        /// call to \c _mdbxc_peers and forgets peers silent for longer than
+        /// \c policy.peer_timeout. Then, per origin, removes the oldest
+        /// batches that every tracked peer has or that are older than
+        /// \c policy.max_age, and last the oldest batches of any origin while
+        /// the changelog is larger than \c policy.max_bytes. Works in write
+        /// transactions of at most \c policy.max_batches_per_txn removals and
+        /// checks \p cancel_token between them, so other writers wait for at
+        /// most one such transaction. Origin tails in \c _mdbxc_origins are
+        /// kept, so pulls still report them after every batch is pruned.
+        /// \throws std::invalid_argument when \p policy is invalid.
+        /// \throws MdbxException on database error.
+        ChangeLogPruneResult prune_changelog(const ChangeLogRetention& policy,
+                                             const CancellationToken& cancel_token =
+                                                 CancellationToken()) {
+            policy.validate();
+            ChangeLogPruneResult result;
+            std::map<NodeId, PendingWatermark> reports;
+            {
+                std::lock_guard<std::mutex> lk(m_peer_watermarks->mutex);
+                reports = m_peer_watermarks->pending;
+            }
+            bool more = prune_changelog_txn(policy, reports, result);
+            {
+                // Reports that changed meanwhile wait for the next prune.
+                std::lock_guard<std::mutex> lk(m_peer_watermarks->mutex);
+                for (std::map<NodeId, PendingWatermark>::const_iterator it = reports.begin();
+                     it != reports.end(); ++it) {
+                    std::map<NodeId, PendingWatermark>::iterator pending =
+                        m_peer_watermarks->pending.find(it->first);
+                    if (pending != m_peer_watermarks->pending.end() &&
+                        pending->second.version == it->second.version) {
+                        m_peer_watermarks->pending.erase(pending);
+                    }
+                }
+            }
+            reports.clear();
+            while (more && !cancel_token.is_cancellation_requested()) {
+                more = prune_changelog_txn(policy, reports, result);
+            }
+            return result;
+        }
+
+        /// \brief Drops superseded ops from older changelog batches.
+        /// \details For each origin, walks from the batch \c policy.keep_recent
+        /// below its tail down to its oldest one. An op is dropped when a
+        /// later op of the same origin writes the same
+        /// \c (dbi_name, storage_key), or a later \c ClearTable clears its
+        /// DBI. Ops of \c MDBX_DUPSORT tables, where a put adds a value
+        /// instead of replacing it, are only dropped by \c ClearTable.
+        /// Batches keep their \c seq, time and compression, so pulls and
+        /// the applied cursors of peers are unaffected; a lagging replica
+        /// just replays fewer ops to reach the same state. Works in write
+        /// transactions of at most \c policy.max_batches_per_txn batches and
+        /// checks \p cancel_token between them. Calls must not overlap.
+        /// \throws std::invalid_argument when \p policy is invalid.
+        /// \throws MdbxException on database error.
+        ChangeLogCompactResult compact_changelog(const ChangeLogCompaction& policy,
+                                                 const CancellationToken& cancel_token =
+                                                     CancellationToken()) {
+            policy.validate();
+            ChangeLogCompactResult result;
+            std::vector<PullOrigin> origins;
+            {
+                // Opening the index backfills it for a legacy changelog, so
+                // every origin comes with its tail.
+                auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+                ChangeLogStore log(m_conn->env_handle());
+                log.open(txn.handle());
+                log.origin_index_txnid(txn.handle());
+                origins = collect_known_origins(txn.handle(), log.keyspace(txn.handle()));
+                txn.commit();
+            }
+            for (std::size_t i = 0; i < origins.size(); ++i) {
+                if (!origins[i].has_last_seq || origins[i].last_seq <= policy.keep_recent) {
+                    continue;
+                }
+                CompactionState state;
+                state.next_seq = origins[i].last_seq - policy.keep_recent;
+                while (state.next_seq != 0) {
+                    if (cancel_token.is_cancellation_requested()) {
+                        return result;
+                    }
+                    compact_changelog_txn(policy, origins[i].origin, state, result);
+                }
+            }
+            return result;
+        }
+
+    private:
+        struct BatchDbiFlags {
+            std::string name;
+            std::uint32_t flags;
+        };
+
+        /// \brief Pushed batch decoded and checked before the writer is taken.
+        struct PreparedBatch {
+            NodeId origin_node_id{};
+            std::uint64_t seq = 0;
+            std::unique_ptr<ChangeBatchCodec::Reader> reader; // owns ops of a compressed batch
+            std::vector<ChangeOpView> ops;
+            std::vector<BatchDbiFlags> dbis;
+            ApplyOutcome dbi_conflict;       // Conflict when the ops disagree on DBI flags
+            std::exception_ptr header_error; // rethrown when the batch is reached
+            std::exception_ptr ops_error;    // rethrown only if the batch is admitted
+            ApplyOutcome outcome;            // set by admit_prepared(), then the write
+            bool replayed = false;           // seq already applied; ops not decoded
+            bool admitted = false;           // ops are written by this push
+            std::vector<bool> superseded;    // ops a later op of this push overwrites
+        };
+
+        /// \brief Origin each requester's next round-robin page starts at.
+        struct PullResumeTable {
+            std::mutex mutex;
+            std::map<NodeId, NodeId> next_origin;
+        };
+
+        /// \brief Requesters remembered by \c PullResumeTable before it is reset.
+        static const std::size_t max_pull_resume_entries = 4096;
+
+        /// \brief Peer report not yet written to \c _mdbxc_peers.
+        struct PendingWatermark {
+            SyncCursor have;
+            std::uint64_t seen_unix_ms = 0;
+            std::uint64_t version = 0; ///< Bumped by each report.
+        };
+
+        /// \brief Peer reports gathered between prunes.
+        struct PeerWatermarkTable {
+            std::mutex mutex;
+            std::map<NodeId, PendingWatermark> pending;
+        };
+
+        /// \brief Peers whose reports wait for a prune before new ones are ignored.
+        static const std::size_t max_pending_watermarks = 4096;
+
+        /// \brief One prune write transaction.
+        /// \return \c true when it stopped at \c max_batches_per_txn.
+        bool prune_changelog_txn(const ChangeLogRetention& policy,
+                                 const std::map<NodeId, PendingWatermark>& reports,
+                                 ChangeLogPruneResult& result) {
+            auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+            PeerWatermarkStore peers(m_conn->env_handle());
+            peers.open(txn.handle());
+            for (std::map<NodeId, PendingWatermark>::const_iterator it = reports.begin();
+                 it != reports.end(); ++it) {
+                peers.record(txn.handle(), it->first, it->second.have, it->second.seen_unix_ms);
+            }
+            std::vector<PeerWatermarkStore::PeerWatermark> marks = peers.peers(txn.handle());
+            if (policy.peer_timeout.count() > 0) {
+                const std::uint64_t now_ms = unix_time_ms();
+                const std::uint64_t timeout_ms =
+                    static_cast<std::uint64_t>(policy.peer_timeout.count());
+                std::vector<PeerWatermarkStore::PeerWatermark> live;
+                for (std::size_t i = 0; i < marks.size(); ++i) {
+                    if (marks[i].seen_unix_ms < now_ms && now_ms - marks[i].seen_unix_ms > timeout_ms) {
+                        peers.forget(txn.handle(), marks[i].peer);
+                        ++result.peers_forgotten;
+                    } else {
+                        live.push_back(marks[i]);
+                    }
+                }
+                marks.swap(live);
+            }
+
+            ChangeLogStore log(m_conn->env_handle());
+            log.open(txn.handle());
+            const std::vector<PullOrigin> origins =
+                collect_known_origins(txn.handle(), log.keyspace(txn.handle()));
+            std::size_t budget = policy.max_batches_per_txn;
+            std::uint64_t cutoff_ns = 0;
+            if (policy.max_age.count() > 0) {
+                const std::uint64_t now_ns = unix_time_ns();
+                const std::uint64_t age_ns = static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(policy.max_age).count());
+                cutoff_ns = now_ns > age_ns ? now_ns - age_ns : 0;
+            }
+            std::uint64_t seq = 0;
+            MDBX_val value;
+            for (std::size_t i = 0; i < origins.size() && budget != 0; ++i) {
+                const NodeId& origin = origins[i].origin;
+                const std::uint64_t acked =
+                    policy.prune_acknowledged ? acknowledged_seq(marks, origin) : 0;
+                while (budget != 0 && log.first(txn.handle(), origin, seq, value)) {
+                    const std::uint64_t time_ns = batch_time_unix_ns(value);
+                    if (seq > acked && (time_ns == 0 || time_ns >= cutoff_ns)) {
+                        break;
+                    }
+                    result.bytes_removed += 24u + value.iov_len;
+                    log.erase(txn.handle(), origin, seq);
+                    ++result.batches_removed;
+                    --budget;
+                }
+            }
+            if (policy.max_bytes != 0 && budget != 0) {
+                const std::uint64_t stored = log.stored_bytes(txn.handle());
+                std::uint64_t excess = stored > policy.max_bytes ? stored - policy.max_bytes : 0;
+                while (excess != 0 && budget != 0) {
+                    // Oldest head across origins; unstamped batches go first.
+                    const NodeId* oldest = nullptr;
+                    std::uint64_t oldest_seq = 0;
+                    std::uint64_t oldest_time = 0;
+                    for (std::size_t i = 0; i < origins.size(); ++i) {
+                        if (!log.first(txn.handle(), origins[i].origin, seq, value)) {
+                            continue;
+                        }
+                        const std::uint64_t time_ns = batch_time_unix_ns(value);
+                        if (oldest == nullptr || time_ns < oldest_time) {
+                            oldest = &origins[i].origin;
+                            oldest_seq = seq;
+                            oldest_time = time_ns;
+                        }
+                    }
+                    if (oldest == nullptr) {
+                        break;
+                    }
+                    log.first(txn.handle(), *oldest, seq, value);
+                    const std::uint64_t bytes = 24u + value.iov_len;
+                    result.bytes_removed += bytes;
+                    log.erase(txn.handle(), *oldest, oldest_seq);
+                    ++result.batches_removed;
+                    --budget;
+                    excess = bytes >= excess ? 0 : excess - bytes;
+                }
+            }
+            txn.commit();
+            ++result.transactions;
+            return budget == 0;
+        }
+
+        /// \brief Keys and DBIs written by ops already seen in a walk from
+        /// the newest op back to older ones.
+        struct LaterWrites {
+            std::unordered_set<std::string> written;  ///< Keys a later op writes.
+            std::unordered_set<std::string> cleared;  ///< DBIs a later op clears.
+
+            /// \brief Records an op; returns \c false when a later op already
+            /// makes it redundant.
+            /// \details Ops of \c MDBX_DUPSORT tables add values rather than
+            /// replace them, so only \c ClearTable supersedes them. \c Merge
+            /// ops are superseded like puts but do not supersede older ops.
+            bool note(ChangeOpType op_type, std::uint32_t dbi_flags,
+                      const char* dbi_name, std::size_t dbi_name_len,
+                      const std::uint8_t* storage_key, std::size_t storage_key_len) {
+                const std::string name(dbi_name, dbi_name_len);
+                if (cleared.count(name) != 0) {
+                    return false;
+                }
+                if (op_type == ChangeOpType::ClearTable) {
+                    cleared.insert(name);
+                    return true;
+                }
+                if ((dbi_flags & MDBX_DUPSORT) != 0) {
+                    return true;
+                }
+                const std::string key = dbi_key_string(dbi_name, dbi_name_len,
+                                                       storage_key, storage_key_len);
+                if (op_type == ChangeOpType::Merge) {
+                    // A merge builds on the older value, so it supersedes nothing.
+                    return written.count(key) == 0;
+                }
+                return written.insert(key).second;
+            }
+        };
+
+        /// \brief Position of a compaction walk down one origin.
+        struct CompactionState {
+            std::uint64_t next_seq = 0; ///< Batch read next; 0 when done.
+            LaterWrites later;
+        };
+
+        /// \brief One compaction write transaction.
+        void compact_changelog_txn(const ChangeLogCompaction& policy,
+                                   const NodeId& origin,
+                                   CompactionState& state,
+                                   ChangeLogCompactResult& result) {
+            auto txn = m_conn->transaction(TransactionMode::WRITABLE);
+            ChangeLogStore log(m_conn->env_handle());
+            log.open(txn.handle());
+            std::vector<std::uint8_t> bytes;
+            for (std::size_t n = 0; n < policy.max_batches_per_txn && state.next_seq != 0; ++n) {
+                const std::uint64_t seq = state.next_seq--;
+                if (!log.get(txn.handle(), origin, seq, bytes)) {
+                    state.next_seq = 0; // pruned from here down
+                    break;
+                }
+                ChangeBatch batch = ChangeBatchCodec::decode(bytes);
+                const std::size_t kept = drop_superseded_ops(batch.ops, state);
+                if (kept != batch.ops.size()) {
+                    result.ops_removed += batch.ops.size() - kept;
+                    batch.ops.resize(kept);
+                    const std::vector<std::uint8_t> compacted = ChangeBatchCodec::encode(batch);
+                    log.replace(txn.handle(), origin, seq, compacted);
+                    ++result.batches_rewritten;
+                    if (compacted.size() < bytes.size()) {
+                        result.bytes_saved += bytes.size() - compacted.size();
+                    }
+                }
+                if (state.later.written.size() > policy.max_tracked_keys) {
+                    state.next_seq = 0;
+                }
+            }
+            txn.commit();
+            ++result.transactions;
+        }
+
+        /// \brief Moves the ops no later op supersedes to the front of \p ops,
+        /// in order, and records what they write in \p state.
+        /// \return Number of ops kept.
+        static std::size_t drop_superseded_ops(std::vector<ChangeOp>& ops,
+                                               CompactionState& state) {
+            std::vector<bool> keep(ops.size(), false);
+            for (std::size_t i = ops.size(); i-- > 0;) {
+                const ChangeOp& op = ops[i];
+                keep[i] = state.later.note(op.op_type, op.dbi_flags,
+                                           op.dbi_name.data(), op.dbi_name.size(),
+                                           op.storage_key.data(), op.storage_key.size());
+            }
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < ops.size(); ++i) {
+                if (keep[i]) {
+                    if (kept != i) {
+                        ops[kept] = std::move(ops[i]);
+                    }
+                    ++kept;
+                }
+            }
+            return kept;
+        }
+
+        /// \brief Lowest \c seq of \p origin that every peer in \p marks has.
+        static std::uint64_t acknowledged_seq(
+                const std::vector<PeerWatermarkStore::PeerWatermark>& marks,
+                const NodeId& origin) {
+            if (marks.empty()) {
+                return 0;
+            }
+            std::uint64_t acked = (std::numeric_limits<std::uint64_t>::max)();
+            for (std::size_t i = 0; i < marks.size(); ++i) {
+                acked = (std::min)(acked, marks[i].have.last_seq_for(origin));
+            }
+            return acked;
+        }
+
+        /// \brief Creation time of a stored batch; 0 when it has none.
+        static std::uint64_t batch_time_unix_ns(const MDBX_val& value) {
+            const ChangeBatchView view(static_cast<const std::uint8_t*>(value.iov_base),
+                                       value.iov_len);
+            return view.time_unix_ns();
+        }
+
+        static std::uint64_t unix_time_ms() {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+        }
+
+        static std::uint64_t unix_time_ns() {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+        }
+
+        struct CursorGuard {
+            explicit CursorGuard(MDBX_cursor* cursor) : raw(cursor) {}
+            ~CursorGuard() { if (raw) mdbx_cursor_close(raw); }
+            CursorGuard(const CursorGuard&) = delete;
+            CursorGuard& operator=(const CursorGuard&) = delete;
+
+            MDBX_cursor* raw;
+        };
+
+        /// \brief Returns true when \p request_db_id matches the local
+        /// \c db_uuid. A zero \p request_db_id is rejected: callers must
+        /// know the database identity before issuing pull/push requests.
+        bool db_id_matches(const NodeId& request_db_id) const {
+            const NodeId zero{};
+            if (compare_node_id(request_db_id, zero) == 0) return false;
+            return compare_node_id(request_db_id, db_uuid()) == 0;
+        }
+
+        static ApplyOutcome make_apply_outcome(ApplyResult result,
+                                               const ChangeBatch& batch,
+                                               std::uint64_t last_applied_seq) {
+            ApplyOutcome outcome;
+            outcome.result = result;
+            outcome.conflict_reason = ApplyConflictReason::None;
+            outcome.origin_node_id = batch.origin_node_id;
+            outcome.last_applied_seq = last_applied_seq;
+            outcome.batch_seq = batch.seq;
+            return outcome;
+        }
+
+        /// \brief Applies \p batch; \p ops receives views of its ops.
+        ApplyOutcome apply_changes(MDBX_txn* txn,
+                                   const ChangeBatch& batch,
+                                   std::vector<ChangeOpView>& ops) {
+            MDBXC_TRACE_SCOPE(SyncApply);
+            txn = checked_external_txn(txn, "SyncEngine::apply_batch_ex");
+            ApplyOutcome outcome = make_apply_outcome(ApplyResult::Applied, batch, 0);
+            ops.clear();
+            AppliedStore applied(m_conn->env_handle());
+            if (!admit_batch(txn, applied, outcome)) {
+                return outcome;
+            }
+            ops.resize(batch.ops.size());
+            for (std::size_t i = 0; i < batch.ops.size(); ++i) {
+                ops[i] = view_of(batch.ops[i]);
+            }
+            apply_op_views(txn, applied, ops, outcome);
+            return outcome;
+        }
+
+        /// \brief Applies an encoded batch; \p ops receives views into
+        /// \p reader, which must stay alive while they are used.
+        ApplyOutcome apply_encoded(MDBX_txn* txn,
+                                   const ChangeBatchView& batch,
+                                   ChangeBatchCodec::Reader& reader,
+                                   std::vector<ChangeOpView>& ops) {
+            MDBXC_TRACE_SCOPE(SyncApply);
+            txn = checked_external_txn(txn, "SyncEngine::apply_batch_ex");
+            ApplyOutcome outcome;
+            outcome.origin_node_id = batch.origin_node_id();
+            outcome.batch_seq = batch.seq();
+            ops.clear();
+            AppliedStore applied(m_conn->env_handle());
+            if (!admit_batch(txn, applied, outcome)) {
+                return outcome;
+            }
+            read_op_views(batch, reader, ops);
+            apply_op_views(txn, applied, ops, outcome);
+            return outcome;
+        }
+
+        /// \brief Committed applied cursor, without a transaction while
+        /// \ref applied_cursor_cache() is current.
+        /// \param version Receives the \c _mdbxc_applied version it reflects.
+        SyncCursor applied_watermark(std::uint64_t& version) const {
+            SyncCursor cur;
+            if (m_applied_cache->lookup(m_conn->last_txn_id(), cur, version)) {
+                return cur;
+            }
+            auto txn = m_conn->transaction(TransactionMode::READ_ONLY);
+            version = applied_mod_txnid(txn.handle());
+            return cached_applied_cursor(txn.handle());
+        }
+
+        /// \brief Whether every batch of a non-empty push is a replay.
+        static bool all_replayed(const std::vector<PreparedBatch>& prepared) {
+            for (std::size_t i = 0; i < prepared.size(); ++i) {
+                if (!prepared[i].replayed) {
+                    return false;
+                }
+            }
+            return !prepared.empty();
+        }
+
+        /// \brief Checks replays against the applied store of \p txn when it
+        /// changed since the watermark was read.
+        /// \details A snapshot install may lower a cursor; batches the store
+        /// no longer covers are decoded here, under the writer.
+        static void recheck_replayed(MDBX_txn* txn,
+                                     const AppliedStore& applied,
+                                     const PushRequest& request,
+                                     std::vector<PreparedBatch>& prepared) {
+            for (std::size_t i = 0; i < prepared.size(); ++i) {
+                PreparedBatch& batch = prepared[i];
+                if (batch.replayed &&
+                    batch.seq > applied.last_applied_seq(txn, batch.origin_node_id)) {
+                    batch = PreparedBatch();
+                    prepare_batch(request, i, nullptr, batch);
+                }
+            }
+        }
+
+        /// \brief Prepares every batch of \p request, in parallel when a
+        /// prepare pool is set.
+        /// \param watermark Applied cursor; batches it covers are marked
+        ///        \c replayed instead of decoded. May be null.
+        std::vector<PreparedBatch> prepare_push_batches(const PushRequest& request,
+                                                        const SyncCursor* watermark) const {
+            const std::size_t count =
+                request.batches.size() + request.encoded_batches.size();
+            std::vector<PreparedBatch> prepared(count);
+            const std::shared_ptr<mdbxc::detail::ThreadPool> pool = m_prepare_pool;
+            const std::size_t parts =
+                pool ? (std::min)(count, pool->size() + 1) : 1;
+            std::vector<std::future<void>> pending;
+            for (std::size_t p = 1; p < parts; ++p) {
+                const std::size_t begin = count * p / parts;
+                const std::size_t end = count * (p + 1) / parts;
+                std::shared_ptr<std::packaged_task<void()>> task =
+                    std::make_shared<std::packaged_task<void()>>(
+                        [&request, watermark, &prepared, begin, end]() {
+                            for (std::size_t i = begin; i < end; ++i) {
+                                prepare_batch(request, i, watermark, prepared[i]);
+                            }
+                        });
+                pending.push_back(task->get_future());
+                pool->post([task]() { (*task)(); });
+            }
+            const std::size_t own_end = parts > 1 ? count / parts : count;
+            for (std::size_t i = 0; i < own_end; ++i) {
+                prepare_batch(request, i, watermark, prepared[i]);
+            }
+            for (std::size_t p = 0; p < pending.size(); ++p) {
+                pending[p].get();
+            }
+            return prepared;
+        }
+
+        /// \brief Decodes batch \p index of \p request and collects its DBI
+        /// flags; failures are stored in \p out, never thrown.
+        /// \param watermark Applied cursor, or null; a batch it covers is
+        ///        only marked \c replayed.
+        static void prepare_batch(const PushRequest& request,
+                                  std::size_t index,
+                                  const SyncCursor* watermark,
+                                  PreparedBatch& out) {
+            bool header_read = false;
+            try {
+                if (index < request.batches.size()) {
+                    const ChangeBatch& batch = request.batches[index];
+                    out.origin_node_id = batch.origin_node_id;
+                    out.seq = batch.seq;
+                    header_read = true;
+                    if (covered_by(watermark, out)) {
+                        return;
+                    }
+                    out.ops.resize(batch.ops.size());
+                    for (std::size_t i = 0; i < batch.ops.size(); ++i) {
+                        out.ops[i] = view_of(batch.ops[i]);
+                    }
+                } else {
+                    const ChangeBatchView view(
+                        request.encoded_batches[index - request.batches.size()]);
+                    out.origin_node_id = view.origin_node_id();
+                    out.seq = view.seq();
+                    header_read = true;
+                    if (covered_by(watermark, out)) {
+                        return;
+                    }
+                    out.reader.reset(new ChangeBatchCodec::Reader(view.ops()));
+                    read_op_views(view, *out.reader, out.ops);
+                }
+                collect_batch_dbi_flags(out.ops, out.dbis, &out.dbi_conflict);
+            } catch (...) {
+                (header_read ? out.ops_error : out.header_error) =
+                    std::current_exception();
+            }
+        }
+
+        /// \brief Marks \p batch \c replayed when \p watermark covers its \c seq.
+        static bool covered_by(const SyncCursor* watermark, PreparedBatch& batch) {
+            batch.replayed = watermark != nullptr &&
+                             batch.seq <= watermark->last_seq_for(batch.origin_node_id);
+            return batch.replayed;
+        }
+
+        /// \brief Decides, with the rules of \c apply_batch_ex(), whether a
+        /// prepared batch is written; the result goes to \c batch.outcome.
+        /// \param admitted_tail Last \c seq admitted per origin in this push.
+        void admit_prepared(MDBX_txn* txn,
+                            AppliedStore& applied,
+                            PreparedBatch& batch,
+                            std::map<NodeId, std::uint64_t>& admitted_tail) const {
+            if (batch.header_error) {
+                std::rethrow_exception(batch.header_error);
+            }
+            ApplyOutcome& outcome = batch.outcome;
+            outcome.origin_node_id = batch.origin_node_id;
+            outcome.batch_seq = batch.seq;
+            if (batch.replayed) {
+                outcome.result = ApplyResult::Skipped;
+                return;
+            }
+            std::map<NodeId, std::uint64_t>::iterator tail =
+                admitted_tail.find(batch.origin_node_id);
+            if (tail == admitted_tail.end()) {
+                if (!admit_batch(txn, applied, outcome)) {
+                    return;
+                }
+            } else {
+                // Earlier batches of this push are admitted but not written yet.
+                outcome.last_applied_seq = tail->second;
+                if (batch.seq <= tail->second) {
+                    outcome.result = ApplyResult::Skipped;
+                    return;
+                }
+                if (batch.seq != tail->second + 1) {
+                    outcome.result = ApplyResult::Conflict;
+                    outcome.conflict_reason = ApplyConflictReason::SequenceGap;
+                    return;
+                }
+            }
+            if (batch.ops_error) {
+                std::rethrow_exception(batch.ops_error);
+            }
+            if (batch.dbi_conflict.result == ApplyResult::Conflict) {
+                ApplyOutcome conflict = batch.dbi_conflict;
+                conflict.origin_node_id = outcome.origin_node_id;
+                conflict.last_applied_seq = outcome.last_applied_seq;
+                conflict.batch_seq = outcome.batch_seq;
+                outcome = conflict;
+                return;
+            }
+            admitted_tail[batch.origin_node_id] = batch.seq;
+            batch.admitted = true;
+        }
+
+        /// \brief Marks superseded ops across the push, or within segments of
+        /// about \c apply_segment_ops admitted ops when \p sliced.
+        /// \return One past the last batch of each segment.
+        static std::vector<std::size_t> mark_superseded_segments(
+                std::vector<PreparedBatch>& prepared, bool sliced) {
+            std::vector<std::size_t> ends;
+            std::size_t begin = 0;
+            std::size_t ops = 0;
+            for (std::size_t i = 0; i < prepared.size(); ++i) {
+                if (prepared[i].admitted) {
+                    ops += prepared[i].ops.size();
+                }
+                if (i + 1 == prepared.size() || (sliced && ops >= apply_segment_ops)) {
+                    mark_superseded_ops(prepared, begin, i + 1);
+                    ends.push_back(i + 1);
+                    begin = i + 1;
+                    ops = 0;
+                }
+            }
+            return ends;
+        }
+
+        /// \brief Marks the ops of admitted batches in [\p begin, \p end) that
+        /// a later admitted op of that range overwrites, so their writes can
+        /// be skipped.
+        /// \details Skipped batches are not written again and so supersede
+        /// nothing.
+        static void mark_superseded_ops(std::vector<PreparedBatch>& prepared,
+                                        std::size_t begin,
+                                        std::size_t end) {
+            LaterWrites later;
+            for (std::size_t i = end; i-- > begin;) {
+                PreparedBatch& batch = prepared[i];
+                if (!batch.admitted) {
+                    continue;
+                }
+                batch.superseded.assign(batch.ops.size(), false);
+                for (std::size_t j = batch.ops.size(); j-- > 0;) {
+                    const ChangeOpView& op = batch.ops[j];
+                    batch.superseded[j] = !later.note(op.op_type, op.dbi_flags,
+                                                      op.dbi_name, op.dbi_name_len,
+                                                      op.storage_key, op.storage_key_len);
+                }
+            }
+        }
+
+        /// \brief Body of \ref handle_push().
+        /// \param reason When set, receives the conflict reason and the
+        ///        response \c error text is not built.
+        /// \param out Response; a refused or conflicting push is reported here.
+        /// \return Ok, or the MDBX error of beginning or committing an apply
+        ///         transaction, e.g. \c StatusCode::Busy, without unwinding.
+        ///         Slices committed before it are kept.
+        Status apply_push(const PushRequest& request, ApplyConflictReason* reason,
+                          PushResponse& out) {
+            out = PushResponse();
+            if (!db_id_matches(request.db_id)) {
+                out.ok = false;
+                if (!reason) {
+                    out.error = "db_id mismatch";
+                }
+                out.error_code = SyncResponseErrorCode::DbIdMismatch;
+                out.receiver_have = applied_cursor();
+                return Status();
+            }
+            SyncSpan span(SyncSpanKind::PushApply);
+            // Batches at or below the committed applied cursor are replays,
+            // e.g. relayed by several hubs; they are neither decoded nor,
+            // when the whole push is replayed, given the writer.
+            std::uint64_t watermark_version = 0;
+            const SyncCursor watermark = applied_watermark(watermark_version);
+            // Decoding and per-batch checks need no writer; finish them
+            // before the single MDBX writer is taken.
+            std::vector<PreparedBatch> prepared = prepare_push_batches(request, &watermark);
+            if (prepared.empty() || all_replayed(prepared)) {
+                out.ok = true;
+                out.receiver_have = applied_cursor();
+                span.finish(true, 0);
+                return Status();
+            }
+            std::vector<Connection::SyncApplyNotification> notifications;
+            std::size_t applied_batches = 0;
+            PushResponse failed;
+            bool stopped = false;
+            Status error;
+            try {
+                const Connection::SyncApplyWriteGuard sync_apply_guard =
+                    m_conn->sync_apply_write_guard();
+                WriterScheduler& scheduler = m_conn->writer_scheduler();
+                const WriterScheduler::ClassScope replication(WriterClass::Replication);
+                Transaction txn = m_conn->transaction(std::nothrow, TransactionMode::WRITABLE, error);
+                if (!error) {
+                    return error;
+                }
+                AppliedStore applied(m_conn->env_handle());
+                applied.open(txn.handle());
+                std::uint64_t applied_base = applied.mod_txnid(txn.handle());
+                if (applied_base != watermark_version) {
+                    recheck_replayed(txn.handle(), applied, request, prepared);
+                }
+                std::map<NodeId, std::uint64_t> admitted_tail;
+                for (std::size_t i = 0; i < prepared.size(); ++i) {
+                    admit_prepared(txn.handle(), applied, prepared[i], admitted_tail);
+                    if (prepared[i].outcome.result == ApplyResult::Conflict) {
+                        txn.rollback();
+                        out = push_conflict(prepared[i].outcome, reason);
+                        return Status();
+                    }
+                }
+                const std::vector<std::size_t> segment_ends =
+                    mark_superseded_segments(prepared, scheduler.slicing());
+                RangeHashStore range_hash(m_conn->env_handle());
+                const bool range_hashed = range_hash.open_existing(txn.handle());
+                PushSlice slice;
+                std::size_t segment = 0;
+                for (std::size_t i = 0; i < prepared.size(); ++i) {
+                    PreparedBatch& batch = prepared[i];
+                    if (batch.admitted) {
+                        write_op_views(txn.handle(), applied, batch.ops, batch.dbis,
+                                       batch.outcome, &batch.superseded);
+                        if (batch.outcome.result == ApplyResult::Conflict) {
+                            txn.rollback();
+                            failed = push_conflict(batch.outcome, reason);
+                            stopped = true;
+                            break;
+                        }
+                        slice.add(batch, range_hashed);
+                    }
+                    if (i + 1 != segment_ends[segment]) {
+                        continue;
+                    }
+                    ++segment;
+                    if (i + 1 == prepared.size() || !scheduler.should_yield(slice.started)) {
+                        continue;
+                    }
+                    // Local writers wait: commit what is written and let them in.
+                    error = commit_push_slice(txn, applied, range_hash, range_hashed,
+                                              applied_base, slice, out, notifications);
+                    if (!error) {
+                        stopped = true;
+                        break;
+                    }
+                    applied_batches += slice.batches;
+                    scheduler.yield_to_local();
+                    txn = m_conn->transaction(std::nothrow, TransactionMode::WRITABLE, error);
+                    if (!error) {
+                        stopped = true;
+                        break;
+                    }
+                    slice = PushSlice();
+                    if (applied.mod_txnid(txn.handle()) != applied_base) {
+                        // Another connection applied batches meanwhile; the
+                        // remaining ones were admitted against older cursors.
+                        txn.rollback();
+                        failed.ok = false;
+                        if (!reason) {
+                            failed.error = "applied cursor changed while the push yielded the writer";
+                        }
+                        failed.error_code = SyncResponseErrorCode::ApplyConflict;
+                        failed.error_retryable = true;
+                        failed.receiver_have = applied_cursor();
+                        stopped = true;
+                        break;
+                    }
+                }
+                if (!stopped) {
+                    error = commit_push_slice(txn, applied, range_hash, range_hashed,
+                                              applied_base, slice, out, notifications);
+                    stopped = !error;
+                    applied_batches += slice.batches;
+                }
+            } catch (...) {
+                // Slices committed before the error are still reported.
+                for (std::size_t i = 0; i < notifications.size(); ++i) {
+                    m_conn->notify_sync_apply_observers(notifications[i]);
+                }
+                throw;
+            }
+            for (std::size_t i = 0; i < notifications.size(); ++i) {
+                m_conn->notify_sync_apply_observers(notifications[i]);
+            }
+            if (!error) {
+                return error;
+            }
+            if (stopped) {
+                out = failed;
+                return Status();
+            }
+            out.ok = true;
+            out.receiver_have = applied_cursor();
+            span.finish(true, applied_batches);
+            return Status();
+        }
+
+        /// \brief Writes of one apply transaction of a push.
+        struct PushSlice {
+            std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+            std::size_t batches = 0;
+            std::size_t ops = 0;
+            std::vector<std::string> affected_dbi_names;
+            std::vector<SyncAppliedKey> applied_keys;
+            std::map<NodeId, std::uint64_t> tail; ///< Highest seq written per origin.
+            RangeHashStore::TouchedTables touched;
+
+            /// \brief Records the written \p batch.
+            void add(const PreparedBatch& batch, bool range_hashed) {
+                tail[batch.origin_node_id] = batch.seq;
+                const std::vector<ChangeOpView>& batch_ops = batch.ops;
+                if (range_hashed) {
+                    RangeHashStore::collect(batch_ops, touched);
+                }
+                if (batch_ops.empty()) {
+                    return;
+                }
+                ++batches;
+                ops += batch_ops.size();
+                for (std::size_t j = 0; j < batch_ops.size(); ++j) {
+                    SyncAppliedKey key;
+                    key.dbi_name.assign(batch_ops[j].dbi_name, batch_ops[j].dbi_name_len);
+                    key.op_type = batch_ops[j].op_type;
+                    key.storage_key.assign(
+                        batch_ops[j].storage_key,
+                        batch_ops[j].storage_key + batch_ops[j].storage_key_len);
+                    add_unique_dbi_name(affected_dbi_names, key.dbi_name);
+                    applied_keys.push_back(std::move(key));
+                }
+            }
+        };
+
+        /// \brief Admitted ops after which a sliced push may commit.
+        /// \details Superseded ops are marked only within such a segment, so
+        /// every committed slice holds the full state of its batches.
+        static const std::size_t apply_segment_ops = 1024;
+
+        /// \brief Commits one apply transaction of a push.
+        /// \param applied_base Store version \p txn started from; set to the
+        ///        committed version.
+        /// \param notifications Receives the notification for the observers,
+        ///        sent once the writer is released.
+        /// \return Ok, or the error of the commit; nothing is committed then.
+        Status commit_push_slice(Transaction& txn,
+                                 AppliedStore& applied,
+                                 RangeHashStore& range_hash,
+                                 bool range_hashed,
+                                 std::uint64_t& applied_base,
+                                 PushSlice& slice,
+                                 PushResponse& out,
+                                 std::vector<Connection::SyncApplyNotification>& notifications) {
+            if (range_hashed) {
+                range_hash.refresh(txn.handle(), slice.touched);
+            }
+            const std::uint64_t applied_after =
+                slice.tail.empty() ? applied_base : applied.mod_txnid(txn.handle());
+            const std::uint64_t commit_txnid = mdbx_txn_id(txn.handle());
+            {
+                SyncSpan commit_span(SyncSpanKind::PushCommit);
+                const Status committed = txn.commit(std::nothrow);
+                if (!committed) {
+                    return committed;
+                }
+                commit_span.finish(true, slice.batches);
+            }
+            out.commit_latency = txn.commit_latency();
+            if (applied_after != applied_base) {
+                m_applied_cache->committed_advance(applied_base, applied_after,
+                                                   commit_txnid, slice.tail);
+                applied_base = applied_after;
+            }
+            Connection::SyncApplyNotification notification;
+            if (slice.batches != 0u) {
+                notification = m_conn->mark_sync_apply_committed(slice.batches,
+                                                                 slice.ops,
+                                                                 slice.affected_dbi_names,
+                                                                 std::move(slice.applied_keys));
+            }
+            notifications.push_back(std::move(notification));
+            return Status();
+        }
+
+        /// \brief Failure response for a push stopped by \p outcome.
+        /// \param reason When set, receives the reason instead of \c error text.
+        PushResponse push_conflict(const ApplyOutcome& outcome,
+                                   ApplyConflictReason* reason) const {
+            PushResponse out;
+            out.ok = false;
+            if (reason) {
+                *reason = outcome.conflict_reason;
+            } else {
+                out.error = apply_conflict_message(outcome);
+            }
+            out.error_code = SyncResponseErrorCode::ApplyConflict;
+            out.error_retryable =
+                outcome.conflict_reason == ApplyConflictReason::SequenceGap;
+            out.receiver_have = applied_cursor();
+            return out;
+        }
+
+        /// \brief Decodes every op of \p batch through \p reader.
+        /// \throws std::runtime_error on a malformed batch.
+        static void read_op_views(const ChangeBatchView& batch,
+                                  ChangeBatchCodec::Reader& reader,
+                                  std::vector<ChangeOpView>& ops) {
+            ops.resize(batch.ops_count());
+            for (std::size_t i = 0; i < ops.size(); ++i) {
+                reader.next(ops[i]);
+            }
+            ChangeOpView end;
+            reader.next(end);
+            if (reader.bytes_read() != batch.size()) {
+                throw std::runtime_error("Trailing bytes after ChangeBatch");
+            }
+        }
+
+        /// \brief Checks origin and seq of \p outcome's batch.
+        /// \return \c false with \p outcome set to \c Skipped or a
+        ///         \c SequenceGap conflict when the batch must not be applied.
+        bool admit_batch(MDBX_txn* txn, AppliedStore& applied, ApplyOutcome& outcome) const {
+            MetaStore meta(m_conn->env_handle());
+            meta.open(txn);
+            applied.open(txn);
+
+            const NodeId local_node = meta.get_node_id(txn);
+            if (compare_node_id(outcome.origin_node_id, local_node) == 0) {
+                outcome.result = ApplyResult::Skipped;
+                return false;
+            }
+
+            const std::uint64_t last = applied.last_applied_seq(txn, outcome.origin_node_id);
+            outcome.last_applied_seq = last;
+            if (outcome.batch_seq <= last) {
+                outcome.result = ApplyResult::Skipped;
+                return false;
+            }
+            if (outcome.batch_seq != last + 1) {
+                outcome.result = ApplyResult::Conflict;
+                outcome.conflict_reason = ApplyConflictReason::SequenceGap;
+                return false;
+            }
+            return true;
+        }
+
+        /// \brief Writes the ops of an admitted batch and advances its cursor.
+        static void apply_op_views(MDBX_txn* txn,
+                                   AppliedStore& applied,
+                                   const std::vector<ChangeOpView>& ops,
+                                   ApplyOutcome& outcome) {
+            std::vector<BatchDbiFlags> batch_dbis;
+            if (!collect_batch_dbi_flags(ops, batch_dbis, &outcome)) return;
+            write_op_views(txn, applied, ops, batch_dbis, outcome);
+            RangeHashStore range_hash(mdbx_txn_env(txn));
+            if (outcome.result == ApplyResult::Applied && range_hash.open_existing(txn)) {
+                RangeHashStore::TouchedTables touched;
+                RangeHashStore::collect(ops, touched);
+                range_hash.refresh(txn, touched);
+            }
+        }
+
+        /// \brief Writes ops whose DBI flags were already collected.
+        /// \param superseded When set, ops marked in it are not written.
+        static void write_op_views(MDBX_txn* txn,
+                                   AppliedStore& applied,
+                                   const std::vector<ChangeOpView>& ops,
+                                   const std::vector<BatchDbiFlags>& batch_dbis,
+                                   ApplyOutcome& outcome,
+                                   const std::vector<bool>* superseded = nullptr) {
+            std::unordered_map<std::string, MDBX_dbi> dbi_cache;
+            if (!preflight_batch_user_dbis(txn, batch_dbis, dbi_cache, &outcome)) {
+                return;
+            }
+            std::vector<std::size_t> order;
+            order.reserve(ops.size());
+            for (std::size_t i = 0; i < ops.size(); ++i) {
+                if (superseded == nullptr || !(*superseded)[i]) {
+                    order.push_back(i);
+                }
+            }
+            if (order.size() >= sorted_apply_min_ops && ops_are_reorderable(ops, order)) {
+                write_sorted_ops(txn, ops, order, dbi_cache);
+            } else {
+                std::string name;
+                for (std::size_t i = 0; i < order.size(); ++i) {
+                    const ChangeOpView& op = ops[order[i]];
+                    name.assign(op.dbi_name, op.dbi_name_len);
+                    apply_one_op(txn, op, name, dbi_cache);
+                }
+            }
+            applied.set_last_applied_seq(txn, outcome.origin_node_id, outcome.batch_seq);
+            outcome.result = ApplyResult::Applied;
+            outcome.conflict_reason = ApplyConflictReason::None;
+            outcome.last_applied_seq = outcome.batch_seq;
+        }
+
+        /// \brief Fewest ops in a batch for which the sorted apply is tried.
+        static const std::size_t sorted_apply_min_ops = 8;
+
+        /// \brief Whether the ops at \p order can be written in any order.
+        /// \details True when they are puts, deletes and merges of distinct keys in
+        /// non-dupsort DBIs, so no op sees the effect of another.
+        static bool ops_are_reorderable(const std::vector<ChangeOpView>& ops,
+                                        const std::vector<std::size_t>& order) {
+            std::unordered_set<std::string> keys;
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                const ChangeOpView& op = ops[order[i]];
+                if (op.op_type == ChangeOpType::ClearTable ||
+                    (op.dbi_flags & MDBX_DUPSORT) != 0) {
+                    return false;
+                }
+                if ((op.dbi_flags & MDBX_INTEGERKEY) != 0 &&
+                    op.storage_key_len != 4 && op.storage_key_len != 8) {
+                    return false; // left for mdbx_put() to reject
+                }
+                if (!keys.insert(dbi_key_string(op.dbi_name, op.dbi_name_len,
+                                                op.storage_key, op.storage_key_len)).second) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// \brief Writes reorderable ops grouped by DBI in key order.
+        /// \details Neighbouring keys share leaf pages, so each page is
+        /// dirtied once rather than once per op, and one cursor per DBI
+        /// serves the whole group.
+        static void write_sorted_ops(MDBX_txn* txn,
+                                     const std::vector<ChangeOpView>& ops,
+                                     const std::vector<std::size_t>& order,
+                                     std::unordered_map<std::string, MDBX_dbi>& cache) {
+            std::vector<std::pair<MDBX_dbi, std::size_t> > sorted;
+            sorted.reserve(order.size());
+            std::string name;
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                const ChangeOpView& op = ops[order[i]];
+                name.assign(op.dbi_name, op.dbi_name_len);
+                sorted.push_back(std::make_pair(
+                    resolve_user_dbi(txn, name, op.dbi_flags, cache), order[i]));
+            }
+            std::sort(sorted.begin(), sorted.end(),
+                      [txn, &ops](const std::pair<MDBX_dbi, std::size_t>& a,
+                                  const std::pair<MDBX_dbi, std::size_t>& b) {
+                          if (a.first != b.first) {
+                              return a.first < b.first;
+                          }
+                          const MDBX_val ka = key_of(ops[a.second]);
+                          const MDBX_val kb = key_of(ops[b.second]);
+                          return mdbx_cmp(txn, a.first, &ka, &kb) < 0;
+                      });
+            std::size_t i = 0;
+            while (i < sorted.size()) {
+                const MDBX_dbi dbi = sorted[i].first;
+                MDBX_cursor* raw = nullptr;
+                check_mdbx(mdbx_cursor_open(txn, dbi, &raw),
+                           "SyncEngine: sorted apply cursor open failed");
+                CursorGuard guard(raw);
+                for (; i < sorted.size() && sorted[i].first == dbi; ++i) {
+                    const ChangeOpView& op = ops[sorted[i].second];
+                    MDBX_val k = key_of(op);
+                    if (op.op_type == ChangeOpType::Put) {
+                        MDBX_val v = { op.value_len == 0 ? nullptr
+                                                         : const_cast<std::uint8_t*>(op.value),
+                                       op.value_len };
+                        check_mdbx(mdbx_cursor_put(raw, &k, &v, MDBX_UPSERT),
+                                   "SyncEngine: mdbx_cursor_put failed for DBI '" +
+                                       std::string(op.dbi_name, op.dbi_name_len) + "'");
+                        continue;
+                    }
+                    MDBX_val v;
+                    int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_KEY);
+                    if (op.op_type == ChangeOpType::Merge) {
+                        const std::string dbi_name(op.dbi_name, op.dbi_name_len);
+                        if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                            check_mdbx(rc, "SyncEngine: merge read failed for DBI '" + dbi_name + "'");
+                        }
+                        std::vector<std::uint8_t> merged;
+                        merge_value(op, rc == MDBX_SUCCESS ? &v : nullptr, dbi_name, merged);
+                        MDBX_val mv = { merged.empty() ? nullptr : &merged[0], merged.size() };
+                        check_mdbx(mdbx_cursor_put(raw, &k, &mv,
+                                                   rc == MDBX_SUCCESS ? MDBX_CURRENT : MDBX_UPSERT),
+                                   "SyncEngine: mdbx_cursor_put failed for DBI '" + dbi_name + "'");
+                        continue;
+                    }
+                    if (rc == MDBX_SUCCESS) {
+                        rc = mdbx_cursor_del(raw, MDBX_CURRENT);
+                    }
+                    if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "SyncEngine: mdbx_del failed for DBI '" +
+                                           std::string(op.dbi_name, op.dbi_name_len) + "'");
+                    }
                 }
-                req.batches.push_back(ChangeBatchCodec::decode_exact(buf));
-                if (s == to_seq) break;
             }
-            return req;
         }
 
-    private:
-        struct CursorGuard {
-            explicit CursorGuard(MDBX_cursor* cursor) : raw(cursor) {}
-            ~CursorGuard() { if (raw) mdbx_cursor_close(raw); }
-            CursorGuard(const CursorGuard&) = delete;
-            CursorGuard& operator=(const CursorGuard&) = delete;
-
-            MDBX_cursor* raw;
-        };
+        static MDBX_val key_of(const ChangeOpView& op) {
+            MDBX_val k = { op.storage_key_len == 0 ? nullptr
+                                                   : const_cast<std::uint8_t*>(op.storage_key),
+                           op.storage_key_len };
+            return k;
+        }
 
-        /// \brief Returns true when \p request_db_id matches the local
-        /// \c db_uuid. A zero \p request_db_id is rejected: callers must
-        /// know the database identity before issuing pull/push requests.
-        bool db_id_matches(const NodeId& request_db_id) const {
-            const NodeId zero{};
-            if (compare_node_id(request_db_id, zero) == 0) return false;
-            return compare_node_id(request_db_id, db_uuid()) == 0;
+        /// \brief Unique string for a \c (dbi_name, storage_key) pair.
+        /// \details The length prefix keeps ("ab","c") and ("a","bc") apart.
+        static std::string dbi_key_string(const char* dbi_name, std::size_t dbi_name_len,
+                                          const std::uint8_t* storage_key,
+                                          std::size_t storage_key_len) {
+            std::string key(4, '\0');
+            detail::write_u32_le(static_cast<std::uint32_t>(dbi_name_len),
+                                 reinterpret_cast<std::uint8_t*>(&key[0]));
+            key.append(dbi_name, dbi_name_len);
+            key.append(reinterpret_cast<const char*>(storage_key), storage_key_len);
+            return key;
         }
 
-        static ApplyOutcome make_apply_outcome(ApplyResult result,
-                                               const ChangeBatch& batch,
-                                               std::uint64_t last_applied_seq) {
-            ApplyOutcome outcome;
-            outcome.result = result;
-            outcome.conflict_reason = ApplyConflictReason::None;
-            outcome.origin_node_id = batch.origin_node_id;
-            outcome.last_applied_seq = last_applied_seq;
-            outcome.batch_seq = batch.seq;
-            return outcome;
+        static ChangeOpView view_of(const ChangeOp& op) {
+            ChangeOpView view;
+            view.op_type = op.op_type;
+            view.op_flags = op.op_flags;
+            view.dbi_flags = op.dbi_flags;
+            view.dbi_name = op.dbi_name.data();
+            view.dbi_name_len = op.dbi_name.size();
+            view.storage_key = op.storage_key.data();
+            view.storage_key_len = op.storage_key.size();
+            view.value = op.value.data();
+            view.value_len = op.value.size();
+            view.identity_key = op.identity_key.data();
+            view.identity_key_len = op.identity_key.size();
+            view.revision_key = op.revision_key.data();
+            view.revision_key_len = op.revision_key.size();
+            return view;
         }
 
         MDBX_txn* checked_external_txn(MDBX_txn* txn,
@@ -588,23 +2829,20 @@ namespace sync {
             return dbi_flags & persistent_dbi_flags_mask();
         }
 
-        struct BatchDbiFlags {
-            std::string name;
-            std::uint32_t flags;
-        };
-
-        static bool collect_batch_dbi_flags(const ChangeBatch& batch,
+        static bool collect_batch_dbi_flags(const std::vector<ChangeOpView>& ops,
                                             std::vector<BatchDbiFlags>& dbis,
                                             ApplyOutcome* outcome) {
             dbis.clear();
             std::unordered_map<std::string, std::vector<BatchDbiFlags>::size_type> index_by_name;
-            for (const ChangeOp& op : batch.ops) {
-                if (is_reserved_dbi_name(op.dbi_name)) {
+            std::string name;
+            for (const ChangeOpView& op : ops) {
+                name.assign(op.dbi_name, op.dbi_name_len);
+                if (is_reserved_dbi_name(name)) {
                     if (outcome != nullptr) {
                         outcome->result = ApplyResult::Conflict;
                         outcome->conflict_reason =
                             ApplyConflictReason::ReservedDbiName;
-                        outcome->dbi_name = op.dbi_name;
+                        outcome->dbi_name = name;
                         outcome->incoming_dbi_flags =
                             persistent_dbi_flags(op.dbi_flags);
                     }
@@ -614,10 +2852,10 @@ namespace sync {
                 const std::pair<
                     std::unordered_map<std::string, std::vector<BatchDbiFlags>::size_type>::iterator,
                     bool> inserted =
-                    index_by_name.insert(std::make_pair(op.dbi_name, dbis.size()));
+                    index_by_name.insert(std::make_pair(name, dbis.size()));
                 if (inserted.second) {
                     BatchDbiFlags entry;
-                    entry.name = op.dbi_name;
+                    entry.name = name;
                     entry.flags = flags;
                     dbis.push_back(entry);
                     continue;
@@ -628,7 +2866,7 @@ namespace sync {
                         outcome->result = ApplyResult::Conflict;
                         outcome->conflict_reason =
                             ApplyConflictReason::InconsistentBatchDbiFlags;
-                        outcome->dbi_name = op.dbi_name;
+                        outcome->dbi_name = name;
                         outcome->expected_dbi_flags = existing.flags;
                         outcome->incoming_dbi_flags = flags;
                     }
@@ -716,36 +2954,6 @@ namespace sync {
             return true;
         }
 
-        static std::vector<std::uint8_t> make_changelog_key(const NodeId& origin,
-                                                            std::uint64_t seq) {
-            std::vector<std::uint8_t> out(24);
-            std::memcpy(out.data(), origin.data(), 16);
-            detail::write_u64_be(seq, out.data() + 16);
-            return out;
-        }
-
-        static NodeId changelog_key_origin(const MDBX_val& key) {
-            if (key.iov_len != 24) {
-                throw std::runtime_error("SyncEngine: invalid changelog key size");
-            }
-            NodeId origin{};
-            std::memcpy(origin.data(), key.iov_base, 16);
-            return origin;
-        }
-
-        static std::uint64_t changelog_key_seq(const MDBX_val& key) {
-            if (key.iov_len != 24) {
-                throw std::runtime_error("SyncEngine: invalid changelog key size");
-            }
-            const std::uint8_t* bytes = static_cast<const std::uint8_t*>(key.iov_base);
-            return detail::read_u64_be(bytes + 16);
-        }
-
-        static bool changelog_key_matches_origin(const MDBX_val& key,
-                                                 const NodeId& origin) {
-            return compare_node_id(changelog_key_origin(key), origin) == 0;
-        }
-
         static PullOrigin make_pull_origin(const NodeId& origin) {
             PullOrigin out;
             out.origin = origin;
@@ -776,6 +2984,7 @@ namespace sync {
                                           std::uint64_t earliest_seq) {
             out.ok = false;
             out.batches.clear();
+            out.encoded_batches.clear();
             out.has_more = false;
             out.error_code = SyncResponseErrorCode::SnapshotRequired;
             out.error_retryable = false;
@@ -801,6 +3010,7 @@ namespace sync {
             (void)origin;
             out.ok = false;
             out.batches.clear();
+            out.encoded_batches.clear();
             out.has_more = false;
             out.error_code = SyncResponseErrorCode::BatchTooLarge;
             out.error_retryable = false;
@@ -811,8 +3021,7 @@ namespace sync {
             out.error += ")";
         }
 
-        static bool request_has_retained_start(MDBX_txn* txn,
-                                               MDBX_dbi dbi,
+        static bool request_has_retained_start(const ChangeLogKeyspace& log,
                                                const PullOrigin& origin,
                                                const PullRequest& request,
                                                PullResponse& out) {
@@ -826,7 +3035,7 @@ namespace sync {
             }
             std::uint64_t earliest_seq = 0;
             const bool earliest_known =
-                changelog_earliest_seq(txn, dbi, origin.origin, earliest_seq);
+                changelog_earliest_seq(log, origin.origin, earliest_seq);
             if (!earliest_known) {
                 if (origin.has_last_seq && have_seq < origin.last_seq) {
                     set_snapshot_required(out, origin, have_seq,
@@ -856,42 +3065,26 @@ namespace sync {
             return true;
         }
 
-        static std::vector<PullOrigin> collect_changelog_origins(MDBX_txn* txn,
-                                                                 MDBX_dbi dbi) {
+        static std::vector<PullOrigin> collect_changelog_origins(const ChangeLogKeyspace& log) {
+            const std::vector<NodeId> found = log.origins();
             std::vector<PullOrigin> origins;
-            MDBX_cursor* raw = nullptr;
-            check_mdbx(mdbx_cursor_open(txn, dbi, &raw),
-                       "pull_full: origin cursor open failed");
-            CursorGuard guard(raw);
+            origins.reserve(found.size());
+            for (std::size_t i = 0; i < found.size(); ++i) {
+                origins.push_back(make_pull_origin(found[i]));
+            }
+            return origins;
+        }
 
-            MDBX_val k, v;
-            std::vector<std::uint8_t> owned_key;
-            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
-            while (rc == MDBX_SUCCESS) {
-                const NodeId origin = changelog_key_origin(k);
-                origins.push_back(make_pull_origin(origin));
-
-                std::vector<std::uint8_t> next_key_buf =
-                    make_changelog_key(origin, std::numeric_limits<std::uint64_t>::max());
-                MDBX_val next_key = { next_key_buf.empty() ? nullptr : &next_key_buf[0],
-                                      next_key_buf.size() };
-                rc = mdbx_cursor_get(raw, &next_key, &v, MDBX_SET_RANGE);
-                if (rc == MDBX_SUCCESS &&
-                    compare_node_id(changelog_key_origin(next_key), origin) == 0) {
-                    rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT);
-                } else if (rc == MDBX_SUCCESS) {
-                    owned_key.resize(next_key.iov_len);
-                    if (next_key.iov_len > 0) {
-                        std::memcpy(owned_key.data(), next_key.iov_base, next_key.iov_len);
-                    }
-                    k.iov_base = owned_key.empty() ? nullptr : &owned_key[0];
-                    k.iov_len = owned_key.size();
+        /// \brief Cache kept by the attached capture sink, else the engine's.
+        std::shared_ptr<OriginTailCache> origin_tail_cache() const {
+            ISyncCaptureSink* sink = m_conn->sync_capture();
+            if (sink != nullptr) {
+                std::shared_ptr<OriginTailCache> cache = sink->origin_tail_cache();
+                if (cache) {
+                    return cache;
                 }
             }
-            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
-                check_mdbx(rc, "pull_full: origin cursor walk failed");
-            }
-            return origins;
+            return m_tail_cache;
         }
 
         std::vector<PullOrigin> collect_indexed_origins(MDBX_txn* txn) const {
@@ -899,8 +3092,13 @@ namespace sync {
             if (!origins.open_existing(txn)) {
                 return std::vector<PullOrigin>();
             }
-            const std::vector<OriginIndexStore::OriginTail> tails =
-                origins.origin_tails(txn);
+            const std::uint64_t index_txnid = origins.mod_txnid(txn);
+            const std::shared_ptr<OriginTailCache> cache = origin_tail_cache();
+            std::vector<OriginIndexStore::OriginTail> tails;
+            if (!cache->lookup(index_txnid, tails)) {
+                tails = origins.origin_tails(txn);
+                cache->store(index_txnid, tails);
+            }
             std::vector<PullOrigin> out;
             out.reserve(tails.size());
             for (std::vector<OriginIndexStore::OriginTail>::const_iterator it =
@@ -912,60 +3110,249 @@ namespace sync {
         }
 
         std::vector<PullOrigin> collect_known_origins(MDBX_txn* txn,
-                                                      MDBX_dbi changelog_dbi) const {
+                                                      const ChangeLogKeyspace& log) const {
             const std::vector<PullOrigin> indexed = collect_indexed_origins(txn);
             if (!indexed.empty()) {
                 return indexed;
             }
-            return collect_changelog_origins(txn, changelog_dbi);
+            return collect_changelog_origins(log);
         }
 
-        static bool pull_origin_batches(MDBX_txn* txn,
-                                        MDBX_dbi dbi,
-                                        const NodeId& origin,
-                                        const PullRequest& request,
-                                        PullResponse& out,
-                                        std::size_t& total_bytes) {
+        /// \brief \c PullRequest::subscription sorted by table for per-op checks.
+        class PullSubscriptionFilter {
+        public:
+            explicit PullSubscriptionFilter(const std::vector<SyncTableSubscription>& tables) {
+                for (std::size_t i = 0; i < tables.size(); ++i) {
+                    Table table;
+                    table.name = tables[i].dbi_name;
+                    table.all_keys = tables[i].key_prefixes.empty();
+                    table.prefixes = tables[i].key_prefixes;
+                    m_tables.push_back(std::move(table));
+                }
+                std::sort(m_tables.begin(), m_tables.end(),
+                          [](const Table& a, const Table& b) { return a.name < b.name; });
+                // Merge repeated tables; an entry without prefixes takes all keys.
+                std::size_t out = 0;
+                for (std::size_t i = 0; i < m_tables.size(); ++i) {
+                    if (out != 0 && m_tables[out - 1].name == m_tables[i].name) {
+                        Table& merged = m_tables[out - 1];
+                        merged.all_keys = merged.all_keys || m_tables[i].all_keys;
+                        merged.prefixes.insert(merged.prefixes.end(),
+                                               m_tables[i].prefixes.begin(),
+                                               m_tables[i].prefixes.end());
+                    } else {
+                        if (out != i) {
+                            m_tables[out] = std::move(m_tables[i]);
+                        }
+                        ++out;
+                    }
+                }
+                m_tables.resize(out);
+            }
+
+            /// \brief Consults \c _mdbxc_changelog_dbis of \p txn, when it
+            /// exists, in \ref may_match().
+            void use_dbi_index(MDBX_txn* txn, MDBX_env* env) {
+                m_index.reset(new ChangeLogDbiIndexStore(env));
+                if (!m_index->open_existing(txn)) {
+                    m_index.reset();
+                    return;
+                }
+                m_txn = txn;
+            }
+
+            /// \brief Whether batch (\p origin, \p seq) may hold subscribed ops.
+            /// \details Always \c true without the index. With it, the next
+            /// indexed batch of \p origin is found by one seek per table and
+            /// remembered, so a run of batches without subscribed ops costs
+            /// no index reads until it ends.
+            bool may_match(const NodeId& origin, std::uint64_t seq) const {
+                if (!m_index) {
+                    return true;
+                }
+                std::map<NodeId, IndexedRun>::iterator it = m_runs.find(origin);
+                if (it == m_runs.end() || seq < it->second.from_seq ||
+                    seq > it->second.next_seq) {
+                    IndexedRun run;
+                    run.from_seq = seq;
+                    run.next_seq = std::numeric_limits<std::uint64_t>::max();
+                    for (std::size_t i = 0; i < m_tables.size(); ++i) {
+                        std::uint64_t next = 0;
+                        if (m_index->next_seq(m_txn, m_tables[i].name, origin, seq, next) &&
+                            next < run.next_seq) {
+                            run.next_seq = next;
+                        }
+                    }
+                    it = m_runs.insert(std::make_pair(origin, run)).first;
+                    it->second = run;
+                }
+                return seq == it->second.next_seq;
+            }
+
+            /// \brief Whether \p op is part of the subscription.
+            bool matches(const ChangeOpView& op) const {
+                std::vector<Table>::const_iterator it =
+                    std::lower_bound(m_tables.begin(), m_tables.end(), op,
+                                     [](const Table& table, const ChangeOpView& key) {
+                                         return table.name.compare(0, std::string::npos,
+                                                                   key.dbi_name,
+                                                                   key.dbi_name_len) < 0;
+                                     });
+                if (it == m_tables.end() ||
+                    it->name.compare(0, std::string::npos, op.dbi_name, op.dbi_name_len) != 0) {
+                    return false;
+                }
+                if (it->all_keys || op.op_type == ChangeOpType::ClearTable) {
+                    return true;
+                }
+                for (std::size_t i = 0; i < it->prefixes.size(); ++i) {
+                    const std::vector<std::uint8_t>& prefix = it->prefixes[i];
+                    if (prefix.size() <= op.storage_key_len &&
+                        (prefix.empty() ||
+                         std::memcmp(&prefix[0], op.storage_key, prefix.size()) == 0)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+        private:
+            struct Table {
+                std::string name;
+                bool all_keys = false;
+                std::vector<std::vector<std::uint8_t>> prefixes;
+            };
+
+            /// \brief Batches of one origin in [\c from_seq, \c next_seq)
+            /// touch no subscribed table.
+            struct IndexedRun {
+                std::uint64_t from_seq;
+                std::uint64_t next_seq; ///< Max when no later batch does.
+            };
+
+            std::vector<Table> m_tables; ///< Sorted by name, one entry per table.
+            std::unique_ptr<ChangeLogDbiIndexStore> m_index;
+            MDBX_txn* m_txn = nullptr;
+            mutable std::map<NodeId, IndexedRun> m_runs;
+        };
+
+        /// \brief Buffers reused across the batches of one pull page.
+        /// \details Seeks write their key into \c key instead of a fresh
+        /// vector, and filtered batches collect their ops in \c kept, whose
+        /// capacity survives from batch to batch.
+        struct PullPageScratch {
+            std::uint8_t key[24];
+            std::vector<ChangeOpView> kept;
+
+            /// \brief Fills \c key with the \p log key of (\p origin, \p seq).
+            MDBX_val seek_key(const ChangeLogKeyspace& log,
+                              const NodeId& origin, std::uint64_t seq) {
+                return log.seek_key(origin, seq, key);
+            }
+        };
+
+        /// \brief Most batches one read-ahead pass walks past.
+        static const std::size_t pull_readahead_max_batches = 256;
+
+        /// \brief Values shorter than this are stored in leaf pages, which
+        /// the read-ahead walk itself faults in, and get no hint.
+        static std::size_t pull_readahead_min_value_bytes() noexcept {
+            return mdbxc::detail::os_page_size() / 2;
+        }
+
+        /// \brief Hints the values of the batches of \p origin the page will
+        /// take, starting at the position of \p from.
+        /// \details Walks a copy of \p from, so the caller's position is
+        /// kept, and stops at the end of the origin run or of the page
+        /// budget left after \p out and \p total_bytes.
+        /// \return Number of batches walked past.
+        static std::size_t readahead_origin_batches(const ChangeLogKeyspace& log,
+                                                    MDBX_cursor* from,
+                                                    const NodeId& origin,
+                                                    const PullRequest& request,
+                                                    const PullResponse& out,
+                                                    std::size_t total_bytes) {
+            const std::size_t taken = out.batches.size() + out.encoded_batches.size();
+            if (taken >= request.max_batches || total_bytes >= request.max_bytes) {
+                return 0;
+            }
+            const std::uint64_t left = request.max_batches - taken;
+            const std::size_t limit = left < pull_readahead_max_batches
+                ? static_cast<std::size_t>(left)
+                : pull_readahead_max_batches;
+
+            MDBX_cursor* raw = mdbx_cursor_create(nullptr);
+            if (raw == nullptr) {
+                check_mdbx(MDBX_ENOMEM, "pull_full: read-ahead cursor open failed");
+            }
+            CursorGuard guard(raw);
+            check_mdbx(mdbx_cursor_copy(from, raw),
+                       "pull_full: read-ahead cursor copy failed");
+
+            const std::size_t min_value = pull_readahead_min_value_bytes();
+            mdbxc::detail::ReadaheadHint hint;
+            std::size_t walked = 0;
+            std::size_t bytes = total_bytes;
+            MDBX_val k, v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_GET_CURRENT);
+            while (rc == MDBX_SUCCESS && log.key_matches_origin(k, origin) &&
+                   walked < limit && bytes < request.max_bytes) {
+                if (v.iov_len >= min_value) {
+                    hint.add(v.iov_base, v.iov_len);
+                }
+                bytes += v.iov_len;
+                ++walked;
+                rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "pull_full: read-ahead cursor walk failed");
+            }
+            return walked;
+        }
+
+        bool pull_origin_batches(const ChangeLogKeyspace& log,
+                                 const NodeId& origin,
+                                 const PullRequest& request,
+                                 PullBatchForm form,
+                                 const PullSubscriptionFilter* filter,
+                                 PullPageScratch& scratch,
+                                 PullResponse& out,
+                                 std::size_t& total_bytes) const {
             const std::uint64_t have_seq = request.have.last_seq_for(origin);
             if (have_seq == std::numeric_limits<std::uint64_t>::max()) {
                 return false;
             }
+            const MDBX_dbi dbi = log.dbi_for(origin);
+            if (dbi == 0) {
+                return false;
+            }
 
             MDBX_cursor* raw = nullptr;
-            check_mdbx(mdbx_cursor_open(txn, dbi, &raw),
+            check_mdbx(mdbx_cursor_open(log.txn(), dbi, &raw),
                        "pull_full: origin batch cursor open failed");
             CursorGuard guard(raw);
 
-            std::vector<std::uint8_t> key_buf = make_changelog_key(origin, have_seq + 1);
-            MDBX_val k = { key_buf.empty() ? nullptr : &key_buf[0], key_buf.size() };
+            MDBX_val k = scratch.seek_key(log, origin, have_seq + 1);
             MDBX_val v;
             int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
-            while (rc == MDBX_SUCCESS && changelog_key_matches_origin(k, origin)) {
-                if (out.batches.size() >= request.max_batches ||
-                    total_bytes >= request.max_bytes) {
-                    return true;
+            if (m_pull_readahead && rc == MDBX_SUCCESS &&
+                log.key_matches_origin(k, origin)) {
+                const std::size_t ahead =
+                    readahead_origin_batches(log, raw, origin, request, out, total_bytes);
+                if (form == PullBatchForm::Encoded) {
+                    out.encoded_batches.reserve(out.encoded_batches.size() + ahead);
+                } else {
+                    out.batches.reserve(out.batches.size() + ahead);
                 }
-
-                const std::uint64_t key_seq = changelog_key_seq(k);
-                if (v.iov_len > request.max_single_batch_bytes) {
-                    set_batch_too_large(
-                        out, origin, key_seq,
-                        static_cast<std::uint64_t>(v.iov_len),
-                        request.max_single_batch_bytes);
+            }
+            while (rc == MDBX_SUCCESS && log.key_matches_origin(k, origin)) {
+                if (page_full(request, out, total_bytes)) {
                     return true;
                 }
-                std::vector<std::uint8_t> buf(v.iov_len);
-                if (v.iov_len > 0) {
-                    std::memcpy(buf.data(), v.iov_base, v.iov_len);
-                }
-                const ChangeBatch batch = ChangeBatchCodec::decode_exact(buf);
-                if (compare_node_id(batch.origin_node_id, origin) != 0 ||
-                    batch.seq != key_seq) {
-                    throw std::runtime_error("SyncEngine: changelog key/value mismatch");
+                if (!append_pulled_batch(origin, log.key_seq(k), v, request, form,
+                                         filter, scratch, out, total_bytes)) {
+                    return true;
                 }
-
-                out.batches.push_back(batch);
-                total_bytes += v.iov_len;
                 rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT);
             }
             if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
@@ -974,30 +3361,281 @@ namespace sync {
             return false;
         }
 
-        static bool changelog_earliest_seq(MDBX_txn* txn,
-                                           MDBX_dbi dbi,
+        /// \brief Fills the page one batch per lagging origin in turn.
+        /// \details Starts at the origin remembered for \c request.requester
+        /// and remembers where the page stopped. Each batch is an exact
+        /// \c (origin, next_seq) seek, so lanes need no cursor of their own;
+        /// in the per-origin layout the one cursor is rebound to the DBI of
+        /// each lane.
+        /// \return \c true when the page budget or an oversized batch
+        ///         stopped the walk.
+        bool pull_round_robin(const ChangeLogKeyspace& log,
+                              const std::vector<PullOrigin>& origins,
+                              const PullRequest& request,
+                              PullBatchForm form,
+                              const PullSubscriptionFilter* filter,
+                              PullPageScratch& scratch,
+                              PullResponse& out,
+                              std::size_t& total_bytes) const {
+            struct Lane {
+                NodeId origin;
+                std::uint64_t next_seq;
+                MDBX_dbi dbi;
+            };
+            std::vector<Lane> lanes;
+            for (std::size_t i = 0; i < origins.size(); ++i) {
+                const std::uint64_t have_seq =
+                    request.have.last_seq_for(origins[i].origin);
+                if (origin_is_at_tail(origins[i], request) ||
+                    have_seq == std::numeric_limits<std::uint64_t>::max()) {
+                    continue;
+                }
+                Lane lane;
+                lane.origin = origins[i].origin;
+                lane.next_seq = have_seq + 1;
+                lane.dbi = log.dbi_for(lane.origin);
+                if (lane.dbi != 0) {
+                    lanes.push_back(lane);
+                }
+            }
+            NodeId resume{};
+            if (!lanes.empty() && find_pull_resume(request.requester, resume)) {
+                std::size_t first = 0;
+                while (first < lanes.size() &&
+                       compare_node_id(lanes[first].origin, resume) < 0) {
+                    ++first;
+                }
+                if (first < lanes.size()) {
+                    std::rotate(lanes.begin(), lanes.begin() + first, lanes.end());
+                }
+            }
+
+            MDBX_cursor* raw = mdbx_cursor_create(nullptr);
+            if (raw == nullptr) {
+                check_mdbx(MDBX_ENOMEM, "pull_full: round-robin cursor open failed");
+            }
+            CursorGuard guard(raw);
+            MDBX_dbi bound = 0;
+
+            std::size_t i = 0;
+            while (!lanes.empty()) {
+                if (i >= lanes.size()) {
+                    i = 0;
+                }
+                Lane& lane = lanes[i];
+                if (lane.dbi != bound) {
+                    check_mdbx(mdbx_cursor_bind(log.txn(), raw, lane.dbi),
+                               "pull_full: round-robin cursor bind failed");
+                    bound = lane.dbi;
+                }
+                MDBX_val k = scratch.seek_key(log, lane.origin, lane.next_seq);
+                MDBX_val v;
+                const int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+                if (rc == MDBX_NOTFOUND ||
+                    (rc == MDBX_SUCCESS && !log.key_matches_origin(k, lane.origin))) {
+                    lanes.erase(lanes.begin() + static_cast<std::ptrdiff_t>(i));
+                    continue;
+                }
+                check_mdbx(rc, "pull_full: round-robin cursor get failed");
+                if (page_full(request, out, total_bytes)) {
+                    remember_pull_resume(request.requester, lane.origin);
+                    return true;
+                }
+                const std::uint64_t key_seq = log.key_seq(k);
+                if (!append_pulled_batch(lane.origin, key_seq, v, request, form,
+                                         filter, scratch, out, total_bytes)) {
+                    return true;
+                }
+                lane.next_seq = key_seq + 1;
+                ++i;
+            }
+            forget_pull_resume(request.requester);
+            return false;
+        }
+
+        static bool page_full(const PullRequest& request,
+                              const PullResponse& out,
+                              std::size_t total_bytes) {
+            return out.batches.size() + out.encoded_batches.size() >= request.max_batches ||
+                   total_bytes >= request.max_bytes;
+        }
+
+        /// \brief Adds the ops of \p view that \p filter keeps as a new batch.
+        /// \return \c false when every op is kept; nothing is added then.
+        static bool append_filtered_batch(const ChangeBatchView& view,
+                                          const PullSubscriptionFilter& filter,
+                                          PullBatchForm form,
+                                          PullPageScratch& scratch,
+                                          PullResponse& out,
+                                          std::size_t& total_bytes) {
+            ChangeBatchCodec::Reader reader = view.ops();
+            std::vector<ChangeOpView>& kept = scratch.kept;
+            kept.clear();
+            std::size_t seen = 0;
+            ChangeOpView op;
+            while (reader.next(op)) {
+                ++seen;
+                if (filter.matches(op)) {
+                    kept.push_back(op);
+                }
+            }
+            if (kept.size() == seen) {
+                return false;
+            }
+            ChangeBatch batch;
+            batch.batch_flags =
+                view.batch_flags() & ~static_cast<std::uint32_t>(BATCH_COMPRESSED_ZSTD);
+            batch.origin_node_id = view.origin_node_id();
+            batch.seq = view.seq();
+            batch.time_unix_ns = view.time_unix_ns();
+            batch.ops.reserve(kept.size());
+            for (std::size_t i = 0; i < kept.size(); ++i) {
+                batch.ops.push_back(kept[i].to_op());
+            }
+            std::vector<std::uint8_t> bytes = ChangeBatchCodec::encode(batch);
+            total_bytes += bytes.size();
+            if (form == PullBatchForm::Encoded) {
+                out.encoded_batches.push_back(std::move(bytes));
+            } else {
+                out.batches.push_back(std::move(batch));
+            }
+            return true;
+        }
+
+        /// \brief Adds the batch of changelog value \p v without its ops.
+        /// \details Only the header is read, so the ops are neither
+        /// expanded nor decoded. The empty batch keeps the requester's
+        /// cursor contiguous.
+        static void append_batch_header(const NodeId& origin,
+                                        std::uint64_t key_seq,
+                                        const MDBX_val& v,
+                                        PullBatchForm form,
+                                        PullResponse& out,
+                                        std::size_t& total_bytes) {
+            const ChangeBatchView view(static_cast<const std::uint8_t*>(v.iov_base), v.iov_len);
+            if (compare_node_id(view.origin_node_id(), origin) != 0 ||
+                view.seq() != key_seq) {
+                throw std::runtime_error("SyncEngine: changelog key/value mismatch");
+            }
+            ChangeBatch batch;
+            batch.batch_flags =
+                view.batch_flags() & ~static_cast<std::uint32_t>(BATCH_COMPRESSED_ZSTD);
+            batch.origin_node_id = view.origin_node_id();
+            batch.seq = view.seq();
+            batch.time_unix_ns = view.time_unix_ns();
+            std::vector<std::uint8_t> bytes = ChangeBatchCodec::encode(batch);
+            total_bytes += bytes.size();
+            if (form == PullBatchForm::Encoded) {
+                out.encoded_batches.push_back(std::move(bytes));
+            } else {
+                out.batches.push_back(std::move(batch));
+            }
+        }
+
+        /// \brief Adds the changelog value \p v of (\p origin, \p key_seq)
+        /// to the page.
+        /// \param filter Subscription of the request, or null for all ops.
+        /// \return \c false when the batch exceeds
+        ///         \c request.max_single_batch_bytes; \p out then holds the error.
+        static bool append_pulled_batch(const NodeId& origin,
+                                        std::uint64_t key_seq,
+                                        const MDBX_val& v,
+                                        const PullRequest& request,
+                                        PullBatchForm form,
+                                        const PullSubscriptionFilter* filter,
+                                        PullPageScratch& scratch,
+                                        PullResponse& out,
+                                        std::size_t& total_bytes) {
+            if (filter != nullptr && !filter->may_match(origin, key_seq)) {
+                append_batch_header(origin, key_seq, v, form, out, total_bytes);
+                return true;
+            }
+            if (v.iov_len > request.max_single_batch_bytes) {
+                set_batch_too_large(
+                    out, origin, key_seq,
+                    static_cast<std::uint64_t>(v.iov_len),
+                    request.max_single_batch_bytes);
+                return false;
+            }
+            const std::uint8_t* bytes = static_cast<const std::uint8_t*>(v.iov_base);
+            const ChangeBatchView view(bytes, v.iov_len);
+            if (compare_node_id(view.origin_node_id(), origin) != 0 ||
+                view.seq() != key_seq) {
+                throw std::runtime_error("SyncEngine: changelog key/value mismatch");
+            }
+            if (filter != nullptr &&
+                append_filtered_batch(view, *filter, form, scratch, out, total_bytes)) {
+                return true;
+            }
+            if (form == PullBatchForm::Encoded &&
+                (!view.compressed() || request.accept_compressed_batches)) {
+                out.encoded_batches.push_back(
+                    std::vector<std::uint8_t>(bytes, bytes + v.iov_len));
+            } else {
+                ChangeBatch batch = view.to_batch();
+                if (!request.accept_compressed_batches) {
+                    batch.batch_flags &= ~static_cast<std::uint32_t>(BATCH_COMPRESSED_ZSTD);
+                }
+                if (form == PullBatchForm::Encoded) {
+                    out.encoded_batches.push_back(ChangeBatchCodec::encode(batch));
+                } else {
+                    out.batches.push_back(batch);
+                }
+            }
+            total_bytes += v.iov_len;
+            return true;
+        }
+
+        bool find_pull_resume(const NodeId& requester, NodeId& origin) const {
+            std::lock_guard<std::mutex> lk(m_pull_resume->mutex);
+            std::map<NodeId, NodeId>::const_iterator it =
+                m_pull_resume->next_origin.find(requester);
+            if (it == m_pull_resume->next_origin.end()) {
+                return false;
+            }
+            origin = it->second;
+            return true;
+        }
+
+        void remember_pull_resume(const NodeId& requester, const NodeId& origin) const {
+            std::lock_guard<std::mutex> lk(m_pull_resume->mutex);
+            if (m_pull_resume->next_origin.size() >= max_pull_resume_entries &&
+                m_pull_resume->next_origin.find(requester) ==
+                    m_pull_resume->next_origin.end()) {
+                m_pull_resume->next_origin.clear();
+            }
+            m_pull_resume->next_origin[requester] = origin;
+        }
+
+        void forget_pull_resume(const NodeId& requester) const {
+            std::lock_guard<std::mutex> lk(m_pull_resume->mutex);
+            m_pull_resume->next_origin.erase(requester);
+        }
+
+        static bool changelog_earliest_seq(const ChangeLogKeyspace& log,
                                            const NodeId& origin,
                                            std::uint64_t& out) {
+            const MDBX_dbi dbi = log.dbi_for(origin);
+            if (dbi == 0) {
+                return false;
+            }
             MDBX_cursor* raw = nullptr;
-            check_mdbx(mdbx_cursor_open(txn, dbi, &raw),
+            check_mdbx(mdbx_cursor_open(log.txn(), dbi, &raw),
                        "pull_full: earliest retained cursor open failed");
             CursorGuard guard(raw);
 
-            std::vector<std::uint8_t> key_buf = make_changelog_key(origin, 0);
-            MDBX_val k = {
-                key_buf.empty() ? nullptr : &key_buf[0],
-                key_buf.size()
-            };
+            std::uint8_t key_buf[24];
+            MDBX_val k = log.seek_key(origin, 0, key_buf);
             MDBX_val v;
             const int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
             if (rc == MDBX_NOTFOUND) {
                 return false;
             }
             check_mdbx(rc, "pull_full: earliest retained cursor get failed");
-            if (!changelog_key_matches_origin(k, origin)) {
+            if (!log.key_matches_origin(k, origin)) {
                 return false;
             }
-            out = changelog_key_seq(k);
+            out = log.key_seq(k);
             return true;
         }
 
@@ -1011,6 +3649,56 @@ namespace sync {
             return open_store_ro(txn, "_mdbxc_applied");
         }
 
+        /// \brief Opens the range hashes and the table of \p dbi_name.
+        /// \return \c false when the table keeps none or does not exist.
+        static bool open_range_hashed(MDBX_txn* txn, RangeHashStore& store,
+                                      const std::string& dbi_name,
+                                      unsigned& leaf_bits, MDBX_dbi& data) {
+            return !is_reserved_dbi_name(dbi_name) &&
+                   store.open_existing(txn) &&
+                   store.leaf_bits(txn, dbi_name, leaf_bits) &&
+                   RangeHashStore::open_table(txn, dbi_name, data);
+        }
+
+        static std::uint32_t table_dbi_flags(MDBX_txn* txn, MDBX_dbi dbi,
+                                             const std::string& dbi_name) {
+            unsigned raw_flags = 0;
+            check_mdbx(mdbx_dbi_flags(txn, dbi, &raw_flags),
+                       "SyncEngine: failed to read flags for DBI '" + dbi_name + "'");
+            return persistent_dbi_flags(raw_flags);
+        }
+
+        /// \brief Reads the distinct local keys a range page replaces.
+        static void read_range_keys(MDBX_txn* txn, MDBX_dbi data,
+                                    const RangeHashRequest& request,
+                                    const RangeHashResponse& page,
+                                    std::vector<std::vector<std::uint8_t> >& keys) {
+            const std::vector<std::uint8_t>* end =
+                page.has_more ? &page.resume_key : (request.has_hi ? &request.hi : nullptr);
+            const MDBX_val end_val = { end == nullptr || end->empty() ? nullptr
+                                           : const_cast<std::uint8_t*>(&(*end)[0]),
+                                       end == nullptr ? 0 : end->size() };
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, data, &raw), "SyncEngine: cursor open failed");
+            CursorGuard cursor(raw);
+            MDBX_val k = { request.lo.empty() ? nullptr
+                               : const_cast<std::uint8_t*>(&request.lo[0]),
+                           request.lo.size() };
+            MDBX_val v;
+            int rc = request.from_head ? mdbx_cursor_get(raw, &k, &v, MDBX_FIRST)
+                                       : mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT_NODUP)) {
+                if (end != nullptr && mdbx_cmp(txn, data, &k, &end_val) >= 0) {
+                    break;
+                }
+                const std::uint8_t* p = static_cast<const std::uint8_t*>(k.iov_base);
+                keys.push_back(std::vector<std::uint8_t>(p, p + k.iov_len));
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "SyncEngine: range scan failed");
+            }
+        }
+
         static MDBX_dbi open_store_ro(MDBX_txn* txn, const char* name) {
             MDBX_dbi dbi = 0;
             const int rc = mdbx_dbi_open(txn, name, static_cast<MDBX_db_flags_t>(0), &dbi);
@@ -1019,6 +3707,28 @@ namespace sync {
             return dbi;
         }
 
+        /// \brief Returns the applied cursor of read-only \p txn through the cache.
+        SyncCursor cached_applied_cursor(MDBX_txn* txn) const {
+            const std::uint64_t version = applied_mod_txnid(txn);
+            const std::uint64_t snapshot = mdbx_txn_id(txn);
+            SyncCursor cur;
+            if (!m_applied_cache->lookup_version(version, snapshot, cur)) {
+                cur = read_applied_cursor(txn, SyncCursor());
+                m_applied_cache->store(version, snapshot, cur);
+            }
+            return cur;
+        }
+
+        /// \brief Returns \c ms_mod_txnid of \c _mdbxc_applied, or 0 when absent.
+        static std::uint64_t applied_mod_txnid(MDBX_txn* txn) {
+            const MDBX_dbi applied_dbi = open_applied_ro(txn);
+            if (applied_dbi == 0) return 0;
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, applied_dbi, &stat, sizeof(stat)),
+                       "applied_cursor: store stat failed");
+            return stat.ms_mod_txnid;
+        }
+
         static SyncCursor read_applied_cursor(MDBX_txn* txn, SyncCursor cur) {
             MDBX_dbi applied_dbi = open_applied_ro(txn);
             if (applied_dbi == 0) return cur;
@@ -1080,44 +3790,170 @@ namespace sync {
         }
 
         static void apply_one_op(MDBX_txn* txn,
-                                 const ChangeOp& op,
+                                 const ChangeOpView& op,
+                                 const std::string& dbi_name,
                                  std::unordered_map<std::string, MDBX_dbi>& cache) {
-            MDBX_dbi dbi = resolve_user_dbi(txn, op.dbi_name, op.dbi_flags, cache);
+            MDBX_dbi dbi = resolve_user_dbi(txn, dbi_name, op.dbi_flags, cache);
+            MDBX_val k = { op.storage_key_len == 0 ? nullptr
+                                                   : const_cast<std::uint8_t*>(op.storage_key),
+                           op.storage_key_len };
             switch (op.op_type) {
                 case ChangeOpType::Put: {
-                    MDBX_val k = { op.storage_key.empty() ? nullptr
-                                                           : const_cast<std::uint8_t*>(op.storage_key.data()),
-                                   op.storage_key.size() };
-                    MDBX_val v = { op.value.empty() ? nullptr
-                                                     : const_cast<std::uint8_t*>(op.value.data()),
-                                   op.value.size() };
+                    MDBX_val v = { op.value_len == 0 ? nullptr
+                                                     : const_cast<std::uint8_t*>(op.value),
+                                   op.value_len };
                     check_mdbx(mdbx_put(txn, dbi, &k, &v, MDBX_UPSERT),
-                               "SyncEngine: mdbx_put failed for DBI '" + op.dbi_name + "'");
+                               "SyncEngine: mdbx_put failed for DBI '" + dbi_name + "'");
                     return;
                 }
                 case ChangeOpType::Delete: {
-                    MDBX_val k = { op.storage_key.empty() ? nullptr
-                                                           : const_cast<std::uint8_t*>(op.storage_key.data()),
-                                   op.storage_key.size() };
                     const int rc = mdbx_del(txn, dbi, &k, nullptr);
                     if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
-                        check_mdbx(rc, "SyncEngine: mdbx_del failed for DBI '" + op.dbi_name + "'");
+                        check_mdbx(rc, "SyncEngine: mdbx_del failed for DBI '" + dbi_name + "'");
                     }
-                    cache.erase(op.dbi_name);
+                    cache.erase(dbi_name);
                     return;
                 }
                 case ChangeOpType::ClearTable: {
                     check_mdbx(mdbx_drop(txn, dbi, 0),
-                               "SyncEngine: mdbx_drop failed for DBI '" + op.dbi_name + "'");
-                    cache.erase(op.dbi_name);
+                               "SyncEngine: mdbx_drop failed for DBI '" + dbi_name + "'");
+                    cache.erase(dbi_name);
                     return;
                 }
+                case ChangeOpType::Merge: {
+                    MDBX_val current;
+                    const int rc = mdbx_get(txn, dbi, &k, &current);
+                    if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "SyncEngine: merge read failed for DBI '" + dbi_name + "'");
+                    }
+                    std::vector<std::uint8_t> merged;
+                    merge_value(op, rc == MDBX_SUCCESS ? &current : nullptr, dbi_name, merged);
+                    MDBX_val v = { merged.empty() ? nullptr : &merged[0], merged.size() };
+                    check_mdbx(mdbx_put(txn, dbi, &k, &v, MDBX_UPSERT),
+                               "SyncEngine: mdbx_put failed for DBI '" + dbi_name + "'");
+                    return;
+                }
+                case ChangeOpType::MultiInsert:
+                case ChangeOpType::MultiEraseOne:
+                case ChangeOpType::MultiEraseAll:
+                    apply_multi_value_op(txn, dbi, op, dbi_name);
+                    return;
             }
             throw std::logic_error("SyncEngine: unknown ChangeOpType");
         }
 
+        /// \brief Applies a \c Multi* op to the duplicates of one key.
+        /// \details Follows the \c KeyMultiValueTable layout, where each
+        /// duplicate is an 8-byte big-endian per-key sequence followed by
+        /// the value. An insert takes the sequence after the newest
+        /// duplicate of the key, so every replica allocates its own; erases
+        /// compare only the value part.
+        /// \throws std::runtime_error when the DBI is not \c MDBX_DUPSORT or
+        ///         holds a duplicate shorter than the sequence.
+        static void apply_multi_value_op(MDBX_txn* txn, MDBX_dbi dbi,
+                                         const ChangeOpView& op,
+                                         const std::string& dbi_name) {
+            static const std::size_t prefix_size = 8;
+            if ((op.dbi_flags & MDBX_DUPSORT) == 0) {
+                throw std::runtime_error("SyncEngine: multi-value op for non-DUPSORT DBI '" +
+                                         dbi_name + "'");
+            }
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, dbi, &raw),
+                       "SyncEngine: multi-value cursor open failed");
+            CursorGuard guard(raw);
+            const MDBX_val key = key_of(op);
+            MDBX_val k = key;
+            MDBX_val v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_KEY);
+            if (rc == MDBX_SUCCESS && op.op_type != ChangeOpType::MultiEraseAll) {
+                rc = mdbx_cursor_get(raw, &k, &v, MDBX_LAST_DUP);
+            }
+            if (rc == MDBX_NOTFOUND && op.op_type != ChangeOpType::MultiInsert) {
+                return;
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "SyncEngine: multi-value seek failed for DBI '" + dbi_name + "'");
+            }
+            if (op.op_type == ChangeOpType::MultiInsert) {
+                std::uint64_t sequence = 0;
+                if (rc == MDBX_SUCCESS) {
+                    if (v.iov_len < prefix_size) {
+                        throw std::runtime_error("SyncEngine: corrupted multi-value record in DBI '" +
+                                                 dbi_name + "'");
+                    }
+                    sequence = detail::read_u64_be(static_cast<const std::uint8_t*>(v.iov_base));
+                    if (sequence == std::numeric_limits<std::uint64_t>::max()) {
+                        throw std::overflow_error("Per-key multi-value sequence exhausted");
+                    }
+                    ++sequence;
+                }
+                std::vector<std::uint8_t> stored(prefix_size + op.value_len);
+                detail::write_u64_be(sequence, &stored[0]);
+                if (op.value_len != 0) {
+                    std::memcpy(&stored[prefix_size], op.value, op.value_len);
+                }
+                MDBX_val put_key = key;
+                MDBX_val put_val = { &stored[0], stored.size() };
+                check_mdbx(mdbx_cursor_put(raw, &put_key, &put_val, MDBX_UPSERT),
+                           "SyncEngine: multi-value insert failed for DBI '" + dbi_name + "'");
+                return;
+            }
+            // Erases walk the duplicates: newest first for one, all of them for all.
+            const MDBX_cursor_op step = op.op_type == ChangeOpType::MultiEraseOne
+                ? MDBX_PREV_DUP : MDBX_NEXT_DUP;
+            while (rc == MDBX_SUCCESS) {
+                const bool matches = v.iov_len == prefix_size + op.value_len &&
+                    (op.value_len == 0 ||
+                     std::memcmp(static_cast<const std::uint8_t*>(v.iov_base) + prefix_size,
+                                 op.value, op.value_len) == 0);
+                if (matches) {
+                    check_mdbx(mdbx_cursor_del(raw, MDBX_CURRENT),
+                               "SyncEngine: multi-value erase failed for DBI '" + dbi_name + "'");
+                    if (op.op_type == ChangeOpType::MultiEraseOne) {
+                        return;
+                    }
+                }
+                rc = mdbx_cursor_get(raw, &k, &v, step);
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "SyncEngine: multi-value scan failed for DBI '" + dbi_name + "'");
+            }
+        }
+
+        /// \brief Combines the operand of a \c Merge op with the stored value.
+        /// \param current Stored value, or \c nullptr when the key is absent.
+        /// \throws std::runtime_error if the op carries no valid operator or
+        ///         the stored value does not fit it.
+        static void merge_value(const ChangeOpView& op, const MDBX_val* current,
+                                const std::string& dbi_name, std::vector<std::uint8_t>& out) {
+            MergeOperator merge;
+            if (!MergeOperator::decode(op.value, op.value_len, merge)) {
+                throw std::runtime_error("SyncEngine: invalid merge operator for DBI '" +
+                                         dbi_name + "'");
+            }
+            try {
+                merge.apply(current ? current->iov_base : nullptr, current ? current->iov_len : 0,
+                            current != nullptr, op.value + MergeOperator::encoded_size,
+                            op.value_len - MergeOperator::encoded_size, out);
+            } catch (const std::invalid_argument& e) {
+                throw std::runtime_error("SyncEngine: merge failed for DBI '" + dbi_name +
+                                         "': " + e.what());
+            }
+        }
+
         std::shared_ptr<Connection> m_conn;
         ConflictPolicy              m_policy;
+        std::shared_ptr<mdbxc::detail::ThreadPool> m_prepare_pool; ///< Null when pushes prepare inline.
+        std::shared_ptr<OriginTailCache> m_tail_cache; ///< Used when the capture sink keeps none.
+        std::shared_ptr<AppliedCursorCache> m_applied_cache;
+        PullSchedule                m_pull_schedule = PullSchedule::KeyOrder;
+        bool                        m_pull_readahead = true;
+        std::chrono::milliseconds   m_max_pull_wait{0};
+        std::shared_ptr<PullResumeTable> m_pull_resume;
+        std::shared_ptr<SnapshotSessionTable> m_snapshot_sessions;
+        std::shared_ptr<PeerWatermarkTable> m_peer_watermarks;
+        std::chrono::milliseconds   m_snapshot_session_timeout{300000};
     };
 
 } // namespace sync
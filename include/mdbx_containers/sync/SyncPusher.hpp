@@ -0,0 +1,354 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_SYNC_PUSHER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_SYNC_PUSHER_HPP_INCLUDED
+
+/// \file SyncPusher.hpp
+/// \brief Background pusher that sends new local batches right after they commit.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ISyncPeer.hpp"
+#include "cancellation.hpp"
+#include "SyncEngine.hpp"
+#include "protocol.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Timing and paging settings for \c SyncPusher.
+    struct SyncPusherOptions {
+        /// \brief Delay between the commit that woke a peer's pusher and
+        /// the push, so a burst of commits leaves as one push; 0 pushes at once.
+        std::chrono::milliseconds coalesce_window = std::chrono::milliseconds(2);
+
+        /// \brief Max local batches sent to a peer per push.
+        std::uint64_t max_batches = 1000;
+
+        /// \brief Longest wait for a commit before the local tail is checked
+        /// anyway.
+        /// \details Commits made through this process's \c Connection wake
+        /// the pushers at once; this catches the rest, e.g. batches written
+        /// by another process.
+        std::chrono::milliseconds recheck_interval = std::chrono::milliseconds(1000);
+
+        /// \brief Initial delay after a failed push to a peer.
+        std::chrono::milliseconds initial_backoff =
+            std::chrono::milliseconds(100);
+
+        /// \brief Maximum delay after repeated failed pushes to a peer.
+        std::chrono::milliseconds max_backoff =
+            std::chrono::milliseconds(5000);
+    };
+
+    /// \brief Counters of one peer of a \c SyncPusher.
+    struct SyncPusherPeerStatus {
+        std::uint64_t next_seq = 0;       ///< Next local \c seq to send; 0 until the peer answered.
+        std::uint64_t pushes = 0;         ///< Successful pushes, probes included.
+        std::uint64_t batches_pushed = 0; ///< Batches in those pushes.
+        std::uint64_t failures = 0;       ///< Failed pushes, in total.
+        std::string last_error;           ///< Error of the last failed push.
+    };
+
+    /// \brief Thread-safe snapshot of a \c SyncPusher.
+    struct SyncPusherStatus {
+        bool running = false;                 ///< Between \c start() and \c stop().
+        std::vector<SyncPusherPeerStatus> peers; ///< In constructor order.
+    };
+
+    /// \brief Pushes new local batches to several peers as soon as they commit.
+    /// \details Without it local changes reach a peer only when the peer
+    /// pulls, once per its \c idle_interval. Each peer gets a pusher thread
+    /// that sleeps in \c Connection::wait_for_commit(), so the commit of a
+    /// \c ThreadLocalChangeAccumulator flush wakes it immediately. It then
+    /// waits \c coalesce_window for the rest of a burst and sends every
+    /// local batch the peer lacks with \c SyncEngine::make_push_request(),
+    /// \c max_batches at a time. The first push to a peer carries no batch
+    /// and only asks for its \c receiver_have; later pushes continue from
+    /// the \c receiver_have of the previous answer, and a failed push makes
+    /// the next one ask again. Only batches of the local origin are pushed;
+    /// relaying other origins is left to pulls.
+    /// \note The engine and peers must outlive the pusher. Peers must accept
+    /// pushes, e.g. \c DirectSyncPeer or \c HttpSyncPeer, and a peer driven
+    /// by a \c SyncWorker should not be shared with the pusher.
+    /// \thread_safety \ref start(), \ref stop() and \ref push_now() must be
+    /// serialized by the caller; \ref status() is thread-safe.
+    class SyncPusher {
+    public:
+        /// \throws std::invalid_argument when \p peers is empty or holds a
+        ///         null pointer, or \p options is unusable.
+        SyncPusher(SyncEngine& engine,
+                   const std::vector<ISyncPeer*>& peers,
+                   const SyncPusherOptions& options = SyncPusherOptions())
+            : m_engine(engine), m_peers(peers), m_options(options) {
+            if (m_peers.empty()) {
+                throw std::invalid_argument("SyncPusher: no peers");
+            }
+            for (std::size_t i = 0; i < m_peers.size(); ++i) {
+                if (m_peers[i] == nullptr) {
+                    throw std::invalid_argument("SyncPusher: null peer");
+                }
+            }
+            validate_options(m_options);
+            m_status.peers.resize(m_peers.size());
+        }
+
+        /// \brief Stops and joins every thread.
+        ~SyncPusher() {
+            stop();
+        }
+
+        SyncPusher(const SyncPusher&) = delete;
+        SyncPusher& operator=(const SyncPusher&) = delete;
+
+        /// \brief Starts one pusher thread per peer.
+        /// \throws std::logic_error if the pusher is already running.
+        void start() {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                if (m_status.running) {
+                    throw std::logic_error("SyncPusher is already running");
+                }
+                m_stop_requested = false;
+                m_cancel = CancellationSource();
+                m_status.running = true;
+            }
+            try {
+                for (std::size_t i = 0; i < m_peers.size(); ++i) {
+                    m_threads.push_back(std::thread(&SyncPusher::push_main, this, i));
+                }
+            } catch (...) {
+                stop();
+                throw;
+            }
+        }
+
+        /// \brief Cancels in-flight pushes and joins every thread.
+        /// \details May block until in-flight \c ISyncPeer::push() calls
+        /// return, and for up to \ref stop_poll() while a thread waits for a commit.
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                if (!m_status.running) {
+                    return;
+                }
+                m_stop_requested = true;
+            }
+            m_cancel.request_cancel();
+            for (std::size_t i = 0; i < m_peers.size(); ++i) {
+                m_peers[i]->request_cancel();
+            }
+            m_changed.notify_all();
+            for (std::size_t i = 0; i < m_threads.size(); ++i) {
+                if (m_threads[i].joinable()) {
+                    m_threads[i].join();
+                }
+            }
+            m_threads.clear();
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_status.running = false;
+        }
+
+        /// \brief Pushes every pending local batch to every peer on the
+        /// calling thread.
+        /// \details For callers that drive pushes themselves, e.g. right
+        /// after a write they must see replicated. Failures are recorded in
+        /// \ref status() as in the background threads.
+        /// \return \c true when every peer now has every local batch.
+        /// \throws std::logic_error while the pusher is running.
+        bool push_now() {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                if (m_status.running) {
+                    throw std::logic_error("SyncPusher::push_now: pusher is running");
+                }
+            }
+            bool caught_up = true;
+            for (std::size_t i = 0; i < m_peers.size(); ++i) {
+                bool more = true;
+                std::string error;
+                while (more && error.empty()) {
+                    more = push_once(i, error);
+                }
+                if (!error.empty()) {
+                    caught_up = false;
+                }
+            }
+            return caught_up;
+        }
+
+        /// \brief Returns a snapshot of the counters.
+        SyncPusherStatus status() const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            return m_status;
+        }
+
+        /// \brief Longest slice a pusher thread waits for a commit before it
+        /// checks for \ref stop().
+        static std::chrono::milliseconds stop_poll() {
+            return std::chrono::milliseconds(50);
+        }
+
+    private:
+        static void validate_options(const SyncPusherOptions& options) {
+            if (options.max_batches == 0) {
+                throw std::invalid_argument("SyncPusherOptions: max_batches must be positive");
+            }
+            if (options.coalesce_window.count() < 0 ||
+                options.recheck_interval.count() <= 0 ||
+                options.initial_backoff.count() <= 0 ||
+                options.max_backoff < options.initial_backoff) {
+                throw std::invalid_argument("SyncPusherOptions: invalid intervals");
+            }
+        }
+
+        /// \brief Pusher loop of peer \p index.
+        void push_main(std::size_t index) {
+            const std::shared_ptr<Connection>& conn = m_engine.connection();
+            std::chrono::milliseconds backoff = m_options.initial_backoff;
+            while (!stop_requested()) {
+                // Read before pushing so a commit made meanwhile is not missed.
+                const std::uint64_t seen = conn->commit_sequence();
+                std::string error;
+                const bool more = push_once(index, error);
+                if (stop_requested()) {
+                    return;
+                }
+                if (!error.empty()) {
+                    if (wait_for_stop(backoff)) {
+                        return;
+                    }
+                    backoff = (std::min)(backoff * 2, m_options.max_backoff);
+                    continue;
+                }
+                backoff = m_options.initial_backoff;
+                if (more) {
+                    continue;
+                }
+                if (!wait_for_commit(*conn, seen)) {
+                    return;
+                }
+                if (m_options.coalesce_window.count() > 0 &&
+                    wait_for_stop(m_options.coalesce_window)) {
+                    return;
+                }
+            }
+        }
+
+        /// \brief Sends one push to peer \p index.
+        /// \param error Receives the error of a failed push.
+        /// \return \c true when more local batches wait for the peer.
+        bool push_once(std::size_t index, std::string& error) {
+            ISyncPeer& peer = *m_peers[index];
+            std::size_t sent = 0;
+            std::uint64_t next_seq = 0;
+            bool more = false;
+            try {
+                {
+                    std::lock_guard<std::mutex> lk(m_mutex);
+                    next_seq = m_status.peers[index].next_seq;
+                }
+                PushRequest request;
+                if (next_seq == 0) {
+                    // Asks where the peer is; an empty push writes nothing.
+                    request.sender = m_engine.local_node_id();
+                    request.db_id = m_engine.db_uuid();
+                } else {
+                    const std::uint64_t tail = m_engine.local_seq();
+                    if (tail < next_seq) {
+                        return false;
+                    }
+                    const std::uint64_t last = tail - next_seq >= m_options.max_batches
+                        ? next_seq + m_options.max_batches - 1
+                        : tail;
+                    request = m_engine.make_push_request(next_seq, last);
+                    sent = request.batches.size();
+                }
+                request.cancel_token = m_cancel.token();
+                const PushResponse response = peer.push(request);
+                if (!response.ok) {
+                    error = response.error.empty() ? "push failed" : response.error;
+                } else {
+                    next_seq = response.receiver_have.last_seq_for(request.sender) + 1;
+                    more = m_engine.local_seq() >= next_seq;
+                }
+            } catch (const std::exception& e) {
+                error = e.what();
+            } catch (...) {
+                error = "unknown push error";
+            }
+            std::lock_guard<std::mutex> lk(m_mutex);
+            SyncPusherPeerStatus& status = m_status.peers[index];
+            if (error.empty()) {
+                ++status.pushes;
+                status.batches_pushed += sent;
+                status.next_seq = next_seq;
+            } else {
+                ++status.failures;
+                status.last_error = error;
+                // Ask again where the peer is before the next push.
+                status.next_seq = 0;
+            }
+            return more;
+        }
+
+        /// \brief Waits until a commit follows \p seen or \c recheck_interval passes.
+        /// \return \c false when stop was requested.
+        bool wait_for_commit(const Connection& conn, std::uint64_t seen) const {
+            typedef std::chrono::steady_clock clock;
+            const clock::time_point deadline = clock::now() + m_options.recheck_interval;
+            for (;;) {
+                if (stop_requested()) {
+                    return false;
+                }
+                const clock::time_point now = clock::now();
+                if (now >= deadline) {
+                    return true;
+                }
+                const clock::duration left = deadline - now;
+                const clock::duration slice = left < clock::duration(stop_poll())
+                    ? left
+                    : clock::duration(stop_poll());
+                if (conn.wait_for_commit(seen, slice)) {
+                    return !stop_requested();
+                }
+            }
+        }
+
+        /// \brief Sleeps for \p duration unless stop is requested first.
+        /// \return \c true when stop was requested.
+        bool wait_for_stop(std::chrono::milliseconds duration) const {
+            std::unique_lock<std::mutex> lk(m_mutex);
+            return m_changed.wait_for(lk, duration, [this]() { return m_stop_requested; });
+        }
+
+        bool stop_requested() const {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            return m_stop_requested;
+        }
+
+        SyncEngine&                     m_engine;
+        std::vector<ISyncPeer*>         m_peers;
+        SyncPusherOptions               m_options;
+        CancellationSource              m_cancel;
+        std::vector<std::thread>        m_threads;
+        mutable std::mutex              m_mutex;
+        mutable std::condition_variable m_changed;
+        bool                            m_stop_requested = false;
+        SyncPusherStatus                m_status;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_SYNC_PUSHER_HPP_INCLUDED
@@ -0,0 +1,136 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_SYNC_TRACING_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_SYNC_TRACING_HPP_INCLUDED
+
+/// \file SyncTracing.hpp
+/// \brief Optional timing spans around sync worker, codec, and engine stages.
+/// \details
+/// A process-wide \ref ISyncTracer receives one start/end pair per stage. The
+/// interface maps onto OpenTelemetry's \c Tracer::StartSpan() and
+/// \c Span::End(): return the started span from \ref ISyncTracer::start_sync_span()
+/// and end it in \ref ISyncTracer::end_sync_span(). Spans start and end on the
+/// same thread and nest, so a tracer can keep a thread-local parent stack.
+/// With no tracer installed a span costs one atomic load.
+
+#include <atomic>
+#include <cstdint>
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Stage covered by a sync span.
+    enum class SyncSpanKind : std::uint8_t {
+        WorkerRound, ///< One \c SyncWorker round.
+        WorkerPull,  ///< One \c ISyncPeer::pull() issued by \c SyncWorker.
+        WorkerApply, ///< Local apply of one pulled page by \c SyncWorker.
+        CodecEncode, ///< \c TransportMessageCodec encode of one message.
+        CodecDecode, ///< \c TransportMessageCodec decode of one message.
+        PullRead,    ///< Change-log read of one \c SyncEngine::handle_pull() page.
+        PushApply,   ///< \c SyncEngine::handle_push(), from decode to commit.
+        PushCommit   ///< MDBX commit inside \c SyncEngine::handle_push().
+    };
+
+    /// \brief Stable span name, e.g. \c "mdbxc.sync.worker.round".
+    inline const char* sync_span_name(SyncSpanKind kind) {
+        switch (kind) {
+        case SyncSpanKind::WorkerRound: return "mdbxc.sync.worker.round";
+        case SyncSpanKind::WorkerPull:  return "mdbxc.sync.worker.pull";
+        case SyncSpanKind::WorkerApply: return "mdbxc.sync.worker.apply";
+        case SyncSpanKind::CodecEncode: return "mdbxc.sync.codec.encode";
+        case SyncSpanKind::CodecDecode: return "mdbxc.sync.codec.decode";
+        case SyncSpanKind::PullRead:    return "mdbxc.sync.engine.pull_read";
+        case SyncSpanKind::PushApply:   return "mdbxc.sync.engine.push_apply";
+        case SyncSpanKind::PushCommit:  return "mdbxc.sync.engine.push_commit";
+        }
+        return "mdbxc.sync.unknown";
+    }
+
+    /// \brief Receives sync spans.
+    /// \details Called on the thread running the stage; implementations must
+    /// be thread-safe. Exceptions are swallowed.
+    class ISyncTracer {
+    public:
+        virtual ~ISyncTracer() {}
+
+        /// \brief Starts a span and returns an opaque handle for its end.
+        virtual void* start_sync_span(SyncSpanKind kind) = 0;
+
+        /// \brief Ends a span started by \ref start_sync_span().
+        /// \param ok \c false when the stage threw or reported a failure.
+        /// \param items Bytes for codec spans, batches for the others.
+        virtual void end_sync_span(void* span,
+                                   SyncSpanKind kind,
+                                   bool ok,
+                                   std::uint64_t items) = 0;
+    };
+
+    namespace detail {
+        inline std::atomic<ISyncTracer*>& sync_tracer_slot() {
+            static std::atomic<ISyncTracer*> slot(nullptr);
+            return slot;
+        }
+    } // namespace detail
+
+    /// \brief Installs \p tracer process-wide; \c nullptr disables tracing.
+    /// \details The tracer must outlive every span started while it was
+    /// installed, so uninstall it only after sync activity has stopped.
+    inline void set_sync_tracer(ISyncTracer* tracer) {
+        detail::sync_tracer_slot().store(tracer, std::memory_order_release);
+    }
+
+    /// \brief Returns the installed tracer, or \c nullptr.
+    inline ISyncTracer* sync_tracer() {
+        return detail::sync_tracer_slot().load(std::memory_order_acquire);
+    }
+
+    /// \brief RAII span reported to the installed \ref ISyncTracer.
+    /// \details Ends as failed unless \ref finish() was called first, so a
+    /// stage left by an exception is reported as such.
+    class SyncSpan {
+    public:
+        explicit SyncSpan(SyncSpanKind kind)
+            : m_tracer(sync_tracer()),
+              m_span(nullptr),
+              m_kind(kind),
+              m_ok(false),
+              m_items(0) {
+            if (m_tracer == nullptr) {
+                return;
+            }
+            try {
+                m_span = m_tracer->start_sync_span(kind);
+            } catch (...) {
+                m_tracer = nullptr;
+            }
+        }
+
+        ~SyncSpan() {
+            if (m_tracer == nullptr) {
+                return;
+            }
+            try {
+                m_tracer->end_sync_span(m_span, m_kind, m_ok, m_items);
+            } catch (...) {}
+        }
+
+        SyncSpan(const SyncSpan&) = delete;
+        SyncSpan& operator=(const SyncSpan&) = delete;
+
+        /// \brief Records the outcome reported when the span ends.
+        void finish(bool ok, std::uint64_t items) {
+            m_ok = ok;
+            m_items = items;
+        }
+
+    private:
+        ISyncTracer* m_tracer;
+        void* m_span;
+        SyncSpanKind m_kind;
+        bool m_ok;
+        std::uint64_t m_items;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_SYNC_TRACING_HPP_INCLUDED
@@ -9,17 +9,22 @@
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <exception>
 #include <limits>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <utility>
 
+#include "ChangeBatchView.hpp"
 #include "ISyncPeer.hpp"
 #include "cancellation.hpp"
 #include "SyncEngine.hpp"
+#include "SyncTracing.hpp"
 #include "protocol.hpp"
 
 namespace mdbxc {
@@ -71,9 +76,18 @@ namespace sync {
         std::uint64_t max_single_batch_bytes = 4ULL * 1024ULL * 1024ULL;
 
         /// \brief Delay between successful background sync rounds.
+        /// \details With \c pull_wait the first pull of a round already
+        /// waits for new changes, so this can be lowered, even to 0.
         std::chrono::milliseconds idle_interval =
             std::chrono::milliseconds(1000);
 
+        /// \brief Long-poll time sent as \c PullRequest::wait_timeout_ms.
+        /// \details 0 disables long-poll. Otherwise the first pull of each
+        /// round asks the peer to hold an empty page for up to this long
+        /// until a commit has changes for this replica; the peer caps it by
+        /// \c SyncEngine::max_pull_wait(). Transport timeouts must exceed it.
+        std::chrono::milliseconds pull_wait = std::chrono::milliseconds(0);
+
         /// \brief Initial delay after a failed background sync round.
         std::chrono::milliseconds initial_backoff =
             std::chrono::milliseconds(100);
@@ -82,9 +96,56 @@ namespace sync {
         std::chrono::milliseconds max_backoff =
             std::chrono::milliseconds(5000);
 
+        /// \brief Whether the replica loads a full snapshot when it has none.
+        /// \details When set, the first round of a worker whose applied
+        /// cursor is empty pulls a full snapshot through
+        /// \c PullRequest::request_full_snapshot instead of replaying the
+        /// peer's changelog, and so does any round after the peer answers
+        /// \c SnapshotRequired or while \c SyncEngine::snapshot_import_pending()
+        /// reports an unfinished import. Snapshot pages are loaded with
+        /// \c SyncEngine::apply_snapshot_page(); incremental pulls continue
+        /// from the snapshot's cursor. Snapshot rounds do not long-poll or
+        /// pull ahead.
+        bool snapshot_bootstrap = false;
+
+        /// \brief Sent as \c PullRequest::subscription; empty pulls every table.
+        /// \details Changelog pages then only carry the subscribed tables and
+        /// key prefixes. Snapshot bootstrap still loads every table.
+        std::vector<SyncTableSubscription> subscription;
+
         /// \brief Whether one round drains all \c has_more pages immediately.
         bool drain_pages = true;
 
+        /// \brief Pages pulled ahead while an earlier page is applied.
+        /// \details 0 keeps the strict pull, apply, pull order. With a
+        /// positive value and \c drain_pages, once a page reports
+        /// \c has_more the next pull is sent on a helper thread with the
+        /// cursor the page will reach, so network round trips overlap local
+        /// applies. At most this many pulled pages wait for apply; each may
+        /// hold up to \c max_bytes.
+        std::size_t pipeline_depth = 0;
+
+        /// \brief Whether the page budget adapts to the observed page time.
+        /// \details When set, \c max_bytes is only the starting budget. After
+        /// each page pulled inline the worker compares the pull round trip
+        /// plus the local apply with \c adaptive_target_page_time: a faster
+        /// page that filled its budget grows it by a quarter of \c max_bytes,
+        /// while a slower page or a failed transport call halves it. The
+        /// budget stays within \c adaptive_min_bytes and
+        /// \c adaptive_max_bytes, and \c max_batches is scaled with it.
+        /// Long-polled first pages and pages pulled ahead are not measured.
+        bool adaptive_paging = false;
+
+        /// \brief Pull plus apply time one adaptive page should take.
+        std::chrono::milliseconds adaptive_target_page_time =
+            std::chrono::milliseconds(500);
+
+        /// \brief Lower bound of the adaptive page budget.
+        std::uint64_t adaptive_min_bytes = 64ULL * 1024ULL;
+
+        /// \brief Upper bound of the adaptive page budget.
+        std::uint64_t adaptive_max_bytes = 64ULL * 1024ULL * 1024ULL;
+
         /// \brief How the background worker handles permanent transport hints.
         /// \details The default keeps v0.1 retry hints advisory. Set to
         /// \c StopWorker when a classified permanent transport failure should
@@ -130,6 +191,10 @@ namespace sync {
         SyncResponseErrorCode sync_error_code =
             SyncResponseErrorCode::None;
         bool sync_error_retryable = false; ///< Sync-level recovery hint.
+        /// \brief MDBX commit phases summed over the round's local applies.
+        /// \details Tells fsync stalls (\c sync) apart from free-list
+        /// maintenance (\c gc) when apply commits dominate a round.
+        CommitLatency commit_latency;
     };
 
     /// \brief Fine-grained observer event for sync round stages.
@@ -184,6 +249,8 @@ namespace sync {
         std::chrono::steady_clock::time_point last_round_finished_at;
         std::string last_error; ///< Most recent worker failure message.
         std::string last_observer_error; ///< Most recent observer failure.
+        std::uint64_t page_max_bytes = 0; ///< Current pull page byte budget.
+        std::uint64_t page_max_batches = 0; ///< Current pull page batch budget.
     };
 
     /// \brief Details for a successfully applied page.
@@ -250,8 +317,13 @@ namespace sync {
     ///
     /// The implementation never keeps a local MDBX transaction open while
     /// waiting in \c ISyncPeer::pull(), idle sleep, or backoff sleep. Pulled
-    /// batches are applied through \c SyncEngine::handle_push(), which opens
-    /// and commits a short local write transaction for each pulled page.
+    /// batches are applied through \c SyncEngine::handle_push(), and full
+    /// snapshot pages through \c SyncEngine::apply_snapshot_page(); both open
+    /// and commit a short local write transaction for each pulled page.
+    /// With \c SyncWorkerOptions::pipeline_depth set, later pages of a round
+    /// are pulled on a helper thread while earlier ones are applied; observer
+    /// callbacks still run on the round thread, which reports
+    /// \c PullStarted and \c PullFinished for such a page when it takes it.
     /// Stop requests cancel the active request token and call
     /// \c ISyncPeer::request_cancel() at most once for each observed in-flight
     /// peer call. Cancellation is best-effort: \c stop(), \c join(), and the
@@ -272,8 +344,15 @@ namespace sync {
               m_stop_requested(false),
               m_peer_call_active(false),
               m_peer_cancel_requested(false),
-              m_peer_cancel_source() {
+              m_peer_cancel_source(),
+              m_bootstrap_checked(false),
+              m_snapshot_wanted(false) {
             validate_options(m_options);
+            m_page_bytes = m_options.max_bytes;
+            if (m_options.adaptive_paging) {
+                m_page_bytes = clamp_page_bytes(m_page_bytes);
+            }
+            reset_status_locked();
         }
 
         /// \brief Requests stop and waits for the background worker to finish.
@@ -335,11 +414,7 @@ namespace sync {
             {
                 std::lock_guard<std::mutex> lock(m_mutex);
                 m_stop_requested = true;
-                if (m_peer_call_active && !m_peer_cancel_requested) {
-                    m_peer_cancel_source.request_cancel();
-                    m_peer_cancel_requested = true;
-                    cancel_peer = true;
-                }
+                cancel_peer = cancel_peer_call_locked();
                 if (m_state != SyncWorkerState::Stopped &&
                     m_state != SyncWorkerState::Failed) {
                     m_state = SyncWorkerState::Stopping;
@@ -389,7 +464,7 @@ namespace sync {
                 m_last_observer_error.clear();
                 reset_status_locked();
             }
-            const SyncWorkerRoundResult result = run_once_impl();
+            const SyncWorkerRoundResult result = run_traced_round();
             notify_round_completed(result);
             if (stop_requested()) {
                 set_state(SyncWorkerState::Stopped);
@@ -478,6 +553,148 @@ namespace sync {
             bool        m_active;
         };
 
+        /// \brief Page pulled ahead by \c PagePrefetcher.
+        struct PrefetchedPage {
+            PullResponse response;
+            SyncTransportRetryHint retry_hint; ///< Read after a failed pull.
+            std::exception_ptr error;          ///< Thrown by the pull.
+        };
+
+        /// \brief Pulls pages ahead of apply on a helper thread.
+        /// \details Each request uses the cursor the previous page reaches
+        /// once applied. The helper stops after a failed or final page, a
+        /// page without cursor progress, or a stop request. Pages are handed
+        /// over in order; observer events stay on the round thread.
+        class PagePrefetcher {
+        public:
+            PagePrefetcher(SyncWorker& worker,
+                           const PullRequest& request,
+                           std::size_t depth)
+                : m_worker(worker),
+                  m_request(request),
+                  m_depth(depth),
+                  m_done(false),
+                  m_abort(false) {
+                m_thread = std::thread(&PagePrefetcher::run, this);
+            }
+
+            /// \brief Stops pulling, cancels an in-flight pull, and joins.
+            ~PagePrefetcher() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_abort = true;
+                }
+                m_changed.notify_all();
+                m_worker.cancel_peer_call();
+                m_thread.join();
+            }
+
+            PagePrefetcher(const PagePrefetcher&) = delete;
+            PagePrefetcher& operator=(const PagePrefetcher&) = delete;
+
+            /// \brief Waits for the next page.
+            /// \return \c false when the helper stopped without one.
+            bool next(PrefetchedPage& page) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_changed.wait(lock, [this] { return !m_pages.empty() || m_done; });
+                if (m_pages.empty()) {
+                    return false;
+                }
+                page = std::move(m_pages.front());
+                m_pages.pop_front();
+                m_changed.notify_all();
+                return true;
+            }
+
+        private:
+            void run() {
+                for (;;) {
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_changed.wait(lock, [this] {
+                            return m_abort || m_pages.size() < m_depth;
+                        });
+                        if (m_abort) {
+                            break;
+                        }
+                    }
+                    PrefetchedPage page;
+                    bool last = true;
+                    try {
+                        CancellationToken cancel_token;
+                        PeerCallGuard peer_call(m_worker, cancel_token);
+                        if (!peer_call.active()) {
+                            break;
+                        }
+                        m_request.cancel_token = cancel_token;
+                        SyncSpan span(SyncSpanKind::WorkerPull);
+                        page.response = m_worker.m_peer.pull(m_request);
+                        span.finish(page.response.ok,
+                                    page.response.batches.size() +
+                                        page.response.encoded_batches.size());
+                        if (page.response.ok) {
+                            const SyncCursor before = m_request.have;
+                            m_request.have = expected_cursor(before, page.response);
+                            last = !page.response.has_more ||
+                                m_request.have.last_seq_by_origin ==
+                                    before.last_seq_by_origin;
+                        } else {
+                            page.retry_hint = m_worker.m_peer.last_retry_hint();
+                        }
+                    } catch (...) {
+                        page.error = std::current_exception();
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_pages.push_back(std::move(page));
+                    }
+                    m_changed.notify_all();
+                    if (last) {
+                        break;
+                    }
+                }
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_done = true;
+                }
+                m_changed.notify_all();
+            }
+
+            SyncWorker&                 m_worker;
+            PullRequest                 m_request;
+            const std::size_t           m_depth;
+            std::mutex                  m_mutex;
+            std::condition_variable     m_changed;
+            std::deque<PrefetchedPage>  m_pages;
+            bool                        m_done;
+            bool                        m_abort;
+            std::thread                 m_thread;
+        };
+
+        /// \brief Returns \p have advanced past every batch of \p response.
+        static SyncCursor expected_cursor(const SyncCursor& have,
+                                          const PullResponse& response) {
+            SyncCursor out = have;
+            for (std::size_t i = 0; i < response.batches.size(); ++i) {
+                advance_cursor(out, response.batches[i].origin_node_id,
+                               response.batches[i].seq);
+            }
+            for (std::size_t i = 0; i < response.encoded_batches.size(); ++i) {
+                const ChangeBatchView view(response.encoded_batches[i]);
+                advance_cursor(out, view.origin_node_id(), view.seq());
+            }
+            return out;
+        }
+
+        static void advance_cursor(SyncCursor& cursor,
+                                   const NodeId& origin,
+                                   std::uint64_t seq) {
+            std::uint64_t& last = cursor.last_seq_by_origin[origin];
+            if (seq > last) {
+                last = seq;
+            }
+        }
+
         static void validate_options(const SyncWorkerOptions& options) {
             if (options.max_batches == 0) {
                 throw std::invalid_argument(
@@ -495,6 +712,10 @@ namespace sync {
                 throw std::invalid_argument(
                     "SyncWorkerOptions::idle_interval must not be negative");
             }
+            if (options.pull_wait < std::chrono::milliseconds::zero()) {
+                throw std::invalid_argument(
+                    "SyncWorkerOptions::pull_wait must not be negative");
+            }
             if (options.initial_backoff < std::chrono::milliseconds::zero()) {
                 throw std::invalid_argument(
                     "SyncWorkerOptions::initial_backoff must not be negative");
@@ -507,6 +728,83 @@ namespace sync {
                 throw std::invalid_argument(
                     "SyncWorkerOptions::max_backoff must be at least initial_backoff");
             }
+            if (options.adaptive_paging) {
+                if (options.adaptive_target_page_time <= std::chrono::milliseconds::zero()) {
+                    throw std::invalid_argument(
+                        "SyncWorkerOptions::adaptive_target_page_time must be positive");
+                }
+                if (options.adaptive_min_bytes == 0) {
+                    throw std::invalid_argument(
+                        "SyncWorkerOptions::adaptive_min_bytes must be greater than zero");
+                }
+                if (options.adaptive_max_bytes < options.adaptive_min_bytes) {
+                    throw std::invalid_argument(
+                        "SyncWorkerOptions::adaptive_max_bytes must be at least adaptive_min_bytes");
+                }
+            }
+        }
+
+        std::uint64_t clamp_page_bytes(std::uint64_t bytes) const {
+            if (bytes < m_options.adaptive_min_bytes) {
+                return m_options.adaptive_min_bytes;
+            }
+            if (bytes > m_options.adaptive_max_bytes) {
+                return m_options.adaptive_max_bytes;
+            }
+            return bytes;
+        }
+
+        /// \brief \c max_batches scaled by the current byte budget.
+        std::uint64_t page_batches_budget() const {
+            if (m_page_bytes == m_options.max_bytes) {
+                return m_options.max_batches;
+            }
+            const long double scaled =
+                static_cast<long double>(m_options.max_batches) *
+                static_cast<long double>(m_page_bytes) /
+                static_cast<long double>(m_options.max_bytes);
+            if (scaled < 1.0L) {
+                return 1;
+            }
+            if (scaled >= static_cast<long double>(
+                    (std::numeric_limits<std::uint64_t>::max)())) {
+                return (std::numeric_limits<std::uint64_t>::max)();
+            }
+            return static_cast<std::uint64_t>(scaled);
+        }
+
+        /// \brief AIMD step after one measured page; see \c adaptive_paging.
+        /// \param ok Whether the transport call succeeded.
+        /// \param filled Whether the page was cut by its budget.
+        void adapt_page_budget(bool ok, bool filled,
+                               std::chrono::steady_clock::duration elapsed) {
+            if (!m_options.adaptive_paging) {
+                return;
+            }
+            std::uint64_t bytes = m_page_bytes;
+            if (!ok || elapsed > m_options.adaptive_target_page_time) {
+                bytes /= 2;
+            } else if (filled) {
+                const std::uint64_t step = m_options.max_bytes / 4 + 1;
+                bytes = bytes > (std::numeric_limits<std::uint64_t>::max)() - step
+                    ? (std::numeric_limits<std::uint64_t>::max)()
+                    : bytes + step;
+            }
+            bytes = clamp_page_bytes(bytes);
+            if (bytes == m_page_bytes) {
+                return;
+            }
+            m_page_bytes = bytes;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_status.page_max_bytes = m_page_bytes;
+            m_status.page_max_batches = page_batches_budget();
+        }
+
+        SyncWorkerRoundResult run_traced_round() {
+            SyncSpan span(SyncSpanKind::WorkerRound);
+            SyncWorkerRoundResult result = run_once_impl();
+            span.finish(result.ok, result.batches_applied);
+            return result;
         }
 
         SyncWorkerRoundResult run_once_impl() {
@@ -520,12 +818,21 @@ namespace sync {
                 request.requester = m_engine.local_node_id();
                 request.db_id = m_engine.db_uuid();
                 request.have = m_engine.applied_cursor();
-                request.max_batches = m_options.max_batches;
-                request.max_bytes = m_options.max_bytes;
+                request.max_batches = page_batches_budget();
+                request.max_bytes = m_page_bytes;
                 request.max_single_batch_bytes =
                     m_options.max_single_batch_bytes;
+                request.subscription = m_options.subscription;
+                request.request_full_snapshot = snapshot_wanted(request.have);
+                request.wait_timeout_ms = request.request_full_snapshot
+                    ? 0
+                    : static_cast<std::uint64_t>(m_options.pull_wait.count());
+                // Pulled batches are only applied, so keep them encoded.
+                request.batch_form = PullBatchForm::Encoded;
 
                 bool has_more = false;
+                // Started once a page reports has_more, see pipeline_depth.
+                std::unique_ptr<PagePrefetcher> prefetcher;
                 do {
                     if (stop_requested()) {
                         result.has_more = has_more;
@@ -534,7 +841,24 @@ namespace sync {
 
                     const SyncCursor before = request.have;
                     PullResponse response;
-                    {
+                    SyncTransportRetryHint pull_retry_hint;
+                    PrefetchedPage page;
+                    // Inline pulls without long-poll feed adapt_page_budget().
+                    bool measured = false;
+                    std::chrono::steady_clock::time_point page_started;
+                    if (prefetcher && !prefetcher->next(page)) {
+                        // The helper ended early; pull from here inline.
+                        prefetcher.reset();
+                    }
+                    if (prefetcher) {
+                        notify_stage_changed(make_stage_event(
+                            SyncWorkerStage::PullStarted, result));
+                        if (page.error) {
+                            std::rethrow_exception(page.error);
+                        }
+                        response = std::move(page.response);
+                        pull_retry_hint = page.retry_hint;
+                    } else {
                         CancellationToken cancel_token;
                         PeerCallGuard peer_call(*this, cancel_token);
                         if (!peer_call.active()) {
@@ -544,12 +868,35 @@ namespace sync {
                         notify_stage_changed(make_stage_event(
                             SyncWorkerStage::PullStarted, result));
                         request.cancel_token = cancel_token;
-                        response = m_peer.pull(request);
+                        request.max_batches = page_batches_budget();
+                        request.max_bytes = m_page_bytes;
+                        if (request.wait_timeout_ms == 0) {
+                            page_started = std::chrono::steady_clock::now();
+                            measured = true;
+                        }
+                        try {
+                            SyncSpan span(SyncSpanKind::WorkerPull);
+                            response = m_peer.pull(request);
+                            span.finish(response.ok,
+                                        response.batches.size() +
+                                            response.encoded_batches.size());
+                        } catch (...) {
+                            if (measured) {
+                                adapt_page_budget(false, false,
+                                    std::chrono::steady_clock::duration::zero());
+                            }
+                            throw;
+                        }
+                        if (!response.ok) {
+                            pull_retry_hint = m_peer.last_retry_hint();
+                        }
                     }
+                    const std::size_t page_batches =
+                        response.batches.size() + response.encoded_batches.size();
                     {
                         SyncWorkerStageEvent event = make_stage_event(
                             SyncWorkerStage::PullFinished, result);
-                        event.batches_in_page = response.batches.size();
+                        event.batches_in_page = page_batches;
                         event.has_more = response.has_more;
                         event.ok = response.ok;
                         event.error = response.error;
@@ -568,22 +915,35 @@ namespace sync {
                             result.progress = progress;
                             event.progress = progress;
                         } else {
-                            event.retry_hint = m_peer.last_retry_hint();
+                            event.retry_hint = pull_retry_hint;
                         }
                         notify_stage_changed(event);
                     }
                     if (!response.ok) {
+                        if (measured &&
+                            response.error_code == SyncResponseErrorCode::None) {
+                            // Sync-level errors say nothing about the link.
+                            adapt_page_budget(false, false,
+                                std::chrono::steady_clock::duration::zero());
+                        }
+                        if (response.error_code ==
+                                SyncResponseErrorCode::SnapshotRequired &&
+                            m_options.snapshot_bootstrap) {
+                            m_snapshot_wanted = true;
+                        }
                         result.ok = false;
                         result.error = response.error.empty()
                             ? "pull failed"
                             : response.error;
-                        result.retry_hint = m_peer.last_retry_hint();
+                        result.retry_hint = pull_retry_hint;
                         result.sync_error_code = response.error_code;
                         result.sync_error_retryable =
                             response.error_retryable;
                         return result;
                     }
                     ++result.pages_pulled;
+                    // Only the first page of a round long-polls.
+                    request.wait_timeout_ms = 0;
 
                     has_more = response.has_more;
                     if (stop_requested()) {
@@ -591,11 +951,16 @@ namespace sync {
                         return result;
                     }
 
-                    if (!response.batches.empty()) {
-                        PushRequest apply;
-                        apply.db_id = request.db_id;
-                        apply.batches = response.batches;
+                    if (has_more && page_batches != 0 && !prefetcher &&
+                        !request.request_full_snapshot &&
+                        m_options.pipeline_depth != 0 && m_options.drain_pages) {
+                        PullRequest ahead = request;
+                        ahead.have = expected_cursor(request.have, response);
+                        prefetcher.reset(new PagePrefetcher(
+                            *this, ahead, m_options.pipeline_depth));
+                    }
 
+                    if (page_batches != 0) {
                         if (!begin_apply_stage()) {
                             result.has_more = has_more;
                             return result;
@@ -603,7 +968,7 @@ namespace sync {
                         {
                             SyncWorkerStageEvent event = make_stage_event(
                                 SyncWorkerStage::ApplyStarted, result);
-                            event.batches_in_page = response.batches.size();
+                            event.batches_in_page = page_batches;
                             event.has_more = has_more;
                             event.progress = progress;
                             notify_stage_changed(event);
@@ -613,7 +978,21 @@ namespace sync {
                             result.has_more = has_more;
                             return result;
                         }
-                        applied = m_engine.handle_push(apply);
+                        {
+                            SyncSpan span(SyncSpanKind::WorkerApply);
+                            if (request.request_full_snapshot) {
+                                applied = m_engine.apply_snapshot_page(
+                                    response, request.snapshot_token.empty());
+                            } else {
+                                PushRequest apply;
+                                apply.db_id = request.db_id;
+                                apply.batches.swap(response.batches);
+                                apply.encoded_batches.swap(response.encoded_batches);
+                                applied = m_engine.handle_push(apply);
+                            }
+                            span.finish(applied.ok, page_batches);
+                        }
+                        result.commit_latency += applied.commit_latency;
                         SyncCursor after_apply = request.have;
                         if (applied.ok) {
                             after_apply = m_engine.applied_cursor();
@@ -622,13 +1001,13 @@ namespace sync {
                                     response.remote_tail,
                                     after_apply,
                                     result.batches_applied +
-                                        response.batches.size());
+                                        page_batches);
                             }
                         }
                         {
                             SyncWorkerStageEvent event = make_stage_event(
                                 SyncWorkerStage::ApplyFinished, result);
-                            event.batches_in_page = response.batches.size();
+                            event.batches_in_page = page_batches;
                             event.has_more = has_more;
                             event.ok = applied.ok;
                             event.error = applied.error;
@@ -638,7 +1017,7 @@ namespace sync {
                             if (applied.ok) {
                                 event.batches_applied =
                                     result.batches_applied +
-                                    response.batches.size();
+                                    page_batches;
                                 if (response.remote_tail_known) {
                                     event.progress = progress;
                                 }
@@ -655,24 +1034,43 @@ namespace sync {
                                 applied.error_retryable;
                             return result;
                         }
-                        result.batches_applied += response.batches.size();
+                        result.batches_applied += page_batches;
                         result.progress = progress;
                         request.have = after_apply;
+                        if (measured) {
+                            adapt_page_budget(true, has_more,
+                                std::chrono::steady_clock::now() - page_started);
+                        }
                     } else if (response.has_more) {
                         result.ok = false;
                         result.error = "pull reported has_more without batches";
                         return result;
                     }
 
-                    if (!response.batches.empty()) {
+                    if (page_batches != 0) {
                         SyncWorkerPageEvent event;
                         event.pages_pulled = result.pages_pulled;
-                        event.batches_applied = response.batches.size();
+                        event.batches_applied = page_batches;
                         event.has_more = has_more;
                         event.applied_cursor = request.have;
                         notify_page_applied(event);
                     }
-                    if (has_more &&
+                    if (request.request_full_snapshot) {
+                        if (has_more) {
+                            if (response.snapshot_token.empty()) {
+                                result.ok = false;
+                                result.error = "snapshot page reported has_more without snapshot_token";
+                                return result;
+                            }
+                            request.snapshot_token = response.snapshot_token;
+                        } else {
+                            // Loaded; continue with changes since the snapshot.
+                            m_snapshot_wanted = false;
+                            request.request_full_snapshot = false;
+                            request.snapshot_token.clear();
+                            has_more = true;
+                        }
+                    } else if (has_more &&
                         request.have.last_seq_by_origin == before.last_seq_by_origin) {
                         result.ok = false;
                         result.error = "pull pagination made no cursor progress";
@@ -692,6 +1090,18 @@ namespace sync {
             return result;
         }
 
+        /// \brief Whether this round pulls a full snapshot; see \c snapshot_bootstrap.
+        bool snapshot_wanted(const SyncCursor& have) {
+            if (!m_options.snapshot_bootstrap) {
+                return false;
+            }
+            if (!m_bootstrap_checked) {
+                m_bootstrap_checked = true;
+                m_snapshot_wanted = have.last_seq_by_origin.empty();
+            }
+            return m_snapshot_wanted || m_engine.snapshot_import_pending();
+        }
+
         SyncWorkerStageEvent make_stage_event(
                 SyncWorkerStage stage,
                 const SyncWorkerRoundResult& result) const {
@@ -732,7 +1142,7 @@ namespace sync {
         static std::uint64_t cursor_distance(const SyncCursor& from,
                                              const SyncCursor& to) {
             std::uint64_t distance = 0;
-            std::map<NodeId, std::uint64_t>::const_iterator it =
+            OriginSeqMap::const_iterator it =
                 to.last_seq_by_origin.begin();
             for (; it != to.last_seq_by_origin.end(); ++it) {
                 const std::uint64_t have = from.last_seq_for(it->first);
@@ -869,6 +1279,8 @@ namespace sync {
         void reset_status_locked() const {
             m_status = SyncWorkerStatus();
             m_status.state = m_state;
+            m_status.page_max_bytes = m_page_bytes;
+            m_status.page_max_batches = page_batches_budget();
         }
 
         void record_stage_status(
@@ -966,6 +1378,27 @@ namespace sync {
             return !m_stop_requested;
         }
 
+        /// \brief Cancels the in-flight peer call without stopping the worker.
+        void cancel_peer_call() const {
+            bool cancel_peer = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                cancel_peer = cancel_peer_call_locked();
+            }
+            if (cancel_peer) {
+                request_peer_cancel();
+            }
+        }
+
+        bool cancel_peer_call_locked() const {
+            if (!m_peer_call_active || m_peer_cancel_requested) {
+                return false;
+            }
+            m_peer_cancel_source.request_cancel();
+            m_peer_cancel_requested = true;
+            return true;
+        }
+
         void request_peer_cancel() const {
             try {
                 m_peer.request_cancel();
@@ -983,7 +1416,7 @@ namespace sync {
             try {
                 set_state(SyncWorkerState::Idle);
                 while (!stop_requested()) {
-                    const SyncWorkerRoundResult result = run_once_impl();
+                    const SyncWorkerRoundResult result = run_traced_round();
                     notify_round_completed(result);
                     if (stop_requested()) {
                         break;
@@ -1090,6 +1523,9 @@ namespace sync {
         mutable std::string         m_last_error;
         mutable std::string         m_last_observer_error;
         mutable SyncWorkerStatus    m_status;
+        bool                        m_bootstrap_checked; ///< Round thread only.
+        bool                        m_snapshot_wanted;   ///< Round thread only.
+        std::uint64_t               m_page_bytes = 0;    ///< Round thread writes; see adaptive_paging.
     };
 
 } // namespace sync
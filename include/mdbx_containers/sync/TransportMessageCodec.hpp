@@ -8,33 +8,76 @@
 /// Envelope layout for all messages:
 /// \code
 ///   magic             "MDBXCPRT"   8 bytes
-///   codec_version     u16 le       = 4
+///   codec_version     u16 le       = 10
 ///   message_type      u8           1=pull request, 2=pull response,
-///                                  3=push request, 4=push response
-///   message_flags     u32 le       = 0 in v0.1
+///                                  3=push request, 4=push response,
+///                                  5=range-hash request, 6=range-hash response
+///   message_flags     u32 le       0 or TRANSPORT_MESSAGE_ZSTD
 ///   payload           type-specific fields
 /// \endcode
 ///
+/// With \c TRANSPORT_MESSAGE_ZSTD the payload is a u32 le plain payload size
+/// followed by one Zstd frame of the plain payload. Encoders always write
+/// plain messages; \c compress_message() rewrites one as compressed under a
+/// \c TransportCompression policy, and every decoder expands it first. A
+/// peer advertises that it decodes them through
+/// \c PullRequest::accept_compressed_messages and
+/// \c PushResponse::accept_compressed_messages.
+///
 /// \c CancellationToken values are local call-control state and are never
 /// serialized. Decoded request DTOs always contain default non-cancellable
 /// tokens. \c ChangeBatch payloads are length-prefixed byte strings encoded by
-/// \c ChangeBatchCodec. Passing a null \c CodecBounds pointer uses the
+/// \c ChangeBatchCodec; a batch is sent compressed only when its
+/// \c BATCH_COMPRESSED_ZSTD flag is set, which responders do only for peers
+/// that advertise \c accept_compressed_batches. The \c encoded_batches of a
+/// pull response or push request follow \c batches in the same list, copied
+/// byte for byte; decoders put every batch in either field depending on the
+/// requested \c PullBatchForm. \c encode_pull_response_chunked() writes the
+/// same pull response bytes as a \c ChunkedTransportMessage for transports
+/// that stream a page instead of sending one buffer. Passing a null \c CodecBounds pointer uses the
 /// default bounds from \c CodecBounds; callers may pass stricter bounds for a
 /// specific transport.
+///
+/// The three pull cursors (\c have, \c remote_have, \c remote_tail) start
+/// with a form byte: 0 for the full entry list, 1 for a delta. A delta names
+/// its baseline by \c sync_cursor_digest() and lists the changed or added
+/// entries, then the removed origins, both in ascending origin order. A
+/// request's \c have is a delta against the cursor a \c CursorBaselineCache
+/// holds for the requester; response cursors are deltas against the
+/// request's \c have when it set \c accept_cursor_deltas. Encoders fall back
+/// to the full form whenever it is not larger.
+///
+/// A pull request ends with its \c subscription: a u32 table count, then
+/// per table its name and a u32 count of length-prefixed key prefixes. It
+/// and a push response then close with \c accept_compressed_messages.
+///
+/// Range-hash messages carry the fields of \c RangeHashRequest and
+/// \c RangeHashResponse in declaration order; lists are a u32 count and
+/// keys and values are u32-length-prefixed bytes bounded like \c ChangeOp
+/// keys and values.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ChangeBatchCodec.hpp"
 #include "CodecBounds.hpp"
+#include "SyncTracing.hpp"
+#include "codec_flags.hpp"
 #include "common.hpp"
 #include "protocol.hpp"
 
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+#include <zstd.h>
+#endif
+
 namespace mdbxc {
 namespace sync {
 
@@ -44,10 +87,194 @@ namespace sync {
         PullResponse = 2,
         PushRequest  = 3,
         PushResponse = 4,
+        RangeHashRequest  = 5,
+        RangeHashResponse = 6,
+    };
+
+    /// \brief When a transport sends messages with \c TRANSPORT_MESSAGE_ZSTD.
+    /// \details Applies only to peers that advertise
+    /// \c accept_compressed_messages. \c min_bytes trades CPU for bandwidth:
+    /// raise it on fast links, lower it for expensive cross-region traffic.
+    struct TransportCompression {
+        /// \brief Compress messages; has no effect without \c MDBXC_HAS_ZSTD.
+        bool enabled = false;
+        /// \brief Plain payloads smaller than this stay uncompressed.
+        std::size_t min_bytes = 16 * 1024;
+        /// \brief Zstd compression level.
+        int level = 1;
+    };
+
+    /// \brief Encoded transport message held as an ordered list of chunks.
+    /// \details Produced by \c TransportMessageCodec::encode_pull_response_chunked().
+    /// Large batches keep their own buffers, moved in from the response, so
+    /// a page is written to the wire without first being joined into one
+    /// contiguous copy. The concatenation of all chunks is byte-identical to
+    /// the contiguous encoding.
+    class ChunkedTransportMessage {
+    public:
+        ChunkedTransportMessage() = default;
+
+        /// \brief Wraps one contiguous encoded message as a single chunk.
+        explicit ChunkedTransportMessage(std::vector<std::uint8_t> bytes) {
+            append_chunk(std::move(bytes));
+            finish();
+        }
+
+        /// \brief Whether the message holds no bytes.
+        bool empty() const noexcept { return m_size == 0; }
+
+        /// \brief Total size of the message in bytes.
+        std::size_t size() const noexcept { return m_size; }
+
+        /// \brief Number of chunks.
+        std::size_t chunk_count() const noexcept { return m_chunks.size(); }
+
+        /// \brief Bytes of chunk \p index; never empty.
+        const std::vector<std::uint8_t>& chunk(std::size_t index) const {
+            return m_chunks.at(index);
+        }
+
+        /// \brief Passes every chunk in order to \p sink.
+        /// \param sink Callable as \c sink(const std::uint8_t*, std::size_t).
+        template <class Sink>
+        void write_to(Sink&& sink) const {
+            for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+                sink(&m_chunks[i][0], m_chunks[i].size());
+            }
+        }
+
+        /// \brief Joins the chunks into one contiguous buffer.
+        std::vector<std::uint8_t> to_vector() const {
+            std::vector<std::uint8_t> out;
+            out.reserve(m_size);
+            for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+                out.insert(out.end(), m_chunks[i].begin(), m_chunks[i].end());
+            }
+            return out;
+        }
+
+    private:
+        friend class TransportMessageCodec;
+
+        std::vector<std::vector<std::uint8_t>> m_chunks;
+        std::size_t m_size = 0;
+
+        /// \brief Open last chunk that small fields are appended to.
+        std::vector<std::uint8_t>& tail() {
+            if (m_chunks.empty()) {
+                m_chunks.push_back(std::vector<std::uint8_t>());
+            }
+            return m_chunks.back();
+        }
+
+        /// \brief Appends \p bytes as a chunk of its own.
+        void append_chunk(std::vector<std::uint8_t>&& bytes) {
+            if (!m_chunks.empty() && m_chunks.back().empty()) {
+                m_chunks.pop_back();
+            }
+            m_chunks.push_back(std::move(bytes));
+            m_chunks.push_back(std::vector<std::uint8_t>());
+        }
+
+        /// \brief Drops the empty trailing chunk and records the size.
+        void finish() {
+            while (!m_chunks.empty() && m_chunks.back().empty()) {
+                m_chunks.pop_back();
+            }
+            m_size = 0;
+            for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+                m_size += m_chunks[i].size();
+            }
+        }
+    };
+
+    /// \brief Last full \c PullRequest::have per requester, kept by a
+    /// responder so requesters can send \c have as a delta.
+    /// \details Thread-safe. Holds at most \c max_entries requesters and
+    /// drops the least recently stored one when full; a requester whose
+    /// baseline was dropped gets \c CursorBaselineMismatch and resends a full
+    /// cursor. A cap of 0 stores nothing, so requesters never send deltas.
+    class CursorBaselineCache {
+    public:
+        explicit CursorBaselineCache(std::size_t max_entries = 1024)
+            : m_max_entries(max_entries), m_clock(0) {}
+
+        CursorBaselineCache(const CursorBaselineCache&) = delete;
+        CursorBaselineCache& operator=(const CursorBaselineCache&) = delete;
+
+        /// \brief Copies the baseline of \p requester into \p out when its
+        /// digest is \p digest.
+        bool find(const NodeId& requester,
+                  std::uint64_t digest,
+                  SyncCursor& out) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const std::map<NodeId, Entry>::const_iterator it =
+                m_entries.find(requester);
+            if (it == m_entries.end() || it->second.digest != digest) {
+                return false;
+            }
+            out = it->second.cursor;
+            return true;
+        }
+
+        /// \brief Stores \c request.have as the baseline of its requester.
+        /// \details Only for successful pulls from requesters that accept
+        /// cursor deltas and sent a resolved \c have; sets
+        /// \c PullResponse::cursor_baseline_stored when stored.
+        void remember(const PullRequest& request, PullResponse& response) {
+            if (m_max_entries == 0 || !request.accept_cursor_deltas ||
+                !response.ok || request.have_baseline_digest != 0) {
+                return;
+            }
+            const std::uint64_t digest = sync_cursor_digest(request.have);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<NodeId, Entry>::iterator it = m_entries.find(request.requester);
+            if (it == m_entries.end()) {
+                if (m_entries.size() >= m_max_entries) {
+                    evict_oldest();
+                }
+                it = m_entries.insert(std::make_pair(request.requester, Entry())).first;
+            }
+            it->second.digest = digest;
+            it->second.cursor = request.have;
+            it->second.stamp = ++m_clock;
+            response.cursor_baseline_stored = true;
+        }
+
+        /// \brief Number of requesters with a stored baseline.
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+    private:
+        struct Entry {
+            std::uint64_t digest = 0;
+            SyncCursor cursor;
+            std::uint64_t stamp = 0;
+        };
+
+        void evict_oldest() {
+            std::map<NodeId, Entry>::iterator oldest = m_entries.begin();
+            for (std::map<NodeId, Entry>::iterator it = m_entries.begin();
+                 it != m_entries.end(); ++it) {
+                if (it->second.stamp < oldest->second.stamp) {
+                    oldest = it;
+                }
+            }
+            if (oldest != m_entries.end()) {
+                m_entries.erase(oldest);
+            }
+        }
+
+        const std::size_t m_max_entries;
+        mutable std::mutex m_mutex;
+        std::map<NodeId, Entry> m_entries;
+        std::uint64_t m_clock;
     };
 
     /// \brief Stable binary codec for \c PullRequest, \c PullResponse,
-    /// \c PushRequest, and \c PushResponse.
+    /// \c PushRequest, \c PushResponse and the range-hash messages.
     class TransportMessageCodec {
     public:
         /// \brief Encoded magic prefix (8 bytes, no NUL terminator).
@@ -61,68 +288,188 @@ namespace sync {
         static std::size_t magic_size() { return 8; }
 
         /// \brief Supported transport codec version.
-        static std::uint16_t codec_version() { return 4; }
+        static std::uint16_t codec_version() { return 10; }
 
         /// \brief Reads the message type from a transport envelope.
         /// \details Validates magic, codec version, and mandatory flags but
-        /// does not decode or validate the type-specific payload.
+        /// does not decode or validate the type-specific payload, which may
+        /// be compressed.
         static TransportMessageType peek_message_type(
                 const std::vector<std::uint8_t>& data,
                 const CodecBounds* bounds = nullptr) {
             bounds = effective_bounds(bounds);
             Cursor cur = make_cursor(data, bounds);
-            return read_header_type(cur);
+            return read_header_type(cur, TRANSPORT_MESSAGE_ZSTD);
+        }
+
+        /// \brief Rewrites the encoded \p message with a Zstd payload when
+        /// \p compression allows it and the result is smaller.
+        /// \return \c true when \p message was replaced.
+        /// \throws std::logic_error if \p message is shorter than an envelope.
+        static bool compress_message(std::vector<std::uint8_t>& message,
+                                     const TransportCompression& compression) {
+            if (message.size() < envelope_size()) {
+                throw std::logic_error("TransportMessageCodec::compress_message: truncated message");
+            }
+            const std::size_t raw_len = message.size() - envelope_size();
+            if (!compression.enabled || raw_len == 0 || raw_len < compression.min_bytes ||
+                raw_len > 0xFFFFFFFFu ||
+                detail::read_u32_le(&message[envelope_size() - 4]) != 0) {
+                return false;
+            }
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+            const std::size_t prefix = envelope_size() + 4;
+            std::vector<std::uint8_t> out(prefix + ZSTD_compressBound(raw_len));
+            const std::size_t packed_len =
+                ZSTD_compress(&out[prefix], out.size() - prefix,
+                              &message[envelope_size()], raw_len, compression.level);
+            if (ZSTD_isError(packed_len) || prefix + packed_len >= message.size()) {
+                return false;
+            }
+            std::memcpy(&out[0], &message[0], envelope_size());
+            detail::write_u32_le(TRANSPORT_MESSAGE_ZSTD, &out[envelope_size() - 4]);
+            detail::write_u32_le(static_cast<std::uint32_t>(raw_len), &out[envelope_size()]);
+            out.resize(prefix + packed_len);
+            message.swap(out);
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /// \brief Whether \p message has a \c TRANSPORT_MESSAGE_ZSTD payload.
+        static bool is_compressed(const std::vector<std::uint8_t>& message) {
+            return message.size() >= envelope_size() &&
+                   (detail::read_u32_le(&message[envelope_size() - 4]) &
+                    TRANSPORT_MESSAGE_ZSTD) != 0;
         }
 
         /// \brief Encodes a pull request.
+        /// \param have_baseline Cursor the responder holds for the
+        ///        requester; when set, \c have is sent as a delta against it.
         static std::vector<std::uint8_t> encode_pull_request(
                 const PullRequest& request,
-                const CodecBounds* bounds = nullptr) {
+                const CodecBounds* bounds = nullptr,
+                const SyncCursor* have_baseline = nullptr) {
             bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecEncode);
             std::vector<std::uint8_t> out =
                 make_header(TransportMessageType::PullRequest);
             append_node(out, request.requester);
             append_node(out, request.db_id);
-            append_cursor(out, request.have, bounds);
+            append_pull_cursor(out, request.have, have_baseline,
+                               digest_of(have_baseline), bounds);
             detail::append_u64_le(out, request.max_batches);
             detail::append_u64_le(out, request.max_bytes);
             append_bool(out, request.request_full_snapshot);
             detail::append_u64_le(out, request.max_single_batch_bytes);
+            append_bool(out, request.accept_compressed_batches);
+            detail::append_u64_le(out, request.wait_timeout_ms);
+            append_string(out, request.snapshot_token, bounds);
+            append_bool(out, request.accept_cursor_deltas);
+            append_subscription(out, request.subscription, bounds);
+            append_bool(out, request.accept_compressed_messages);
             validate_message_size(out, bounds);
+            span.finish(true, out.size());
             return out;
         }
 
         /// \brief Encodes a pull response.
+        /// \param cursor_baseline \c have of a request that set
+        ///        \c accept_cursor_deltas; when set, \c remote_have and
+        ///        \c remote_tail are sent as deltas against it.
         static std::vector<std::uint8_t> encode_pull_response(
                 const PullResponse& response,
-                const CodecBounds* bounds = nullptr) {
+                const CodecBounds* bounds = nullptr,
+                const SyncCursor* cursor_baseline = nullptr) {
             bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecEncode);
             std::vector<std::uint8_t> out =
                 make_header(TransportMessageType::PullResponse);
-            append_cursor(out, response.remote_have, bounds);
-            append_cursor(out, response.remote_tail, bounds);
+            const std::uint64_t baseline_digest = digest_of(cursor_baseline);
+            append_pull_cursor(out, response.remote_have, cursor_baseline,
+                               baseline_digest, bounds);
+            append_pull_cursor(out, response.remote_tail, cursor_baseline,
+                               baseline_digest, bounds);
             append_bool(out, response.remote_tail_known);
-            append_batches(out, response.batches, bounds);
+            append_batches(out, response.batches, bounds, &response.encoded_batches);
             append_bool(out, response.has_more);
             append_bool(out, response.ok);
             append_string(out, response.error, bounds);
             append_response_error_code(out, response.error_code);
             append_bool(out, response.error_retryable);
+            append_string(out, response.snapshot_token, bounds);
+            append_bool(out, response.cursor_baseline_stored);
             validate_message_size(out, bounds);
+            span.finish(true, out.size());
             return out;
         }
 
+        /// \brief Encodes a pull response as chunks instead of one buffer.
+        /// \details Writes the same bytes as \ref encode_pull_response(), but
+        /// encoded batches of at least \c chunked_batch_min_bytes() move out
+        /// of \p response into chunks of their own rather than being copied,
+        /// so pass an rvalue. Scalar fields and small batches share chunks.
+        /// \throws std::length_error as \ref encode_pull_response().
+        static ChunkedTransportMessage encode_pull_response_chunked(
+                PullResponse response,
+                const CodecBounds* bounds = nullptr,
+                const SyncCursor* cursor_baseline = nullptr) {
+            bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecEncode);
+            ChunkedTransportMessage message;
+            message.tail() = make_header(TransportMessageType::PullResponse);
+            const std::uint64_t baseline_digest = digest_of(cursor_baseline);
+            append_pull_cursor(message.tail(), response.remote_have,
+                               cursor_baseline, baseline_digest, bounds);
+            append_pull_cursor(message.tail(), response.remote_tail,
+                               cursor_baseline, baseline_digest, bounds);
+            append_bool(message.tail(), response.remote_tail_known);
+            append_batches_count(
+                message.tail(),
+                response.batches.size() + response.encoded_batches.size(),
+                bounds);
+            for (std::size_t i = 0; i < response.batches.size(); ++i) {
+                append_batch_chunk(
+                    message, ChangeBatchCodec::encode(response.batches[i], bounds), bounds);
+            }
+            for (std::size_t i = 0; i < response.encoded_batches.size(); ++i) {
+                append_batch_chunk(
+                    message, std::move(response.encoded_batches[i]), bounds);
+            }
+            append_bool(message.tail(), response.has_more);
+            append_bool(message.tail(), response.ok);
+            append_string(message.tail(), response.error, bounds);
+            append_response_error_code(message.tail(), response.error_code);
+            append_bool(message.tail(), response.error_retryable);
+            append_string(message.tail(), response.snapshot_token, bounds);
+            append_bool(message.tail(), response.cursor_baseline_stored);
+            message.finish();
+            if (message.size() > bounds->max_transport_message_bytes) {
+                throw std::length_error(
+                    "transport message exceeds max_transport_message_bytes");
+            }
+            span.finish(true, message.size());
+            return message;
+        }
+
+        /// \brief Smallest encoded batch given a chunk of its own by
+        /// \ref encode_pull_response_chunked().
+        static std::size_t chunked_batch_min_bytes() { return 4096; }
+
         /// \brief Encodes a push request.
         static std::vector<std::uint8_t> encode_push_request(
                 const PushRequest& request,
                 const CodecBounds* bounds = nullptr) {
             bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecEncode);
             std::vector<std::uint8_t> out =
                 make_header(TransportMessageType::PushRequest);
             append_node(out, request.sender);
             append_node(out, request.db_id);
-            append_batches(out, request.batches, bounds);
+            append_batches(out, request.batches, bounds, &request.encoded_batches);
             validate_message_size(out, bounds);
+            span.finish(true, out.size());
             return out;
         }
 
@@ -131,69 +478,115 @@ namespace sync {
                 const PushResponse& response,
                 const CodecBounds* bounds = nullptr) {
             bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecEncode);
             std::vector<std::uint8_t> out =
                 make_header(TransportMessageType::PushResponse);
             append_cursor(out, response.receiver_have, bounds);
+            append_bool(out, response.accept_compressed_batches);
             append_bool(out, response.ok);
             append_string(out, response.error, bounds);
             append_response_error_code(out, response.error_code);
             append_bool(out, response.error_retryable);
+            append_bool(out, response.accept_compressed_messages);
             validate_message_size(out, bounds);
+            span.finish(true, out.size());
             return out;
         }
 
         /// \brief Strictly decodes a pull request.
+        /// \param baselines Resolves a delta-encoded \c have. Without it, or
+        ///        when it lacks the named baseline, \c have is left empty and
+        ///        \c have_baseline_digest is set.
         static PullRequest decode_pull_request(
                 const std::vector<std::uint8_t>& data,
-                const CodecBounds* bounds = nullptr) {
+                const CodecBounds* bounds = nullptr,
+                const CursorBaselineCache* baselines = nullptr) {
             bounds = effective_bounds(bounds);
-            Cursor cur = make_cursor(data, bounds);
+            SyncSpan span(SyncSpanKind::CodecDecode);
+            std::vector<std::uint8_t> expanded;
+            Cursor cur = make_cursor(expand_message(data, bounds, expanded), bounds);
             check_header(cur, TransportMessageType::PullRequest);
             PullRequest request;
             read_node(cur, request.requester);
             read_node(cur, request.db_id);
-            request.have = read_cursor(cur, bounds);
+            if (read_cursor_form(cur) == cursor_form_full) {
+                request.have = read_cursor(cur, bounds);
+            } else {
+                const std::uint64_t digest = read_u64_le(cur);
+                SyncCursor baseline;
+                if (baselines != nullptr &&
+                    baselines->find(request.requester, digest, baseline)) {
+                    request.have = read_cursor_delta(cur, bounds, &baseline);
+                } else {
+                    read_cursor_delta(cur, bounds, nullptr);
+                    request.have_baseline_digest = digest;
+                }
+            }
             request.max_batches = read_u64_le(cur);
             request.max_bytes = read_u64_le(cur);
             request.request_full_snapshot = read_bool(cur);
             request.max_single_batch_bytes = read_u64_le(cur);
+            request.accept_compressed_batches = read_bool(cur);
+            request.wait_timeout_ms = read_u64_le(cur);
+            request.snapshot_token = read_string(cur, bounds);
+            request.accept_cursor_deltas = read_bool(cur);
+            request.subscription = read_subscription(cur, bounds);
+            request.accept_compressed_messages = read_bool(cur);
             check_consumed(cur);
+            span.finish(true, data.size());
             return request;
         }
 
         /// \brief Strictly decodes a pull response.
+        /// \param form With \c PullBatchForm::Encoded, each batch is
+        ///        validated in place and its bytes are kept in
+        ///        \c encoded_batches instead of being decoded.
+        /// \param cursor_baseline \c have of the request; required when the
+        ///        responder sent cursor deltas.
         static PullResponse decode_pull_response(
                 const std::vector<std::uint8_t>& data,
-                const CodecBounds* bounds = nullptr) {
+                const CodecBounds* bounds = nullptr,
+                PullBatchForm form = PullBatchForm::Decoded,
+                const SyncCursor* cursor_baseline = nullptr) {
             bounds = effective_bounds(bounds);
-            Cursor cur = make_cursor(data, bounds);
+            SyncSpan span(SyncSpanKind::CodecDecode);
+            std::vector<std::uint8_t> expanded;
+            Cursor cur = make_cursor(expand_message(data, bounds, expanded), bounds);
             check_header(cur, TransportMessageType::PullResponse);
             PullResponse response;
-            response.remote_have = read_cursor(cur, bounds);
-            response.remote_tail = read_cursor(cur, bounds);
+            response.remote_have = read_pull_cursor(cur, bounds, cursor_baseline);
+            response.remote_tail = read_pull_cursor(cur, bounds, cursor_baseline);
             response.remote_tail_known = read_bool(cur);
-            response.batches = read_batches(cur, bounds);
+            read_batches(cur, bounds, form, response.batches, response.encoded_batches);
             response.has_more = read_bool(cur);
             response.ok = read_bool(cur);
             response.error = read_string(cur, bounds);
             response.error_code = read_response_error_code(cur);
             response.error_retryable = read_bool(cur);
+            response.snapshot_token = read_string(cur, bounds);
+            response.cursor_baseline_stored = read_bool(cur);
             check_consumed(cur);
+            span.finish(true, data.size());
             return response;
         }
 
         /// \brief Strictly decodes a push request.
+        /// \param form As for \ref decode_pull_response().
         static PushRequest decode_push_request(
                 const std::vector<std::uint8_t>& data,
-                const CodecBounds* bounds = nullptr) {
+                const CodecBounds* bounds = nullptr,
+                PullBatchForm form = PullBatchForm::Decoded) {
             bounds = effective_bounds(bounds);
-            Cursor cur = make_cursor(data, bounds);
+            SyncSpan span(SyncSpanKind::CodecDecode);
+            std::vector<std::uint8_t> expanded;
+            Cursor cur = make_cursor(expand_message(data, bounds, expanded), bounds);
             check_header(cur, TransportMessageType::PushRequest);
             PushRequest request;
             read_node(cur, request.sender);
             read_node(cur, request.db_id);
-            request.batches = read_batches(cur, bounds);
+            read_batches(cur, bounds, form, request.batches, request.encoded_batches);
             check_consumed(cur);
+            span.finish(true, data.size());
             return request;
         }
 
@@ -202,15 +595,186 @@ namespace sync {
                 const std::vector<std::uint8_t>& data,
                 const CodecBounds* bounds = nullptr) {
             bounds = effective_bounds(bounds);
-            Cursor cur = make_cursor(data, bounds);
+            SyncSpan span(SyncSpanKind::CodecDecode);
+            std::vector<std::uint8_t> expanded;
+            Cursor cur = make_cursor(expand_message(data, bounds, expanded), bounds);
             check_header(cur, TransportMessageType::PushResponse);
             PushResponse response;
             response.receiver_have = read_cursor(cur, bounds);
+            response.accept_compressed_batches = read_bool(cur);
+            response.ok = read_bool(cur);
+            response.error = read_string(cur, bounds);
+            response.error_code = read_response_error_code(cur);
+            response.error_retryable = read_bool(cur);
+            response.accept_compressed_messages = read_bool(cur);
+            check_consumed(cur);
+            span.finish(true, data.size());
+            return response;
+        }
+
+        /// \brief Encodes a range-hash request.
+        static std::vector<std::uint8_t> encode_range_hash_request(
+                const RangeHashRequest& request,
+                const CodecBounds* bounds = nullptr) {
+            bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecEncode);
+            std::vector<std::uint8_t> out =
+                make_header(TransportMessageType::RangeHashRequest);
+            append_node(out, request.requester);
+            append_node(out, request.db_id);
+            append_dbi_name(out, request.dbi_name, bounds);
+            append_u8(out, static_cast<std::uint8_t>(request.query));
+            append_u8(out, request.depth);
+            append_u32_size(out, request.indexes.size(), "range hash indexes exceed u32");
+            for (std::size_t i = 0; i < request.indexes.size(); ++i) {
+                detail::append_u32_le(out, request.indexes[i]);
+            }
+            append_bool(out, request.from_head);
+            append_key(out, request.lo, bounds);
+            append_bool(out, request.has_hi);
+            append_key(out, request.hi, bounds);
+            detail::append_u64_le(out, request.max_records);
+            detail::append_u64_le(out, request.max_bytes);
+            validate_message_size(out, bounds);
+            span.finish(true, out.size());
+            return out;
+        }
+
+        /// \brief Encodes a range-hash response.
+        static std::vector<std::uint8_t> encode_range_hash_response(
+                const RangeHashResponse& response,
+                const CodecBounds* bounds = nullptr) {
+            bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecEncode);
+            std::vector<std::uint8_t> out =
+                make_header(TransportMessageType::RangeHashResponse);
+            append_bool(out, response.ok);
+            append_string(out, response.error, bounds);
+            append_response_error_code(out, response.error_code);
+            append_bool(out, response.error_retryable);
+            append_u8(out, response.leaf_bits);
+            detail::append_u32_le(out, response.dbi_flags);
+            append_u32_size(out, response.nodes.size(), "range hash nodes exceed u32");
+            for (std::size_t i = 0; i < response.nodes.size(); ++i) {
+                const RangeHashNode& node = response.nodes[i];
+                append_u8(out, node.depth);
+                detail::append_u32_le(out, node.index);
+                detail::append_u64_le(out, node.count);
+                detail::append_u64_le(out, node.hash);
+            }
+            append_u32_size(out, response.leaves.size(), "range hash leaves exceed u32");
+            for (std::size_t i = 0; i < response.leaves.size(); ++i) {
+                const RangeHashLeaf& leaf = response.leaves[i];
+                detail::append_u32_le(out, leaf.bucket);
+                append_bool(out, leaf.head);
+                append_key(out, leaf.start_key, bounds);
+                detail::append_u64_le(out, leaf.count);
+                detail::append_u64_le(out, leaf.hash);
+            }
+            append_u32_size(out, response.records.size(), "range hash records exceed u32");
+            for (std::size_t i = 0; i < response.records.size(); ++i) {
+                append_key(out, response.records[i].key, bounds);
+                const std::vector<std::uint8_t>& value = response.records[i].value;
+                if (value.size() > bounds->max_value_len) {
+                    throw std::length_error("range hash value exceeds max_value_len");
+                }
+                append_u32_size(out, value.size(), "range hash value exceeds u32");
+                append_bytes(out, value.empty() ? nullptr : &value[0], value.size());
+            }
+            append_bool(out, response.has_more);
+            append_key(out, response.resume_key, bounds);
+            validate_message_size(out, bounds);
+            span.finish(true, out.size());
+            return out;
+        }
+
+        /// \brief Strictly decodes a range-hash request.
+        static RangeHashRequest decode_range_hash_request(
+                const std::vector<std::uint8_t>& data,
+                const CodecBounds* bounds = nullptr) {
+            bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecDecode);
+            std::vector<std::uint8_t> expanded;
+            Cursor cur = make_cursor(expand_message(data, bounds, expanded), bounds);
+            check_header(cur, TransportMessageType::RangeHashRequest);
+            RangeHashRequest request;
+            read_node(cur, request.requester);
+            read_node(cur, request.db_id);
+            request.dbi_name = read_dbi_name(cur, bounds);
+            const std::uint8_t query = read_u8(cur);
+            if (query < static_cast<std::uint8_t>(RangeHashQuery::Nodes) ||
+                query > static_cast<std::uint8_t>(RangeHashQuery::Records)) {
+                throw std::runtime_error("Invalid RangeHashQuery");
+            }
+            request.query = static_cast<RangeHashQuery>(query);
+            request.depth = read_u8(cur);
+            // Every element has a minimum size, so a forged count underruns.
+            const std::uint32_t indexes = read_u32_le(cur);
+            for (std::uint32_t i = 0; i < indexes; ++i) {
+                request.indexes.push_back(read_u32_le(cur));
+            }
+            request.from_head = read_bool(cur);
+            request.lo = read_key(cur, bounds);
+            request.has_hi = read_bool(cur);
+            request.hi = read_key(cur, bounds);
+            request.max_records = read_u64_le(cur);
+            request.max_bytes = read_u64_le(cur);
+            check_consumed(cur);
+            span.finish(true, data.size());
+            return request;
+        }
+
+        /// \brief Strictly decodes a range-hash response.
+        static RangeHashResponse decode_range_hash_response(
+                const std::vector<std::uint8_t>& data,
+                const CodecBounds* bounds = nullptr) {
+            bounds = effective_bounds(bounds);
+            SyncSpan span(SyncSpanKind::CodecDecode);
+            std::vector<std::uint8_t> expanded;
+            Cursor cur = make_cursor(expand_message(data, bounds, expanded), bounds);
+            check_header(cur, TransportMessageType::RangeHashResponse);
+            RangeHashResponse response;
             response.ok = read_bool(cur);
             response.error = read_string(cur, bounds);
             response.error_code = read_response_error_code(cur);
             response.error_retryable = read_bool(cur);
+            response.leaf_bits = read_u8(cur);
+            response.dbi_flags = read_u32_le(cur);
+            const std::uint32_t nodes = read_u32_le(cur);
+            for (std::uint32_t i = 0; i < nodes; ++i) {
+                RangeHashNode node;
+                node.depth = read_u8(cur);
+                node.index = read_u32_le(cur);
+                node.count = read_u64_le(cur);
+                node.hash = read_u64_le(cur);
+                response.nodes.push_back(node);
+            }
+            const std::uint32_t leaves = read_u32_le(cur);
+            for (std::uint32_t i = 0; i < leaves; ++i) {
+                RangeHashLeaf leaf;
+                leaf.bucket = read_u32_le(cur);
+                leaf.head = read_bool(cur);
+                leaf.start_key = read_key(cur, bounds);
+                leaf.count = read_u64_le(cur);
+                leaf.hash = read_u64_le(cur);
+                response.leaves.push_back(std::move(leaf));
+            }
+            const std::uint32_t records = read_u32_le(cur);
+            for (std::uint32_t i = 0; i < records; ++i) {
+                RangeHashRecord record;
+                record.key = read_key(cur, bounds);
+                const std::uint32_t len = read_u32_le(cur);
+                if (len > bounds->max_value_len) {
+                    throw std::length_error("range hash value exceeds max_value_len");
+                }
+                const std::uint8_t* bytes = read_bytes(cur, len);
+                record.value.assign(bytes, bytes + len);
+                response.records.push_back(std::move(record));
+            }
+            response.has_more = read_bool(cur);
+            response.resume_key = read_key(cur, bounds);
             check_consumed(cur);
+            span.finish(true, data.size());
             return response;
         }
 
@@ -227,6 +791,62 @@ namespace sync {
             return bounds != nullptr ? bounds : &defaults;
         }
 
+        /// \brief Bytes of magic, version, type and flags.
+        static std::size_t envelope_size() { return 15; }
+
+        /// \brief Returns \p data, or its plain form in \p storage when it
+        /// is compressed.
+        /// \details Leaves messages with a bad envelope or unknown flags to
+        /// the header check.
+        static const std::vector<std::uint8_t>& expand_message(
+                const std::vector<std::uint8_t>& data,
+                const CodecBounds* bounds,
+                std::vector<std::uint8_t>& storage) {
+            if (data.size() < envelope_size() ||
+                std::memcmp(&data[0], magic(), magic_size()) != 0 ||
+                detail::read_u16_le(&data[magic_size()]) != codec_version() ||
+                detail::read_u32_le(&data[envelope_size() - 4]) != TRANSPORT_MESSAGE_ZSTD) {
+                return data;
+            }
+            if (data.size() > bounds->max_transport_message_bytes) {
+                throw std::length_error(
+                    "transport message exceeds max_transport_message_bytes");
+            }
+            if (data.size() < envelope_size() + 4) {
+                throw std::runtime_error("Compressed transport message truncated");
+            }
+            const std::size_t raw_len = detail::read_u32_le(&data[envelope_size()]);
+            if (raw_len > bounds->max_transport_message_bytes - envelope_size()) {
+                throw std::length_error(
+                    "transport message exceeds max_transport_message_bytes");
+            }
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+            const void* src = &data[envelope_size() + 4];
+            const std::size_t size = data.size() - envelope_size() - 4;
+            // Checked before allocating, so a forged size cannot inflate memory.
+            if (ZSTD_getFrameContentSize(src, size) != raw_len) {
+                throw std::runtime_error("Compressed transport message size mismatch");
+            }
+            storage.resize(envelope_size() + raw_len);
+            std::memcpy(&storage[0], &data[0], envelope_size());
+            detail::write_u32_le(TRANSPORT_MESSAGE_NONE, &storage[envelope_size() - 4]);
+            const std::size_t written =
+                ZSTD_decompress(raw_len == 0 ? nullptr : &storage[envelope_size()],
+                                raw_len, src, size);
+            if (ZSTD_isError(written)) {
+                throw std::runtime_error(std::string("Compressed transport message: ") +
+                                         ZSTD_getErrorName(written));
+            }
+            if (written != raw_len) {
+                throw std::runtime_error("Compressed transport message size mismatch");
+            }
+            return storage;
+#else
+            (void)storage;
+            throw std::runtime_error("TRANSPORT_MESSAGE_ZSTD requires MDBXC_HAS_ZSTD");
+#endif
+        }
+
         static std::vector<std::uint8_t> make_header(
                 TransportMessageType type) {
             std::vector<std::uint8_t> out;
@@ -252,7 +872,8 @@ namespace sync {
             return cur;
         }
 
-        static TransportMessageType read_header_type(Cursor& cur) {
+        static TransportMessageType read_header_type(Cursor& cur,
+                                                     std::uint32_t allowed_flags = 0) {
             check_bounds(cur, magic_size());
             if (std::memcmp(cur.data + cur.pos, magic(), magic_size()) != 0) {
                 throw std::runtime_error("Transport codec magic mismatch");
@@ -265,7 +886,7 @@ namespace sync {
             }
             const std::uint8_t type = read_u8(cur);
             const std::uint32_t flags = read_u32_le(cur);
-            if (flags != 0) {
+            if ((flags & ~allowed_flags) != 0) {
                 throw std::runtime_error(
                     "Unknown mandatory transport message flags");
             }
@@ -282,6 +903,12 @@ namespace sync {
                 case static_cast<std::uint8_t>(
                         TransportMessageType::PushResponse):
                     return TransportMessageType::PushResponse;
+                case static_cast<std::uint8_t>(
+                        TransportMessageType::RangeHashRequest):
+                    return TransportMessageType::RangeHashRequest;
+                case static_cast<std::uint8_t>(
+                        TransportMessageType::RangeHashResponse):
+                    return TransportMessageType::RangeHashResponse;
                 default:
                     throw std::runtime_error(
                         "Unexpected transport message type");
@@ -326,6 +953,10 @@ namespace sync {
                 case SyncResponseErrorCode::ApplyConflict:
                 case SyncResponseErrorCode::SnapshotRequired:
                 case SyncResponseErrorCode::BatchTooLarge:
+                case SyncResponseErrorCode::SnapshotExpired:
+                case SyncResponseErrorCode::CursorBaselineMismatch:
+                case SyncResponseErrorCode::RangeHashUnavailable:
+                case SyncResponseErrorCode::Busy:
                     detail::append_u16_le(out,
                         static_cast<std::uint16_t>(code));
                     return;
@@ -372,7 +1003,7 @@ namespace sync {
             }
             append_u32_size(out, cursor.last_seq_by_origin.size(),
                             "cursor origins exceed u32");
-            std::map<NodeId, std::uint64_t>::const_iterator it =
+            OriginSeqMap::const_iterator it =
                 cursor.last_seq_by_origin.begin();
             for (; it != cursor.last_seq_by_origin.end(); ++it) {
                 append_node(out, it->first);
@@ -380,6 +1011,77 @@ namespace sync {
             }
         }
 
+        static const std::uint8_t cursor_form_full = 0;
+        static const std::uint8_t cursor_form_delta = 1;
+
+        static std::uint64_t digest_of(const SyncCursor* cursor) {
+            return cursor != nullptr ? sync_cursor_digest(*cursor) : 0;
+        }
+
+        /// \brief Writes a pull cursor, as a delta against \p baseline when
+        /// that is smaller.
+        static void append_pull_cursor(std::vector<std::uint8_t>& out,
+                                       const SyncCursor& cursor,
+                                       const SyncCursor* baseline,
+                                       std::uint64_t baseline_digest,
+                                       const CodecBounds* bounds) {
+            if (baseline != nullptr &&
+                cursor.last_seq_by_origin.size() <= bounds->max_cursor_origins) {
+                std::vector<OriginSeqMap::value_type> changed;
+                std::vector<NodeId> removed;
+                diff_cursor(*baseline, cursor, changed, removed);
+                const std::size_t entry_bytes = sizeof(NodeId) + 8;
+                const std::size_t delta_bytes = 16 + changed.size() * entry_bytes +
+                                                removed.size() * sizeof(NodeId);
+                const std::size_t full_bytes =
+                    4 + cursor.last_seq_by_origin.size() * entry_bytes;
+                if (delta_bytes < full_bytes &&
+                    removed.size() <= bounds->max_cursor_origins) {
+                    append_u8(out, cursor_form_delta);
+                    detail::append_u64_le(out, baseline_digest);
+                    append_u32_size(out, changed.size(), "cursor origins exceed u32");
+                    for (std::size_t i = 0; i < changed.size(); ++i) {
+                        append_node(out, changed[i].first);
+                        detail::append_u64_le(out, changed[i].second);
+                    }
+                    append_u32_size(out, removed.size(), "cursor origins exceed u32");
+                    for (std::size_t i = 0; i < removed.size(); ++i) {
+                        append_node(out, removed[i]);
+                    }
+                    return;
+                }
+            }
+            append_u8(out, cursor_form_full);
+            append_cursor(out, cursor, bounds);
+        }
+
+        /// \brief Entries of \p target that differ from \p baseline, and
+        /// origins of \p baseline missing from \p target.
+        static void diff_cursor(const SyncCursor& baseline,
+                                const SyncCursor& target,
+                                std::vector<OriginSeqMap::value_type>& changed,
+                                std::vector<NodeId>& removed) {
+            OriginSeqMap::const_iterator b = baseline.last_seq_by_origin.begin();
+            const OriginSeqMap::const_iterator b_end = baseline.last_seq_by_origin.end();
+            OriginSeqMap::const_iterator t = target.last_seq_by_origin.begin();
+            const OriginSeqMap::const_iterator t_end = target.last_seq_by_origin.end();
+            while (b != b_end || t != t_end) {
+                if (t == t_end || (b != b_end && b->first < t->first)) {
+                    removed.push_back(b->first);
+                    ++b;
+                } else if (b == b_end || t->first < b->first) {
+                    changed.push_back(*t);
+                    ++t;
+                } else {
+                    if (t->second != b->second) {
+                        changed.push_back(*t);
+                    }
+                    ++b;
+                    ++t;
+                }
+            }
+        }
+
         static void append_string(std::vector<std::uint8_t>& out,
                                   const std::string& value,
                                   const CodecBounds* bounds) {
@@ -394,28 +1096,140 @@ namespace sync {
             }
         }
 
+        static void append_dbi_name(std::vector<std::uint8_t>& out,
+                                    const std::string& name,
+                                    const CodecBounds* bounds) {
+            if (name.size() > bounds->max_dbi_name_len) {
+                throw std::length_error("dbi_name exceeds max_dbi_name_len");
+            }
+            append_u32_size(out, name.size(), "dbi_name exceeds u32");
+            append_bytes(out, reinterpret_cast<const std::uint8_t*>(name.data()), name.size());
+        }
+
+        static void append_key(std::vector<std::uint8_t>& out,
+                               const std::vector<std::uint8_t>& key,
+                               const CodecBounds* bounds) {
+            if (key.size() > bounds->max_storage_key_len) {
+                throw std::length_error("key exceeds max_storage_key_len");
+            }
+            append_u32_size(out, key.size(), "key exceeds u32");
+            append_bytes(out, key.empty() ? nullptr : &key[0], key.size());
+        }
+
+        static std::string read_dbi_name(Cursor& cur, const CodecBounds* bounds) {
+            const std::uint32_t len = read_u32_le(cur);
+            if (len > bounds->max_dbi_name_len) {
+                throw std::length_error("dbi_name exceeds max_dbi_name_len");
+            }
+            const std::uint8_t* bytes = read_bytes(cur, len);
+            return len == 0 ? std::string()
+                            : std::string(reinterpret_cast<const char*>(bytes), len);
+        }
+
+        static std::vector<std::uint8_t> read_key(Cursor& cur, const CodecBounds* bounds) {
+            const std::uint32_t len = read_u32_le(cur);
+            if (len > bounds->max_storage_key_len) {
+                throw std::length_error("key exceeds max_storage_key_len");
+            }
+            const std::uint8_t* bytes = read_bytes(cur, len);
+            return len == 0 ? std::vector<std::uint8_t>()
+                            : std::vector<std::uint8_t>(bytes, bytes + len);
+        }
+
+        static void check_subscription_entries(std::size_t entries,
+                                               const CodecBounds* bounds) {
+            if (bounds != nullptr && entries > bounds->max_subscription_entries) {
+                throw std::length_error(
+                    "subscription exceeds max_subscription_entries");
+            }
+        }
+
+        static void append_subscription(std::vector<std::uint8_t>& out,
+                                        const std::vector<SyncTableSubscription>& tables,
+                                        const CodecBounds* bounds) {
+            std::size_t entries = tables.size();
+            for (std::size_t i = 0; i < tables.size(); ++i) {
+                entries += tables[i].key_prefixes.size();
+            }
+            check_subscription_entries(entries, bounds);
+            append_u32_size(out, tables.size(), "subscription tables exceed u32");
+            for (std::size_t i = 0; i < tables.size(); ++i) {
+                const SyncTableSubscription& table = tables[i];
+                if (bounds != nullptr && table.dbi_name.size() > bounds->max_dbi_name_len) {
+                    throw std::length_error("subscription dbi_name exceeds max_dbi_name_len");
+                }
+                append_u32_size(out, table.dbi_name.size(), "dbi_name length exceeds u32");
+                append_bytes(out,
+                             reinterpret_cast<const std::uint8_t*>(table.dbi_name.data()),
+                             table.dbi_name.size());
+                append_u32_size(out, table.key_prefixes.size(),
+                                "subscription key prefixes exceed u32");
+                for (std::size_t j = 0; j < table.key_prefixes.size(); ++j) {
+                    const std::vector<std::uint8_t>& prefix = table.key_prefixes[j];
+                    if (bounds != nullptr && prefix.size() > bounds->max_storage_key_len) {
+                        throw std::length_error(
+                            "subscription key prefix exceeds max_storage_key_len");
+                    }
+                    append_u32_size(out, prefix.size(), "key prefix length exceeds u32");
+                    append_bytes(out, prefix.empty() ? nullptr : &prefix[0], prefix.size());
+                }
+            }
+        }
+
+        /// \brief Writes \p batches, then \p encoded batches as they are.
         static void append_batches(std::vector<std::uint8_t>& out,
                                    const std::vector<ChangeBatch>& batches,
-                                   const CodecBounds* bounds) {
-            if (bounds != nullptr &&
-                batches.size() > bounds->max_batches_per_message) {
+                                   const CodecBounds* bounds,
+                                   const std::vector<std::vector<std::uint8_t>>* encoded) {
+            append_batches_count(
+                out,
+                batches.size() + (encoded != nullptr ? encoded->size() : 0),
+                bounds);
+            for (std::size_t i = 0; i < batches.size(); ++i) {
+                append_batch_bytes(out, ChangeBatchCodec::encode(batches[i], bounds), bounds);
+            }
+            for (std::size_t i = 0; encoded != nullptr && i < encoded->size(); ++i) {
+                append_batch_bytes(out, (*encoded)[i], bounds);
+            }
+        }
+
+        static void append_batches_count(std::vector<std::uint8_t>& out,
+                                         std::size_t count,
+                                         const CodecBounds* bounds) {
+            if (bounds != nullptr && count > bounds->max_batches_per_message) {
                 throw std::length_error(
                     "batches exceed max_batches_per_message");
             }
-            append_u32_size(out, batches.size(), "batches count exceeds u32");
-            for (std::size_t i = 0; i < batches.size(); ++i) {
-                const std::vector<std::uint8_t> encoded =
-                    ChangeBatchCodec::encode(batches[i], bounds);
-                if (bounds != nullptr &&
-                    encoded.size() > bounds->max_batch_total_bytes) {
-                    throw std::length_error(
-                        "batch bytes exceed max_batch_total_bytes");
-                }
-                append_u32_size(out, encoded.size(),
-                                "batch bytes length exceeds u32");
-                append_bytes(out, encoded.empty() ? nullptr : &encoded[0],
-                             encoded.size());
+            append_u32_size(out, count, "batches count exceeds u32");
+        }
+
+        static void append_batch_chunk(ChunkedTransportMessage& message,
+                                       std::vector<std::uint8_t>&& encoded,
+                                       const CodecBounds* bounds) {
+            if (encoded.size() < chunked_batch_min_bytes()) {
+                append_batch_bytes(message.tail(), encoded, bounds);
+                return;
             }
+            append_batch_length(message.tail(), encoded.size(), bounds);
+            message.append_chunk(std::move(encoded));
+        }
+
+        static void append_batch_length(std::vector<std::uint8_t>& out,
+                                        std::size_t size,
+                                        const CodecBounds* bounds) {
+            if (bounds != nullptr && size > bounds->max_batch_total_bytes) {
+                throw std::length_error(
+                    "batch bytes exceed max_batch_total_bytes");
+            }
+            append_u32_size(out, size, "batch bytes length exceeds u32");
+        }
+
+        static void append_batch_bytes(std::vector<std::uint8_t>& out,
+                                       const std::vector<std::uint8_t>& encoded,
+                                       const CodecBounds* bounds) {
+            append_batch_length(out, encoded.size(), bounds);
+            append_bytes(out, encoded.empty() ? nullptr : &encoded[0],
+                         encoded.size());
         }
 
         static void validate_message_size(
@@ -470,6 +1284,17 @@ namespace sync {
                 case static_cast<std::uint16_t>(
                         SyncResponseErrorCode::BatchTooLarge):
                     return SyncResponseErrorCode::BatchTooLarge;
+                case static_cast<std::uint16_t>(
+                        SyncResponseErrorCode::SnapshotExpired):
+                    return SyncResponseErrorCode::SnapshotExpired;
+                case static_cast<std::uint16_t>(
+                        SyncResponseErrorCode::CursorBaselineMismatch):
+                    return SyncResponseErrorCode::CursorBaselineMismatch;
+                case static_cast<std::uint16_t>(
+                        SyncResponseErrorCode::RangeHashUnavailable):
+                    return SyncResponseErrorCode::RangeHashUnavailable;
+                case static_cast<std::uint16_t>(SyncResponseErrorCode::Busy):
+                    return SyncResponseErrorCode::Busy;
             }
             throw std::runtime_error("Invalid SyncResponseErrorCode");
         }
@@ -511,6 +1336,9 @@ namespace sync {
                     "cursor origins exceed max_cursor_origins");
             }
             SyncCursor cursor;
+            cursor.last_seq_by_origin.reserve(
+                (std::min)(static_cast<std::size_t>(count),
+                           (cur.size - cur.pos) / (sizeof(NodeId) + 8)));
             for (std::uint32_t i = 0; i < count; ++i) {
                 NodeId origin{};
                 read_node(cur, origin);
@@ -525,6 +1353,146 @@ namespace sync {
             return cursor;
         }
 
+        static std::uint8_t read_cursor_form(Cursor& cur) {
+            const std::uint8_t form = read_u8(cur);
+            if (form != cursor_form_full && form != cursor_form_delta) {
+                throw std::runtime_error("Invalid transport cursor form");
+            }
+            return form;
+        }
+
+        /// \brief Reads a pull cursor sent in either form.
+        /// \throws std::runtime_error for a delta without a matching
+        /// \p baseline.
+        static SyncCursor read_pull_cursor(Cursor& cur,
+                                           const CodecBounds* bounds,
+                                           const SyncCursor* baseline) {
+            if (read_cursor_form(cur) == cursor_form_full) {
+                return read_cursor(cur, bounds);
+            }
+            const std::uint64_t digest = read_u64_le(cur);
+            if (baseline == nullptr || sync_cursor_digest(*baseline) != digest) {
+                throw std::runtime_error(
+                    "Transport cursor delta does not match its baseline");
+            }
+            return read_cursor_delta(cur, bounds, baseline);
+        }
+
+        /// \brief Reads a cursor delta and applies it to \p baseline.
+        /// \details With a null \p baseline the delta is only validated and
+        /// an empty cursor is returned.
+        static SyncCursor read_cursor_delta(Cursor& cur,
+                                            const CodecBounds* bounds,
+                                            const SyncCursor* baseline) {
+            const std::size_t entry_bytes = sizeof(NodeId) + 8;
+            const std::uint32_t changed_count = read_u32_le(cur);
+            if (changed_count > bounds->max_cursor_origins) {
+                throw std::length_error(
+                    "cursor origins exceed max_cursor_origins");
+            }
+            std::vector<OriginSeqMap::value_type> changed;
+            changed.reserve((std::min)(static_cast<std::size_t>(changed_count),
+                                       (cur.size - cur.pos) / entry_bytes));
+            for (std::uint32_t i = 0; i < changed_count; ++i) {
+                OriginSeqMap::value_type entry;
+                read_node(cur, entry.first);
+                entry.second = read_u64_le(cur);
+                if (!changed.empty() && !(changed.back().first < entry.first)) {
+                    throw std::runtime_error(
+                        "Unsorted origins in transport cursor delta");
+                }
+                changed.push_back(entry);
+            }
+            const std::uint32_t removed_count = read_u32_le(cur);
+            if (removed_count > bounds->max_cursor_origins) {
+                throw std::length_error(
+                    "cursor origins exceed max_cursor_origins");
+            }
+            std::vector<NodeId> removed;
+            removed.reserve((std::min)(static_cast<std::size_t>(removed_count),
+                                       (cur.size - cur.pos) / sizeof(NodeId)));
+            for (std::uint32_t i = 0; i < removed_count; ++i) {
+                NodeId origin{};
+                read_node(cur, origin);
+                if (!removed.empty() && !(removed.back() < origin)) {
+                    throw std::runtime_error(
+                        "Unsorted origins in transport cursor delta");
+                }
+                removed.push_back(origin);
+            }
+            SyncCursor out;
+            if (baseline == nullptr) {
+                return out;
+            }
+
+            // Merge in origin order; a removal must name a baseline origin
+            // the delta does not also change.
+            out.last_seq_by_origin.reserve(
+                baseline->last_seq_by_origin.size() + changed.size());
+            OriginSeqMap::const_iterator b = baseline->last_seq_by_origin.begin();
+            const OriginSeqMap::const_iterator b_end = baseline->last_seq_by_origin.end();
+            std::size_t c = 0;
+            std::size_t r = 0;
+            while (b != b_end || c < changed.size()) {
+                if (c < changed.size() &&
+                    (b == b_end || !(b->first < changed[c].first))) {
+                    if (b != b_end && b->first == changed[c].first) {
+                        ++b;
+                    }
+                    out.last_seq_by_origin[changed[c].first] = changed[c].second;
+                    ++c;
+                } else if (r < removed.size() && removed[r] == b->first) {
+                    ++r;
+                    ++b;
+                } else {
+                    out.last_seq_by_origin[b->first] = b->second;
+                    ++b;
+                }
+            }
+            if (r != removed.size()) {
+                throw std::runtime_error(
+                    "Transport cursor delta removes an unknown origin");
+            }
+            if (out.last_seq_by_origin.size() > bounds->max_cursor_origins) {
+                throw std::length_error(
+                    "cursor origins exceed max_cursor_origins");
+            }
+            return out;
+        }
+
+        static std::vector<SyncTableSubscription> read_subscription(
+                Cursor& cur,
+                const CodecBounds* bounds) {
+            const std::uint32_t tables = read_u32_le(cur);
+            std::size_t entries = tables;
+            check_subscription_entries(entries, bounds);
+            std::vector<SyncTableSubscription> out(tables);
+            for (std::uint32_t i = 0; i < tables; ++i) {
+                const std::uint32_t name_len = read_u32_le(cur);
+                if (bounds != nullptr && name_len > bounds->max_dbi_name_len) {
+                    throw std::length_error("subscription dbi_name exceeds max_dbi_name_len");
+                }
+                const std::uint8_t* name = read_bytes(cur, name_len);
+                if (name_len != 0) {
+                    out[i].dbi_name.assign(reinterpret_cast<const char*>(name), name_len);
+                }
+                const std::uint32_t prefixes = read_u32_le(cur);
+                entries += prefixes;
+                check_subscription_entries(entries, bounds);
+                out[i].key_prefixes.resize(prefixes);
+                for (std::uint32_t j = 0; j < prefixes; ++j) {
+                    const std::uint32_t len = read_u32_le(cur);
+                    if (bounds != nullptr && len > bounds->max_storage_key_len) {
+                        throw std::length_error(
+                            "subscription key prefix exceeds max_storage_key_len");
+                    }
+                    const std::uint8_t* bytes = read_bytes(cur, len);
+                    out[i].key_prefixes[j].assign(bytes, bytes + len);
+                }
+            }
+            return out;
+        }
+
         static std::string read_string(Cursor& cur,
                                        const CodecBounds* bounds) {
             const std::uint32_t len = read_u32_le(cur);
@@ -538,16 +1506,21 @@ namespace sync {
             return std::string(reinterpret_cast<const char*>(bytes), len);
         }
 
-        static std::vector<ChangeBatch> read_batches(
-                Cursor& cur,
-                const CodecBounds* bounds) {
+        static void read_batches(Cursor& cur,
+                                 const CodecBounds* bounds,
+                                 PullBatchForm form,
+                                 std::vector<ChangeBatch>& batches,
+                                 std::vector<std::vector<std::uint8_t>>& encoded) {
             const std::uint32_t count = read_u32_le(cur);
             if (bounds != nullptr && count > bounds->max_batches_per_message) {
                 throw std::length_error(
                     "batches exceed max_batches_per_message");
             }
-            std::vector<ChangeBatch> batches;
-            batches.reserve(count);
+            if (form == PullBatchForm::Encoded) {
+                encoded.reserve(count);
+            } else {
+                batches.reserve(count);
+            }
             for (std::uint32_t i = 0; i < count; ++i) {
                 const std::uint32_t len = read_u32_le(cur);
                 if (bounds != nullptr && len > bounds->max_batch_total_bytes) {
@@ -555,16 +1528,78 @@ namespace sync {
                         "batch bytes exceed max_batch_total_bytes");
                 }
                 const std::uint8_t* bytes = read_bytes(cur, len);
-                std::vector<std::uint8_t> encoded(len);
-                if (len > 0) {
-                    std::memcpy(&encoded[0], bytes, len);
+                if (form == PullBatchForm::Decoded) {
+                    batches.push_back(ChangeBatchCodec::decode_exact(bytes, len, bounds));
+                    continue;
+                }
+                // Walk the ops so malformed batches fail here, not at apply.
+                ChangeBatchCodec::Reader reader(bytes, len, bounds);
+                ChangeOpView op;
+                while (reader.next(op)) {
+                }
+                if (reader.bytes_read() != len) {
+                    throw std::runtime_error("Trailing bytes after ChangeBatch");
                 }
-                batches.push_back(ChangeBatchCodec::decode_exact(encoded, bounds));
+                encoded.push_back(std::vector<std::uint8_t>(bytes, bytes + len));
             }
-            return batches;
         }
     };
 
+    /// \brief Requester side of transport cursor deltas.
+    /// \details One per peer connection: holds the \c have the responder
+    /// last stored in its \c CursorBaselineCache and sends later cursors as
+    /// deltas against it. Thread-safe.
+    class PullCursorBaseline {
+    public:
+        PullCursorBaseline() : m_valid(false) {}
+
+        PullCursorBaseline(const PullCursorBaseline&) = delete;
+        PullCursorBaseline& operator=(const PullCursorBaseline&) = delete;
+
+        /// \brief Encodes \p request with \c accept_cursor_deltas set and
+        /// \c have as a delta when a baseline is held.
+        std::vector<std::uint8_t> encode_request(
+                const PullRequest& request,
+                const CodecBounds* bounds) const {
+            PullRequest wire(request);
+            wire.accept_cursor_deltas = true;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return TransportMessageCodec::encode_pull_request(
+                wire, bounds, m_valid ? &m_baseline : nullptr);
+        }
+
+        /// \brief Decodes the response to \p request and keeps, replaces,
+        /// or drops the baseline accordingly.
+        PullResponse decode_response(
+                const PullRequest& request,
+                const std::vector<std::uint8_t>& data,
+                const CodecBounds* bounds) {
+            PullResponse response = TransportMessageCodec::decode_pull_response(
+                data, bounds, request.batch_form, &request.have);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (response.cursor_baseline_stored) {
+                m_baseline = request.have;
+                m_valid = true;
+            } else if (response.ok || baseline_mismatch(response)) {
+                // The responder keeps no baseline for us.
+                m_valid = false;
+            }
+            return response;
+        }
+
+        /// \brief Whether \p response asks for the request to be resent
+        /// with a full cursor.
+        static bool baseline_mismatch(const PullResponse& response) {
+            return !response.ok &&
+                   response.error_code == SyncResponseErrorCode::CursorBaselineMismatch;
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        SyncCursor m_baseline;
+        bool m_valid;
+    };
+
 } // namespace sync
 } // namespace mdbxc
 
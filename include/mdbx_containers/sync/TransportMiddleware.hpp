@@ -9,18 +9,24 @@
 /// add credentials to sync DTOs and do not own sockets; concrete transports can
 /// use them to enforce allow lists, fixed request budgets, and metrics hooks.
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <functional>
 #include <limits>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "../common/TableMetrics.hpp"
 #include "HttpTransport.hpp"
 #include "ISyncPeer.hpp"
 #include "WebSocketTransport.hpp"
@@ -461,6 +467,9 @@ namespace sync {
             if (request.target == HttpSyncRoutes::push_target()) {
                 return check_push_identity(request.body, binding);
             }
+            if (request.target == HttpSyncRoutes::range_hash_target()) {
+                return check_range_hash_identity(request.body, binding);
+            }
             return SyncTransportDecision::allow();
         }
 
@@ -509,7 +518,7 @@ namespace sync {
             try {
                 const PushRequest request =
                     TransportMessageCodec::decode_push_request(
-                        body, &m_bounds);
+                        body, &m_bounds, PullBatchForm::Encoded);
                 if (request.sender != binding.node_id) {
                     return SyncTransportDecision::reject(
                         "sync sender does not match authenticated node",
@@ -523,6 +532,26 @@ namespace sync {
             }
         }
 
+        SyncTransportDecision check_range_hash_identity(
+                const std::vector<std::uint8_t>& body,
+                const Binding& binding) const {
+            try {
+                const RangeHashRequest request =
+                    TransportMessageCodec::decode_range_hash_request(
+                        body, &m_bounds);
+                if (request.requester != binding.node_id) {
+                    return SyncTransportDecision::reject(
+                        "sync requester does not match authenticated node",
+                        403);
+                }
+                return check_db(binding, request.db_id);
+            } catch (const std::length_error& e) {
+                return SyncTransportDecision::reject(e.what(), 413);
+            } catch (const std::exception& e) {
+                return SyncTransportDecision::reject(e.what(), 400);
+            }
+        }
+
         static SyncTransportDecision check_db(const Binding& binding,
                                               const DbId& db_id) {
             if (!binding.db_access.allows_db_id(db_id)) {
@@ -570,8 +599,11 @@ namespace sync {
                         return check_pull_identity(request);
                     case TransportMessageType::PushRequest:
                         return check_push_identity(request);
+                    case TransportMessageType::RangeHashRequest:
+                        return check_range_hash_identity(request);
                     case TransportMessageType::PullResponse:
                     case TransportMessageType::PushResponse:
+                    case TransportMessageType::RangeHashResponse:
                         return SyncTransportDecision::reject(
                             "sync WebSocket server received response message",
                             1008);
@@ -603,7 +635,7 @@ namespace sync {
                 const WebSocketSyncRequestContext& context) const {
             const PushRequest request =
                 TransportMessageCodec::decode_push_request(
-                    context.binary_message, &m_bounds);
+                    context.binary_message, &m_bounds, PullBatchForm::Encoded);
             if (request.sender != context.authenticated_node) {
                 return SyncTransportDecision::reject(
                     "sync sender does not match authenticated WebSocket node",
@@ -612,6 +644,19 @@ namespace sync {
             return check_db(context.db_access, request.db_id);
         }
 
+        SyncTransportDecision check_range_hash_identity(
+                const WebSocketSyncRequestContext& context) const {
+            const RangeHashRequest request =
+                TransportMessageCodec::decode_range_hash_request(
+                    context.binary_message, &m_bounds);
+            if (request.requester != context.authenticated_node) {
+                return SyncTransportDecision::reject(
+                    "sync requester does not match authenticated WebSocket node",
+                    1008);
+            }
+            return check_db(context.db_access, request.db_id);
+        }
+
         static SyncTransportDecision check_db(
                 const SyncDbAccess& db_access,
                 const DbId& db_id) {
@@ -683,28 +728,45 @@ namespace sync {
     /// header with the remaining window time in seconds. \p max_buckets caps
     /// tracked client identities when non-zero; expired buckets are evicted
     /// before a new identity is rejected.
+    ///
+    /// Buckets are hash-partitioned into \p shard_count shards with their own
+    /// mutex, so concurrent requests from different identities rarely contend.
+    /// Expired buckets are also swept once per window, which keeps an
+    /// uncapped limiter from growing with every identity it has ever seen.
     class FixedWindowHttpRateLimitPolicy : public ISyncTransportPolicy {
     public:
         FixedWindowHttpRateLimitPolicy(std::uint64_t max_requests,
                                        std::chrono::seconds window,
-                                       std::size_t max_buckets = 0)
+                                       std::size_t max_buckets = 0,
+                                       std::size_t shard_count = 16)
             : m_max_requests(max_requests),
               m_window(window),
-              m_max_buckets(max_buckets) {
+              m_max_buckets(max_buckets),
+              m_shard_count(shard_count),
+              m_bucket_count(0),
+              m_next_sweep(0) {
             if (window.count() <= 0) {
                 throw std::invalid_argument(
                     "HTTP rate-limit window must be positive");
             }
+            if (shard_count == 0) {
+                throw std::invalid_argument(
+                    "HTTP rate-limit shard count must be positive");
+            }
+            m_shards.reset(new Shard[shard_count]);
         }
 
         void clear() {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_buckets.clear();
+            for (std::size_t i = 0; i < m_shard_count; ++i) {
+                std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+                m_bucket_count.fetch_sub(m_shards[i].buckets.size(),
+                                         std::memory_order_acq_rel);
+                m_shards[i].buckets.clear();
+            }
         }
 
         std::size_t bucket_count() const {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            return m_buckets.size();
+            return m_bucket_count.load(std::memory_order_acquire);
         }
 
         SyncTransportDecision check_http_request(
@@ -712,24 +774,35 @@ namespace sync {
             const std::chrono::steady_clock::time_point now =
                 std::chrono::steady_clock::now();
             const std::string identity = client_identity(request);
-
-            std::lock_guard<std::mutex> lock(m_mutex);
-            std::map<std::string, Bucket>::iterator it =
-                m_buckets.find(identity);
-            if (it == m_buckets.end()) {
-                evict_expired_buckets(now);
-                if (m_max_buckets != 0 &&
-                    m_buckets.size() >= m_max_buckets) {
-                    SyncTransportDecision decision =
-                        SyncTransportDecision::reject(
-                            "sync HTTP rate-limit bucket cap exceeded", 429);
-                    decision.add_response_header(
-                        "Retry-After",
-                        retry_after_seconds(now, earliest_reset_at()));
-                    return decision;
+            sweep_if_due(now);
+
+            Shard& shard = shard_for(identity);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            BucketMap::iterator it = shard.buckets.find(identity);
+            if (it == shard.buckets.end()) {
+                if (!reserve_bucket()) {
+                    // Other shards are swept without holding this one so
+                    // that shard locks are never nested.
+                    lock.unlock();
+                    evict_expired_buckets(now);
+                    lock.lock();
+                    it = shard.buckets.find(identity);
+                    if (it == shard.buckets.end() && !reserve_bucket()) {
+                        lock.unlock();
+                        SyncTransportDecision decision =
+                            SyncTransportDecision::reject(
+                                "sync HTTP rate-limit bucket cap exceeded",
+                                429);
+                        decision.add_response_header(
+                            "Retry-After",
+                            retry_after_seconds(now, earliest_reset_at()));
+                        return decision;
+                    }
+                }
+                if (it == shard.buckets.end()) {
+                    it = shard.buckets.insert(
+                        std::make_pair(identity, Bucket())).first;
                 }
-                it = m_buckets.insert(
-                    std::make_pair(identity, Bucket())).first;
             }
 
             Bucket& bucket = it->second;
@@ -760,6 +833,13 @@ namespace sync {
             std::chrono::steady_clock::time_point reset_at;
         };
 
+        typedef std::unordered_map<std::string, Bucket> BucketMap;
+
+        struct Shard {
+            std::mutex mutex;
+            BucketMap buckets;
+        };
+
         static std::string client_identity(const HttpSyncRequest& request) {
             const std::string token = http_bearer_token(request);
             if (!token.empty()) {
@@ -787,39 +867,87 @@ namespace sync {
             return std::to_string(count);
         }
 
+        Shard& shard_for(const std::string& identity) const {
+            return m_shards[std::hash<std::string>()(identity) %
+                            m_shard_count];
+        }
+
+        /// \brief Claims room for one new bucket under \c m_max_buckets.
+        bool reserve_bucket() {
+            if (m_max_buckets == 0) {
+                m_bucket_count.fetch_add(1, std::memory_order_acq_rel);
+                return true;
+            }
+            std::size_t count = m_bucket_count.load(std::memory_order_acquire);
+            while (count < m_max_buckets) {
+                if (m_bucket_count.compare_exchange_weak(
+                        count, count + 1, std::memory_order_acq_rel)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// \brief Sweeps expired buckets at most once per window.
+        /// \details Only the caller that advances \c m_next_sweep sweeps.
+        void sweep_if_due(std::chrono::steady_clock::time_point now) {
+            const std::chrono::steady_clock::rep ticks =
+                now.time_since_epoch().count();
+            std::chrono::steady_clock::rep due =
+                m_next_sweep.load(std::memory_order_acquire);
+            if (ticks < due) {
+                return;
+            }
+            const std::chrono::steady_clock::rep next =
+                (now + m_window).time_since_epoch().count();
+            if (m_next_sweep.compare_exchange_strong(
+                    due, next, std::memory_order_acq_rel)) {
+                evict_expired_buckets(now);
+            }
+        }
+
         void evict_expired_buckets(
                 std::chrono::steady_clock::time_point now) {
-            for (std::map<std::string, Bucket>::iterator it =
-                     m_buckets.begin();
-                 it != m_buckets.end();) {
-                if (it->second.reset_at !=
-                        std::chrono::steady_clock::time_point() &&
-                    now >= it->second.reset_at) {
-                    m_buckets.erase(it++);
-                } else {
-                    ++it;
+            for (std::size_t i = 0; i < m_shard_count; ++i) {
+                std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+                BucketMap& buckets = m_shards[i].buckets;
+                for (BucketMap::iterator it = buckets.begin();
+                     it != buckets.end();) {
+                    if (it->second.reset_at !=
+                            std::chrono::steady_clock::time_point() &&
+                        now >= it->second.reset_at) {
+                        it = buckets.erase(it);
+                        m_bucket_count.fetch_sub(1, std::memory_order_acq_rel);
+                    } else {
+                        ++it;
+                    }
                 }
             }
         }
 
         std::chrono::steady_clock::time_point earliest_reset_at() const {
             std::chrono::steady_clock::time_point earliest;
-            for (std::map<std::string, Bucket>::const_iterator it =
-                     m_buckets.begin();
-                 it != m_buckets.end(); ++it) {
-                if (earliest == std::chrono::steady_clock::time_point() ||
-                    it->second.reset_at < earliest) {
-                    earliest = it->second.reset_at;
+            for (std::size_t i = 0; i < m_shard_count; ++i) {
+                std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+                const BucketMap& buckets = m_shards[i].buckets;
+                for (BucketMap::const_iterator it = buckets.begin();
+                     it != buckets.end(); ++it) {
+                    if (earliest == std::chrono::steady_clock::time_point() ||
+                        it->second.reset_at < earliest) {
+                        earliest = it->second.reset_at;
+                    }
                 }
             }
             return earliest;
         }
 
-        mutable std::mutex m_mutex;
         std::uint64_t m_max_requests;
         std::chrono::seconds m_window;
         std::size_t m_max_buckets;
-        std::map<std::string, Bucket> m_buckets;
+        std::size_t m_shard_count;
+        std::unique_ptr<Shard[]> m_shards;
+        std::atomic<std::size_t> m_bucket_count;
+        std::atomic<std::chrono::steady_clock::rep> m_next_sweep;
     };
 
     /// \brief Rejects HTTP bodies and WebSocket messages above a byte limit.
@@ -1024,6 +1152,12 @@ namespace sync {
         std::uint64_t websocket_message_calls = 0;
         std::uint64_t pulled_batches = 0;
         std::uint64_t pushed_batches = 0;
+        /// \brief Wall time of forwarded calls, by \c SyncTransportOperation.
+        /// \details Rejected calls are not timed; calls that throw are.
+        LatencyHistogram pull_latency;
+        LatencyHistogram push_latency;
+        LatencyHistogram http_post_latency;
+        LatencyHistogram websocket_message_latency;
     };
 
     /// \brief Best-effort observer for transport middleware events.
@@ -1079,22 +1213,69 @@ namespace sync {
         }
 
         virtual void on_sync_transport_cancel_requested() {}
+
+        /// \brief Reports the wall time of one forwarded call.
+        /// \details Middleware reads the clock only when an observer is set.
+        virtual void on_sync_transport_latency(
+                SyncTransportOperation operation,
+                std::chrono::nanoseconds latency) {
+            (void)operation;
+            (void)latency;
+        }
     };
 
     /// \brief Thread-safe counter observer for basic transport metrics.
     /// \details Counts middleware hook invocations, not necessarily distinct
     /// logical user operations. Use separate observers when peer-level and
     /// HTTP-level layers should be reported independently.
+    ///
+    /// Counters are cache-line padded atomics, so transport threads do not
+    /// serialize on the observer. Latencies go to one of several striped
+    /// histograms chosen by thread id and are merged by \ref snapshot().
+    /// Counters are read one by one, so a snapshot taken under load may see
+    /// an event in one counter but not yet in a related one.
     class SyncTransportMetricsObserver : public ISyncTransportObserver {
     public:
         SyncTransportMetricsSnapshot snapshot() const {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            return m_snapshot;
+            SyncTransportMetricsSnapshot out;
+            out.pull_calls = load(PullCalls);
+            out.push_calls = load(PushCalls);
+            out.http_post_calls = load(HttpPostCalls);
+            out.rejected_calls = load(RejectedCalls);
+            out.failed_calls = load(FailedCalls);
+            out.request_cancel_calls = load(RequestCancelCalls);
+            out.http_request_calls = load(HttpRequestCalls);
+            out.websocket_message_calls = load(WebSocketMessageCalls);
+            out.pulled_batches = load(PulledBatches);
+            out.pushed_batches = load(PushedBatches);
+            for (std::size_t i = 0; i < latency_stripe_count; ++i) {
+                std::lock_guard<std::mutex> lock(m_latency[i].mutex);
+                out.pull_latency.merge(
+                    m_latency[i].histograms[operation_index(
+                        SyncTransportOperation::Pull)]);
+                out.push_latency.merge(
+                    m_latency[i].histograms[operation_index(
+                        SyncTransportOperation::Push)]);
+                out.http_post_latency.merge(
+                    m_latency[i].histograms[operation_index(
+                        SyncTransportOperation::HttpPost)]);
+                out.websocket_message_latency.merge(
+                    m_latency[i].histograms[operation_index(
+                        SyncTransportOperation::WebSocketMessage)]);
+            }
+            return out;
         }
 
         void reset() {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_snapshot = SyncTransportMetricsSnapshot();
+            for (std::size_t i = 0; i < CounterCount; ++i) {
+                m_counters[i].value.store(0, std::memory_order_relaxed);
+            }
+            for (std::size_t i = 0; i < latency_stripe_count; ++i) {
+                std::lock_guard<std::mutex> lock(m_latency[i].mutex);
+                for (std::size_t j = 0; j < operation_count; ++j) {
+                    m_latency[i].histograms[j].reset();
+                }
+            }
         }
 
         void on_sync_transport_rejected(
@@ -1102,56 +1283,52 @@ namespace sync {
                 const std::string& error) override {
             (void)operation;
             (void)error;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_snapshot.rejected_calls;
+            add(RejectedCalls);
         }
 
         void on_sync_transport_pull_result(
                 const PullRequest& request,
                 const PullResponse& response) override {
             (void)request;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_snapshot.pull_calls;
+            add(PullCalls);
             if (!response.ok) {
-                ++m_snapshot.failed_calls;
+                add(FailedCalls);
             }
-            m_snapshot.pulled_batches += response.batches.size();
+            add(PulledBatches,
+                response.batches.size() + response.encoded_batches.size());
         }
 
         void on_sync_transport_push_result(
                 const PushRequest& request,
                 const PushResponse& response) override {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_snapshot.push_calls;
+            add(PushCalls);
             if (!response.ok) {
-                ++m_snapshot.failed_calls;
+                add(FailedCalls);
             }
-            m_snapshot.pushed_batches += request.batches.size();
+            add(PushedBatches,
+                request.batches.size() + request.encoded_batches.size());
         }
 
         void on_sync_transport_http_request(
                 const HttpSyncRequest& request) override {
             (void)request;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_snapshot.http_request_calls;
+            add(HttpRequestCalls);
         }
 
         void on_sync_transport_http_post_result(
                 const std::string& target,
                 const HttpSyncResponse& response) override {
             (void)target;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_snapshot.http_post_calls;
+            add(HttpPostCalls);
             if (response.status_code < 200 || response.status_code >= 300) {
-                ++m_snapshot.failed_calls;
+                add(FailedCalls);
             }
         }
 
         void on_sync_transport_websocket_message(
                 const WebSocketSyncRequestContext& request) override {
             (void)request;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_snapshot.websocket_message_calls;
+            add(WebSocketMessageCalls);
         }
 
         void on_sync_transport_exception(
@@ -1159,18 +1336,70 @@ namespace sync {
                 const std::string& error) override {
             (void)operation;
             (void)error;
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_snapshot.failed_calls;
+            add(FailedCalls);
         }
 
         void on_sync_transport_cancel_requested() override {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_snapshot.request_cancel_calls;
+            add(RequestCancelCalls);
+        }
+
+        void on_sync_transport_latency(
+                SyncTransportOperation operation,
+                std::chrono::nanoseconds latency) override {
+            LatencyStripe& stripe =
+                m_latency[std::hash<std::thread::id>()(
+                              std::this_thread::get_id()) %
+                          latency_stripe_count];
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            stripe.histograms[operation_index(operation)].record(latency);
         }
 
     private:
-        mutable std::mutex m_mutex;
-        SyncTransportMetricsSnapshot m_snapshot;
+        enum Counter {
+            PullCalls,
+            PushCalls,
+            HttpPostCalls,
+            RejectedCalls,
+            FailedCalls,
+            RequestCancelCalls,
+            HttpRequestCalls,
+            WebSocketMessageCalls,
+            PulledBatches,
+            PushedBatches,
+            CounterCount
+        };
+
+        static const std::size_t operation_count = 4;
+        static const std::size_t latency_stripe_count = 8;
+
+        /// \brief One counter per cache line to avoid false sharing.
+        struct PaddedCounter {
+            PaddedCounter() : value(0) {}
+
+            std::atomic<std::uint64_t> value;
+            char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+        };
+
+        struct LatencyStripe {
+            std::mutex mutex;
+            LatencyHistogram histograms[operation_count];
+        };
+
+        static std::size_t operation_index(SyncTransportOperation operation) {
+            return static_cast<std::size_t>(operation);
+        }
+
+        void add(Counter counter, std::uint64_t delta = 1) {
+            m_counters[counter].value.fetch_add(delta,
+                                                std::memory_order_relaxed);
+        }
+
+        std::uint64_t load(Counter counter) const {
+            return m_counters[counter].value.load(std::memory_order_relaxed);
+        }
+
+        PaddedCounter m_counters[CounterCount];
+        mutable LatencyStripe m_latency[latency_stripe_count];
     };
 
     namespace detail {
@@ -1199,6 +1428,29 @@ namespace sync {
             } catch (...) {}
         }
 
+        inline void notify_transport_latency(
+                ISyncTransportObserver* observer,
+                SyncTransportOperation operation,
+                std::chrono::steady_clock::time_point started) {
+            if (observer == nullptr) {
+                return;
+            }
+            try {
+                observer->on_sync_transport_latency(
+                    operation,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - started));
+            } catch (...) {}
+        }
+
+        /// \brief Reads the clock only when an observer will use it.
+        inline std::chrono::steady_clock::time_point transport_timer_start(
+                const ISyncTransportObserver* observer) {
+            return observer == nullptr
+                ? std::chrono::steady_clock::time_point()
+                : std::chrono::steady_clock::now();
+        }
+
         inline void notify_transport_cancel_requested(
                 ISyncTransportObserver* observer) {
             if (observer == nullptr) {
@@ -1277,15 +1529,23 @@ namespace sync {
                 }
             }
 
+            const std::chrono::steady_clock::time_point started =
+                detail::transport_timer_start(m_observer);
             try {
                 const PullResponse response = m_next.pull(request);
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::Pull, started);
                 notify_pull_result(request, response);
                 return response;
             } catch (const std::exception& e) {
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::Pull, started);
                 detail::notify_transport_exception(
                     m_observer, SyncTransportOperation::Pull, e.what());
                 throw;
             } catch (...) {
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::Pull, started);
                 detail::notify_transport_exception(
                     m_observer, SyncTransportOperation::Pull,
                     "unknown pull exception");
@@ -1308,15 +1568,23 @@ namespace sync {
                 }
             }
 
+            const std::chrono::steady_clock::time_point started =
+                detail::transport_timer_start(m_observer);
             try {
                 const PushResponse response = m_next.push(request);
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::Push, started);
                 notify_push_result(request, response);
                 return response;
             } catch (const std::exception& e) {
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::Push, started);
                 detail::notify_transport_exception(
                     m_observer, SyncTransportOperation::Push, e.what());
                 throw;
             } catch (...) {
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::Push, started);
                 detail::notify_transport_exception(
                     m_observer, SyncTransportOperation::Push,
                     "unknown push exception");
@@ -1324,6 +1592,11 @@ namespace sync {
             }
         }
 
+        /// \brief Forwards to the wrapped peer; policies see only pulls and pushes.
+        RangeHashResponse range_hash(const RangeHashRequest& request) override {
+            return m_next.range_hash(request);
+        }
+
         void request_cancel() override {
             detail::notify_transport_cancel_requested(m_observer);
             m_next.request_cancel();
@@ -1394,15 +1667,23 @@ namespace sync {
                 }
             }
 
+            const std::chrono::steady_clock::time_point started =
+                detail::transport_timer_start(m_observer);
             try {
                 const HttpSyncResponse response = m_next.handle(request);
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::HttpPost, started);
                 notify_http_post_result(request.target, response);
                 return response;
             } catch (const std::exception& e) {
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::HttpPost, started);
                 detail::notify_transport_exception(
                     m_observer, SyncTransportOperation::HttpPost, e.what());
                 throw;
             } catch (...) {
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::HttpPost, started);
                 detail::notify_transport_exception(
                     m_observer, SyncTransportOperation::HttpPost,
                     "unknown HTTP server exception");
@@ -1442,6 +1723,57 @@ namespace sync {
 
         std::vector<std::uint8_t> handle_binary_message(
                 const WebSocketSyncRequestContext& request) {
+            check_message(request);
+            const std::chrono::steady_clock::time_point started =
+                detail::transport_timer_start(m_observer);
+            try {
+                std::vector<std::uint8_t> response =
+                    m_next.handle_binary_message(request.binary_message);
+                notify_latency(started);
+                return response;
+            } catch (const WebSocketSyncRejected&) {
+                notify_latency(started);
+                throw;
+            } catch (const std::exception& e) {
+                notify_latency(started);
+                notify_exception(e.what());
+                throw;
+            } catch (...) {
+                notify_latency(started);
+                notify_exception("unknown WebSocket server exception");
+                throw;
+            }
+        }
+
+        /// \brief Applies the policy, then returns the response as chunks.
+        /// \see WebSocketSyncServer::handle_binary_message_chunked()
+        ChunkedTransportMessage handle_binary_message_chunked(
+                const WebSocketSyncRequestContext& request) {
+            check_message(request);
+            const std::chrono::steady_clock::time_point started =
+                detail::transport_timer_start(m_observer);
+            try {
+                ChunkedTransportMessage response =
+                    m_next.handle_binary_message_chunked(
+                        request.binary_message);
+                notify_latency(started);
+                return response;
+            } catch (const WebSocketSyncRejected&) {
+                notify_latency(started);
+                throw;
+            } catch (const std::exception& e) {
+                notify_latency(started);
+                notify_exception(e.what());
+                throw;
+            } catch (...) {
+                notify_latency(started);
+                notify_exception("unknown WebSocket server exception");
+                throw;
+            }
+        }
+
+    private:
+        void check_message(const WebSocketSyncRequestContext& request) {
             detail::notify_transport_websocket_message(m_observer, request);
             if (m_policy != nullptr) {
                 const SyncTransportDecision decision =
@@ -1457,25 +1789,19 @@ namespace sync {
                             decision, "WebSocket sync request rejected"));
                 }
             }
+        }
 
-            try {
-                return m_next.handle_binary_message(request.binary_message);
-            } catch (const WebSocketSyncRejected&) {
-                throw;
-            } catch (const std::exception& e) {
-                detail::notify_transport_exception(
-                    m_observer, SyncTransportOperation::WebSocketMessage,
-                    e.what());
-                throw;
-            } catch (...) {
-                detail::notify_transport_exception(
-                    m_observer, SyncTransportOperation::WebSocketMessage,
-                    "unknown WebSocket server exception");
-                throw;
-            }
+        void notify_exception(const char* error) const {
+            detail::notify_transport_exception(
+                m_observer, SyncTransportOperation::WebSocketMessage, error);
+        }
+
+        void notify_latency(
+                std::chrono::steady_clock::time_point started) const {
+            detail::notify_transport_latency(
+                m_observer, SyncTransportOperation::WebSocketMessage, started);
         }
 
-    private:
         static std::string reject_message(
                 const SyncTransportDecision& decision,
                 const char* fallback) {
@@ -1525,16 +1851,24 @@ namespace sync {
                 }
             }
 
+            const std::chrono::steady_clock::time_point started =
+                detail::transport_timer_start(m_observer);
             try {
                 const HttpSyncResponse response =
                     m_next.post(target, content_type, body, cancel_token);
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::HttpPost, started);
                 notify_http_post_result(target, response);
                 return response;
             } catch (const std::exception& e) {
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::HttpPost, started);
                 detail::notify_transport_exception(
                     m_observer, SyncTransportOperation::HttpPost, e.what());
                 throw;
             } catch (...) {
+                detail::notify_transport_latency(
+                    m_observer, SyncTransportOperation::HttpPost, started);
                 detail::notify_transport_exception(
                     m_observer, SyncTransportOperation::HttpPost,
                     "unknown HTTP post exception");
@@ -11,11 +11,21 @@
 /// Concrete bindings own connection setup, authentication headers, ping/pong,
 /// fragmentation/reassembly, backpressure, retries, and socket cancellation.
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "IAsyncSyncPeer.hpp"
 #include "ISyncPeer.hpp"
+#include "PullPageCache.hpp"
 #include "SyncEngine.hpp"
 #include "TransportMessageCodec.hpp"
 
@@ -72,6 +82,66 @@ namespace sync {
         return hint;
     }
 
+    /// \brief Magic of the request-id envelope (8 bytes, no NUL terminator).
+    /// \details Differs from the \c TransportMessageCodec magic, so one
+    /// listener can tell tagged and plain messages apart.
+    inline const std::uint8_t* websocket_sync_tag_magic() {
+        static const std::uint8_t magic[8] = {
+            'M', 'D', 'B', 'X', 'C', 'T', 'A', 'G'
+        };
+        return magic;
+    }
+
+    /// \brief Size of the envelope: magic, then u64 LE request id.
+    inline std::size_t websocket_sync_tag_size() {
+        return 16;
+    }
+
+    /// \brief Whether \p message starts with the request-id envelope.
+    inline bool websocket_sync_message_is_tagged(
+            const std::vector<std::uint8_t>& message) {
+        return message.size() >= websocket_sync_tag_size() &&
+               std::memcmp(&message[0], websocket_sync_tag_magic(), 8) == 0;
+    }
+
+    /// \brief Writes the envelope for \p request_id into \p out.
+    /// \param out Buffer of at least \c websocket_sync_tag_size() bytes.
+    inline void websocket_sync_write_tag(std::uint64_t request_id,
+                                         std::uint8_t* out) {
+        std::memcpy(out, websocket_sync_tag_magic(), 8);
+        detail::write_u64_le(request_id, out + 8);
+    }
+
+    /// \brief Prefixes one encoded sync message with \p request_id.
+    /// \details Lets several exchanges share one connection: the peer
+    /// answers each tagged request with a response tagged the same way, in
+    /// any order.
+    inline std::vector<std::uint8_t> websocket_sync_tag_message(
+            std::uint64_t request_id,
+            const std::vector<std::uint8_t>& message) {
+        std::vector<std::uint8_t> out(websocket_sync_tag_size() + message.size());
+        websocket_sync_write_tag(request_id, &out[0]);
+        if (!message.empty()) {
+            std::memcpy(&out[websocket_sync_tag_size()], &message[0],
+                        message.size());
+        }
+        return out;
+    }
+
+    /// \brief Splits a tagged message into request id and inner message.
+    /// \throws std::runtime_error when \p tagged has no envelope.
+    inline std::uint64_t websocket_sync_untag_message(
+            const std::vector<std::uint8_t>& tagged,
+            std::vector<std::uint8_t>& message) {
+        if (!websocket_sync_message_is_tagged(tagged)) {
+            throw std::runtime_error("WebSocket sync message has no request id");
+        }
+        message.assign(tagged.begin() +
+                           static_cast<std::ptrdiff_t>(websocket_sync_tag_size()),
+                       tagged.end());
+        return detail::read_u64_le(&tagged[8]);
+    }
+
     /// \brief Client-side bridge implemented by a concrete WebSocket library.
     /// \details \p binary_message must contain exactly one
     /// \c TransportMessageCodec request. Implementations return exactly one
@@ -85,8 +155,9 @@ namespace sync {
         /// \param cancel_token Local call-control token; it is not serialized.
         /// \return Encoded pull or push response.
         /// \note The v0.1 wire DTOs have no request id. Implementations must
-        /// serialize concurrent exchanges on one connection unless the
-        /// concrete WebSocket binding adds its own correlation layer.
+        /// serialize concurrent exchanges on one connection unless they wrap
+        /// messages with \c websocket_sync_tag_message() and match responses
+        /// by that id.
         virtual std::vector<std::uint8_t> exchange_binary(
                 const std::vector<std::uint8_t>& binary_message,
                 const CancellationToken& cancel_token) = 0;
@@ -104,13 +175,79 @@ namespace sync {
         }
     };
 
+    /// \brief Non-blocking channel bridge implemented by an asynchronous WebSocket library.
+    /// \details Same message contract as \c IWebSocketSyncChannel.
+    class IAsyncWebSocketSyncChannel {
+    public:
+        /// \brief Receives the response message, or the transport error and an empty message.
+        typedef std::function<void(std::exception_ptr, std::vector<std::uint8_t>)> Callback;
+
+        virtual ~IAsyncWebSocketSyncChannel() {}
+
+        /// \brief Sends one binary sync message and reports its response to \p done.
+        /// \details \p binary_message is only valid until the call returns.
+        /// \p done runs exactly once, on any thread, possibly before the call
+        /// returns.
+        virtual void async_exchange_binary(
+                const std::vector<std::uint8_t>& binary_message,
+                const CancellationToken& cancel_token,
+                Callback done) = 0;
+
+        /// \brief Best-effort cancellation hook for an in-flight exchange.
+        virtual void request_cancel() {}
+
+        /// \brief Returns retry advice for the most recent exchange failure.
+        virtual SyncTransportRetryHint last_retry_hint() const {
+            return SyncTransportRetryHint();
+        }
+    };
+
+    /// \brief Persistent, ordered message stream implemented by a WebSocket library.
+    /// \details Unlike \c IWebSocketSyncChannel, sending does not wait for
+    /// the answer, so several requests can be on the wire at once. The
+    /// receiving side must handle the messages of one stream in the order
+    /// they were sent, one at a time, and answer each with exactly one
+    /// message, e.g. through \c WebSocketSyncServer::handle_binary_message().
+    class IWebSocketSyncStream {
+    public:
+        virtual ~IWebSocketSyncStream() {}
+
+        /// \brief Queues one binary sync message for sending.
+        /// \details May block for backpressure but not for the answer.
+        /// Throws on transport failure.
+        virtual void send_binary(const std::vector<std::uint8_t>& binary_message,
+                                 const CancellationToken& cancel_token) = 0;
+
+        /// \brief Waits for the next message from the other side.
+        /// \details Throws on transport failure or cancellation.
+        virtual std::vector<std::uint8_t> receive_binary(
+                const CancellationToken& cancel_token) = 0;
+
+        /// \brief Best-effort cancellation hook for blocked calls.
+        virtual void request_cancel() {}
+
+        /// \brief Returns retry advice for the most recent stream failure.
+        virtual SyncTransportRetryHint last_retry_hint() const {
+            return SyncTransportRetryHint();
+        }
+    };
+
     /// \brief Server-side dispatcher from binary WebSocket messages to
     /// \c SyncEngine.
+    /// \details Keeps requester cursor baselines, compresses pull responses
+    /// and shares them through a \c PullPageCache like \c HttpSyncServer.
+    /// Push responses carry the cumulative \c receiver_have, so a binding
+    /// that feeds it the messages of an \c IWebSocketSyncStream in order
+    /// also serves \c WebSocketStreamingPushSender.
     class WebSocketSyncServer {
     public:
         explicit WebSocketSyncServer(SyncEngine& engine,
-                                     const CodecBounds& bounds = CodecBounds())
-            : m_engine(engine), m_bounds(bounds) {}
+                                     const CodecBounds& bounds = CodecBounds(),
+                                     std::size_t max_cursor_baselines = 1024)
+            : m_engine(engine),
+              m_bounds(bounds),
+              m_cursor_baselines(
+                  std::make_shared<CursorBaselineCache>(max_cursor_baselines)) {}
 
         /// \brief Handles one complete binary WebSocket message.
         /// \details Request messages produce response messages. Response
@@ -127,67 +264,290 @@ namespace sync {
                     return handle_pull(binary_message);
                 case TransportMessageType::PushRequest:
                     return handle_push(binary_message);
+                case TransportMessageType::RangeHashRequest:
+                    return handle_range_hash(binary_message);
                 case TransportMessageType::PullResponse:
                 case TransportMessageType::PushResponse:
+                case TransportMessageType::RangeHashResponse:
                     throw std::runtime_error(
                         "WebSocket sync server received response message");
             }
             throw std::runtime_error("Unexpected WebSocket sync message type");
         }
 
+        /// \brief Handles one message like \ref handle_binary_message(),
+        /// returning the response as chunks.
+        /// \details Pull responses are built by
+        /// \c TransportMessageCodec::encode_pull_response_chunked(), so
+        /// bindings can send a page without joining it into one buffer.
+        /// A compressed or cached response is one chunk.
+        ChunkedTransportMessage handle_binary_message_chunked(
+                const std::vector<std::uint8_t>& binary_message) const {
+            if (TransportMessageCodec::peek_message_type(
+                    binary_message, &m_bounds) ==
+                TransportMessageType::PullRequest) {
+                const PullRequest request = decode_pull(binary_message);
+                if (compress_for(request) || use_pull_pages(request)) {
+                    return ChunkedTransportMessage(encode_pull(request));
+                }
+                return TransportMessageCodec::encode_pull_response_chunked(
+                    pull_response(request), &m_bounds, cursor_baseline(request));
+            }
+            return ChunkedTransportMessage(
+                handle_binary_message(binary_message));
+        }
+
+        /// \brief Sets when pull responses are sent compressed.
+        /// \details Call before serving; compression is off by default.
+        void set_compression(const TransportCompression& compression) {
+            m_compression = compression;
+        }
+
+        /// \brief Answers pulls from \p cache, or reads every page when null.
+        /// \details Call before serving. Cached pages are one chunk.
+        void set_pull_page_cache(std::shared_ptr<PullPageCache> cache) {
+            m_pull_pages = std::move(cache);
+        }
+
     private:
         std::vector<std::uint8_t> handle_pull(
                 const std::vector<std::uint8_t>& binary_message) const {
-            const PullRequest request =
-                TransportMessageCodec::decode_pull_request(
-                    binary_message, &m_bounds);
-            const PullResponse response = m_engine.handle_pull(request);
-            return TransportMessageCodec::encode_pull_response(
-                response, &m_bounds);
+            return encode_pull(decode_pull(binary_message));
+        }
+
+        std::vector<std::uint8_t> encode_pull(const PullRequest& request) const {
+            if (use_pull_pages(request)) {
+                return cached_pull(request);
+            }
+            bool store = false;
+            return encode_pull_page(request, store);
+        }
+
+        bool use_pull_pages(const PullRequest& request) const {
+            return m_pull_pages && PullPageCache::cacheable(request);
+        }
+
+        /// \brief Copies the page for \p request out of \c m_pull_pages,
+        /// reading and encoding it on a miss.
+        std::vector<std::uint8_t> cached_pull(const PullRequest& request) const {
+            const PullPageCache::Key key = PullPageCache::make_key(
+                request, m_engine.connection()->last_txn_id(), compress_for(request));
+            bool hit = false;
+            const PullPageCache::Page page = m_pull_pages->find_or_fill(
+                key, request.wait_timeout_ms == 0, hit,
+                [this, &request](bool& store) {
+                    return encode_pull_page(request, store);
+                });
+            if (hit) {
+                // The bookkeeping handle_pull() does for each requester.
+                PullResponse stored;
+                m_cursor_baselines->remember(request, stored);
+                m_engine.note_peer_have(request.requester, request.have);
+            }
+            return *page;
+        }
+
+        /// \brief Reads and encodes one page; \p store tells whether other
+        /// requesters may get the same bytes.
+        std::vector<std::uint8_t> encode_pull_page(const PullRequest& request,
+                                                   bool& store) const {
+            PullResponse response = pull_response(request);
+            store = response.ok && (response.has_more || !response.encoded_batches.empty());
+            std::vector<std::uint8_t> out =
+                TransportMessageCodec::encode_pull_response(
+                    response, &m_bounds, cursor_baseline(request));
+            if (compress_for(request)) {
+                TransportMessageCodec::compress_message(out, m_compression);
+            }
+            return out;
+        }
+
+        bool compress_for(const PullRequest& request) const {
+            return m_compression.enabled && request.accept_compressed_messages;
+        }
+
+        PullRequest decode_pull(
+                const std::vector<std::uint8_t>& binary_message) const {
+            return TransportMessageCodec::decode_pull_request(
+                binary_message, &m_bounds, m_cursor_baselines.get());
+        }
+
+        PullResponse pull_response(const PullRequest& request) const {
+            PullResponse response =
+                m_engine.handle_pull(request, PullBatchForm::Encoded);
+            m_cursor_baselines->remember(request, response);
+            return response;
+        }
+
+        static const SyncCursor* cursor_baseline(const PullRequest& request) {
+            return request.accept_cursor_deltas && request.have_baseline_digest == 0
+                ? &request.have
+                : nullptr;
         }
 
         std::vector<std::uint8_t> handle_push(
                 const std::vector<std::uint8_t>& binary_message) const {
             const PushRequest request =
                 TransportMessageCodec::decode_push_request(
-                    binary_message, &m_bounds);
+                    binary_message, &m_bounds, PullBatchForm::Encoded);
             const PushResponse response = m_engine.handle_push(request);
             return TransportMessageCodec::encode_push_response(
                 response, &m_bounds);
         }
 
+        std::vector<std::uint8_t> handle_range_hash(
+                const std::vector<std::uint8_t>& binary_message) const {
+            const RangeHashRequest request =
+                TransportMessageCodec::decode_range_hash_request(
+                    binary_message, &m_bounds);
+            return TransportMessageCodec::encode_range_hash_response(
+                m_engine.handle_range_hash(request), &m_bounds);
+        }
+
         SyncEngine& m_engine;
         CodecBounds m_bounds;
+        std::shared_ptr<CursorBaselineCache> m_cursor_baselines;
+        TransportCompression m_compression;
+        std::shared_ptr<PullPageCache> m_pull_pages;
+    };
+
+    /// \brief Request encoding shared by the WebSocket peers.
+    /// \details Holds the cursor-delta baseline and push compression state.
+    class WebSocketSyncPeerCodec {
+    public:
+        explicit WebSocketSyncPeerCodec(const CodecBounds& bounds)
+            : m_bounds(bounds) {}
+
+        std::vector<std::uint8_t> encode_pull(const PullRequest& request) {
+            return m_cursor_baseline.encode_request(request, &m_bounds);
+        }
+
+        PullResponse decode_pull(const PullRequest& request,
+                                 const std::vector<std::uint8_t>& message) {
+            return m_cursor_baseline.decode_response(request, message, &m_bounds);
+        }
+
+        std::vector<std::uint8_t> encode_push(const PushRequest& request) {
+            std::vector<std::uint8_t> message =
+                TransportMessageCodec::encode_push_request(
+                    request, &m_bounds);
+            if (m_remote_accepts_compression) {
+                TransportMessageCodec::compress_message(message, m_compression);
+            }
+            return message;
+        }
+
+        PushResponse decode_push(const std::vector<std::uint8_t>& message) {
+            PushResponse response = TransportMessageCodec::decode_push_response(
+                message, &m_bounds);
+            m_remote_accepts_compression = response.accept_compressed_messages;
+            return response;
+        }
+
+        void set_compression(const TransportCompression& compression) {
+            m_compression = compression;
+        }
+
+    private:
+        CodecBounds m_bounds;
+        PullCursorBaseline m_cursor_baseline;
+        TransportCompression m_compression;
+        bool m_remote_accepts_compression = false;
     };
 
     /// \brief \c ISyncPeer implementation over an abstract WebSocket channel.
+    /// \details Uses cursor deltas and compresses push requests like
+    /// \c HttpSyncPeer.
     class WebSocketSyncPeer : public ISyncPeer {
     public:
         explicit WebSocketSyncPeer(
                 IWebSocketSyncChannel& channel,
                 const CodecBounds& bounds = CodecBounds())
-            : m_channel(channel), m_bounds(bounds) {}
+            : m_channel(channel), m_codec(bounds) {}
 
         PullResponse pull(const PullRequest& request) override {
+            PullResponse response = exchange_pull(request);
+            if (PullCursorBaseline::baseline_mismatch(response)) {
+                response = exchange_pull(request);
+            }
+            return response;
+        }
+
+        PushResponse push(const PushRequest& request) override {
             const std::vector<std::uint8_t> request_message =
-                TransportMessageCodec::encode_pull_request(
-                    request, &m_bounds);
+                m_codec.encode_push(request);
             const std::vector<std::uint8_t> response_message =
                 m_channel.exchange_binary(request_message,
                                           request.cancel_token);
-            return TransportMessageCodec::decode_pull_response(
-                response_message, &m_bounds);
+            return m_codec.decode_push(response_message);
         }
 
-        PushResponse push(const PushRequest& request) override {
+        void request_cancel() override {
+            m_channel.request_cancel();
+        }
+
+        SyncTransportRetryHint last_retry_hint() const override {
+            return m_channel.last_retry_hint();
+        }
+
+        /// \brief Sets when push requests are sent compressed.
+        /// \details Call before syncing; compression is off by default.
+        void set_compression(const TransportCompression& compression) {
+            m_codec.set_compression(compression);
+        }
+
+    private:
+        PullResponse exchange_pull(const PullRequest& request) {
             const std::vector<std::uint8_t> request_message =
-                TransportMessageCodec::encode_push_request(
-                    request, &m_bounds);
+                m_codec.encode_pull(request);
             const std::vector<std::uint8_t> response_message =
                 m_channel.exchange_binary(request_message,
                                           request.cancel_token);
-            return TransportMessageCodec::decode_push_response(
-                response_message, &m_bounds);
+            return m_codec.decode_pull(request, response_message);
+        }
+
+        IWebSocketSyncChannel& m_channel;
+        WebSocketSyncPeerCodec m_codec;
+    };
+
+    /// \brief \c IAsyncSyncPeer implementation over an asynchronous WebSocket channel.
+    /// \details Same wire behaviour as \c WebSocketSyncPeer; callbacks run on
+    /// the channel's completion thread.
+    class AsyncWebSocketSyncPeer : public IAsyncSyncPeer {
+    public:
+        explicit AsyncWebSocketSyncPeer(
+                IAsyncWebSocketSyncChannel& channel,
+                const CodecBounds& bounds = CodecBounds())
+            : m_channel(channel), m_codec(bounds) {}
+
+        void async_pull(const PullRequest& request, PullCallback done) override {
+            exchange_pull(std::make_shared<PullRequest>(request), std::move(done), true);
+        }
+
+        void async_push(const PushRequest& request, PushCallback done) override {
+            std::vector<std::uint8_t> request_message;
+            try {
+                request_message = m_codec.encode_push(request);
+            } catch (...) {
+                done(std::current_exception(), PushResponse());
+                return;
+            }
+            WebSocketSyncPeerCodec* codec = &m_codec;
+            m_channel.async_exchange_binary(
+                request_message,
+                request.cancel_token,
+                [codec, done](std::exception_ptr error,
+                              std::vector<std::uint8_t> response_message) {
+                    PushResponse decoded;
+                    if (!error) {
+                        try {
+                            decoded = codec->decode_push(response_message);
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    }
+                    done(error, std::move(decoded));
+                });
         }
 
         void request_cancel() override {
@@ -198,9 +558,204 @@ namespace sync {
             return m_channel.last_retry_hint();
         }
 
+        /// \brief Sets when push requests are sent compressed.
+        /// \details Call before syncing; compression is off by default.
+        void set_compression(const TransportCompression& compression) {
+            m_codec.set_compression(compression);
+        }
+
     private:
-        IWebSocketSyncChannel& m_channel;
-        CodecBounds m_bounds;
+        void exchange_pull(std::shared_ptr<PullRequest> request, PullCallback done,
+                           bool resend_on_mismatch) {
+            std::vector<std::uint8_t> request_message;
+            try {
+                request_message = m_codec.encode_pull(*request);
+            } catch (...) {
+                done(std::current_exception(), PullResponse());
+                return;
+            }
+            m_channel.async_exchange_binary(
+                request_message,
+                request->cancel_token,
+                [this, request, done, resend_on_mismatch](
+                        std::exception_ptr error,
+                        std::vector<std::uint8_t> response_message) {
+                    PullResponse decoded;
+                    if (!error) {
+                        try {
+                            decoded = m_codec.decode_pull(*request, response_message);
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    }
+                    if (!error && resend_on_mismatch &&
+                        PullCursorBaseline::baseline_mismatch(decoded)) {
+                        exchange_pull(request, done, false);
+                        return;
+                    }
+                    done(error, std::move(decoded));
+                });
+        }
+
+        IAsyncWebSocketSyncChannel& m_channel;
+        WebSocketSyncPeerCodec m_codec;
+    };
+
+    /// \brief Window settings for \c WebSocketStreamingPushSender.
+    struct WebSocketStreamingPushOptions {
+        /// \brief Local batches per push message.
+        std::uint64_t batches_per_message = 64;
+
+        /// \brief Unacknowledged push messages allowed on the stream.
+        std::size_t max_in_flight_messages = 16;
+
+        /// \brief Unacknowledged encoded message bytes allowed on the stream.
+        /// \details One message is always let through, however large.
+        std::uint64_t max_in_flight_bytes = 16ULL * 1024ULL * 1024ULL;
+    };
+
+    /// \brief Outcome of \c WebSocketStreamingPushSender::push().
+    struct WebSocketStreamingPushResult {
+        bool ok = true;                  ///< Every message was applied.
+        std::string error;               ///< Error of the first failed message.
+        SyncResponseErrorCode error_code = SyncResponseErrorCode::None;
+        bool error_retryable = false;
+        SyncCursor receiver_have;        ///< Cursor of the last answer.
+        std::uint64_t acknowledged_seq = 0; ///< Last local \c seq the receiver has.
+        std::uint64_t messages_sent = 0;
+        std::uint64_t batches_sent = 0;
+        std::uint64_t max_in_flight = 0; ///< Most messages waiting for an answer at once.
+    };
+
+    /// \brief Streams local batches over an \c IWebSocketSyncStream with a
+    /// window of unacknowledged messages.
+    /// \details \c WebSocketSyncPeer::push() waits one round trip per push,
+    /// so a long link caps throughput at one message per RTT. The sender
+    /// splits a range of local batches into push messages and keeps up to
+    /// \c max_in_flight_messages / \c max_in_flight_bytes of them on the
+    /// stream. Answers are cumulative: each \c receiver_have releases every
+    /// message whose batches it covers, and a new message is sent as soon as
+    /// the window has room. After a failed message nothing more is sent and
+    /// the answers still on the stream are drained, so the stream stays
+    /// usable. Push compression follows the receiver's answers as in
+    /// \c WebSocketSyncPeer.
+    /// \note The engine and stream must outlive the sender, and one sender
+    /// owns the stream while \ref push() runs.
+    class WebSocketStreamingPushSender {
+    public:
+        /// \throws std::invalid_argument when \p options is unusable.
+        WebSocketStreamingPushSender(
+                SyncEngine& engine,
+                IWebSocketSyncStream& stream,
+                const WebSocketStreamingPushOptions& options =
+                    WebSocketStreamingPushOptions(),
+                const CodecBounds& bounds = CodecBounds())
+            : m_engine(engine), m_stream(stream), m_options(options), m_codec(bounds) {
+            if (m_options.batches_per_message == 0 ||
+                m_options.max_in_flight_messages == 0 ||
+                m_options.max_in_flight_bytes == 0) {
+                throw std::invalid_argument(
+                    "WebSocketStreamingPushOptions: limits must be positive");
+            }
+        }
+
+        /// \brief Streams the local batches with \c seq in
+        /// <tt>[from_seq, to_seq]</tt>.
+        /// \param from_seq First \c seq to send, e.g. the receiver's
+        ///        \c receiver_have for this node plus 1.
+        /// \param to_seq Last \c seq to send; 0 sends up to the local tail.
+        /// \param cancel_token Passed to every stream call.
+        /// \return Outcome; rejected messages are reported in it.
+        /// \throws std::runtime_error on a local changelog gap, and whatever
+        ///         the stream throws; the stream should then be reopened.
+        WebSocketStreamingPushResult push(std::uint64_t from_seq,
+                                          std::uint64_t to_seq = 0,
+                                          const CancellationToken& cancel_token =
+                                              CancellationToken()) {
+            WebSocketStreamingPushResult result;
+            const NodeId local = m_engine.local_node_id();
+            if (to_seq == 0) {
+                to_seq = m_engine.local_seq();
+            }
+            if (from_seq == 0) {
+                from_seq = 1;
+            }
+            // Messages not yet covered by an answer: last seq and size.
+            std::deque<std::pair<std::uint64_t, std::uint64_t>> window;
+            std::uint64_t window_bytes = 0;
+            std::uint64_t unanswered = 0;
+            std::uint64_t next = from_seq;
+            for (;;) {
+                while (result.ok && next <= to_seq &&
+                       window.size() < m_options.max_in_flight_messages &&
+                       (window.empty() || window_bytes < m_options.max_in_flight_bytes)) {
+                    const std::uint64_t last =
+                        to_seq - next >= m_options.batches_per_message
+                            ? next + m_options.batches_per_message - 1
+                            : to_seq;
+                    const PushRequest request = m_engine.make_push_request(next, last);
+                    const std::vector<std::uint8_t> message = m_codec.encode_push(request);
+                    m_stream.send_binary(message, cancel_token);
+                    window.push_back(std::make_pair(last, static_cast<std::uint64_t>(message.size())));
+                    window_bytes += message.size();
+                    ++unanswered;
+                    ++result.messages_sent;
+                    result.batches_sent += request.batches.size();
+                    if (unanswered > result.max_in_flight) {
+                        result.max_in_flight = unanswered;
+                    }
+                    next = last + 1;
+                }
+                if (unanswered == 0) {
+                    break;
+                }
+                const PushResponse response =
+                    m_codec.decode_push(m_stream.receive_binary(cancel_token));
+                --unanswered;
+                result.receiver_have = response.receiver_have;
+                const std::uint64_t have = response.receiver_have.last_seq_for(local);
+                if (have > result.acknowledged_seq) {
+                    result.acknowledged_seq = have;
+                }
+                while (!window.empty() && window.front().first <= result.acknowledged_seq) {
+                    window_bytes -= window.front().second;
+                    window.pop_front();
+                }
+                if (!response.ok && result.ok) {
+                    result.ok = false;
+                    result.error = response.error.empty() ? "push failed" : response.error;
+                    result.error_code = response.error_code;
+                    result.error_retryable = response.error_retryable;
+                }
+            }
+            if (result.ok && result.acknowledged_seq < to_seq && from_seq <= to_seq) {
+                result.ok = false;
+                result.error = "receiver did not acknowledge every streamed batch";
+            }
+            return result;
+        }
+
+        /// \brief Forwards cancellation to the stream.
+        void request_cancel() {
+            m_stream.request_cancel();
+        }
+
+        /// \brief Returns retry advice for the most recent stream failure.
+        SyncTransportRetryHint last_retry_hint() const {
+            return m_stream.last_retry_hint();
+        }
+
+        /// \brief Sets when push messages are sent compressed.
+        /// \details Call before streaming; compression is off by default.
+        void set_compression(const TransportCompression& compression) {
+            m_codec.set_compression(compression);
+        }
+
+    private:
+        SyncEngine&                   m_engine;
+        IWebSocketSyncStream&         m_stream;
+        WebSocketStreamingPushOptions m_options;
+        WebSocketSyncPeerCodec        m_codec;
     };
 
 } // namespace sync
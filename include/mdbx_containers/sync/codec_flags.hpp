@@ -3,7 +3,7 @@
 #define MDBX_CONTAINERS_HEADER_SYNC_CODEC_FLAGS_HPP_INCLUDED
 
 /// \file CodecFlags.hpp
-/// \brief Codec flag bits for \c ChangeBatch and \c ChangeOp.
+/// \brief Codec flag bits for \c ChangeBatch, \c ChangeOp and transport messages.
 
 #include <cstdint>
 
@@ -14,7 +14,7 @@ namespace sync {
     /// \note All unknown bits trigger a decoder error.
     enum ChangeBatchFlags : std::uint32_t {
         BATCH_NONE              = 0,
-        BATCH_COMPRESSED_ZSTD   = 1u << 0, ///< Reserved, unsupported in v0.1.
+        BATCH_COMPRESSED_ZSTD   = 1u << 0, ///< Ops section is one Zstd frame (needs \c MDBXC_HAS_ZSTD).
         BATCH_HAS_MORE          = 1u << 1, ///< More chunks follow (full export).
     };
 
@@ -27,6 +27,23 @@ namespace sync {
         OP_TOMBSTONE        = 1u << 2, ///< Delete-marker (value is absent).
     };
 
+    /// \brief Bit flags of the transport message envelope.
+    /// \note All unknown bits trigger a decoder error.
+    enum TransportMessageFlags : std::uint32_t {
+        TRANSPORT_MESSAGE_NONE = 0,
+        TRANSPORT_MESSAGE_ZSTD = 1u << 0, ///< Payload is its plain size and one Zstd frame (needs \c MDBXC_HAS_ZSTD).
+    };
+
+    /// \brief Returns true when this build encodes and decodes
+    /// \c BATCH_COMPRESSED_ZSTD batches (\c MDBXC_HAS_ZSTD=1 and libzstd).
+    inline bool batch_compression_supported() noexcept {
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+
 } // namespace sync
 } // namespace mdbxc
 
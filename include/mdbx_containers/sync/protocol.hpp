@@ -9,8 +9,10 @@
 #include <string>
 #include <vector>
 
+#include "../common/CommitLatency.hpp"
 #include "ChangeBatch.hpp"
 #include "cancellation.hpp"
+#include "codec_flags.hpp"
 #include "common.hpp"
 #include "SyncCursor.hpp"
 
@@ -25,10 +27,14 @@ namespace sync {
     enum class SyncResponseErrorCode : std::uint16_t {
         None                    = 0, ///< No structured sync error.
         DbIdMismatch            = 1, ///< Request targeted a different db_id.
-        UnsupportedFullSnapshot = 2, ///< Full snapshot protocol is not implemented.
+        UnsupportedFullSnapshot = 2, ///< The call does not serve full snapshots.
         ApplyConflict           = 3, ///< Push apply failed on a sync conflict.
         SnapshotRequired        = 4, ///< Requested changelog history was pruned.
         BatchTooLarge           = 5, ///< A single retained batch exceeds the requested limit.
+        SnapshotExpired         = 6, ///< Snapshot token is unknown, expired, or out of order.
+        CursorBaselineMismatch  = 7, ///< A delta-encoded \c have named a baseline the responder does not hold.
+        RangeHashUnavailable    = 8, ///< The table keeps no range hashes, or keeps them with other settings.
+        Busy                    = 9, ///< The receiver's apply queue is full; resend after a delay.
     };
 
     /// \brief Returns a stable diagnostic name for a sync response error code.
@@ -47,10 +53,33 @@ namespace sync {
                 return "snapshot_required";
             case SyncResponseErrorCode::BatchTooLarge:
                 return "batch_too_large";
+            case SyncResponseErrorCode::SnapshotExpired:
+                return "snapshot_expired";
+            case SyncResponseErrorCode::CursorBaselineMismatch:
+                return "cursor_baseline_mismatch";
+            case SyncResponseErrorCode::RangeHashUnavailable:
+                return "range_hash_unavailable";
+            case SyncResponseErrorCode::Busy:
+                return "busy";
         }
         return "unknown";
     }
 
+    /// \brief In which \c PullResponse or \c PushRequest field batches travel.
+    enum class PullBatchForm {
+        Decoded, ///< Decoded into \c batches.
+        Encoded, ///< Kept as \c ChangeBatchCodec bytes in \c encoded_batches.
+    };
+
+    /// \brief One table a replica subscribes to; see
+    /// \c PullRequest::subscription.
+    struct SyncTableSubscription {
+        std::string dbi_name;
+        /// \brief Storage-key prefixes to receive; empty receives every key.
+        /// \details \c ClearTable ops of the table always match.
+        std::vector<std::vector<std::uint8_t>> key_prefixes;
+    };
+
     /// \brief Request from a replica to a primary node for new change batches.
     struct PullRequest {
         NodeId       requester{};
@@ -62,8 +91,9 @@ namespace sync {
         /// returned alone when it does not exceed \c max_single_batch_bytes.
         std::uint64_t max_bytes   = 4ULL * 1024ULL * 1024ULL;
         /// \brief Requests a full snapshot instead of an incremental delta.
-        /// \details Reserved for a future snapshot protocol. v0.1
-        /// \c SyncEngine responders reject this request explicitly.
+        /// \details \c SyncEngine::handle_pull() then returns the user
+        /// tables of one read snapshot in key order, a page at a time; see
+        /// \c snapshot_token and \c SyncEngine::apply_snapshot_page().
         bool         request_full_snapshot = false;
         /// \brief Cooperative cancellation token for this transport call.
         /// \details Optional; default-constructed tokens never cancel.
@@ -74,6 +104,51 @@ namespace sync {
         /// next required retained batch exceeds this value. This differs from
         /// \c max_bytes, which is a soft page budget.
         std::uint64_t max_single_batch_bytes = 4ULL * 1024ULL * 1024ULL;
+        /// \brief Whether the requester decodes \c BATCH_COMPRESSED_ZSTD batches.
+        /// \details Responders send batches stored compressed as they are
+        /// when set, and plain otherwise. Defaults to what this build supports.
+        bool         accept_compressed_batches = batch_compression_supported();
+        /// \brief Form in which the caller wants the response batches.
+        /// \details Local call-control state like \c cancel_token, never
+        /// serialized. \c Encoded lets a receiver that only applies the
+        /// batches skip materializing them: the built-in peers then return
+        /// them in \c PullResponse::encoded_batches. Peers may ignore it, so
+        /// callers must handle both fields.
+        PullBatchForm batch_form = PullBatchForm::Decoded;
+        /// \brief Long-poll timeout in milliseconds; 0 answers at once.
+        /// \details When the page would be empty, the responder waits up to
+        /// this long for a commit that gives the requester something to
+        /// pull, then answers. \c SyncEngine caps the wait at
+        /// \c SyncEngine::max_pull_wait(), which is 0 unless configured.
+        std::uint64_t wait_timeout_ms = 0;
+        /// \brief \c PullResponse::snapshot_token of the previous snapshot page.
+        /// \details Empty starts a new full snapshot. Opaque to callers.
+        std::string  snapshot_token;
+        /// \brief Whether the requester decodes response cursors sent as
+        /// deltas against \c have.
+        /// \details Set by the built-in HTTP and WebSocket peers. Responders
+        /// that keep a \c CursorBaselineCache also store \c have for such
+        /// requesters, so later requests can send \c have as a delta.
+        bool         accept_cursor_deltas = false;
+        /// \brief Non-zero when \c have arrived as a delta whose baseline the
+        /// decoder does not hold.
+        /// \details Decode-side state, never serialized. \c have is then
+        /// empty, and \c SyncEngine::handle_pull() answers
+        /// \c CursorBaselineMismatch so the requester resends a full cursor.
+        std::uint64_t have_baseline_digest = 0;
+        /// \brief Tables, optionally narrowed to key prefixes, the requester
+        /// replicates; empty receives every table.
+        /// \details Changelog pages then carry only the matching ops. A
+        /// batch with no matching op is sent with no ops, so the requester's
+        /// applied cursor still advances past it. Full snapshots ignore the
+        /// subscription. The applied cursor then covers only the subscribed
+        /// data: widening a subscription needs a new full snapshot.
+        std::vector<SyncTableSubscription> subscription;
+        /// \brief Whether the requester decodes \c TRANSPORT_MESSAGE_ZSTD
+        /// messages.
+        /// \details Transport servers with compression enabled may then
+        /// compress the response. Defaults to what this build supports.
+        bool         accept_compressed_messages = batch_compression_supported();
     };
 
     /// \brief Response to a \c PullRequest.
@@ -86,6 +161,12 @@ namespace sync {
         SyncCursor               remote_tail;
         bool                     remote_tail_known = false;
         std::vector<ChangeBatch> batches;
+        /// \brief Batches as \c ChangeBatchCodec bytes, following \c batches.
+        /// \details Filled instead of \c batches by \c PullBatchForm::Encoded
+        /// pulls and decodes, so changelog bytes travel from the responder's
+        /// changelog to the receiver's apply without being decoded and
+        /// encoded again.
+        std::vector<std::vector<std::uint8_t>> encoded_batches;
         bool                     has_more = false;
         bool                     ok       = true;
         std::string              error;
@@ -98,6 +179,14 @@ namespace sync {
         /// mean blindly replaying the identical request is always useful.
         SyncResponseErrorCode    error_code = SyncResponseErrorCode::None;
         bool                     error_retryable = false;
+        /// \brief Token for the next page of a full snapshot.
+        /// \details Set on snapshot pages with \c has_more; empty otherwise.
+        /// On snapshot pages \c remote_tail is the cursor the snapshot
+        /// reflects and stays the same on every page.
+        std::string              snapshot_token;
+        /// \brief Whether the responder stored the request's \c have as the
+        /// baseline for the requester's next cursor delta.
+        bool                     cursor_baseline_stored = false;
     };
 
     /// \brief Request carrying changes that the sender wants the receiver to
@@ -106,6 +195,10 @@ namespace sync {
         NodeId                   sender{};
         DbId                     db_id{};
         std::vector<ChangeBatch> batches;
+        /// \brief Batches as \c ChangeBatchCodec bytes, applied after \c batches.
+        /// \details Applied from the bytes without decoding them into
+        /// \c ChangeOp values; see \c PullResponse::encoded_batches.
+        std::vector<std::vector<std::uint8_t>> encoded_batches;
         /// \brief Cooperative cancellation token for this transport call.
         /// \details Optional; default-constructed tokens never cancel.
         CancellationToken        cancel_token;
@@ -114,6 +207,10 @@ namespace sync {
     /// \brief Response to a \c PushRequest.
     struct PushResponse {
         SyncCursor               receiver_have;
+        /// \brief Whether the receiver decodes \c BATCH_COMPRESSED_ZSTD batches.
+        /// \details Lets a sender set the flag on later pushes to this peer;
+        /// \c SyncEngine::make_push_request() always builds plain batches.
+        bool                     accept_compressed_batches = batch_compression_supported();
         bool                     ok = true;
         std::string              error;
         /// \brief Optional machine-readable sync-level error code.
@@ -125,6 +222,107 @@ namespace sync {
         /// mean blindly replaying the identical request is always useful.
         SyncResponseErrorCode    error_code = SyncResponseErrorCode::None;
         bool                     error_retryable = false;
+        /// \brief Whether the receiver decodes \c TRANSPORT_MESSAGE_ZSTD
+        /// messages.
+        /// \details Lets a transport peer compress later push requests.
+        bool                     accept_compressed_messages = batch_compression_supported();
+        /// \brief MDBX phases of the receiver's apply commit.
+        /// \details Filled by \c SyncEngine::handle_push() and
+        /// \c SyncEngine::apply_snapshot_page() for local callers; zero when
+        /// nothing was committed. Not serialized by transports.
+        CommitLatency            commit_latency;
+        /// \brief Suggested delay before resending a \c Busy push, in seconds.
+        /// \details Set by \c PushApplyQueue. Not serialized by transports;
+        /// \c HttpSyncServer sends it as \c Retry-After, which reaches the
+        /// sender as a \c SyncTransportRetryHint.
+        std::uint64_t            retry_after_seconds = 0;
+    };
+
+    /// \brief What a \c RangeHashRequest asks for.
+    enum class RangeHashQuery : std::uint8_t {
+        Nodes   = 1, ///< Summaries of tree nodes at one depth.
+        Leaves  = 2, ///< Leaf summaries of hash buckets.
+        Records = 3, ///< Table records of a key range.
+    };
+
+    /// \brief Record count and hash of one node of a range-hash tree.
+    struct RangeHashNode {
+        std::uint8_t  depth = 0;  ///< 0 is the root; the deepest level are the buckets.
+        std::uint32_t index = 0;  ///< Position of the node within its depth.
+        std::uint64_t count = 0;  ///< Records below the node.
+        std::uint64_t hash  = 0;  ///< Wrapping sum of the digests of its leaves.
+    };
+
+    /// \brief Summary of one leaf: the records from \c start_key up to the
+    /// next leaf start in table order.
+    struct RangeHashLeaf {
+        std::uint32_t bucket = 0;
+        /// \brief Whether the leaf holds the records before the first leaf
+        /// start key; \c start_key is then empty.
+        bool          head = false;
+        std::vector<std::uint8_t> start_key;
+        std::uint64_t count = 0;
+        std::uint64_t hash  = 0; ///< XXH3 over the leaf records in table order.
+    };
+
+    /// \brief One table record; a \c MDBX_DUPSORT key has one per value.
+    struct RangeHashRecord {
+        std::vector<std::uint8_t> key;
+        std::vector<std::uint8_t> value;
+    };
+
+    /// \brief Key range <tt>[lo, hi)</tt> of one table.
+    struct RangeHashRange {
+        bool from_head = true;        ///< Starts at the first record instead of \c lo.
+        std::vector<std::uint8_t> lo;
+        bool has_hi = false;          ///< Otherwise runs to the end of the table.
+        std::vector<std::uint8_t> hi;
+    };
+
+    /// \brief Anti-entropy request comparing the range hashes of one table.
+    /// \details Served by \c SyncEngine::handle_range_hash() for tables
+    /// enabled with \c SyncEngine::enable_range_hash(); see
+    /// \c RangeHashVerifier for the comparison.
+    struct RangeHashRequest {
+        NodeId         requester{};
+        DbId           db_id{};
+        std::string    dbi_name;
+        RangeHashQuery query = RangeHashQuery::Nodes;
+        /// \brief Node depth for \c Nodes.
+        std::uint8_t   depth = 0;
+        /// \brief Node indexes for \c Nodes, bucket indexes for \c Leaves.
+        std::vector<std::uint32_t> indexes;
+        /// \brief For \c Records: start from the first record of the table
+        /// instead of \c lo.
+        bool           from_head = true;
+        std::vector<std::uint8_t> lo; ///< Inclusive lower key for \c Records.
+        bool           has_hi = false;
+        std::vector<std::uint8_t> hi; ///< Exclusive upper key for \c Records.
+        /// \brief Soft page limits for \c Records; the values of one key
+        /// are never split across pages.
+        std::uint64_t  max_records = 4096;
+        std::uint64_t  max_bytes   = 4ULL * 1024ULL * 1024ULL;
+        /// \brief Cooperative cancellation token for this transport call.
+        /// \details Optional; default-constructed tokens never cancel.
+        CancellationToken cancel_token;
+    };
+
+    /// \brief Response to a \c RangeHashRequest.
+    struct RangeHashResponse {
+        bool           ok = true;
+        std::string    error;
+        SyncResponseErrorCode error_code = SyncResponseErrorCode::None;
+        bool           error_retryable = false;
+        /// \brief Leaf size setting of the table; both sides must match.
+        std::uint8_t   leaf_bits = 0;
+        /// \brief Persistent MDBX flags of the table.
+        std::uint32_t  dbi_flags = 0;
+        std::vector<RangeHashNode>   nodes;
+        std::vector<RangeHashLeaf>   leaves;
+        std::vector<RangeHashRecord> records;
+        /// \brief For \c Records: the range continues at \c resume_key.
+        bool           has_more = false;
+        std::vector<std::uint8_t> resume_key;
     };
 
 } // namespace sync
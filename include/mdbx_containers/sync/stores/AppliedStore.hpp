@@ -47,6 +47,18 @@ namespace sync {
             }
         }
 
+        /// \brief Returns the id of the last transaction that modified the store.
+        /// \details Equal values mean identical contents, so
+        /// \c AppliedCursorCache is keyed by it.
+        std::uint64_t mod_txnid(MDBX_txn* txn) const {
+            txn = checked_txn(txn, "AppliedStore::mod_txnid");
+            ensure_open();
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat)),
+                       "AppliedStore mod_txnid failed");
+            return stat.ms_mod_txnid;
+        }
+
         /// \brief Returns the last contiguous applied \c seq for \p origin.
         /// \details Returns 0 when no record exists.
         std::uint64_t last_applied_seq(MDBX_txn* txn, const NodeId& origin) const {
@@ -0,0 +1,215 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_STORES_CHANGE_LOG_DBI_INDEX_STORE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_STORES_CHANGE_LOG_DBI_INDEX_STORE_HPP_INCLUDED
+
+/// \file ChangeLogDbiIndexStore.hpp
+/// \brief Optional index of the changelog batches that touch each DBI.
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mdbx.h>
+
+#include "../../detail/utils.hpp"
+#include "../common.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Thin wrapper around \c _mdbxc_changelog_dbis.
+    /// \details \c MDBX_DUPSORT | \c MDBX_DUPFIXED DBI. Key = \c dbi_name of
+    /// a replicated table, values = \c origin_node_id (16 raw bytes) followed
+    /// by \c seq as \c u64 big-endian, one per changelog batch with an op on
+    /// that table. Values sort like changelog keys, so the batches of one
+    /// origin that touch a table are a contiguous, ordered duplicate range.
+    /// The DBI exists only once \c ChangeLogStore::rebuild_dbi_index()
+    /// created it; \c ChangeLogStore keeps it in step from then on.
+    class ChangeLogDbiIndexStore {
+    public:
+        /// \brief Constructs a wrapper bound to \p env.
+        ChangeLogDbiIndexStore(MDBX_env* env,
+                               const std::string& dbi_name = "_mdbxc_changelog_dbis")
+            : m_env(env), m_dbi_name(dbi_name), m_dbi(0), m_open(false) {}
+
+        /// \brief Opens or creates the DBI inside the supplied transaction.
+        void open(MDBX_txn* txn) {
+            txn = checked_txn(txn, "ChangeLogDbiIndexStore::open");
+            if (m_open) return;
+            check_mdbx(mdbx_dbi_open(txn, m_dbi_name.c_str(), dbi_flags(MDBX_CREATE),
+                                     &m_dbi),
+                       "Failed to open ChangeLogDbiIndexStore DBI");
+            m_open = true;
+        }
+
+        /// \brief Opens the DBI only if it already exists.
+        /// \return \c true when opened, \c false when the DBI is absent.
+        bool open_existing(MDBX_txn* txn) {
+            txn = checked_txn(txn, "ChangeLogDbiIndexStore::open_existing");
+            if (m_open) return true;
+            const int rc = mdbx_dbi_open(txn, m_dbi_name.c_str(),
+                                         dbi_flags(MDBX_DB_DEFAULTS), &m_dbi);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to open existing ChangeLogDbiIndexStore DBI");
+            m_open = true;
+            return true;
+        }
+
+        bool is_open() const { return m_open; }
+        MDBX_dbi handle() const { return m_dbi; }
+
+        /// \brief Resets the open flag so the next \c open() reopens the DBI.
+        void reset_open() { m_open = false; }
+
+        /// \brief Throws when the DBI has not been opened yet.
+        void ensure_open() const {
+            if (!m_open) {
+                throw std::logic_error("ChangeLogDbiIndexStore is not open");
+            }
+        }
+
+        /// \brief Records that batch (\p origin, \p seq) touches \p dbi_names.
+        /// \details Repeated names and already indexed pairs are no-ops.
+        void note_batch(MDBX_txn* txn, const NodeId& origin, std::uint64_t seq,
+                        const std::vector<std::string>& dbi_names) {
+            txn = checked_txn(txn, "ChangeLogDbiIndexStore::note_batch");
+            ensure_open();
+            std::uint8_t value_buf[24];
+            encode_value(origin, seq, value_buf);
+            for (std::size_t i = 0; i < dbi_names.size(); ++i) {
+                MDBX_val k = { const_cast<char*>(dbi_names[i].data()), dbi_names[i].size() };
+                MDBX_val v = { value_buf, sizeof(value_buf) };
+                const int rc = mdbx_put(txn, m_dbi, &k, &v, MDBX_NODUPDATA);
+                if (rc != MDBX_KEYEXIST) {
+                    check_mdbx(rc, "ChangeLogDbiIndexStore note_batch failed");
+                }
+            }
+        }
+
+        /// \brief Finds the first batch of \p origin at or after \p from_seq
+        /// that touches \p dbi_name.
+        /// \return \c false when there is none.
+        bool next_seq(MDBX_txn* txn, const std::string& dbi_name, const NodeId& origin,
+                      std::uint64_t from_seq, std::uint64_t& seq) const {
+            txn = checked_txn(txn, "ChangeLogDbiIndexStore::next_seq");
+            ensure_open();
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw),
+                       "ChangeLogDbiIndexStore next_seq cursor open failed");
+            std::uint8_t value_buf[24];
+            encode_value(origin, from_seq, value_buf);
+            MDBX_val k = { const_cast<char*>(dbi_name.data()), dbi_name.size() };
+            MDBX_val v = { value_buf, sizeof(value_buf) };
+            const int rc = mdbx_cursor_get(raw, &k, &v, MDBX_GET_BOTH_RANGE);
+            mdbx_cursor_close(raw);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "ChangeLogDbiIndexStore next_seq failed");
+            if (!value_matches_origin(v, origin)) return false;
+            seq = decode_value_seq(v);
+            return true;
+        }
+
+        /// \brief Removes the entries of \p origin with \p from_seq <= seq <= \p to_seq.
+        /// \details One range walk per indexed table.
+        /// \return Number of entries removed.
+        std::size_t erase_range(MDBX_txn* txn, const NodeId& origin,
+                                std::uint64_t from_seq, std::uint64_t to_seq) {
+            txn = checked_txn(txn, "ChangeLogDbiIndexStore::erase_range");
+            ensure_open();
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw),
+                       "ChangeLogDbiIndexStore erase cursor open failed");
+            std::size_t removed = 0;
+            try {
+                std::uint8_t lo_buf[24];
+                std::uint8_t hi_buf[24];
+                encode_value(origin, from_seq, lo_buf);
+                encode_value(origin, to_seq, hi_buf);
+                MDBX_val k, v;
+                int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
+                while (rc == MDBX_SUCCESS) {
+                    // Deletes may move the page the key points into.
+                    const std::string name(static_cast<const char*>(k.iov_base), k.iov_len);
+                    k.iov_base = const_cast<char*>(name.data());
+                    k.iov_len = name.size();
+                    v.iov_base = lo_buf;
+                    v.iov_len = sizeof(lo_buf);
+                    rc = mdbx_cursor_get(raw, &k, &v, MDBX_GET_BOTH_RANGE);
+                    while (rc == MDBX_SUCCESS &&
+                           std::memcmp(v.iov_base, hi_buf, sizeof(hi_buf)) <= 0) {
+                        check_mdbx(mdbx_cursor_del(raw, MDBX_CURRENT),
+                                   "ChangeLogDbiIndexStore erase cursor_del failed");
+                        ++removed;
+                        rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT_DUP);
+                    }
+                    if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                        check_mdbx(rc, "ChangeLogDbiIndexStore erase cursor walk failed");
+                    }
+                    // Reposition past this table whether or not entries remain.
+                    k.iov_base = const_cast<char*>(name.data());
+                    k.iov_len = name.size();
+                    rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+                    if (rc == MDBX_SUCCESS && k.iov_len == name.size() &&
+                        (name.empty() || std::memcmp(k.iov_base, name.data(), name.size()) == 0)) {
+                        rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT_NODUP);
+                    }
+                }
+                if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "ChangeLogDbiIndexStore erase key walk failed");
+                }
+            } catch (...) {
+                mdbx_cursor_close(raw);
+                throw;
+            }
+            mdbx_cursor_close(raw);
+            return removed;
+        }
+
+        /// \brief Removes every entry; the DBI itself is kept.
+        /// \pre Transaction must be writable.
+        void clear(MDBX_txn* txn) {
+            txn = checked_txn(txn, "ChangeLogDbiIndexStore::clear");
+            ensure_open();
+            check_mdbx(mdbx_drop(txn, m_dbi, false),
+                       "ChangeLogDbiIndexStore clear failed");
+        }
+
+    private:
+        MDBX_txn* checked_txn(MDBX_txn* txn, const char* context) const {
+            return checked_txn_env(txn, m_env, context);
+        }
+
+        static MDBX_db_flags_t dbi_flags(MDBX_db_flags_t extra) {
+            return static_cast<MDBX_db_flags_t>(MDBX_DUPSORT | MDBX_DUPFIXED | extra);
+        }
+
+        static void encode_value(const NodeId& origin, std::uint64_t seq,
+                                 std::uint8_t* out) {
+            std::memcpy(out, origin.data(), 16);
+            // Big-endian seq keeps duplicates in changelog key order.
+            detail::write_u64_be(seq, out + 16);
+        }
+
+        static bool value_matches_origin(const MDBX_val& value, const NodeId& origin) {
+            if (value.iov_len != 24) {
+                throw std::runtime_error("ChangeLogDbiIndexStore value has invalid size");
+            }
+            return std::memcmp(value.iov_base, origin.data(), 16) == 0;
+        }
+
+        static std::uint64_t decode_value_seq(const MDBX_val& value) {
+            return detail::read_u64_be(static_cast<const std::uint8_t*>(value.iov_base) + 16);
+        }
+
+        MDBX_env*     m_env;
+        std::string   m_dbi_name;
+        MDBX_dbi      m_dbi;
+        bool          m_open;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_STORES_CHANGE_LOG_DBI_INDEX_STORE_HPP_INCLUDED
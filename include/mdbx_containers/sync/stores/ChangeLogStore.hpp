@@ -5,8 +5,10 @@
 /// \file ChangeLogStore.hpp
 /// \brief Per-origin changelog of raw \c ChangeBatch bytes.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <map>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -14,17 +16,265 @@
 #include <mdbx.h>
 
 #include "../../detail/utils.hpp"
+#include "../ChangeBatchView.hpp"
 #include "../common.hpp"
+#include "ChangeLogDbiIndexStore.hpp"
+#include "MetaStore.hpp"
 #include "OriginIndexStore.hpp"
 
 namespace mdbxc {
 namespace sync {
 
+    /// \brief How changelog records are keyed; recorded in \c _mdbxc_meta.
+    enum class ChangeLogLayout : std::uint8_t {
+        /// One DBI keyed by \c origin (16 bytes) followed by big-endian \c seq.
+        Shared = 0,
+        /// One DBI per origin, named \c <changelog>@<origin as hex> and
+        /// keyed by big-endian \c seq alone. Keys are 8 bytes instead of
+        /// 24, and in-order appends use \c MDBX_APPEND. Every origin holds
+        /// a DBI handle, so \c Config::max_dbs must leave room for them.
+        PerOrigin = 1
+    };
+
+    /// \class ChangeLogKeyspace
+    /// \brief Changelog key format and DBIs of one transaction, in either layout.
+    /// \details Lets readers that walk the changelog with their own cursors,
+    /// such as the pull paths of \c SyncEngine, stay layout-neutral: they
+    /// position a cursor of \ref dbi_for() at \ref seek_key() and stop once
+    /// \ref key_matches_origin() fails. Valid while \p txn is.
+    class ChangeLogKeyspace {
+    public:
+        /// \param txn Transaction the DBIs are opened in.
+        /// \param shared_dbi Handle of the shared changelog DBI; may be 0
+        ///        when it does not exist.
+        /// \param layout Layout of the changelog.
+        /// \param dbi_name Name of the shared changelog DBI.
+        ChangeLogKeyspace(MDBX_txn* txn,
+                          MDBX_dbi shared_dbi,
+                          ChangeLogLayout layout,
+                          const std::string& dbi_name = "_mdbxc_changelog")
+            : m_txn(txn), m_shared(shared_dbi), m_layout(layout), m_dbi_name(dbi_name) {}
+
+        /// \brief Largest key \ref seek_key() writes.
+        static std::size_t max_key_size() { return 24; }
+
+        /// \brief Reads the layout recorded in \c _mdbxc_meta of \p txn.
+        /// \throws std::runtime_error on an unknown layout value.
+        static ChangeLogLayout read_layout(MDBX_txn* txn, MDBX_env* env) {
+            MetaStore meta(env);
+            if (!meta.open_existing(txn)) {
+                return ChangeLogLayout::Shared;
+            }
+            const std::uint8_t value = meta.get_changelog_layout(txn);
+            if (value > static_cast<std::uint8_t>(ChangeLogLayout::PerOrigin)) {
+                throw std::runtime_error("ChangeLogStore: unknown changelog layout " +
+                                         std::to_string(value));
+            }
+            return static_cast<ChangeLogLayout>(value);
+        }
+
+        /// \brief Name of the DBI that holds the records of \p origin in the
+        /// per-origin layout.
+        static std::string origin_dbi_name(const std::string& dbi_name, const NodeId& origin) {
+            static const char digits[] = "0123456789abcdef";
+            std::string name = dbi_name;
+            name.reserve(dbi_name.size() + 33);
+            name.push_back('@');
+            for (std::size_t i = 0; i < origin.size(); ++i) {
+                name.push_back(digits[origin[i] >> 4]);
+                name.push_back(digits[origin[i] & 0x0F]);
+            }
+            return name;
+        }
+
+        /// \brief Origins that have a per-origin DBI, in \c NodeId order.
+        /// \details Lists the names in the main DBI; a DBI whose records were
+        /// all pruned is still listed.
+        static std::vector<NodeId> origin_dbi_origins(MDBX_txn* txn, const std::string& dbi_name) {
+            std::vector<NodeId> out;
+            MDBX_dbi main_dbi = 0;
+            check_mdbx(mdbx_dbi_open(txn, nullptr, static_cast<MDBX_db_flags_t>(0), &main_dbi),
+                       "ChangeLogStore: failed to open the main DBI");
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, main_dbi, &raw),
+                       "ChangeLogStore: failed to open a cursor on the main DBI");
+            const std::string prefix = dbi_name + "@";
+            MDBX_val k = { const_cast<char*>(prefix.data()), prefix.size() };
+            MDBX_val v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS) {
+                const char* name = static_cast<const char*>(k.iov_base);
+                if (k.iov_len < prefix.size() ||
+                    std::memcmp(name, prefix.data(), prefix.size()) != 0) {
+                    break;
+                }
+                NodeId origin{};
+                if (parse_hex_origin(name + prefix.size(), k.iov_len - prefix.size(), origin)) {
+                    out.push_back(origin);
+                }
+                rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT);
+            }
+            mdbx_cursor_close(raw);
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "ChangeLogStore: failed to list per-origin DBIs");
+            }
+            return out;
+        }
+
+        ChangeLogLayout layout() const { return m_layout; }
+        MDBX_txn* txn() const { return m_txn; }
+
+        /// \brief DBI that holds the records of \p origin; 0 when none exists.
+        MDBX_dbi dbi_for(const NodeId& origin) const {
+            if (m_layout == ChangeLogLayout::Shared) {
+                return m_shared;
+            }
+            const std::map<NodeId, MDBX_dbi>::const_iterator it = m_origin_dbis.find(origin);
+            if (it != m_origin_dbis.end()) {
+                return it->second;
+            }
+            MDBX_dbi dbi = 0;
+            const int rc = mdbx_dbi_open(m_txn, origin_dbi_name(m_dbi_name, origin).c_str(),
+                                         static_cast<MDBX_db_flags_t>(0), &dbi);
+            if (rc == MDBX_NOTFOUND) {
+                return 0;
+            }
+            check_mdbx(rc, "ChangeLogStore: failed to open a per-origin DBI");
+            m_origin_dbis[origin] = dbi;
+            return dbi;
+        }
+
+        /// \brief Writes the key of (\p origin, \p seq) into \p buf.
+        /// \param buf At least \ref max_key_size() bytes.
+        MDBX_val seek_key(const NodeId& origin, std::uint64_t seq, std::uint8_t* buf) const {
+            return encode_key(m_layout, origin, seq, buf);
+        }
+
+        /// \brief Whether \p key, read from \ref dbi_for(\p origin), belongs to \p origin.
+        /// \throws std::runtime_error on a key of the wrong size.
+        bool key_matches_origin(const MDBX_val& key, const NodeId& origin) const {
+            if (m_layout == ChangeLogLayout::PerOrigin) {
+                check_key_size(key, 8);
+                return true;
+            }
+            check_key_size(key, 24);
+            return std::memcmp(key.iov_base, origin.data(), 16) == 0;
+        }
+
+        /// \brief Returns the \c seq of \p key.
+        /// \throws std::runtime_error on a key of the wrong size.
+        std::uint64_t key_seq(const MDBX_val& key) const {
+            return decode_seq(m_layout, key);
+        }
+
+        /// \brief Origins with at least one retained record, in \c NodeId order.
+        std::vector<NodeId> origins() const {
+            std::vector<NodeId> out;
+            if (m_layout == ChangeLogLayout::PerOrigin) {
+                const std::vector<NodeId> named = origin_dbi_origins(m_txn, m_dbi_name);
+                for (std::size_t i = 0; i < named.size(); ++i) {
+                    const MDBX_dbi dbi = dbi_for(named[i]);
+                    MDBX_stat stat;
+                    if (dbi != 0 &&
+                        mdbx_dbi_stat(m_txn, dbi, &stat, sizeof(stat)) == MDBX_SUCCESS &&
+                        stat.ms_entries != 0) {
+                        out.push_back(named[i]);
+                    }
+                }
+                return out;
+            }
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(m_txn, m_shared, &raw),
+                       "ChangeLogStore origin scan cursor open failed");
+            std::uint8_t key[24];
+            MDBX_val k, v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
+            while (rc == MDBX_SUCCESS) {
+                check_key_size(k, 24);
+                NodeId origin{};
+                std::memcpy(origin.data(), k.iov_base, 16);
+                out.push_back(origin);
+                // Skip the rest of this origin with one seek past its last seq.
+                k = encode_key(ChangeLogLayout::Shared, origin,
+                               ~static_cast<std::uint64_t>(0), key);
+                rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+                if (rc == MDBX_SUCCESS && key_matches_origin(k, origin)) {
+                    rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT);
+                }
+            }
+            mdbx_cursor_close(raw);
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "ChangeLogStore origin scan cursor walk failed");
+            }
+            return out;
+        }
+
+        /// \brief Writes the key of (\p origin, \p seq) in \p layout into \p buf.
+        static MDBX_val encode_key(ChangeLogLayout layout, const NodeId& origin,
+                                   std::uint64_t seq, std::uint8_t* buf) {
+            if (layout == ChangeLogLayout::PerOrigin) {
+                detail::write_u64_be(seq, buf);
+                MDBX_val k = { buf, 8 };
+                return k;
+            }
+            std::memcpy(buf, origin.data(), 16);
+            // Big-endian seq preserves numeric order under MDBX bytewise scans.
+            detail::write_u64_be(seq, buf + 16);
+            MDBX_val k = { buf, 24 };
+            return k;
+        }
+
+        /// \brief Returns the \c seq of a \p layout key.
+        static std::uint64_t decode_seq(ChangeLogLayout layout, const MDBX_val& key) {
+            const std::size_t size = layout == ChangeLogLayout::PerOrigin ? 8 : 24;
+            check_key_size(key, size);
+            return detail::read_u64_be(static_cast<const std::uint8_t*>(key.iov_base) + size - 8);
+        }
+
+    private:
+        static void check_key_size(const MDBX_val& key, std::size_t size) {
+            if (key.iov_len != size) {
+                throw std::runtime_error("ChangeLogStore key has invalid size");
+            }
+        }
+
+        static bool parse_hex_origin(const char* text, std::size_t size, NodeId& out) {
+            if (size != 32) {
+                return false;
+            }
+            for (std::size_t i = 0; i < 32; ++i) {
+                const char c = text[i];
+                int nibble = 0;
+                if (c >= '0' && c <= '9') {
+                    nibble = c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    nibble = c - 'a' + 10;
+                } else {
+                    return false;
+                }
+                out[i / 2] = static_cast<std::uint8_t>(
+                    (i % 2) == 0 ? nibble << 4 : (out[i / 2] | nibble));
+            }
+            return true;
+        }
+
+        MDBX_txn*       m_txn;
+        MDBX_dbi        m_shared;
+        ChangeLogLayout m_layout;
+        std::string     m_dbi_name;
+        mutable std::map<NodeId, MDBX_dbi> m_origin_dbis;
+    };
+
     /// \brief Raw bytestore for replicated \c ChangeBatch records keyed by
     /// \c (origin_node_id, seq).
     /// \details Values are \c ChangeBatchCodec::encode() output, opaque to
     /// this layer. The store makes no assumption about seq monotonicity; the
     /// caller (SyncEngine) is responsible for gap detection and ordering.
+    /// Once \ref rebuild_dbi_index() has created \c _mdbxc_changelog_dbis,
+    /// \c append(), \c erase() and \c prune_up_to() also keep it in step;
+    /// only then does \c append() decode the ops, for their DBI names.
+    /// Records are keyed by the \c ChangeLogLayout recorded in
+    /// \c _mdbxc_meta, read by \ref open().
     class ChangeLogStore {
     public:
         /// \brief Constructs a wrapper bound to \p env.
@@ -35,7 +285,11 @@ namespace sync {
               m_dbi(0),
               m_open(false),
               m_origin_index_ready(false),
-              m_origins(env) {}
+              m_origins(env),
+              m_dbi_index(env),
+              m_dbi_index_txnid(0),
+              m_dbi_index_present(false),
+              m_layout(ChangeLogLayout::Shared) {}
 
         /// \brief Opens the DBI inside the supplied transaction.
         /// \details Tries \c MDBX_CREATE first; falls back to a plain open
@@ -49,19 +303,35 @@ namespace sync {
                                    static_cast<MDBX_db_flags_t>(0), &m_dbi);
             }
             check_mdbx(rc, "Failed to open ChangeLogStore DBI");
+            m_layout = ChangeLogKeyspace::read_layout(txn, m_env);
+            m_origin_dbis.clear();
             m_open = true;
         }
 
         bool is_open() const { return m_open; }
+
+        /// \brief Returns the shared DBI; in the per-origin layout it holds no records.
         MDBX_dbi handle() const { return m_dbi; }
 
+        /// \brief Returns the layout read by \ref open().
+        ChangeLogLayout layout() const { return m_layout; }
+
+        /// \brief Returns the key format and DBIs of the changelog in \p txn.
+        ChangeLogKeyspace keyspace(MDBX_txn* txn) const {
+            ensure_open();
+            return ChangeLogKeyspace(txn, m_dbi, m_layout, m_dbi_name);
+        }
+
         /// \brief Resets the open flag so the next \c open() reopens the DBI
         /// inside the supplied transaction. Use between transactions to avoid
         /// using a stale handle from a prior committed/closed transaction.
         void reset_open() {
             m_open = false;
+            m_origin_dbis.clear();
             m_origin_index_ready = false;
             m_origins.reset_open();
+            m_dbi_index.reset_open();
+            m_dbi_index_txnid = 0;
         }
 
         /// \brief Throws when the DBI has not been opened yet.
@@ -72,34 +342,52 @@ namespace sync {
         }
 
         /// \brief Appends a single batch for \p origin at \p seq.
-        /// \details Uses \c MDBX_NOOVERWRITE so accidental re-use of a
-        /// (origin, seq) key surfaces immediately.
+        /// \details Tries \c MDBX_APPEND first, which succeeds whenever the
+        /// key sorts last in its DBI: always for in-order appends in the
+        /// per-origin layout, and for the newest origin in the shared one.
+        /// Otherwise falls back to \c MDBX_NOOVERWRITE, so accidental re-use
+        /// of a (origin, seq) key surfaces immediately.
         void append(MDBX_txn* txn, const NodeId& origin,
                     std::uint64_t seq, const std::vector<std::uint8_t>& bytes) {
             txn = checked_txn(txn, "ChangeLogStore::append");
             ensure_open();
             ensure_origin_index_ready(txn);
-            std::vector<std::uint8_t> key_buf;
-            encode_key(origin, seq, key_buf);
-            MDBX_val k = { key_buf.empty() ? nullptr : &key_buf[0], key_buf.size() };
+            const MDBX_dbi dbi = origin_dbi(txn, origin, true);
+            std::uint8_t key_buf[24];
+            MDBX_val k = encode_key(origin, seq, key_buf);
             MDBX_val v = { bytes.empty() ? nullptr : const_cast<std::uint8_t*>(&bytes[0]),
                            bytes.size() };
-            check_mdbx(
-                mdbx_put(txn, m_dbi, &k, &v, MDBX_NOOVERWRITE),
-                "ChangeLogStore append failed"
-            );
+            int rc = mdbx_put(txn, dbi, &k, &v, MDBX_APPEND);
+            if (rc == MDBX_EKEYMISMATCH) {
+                rc = mdbx_put(txn, dbi, &k, &v, MDBX_NOOVERWRITE);
+            }
+            check_mdbx(rc, "ChangeLogStore append failed");
             m_origins.note_origin(txn, origin, seq);
+            if (dbi_index_present(txn)) {
+                m_dbi_index.note_batch(txn, origin, seq, batch_dbi_names(bytes));
+            }
+        }
+
+        /// \brief Returns \c OriginIndexStore::mod_txnid() of the origin index.
+        /// \details Opens, and on first use backfills, the index like
+        /// \c append().
+        std::uint64_t origin_index_txnid(MDBX_txn* txn) {
+            txn = checked_txn(txn, "ChangeLogStore::origin_index_txnid");
+            ensure_open();
+            ensure_origin_index_ready(txn);
+            return m_origins.mod_txnid(txn);
         }
 
         /// \brief Returns true when a record exists for (\p origin, \p seq).
         bool contains(MDBX_txn* txn, const NodeId& origin, std::uint64_t seq) const {
             txn = checked_txn(txn, "ChangeLogStore::contains");
             ensure_open();
-            std::vector<std::uint8_t> key_buf;
-            encode_key(origin, seq, key_buf);
-            MDBX_val k = { key_buf.empty() ? nullptr : &key_buf[0], key_buf.size() };
+            const MDBX_dbi dbi = origin_dbi(txn, origin, false);
+            if (dbi == 0) return false;
+            std::uint8_t key_buf[24];
+            MDBX_val k = encode_key(origin, seq, key_buf);
             MDBX_val v;
-            const int rc = mdbx_get(txn, m_dbi, &k, &v);
+            const int rc = mdbx_get(txn, dbi, &k, &v);
             if (rc == MDBX_SUCCESS) return true;
             if (rc == MDBX_NOTFOUND) return false;
             check_mdbx(rc, "ChangeLogStore contains failed");
@@ -112,11 +400,12 @@ namespace sync {
                  std::vector<std::uint8_t>& out) const {
             txn = checked_txn(txn, "ChangeLogStore::get");
             ensure_open();
-            std::vector<std::uint8_t> key_buf;
-            encode_key(origin, seq, key_buf);
-            MDBX_val k = { key_buf.empty() ? nullptr : &key_buf[0], key_buf.size() };
+            const MDBX_dbi dbi = origin_dbi(txn, origin, false);
+            if (dbi == 0) return false;
+            std::uint8_t key_buf[24];
+            MDBX_val k = encode_key(origin, seq, key_buf);
             MDBX_val v;
-            const int rc = mdbx_get(txn, m_dbi, &k, &v);
+            const int rc = mdbx_get(txn, dbi, &k, &v);
             if (rc == MDBX_NOTFOUND) return false;
             check_mdbx(rc, "ChangeLogStore get failed");
             out.resize(v.iov_len);
@@ -126,19 +415,43 @@ namespace sync {
             return true;
         }
 
+        /// \brief Overwrites the bytes of the existing record at (\p origin, \p seq).
+        /// \details Used by compaction; the origin index is unchanged. So is
+        /// \c _mdbxc_changelog_dbis, which may then still list a DBI whose
+        /// ops compaction dropped.
+        /// \return true when replaced, false when absent.
+        bool replace(MDBX_txn* txn, const NodeId& origin, std::uint64_t seq,
+                     const std::vector<std::uint8_t>& bytes) {
+            txn = checked_txn(txn, "ChangeLogStore::replace");
+            ensure_open();
+            const MDBX_dbi dbi = origin_dbi(txn, origin, false);
+            if (dbi == 0) return false;
+            std::uint8_t key_buf[24];
+            MDBX_val k = encode_key(origin, seq, key_buf);
+            MDBX_val v = { bytes.empty() ? nullptr : const_cast<std::uint8_t*>(&bytes[0]),
+                           bytes.size() };
+            const int rc = mdbx_put(txn, dbi, &k, &v, MDBX_CURRENT);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "ChangeLogStore replace failed");
+            return true;
+        }
+
         /// \brief Removes the record at (\p origin, \p seq).
         /// \return true when a record was removed, false when absent.
         bool erase(MDBX_txn* txn, const NodeId& origin, std::uint64_t seq) {
             txn = checked_txn(txn, "ChangeLogStore::erase");
             ensure_open();
-            std::vector<std::uint8_t> key_buf;
-            encode_key(origin, seq, key_buf);
-            MDBX_val k = { key_buf.empty() ? nullptr : &key_buf[0], key_buf.size() };
-            const int rc = mdbx_del(txn, m_dbi, &k, nullptr);
-            if (rc == MDBX_SUCCESS) return true;
+            const MDBX_dbi dbi = origin_dbi(txn, origin, false);
+            if (dbi == 0) return false;
+            std::uint8_t key_buf[24];
+            MDBX_val k = encode_key(origin, seq, key_buf);
+            const int rc = mdbx_del(txn, dbi, &k, nullptr);
             if (rc == MDBX_NOTFOUND) return false;
             check_mdbx(rc, "ChangeLogStore erase failed");
-            return false;
+            if (dbi_index_present(txn)) {
+                m_dbi_index.erase_range(txn, origin, seq, seq);
+            }
+            return true;
         }
 
         /// \brief Removes every record with seq <= \p up_to for \p origin.
@@ -149,21 +462,21 @@ namespace sync {
             if (!m_open) {
                 throw std::logic_error("ChangeLogStore is not open");
             }
+            const MDBX_dbi dbi = origin_dbi(txn, origin, false);
+            if (dbi == 0) return 0;
             MDBX_cursor* raw = nullptr;
-            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw), "cursor open failed");
+            check_mdbx(mdbx_cursor_open(txn, dbi, &raw), "cursor open failed");
             std::size_t removed = 0;
             try {
-                std::vector<std::uint8_t> lo_key, hi_key;
-                encode_key(origin, 0, lo_key);
-                encode_key(origin, up_to, hi_key);
-                MDBX_val lo = { lo_key.empty() ? nullptr : &lo_key[0], lo_key.size() };
-                MDBX_val hi = { hi_key.empty() ? nullptr : &hi_key[0], hi_key.size() };
-                MDBX_val k = lo;
+                std::uint8_t lo_key[24];
+                std::uint8_t hi_key[24];
+                MDBX_val k = encode_key(origin, 0, lo_key);
+                const MDBX_val hi = encode_key(origin, up_to, hi_key);
                 MDBX_val v;
                 int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
                 while (rc == MDBX_SUCCESS) {
-                    if (k.iov_len < 24) break;
-                    if (mdbx_cmp(txn, m_dbi, &k, &hi) > 0) break;
+                    if (k.iov_len != hi.iov_len) break;
+                    if (mdbx_cmp(txn, dbi, &k, &hi) > 0) break;
                     rc = mdbx_cursor_del(raw, MDBX_CURRENT);
                     if (rc == MDBX_SUCCESS) {
                         ++removed;
@@ -182,9 +495,58 @@ namespace sync {
                 throw;
             }
             mdbx_cursor_close(raw);
+            if (removed != 0 && dbi_index_present(txn)) {
+                m_dbi_index.erase_range(txn, origin, 0, up_to);
+            }
             return removed;
         }
 
+        /// \brief Reads the oldest retained record of \p origin.
+        /// \param value Receives the batch bytes, valid until \p txn ends or
+        ///        the store is written.
+        /// \return \c false when \p origin has no record.
+        bool first(MDBX_txn* txn, const NodeId& origin, std::uint64_t& seq,
+                   MDBX_val& value) const {
+            txn = checked_txn(txn, "ChangeLogStore::first");
+            ensure_open();
+            const MDBX_dbi dbi = origin_dbi(txn, origin, false);
+            if (dbi == 0) return false;
+            std::uint8_t key_buf[24];
+            MDBX_val k = encode_key(origin, 0, key_buf);
+            const std::size_t key_size = k.iov_len;
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, dbi, &raw), "cursor open failed");
+            const int rc = mdbx_cursor_get(raw, &k, &value, MDBX_SET_RANGE);
+            mdbx_cursor_close(raw);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "ChangeLogStore first failed");
+            if (k.iov_len != key_size ||
+                (m_layout == ChangeLogLayout::Shared &&
+                 std::memcmp(k.iov_base, origin.data(), 16) != 0)) {
+                return false;
+            }
+            seq = ChangeLogKeyspace::decode_seq(m_layout, k);
+            return true;
+        }
+
+        /// \brief Returns the bytes of the pages the changelog occupies.
+        std::uint64_t stored_bytes(MDBX_txn* txn) const {
+            txn = checked_txn(txn, "ChangeLogStore::stored_bytes");
+            ensure_open();
+            std::uint64_t bytes = dbi_bytes(txn, m_dbi);
+            if (m_layout == ChangeLogLayout::PerOrigin) {
+                const std::vector<NodeId> origins =
+                    ChangeLogKeyspace::origin_dbi_origins(txn, m_dbi_name);
+                for (std::size_t i = 0; i < origins.size(); ++i) {
+                    const MDBX_dbi dbi = origin_dbi(txn, origins[i], false);
+                    if (dbi != 0) {
+                        bytes += dbi_bytes(txn, dbi);
+                    }
+                }
+            }
+            return bytes;
+        }
+
         /// \brief Checks whether \c _mdbxc_origins exactly mirrors changelog tails.
         /// \param txn Active transaction.
         /// \return \c true when every changelog origin has one matching index
@@ -238,6 +600,41 @@ namespace sync {
             return tails.size();
         }
 
+        /// \brief Creates or refills \c _mdbxc_changelog_dbis from the
+        /// retained changelog.
+        /// \details The per-DBI index is optional. It exists only after this
+        /// call, which decodes every retained batch once; from then on the
+        /// writes of this class maintain it, and filtered pulls use it to
+        /// skip batches without subscribed ops unread.
+        /// \param txn Active transaction.
+        /// \return Number of batches indexed.
+        /// \pre Transaction must be writable.
+        /// \complexity O(changelog bytes).
+        /// \note Explicit maintenance operation; ordinary pull does not call it.
+        std::size_t rebuild_dbi_index(MDBX_txn* txn) {
+            txn = checked_txn(txn, "ChangeLogStore::rebuild_dbi_index");
+            ensure_open();
+            m_dbi_index.reset_open();
+            m_dbi_index.open(txn);
+            m_dbi_index.clear(txn);
+            m_dbi_index_txnid = mdbx_txn_id(txn);
+            m_dbi_index_present = true;
+            std::size_t indexed = 0;
+            if (m_layout == ChangeLogLayout::Shared) {
+                indexed += index_dbi_batches(txn, m_dbi, nullptr);
+            } else {
+                const std::vector<NodeId> origins =
+                    ChangeLogKeyspace::origin_dbi_origins(txn, m_dbi_name);
+                for (std::size_t i = 0; i < origins.size(); ++i) {
+                    const MDBX_dbi dbi = origin_dbi(txn, origins[i], false);
+                    if (dbi != 0) {
+                        indexed += index_dbi_batches(txn, dbi, &origins[i]);
+                    }
+                }
+            }
+            return indexed;
+        }
+
     private:
         MDBX_txn* checked_txn(MDBX_txn* txn, const char* context) const {
             return checked_txn_env(txn, m_env, context);
@@ -248,12 +645,9 @@ namespace sync {
             std::uint64_t seq;
         };
 
-        static void encode_key(const NodeId& origin, std::uint64_t seq,
-                               std::vector<std::uint8_t>& out) {
-            out.resize(24);
-            std::memcpy(out.data(), origin.data(), 16);
-            // Big-endian seq preserves numeric order under MDBX bytewise scans.
-            detail::write_u64_be(seq, out.data() + 16);
+        /// \brief Writes the key of (\p origin, \p seq) into \p buf of 24 bytes.
+        MDBX_val encode_key(const NodeId& origin, std::uint64_t seq, std::uint8_t* buf) const {
+            return ChangeLogKeyspace::encode_key(m_layout, origin, seq, buf);
         }
 
         static NodeId decode_key_origin(const MDBX_val& key) {
@@ -265,16 +659,93 @@ namespace sync {
             return origin;
         }
 
-        static std::uint64_t decode_key_seq(const MDBX_val& key) {
-            if (key.iov_len != 24) {
-                throw std::runtime_error("ChangeLogStore key has invalid size");
+        /// \brief DBI holding the records of \p origin; 0 when absent and not \p create.
+        MDBX_dbi origin_dbi(MDBX_txn* txn, const NodeId& origin, bool create) const {
+            if (m_layout == ChangeLogLayout::Shared) {
+                return m_dbi;
+            }
+            const std::map<NodeId, MDBX_dbi>::const_iterator it = m_origin_dbis.find(origin);
+            if (it != m_origin_dbis.end()) {
+                return it->second;
+            }
+            const std::string name = ChangeLogKeyspace::origin_dbi_name(m_dbi_name, origin);
+            MDBX_dbi dbi = 0;
+            int rc = mdbx_dbi_open(txn, name.c_str(),
+                                   create ? MDBX_CREATE : static_cast<MDBX_db_flags_t>(0),
+                                   &dbi);
+            if (rc == MDBX_EACCESS && create) {
+                rc = mdbx_dbi_open(txn, name.c_str(), static_cast<MDBX_db_flags_t>(0), &dbi);
+            }
+            if (rc == MDBX_NOTFOUND && !create) {
+                return 0;
+            }
+            check_mdbx(rc, "Failed to open ChangeLogStore per-origin DBI");
+            m_origin_dbis[origin] = dbi;
+            return dbi;
+        }
+
+        static std::uint64_t dbi_bytes(MDBX_txn* txn, MDBX_dbi dbi) {
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, dbi, &stat, sizeof(stat)),
+                       "ChangeLogStore stat failed");
+            return (stat.ms_branch_pages + stat.ms_leaf_pages + stat.ms_overflow_pages) *
+                   static_cast<std::uint64_t>(stat.ms_psize);
+        }
+
+        /// \brief Notes every batch of \p dbi in \c _mdbxc_changelog_dbis.
+        /// \param origin Origin of every record of a per-origin DBI; null
+        ///        for the shared DBI, whose keys name it.
+        std::size_t index_dbi_batches(MDBX_txn* txn, MDBX_dbi dbi, const NodeId* origin) {
+            std::size_t indexed = 0;
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, dbi, &raw),
+                       "ChangeLogStore dbi index cursor open failed");
+            try {
+                MDBX_val k, v;
+                int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
+                while (rc == MDBX_SUCCESS) {
+                    m_dbi_index.note_batch(
+                        txn, origin != nullptr ? *origin : decode_key_origin(k),
+                        ChangeLogKeyspace::decode_seq(m_layout, k),
+                        batch_dbi_names(static_cast<const std::uint8_t*>(v.iov_base),
+                                        v.iov_len));
+                    ++indexed;
+                    rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT);
+                }
+                if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "ChangeLogStore dbi index cursor walk failed");
+                }
+            } catch (...) {
+                mdbx_cursor_close(raw);
+                throw;
             }
-            const std::uint8_t* bytes = static_cast<const std::uint8_t*>(key.iov_base);
-            return detail::read_u64_be(bytes + 16);
+            mdbx_cursor_close(raw);
+            return indexed;
         }
 
         std::vector<OriginTail> collect_changelog_origin_tails(MDBX_txn* txn) const {
             std::vector<OriginTail> out;
+            if (m_layout == ChangeLogLayout::PerOrigin) {
+                const std::vector<NodeId> origins =
+                    ChangeLogKeyspace::origin_dbi_origins(txn, m_dbi_name);
+                for (std::size_t i = 0; i < origins.size(); ++i) {
+                    const MDBX_dbi dbi = origin_dbi(txn, origins[i], false);
+                    if (dbi == 0) continue;
+                    MDBX_cursor* last = nullptr;
+                    check_mdbx(mdbx_cursor_open(txn, dbi, &last),
+                               "ChangeLogStore origin scan cursor open failed");
+                    MDBX_val k, v;
+                    const int rc = mdbx_cursor_get(last, &k, &v, MDBX_LAST);
+                    mdbx_cursor_close(last);
+                    if (rc == MDBX_NOTFOUND) continue;
+                    check_mdbx(rc, "ChangeLogStore origin scan cursor walk failed");
+                    OriginTail tail;
+                    tail.origin = origins[i];
+                    tail.seq = ChangeLogKeyspace::decode_seq(m_layout, k);
+                    out.push_back(tail);
+                }
+                return out;
+            }
             MDBX_cursor* raw = nullptr;
             check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw),
                        "ChangeLogStore origin scan cursor open failed");
@@ -283,7 +754,7 @@ namespace sync {
                 int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
                 while (rc == MDBX_SUCCESS) {
                     const NodeId origin = decode_key_origin(k);
-                    const std::uint64_t seq = decode_key_seq(k);
+                    const std::uint64_t seq = ChangeLogKeyspace::decode_seq(m_layout, k);
                     if (out.empty() ||
                         compare_node_id(out.back().origin, origin) != 0) {
                         OriginTail tail;
@@ -332,12 +803,55 @@ namespace sync {
             write_origin_tails(txn, tails);
         }
 
+        /// \brief Whether \c _mdbxc_changelog_dbis exists in \p txn.
+        /// \details Probed once per transaction, so an index created by
+        /// another store instance is picked up by the next write.
+        bool dbi_index_present(MDBX_txn* txn) {
+            const std::uint64_t txnid = mdbx_txn_id(txn);
+            if (m_dbi_index_txnid != txnid || txnid == 0) {
+                m_dbi_index.reset_open();
+                m_dbi_index_present = m_dbi_index.open_existing(txn);
+                m_dbi_index_txnid = txnid;
+            }
+            return m_dbi_index_present;
+        }
+
+        /// \brief Sorted, distinct DBI names of the ops of an encoded batch.
+        static std::vector<std::string> batch_dbi_names(const std::uint8_t* data,
+                                                        std::size_t size) {
+            const ChangeBatchView view(data, size);
+            ChangeBatchCodec::Reader reader = view.ops();
+            std::vector<std::string> names;
+            ChangeOpView op;
+            while (reader.next(op)) {
+                if (names.empty() ||
+                    names.back().compare(0, std::string::npos, op.dbi_name,
+                                         op.dbi_name_len) != 0) {
+                    names.push_back(op.dbi_name_len != 0
+                                        ? std::string(op.dbi_name, op.dbi_name_len)
+                                        : std::string());
+                }
+            }
+            std::sort(names.begin(), names.end());
+            names.erase(std::unique(names.begin(), names.end()), names.end());
+            return names;
+        }
+
+        static std::vector<std::string> batch_dbi_names(const std::vector<std::uint8_t>& bytes) {
+            return batch_dbi_names(bytes.empty() ? nullptr : &bytes[0], bytes.size());
+        }
+
         MDBX_env*     m_env;
         std::string   m_dbi_name;
         MDBX_dbi      m_dbi;
         bool          m_open;
         bool          m_origin_index_ready;
         OriginIndexStore m_origins;
+        ChangeLogDbiIndexStore m_dbi_index;
+        std::uint64_t m_dbi_index_txnid;  ///< Transaction \c m_dbi_index_present was probed in.
+        bool          m_dbi_index_present;
+        ChangeLogLayout m_layout;
+        mutable std::map<NodeId, MDBX_dbi> m_origin_dbis; ///< Per-origin DBIs opened so far.
     };
 
 } // namespace sync
@@ -30,6 +30,15 @@ namespace sync {
         std::uint32_t flags = 0;
     };
 
+    /// \brief One pending identity-index change for
+    /// \ref IdentityIndexStore::write_batch().
+    struct IdentityIndexUpdate {
+        std::string dbi_name;
+        std::vector<std::uint8_t> identity_key;
+        IdentityIndexValue value;
+        bool erase = false; ///< Remove the record instead of writing \c value.
+    };
+
     /// \brief Thin wrapper around \c _mdbxc_identity_index.
     /// \details Key = \c u32 dbi_name_len_le || dbi_name_bytes || identity_key_bytes.
     /// The length prefix is mandatory: without it, \c ("ab","c") and
@@ -127,6 +136,64 @@ namespace sync {
             return false;
         }
 
+        /// \brief Writes every update of one apply transaction in key order.
+        /// \details Updates are sorted by encoded key and, for a key listed
+        /// more than once, only the last one in \p updates is written; the
+        /// earlier ones are superseded. The sorted updates go through a single
+        /// cursor, so neighbouring keys reuse the pages the previous write
+        /// touched instead of one independent B-tree descent per op.
+        /// \return Number of records written or removed.
+        std::size_t write_batch(MDBX_txn* txn,
+                                const std::vector<IdentityIndexUpdate>& updates) {
+            txn = checked_txn(txn, "IdentityIndexStore::write_batch");
+            ensure_open();
+            if (updates.empty()) return 0;
+            std::vector<std::vector<std::uint8_t> > keys(updates.size());
+            std::vector<std::size_t> order(updates.size());
+            for (std::size_t i = 0; i < updates.size(); ++i) {
+                encode_key(updates[i].dbi_name, updates[i].identity_key, keys[i]);
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [&keys](std::size_t a, std::size_t b) {
+                                 return keys[a] < keys[b];
+                             });
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw),
+                       "IdentityIndexStore cursor open failed");
+            std::size_t written = 0;
+            try {
+                std::vector<std::uint8_t> val_buf;
+                for (std::size_t i = 0; i < order.size(); ++i) {
+                    if (i + 1 < order.size() && keys[order[i]] == keys[order[i + 1]]) {
+                        continue;
+                    }
+                    std::vector<std::uint8_t>& key_buf = keys[order[i]];
+                    const IdentityIndexUpdate& update = updates[order[i]];
+                    MDBX_val k = { key_buf.empty() ? nullptr : &key_buf[0], key_buf.size() };
+                    if (update.erase) {
+                        MDBX_val v;
+                        const int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_KEY);
+                        if (rc == MDBX_NOTFOUND) continue;
+                        check_mdbx(rc, "IdentityIndexStore erase failed");
+                        check_mdbx(mdbx_cursor_del(raw, MDBX_CURRENT),
+                                   "IdentityIndexStore erase failed");
+                    } else {
+                        encode_value(update.value, val_buf);
+                        MDBX_val v = { val_buf.empty() ? nullptr : &val_buf[0], val_buf.size() };
+                        check_mdbx(mdbx_cursor_put(raw, &k, &v, MDBX_UPSERT),
+                                   "IdentityIndexStore put failed");
+                    }
+                    ++written;
+                }
+            } catch (...) {
+                mdbx_cursor_close(raw);
+                throw;
+            }
+            mdbx_cursor_close(raw);
+            return written;
+        }
+
     private:
         MDBX_txn* checked_txn(MDBX_txn* txn, const char* context) const {
             return checked_txn_env(txn, m_env, context);
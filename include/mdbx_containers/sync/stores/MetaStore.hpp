@@ -4,7 +4,8 @@
 
 /// \file MetaStore.hpp
 /// \brief Persistent metadata for the sync subsystem: db identity, local node
-/// identity, schema version, monotonic local seq, creation timestamp.
+/// identity, schema version, monotonic local seq, creation timestamp,
+/// changelog layout.
 
 #include <cstdint>
 #include <cstring>
@@ -51,6 +52,19 @@ namespace sync {
             m_open = true;
         }
 
+        /// \brief Opens the DBI only when it already exists.
+        /// \return \c false when the environment has no metadata yet.
+        bool open_existing(MDBX_txn* txn) {
+            txn = checked_txn(txn, "MetaStore::open_existing");
+            if (m_open) return true;
+            const int rc = mdbx_dbi_open(txn, m_dbi_name.c_str(),
+                                         static_cast<MDBX_db_flags_t>(0), &m_dbi);
+            if (rc == MDBX_NOTFOUND) return false;
+            check_mdbx(rc, "Failed to open existing MetaStore DBI");
+            m_open = true;
+            return true;
+        }
+
         /// \brief Throws when the DBI has not been opened yet.
         void ensure_open() const {
             if (!m_open) {
@@ -145,12 +159,51 @@ namespace sync {
             write_fixed(txn, key_created_at_ms(), buf, 8);
         }
 
+        /// \brief Reads the source of an unfinished full snapshot import.
+        /// \return \c false when no import is in progress.
+        bool get_snapshot_import(MDBX_txn* txn, NodeId& source) const {
+            return read_fixed(txn, key_snapshot_import(),
+                              reinterpret_cast<std::uint8_t*>(source.data()), 16) == 16;
+        }
+
+        /// \brief Records that a full snapshot import from \p source started.
+        void set_snapshot_import(MDBX_txn* txn, const NodeId& source) {
+            write_fixed(txn, key_snapshot_import(),
+                        reinterpret_cast<const std::uint8_t*>(source.data()), 16);
+        }
+
+        /// \brief Clears the unfinished snapshot import marker.
+        void clear_snapshot_import(MDBX_txn* txn) {
+            txn = checked_txn(txn, "MetaStore::clear_snapshot_import");
+            ensure_open();
+            std::uint8_t key = key_snapshot_import();
+            MDBX_val k = { &key, 1 };
+            const int rc = mdbx_del(txn, m_dbi, &k, nullptr);
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "MetaStore delete failed");
+            }
+        }
+
+        /// \brief Reads the \c ChangeLogLayout value. Returns 0 (shared) when unset.
+        std::uint8_t get_changelog_layout(MDBX_txn* txn) const {
+            std::uint8_t value = 0;
+            read_fixed(txn, key_changelog_layout(), &value, 1);
+            return value;
+        }
+
+        /// \brief Writes the \c ChangeLogLayout value.
+        void set_changelog_layout(MDBX_txn* txn, std::uint8_t value) {
+            write_fixed(txn, key_changelog_layout(), &value, 1);
+        }
+
     private:
         static std::uint8_t key_db_uuid()       { return 0x01; }
         static std::uint8_t key_node_id()      { return 0x02; }
         static std::uint8_t key_schema_version(){ return 0x03; }
         static std::uint8_t key_local_seq()    { return 0x04; }
         static std::uint8_t key_created_at_ms() { return 0x05; }
+        static std::uint8_t key_snapshot_import() { return 0x06; }
+        static std::uint8_t key_changelog_layout() { return 0x07; }
 
         std::size_t read_fixed(MDBX_txn* txn, std::uint8_t key,
                                std::uint8_t* dst, std::size_t n) const {
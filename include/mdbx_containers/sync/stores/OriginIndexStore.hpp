@@ -156,6 +156,18 @@ namespace sync {
             return true;
         }
 
+        /// \brief Returns the id of the last transaction that modified the index.
+        /// \details Equal values mean identical contents, so in-memory copies
+        /// such as \c OriginTailCache are keyed by it.
+        std::uint64_t mod_txnid(MDBX_txn* txn) const {
+            txn = checked_txn(txn, "OriginIndexStore::mod_txnid");
+            ensure_open();
+            MDBX_stat stat;
+            check_mdbx(mdbx_dbi_stat(txn, m_dbi, &stat, sizeof(stat)),
+                       "OriginIndexStore mod_txnid failed");
+            return stat.ms_mod_txnid;
+        }
+
         /// \brief Returns all indexed origins with their tails in DB key order.
         std::vector<OriginTail> origin_tails(MDBX_txn* txn) const {
             txn = checked_txn(txn, "OriginIndexStore::origin_tails");
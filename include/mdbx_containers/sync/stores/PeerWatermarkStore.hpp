@@ -0,0 +1,171 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_STORES_PEER_WATERMARK_STORE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_STORES_PEER_WATERMARK_STORE_HPP_INCLUDED
+
+/// \file PeerWatermarkStore.hpp
+/// \brief Changelog positions peers reported having, used by retention.
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mdbx.h>
+
+#include "../../detail/utils.hpp"
+#include "../common.hpp"
+#include "../SyncCursor.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Records, per peer, the last \c seq it has of each origin.
+    /// \details Key = peer \c NodeId (16 raw) followed by origin \c NodeId
+    /// (16 raw), so a peer's rows are adjacent. Value = 8 bytes LE \c seq
+    /// then 8 bytes LE Unix milliseconds of the report.
+    class PeerWatermarkStore {
+    public:
+        /// \brief Everything known about one peer.
+        struct PeerWatermark {
+            NodeId peer{};
+            SyncCursor have;                ///< Last \c seq the peer has, per origin.
+            std::uint64_t seen_unix_ms = 0; ///< Latest report of any origin.
+        };
+
+        PeerWatermarkStore(MDBX_env* env,
+                           const std::string& dbi_name = "_mdbxc_peers")
+            : m_env(env), m_dbi_name(dbi_name), m_dbi(0), m_open(false) {}
+
+        /// \brief Opens the DBI inside the supplied transaction.
+        /// \details Tries \c MDBX_CREATE first; falls back to a plain open
+        /// when the transaction is read-only and the DBI already exists.
+        void open(MDBX_txn* txn) {
+            txn = checked_txn(txn, "PeerWatermarkStore::open");
+            if (m_open) return;
+            int rc = mdbx_dbi_open(txn, m_dbi_name.c_str(), MDBX_CREATE, &m_dbi);
+            if (rc == MDBX_EACCESS) {
+                rc = mdbx_dbi_open(txn, m_dbi_name.c_str(),
+                                   static_cast<MDBX_db_flags_t>(0), &m_dbi);
+            }
+            check_mdbx(rc, "Failed to open PeerWatermarkStore DBI");
+            m_open = true;
+        }
+
+        bool is_open() const { return m_open; }
+        MDBX_dbi handle() const { return m_dbi; }
+
+        /// \brief Throws when the DBI has not been opened yet.
+        void ensure_open() const {
+            if (!m_open) {
+                throw std::logic_error("PeerWatermarkStore is not open");
+            }
+        }
+
+        /// \brief Stores \p have as what \p peer has, reported at \p seen_unix_ms.
+        /// \details Each origin of \p have replaces its previous row, even
+        /// with a lower \c seq, since a restored peer really has less.
+        /// Origins missing from \p have keep their rows.
+        void record(MDBX_txn* txn, const NodeId& peer, const SyncCursor& have,
+                    std::uint64_t seen_unix_ms) {
+            txn = checked_txn(txn, "PeerWatermarkStore::record");
+            ensure_open();
+            std::uint8_t key[32];
+            std::uint8_t value[16];
+            std::memcpy(key, peer.data(), 16);
+            detail::write_u64_le(seen_unix_ms, value + 8);
+            for (OriginSeqMap::const_iterator it =
+                     have.last_seq_by_origin.begin();
+                 it != have.last_seq_by_origin.end(); ++it) {
+                std::memcpy(key + 16, it->first.data(), 16);
+                detail::write_u64_le(it->second, value);
+                MDBX_val k = { key, sizeof(key) };
+                MDBX_val v = { value, sizeof(value) };
+                check_mdbx(mdbx_put(txn, m_dbi, &k, &v, MDBX_UPSERT),
+                           "PeerWatermarkStore write failed");
+            }
+        }
+
+        /// \brief Removes every row of \p peer.
+        /// \return Number of rows removed.
+        std::size_t forget(MDBX_txn* txn, const NodeId& peer) {
+            txn = checked_txn(txn, "PeerWatermarkStore::forget");
+            ensure_open();
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw), "cursor open failed");
+            std::size_t removed = 0;
+            try {
+                MDBX_val k = { const_cast<std::uint8_t*>(peer.data()), 16 };
+                MDBX_val v;
+                int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+                while (rc == MDBX_SUCCESS && k.iov_len == 32 &&
+                       std::memcmp(k.iov_base, peer.data(), 16) == 0) {
+                    check_mdbx(mdbx_cursor_del(raw, MDBX_CURRENT),
+                               "PeerWatermarkStore delete failed");
+                    ++removed;
+                    rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT);
+                }
+                if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "PeerWatermarkStore cursor_get failed");
+                }
+            } catch (...) {
+                mdbx_cursor_close(raw);
+                throw;
+            }
+            mdbx_cursor_close(raw);
+            return removed;
+        }
+
+        /// \brief Returns every recorded peer in DB key order.
+        std::vector<PeerWatermark> peers(MDBX_txn* txn) const {
+            txn = checked_txn(txn, "PeerWatermarkStore::peers");
+            ensure_open();
+            std::vector<PeerWatermark> out;
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw), "cursor open failed");
+            try {
+                MDBX_val k, v;
+                int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
+                for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT)) {
+                    if (k.iov_len != 32 || v.iov_len != 16) continue;
+                    const std::uint8_t* key = static_cast<const std::uint8_t*>(k.iov_base);
+                    const std::uint8_t* value = static_cast<const std::uint8_t*>(v.iov_base);
+                    if (out.empty() || std::memcmp(out.back().peer.data(), key, 16) != 0) {
+                        out.push_back(PeerWatermark());
+                        std::memcpy(out.back().peer.data(), key, 16);
+                    }
+                    NodeId origin{};
+                    std::memcpy(origin.data(), key + 16, 16);
+                    out.back().have.last_seq_by_origin[origin] = detail::read_u64_le(value);
+                    const std::uint64_t seen = detail::read_u64_le(value + 8);
+                    if (seen > out.back().seen_unix_ms) {
+                        out.back().seen_unix_ms = seen;
+                    }
+                }
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "PeerWatermarkStore cursor_get failed");
+                }
+            } catch (...) {
+                mdbx_cursor_close(raw);
+                throw;
+            }
+            mdbx_cursor_close(raw);
+            return out;
+        }
+
+    private:
+        MDBX_txn* checked_txn(MDBX_txn* txn, const char* context) const {
+            return checked_txn_env(txn, m_env, context);
+        }
+
+        MDBX_env*     m_env;
+        std::string   m_dbi_name;
+        MDBX_dbi      m_dbi;
+        bool          m_open;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_STORES_PEER_WATERMARK_STORE_HPP_INCLUDED
@@ -0,0 +1,162 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_STORES_PUSH_STAGING_STORE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_STORES_PUSH_STAGING_STORE_HPP_INCLUDED
+
+/// \file PushStagingStore.hpp
+/// \brief Received pushes spilled to disk until the writer applies them.
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mdbx.h>
+
+#include "../../detail/utils.hpp"
+#include "../common.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief FIFO of encoded push requests waiting to be applied.
+    /// \details Key = 8 bytes BE staging sequence, so cursor order is arrival
+    /// order. Value = the \c TransportMessageCodec push request bytes.
+    class PushStagingStore {
+    public:
+        /// \brief Entry count, value bytes and largest sequence of the store.
+        struct Totals {
+            std::uint64_t count = 0;
+            std::uint64_t bytes = 0;
+            std::uint64_t last_seq = 0;
+        };
+
+        PushStagingStore(MDBX_env* env,
+                         const std::string& dbi_name = "_mdbxc_push_staging")
+            : m_env(env), m_dbi_name(dbi_name), m_dbi(0), m_open(false) {}
+
+        /// \brief Opens the DBI, creating it, inside a write \p txn.
+        void open(MDBX_txn* txn) {
+            txn = checked_txn(txn, "PushStagingStore::open");
+            if (m_open) return;
+            check_mdbx(mdbx_dbi_open(txn, m_dbi_name.c_str(), MDBX_CREATE, &m_dbi),
+                       "Failed to open PushStagingStore DBI");
+            m_open = true;
+        }
+
+        /// \brief Opens the DBI when it exists.
+        /// \return \c false when nothing was ever staged.
+        bool open_existing(MDBX_txn* txn) {
+            txn = checked_txn(txn, "PushStagingStore::open_existing");
+            if (m_open) return true;
+            const int rc = mdbx_dbi_open(txn, m_dbi_name.c_str(),
+                                         static_cast<MDBX_db_flags_t>(0), &m_dbi);
+            if (rc == MDBX_NOTFOUND) {
+                return false;
+            }
+            check_mdbx(rc, "Failed to open PushStagingStore DBI");
+            m_open = true;
+            return true;
+        }
+
+        bool is_open() const { return m_open; }
+        MDBX_dbi handle() const { return m_dbi; }
+
+        /// \brief Throws when the DBI has not been opened yet.
+        void ensure_open() const {
+            if (!m_open) {
+                throw std::logic_error("PushStagingStore is not open");
+            }
+        }
+
+        /// \brief Stores \p message under \p seq.
+        void put(MDBX_txn* txn, std::uint64_t seq, const std::vector<std::uint8_t>& message) {
+            txn = checked_txn(txn, "PushStagingStore::put");
+            ensure_open();
+            std::uint8_t key[8];
+            detail::write_u64_be(seq, key);
+            MDBX_val k = { key, sizeof(key) };
+            MDBX_val v = { const_cast<std::uint8_t*>(message.data()), message.size() };
+            check_mdbx(mdbx_put(txn, m_dbi, &k, &v, MDBX_NOOVERWRITE),
+                       "PushStagingStore write failed");
+        }
+
+        /// \brief Reads the oldest entry.
+        /// \return \c false when the store is empty.
+        bool front(MDBX_txn* txn, std::uint64_t& seq, std::vector<std::uint8_t>& message) const {
+            txn = checked_txn(txn, "PushStagingStore::front");
+            ensure_open();
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw), "cursor open failed");
+            MDBX_val k, v;
+            const int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
+            mdbx_cursor_close(raw);
+            if (rc == MDBX_NOTFOUND) {
+                return false;
+            }
+            check_mdbx(rc, "PushStagingStore cursor_get failed");
+            if (k.iov_len != 8) {
+                throw std::runtime_error("PushStagingStore: malformed key");
+            }
+            seq = detail::read_u64_be(static_cast<const std::uint8_t*>(k.iov_base));
+            const std::uint8_t* data = static_cast<const std::uint8_t*>(v.iov_base);
+            message.assign(data, data + v.iov_len);
+            return true;
+        }
+
+        /// \brief Removes the entry \p seq.
+        /// \return Removed value bytes, or zero when it was absent.
+        std::uint64_t erase(MDBX_txn* txn, std::uint64_t seq) {
+            txn = checked_txn(txn, "PushStagingStore::erase");
+            ensure_open();
+            std::uint8_t key[8];
+            detail::write_u64_be(seq, key);
+            MDBX_val k = { key, sizeof(key) };
+            MDBX_val v;
+            int rc = mdbx_get(txn, m_dbi, &k, &v);
+            if (rc == MDBX_NOTFOUND) {
+                return 0;
+            }
+            check_mdbx(rc, "PushStagingStore read failed");
+            const std::uint64_t bytes = v.iov_len;
+            check_mdbx(mdbx_del(txn, m_dbi, &k, nullptr), "PushStagingStore delete failed");
+            return bytes;
+        }
+
+        /// \brief Walks the store once to count entries and bytes.
+        Totals totals(MDBX_txn* txn) const {
+            txn = checked_txn(txn, "PushStagingStore::totals");
+            ensure_open();
+            Totals out;
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw), "cursor open failed");
+            MDBX_val k, v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT)) {
+                ++out.count;
+                out.bytes += v.iov_len;
+                if (k.iov_len == 8) {
+                    out.last_seq = detail::read_u64_be(static_cast<const std::uint8_t*>(k.iov_base));
+                }
+            }
+            mdbx_cursor_close(raw);
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "PushStagingStore cursor_get failed");
+            }
+            return out;
+        }
+
+    private:
+        MDBX_txn* checked_txn(MDBX_txn* txn, const char* context) const {
+            return checked_txn_env(txn, m_env, context);
+        }
+
+        MDBX_env*     m_env;
+        std::string   m_dbi_name;
+        MDBX_dbi      m_dbi;
+        bool          m_open;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_STORES_PUSH_STAGING_STORE_HPP_INCLUDED
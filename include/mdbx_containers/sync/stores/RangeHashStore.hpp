@@ -0,0 +1,835 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_STORES_RANGE_HASH_STORE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_STORES_RANGE_HASH_STORE_HPP_INCLUDED
+
+/// \file RangeHashStore.hpp
+/// \brief Per-table range hashes (a Merkle summary) used to compare
+///        replicas without reading whole tables.
+/// \details
+/// A table is cut into leaves by its own content: a key whose XXH3 hash has
+/// its low \c leaf_bits bits clear starts a leaf, which holds the records
+/// from that key up to the next such key in table order. Records before the
+/// first start key form the head leaf. Identical tables therefore have
+/// identical leaves, and a write only moves the leaves around its key.
+///
+/// Each leaf falls into one of 2^16 buckets by the high bits of the hash of
+/// its start key. Buckets are the deepest level of a tree with fan-out 16:
+/// a node stores the record count and the wrapping sum of the digests of
+/// the leaves below it, so a leaf change is added to its five ancestors
+/// without reading their siblings.
+///
+/// Keys of \c _mdbxc_range_hash, all prefixed by the table name and a NUL:
+/// \code
+///   'C'                                   -> u8 format, u8 leaf_bits
+///   'N' depth u8, index u32 be            -> count u64 le, hash u64 le
+///   'L' bucket u16 be, id u64 be          -> count u64 le, hash u64 le,
+///                                            u8 head, start key bytes
+/// \endcode
+/// The leaf id is a seeded hash of the start key, so start keys of any
+/// length fit the store's key size limit.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <mdbx.h>
+
+#include "../../Hash.hpp"
+#include "../../detail/utils.hpp"
+#include "../ChangeBatchCodec.hpp"
+#include "../common.hpp"
+#include "../protocol.hpp"
+
+namespace mdbxc {
+namespace sync {
+
+    /// \brief Maintains and reads the range hashes of enabled tables.
+    class RangeHashStore {
+    public:
+        /// \brief Keys of one table touched by a write transaction.
+        struct TouchedTable {
+            bool cleared = false; ///< A \c ClearTable op ran; the table is rebuilt.
+            std::vector<std::vector<std::uint8_t> > keys;
+        };
+
+        /// \brief Touched keys by table name.
+        typedef std::map<std::string, TouchedTable> TouchedTables;
+
+        RangeHashStore(MDBX_env* env,
+                       const std::string& dbi_name = "_mdbxc_range_hash")
+            : m_env(env), m_dbi_name(dbi_name), m_dbi(0), m_open(false) {}
+
+        /// \brief Opens the DBI, creating it, inside \p txn.
+        void open(MDBX_txn* txn) {
+            txn = checked_txn(txn, "RangeHashStore::open");
+            if (m_open) return;
+            check_mdbx(mdbx_dbi_open(txn, m_dbi_name.c_str(), MDBX_CREATE, &m_dbi),
+                       "Failed to open RangeHashStore DBI");
+            m_open = true;
+        }
+
+        /// \brief Opens the DBI when it exists.
+        /// \return \c false when no table was ever enabled.
+        bool open_existing(MDBX_txn* txn) {
+            txn = checked_txn(txn, "RangeHashStore::open_existing");
+            if (m_open) return true;
+            const int rc = mdbx_dbi_open(txn, m_dbi_name.c_str(),
+                                         static_cast<MDBX_db_flags_t>(0), &m_dbi);
+            if (rc == MDBX_NOTFOUND) {
+                return false;
+            }
+            check_mdbx(rc, "Failed to open RangeHashStore DBI");
+            m_open = true;
+            return true;
+        }
+
+        bool is_open() const { return m_open; }
+        void reset_open() { m_open = false; }
+        MDBX_dbi handle() const { return m_dbi; }
+
+        /// \brief Throws when the DBI has not been opened yet.
+        void ensure_open() const {
+            if (!m_open) {
+                throw std::logic_error("RangeHashStore is not open");
+            }
+        }
+
+        /// \brief Leaf size used when none is given: 64 records on average.
+        static unsigned default_leaf_bits() { return 6; }
+
+        /// \brief Largest accepted \c leaf_bits.
+        static unsigned max_leaf_bits() { return 16; }
+
+        /// \brief Number of hash buckets as a power of two.
+        static unsigned bucket_bits() { return 16; }
+
+        /// \brief Children of a tree node as a power of two.
+        static unsigned fanout_bits() { return 4; }
+
+        /// \brief Depth of the bucket level; the root is at depth 0.
+        static std::uint8_t bucket_depth() {
+            return static_cast<std::uint8_t>(bucket_bits() / fanout_bits());
+        }
+
+        /// \brief Reads the \c leaf_bits of \p table.
+        /// \return \c false when \p table keeps no range hashes.
+        bool leaf_bits(MDBX_txn* txn, const std::string& table, unsigned& out) const {
+            txn = checked_txn(txn, "RangeHashStore::leaf_bits");
+            ensure_open();
+            std::vector<std::uint8_t> key = prefix(table, 'C');
+            MDBX_val k = make_val(key);
+            MDBX_val v;
+            const int rc = mdbx_get(txn, m_dbi, &k, &v);
+            if (rc == MDBX_NOTFOUND) {
+                return false;
+            }
+            check_mdbx(rc, "RangeHashStore read failed");
+            if (v.iov_len != 2) {
+                throw std::runtime_error("RangeHashStore: malformed config of '" + table + "'");
+            }
+            out = static_cast<const std::uint8_t*>(v.iov_base)[1];
+            return true;
+        }
+
+        /// \brief Starts keeping range hashes for \p table and builds them.
+        /// \details Replaces any earlier hashes of \p table. Reads the whole
+        /// table once.
+        /// \throws std::invalid_argument for a reserved name or bad
+        ///         \p leaf_bits, std::runtime_error when \p table does not exist.
+        void enable(MDBX_txn* txn, const std::string& table, unsigned leaf_bits) {
+            txn = checked_txn(txn, "RangeHashStore::enable");
+            ensure_open();
+            if (table.empty() || is_reserved_dbi_name(table)) {
+                throw std::invalid_argument(
+                    "RangeHashStore: range hashes need a user table, got '" + table + "'");
+            }
+            if (leaf_bits == 0 || leaf_bits > max_leaf_bits()) {
+                throw std::invalid_argument("RangeHashStore: leaf_bits must be 1..16");
+            }
+            MDBX_dbi data = 0;
+            if (!open_table(txn, table, data)) {
+                throw std::runtime_error("RangeHashStore: table '" + table + "' does not exist");
+            }
+            std::vector<std::uint8_t> key = prefix(table, 'C');
+            std::uint8_t config[2] = { 1, static_cast<std::uint8_t>(leaf_bits) };
+            MDBX_val k = make_val(key);
+            MDBX_val v = { config, sizeof(config) };
+            check_mdbx(mdbx_put(txn, m_dbi, &k, &v, MDBX_UPSERT),
+                       "RangeHashStore write failed");
+            build(txn, table, data, leaf_bits);
+        }
+
+        /// \brief Drops the range hashes of \p table.
+        /// \return \c false when \p table kept none.
+        bool disable(MDBX_txn* txn, const std::string& table) {
+            txn = checked_txn(txn, "RangeHashStore::disable");
+            ensure_open();
+            std::vector<std::uint8_t> key = prefix(table, 'C');
+            MDBX_val k = make_val(key);
+            const int rc = mdbx_del(txn, m_dbi, &k, nullptr);
+            if (rc == MDBX_NOTFOUND) {
+                return false;
+            }
+            check_mdbx(rc, "RangeHashStore delete failed");
+            erase_prefix(txn, prefix(table, 'N'));
+            erase_prefix(txn, prefix(table, 'L'));
+            return true;
+        }
+
+        /// \brief Adds the key of \p op to \p out.
+        static void collect(const ChangeOpView& op, TouchedTables& out) {
+            TouchedTable& table = out[std::string(op.dbi_name, op.dbi_name_len)];
+            if (op.op_type == ChangeOpType::ClearTable) {
+                table.cleared = true;
+                return;
+            }
+            if (!table.cleared) {
+                table.keys.push_back(std::vector<std::uint8_t>(
+                    op.storage_key, op.storage_key + op.storage_key_len));
+            }
+        }
+
+        /// \brief Adds the keys of \p ops to \p out.
+        static void collect(const std::vector<ChangeOpView>& ops, TouchedTables& out) {
+            for (std::size_t i = 0; i < ops.size(); ++i) {
+                collect(ops[i], out);
+            }
+        }
+
+        /// \brief Refreshes the tables written by the encoded, uncompressed
+        /// batch at \p data.
+        void refresh_batch(MDBX_txn* txn, const std::uint8_t* data, std::size_t size) {
+            ChangeBatchCodec::Reader reader(data, size);
+            TouchedTables touched;
+            ChangeOpView op;
+            while (reader.next(op)) {
+                collect(op, touched);
+            }
+            refresh(txn, touched);
+        }
+
+        /// \brief Brings the hashes of every enabled table in \p touched up
+        /// to date with the writes already made in \p txn.
+        /// \details Rebuilds a cleared table; otherwise recomputes only the
+        /// leaves around each key, reading about two leaves per key.
+        void refresh(MDBX_txn* txn, const TouchedTables& touched) {
+            txn = checked_txn(txn, "RangeHashStore::refresh");
+            ensure_open();
+            for (TouchedTables::const_iterator it = touched.begin(); it != touched.end(); ++it) {
+                unsigned bits = 0;
+                MDBX_dbi data = 0;
+                if (!leaf_bits(txn, it->first, bits) || !open_table(txn, it->first, data)) {
+                    continue;
+                }
+                if (it->second.cleared) {
+                    build(txn, it->first, data, bits);
+                } else {
+                    refresh_keys(txn, it->first, data, bits, it->second.keys);
+                }
+            }
+        }
+
+        /// \brief Reads the nodes at \p depth listed in \p indexes.
+        void nodes(MDBX_txn* txn, const std::string& table, std::uint8_t depth,
+                   const std::vector<std::uint32_t>& indexes,
+                   std::vector<RangeHashNode>& out) const {
+            txn = checked_txn(txn, "RangeHashStore::nodes");
+            ensure_open();
+            if (depth > bucket_depth()) {
+                throw std::invalid_argument("RangeHashStore: node depth out of range");
+            }
+            const std::uint32_t width = 1u << (fanout_bits() * depth);
+            for (std::size_t i = 0; i < indexes.size(); ++i) {
+                if (indexes[i] >= width) {
+                    throw std::invalid_argument("RangeHashStore: node index out of range");
+                }
+                RangeHashNode node;
+                node.depth = depth;
+                node.index = indexes[i];
+                read_node(txn, table, depth, indexes[i], node.count, node.hash);
+                out.push_back(node);
+            }
+        }
+
+        /// \brief Reads the leaves of the buckets listed in \p buckets.
+        void leaves(MDBX_txn* txn, const std::string& table,
+                    const std::vector<std::uint32_t>& buckets,
+                    std::vector<RangeHashLeaf>& out) const {
+            txn = checked_txn(txn, "RangeHashStore::leaves");
+            ensure_open();
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw), "cursor open failed");
+            Cursor cursor(raw);
+            for (std::size_t i = 0; i < buckets.size(); ++i) {
+                if (buckets[i] >> bucket_bits()) {
+                    throw std::invalid_argument("RangeHashStore: bucket out of range");
+                }
+                std::vector<std::uint8_t> start = prefix(table, 'L');
+                append_u16_be(start, static_cast<std::uint16_t>(buckets[i]));
+                MDBX_val k = make_val(start);
+                MDBX_val v;
+                int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+                for (; rc == MDBX_SUCCESS &&
+                       k.iov_len == start.size() + 8 &&
+                       std::memcmp(k.iov_base, &start[0], start.size()) == 0;
+                     rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT)) {
+                    RangeHashLeaf leaf;
+                    leaf.bucket = buckets[i];
+                    read_leaf_value(v, leaf);
+                    out.push_back(std::move(leaf));
+                }
+                if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "RangeHashStore cursor_get failed");
+                }
+            }
+        }
+
+        /// \brief Copies the records of \p table in <tt>[lo, hi)</tt> into
+        /// \p out, within the page limits of \p request.
+        /// \details Needs no range hashes. A key's values are never split;
+        /// when the page fills, \c has_more is set and \c resume_key names
+        /// the first key left out.
+        static void records(MDBX_txn* txn, MDBX_dbi data,
+                            const RangeHashRequest& request,
+                            RangeHashResponse& out) {
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, data, &raw), "cursor open failed");
+            Cursor cursor(raw);
+            MDBX_val k = make_val(request.lo);
+            MDBX_val v;
+            int rc = request.from_head
+                ? mdbx_cursor_get(raw, &k, &v, MDBX_FIRST)
+                : mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+            const MDBX_val hi = make_val(request.hi);
+            std::uint64_t bytes = 0;
+            std::vector<std::uint8_t> last;
+            bool first = true;
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT)) {
+                const bool new_key = first || !same_bytes(k, last);
+                if (new_key) {
+                    if (request.has_hi && mdbx_cmp(txn, data, &k, &hi) >= 0) {
+                        break;
+                    }
+                    if (!first && (out.records.size() >= request.max_records ||
+                                   bytes >= request.max_bytes)) {
+                        out.has_more = true;
+                        out.resume_key = to_bytes(k);
+                        break;
+                    }
+                    last = to_bytes(k);
+                    first = false;
+                }
+                RangeHashRecord record;
+                record.key = last;
+                record.value = to_bytes(v);
+                bytes += record.key.size() + record.value.size();
+                out.records.push_back(std::move(record));
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "RangeHashStore: records cursor_get failed");
+            }
+        }
+
+        /// \brief Finds the first leaf start key after \p key in \p data.
+        /// \param from_head Search from the start of the table instead.
+        /// \return \c false when no leaf starts after \p key.
+        static bool next_leaf_start(MDBX_txn* txn, MDBX_dbi data, unsigned leaf_bits,
+                                    bool from_head, const std::vector<std::uint8_t>& key,
+                                    std::vector<std::uint8_t>& out) {
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, data, &raw), "cursor open failed");
+            Cursor cursor(raw);
+            MDBX_val k = make_val(key);
+            MDBX_val v;
+            int rc = from_head ? mdbx_cursor_get(raw, &k, &v, MDBX_FIRST)
+                               : mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+            const MDBX_val after = make_val(key);
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT_NODUP)) {
+                if (!from_head && mdbx_cmp(txn, data, &k, &after) <= 0) {
+                    continue;
+                }
+                if (is_leaf_start(k, leaf_bits)) {
+                    out = to_bytes(k);
+                    return true;
+                }
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "RangeHashStore: leaf scan failed");
+            }
+            return false;
+        }
+
+        /// \brief Opens the existing table \p table with its own flags.
+        /// \return \c false when it does not exist.
+        static bool open_table(MDBX_txn* txn, const std::string& table, MDBX_dbi& out) {
+            const int rc = mdbx_dbi_open(txn, table.c_str(), MDBX_DB_ACCEDE, &out);
+            if (rc == MDBX_NOTFOUND) {
+                return false;
+            }
+            check_mdbx(rc, "RangeHashStore: failed to open table '" + table + "'");
+            return true;
+        }
+
+        /// \brief Whether \p key starts a leaf.
+        static bool is_leaf_start(const MDBX_val& key, unsigned leaf_bits) {
+            return (key_hash(key) & ((std::uint64_t(1) << leaf_bits) - 1)) == 0;
+        }
+
+    private:
+        /// \brief Closes a cursor on scope exit.
+        struct Cursor {
+            explicit Cursor(MDBX_cursor* cursor) : raw(cursor) {}
+            ~Cursor() { if (raw) mdbx_cursor_close(raw); }
+            Cursor(const Cursor&) = delete;
+            Cursor& operator=(const Cursor&) = delete;
+            MDBX_cursor* raw;
+        };
+
+        /// \brief Start of a leaf: the head leaf or a start key.
+        struct LeafStart {
+            bool head = true;
+            std::vector<std::uint8_t> key;
+        };
+
+        /// \brief Where a recomputed leaf ended.
+        struct LeafEnd {
+            bool at_end = true;              ///< The leaf runs to the end of the table.
+            std::vector<std::uint8_t> key;   ///< Otherwise the next leaf start.
+        };
+
+        static std::uint64_t key_hash(const MDBX_val& key) {
+            return static_cast<std::uint64_t>(XXH3_64bits(key.iov_base, key.iov_len));
+        }
+
+        static std::uint32_t bucket_of(const LeafStart& start) {
+            if (start.head) {
+                return 0;
+            }
+            return static_cast<std::uint32_t>(key_hash(make_val(start.key)) >>
+                                              (64 - bucket_bits()));
+        }
+
+        static std::uint64_t leaf_id(const LeafStart& start) {
+            if (start.head) {
+                return 0;
+            }
+            return static_cast<std::uint64_t>(XXH3_64bits_withSeed(
+                start.key.empty() ? nullptr : &start.key[0], start.key.size(), 0x5EEDu));
+        }
+
+        /// \brief Digest a leaf adds to its tree nodes.
+        static std::uint64_t leaf_digest(const LeafStart& start,
+                                         std::uint64_t count, std::uint64_t hash) {
+            if (count == 0) {
+                return 0;
+            }
+            std::uint8_t head[17];
+            detail::write_u64_le(count, head);
+            detail::write_u64_le(hash, head + 8);
+            head[16] = start.head ? 1 : 0;
+            const std::uint64_t seed = static_cast<std::uint64_t>(XXH3_64bits(head, sizeof(head)));
+            return static_cast<std::uint64_t>(XXH3_64bits_withSeed(
+                start.key.empty() ? nullptr : &start.key[0], start.key.size(), seed));
+        }
+
+        /// \brief Folds one record into a leaf hash.
+        static std::uint64_t hash_record(std::uint64_t hash, const MDBX_val& key,
+                                         const MDBX_val& value) {
+            hash = static_cast<std::uint64_t>(XXH3_64bits_withSeed(key.iov_base, key.iov_len, hash));
+            return static_cast<std::uint64_t>(XXH3_64bits_withSeed(
+                value.iov_base, value.iov_len, hash ^ UINT64_C(0x9E3779B97F4A7C15)));
+        }
+
+        static MDBX_val make_val(const std::vector<std::uint8_t>& bytes) {
+            MDBX_val v = { bytes.empty() ? nullptr : const_cast<std::uint8_t*>(&bytes[0]),
+                           bytes.size() };
+            return v;
+        }
+
+        static std::vector<std::uint8_t> to_bytes(const MDBX_val& v) {
+            const std::uint8_t* p = static_cast<const std::uint8_t*>(v.iov_base);
+            return v.iov_len == 0 ? std::vector<std::uint8_t>()
+                                  : std::vector<std::uint8_t>(p, p + v.iov_len);
+        }
+
+        static bool same_bytes(const MDBX_val& v, const std::vector<std::uint8_t>& bytes) {
+            return v.iov_len == bytes.size() &&
+                   (bytes.empty() || std::memcmp(v.iov_base, &bytes[0], bytes.size()) == 0);
+        }
+
+        static std::vector<std::uint8_t> prefix(const std::string& table, char kind) {
+            std::vector<std::uint8_t> out(table.begin(), table.end());
+            out.push_back(0);
+            out.push_back(static_cast<std::uint8_t>(kind));
+            return out;
+        }
+
+        static void append_u16_be(std::vector<std::uint8_t>& out, std::uint16_t value) {
+            out.push_back(static_cast<std::uint8_t>(value >> 8));
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        static void append_u32_be(std::vector<std::uint8_t>& out, std::uint32_t value) {
+            for (int i = 3; i >= 0; --i) {
+                out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        std::vector<std::uint8_t> node_key(const std::string& table, std::uint8_t depth,
+                                           std::uint32_t index) const {
+            std::vector<std::uint8_t> key = prefix(table, 'N');
+            key.push_back(depth);
+            append_u32_be(key, index);
+            return key;
+        }
+
+        std::vector<std::uint8_t> leaf_key(const std::string& table,
+                                           const LeafStart& start) const {
+            std::vector<std::uint8_t> key = prefix(table, 'L');
+            append_u16_be(key, static_cast<std::uint16_t>(bucket_of(start)));
+            std::uint8_t id[8];
+            detail::write_u64_be(leaf_id(start), id);
+            key.insert(key.end(), id, id + 8);
+            return key;
+        }
+
+        static void read_leaf_value(const MDBX_val& v, RangeHashLeaf& leaf) {
+            if (v.iov_len < 17) {
+                throw std::runtime_error("RangeHashStore: malformed leaf");
+            }
+            const std::uint8_t* p = static_cast<const std::uint8_t*>(v.iov_base);
+            leaf.count = detail::read_u64_le(p);
+            leaf.hash = detail::read_u64_le(p + 8);
+            leaf.head = p[16] != 0;
+            leaf.start_key.assign(p + 17, p + v.iov_len);
+        }
+
+        void read_node(MDBX_txn* txn, const std::string& table, std::uint8_t depth,
+                       std::uint32_t index, std::uint64_t& count, std::uint64_t& hash) const {
+            std::vector<std::uint8_t> key = node_key(table, depth, index);
+            MDBX_val k = make_val(key);
+            MDBX_val v;
+            const int rc = mdbx_get(txn, m_dbi, &k, &v);
+            count = 0;
+            hash = 0;
+            if (rc == MDBX_NOTFOUND) {
+                return;
+            }
+            check_mdbx(rc, "RangeHashStore read failed");
+            if (v.iov_len != 16) {
+                throw std::runtime_error("RangeHashStore: malformed node");
+            }
+            const std::uint8_t* p = static_cast<const std::uint8_t*>(v.iov_base);
+            count = detail::read_u64_le(p);
+            hash = detail::read_u64_le(p + 8);
+        }
+
+        void write_node(MDBX_txn* txn, const std::string& table, std::uint8_t depth,
+                        std::uint32_t index, std::uint64_t count, std::uint64_t hash) {
+            std::vector<std::uint8_t> key = node_key(table, depth, index);
+            MDBX_val k = make_val(key);
+            if (count == 0 && hash == 0) {
+                const int rc = mdbx_del(txn, m_dbi, &k, nullptr);
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "RangeHashStore delete failed");
+                }
+                return;
+            }
+            std::uint8_t value[16];
+            detail::write_u64_le(count, value);
+            detail::write_u64_le(hash, value + 8);
+            MDBX_val v = { value, sizeof(value) };
+            check_mdbx(mdbx_put(txn, m_dbi, &k, &v, MDBX_UPSERT),
+                       "RangeHashStore write failed");
+        }
+
+        /// \brief Replaces the summary of the leaf at \p start and moves its
+        /// tree nodes by the difference.
+        void store_leaf(MDBX_txn* txn, const std::string& table, const LeafStart& start,
+                        std::uint64_t count, std::uint64_t hash) {
+            std::vector<std::uint8_t> key = leaf_key(table, start);
+            MDBX_val k = make_val(key);
+            MDBX_val v;
+            std::uint64_t old_count = 0;
+            std::uint64_t old_hash = 0;
+            int rc = mdbx_get(txn, m_dbi, &k, &v);
+            if (rc == MDBX_SUCCESS) {
+                RangeHashLeaf old;
+                read_leaf_value(v, old);
+                old_count = old.count;
+                old_hash = old.hash;
+            } else if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "RangeHashStore read failed");
+            }
+            if (old_count == count && old_hash == hash) {
+                return;
+            }
+            if (count == 0) {
+                rc = mdbx_del(txn, m_dbi, &k, nullptr);
+                if (rc != MDBX_NOTFOUND) {
+                    check_mdbx(rc, "RangeHashStore delete failed");
+                }
+            } else {
+                std::vector<std::uint8_t> value(16);
+                detail::write_u64_le(count, &value[0]);
+                detail::write_u64_le(hash, &value[8]);
+                value.push_back(start.head ? 1 : 0);
+                value.insert(value.end(), start.key.begin(), start.key.end());
+                MDBX_val nv = make_val(value);
+                check_mdbx(mdbx_put(txn, m_dbi, &k, &nv, MDBX_UPSERT),
+                           "RangeHashStore write failed");
+            }
+            const std::uint64_t digest_delta =
+                leaf_digest(start, count, hash) - leaf_digest(start, old_count, old_hash);
+            const std::uint32_t bucket = bucket_of(start);
+            for (unsigned depth = 0; depth <= bucket_depth(); ++depth) {
+                const std::uint32_t index =
+                    bucket >> (fanout_bits() * (bucket_depth() - depth));
+                std::uint64_t node_count = 0;
+                std::uint64_t node_hash = 0;
+                read_node(txn, table, static_cast<std::uint8_t>(depth), index,
+                          node_count, node_hash);
+                write_node(txn, table, static_cast<std::uint8_t>(depth), index,
+                           node_count + count - old_count, node_hash + digest_delta);
+            }
+        }
+
+        /// \brief Drops the leaf a deleted or demoted \p key may have started.
+        void drop_leaf(MDBX_txn* txn, const std::string& table,
+                       const std::vector<std::uint8_t>& key, unsigned leaf_bits) {
+            if (!is_leaf_start(make_val(key), leaf_bits)) {
+                return;
+            }
+            LeafStart start;
+            start.head = false;
+            start.key = key;
+            store_leaf(txn, table, start, 0, 0);
+        }
+
+        /// \brief Finds the start of the leaf holding the last key before \p key.
+        static LeafStart leaf_before(MDBX_txn* txn, MDBX_cursor* raw,
+                                     const std::vector<std::uint8_t>& key,
+                                     unsigned leaf_bits) {
+            (void)txn;
+            MDBX_val k = make_val(key);
+            MDBX_val v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+            rc = rc == MDBX_NOTFOUND ? mdbx_cursor_get(raw, &k, &v, MDBX_LAST)
+                                     : mdbx_cursor_get(raw, &k, &v, MDBX_PREV_NODUP);
+            LeafStart out;
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_PREV_NODUP)) {
+                if (is_leaf_start(k, leaf_bits)) {
+                    out.head = false;
+                    out.key = to_bytes(k);
+                    return out;
+                }
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "RangeHashStore: leaf scan failed");
+            }
+            return out;
+        }
+
+        /// \brief Hashes the leaf at \p start and stores its summary.
+        LeafEnd hash_leaf(MDBX_txn* txn, const std::string& table, MDBX_cursor* raw,
+                          const LeafStart& start, unsigned leaf_bits) {
+            MDBX_val k = make_val(start.key);
+            MDBX_val v;
+            int rc = start.head ? mdbx_cursor_get(raw, &k, &v, MDBX_FIRST)
+                                : mdbx_cursor_get(raw, &k, &v, MDBX_SET_KEY);
+            std::uint64_t count = 0;
+            std::uint64_t hash = 0;
+            LeafEnd end;
+            std::vector<std::uint8_t> last;
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT)) {
+                if (count == 0 || !same_bytes(k, last)) {
+                    if ((count != 0 || start.head) && is_leaf_start(k, leaf_bits)) {
+                        end.at_end = false;
+                        end.key = to_bytes(k);
+                        break;
+                    }
+                    last = to_bytes(k);
+                }
+                hash = hash_record(hash, k, v);
+                ++count;
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "RangeHashStore: leaf scan failed");
+            }
+            store_leaf(txn, table, start, count, hash);
+            return end;
+        }
+
+        void refresh_keys(MDBX_txn* txn, const std::string& table, MDBX_dbi data,
+                          unsigned leaf_bits,
+                          const std::vector<std::vector<std::uint8_t> >& touched) {
+            std::vector<const std::vector<std::uint8_t>*> keys;
+            keys.reserve(touched.size());
+            for (std::size_t i = 0; i < touched.size(); ++i) {
+                keys.push_back(&touched[i]);
+            }
+            std::sort(keys.begin(), keys.end(),
+                      [txn, data](const std::vector<std::uint8_t>* a,
+                                  const std::vector<std::uint8_t>* b) {
+                          const MDBX_val ka = make_val(*a);
+                          const MDBX_val kb = make_val(*b);
+                          return mdbx_cmp(txn, data, &ka, &kb) < 0;
+                      });
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, data, &raw), "cursor open failed");
+            Cursor cursor(raw);
+            // End of the last recomputed leaf; sorted keys before it are covered.
+            bool covered = false;
+            LeafEnd covered_end;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                const std::vector<std::uint8_t>& key = *keys[i];
+                if (i != 0 && *keys[i - 1] == key) {
+                    continue;
+                }
+                const MDBX_val k = make_val(key);
+                if (covered) {
+                    const MDBX_val end = make_val(covered_end.key);
+                    if (covered_end.at_end || mdbx_cmp(txn, data, &k, &end) < 0) {
+                        // Inside a fresh leaf, so no longer a leaf start.
+                        drop_leaf(txn, table, key, leaf_bits);
+                        continue;
+                    }
+                }
+                const LeafStart before = leaf_before(txn, raw, key, leaf_bits);
+                covered_end = hash_leaf(txn, table, raw, before, leaf_bits);
+                covered = true;
+                if (!covered_end.at_end && covered_end.key == key) {
+                    LeafStart own;
+                    own.head = false;
+                    own.key = key;
+                    covered_end = hash_leaf(txn, table, raw, own, leaf_bits);
+                } else {
+                    drop_leaf(txn, table, key, leaf_bits);
+                }
+            }
+        }
+
+        /// \brief Recomputes every leaf and node of \p table from its records.
+        void build(MDBX_txn* txn, const std::string& table, MDBX_dbi data,
+                   unsigned leaf_bits) {
+            erase_prefix(txn, prefix(table, 'N'));
+            erase_prefix(txn, prefix(table, 'L'));
+            std::vector<std::uint64_t> counts(std::size_t(1) << bucket_bits(), 0);
+            std::vector<std::uint64_t> hashes(counts.size(), 0);
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, data, &raw), "cursor open failed");
+            Cursor cursor(raw);
+            LeafStart start;
+            std::uint64_t count = 0;
+            std::uint64_t hash = 0;
+            std::vector<std::uint8_t> last;
+            bool first = true;
+            MDBX_val k;
+            MDBX_val v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_FIRST);
+            for (; rc == MDBX_SUCCESS; rc = mdbx_cursor_get(raw, &k, &v, MDBX_NEXT)) {
+                if (first || !same_bytes(k, last)) {
+                    last = to_bytes(k);
+                    first = false;
+                    if (is_leaf_start(k, leaf_bits)) {
+                        put_built_leaf(txn, table, start, count, hash, counts, hashes);
+                        start.head = false;
+                        start.key = last;
+                        count = 0;
+                        hash = 0;
+                    }
+                }
+                hash = hash_record(hash, k, v);
+                ++count;
+            }
+            if (rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "RangeHashStore: table scan failed");
+            }
+            put_built_leaf(txn, table, start, count, hash, counts, hashes);
+            for (int depth = bucket_depth(); depth >= 0; --depth) {
+                const std::size_t width = std::size_t(1) << (fanout_bits() * depth);
+                for (std::size_t index = 0; index < width; ++index) {
+                    if (counts[index] != 0 || hashes[index] != 0) {
+                        write_node(txn, table, static_cast<std::uint8_t>(depth),
+                                   static_cast<std::uint32_t>(index),
+                                   counts[index], hashes[index]);
+                    }
+                }
+                if (depth == 0) {
+                    break;
+                }
+                // Fold the level into its parents, which reuse the front.
+                const std::size_t fanout = std::size_t(1) << fanout_bits();
+                for (std::size_t index = 0; index < width / fanout; ++index) {
+                    std::uint64_t c = 0;
+                    std::uint64_t h = 0;
+                    for (std::size_t j = 0; j < fanout; ++j) {
+                        c += counts[index * fanout + j];
+                        h += hashes[index * fanout + j];
+                    }
+                    counts[index] = c;
+                    hashes[index] = h;
+                }
+            }
+        }
+
+        void put_built_leaf(MDBX_txn* txn, const std::string& table, const LeafStart& start,
+                            std::uint64_t count, std::uint64_t hash,
+                            std::vector<std::uint64_t>& counts,
+                            std::vector<std::uint64_t>& hashes) {
+            if (count == 0) {
+                return;
+            }
+            std::vector<std::uint8_t> key = leaf_key(table, start);
+            std::vector<std::uint8_t> value(16);
+            detail::write_u64_le(count, &value[0]);
+            detail::write_u64_le(hash, &value[8]);
+            value.push_back(start.head ? 1 : 0);
+            value.insert(value.end(), start.key.begin(), start.key.end());
+            MDBX_val k = make_val(key);
+            MDBX_val v = make_val(value);
+            check_mdbx(mdbx_put(txn, m_dbi, &k, &v, MDBX_UPSERT),
+                       "RangeHashStore write failed");
+            const std::uint32_t bucket = bucket_of(start);
+            counts[bucket] += count;
+            hashes[bucket] += leaf_digest(start, count, hash);
+        }
+
+        void erase_prefix(MDBX_txn* txn, const std::vector<std::uint8_t>& start) {
+            MDBX_cursor* raw = nullptr;
+            check_mdbx(mdbx_cursor_open(txn, m_dbi, &raw), "cursor open failed");
+            Cursor cursor(raw);
+            MDBX_val k = make_val(start);
+            MDBX_val v;
+            int rc = mdbx_cursor_get(raw, &k, &v, MDBX_SET_RANGE);
+            while (rc == MDBX_SUCCESS && k.iov_len >= start.size() &&
+                   std::memcmp(k.iov_base, &start[0], start.size()) == 0) {
+                check_mdbx(mdbx_cursor_del(raw, MDBX_CURRENT),
+                           "RangeHashStore delete failed");
+                rc = mdbx_cursor_get(raw, &k, &v, MDBX_GET_CURRENT);
+            }
+            if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+                check_mdbx(rc, "RangeHashStore cursor_get failed");
+            }
+        }
+
+        MDBX_txn* checked_txn(MDBX_txn* txn, const char* context) const {
+            return checked_txn_env(txn, m_env, context);
+        }
+
+        MDBX_env*     m_env;
+        std::string   m_dbi_name;
+        MDBX_dbi      m_dbi;
+        bool          m_open;
+    };
+
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_STORES_RANGE_HASH_STORE_HPP_INCLUDED
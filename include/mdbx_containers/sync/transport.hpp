@@ -15,6 +15,7 @@
 #if MDBXC_SYNC_ENABLED
 #include <mdbx_containers/sync/HttpTransport.hpp>
 #include <mdbx_containers/sync/WebSocketTransport.hpp>
+#include <mdbx_containers/sync/SharedMemoryTransport.hpp>
 #include <mdbx_containers/sync/TransportMiddleware.hpp>
 #endif
 
@@ -0,0 +1,10 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_TRANSPORTS_CURL_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_TRANSPORTS_CURL_HPP_INCLUDED
+
+/// \file sync/transports/curl.hpp
+/// \brief Aggregate header for optional libcurl sync transport bindings.
+
+#include <mdbx_containers/sync/transports/curl/HttpTransport.hpp>
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_TRANSPORTS_CURL_HPP_INCLUDED
@@ -0,0 +1,600 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_SYNC_TRANSPORTS_CURL_HTTP_TRANSPORT_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_SYNC_TRANSPORTS_CURL_HTTP_TRANSPORT_HPP_INCLUDED
+
+/// \file sync/transports/curl/HttpTransport.hpp
+/// \brief Optional libcurl multi client binding for HTTP sync transport.
+/// \details
+/// This header is not included by mdbx_containers/sync.hpp. Include it only in
+/// translation units that intentionally use libcurl directly as the concrete
+/// HTTP client backend. Unlike the Kurlyk binding it drives one
+/// \c CURLM handle per base URL, so requests of several clients can share one
+/// HTTP/2 connection as separate streams.
+
+#if !defined(MDBXC_HAS_CURL_HTTP_TRANSPORT) || \
+        !MDBXC_HAS_CURL_HTTP_TRANSPORT
+#error "libcurl HTTP transport requires MDBXC_HAS_CURL_HTTP_TRANSPORT=1"
+#endif
+
+#include <curl/curl.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mdbx_containers/sync/sync_module.hpp>
+#include <mdbx_containers/sync/HttpTransport.hpp>
+
+#if !MDBXC_SYNC_ENABLED
+#error "mdbx_containers/sync/transports/curl/HttpTransport.hpp requires MDBXC_SYNC_ENABLED=1"
+#endif
+
+namespace mdbxc {
+namespace sync {
+namespace curl {
+
+    /// \brief HTTP version requested by \c HttpSyncClient.
+    enum class HttpVersion : std::uint8_t {
+        /// \brief HTTP/1.1 only; concurrent requests use separate connections.
+        Http1_1,
+        /// \brief HTTP/2 negotiated through TLS ALPN, HTTP/1.1 otherwise.
+        /// \details Plain \c http:// URLs stay on HTTP/1.1.
+        Http2Tls,
+        /// \brief HTTP/2 without upgrade (h2c), also over plain \c http://.
+        /// \details The server must speak HTTP/2 on that port.
+        Http2PriorKnowledge
+    };
+
+    namespace detail {
+        inline std::vector<std::uint8_t> string_to_bytes(
+                const std::string& text) {
+            return std::vector<std::uint8_t>(text.begin(), text.end());
+        }
+
+        inline long to_curl_http_version(HttpVersion version) {
+            switch (version) {
+            case HttpVersion::Http1_1:
+                return CURL_HTTP_VERSION_1_1;
+            case HttpVersion::Http2PriorKnowledge:
+                return CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE;
+            case HttpVersion::Http2Tls:
+            default:
+                return CURL_HTTP_VERSION_2TLS;
+            }
+        }
+
+        /// \brief Calls \c curl_global_init() once per process.
+        inline void ensure_curl_global_init() {
+            struct Init {
+                Init() {
+                    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+                        throw std::runtime_error("curl_global_init failed");
+                    }
+                }
+            };
+            static Init init;
+            (void)init;
+        }
+
+        /// \brief One POST submitted to a \c CurlMultiplexer.
+        /// \details Owns the easy handle and every buffer libcurl reads or
+        /// writes, so a cancelled caller may return before the multiplexer
+        /// thread has detached the handle.
+        class CurlTransfer {
+        public:
+            CurlTransfer()
+                : m_easy(curl_easy_init()),
+                  m_header_list(nullptr) {
+                if (!m_easy) {
+                    throw std::runtime_error("curl_easy_init failed");
+                }
+            }
+
+            ~CurlTransfer() {
+                curl_easy_cleanup(m_easy);
+                if (m_header_list) {
+                    curl_slist_free_all(m_header_list);
+                }
+            }
+
+            CurlTransfer(const CurlTransfer&) = delete;
+            CurlTransfer& operator=(const CurlTransfer&) = delete;
+
+            CURL* easy() const { return m_easy; }
+
+            /// \brief Response bodies above \p limit abort the transfer.
+            std::size_t body_limit = 0;
+            std::vector<std::uint8_t> request_body;
+            std::vector<std::uint8_t> response_body;
+            std::vector<HttpSyncHeader> response_headers;
+            bool body_too_large = false;
+
+            void add_request_header(const std::string& line) {
+                curl_slist* list = curl_slist_append(m_header_list, line.c_str());
+                if (!list) {
+                    throw std::bad_alloc();
+                }
+                m_header_list = list;
+            }
+
+            curl_slist* request_headers() const { return m_header_list; }
+
+            /// \brief Marks the transfer finished; called by the multiplexer.
+            void finish(CURLcode result) {
+                long status = 0;
+                if (result == CURLE_OK) {
+                    curl_easy_getinfo(m_easy, CURLINFO_RESPONSE_CODE, &status);
+                }
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_result = result;
+                m_status = status;
+                m_done = true;
+                m_done_cv.notify_all();
+            }
+
+            /// \brief Waits up to \p timeout for \ref finish().
+            bool wait_for(std::chrono::milliseconds timeout) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                return m_done_cv.wait_for(lock, timeout, [this]() { return m_done; });
+            }
+
+            CURLcode result() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_result;
+            }
+
+            long status() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_status;
+            }
+
+            static size_t write_body(char* data, size_t size, size_t count, void* user) {
+                CurlTransfer* self = static_cast<CurlTransfer*>(user);
+                const std::size_t n = size * count;
+                if (self->response_body.size() + n > self->body_limit) {
+                    self->body_too_large = true;
+                    return 0; // Makes libcurl fail the transfer with CURLE_WRITE_ERROR.
+                }
+                self->response_body.insert(self->response_body.end(),
+                                           reinterpret_cast<const std::uint8_t*>(data),
+                                           reinterpret_cast<const std::uint8_t*>(data) + n);
+                return n;
+            }
+
+            static size_t write_header(char* data, size_t size, size_t count, void* user) {
+                CurlTransfer* self = static_cast<CurlTransfer*>(user);
+                const std::size_t n = size * count;
+                std::string line(data, n);
+                while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) {
+                    line.pop_back();
+                }
+                if (line.compare(0, 5, "HTTP/") == 0) {
+                    // A new status line: headers of an interim response are dropped.
+                    self->response_headers.clear();
+                    return n;
+                }
+                const std::string::size_type colon = line.find(':');
+                if (colon == std::string::npos) {
+                    return n;
+                }
+                std::string::size_type value = colon + 1;
+                while (value < line.size() && (line[value] == ' ' || line[value] == '\t')) {
+                    ++value;
+                }
+                http_add_header(self->response_headers,
+                                line.substr(0, colon),
+                                line.substr(value));
+                return n;
+            }
+
+        private:
+            CURL*                   m_easy;
+            curl_slist*             m_header_list;
+            mutable std::mutex      m_mutex;
+            std::condition_variable m_done_cv;
+            bool                    m_done = false;
+            CURLcode                m_result = CURLE_OK;
+            long                    m_status = 0;
+        };
+
+        /// \brief Runs one \c CURLM handle on its own thread.
+        /// \details The multi handle multiplexes transfers to the same host
+        /// onto one HTTP/2 connection (\c CURLPIPE_MULTIPLEX); transfers
+        /// added with \c CURLOPT_PIPEWAIT wait for that connection instead
+        /// of opening another. Aborting a transfer only resets its stream.
+        class CurlMultiplexer {
+        public:
+            CurlMultiplexer()
+                : m_multi(nullptr),
+                  m_stop(false),
+                  m_new_connections(0) {
+                ensure_curl_global_init();
+                m_multi = curl_multi_init();
+                if (!m_multi) {
+                    throw std::runtime_error("curl_multi_init failed");
+                }
+                curl_multi_setopt(m_multi, CURLMOPT_PIPELINING,
+                                  static_cast<long>(CURLPIPE_MULTIPLEX));
+                try {
+                    m_thread = std::thread([this]() { run(); });
+                } catch (...) {
+                    curl_multi_cleanup(m_multi);
+                    throw;
+                }
+            }
+
+            ~CurlMultiplexer() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+                curl_multi_wakeup(m_multi);
+                m_thread.join();
+                curl_multi_cleanup(m_multi);
+            }
+
+            CurlMultiplexer(const CurlMultiplexer&) = delete;
+            CurlMultiplexer& operator=(const CurlMultiplexer&) = delete;
+
+            /// \brief Hands \p transfer to the multiplexer thread.
+            void submit(const std::shared_ptr<CurlTransfer>& transfer) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_incoming.push_back(transfer);
+                }
+                curl_multi_wakeup(m_multi);
+            }
+
+            /// \brief Asks the multiplexer thread to drop \p transfer.
+            /// \details The transfer finishes with \c CURLE_ABORTED_BY_CALLBACK
+            /// unless it completed first.
+            void abort(const std::shared_ptr<CurlTransfer>& transfer) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_aborting.push_back(transfer);
+                }
+                curl_multi_wakeup(m_multi);
+            }
+
+            /// \brief Connections libcurl opened for finished transfers.
+            /// \details Sum of \c CURLINFO_NUM_CONNECTS; stays at one per
+            /// host while requests are multiplexed over one connection.
+            std::size_t new_connection_count() const {
+                return m_new_connections.load(std::memory_order_acquire);
+            }
+
+        private:
+            typedef std::map<CURL*, std::shared_ptr<CurlTransfer> > ActiveMap;
+
+            void run() {
+                ActiveMap active;
+                for (;;) {
+                    std::vector<std::shared_ptr<CurlTransfer> > incoming;
+                    std::vector<std::shared_ptr<CurlTransfer> > aborting;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        if (m_stop) break;
+                        incoming.swap(m_incoming);
+                        aborting.swap(m_aborting);
+                    }
+                    for (std::size_t i = 0; i < incoming.size(); ++i) {
+                        const CURLMcode rc =
+                            curl_multi_add_handle(m_multi, incoming[i]->easy());
+                        if (rc != CURLM_OK) {
+                            incoming[i]->finish(CURLE_FAILED_INIT);
+                            continue;
+                        }
+                        active[incoming[i]->easy()] = incoming[i];
+                    }
+                    for (std::size_t i = 0; i < aborting.size(); ++i) {
+                        ActiveMap::iterator it = active.find(aborting[i]->easy());
+                        if (it == active.end()) continue;
+                        curl_multi_remove_handle(m_multi, it->first);
+                        it->second->finish(CURLE_ABORTED_BY_CALLBACK);
+                        active.erase(it);
+                    }
+
+                    int running = 0;
+                    curl_multi_perform(m_multi, &running);
+                    int left = 0;
+                    while (CURLMsg* msg = curl_multi_info_read(m_multi, &left)) {
+                        if (msg->msg != CURLMSG_DONE) continue;
+                        ActiveMap::iterator it = active.find(msg->easy_handle);
+                        if (it == active.end()) continue;
+                        long connects = 0;
+                        curl_easy_getinfo(it->first, CURLINFO_NUM_CONNECTS, &connects);
+                        if (connects > 0) {
+                            m_new_connections.fetch_add(static_cast<std::size_t>(connects),
+                                                        std::memory_order_acq_rel);
+                        }
+                        const CURLcode result = msg->data.result;
+                        curl_multi_remove_handle(m_multi, it->first);
+                        it->second->finish(result);
+                        active.erase(it);
+                    }
+                    curl_multi_poll(m_multi, nullptr, 0, 1000, nullptr);
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (std::size_t i = 0; i < m_incoming.size(); ++i) {
+                    m_incoming[i]->finish(CURLE_ABORTED_BY_CALLBACK);
+                }
+                m_incoming.clear();
+                m_aborting.clear();
+                for (ActiveMap::iterator it = active.begin(); it != active.end(); ++it) {
+                    curl_multi_remove_handle(m_multi, it->first);
+                    it->second->finish(CURLE_ABORTED_BY_CALLBACK);
+                }
+            }
+
+            CURLM*                                    m_multi;
+            std::mutex                                m_mutex;
+            bool                                      m_stop;
+            std::vector<std::shared_ptr<CurlTransfer> > m_incoming;
+            std::vector<std::shared_ptr<CurlTransfer> > m_aborting;
+            std::atomic<std::size_t>                  m_new_connections;
+            std::thread                               m_thread;
+        };
+
+        /// \brief Returns the multiplexer shared by everyone using \p base_url.
+        /// \details The registry keeps weak references, so a multiplexer and
+        /// its connections live as long as a sync client uses them.
+        inline std::shared_ptr<CurlMultiplexer> shared_multiplexer(
+                const std::string& base_url) {
+            static std::mutex mutex;
+            static std::map<std::string, std::weak_ptr<CurlMultiplexer> > multiplexers;
+            std::lock_guard<std::mutex> lock(mutex);
+            for (std::map<std::string, std::weak_ptr<CurlMultiplexer> >::iterator it =
+                     multiplexers.begin();
+                 it != multiplexers.end();) {
+                if (it->second.expired()) {
+                    multiplexers.erase(it++);
+                } else {
+                    ++it;
+                }
+            }
+            std::shared_ptr<CurlMultiplexer> multiplexer = multiplexers[base_url].lock();
+            if (!multiplexer) {
+                multiplexer = std::make_shared<CurlMultiplexer>();
+                multiplexers[base_url] = multiplexer;
+            }
+            return multiplexer;
+        }
+    } // namespace detail
+
+    /// \brief Configuration for \c HttpSyncClient.
+    struct HttpSyncClientConfig {
+        /// \brief Base URL, for example \c https://replica-1:18443.
+        std::string base_url = "http://127.0.0.1:18080";
+        /// \brief HTTP version to request.
+        HttpVersion http_version = HttpVersion::Http2Tls;
+        /// \brief Whether clients with the same \c base_url share one
+        /// multiplexer and with it one HTTP/2 connection.
+        /// \details Cancelling a request resets only its own stream, so
+        /// sharing does not couple the callers' cancellation.
+        bool share_connection = true;
+        /// \brief Poll interval used while waiting for the transfer.
+        std::chrono::milliseconds wait_poll_interval =
+            std::chrono::milliseconds(10);
+        /// \brief Whole-request timeout; 0 leaves it to the caller's token.
+        std::chrono::milliseconds request_timeout =
+            std::chrono::milliseconds(0);
+        /// \brief Optional bearer token added as an Authorization header.
+        std::string bearer_token;
+        /// \brief Extra headers sent with every sync POST request.
+        std::vector<HttpSyncHeader> headers;
+        /// \brief Maximum accepted response body size before decode.
+        CodecBounds bounds;
+    };
+
+    /// \brief libcurl HTTP/2 client binding for \c HttpSyncPeer.
+    /// \details Requests are run by a \c detail::CurlMultiplexer; with
+    /// \c HttpSyncClientConfig::share_connection the workers of one node
+    /// that pull from the same replica send their requests as streams of a
+    /// single connection instead of one connection each. The server side
+    /// stays the Simple-Web listener behind an HTTP/2-terminating proxy, or
+    /// any HTTP/1.1 listener when HTTP/2 is not negotiated.
+    /// \note One instance is intended for one active \c post() call at a time.
+    /// Use separate client instances for concurrent callers.
+    class HttpSyncClient : public IHttpSyncClient {
+    public:
+        explicit HttpSyncClient(const HttpSyncClientConfig& config)
+            : m_config(config),
+              m_cancel_generation(0),
+              m_cancel_count(0) {
+            validate_config(m_config);
+            m_multiplexer = make_multiplexer(m_config);
+        }
+
+        explicit HttpSyncClient(const std::string& base_url,
+                                const std::string& bearer_token =
+                                    std::string())
+            : m_cancel_generation(0),
+              m_cancel_count(0) {
+            m_config.base_url = base_url;
+            m_config.bearer_token = bearer_token;
+            validate_config(m_config);
+            m_multiplexer = make_multiplexer(m_config);
+        }
+
+        HttpSyncResponse post(
+                const std::string& target,
+                const std::string& content_type,
+                const std::vector<std::uint8_t>& body,
+                const CancellationToken& cancel_token) override {
+            if (cancel_token.is_cancellation_requested()) {
+                return make_cancelled_response(
+                    "cancelled before HTTP request");
+            }
+
+            const std::uint64_t call_generation =
+                m_cancel_generation.load(std::memory_order_acquire);
+            std::shared_ptr<detail::CurlTransfer> transfer =
+                make_transfer(target, content_type, body);
+            m_multiplexer->submit(transfer);
+
+            while (!transfer->wait_for(m_config.wait_poll_interval)) {
+                if (cancel_token.is_cancellation_requested() ||
+                    m_cancel_generation.load(std::memory_order_acquire) !=
+                        call_generation) {
+                    m_multiplexer->abort(transfer);
+                    return make_cancelled_response(
+                        "cancelled during HTTP request");
+                }
+            }
+            return convert_response(*transfer);
+        }
+
+        void request_cancel() override {
+            m_cancel_generation.fetch_add(1, std::memory_order_acq_rel);
+            m_cancel_count.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        std::size_t cancel_count() const {
+            return m_cancel_count.load(std::memory_order_acquire);
+        }
+
+        /// \brief Connections opened so far by this client's multiplexer.
+        std::size_t new_connection_count() const {
+            return m_multiplexer->new_connection_count();
+        }
+
+    private:
+        static std::shared_ptr<detail::CurlMultiplexer> make_multiplexer(
+                const HttpSyncClientConfig& config) {
+            if (config.share_connection) {
+                return detail::shared_multiplexer(config.base_url);
+            }
+            return std::make_shared<detail::CurlMultiplexer>();
+        }
+
+        std::shared_ptr<detail::CurlTransfer> make_transfer(
+                const std::string& target,
+                const std::string& content_type,
+                const std::vector<std::uint8_t>& body) const {
+            std::shared_ptr<detail::CurlTransfer> transfer =
+                std::make_shared<detail::CurlTransfer>();
+            transfer->body_limit = m_config.bounds.max_transport_message_bytes;
+            transfer->request_body = body;
+            transfer->add_request_header("Content-Type: " + content_type);
+            // libcurl would otherwise delay large HTTP/1.1 bodies for a 100 reply.
+            transfer->add_request_header("Expect:");
+            if (!m_config.bearer_token.empty()) {
+                transfer->add_request_header("Authorization: Bearer " +
+                                             m_config.bearer_token);
+            }
+            for (std::size_t i = 0; i < m_config.headers.size(); ++i) {
+                transfer->add_request_header(m_config.headers[i].name + ": " +
+                                             m_config.headers[i].value);
+            }
+
+            const std::string url = m_config.base_url + target;
+            CURL* easy = transfer->easy();
+            curl_easy_setopt(easy, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+            curl_easy_setopt(easy, CURLOPT_HTTP_VERSION,
+                             detail::to_curl_http_version(m_config.http_version));
+            curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+            curl_easy_setopt(easy, CURLOPT_POST, 1L);
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDS,
+                             transfer->request_body.empty()
+                                 ? ""
+                                 : reinterpret_cast<const char*>(&transfer->request_body[0]));
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE_LARGE,
+                             static_cast<curl_off_t>(transfer->request_body.size()));
+            curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->request_headers());
+            curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION,
+                             &detail::CurlTransfer::write_body);
+            curl_easy_setopt(easy, CURLOPT_WRITEDATA, transfer.get());
+            curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION,
+                             &detail::CurlTransfer::write_header);
+            curl_easy_setopt(easy, CURLOPT_HEADERDATA, transfer.get());
+            if (m_config.request_timeout.count() > 0) {
+                curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS,
+                                 static_cast<long>(m_config.request_timeout.count()));
+            }
+            return transfer;
+        }
+
+        static HttpSyncResponse make_cancelled_response(
+                const std::string& diagnostic) {
+            HttpSyncResponse out;
+            out.status_code = 503;
+            out.content_type = "text/plain; charset=utf-8";
+            out.error = diagnostic.empty() ? "cancelled" : diagnostic;
+            out.body = detail::string_to_bytes(out.error);
+            return out;
+        }
+
+        static HttpSyncResponse make_transport_error_response(
+                const std::string& diagnostic) {
+            HttpSyncResponse out;
+            out.status_code = 0;
+            out.content_type = "text/plain; charset=utf-8";
+            out.error = diagnostic;
+            out.body = detail::string_to_bytes(out.error);
+            return out;
+        }
+
+        static HttpSyncResponse make_payload_too_large_response(
+                const std::string& diagnostic) {
+            HttpSyncResponse out;
+            out.status_code = 413;
+            out.content_type = "text/plain; charset=utf-8";
+            out.error = diagnostic;
+            out.body = detail::string_to_bytes(out.error);
+            return out;
+        }
+
+        static HttpSyncResponse convert_response(detail::CurlTransfer& transfer) {
+            if (transfer.body_too_large) {
+                return make_payload_too_large_response(
+                    "libcurl HTTP sync response exceeds max_transport_message_bytes");
+            }
+            const CURLcode result = transfer.result();
+            if (result != CURLE_OK) {
+                return make_transport_error_response(curl_easy_strerror(result));
+            }
+            HttpSyncResponse out;
+            const long status = transfer.status();
+            out.status_code = status < 0 ? 0u : static_cast<unsigned>(status);
+            out.headers.swap(transfer.response_headers);
+            out.content_type = http_header_value(out.headers, "Content-Type");
+            out.body.swap(transfer.response_body);
+            return out;
+        }
+
+        static void validate_config(const HttpSyncClientConfig& config) {
+            if (config.base_url.empty()) {
+                throw std::invalid_argument(
+                    "libcurl HTTP sync base_url must not be empty");
+            }
+            if (config.wait_poll_interval.count() <= 0) {
+                throw std::invalid_argument(
+                    "libcurl HTTP sync wait_poll_interval must be positive");
+            }
+            if (config.request_timeout.count() < 0) {
+                throw std::invalid_argument(
+                    "libcurl HTTP sync request_timeout must not be negative");
+            }
+        }
+
+        HttpSyncClientConfig m_config;
+        std::shared_ptr<detail::CurlMultiplexer> m_multiplexer;
+        std::atomic<std::uint64_t> m_cancel_generation;
+        std::atomic<std::size_t> m_cancel_count;
+    };
+
+} // namespace curl
+} // namespace sync
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_SYNC_TRANSPORTS_CURL_HTTP_TRANSPORT_HPP_INCLUDED
@@ -34,6 +34,8 @@
 #include <cstdint>
 #include <exception>
 #include <future>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
@@ -65,6 +67,30 @@ namespace kurlyk {
                                bytes.size());
         }
 
+        /// \brief Returns the kurlyk client shared by everyone using \p base_url.
+        /// \details The registry keeps weak references, so a client lives
+        /// as long as a sync client uses it.
+        inline std::shared_ptr< ::kurlyk::HttpClient > shared_http_client(
+                const std::string& base_url) {
+            static std::mutex mutex;
+            static std::map<std::string, std::weak_ptr< ::kurlyk::HttpClient > > clients;
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto it = clients.begin(); it != clients.end();) {
+                if (it->second.expired()) {
+                    it = clients.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            std::shared_ptr< ::kurlyk::HttpClient > client =
+                clients[base_url].lock();
+            if (!client) {
+                client = std::make_shared< ::kurlyk::HttpClient >(base_url);
+                clients[base_url] = client;
+            }
+            return client;
+        }
+
         inline void add_headers(::kurlyk::Headers& destination,
                                 const std::vector<HttpSyncHeader>& source) {
             for (std::size_t i = 0; i < source.size(); ++i) {
@@ -86,28 +112,43 @@ namespace kurlyk {
         std::vector<HttpSyncHeader> headers;
         /// \brief Maximum accepted response body size before decode.
         CodecBounds bounds;
+        /// \brief Whether clients with the same \c base_url share one kurlyk
+        /// client.
+        /// \details Each kurlyk client keeps its own connections, so
+        /// sharing lets several \c SyncWorker peers of one host reuse
+        /// kept-alive HTTP and TLS connections instead of each opening its
+        /// own. A shared client cannot abort one caller's request without
+        /// aborting the others', so cancellation then stops waiting and
+        /// drops the late response instead.
+        bool share_client = false;
     };
 
     /// \brief Kurlyk/libcurl HTTP client binding for \c HttpSyncPeer.
+    /// \details The kurlyk client, and with it its kept-alive connections,
+    /// lives as long as this object, so keep one instance per peer rather
+    /// than one per request. See \c HttpSyncClientConfig::share_client to
+    /// share connections between instances.
     /// \note One instance is intended for one active \c post() call at a time.
     /// Use separate client instances for concurrent callers.
     class HttpSyncClient : public IHttpSyncClient {
     public:
         explicit HttpSyncClient(const HttpSyncClientConfig& config)
             : m_config(config),
-              m_client(config.base_url),
+              m_cancel_generation(0),
               m_cancel_count(0) {
             validate_config(m_config);
+            m_client = make_client(m_config);
         }
 
         explicit HttpSyncClient(const std::string& base_url,
                                 const std::string& bearer_token =
                                     std::string())
-            : m_client(base_url),
+            : m_cancel_generation(0),
               m_cancel_count(0) {
             m_config.base_url = base_url;
             m_config.bearer_token = bearer_token;
             validate_config(m_config);
+            m_client = make_client(m_config);
         }
 
         HttpSyncResponse post(
@@ -120,6 +161,8 @@ namespace kurlyk {
                     "cancelled before HTTP request");
             }
 
+            const std::uint64_t call_generation =
+                m_cancel_generation.load(std::memory_order_acquire);
             ::kurlyk::Headers headers;
             headers.emplace("Content-Type", content_type);
             if (!m_config.bearer_token.empty()) {
@@ -130,14 +173,16 @@ namespace kurlyk {
             detail::add_headers(headers, m_config.headers);
 
             std::future< ::kurlyk::HttpResponsePtr > future =
-                m_client.post(target,
+                m_client->post(target,
                               ::kurlyk::QueryParams(),
                               headers,
                               detail::bytes_to_string(body));
 
             while (future.wait_for(m_config.wait_poll_interval) !=
                    std::future_status::ready) {
-                if (cancel_token.is_cancellation_requested()) {
+                if (cancel_token.is_cancellation_requested() ||
+                    m_cancel_generation.load(std::memory_order_acquire) !=
+                        call_generation) {
                     cancel_requests();
                     return make_cancelled_response(
                         "cancelled during HTTP request");
@@ -160,6 +205,7 @@ namespace kurlyk {
         }
 
         void request_cancel() override {
+            m_cancel_generation.fetch_add(1, std::memory_order_acq_rel);
             m_cancel_count.fetch_add(1, std::memory_order_acq_rel);
             cancel_requests();
         }
@@ -169,6 +215,14 @@ namespace kurlyk {
         }
 
     private:
+        static std::shared_ptr< ::kurlyk::HttpClient > make_client(
+                const HttpSyncClientConfig& config) {
+            if (config.share_client) {
+                return detail::shared_http_client(config.base_url);
+            }
+            return std::make_shared< ::kurlyk::HttpClient >(config.base_url);
+        }
+
         static HttpSyncResponse make_cancelled_response(
                 const std::string& diagnostic) {
             HttpSyncResponse out;
@@ -240,12 +294,16 @@ namespace kurlyk {
         }
 
         void cancel_requests() {
+            if (m_config.share_client) {
+                return; // Would abort other callers' requests too.
+            }
             std::lock_guard<std::mutex> lock(m_cancel_mutex);
-            m_client.cancel_requests();
+            m_client->cancel_requests();
         }
 
         HttpSyncClientConfig m_config;
-        ::kurlyk::HttpClient m_client;
+        std::shared_ptr< ::kurlyk::HttpClient > m_client;
+        std::atomic<std::uint64_t> m_cancel_generation;
         std::atomic<std::size_t> m_cancel_count;
         mutable std::mutex m_cancel_mutex;
     };
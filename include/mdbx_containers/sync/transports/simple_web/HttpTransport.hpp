@@ -37,10 +37,14 @@
 #include <cstdint>
 #include <cstdlib>
 #include <exception>
+#include <functional>
 #include <future>
+#include <istream>
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <ostream>
+#include <streambuf>
 #include <string>
 #include <thread>
 #include <vector>
@@ -48,6 +52,7 @@
 #include <mdbx_containers/sync/sync_module.hpp>
 #include <mdbx_containers/sync/HttpTransport.hpp>
 #include <mdbx_containers/sync/TransportMiddleware.hpp>
+#include <mdbx_containers/sync/OpenMetrics.hpp>
 
 #if !MDBXC_SYNC_ENABLED
 #error "mdbx_containers/sync/transports/simple_web/HttpTransport.hpp requires MDBXC_SYNC_ENABLED=1"
@@ -68,13 +73,64 @@ namespace simple_web {
             return std::vector<std::uint8_t>(text.begin(), text.end());
         }
 
-        inline std::string bytes_to_string(
-                const std::vector<std::uint8_t>& bytes) {
-            if (bytes.empty()) {
-                return std::string();
+        /// \brief Read-only stream buffer over bytes owned by the caller.
+        /// \details Lets Simple-Web send a body straight from an encoded
+        /// vector instead of a \c std::string copy of it. Seeking is
+        /// supported because Simple-Web sizes a stream body that way.
+        class ByteViewStreamBuf : public std::streambuf {
+        public:
+            ByteViewStreamBuf(const std::uint8_t* data, std::size_t size) {
+                char* begin = const_cast<char*>(
+                    reinterpret_cast<const char*>(data));
+                setg(begin, begin, begin + size);
+            }
+
+        protected:
+            pos_type seekoff(off_type off,
+                             std::ios_base::seekdir dir,
+                             std::ios_base::openmode which) override {
+                if ((which & std::ios_base::in) == 0) {
+                    return pos_type(off_type(-1));
+                }
+                const off_type size = egptr() - eback();
+                off_type base = 0;
+                if (dir == std::ios_base::cur) {
+                    base = gptr() - eback();
+                } else if (dir == std::ios_base::end) {
+                    base = size;
+                }
+                const off_type target = base + off;
+                if (target < 0 || target > size) {
+                    return pos_type(off_type(-1));
+                }
+                setg(eback(), eback() + target, egptr());
+                return pos_type(target);
+            }
+
+            pos_type seekpos(pos_type pos,
+                             std::ios_base::openmode which) override {
+                return seekoff(off_type(pos), std::ios_base::beg, which);
             }
-            return std::string(reinterpret_cast<const char*>(&bytes[0]),
-                               bytes.size());
+        };
+
+        /// \brief Reads a received body into \p out with a single copy.
+        /// \return false, leaving \p out empty, when the body is over \p limit.
+        template <class Content>
+        inline bool read_content(Content& content,
+                                 std::uint64_t limit,
+                                 std::vector<std::uint8_t>& out) {
+            out.clear();
+            const std::size_t size = content.size();
+            if (size > limit) {
+                return false;
+            }
+            if (size != 0) {
+                out.resize(size);
+                content.read(reinterpret_cast<char*>(&out[0]),
+                             static_cast<std::streamsize>(size));
+                out.resize(static_cast<std::size_t>(content.gcount()));
+            }
+            return true;
         }
 
         inline std::string header_value(
@@ -223,11 +279,11 @@ namespace simple_web {
                                     m_config.headers[i].value);
                 }
 
+                detail::ByteViewStreamBuf body_buf(
+                    body.empty() ? nullptr : &body[0], body.size());
+                std::istream body_stream(&body_buf);
                 const std::shared_ptr<Client::Response> received =
-                    client.request("POST",
-                                   target,
-                                   detail::bytes_to_string(body),
-                                   headers);
+                    client.request("POST", target, body_stream, headers);
 
                 HttpSyncResponse out;
                 out.status_code =
@@ -246,13 +302,13 @@ namespace simple_web {
                     return make_payload_too_large_response(
                         "HTTP sync response exceeds max_transport_message_bytes");
                 }
-                const std::string content = received->content.string();
-                if (content.size() >
-                    m_config.bounds.max_transport_message_bytes) {
+                if (!detail::read_content(
+                        received->content,
+                        m_config.bounds.max_transport_message_bytes,
+                        out.body)) {
                     return make_payload_too_large_response(
                         "HTTP sync response exceeds max_transport_message_bytes");
                 }
-                out.body = detail::string_to_bytes(content);
                 return out;
             } catch (const SimpleWeb::system_error& e) {
                 if (m_cancel_generation.load(std::memory_order_acquire) !=
@@ -346,6 +402,8 @@ namespace simple_web {
         /// \brief Local bind port. Use 0 to let the OS assign a free port.
         std::uint16_t port = 0;
         /// \brief Simple-Web-Server worker thread count.
+        /// \details Each pull held by \c SyncEngine::max_pull_wait() occupies
+        /// a worker until it returns.
         std::size_t thread_pool_size = 1;
         /// \brief Regex route accepting /pull and /push sync requests.
         std::string sync_route_regex = "^/mdbxc/sync/v1/(pull|push)$";
@@ -358,6 +416,13 @@ namespace simple_web {
         std::mutex* handler_mutex = nullptr;
         /// \brief Maximum accepted request body size before dispatch/decode.
         CodecBounds bounds;
+        /// \brief Optional OpenMetrics source served to GET requests.
+        /// \details Usually builds an \c OpenMetricsWriter and returns
+        /// \c str(). Called on a listener worker thread for every scrape;
+        /// an empty function leaves the route unmounted.
+        std::function<std::string()> metrics_provider;
+        /// \brief Regex route answering with \c metrics_provider output.
+        std::string metrics_route_regex = "^/metrics$";
     };
 
     /// \brief Simple-Web-Server listener binding for \c HttpSyncServer.
@@ -380,6 +445,15 @@ namespace simple_web {
                     handle_post(response, request);
                 };
 
+            if (config.metrics_provider) {
+                m_server.resource[config.metrics_route_regex]["GET"] =
+                    [this](std::shared_ptr<Server::Response> response,
+                           std::shared_ptr<Server::Request> request) {
+                        (void)request;
+                        handle_metrics(response);
+                    };
+            }
+
             if (config.install_default_post_handler) {
                 m_server.default_resource["POST"] =
                     [](std::shared_ptr<Server::Response> response,
@@ -469,9 +543,26 @@ namespace simple_web {
             for (std::size_t i = 0; i < out.headers.size(); ++i) {
                 headers.emplace(out.headers[i].name, out.headers[i].value);
             }
-            response->write(detail::to_simple_status(out.status_code),
-                            detail::bytes_to_string(out.body),
-                            headers);
+            // Bodies go straight into the response stream, without first
+            // being copied into a std::string.
+            const bool chunked = !out.body_chunks.empty();
+            headers.emplace("Content-Length",
+                            std::to_string(chunked ? out.body_chunks.size()
+                                                   : out.body.size()));
+            response->write(detail::to_simple_status(out.status_code), headers);
+            std::ostream& stream = *response;
+            if (!chunked) {
+                if (!out.body.empty()) {
+                    stream.write(reinterpret_cast<const char*>(&out.body[0]),
+                                 static_cast<std::streamsize>(out.body.size()));
+                }
+                return;
+            }
+            out.body_chunks.write_to(
+                [&stream](const std::uint8_t* data, std::size_t size) {
+                    stream.write(reinterpret_cast<const char*>(data),
+                                 static_cast<std::streamsize>(size));
+                });
         }
 
         HttpSyncRequest make_request_metadata(
@@ -479,6 +570,7 @@ namespace simple_web {
             HttpSyncRequest in;
             in.method = request->method;
             in.target = request->path;
+            in.accept_chunked_body = true;
             in.content_type =
                 detail::header_value(request->header, "Content-Type");
             for (SimpleWeb::CaseInsensitiveMultimap::const_iterator it =
@@ -503,13 +595,10 @@ namespace simple_web {
                     request->header, m_config.bounds)) {
                 return false;
             }
-            const std::string body = request->content.string();
-            if (body.size() >
-                m_config.bounds.max_transport_message_bytes) {
-                return false;
-            }
-            in.body = detail::string_to_bytes(body);
-            return true;
+            return detail::read_content(
+                request->content,
+                m_config.bounds.max_transport_message_bytes,
+                in.body);
         }
 
         static HttpSyncResponse make_rejected_response(
@@ -538,6 +627,26 @@ namespace simple_web {
             return out;
         }
 
+        void handle_metrics(
+                const std::shared_ptr<Server::Response>& response) const {
+            HttpSyncResponse out;
+            try {
+                out.content_type = openmetrics_content_type();
+                out.body = detail::string_to_bytes(m_config.metrics_provider());
+            } catch (const std::exception& e) {
+                out.status_code = 500;
+                out.content_type = "text/plain; charset=utf-8";
+                out.error = e.what();
+                out.body = detail::string_to_bytes(out.error);
+            } catch (...) {
+                out.status_code = 500;
+                out.content_type = "text/plain; charset=utf-8";
+                out.error = "metrics provider failed";
+                out.body = detail::string_to_bytes(out.error);
+            }
+            write_response(response, out);
+        }
+
         void handle_post(
                 const std::shared_ptr<Server::Response>& response,
                 const std::shared_ptr<Server::Request>& request) {
@@ -38,6 +38,7 @@
 #include <cstdint>
 #include <exception>
 #include <future>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -45,6 +46,7 @@
 #include <thread>
 #include <vector>
 
+#include <mdbx_containers/detail/ThreadPool.hpp>
 #include <mdbx_containers/sync/sync_module.hpp>
 #include <mdbx_containers/sync/TransportMiddleware.hpp>
 #include <mdbx_containers/sync/WebSocketTransport.hpp>
@@ -385,6 +387,371 @@ namespace simple_web {
         std::atomic<std::size_t> m_cancel_count;
     };
 
+    /// \brief Simple-WebSocket-Server channel that keeps one connection open
+    /// and multiplexes exchanges over it.
+    /// \details The first \c exchange_binary() connects and later calls reuse
+    /// the connection, so sync rounds pay no per-call WebSocket handshake.
+    /// Each request is wrapped by \c websocket_sync_tag_message() and its
+    /// response is matched by request id, so several threads may have
+    /// exchanges outstanding at once, e.g. a \c SyncWorker with
+    /// \c pipeline_depth. \c WebSocketSyncListener answers tagged requests
+    /// of one connection in arrival order, so they are pipelined rather than
+    /// served in parallel. When the connection closes or fails, every
+    /// outstanding exchange fails and the next call reconnects. The peer
+    /// must understand tagged messages; \c WebSocketSyncListener does.
+    class PersistentWebSocketSyncChannel : public IWebSocketSyncChannel {
+    public:
+        explicit PersistentWebSocketSyncChannel(
+                const WebSocketSyncChannelConfig& config)
+            : m_config(config),
+              m_next_request_id(0),
+              m_cancel_count(0),
+              m_connect_count(0) {}
+
+        ~PersistentWebSocketSyncChannel() {
+            close();
+        }
+
+        PersistentWebSocketSyncChannel(
+                const PersistentWebSocketSyncChannel&) = delete;
+        PersistentWebSocketSyncChannel& operator=(
+                const PersistentWebSocketSyncChannel&) = delete;
+
+        /// \brief Sends one tagged request and waits for its response.
+        /// \details \c exchange_timeout covers connecting as well. A
+        /// cancelled or timed-out exchange leaves the connection open; its
+        /// late response is dropped.
+        std::vector<std::uint8_t> exchange_binary(
+                const std::vector<std::uint8_t>& binary_message,
+                const CancellationToken& cancel_token) override {
+            if (binary_message.size() + websocket_sync_tag_size() >
+                m_config.bounds.max_transport_message_bytes) {
+                throw std::length_error(
+                    "WebSocket sync request exceeds max_transport_message_bytes");
+            }
+            if (cancel_token.is_cancellation_requested()) {
+                throw std::runtime_error(
+                    "cancelled before WebSocket exchange");
+            }
+            if (m_config.exchange_timeout.count() < 0) {
+                throw std::invalid_argument(
+                    "WebSocket exchange_timeout must not be negative");
+            }
+            const bool has_deadline = m_config.exchange_timeout.count() > 0;
+            const std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() + m_config.exchange_timeout;
+
+            const std::shared_ptr<Link> link =
+                connect(cancel_token, has_deadline, deadline);
+            const std::uint64_t request_id =
+                m_next_request_id.fetch_add(1, std::memory_order_acq_rel) + 1;
+            std::shared_ptr<WebSocketExchangeState> state(
+                new WebSocketExchangeState());
+            std::future<std::vector<std::uint8_t> > result =
+                state->future();
+            const std::shared_ptr<Client::Connection> connection =
+                link->add(request_id, state);
+            const std::string outbound = detail::ws_bytes_to_string(
+                websocket_sync_tag_message(request_id, binary_message));
+            connection->send(
+                outbound,
+                [state](const SimpleWeb::error_code& ec) {
+                    if (ec) {
+                        state->set_exception(ec.message());
+                    }
+                },
+                m_config.binary_frame_opcode);
+
+            while (result.wait_for(poll_interval()) !=
+                   std::future_status::ready) {
+                if (cancel_token.is_cancellation_requested()) {
+                    link->forget(request_id);
+                    throw std::runtime_error(
+                        "cancelled during WebSocket exchange");
+                }
+                if (has_deadline &&
+                    std::chrono::steady_clock::now() >= deadline) {
+                    link->forget(request_id);
+                    throw std::runtime_error(
+                        "WebSocket exchange deadline exceeded");
+                }
+            }
+            link->forget(request_id);
+            return result.get();
+        }
+
+        /// \brief Fails every outstanding exchange; the connection stays open.
+        void request_cancel() override {
+            m_cancel_count.fetch_add(1, std::memory_order_acq_rel);
+            std::shared_ptr<Link> link;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                link = m_link;
+            }
+            if (link) {
+                link->fail_pending("cancelled during WebSocket exchange");
+            }
+        }
+
+        /// \brief Closes the connection; the next exchange reconnects.
+        void close() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            teardown_locked();
+        }
+
+        std::size_t cancel_count() const {
+            return m_cancel_count.load(std::memory_order_acquire);
+        }
+
+        /// \brief Connections opened so far, including failed attempts.
+        std::size_t connect_count() const {
+            return m_connect_count.load(std::memory_order_acquire);
+        }
+
+    private:
+        typedef SimpleWeb::SocketClient<SimpleWeb::WS> Client;
+
+        static std::chrono::milliseconds poll_interval() {
+            return std::chrono::milliseconds(20);
+        }
+
+        /// \brief State of one connection shared with the client callbacks.
+        class Link {
+        public:
+            void opened(const std::shared_ptr<Client::Connection>& connection) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_closed) {
+                        m_connection = connection;
+                    }
+                }
+                m_changed.notify_all();
+            }
+
+            /// \brief Marks the link dead and fails everything pending on it.
+            void close(const std::string& error) {
+                std::map<std::uint64_t, std::shared_ptr<WebSocketExchangeState> > pending;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_closed) {
+                        m_closed = true;
+                        m_error = error;
+                    }
+                    m_connection.reset();
+                    pending.swap(m_pending);
+                }
+                m_changed.notify_all();
+                for (auto it = pending.begin(); it != pending.end(); ++it) {
+                    it->second->set_exception(error);
+                }
+            }
+
+            void fail_pending(const std::string& error) {
+                std::map<std::uint64_t, std::shared_ptr<WebSocketExchangeState> > pending;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    pending.swap(m_pending);
+                }
+                for (auto it = pending.begin(); it != pending.end(); ++it) {
+                    it->second->set_exception(error);
+                }
+            }
+
+            /// \brief Waits until the connection opens or fails.
+            /// \return false when cancelled or past \p deadline.
+            bool wait_open(const CancellationToken& cancel_token,
+                           bool has_deadline,
+                           std::chrono::steady_clock::time_point deadline) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (!m_connection && !m_closed) {
+                    m_changed.wait_for(lock, poll_interval());
+                    if (cancel_token.is_cancellation_requested() ||
+                        (has_deadline &&
+                         std::chrono::steady_clock::now() >= deadline)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            bool usable() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return !m_closed && m_connection;
+            }
+
+            std::shared_ptr<Client::Connection> add(
+                    std::uint64_t request_id,
+                    const std::shared_ptr<WebSocketExchangeState>& state) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_closed || !m_connection) {
+                    throw std::runtime_error(m_error.empty()
+                        ? std::string("WebSocket connection is not open")
+                        : m_error);
+                }
+                m_pending[request_id] = state;
+                return m_connection;
+            }
+
+            void forget(std::uint64_t request_id) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pending.erase(request_id);
+            }
+
+            void complete(std::uint64_t request_id,
+                          const std::vector<std::uint8_t>& message) {
+                std::shared_ptr<WebSocketExchangeState> state;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto it = m_pending.find(request_id);
+                    if (it == m_pending.end()) {
+                        return; // Cancelled or timed out; drop it.
+                    }
+                    state = it->second;
+                    m_pending.erase(it);
+                }
+                state->set_value(message);
+            }
+
+            std::string error() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_error;
+            }
+
+        private:
+            mutable std::mutex m_mutex;
+            std::condition_variable m_changed;
+            std::shared_ptr<Client::Connection> m_connection;
+            bool m_closed = false;
+            std::string m_error;
+            std::map<std::uint64_t, std::shared_ptr<WebSocketExchangeState> > m_pending;
+        };
+
+        /// \brief Returns the open link, connecting first when there is none.
+        std::shared_ptr<Link> connect(
+                const CancellationToken& cancel_token,
+                bool has_deadline,
+                std::chrono::steady_clock::time_point deadline) {
+            // Held while connecting, so concurrent callers share one attempt.
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_link && m_link->usable()) {
+                return m_link;
+            }
+            teardown_locked();
+
+            std::shared_ptr<Link> link(new Link());
+            std::unique_ptr<Client> client(new Client(detail::ws_endpoint(
+                m_config.host, m_config.port, m_config.path)));
+            if (!m_config.bearer_token.empty()) {
+                client->config.header.emplace(
+                    "Authorization",
+                    std::string("Bearer ") + m_config.bearer_token);
+            }
+            const CodecBounds bounds = m_config.bounds;
+
+            client->on_open =
+                [link](std::shared_ptr<Client::Connection> connection) {
+                    link->opened(connection);
+                };
+
+            client->on_message =
+                [link, bounds](
+                    std::shared_ptr<Client::Connection> connection,
+                    std::shared_ptr<Client::InMessage> in_message) {
+                    const std::string inbound = in_message->string();
+                    if (inbound.size() >
+                        bounds.max_transport_message_bytes) {
+                        link->close(
+                            "WebSocket sync response exceeds max_transport_message_bytes");
+                        connection->send_close(1009);
+                        return;
+                    }
+                    const std::vector<std::uint8_t> bytes =
+                        detail::ws_string_to_bytes(inbound);
+                    if (!websocket_sync_message_is_tagged(bytes)) {
+                        link->close("WebSocket sync response has no request id");
+                        connection->send_close(1002);
+                        return;
+                    }
+                    std::vector<std::uint8_t> message;
+                    const std::uint64_t request_id =
+                        websocket_sync_untag_message(bytes, message);
+                    link->complete(request_id, message);
+                };
+
+            client->on_close =
+                [link](
+                    std::shared_ptr<Client::Connection> connection,
+                    int status,
+                    const std::string& reason) {
+                    (void)connection;
+                    link->close(
+                        "WebSocket closed with status " +
+                        std::to_string(status) + " (" +
+                        detail::ws_close_retry_label(
+                            static_cast<unsigned>(status)) +
+                        "): " + reason);
+                };
+
+            client->on_error =
+                [link](
+                    std::shared_ptr<Client::Connection> connection,
+                    const SimpleWeb::error_code& ec) {
+                    (void)connection;
+                    link->close(ec.message());
+                };
+
+            Client* raw_client = client.get();
+            m_client = std::move(client);
+            m_link = link;
+            m_connect_count.fetch_add(1, std::memory_order_acq_rel);
+            m_thread = std::thread([link, raw_client]() {
+                try {
+                    raw_client->start();
+                } catch (const std::exception& e) {
+                    link->close(e.what());
+                } catch (...) {
+                    link->close("unknown WebSocket client error");
+                }
+                link->close("WebSocket connection stopped");
+            });
+
+            if (!link->wait_open(cancel_token, has_deadline, deadline)) {
+                const bool cancelled = cancel_token.is_cancellation_requested();
+                teardown_locked();
+                throw std::runtime_error(cancelled
+                    ? "cancelled during WebSocket connect"
+                    : "WebSocket exchange deadline exceeded");
+            }
+            if (!link->usable()) {
+                throw std::runtime_error(link->error());
+            }
+            return link;
+        }
+
+        void teardown_locked() {
+            if (m_link) {
+                m_link->close("WebSocket channel closed");
+            }
+            if (m_client) {
+                m_client->stop();
+            }
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+            m_client.reset();
+            m_link.reset();
+        }
+
+        WebSocketSyncChannelConfig m_config;
+        std::atomic<std::uint64_t> m_next_request_id;
+        std::atomic<std::size_t> m_cancel_count;
+        std::atomic<std::size_t> m_connect_count;
+        std::mutex m_mutex; ///< Guards the members below and connecting.
+        std::unique_ptr<Client> m_client;
+        std::shared_ptr<Link> m_link;
+        std::thread m_thread;
+    };
+
     /// \brief Configuration for \c WebSocketSyncListener.
     struct WebSocketSyncListenerConfig {
         /// \brief Local bind host name or address.
@@ -392,6 +759,8 @@ namespace simple_web {
         /// \brief Local bind port. Use 0 to let the OS assign a free port.
         std::uint16_t port = 0;
         /// \brief Simple-WebSocket-Server worker thread count.
+        /// \details Each pull held by \c SyncEngine::max_pull_wait() occupies
+        /// a worker until it returns.
         std::size_t thread_pool_size = 1;
         /// \brief Regex endpoint accepting sync WebSocket connections.
         std::string endpoint_regex = "^/mdbxc/sync/v1/ws/?$";
@@ -410,6 +779,21 @@ namespace simple_web {
         /// Use this when the same MDBX-backed \c SyncEngine is also touched
         /// by application code while the WebSocket listener is running.
         std::mutex* handler_mutex = nullptr;
+        /// \brief Whether \c handler_mutex also covers pull requests.
+        /// \details A pull only reads the engine through its own read
+        /// transaction. Clear this so the mutex serializes pushes only and
+        /// pulls of all replicas keep running while a push applies.
+        bool serialize_pulls = true;
+        /// \brief Threads that handle pull requests; 0 handles them inline.
+        /// \details With a positive value each pull is handed to a pool of
+        /// this many threads and the connection's next message is read at
+        /// once, so tagged pulls pipelined on one persistent connection run
+        /// concurrently and a held long-poll does not occupy a listener
+        /// thread. Responses of a connection may then leave out of order,
+        /// which tagged clients match by request id. Pushes stay on the
+        /// listener threads. Pulls queued when the listener is destroyed
+        /// still run first.
+        std::size_t pull_threads = 0;
         /// \brief Maximum accepted binary message size before dispatch/decode.
         CodecBounds bounds;
     };
@@ -423,6 +807,10 @@ namespace simple_web {
             : m_server(server),
               m_config(config),
               m_running(false) {
+            if (config.pull_threads != 0) {
+                m_pull_pool.reset(
+                    new mdbxc::detail::ThreadPool(config.pull_threads));
+            }
             m_ws.config.address = config.host;
             m_ws.config.port = config.port;
             m_ws.config.thread_pool_size = config.thread_pool_size;
@@ -456,43 +844,7 @@ namespace simple_web {
                 [this](
                     std::shared_ptr<Server::Connection> connection,
                     std::shared_ptr<Server::InMessage> in_message) {
-                    try {
-                        WebSocketSyncRequestContext context;
-                        context.has_authenticated_node =
-                            m_config.has_authenticated_node;
-                        context.authenticated_node =
-                            m_config.authenticated_node;
-                        context.db_access = m_config.db_access;
-                        const std::string message = in_message->string();
-                        if (message.size() >
-                            m_config.bounds.max_transport_message_bytes) {
-                            connection->send_close(
-                                1009,
-                                "WebSocket sync request exceeds max_transport_message_bytes");
-                            return;
-                        }
-                        context.binary_message =
-                            detail::ws_string_to_bytes(message);
-                        std::vector<std::uint8_t> response;
-                        if (m_config.handler_mutex != nullptr) {
-                            std::lock_guard<std::mutex> lock(
-                                *m_config.handler_mutex);
-                            response =
-                                m_server.handle_binary_message(context);
-                        } else {
-                            response =
-                                m_server.handle_binary_message(context);
-                        }
-                        connection->send(
-                            detail::ws_bytes_to_string(response),
-                            nullptr,
-                            m_config.binary_frame_opcode);
-                    } catch (const WebSocketSyncRejected& e) {
-                        connection->send_close(
-                            static_cast<int>(e.close_code()), e.what());
-                    } catch (const std::exception& e) {
-                        connection->send_close(1011, e.what());
-                    }
+                    handle_message(connection, in_message->string());
                 };
 
             endpoint.on_error =
@@ -567,11 +919,118 @@ namespace simple_web {
     private:
         typedef SimpleWeb::SocketServer<SimpleWeb::WS> Server;
 
+        void handle_message(
+                const std::shared_ptr<Server::Connection>& connection,
+                const std::string& message) {
+            try {
+                if (message.size() >
+                    m_config.bounds.max_transport_message_bytes) {
+                    connection->send_close(
+                        1009,
+                        "WebSocket sync request exceeds max_transport_message_bytes");
+                    return;
+                }
+                std::shared_ptr<WebSocketSyncRequestContext> context(
+                    new WebSocketSyncRequestContext());
+                context->has_authenticated_node =
+                    m_config.has_authenticated_node;
+                context->authenticated_node = m_config.authenticated_node;
+                context->db_access = m_config.db_access;
+                std::vector<std::uint8_t> bytes =
+                    detail::ws_string_to_bytes(message);
+                // Tagged requests come from a persistent channel; the
+                // response carries the same request id.
+                const bool tagged = websocket_sync_message_is_tagged(bytes);
+                std::uint64_t request_id = 0;
+                if (tagged) {
+                    request_id = websocket_sync_untag_message(
+                        bytes, context->binary_message);
+                } else {
+                    context->binary_message.swap(bytes);
+                }
+                const bool pull = is_pull(context->binary_message);
+                if (pull && m_pull_pool) {
+                    m_pull_pool->post(
+                        [this, connection, context, tagged, request_id]() {
+                            respond(connection, *context, true, tagged,
+                                    request_id);
+                        });
+                    return;
+                }
+                respond(connection, *context, pull, tagged, request_id);
+            } catch (const std::exception& e) {
+                connection->send_close(1011, e.what());
+            }
+        }
+
+        /// \brief Whether \p message is a pull; false when malformed.
+        /// \details Only peeked when the answer changes the dispatch, so a
+        /// malformed message still fails inside the middleware.
+        bool is_pull(const std::vector<std::uint8_t>& message) const {
+            if (!m_pull_pool &&
+                (m_config.handler_mutex == nullptr || m_config.serialize_pulls)) {
+                return false;
+            }
+            try {
+                return TransportMessageCodec::peek_message_type(
+                           message, &m_config.bounds) ==
+                       TransportMessageType::PullRequest;
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+
+        void respond(const std::shared_ptr<Server::Connection>& connection,
+                     const WebSocketSyncRequestContext& context,
+                     bool pull,
+                     bool tagged,
+                     std::uint64_t request_id) {
+            try {
+                ChunkedTransportMessage response;
+                if (m_config.handler_mutex != nullptr &&
+                    (!pull || m_config.serialize_pulls)) {
+                    std::lock_guard<std::mutex> lock(*m_config.handler_mutex);
+                    response = m_server.handle_binary_message_chunked(context);
+                } else {
+                    response = m_server.handle_binary_message_chunked(context);
+                }
+                std::shared_ptr<Server::OutMessage> out_message =
+                    std::make_shared<Server::OutMessage>(
+                        response.size() +
+                        (tagged ? websocket_sync_tag_size() : 0));
+                if (tagged) {
+                    std::uint8_t tag[16];
+                    websocket_sync_write_tag(request_id, tag);
+                    out_message->write(
+                        reinterpret_cast<const char*>(tag),
+                        static_cast<std::streamsize>(sizeof(tag)));
+                }
+                response.write_to(
+                    [&out_message](const std::uint8_t* data,
+                                   std::size_t size) {
+                        out_message->write(
+                            reinterpret_cast<const char*>(data),
+                            static_cast<std::streamsize>(size));
+                    });
+                connection->send(
+                    out_message,
+                    nullptr,
+                    m_config.binary_frame_opcode);
+            } catch (const WebSocketSyncRejected& e) {
+                connection->send_close(
+                    static_cast<int>(e.close_code()), e.what());
+            } catch (const std::exception& e) {
+                connection->send_close(1011, e.what());
+            }
+        }
+
         WebSocketSyncServerMiddleware& m_server;
         WebSocketSyncListenerConfig m_config;
         Server m_ws;
         std::thread m_thread;
         bool m_running;
+        /// \brief Declared last so queued pulls finish before the rest goes.
+        std::unique_ptr<mdbxc::detail::ThreadPool> m_pull_pool;
     };
 
 } // namespace simple_web
@@ -5,19 +5,28 @@
 /// \file tables.hpp
 /// \brief Includes the table wrappers only.
 /// \details
-/// Pulls in every table wrapper (KeyValue, Key, Value, Sequence,
-/// HashedKeyValue, KeyMultiValue, KeyOrderedMultiValue, AnyValue, Hash) but
-/// NOT the sync or vector subsystems. Use when the project only needs the
-/// table API.
+/// Pulls in every table wrapper (KeyValue, Key, BitmapKey, Value, Sequence,
+/// HashedKeyValue, KeyMultiValue, KeyOrderedMultiValue, AnyValue, Hash,
+/// ShardedKeyValue, CachedKeyValue, WriteBehindKeyValue, TtlKeyValue,
+/// TimeSeries, Blob) but NOT the sync or vector subsystems. Use when the project
+/// only needs the table API.
 
 #include "mdbx_containers/AnyValueTable.hpp"
+#include "mdbx_containers/BitmapKeyTable.hpp"
+#include "mdbx_containers/BlobTable.hpp"
+#include "mdbx_containers/CachedKeyValueTable.hpp"
 #include "mdbx_containers/Hash.hpp"
 #include "mdbx_containers/HashedKeyValueStore.hpp"
 #include "mdbx_containers/KeyMultiValueTable.hpp"
 #include "mdbx_containers/KeyOrderedMultiValueTable.hpp"
+#include "mdbx_containers/KeySetOps.hpp"
 #include "mdbx_containers/KeyTable.hpp"
 #include "mdbx_containers/KeyValueTable.hpp"
 #include "mdbx_containers/SequenceTable.hpp"
+#include "mdbx_containers/ShardedKeyValueTable.hpp"
+#include "mdbx_containers/TimeSeriesTable.hpp"
+#include "mdbx_containers/TtlKeyValueTable.hpp"
 #include "mdbx_containers/ValueTable.hpp"
+#include "mdbx_containers/WriteBehindKeyValueTable.hpp"
 
 #endif // MDBX_CONTAINERS_HEADER_TABLES_HPP_INCLUDED
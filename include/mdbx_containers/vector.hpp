@@ -4,12 +4,22 @@
 
 #include "common.hpp"
 #include "SequenceTable.hpp"
+#include "KeyTable.hpp"
 #include "KeyValueTable.hpp"
+#include "KeyMultiValueTable.hpp"
 #include "vector/VectorMetric.hpp"
+#include "vector/VectorQuantization.hpp"
+#include "vector/VectorIndexType.hpp"
+#include "vector/VectorFilter.hpp"
 #include "vector/Embedding.hpp"
 #include "vector/VectorRecord.hpp"
+#include "vector/SearchPayload.hpp"
 #include "vector/SearchResult.hpp"
+#include "vector/TextIndex.hpp"
 #include "vector/FlatVectorIndex.hpp"
+#include "vector/HnswVectorIndex.hpp"
+#include "vector/IvfVectorIndex.hpp"
 #include "vector/VectorStore.hpp"
+#include "vector/VectorStoreRegistry.hpp"
 
 #endif // MDBX_CONTAINERS_HEADER_VECTOR_HPP_INCLUDED
@@ -0,0 +1,798 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_DISTANCE_KERNELS_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_DISTANCE_KERNELS_HPP_INCLUDED
+
+/// \file DistanceKernels.hpp
+/// \brief Dot-product and squared-L2 kernels used by \ref FlatVectorIndex.
+/// \details
+/// The kernel set is chosen once per process: AVX-512F or AVX2+FMA on x86
+/// when the CPU and OS support them, NEON on AArch64, otherwise a portable
+/// loop. Every variant keeps several independent accumulators so additions
+/// are not serialized on one register. Results may differ from the scalar
+/// loop in the last bits because the summation order differs.
+///
+/// Quantized kernels score a float query against int8 codes with a
+/// per-vector scale, or against IEEE half-precision values. The product
+/// quantization kernel sums one precomputed table entry per code byte, and
+/// the Hamming kernel counts differing bits of sign-packed vectors. Decode
+/// kernels widen half-precision or bfloat16 arrays to floats, e.g. when
+/// reduced-precision embeddings are read back from MDBX.
+///
+/// Define \c MDBXC_VECTOR_SIMD_ENABLED to 0 to force the portable kernels.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifndef MDBXC_VECTOR_SIMD_ENABLED
+#define MDBXC_VECTOR_SIMD_ENABLED 1
+#endif
+
+#if MDBXC_VECTOR_SIMD_ENABLED
+#   if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64)) && \
+       (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#       define MDBXC_VECTOR_SIMD_X86 1
+#       include <immintrin.h>
+#       if defined(_MSC_VER) && !defined(__clang__)
+#           include <intrin.h>
+#           define MDBXC_TARGET_AVX2
+#           define MDBXC_TARGET_AVX2_F16C
+#           define MDBXC_TARGET_AVX512
+#           define MDBXC_TARGET_POPCNT
+#       else
+#           define MDBXC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#           define MDBXC_TARGET_AVX2_F16C __attribute__((target("avx2,fma,f16c")))
+#           define MDBXC_TARGET_AVX512 __attribute__((target("avx512f")))
+#           define MDBXC_TARGET_POPCNT __attribute__((target("popcnt")))
+#       endif
+#   elif defined(__aarch64__) || defined(_M_ARM64)
+#       define MDBXC_VECTOR_SIMD_NEON 1
+#       include <arm_neon.h>
+#   endif
+#endif
+
+namespace mdbxc {
+namespace detail {
+
+    /// \brief Kernel over two float arrays of length \p n.
+    typedef float (*DistanceKernelFn)(const float* a, const float* b, std::size_t n);
+
+    /// \brief Kernel over a float query and \p n int8 codes that decode to <tt>code * scale</tt>.
+    typedef float (*Int8KernelFn)(const float* q, const std::int8_t* codes, float scale, std::size_t n);
+
+    /// \brief Kernel over a float query and \p n IEEE half-precision values.
+    typedef float (*HalfKernelFn)(const float* q, const std::uint16_t* h, std::size_t n);
+
+    /// \brief Kernel summing <tt>table[j * 256 + codes[j]]</tt> over \p m product quantization codes.
+    typedef float (*PqKernelFn)(const float* table, const std::uint8_t* codes, std::size_t m);
+
+    /// \brief Kernel widening \p n 16-bit floating-point values to floats.
+    typedef void (*DecodeKernelFn)(const std::uint16_t* src, float* dst, std::size_t n);
+
+    /// \brief Kernel counting differing bits of two arrays of \p words 64-bit words.
+    typedef std::uint32_t (*BitKernelFn)(const std::uint64_t* a, const std::uint64_t* b,
+                                         std::size_t words);
+
+    /// \brief Kernel set selected for the running CPU.
+    struct DistanceKernels {
+        DistanceKernelFn dot;      ///< Returns the dot product.
+        DistanceKernelFn l2sq;     ///< Returns the squared L2 distance.
+        const char*      name;     ///< Instruction set: "avx512", "avx2", "neon" or "scalar".
+        Int8KernelFn     dot_i8;   ///< Dot product with decoded int8 codes.
+        Int8KernelFn     l2sq_i8;  ///< Squared L2 distance to decoded int8 codes.
+        HalfKernelFn     dot_f16;  ///< Dot product with half-precision values.
+        HalfKernelFn     l2sq_f16; ///< Squared L2 distance to half-precision values.
+        PqKernelFn       pq_adc;   ///< Asymmetric distance from a per-query table to PQ codes.
+        BitKernelFn      hamming;  ///< Hamming distance of sign-packed vectors.
+        DecodeKernelFn   decode_f16;  ///< Half precision to float.
+        DecodeKernelFn   decode_bf16; ///< Bfloat16 to float.
+    };
+
+    /// \brief Converts an IEEE half-precision value to float.
+    inline float half_to_float(std::uint16_t h) noexcept {
+        const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+        std::uint32_t exp = (h >> 10) & 0x1fu;
+        std::uint32_t mant = h & 0x3ffu;
+        std::uint32_t bits;
+        if (exp == 0) {
+            if (mant == 0) {
+                bits = sign;
+            } else {
+                // Subnormal: normalize into a float exponent.
+                exp = 127 - 15 + 1;
+                while ((mant & 0x400u) == 0) {
+                    mant <<= 1;
+                    --exp;
+                }
+                bits = sign | (exp << 23) | ((mant & 0x3ffu) << 13);
+            }
+        } else if (exp == 31) {
+            bits = sign | 0x7f800000u | (mant << 13);
+        } else {
+            bits = sign | ((exp + 112) << 23) | (mant << 13);
+        }
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    /// \brief Converts a float to IEEE half precision, rounding to nearest even.
+    inline std::uint16_t float_to_half(float f) noexcept {
+        std::uint32_t x;
+        std::memcpy(&x, &f, sizeof(x));
+        const std::uint32_t sign = (x >> 16) & 0x8000u;
+        const std::uint32_t raw_exp = (x >> 23) & 0xffu;
+        std::uint32_t mant = x & 0x7fffffu;
+        if (raw_exp == 0xffu) {
+            return static_cast<std::uint16_t>(sign | 0x7c00u | (mant ? 0x200u : 0u));
+        }
+        const std::int32_t exp = static_cast<std::int32_t>(raw_exp) - 127 + 15;
+        if (exp >= 31) {
+            return static_cast<std::uint16_t>(sign | 0x7c00u);
+        }
+        if (exp <= 0) {
+            if (exp < -10) return static_cast<std::uint16_t>(sign);
+            mant |= 0x800000u;
+            const std::uint32_t shift = static_cast<std::uint32_t>(14 - exp);
+            std::uint32_t h = mant >> shift;
+            const std::uint32_t rem = mant & ((1u << shift) - 1u);
+            const std::uint32_t half = 1u << (shift - 1);
+            if (rem > half || (rem == half && (h & 1u))) ++h;
+            return static_cast<std::uint16_t>(sign | h);
+        }
+        // A rounding carry may propagate into the exponent, which is correct.
+        std::uint32_t h = (static_cast<std::uint32_t>(exp) << 10) | (mant >> 13);
+        const std::uint32_t rem = mant & 0x1fffu;
+        if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) ++h;
+        return static_cast<std::uint16_t>(sign | h);
+    }
+
+    /// \brief Converts a bfloat16 value, the upper half of a float, to float.
+    inline float bfloat16_to_float(std::uint16_t b) noexcept {
+        const std::uint32_t bits = static_cast<std::uint32_t>(b) << 16;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    /// \brief Converts a float to bfloat16, rounding to nearest even; NaN stays NaN.
+    inline std::uint16_t float_to_bfloat16(float f) noexcept {
+        std::uint32_t x;
+        std::memcpy(&x, &f, sizeof(x));
+        if ((x & 0x7fffffffu) > 0x7f800000u) {
+            return static_cast<std::uint16_t>((x >> 16) | 0x40u);
+        }
+        x += 0x7fffu + ((x >> 16) & 1u);
+        return static_cast<std::uint16_t>(x >> 16);
+    }
+
+    /// \brief Portable dot product with four accumulators.
+    inline float dot_scalar(const float* a, const float* b, std::size_t n) {
+        float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            s0 += a[i] * b[i];
+            s1 += a[i + 1] * b[i + 1];
+            s2 += a[i + 2] * b[i + 2];
+            s3 += a[i + 3] * b[i + 3];
+        }
+        for (; i < n; ++i) s0 += a[i] * b[i];
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    /// \brief Portable squared L2 distance with four accumulators.
+    inline float l2sq_scalar(const float* a, const float* b, std::size_t n) {
+        float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const float d0 = a[i] - b[i];
+            const float d1 = a[i + 1] - b[i + 1];
+            const float d2 = a[i + 2] - b[i + 2];
+            const float d3 = a[i + 3] - b[i + 3];
+            s0 += d0 * d0;
+            s1 += d1 * d1;
+            s2 += d2 * d2;
+            s3 += d3 * d3;
+        }
+        for (; i < n; ++i) {
+            const float d = a[i] - b[i];
+            s0 += d * d;
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    /// \brief Portable dot product with int8 codes.
+    inline float dot_i8_scalar(const float* q, const std::int8_t* c, float scale, std::size_t n) {
+        float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            s0 += q[i] * c[i];
+            s1 += q[i + 1] * c[i + 1];
+            s2 += q[i + 2] * c[i + 2];
+            s3 += q[i + 3] * c[i + 3];
+        }
+        for (; i < n; ++i) s0 += q[i] * c[i];
+        return ((s0 + s1) + (s2 + s3)) * scale;
+    }
+
+    /// \brief Portable squared L2 distance to int8 codes.
+    inline float l2sq_i8_scalar(const float* q, const std::int8_t* c, float scale, std::size_t n) {
+        float s0 = 0.0f, s1 = 0.0f;
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const float d0 = q[i] - c[i] * scale;
+            const float d1 = q[i + 1] - c[i + 1] * scale;
+            s0 += d0 * d0;
+            s1 += d1 * d1;
+        }
+        for (; i < n; ++i) {
+            const float d = q[i] - c[i] * scale;
+            s0 += d * d;
+        }
+        return s0 + s1;
+    }
+
+    /// \brief Portable dot product with half-precision values.
+    inline float dot_f16_scalar(const float* q, const std::uint16_t* h, std::size_t n) {
+        float s0 = 0.0f, s1 = 0.0f;
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            s0 += q[i] * half_to_float(h[i]);
+            s1 += q[i + 1] * half_to_float(h[i + 1]);
+        }
+        for (; i < n; ++i) s0 += q[i] * half_to_float(h[i]);
+        return s0 + s1;
+    }
+
+    /// \brief Portable squared L2 distance to half-precision values.
+    inline float l2sq_f16_scalar(const float* q, const std::uint16_t* h, std::size_t n) {
+        float s0 = 0.0f, s1 = 0.0f;
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const float d0 = q[i] - half_to_float(h[i]);
+            const float d1 = q[i + 1] - half_to_float(h[i + 1]);
+            s0 += d0 * d0;
+            s1 += d1 * d1;
+        }
+        for (; i < n; ++i) {
+            const float d = q[i] - half_to_float(h[i]);
+            s0 += d * d;
+        }
+        return s0 + s1;
+    }
+
+    /// \brief Portable lookup-table sum over PQ codes.
+    inline float pq_adc_scalar(const float* table, const std::uint8_t* codes, std::size_t m) {
+        float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+        std::size_t j = 0;
+        for (; j + 4 <= m; j += 4) {
+            s0 += table[j * 256 + codes[j]];
+            s1 += table[(j + 1) * 256 + codes[j + 1]];
+            s2 += table[(j + 2) * 256 + codes[j + 2]];
+            s3 += table[(j + 3) * 256 + codes[j + 3]];
+        }
+        for (; j < m; ++j) s0 += table[j * 256 + codes[j]];
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    /// \brief Returns the number of set bits in \p x.
+    inline std::uint32_t popcount64(std::uint64_t x) noexcept {
+#   if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::uint32_t>(__builtin_popcountll(x));
+#   else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<std::uint32_t>((x * 0x0101010101010101ULL) >> 56);
+#   endif
+    }
+
+    /// \brief Portable Hamming distance over 64-bit words.
+    inline std::uint32_t hamming_scalar(const std::uint64_t* a, const std::uint64_t* b,
+                                        std::size_t words) {
+        std::uint32_t s0 = 0, s1 = 0;
+        std::size_t i = 0;
+        for (; i + 2 <= words; i += 2) {
+            s0 += popcount64(a[i] ^ b[i]);
+            s1 += popcount64(a[i + 1] ^ b[i + 1]);
+        }
+        for (; i < words; ++i) s0 += popcount64(a[i] ^ b[i]);
+        return s0 + s1;
+    }
+
+    /// \brief Portable half-precision decode.
+    inline void decode_f16_scalar(const std::uint16_t* src, float* dst, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) dst[i] = half_to_float(src[i]);
+    }
+
+    /// \brief Portable bfloat16 decode; compilers vectorize the shift.
+    inline void decode_bf16_scalar(const std::uint16_t* src, float* dst, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint32_t bits = static_cast<std::uint32_t>(src[i]) << 16;
+            std::memcpy(dst + i, &bits, sizeof(bits));
+        }
+    }
+
+#   if defined(MDBXC_VECTOR_SIMD_X86)
+    MDBXC_TARGET_AVX2 inline float hsum_avx2(__m256 v) {
+        const __m128 lo = _mm256_castps256_ps128(v);
+        const __m128 hi = _mm256_extractf128_ps(v, 1);
+        __m128 s = _mm_add_ps(lo, hi);
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+        return _mm_cvtss_f32(s);
+    }
+
+    /// \brief AVX2+FMA dot product, 32 floats per iteration.
+    MDBXC_TARGET_AVX2 inline float dot_avx2(const float* a, const float* b, std::size_t n) {
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+        __m256 s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s0);
+            s1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), s1);
+            s2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), s2);
+            s3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), s3);
+        }
+        for (; i + 8 <= n; i += 8) {
+            s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s0);
+        }
+        float sum = hsum_avx2(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+        for (; i < n; ++i) sum += a[i] * b[i];
+        return sum;
+    }
+
+    /// \brief AVX2+FMA squared L2 distance, 32 floats per iteration.
+    MDBXC_TARGET_AVX2 inline float l2sq_avx2(const float* a, const float* b, std::size_t n) {
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+        __m256 s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+            const __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+            const __m256 d2 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16));
+            const __m256 d3 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24));
+            s0 = _mm256_fmadd_ps(d0, d0, s0);
+            s1 = _mm256_fmadd_ps(d1, d1, s1);
+            s2 = _mm256_fmadd_ps(d2, d2, s2);
+            s3 = _mm256_fmadd_ps(d3, d3, s3);
+        }
+        for (; i + 8 <= n; i += 8) {
+            const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+            s0 = _mm256_fmadd_ps(d, d, s0);
+        }
+        float sum = hsum_avx2(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+        for (; i < n; ++i) {
+            const float d = a[i] - b[i];
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    /// \brief AVX2+FMA dot product with int8 codes, 16 codes per iteration.
+    MDBXC_TARGET_AVX2 inline float dot_i8_avx2(const float* q, const std::int8_t* c, float scale,
+                                               std::size_t n) {
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i));
+            const __m256 c0 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(b));
+            const __m256 c1 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(b, 8)));
+            s0 = _mm256_fmadd_ps(_mm256_loadu_ps(q + i), c0, s0);
+            s1 = _mm256_fmadd_ps(_mm256_loadu_ps(q + i + 8), c1, s1);
+        }
+        float sum = hsum_avx2(_mm256_add_ps(s0, s1));
+        for (; i < n; ++i) sum += q[i] * c[i];
+        return sum * scale;
+    }
+
+    /// \brief AVX2+FMA squared L2 distance to int8 codes, 16 codes per iteration.
+    MDBXC_TARGET_AVX2 inline float l2sq_i8_avx2(const float* q, const std::int8_t* c, float scale,
+                                                std::size_t n) {
+        const __m256 vs = _mm256_set1_ps(scale);
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i));
+            const __m256 c0 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(b));
+            const __m256 c1 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(b, 8)));
+            const __m256 d0 = _mm256_fnmadd_ps(c0, vs, _mm256_loadu_ps(q + i));
+            const __m256 d1 = _mm256_fnmadd_ps(c1, vs, _mm256_loadu_ps(q + i + 8));
+            s0 = _mm256_fmadd_ps(d0, d0, s0);
+            s1 = _mm256_fmadd_ps(d1, d1, s1);
+        }
+        float sum = hsum_avx2(_mm256_add_ps(s0, s1));
+        for (; i < n; ++i) {
+            const float d = q[i] - c[i] * scale;
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    /// \brief AVX2+FMA+F16C dot product with half-precision values, 16 per iteration.
+    MDBXC_TARGET_AVX2_F16C inline float dot_f16_avx2(const float* q, const std::uint16_t* h,
+                                                     std::size_t n) {
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m256 h0 = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i)));
+            const __m256 h1 = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + 8)));
+            s0 = _mm256_fmadd_ps(_mm256_loadu_ps(q + i), h0, s0);
+            s1 = _mm256_fmadd_ps(_mm256_loadu_ps(q + i + 8), h1, s1);
+        }
+        float sum = hsum_avx2(_mm256_add_ps(s0, s1));
+        for (; i < n; ++i) sum += q[i] * half_to_float(h[i]);
+        return sum;
+    }
+
+    /// \brief AVX2+FMA+F16C squared L2 distance to half-precision values, 16 per iteration.
+    MDBXC_TARGET_AVX2_F16C inline float l2sq_f16_avx2(const float* q, const std::uint16_t* h,
+                                                      std::size_t n) {
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m256 h0 = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i)));
+            const __m256 h1 = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + 8)));
+            const __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(q + i), h0);
+            const __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(q + i + 8), h1);
+            s0 = _mm256_fmadd_ps(d0, d0, s0);
+            s1 = _mm256_fmadd_ps(d1, d1, s1);
+        }
+        float sum = hsum_avx2(_mm256_add_ps(s0, s1));
+        for (; i < n; ++i) {
+            const float d = q[i] - half_to_float(h[i]);
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    /// \brief F16C half-precision decode, 8 per iteration.
+    MDBXC_TARGET_AVX2_F16C inline void decode_f16_avx2(const std::uint16_t* src, float* dst,
+                                                       std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+        }
+        for (; i < n; ++i) dst[i] = half_to_float(src[i]);
+    }
+
+    /// \brief AVX2 bfloat16 decode, 8 per iteration.
+    MDBXC_TARGET_AVX2 inline void decode_bf16_avx2(const std::uint16_t* src, float* dst,
+                                                   std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256i wide = _mm256_cvtepu16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+            _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16)));
+        }
+        for (; i < n; ++i) dst[i] = bfloat16_to_float(src[i]);
+    }
+
+    // Spills instead of _mm512_reduce_add_ps, which trips -Wuninitialized in GCC 12 headers.
+    /// \brief AVX2 lookup-table sum, gathering 8 table entries per iteration.
+    MDBXC_TARGET_AVX2 inline float pq_adc_avx2(const float* table, const std::uint8_t* codes,
+                                               std::size_t m) {
+        const __m256i rows = _mm256_setr_epi32(0, 256, 512, 768, 1024, 1280, 1536, 1792);
+        __m256 s0 = _mm256_setzero_ps();
+        std::size_t j = 0;
+        for (; j + 8 <= m; j += 8) {
+            const __m128i b = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(codes + j));
+            const __m256i idx = _mm256_add_epi32(_mm256_cvtepu8_epi32(b), rows);
+            s0 = _mm256_add_ps(s0, _mm256_i32gather_ps(table + j * 256, idx, 4));
+        }
+        float sum = hsum_avx2(s0);
+        for (; j < m; ++j) sum += table[j * 256 + codes[j]];
+        return sum;
+    }
+
+    MDBXC_TARGET_AVX512 inline float hsum_avx512(__m512 v) {
+        float lanes[16];
+        _mm512_storeu_ps(lanes, v);
+        float sum = 0.0f;
+        for (int i = 0; i < 16; ++i) sum += lanes[i];
+        return sum;
+    }
+
+    /// \brief AVX-512F dot product, 64 floats per iteration and a masked tail.
+    MDBXC_TARGET_AVX512 inline float dot_avx512(const float* a, const float* b, std::size_t n) {
+        __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+        __m512 s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            s0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), s0);
+            s1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), s1);
+            s2 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(b + i + 32), s2);
+            s3 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(b + i + 48), s3);
+        }
+        for (; i + 16 <= n; i += 16) {
+            s0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), s0);
+        }
+        if (i < n) {
+            const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+            s1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                                 _mm512_maskz_loadu_ps(mask, b + i), s1);
+        }
+        return hsum_avx512(_mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3)));
+    }
+
+    /// \brief AVX-512F squared L2 distance, 64 floats per iteration and a masked tail.
+    MDBXC_TARGET_AVX512 inline float l2sq_avx512(const float* a, const float* b, std::size_t n) {
+        __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+        __m512 s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            const __m512 d0 = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+            const __m512 d1 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16));
+            const __m512 d2 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(b + i + 32));
+            const __m512 d3 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(b + i + 48));
+            s0 = _mm512_fmadd_ps(d0, d0, s0);
+            s1 = _mm512_fmadd_ps(d1, d1, s1);
+            s2 = _mm512_fmadd_ps(d2, d2, s2);
+            s3 = _mm512_fmadd_ps(d3, d3, s3);
+        }
+        for (; i + 16 <= n; i += 16) {
+            const __m512 d = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+            s0 = _mm512_fmadd_ps(d, d, s0);
+        }
+        if (i < n) {
+            const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1u);
+            const __m512 d = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                                           _mm512_maskz_loadu_ps(mask, b + i));
+            s1 = _mm512_fmadd_ps(d, d, s1);
+        }
+        return hsum_avx512(_mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3)));
+    }
+
+#   if defined(__x86_64__) || defined(_M_X64)
+    /// \brief Hamming distance with the POPCNT instruction, four words per iteration.
+    MDBXC_TARGET_POPCNT inline std::uint32_t hamming_popcnt(const std::uint64_t* a,
+                                                            const std::uint64_t* b,
+                                                            std::size_t words) {
+        std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= words; i += 4) {
+            s0 += _mm_popcnt_u64(a[i] ^ b[i]);
+            s1 += _mm_popcnt_u64(a[i + 1] ^ b[i + 1]);
+            s2 += _mm_popcnt_u64(a[i + 2] ^ b[i + 2]);
+            s3 += _mm_popcnt_u64(a[i + 3] ^ b[i + 3]);
+        }
+        for (; i < words; ++i) s0 += _mm_popcnt_u64(a[i] ^ b[i]);
+        return static_cast<std::uint32_t>((s0 + s1) + (s2 + s3));
+    }
+#   endif
+
+    /// \brief CPU features relevant to the kernels, including OS register support.
+    struct X86Features {
+        bool avx2 = false;   ///< AVX2 and FMA.
+        bool f16c = false;   ///< F16C half-precision conversion.
+        bool avx512 = false; ///< AVX-512F.
+        bool popcnt = false; ///< POPCNT.
+    };
+
+    inline X86Features detect_x86_features() {
+        X86Features f;
+#       if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuid(regs, 0);
+        if (regs[0] < 7) return f;
+        __cpuid(regs, 1);
+        f.popcnt = (regs[2] & (1 << 23)) != 0;
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+        const bool fma = (regs[2] & (1 << 12)) != 0;
+        const bool f16c = (regs[2] & (1 << 29)) != 0;
+        if (!osxsave) return f;
+        const unsigned long long xcr0 = _xgetbv(0);
+        const bool ymm = (xcr0 & 0x6) == 0x6;
+        const bool zmm = (xcr0 & 0xe6) == 0xe6;
+        __cpuidex(regs, 7, 0);
+        f.avx2 = ymm && fma && (regs[1] & (1 << 5)) != 0;
+        f.f16c = ymm && f16c;
+        f.avx512 = zmm && (regs[1] & (1 << 16)) != 0;
+#       else
+        // __builtin_cpu_supports also checks that the OS saves the registers.
+        __builtin_cpu_init();
+        f.avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        // Older compilers do not know "f16c"; every AVX2 CPU shipped so far has it.
+        f.f16c = f.avx2;
+        f.avx512 = __builtin_cpu_supports("avx512f");
+        f.popcnt = __builtin_cpu_supports("popcnt");
+#       endif
+        return f;
+    }
+#   endif // MDBXC_VECTOR_SIMD_X86
+
+#   if defined(MDBXC_VECTOR_SIMD_NEON)
+    /// \brief NEON dot product, 16 floats per iteration.
+    inline float dot_neon(const float* a, const float* b, std::size_t n) {
+        float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+        float32x4_t s2 = vdupq_n_f32(0.0f), s3 = vdupq_n_f32(0.0f);
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            s0 = vfmaq_f32(s0, vld1q_f32(a + i), vld1q_f32(b + i));
+            s1 = vfmaq_f32(s1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+            s2 = vfmaq_f32(s2, vld1q_f32(a + i + 8), vld1q_f32(b + i + 8));
+            s3 = vfmaq_f32(s3, vld1q_f32(a + i + 12), vld1q_f32(b + i + 12));
+        }
+        for (; i + 4 <= n; i += 4) {
+            s0 = vfmaq_f32(s0, vld1q_f32(a + i), vld1q_f32(b + i));
+        }
+        float sum = vaddvq_f32(vaddq_f32(vaddq_f32(s0, s1), vaddq_f32(s2, s3)));
+        for (; i < n; ++i) sum += a[i] * b[i];
+        return sum;
+    }
+
+    /// \brief NEON squared L2 distance, 16 floats per iteration.
+    inline float l2sq_neon(const float* a, const float* b, std::size_t n) {
+        float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+        float32x4_t s2 = vdupq_n_f32(0.0f), s3 = vdupq_n_f32(0.0f);
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const float32x4_t d0 = vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+            const float32x4_t d1 = vsubq_f32(vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+            const float32x4_t d2 = vsubq_f32(vld1q_f32(a + i + 8), vld1q_f32(b + i + 8));
+            const float32x4_t d3 = vsubq_f32(vld1q_f32(a + i + 12), vld1q_f32(b + i + 12));
+            s0 = vfmaq_f32(s0, d0, d0);
+            s1 = vfmaq_f32(s1, d1, d1);
+            s2 = vfmaq_f32(s2, d2, d2);
+            s3 = vfmaq_f32(s3, d3, d3);
+        }
+        for (; i + 4 <= n; i += 4) {
+            const float32x4_t d = vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+            s0 = vfmaq_f32(s0, d, d);
+        }
+        float sum = vaddvq_f32(vaddq_f32(vaddq_f32(s0, s1), vaddq_f32(s2, s3)));
+        for (; i < n; ++i) {
+            const float d = a[i] - b[i];
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    /// \brief NEON dot product with int8 codes, 8 codes per iteration.
+    inline float dot_i8_neon(const float* q, const std::int8_t* c, float scale, std::size_t n) {
+        float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const int16x8_t w = vmovl_s8(vld1_s8(c + i));
+            s0 = vfmaq_f32(s0, vld1q_f32(q + i), vcvtq_f32_s32(vmovl_s16(vget_low_s16(w))));
+            s1 = vfmaq_f32(s1, vld1q_f32(q + i + 4), vcvtq_f32_s32(vmovl_s16(vget_high_s16(w))));
+        }
+        float sum = vaddvq_f32(vaddq_f32(s0, s1));
+        for (; i < n; ++i) sum += q[i] * c[i];
+        return sum * scale;
+    }
+
+    /// \brief NEON squared L2 distance to int8 codes, 8 codes per iteration.
+    inline float l2sq_i8_neon(const float* q, const std::int8_t* c, float scale, std::size_t n) {
+        float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const int16x8_t w = vmovl_s8(vld1_s8(c + i));
+            const float32x4_t d0 = vfmsq_n_f32(vld1q_f32(q + i),
+                                               vcvtq_f32_s32(vmovl_s16(vget_low_s16(w))), scale);
+            const float32x4_t d1 = vfmsq_n_f32(vld1q_f32(q + i + 4),
+                                               vcvtq_f32_s32(vmovl_s16(vget_high_s16(w))), scale);
+            s0 = vfmaq_f32(s0, d0, d0);
+            s1 = vfmaq_f32(s1, d1, d1);
+        }
+        float sum = vaddvq_f32(vaddq_f32(s0, s1));
+        for (; i < n; ++i) {
+            const float d = q[i] - c[i] * scale;
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    /// \brief NEON dot product with half-precision values, 8 per iteration.
+    inline float dot_f16_neon(const float* q, const std::uint16_t* h, std::size_t n) {
+        float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            s0 = vfmaq_f32(s0, vld1q_f32(q + i), vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(h + i))));
+            s1 = vfmaq_f32(s1, vld1q_f32(q + i + 4), vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(h + i + 4))));
+        }
+        float sum = vaddvq_f32(vaddq_f32(s0, s1));
+        for (; i < n; ++i) sum += q[i] * half_to_float(h[i]);
+        return sum;
+    }
+
+    /// \brief NEON squared L2 distance to half-precision values, 8 per iteration.
+    inline float l2sq_f16_neon(const float* q, const std::uint16_t* h, std::size_t n) {
+        float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const float32x4_t d0 = vsubq_f32(vld1q_f32(q + i),
+                                             vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(h + i))));
+            const float32x4_t d1 = vsubq_f32(vld1q_f32(q + i + 4),
+                                             vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(h + i + 4))));
+            s0 = vfmaq_f32(s0, d0, d0);
+            s1 = vfmaq_f32(s1, d1, d1);
+        }
+        float sum = vaddvq_f32(vaddq_f32(s0, s1));
+        for (; i < n; ++i) {
+            const float d = q[i] - half_to_float(h[i]);
+            sum += d * d;
+        }
+        return sum;
+    }
+    /// \brief NEON half-precision decode, 4 per iteration.
+    inline void decode_f16_neon(const std::uint16_t* src, float* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+        }
+        for (; i < n; ++i) dst[i] = half_to_float(src[i]);
+    }
+
+    /// \brief NEON bfloat16 decode, 4 per iteration.
+    inline void decode_bf16_neon(const std::uint16_t* src, float* dst, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            vst1q_f32(dst + i, vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(src + i), 16)));
+        }
+        for (; i < n; ++i) dst[i] = bfloat16_to_float(src[i]);
+    }
+#   endif // MDBXC_VECTOR_SIMD_NEON
+
+    /// \brief Returns the portable kernel set.
+    inline const DistanceKernels& scalar_distance_kernels() noexcept {
+        static const DistanceKernels kernels = {
+            &dot_scalar, &l2sq_scalar, "scalar",
+            &dot_i8_scalar, &l2sq_i8_scalar, &dot_f16_scalar, &l2sq_f16_scalar,
+            &pq_adc_scalar, &hamming_scalar, &decode_f16_scalar, &decode_bf16_scalar
+        };
+        return kernels;
+    }
+
+    /// \brief Returns the fastest kernel set supported by the running CPU.
+    /// \details Detection runs once; later calls return the cached set.
+    inline const DistanceKernels& distance_kernels() {
+        static const DistanceKernels kernels = []() -> DistanceKernels {
+#           if defined(MDBXC_VECTOR_SIMD_X86)
+            const X86Features f = detect_x86_features();
+            DistanceKernels k = scalar_distance_kernels();
+            if (f.avx2) {
+                k.dot = &dot_avx2;
+                k.l2sq = &l2sq_avx2;
+                k.name = "avx2";
+                // Quantized kernels use the AVX2 set on AVX-512 CPUs as well.
+                k.dot_i8 = &dot_i8_avx2;
+                k.l2sq_i8 = &l2sq_i8_avx2;
+                k.pq_adc = &pq_adc_avx2;
+                k.decode_bf16 = &decode_bf16_avx2;
+                if (f.f16c) {
+                    k.dot_f16 = &dot_f16_avx2;
+                    k.l2sq_f16 = &l2sq_f16_avx2;
+                    k.decode_f16 = &decode_f16_avx2;
+                }
+            }
+#           if defined(__x86_64__) || defined(_M_X64)
+            if (f.popcnt) {
+                k.hamming = &hamming_popcnt;
+            }
+#           endif
+            if (f.avx512) {
+                k.dot = &dot_avx512;
+                k.l2sq = &l2sq_avx512;
+                k.name = "avx512";
+            }
+            return k;
+#           elif defined(MDBXC_VECTOR_SIMD_NEON)
+            const DistanceKernels k = {
+                &dot_neon, &l2sq_neon, "neon",
+                &dot_i8_neon, &l2sq_i8_neon, &dot_f16_neon, &l2sq_f16_neon,
+                &pq_adc_scalar, &hamming_scalar, &decode_f16_neon, &decode_bf16_neon
+            };
+            return k;
+#           else
+            return scalar_distance_kernels();
+#           endif
+        }();
+        return kernels;
+    }
+
+} // namespace detail
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_DISTANCE_KERNELS_HPP_INCLUDED
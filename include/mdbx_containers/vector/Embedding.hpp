@@ -2,20 +2,47 @@
 #ifndef MDBX_CONTAINERS_HEADER_VECTOR_EMBEDDING_HPP_INCLUDED
 #define MDBX_CONTAINERS_HEADER_VECTOR_EMBEDDING_HPP_INCLUDED
 
+#include "DistanceKernels.hpp"
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #include <stdexcept>
 
 namespace mdbxc {
 
+    /// \brief On-disk precision of serialized embedding values.
+    /// \details Values are always \c float in memory; reduced precisions
+    /// round on \ref Embedding::to_bytes() and widen on read.
+    enum class EmbeddingPrecision : uint8_t {
+        FP32 = 0, ///< 32-bit floats; exact.
+        FP16 = 1, ///< IEEE half precision; half the size, 11-bit mantissa, range +-65504.
+        BF16 = 2  ///< Bfloat16; half the size, 8-bit mantissa, full float range.
+    };
+
+    /// \brief Non-owning view of embedding values, e.g. straight from an MDBX page.
+    /// \details Returned by \ref Embedding::view(); \c values points into the
+    /// serialized bytes or into caller scratch and lives only as long as they do.
+    struct EmbeddingView {
+        uint32_t dim = 0;              ///< Number of float components.
+        const float* values = nullptr; ///< First of \c dim values.
+    };
+
     /// \brief Dense float vector persisted by the vector store.
     ///
-    /// Serialized format is little-endian \c uint32_t dimension, little-endian
-    /// reserved \c uint32_t set to zero, followed by \c dim raw \c float values.
+    /// Serialized format is little-endian \c uint32_t dimension, one
+    /// \ref EmbeddingPrecision byte and three zero bytes, followed by \c dim
+    /// values in that precision and zero padding up to a multiple of 8 bytes.
+    /// The 8-byte header and padding keep every value length a multiple of 8,
+    /// so under 8-byte keys MDBX lays the values out aligned and \ref view()
+    /// reads fp32 values in place. Rows written before the precision byte
+    /// existed have it zero and read as fp32. \ref from_bytes() and
+    /// \ref view() also accept the unpadded length.
     struct Embedding {
         uint32_t dim = 0; ///< Number of float components.
         std::vector<float> values; ///< Dense vector values.
+        /// \brief Precision written by \ref to_bytes(); set by \ref from_bytes().
+        EmbeddingPrecision precision = EmbeddingPrecision::FP32;
 
         /// \brief Returns whether the value array is empty.
         bool empty() const noexcept {
@@ -33,20 +60,37 @@ namespace mdbxc {
             }
         }
 
-        /// \brief Serializes the embedding for MDBX storage.
+        /// \brief Returns a view of \c values.
+        EmbeddingView view() const noexcept {
+            EmbeddingView v;
+            v.dim = dim;
+            v.values = values.data();
+            return v;
+        }
+
+        /// \brief Serializes the embedding for MDBX storage in \ref precision.
         /// \return Binary representation suitable for table values.
         /// \throws std::invalid_argument if the embedding invariants are invalid.
         std::vector<uint8_t> to_bytes() const {
             validate();
-            std::vector<uint8_t> result;
-            result.reserve(8 + dim * sizeof(float));
-            result.resize(8 + dim * sizeof(float));
+            const std::size_t payload = static_cast<std::size_t>(dim) * value_size(precision);
+            std::vector<uint8_t> result(8 + ((payload + 7) & ~std::size_t(7)), 0);
             result[0] = static_cast<uint8_t>(dim & 0xFF);
             result[1] = static_cast<uint8_t>((dim >> 8) & 0xFF);
             result[2] = static_cast<uint8_t>((dim >> 16) & 0xFF);
             result[3] = static_cast<uint8_t>((dim >> 24) & 0xFF);
-            result[4] = result[5] = result[6] = result[7] = 0;
-            std::memcpy(result.data() + 8, values.data(), dim * sizeof(float));
+            result[4] = static_cast<uint8_t>(precision);
+            uint8_t* out = result.data() + 8;
+            if (precision == EmbeddingPrecision::FP32) {
+                std::memcpy(out, values.data(), payload);
+                return result;
+            }
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const uint16_t h = precision == EmbeddingPrecision::FP16
+                    ? detail::float_to_half(values[i])
+                    : detail::float_to_bfloat16(values[i]);
+                std::memcpy(out + i * sizeof(h), &h, sizeof(h));
+            }
             return result;
         }
 
@@ -56,6 +100,78 @@ namespace mdbxc {
         /// \return Restored embedding.
         /// \throws std::runtime_error if the binary format is invalid.
         static Embedding from_bytes(const void* data, std::size_t len) {
+            Embedding e;
+            e.dim = decode_header(data, len, e.precision);
+            e.values.resize(e.dim);
+            const uint8_t* p = static_cast<const uint8_t*>(data) + 8;
+            if (e.precision == EmbeddingPrecision::FP32) {
+                std::memcpy(e.values.data(), p, static_cast<std::size_t>(e.dim) * sizeof(float));
+            } else {
+                decode_reduced(p, e.dim, e.precision, e.values.data());
+            }
+            return e;
+        }
+
+        /// \brief Views serialized embedding bytes without allocating.
+        /// \details When fp32 values are float-aligned in \p data the view
+        /// points into \p data; otherwise they are copied, and fp16 or bf16
+        /// values widened with the SIMD decode kernels, into \p scratch,
+        /// whose capacity is reused across calls.
+        /// \param data Pointer to serialized bytes.
+        /// \param len Serialized byte length.
+        /// \param scratch Fallback storage for unaligned values.
+        /// \return View valid while \p data and \p scratch are unchanged.
+        /// \throws std::runtime_error if the binary format is invalid.
+        static EmbeddingView view(const void* data, std::size_t len, std::vector<float>& scratch) {
+            EmbeddingView v;
+            EmbeddingPrecision stored = EmbeddingPrecision::FP32;
+            v.dim = decode_header(data, len, stored);
+            const uint8_t* p = static_cast<const uint8_t*>(data) + 8;
+            if (stored != EmbeddingPrecision::FP32) {
+                scratch.resize(v.dim);
+                decode_reduced(p, v.dim, stored, scratch.data());
+                v.values = scratch.data();
+            } else if (reinterpret_cast<std::uintptr_t>(p) % alignof(float) == 0) {
+                v.values = reinterpret_cast<const float*>(p);
+            } else {
+                scratch.resize(v.dim);
+                std::memcpy(scratch.data(), p, static_cast<std::size_t>(v.dim) * sizeof(float));
+                v.values = scratch.data();
+            }
+            return v;
+        }
+
+        /// \brief Returns the serialized size of one value in \p precision.
+        static std::size_t value_size(EmbeddingPrecision precision) noexcept {
+            return precision == EmbeddingPrecision::FP32 ? sizeof(float) : sizeof(uint16_t);
+        }
+
+    private:
+        /// \brief Widens \p dim 16-bit values at \p p into \p out.
+        static void decode_reduced(const uint8_t* p, uint32_t dim,
+                                   EmbeddingPrecision precision, float* out) {
+            const detail::DistanceKernels& kernels = detail::distance_kernels();
+            if (reinterpret_cast<std::uintptr_t>(p) % alignof(uint16_t) == 0) {
+                const uint16_t* src = reinterpret_cast<const uint16_t*>(p);
+                if (precision == EmbeddingPrecision::FP16) {
+                    kernels.decode_f16(src, out, dim);
+                } else {
+                    kernels.decode_bf16(src, out, dim);
+                }
+                return;
+            }
+            for (uint32_t i = 0; i < dim; ++i) {
+                uint16_t h;
+                std::memcpy(&h, p + static_cast<std::size_t>(i) * sizeof(h), sizeof(h));
+                out[i] = precision == EmbeddingPrecision::FP16
+                    ? detail::half_to_float(h)
+                    : detail::bfloat16_to_float(h);
+            }
+        }
+
+        /// \brief Validates serialized bytes and returns their dimension and precision.
+        static uint32_t decode_header(const void* data, std::size_t len,
+                                      EmbeddingPrecision& precision) {
             if (data == nullptr) {
                 throw std::runtime_error("Embedding binary format data is null");
             }
@@ -67,25 +183,28 @@ namespace mdbxc {
                          | (static_cast<uint32_t>(p[1]) << 8)
                          | (static_cast<uint32_t>(p[2]) << 16)
                          | (static_cast<uint32_t>(p[3]) << 24);
-            uint32_t reserved = static_cast<uint32_t>(p[4])
-                              | (static_cast<uint32_t>(p[5]) << 8)
-                              | (static_cast<uint32_t>(p[6]) << 16)
-                              | (static_cast<uint32_t>(p[7]) << 24);
-            if (reserved != 0) {
+            if (p[4] > static_cast<uint8_t>(EmbeddingPrecision::BF16)) {
+                throw std::runtime_error("Embedding binary format precision is unknown");
+            }
+            if (p[5] != 0 || p[6] != 0 || p[7] != 0) {
                 throw std::runtime_error("Embedding binary format reserved field is non-zero");
             }
-            std::size_t expected_payload = static_cast<std::size_t>(dim) * sizeof(float);
-            if (len != 8 + expected_payload) {
+            precision = static_cast<EmbeddingPrecision>(p[4]);
+            const std::size_t expected_payload = static_cast<std::size_t>(dim) * value_size(precision);
+            const std::size_t padded_payload = (expected_payload + 7) & ~std::size_t(7);
+            if (len == 8 + padded_payload && padded_payload != expected_payload) {
+                for (std::size_t i = 8 + expected_payload; i < len; ++i) {
+                    if (p[i] != 0) {
+                        throw std::runtime_error("Embedding binary format padding is non-zero");
+                    }
+                }
+            } else if (len != 8 + expected_payload) {
                 throw std::runtime_error("Embedding binary format size mismatch");
             }
             if (dim == 0) {
                 throw std::runtime_error("Embedding dimension is zero in binary format");
             }
-            Embedding e;
-            e.dim = dim;
-            e.values.resize(dim);
-            std::memcpy(e.values.data(), p + 8, expected_payload);
-            return e;
+            return dim;
         }
     };
 
@@ -4,11 +4,18 @@
 
 #include "Embedding.hpp"
 #include "VectorMetric.hpp"
+#include "VectorQuantization.hpp"
+#include "VectorFilter.hpp"
+#include "DistanceKernels.hpp"
+#include "../detail/MappedFile.hpp"
+#include <string>
 #include <vector>
 #include <cstdint>
 #include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>
 
 namespace mdbxc {
 
@@ -18,36 +25,176 @@ namespace mdbxc {
         float score = 0.0f; ///< Metric score; larger values rank first.
     };
 
-    /// \brief In-memory exact vector index.
+    /// \brief In-memory brute-force vector index.
     ///
-    /// \warning Search is exact \c O(N*dim). All vectors are held in RAM.
+    /// Scores are computed with the SIMD kernels of \ref detail::distance_kernels()
+    /// selected for the running CPU. With \ref VectorQuantization::INT8 or
+    /// \ref VectorQuantization::FP16 vectors are held in compressed form and
+    /// scores are approximate; \ref rescore() recomputes exact scores from
+    /// full-precision embeddings.
+    ///
+    /// With \ref VectorQuantization::PQ vectors stay 32-bit floats until
+    /// \ref train() learns the codebooks; from then on every row is one byte
+    /// per subspace. A query builds a table of its scores against all
+    /// centroids once, and each row is scored by summing \c subspaces table
+    /// entries (asymmetric distance computation).
+    ///
+    /// With \ref VectorQuantization::BINARY each component keeps only its
+    /// sign bit, and the score is the negated Hamming distance between the
+    /// sign bits of the query and the row, counted with popcount. It is a
+    /// coarse first pass meant to be followed by \ref rescore().
+    ///
+    /// With a non-zero \ref PrefixParams::dim the index keeps a second,
+    /// compact block with the leading components of every row (renormalized
+    /// for cosine). Searches scan only that block, then re-score the best
+    /// candidates from the stored rows at the full dimension, which is exact
+    /// with \ref VectorQuantization::NONE.
+    ///
+    /// \warning Search is \c O(N*dim). All vectors are held in RAM.
     /// The class does not synchronize concurrent mutation and search.
     class FlatVectorIndex {
     public:
         /// \brief Creates an empty index for the given metric.
         /// \param metric Scoring metric used for all vectors.
-        explicit FlatVectorIndex(VectorMetric metric = VectorMetric::COSINE);
+        /// \param quantization In-memory representation of stored vectors.
+        /// \param pq Codebook parameters used with \ref VectorQuantization::PQ.
+        /// \param prefix Truncated first-pass parameters; disabled by default.
+        /// \throws std::invalid_argument if \p quantization is \c PQ and
+        ///         \c pq.subspaces is zero, or \p prefix is enabled with a zero
+        ///         \c rerank_factor or with \c PQ or \c BINARY quantization.
+        explicit FlatVectorIndex(VectorMetric metric = VectorMetric::COSINE,
+                                 VectorQuantization quantization = VectorQuantization::NONE,
+                                 const PqParams& pq = PqParams(),
+                                 const PrefixParams& prefix = PrefixParams());
 
-        /// \brief Removes all vectors and resets the index dimension.
+        /// \brief Removes all vectors and PQ codebooks and resets the index dimension.
         void clear();
 
+        /// \brief Learns PQ codebooks from the stored vectors and encodes every row.
+        /// \details Runs k-means with 256 centroids in each subspace on at
+        /// most \c max_samples sampled vectors; subspaces are trained in
+        /// parallel. Does nothing when the index is empty or already trained;
+        /// to retrain, re-add the full-precision vectors to a new index.
+        /// \param threads Worker threads; 0 uses the hardware concurrency.
+        /// \throws std::logic_error if the index does not use \ref VectorQuantization::PQ.
+        /// \throws std::invalid_argument if \c subspaces does not divide the dimension.
+        void train(std::size_t threads = 1);
+
+        /// \brief Returns whether PQ codebooks are set.
+        bool trained() const noexcept;
+
+        /// \brief Returns the PQ codebooks, <tt>subspaces * 256 * dim / subspaces</tt>
+        /// floats ordered by subspace, then centroid; empty when untrained.
+        const std::vector<float>& codebooks() const noexcept;
+
+        /// \brief Restores codebooks returned by \ref codebooks() into an empty index.
+        /// \details Sets the index dimension to <tt>codebooks.size() / 256</tt>.
+        /// \throws std::logic_error if the index does not use \ref VectorQuantization::PQ.
+        /// \throws std::invalid_argument if the index is not empty or the size
+        ///         does not match \c subspaces.
+        void set_codebooks(const std::vector<float>& codebooks);
+
         /// \brief Adds a vector id to the index.
+        /// \details Re-adding a present id replaces its vector.
         /// \param id Caller-owned stable id.
         /// \param embedding Dense embedding to index.
         /// \throws std::invalid_argument if the embedding is invalid or has a mismatched dimension.
         void add(uint64_t id, const Embedding& embedding);
 
+        /// \brief Adds a vector id from a view, e.g. one read in place by \ref Embedding::view().
+        /// \param id Caller-owned stable id.
+        /// \param embedding Values to index; read only during the call.
+        /// \throws std::invalid_argument if \c dim is zero, \c values is null,
+        ///         or the dimension is mismatched.
+        void add(uint64_t id, const EmbeddingView& embedding);
+
         /// \brief Removes a vector id from the index.
+        /// \details Finds the row through the id map and moves the last row
+        /// into it, so the cost is \c O(dim).
         /// \param id Id to remove.
         /// \return \c true if the id was present.
         bool erase(uint64_t id);
 
+        /// \brief Removes several ids in one compaction pass over the index.
+        /// \details Survivors keep their relative order; \c O(N + ids.size()).
+        /// \param ids Ids to remove; absent and repeated ids are ignored.
+        /// \return Number of removed vectors.
+        std::size_t erase_many(const std::vector<uint64_t>& ids);
+
+        /// \brief Streams the stored rows to \p sink as host-endian bytes.
+        /// \details Writes a header (format, metric, quantization, dimension,
+        /// PQ subspaces, count), then the id array, the vector block and, for
+        /// INT8, the scales or, for trained PQ, the codebooks. \ref load()
+        /// reads it back without re-normalizing.
+        /// \param sink Invoked as <tt>sink(const void* data, std::size_t size)</tt>.
+        template<typename SinkT>
+        void save(SinkT sink) const;
+
+        /// \brief Replaces the contents with bytes written by \ref save().
+        /// \param source Invoked as <tt>source(void* data, std::size_t size)</tt>;
+        ///        must fill all \c size bytes or throw.
+        /// \throws std::runtime_error if the header is not a snapshot of this
+        ///         format, metric and quantization; the index is then unchanged.
+        template<typename SourceT>
+        void load(SourceT source);
+
+        /// \brief Replaces the contents with a snapshot file mapped in place.
+        /// \details \p path holds bytes written by \ref save(). Ids (and INT8
+        /// scales) are copied to the heap, but the vector block stays in a
+        /// private copy-on-write mapping, so processes mapping the same file
+        /// share its pages through the page cache. Added vectors go to the
+        /// heap; an erase moves a row into the mapping, which copies only the
+        /// touched page. Copies of the index own their rows on the heap.
+        /// \param path Snapshot file; replace it with a new file rather than
+        ///        rewriting it while mapped.
+        /// \throws std::runtime_error if the file cannot be mapped or is not a
+        ///         complete snapshot of this metric and quantization; the index
+        ///         is then unchanged.
+        void map(const std::string& path);
+
+        /// \brief Returns the bytes of stored vectors served from a mapped file.
+        std::size_t mapped_bytes() const noexcept;
+
         /// \brief Searches the index and returns the best matches.
+        /// \details Keeps a bounded heap of \p top_k matches, so memory is
+        /// \c O(top_k) regardless of the index size. With several threads the
+        /// stored vectors are split into cache-sized blocks that the threads
+        /// claim in turn; per-thread heaps are merged at the end.
+        /// \param query Query embedding.
+        /// \param top_k Maximum number of matches to return.
+        /// \param threads Worker threads, including the caller; 0 uses the
+        ///        hardware concurrency. Capped at the number of blocks.
+        /// \return Matches ordered by descending score.
+        /// \throws std::invalid_argument if the query is invalid or has a mismatched dimension.
+        std::vector<VectorMatch> search(const Embedding& query, std::size_t top_k,
+                                        std::size_t threads = 1) const;
+
+        /// \brief Searches only the ids admitted by \p filter.
+        /// \details Rejected rows are skipped inside the scan before scoring,
+        /// so the result holds \c min(top_k, admitted ids) matches.
         /// \param query Query embedding.
         /// \param top_k Maximum number of matches to return.
+        /// \param filter Ids eligible for the result.
+        /// \param threads Worker threads, as for the unfiltered overload.
         /// \return Matches ordered by descending score.
         /// \throws std::invalid_argument if the query is invalid or has a mismatched dimension.
-        std::vector<VectorMatch> search(const Embedding& query, std::size_t top_k) const;
+        std::vector<VectorMatch> search(const Embedding& query, std::size_t top_k,
+                                        const VectorFilter& filter,
+                                        std::size_t threads = 1) const;
+
+        /// \brief Searches several queries in one pass over the index.
+        /// \details Every block of stored vectors is scored against all
+        /// queries while it is in cache, so each vector is loaded from memory
+        /// once per call. Each query keeps its own bounded heap of \p top_k
+        /// matches.
+        /// \param queries Query embeddings.
+        /// \param top_k Maximum number of matches per query.
+        /// \param threads Worker threads, as for \ref search().
+        /// \return One result list per query, in query order, each ordered by descending score.
+        /// \throws std::invalid_argument if a query is invalid or has a mismatched dimension.
+        std::vector<std::vector<VectorMatch>> search_batch(const std::vector<Embedding>& queries,
+                                                           std::size_t top_k,
+                                                           std::size_t threads = 1) const;
 
         /// \brief Returns the number of indexed vectors.
         std::size_t size() const noexcept;
@@ -55,14 +202,187 @@ namespace mdbxc {
         /// \brief Returns the active index dimension, or zero when empty.
         uint32_t dim() const noexcept;
 
+        /// \brief Returns the instruction set used for scoring: "avx512", "avx2", "neon" or "scalar".
+        const char* kernel_name() const noexcept;
+
+        /// \brief Returns the in-memory representation of stored vectors.
+        VectorQuantization quantization() const noexcept;
+
+        /// \brief Returns the product quantization parameters.
+        const PqParams& pq_params() const noexcept;
+
+        /// \brief Returns the truncated first-pass parameters.
+        const PrefixParams& prefix_params() const noexcept;
+
+        /// \brief Returns the heap bytes held by stored vectors, codes,
+        /// scales and prefixes; mapped rows are reported by \ref mapped_bytes().
+        std::size_t memory_bytes() const noexcept;
+
+        /// \brief Scores \p candidates exactly and returns the best \p top_k.
+        /// \details Used to re-rank matches of a quantized index from
+        /// full-precision embeddings. Applies the index metric, including
+        /// cosine normalization, without touching the stored vectors.
+        /// \param query Query embedding.
+        /// \param candidates Ids with their full-precision embeddings.
+        /// \param top_k Maximum number of matches to return.
+        /// \return Matches ordered by descending exact score.
+        /// \throws std::invalid_argument if an embedding is invalid or dimensions differ.
+        std::vector<VectorMatch> rescore(const Embedding& query,
+                                         const std::vector<std::pair<uint64_t, Embedding>>& candidates,
+                                         std::size_t top_k) const;
+
+        /// \brief Scores candidate views exactly and returns the best \p top_k.
+        /// \details Same as the \ref Embedding overload, for values read in
+        /// place from storage without a per-candidate copy.
+        /// \throws std::invalid_argument if the query is invalid, a view is
+        ///         empty, or dimensions differ.
+        std::vector<VectorMatch> rescore(const Embedding& query,
+                                         const std::vector<std::pair<uint64_t, EmbeddingView>>& candidates,
+                                         std::size_t top_k) const;
+
     private:
+        /// \brief Leading row block of a mapped snapshot; a copy owns its bytes.
+        class MappedRows {
+        public:
+            MappedRows() = default;
+
+            MappedRows(detail::MappedFile file, std::size_t offset, std::size_t size)
+                : m_file(std::move(file)), m_data(m_file.data() + offset), m_size(size) {}
+
+            MappedRows(const MappedRows& other)
+                : m_owned(other.m_data, other.m_data + other.m_size),
+                  m_data(m_owned.empty() ? nullptr : m_owned.data()),
+                  m_size(other.m_size) {}
+
+            MappedRows(MappedRows&& other) noexcept
+                : m_file(std::move(other.m_file)), m_owned(std::move(other.m_owned)),
+                  m_data(other.m_data), m_size(other.m_size) {
+                other.m_data = nullptr;
+                other.m_size = 0;
+            }
+
+            MappedRows& operator=(MappedRows other) noexcept {
+                std::swap(m_file, other.m_file);
+                m_owned.swap(other.m_owned);
+                std::swap(m_data, other.m_data);
+                std::swap(m_size, other.m_size);
+                return *this;
+            }
+
+            unsigned char* data() const noexcept { return m_data; }
+
+        private:
+            detail::MappedFile m_file;
+            std::vector<unsigned char> m_owned; ///< Bytes of a copied block.
+            unsigned char* m_data = nullptr;
+            std::size_t m_size = 0;
+        };
+
         VectorMetric m_metric;
+        VectorQuantization m_quantization;
+        const detail::DistanceKernels* m_kernels;
         uint32_t m_dim = 0;
         std::vector<uint64_t> m_ids;
-        std::vector<float> m_vectors;
+        std::vector<float> m_vectors;        ///< NONE: \c m_dim floats per heap row.
+        std::vector<std::int8_t> m_codes;    ///< INT8: \c m_dim codes per heap row.
+        std::vector<float> m_scales;         ///< INT8: one scale per id, mapped rows included.
+        std::vector<std::uint16_t> m_halfs;  ///< FP16: \c m_dim halves per heap row.
+        PqParams m_pq;
+        std::vector<float> m_codebooks;      ///< PQ: 256 centroids per subspace; empty until trained.
+        std::vector<std::uint8_t> m_pq_codes; ///< Trained PQ: \c subspaces codes per heap row.
+        std::vector<std::uint64_t> m_bits;   ///< BINARY: sign bits, whole words per heap row.
+        PrefixParams m_prefix_params;
+        std::vector<float> m_prefix;         ///< Prefix mode: leading components per id, mapped rows included.
+        std::unordered_map<uint64_t, std::size_t> m_slots; ///< Id to row.
+        MappedRows m_mapped;                 ///< Rows below \c m_mapped_rows.
+        std::size_t m_mapped_rows = 0;
+
+        void check_dim(const EmbeddingView& embedding);
+        void move_row(std::size_t from, std::size_t to);
+        void truncate(std::size_t rows);
+        std::size_t row_bytes() const noexcept;
+        void check_header(const unsigned char* header, uint32_t& dim, std::uint64_t& count,
+                          uint32_t& subspaces) const;
+        bool pq_coded() const noexcept;
+        void pq_encode(const float* vec, std::uint8_t* codes) const;
+        std::uint8_t pq_nearest(const float* centroids, const float* point,
+                                std::size_t sub_dim) const;
+        std::vector<float> pq_table(const float* query_vec) const;
+        void train_subspace(std::size_t sub, const std::vector<float>& samples, std::size_t count);
+
+        /// \brief Query forms used by the scan: prepared floats, a PQ table or sign bits.
+        struct ScanQuery {
+            const float* vec = nullptr;
+            std::vector<float> table;        ///< Trained PQ: scores against every centroid.
+            std::vector<std::uint64_t> bits; ///< BINARY: sign bits.
+            std::vector<float> prefix;       ///< Prefix mode: leading components.
+        };
+
+        ScanQuery make_scan_query(const float* query_vec) const;
+        std::size_t bit_words() const noexcept;
+        void pack_signs(const float* vec, std::uint64_t* bits) const;
+        bool prefix_active() const noexcept;
+        void store_prefix(const float* vec, float* prefix) const;
+        void rebuild_prefix();
+
+        /// \brief Returns the sign bits of row \p row in the mapped block or the heap.
+        const std::uint64_t* bits_row(std::size_t row) const {
+            return row < m_mapped_rows
+                ? reinterpret_cast<const std::uint64_t*>(m_mapped.data()) + row * bit_words()
+                : &m_bits[(row - m_mapped_rows) * bit_words()];
+        }
+
+        std::uint64_t* bits_row(std::size_t row) {
+            return const_cast<std::uint64_t*>(static_cast<const FlatVectorIndex&>(*this).bits_row(row));
+        }
+
+        /// \brief Returns the PQ codes of row \p row in the mapped block or the heap.
+        const std::uint8_t* pq_row(std::size_t row) const {
+            return row < m_mapped_rows
+                ? m_mapped.data() + row * m_pq.subspaces
+                : &m_pq_codes[(row - m_mapped_rows) * m_pq.subspaces];
+        }
+
+        std::uint8_t* pq_row(std::size_t row) {
+            return const_cast<std::uint8_t*>(static_cast<const FlatVectorIndex&>(*this).pq_row(row));
+        }
+
+        /// \brief Returns row \p row of the mapped block or of \p heap.
+        template<typename T>
+        T* row_at(std::vector<T>& heap, std::size_t row) {
+            return row < m_mapped_rows
+                ? reinterpret_cast<T*>(m_mapped.data()) + row * m_dim
+                : &heap[(row - m_mapped_rows) * m_dim];
+        }
+
+        template<typename T>
+        const T* row_at(const std::vector<T>& heap, std::size_t row) const {
+            return row < m_mapped_rows
+                ? reinterpret_cast<const T*>(m_mapped.data()) + row * m_dim
+                : &heap[(row - m_mapped_rows) * m_dim];
+        }
+        float compute_score(const float* query_vec, std::size_t row) const;
+        float score_row(const ScanQuery& query, std::size_t row) const;
+        float exact_score(const float* query_vec, const float* candidate_vec) const;
+        std::vector<float> prepare_query(const Embedding& query) const;
+
+        /// \brief Snapshot header tag, "MXFV" in little-endian byte order.
+        static const std::uint32_t snapshot_magic = 0x5646584Du;
+        static const std::uint16_t snapshot_version = 1;
+
+        /// \brief Bytes of stored vectors per scan block; sized to stay in L2.
+        static const std::size_t scan_block_bytes = 256 * 1024;
 
-        void check_dim(const Embedding& embedding);
-        float compute_score(const float* query_vec, const float* candidate_vec) const;
+        /// \brief Scores prepared queries against every stored vector admitted
+        /// by \p filter, or every vector when it is null.
+        /// \details In prefix mode the scan keeps \c rerank_factor times more
+        /// candidates and re-scores them at the full dimension.
+        std::vector<std::vector<VectorMatch>> scan(const std::vector<std::vector<float>>& query_vecs,
+                                                   std::size_t top_k, std::size_t threads,
+                                                   const VectorFilter* filter = nullptr) const;
+        static bool better_match(const VectorMatch& a, const VectorMatch& b) noexcept;
+        static void push_top_k(std::vector<VectorMatch>& heap, std::size_t top_k,
+                               uint64_t id, float score);
     };
 
 } // namespace mdbxc
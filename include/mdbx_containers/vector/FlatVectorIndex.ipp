@@ -1,21 +1,55 @@
 #include <cstring>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <thread>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace mdbxc {
 
-    inline FlatVectorIndex::FlatVectorIndex(VectorMetric metric)
-        : m_metric(metric) {}
+    inline FlatVectorIndex::FlatVectorIndex(VectorMetric metric, VectorQuantization quantization,
+                                            const PqParams& pq, const PrefixParams& prefix)
+        : m_metric(metric), m_quantization(quantization), m_kernels(&detail::distance_kernels()),
+          m_pq(pq), m_prefix_params(prefix) {
+        if (quantization == VectorQuantization::PQ && pq.subspaces == 0) {
+            throw std::invalid_argument("FlatVectorIndex PQ subspaces must be positive");
+        }
+        if (prefix.dim != 0) {
+            if (prefix.rerank_factor == 0) {
+                throw std::invalid_argument("FlatVectorIndex prefix rerank factor must be positive");
+            }
+            if (quantization == VectorQuantization::PQ || quantization == VectorQuantization::BINARY) {
+                throw std::invalid_argument("FlatVectorIndex prefix search does not support PQ or BINARY");
+            }
+        }
+    }
 
     inline void FlatVectorIndex::clear() {
         m_ids.clear();
         m_vectors.clear();
+        m_codes.clear();
+        m_scales.clear();
+        m_halfs.clear();
+        m_codebooks.clear();
+        m_pq_codes.clear();
+        m_bits.clear();
+        m_prefix.clear();
+        m_slots.clear();
+        m_mapped = MappedRows();
+        m_mapped_rows = 0;
         m_dim = 0;
     }
 
-    inline void FlatVectorIndex::check_dim(const Embedding& embedding) {
-        embedding.validate();
+    inline void FlatVectorIndex::check_dim(const EmbeddingView& embedding) {
+        if (embedding.dim == 0) {
+            throw std::invalid_argument("Embedding dimension is zero");
+        }
+        if (embedding.values == nullptr) {
+            throw std::invalid_argument("Embedding view has no values");
+        }
         if (m_dim == 0) {
             m_dim = embedding.dim;
         } else if (embedding.dim != m_dim) {
@@ -24,11 +58,21 @@ namespace mdbxc {
     }
 
     inline void FlatVectorIndex::add(uint64_t id, const Embedding& embedding) {
+        embedding.validate();
+        add(id, embedding.view());
+    }
+
+    inline void FlatVectorIndex::add(uint64_t id, const EmbeddingView& embedding) {
         check_dim(embedding);
+        if (m_slots.count(id) != 0) {
+            const uint32_t dim = m_dim;
+            erase(id);
+            m_dim = dim;
+        }
         std::vector<float> stored(m_dim);
         if (m_metric == VectorMetric::COSINE) {
             float norm = 0.0f;
-            for (std::size_t i = 0; i < embedding.values.size(); ++i) {
+            for (std::size_t i = 0; i < m_dim; ++i) {
                 norm += embedding.values[i] * embedding.values[i];
             }
             norm = std::sqrt(norm);
@@ -40,53 +84,508 @@ namespace mdbxc {
                 std::fill(stored.begin(), stored.end(), 0.0f);
             }
         } else {
-            std::memcpy(stored.data(), embedding.values.data(), m_dim * sizeof(float));
+            std::memcpy(stored.data(), embedding.values, m_dim * sizeof(float));
+        }
+        if (prefix_active()) {
+            const std::size_t offset = m_prefix.size();
+            m_prefix.resize(offset + m_prefix_params.dim);
+            store_prefix(stored.data(), &m_prefix[offset]);
+        }
+        if (pq_coded()) {
+            const std::size_t offset = m_pq_codes.size();
+            m_pq_codes.resize(offset + m_pq.subspaces);
+            pq_encode(stored.data(), &m_pq_codes[offset]);
+            m_slots[id] = m_ids.size();
+            m_ids.push_back(id);
+            return;
+        }
+        switch (m_quantization) {
+        case VectorQuantization::INT8: {
+            // Symmetric: code * scale reconstructs the value, codes in [-127, 127].
+            float max_abs = 0.0f;
+            for (std::size_t i = 0; i < m_dim; ++i) {
+                max_abs = std::max(max_abs, std::fabs(stored[i]));
+            }
+            const float scale = max_abs > 0.0f ? max_abs / 127.0f : 0.0f;
+            const float inv = max_abs > 0.0f ? 127.0f / max_abs : 0.0f;
+            const std::size_t offset = m_codes.size();
+            m_codes.resize(offset + m_dim);
+            for (std::size_t i = 0; i < m_dim; ++i) {
+                const long code = std::lround(stored[i] * inv);
+                m_codes[offset + i] = static_cast<std::int8_t>(std::max(-127L, std::min(127L, code)));
+            }
+            m_scales.push_back(scale);
+            break;
+        }
+        case VectorQuantization::FP16: {
+            const std::size_t offset = m_halfs.size();
+            m_halfs.resize(offset + m_dim);
+            for (std::size_t i = 0; i < m_dim; ++i) {
+                m_halfs[offset + i] = detail::float_to_half(stored[i]);
+            }
+            break;
+        }
+        case VectorQuantization::BINARY: {
+            const std::size_t offset = m_bits.size();
+            m_bits.resize(offset + bit_words());
+            pack_signs(stored.data(), &m_bits[offset]);
+            break;
         }
-        m_ids.reserve(m_ids.size() + 1);
-        m_vectors.reserve(m_vectors.size() + m_dim);
+        default:
+            m_vectors.insert(m_vectors.end(), stored.begin(), stored.end());
+            break;
+        }
+        m_slots[id] = m_ids.size();
         m_ids.push_back(id);
-        m_vectors.insert(m_vectors.end(), stored.begin(), stored.end());
+    }
+
+    inline void FlatVectorIndex::move_row(std::size_t from, std::size_t to) {
+        m_ids[to] = m_ids[from];
+        m_slots[m_ids[to]] = to;
+        if (prefix_active()) {
+            std::memcpy(&m_prefix[to * m_prefix_params.dim], &m_prefix[from * m_prefix_params.dim],
+                        m_prefix_params.dim * sizeof(float));
+        }
+        if (pq_coded()) {
+            std::memcpy(pq_row(to), pq_row(from), m_pq.subspaces);
+            return;
+        }
+        switch (m_quantization) {
+        case VectorQuantization::INT8:
+            std::memcpy(row_at(m_codes, to), row_at(m_codes, from), m_dim);
+            m_scales[to] = m_scales[from];
+            break;
+        case VectorQuantization::FP16:
+            std::memcpy(row_at(m_halfs, to), row_at(m_halfs, from),
+                        m_dim * sizeof(std::uint16_t));
+            break;
+        case VectorQuantization::BINARY:
+            std::memcpy(bits_row(to), bits_row(from), bit_words() * sizeof(std::uint64_t));
+            break;
+        default:
+            std::memcpy(row_at(m_vectors, to), row_at(m_vectors, from),
+                        m_dim * sizeof(float));
+            break;
+        }
+    }
+
+    inline void FlatVectorIndex::truncate(std::size_t rows) {
+        m_ids.resize(rows);
+        if (rows < m_mapped_rows) {
+            m_mapped_rows = rows;
+        }
+        const std::size_t heap = (rows - m_mapped_rows) * m_dim;
+        if (prefix_active()) {
+            m_prefix.resize(rows * m_prefix_params.dim);
+        }
+        if (pq_coded()) {
+            m_pq_codes.resize((rows - m_mapped_rows) * m_pq.subspaces);
+        } else {
+            switch (m_quantization) {
+            case VectorQuantization::INT8:
+                m_codes.resize(heap);
+                m_scales.resize(rows);
+                break;
+            case VectorQuantization::FP16:
+                m_halfs.resize(heap);
+                break;
+            case VectorQuantization::BINARY:
+                m_bits.resize((rows - m_mapped_rows) * bit_words());
+                break;
+            default:
+                m_vectors.resize(heap);
+                break;
+            }
+        }
+        if (rows == 0) {
+            m_mapped = MappedRows();
+            // Codebooks fix the dimension of a trained PQ index.
+            if (m_codebooks.empty()) {
+                m_dim = 0;
+            }
+        }
+    }
+
+    inline std::size_t FlatVectorIndex::row_bytes() const noexcept {
+        if (pq_coded()) {
+            return m_pq.subspaces;
+        }
+        switch (m_quantization) {
+        case VectorQuantization::INT8:
+            return m_dim;
+        case VectorQuantization::FP16:
+            return m_dim * sizeof(std::uint16_t);
+        case VectorQuantization::BINARY:
+            return bit_words() * sizeof(std::uint64_t);
+        default:
+            return m_dim * sizeof(float);
+        }
     }
 
     inline bool FlatVectorIndex::erase(uint64_t id) {
+        const std::unordered_map<uint64_t, std::size_t>::iterator it = m_slots.find(id);
+        if (it == m_slots.end()) {
+            return false;
+        }
+        const std::size_t slot = it->second;
+        const std::size_t last = m_ids.size() - 1;
+        m_slots.erase(it);
+        if (slot != last) {
+            move_row(last, slot);
+        }
+        truncate(last);
+        return true;
+    }
+
+    inline std::size_t FlatVectorIndex::erase_many(const std::vector<uint64_t>& ids) {
+        if (ids.empty() || m_ids.empty()) {
+            return 0;
+        }
+        std::vector<char> doomed(m_ids.size(), 0);
+        std::size_t removed = 0;
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            const std::unordered_map<uint64_t, std::size_t>::iterator it = m_slots.find(ids[i]);
+            if (it != m_slots.end()) {
+                doomed[it->second] = 1;
+                m_slots.erase(it);
+                ++removed;
+            }
+        }
+        if (removed == 0) {
+            return 0;
+        }
+        // One stable pass moves each surviving row at most once.
+        std::size_t kept = 0;
         for (std::size_t i = 0; i < m_ids.size(); ++i) {
-            if (m_ids[i] == id) {
-                std::size_t last = m_ids.size() - 1;
-                if (i != last) {
-                    m_ids[i] = m_ids[last];
-                    std::memcpy(&m_vectors[i * m_dim], &m_vectors[last * m_dim], m_dim * sizeof(float));
+            if (doomed[i]) {
+                continue;
+            }
+            if (kept != i) {
+                move_row(i, kept);
+            }
+            ++kept;
+        }
+        truncate(kept);
+        return removed;
+    }
+
+    template<typename SinkT>
+    inline void FlatVectorIndex::save(SinkT sink) const {
+        unsigned char header[24] = {0};
+        const std::uint32_t magic = snapshot_magic;
+        const std::uint16_t version = snapshot_version;
+        const std::uint64_t count = m_ids.size();
+        const std::uint32_t subspaces = pq_coded() ? static_cast<std::uint32_t>(m_pq.subspaces) : 0;
+        std::memcpy(header, &magic, 4);
+        std::memcpy(header + 4, &version, 2);
+        header[6] = static_cast<unsigned char>(m_metric);
+        header[7] = static_cast<unsigned char>(m_quantization);
+        std::memcpy(header + 8, &m_dim, 4);
+        std::memcpy(header + 12, &subspaces, 4);
+        std::memcpy(header + 16, &count, 8);
+        sink(static_cast<const void*>(header), sizeof(header));
+        if (!m_ids.empty()) {
+            sink(static_cast<const void*>(m_ids.data()), m_ids.size() * sizeof(uint64_t));
+            if (m_mapped_rows != 0) {
+                sink(static_cast<const void*>(m_mapped.data()), m_mapped_rows * row_bytes());
+            }
+            if (subspaces != 0) {
+                sink(static_cast<const void*>(m_pq_codes.data()), m_pq_codes.size());
+            } else {
+                switch (m_quantization) {
+                case VectorQuantization::INT8:
+                    sink(static_cast<const void*>(m_codes.data()), m_codes.size());
+                    sink(static_cast<const void*>(m_scales.data()), m_scales.size() * sizeof(float));
+                    break;
+                case VectorQuantization::FP16:
+                    sink(static_cast<const void*>(m_halfs.data()),
+                         m_halfs.size() * sizeof(std::uint16_t));
+                    break;
+                case VectorQuantization::BINARY:
+                    sink(static_cast<const void*>(m_bits.data()),
+                         m_bits.size() * sizeof(std::uint64_t));
+                    break;
+                default:
+                    sink(static_cast<const void*>(m_vectors.data()), m_vectors.size() * sizeof(float));
+                    break;
+                }
+            }
+        }
+        if (subspaces != 0) {
+            sink(static_cast<const void*>(m_codebooks.data()), m_codebooks.size() * sizeof(float));
+        }
+    }
+
+    inline void FlatVectorIndex::check_header(const unsigned char* header, uint32_t& dim,
+                                              std::uint64_t& count, uint32_t& subspaces) const {
+        std::uint32_t magic = 0;
+        std::uint16_t version = 0;
+        std::memcpy(&magic, header, 4);
+        std::memcpy(&version, header + 4, 2);
+        std::memcpy(&dim, header + 8, 4);
+        std::memcpy(&subspaces, header + 12, 4);
+        std::memcpy(&count, header + 16, 8);
+        if (magic != snapshot_magic || version != snapshot_version) {
+            throw std::runtime_error("FlatVectorIndex snapshot has an unknown format");
+        }
+        if (header[6] != static_cast<unsigned char>(m_metric) ||
+            header[7] != static_cast<unsigned char>(m_quantization)) {
+            throw std::runtime_error("FlatVectorIndex snapshot metric or quantization differs");
+        }
+        if (subspaces != 0 && (subspaces != m_pq.subspaces || m_quantization != VectorQuantization::PQ)) {
+            throw std::runtime_error("FlatVectorIndex snapshot PQ subspaces differ");
+        }
+        // A trained PQ index keeps its dimension while empty.
+        if ((count != 0 && dim == 0) || (count == 0 && dim != 0 && subspaces == 0) ||
+            (subspaces != 0 && (dim == 0 || dim % subspaces != 0))) {
+            throw std::runtime_error("FlatVectorIndex snapshot header is inconsistent");
+        }
+    }
+
+    template<typename SourceT>
+    inline void FlatVectorIndex::load(SourceT source) {
+        unsigned char header[24];
+        source(static_cast<void*>(header), sizeof(header));
+        uint32_t dim = 0;
+        std::uint64_t count = 0;
+        uint32_t subspaces = 0;
+        check_header(header, dim, count, subspaces);
+        FlatVectorIndex loaded(m_metric, m_quantization, m_pq, m_prefix_params);
+        loaded.m_dim = dim;
+        const std::size_t rows = static_cast<std::size_t>(count);
+        loaded.m_ids.resize(rows);
+        if (rows != 0) {
+            source(static_cast<void*>(loaded.m_ids.data()), rows * sizeof(uint64_t));
+        }
+        if (subspaces != 0) {
+            loaded.m_pq_codes.resize(rows * subspaces);
+            loaded.m_codebooks.resize(std::size_t(256) * dim);
+            if (rows != 0) {
+                source(static_cast<void*>(loaded.m_pq_codes.data()), loaded.m_pq_codes.size());
+            }
+            source(static_cast<void*>(loaded.m_codebooks.data()),
+                   loaded.m_codebooks.size() * sizeof(float));
+        } else {
+            switch (m_quantization) {
+            case VectorQuantization::INT8:
+                loaded.m_codes.resize(rows * dim);
+                loaded.m_scales.resize(rows);
+                if (rows != 0) {
+                    source(static_cast<void*>(loaded.m_codes.data()), loaded.m_codes.size());
+                    source(static_cast<void*>(loaded.m_scales.data()), rows * sizeof(float));
+                }
+                break;
+            case VectorQuantization::FP16:
+                loaded.m_halfs.resize(rows * dim);
+                if (rows != 0) {
+                    source(static_cast<void*>(loaded.m_halfs.data()),
+                           loaded.m_halfs.size() * sizeof(std::uint16_t));
+                }
+                break;
+            case VectorQuantization::BINARY:
+                loaded.m_bits.resize(rows * loaded.bit_words());
+                if (rows != 0) {
+                    source(static_cast<void*>(loaded.m_bits.data()),
+                           loaded.m_bits.size() * sizeof(std::uint64_t));
                 }
-                m_ids.pop_back();
-                m_vectors.resize(m_vectors.size() - m_dim);
-                if (m_ids.empty()) {
-                    m_dim = 0;
+                break;
+            default:
+                loaded.m_vectors.resize(rows * dim);
+                if (rows != 0) {
+                    source(static_cast<void*>(loaded.m_vectors.data()),
+                           loaded.m_vectors.size() * sizeof(float));
                 }
-                return true;
+                break;
             }
         }
-        return false;
+        loaded.m_slots.reserve(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (!loaded.m_slots.insert(std::make_pair(loaded.m_ids[i], i)).second) {
+                throw std::runtime_error("FlatVectorIndex snapshot has duplicate ids");
+            }
+        }
+        loaded.rebuild_prefix();
+        *this = std::move(loaded);
     }
 
-    inline float FlatVectorIndex::compute_score(const float* query_vec,
-                                                  const float* candidate_vec) const {
-        if (m_metric == VectorMetric::COSINE || m_metric == VectorMetric::DOT) {
-            float dot = 0.0f;
-            for (std::size_t i = 0; i < m_dim; ++i) {
-                dot += query_vec[i] * candidate_vec[i];
+    inline void FlatVectorIndex::map(const std::string& path) {
+        detail::MappedFile file(path);
+        const std::size_t header_bytes = 24;
+        if (file.size() < header_bytes) {
+            throw std::runtime_error("FlatVectorIndex snapshot file is truncated");
+        }
+        uint32_t dim = 0;
+        std::uint64_t count = 0;
+        uint32_t subspaces = 0;
+        check_header(file.data(), dim, count, subspaces);
+
+        FlatVectorIndex mapped(m_metric, m_quantization, m_pq, m_prefix_params);
+        mapped.m_dim = dim;
+        const std::size_t codebook_bytes = subspaces != 0 ? std::size_t(256) * dim * sizeof(float) : 0;
+        if (file.size() - header_bytes < codebook_bytes) {
+            throw std::runtime_error("FlatVectorIndex snapshot file is truncated");
+        }
+        const std::size_t available = file.size() - header_bytes - codebook_bytes;
+        const std::size_t block_row = subspaces != 0 ? subspaces : mapped.row_bytes();
+        const std::size_t per_row = sizeof(uint64_t) + block_row +
+            (m_quantization == VectorQuantization::INT8 ? sizeof(float) : 0);
+        if (count > available / per_row) {
+            throw std::runtime_error("FlatVectorIndex snapshot file is truncated");
+        }
+        const std::size_t rows = static_cast<std::size_t>(count);
+        const std::size_t ids_bytes = rows * sizeof(uint64_t);
+        const std::size_t block_bytes = rows * block_row;
+        if (subspaces != 0) {
+            mapped.m_codebooks.resize(std::size_t(256) * dim);
+            std::memcpy(mapped.m_codebooks.data(), file.data() + header_bytes + ids_bytes + block_bytes,
+                        codebook_bytes);
+        }
+        if (rows == 0) {
+            *this = std::move(mapped);
+            return;
+        }
+        mapped.m_ids.resize(rows);
+        std::memcpy(mapped.m_ids.data(), file.data() + header_bytes, ids_bytes);
+        if (m_quantization == VectorQuantization::INT8) {
+            mapped.m_scales.resize(rows);
+            std::memcpy(mapped.m_scales.data(), file.data() + header_bytes + ids_bytes + block_bytes,
+                        rows * sizeof(float));
+        }
+        mapped.m_slots.reserve(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (!mapped.m_slots.insert(std::make_pair(mapped.m_ids[i], i)).second) {
+                throw std::runtime_error("FlatVectorIndex snapshot has duplicate ids");
             }
-            return dot;
         }
+        // The block starts 8-byte aligned: the header and ids are whole words.
+        mapped.m_mapped = MappedRows(std::move(file), header_bytes + ids_bytes, block_bytes);
+        mapped.m_mapped_rows = rows;
+        mapped.rebuild_prefix();
+        *this = std::move(mapped);
+    }
+
+    inline float FlatVectorIndex::compute_score(const float* query_vec, std::size_t row) const {
+        const bool dot = m_metric == VectorMetric::COSINE || m_metric == VectorMetric::DOT;
         // L2: score = -squared_distance (higher is better)
-        float sq_dist = 0.0f;
+        switch (m_quantization) {
+        case VectorQuantization::INT8:
+            return dot ? m_kernels->dot_i8(query_vec, row_at(m_codes, row), m_scales[row], m_dim)
+                       : -m_kernels->l2sq_i8(query_vec, row_at(m_codes, row), m_scales[row], m_dim);
+        case VectorQuantization::FP16:
+            return dot ? m_kernels->dot_f16(query_vec, row_at(m_halfs, row), m_dim)
+                       : -m_kernels->l2sq_f16(query_vec, row_at(m_halfs, row), m_dim);
+        default:
+            return exact_score(query_vec, row_at(m_vectors, row));
+        }
+    }
+
+    inline float FlatVectorIndex::score_row(const ScanQuery& query, std::size_t row) const {
+        if (!query.prefix.empty()) {
+            const float* prefix = &m_prefix[row * query.prefix.size()];
+            return m_metric == VectorMetric::L2
+                ? -m_kernels->l2sq(query.prefix.data(), prefix, query.prefix.size())
+                : m_kernels->dot(query.prefix.data(), prefix, query.prefix.size());
+        }
+        if (!query.table.empty()) {
+            return m_kernels->pq_adc(query.table.data(), pq_row(row), m_pq.subspaces);
+        }
+        if (!query.bits.empty()) {
+            return -static_cast<float>(m_kernels->hamming(query.bits.data(), bits_row(row),
+                                                          query.bits.size()));
+        }
+        return compute_score(query.vec, row);
+    }
+
+    inline FlatVectorIndex::ScanQuery FlatVectorIndex::make_scan_query(const float* query_vec) const {
+        ScanQuery query;
+        query.vec = query_vec;
+        if (prefix_active()) {
+            query.prefix.resize(m_prefix_params.dim);
+            store_prefix(query_vec, query.prefix.data());
+        } else if (pq_coded()) {
+            query.table = pq_table(query_vec);
+        } else if (m_quantization == VectorQuantization::BINARY) {
+            query.bits.resize(bit_words());
+            pack_signs(query_vec, query.bits.data());
+        }
+        return query;
+    }
+
+    inline std::size_t FlatVectorIndex::bit_words() const noexcept {
+        return (static_cast<std::size_t>(m_dim) + 63) / 64;
+    }
+
+    inline void FlatVectorIndex::pack_signs(const float* vec, std::uint64_t* bits) const {
+        std::fill(bits, bits + bit_words(), std::uint64_t(0));
         for (std::size_t i = 0; i < m_dim; ++i) {
-            float diff = query_vec[i] - candidate_vec[i];
-            sq_dist += diff * diff;
+            if (vec[i] > 0.0f) {
+                bits[i / 64] |= std::uint64_t(1) << (i % 64);
+            }
+        }
+    }
+
+    inline bool FlatVectorIndex::prefix_active() const noexcept {
+        return m_prefix_params.dim != 0 && m_prefix_params.dim < m_dim;
+    }
+
+    inline void FlatVectorIndex::store_prefix(const float* vec, float* prefix) const {
+        const std::size_t dim = m_prefix_params.dim;
+        std::memcpy(prefix, vec, dim * sizeof(float));
+        if (m_metric != VectorMetric::COSINE) {
+            return;
+        }
+        // A prefix of a unit vector is shorter than one; cosine needs it rescaled.
+        const float norm = std::sqrt(m_kernels->dot(prefix, prefix, dim));
+        if (norm > 0.0f) {
+            for (std::size_t i = 0; i < dim; ++i) {
+                prefix[i] /= norm;
+            }
         }
-        return -sq_dist;
+    }
+
+    inline void FlatVectorIndex::rebuild_prefix() {
+        m_prefix.clear();
+        if (!prefix_active()) {
+            return;
+        }
+        const std::size_t dim = m_prefix_params.dim;
+        m_prefix.resize(m_ids.size() * dim);
+        std::vector<float> head(dim);
+        for (std::size_t row = 0; row < m_ids.size(); ++row) {
+            switch (m_quantization) {
+            case VectorQuantization::INT8: {
+                const std::int8_t* codes = row_at(m_codes, row);
+                for (std::size_t i = 0; i < dim; ++i) {
+                    head[i] = codes[i] * m_scales[row];
+                }
+                break;
+            }
+            case VectorQuantization::FP16: {
+                const std::uint16_t* halfs = row_at(m_halfs, row);
+                for (std::size_t i = 0; i < dim; ++i) {
+                    head[i] = detail::half_to_float(halfs[i]);
+                }
+                break;
+            }
+            default:
+                std::memcpy(head.data(), row_at(m_vectors, row), dim * sizeof(float));
+                break;
+            }
+            store_prefix(head.data(), &m_prefix[row * dim]);
+        }
+    }
+
+    inline float FlatVectorIndex::exact_score(const float* query_vec,
+                                              const float* candidate_vec) const {
+        if (m_metric == VectorMetric::COSINE || m_metric == VectorMetric::DOT) {
+            return m_kernels->dot(query_vec, candidate_vec, m_dim);
+        }
+        return -m_kernels->l2sq(query_vec, candidate_vec, m_dim);
     }
 
     inline std::vector<VectorMatch> FlatVectorIndex::search(const Embedding& query,
-                                                              std::size_t top_k) const {
+                                                              std::size_t top_k,
+                                                              std::size_t threads) const {
         query.validate();
         if (top_k == 0) {
             return std::vector<VectorMatch>();
@@ -98,8 +597,158 @@ namespace mdbxc {
             throw std::invalid_argument("Query dimension does not match index dimension");
         }
 
-        // Prepare query vector (normalize for COSINE)
-        std::vector<float> query_vec(m_dim);
+        std::vector<std::vector<float>> query_vecs(1, prepare_query(query));
+        return std::move(scan(query_vecs, top_k, threads)[0]);
+    }
+
+    inline std::vector<VectorMatch> FlatVectorIndex::search(const Embedding& query,
+                                                              std::size_t top_k,
+                                                              const VectorFilter& filter,
+                                                              std::size_t threads) const {
+        query.validate();
+        if (top_k == 0 || filter.count() == 0 || m_dim == 0 || m_ids.empty()) {
+            return std::vector<VectorMatch>();
+        }
+        if (query.dim != m_dim) {
+            throw std::invalid_argument("Query dimension does not match index dimension");
+        }
+
+        std::vector<std::vector<float>> query_vecs(1, prepare_query(query));
+        return std::move(scan(query_vecs, std::min(top_k, filter.count()), threads, &filter)[0]);
+    }
+
+    inline std::vector<std::vector<VectorMatch>>
+    FlatVectorIndex::search_batch(const std::vector<Embedding>& queries, std::size_t top_k,
+                                  std::size_t threads) const {
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            queries[q].validate();
+            if (m_dim != 0 && !m_ids.empty() && queries[q].dim != m_dim) {
+                throw std::invalid_argument("Query dimension does not match index dimension");
+            }
+        }
+        if (top_k == 0 || m_dim == 0 || m_ids.empty() || queries.empty()) {
+            return std::vector<std::vector<VectorMatch>>(queries.size());
+        }
+
+        std::vector<std::vector<float>> query_vecs;
+        query_vecs.reserve(queries.size());
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            query_vecs.push_back(prepare_query(queries[q]));
+        }
+        return scan(query_vecs, top_k, threads);
+    }
+
+    inline std::vector<std::vector<VectorMatch>>
+    FlatVectorIndex::scan(const std::vector<std::vector<float>>& query_vecs, std::size_t top_k,
+                          std::size_t threads, const VectorFilter* filter) const {
+        const std::size_t n = m_ids.size();
+        if (top_k > n) {
+            top_k = n;
+        }
+        // Prefix mode over-fetches from the compact block and re-scores below.
+        const bool prefix = prefix_active();
+        const std::size_t keep = !prefix ? top_k
+            : top_k <= n / m_prefix_params.rerank_factor ? top_k * m_prefix_params.rerank_factor : n;
+        const std::size_t scanned_bytes = prefix ? m_prefix_params.dim * sizeof(float) : row_bytes();
+        const std::size_t block_rows = std::max<std::size_t>(1, scan_block_bytes / scanned_bytes);
+        const std::size_t blocks = (n + block_rows - 1) / block_rows;
+        if (threads == 0) {
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, blocks);
+
+        // One bounded heap per query and thread; allocated up front so the
+        // workers never allocate.
+        std::vector<std::vector<std::vector<VectorMatch>>> heaps(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            heaps[t].resize(query_vecs.size());
+            for (std::size_t q = 0; q < query_vecs.size(); ++q) {
+                heaps[t][q].reserve(keep);
+            }
+        }
+
+        // Trained PQ and BINARY rows are scored against a per-query table or
+        // sign bits built once here.
+        std::vector<ScanQuery> queries;
+        queries.reserve(query_vecs.size());
+        for (std::size_t q = 0; q < query_vecs.size(); ++q) {
+            queries.push_back(make_scan_query(query_vecs[q].data()));
+        }
+
+        std::atomic<std::size_t> next_block(0);
+        auto worker = [this, &queries, &heaps, &next_block, n, keep, block_rows, blocks,
+                       filter](std::size_t t) {
+            std::vector<std::vector<VectorMatch>>& local = heaps[t];
+            for (;;) {
+                const std::size_t b = next_block.fetch_add(1);
+                if (b >= blocks) break;
+                const std::size_t first = b * block_rows;
+                const std::size_t last = std::min(n, first + block_rows);
+                // Query-major inside a block: the block stays in cache while
+                // every query is scored against it.
+                for (std::size_t q = 0; q < queries.size(); ++q) {
+                    const ScanQuery& query = queries[q];
+                    if (filter != nullptr) {
+                        for (std::size_t i = first; i < last; ++i) {
+                            if (filter->allows(m_ids[i])) {
+                                push_top_k(local[q], keep, m_ids[i], score_row(query, i));
+                            }
+                        }
+                    } else {
+                        for (std::size_t i = first; i < last; ++i) {
+                            push_top_k(local[q], keep, m_ids[i], score_row(query, i));
+                        }
+                    }
+                }
+            }
+        };
+
+        if (threads <= 1) {
+            worker(0);
+        } else {
+            std::vector<std::thread> pool;
+            pool.reserve(threads - 1);
+            try {
+                for (std::size_t t = 1; t < threads; ++t) {
+                    pool.push_back(std::thread(worker, t));
+                }
+            } catch (...) {
+                next_block.store(blocks);
+                for (std::size_t i = 0; i < pool.size(); ++i) pool[i].join();
+                throw;
+            }
+            worker(0);
+            for (std::size_t i = 0; i < pool.size(); ++i) pool[i].join();
+        }
+
+        std::vector<std::vector<VectorMatch>> results(query_vecs.size());
+        for (std::size_t q = 0; q < query_vecs.size(); ++q) {
+            std::vector<VectorMatch>& merged = results[q];
+            merged.swap(heaps[0][q]);
+            for (std::size_t t = 1; t < threads; ++t) {
+                const std::vector<VectorMatch>& part = heaps[t][q];
+                for (std::size_t i = 0; i < part.size(); ++i) {
+                    push_top_k(merged, keep, part[i].id, part[i].score);
+                }
+            }
+            if (prefix) {
+                std::vector<VectorMatch> refined;
+                refined.reserve(top_k);
+                for (std::size_t i = 0; i < merged.size(); ++i) {
+                    const std::size_t row = m_slots.find(merged[i].id)->second;
+                    push_top_k(refined, top_k, merged[i].id, compute_score(query_vecs[q].data(), row));
+                }
+                merged.swap(refined);
+            }
+            std::sort_heap(merged.begin(), merged.end(), &FlatVectorIndex::better_match);
+        }
+        return results;
+    }
+
+    inline std::vector<float> FlatVectorIndex::prepare_query(const Embedding& query) const {
+        // Normalize for COSINE so the score is a plain dot product.
+        const std::size_t dim = query.values.size();
+        std::vector<float> query_vec(dim);
         if (m_metric == VectorMetric::COSINE) {
             float norm = 0.0f;
             for (std::size_t i = 0; i < query.values.size(); ++i) {
@@ -107,35 +756,37 @@ namespace mdbxc {
             }
             norm = std::sqrt(norm);
             if (norm > 0.0f) {
-                for (std::size_t i = 0; i < m_dim; ++i) {
+                for (std::size_t i = 0; i < dim; ++i) {
                     query_vec[i] = query.values[i] / norm;
                 }
             } else {
                 std::fill(query_vec.begin(), query_vec.end(), 0.0f);
             }
         } else {
-            std::memcpy(query_vec.data(), query.values.data(), m_dim * sizeof(float));
+            std::memcpy(query_vec.data(), query.values.data(), dim * sizeof(float));
         }
+        return query_vec;
+    }
 
-        std::size_t n = m_ids.size();
-        std::vector<VectorMatch> matches;
-        matches.reserve(n);
-        for (std::size_t i = 0; i < n; ++i) {
-            VectorMatch m;
-            m.id = m_ids[i];
-            m.score = compute_score(query_vec.data(), &m_vectors[i * m_dim]);
-            matches.push_back(m);
-        }
+    inline bool FlatVectorIndex::better_match(const VectorMatch& a, const VectorMatch& b) noexcept {
+        return a.score > b.score;
+    }
 
-        if (top_k > n) {
-            top_k = n;
+    inline void FlatVectorIndex::push_top_k(std::vector<VectorMatch>& heap, std::size_t top_k,
+                                            uint64_t id, float score) {
+        // Min-heap on score: the front is the weakest of the kept matches.
+        if (heap.size() < top_k) {
+            VectorMatch m;
+            m.id = id;
+            m.score = score;
+            heap.push_back(m);
+            std::push_heap(heap.begin(), heap.end(), &FlatVectorIndex::better_match);
+        } else if (score > heap.front().score) {
+            std::pop_heap(heap.begin(), heap.end(), &FlatVectorIndex::better_match);
+            heap.back().id = id;
+            heap.back().score = score;
+            std::push_heap(heap.begin(), heap.end(), &FlatVectorIndex::better_match);
         }
-        std::partial_sort(matches.begin(), matches.begin() + top_k, matches.end(),
-            [](const VectorMatch& a, const VectorMatch& b) {
-                return a.score > b.score;
-            });
-        matches.resize(top_k);
-        return matches;
     }
 
     inline std::size_t FlatVectorIndex::size() const noexcept {
@@ -146,4 +797,276 @@ namespace mdbxc {
         return m_dim;
     }
 
+    inline const char* FlatVectorIndex::kernel_name() const noexcept {
+        return m_kernels->name;
+    }
+
+    inline VectorQuantization FlatVectorIndex::quantization() const noexcept {
+        return m_quantization;
+    }
+
+    inline const PqParams& FlatVectorIndex::pq_params() const noexcept {
+        return m_pq;
+    }
+
+    inline const PrefixParams& FlatVectorIndex::prefix_params() const noexcept {
+        return m_prefix_params;
+    }
+
+    inline std::size_t FlatVectorIndex::memory_bytes() const noexcept {
+        return m_vectors.size() * sizeof(float) + m_codes.size() +
+               m_scales.size() * sizeof(float) + m_halfs.size() * sizeof(std::uint16_t) +
+               m_pq_codes.size() + m_codebooks.size() * sizeof(float) +
+               m_bits.size() * sizeof(std::uint64_t) + m_prefix.size() * sizeof(float);
+    }
+
+    inline std::size_t FlatVectorIndex::mapped_bytes() const noexcept {
+        return m_mapped_rows * row_bytes();
+    }
+
+    inline bool FlatVectorIndex::pq_coded() const noexcept {
+        return !m_codebooks.empty();
+    }
+
+    inline bool FlatVectorIndex::trained() const noexcept {
+        return pq_coded();
+    }
+
+    inline const std::vector<float>& FlatVectorIndex::codebooks() const noexcept {
+        return m_codebooks;
+    }
+
+    inline void FlatVectorIndex::set_codebooks(const std::vector<float>& codebooks) {
+        if (m_quantization != VectorQuantization::PQ) {
+            throw std::logic_error("FlatVectorIndex codebooks require VectorQuantization::PQ");
+        }
+        if (!m_ids.empty()) {
+            throw std::invalid_argument("FlatVectorIndex codebooks can only be set on an empty index");
+        }
+        const std::size_t dim = codebooks.size() / 256;
+        if (dim == 0 || codebooks.size() % 256 != 0 || dim % m_pq.subspaces != 0) {
+            throw std::invalid_argument("FlatVectorIndex codebooks do not match the PQ subspaces");
+        }
+        for (std::size_t i = 0; i < codebooks.size(); ++i) {
+            if (!std::isfinite(codebooks[i])) {
+                throw std::invalid_argument("FlatVectorIndex codebooks must be finite");
+            }
+        }
+        clear();
+        m_codebooks = codebooks;
+        m_dim = static_cast<uint32_t>(dim);
+    }
+
+    inline void FlatVectorIndex::train(std::size_t threads) {
+        if (m_quantization != VectorQuantization::PQ) {
+            throw std::logic_error("FlatVectorIndex::train requires VectorQuantization::PQ");
+        }
+        if (m_ids.empty() || pq_coded()) {
+            return;
+        }
+        if (m_dim % m_pq.subspaces != 0) {
+            throw std::invalid_argument("FlatVectorIndex PQ subspaces must divide the dimension");
+        }
+        const std::size_t n = m_ids.size();
+        const std::size_t count = std::min(n, std::max<std::size_t>(m_pq.max_samples, 1));
+
+        // Partial Fisher-Yates: the first `count` rows become a uniform sample.
+        std::mt19937_64 rng(m_pq.seed);
+        std::vector<std::size_t> order(n);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uniform_int_distribution<std::size_t> pick(i, n - 1);
+            std::swap(order[i], order[pick(rng)]);
+        }
+        std::vector<float> samples(count * m_dim);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::memcpy(&samples[i * m_dim], row_at(m_vectors, order[i]), m_dim * sizeof(float));
+        }
+
+        // Subspaces are independent k-means problems.
+        std::vector<float> codebooks(std::size_t(256) * m_dim);
+        m_codebooks.swap(codebooks);
+        if (threads == 0) {
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, m_pq.subspaces);
+        std::atomic<std::size_t> next_sub(0);
+        auto worker = [this, &samples, &next_sub, count]() {
+            for (;;) {
+                const std::size_t sub = next_sub.fetch_add(1);
+                if (sub >= m_pq.subspaces) break;
+                train_subspace(sub, samples, count);
+            }
+        };
+        std::vector<std::thread> pool;
+        try {
+            pool.reserve(threads - 1);
+            for (std::size_t t = 1; t < threads; ++t) {
+                pool.push_back(std::thread(worker));
+            }
+        } catch (...) {
+            next_sub.store(m_pq.subspaces);
+            for (std::size_t i = 0; i < pool.size(); ++i) pool[i].join();
+            m_codebooks.clear();
+            throw;
+        }
+        worker();
+        for (std::size_t i = 0; i < pool.size(); ++i) pool[i].join();
+
+        std::vector<std::uint8_t> codes(n * m_pq.subspaces);
+        for (std::size_t row = 0; row < n; ++row) {
+            pq_encode(row_at(m_vectors, row), &codes[row * m_pq.subspaces]);
+        }
+        m_pq_codes.swap(codes);
+        std::vector<float>().swap(m_vectors);
+        m_mapped = MappedRows();
+        m_mapped_rows = 0;
+    }
+
+    inline void FlatVectorIndex::train_subspace(std::size_t sub, const std::vector<float>& samples,
+                                                std::size_t count) {
+        const std::size_t sub_dim = m_dim / m_pq.subspaces;
+        const std::size_t k = 256;
+        std::vector<float> points(count * sub_dim);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::memcpy(&points[i * sub_dim], &samples[i * m_dim + sub * sub_dim],
+                        sub_dim * sizeof(float));
+        }
+        // Samples are already shuffled; fewer than 256 of them repeat.
+        float* centroids = &m_codebooks[sub * k * sub_dim];
+        for (std::size_t c = 0; c < k; ++c) {
+            std::memcpy(centroids + c * sub_dim, &points[(c % count) * sub_dim],
+                        sub_dim * sizeof(float));
+        }
+
+        std::mt19937_64 rng(m_pq.seed + sub + 1);
+        std::uniform_int_distribution<std::size_t> any_sample(0, count - 1);
+        std::vector<std::uint8_t> labels(count);
+        std::vector<double> sums(k * sub_dim);
+        std::vector<std::size_t> counts(k);
+        for (std::size_t it = 0; it < m_pq.train_iterations; ++it) {
+            bool changed = it == 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::uint8_t label = pq_nearest(centroids, &points[i * sub_dim], sub_dim);
+                changed = changed || label != labels[i];
+                labels[i] = label;
+            }
+            if (!changed) {
+                break;
+            }
+            std::fill(sums.begin(), sums.end(), 0.0);
+            std::fill(counts.begin(), counts.end(), 0);
+            for (std::size_t i = 0; i < count; ++i) {
+                double* sum = &sums[static_cast<std::size_t>(labels[i]) * sub_dim];
+                const float* point = &points[i * sub_dim];
+                for (std::size_t d = 0; d < sub_dim; ++d) {
+                    sum[d] += point[d];
+                }
+                ++counts[labels[i]];
+            }
+            for (std::size_t c = 0; c < k; ++c) {
+                float* centroid = centroids + c * sub_dim;
+                if (counts[c] == 0) {
+                    // Reseed an empty cluster from a random sample.
+                    std::memcpy(centroid, &points[any_sample(rng) * sub_dim], sub_dim * sizeof(float));
+                    continue;
+                }
+                for (std::size_t d = 0; d < sub_dim; ++d) {
+                    centroid[d] = static_cast<float>(sums[c * sub_dim + d] / static_cast<double>(counts[c]));
+                }
+            }
+        }
+    }
+
+    inline std::uint8_t FlatVectorIndex::pq_nearest(const float* centroids, const float* point,
+                                                    std::size_t sub_dim) const {
+        std::size_t best = 0;
+        float best_dist = m_kernels->l2sq(point, centroids, sub_dim);
+        for (std::size_t c = 1; c < 256; ++c) {
+            const float dist = m_kernels->l2sq(point, centroids + c * sub_dim, sub_dim);
+            if (dist < best_dist) {
+                best_dist = dist;
+                best = c;
+            }
+        }
+        return static_cast<std::uint8_t>(best);
+    }
+
+    inline void FlatVectorIndex::pq_encode(const float* vec, std::uint8_t* codes) const {
+        const std::size_t sub_dim = m_dim / m_pq.subspaces;
+        for (std::size_t sub = 0; sub < m_pq.subspaces; ++sub) {
+            codes[sub] = pq_nearest(&m_codebooks[sub * 256 * sub_dim], vec + sub * sub_dim, sub_dim);
+        }
+    }
+
+    inline std::vector<float> FlatVectorIndex::pq_table(const float* query_vec) const {
+        // Entry (sub, c) is the score of the query slice against centroid c,
+        // so a row's score is the sum of one entry per code byte.
+        const std::size_t sub_dim = m_dim / m_pq.subspaces;
+        const bool dot = m_metric == VectorMetric::COSINE || m_metric == VectorMetric::DOT;
+        std::vector<float> table(m_pq.subspaces * 256);
+        for (std::size_t sub = 0; sub < m_pq.subspaces; ++sub) {
+            const float* slice = query_vec + sub * sub_dim;
+            const float* centroids = &m_codebooks[sub * 256 * sub_dim];
+            for (std::size_t c = 0; c < 256; ++c) {
+                table[sub * 256 + c] = dot ? m_kernels->dot(slice, centroids + c * sub_dim, sub_dim)
+                                           : -m_kernels->l2sq(slice, centroids + c * sub_dim, sub_dim);
+            }
+        }
+        return table;
+    }
+
+    inline std::vector<VectorMatch> FlatVectorIndex::rescore(
+            const Embedding& query,
+            const std::vector<std::pair<uint64_t, Embedding>>& candidates,
+            std::size_t top_k) const {
+        std::vector<std::pair<uint64_t, EmbeddingView>> views;
+        views.reserve(candidates.size());
+        for (std::size_t c = 0; c < candidates.size(); ++c) {
+            candidates[c].second.validate();
+            views.push_back(std::make_pair(candidates[c].first, candidates[c].second.view()));
+        }
+        return rescore(query, views, top_k);
+    }
+
+    inline std::vector<VectorMatch> FlatVectorIndex::rescore(
+            const Embedding& query,
+            const std::vector<std::pair<uint64_t, EmbeddingView>>& candidates,
+            std::size_t top_k) const {
+        query.validate();
+        if (m_dim != 0 && query.dim != m_dim) {
+            throw std::invalid_argument("Query dimension does not match index dimension");
+        }
+        std::vector<VectorMatch> heap;
+        if (top_k == 0 || candidates.empty()) {
+            return heap;
+        }
+        const std::vector<float> query_vec = prepare_query(query);
+        heap.reserve(std::min(top_k, candidates.size()));
+        for (std::size_t c = 0; c < candidates.size(); ++c) {
+            const EmbeddingView& candidate = candidates[c].second;
+            if (candidate.values == nullptr) {
+                throw std::invalid_argument("Embedding view has no values");
+            }
+            if (candidate.dim != query.dim) {
+                throw std::invalid_argument("Embedding dimension does not match query dimension");
+            }
+            float score;
+            if (m_metric == VectorMetric::COSINE) {
+                // Cosine of the raw vectors equals the dot of the normalized ones.
+                const float norm = std::sqrt(m_kernels->dot(candidate.values, candidate.values, query.dim));
+                score = norm > 0.0f
+                    ? m_kernels->dot(query_vec.data(), candidate.values, query.dim) / norm
+                    : 0.0f;
+            } else if (m_metric == VectorMetric::DOT) {
+                score = m_kernels->dot(query_vec.data(), candidate.values, query.dim);
+            } else {
+                score = -m_kernels->l2sq(query_vec.data(), candidate.values, query.dim);
+            }
+            push_top_k(heap, top_k, candidates[c].first, score);
+        }
+        std::sort_heap(heap.begin(), heap.end(), &FlatVectorIndex::better_match);
+        return heap;
+    }
+
 } // namespace mdbxc
@@ -0,0 +1,192 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_HNSW_VECTOR_INDEX_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_HNSW_VECTOR_INDEX_HPP_INCLUDED
+
+#include "FlatVectorIndex.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \brief Construction and search parameters of \ref HnswVectorIndex.
+    struct HnswParams {
+        /// \brief Neighbours kept per node on upper layers; layer 0 keeps \c 2*M.
+        /// Larger values raise recall and memory. Must be at least 2.
+        std::size_t M = 16;
+        /// \brief Candidate list size while inserting. Must be positive.
+        std::size_t ef_construction = 200;
+        /// \brief Candidate list size while searching; raised to \c top_k when smaller.
+        std::size_t ef_search = 64;
+        /// \brief Seed of the layer assignment generator.
+        std::uint64_t seed = 100;
+    };
+
+    namespace detail {
+
+        /// \brief Visit marks of one graph traversal, reset in O(1) by bumping the epoch.
+        struct HnswVisitedList {
+            std::vector<std::uint32_t> marks;
+            std::uint32_t epoch = 0;
+
+            void reset(std::size_t nodes) {
+                if (marks.size() < nodes) marks.resize(nodes, 0);
+                if (++epoch == 0) {
+                    std::fill(marks.begin(), marks.end(), 0);
+                    epoch = 1;
+                }
+            }
+
+            /// \brief Marks \p node; returns \c false if it was already visited.
+            bool visit(std::uint32_t node) {
+                if (marks[node] == epoch) return false;
+                marks[node] = epoch;
+                return true;
+            }
+        };
+
+        /// \brief Visit lists shared by concurrent searches.
+        struct HnswVisitedPool {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<HnswVisitedList>> lists;
+        };
+
+    } // namespace detail
+
+    /// \brief In-memory approximate vector index over a hierarchical navigable
+    /// small-world (HNSW) graph.
+    ///
+    /// Each vector is a node on layer 0 and, with geometrically falling
+    /// probability, on higher layers. Search descends greedily through the
+    /// upper layers and then runs a best-first search with \c ef_search
+    /// candidates on layer 0, so query cost grows roughly with \c log(N).
+    /// Scores use the same kernels and conventions as \ref FlatVectorIndex.
+    ///
+    /// Erasing marks the node as a tombstone: it still routes searches but is
+    /// never returned. Tombstones are dropped by \ref clear() or by rebuilding
+    /// the index; \ref deleted_count() reports how many are held.
+    ///
+    /// \warning Results are approximate; recall depends on \ref HnswParams.
+    /// \ref VectorMetric::DOT is not a distance, so recall on unnormalized
+    /// vectors is lower than with \ref VectorMetric::COSINE or \ref VectorMetric::L2.
+    /// \note Concurrent searches are safe. The class does not synchronize
+    /// mutation with search.
+    class HnswVectorIndex {
+    public:
+        /// \brief Creates an empty index.
+        /// \param metric Scoring metric used for all vectors.
+        /// \param params Graph parameters.
+        /// \throws std::invalid_argument if \c params.M is below 2 or
+        ///         \c params.ef_construction is zero.
+        explicit HnswVectorIndex(VectorMetric metric = VectorMetric::COSINE,
+                                 const HnswParams& params = HnswParams());
+
+        /// \brief Removes all vectors and tombstones and resets the index dimension.
+        void clear();
+
+        /// \brief Inserts a vector id into the graph.
+        /// \details Re-adding a live id tombstones its previous node first.
+        /// \param id Caller-owned stable id.
+        /// \param embedding Dense embedding to index.
+        /// \throws std::invalid_argument if the embedding is invalid or has a mismatched dimension.
+        void add(uint64_t id, const Embedding& embedding);
+
+        /// \brief Tombstones a vector id.
+        /// \param id Id to remove.
+        /// \return \c true if the id was present.
+        bool erase(uint64_t id);
+
+        /// \brief Searches the graph and returns the best matches found.
+        /// \param query Query embedding.
+        /// \param top_k Maximum number of matches to return.
+        /// \return Matches ordered by descending score.
+        /// \throws std::invalid_argument if the query is invalid or has a mismatched dimension.
+        std::vector<VectorMatch> search(const Embedding& query, std::size_t top_k) const;
+
+        /// \brief Searches only the ids admitted by \p filter.
+        /// \details Rejected nodes still route the traversal but never enter
+        /// the candidate list. When fewer than 1/16 of the live ids are
+        /// admitted, or the traversal finds fewer than \p top_k matches, the
+        /// admitted ids are scored exactly instead, so the result always
+        /// holds \c min(top_k, admitted live ids) matches.
+        /// \param query Query embedding.
+        /// \param top_k Maximum number of matches to return.
+        /// \param filter Ids eligible for the result.
+        /// \return Matches ordered by descending score.
+        /// \throws std::invalid_argument if the query is invalid or has a mismatched dimension.
+        std::vector<VectorMatch> search(const Embedding& query, std::size_t top_k,
+                                        const VectorFilter& filter) const;
+
+        /// \brief Sets the layer-0 candidate list size used by \ref search().
+        void set_ef_search(std::size_t ef_search) noexcept;
+
+        /// \brief Returns the graph parameters.
+        const HnswParams& params() const noexcept;
+
+        /// \brief Returns the number of live vectors.
+        std::size_t size() const noexcept;
+
+        /// \brief Returns the number of tombstoned nodes still in the graph.
+        std::size_t deleted_count() const noexcept;
+
+        /// \brief Returns the active index dimension, or zero when empty.
+        uint32_t dim() const noexcept;
+
+        /// \brief Returns the instruction set used for scoring, see \ref FlatVectorIndex::kernel_name().
+        const char* kernel_name() const noexcept;
+
+        /// \brief Returns the bytes held by stored vectors and graph links.
+        std::size_t memory_bytes() const noexcept;
+
+    private:
+        typedef std::pair<float, std::uint32_t> Candidate; ///< Distance and node.
+
+        VectorMetric m_metric;
+        HnswParams m_params;
+        const detail::DistanceKernels* m_kernels;
+        double m_level_mult;
+        std::mt19937_64 m_rng;
+        uint32_t m_dim = 0;
+        std::vector<uint64_t> m_ids;                  ///< Node to id.
+        std::vector<float> m_vectors;                 ///< \c m_dim floats per node.
+        std::vector<std::uint32_t> m_links0;          ///< Per node: count, then \c 2*M neighbours.
+        std::vector<std::vector<std::uint32_t>> m_upper; ///< Per node and layer >= 1: count, then \c M neighbours.
+        std::vector<char> m_deleted;                  ///< Tombstone flag per node.
+        std::unordered_map<uint64_t, std::uint32_t> m_nodes; ///< Live id to node.
+        std::uint32_t m_entry = 0;
+        int m_max_level = -1;
+        std::unique_ptr<detail::HnswVisitedPool> m_visited;
+
+        std::vector<float> prepare(const Embedding& embedding) const;
+        float distance(const float* a, const float* b) const;
+        const float* vector_of(std::uint32_t node) const;
+        std::size_t max_links(int level) const;
+        std::uint32_t* links(std::uint32_t node, int level);
+        const std::uint32_t* links(std::uint32_t node, int level) const;
+        int random_level();
+
+        std::unique_ptr<detail::HnswVisitedList> acquire_visited() const;
+        void release_visited(std::unique_ptr<detail::HnswVisitedList> list) const;
+
+        void greedy_descend(const float* query, std::uint32_t& node, float& dist,
+                            int from_level, int to_level) const;
+        std::vector<Candidate> search_layer(const float* query, std::uint32_t entry,
+                                            float entry_dist, std::size_t ef, int level,
+                                            bool skip_deleted, const VectorFilter* filter,
+                                            detail::HnswVisitedList& visited) const;
+        std::vector<VectorMatch> exact_search(const float* query, std::size_t top_k,
+                                              const VectorFilter& filter) const;
+        std::vector<Candidate> select_neighbors(const std::vector<Candidate>& sorted,
+                                                std::size_t count) const;
+        void connect(std::uint32_t node, std::uint32_t neighbor, int level);
+    };
+
+} // namespace mdbxc
+
+#include "HnswVectorIndex.ipp"
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_HNSW_VECTOR_INDEX_HPP_INCLUDED
@@ -0,0 +1,412 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+namespace mdbxc {
+
+    inline HnswVectorIndex::HnswVectorIndex(VectorMetric metric, const HnswParams& params)
+        : m_metric(metric), m_params(params), m_kernels(&detail::distance_kernels()),
+          m_level_mult(0.0), m_rng(params.seed), m_visited(new detail::HnswVisitedPool()) {
+        if (m_params.M < 2) {
+            throw std::invalid_argument("HnswParams::M must be at least 2");
+        }
+        if (m_params.ef_construction == 0) {
+            throw std::invalid_argument("HnswParams::ef_construction must be positive");
+        }
+        m_level_mult = 1.0 / std::log(static_cast<double>(m_params.M));
+    }
+
+    inline void HnswVectorIndex::clear() {
+        m_ids.clear();
+        m_vectors.clear();
+        m_links0.clear();
+        m_upper.clear();
+        m_deleted.clear();
+        m_nodes.clear();
+        m_entry = 0;
+        m_max_level = -1;
+        m_dim = 0;
+    }
+
+    inline void HnswVectorIndex::add(uint64_t id, const Embedding& embedding) {
+        embedding.validate();
+        if (m_dim != 0 && embedding.dim != m_dim) {
+            throw std::invalid_argument("Embedding dimension does not match index dimension");
+        }
+        if (m_ids.size() >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("HnswVectorIndex node count exceeds 2^32 - 1");
+        }
+        erase(id);
+        m_dim = embedding.dim;
+        const std::vector<float> vec = prepare(embedding);
+
+        const std::uint32_t node = static_cast<std::uint32_t>(m_ids.size());
+        const int level = random_level();
+        m_ids.push_back(id);
+        m_vectors.insert(m_vectors.end(), vec.begin(), vec.end());
+        m_links0.resize(m_links0.size() + max_links(0) + 1, 0);
+        m_upper.push_back(std::vector<std::uint32_t>(
+            static_cast<std::size_t>(level) * (max_links(1) + 1), 0));
+        m_deleted.push_back(0);
+        m_nodes[id] = node;
+
+        if (m_max_level < 0) {
+            m_entry = node;
+            m_max_level = level;
+            return;
+        }
+
+        std::uint32_t current = m_entry;
+        float current_dist = distance(vec.data(), vector_of(current));
+        greedy_descend(vec.data(), current, current_dist, m_max_level, level);
+
+        std::unique_ptr<detail::HnswVisitedList> visited = acquire_visited();
+        for (int l = std::min(level, m_max_level); l >= 0; --l) {
+            const std::vector<Candidate> found = search_layer(
+                vec.data(), current, current_dist, m_params.ef_construction, l, false, nullptr,
+                *visited);
+            const std::vector<Candidate> chosen = select_neighbors(found, m_params.M);
+            std::uint32_t* own = links(node, l);
+            own[0] = static_cast<std::uint32_t>(chosen.size());
+            for (std::size_t i = 0; i < chosen.size(); ++i) {
+                own[i + 1] = chosen[i].second;
+            }
+            for (std::size_t i = 0; i < chosen.size(); ++i) {
+                connect(chosen[i].second, node, l);
+            }
+            current = found.front().second;
+            current_dist = found.front().first;
+        }
+        release_visited(std::move(visited));
+
+        if (level > m_max_level) {
+            m_entry = node;
+            m_max_level = level;
+        }
+    }
+
+    inline bool HnswVectorIndex::erase(uint64_t id) {
+        const std::unordered_map<uint64_t, std::uint32_t>::iterator it = m_nodes.find(id);
+        if (it == m_nodes.end()) {
+            return false;
+        }
+        m_deleted[it->second] = 1;
+        m_nodes.erase(it);
+        if (m_nodes.empty()) {
+            clear();
+        }
+        return true;
+    }
+
+    inline std::vector<VectorMatch> HnswVectorIndex::search(const Embedding& query,
+                                                            std::size_t top_k) const {
+        query.validate();
+        if (m_dim != 0 && query.dim != m_dim) {
+            throw std::invalid_argument("Query dimension does not match index dimension");
+        }
+        std::vector<VectorMatch> result;
+        if (top_k == 0 || m_nodes.empty()) {
+            return result;
+        }
+        const std::vector<float> vec = prepare(query);
+        std::uint32_t current = m_entry;
+        float current_dist = distance(vec.data(), vector_of(current));
+        greedy_descend(vec.data(), current, current_dist, m_max_level, 0);
+
+        std::unique_ptr<detail::HnswVisitedList> visited = acquire_visited();
+        const std::vector<Candidate> found = search_layer(
+            vec.data(), current, current_dist, std::max(m_params.ef_search, top_k), 0, true, nullptr,
+            *visited);
+        release_visited(std::move(visited));
+
+        const std::size_t count = std::min(top_k, found.size());
+        result.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            result[i].id = m_ids[found[i].second];
+            result[i].score = -found[i].first;
+        }
+        return result;
+    }
+
+    inline std::vector<VectorMatch> HnswVectorIndex::search(const Embedding& query,
+                                                            std::size_t top_k,
+                                                            const VectorFilter& filter) const {
+        query.validate();
+        if (m_dim != 0 && query.dim != m_dim) {
+            throw std::invalid_argument("Query dimension does not match index dimension");
+        }
+        std::vector<VectorMatch> result;
+        if (top_k == 0 || m_nodes.empty() || filter.count() == 0) {
+            return result;
+        }
+        const std::vector<float> vec = prepare(query);
+        // A selective filter leaves few accepted nodes near the query, and the
+        // traversal would wander most of the graph to collect them.
+        if (filter.count() * 16 <= m_nodes.size()) {
+            return exact_search(vec.data(), top_k, filter);
+        }
+        std::uint32_t current = m_entry;
+        float current_dist = distance(vec.data(), vector_of(current));
+        greedy_descend(vec.data(), current, current_dist, m_max_level, 0);
+
+        std::unique_ptr<detail::HnswVisitedList> visited = acquire_visited();
+        const std::vector<Candidate> found = search_layer(
+            vec.data(), current, current_dist, std::max(m_params.ef_search, top_k), 0, true, &filter,
+            *visited);
+        release_visited(std::move(visited));
+
+        if (found.size() < top_k) {
+            return exact_search(vec.data(), top_k, filter);
+        }
+        result.resize(top_k);
+        for (std::size_t i = 0; i < top_k; ++i) {
+            result[i].id = m_ids[found[i].second];
+            result[i].score = -found[i].first;
+        }
+        return result;
+    }
+
+    inline std::vector<VectorMatch> HnswVectorIndex::exact_search(const float* query,
+                                                                  std::size_t top_k,
+                                                                  const VectorFilter& filter) const {
+        std::vector<Candidate> heap; // max-heap on distance: worst kept match on top
+        heap.reserve(std::min(top_k, filter.count()));
+        filter.for_each([this, &heap, query, top_k](uint64_t id) {
+            const std::unordered_map<uint64_t, std::uint32_t>::const_iterator it = m_nodes.find(id);
+            if (it == m_nodes.end()) {
+                return;
+            }
+            const Candidate c(distance(query, vector_of(it->second)), it->second);
+            if (heap.size() < top_k) {
+                heap.push_back(c);
+                std::push_heap(heap.begin(), heap.end());
+            } else if (c < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = c;
+                std::push_heap(heap.begin(), heap.end());
+            }
+        });
+        std::sort_heap(heap.begin(), heap.end());
+        std::vector<VectorMatch> result(heap.size());
+        for (std::size_t i = 0; i < heap.size(); ++i) {
+            result[i].id = m_ids[heap[i].second];
+            result[i].score = -heap[i].first;
+        }
+        return result;
+    }
+
+    inline void HnswVectorIndex::set_ef_search(std::size_t ef_search) noexcept {
+        m_params.ef_search = ef_search;
+    }
+
+    inline const HnswParams& HnswVectorIndex::params() const noexcept {
+        return m_params;
+    }
+
+    inline std::size_t HnswVectorIndex::size() const noexcept {
+        return m_nodes.size();
+    }
+
+    inline std::size_t HnswVectorIndex::deleted_count() const noexcept {
+        return m_ids.size() - m_nodes.size();
+    }
+
+    inline uint32_t HnswVectorIndex::dim() const noexcept {
+        return m_dim;
+    }
+
+    inline const char* HnswVectorIndex::kernel_name() const noexcept {
+        return m_kernels->name;
+    }
+
+    inline std::size_t HnswVectorIndex::memory_bytes() const noexcept {
+        std::size_t bytes = m_vectors.size() * sizeof(float) +
+                            m_links0.size() * sizeof(std::uint32_t) +
+                            m_ids.size() * (sizeof(uint64_t) + sizeof(char));
+        for (std::size_t i = 0; i < m_upper.size(); ++i) {
+            bytes += m_upper[i].size() * sizeof(std::uint32_t);
+        }
+        return bytes;
+    }
+
+    inline std::vector<float> HnswVectorIndex::prepare(const Embedding& embedding) const {
+        // Normalize for COSINE so the score is a plain dot product.
+        std::vector<float> vec(embedding.values.begin(), embedding.values.end());
+        if (m_metric == VectorMetric::COSINE) {
+            const float norm = std::sqrt(m_kernels->dot(vec.data(), vec.data(), vec.size()));
+            if (norm > 0.0f) {
+                for (std::size_t i = 0; i < vec.size(); ++i) {
+                    vec[i] /= norm;
+                }
+            }
+        }
+        return vec;
+    }
+
+    inline float HnswVectorIndex::distance(const float* a, const float* b) const {
+        // Lower is closer: the negated score of FlatVectorIndex.
+        if (m_metric == VectorMetric::COSINE || m_metric == VectorMetric::DOT) {
+            return -m_kernels->dot(a, b, m_dim);
+        }
+        return m_kernels->l2sq(a, b, m_dim);
+    }
+
+    inline const float* HnswVectorIndex::vector_of(std::uint32_t node) const {
+        return &m_vectors[static_cast<std::size_t>(node) * m_dim];
+    }
+
+    inline std::size_t HnswVectorIndex::max_links(int level) const {
+        return level == 0 ? 2 * m_params.M : m_params.M;
+    }
+
+    inline std::uint32_t* HnswVectorIndex::links(std::uint32_t node, int level) {
+        if (level == 0) {
+            return &m_links0[static_cast<std::size_t>(node) * (max_links(0) + 1)];
+        }
+        return &m_upper[node][static_cast<std::size_t>(level - 1) * (max_links(1) + 1)];
+    }
+
+    inline const std::uint32_t* HnswVectorIndex::links(std::uint32_t node, int level) const {
+        return const_cast<HnswVectorIndex*>(this)->links(node, level);
+    }
+
+    inline int HnswVectorIndex::random_level() {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        const double level = -std::log(1.0 - uniform(m_rng)) * m_level_mult;
+        return static_cast<int>(std::min(level, 32.0));
+    }
+
+    inline std::unique_ptr<detail::HnswVisitedList> HnswVectorIndex::acquire_visited() const {
+        std::unique_ptr<detail::HnswVisitedList> list;
+        {
+            std::lock_guard<std::mutex> lock(m_visited->mutex);
+            if (!m_visited->lists.empty()) {
+                list = std::move(m_visited->lists.back());
+                m_visited->lists.pop_back();
+            }
+        }
+        if (!list) {
+            list.reset(new detail::HnswVisitedList());
+        }
+        return list;
+    }
+
+    inline void HnswVectorIndex::release_visited(std::unique_ptr<detail::HnswVisitedList> list) const {
+        std::lock_guard<std::mutex> lock(m_visited->mutex);
+        m_visited->lists.push_back(std::move(list));
+    }
+
+    inline void HnswVectorIndex::greedy_descend(const float* query, std::uint32_t& node, float& dist,
+                                                int from_level, int to_level) const {
+        for (int l = from_level; l > to_level; --l) {
+            bool changed = true;
+            while (changed) {
+                changed = false;
+                const std::uint32_t* list = links(node, l);
+                for (std::uint32_t i = 1; i <= list[0]; ++i) {
+                    const float d = distance(query, vector_of(list[i]));
+                    if (d < dist) {
+                        dist = d;
+                        node = list[i];
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    inline std::vector<HnswVectorIndex::Candidate> HnswVectorIndex::search_layer(
+            const float* query, std::uint32_t entry, float entry_dist, std::size_t ef,
+            int level, bool skip_deleted, const VectorFilter* filter,
+            detail::HnswVisitedList& visited) const {
+        // Tombstones and filtered-out nodes are expanded but never enter the result set.
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> frontier;
+        std::priority_queue<Candidate> best;
+        visited.reset(m_ids.size());
+        visited.visit(entry);
+        frontier.push(Candidate(entry_dist, entry));
+        if ((!skip_deleted || !m_deleted[entry]) &&
+            (filter == nullptr || filter->allows(m_ids[entry]))) {
+            best.push(Candidate(entry_dist, entry));
+        }
+        while (!frontier.empty()) {
+            const Candidate closest = frontier.top();
+            if (best.size() >= ef && closest.first > best.top().first) {
+                break;
+            }
+            frontier.pop();
+            const std::uint32_t* list = links(closest.second, level);
+            for (std::uint32_t i = 1; i <= list[0]; ++i) {
+                const std::uint32_t next = list[i];
+                if (!visited.visit(next)) {
+                    continue;
+                }
+                const float d = distance(query, vector_of(next));
+                if (best.size() < ef || d < best.top().first) {
+                    frontier.push(Candidate(d, next));
+                    if ((!skip_deleted || !m_deleted[next]) &&
+                        (filter == nullptr || filter->allows(m_ids[next]))) {
+                        best.push(Candidate(d, next));
+                        if (best.size() > ef) {
+                            best.pop();
+                        }
+                    }
+                }
+            }
+        }
+        std::vector<Candidate> result(best.size());
+        for (std::size_t i = result.size(); i > 0; --i) {
+            result[i - 1] = best.top();
+            best.pop();
+        }
+        return result;
+    }
+
+    inline std::vector<HnswVectorIndex::Candidate> HnswVectorIndex::select_neighbors(
+            const std::vector<Candidate>& sorted, std::size_t count) const {
+        // Keep a candidate only if it is closer to the base than to every kept
+        // neighbour, so links spread in different directions.
+        std::vector<Candidate> chosen;
+        chosen.reserve(std::min(count, sorted.size()));
+        for (std::size_t i = 0; i < sorted.size() && chosen.size() < count; ++i) {
+            bool keep = true;
+            for (std::size_t j = 0; j < chosen.size(); ++j) {
+                if (distance(vector_of(sorted[i].second), vector_of(chosen[j].second)) < sorted[i].first) {
+                    keep = false;
+                    break;
+                }
+            }
+            if (keep) {
+                chosen.push_back(sorted[i]);
+            }
+        }
+        return chosen;
+    }
+
+    inline void HnswVectorIndex::connect(std::uint32_t node, std::uint32_t neighbor, int level) {
+        std::uint32_t* list = links(node, level);
+        const std::size_t capacity = max_links(level);
+        if (list[0] < capacity) {
+            list[++list[0]] = neighbor;
+            return;
+        }
+        std::vector<Candidate> candidates;
+        candidates.reserve(capacity + 1);
+        const float* base = vector_of(node);
+        for (std::uint32_t i = 1; i <= list[0]; ++i) {
+            candidates.push_back(Candidate(distance(base, vector_of(list[i])), list[i]));
+        }
+        candidates.push_back(Candidate(distance(base, vector_of(neighbor)), neighbor));
+        std::sort(candidates.begin(), candidates.end());
+        const std::vector<Candidate> chosen = select_neighbors(candidates, capacity);
+        list[0] = static_cast<std::uint32_t>(chosen.size());
+        for (std::size_t i = 0; i < chosen.size(); ++i) {
+            list[i + 1] = chosen[i].second;
+        }
+    }
+
+} // namespace mdbxc
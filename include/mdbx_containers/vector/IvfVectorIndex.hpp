@@ -0,0 +1,169 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_IVF_VECTOR_INDEX_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_IVF_VECTOR_INDEX_HPP_INCLUDED
+
+#include "FlatVectorIndex.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \brief Training and search parameters of \ref IvfVectorIndex.
+    struct IvfParams {
+        /// \brief Number of k-means centroids, i.e. inverted lists. Must be positive.
+        std::size_t nlist = 256;
+        /// \brief Lists scanned per query; raised to 1 when zero.
+        std::size_t nprobe = 8;
+        /// \brief Lloyd iterations run by \ref IvfVectorIndex::train().
+        std::size_t train_iterations = 10;
+        /// \brief Training sample cap per list; larger sets are subsampled.
+        std::size_t samples_per_list = 64;
+        /// \brief Seed of centroid initialization and subsampling.
+        std::uint64_t seed = 100;
+    };
+
+    /// \brief In-memory approximate vector index over k-means inverted lists.
+    ///
+    /// \ref train() clusters the stored vectors into \c nlist centroids and
+    /// files every vector under its nearest centroid. A query scores the
+    /// centroids, then scans the vectors of the \c nprobe best lists with the
+    /// kernels of \ref FlatVectorIndex. Memory is the vectors plus
+    /// <tt>nlist * dim</tt> floats of centroids.
+    ///
+    /// Before training, or after \ref clear(), all vectors live in one list
+    /// and search is exact.
+    ///
+    /// \warning Results are approximate once trained; recall depends on
+    /// \c nprobe. Lists drift as data changes; retrain after large updates.
+    /// The class does not synchronize concurrent mutation and search.
+    class IvfVectorIndex {
+    public:
+        /// \brief Creates an empty, untrained index.
+        /// \param metric Scoring metric used for all vectors and centroids.
+        /// \param params Clustering parameters.
+        /// \throws std::invalid_argument if \c params.nlist is zero.
+        explicit IvfVectorIndex(VectorMetric metric = VectorMetric::COSINE,
+                                const IvfParams& params = IvfParams());
+
+        /// \brief Removes all vectors and centroids and resets the index dimension.
+        void clear();
+
+        /// \brief Clusters the stored vectors and reassigns them to new lists.
+        /// \details Runs k-means with \c min(nlist, size()) centroids on at
+        /// most <tt>nlist * samples_per_list</tt> sampled vectors. Does nothing
+        /// when the index is empty.
+        /// \param threads Worker threads for assignment; 0 uses the hardware concurrency.
+        void train(std::size_t threads = 1);
+
+        /// \brief Restores centroids saved from \ref centroids() into an empty index.
+        /// \param centroids Centroids in list order, all of one dimension.
+        /// \throws std::invalid_argument if the index is not empty, \p centroids
+        ///         is empty, or a centroid is invalid or of another dimension.
+        void set_centroids(const std::vector<Embedding>& centroids);
+
+        /// \brief Returns whether centroids are set.
+        bool trained() const noexcept;
+
+        /// \brief Returns the number of lists; 1 when untrained and non-empty.
+        std::size_t list_count() const noexcept;
+
+        /// \brief Returns a copy of the centroids in list order.
+        std::vector<Embedding> centroids() const;
+
+        /// \brief Returns the list whose centroid is nearest to \p embedding.
+        /// \return 0 when the index is untrained.
+        /// \throws std::invalid_argument if the embedding is invalid or has a mismatched dimension.
+        uint32_t assign(const Embedding& embedding) const;
+
+        /// \brief Adds a vector to its nearest list.
+        /// \param id Caller-owned stable id.
+        /// \param embedding Dense embedding to index.
+        /// \throws std::invalid_argument if the embedding is invalid or has a mismatched dimension.
+        void add(uint64_t id, const Embedding& embedding);
+
+        /// \brief Adds a vector to a known list, e.g. one restored from storage.
+        /// \throws std::invalid_argument if the embedding is invalid or
+        ///         \p list is not below \ref list_count() of a trained index.
+        void add(uint64_t id, const Embedding& embedding, uint32_t list);
+
+        /// \brief Removes a vector id from the index.
+        /// \return \c true if the id was present.
+        bool erase(uint64_t id);
+
+        /// \brief Returns the list holding \p id.
+        /// \return Pair of success flag and list number.
+        std::pair<bool, uint32_t> list_of(uint64_t id) const;
+
+        /// \brief Returns every <tt>(list, id)</tt> pair, grouped by list.
+        std::vector<std::pair<uint32_t, uint64_t>> assignments() const;
+
+        /// \brief Searches the \c nprobe nearest lists.
+        /// \param query Query embedding.
+        /// \param top_k Maximum number of matches to return.
+        /// \return Matches ordered by descending score.
+        /// \throws std::invalid_argument if the query is invalid or has a mismatched dimension.
+        std::vector<VectorMatch> search(const Embedding& query, std::size_t top_k) const;
+
+        /// \brief Searches only the ids admitted by \p filter.
+        /// \details Rejected ids are skipped inside the list scan. While fewer
+        /// than \p top_k matches are found, further lists are scanned in
+        /// centroid order, so the result holds \c min(top_k, admitted ids)
+        /// matches.
+        /// \param query Query embedding.
+        /// \param top_k Maximum number of matches to return.
+        /// \param filter Ids eligible for the result.
+        /// \return Matches ordered by descending score.
+        /// \throws std::invalid_argument if the query is invalid or has a mismatched dimension.
+        std::vector<VectorMatch> search(const Embedding& query, std::size_t top_k,
+                                        const VectorFilter& filter) const;
+
+        /// \brief Sets the number of lists scanned per query.
+        void set_nprobe(std::size_t nprobe) noexcept;
+
+        /// \brief Returns the clustering parameters.
+        const IvfParams& params() const noexcept;
+
+        /// \brief Returns the number of indexed vectors.
+        std::size_t size() const noexcept;
+
+        /// \brief Returns the active index dimension, or zero when empty.
+        uint32_t dim() const noexcept;
+
+        /// \brief Returns the instruction set used for scoring, see \ref FlatVectorIndex::kernel_name().
+        const char* kernel_name() const noexcept;
+
+        /// \brief Returns the bytes held by stored vectors, ids and centroids.
+        std::size_t memory_bytes() const noexcept;
+
+    private:
+        struct InvertedList {
+            std::vector<uint64_t> ids;
+            std::vector<float> vectors; ///< \c m_dim floats per id.
+        };
+
+        VectorMetric m_metric;
+        IvfParams m_params;
+        const detail::DistanceKernels* m_kernels;
+        uint32_t m_dim = 0;
+        std::vector<float> m_centroids;   ///< \c m_dim floats per list; empty when untrained.
+        std::vector<InvertedList> m_lists;
+        std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> m_positions; ///< Id to list and row.
+
+        void check_dim(const Embedding& embedding);
+        std::vector<float> prepare(const Embedding& embedding) const;
+        float score(const float* a, const float* b) const;
+        uint32_t nearest_list(const float* vec) const;
+        void append(uint32_t list, uint64_t id, const float* vec);
+        std::vector<VectorMatch> search_lists(const Embedding& query, std::size_t top_k,
+                                              const VectorFilter* filter) const;
+        void assign_all(const std::vector<float>& vectors, std::vector<uint32_t>& out,
+                        std::size_t threads) const;
+    };
+
+} // namespace mdbxc
+
+#include "IvfVectorIndex.ipp"
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_IVF_VECTOR_INDEX_HPP_INCLUDED
@@ -0,0 +1,412 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace mdbxc {
+
+    namespace detail {
+
+        inline bool ivf_better_match(const VectorMatch& a, const VectorMatch& b) noexcept {
+            return a.score > b.score;
+        }
+
+    } // namespace detail
+
+    inline IvfVectorIndex::IvfVectorIndex(VectorMetric metric, const IvfParams& params)
+        : m_metric(metric), m_params(params), m_kernels(&detail::distance_kernels()) {
+        if (m_params.nlist == 0) {
+            throw std::invalid_argument("IvfParams::nlist must be positive");
+        }
+    }
+
+    inline void IvfVectorIndex::clear() {
+        m_centroids.clear();
+        m_lists.clear();
+        m_positions.clear();
+        m_dim = 0;
+    }
+
+    inline void IvfVectorIndex::check_dim(const Embedding& embedding) {
+        embedding.validate();
+        if (m_dim != 0 && embedding.dim != m_dim) {
+            throw std::invalid_argument("Embedding dimension does not match index dimension");
+        }
+    }
+
+    inline void IvfVectorIndex::train(std::size_t threads) {
+        if (m_positions.empty()) {
+            return;
+        }
+        std::vector<float> all;
+        std::vector<uint64_t> ids;
+        all.reserve(m_positions.size() * m_dim);
+        ids.reserve(m_positions.size());
+        for (std::size_t l = 0; l < m_lists.size(); ++l) {
+            all.insert(all.end(), m_lists[l].vectors.begin(), m_lists[l].vectors.end());
+            ids.insert(ids.end(), m_lists[l].ids.begin(), m_lists[l].ids.end());
+        }
+        const std::size_t n = ids.size();
+        const std::size_t k = std::min(m_params.nlist, n);
+        const std::size_t per_list = std::max<std::size_t>(m_params.samples_per_list, 1);
+        const std::size_t cap = m_params.nlist > n / per_list ? n : m_params.nlist * per_list;
+
+        // Partial Fisher-Yates: the first `cap` rows become a uniform sample,
+        // and its first `k` rows the initial centroids.
+        std::mt19937_64 rng(m_params.seed);
+        std::vector<std::size_t> order(n);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        for (std::size_t i = 0; i < cap; ++i) {
+            std::uniform_int_distribution<std::size_t> pick(i, n - 1);
+            std::swap(order[i], order[pick(rng)]);
+        }
+        std::vector<float> samples(cap * m_dim);
+        for (std::size_t i = 0; i < cap; ++i) {
+            std::memcpy(&samples[i * m_dim], &all[order[i] * m_dim], m_dim * sizeof(float));
+        }
+        m_centroids.assign(samples.begin(), samples.begin() + k * m_dim);
+
+        std::vector<uint32_t> labels;
+        std::vector<uint32_t> previous;
+        std::vector<double> sums(k * m_dim);
+        std::vector<std::size_t> counts(k);
+        std::uniform_int_distribution<std::size_t> any_sample(0, cap - 1);
+        for (std::size_t it = 0; it < m_params.train_iterations; ++it) {
+            assign_all(samples, labels, threads);
+            if (labels == previous) {
+                break;
+            }
+            std::fill(sums.begin(), sums.end(), 0.0);
+            std::fill(counts.begin(), counts.end(), 0);
+            for (std::size_t i = 0; i < cap; ++i) {
+                double* sum = &sums[static_cast<std::size_t>(labels[i]) * m_dim];
+                const float* row = &samples[i * m_dim];
+                for (std::size_t d = 0; d < m_dim; ++d) {
+                    sum[d] += row[d];
+                }
+                ++counts[labels[i]];
+            }
+            for (std::size_t c = 0; c < k; ++c) {
+                float* centroid = &m_centroids[c * m_dim];
+                if (counts[c] == 0) {
+                    // Reseed an empty cluster from a random sample.
+                    std::memcpy(centroid, &samples[any_sample(rng) * m_dim], m_dim * sizeof(float));
+                    continue;
+                }
+                for (std::size_t d = 0; d < m_dim; ++d) {
+                    centroid[d] = static_cast<float>(sums[c * m_dim + d] / static_cast<double>(counts[c]));
+                }
+                if (m_metric == VectorMetric::COSINE) {
+                    const float norm = std::sqrt(m_kernels->dot(centroid, centroid, m_dim));
+                    if (norm > 0.0f) {
+                        for (std::size_t d = 0; d < m_dim; ++d) {
+                            centroid[d] /= norm;
+                        }
+                    }
+                }
+            }
+            previous.swap(labels);
+        }
+
+        assign_all(all, labels, threads);
+        m_lists.assign(k, InvertedList());
+        m_positions.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            append(labels[i], ids[i], &all[i * m_dim]);
+        }
+    }
+
+    inline void IvfVectorIndex::set_centroids(const std::vector<Embedding>& centroids) {
+        if (!m_positions.empty()) {
+            throw std::invalid_argument("IvfVectorIndex centroids can only be set on an empty index");
+        }
+        if (centroids.empty()) {
+            throw std::invalid_argument("IvfVectorIndex centroid list is empty");
+        }
+        const uint32_t dim = centroids.front().dim;
+        std::vector<float> flat;
+        flat.reserve(centroids.size() * dim);
+        for (std::size_t i = 0; i < centroids.size(); ++i) {
+            centroids[i].validate();
+            if (centroids[i].dim != dim) {
+                throw std::invalid_argument("IvfVectorIndex centroid dimensions differ");
+            }
+            flat.insert(flat.end(), centroids[i].values.begin(), centroids[i].values.end());
+        }
+        m_dim = dim;
+        m_centroids.swap(flat);
+        m_lists.assign(centroids.size(), InvertedList());
+    }
+
+    inline bool IvfVectorIndex::trained() const noexcept {
+        return !m_centroids.empty();
+    }
+
+    inline std::size_t IvfVectorIndex::list_count() const noexcept {
+        return m_lists.size();
+    }
+
+    inline std::vector<Embedding> IvfVectorIndex::centroids() const {
+        std::vector<Embedding> result(trained() ? m_lists.size() : 0);
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i].dim = m_dim;
+            result[i].values.assign(m_centroids.begin() + i * m_dim,
+                                    m_centroids.begin() + (i + 1) * m_dim);
+        }
+        return result;
+    }
+
+    inline uint32_t IvfVectorIndex::assign(const Embedding& embedding) const {
+        embedding.validate();
+        if (m_dim != 0 && embedding.dim != m_dim) {
+            throw std::invalid_argument("Embedding dimension does not match index dimension");
+        }
+        if (!trained()) {
+            return 0;
+        }
+        return nearest_list(prepare(embedding).data());
+    }
+
+    inline void IvfVectorIndex::add(uint64_t id, const Embedding& embedding) {
+        check_dim(embedding);
+        const std::vector<float> vec = prepare(embedding);
+        erase(id);
+        m_dim = embedding.dim;
+        append(trained() ? nearest_list(vec.data()) : 0, id, vec.data());
+    }
+
+    inline void IvfVectorIndex::add(uint64_t id, const Embedding& embedding, uint32_t list) {
+        check_dim(embedding);
+        if (trained() ? list >= m_lists.size() : list != 0) {
+            throw std::invalid_argument("IvfVectorIndex list number is out of range");
+        }
+        const std::vector<float> vec = prepare(embedding);
+        erase(id);
+        m_dim = embedding.dim;
+        append(list, id, vec.data());
+    }
+
+    inline void IvfVectorIndex::append(uint32_t list, uint64_t id, const float* vec) {
+        if (m_lists.empty()) {
+            m_lists.resize(1);
+        }
+        InvertedList& target = m_lists[list];
+        m_positions[id] = std::make_pair(list, static_cast<uint32_t>(target.ids.size()));
+        target.ids.push_back(id);
+        target.vectors.insert(target.vectors.end(), vec, vec + m_dim);
+    }
+
+    inline bool IvfVectorIndex::erase(uint64_t id) {
+        const std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>>::iterator it =
+            m_positions.find(id);
+        if (it == m_positions.end()) {
+            return false;
+        }
+        InvertedList& list = m_lists[it->second.first];
+        const std::size_t row = it->second.second;
+        const std::size_t last = list.ids.size() - 1;
+        if (row != last) {
+            list.ids[row] = list.ids[last];
+            std::memcpy(&list.vectors[row * m_dim], &list.vectors[last * m_dim], m_dim * sizeof(float));
+            m_positions[list.ids[row]].second = static_cast<uint32_t>(row);
+        }
+        list.ids.pop_back();
+        list.vectors.resize(list.vectors.size() - m_dim);
+        m_positions.erase(it);
+        if (m_positions.empty() && !trained()) {
+            m_lists.clear();
+            m_dim = 0;
+        }
+        return true;
+    }
+
+    inline std::pair<bool, uint32_t> IvfVectorIndex::list_of(uint64_t id) const {
+        const std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>>::const_iterator it =
+            m_positions.find(id);
+        if (it == m_positions.end()) {
+            return std::make_pair(false, uint32_t(0));
+        }
+        return std::make_pair(true, it->second.first);
+    }
+
+    inline std::vector<std::pair<uint32_t, uint64_t>> IvfVectorIndex::assignments() const {
+        std::vector<std::pair<uint32_t, uint64_t>> result;
+        result.reserve(m_positions.size());
+        for (std::size_t l = 0; l < m_lists.size(); ++l) {
+            for (std::size_t i = 0; i < m_lists[l].ids.size(); ++i) {
+                result.push_back(std::make_pair(static_cast<uint32_t>(l), m_lists[l].ids[i]));
+            }
+        }
+        return result;
+    }
+
+    inline std::vector<VectorMatch> IvfVectorIndex::search(const Embedding& query,
+                                                           std::size_t top_k) const {
+        return search_lists(query, top_k, nullptr);
+    }
+
+    inline std::vector<VectorMatch> IvfVectorIndex::search(const Embedding& query,
+                                                           std::size_t top_k,
+                                                           const VectorFilter& filter) const {
+        return search_lists(query, top_k, &filter);
+    }
+
+    inline std::vector<VectorMatch> IvfVectorIndex::search_lists(const Embedding& query,
+                                                                 std::size_t top_k,
+                                                                 const VectorFilter* filter) const {
+        query.validate();
+        if (m_dim != 0 && query.dim != m_dim) {
+            throw std::invalid_argument("Query dimension does not match index dimension");
+        }
+        std::vector<VectorMatch> heap;
+        if (top_k == 0 || m_positions.empty() || (filter != nullptr && filter->count() == 0)) {
+            return heap;
+        }
+        const std::vector<float> vec = prepare(query);
+
+        std::vector<std::pair<float, uint32_t>> probes;
+        std::size_t nprobe = 1;
+        if (trained()) {
+            probes.resize(m_lists.size());
+            for (std::size_t l = 0; l < m_lists.size(); ++l) {
+                probes[l] = std::make_pair(score(vec.data(), &m_centroids[l * m_dim]),
+                                           static_cast<uint32_t>(l));
+            }
+            nprobe = std::min(std::max<std::size_t>(m_params.nprobe, 1), probes.size());
+            std::partial_sort(probes.begin(), probes.begin() + nprobe, probes.end(),
+                              std::greater<std::pair<float, uint32_t>>());
+            if (filter == nullptr) {
+                probes.resize(nprobe);
+            }
+        } else {
+            probes.push_back(std::make_pair(0.0f, uint32_t(0)));
+        }
+
+        heap.reserve(std::min(top_k, m_positions.size()));
+        for (std::size_t p = 0; p < probes.size(); ++p) {
+            if (p == nprobe) {
+                // Filtered search ran short: widen to the remaining lists.
+                if (heap.size() >= top_k) {
+                    break;
+                }
+                std::sort(probes.begin() + p, probes.end(),
+                          std::greater<std::pair<float, uint32_t>>());
+            }
+            const InvertedList& list = m_lists[probes[p].second];
+            for (std::size_t i = 0; i < list.ids.size(); ++i) {
+                if (filter != nullptr && !filter->allows(list.ids[i])) {
+                    continue;
+                }
+                VectorMatch match;
+                match.id = list.ids[i];
+                match.score = score(vec.data(), &list.vectors[i * m_dim]);
+                if (heap.size() < top_k) {
+                    heap.push_back(match);
+                    std::push_heap(heap.begin(), heap.end(), &detail::ivf_better_match);
+                } else if (match.score > heap.front().score) {
+                    std::pop_heap(heap.begin(), heap.end(), &detail::ivf_better_match);
+                    heap.back() = match;
+                    std::push_heap(heap.begin(), heap.end(), &detail::ivf_better_match);
+                }
+            }
+        }
+        std::sort_heap(heap.begin(), heap.end(), &detail::ivf_better_match);
+        return heap;
+    }
+
+    inline void IvfVectorIndex::set_nprobe(std::size_t nprobe) noexcept {
+        m_params.nprobe = nprobe;
+    }
+
+    inline const IvfParams& IvfVectorIndex::params() const noexcept {
+        return m_params;
+    }
+
+    inline std::size_t IvfVectorIndex::size() const noexcept {
+        return m_positions.size();
+    }
+
+    inline uint32_t IvfVectorIndex::dim() const noexcept {
+        return m_dim;
+    }
+
+    inline const char* IvfVectorIndex::kernel_name() const noexcept {
+        return m_kernels->name;
+    }
+
+    inline std::size_t IvfVectorIndex::memory_bytes() const noexcept {
+        std::size_t bytes = m_centroids.size() * sizeof(float);
+        for (std::size_t l = 0; l < m_lists.size(); ++l) {
+            bytes += m_lists[l].vectors.size() * sizeof(float) + m_lists[l].ids.size() * sizeof(uint64_t);
+        }
+        return bytes;
+    }
+
+    inline std::vector<float> IvfVectorIndex::prepare(const Embedding& embedding) const {
+        // Normalize for COSINE so the score is a plain dot product.
+        std::vector<float> vec(embedding.values.begin(), embedding.values.end());
+        if (m_metric == VectorMetric::COSINE) {
+            const float norm = std::sqrt(m_kernels->dot(vec.data(), vec.data(), vec.size()));
+            if (norm > 0.0f) {
+                for (std::size_t i = 0; i < vec.size(); ++i) {
+                    vec[i] /= norm;
+                }
+            }
+        }
+        return vec;
+    }
+
+    inline float IvfVectorIndex::score(const float* a, const float* b) const {
+        if (m_metric == VectorMetric::COSINE || m_metric == VectorMetric::DOT) {
+            return m_kernels->dot(a, b, m_dim);
+        }
+        // L2: score = -squared_distance (higher is better)
+        return -m_kernels->l2sq(a, b, m_dim);
+    }
+
+    inline uint32_t IvfVectorIndex::nearest_list(const float* vec) const {
+        uint32_t best = 0;
+        float best_score = score(vec, &m_centroids[0]);
+        const std::size_t count = m_centroids.size() / m_dim;
+        for (std::size_t l = 1; l < count; ++l) {
+            const float s = score(vec, &m_centroids[l * m_dim]);
+            if (s > best_score) {
+                best_score = s;
+                best = static_cast<uint32_t>(l);
+            }
+        }
+        return best;
+    }
+
+    inline void IvfVectorIndex::assign_all(const std::vector<float>& vectors,
+                                           std::vector<uint32_t>& out,
+                                           std::size_t threads) const {
+        const std::size_t n = vectors.size() / m_dim;
+        out.resize(n);
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::max<std::size_t>(1, std::min(threads, n / 256));
+        const std::size_t chunk = (n + threads - 1) / threads;
+        const auto work = [this, &vectors, &out, chunk, n](std::size_t t) {
+            const std::size_t end = std::min(n, (t + 1) * chunk);
+            for (std::size_t i = t * chunk; i < end; ++i) {
+                out[i] = nearest_list(&vectors[i * m_dim]);
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t) {
+            workers.emplace_back(work, t);
+        }
+        work(0);
+        for (std::size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    }
+
+} // namespace mdbxc
@@ -0,0 +1,14 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_SEARCH_PAYLOAD_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_SEARCH_PAYLOAD_HPP_INCLUDED
+
+namespace mdbxc {
+    /// \brief Payload fields loaded into \ref SearchResult by \ref VectorStore.
+    enum class SearchPayload {
+        ALL,      ///< Text and metadata.
+        METADATA, ///< Metadata only; \c text stays empty.
+        NONE      ///< Ids and scores only; no payload table is read.
+    };
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_SEARCH_PAYLOAD_HPP_INCLUDED
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_TEXT_INDEX_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_TEXT_INDEX_HPP_INCLUDED
+
+#include "SearchPayload.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace mdbxc {
+
+    /// \brief Posting of one term in one record of the \ref VectorStore text index.
+    /// \details Stored as a fixed-size duplicate under the term, so a term's
+    /// postings are read page by page.
+    struct TextPosting {
+        uint64_t id = 0;      ///< Record id.
+        uint32_t tf = 0;      ///< Occurrences of the term in the record text.
+        uint32_t length = 0;  ///< Tokens in the record text.
+    };
+
+    /// \brief How \ref VectorStore::hybrid_search() combines the two rankings.
+    enum class HybridFusion {
+        RRF,     ///< Reciprocal rank fusion: <tt>sum 1 / (rrf_k + rank)</tt>.
+        WEIGHTED ///< Min-max normalized scores mixed by \c vector_weight.
+    };
+
+    /// \brief Parameters of \ref VectorStore::hybrid_search().
+    struct HybridSearchOptions {
+        /// \brief Fusion method.
+        HybridFusion fusion = HybridFusion::RRF;
+        /// \brief Matches taken from each ranking before fusion; 0 uses
+        /// <tt>max(4 * top_k, 50)</tt>.
+        std::size_t candidates = 0;
+        /// \brief Rank offset of \c RRF; larger values flatten the rank weights.
+        float rrf_k = 60.0f;
+        /// \brief Share of the vector score in \c WEIGHTED; BM25 gets the rest.
+        float vector_weight = 0.5f;
+        /// \brief Payload fields loaded for the fused results.
+        SearchPayload payload = SearchPayload::ALL;
+    };
+
+    namespace detail {
+
+        /// \brief Splits \p text into lowercase terms and counts them.
+        /// \details A term is a run of ASCII letters and digits or of bytes
+        /// >= 0x80, so UTF-8 words stay whole; only ASCII is case-folded.
+        /// Terms longer than 128 bytes are cut to keep MDBX keys small.
+        /// \param text Text to split.
+        /// \param terms Receives term frequencies.
+        /// \return Number of terms in \p text.
+        inline uint32_t tokenize_text(const std::string& text,
+                                      std::map<std::string, uint32_t>& terms) {
+            const std::size_t max_term = 128;
+            uint32_t length = 0;
+            std::string term;
+            for (std::size_t i = 0; i <= text.size(); ++i) {
+                const unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : 0;
+                const bool word = c >= 0x80 || (c >= '0' && c <= '9') ||
+                                  (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+                if (word) {
+                    if (term.size() < max_term) {
+                        term.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a')
+                                                            : static_cast<char>(c));
+                    }
+                } else if (!term.empty()) {
+                    ++terms[term];
+                    ++length;
+                    term.clear();
+                }
+            }
+            return length;
+        }
+
+        /// \brief Okapi BM25 weight of one posting with <tt>k1 = 1.2</tt>, <tt>b = 0.75</tt>.
+        /// \param docs Records in the collection.
+        /// \param df Records containing the term.
+        /// \param tf Term occurrences in the record.
+        /// \param length Record length in terms.
+        /// \param avg_length Mean record length.
+        inline float bm25_weight(std::uint64_t docs, std::size_t df, uint32_t tf,
+                                 uint32_t length, double avg_length) {
+            const double k1 = 1.2;
+            const double b = 0.75;
+            const double idf = std::log(1.0 + (static_cast<double>(docs) - df + 0.5) / (df + 0.5));
+            const double norm = avg_length > 0.0 ? length / avg_length : 1.0;
+            return static_cast<float>(idf * tf * (k1 + 1.0) / (tf + k1 * (1.0 - b + b * norm)));
+        }
+
+    } // namespace detail
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_TEXT_INDEX_HPP_INCLUDED
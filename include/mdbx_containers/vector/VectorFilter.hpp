@@ -0,0 +1,79 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_FILTER_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_FILTER_HPP_INCLUDED
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace mdbxc {
+
+    /// \brief Set of vector ids admitted by a filtered search.
+    ///
+    /// Stored as a bitset indexed by id, so membership is one load and a
+    /// mask inside the scan. Memory is <tt>max_id / 8</tt> bytes, which suits
+    /// the dense ids generated by \ref VectorStore.
+    class VectorFilter {
+    public:
+        /// \brief Admits \p id.
+        void allow(uint64_t id) {
+            const std::size_t word = static_cast<std::size_t>(id >> 6);
+            if (word >= m_words.size()) {
+                m_words.resize(word + 1, 0);
+            }
+            const std::uint64_t bit = std::uint64_t(1) << (id & 63);
+            if ((m_words[word] & bit) == 0) {
+                m_words[word] |= bit;
+                ++m_count;
+            }
+        }
+
+        /// \brief Removes \p id from the set.
+        void deny(uint64_t id) noexcept {
+            const std::size_t word = static_cast<std::size_t>(id >> 6);
+            const std::uint64_t bit = std::uint64_t(1) << (id & 63);
+            if (word < m_words.size() && (m_words[word] & bit) != 0) {
+                m_words[word] &= ~bit;
+                --m_count;
+            }
+        }
+
+        /// \brief Returns whether \p id is admitted.
+        bool allows(uint64_t id) const noexcept {
+            const std::size_t word = static_cast<std::size_t>(id >> 6);
+            return word < m_words.size() &&
+                   (m_words[word] >> (id & 63) & 1u) != 0;
+        }
+
+        /// \brief Returns the number of admitted ids.
+        std::size_t count() const noexcept {
+            return m_count;
+        }
+
+        /// \brief Removes every id.
+        void clear() noexcept {
+            m_words.clear();
+            m_count = 0;
+        }
+
+        /// \brief Calls \p fn with each admitted id in ascending order.
+        template<typename FunctionT>
+        void for_each(FunctionT fn) const {
+            for (std::size_t w = 0; w < m_words.size(); ++w) {
+                std::uint64_t bits = m_words[w];
+                for (uint64_t id = static_cast<uint64_t>(w) * 64; bits != 0; ++id, bits >>= 1) {
+                    if ((bits & 1u) != 0) {
+                        fn(id);
+                    }
+                }
+            }
+        }
+
+    private:
+        std::vector<std::uint64_t> m_words;
+        std::size_t m_count = 0;
+    };
+
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_FILTER_HPP_INCLUDED
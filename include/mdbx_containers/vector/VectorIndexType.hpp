@@ -0,0 +1,14 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_INDEX_TYPE_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_INDEX_TYPE_HPP_INCLUDED
+
+namespace mdbxc {
+    /// \brief In-memory index used by \ref VectorStore.
+    enum class VectorIndexType {
+        FLAT, ///< \ref FlatVectorIndex; exact brute-force scan.
+        HNSW, ///< \ref HnswVectorIndex; approximate graph search.
+        IVF   ///< \ref IvfVectorIndex; approximate search over k-means lists.
+    };
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_INDEX_TYPE_HPP_INCLUDED
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_QUANTIZATION_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_QUANTIZATION_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mdbxc {
+    /// \brief In-memory representation of vectors held by \ref FlatVectorIndex.
+    enum class VectorQuantization {
+        NONE, ///< 32-bit floats; exact scores.
+        INT8, ///< Symmetric int8 codes with one float scale per vector; about 4x smaller.
+        FP16, ///< IEEE half precision; 2x smaller.
+        PQ,   ///< Product quantization: one byte per subspace once trained, see \ref PqParams.
+        BINARY ///< One sign bit per component scored by Hamming distance; 32x smaller.
+    };
+
+    /// \brief Codebook parameters of \ref VectorQuantization::PQ.
+    /// \details A vector is split into \c subspaces equal slices, and each
+    /// slice is stored as the index of the nearest of 256 k-means centroids,
+    /// so a row takes \c subspaces bytes.
+    struct PqParams {
+        /// \brief Number of slices; must divide the dimension. Code size in bytes.
+        std::size_t subspaces = 8;
+        /// \brief Lloyd iterations per subspace.
+        std::size_t train_iterations = 10;
+        /// \brief Training sample cap; larger sets are subsampled.
+        std::size_t max_samples = 65536;
+        /// \brief Seed of centroid initialization and subsampling.
+        std::uint64_t seed = 100;
+    };
+
+    /// \brief Two-stage truncated-dimension search of \ref FlatVectorIndex.
+    /// \details Models trained with Matryoshka representation learning keep
+    /// most of their ranking signal in the leading components. With a
+    /// non-zero \c dim the index also holds the first \c dim components of
+    /// every row as floats, scans only that compact block, and re-scores the
+    /// best <tt>top_k * rerank_factor</tt> rows at the full dimension.
+    struct PrefixParams {
+        /// \brief Leading components scanned in the first pass; 0 disables
+        /// the mode, as does a value not below the index dimension.
+        std::uint32_t dim = 0;
+        /// \brief First-pass candidates kept per requested match.
+        std::size_t rerank_factor = 4;
+    };
+} // namespace mdbxc
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_QUANTIZATION_HPP_INCLUDED
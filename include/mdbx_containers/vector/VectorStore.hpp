@@ -3,26 +3,99 @@
 #define MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_STORE_HPP_INCLUDED
 
 #include "FlatVectorIndex.hpp"
+#include "HnswVectorIndex.hpp"
+#include "IvfVectorIndex.hpp"
+#include "VectorIndexType.hpp"
 #include "VectorRecord.hpp"
+#include "SearchPayload.hpp"
+#include "TextIndex.hpp"
 #include "SearchResult.hpp"
 #include <string>
+#include <future>
+#include <map>
+#include <unordered_map>
 #include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
+#if __cplusplus >= 201703L
+#   include <shared_mutex>
+#endif
 
 namespace mdbxc {
 
-    /// \brief Persistent local vector store with an exact in-memory search index.
+    /// \brief Construction options of \ref VectorStore.
+    struct VectorStoreOptions {
+        /// \brief Metric used by the in-memory index.
+        VectorMetric metric = VectorMetric::COSINE;
+        /// \brief In-memory representation of indexed vectors.
+        VectorQuantization quantization = VectorQuantization::NONE;
+        /// \brief With quantization, \c search() re-ranks
+        /// <tt>top_k * rerank_factor</tt> candidates from persisted embeddings.
+        std::size_t rerank_factor = 4;
+        /// \brief In-memory index kind.
+        VectorIndexType index_type = VectorIndexType::FLAT;
+        /// \brief Precision of embeddings written to the embeddings table.
+        /// \details \c FP16 and \c BF16 halve the table and the bytes read
+        /// by rebuilds and re-ranking; rows are widened to fp32 on read, so
+        /// every index kind and quantization works unchanged. Each row records
+        /// its own precision, so changing this option on reopen only affects
+        /// new writes. The RAM index keeps the fp32 values of records added
+        /// in this session until it is rebuilt from the table.
+        EmbeddingPrecision embedding_precision = EmbeddingPrecision::FP32;
+        /// \brief Leading components scanned by the flat index before a
+        /// full-dimension re-rank; 0 scans whole vectors.
+        /// \details Meant for Matryoshka-trained models whose embedding
+        /// prefixes are usable embeddings. The first pass keeps
+        /// <tt>top_k * rerank_factor</tt> candidates, see \ref PrefixParams.
+        /// Requires the flat index and \c NONE, \c INT8 or \c FP16 quantization.
+        std::uint32_t prefix_dim = 0;
+        /// \brief Graph parameters used when \c index_type is \c HNSW.
+        HnswParams hnsw;
+        /// \brief Clustering parameters used when \c index_type is \c IVF.
+        IvfParams ivf;
+        /// \brief Codebook parameters used when \c quantization is \c PQ.
+        PqParams pq;
+        /// \brief Persist flat index snapshots and load them on open instead
+        /// of rebuilding, see \ref VectorStore::save_index_snapshot().
+        bool index_snapshot = false;
+        /// \brief Base path of a snapshot sidecar file mapped by every process.
+        /// \details Requires \c index_snapshot. When set,
+        /// \ref VectorStore::save_index_snapshot() writes the flat index to
+        /// <tt>shared_index_path + "." + generation</tt> instead of MDBX, and
+        /// opening maps that file copy-on-write, so processes on one host
+        /// share the vector block through the page cache. Empty disables it.
+        std::string shared_index_path;
+        /// \brief Maintain a BM25 inverted index over record texts for
+        /// \ref VectorStore::text_search() and \ref VectorStore::hybrid_search().
+        /// \details Postings are written in the transaction of every add and
+        /// erase. Opening a store whose text index disagrees with the text
+        /// count rebuilds it.
+        bool text_index = false;
+    };
+
+    /// \brief Persistent local vector store with an in-memory search index.
     ///
     /// The store persists embeddings, text, and metadata in MDBX tables, then
-    /// rebuilds a \ref FlatVectorIndex when opened.
+    /// rebuilds a \ref FlatVectorIndex, \ref HnswVectorIndex or
+    /// \ref IvfVectorIndex when opened. IVF centroids and list assignments are
+    /// persisted too, so reopening an IVF store does not retrain.
     ///
-    /// \warning Search is exact \c O(N*dim), all embeddings are loaded into RAM,
-    /// and mutable index synchronization is caller-managed.
+    /// \warning Flat search is exact \c O(N*dim); HNSW and IVF search is approximate.
+    /// All embeddings are loaded into RAM, and mutable index synchronization
+    /// is caller-managed.
     /// \warning Lazy sync-apply refresh is protected by the connection
-    /// apply/read barrier. One \c VectorStore instance serializes its public
-    /// operations with an instance mutex. In C++17 builds, different
-    /// cache-backed readers can still share the connection read side; C++11
-    /// builds conservatively serialize the connection barrier.
+    /// apply/read barrier. The store observes remote applies and, on the next
+    /// operation, re-reads only the embedding ids they touched; a remote clear,
+    /// IVF retraining, or a missed event falls back to a full rebuild.
+    /// Searches and \c count() on one \c VectorStore instance hold its lock
+    /// shared and run in parallel; mutations and index refreshes hold it
+    /// exclusively. C++11 builds have no shared mutex and serialize all
+    /// public operations, including the connection barrier.
+    ///
+    /// With \ref VectorStoreOptions::index_snapshot, the flat index is opened
+    /// from the snapshot written by \ref save_index_snapshot() and only the
+    /// ids changed since then are re-read from the embeddings table.
     ///
     /// \note Non-empty collections have a single active dimension established by
     /// the first successfully added embedding.
@@ -33,22 +106,73 @@ namespace mdbxc {
         /// \param collection Logical collection name. Allowed characters are
         /// ASCII letters, digits, \c _ and \c -.
         /// \param metric Metric used by the in-memory index.
+        /// \param quantization In-memory representation of indexed vectors.
+        /// \param rerank_factor With quantization, \c search() re-ranks
+        /// <tt>top_k * rerank_factor</tt> candidates from persisted embeddings.
+        /// \param index_type In-memory index kind.
+        /// \param hnsw Graph parameters used when \c index_type is \c HNSW.
+        /// \param ivf Clustering parameters used when \c index_type is \c IVF.
         /// \throws std::invalid_argument if \c collection is empty or contains
-        /// unsupported characters.
+        /// unsupported characters, \c rerank_factor is zero, or quantization
+        /// is combined with an index other than \c VectorIndexType::FLAT.
         VectorStore(const Config& config,
                     std::string collection = "default",
-                    VectorMetric metric = VectorMetric::COSINE);
+                    VectorMetric metric = VectorMetric::COSINE,
+                    VectorQuantization quantization = VectorQuantization::NONE,
+                    std::size_t rerank_factor = 4,
+                    VectorIndexType index_type = VectorIndexType::FLAT,
+                    const HnswParams& hnsw = HnswParams(),
+                    const IvfParams& ivf = IvfParams());
 
         /// \brief Opens a vector store using an existing connection.
         /// \param connection Shared MDBX connection.
         /// \param collection Logical collection name. Allowed characters are
         /// ASCII letters, digits, \c _ and \c -.
         /// \param metric Metric used by the in-memory index.
-        /// \throws std::invalid_argument if \c connection is null, or
-        /// \c collection is empty or contains unsupported characters.
+        /// \param quantization In-memory representation of indexed vectors.
+        /// \param rerank_factor With quantization, \c search() re-ranks
+        /// <tt>top_k * rerank_factor</tt> candidates from persisted embeddings.
+        /// \param index_type In-memory index kind.
+        /// \param hnsw Graph parameters used when \c index_type is \c HNSW.
+        /// \param ivf Clustering parameters used when \c index_type is \c IVF.
+        /// \throws std::invalid_argument if \c connection is null,
+        /// \c collection is empty or contains unsupported characters,
+        /// \c rerank_factor is zero, or quantization is combined with an
+        /// index other than \c VectorIndexType::FLAT.
         VectorStore(std::shared_ptr<Connection> connection,
                     std::string collection = "default",
-                    VectorMetric metric = VectorMetric::COSINE);
+                    VectorMetric metric = VectorMetric::COSINE,
+                    VectorQuantization quantization = VectorQuantization::NONE,
+                    std::size_t rerank_factor = 4,
+                    VectorIndexType index_type = VectorIndexType::FLAT,
+                    const HnswParams& hnsw = HnswParams(),
+                    const IvfParams& ivf = IvfParams());
+
+        /// \brief Opens a vector store using a new MDBX connection.
+        /// \param config MDBX environment configuration.
+        /// \param collection Logical collection name.
+        /// \param options Index and snapshot options.
+        /// \throws std::invalid_argument if \c collection is invalid,
+        /// \c options.rerank_factor is zero, quantization,
+        /// \c options.index_snapshot or \c options.prefix_dim is combined
+        /// with an index other than \c VectorIndexType::FLAT, or
+        /// \c options.prefix_dim is combined with \c PQ or \c BINARY.
+        VectorStore(const Config& config,
+                    std::string collection,
+                    const VectorStoreOptions& options);
+
+        /// \brief Opens a vector store using an existing connection.
+        /// \param connection Shared MDBX connection.
+        /// \param collection Logical collection name.
+        /// \param options Index and snapshot options.
+        /// \throws std::invalid_argument if \c connection is null or an
+        /// argument is invalid as for the \c Config overload.
+        VectorStore(std::shared_ptr<Connection> connection,
+                    std::string collection,
+                    const VectorStoreOptions& options);
+
+        /// \brief Unregisters the sync apply observer.
+        ~VectorStore();
 
         VectorStore(const VectorStore&) = delete;
         VectorStore& operator=(const VectorStore&) = delete;
@@ -66,7 +190,28 @@ namespace mdbxc {
                      const std::string& text,
                      const std::string& metadata_json = "{}");
 
+        /// \brief Adds many records in one write transaction.
+        /// \details Ids are taken from the sequence in one run, and the
+        /// embedding, text and metadata rows are written through the
+        /// \c MDBX_APPEND fast path. The RAM index is updated in one pass after
+        /// commit. \c VectorRecord::id and \c VectorRecord::collection are
+        /// ignored; an empty \c metadata_json is stored as <tt>"{}"</tt>.
+        /// Rows are staged in memory before the write, so split very large
+        /// ingests into batches of a few thousand records.
+        /// \param records Records to add; all embeddings share one dimension.
+        /// \return Half-open id range <tt>[first_id, end_id)</tt> assigned in
+        ///         record order; <tt>(0, 0)</tt> for an empty batch.
+        /// \throws std::invalid_argument if an embedding is invalid or its
+        ///         dimension differs from the index or the other records;
+        ///         nothing is written in that case.
+        /// \throws MdbxException if a database error occurs.
+        std::pair<uint64_t, uint64_t> add_batch(const std::vector<VectorRecord>& records);
+
         /// \brief Searches the RAM index and loads payloads for matches.
+        /// \details With quantization, the best <tt>top_k * rerank_factor</tt>
+        /// approximate matches are re-scored exactly from persisted embeddings,
+        /// so returned scores are those of the \ref
+        /// VectorStoreOptions::embedding_precision values.
         /// \param query Query embedding.
         /// \param top_k Maximum number of matches.
         /// \return Search results ordered by descending score.
@@ -75,6 +220,101 @@ namespace mdbxc {
         std::vector<SearchResult> search(const Embedding& query,
                                          std::size_t top_k) const;
 
+        /// \brief Searches only the ids admitted by \p filter.
+        /// \details The filter is applied inside the index scan or graph
+        /// traversal, so rejected records are never scored against payloads
+        /// and the result holds \c min(top_k, admitted records) matches.
+        /// Build the filter with \ref make_filter() or from ids kept by the caller.
+        /// \param query Query embedding.
+        /// \param top_k Maximum number of matches.
+        /// \param filter Record ids eligible for the result.
+        /// \return Search results ordered by descending score.
+        /// \throws std::invalid_argument if \c query is invalid.
+        /// \throws std::runtime_error if persisted payload rows are missing.
+        std::vector<SearchResult> search(const Embedding& query,
+                                         std::size_t top_k,
+                                         const VectorFilter& filter) const;
+
+        /// \brief Searches and loads only the payload fields in \p payload.
+        /// \details Payload rows of all matches are read with one cursor walk
+        /// per table. \ref SearchPayload::NONE returns ids and scores without
+        /// reading the text or metadata tables; fetch the survivors of a
+        /// re-ranking step later with \ref load_payloads().
+        /// \param query Query embedding.
+        /// \param top_k Maximum number of matches.
+        /// \param payload Fields to load; others stay empty.
+        /// \return Search results ordered by descending score.
+        /// \throws std::invalid_argument if \c query is invalid.
+        /// \throws std::runtime_error if requested payload rows are missing.
+        std::vector<SearchResult> search(const Embedding& query,
+                                         std::size_t top_k,
+                                         SearchPayload payload) const;
+
+        /// \brief Filtered search that loads only the payload fields in \p payload.
+        /// \param query Query embedding.
+        /// \param top_k Maximum number of matches.
+        /// \param filter Record ids eligible for the result.
+        /// \param payload Fields to load; others stay empty.
+        /// \return Search results ordered by descending score.
+        /// \throws std::invalid_argument if \c query is invalid.
+        /// \throws std::runtime_error if requested payload rows are missing.
+        std::vector<SearchResult> search(const Embedding& query,
+                                         std::size_t top_k,
+                                         const VectorFilter& filter,
+                                         SearchPayload payload) const;
+
+        /// \brief Loads payload fields for results returned without them.
+        /// \details Keys are resolved by one sorted cursor walk per table, see
+        /// \ref KeyValueTable::find_many_batch_compat(). Results whose record
+        /// was erased since the search are left unchanged.
+        /// \param results Results to fill, matched by \c id.
+        /// \param payload Fields to load.
+        /// \return Number of results whose requested fields were found.
+        /// \throws MdbxException if a database error occurs.
+        std::size_t load_payloads(std::vector<SearchResult>& results,
+                                  SearchPayload payload = SearchPayload::ALL) const;
+
+        /// \brief Ranks records by BM25 over their texts.
+        /// \details Query terms are split like record texts; each term's
+        /// postings are read once from the inverted index.
+        /// \param text_query Free-text query.
+        /// \param top_k Maximum number of matches.
+        /// \param payload Fields to load; others stay empty.
+        /// \return Results with BM25 scores, ordered by descending score.
+        /// \throws std::logic_error if \c VectorStoreOptions::text_index is off.
+        /// \throws std::runtime_error if requested payload rows are missing.
+        std::vector<SearchResult> text_search(const std::string& text_query,
+                                              std::size_t top_k,
+                                              SearchPayload payload = SearchPayload::ALL) const;
+
+        /// \brief Fuses vector and BM25 rankings in one call.
+        /// \details Takes \c options.candidates matches from the RAM index and
+        /// from the text index under one lock, fuses them by \c options.fusion,
+        /// and loads payloads only for the fused \p top_k. Scores of the
+        /// results are the fused scores.
+        /// \param query Query embedding.
+        /// \param text_query Free-text query.
+        /// \param top_k Maximum number of matches.
+        /// \param options Fusion parameters.
+        /// \return Fused results ordered by descending score.
+        /// \throws std::invalid_argument if \c query is invalid.
+        /// \throws std::logic_error if \c VectorStoreOptions::text_index is off.
+        /// \throws std::runtime_error if requested payload rows are missing.
+        std::vector<SearchResult> hybrid_search(const Embedding& query,
+                                                const std::string& text_query,
+                                                std::size_t top_k,
+                                                const HybridSearchOptions& options =
+                                                    HybridSearchOptions()) const;
+
+        /// \brief Builds a filter from the persisted metadata of every record.
+        /// \details Reads the metadata table once; reuse the filter across
+        /// queries while the predicate's answers stay valid.
+        /// \param predicate Called as <tt>predicate(uint64_t id, const std::string& metadata_json)</tt>;
+        ///        returns \c true to admit the record.
+        /// \return Filter admitting the accepted ids.
+        template<typename PredicateT>
+        VectorFilter make_filter(PredicateT predicate) const;
+
         /// \brief Removes a record from persistent tables and the RAM index.
         /// \param id Record id.
         /// \return \c true if any persisted row existed.
@@ -83,8 +323,59 @@ namespace mdbxc {
         /// \brief Clears all persistent tables and the RAM index.
         void clear();
 
-        /// \brief Rebuilds the RAM index from persisted embeddings.
-        void rebuild_index();
+        /// \brief Rebuilds the RAM index from persisted embeddings while searches continue.
+        /// \details Builds a second index from a read snapshot without holding
+        /// the store lock, so searches keep using the current index. Records
+        /// added or erased meanwhile, locally or by sync applies, are
+        /// journaled; the journal is replayed into the new index, which is
+        /// then swapped in under the lock. Also drops HNSW tombstones left by
+        /// \c erase(). Rebuilds run one at a time, and the peak RAM holds both
+        /// indexes. A released index is loaded in the foreground instead.
+        /// \return \c false if \c clear(), \c train_index(), \c release_index()
+        ///         or a fallback full rebuild replaced the index meanwhile; the
+        ///         new index is then discarded.
+        /// \throws MdbxException if a database error occurs; the current index is kept.
+        bool rebuild_index();
+
+        /// \brief Runs \ref rebuild_index() on a new thread.
+        /// \details The store must outlive the returned future.
+        /// \return Future of the \ref rebuild_index() result.
+        std::future<bool> rebuild_index_async();
+
+        /// \brief Trains IVF centroids or PQ codebooks on all embeddings and persists them.
+        /// \details For IVF, runs \c IvfVectorIndex::train(), then replaces the
+        /// stored centroids and list assignments in one write transaction.
+        /// Later adds are filed under the persisted centroids until the next
+        /// training. With \c VectorQuantization::PQ, trains new codebooks on the
+        /// fp32 embeddings, stores them, and swaps in the re-encoded flat
+        /// index; reopening encodes with the stored codebooks, and snapshots
+        /// saved before the training are ignored.
+        /// \param threads Worker threads for k-means; 0 uses the hardware concurrency.
+        /// \throws std::logic_error if the store uses neither \c VectorIndexType::IVF
+        ///         nor \c VectorQuantization::PQ.
+        /// \throws std::invalid_argument if PQ subspaces do not divide the dimension.
+        /// \throws MdbxException if a database error occurs; the RAM index is
+        ///         then rebuilt from the previous persisted state.
+        void train_index(std::size_t threads = 1);
+
+        /// \brief Persists the flat index so the next open skips the rebuild.
+        /// \details Replaces the stored snapshot and empties the set of ids
+        /// changed since the previous one in a single write transaction.
+        /// On open, the snapshot is copied into RAM, changed ids are re-read,
+        /// and the index is rebuilt from embeddings if the snapshot is missing,
+        /// unreadable, or disagrees with the embedding count.
+        ///
+        /// With \c VectorStoreOptions::shared_index_path, the snapshot is
+        /// written to a new sidecar file of the next generation, committed by
+        /// a small record in MDBX, and then mapped by this store; the previous
+        /// file is removed, and processes still mapping it keep their view.
+        /// \throws std::logic_error if \c VectorStoreOptions::index_snapshot is off.
+        /// \throws std::runtime_error if the sidecar file cannot be written.
+        /// \throws MdbxException if a database error occurs.
+        /// \warning Embedding rows written without this store (e.g. directly
+        /// through the tables) are not tracked; call \ref rebuild_index() and
+        /// save a new snapshot afterwards.
+        void save_index_snapshot();
 
         /// \brief Returns the number of persisted embeddings.
         std::size_t count() const;
@@ -92,27 +383,154 @@ namespace mdbxc {
         /// \brief Returns the validated collection name.
         const std::string& collection() const noexcept;
 
+        /// \brief Frees the RAM index; the next operation that needs it reloads it.
+        /// \details The reload maps or copies the index snapshot when
+        /// \ref VectorStoreOptions::index_snapshot is on and rebuilds from the
+        /// embeddings otherwise. Persisted rows are untouched.
+        /// \ref VectorStoreRegistry uses it to evict cold collections.
+        void release_index();
+
+        /// \brief Returns whether the RAM index is loaded.
+        bool index_loaded() const;
+
+        /// \brief Returns the heap bytes of the RAM index, 0 while released.
+        /// \details Rows mapped from a shared snapshot file are not counted.
+        std::size_t index_memory_bytes() const;
+
     private:
         std::string m_collection;
         VectorMetric m_metric;
+        VectorQuantization m_quantization;
+        std::size_t m_rerank_factor;
+        VectorIndexType m_index_type;
+        EmbeddingPrecision m_embedding_precision;
+        std::string m_shared_index_path;
         std::shared_ptr<Connection> m_connection;
         SequenceTable<uint64_t> m_ids;
         mutable KeyValueTable<uint64_t, Embedding> m_embeddings;
         KeyValueTable<uint64_t, std::string> m_texts;
-        KeyValueTable<uint64_t, std::string> m_metadata;
+        mutable KeyValueTable<uint64_t, std::string> m_metadata;
         mutable FlatVectorIndex m_index;
+        mutable HnswVectorIndex m_hnsw;
+        mutable IvfVectorIndex m_ivf;
+        std::unique_ptr<KeyMultiValueTable<uint32_t, uint64_t>> m_ivf_lists; ///< IVF list to ids.
+        std::unique_ptr<KeyValueTable<uint32_t, Embedding>> m_ivf_centroids; ///< IVF list to centroid.
+        std::unique_ptr<KeyValueTable<uint32_t, std::vector<float>>> m_pq_codebooks; ///< PQ codebooks under key 0.
+        std::unique_ptr<KeyValueTable<uint32_t, std::vector<uint8_t>>> m_snapshot; ///< Header at key 0, then chunks.
+        std::unique_ptr<KeyTable<uint64_t>> m_dirty; ///< Ids changed since the snapshot.
+        std::unique_ptr<KeyMultiValueTable<std::string, TextPosting, DupFixedTableOptions>> m_postings; ///< Term to postings.
+        std::unique_ptr<KeyValueTable<uint32_t, std::uint64_t>> m_text_stats; ///< Key 0: records, key 1: terms.
         mutable std::uint64_t m_sync_apply_generation_seen = 0;
-        mutable std::mutex m_store_mutex;
+        mutable bool m_index_released = false; ///< Set by \ref release_index() until the next load.
+        /// \brief Bumped whenever the index is replaced outside \ref rebuild_index().
+        mutable std::uint64_t m_index_epoch = 0;
+        mutable bool m_rebuild_journal = false; ///< Writers record ids for a running rebuild.
+        mutable std::vector<uint64_t> m_rebuild_changed; ///< Ids changed since the rebuild snapshot.
+        std::mutex m_rebuild_mutex; ///< Serializes \ref rebuild_index().
+#if __cplusplus >= 201703L
+        using StoreMutex = std::shared_mutex;
+        using StoreReadLock = std::shared_lock<StoreMutex>;
+#else
+        using StoreMutex = std::mutex;
+        using StoreReadLock = std::unique_lock<StoreMutex>;
+#endif
+        using StoreWriteLock = std::unique_lock<StoreMutex>;
+        /// \brief Shared by searches and \c count(), exclusive for index mutation.
+        mutable StoreMutex m_store_mutex;
+#if MDBXC_SYNC_ENABLED
+        /// \brief Records embedding ids touched by remote sync applies.
+        class ApplyObserver final : public sync::ISyncApplyObserver {
+        public:
+            explicit ApplyObserver(const VectorStore& store) : m_store(store) {}
+            void on_sync_apply_committed(const sync::SyncApplyEvent& event) override;
+        private:
+            const VectorStore& m_store;
+        };
+
+        /// \brief Changes of one apply generation not yet applied to the index.
+        struct PendingApply {
+            bool rebuild = false;       ///< Needs a full rebuild (clear, retrain, overflow).
+            std::vector<uint64_t> ids;  ///< Touched embedding ids.
+        };
+
+        /// \brief Pending ids above which events request a full rebuild instead.
+        static const std::size_t max_pending_ids = std::size_t(1) << 16;
+
+        mutable std::mutex m_pending_mutex;
+        mutable std::map<std::uint64_t, PendingApply> m_pending; ///< By apply generation.
+        mutable std::size_t m_pending_ids = 0;
+        std::unique_ptr<ApplyObserver> m_apply_observer;
+        std::uint64_t m_apply_observer_token = 0;
+
+        void record_sync_apply(const sync::SyncApplyEvent& event) const;
+        bool refresh_index_locked() const;
+        void apply_changed_ids_locked(std::vector<uint64_t> ids) const;
+#endif
+        void apply_changed_ids(std::vector<uint64_t> ids, FlatVectorIndex& flat,
+                               HnswVectorIndex& hnsw, IvfVectorIndex& ivf) const;
+        void note_changed_locked(uint64_t first, uint64_t end) const;
 
         static std::shared_ptr<Connection> require_connection(std::shared_ptr<Connection> connection);
         static std::string validate_collection_name(const std::string& name);
+        static std::size_t validate_rerank_factor(std::size_t factor);
+        static VectorIndexType validate_index_type(VectorIndexType type,
+                                                   VectorQuantization quantization,
+                                                   bool index_snapshot,
+                                                   std::uint32_t prefix_dim);
+        static PrefixParams make_prefix_params(const VectorStoreOptions& options);
+        static std::string validate_shared_index_path(const std::string& path,
+                                                      bool index_snapshot);
+        static VectorStoreOptions make_options(VectorMetric metric,
+                                               VectorQuantization quantization,
+                                               std::size_t rerank_factor,
+                                               VectorIndexType index_type,
+                                               const HnswParams& hnsw,
+                                               const IvfParams& ivf);
+        static std::shared_ptr<Connection> open_connection(const Config& config,
+                                                           const std::string& collection,
+                                                           const VectorStoreOptions& options);
         static std::string make_table_name(const std::string& collection, const std::string& suffix);
+        void open_ivf_tables();
+        void open_pq_tables();
+        void train_pq_locked(std::size_t threads);
+        void open_snapshot_tables();
+        void open_text_tables();
+        uint32_t post_text_locked(uint64_t id, const std::string& text, bool insert,
+                                  const Transaction& txn);
+        void add_text_stats_locked(std::int64_t records, std::int64_t terms, const Transaction& txn);
+        void rebuild_text_index_locked();
+        std::vector<VectorMatch> text_matches_locked(const std::string& text_query,
+                                                     std::size_t top_k) const;
+        std::vector<VectorMatch> match_locked(const Embedding& query, std::size_t top_k,
+                                              const VectorFilter* filter) const;
+        uint32_t index_dim() const;
         void ensure_index_fresh() const;
         void ensure_index_fresh_locked() const;
         bool is_index_fresh() const;
-        std::vector<SearchResult> search_locked(const Embedding& query,
-                                                std::size_t top_k) const;
+        std::size_t load_payloads_locked(std::vector<SearchResult>& results,
+                                         SearchPayload payload, bool required) const;
+        template<typename FunctionT>
+        std::vector<SearchResult> search_guarded(FunctionT search) const;
+        std::vector<SearchResult> make_results_locked(const std::vector<VectorMatch>& matches,
+                                                      SearchPayload payload) const;
+        static void fuse_ranking(const std::vector<VectorMatch>& ranking,
+                                 const HybridSearchOptions& options, float weight,
+                                 std::unordered_map<uint64_t, float>& fused);
+        static void sort_matches(std::vector<VectorMatch>& matches, std::size_t top_k);
+        template<typename CallbackT>
+        void for_each_embedding(const Transaction& txn, CallbackT callback) const;
+        void build_index(const Transaction& txn, FlatVectorIndex& flat,
+                         HnswVectorIndex& hnsw, IvfVectorIndex& ivf) const;
+        void install_index_locked(FlatVectorIndex& flat, HnswVectorIndex& hnsw,
+                                  IvfVectorIndex& ivf) const;
         void rebuild_index_impl_locked() const;
+        void load_index_locked() const;
+        bool load_snapshot_locked() const;
+        bool load_snapshot_chunks_locked(FlatVectorIndex& restored,
+                                         const std::vector<uint8_t>& header,
+                                         const Transaction& txn) const;
+        void save_shared_snapshot_locked(Transaction& txn);
+        std::string shared_index_file(std::uint64_t generation) const;
         std::uint64_t current_sync_apply_generation() const;
     };
 
@@ -1,5 +1,11 @@
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
 #include <stdexcept>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -28,39 +34,250 @@ namespace mdbxc {
         return name;
     }
 
+    inline std::size_t VectorStore::validate_rerank_factor(std::size_t factor) {
+        if (factor == 0) {
+            throw std::invalid_argument("VectorStore rerank_factor must be positive");
+        }
+        return factor;
+    }
+
+    inline VectorIndexType VectorStore::validate_index_type(VectorIndexType type,
+                                                            VectorQuantization quantization,
+                                                            bool index_snapshot,
+                                                            std::uint32_t prefix_dim) {
+        if (type != VectorIndexType::FLAT && quantization != VectorQuantization::NONE) {
+            throw std::invalid_argument("VectorStore quantization requires the flat index");
+        }
+        if (type != VectorIndexType::FLAT && index_snapshot) {
+            throw std::invalid_argument("VectorStore index snapshots require the flat index");
+        }
+        if (prefix_dim != 0 && (type != VectorIndexType::FLAT ||
+                                quantization == VectorQuantization::PQ ||
+                                quantization == VectorQuantization::BINARY)) {
+            throw std::invalid_argument("VectorStore prefix search requires the flat index without PQ or BINARY");
+        }
+        return type;
+    }
+
+    inline PrefixParams VectorStore::make_prefix_params(const VectorStoreOptions& options) {
+        PrefixParams prefix;
+        prefix.dim = options.prefix_dim;
+        prefix.rerank_factor = options.rerank_factor;
+        return prefix;
+    }
+
+    inline std::string VectorStore::validate_shared_index_path(const std::string& path,
+                                                               bool index_snapshot) {
+        if (!path.empty() && !index_snapshot) {
+            throw std::invalid_argument("VectorStore shared index path requires index_snapshot");
+        }
+        return path;
+    }
+
+    inline void VectorStore::open_ivf_tables() {
+        if (m_index_type != VectorIndexType::IVF) {
+            return;
+        }
+        m_ivf_lists.reset(new KeyMultiValueTable<uint32_t, uint64_t>(
+            m_connection, make_table_name(m_collection, "ivf_lists")));
+        m_ivf_centroids.reset(new KeyValueTable<uint32_t, Embedding>(
+            m_connection, make_table_name(m_collection, "ivf_centroids")));
+    }
+
+    inline void VectorStore::open_pq_tables() {
+        if (m_quantization != VectorQuantization::PQ) {
+            return;
+        }
+        m_pq_codebooks.reset(new KeyValueTable<uint32_t, std::vector<float>>(
+            m_connection, make_table_name(m_collection, "pq_codebooks")));
+    }
+
+    inline void VectorStore::open_snapshot_tables() {
+        m_snapshot.reset(new KeyValueTable<uint32_t, std::vector<uint8_t>>(
+            m_connection, make_table_name(m_collection, "snapshot")));
+        m_dirty.reset(new KeyTable<uint64_t>(
+            m_connection, make_table_name(m_collection, "dirty")));
+    }
+
+    inline void VectorStore::open_text_tables() {
+        m_postings.reset(new KeyMultiValueTable<std::string, TextPosting, DupFixedTableOptions>(
+            m_connection, make_table_name(m_collection, "postings")));
+        m_text_stats.reset(new KeyValueTable<uint32_t, std::uint64_t>(
+            m_connection, make_table_name(m_collection, "text_stats")));
+    }
+
+    inline uint32_t VectorStore::post_text_locked(uint64_t id, const std::string& text,
+                                                  bool insert, const Transaction& txn) {
+        std::map<std::string, uint32_t> terms;
+        const uint32_t length = detail::tokenize_text(text, terms);
+        for (std::map<std::string, uint32_t>::const_iterator it = terms.begin();
+             it != terms.end(); ++it) {
+            TextPosting posting;
+            posting.id = id;
+            posting.tf = it->second;
+            posting.length = length;
+            if (insert) {
+                m_postings->insert(it->first, posting, txn);
+            } else {
+                m_postings->erase(it->first, posting, txn);
+            }
+        }
+        return length;
+    }
+
+    inline void VectorStore::add_text_stats_locked(std::int64_t records, std::int64_t terms,
+                                                   const Transaction& txn) {
+        const std::int64_t deltas[2] = {records, terms};
+        for (uint32_t key = 0; key < 2; ++key) {
+            const std::pair<bool, std::uint64_t> current = m_text_stats->find_compat(key, txn);
+            const std::int64_t value = static_cast<std::int64_t>(current.first ? current.second : 0) +
+                                       deltas[key];
+            m_text_stats->insert_or_assign(key, static_cast<std::uint64_t>(value > 0 ? value : 0), txn);
+        }
+    }
+
+    inline void VectorStore::rebuild_text_index_locked() {
+        auto txn = m_connection->transaction(TransactionMode::WRITABLE);
+        m_postings->clear(txn);
+        m_text_stats->clear(txn);
+        std::vector<std::pair<uint64_t, std::string>> texts;
+        m_texts.load(texts, txn);
+        std::int64_t terms = 0;
+        for (std::size_t i = 0; i < texts.size(); ++i) {
+            terms += post_text_locked(texts[i].first, texts[i].second, true, txn);
+        }
+        add_text_stats_locked(static_cast<std::int64_t>(texts.size()), terms, txn);
+        txn.commit();
+    }
+
+    inline uint32_t VectorStore::index_dim() const {
+        switch (m_index_type) {
+        case VectorIndexType::HNSW:
+            return m_hnsw.dim();
+        case VectorIndexType::IVF:
+            return m_ivf.dim();
+        default:
+            return m_index.dim();
+        }
+    }
+
     inline std::string VectorStore::make_table_name(const std::string& collection,
                                                       const std::string& suffix) {
         return "vectors_" + collection + "_" + suffix;
     }
 
+    inline VectorStoreOptions VectorStore::make_options(VectorMetric metric,
+                                                          VectorQuantization quantization,
+                                                          std::size_t rerank_factor,
+                                                          VectorIndexType index_type,
+                                                          const HnswParams& hnsw,
+                                                          const IvfParams& ivf) {
+        VectorStoreOptions options;
+        options.metric = metric;
+        options.quantization = quantization;
+        options.rerank_factor = rerank_factor;
+        options.index_type = index_type;
+        options.hnsw = hnsw;
+        options.ivf = ivf;
+        return options;
+    }
+
+    inline std::shared_ptr<Connection> VectorStore::open_connection(const Config& config,
+                                                                    const std::string& collection,
+                                                                    const VectorStoreOptions& options) {
+        // Reject bad arguments before the environment is created.
+        validate_collection_name(collection);
+        validate_rerank_factor(options.rerank_factor);
+        validate_index_type(options.index_type, options.quantization, options.index_snapshot,
+                            options.prefix_dim);
+        validate_shared_index_path(options.shared_index_path, options.index_snapshot);
+        return Connection::create(config);
+    }
+
     inline VectorStore::VectorStore(const Config& config,
                                       std::string collection,
-                                      VectorMetric metric)
-        : m_collection(validate_collection_name(collection))
-        , m_metric(metric)
-        , m_connection(Connection::create(config))
-        , m_ids(m_connection, make_table_name(m_collection, "ids"))
-        , m_embeddings(m_connection, make_table_name(m_collection, "embeddings"))
-        , m_texts(m_connection, make_table_name(m_collection, "texts"))
-        , m_metadata(m_connection, make_table_name(m_collection, "metadata"))
-        , m_index(metric)
-    {
-        rebuild_index();
-    }
+                                      VectorMetric metric,
+                                      VectorQuantization quantization,
+                                      std::size_t rerank_factor,
+                                      VectorIndexType index_type,
+                                      const HnswParams& hnsw,
+                                      const IvfParams& ivf)
+        : VectorStore(config, std::move(collection),
+                      make_options(metric, quantization, rerank_factor, index_type, hnsw, ivf))
+    {}
 
     inline VectorStore::VectorStore(std::shared_ptr<Connection> connection,
                                       std::string collection,
-                                      VectorMetric metric)
+                                      VectorMetric metric,
+                                      VectorQuantization quantization,
+                                      std::size_t rerank_factor,
+                                      VectorIndexType index_type,
+                                      const HnswParams& hnsw,
+                                      const IvfParams& ivf)
+        : VectorStore(std::move(connection), std::move(collection),
+                      make_options(metric, quantization, rerank_factor, index_type, hnsw, ivf))
+    {}
+
+    inline VectorStore::VectorStore(const Config& config,
+                                      std::string collection,
+                                      const VectorStoreOptions& options)
+        : VectorStore(open_connection(config, collection, options), collection, options)
+    {}
+
+    inline VectorStore::VectorStore(std::shared_ptr<Connection> connection,
+                                      std::string collection,
+                                      const VectorStoreOptions& options)
         : m_collection(validate_collection_name(collection))
-        , m_metric(metric)
+        , m_metric(options.metric)
+        , m_quantization(options.quantization)
+        , m_rerank_factor(validate_rerank_factor(options.rerank_factor))
+        , m_index_type(validate_index_type(options.index_type, options.quantization,
+                                           options.index_snapshot, options.prefix_dim))
+        , m_embedding_precision(options.embedding_precision)
+        , m_shared_index_path(validate_shared_index_path(options.shared_index_path,
+                                                         options.index_snapshot))
         , m_connection(require_connection(std::move(connection)))
         , m_ids(m_connection, make_table_name(m_collection, "ids"))
         , m_embeddings(m_connection, make_table_name(m_collection, "embeddings"))
         , m_texts(m_connection, make_table_name(m_collection, "texts"))
         , m_metadata(m_connection, make_table_name(m_collection, "metadata"))
-        , m_index(metric)
+        , m_index(options.metric, options.quantization, options.pq, make_prefix_params(options))
+        , m_hnsw(options.metric, options.hnsw)
+        , m_ivf(options.metric, options.ivf)
     {
-        rebuild_index();
+        open_ivf_tables();
+        open_pq_tables();
+        if (options.index_snapshot) {
+            open_snapshot_tables();
+        }
+        if (options.text_index) {
+            open_text_tables();
+        }
+#if MDBXC_SYNC_ENABLED
+        const Connection::SyncApplyWriteGuard guard =
+            m_connection->sync_apply_write_guard();
+#endif
+        const StoreWriteLock store_lock(m_store_mutex);
+        load_index_locked();
+        if (m_postings) {
+            const std::pair<bool, std::uint64_t> records = m_text_stats->find_compat(0);
+            if ((records.first ? records.second : 0) != m_texts.count()) {
+                rebuild_text_index_locked();
+            }
+        }
+#if MDBXC_SYNC_ENABLED
+        m_apply_observer.reset(new ApplyObserver(*this));
+        m_apply_observer_token = m_connection->add_sync_apply_observer(m_apply_observer.get());
+#endif
+    }
+
+    inline VectorStore::~VectorStore() {
+#if MDBXC_SYNC_ENABLED
+        if (m_apply_observer) {
+            // Waits for callbacks in flight on other threads.
+            m_connection->remove_sync_apply_observer(m_apply_observer_token);
+        }
+#endif
     }
 
     inline uint64_t VectorStore::add(const Embedding& embedding,
@@ -71,47 +288,274 @@ namespace mdbxc {
         const Connection::SyncApplyWriteGuard guard =
             m_connection->sync_apply_write_guard();
 #endif
-        std::lock_guard<std::mutex> store_lock(m_store_mutex);
+        const StoreWriteLock store_lock(m_store_mutex);
         ensure_index_fresh_locked();
-        if (m_index.dim() != 0 && embedding.dim != m_index.dim()) {
+        const uint32_t dim = index_dim();
+        if (dim != 0 && embedding.dim != dim) {
             throw std::invalid_argument("Embedding dimension does not match index dimension");
         }
+        // Trained IVF lists are persisted with the record.
+        const bool persist_list = m_index_type == VectorIndexType::IVF && m_ivf.trained();
+        const uint32_t list = persist_list ? m_ivf.assign(embedding) : 0;
 
         auto txn = m_connection->transaction(TransactionMode::WRITABLE);
         uint64_t id = m_ids.append(uint64_t(0), txn);
-        m_embeddings.insert_or_assign(id, embedding, txn);
+        if (embedding.precision == m_embedding_precision) {
+            m_embeddings.insert_or_assign(id, embedding, txn);
+        } else {
+            Embedding stored = embedding;
+            stored.precision = m_embedding_precision;
+            m_embeddings.insert_or_assign(id, stored, txn);
+        }
         m_texts.insert_or_assign(id, text, txn);
         m_metadata.insert_or_assign(id, metadata_json, txn);
+        if (m_postings) {
+            add_text_stats_locked(1, post_text_locked(id, text, true, txn), txn);
+        }
+        if (persist_list) {
+            m_ivf_lists->insert(list, id, txn);
+        }
+        if (m_dirty) {
+            m_dirty->insert(id, txn);
+        }
         txn.commit();
+        note_changed_locked(id, id + 1);
 
-        m_index.add(id, embedding);
+        if (m_index_type == VectorIndexType::HNSW) {
+            m_hnsw.add(id, embedding);
+        } else if (m_index_type == VectorIndexType::IVF) {
+            m_ivf.add(id, embedding, list);
+        } else {
+            m_index.add(id, embedding);
+        }
         return id;
     }
 
+    inline std::pair<uint64_t, uint64_t> VectorStore::add_batch(const std::vector<VectorRecord>& records) {
+        if (records.empty()) {
+            return std::make_pair(uint64_t(0), uint64_t(0));
+        }
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            records[i].embedding.validate();
+            if (records[i].embedding.dim != records[0].embedding.dim) {
+                throw std::invalid_argument("Batch embeddings have different dimensions");
+            }
+        }
+#if MDBXC_SYNC_ENABLED
+        const Connection::SyncApplyWriteGuard guard =
+            m_connection->sync_apply_write_guard();
+#endif
+        const StoreWriteLock store_lock(m_store_mutex);
+        ensure_index_fresh_locked();
+        const uint32_t dim = index_dim();
+        if (dim != 0 && records[0].embedding.dim != dim) {
+            throw std::invalid_argument("Embedding dimension does not match index dimension");
+        }
+        const bool persist_list = m_index_type == VectorIndexType::IVF && m_ivf.trained();
+        std::vector<uint32_t> lists;
+        if (persist_list) {
+            lists.reserve(records.size());
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                lists.push_back(m_ivf.assign(records[i].embedding));
+            }
+        }
+
+        auto txn = m_connection->transaction(TransactionMode::WRITABLE);
+        const std::vector<uint64_t> zeros(records.size(), 0);
+        const std::pair<uint64_t, uint64_t> ids = m_ids.append_many(zeros.begin(), zeros.end(), txn);
+        {
+            std::vector<std::pair<uint64_t, Embedding>> rows;
+            rows.reserve(records.size());
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                rows.push_back(std::make_pair(ids.first + i, records[i].embedding));
+                rows.back().second.precision = m_embedding_precision;
+            }
+            m_embeddings.bulk_load_sorted(rows, BulkLoadMode::Fallback, txn);
+        }
+        {
+            std::vector<std::pair<uint64_t, std::string>> texts;
+            std::vector<std::pair<uint64_t, std::string>> metadata;
+            texts.reserve(records.size());
+            metadata.reserve(records.size());
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                texts.push_back(std::make_pair(ids.first + i, records[i].text));
+                metadata.push_back(std::make_pair(
+                    ids.first + i,
+                    records[i].metadata_json.empty() ? std::string("{}") : records[i].metadata_json));
+            }
+            m_texts.bulk_load_sorted(texts, BulkLoadMode::Fallback, txn);
+            m_metadata.bulk_load_sorted(metadata, BulkLoadMode::Fallback, txn);
+        }
+        if (m_postings) {
+            std::int64_t terms = 0;
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                terms += post_text_locked(ids.first + i, records[i].text, true, txn);
+            }
+            add_text_stats_locked(static_cast<std::int64_t>(records.size()), terms, txn);
+        }
+        if (persist_list) {
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                m_ivf_lists->insert(lists[i], ids.first + i, txn);
+            }
+        }
+        if (m_dirty) {
+            std::vector<uint64_t> dirty;
+            dirty.reserve(records.size());
+            for (uint64_t id = ids.first; id != ids.second; ++id) {
+                dirty.push_back(id);
+            }
+            m_dirty->bulk_load_sorted(dirty, BulkLoadMode::Fallback, txn);
+        }
+        txn.commit();
+        note_changed_locked(ids.first, ids.second);
+
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            const uint64_t id = ids.first + i;
+            if (m_index_type == VectorIndexType::HNSW) {
+                m_hnsw.add(id, records[i].embedding);
+            } else if (m_index_type == VectorIndexType::IVF) {
+                m_ivf.add(id, records[i].embedding, persist_list ? lists[i] : 0);
+            } else {
+                m_index.add(id, records[i].embedding);
+            }
+        }
+        return ids;
+    }
+
     inline std::vector<SearchResult> VectorStore::search(const Embedding& query,
                                                            std::size_t top_k) const {
+        return search(query, top_k, SearchPayload::ALL);
+    }
+
+    inline std::vector<SearchResult> VectorStore::search(const Embedding& query,
+                                                           std::size_t top_k,
+                                                           const VectorFilter& filter) const {
+        return search(query, top_k, filter, SearchPayload::ALL);
+    }
+
+    inline std::vector<SearchResult> VectorStore::search(const Embedding& query,
+                                                           std::size_t top_k,
+                                                           SearchPayload payload) const {
         query.validate();
+        return search_guarded([this, &query, top_k, payload]() {
+            return make_results_locked(match_locked(query, top_k, nullptr), payload);
+        });
+    }
+
+    inline std::vector<SearchResult> VectorStore::search(const Embedding& query,
+                                                           std::size_t top_k,
+                                                           const VectorFilter& filter,
+                                                           SearchPayload payload) const {
+        query.validate();
+        return search_guarded([this, &query, top_k, &filter, payload]() {
+            return make_results_locked(match_locked(query, top_k, &filter), payload);
+        });
+    }
+
+    inline std::vector<SearchResult> VectorStore::text_search(const std::string& text_query,
+                                                                std::size_t top_k,
+                                                                SearchPayload payload) const {
+        if (!m_postings) {
+            throw std::logic_error("VectorStore::text_search requires text_index");
+        }
+#if MDBXC_SYNC_ENABLED
+        const Connection::SyncApplyReadGuard guard =
+            m_connection->sync_apply_read_guard();
+#endif
+        const StoreReadLock store_lock(m_store_mutex);
+        return make_results_locked(text_matches_locked(text_query, top_k), payload);
+    }
+
+    inline std::vector<SearchResult> VectorStore::hybrid_search(const Embedding& query,
+                                                                  const std::string& text_query,
+                                                                  std::size_t top_k,
+                                                                  const HybridSearchOptions& options) const {
+        if (!m_postings) {
+            throw std::logic_error("VectorStore::hybrid_search requires text_index");
+        }
+        query.validate();
+        return search_guarded([this, &query, &text_query, top_k, &options]() {
+            const std::size_t depth = (std::max)(
+                top_k, options.candidates != 0 ? options.candidates
+                                               : (std::max)(top_k * 4, std::size_t(50)));
+            std::unordered_map<uint64_t, float> fused;
+            fuse_ranking(match_locked(query, depth, nullptr), options,
+                         options.vector_weight, fused);
+            fuse_ranking(text_matches_locked(text_query, depth), options,
+                         1.0f - options.vector_weight, fused);
+            std::vector<VectorMatch> matches;
+            matches.reserve(fused.size());
+            for (std::unordered_map<uint64_t, float>::const_iterator it = fused.begin();
+                 it != fused.end(); ++it) {
+                VectorMatch m;
+                m.id = it->first;
+                m.score = it->second;
+                matches.push_back(m);
+            }
+            sort_matches(matches, top_k);
+            return make_results_locked(matches, options.payload);
+        });
+    }
+
+    inline std::size_t VectorStore::load_payloads(std::vector<SearchResult>& results,
+                                                  SearchPayload payload) const {
+#if MDBXC_SYNC_ENABLED
+        const Connection::SyncApplyReadGuard guard =
+            m_connection->sync_apply_read_guard();
+#endif
+        const StoreReadLock store_lock(m_store_mutex);
+        return load_payloads_locked(results, payload, false);
+    }
+
+    template<typename PredicateT>
+    inline VectorFilter VectorStore::make_filter(PredicateT predicate) const {
+#if MDBXC_SYNC_ENABLED
+        const Connection::SyncApplyReadGuard guard =
+            m_connection->sync_apply_read_guard();
+#endif
+        const StoreReadLock store_lock(m_store_mutex);
+        std::vector<std::pair<uint64_t, std::string>> entries;
+        m_metadata.load(entries);
+        VectorFilter filter;
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            if (predicate(entries[i].first, entries[i].second)) {
+                filter.allow(entries[i].first);
+            }
+        }
+        return filter;
+    }
+
+    template<typename FunctionT>
+    inline std::vector<SearchResult> VectorStore::search_guarded(FunctionT search) const {
 #if MDBXC_SYNC_ENABLED
         for (;;) {
             {
                 const Connection::SyncApplyReadGuard read_guard =
                     m_connection->sync_apply_read_guard();
-                std::lock_guard<std::mutex> store_lock(m_store_mutex);
+                const StoreReadLock store_lock(m_store_mutex);
                 if (is_index_fresh()) {
-                    return search_locked(query, top_k);
+                    return search();
                 }
             }
             {
                 const Connection::SyncApplyWriteGuard write_guard =
                     m_connection->sync_apply_write_guard();
-                std::lock_guard<std::mutex> store_lock(m_store_mutex);
+                const StoreWriteLock store_lock(m_store_mutex);
                 ensure_index_fresh_locked();
             }
         }
 #else
-        std::lock_guard<std::mutex> store_lock(m_store_mutex);
-        ensure_index_fresh_locked();
-        return search_locked(query, top_k);
+        // Without sync the index is only changed by writers holding the lock.
+        for (;;) {
+            {
+                const StoreReadLock store_lock(m_store_mutex);
+                if (!m_index_released) {
+                    return search();
+                }
+            }
+            const StoreWriteLock store_lock(m_store_mutex);
+            ensure_index_fresh_locked();
+        }
 #endif
     }
 
@@ -120,15 +564,36 @@ namespace mdbxc {
         const Connection::SyncApplyWriteGuard guard =
             m_connection->sync_apply_write_guard();
 #endif
-        std::lock_guard<std::mutex> store_lock(m_store_mutex);
+        const StoreWriteLock store_lock(m_store_mutex);
         ensure_index_fresh_locked();
+        const std::pair<bool, uint32_t> list = m_ivf.list_of(id);
         auto txn = m_connection->transaction(TransactionMode::WRITABLE);
+        if (m_postings) {
+            const std::pair<bool, std::string> text = m_texts.find_compat(id, txn);
+            if (text.first) {
+                add_text_stats_locked(-1, -static_cast<std::int64_t>(
+                    post_text_locked(id, text.second, false, txn)), txn);
+            }
+        }
         bool emb_ok = m_embeddings.erase(id, txn);
         bool txt_ok = m_texts.erase(id, txn);
         bool meta_ok = m_metadata.erase(id, txn);
+        if (list.first && m_ivf.trained()) {
+            m_ivf_lists->erase(list.second, id, txn);
+        }
+        if (m_dirty) {
+            m_dirty->insert(id, txn);
+        }
         txn.commit();
+        note_changed_locked(id, id + 1);
 
-        m_index.erase(id);
+        if (m_index_type == VectorIndexType::HNSW) {
+            m_hnsw.erase(id);
+        } else if (m_index_type == VectorIndexType::IVF) {
+            m_ivf.erase(id);
+        } else {
+            m_index.erase(id);
+        }
         return emb_ok || txt_ok || meta_ok;
     }
 
@@ -137,37 +602,507 @@ namespace mdbxc {
         const Connection::SyncApplyWriteGuard guard =
             m_connection->sync_apply_write_guard();
 #endif
-        std::lock_guard<std::mutex> store_lock(m_store_mutex);
+        const StoreWriteLock store_lock(m_store_mutex);
         auto txn = m_connection->transaction(TransactionMode::WRITABLE);
         m_ids.clear(txn);
         m_embeddings.clear(txn);
         m_texts.clear(txn);
         m_metadata.clear(txn);
+        if (m_ivf_lists) {
+            m_ivf_lists->clear(txn);
+            m_ivf_centroids->clear(txn);
+        }
+        if (m_pq_codebooks) {
+            m_pq_codebooks->clear(txn);
+        }
+        std::string shared_file;
+        if (m_snapshot) {
+            const std::pair<bool, std::vector<uint8_t>> header = m_snapshot->find_compat(0, txn);
+            const std::size_t chunk_header = sizeof(uint32_t) + sizeof(std::uint64_t);
+            if (!m_shared_index_path.empty() && header.first &&
+                header.second.size() == chunk_header + sizeof(std::uint64_t)) {
+                std::uint64_t generation = 0;
+                std::memcpy(&generation, header.second.data() + chunk_header, sizeof(std::uint64_t));
+                shared_file = shared_index_file(generation);
+            }
+            m_snapshot->clear(txn);
+            m_dirty->clear(txn);
+        }
+        if (m_postings) {
+            m_postings->clear(txn);
+            m_text_stats->clear(txn);
+        }
         txn.commit();
+        if (!shared_file.empty()) {
+            std::remove(shared_file.c_str());
+        }
         m_index.clear();
+        m_hnsw.clear();
+        m_ivf.clear();
         m_sync_apply_generation_seen = current_sync_apply_generation();
+        m_index_released = false;
+        ++m_index_epoch;
     }
 
-    inline void VectorStore::rebuild_index() {
+    inline bool VectorStore::rebuild_index() {
+        const std::lock_guard<std::mutex> rebuild_lock(m_rebuild_mutex);
+#if MDBXC_SYNC_ENABLED
+        Connection::SyncApplyWriteGuard guard = m_connection->sync_apply_write_guard();
+#endif
+        StoreWriteLock store_lock(m_store_mutex);
+        if (m_index_released) {
+            load_index_locked();
+            return true;
+        }
+        ensure_index_fresh_locked();
+        const std::uint64_t epoch = m_index_epoch;
+        FlatVectorIndex flat(m_metric, m_quantization, m_index.pq_params(),
+                             m_index.prefix_params());
+        HnswVectorIndex hnsw(m_metric, m_hnsw.params());
+        IvfVectorIndex ivf(m_metric, m_ivf.params());
+        // Writes committed after the snapshot are journaled and replayed below.
+        m_rebuild_changed.clear();
+        m_rebuild_journal = true;
+        auto txn = m_connection->transaction(TransactionMode::READ_ONLY);
+        store_lock.unlock();
+#if MDBXC_SYNC_ENABLED
+        guard.unlock();
+#endif
+        try {
+            build_index(txn, flat, hnsw, ivf);
+            txn.commit();
+        } catch (...) {
+#if MDBXC_SYNC_ENABLED
+            guard.lock();
+#endif
+            store_lock.lock();
+            m_rebuild_journal = false;
+            m_rebuild_changed.clear();
+            throw;
+        }
+#if MDBXC_SYNC_ENABLED
+        guard.lock();
+#endif
+        store_lock.lock();
+        // Pending sync applies reach the old index first, so they are journaled too.
+        ensure_index_fresh_locked();
+        m_rebuild_journal = false;
+        std::vector<uint64_t> changed;
+        changed.swap(m_rebuild_changed);
+        if (m_index_epoch != epoch) {
+            return false;
+        }
+        apply_changed_ids(std::move(changed), flat, hnsw, ivf);
+        install_index_locked(flat, hnsw, ivf);
+        return true;
+    }
+
+    inline std::future<bool> VectorStore::rebuild_index_async() {
+        return std::async(std::launch::async, [this]() { return rebuild_index(); });
+    }
+
+    inline void VectorStore::train_index(std::size_t threads) {
+        if (m_index_type != VectorIndexType::IVF && !m_pq_codebooks) {
+            throw std::logic_error(
+                "VectorStore::train_index requires VectorIndexType::IVF or VectorQuantization::PQ");
+        }
+#if MDBXC_SYNC_ENABLED
+        const Connection::SyncApplyWriteGuard guard =
+            m_connection->sync_apply_write_guard();
+#endif
+        const StoreWriteLock store_lock(m_store_mutex);
+        ensure_index_fresh_locked();
+        if (m_pq_codebooks) {
+            train_pq_locked(threads);
+            return;
+        }
+        m_ivf.train(threads);
+        ++m_index_epoch;
+        try {
+            auto txn = m_connection->transaction(TransactionMode::WRITABLE);
+            m_ivf_centroids->clear(txn);
+            m_ivf_lists->clear(txn);
+            const std::vector<Embedding> centroids = m_ivf.centroids();
+            for (std::size_t i = 0; i < centroids.size(); ++i) {
+                m_ivf_centroids->insert_or_assign(static_cast<uint32_t>(i), centroids[i], txn);
+            }
+            const std::vector<std::pair<uint32_t, uint64_t>> assignments = m_ivf.assignments();
+            for (std::size_t i = 0; i < assignments.size(); ++i) {
+                m_ivf_lists->insert(assignments[i].first, assignments[i].second, txn);
+            }
+            txn.commit();
+        } catch (...) {
+            rebuild_index_impl_locked();
+            throw;
+        }
+    }
+
+    inline void VectorStore::train_pq_locked(std::size_t threads) {
+        // Codebooks are learned from the fp32 embeddings, not from old codes.
+        FlatVectorIndex trained(m_metric, m_quantization, m_index.pq_params(),
+                                m_index.prefix_params());
+        {
+            auto txn = m_connection->transaction(TransactionMode::READ_ONLY);
+            for_each_embedding(txn, [&trained](uint64_t id, const EmbeddingView& embedding) {
+                trained.add(id, embedding);
+            });
+            txn.commit();
+        }
+        trained.train(threads);
+        try {
+            auto txn = m_connection->transaction(TransactionMode::WRITABLE);
+            m_pq_codebooks->clear(txn);
+            if (trained.trained()) {
+                m_pq_codebooks->insert_or_assign(uint32_t(0), trained.codebooks(), txn);
+            }
+            txn.commit();
+        } catch (...) {
+            rebuild_index_impl_locked();
+            throw;
+        }
+        m_index = std::move(trained);
+        ++m_index_epoch;
+    }
+
+    inline void VectorStore::save_index_snapshot() {
+        if (!m_snapshot) {
+            throw std::logic_error("VectorStore::save_index_snapshot requires index_snapshot");
+        }
 #if MDBXC_SYNC_ENABLED
         const Connection::SyncApplyWriteGuard guard =
             m_connection->sync_apply_write_guard();
 #endif
-        std::lock_guard<std::mutex> store_lock(m_store_mutex);
+        const StoreWriteLock store_lock(m_store_mutex);
+        ensure_index_fresh_locked();
+        auto txn = m_connection->transaction(TransactionMode::WRITABLE);
+        if (!m_shared_index_path.empty()) {
+            save_shared_snapshot_locked(txn);
+            return;
+        }
+        // Chunks keep single MDBX values bounded for large indexes.
+        const std::size_t chunk_bytes = std::size_t(4) << 20;
+        m_snapshot->clear(txn);
+        std::vector<uint8_t> chunk;
+        uint32_t chunks = 0;
+        std::uint64_t total = 0;
+        m_index.save([this, &total, &chunk, &chunks, chunk_bytes, &txn](const void* data, std::size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            total += size;
+            while (size != 0) {
+                const std::size_t n = (std::min)(size, chunk_bytes - chunk.size());
+                chunk.insert(chunk.end(), bytes, bytes + n);
+                bytes += n;
+                size -= n;
+                if (chunk.size() == chunk_bytes) {
+                    m_snapshot->insert_or_assign(++chunks, chunk, txn);
+                    chunk.clear();
+                }
+            }
+        });
+        if (!chunk.empty()) {
+            m_snapshot->insert_or_assign(++chunks, chunk, txn);
+        }
+        std::vector<uint8_t> header(sizeof(uint32_t) + sizeof(std::uint64_t));
+        std::memcpy(header.data(), &chunks, sizeof(uint32_t));
+        std::memcpy(header.data() + sizeof(uint32_t), &total, sizeof(std::uint64_t));
+        m_snapshot->insert_or_assign(uint32_t(0), header, txn);
+        m_dirty->clear(txn);
+        txn.commit();
+    }
+
+    inline void VectorStore::load_index_locked() const {
+        if (m_snapshot && load_snapshot_locked()) {
+            m_sync_apply_generation_seen = current_sync_apply_generation();
+            m_index_released = false;
+            ++m_index_epoch;
+            return;
+        }
         rebuild_index_impl_locked();
     }
 
-    inline void VectorStore::rebuild_index_impl_locked() const {
-        FlatVectorIndex rebuilt(m_metric);
-        std::vector<std::pair<uint64_t, Embedding>> entries;
-        m_embeddings.load(entries);
-        for (std::size_t i = 0; i < entries.size(); ++i) {
-            entries[i].second.validate();
-            rebuilt.add(entries[i].first, entries[i].second);
+    inline void VectorStore::save_shared_snapshot_locked(Transaction& txn) {
+        // Header record: u32 chunk count (0), u64 file size, u64 generation.
+        const std::size_t header_bytes = sizeof(uint32_t) + 2 * sizeof(std::uint64_t);
+        const std::pair<bool, std::vector<uint8_t>> previous = m_snapshot->find_compat(0, txn);
+        const bool replaces = previous.first && previous.second.size() == header_bytes;
+        std::uint64_t generation = 0;
+        if (replaces) {
+            std::memcpy(&generation, previous.second.data() + sizeof(uint32_t) + sizeof(std::uint64_t),
+                        sizeof(std::uint64_t));
+        }
+        ++generation;
+        // A new file per generation: other processes may still map the old one.
+        const std::string path = shared_index_file(generation);
+        const std::string temp = path + ".tmp";
+        std::uint64_t total = 0;
+        {
+            std::ofstream out(temp.c_str(), std::ios::binary | std::ios::trunc);
+            if (out) {
+                m_index.save([&out, &total](const void* data, std::size_t size) {
+                    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                    total += size;
+                });
+                out.close();
+            }
+            if (!out || std::rename(temp.c_str(), path.c_str()) != 0) {
+                std::remove(temp.c_str());
+                throw std::runtime_error("Failed to write VectorStore shared index file: " + path);
+            }
+        }
+        try {
+            m_snapshot->clear(txn);
+            std::vector<uint8_t> header(header_bytes, 0);
+            std::memcpy(header.data() + sizeof(uint32_t), &total, sizeof(std::uint64_t));
+            std::memcpy(header.data() + sizeof(uint32_t) + sizeof(std::uint64_t), &generation,
+                        sizeof(std::uint64_t));
+            m_snapshot->insert_or_assign(uint32_t(0), header, txn);
+            m_dirty->clear(txn);
+            txn.commit();
+        } catch (...) {
+            std::remove(path.c_str());
+            throw;
+        }
+        if (replaces) {
+            std::remove(shared_index_file(generation - 1).c_str());
+        }
+        try {
+            m_index.map(path);
+        } catch (const std::exception&) {
+            // The heap index stays valid; the file is used on the next open.
+        }
+    }
+
+    inline std::string VectorStore::shared_index_file(std::uint64_t generation) const {
+        return m_shared_index_path + "." + std::to_string(generation);
+    }
+
+    inline bool VectorStore::load_snapshot_locked() const {
+        try {
+            auto txn = m_connection->transaction(TransactionMode::READ_ONLY);
+            const std::pair<bool, std::vector<uint8_t>> header = m_snapshot->find_compat(0, txn);
+            const std::size_t chunk_header = sizeof(uint32_t) + sizeof(std::uint64_t);
+            const std::size_t shared_header = chunk_header + sizeof(std::uint64_t);
+            if (!header.first) {
+                return false;
+            }
+            FlatVectorIndex restored(m_metric, m_quantization, m_index.pq_params(),
+                                     m_index.prefix_params());
+            if (header.second.size() == shared_header) {
+                if (m_shared_index_path.empty()) {
+                    return false;
+                }
+                std::uint64_t generation = 0;
+                std::memcpy(&generation, header.second.data() + chunk_header, sizeof(std::uint64_t));
+                restored.map(shared_index_file(generation));
+            } else if (header.second.size() != chunk_header ||
+                       !load_snapshot_chunks_locked(restored, header.second, txn)) {
+                return false;
+            }
+            if (m_pq_codebooks) {
+                // A snapshot saved before the last training holds stale codes.
+                const std::pair<bool, std::vector<float>> codebooks = m_pq_codebooks->find_compat(0, txn);
+                if (codebooks.first ? restored.codebooks() != codebooks.second : restored.trained()) {
+                    return false;
+                }
+            }
+
+            // Replay ids written since the snapshot from the embeddings table.
+            std::vector<uint64_t> dirty;
+            m_dirty->load(dirty, txn);
+            restored.erase_many(dirty);
+            for (std::size_t i = 0; i < dirty.size(); ++i) {
+                std::pair<bool, Embedding> emb_res = m_embeddings.find_compat(dirty[i], txn);
+                if (emb_res.first) {
+                    emb_res.second.validate();
+                    restored.add(dirty[i], emb_res.second);
+                }
+            }
+            if (restored.size() != m_embeddings.count(txn)) {
+                return false;
+            }
+            txn.commit();
+            m_index = std::move(restored);
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    inline bool VectorStore::load_snapshot_chunks_locked(FlatVectorIndex& restored,
+                                                         const std::vector<uint8_t>& header,
+                                                         const Transaction& txn) const {
+        uint32_t chunks = 0;
+        std::uint64_t total = 0;
+        std::memcpy(&chunks, header.data(), sizeof(uint32_t));
+        std::memcpy(&total, header.data() + sizeof(uint32_t), sizeof(std::uint64_t));
+
+        std::vector<uint8_t> chunk;
+        uint32_t next = 0;
+        std::size_t offset = 0;
+        std::uint64_t consumed = 0;
+        restored.load([this, &chunk, &next, &offset, &consumed, chunks, &txn](void* data, std::size_t size) {
+            uint8_t* out = static_cast<uint8_t*>(data);
+            while (size != 0) {
+                if (offset == chunk.size()) {
+                    std::pair<bool, std::vector<uint8_t>> res;
+                    if (next < chunks) {
+                        res = m_snapshot->find_compat(++next, txn);
+                    }
+                    if (!res.first || res.second.empty()) {
+                        throw std::runtime_error("VectorStore index snapshot is truncated");
+                    }
+                    chunk.swap(res.second);
+                    offset = 0;
+                }
+                const std::size_t n = (std::min)(size, chunk.size() - offset);
+                std::memcpy(out, chunk.data() + offset, n);
+                out += n;
+                size -= n;
+                offset += n;
+                consumed += n;
+            }
+        });
+        return consumed == total && next == chunks && offset == chunk.size();
+    }
+
+    template<typename CallbackT>
+    inline void VectorStore::for_each_embedding(const Transaction& txn, CallbackT callback) const {
+        // Values are read in place from the pages; only unaligned or
+        // reduced-precision ones are copied, into one reused buffer.
+        std::vector<float> scratch;
+        m_embeddings.for_each_range_view(uint64_t(0), (std::numeric_limits<uint64_t>::max)(),
+                [&callback, &scratch](const uint64_t& id, const ByteView& bytes) -> bool {
+            callback(id, Embedding::view(bytes.data, bytes.size, scratch));
+            return true;
+        }, txn);
+    }
+
+    inline void VectorStore::build_index(const Transaction& txn, FlatVectorIndex& flat,
+                                         HnswVectorIndex& hnsw, IvfVectorIndex& ivf) const {
+        if (m_index_type == VectorIndexType::HNSW) {
+            Embedding row;
+            for_each_embedding(txn, [&hnsw, &row](uint64_t id, const EmbeddingView& embedding) {
+                row.dim = embedding.dim;
+                row.values.assign(embedding.values, embedding.values + embedding.dim);
+                hnsw.add(id, row);
+            });
+        } else if (m_index_type == VectorIndexType::IVF) {
+            std::vector<std::pair<uint32_t, Embedding>> centroids;
+            m_ivf_centroids->load(centroids, txn);
+            std::unordered_map<uint64_t, uint32_t> lists;
+            if (!centroids.empty()) {
+                std::vector<Embedding> ordered;
+                ordered.reserve(centroids.size());
+                for (std::size_t i = 0; i < centroids.size(); ++i) {
+                    ordered.push_back(centroids[i].second);
+                }
+                ivf.set_centroids(ordered);
+                std::vector<std::pair<uint32_t, uint64_t>> assignments;
+                m_ivf_lists->load(assignments, txn);
+                lists.reserve(assignments.size());
+                for (std::size_t i = 0; i < assignments.size(); ++i) {
+                    lists[assignments[i].second] = assignments[i].first;
+                }
+            }
+            // Persisted assignments skip the nearest-centroid scan; records
+            // without one (e.g. added before training) are assigned now.
+            Embedding row;
+            for_each_embedding(txn, [&ivf, &row, &lists](uint64_t id, const EmbeddingView& embedding) {
+                row.dim = embedding.dim;
+                row.values.assign(embedding.values, embedding.values + embedding.dim);
+                const std::unordered_map<uint64_t, uint32_t>::const_iterator it = lists.find(id);
+                if (it != lists.end() && it->second < ivf.list_count()) {
+                    ivf.add(id, row, it->second);
+                } else {
+                    ivf.add(id, row);
+                }
+            });
+        } else {
+            if (m_pq_codebooks) {
+                const std::pair<bool, std::vector<float>> codebooks = m_pq_codebooks->find_compat(0, txn);
+                if (codebooks.first) {
+                    flat.set_codebooks(codebooks.second);
+                }
+            }
+            for_each_embedding(txn, [&flat](uint64_t id, const EmbeddingView& embedding) {
+                flat.add(id, embedding);
+            });
+        }
+    }
+
+    inline void VectorStore::install_index_locked(FlatVectorIndex& flat, HnswVectorIndex& hnsw,
+                                                  IvfVectorIndex& ivf) const {
+        if (m_index_type == VectorIndexType::HNSW) {
+            m_hnsw = std::move(hnsw);
+        } else if (m_index_type == VectorIndexType::IVF) {
+            m_ivf = std::move(ivf);
+        } else {
+            m_index = std::move(flat);
         }
+    }
 
-        m_index = std::move(rebuilt);
+    inline void VectorStore::rebuild_index_impl_locked() const {
+        FlatVectorIndex flat(m_metric, m_quantization, m_index.pq_params(),
+                             m_index.prefix_params());
+        HnswVectorIndex hnsw(m_metric, m_hnsw.params());
+        IvfVectorIndex ivf(m_metric, m_ivf.params());
+        {
+            auto txn = m_connection->transaction(TransactionMode::READ_ONLY);
+            build_index(txn, flat, hnsw, ivf);
+            txn.commit();
+        }
+        install_index_locked(flat, hnsw, ivf);
         m_sync_apply_generation_seen = current_sync_apply_generation();
+        m_index_released = false;
+        ++m_index_epoch;
+    }
+
+    inline void VectorStore::note_changed_locked(uint64_t first, uint64_t end) const {
+        if (!m_rebuild_journal) {
+            return;
+        }
+        for (uint64_t id = first; id != end; ++id) {
+            m_rebuild_changed.push_back(id);
+        }
+    }
+
+    inline void VectorStore::apply_changed_ids(std::vector<uint64_t> ids, FlatVectorIndex& flat,
+                                               HnswVectorIndex& hnsw, IvfVectorIndex& ivf) const {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        std::vector<std::pair<bool, Embedding>> rows;
+        rows.reserve(ids.size());
+        {
+            auto txn = m_connection->transaction(TransactionMode::READ_ONLY);
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                rows.push_back(m_embeddings.find_compat(ids[i], txn));
+                if (rows.back().first) {
+                    rows.back().second.validate();
+                }
+            }
+            txn.commit();
+        }
+        if (m_index_type == VectorIndexType::FLAT) {
+            flat.erase_many(ids);
+        }
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            const bool present = rows[i].first;
+            if (m_index_type == VectorIndexType::HNSW) {
+                if (present) {
+                    hnsw.add(ids[i], rows[i].second);
+                } else {
+                    hnsw.erase(ids[i]);
+                }
+            } else if (m_index_type == VectorIndexType::IVF) {
+                if (present) {
+                    ivf.add(ids[i], rows[i].second);
+                } else {
+                    ivf.erase(ids[i]);
+                }
+            } else if (present) {
+                flat.add(ids[i], rows[i].second);
+            }
+        }
     }
 
     inline std::uint64_t VectorStore::current_sync_apply_generation() const {
@@ -183,44 +1118,269 @@ namespace mdbxc {
         const Connection::SyncApplyWriteGuard guard =
             m_connection->sync_apply_write_guard();
 #endif
-        std::lock_guard<std::mutex> store_lock(m_store_mutex);
+        const StoreWriteLock store_lock(m_store_mutex);
         ensure_index_fresh_locked();
     }
 
     inline void VectorStore::ensure_index_fresh_locked() const {
-        if (!is_index_fresh()) {
-            rebuild_index_impl_locked();
+        if (m_index_released) {
+            load_index_locked();
+            return;
+        }
+        if (is_index_fresh()) {
+            return;
+        }
+#if MDBXC_SYNC_ENABLED
+        if (refresh_index_locked()) {
+            return;
+        }
+#endif
+        rebuild_index_impl_locked();
+    }
+
+#if MDBXC_SYNC_ENABLED
+    inline void VectorStore::ApplyObserver::on_sync_apply_committed(
+            const sync::SyncApplyEvent& event) {
+        m_store.record_sync_apply(event);
+    }
+
+    inline void VectorStore::record_sync_apply(const sync::SyncApplyEvent& event) const {
+        const std::string embeddings = make_table_name(m_collection, "embeddings");
+        const std::string centroids = make_table_name(m_collection, "ivf_centroids");
+        const std::string codebooks = make_table_name(m_collection, "pq_codebooks");
+        PendingApply pending;
+        for (std::size_t i = 0; i < event.applied_keys.size() && !pending.rebuild; ++i) {
+            const sync::SyncAppliedKey& key = event.applied_keys[i];
+            if (key.dbi_name == centroids) {
+                pending.rebuild = m_index_type == VectorIndexType::IVF;
+            } else if (key.dbi_name == codebooks) {
+                pending.rebuild = static_cast<bool>(m_pq_codebooks);
+            } else if (key.dbi_name != embeddings) {
+                continue;
+            } else if (key.op_type == sync::ChangeOpType::ClearTable ||
+                       key.storage_key.size() != sizeof(uint64_t)) {
+                pending.rebuild = true;
+            } else {
+                MDBX_val raw;
+                raw.iov_base = const_cast<std::uint8_t*>(key.storage_key.data());
+                raw.iov_len = key.storage_key.size();
+                pending.ids.push_back(deserialize_key<uint64_t>(raw));
+            }
         }
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        if (!pending.rebuild && m_pending_ids + pending.ids.size() > max_pending_ids) {
+            pending.rebuild = true;
+        }
+        if (pending.rebuild) {
+            pending.ids.clear();
+        }
+        m_pending_ids += pending.ids.size();
+        PendingApply& slot = m_pending[event.generation];
+        slot.ids.swap(pending.ids);
+        slot.rebuild = pending.rebuild;
     }
 
+    inline bool VectorStore::refresh_index_locked() const {
+        const std::uint64_t current = current_sync_apply_generation();
+        std::vector<uint64_t> ids;
+        bool rebuild = false;
+        std::uint64_t events = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_pending_mutex);
+            while (!m_pending.empty() && m_pending.begin()->first <= current) {
+                std::map<std::uint64_t, PendingApply>::iterator it = m_pending.begin();
+                m_pending_ids -= it->second.ids.size();
+                if (it->first > m_sync_apply_generation_seen) {
+                    ++events;
+                    rebuild = rebuild || it->second.rebuild;
+                    ids.insert(ids.end(), it->second.ids.begin(), it->second.ids.end());
+                }
+                m_pending.erase(it);
+            }
+        }
+        // Observers run after the apply barrier is released, so an event can
+        // still be on its way; rebuild rather than miss its ids.
+        if (rebuild || events != current - m_sync_apply_generation_seen) {
+            return false;
+        }
+        try {
+            apply_changed_ids_locked(std::move(ids));
+        } catch (const std::exception&) {
+            return false;
+        }
+        m_sync_apply_generation_seen = current;
+        return true;
+    }
+
+    inline void VectorStore::apply_changed_ids_locked(std::vector<uint64_t> ids) const {
+        if (m_rebuild_journal) {
+            m_rebuild_changed.insert(m_rebuild_changed.end(), ids.begin(), ids.end());
+        }
+        apply_changed_ids(std::move(ids), m_index, m_hnsw, m_ivf);
+    }
+#endif
+
     inline bool VectorStore::is_index_fresh() const {
-        return current_sync_apply_generation() == m_sync_apply_generation_seen;
+        return !m_index_released && current_sync_apply_generation() == m_sync_apply_generation_seen;
+    }
+
+    inline std::vector<VectorMatch> VectorStore::match_locked(const Embedding& query,
+                                                                std::size_t top_k,
+                                                                const VectorFilter* filter) const {
+        std::vector<VectorMatch> matches;
+        if (m_index_type == VectorIndexType::HNSW) {
+            matches = filter ? m_hnsw.search(query, top_k, *filter) : m_hnsw.search(query, top_k);
+        } else if (m_index_type == VectorIndexType::IVF) {
+            matches = filter ? m_ivf.search(query, top_k, *filter) : m_ivf.search(query, top_k);
+        } else if (m_quantization == VectorQuantization::NONE) {
+            matches = filter ? m_index.search(query, top_k, *filter) : m_index.search(query, top_k);
+        } else {
+            // Over-fetch approximate matches, then re-rank them exactly.
+            const std::size_t limit = std::numeric_limits<std::size_t>::max() / m_rerank_factor;
+            const std::size_t candidates = top_k < limit ? top_k * m_rerank_factor : top_k;
+            std::vector<VectorMatch> approx = filter ? m_index.search(query, candidates, *filter)
+                                                     : m_index.search(query, candidates);
+            // Read-only pages stay mapped until the transaction ends, so the
+            // views stay valid through the rescore; only unaligned values are
+            // copied into their scratch slot.
+            std::vector<std::pair<uint64_t, EmbeddingView>> exact;
+            exact.reserve(approx.size());
+            std::vector<std::vector<float>> scratch(approx.size());
+            auto txn = m_connection->transaction(TransactionMode::READ_ONLY);
+            for (std::size_t i = 0; i < approx.size(); ++i) {
+                const uint64_t id = approx[i].id;
+                std::vector<float>& slot = scratch[i];
+                if (!m_embeddings.find_view(id, [&exact, &slot, id](const ByteView& bytes) {
+                        exact.push_back(std::make_pair(id, Embedding::view(bytes.data, bytes.size, slot)));
+                    }, txn)) {
+                    throw std::runtime_error("VectorStore integrity error: embedding missing for id");
+                }
+            }
+            matches = m_index.rescore(query, exact, top_k);
+            txn.commit();
+        }
+        return matches;
     }
 
-    inline std::vector<SearchResult> VectorStore::search_locked(
-            const Embedding& query,
-            std::size_t top_k) const {
-        std::vector<VectorMatch> matches = m_index.search(query, top_k);
-        std::vector<SearchResult> results;
-        results.reserve(matches.size());
+    inline std::vector<SearchResult> VectorStore::make_results_locked(
+            const std::vector<VectorMatch>& matches,
+            SearchPayload payload) const {
+        std::vector<SearchResult> results(matches.size());
         for (std::size_t i = 0; i < matches.size(); ++i) {
-            std::pair<bool, std::string> text_res = m_texts.find_compat(matches[i].id);
-            if (!text_res.first) {
+            results[i].id = matches[i].id;
+            results[i].score = matches[i].score;
+            results[i].collection = m_collection;
+        }
+        load_payloads_locked(results, payload, true);
+        return results;
+    }
+
+    inline std::vector<VectorMatch> VectorStore::text_matches_locked(const std::string& text_query,
+                                                                       std::size_t top_k) const {
+        std::vector<VectorMatch> matches;
+        std::map<std::string, uint32_t> terms;
+        detail::tokenize_text(text_query, terms);
+        if (top_k == 0 || terms.empty()) {
+            return matches;
+        }
+        auto txn = m_connection->transaction(TransactionMode::READ_ONLY);
+        const std::pair<bool, std::uint64_t> records = m_text_stats->find_compat(0, txn);
+        const std::pair<bool, std::uint64_t> total = m_text_stats->find_compat(1, txn);
+        if (!records.first || records.second == 0) {
+            txn.commit();
+            return matches;
+        }
+        const double avg_length = total.first
+            ? static_cast<double>(total.second) / static_cast<double>(records.second) : 0.0;
+        std::unordered_map<uint64_t, float> scores;
+        for (std::map<std::string, uint32_t>::const_iterator it = terms.begin();
+             it != terms.end(); ++it) {
+            const std::vector<TextPosting> postings = m_postings->find(it->first, txn);
+            for (std::size_t i = 0; i < postings.size(); ++i) {
+                scores[postings[i].id] += static_cast<float>(it->second) *
+                    detail::bm25_weight(records.second, postings.size(), postings[i].tf,
+                                        postings[i].length, avg_length);
+            }
+        }
+        txn.commit();
+        matches.reserve(scores.size());
+        for (std::unordered_map<uint64_t, float>::const_iterator it = scores.begin();
+             it != scores.end(); ++it) {
+            VectorMatch m;
+            m.id = it->first;
+            m.score = it->second;
+            matches.push_back(m);
+        }
+        sort_matches(matches, top_k);
+        return matches;
+    }
+
+    inline void VectorStore::fuse_ranking(const std::vector<VectorMatch>& ranking,
+                                          const HybridSearchOptions& options,
+                                          float weight,
+                                          std::unordered_map<uint64_t, float>& fused) {
+        if (ranking.empty()) {
+            return;
+        }
+        if (options.fusion == HybridFusion::RRF) {
+            for (std::size_t i = 0; i < ranking.size(); ++i) {
+                fused[ranking[i].id] += 1.0f / (options.rrf_k + static_cast<float>(i + 1));
+            }
+            return;
+        }
+        // Rankings arrive best first.
+        const float best = ranking.front().score;
+        const float worst = ranking.back().score;
+        for (std::size_t i = 0; i < ranking.size(); ++i) {
+            const float norm = best > worst ? (ranking[i].score - worst) / (best - worst) : 1.0f;
+            fused[ranking[i].id] += weight * norm;
+        }
+    }
+
+    inline void VectorStore::sort_matches(std::vector<VectorMatch>& matches, std::size_t top_k) {
+        const std::size_t keep = (std::min)(top_k, matches.size());
+        std::partial_sort(matches.begin(), matches.begin() + keep, matches.end(),
+                          [](const VectorMatch& a, const VectorMatch& b) {
+                              return a.score > b.score || (a.score == b.score && a.id < b.id);
+                          });
+        matches.resize(keep);
+    }
+
+    inline std::size_t VectorStore::load_payloads_locked(std::vector<SearchResult>& results,
+                                                         SearchPayload payload,
+                                                         bool required) const {
+        if (payload == SearchPayload::NONE || results.empty()) {
+            return payload == SearchPayload::NONE ? results.size() : 0;
+        }
+        std::vector<uint64_t> ids(results.size());
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            ids[i] = results[i].id;
+        }
+        std::vector<std::pair<bool, std::string>> metadata;
+        m_metadata.find_many_batch_compat(ids, metadata);
+        std::vector<std::pair<bool, std::string>> texts;
+        if (payload == SearchPayload::ALL) {
+            m_texts.find_many_batch_compat(ids, texts);
+        }
+        std::size_t loaded = 0;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const bool has_text = payload != SearchPayload::ALL || texts[i].first;
+            if (required && !has_text) {
                 throw std::runtime_error("VectorStore integrity error: text missing for id");
             }
-            std::pair<bool, std::string> meta_res = m_metadata.find_compat(matches[i].id);
-            if (!meta_res.first) {
+            if (required && !metadata[i].first) {
                 throw std::runtime_error("VectorStore integrity error: metadata missing for id");
             }
-            SearchResult sr;
-            sr.id = matches[i].id;
-            sr.score = matches[i].score;
-            sr.collection = m_collection;
-            sr.text = text_res.second;
-            sr.metadata_json = meta_res.second;
-            results.push_back(sr);
+            if (!has_text || !metadata[i].first) {
+                continue;
+            }
+            results[i].metadata_json = std::move(metadata[i].second);
+            if (payload == SearchPayload::ALL) {
+                results[i].text = std::move(texts[i].second);
+            }
+            ++loaded;
         }
-        return results;
+        return loaded;
     }
 
     inline std::size_t VectorStore::count() const {
@@ -228,7 +1388,7 @@ namespace mdbxc {
         const Connection::SyncApplyReadGuard guard =
             m_connection->sync_apply_read_guard();
 #endif
-        std::lock_guard<std::mutex> store_lock(m_store_mutex);
+        const StoreReadLock store_lock(m_store_mutex);
         return m_embeddings.count();
     }
 
@@ -236,4 +1396,39 @@ namespace mdbxc {
         return m_collection;
     }
 
+    inline void VectorStore::release_index() {
+#if MDBXC_SYNC_ENABLED
+        const Connection::SyncApplyWriteGuard guard =
+            m_connection->sync_apply_write_guard();
+#endif
+        const StoreWriteLock store_lock(m_store_mutex);
+        // Fresh objects drop the capacity that clear() would keep.
+        m_index = FlatVectorIndex(m_metric, m_quantization, m_index.pq_params(),
+                                  m_index.prefix_params());
+        m_hnsw = HnswVectorIndex(m_metric, m_hnsw.params());
+        m_ivf = IvfVectorIndex(m_metric, m_ivf.params());
+        m_index_released = true;
+        ++m_index_epoch;
+    }
+
+    inline bool VectorStore::index_loaded() const {
+        const StoreReadLock store_lock(m_store_mutex);
+        return !m_index_released;
+    }
+
+    inline std::size_t VectorStore::index_memory_bytes() const {
+        const StoreReadLock store_lock(m_store_mutex);
+        if (m_index_released) {
+            return 0;
+        }
+        switch (m_index_type) {
+        case VectorIndexType::HNSW:
+            return m_hnsw.memory_bytes();
+        case VectorIndexType::IVF:
+            return m_ivf.memory_bytes();
+        default:
+            return m_index.memory_bytes();
+        }
+    }
+
 } // namespace mdbxc
@@ -0,0 +1,150 @@
+#pragma once
+#ifndef MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_STORE_REGISTRY_HPP_INCLUDED
+#define MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_STORE_REGISTRY_HPP_INCLUDED
+
+#include "VectorStore.hpp"
+#include "../detail/ThreadPool.hpp"
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mdbxc {
+
+    /// \brief Construction options of \ref VectorStoreRegistry.
+    struct VectorStoreRegistryOptions {
+        /// \brief Cap on the RAM index bytes of all collections; 0 disables eviction.
+        std::size_t memory_limit = 0;
+        /// \brief Workers of the shared search pool; 0 uses the hardware concurrency.
+        std::size_t search_threads = 0;
+    };
+
+    /// \brief RAM index usage of one collection, see \ref VectorStoreRegistry::memory_stats().
+    struct CollectionMemoryStats {
+        std::string collection;       ///< Collection name.
+        std::size_t index_bytes = 0;  ///< Heap bytes of the RAM index; 0 while evicted.
+        bool loaded = false;          ///< Whether the RAM index is resident.
+        std::uint64_t evictions = 0;  ///< Times the registry released the index.
+        std::uint64_t last_used = 0;  ///< Registry access tick; larger is more recent.
+    };
+
+    /// \brief Hosts many \ref VectorStore collections of one connection.
+    ///
+    /// All searches issued through the registry run on one shared pool of
+    /// \c search_threads workers instead of threads per collection. After
+    /// each \ref open() and search the RAM indexes are summed; while the
+    /// total exceeds \c memory_limit, the least recently used collections
+    /// release their index with \ref VectorStore::release_index(). An
+    /// evicted collection reloads lazily on its next operation, from its
+    /// index snapshot when \ref VectorStoreOptions::index_snapshot is on and
+    /// by a rebuild from the embeddings otherwise, so enable snapshots for
+    /// cheap reloads.
+    ///
+    /// \note Stores returned by \ref get() stay usable after eviction, but
+    /// operations called on them directly do not mark the collection as
+    /// used, and an index they reload is counted at the next \ref open(),
+    /// search or \ref trim().
+    /// \note Every collection opens its tables in the shared environment, so
+    /// size \c Config::max_dbs for all of them.
+    /// \thread_safety Thread-safe.
+    class VectorStoreRegistry {
+    public:
+        /// \brief Creates an empty registry over \p connection.
+        /// \param connection Shared MDBX connection used by every collection.
+        /// \param options Memory cap and search pool size.
+        /// \throws std::invalid_argument if \p connection is null.
+        explicit VectorStoreRegistry(std::shared_ptr<Connection> connection,
+                                     const VectorStoreRegistryOptions& options =
+                                         VectorStoreRegistryOptions());
+
+        /// \brief Waits for queued searches and stops the pool.
+        ~VectorStoreRegistry();
+
+        VectorStoreRegistry(const VectorStoreRegistry&) = delete;
+        VectorStoreRegistry& operator=(const VectorStoreRegistry&) = delete;
+
+        /// \brief Opens a collection, or returns it if already open.
+        /// \param collection Collection name, see \ref VectorStore.
+        /// \param options Options used when the collection is opened now;
+        ///        ignored for an open collection.
+        /// \return Shared store of the collection.
+        /// \throws std::invalid_argument if the name or options are invalid.
+        /// \throws MdbxException if a database error occurs.
+        std::shared_ptr<VectorStore> open(const std::string& collection,
+                                          const VectorStoreOptions& options = VectorStoreOptions());
+
+        /// \brief Returns an open collection and marks it as used.
+        /// \return Shared store, or null if \p collection is not open.
+        std::shared_ptr<VectorStore> get(const std::string& collection);
+
+        /// \brief Removes a collection from the registry.
+        /// \details The store closes once the last shared pointer is gone;
+        /// persisted rows are kept.
+        /// \return \c true if the collection was open.
+        bool close(const std::string& collection);
+
+        /// \brief Returns the names of the open collections in name order.
+        std::vector<std::string> collections() const;
+
+        /// \brief Searches one collection on the shared pool.
+        /// \return Future of the results; it rethrows the search exceptions.
+        /// \throws std::out_of_range if \p collection is not open.
+        std::future<std::vector<SearchResult>> search_async(const std::string& collection,
+                                                            const Embedding& query,
+                                                            std::size_t top_k,
+                                                            SearchPayload payload = SearchPayload::ALL);
+
+        /// \brief Searches several collections in parallel and merges the results.
+        /// \details Each collection is searched on the shared pool; the best
+        /// \p top_k results by score are returned, tagged with their
+        /// \c SearchResult::collection. Scores are comparable only between
+        /// collections of the same metric.
+        /// \throws std::out_of_range if a collection is not open.
+        /// \throws std::invalid_argument if \p query is invalid for a collection.
+        std::vector<SearchResult> search(const std::vector<std::string>& collections,
+                                         const Embedding& query,
+                                         std::size_t top_k,
+                                         SearchPayload payload = SearchPayload::ALL);
+
+        /// \brief Evicts least recently used indexes until the memory limit holds.
+        /// \return Number of indexes released.
+        std::size_t trim();
+
+        /// \brief Returns the RAM index bytes of all open collections.
+        std::size_t index_memory_bytes() const;
+
+        /// \brief Returns per-collection index memory in name order.
+        std::vector<CollectionMemoryStats> memory_stats() const;
+
+        /// \brief Returns the memory cap; 0 when eviction is disabled.
+        std::size_t memory_limit() const noexcept;
+
+        /// \brief Returns the number of search workers.
+        std::size_t search_threads() const noexcept;
+
+    private:
+        struct Entry {
+            std::shared_ptr<VectorStore> store;
+            std::uint64_t last_used = 0;
+            std::uint64_t evictions = 0;
+        };
+
+        std::shared_ptr<Connection> m_connection;
+        std::size_t m_memory_limit;
+        mutable std::mutex m_mutex;
+        std::map<std::string, Entry> m_entries;
+        std::uint64_t m_tick = 0;
+        std::unique_ptr<detail::ThreadPool> m_pool; ///< Declared last so it stops first.
+
+        std::shared_ptr<VectorStore> touch(const std::string& collection);
+        std::size_t trim_except(const std::string& keep);
+    };
+
+} // namespace mdbxc
+
+#include "VectorStoreRegistry.ipp"
+
+#endif // MDBX_CONTAINERS_HEADER_VECTOR_VECTOR_STORE_REGISTRY_HPP_INCLUDED
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace mdbxc {
+
+    inline VectorStoreRegistry::VectorStoreRegistry(std::shared_ptr<Connection> connection,
+                                                    const VectorStoreRegistryOptions& options)
+        : m_connection(std::move(connection))
+        , m_memory_limit(options.memory_limit) {
+        if (!m_connection) {
+            throw std::invalid_argument("VectorStoreRegistry connection cannot be null");
+        }
+        m_pool.reset(new detail::ThreadPool(options.search_threads));
+    }
+
+    inline VectorStoreRegistry::~VectorStoreRegistry() {
+        // Queued searches still use the entries; finish them first.
+        m_pool.reset();
+    }
+
+    inline std::shared_ptr<VectorStore> VectorStoreRegistry::open(const std::string& collection,
+                                                                  const VectorStoreOptions& options) {
+        std::shared_ptr<VectorStore> store;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<std::string, Entry>::iterator it = m_entries.find(collection);
+            if (it == m_entries.end()) {
+                Entry entry;
+                entry.store = std::make_shared<VectorStore>(m_connection, collection, options);
+                it = m_entries.insert(std::make_pair(collection, entry)).first;
+            }
+            it->second.last_used = ++m_tick;
+            store = it->second.store;
+        }
+        trim_except(collection);
+        return store;
+    }
+
+    inline std::shared_ptr<VectorStore> VectorStoreRegistry::get(const std::string& collection) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::map<std::string, Entry>::iterator it = m_entries.find(collection);
+        if (it == m_entries.end()) {
+            return std::shared_ptr<VectorStore>();
+        }
+        it->second.last_used = ++m_tick;
+        return it->second.store;
+    }
+
+    inline bool VectorStoreRegistry::close(const std::string& collection) {
+        std::shared_ptr<VectorStore> store;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<std::string, Entry>::iterator it = m_entries.find(collection);
+            if (it == m_entries.end()) {
+                return false;
+            }
+            store.swap(it->second.store);
+            m_entries.erase(it);
+        }
+        // The store may close here, outside the registry lock.
+        return true;
+    }
+
+    inline std::vector<std::string> VectorStoreRegistry::collections() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<std::string> names;
+        names.reserve(m_entries.size());
+        for (std::map<std::string, Entry>::const_iterator it = m_entries.begin();
+             it != m_entries.end(); ++it) {
+            names.push_back(it->first);
+        }
+        return names;
+    }
+
+    inline std::shared_ptr<VectorStore> VectorStoreRegistry::touch(const std::string& collection) {
+        std::shared_ptr<VectorStore> store = get(collection);
+        if (!store) {
+            throw std::out_of_range("VectorStoreRegistry collection is not open: " + collection);
+        }
+        return store;
+    }
+
+    inline std::future<std::vector<SearchResult>> VectorStoreRegistry::search_async(
+            const std::string& collection,
+            const Embedding& query,
+            std::size_t top_k,
+            SearchPayload payload) {
+        std::shared_ptr<VectorStore> store = touch(collection);
+        std::shared_ptr<std::packaged_task<std::vector<SearchResult>()>> task =
+            std::make_shared<std::packaged_task<std::vector<SearchResult>()>>(
+                [this, store, collection, query, top_k, payload]() {
+                    std::vector<SearchResult> results = store->search(query, top_k, payload);
+                    trim_except(collection);
+                    return results;
+                });
+        std::future<std::vector<SearchResult>> result = task->get_future();
+        m_pool->post([task]() { (*task)(); });
+        return result;
+    }
+
+    inline std::vector<SearchResult> VectorStoreRegistry::search(
+            const std::vector<std::string>& collections,
+            const Embedding& query,
+            std::size_t top_k,
+            SearchPayload payload) {
+        std::vector<std::future<std::vector<SearchResult>>> pending;
+        pending.reserve(collections.size());
+        for (std::size_t i = 0; i < collections.size(); ++i) {
+            pending.push_back(search_async(collections[i], query, top_k, payload));
+        }
+        std::vector<SearchResult> merged;
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            std::vector<SearchResult> part = pending[i].get();
+            merged.insert(merged.end(), part.begin(), part.end());
+        }
+        const std::size_t keep = (std::min)(top_k, merged.size());
+        std::partial_sort(merged.begin(), merged.begin() + keep, merged.end(),
+                          [](const SearchResult& a, const SearchResult& b) {
+                              return a.score > b.score;
+                          });
+        merged.resize(keep);
+        return merged;
+    }
+
+    inline std::size_t VectorStoreRegistry::trim() {
+        return trim_except(std::string());
+    }
+
+    inline std::size_t VectorStoreRegistry::trim_except(const std::string& keep) {
+        struct Candidate {
+            std::uint64_t last_used;
+            std::string collection;
+            std::shared_ptr<VectorStore> store;
+            std::size_t bytes;
+        };
+        std::vector<Candidate> candidates;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_memory_limit == 0) {
+                return 0;
+            }
+            candidates.reserve(m_entries.size());
+            for (std::map<std::string, Entry>::const_iterator it = m_entries.begin();
+                 it != m_entries.end(); ++it) {
+                Candidate c;
+                c.last_used = it->second.last_used;
+                c.collection = it->first;
+                c.store = it->second.store;
+                c.bytes = 0;
+                candidates.push_back(c);
+            }
+        }
+        // Sizes are read outside the registry lock; each takes a store lock.
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            candidates[i].bytes = candidates[i].store->index_memory_bytes();
+            total += candidates[i].bytes;
+        }
+        if (total <= m_memory_limit) {
+            return 0;
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) {
+                      return a.last_used < b.last_used;
+                  });
+        std::size_t released = 0;
+        for (std::size_t i = 0; i < candidates.size() && total > m_memory_limit; ++i) {
+            if (candidates[i].bytes == 0 || candidates[i].collection == keep) {
+                continue;
+            }
+            candidates[i].store->release_index();
+            total -= candidates[i].bytes;
+            ++released;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<std::string, Entry>::iterator it = m_entries.find(candidates[i].collection);
+            if (it != m_entries.end() && it->second.store == candidates[i].store) {
+                ++it->second.evictions;
+            }
+        }
+        return released;
+    }
+
+    inline std::size_t VectorStoreRegistry::index_memory_bytes() const {
+        const std::vector<CollectionMemoryStats> stats = memory_stats();
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < stats.size(); ++i) {
+            total += stats[i].index_bytes;
+        }
+        return total;
+    }
+
+    inline std::vector<CollectionMemoryStats> VectorStoreRegistry::memory_stats() const {
+        std::vector<CollectionMemoryStats> stats;
+        std::vector<std::shared_ptr<VectorStore>> stores;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            stats.reserve(m_entries.size());
+            stores.reserve(m_entries.size());
+            for (std::map<std::string, Entry>::const_iterator it = m_entries.begin();
+                 it != m_entries.end(); ++it) {
+                CollectionMemoryStats s;
+                s.collection = it->first;
+                s.evictions = it->second.evictions;
+                s.last_used = it->second.last_used;
+                stats.push_back(s);
+                stores.push_back(it->second.store);
+            }
+        }
+        for (std::size_t i = 0; i < stats.size(); ++i) {
+            stats[i].index_bytes = stores[i]->index_memory_bytes();
+            stats[i].loaded = stores[i]->index_loaded();
+        }
+        return stats;
+    }
+
+    inline std::size_t VectorStoreRegistry::memory_limit() const noexcept {
+        return m_memory_limit;
+    }
+
+    inline std::size_t VectorStoreRegistry::search_threads() const noexcept {
+        return m_pool->size();
+    }
+
+} // namespace mdbxc
@@ -183,6 +183,35 @@ int main() {
     }
 #endif
 
+    int viewed = 0;
+    MDBXC_TEST_ASSERT(table.get_view<int>("answer", [&viewed](const int& value) {
+        viewed = value;
+    }));
+    MDBXC_TEST_ASSERT(viewed == 42);
+    MDBXC_TEST_ASSERT(tagged.get_view<int>("answer", [&viewed](const int& value) {
+        viewed = value;
+    }));
+    MDBXC_TEST_ASSERT(viewed == 43);
+    MDBXC_TEST_ASSERT(!tagged.get_view<int>("missing", [](const int&) {}));
+    bool view_bad_cast = false;
+    try {
+        tagged.get_view<double>("answer", [](const double&) {});
+    } catch (const std::bad_cast&) {
+        view_bad_cast = true;
+    }
+    MDBXC_TEST_ASSERT(view_bad_cast);
+
+    std::vector<std::string> many_keys;
+    many_keys.push_back("stable");
+    many_keys.push_back("missing");
+    many_keys.push_back("answer");
+    std::vector<std::pair<std::string, int>> many = tagged.get_many<int>(many_keys);
+    MDBXC_TEST_ASSERT(many.size() == 1);
+    MDBXC_TEST_ASSERT(many[0].first == "answer" && many[0].second == 43);
+    std::vector<std::pair<std::string, std::string>> untagged =
+        table.get_many<std::string>(std::vector<std::string>(1, "greeting"));
+    MDBXC_TEST_ASSERT(untagged.size() == 1 && untagged[0].second == "hello");
+
     std::cout << "AnyValueTable test passed.\n";
     return 0;
 }
@@ -0,0 +1,112 @@
+#include "test_assert.hpp"
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <mdbx_containers/BitmapKeyTable.hpp>
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/bitmap_key_table_test.mdbx";
+        cfg.max_dbs = 8;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+
+        {
+            mdbxc::BitmapKeyTable<std::uint32_t> table(conn, "bitmap_basic");
+            table.clear();
+
+            MDBXC_TEST_ASSERT(table.empty());
+            MDBXC_TEST_ASSERT(table.insert(5));
+            MDBXC_TEST_ASSERT(!table.insert(5));
+            MDBXC_TEST_ASSERT(table.insert(70000));
+            MDBXC_TEST_ASSERT(table.insert(0xFFFFFFFFu));
+            MDBXC_TEST_ASSERT(table.contains(5));
+            MDBXC_TEST_ASSERT(table.contains(70000));
+            MDBXC_TEST_ASSERT(!table.contains(6));
+            MDBXC_TEST_ASSERT(!table.contains(65536 + 5));
+            MDBXC_TEST_ASSERT(table.count() == 3);
+            MDBXC_TEST_ASSERT(table.retrieve_all() ==
+                              (std::vector<std::uint32_t>{5, 70000, 0xFFFFFFFFu}));
+            MDBXC_TEST_ASSERT(table.range(6, 70000) == (std::vector<std::uint32_t>{70000}));
+
+            MDBXC_TEST_ASSERT(table.erase(70000));
+            MDBXC_TEST_ASSERT(!table.erase(70000));
+            MDBXC_TEST_ASSERT(table.count() == 2);
+            MDBXC_TEST_ASSERT(table.erase(5));
+            MDBXC_TEST_ASSERT(table.erase(0xFFFFFFFFu));
+            MDBXC_TEST_ASSERT(table.empty());
+        }
+
+        // Dense chunks switch to bitmaps and back; sparse chunks stay arrays.
+        {
+            mdbxc::BitmapKeyTable<std::uint64_t> evens(conn, "bitmap_evens");
+            mdbxc::BitmapKeyTable<std::uint64_t> triples(conn, "bitmap_triples");
+            evens.clear();
+            triples.clear();
+
+            const std::uint64_t base = 1ULL << 40;
+            std::vector<std::uint64_t> keys;
+            for (std::uint64_t i = 0; i < 200000; i += 2) keys.push_back(base + i);
+            keys.push_back(base);
+            MDBXC_TEST_ASSERT(evens.insert_many(keys.begin(), keys.end()) == 100000);
+            MDBXC_TEST_ASSERT(evens.insert_many(keys.begin(), keys.end()) == 0);
+            MDBXC_TEST_ASSERT(evens.count() == 100000);
+            MDBXC_TEST_ASSERT(evens.contains(base + 131072));
+            MDBXC_TEST_ASSERT(!evens.contains(base + 131073));
+
+            std::vector<std::uint64_t> sparse;
+            for (std::uint64_t i = 0; i < 200000; i += 3000) sparse.push_back(base + i);
+            triples.insert_many(sparse.begin(), sparse.end());
+
+            std::set<std::uint64_t> expected;
+            for (std::size_t i = 0; i < sparse.size(); ++i) {
+                if ((sparse[i] - base) % 2 == 0) expected.insert(sparse[i]);
+            }
+            const std::vector<std::uint64_t> common = evens.intersect(triples);
+            MDBXC_TEST_ASSERT(std::set<std::uint64_t>(common.begin(), common.end()) == expected);
+            MDBXC_TEST_ASSERT(evens.intersection_count(triples) == expected.size());
+            MDBXC_TEST_ASSERT(evens.intersection_count(evens) == 100000);
+
+            std::uint64_t visited = 0;
+            std::uint64_t previous = 0;
+            bool ordered = true;
+            MDBXC_TEST_ASSERT(evens.for_each([&ordered, &visited, &previous](const std::uint64_t& key) {
+                ordered = ordered && (visited == 0 || key > previous);
+                previous = key;
+                ++visited;
+                return true;
+            }));
+            MDBXC_TEST_ASSERT(ordered && visited == 100000);
+
+            MDBXC_TEST_ASSERT(evens.range(base + 65530, base + 65540) ==
+                              (std::vector<std::uint64_t>{base + 65530, base + 65532, base + 65534,
+                                                          base + 65536, base + 65538, base + 65540}));
+
+            std::size_t seen = 0;
+            MDBXC_TEST_ASSERT(!evens.for_each([&seen](const std::uint64_t&) {
+                return ++seen < 10;
+            }));
+            MDBXC_TEST_ASSERT(seen == 10);
+
+            // Shrink the first chunk back below the array limit.
+            for (std::uint64_t i = 0; i < 65536; i += 2) {
+                if (i >= 1000) MDBXC_TEST_ASSERT(evens.erase(base + i));
+            }
+            MDBXC_TEST_ASSERT(evens.range(base, base + 65535).size() == 500);
+            MDBXC_TEST_ASSERT(evens.contains(base + 998));
+            MDBXC_TEST_ASSERT(!evens.contains(base + 1000));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Bitmap key table test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Bitmap key table test passed.\n";
+    return 0;
+}
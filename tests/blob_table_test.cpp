@@ -0,0 +1,146 @@
+#include "test_assert.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mdbx_containers/BlobTable.hpp>
+
+namespace {
+
+std::vector<std::uint8_t> pattern(std::size_t size, std::uint8_t seed) {
+    std::vector<std::uint8_t> out(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        out[i] = static_cast<std::uint8_t>(seed + i * 7);
+    }
+    return out;
+}
+
+} // namespace
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/blob_table_test.mdbx";
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+
+        typedef mdbxc::BlobTable<std::string> Blobs;
+        Blobs blobs(conn, "blob_chunks", 16);
+        blobs.clear();
+        MDBXC_TEST_ASSERT(blobs.chunk_size() == 16);
+
+        std::vector<std::uint8_t> expected = pattern(100, 1);
+        blobs.put("a", expected);
+        blobs.put("b", pattern(5, 9));
+
+        std::vector<std::uint8_t> value;
+        MDBXC_TEST_ASSERT(blobs.get("a", value) && value == expected);
+        std::uint64_t size = 0;
+        MDBXC_TEST_ASSERT(blobs.size("a", size) && size == 100);
+        MDBXC_TEST_ASSERT(!blobs.contains("c"));
+        MDBXC_TEST_ASSERT(!blobs.get("c", value));
+
+        // Ranged reads cross chunk boundaries and stop at the blob end.
+        std::vector<std::uint8_t> range = blobs.read_range("a", 10, 30);
+        MDBXC_TEST_ASSERT(range == std::vector<std::uint8_t>(expected.begin() + 10, expected.begin() + 40));
+        MDBXC_TEST_ASSERT(blobs.read_range("a", 95, 30).size() == 5);
+        MDBXC_TEST_ASSERT(blobs.read_range("a", 100, 1).empty());
+        std::uint8_t buf[4] = {0, 0, 0, 0};
+        MDBXC_TEST_ASSERT(blobs.read("a", 15, buf, sizeof(buf)) == 4);
+        MDBXC_TEST_ASSERT(buf[0] == expected[15] && buf[3] == expected[18]);
+
+        // Partial overwrites keep the surrounding bytes of each touched chunk.
+        const std::vector<std::uint8_t> patch = pattern(20, 200);
+        blobs.write("a", 30, patch);
+        std::copy(patch.begin(), patch.end(), expected.begin() + 30);
+        MDBXC_TEST_ASSERT(blobs.get("a", value) && value == expected);
+
+        // Writing past the end extends the blob; the gap reads as zero.
+        blobs.write("a", 150, patch);
+        expected.resize(150, 0);
+        expected.insert(expected.end(), patch.begin(), patch.end());
+        MDBXC_TEST_ASSERT(blobs.size("a", size) && size == 170);
+        MDBXC_TEST_ASSERT(blobs.get("a", value) && value == expected);
+
+        // Truncation drops the tail; bytes past a later extension stay zero.
+        MDBXC_TEST_ASSERT(blobs.truncate("a", 40));
+        MDBXC_TEST_ASSERT(blobs.size("a", size) && size == 40);
+        blobs.write("a", 60, patch.data(), 1);
+        expected.resize(40);
+        expected.resize(60, 0);
+        expected.push_back(patch[0]);
+        MDBXC_TEST_ASSERT(blobs.get("a", value) && value == expected);
+        MDBXC_TEST_ASSERT(!blobs.truncate("c", 0));
+
+        // Writes to a missing blob create it.
+        blobs.write("c", 3, patch.data(), 2);
+        MDBXC_TEST_ASSERT(blobs.get("c", value) && value.size() == 5);
+        MDBXC_TEST_ASSERT(value[0] == 0 && value[3] == patch[0] && value[4] == patch[1]);
+
+        // Replacing with a shorter value and erasing leave other blobs intact.
+        blobs.put("a", pattern(20, 3));
+        MDBXC_TEST_ASSERT(blobs.get("a", value) && value == pattern(20, 3));
+        MDBXC_TEST_ASSERT(blobs.erase("a"));
+        MDBXC_TEST_ASSERT(!blobs.erase("a"));
+        MDBXC_TEST_ASSERT(!blobs.contains("a"));
+        MDBXC_TEST_ASSERT(blobs.get("b", value) && value == pattern(5, 9));
+
+        // Streaming writer and reader, inside one transaction.
+        const std::vector<std::uint8_t> stream = pattern(1000, 42);
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            Blobs::Writer writer = blobs.writer("s", txn);
+            for (std::size_t i = 0; i < stream.size(); i += 37) {
+                const std::size_t n = std::min<std::size_t>(37, stream.size() - i);
+                writer.write(&stream[i], n);
+            }
+            MDBXC_TEST_ASSERT(writer.size() == stream.size());
+            writer.close();
+            txn.commit();
+        }
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            Blobs::Reader reader = blobs.reader("s", txn);
+            MDBXC_TEST_ASSERT(reader.size() == stream.size());
+            std::vector<std::uint8_t> copy;
+            std::uint8_t chunk[23];
+            std::size_t n = 0;
+            while ((n = reader.read(chunk, sizeof(chunk))) != 0) {
+                copy.insert(copy.end(), chunk, chunk + n);
+            }
+            MDBXC_TEST_ASSERT(copy == stream);
+            reader.seek(500);
+            MDBXC_TEST_ASSERT(reader.read(chunk, 3) == 3 && chunk[0] == stream[500]);
+            MDBXC_TEST_ASSERT(reader.tell() == 503);
+            txn.commit();
+        }
+
+        bool thrown = false;
+        try {
+            blobs.reader("missing");
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        MDBXC_TEST_ASSERT(thrown);
+
+        // A table with another chunk size still reads blobs by their stored chunk size.
+        Blobs wide(conn, "blob_chunks", 64);
+        MDBXC_TEST_ASSERT(wide.get("s", value) && value == stream);
+        wide.write("s", 10, patch);
+        std::vector<std::uint8_t> patched = stream;
+        std::copy(patch.begin(), patch.end(), patched.begin() + 10);
+        MDBXC_TEST_ASSERT(blobs.get("s", value) && value == patched);
+    } catch (const std::exception& e) {
+        std::cerr << "Blob table test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Blob table test passed.\n";
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "test_assert.hpp"
+#include <iostream>
+#include <string>
+
+#include <mdbx_containers/CachedKeyValueTable.hpp>
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/cached_key_value_table_test.mdbx";
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+        mdbxc::CachedKeyValueTable<int, std::string> table(conn, "cached_kv", 1 << 20, 4);
+        table.clear();
+
+        table.insert_or_assign(1, "one");
+        table.insert_or_assign(2, "two");
+        table.reset_cache_stats();
+
+        // First read misses, later reads share the cached value.
+        auto first = table.get(1);
+        MDBXC_TEST_ASSERT(first && *first == "one");
+        auto second = table.get(1);
+        MDBXC_TEST_ASSERT(second.get() == first.get());
+        MDBXC_TEST_ASSERT(table.at(2) == "two");
+        MDBXC_TEST_ASSERT(table.contains(2));
+
+        // Absent keys are cached too.
+        MDBXC_TEST_ASSERT(!table.get(3));
+        MDBXC_TEST_ASSERT(!table.contains(3));
+
+        mdbxc::CacheStats stats = table.cache_stats();
+        MDBXC_TEST_ASSERT(stats.misses == 3);
+        MDBXC_TEST_ASSERT(stats.hits == 3);
+        MDBXC_TEST_ASSERT(stats.entries == 3);
+        MDBXC_TEST_ASSERT(stats.bytes > 0);
+
+        // Local writes drop the written keys.
+        table.insert_or_assign(1, "uno");
+        MDBXC_TEST_ASSERT(table.at(1) == "uno");
+        MDBXC_TEST_ASSERT(table.insert(3, "three"));
+        MDBXC_TEST_ASSERT(table.at(3) == "three");
+        MDBXC_TEST_ASSERT(table.update(2, [](std::string& v) { v += "!"; }));
+        MDBXC_TEST_ASSERT(table.at(2) == "two!");
+        MDBXC_TEST_ASSERT(table.erase(3));
+        MDBXC_TEST_ASSERT(!table.contains(3));
+        MDBXC_TEST_ASSERT(table.cache_stats().invalidations == 4);
+
+        // Writes that bypass the wrapper need an explicit invalidation.
+        table.table().insert_or_assign(1, "bypass");
+        MDBXC_TEST_ASSERT(table.at(1) == "uno");
+        table.invalidate(1);
+        MDBXC_TEST_ASSERT(table.at(1) == "bypass");
+
+        // The memory budget evicts least recently used entries.
+        mdbxc::CachedKeyValueTable<int, std::string> small(conn, "cached_kv_small", 2048, 1);
+        small.clear();
+        for (int i = 0; i < 64; ++i) {
+            small.insert_or_assign(i, std::string(64, 'x'));
+        }
+        for (int i = 0; i < 64; ++i) {
+            MDBXC_TEST_ASSERT(small.at(i).size() == 64);
+        }
+        stats = small.cache_stats();
+        MDBXC_TEST_ASSERT(stats.evictions > 0);
+        MDBXC_TEST_ASSERT(stats.bytes <= small.budget_bytes());
+        MDBXC_TEST_ASSERT(stats.entries < 64);
+
+        table.clear();
+        MDBXC_TEST_ASSERT(table.cache_stats().entries == 0);
+        MDBXC_TEST_ASSERT(!table.contains(1));
+    } catch (const std::exception& e) {
+        std::cerr << "Cached key-value table test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Cached key-value table test passed.\n";
+    return 0;
+}
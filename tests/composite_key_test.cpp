@@ -0,0 +1,144 @@
+#include "test_assert.hpp"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <mdbx_containers/KeyValueTable.hpp>
+
+namespace {
+
+template<typename T>
+std::vector<std::uint8_t> encode(const T& key) {
+    mdbxc::SerializeScratch sc;
+    const MDBX_val val = mdbxc::serialize_key(key, sc);
+    const std::uint8_t* p = static_cast<const std::uint8_t*>(val.iov_base);
+    return std::vector<std::uint8_t>(p, p + val.iov_len);
+}
+
+template<typename T>
+T decode(const std::vector<std::uint8_t>& bytes) {
+    MDBX_val val;
+    val.iov_base = const_cast<std::uint8_t*>(bytes.data());
+    val.iov_len = bytes.size();
+    return mdbxc::deserialize_key<T>(val);
+}
+
+/// \brief Checks that \p keys, sorted by value, also sort by encoded bytes and round-trip.
+template<typename T>
+void assert_ordered(const std::vector<T>& keys) {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        const std::vector<std::uint8_t> bytes = encode(keys[i]);
+        MDBXC_TEST_ASSERT(decode<T>(bytes) == keys[i]);
+        if (i == 0) continue;
+        MDBXC_TEST_ASSERT(encode(keys[i - 1]) < bytes);
+    }
+}
+
+void test_encoding() {
+    typedef std::tuple<std::int32_t, std::string, double> Key;
+    std::vector<Key> keys;
+    keys.push_back(Key(-5, "", -1.5));
+    keys.push_back(Key(-5, "", 0.0));
+    keys.push_back(Key(-5, std::string("a\0", 2), -2.0));
+    keys.push_back(Key(-1, "a", 3.0));
+    keys.push_back(Key(0, "a", 1.0));
+    keys.push_back(Key(0, std::string("a\0b", 3), 1.0));
+    keys.push_back(Key(0, "ab", -1.0));
+    keys.push_back(Key(7, "b", 2.5));
+    assert_ordered(keys);
+
+    typedef std::pair<std::uint64_t, std::pair<bool, std::vector<std::uint8_t> > > Nested;
+    std::vector<Nested> nested;
+    nested.push_back(Nested(1, std::make_pair(false, std::vector<std::uint8_t>(1, 0xFF))));
+    nested.push_back(Nested(1, std::make_pair(true, std::vector<std::uint8_t>())));
+    nested.push_back(Nested(256, std::make_pair(false, std::vector<std::uint8_t>(2, 0))));
+    assert_ordered(nested);
+
+    MDBXC_TEST_ASSERT(mdbxc::get_mdbx_flags<Key>() == 0);
+    MDBXC_TEST_ASSERT(mdbxc::get_key_size(Key(1, "xy", 0.0)) == 4 + 4 + 8);
+
+    // The leading fields encode to a byte prefix of the whole key.
+    const std::vector<std::uint8_t> whole = encode(Key(3, "abc", 1.0));
+    const std::vector<std::uint8_t> head = encode(std::make_tuple(std::int32_t(3), std::string("abc")));
+    MDBXC_TEST_ASSERT(head.size() < whole.size());
+    MDBXC_TEST_ASSERT(std::memcmp(head.data(), whole.data(), head.size()) == 0);
+
+    bool threw = false;
+    try {
+        std::vector<std::uint8_t> truncated = whole;
+        truncated.pop_back();
+        decode<Key>(truncated);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    MDBXC_TEST_ASSERT(threw);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_encoding();
+
+        mdbxc::Config cfg;
+        cfg.pathname = "data/composite_key_test.mdbx";
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+        auto conn = mdbxc::Connection::create(cfg);
+
+        typedef std::tuple<std::int32_t, std::string, std::int64_t> EventKey;
+        mdbxc::KeyValueTable<EventKey, std::string> events(conn, "composite_events");
+        events.clear();
+        for (std::int32_t user = -2; user <= 2; ++user) {
+            events.insert_or_assign(EventKey(user, "click", 10), "c10");
+            events.insert_or_assign(EventKey(user, "click", -3), "c-3");
+            events.insert_or_assign(EventKey(user, "view", 5), "v5");
+        }
+        MDBXC_TEST_ASSERT(events.count() == 15);
+        MDBXC_TEST_ASSERT(events.at(EventKey(-2, "click", -3)) == "c-3");
+
+        std::vector<std::pair<EventKey, std::string> > slice =
+            events.range<std::vector>(EventKey(-1, "", 0), EventKey(0, "click", 100));
+        MDBXC_TEST_ASSERT(slice.size() == 5);
+        MDBXC_TEST_ASSERT(std::get<0>(slice.front().first) == -1);
+        MDBXC_TEST_ASSERT(std::get<2>(slice.front().first) == -3);
+        MDBXC_TEST_ASSERT(std::get<2>(slice.back().first) == 10);
+
+        std::vector<EventKey> visited;
+        MDBXC_TEST_ASSERT(events.for_each_prefix(std::make_tuple(std::int32_t(1)),
+            [&visited](const EventKey& key, const std::string&) {
+                visited.push_back(key);
+                return true;
+            }));
+        MDBXC_TEST_ASSERT(visited.size() == 3);
+        MDBXC_TEST_ASSERT(visited[0] == EventKey(1, "click", -3));
+        MDBXC_TEST_ASSERT(visited[2] == EventKey(1, "view", 5));
+        MDBXC_TEST_ASSERT(events.count_prefix(std::make_tuple(std::int32_t(-2), std::string("click"))) == 2);
+        MDBXC_TEST_ASSERT(events.count_prefix(EventKey(2, "view", 5)) == 1);
+        MDBXC_TEST_ASSERT(events.erase_prefix(std::make_tuple(std::int32_t(0))) == 3);
+        MDBXC_TEST_ASSERT(events.count() == 12);
+        MDBXC_TEST_ASSERT(!events.contains(EventKey(0, "view", 5)));
+
+        mdbxc::KeyValueTable<std::pair<std::string, std::uint16_t>, int> ports(conn, "composite_ports");
+        ports.clear();
+        ports.insert_or_assign(std::make_pair(std::string("host"), std::uint16_t(443)), 1);
+        ports.insert_or_assign(std::make_pair(std::string("host"), std::uint16_t(80)), 2);
+        ports.insert_or_assign(std::make_pair(std::string("hostname"), std::uint16_t(22)), 3);
+        MDBXC_TEST_ASSERT(ports.count_prefix(std::make_tuple(std::string("host"))) == 2);
+        int port_value = 0;
+        MDBXC_TEST_ASSERT(ports.try_get(std::make_pair(std::string("host"), std::uint16_t(80)), port_value, nullptr));
+        MDBXC_TEST_ASSERT(port_value == 2);
+    } catch (const std::exception& e) {
+        std::cerr << "Composite key test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Composite key test passed.\n";
+    return 0;
+}
@@ -59,7 +59,7 @@ void assert_throws_any(Fn fn) {
 int main() {
     mdbxc::Config cfg;
     cfg.pathname = "data/hashed_key_value_store_test.mdbx";
-    cfg.max_dbs = 32;
+    cfg.max_dbs = 64;
     cfg.no_subdir = true;
     cfg.relative_to_exe = true;
 
@@ -96,6 +96,12 @@ int main() {
 
         std::vector<std::pair<std::string, int> > as_vector = store.retrieve_all<std::vector>();
         MDBXC_TEST_ASSERT(as_vector.size() == 4);
+        std::vector<std::pair<std::string, int> > decoded;
+        store.parallel_load(decoded, 3);
+        MDBXC_TEST_ASSERT(decoded.size() == 4);
+        std::map<std::string, int> parallel_map;
+        store.parallel_load(parallel_map, 3);
+        MDBXC_TEST_ASSERT(parallel_map == as_map);
 
         MDBXC_TEST_ASSERT(store.erase("alpha"));
         MDBXC_TEST_ASSERT(!store.erase("alpha"));
@@ -152,6 +158,15 @@ int main() {
         MDBXC_TEST_ASSERT(!store.contains("alpha"));
         MDBXC_TEST_ASSERT(store.contains("beta"));
         MDBXC_TEST_ASSERT(store.count() == 2);
+
+        const std::string prefix = "https://example.com/a/very/long/shared/path/segment/";
+        store.insert_or_assign(prefix + "tail-1", "t1");
+        store.insert_or_assign(prefix + "tail-2", "t2");
+        store.insert_or_assign("X" + prefix.substr(1) + "tail-1", "x1");
+        assert_found<decltype(store), std::string, std::string>(store, prefix + "tail-1", "t1");
+        assert_found<decltype(store), std::string, std::string>(store, prefix + "tail-2", "t2");
+        assert_found<decltype(store), std::string, std::string>(store, "X" + prefix.substr(1) + "tail-1", "x1");
+        MDBXC_TEST_ASSERT(!store.contains(prefix + "tail-3"));
     }
 
     {
@@ -321,6 +336,9 @@ int main() {
         store.load(as_map);
         MDBXC_TEST_ASSERT(as_map["a"] == 1);
         MDBXC_TEST_ASSERT(as_map["b"] == 22);
+        std::vector<std::pair<std::string, int> > decoded;
+        store.parallel_load(decoded, 2);
+        MDBXC_TEST_ASSERT(decoded.size() == 2);
 
         std::vector<std::pair<std::string, int> > replacement;
         replacement.push_back(std::make_pair(std::string("b"), 200));
@@ -412,6 +430,201 @@ int main() {
         });
     }
 
+    {
+        mdbxc::HashedKeyValueStore<std::string, int> store(conn, "hashed_filtered");
+        store.clear();
+        store.insert_or_assign("before", 1);
+        MDBXC_TEST_ASSERT(!store.hash_filter_enabled());
+        store.enable_hash_filter(64);
+        MDBXC_TEST_ASSERT(store.hash_filter_enabled());
+        MDBXC_TEST_ASSERT(store.at("before") == 1);
+
+        MDBXC_TEST_ASSERT(store.insert("after", 2));
+        MDBXC_TEST_ASSERT(store.contains("after"));
+        MDBXC_TEST_ASSERT(!store.contains("missing"));
+        MDBXC_TEST_ASSERT(!store.erase("missing"));
+
+        {
+            mdbxc::Transaction txn = conn->transaction();
+            store.insert_or_assign("rolled_back", 3, txn);
+            MDBXC_TEST_ASSERT(store.contains("rolled_back", txn));
+            txn.rollback();
+        }
+        MDBXC_TEST_ASSERT(!store.contains("rolled_back"));
+
+        MDBXC_TEST_ASSERT(store.erase("before"));
+        store.rebuild_hash_filter();
+        MDBXC_TEST_ASSERT(!store.contains("before"));
+        MDBXC_TEST_ASSERT(store.at("after") == 2);
+
+        bool nested_threw = false;
+        {
+            mdbxc::Transaction txn = conn->transaction();
+            try {
+                store.rebuild_hash_filter();
+            } catch (const std::logic_error&) {
+                nested_threw = true;
+            }
+            txn.rollback();
+        }
+        MDBXC_TEST_ASSERT(nested_threw);
+
+        store.disable_hash_filter();
+        MDBXC_TEST_ASSERT(!store.hash_filter_enabled());
+        MDBXC_TEST_ASSERT(store.contains("after"));
+
+        typedef mdbxc::HashedKeyValueStore<
+            std::string,
+            int,
+            mdbxc::XXH3Hasher,
+            mdbxc::HashedStoreLayout::SmallValues> SmallStore;
+        SmallStore small(conn, "hashed_small_filtered");
+        small.clear();
+        small.insert_or_assign("a", 1);
+        small.enable_hash_filter(16);
+        MDBXC_TEST_ASSERT(small.insert("b", 2));
+        MDBXC_TEST_ASSERT(small.at("a") == 1);
+        MDBXC_TEST_ASSERT(small.at("b") == 2);
+        MDBXC_TEST_ASSERT(!small.contains("c"));
+        small.insert_or_assign("c", 3);
+        MDBXC_TEST_ASSERT(small.at("c") == 3);
+    }
+
+    {
+        mdbxc::HashedKeyValueStore<std::string, int> store(conn, "hashed_batch");
+        store.clear();
+        std::vector<std::string> keys;
+        for (int i = 0; i < 200; ++i) {
+            std::string key = "key-" + std::to_string(i);
+            if (i % 3 != 0) {
+                store.insert_or_assign(key, i);
+            }
+            keys.push_back(key);
+        }
+        keys.push_back("key-5");
+        keys.push_back("absent");
+
+        std::vector<std::pair<bool, int> > compat;
+        MDBXC_TEST_ASSERT(store.find_many_batch_compat(keys, compat) == 134);
+        MDBXC_TEST_ASSERT(compat.size() == keys.size());
+        for (int i = 0; i < 200; ++i) {
+            MDBXC_TEST_ASSERT(compat[i].first == (i % 3 != 0));
+            MDBXC_TEST_ASSERT(!compat[i].first || compat[i].second == i);
+        }
+        MDBXC_TEST_ASSERT(compat[200].first && compat[200].second == 5);
+        MDBXC_TEST_ASSERT(!compat[201].first);
+
+        mdbxc::HashedKeyValueStore<std::string, std::string, ConstantHasher> colliding(
+            conn, "hashed_batch_collisions", ConstantHasher());
+        colliding.clear();
+        colliding.insert_or_assign("a", "A");
+        colliding.insert_or_assign("b", "B");
+        std::vector<std::string> colliding_keys;
+        colliding_keys.push_back("b");
+        colliding_keys.push_back("c");
+        colliding_keys.push_back("a");
+        std::vector<std::pair<bool, std::string> > colliding_out;
+        MDBXC_TEST_ASSERT(colliding.find_many_batch_compat(colliding_keys, colliding_out) == 2);
+        MDBXC_TEST_ASSERT(colliding_out[0].second == "B");
+        MDBXC_TEST_ASSERT(!colliding_out[1].first);
+        MDBXC_TEST_ASSERT(colliding_out[2].second == "A");
+
+        typedef mdbxc::HashedKeyValueStore<
+            std::string,
+            int,
+            mdbxc::XXH3Hasher,
+            mdbxc::HashedStoreLayout::SmallValues> SmallStore;
+        SmallStore small(conn, "hashed_small_batch");
+        small.clear();
+        small.insert_or_assign("x", 1);
+        small.insert_or_assign("y", 2);
+        std::vector<std::string> small_keys;
+        small_keys.push_back("y");
+        small_keys.push_back("z");
+        small_keys.push_back("x");
+#if __cplusplus >= 201703L
+        std::vector<std::optional<int> > small_out;
+        MDBXC_TEST_ASSERT(small.find_many_batch(small_keys, small_out) == 2);
+        MDBXC_TEST_ASSERT(small_out[0] == 2);
+        MDBXC_TEST_ASSERT(!small_out[1].has_value());
+        MDBXC_TEST_ASSERT(small_out[2] == 1);
+#else
+        std::vector<std::pair<bool, int> > small_out;
+        MDBXC_TEST_ASSERT(small.find_many_batch_compat(small_keys, small_out) == 2);
+        MDBXC_TEST_ASSERT(small_out[0].second == 2);
+        MDBXC_TEST_ASSERT(!small_out[1].first);
+        MDBXC_TEST_ASSERT(small_out[2].second == 1);
+#endif
+    }
+
+    {
+        typedef mdbxc::HashedKeyValueStore<
+            std::string,
+            std::string,
+            mdbxc::XXH3Hasher,
+            mdbxc::HashedStoreLayout::Hybrid> HybridStore;
+        HybridStore store(conn, "hashed_hybrid", mdbxc::XXH3Hasher(), 16);
+        store.clear();
+        MDBXC_TEST_ASSERT(store.inline_limit() == 16);
+
+        const std::string big(4096, 'b');
+        MDBXC_TEST_ASSERT(store.insert("small", "s"));
+        MDBXC_TEST_ASSERT(store.insert("large", big));
+        MDBXC_TEST_ASSERT(!store.insert("large", "ignored"));
+        assert_found<HybridStore, std::string, std::string>(store, "small", "s");
+        assert_found<HybridStore, std::string, std::string>(store, "large", big);
+
+        store.insert_or_assign("small", big + "x");
+        store.insert_or_assign("large", big + "y");
+        assert_found<HybridStore, std::string, std::string>(store, "small", big + "x");
+        assert_found<HybridStore, std::string, std::string>(store, "large", big + "y");
+        store.insert_or_assign("large", "tiny");
+        assert_found<HybridStore, std::string, std::string>(store, "large", "tiny");
+        MDBXC_TEST_ASSERT(store.count() == 2);
+
+        MDBXC_TEST_ASSERT(store.erase("small"));
+        MDBXC_TEST_ASSERT(!store.contains("small"));
+        store.insert_or_assign("spilled", big);
+
+        std::map<std::string, std::string> as_map;
+        store.load(as_map);
+        MDBXC_TEST_ASSERT(as_map.size() == 2);
+        MDBXC_TEST_ASSERT(as_map["spilled"] == big);
+
+        std::vector<std::pair<std::string, std::string> > decoded;
+        store.parallel_load(decoded, 2);
+        MDBXC_TEST_ASSERT(decoded.size() == 2);
+        std::map<std::string, std::string> parallel_map;
+        store.parallel_load(parallel_map, 2);
+        MDBXC_TEST_ASSERT(parallel_map == as_map);
+
+        std::vector<std::pair<std::string, std::string> > replacement;
+        replacement.push_back(std::make_pair(std::string("large"), big));
+        store.reconcile(replacement);
+        MDBXC_TEST_ASSERT(store.count() == 1);
+        MDBXC_TEST_ASSERT(!store.contains("spilled"));
+
+        mdbxc::HashedKeyValueStore<std::string, std::string> source(conn, "hashed_migrate_source");
+        source.clear();
+        for (int i = 0; i < 50; ++i) {
+            source.insert_or_assign("m" + std::to_string(i), i % 2 ? big : std::to_string(i));
+        }
+        store.clear();
+        MDBXC_TEST_ASSERT(mdbxc::migrate_hashed_store(source, store, 7) == 50);
+        MDBXC_TEST_ASSERT(store.count() == 50);
+        assert_found<HybridStore, std::string, std::string>(store, "m1", big);
+        assert_found<HybridStore, std::string, std::string>(store, "m2", "2");
+
+        mdbxc::HashedKeyValueStore<std::string, std::string> back(conn, "hashed_migrate_back");
+        back.clear();
+        store.erase("m1");
+        MDBXC_TEST_ASSERT(mdbxc::migrate_hashed_store(store, back, 3) == 49);
+        MDBXC_TEST_ASSERT(back.count() == 49);
+        MDBXC_TEST_ASSERT(!back.contains("m1"));
+        MDBXC_TEST_ASSERT(back.at("m3") == big);
+        MDBXC_TEST_ASSERT(back.at("m4") == "4");
+    }
+
     std::cout << "HashedKeyValueStore test passed.\n";
     return 0;
 }
@@ -26,6 +26,10 @@
 #error "framework-neutral sync/transport.hpp must not enable Kurlyk HTTP"
 #endif
 
+#if defined(MDBXC_HAS_CURL_HTTP_TRANSPORT)
+#error "framework-neutral sync/transport.hpp must not enable libcurl HTTP"
+#endif
+
 int main() {
     mdbxc::sync::NodeId node = mdbxc::sync::make_zero_node();
     mdbxc::sync::PullRequest pull;
@@ -135,6 +135,14 @@ int main() {
         std::string(mdbxc::sync::sync_response_error_code_name(
             mdbxc::sync::SyncResponseErrorCode::BatchTooLarge)) ==
         "batch_too_large");
+    MDBXC_TEST_ASSERT(
+        std::string(mdbxc::sync::sync_response_error_code_name(
+            mdbxc::sync::SyncResponseErrorCode::SnapshotExpired)) ==
+        "snapshot_expired");
+    MDBXC_TEST_ASSERT(
+        std::string(mdbxc::sync::sync_response_error_code_name(
+            mdbxc::sync::SyncResponseErrorCode::CursorBaselineMismatch)) ==
+        "cursor_baseline_mismatch");
     mdbxc::sync::SyncCaptureScope* capture_scope = nullptr;
     mdbxc::sync::SyncWorkerGuard* worker_guard = nullptr;
     mdbxc::sync::SyncNodeSession* node_session = nullptr;
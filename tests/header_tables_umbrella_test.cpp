@@ -30,6 +30,9 @@ int main() {
     mdbxc::HashedKeyValueStore<std::string, std::string>* hashed_store = nullptr;
     MDBXC_TEST_ASSERT(hashed_store == nullptr);
 
+    mdbxc::BlobTable<std::string>* blob_table = nullptr;
+    MDBXC_TEST_ASSERT(blob_table == nullptr);
+
     const std::string key = "tables";
     const mdbxc::ByteView view = mdbxc::make_byte_view(key);
     MDBXC_TEST_ASSERT(view.data != nullptr);
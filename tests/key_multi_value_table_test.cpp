@@ -34,7 +34,7 @@ void assert_throws_length_error(Fn fn) {
 int main() {
     mdbxc::Config cfg;
     cfg.pathname = "data/key_multi_value_table_test.mdbx";
-    cfg.max_dbs = 8;
+    cfg.max_dbs = 16;
     cfg.no_subdir = true;
     cfg.relative_to_exe = true;
 
@@ -54,8 +54,21 @@ int main() {
         MDBXC_TEST_ASSERT(table.count(7) == 3);
         MDBXC_TEST_ASSERT(table.count(7, std::string("created")) == 2);
         MDBXC_TEST_ASSERT(table.count(7, std::string("missing")) == 0);
+        const std::vector<std::size_t> per_key = table.count_many(std::vector<int>{8, 9, 7});
+        MDBXC_TEST_ASSERT(per_key.size() == 3 && per_key[0] == 1 && per_key[1] == 0 && per_key[2] == 3);
+        const std::vector<std::pair<int, std::size_t>> cardinalities = table.key_cardinalities(0, 100);
+        MDBXC_TEST_ASSERT(cardinalities.size() == 2);
+        MDBXC_TEST_ASSERT(cardinalities[0].first == 7 && cardinalities[0].second == 3);
+        MDBXC_TEST_ASSERT(cardinalities[1].first == 8 && cardinalities[1].second == 1);
+        MDBXC_TEST_ASSERT(table.key_cardinalities(8, 8).size() == 1);
         MDBXC_TEST_ASSERT(table.contains(7));
         MDBXC_TEST_ASSERT(table.contains(7, std::string("sent")));
+        std::vector<std::string> seven;
+        MDBXC_TEST_ASSERT(table.for_each_value(7, [&seven](const std::string& v) {
+            seven.push_back(v);
+            return true;
+        }));
+        MDBXC_TEST_ASSERT(seven.size() == 3 && seven[2] == "sent");
         MDBXC_TEST_ASSERT(!table.contains(9));
 
         assert_vector_equal(table.find(7), std::vector<std::string>{"created", "created", "sent"});
@@ -230,6 +243,79 @@ int main() {
         MDBXC_TEST_ASSERT(safe_table.count(12, std::string("fast")) == 1);
     }
 
+    {
+        mdbxc::KeyMultiValueTable<int, uint32_t, mdbxc::DupFixedTableOptions> table(conn, "multi_dup_fixed");
+        table.clear();
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < 5000; ++i) {
+            table.insert(1, i % 7);
+            expected.push_back(i % 7);
+        }
+        table.insert(2, 42u);
+        assert_vector_equal(table.find(1), expected);
+        assert_vector_equal(table.find(2), std::vector<uint32_t>{42u});
+        MDBXC_TEST_ASSERT(table.find(3).empty());
+        std::vector<uint32_t> streamed;
+        MDBXC_TEST_ASSERT(table.for_each_value(1, [&streamed](const uint32_t& v) {
+            streamed.push_back(v);
+            return true;
+        }));
+        assert_vector_equal(streamed, expected);
+        std::size_t visited = 0;
+        MDBXC_TEST_ASSERT(!table.for_each_value(1, [&visited](const uint32_t&) {
+            return ++visited < 10;
+        }));
+        MDBXC_TEST_ASSERT(visited == 10);
+        MDBXC_TEST_ASSERT(table.for_each_value(3, [](const uint32_t&) { return false; }));
+        std::vector<uint32_t> collected(1, 99u);
+        MDBXC_TEST_ASSERT(table.find_into(1, collected) == expected.size());
+        MDBXC_TEST_ASSERT(collected.size() == expected.size() + 1 && collected.back() == expected.back());
+        std::set<uint32_t> distinct;
+        MDBXC_TEST_ASSERT(table.find_into(1, distinct) == expected.size() && distinct.size() == 7);
+        MDBXC_TEST_ASSERT(table.count(1, 3u) == 714);
+        MDBXC_TEST_ASSERT(table.erase(1, 3u) == 714);
+        MDBXC_TEST_ASSERT(table.count(1) == 5000 - 714);
+
+        std::vector<uint32_t> batch;
+        for (uint32_t i = 0; i < 3000; ++i) {
+            batch.push_back(i);
+        }
+        table.insert_many(2, batch.begin(), batch.end());
+        table.insert_many(4, batch.begin(), batch.end());
+        std::vector<uint32_t> expected_two(1, 42u);
+        expected_two.insert(expected_two.end(), batch.begin(), batch.end());
+        assert_vector_equal(table.find(2), expected_two);
+        assert_vector_equal(table.find(4), batch);
+        table.insert(4, 7u);
+        MDBXC_TEST_ASSERT(table.find(4).back() == 7u);
+    }
+
+    {
+        mdbxc::KeyMultiValueTable<int, std::string> table(conn, "multi_insert_many");
+        table.clear();
+        table.insert(1, "first");
+        std::vector<std::string> batch;
+        batch.push_back("b");
+        batch.push_back("a");
+        batch.push_back("b");
+        table.insert_many(1, batch.begin(), batch.end());
+        table.insert_many(2, batch.begin(), batch.end());
+        table.insert_many(3, batch.end(), batch.end());
+        assert_vector_equal(table.find(1), std::vector<std::string>{"first", "b", "a", "b"});
+        std::vector<std::string> into;
+        MDBXC_TEST_ASSERT(table.find_into(1, into) == 4);
+        assert_vector_equal(into, std::vector<std::string>{"first", "b", "a", "b"});
+#if MDBXC_HAS_PMR
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::vector<std::pmr::string> pmr_values(&arena);
+        MDBXC_TEST_ASSERT(table.find_into(2, pmr_values) == 3);
+        MDBXC_TEST_ASSERT(pmr_values[1] == "a" && pmr_values[1].get_allocator().resource() == &arena);
+#endif
+        assert_vector_equal(table.find(2), batch);
+        MDBXC_TEST_ASSERT(table.count(2, std::string("b")) == 2);
+        MDBXC_TEST_ASSERT(!table.contains(3));
+    }
+
     {
         mdbxc::Config limit_cfg;
         limit_cfg.pathname = "data/key_multi_value_oversized_test.mdbx";
@@ -288,6 +374,9 @@ int main() {
         // contains_range / count_range / erase_range
         MDBXC_TEST_ASSERT(table.contains_range(2, 3));
         MDBXC_TEST_ASSERT(table.count_range(2, 3) == 4); // c + d,e,f
+        MDBXC_TEST_ASSERT(table.estimate_count_range(2, 3) == 4);
+        MDBXC_TEST_ASSERT(table.estimate_count_range(3, 2) == 0);
+        MDBXC_TEST_ASSERT(table.estimate_bytes_range(2, 3) > 0);
         std::size_t erased = table.erase_range(2, 3);
         MDBXC_TEST_ASSERT(erased == 4);
         MDBXC_TEST_ASSERT(table.count() == 2);
@@ -101,6 +101,24 @@ int main() {
         MDBXC_TEST_ASSERT(table.count(7) == 3u);
         MDBXC_TEST_ASSERT(table.count(7, std::string("created")) == 2u);
         MDBXC_TEST_ASSERT(table.count(7, std::string("missing")) == 0u);
+        MDBXC_TEST_ASSERT(table.count_many(std::vector<int>{7, 9})[0] == 3u);
+        MDBXC_TEST_ASSERT(table.count_many(std::vector<int>{7, 9})[1] == 0u);
+        MDBXC_TEST_ASSERT(table.key_cardinalities(0, 7).size() == 1u);
+        MDBXC_TEST_ASSERT(table.key_cardinalities(0, 7)[0].second == 3u);
+        std::vector<std::string> seven;
+        MDBXC_TEST_ASSERT(!table.for_each_value(7, [&seven](const std::string& v) {
+            seven.push_back(v);
+            return seven.size() < 2;
+        }));
+        MDBXC_TEST_ASSERT(seven.size() == 2u && seven[1] == "created");
+        std::size_t pairs = 0;
+        MDBXC_TEST_ASSERT(table.for_each_range(7, 8, [&pairs](const int&, const std::string&) {
+            return ++pairs > 0;
+        }));
+        MDBXC_TEST_ASSERT(pairs == 4u);
+        MDBXC_TEST_ASSERT(table.estimate_count_range(7, 8) == 4u);
+        MDBXC_TEST_ASSERT(table.estimate_count_range(7, 7) == 3u);
+        MDBXC_TEST_ASSERT(table.estimate_bytes_range(9, 10) == 0u);
         MDBXC_TEST_ASSERT(table.contains(7));
         MDBXC_TEST_ASSERT(table.contains(7, std::string("sent")));
         MDBXC_TEST_ASSERT(!table.contains(9));
@@ -164,6 +182,135 @@ int main() {
         assert_vector_equal(table.find(1), after_clear);
     }
 
+    {
+        mdbxc::KeyOrderedMultiValueTable<int, std::string> table(conn, "ordered_append_many");
+        table.clear();
+        table.append(1, "first");
+        std::vector<std::string> batch;
+        batch.push_back("b");
+        batch.push_back("a");
+        batch.push_back("b");
+        table.append_many(1, batch.begin(), batch.end());
+        table.insert_many(2, batch.begin(), batch.end());
+        table.append_many(3, batch.end(), batch.end());
+
+        std::vector<std::string> expected;
+        expected.push_back("first");
+        expected.insert(expected.end(), batch.begin(), batch.end());
+        assert_vector_equal(table.find(1), expected);
+        assert_vector_equal(table.find(2), batch);
+        MDBXC_TEST_ASSERT(!table.contains(3));
+        table.append(2, "tail");
+        MDBXC_TEST_ASSERT(table.find(2).back() == "tail");
+    }
+
+    {
+        mdbxc::KeyOrderedMultiValueTable<int, std::string> table(conn, "ordered_order_cache");
+        mdbxc::KeyOrderedMultiValueTable<int, std::string> other(conn, "ordered_order_cache");
+        table.clear();
+        table.set_order_cache_size(2);
+        MDBXC_TEST_ASSERT(table.order_cache_size() == 2u);
+
+        table.append(1, "a");
+        table.append(1, "b");
+        other.append(1, "c");
+        table.append(1, "d");
+        MDBXC_TEST_ASSERT(table.erase_at(1, 3u));
+        table.append(1, "e");
+        std::vector<std::string> batch;
+        batch.push_back("f");
+        batch.push_back("g");
+        table.append_many(1, batch.begin(), batch.end());
+        table.append(2, "x");
+        table.append(3, "y");
+
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            table.clear(txn);
+            table.append(1, "rolled-back", txn);
+            txn.rollback();
+        }
+        table.append(1, "h");
+
+        std::vector<std::string> expected;
+        expected.push_back("a");
+        expected.push_back("b");
+        expected.push_back("c");
+        expected.push_back("e");
+        expected.push_back("f");
+        expected.push_back("g");
+        expected.push_back("h");
+        assert_vector_equal(table.find(1), expected);
+        assert_vector_equal(other.find(1), expected);
+
+        // The next writer reuses the txnid of the rolled back one.
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            table.append(2, "rolled-back", txn);
+            txn.rollback();
+        }
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            other.append(2, "z", txn);
+            table.append(2, "w", txn);
+            txn.commit();
+        }
+        std::vector<std::string> second;
+        second.push_back("x");
+        second.push_back("z");
+        second.push_back("w");
+        assert_vector_equal(table.find(2), second);
+    }
+
+    {
+        mdbxc::KeyOrderedMultiValueTable<int, int> table(conn, "ordered_window");
+        table.clear();
+        std::vector<int> items;
+        for (int i = 0; i < 100; ++i) {
+            items.push_back(i);
+        }
+        table.append_many(1, items.begin(), items.end());
+        table.append(2, 500);
+
+        std::vector<int> head;
+        head.push_back(10);
+        head.push_back(11);
+        head.push_back(12);
+        assert_vector_equal(table.find_window(1, 10, 3), head);
+        std::vector<int> latest;
+        latest.push_back(99);
+        latest.push_back(98);
+        assert_vector_equal(table.find_window(1, 0, 2, true), latest);
+        MDBXC_TEST_ASSERT(table.find_window(1, 98, 10).size() == 2u);
+        MDBXC_TEST_ASSERT(table.find_window(1, 100, 10).empty());
+        MDBXC_TEST_ASSERT(table.find_window(1, 0, 0).empty());
+        MDBXC_TEST_ASSERT(table.find_window(3, 0, 10).empty());
+
+        std::vector<int> pages;
+        std::vector<mdbxc::KeyOrderedMultiValueTable<int, int>::ordered_entry> page =
+            table.find_window_entries(1, 0, 30, true);
+        while (!page.empty()) {
+            for (std::size_t i = 0; i < page.size(); ++i) {
+                pages.push_back(page[i].second);
+            }
+            page = table.find_window_after(1, page.back().first, 30, true);
+        }
+        MDBXC_TEST_ASSERT(pages.size() == items.size());
+        for (std::size_t i = 0; i < pages.size(); ++i) {
+            MDBXC_TEST_ASSERT(pages[i] == items[items.size() - 1 - i]);
+        }
+
+        MDBXC_TEST_ASSERT(table.erase_at(1, 50u));
+        page = table.find_window_entries(1, 48, 2);
+        MDBXC_TEST_ASSERT(page.size() == 2u && page[1].second == 49);
+        page = table.find_window_after(1, page.back().first, 2);
+        MDBXC_TEST_ASSERT(page.size() == 2u && page[0].second == 51 && page[1].second == 52);
+        page = table.find_window_after(1, page.back().first + 1000, 2, true);
+        MDBXC_TEST_ASSERT(page.size() == 2u && page[0].second == 99);
+        MDBXC_TEST_ASSERT(table.find_window_after(1, 0, 5, true).empty());
+        MDBXC_TEST_ASSERT(table.find_window_after(2, 0, 5).empty());
+    }
+
     {
         mdbxc::KeyOrderedMultiValueTable<int, std::string> table(conn, "ordered_signed_keys");
         table.clear();
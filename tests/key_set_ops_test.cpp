@@ -0,0 +1,85 @@
+#include "test_assert.hpp"
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mdbx_containers/KeySetOps.hpp>
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/key_set_ops_test.mdbx";
+        cfg.max_dbs = 8;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+        mdbxc::KeyTable<std::uint64_t> evens(conn, "evens");
+        mdbxc::KeyTable<std::uint64_t> triples(conn, "triples");
+        mdbxc::KeyValueTable<std::uint64_t, std::string> named(conn, "named");
+        mdbxc::KeyTable<std::uint64_t> empty(conn, "empty");
+        evens.clear();
+        triples.clear();
+        named.clear();
+        empty.clear();
+
+        for (std::uint64_t i = 0; i <= 30; i += 2) evens.insert(i);
+        for (std::uint64_t i = 0; i <= 30; i += 3) triples.insert(i);
+        named.insert_or_assign(6, "six");
+        named.insert_or_assign(7, "seven");
+        named.insert_or_assign(24, "twenty-four");
+        named.insert_or_assign(1000, "thousand");
+
+        typedef std::vector<std::uint64_t> Keys;
+        MDBXC_TEST_ASSERT(mdbxc::intersect<std::uint64_t>({evens, triples}) ==
+                          (Keys{0, 6, 12, 18, 24, 30}));
+        MDBXC_TEST_ASSERT(mdbxc::intersect<std::uint64_t>({evens, triples, named}) ==
+                          (Keys{6, 24}));
+        MDBXC_TEST_ASSERT(mdbxc::intersect<std::uint64_t>({evens, empty}).empty());
+        MDBXC_TEST_ASSERT(mdbxc::intersect<std::uint64_t>({named}) ==
+                          (Keys{6, 7, 24, 1000}));
+
+        MDBXC_TEST_ASSERT(mdbxc::unite<std::uint64_t>({triples, named, empty}) ==
+                          (Keys{0, 3, 6, 7, 9, 12, 15, 18, 21, 24, 27, 30, 1000}));
+
+        MDBXC_TEST_ASSERT(mdbxc::difference<std::uint64_t>({named, evens}) ==
+                          (Keys{7, 1000}));
+        MDBXC_TEST_ASSERT(mdbxc::difference<std::uint64_t>({triples, evens, named}) ==
+                          (Keys{3, 9, 15, 21, 27}));
+        MDBXC_TEST_ASSERT(mdbxc::difference<std::uint64_t>({empty, evens}).empty());
+
+        // Early stop and an explicit transaction.
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            Keys seen;
+            const bool completed = mdbxc::for_each_union<std::uint64_t>(
+                {evens, triples},
+                [&seen](const std::uint64_t& key) {
+                    seen.push_back(key);
+                    return seen.size() < 3;
+                },
+                txn);
+            MDBXC_TEST_ASSERT(!completed);
+            MDBXC_TEST_ASSERT(seen == (Keys{0, 2, 3}));
+            MDBXC_TEST_ASSERT(mdbxc::intersect<std::uint64_t>({evens, named}, txn) ==
+                              (Keys{6, 24, 1000}));
+            txn.commit();
+        }
+
+        bool thrown = false;
+        try {
+            mdbxc::intersect<std::uint64_t>({});
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        MDBXC_TEST_ASSERT(thrown);
+    } catch (const std::exception& e) {
+        std::cerr << "Key set ops test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Key set ops test passed.\n";
+    return 0;
+}
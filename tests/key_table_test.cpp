@@ -10,7 +10,7 @@
 int main() {
     mdbxc::Config cfg;
     cfg.pathname = "data/key_table_test.mdbx";
-    cfg.max_dbs = 8;
+    cfg.max_dbs = 16;
     cfg.no_subdir = true;
     cfg.relative_to_exe = true;
 
@@ -140,6 +140,10 @@ int main() {
         MDBXC_TEST_ASSERT(!table.contains_range(10, 20));
         MDBXC_TEST_ASSERT(table.count_range(2, 4) == 3);
         MDBXC_TEST_ASSERT(table.count_range(10, 20) == 0);
+        MDBXC_TEST_ASSERT(table.estimate_count_range(2, 4) == 3);
+        MDBXC_TEST_ASSERT(table.estimate_count_range(10, 20) == 0);
+        MDBXC_TEST_ASSERT(table.estimate_bytes_range(10, 20) == 0);
+        MDBXC_TEST_ASSERT(table.estimate_bytes_range(1, 5) >= table.estimate_bytes_range(2, 4));
 
         std::size_t erased = table.erase_range(2, 4);
         MDBXC_TEST_ASSERT(erased == 3);
@@ -284,6 +288,74 @@ int main() {
 #endif
     }
 
+    {
+        mdbxc::KeyTable<int> table(conn, "bulk_load_sorted");
+        table.clear();
+        MDBXC_TEST_ASSERT(table.bulk_load_sorted(std::set<int>{-3, 1, 2}, mdbxc::BulkLoadMode::Strict));
+        MDBXC_TEST_ASSERT(table.bulk_load_sorted(std::vector<int>{5, 8}));
+        MDBXC_TEST_ASSERT(!table.bulk_load_sorted(std::vector<int>{9, 4, 8, 10}));
+        MDBXC_TEST_ASSERT(table.retrieve_all<std::vector>() ==
+                          (std::vector<int>{-3, 1, 2, 4, 5, 8, 9, 10}));
+
+        bool threw = false;
+        try {
+            table.bulk_load_sorted(std::vector<int>{11, 3}, mdbxc::BulkLoadMode::Strict);
+        } catch (const mdbxc::MdbxException&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+        MDBXC_TEST_ASSERT(!table.contains(11));
+    }
+
+    {
+        mdbxc::KeyTable<std::string> table(conn, "prefix_keys");
+        table.clear();
+        table.insert("tenant/a/1");
+        table.insert("tenant/a/2");
+        table.insert("tenant/ab");
+        table.insert("tenant/b/1");
+        table.insert("tenant");
+
+        std::vector<std::string> seen;
+        MDBXC_TEST_ASSERT(table.for_each_prefix("tenant/a", [&seen](const std::string& key) {
+            seen.push_back(key);
+            return true;
+        }));
+        MDBXC_TEST_ASSERT(seen == (std::vector<std::string>{"tenant/a/1", "tenant/a/2", "tenant/ab"}));
+        MDBXC_TEST_ASSERT(!table.for_each_prefix("tenant/", [](const std::string&) { return false; }));
+        MDBXC_TEST_ASSERT(table.count_prefix("tenant/a/") == 2);
+        MDBXC_TEST_ASSERT(table.count_prefix("tenant") == 5);
+        MDBXC_TEST_ASSERT(table.count_prefix("zzz") == 0);
+        MDBXC_TEST_ASSERT(table.count_prefix("") == 5);
+
+        MDBXC_TEST_ASSERT(table.erase_prefix("tenant/a/") == 2);
+        MDBXC_TEST_ASSERT(table.count() == 3);
+        MDBXC_TEST_ASSERT(table.contains("tenant/ab"));
+        MDBXC_TEST_ASSERT(table.erase_prefix("missing") == 0);
+    }
+
+    {
+        mdbxc::KeyTable<int> table(conn, "chunked_erase_keys");
+        table.clear();
+        for (int i = 0; i < 100; ++i) table.insert(i);
+        MDBXC_TEST_ASSERT(table.erase_range_chunked(20, 79, 7) == 60);
+        MDBXC_TEST_ASSERT(table.count() == 40);
+        MDBXC_TEST_ASSERT(table.contains(19) && table.contains(80) && !table.contains(50));
+    }
+
+    {
+        mdbxc::KeyTable<std::string> table(conn, "sorted_reconcile_keys");
+        table.clear();
+        table.insert("a");
+        table.insert("c");
+        table.insert("d");
+        std::set<std::string> source{"b", "c", "e"};
+        mdbxc::ReconcileProgress stats = table.reconcile_sorted(source.begin(), source.end(), 1);
+        MDBXC_TEST_ASSERT(stats.inserted == 2 && stats.erased == 2 && stats.updated == 0);
+        MDBXC_TEST_ASSERT(stats.chunks == 4);
+        MDBXC_TEST_ASSERT(table.range<std::vector>("a", "z") == (std::vector<std::string>{"b", "c", "e"}));
+    }
+
     std::cout << "KeyTable test passed.\n";
     return 0;
 }
@@ -10,6 +10,7 @@
 #include <deque>
 #include <list>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 #include <cstring>
 #include <bitset>
@@ -18,6 +19,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <new>
 #include <cmath>
 
 #include <mdbx_containers/KeyValueTable.hpp>
@@ -173,6 +175,49 @@ void assert_unsigned_key_table(
 }
 
 // ---- sample serializable structs ----
+struct ReservedBlob {
+    std::vector<uint32_t> words;
+
+    std::size_t serialized_size() const { return words.size() * sizeof(uint32_t); }
+    void write_bytes(void* dst) const {
+        if (!words.empty()) std::memcpy(dst, words.data(), serialized_size());
+    }
+    static ReservedBlob from_bytes(const void* data, size_t size) {
+        ReservedBlob out;
+        out.words.resize(size / sizeof(uint32_t));
+        if (size) std::memcpy(out.words.data(), data, size);
+        return out;
+    }
+    bool operator==(const ReservedBlob& other) const { return words == other.words; }
+};
+
+/// Trivially copyable with padding; the serializer stores 12 packed bytes.
+struct PackedPrice {
+    int64_t price;
+    int32_t volume;
+    bool operator==(const PackedPrice& other) const {
+        return price == other.price && volume == other.volume;
+    }
+};
+
+namespace mdbxc {
+template<>
+struct serializer<PackedPrice> {
+    static std::size_t size(const PackedPrice&) { return sizeof(int64_t) + sizeof(int32_t); }
+    static void write(const PackedPrice& v, uint8_t* out) {
+        std::memcpy(out, &v.price, sizeof(int64_t));
+        std::memcpy(out + sizeof(int64_t), &v.volume, sizeof(int32_t));
+    }
+    static PackedPrice read(const uint8_t* data, std::size_t size) {
+        if (size != sizeof(int64_t) + sizeof(int32_t)) throw std::runtime_error("Invalid PackedPrice size");
+        PackedPrice v;
+        std::memcpy(&v.price, data, sizeof(int64_t));
+        std::memcpy(&v.volume, data + sizeof(int64_t), sizeof(int32_t));
+        return v;
+    }
+};
+} // namespace mdbxc
+
 struct SimpleStruct {
     int   x{};
     float y{};
@@ -798,6 +843,9 @@ int main() {
         // contains_range / count_range / erase_range
         MDBXC_TEST_ASSERT(kv.contains_range(2, 4));
         MDBXC_TEST_ASSERT(kv.count_range(2, 4) == 3);
+        MDBXC_TEST_ASSERT(kv.estimate_count_range(2, 4) == 3);
+        MDBXC_TEST_ASSERT(kv.estimate_count_range(4, 2) == 0);
+        MDBXC_TEST_ASSERT(kv.estimate_bytes_range(2, 4) > 0);
         std::size_t erased = kv.erase_range(2, 4);
         MDBXC_TEST_ASSERT(erased == 3);
         MDBXC_TEST_ASSERT(kv.count() == 2);
@@ -828,6 +876,18 @@ int main() {
         MDBXC_TEST_ASSERT(update_threw);
         ASSERT_FOUND(kv, 1, std::string("ONE"));
 
+        // update_bytes patches the stored bytes without a serialize round trip
+        MDBXC_TEST_ASSERT(kv.update_bytes(1, [](mdbxc::MutableByteView& bytes) {
+            MDBXC_TEST_ASSERT(bytes.size == 3);
+            static_cast<char*>(bytes.data)[2] = 'e';
+        }));
+        ASSERT_FOUND(kv, 1, std::string("ONe"));
+        MDBXC_TEST_ASSERT(kv.update_bytes(1, [](mdbxc::MutableByteView& bytes) {
+            static_cast<char*>(bytes.data)[2] = 'E';
+        }));
+        ASSERT_FOUND(kv, 1, std::string("ONE"));
+        MDBXC_TEST_ASSERT(!kv.update_bytes(99, [](mdbxc::MutableByteView&) {}));
+
         // find_many
         kv.insert_or_assign(2, "two");
         kv.insert_or_assign(3, "three");
@@ -931,6 +991,612 @@ int main() {
 #endif
     }
 
+    std::cout << "[case] find_view\n";
+    {
+        mdbxc::KeyValueTable<int, std::string> kv(conn, "kv_find_view");
+        kv.clear();
+        kv.insert_or_assign(1, "payload");
+
+        std::string seen;
+        bool found = kv.find_view(1, [&seen](const mdbxc::ByteView& view) {
+            seen.assign(static_cast<const char*>(view.data), view.size);
+        });
+        MDBXC_TEST_ASSERT(found);
+        MDBXC_TEST_ASSERT(seen == "payload");
+
+        bool called = false;
+        found = kv.find_view(2, [&called](const mdbxc::ByteView&) {
+            called = true;
+        });
+        MDBXC_TEST_ASSERT(!found);
+        MDBXC_TEST_ASSERT(!called);
+
+        kv.insert_or_assign(3, std::string());
+        std::size_t empty_size = 1;
+        mdbxc::Transaction read_txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+        found = kv.find_view(3, [&empty_size](const mdbxc::ByteView& view) {
+            empty_size = view.size;
+        }, read_txn);
+        read_txn.commit();
+        MDBXC_TEST_ASSERT(found);
+        MDBXC_TEST_ASSERT(empty_size == 0);
+    }
+
+    std::cout << "[case] cursor iterators\n";
+    {
+        typedef mdbxc::KeyValueTable<int, std::string> Table;
+        Table kv(conn, "kv_cursor_iter");
+        kv.clear();
+        kv.insert_or_assign(10, "a");
+        kv.insert_or_assign(20, "b");
+        kv.insert_or_assign(30, "c");
+
+        mdbxc::Transaction read_txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+        std::vector<int> keys;
+        for (Table::const_iterator it = kv.iter_begin(read_txn), end = kv.iter_end(read_txn);
+             it != end; ++it) {
+            keys.push_back(it->first);
+        }
+        MDBXC_TEST_ASSERT((keys == std::vector<int>{10, 20, 30}));
+
+        Table::const_iterator lb = kv.iter_lower_bound(15, read_txn);
+        MDBXC_TEST_ASSERT(lb != Table::const_iterator());
+        MDBXC_TEST_ASSERT(lb->first == 20 && lb->second == "b");
+        Table::const_iterator copy = lb;
+        ++lb;
+        MDBXC_TEST_ASSERT(lb->first == 30);
+        MDBXC_TEST_ASSERT(copy->first == 20);
+        --lb;
+        MDBXC_TEST_ASSERT(lb == copy);
+
+        Table::const_iterator ub = kv.iter_upper_bound(20, read_txn);
+        MDBXC_TEST_ASSERT(ub->first == 30);
+        MDBXC_TEST_ASSERT(++ub == kv.iter_end(read_txn));
+        MDBXC_TEST_ASSERT(kv.iter_upper_bound(30, read_txn) == Table::const_iterator());
+
+        Table::const_iterator back = kv.iter_end(read_txn);
+        --back;
+        MDBXC_TEST_ASSERT((*back == Table::value_type(30, "c")));
+
+        bool threw = false;
+        try {
+            ++back;
+            ++back;
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+        read_txn.commit();
+
+        threw = false;
+        try {
+            (void)kv.iter_begin();
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+
+        Table empty(conn, "kv_cursor_iter_empty");
+        empty.clear();
+        mdbxc::Transaction empty_txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+        MDBXC_TEST_ASSERT(empty.iter_begin(empty_txn) == empty.iter_end(empty_txn));
+        empty_txn.commit();
+    }
+
+    std::cout << "[case] find_many_batch\n";
+    {
+        mdbxc::KeyValueTable<int, std::string> kv(conn, "kv_find_many_batch");
+        kv.clear();
+        for (int i = 0; i < 100; i += 2) {
+            kv.insert_or_assign(i, "v" + std::to_string(i));
+        }
+        const std::vector<int> keys{42, 7, 0, 98, 42, 200, 44, -1, 43};
+
+        std::vector<std::pair<bool, std::string>> compat;
+        std::size_t found = kv.find_many_batch_compat(keys, compat);
+        MDBXC_TEST_ASSERT(found == 5);
+        MDBXC_TEST_ASSERT(compat.size() == keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            const bool expected = keys[i] >= 0 && keys[i] < 100 && keys[i] % 2 == 0;
+            MDBXC_TEST_ASSERT(compat[i].first == expected);
+            if (expected) {
+                MDBXC_TEST_ASSERT(compat[i].second == "v" + std::to_string(keys[i]));
+            }
+        }
+
+#if __cplusplus >= 201703L
+        std::vector<std::optional<std::string>> out{std::string("stale")};
+        found = kv.find_many_batch(keys, out);
+        MDBXC_TEST_ASSERT(found == 5);
+        MDBXC_TEST_ASSERT(out.size() == keys.size());
+        MDBXC_TEST_ASSERT(out[0] && *out[0] == "v42");
+        MDBXC_TEST_ASSERT(!out[1]);
+        MDBXC_TEST_ASSERT(out[4] && *out[4] == "v42");
+        MDBXC_TEST_ASSERT(!out[5] && !out[7] && !out[8]);
+
+        found = kv.find_many_batch(std::vector<int>(), out);
+        MDBXC_TEST_ASSERT(found == 0 && out.empty());
+#endif
+    }
+
+    std::cout << "[case] bulk_load_sorted\n";
+    {
+        mdbxc::KeyValueTable<int, std::string> kv(conn, "kv_bulk_load_sorted");
+        kv.clear();
+        std::map<int, std::string> snapshot;
+        snapshot[1] = "a";
+        snapshot[2] = "b";
+        MDBXC_TEST_ASSERT(kv.bulk_load_sorted(snapshot, mdbxc::BulkLoadMode::Strict));
+
+        std::vector<std::pair<int, std::string>> tail;
+        tail.push_back(std::make_pair(3, std::string("c")));
+        tail.push_back(std::make_pair(1, std::string("A")));
+        MDBXC_TEST_ASSERT(!kv.bulk_load_sorted(tail));
+        MDBXC_TEST_ASSERT(kv.at(1) == "A");
+        MDBXC_TEST_ASSERT(kv.at(3) == "c");
+        MDBXC_TEST_ASSERT(kv.count() == 3);
+
+        bool threw = false;
+        try {
+            mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            kv.bulk_load_sorted(tail, mdbxc::BulkLoadMode::Strict, txn);
+        } catch (const mdbxc::MdbxException& ex) {
+            threw = ex.error_code() == MDBX_EKEYMISMATCH;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    std::cout << "[case] reserved value writes\n";
+    {
+        mdbxc::KeyValueTable<int, ReservedBlob> blobs(conn, "kv_reserved_blob");
+        blobs.clear();
+        ReservedBlob big;
+        for (uint32_t i = 0; i < 32768; ++i) big.words.push_back(i * 2654435761u);
+        blobs.insert_or_assign(1, big);
+        MDBXC_TEST_ASSERT(blobs.insert(2, ReservedBlob()));
+        MDBXC_TEST_ASSERT(!blobs.insert(1, ReservedBlob()));
+        MDBXC_TEST_ASSERT(blobs.at(1) == big);
+        MDBXC_TEST_ASSERT(blobs.at(2).words.empty());
+
+        mdbxc::KeyValueTable<int, std::list<std::string>> lists(conn, "kv_reserved_strings");
+        lists.clear();
+        std::map<int, std::list<std::string>> src;
+        src[1] = std::list<std::string>{"alpha", "", "gamma"};
+        src[2] = std::list<std::string>();
+        lists.append(src);
+        MDBXC_TEST_ASSERT(lists.at(1) == src[1]);
+        MDBXC_TEST_ASSERT(lists.at(2).empty());
+
+        mdbxc::KeyValueTable<int, std::deque<double>> deques(conn, "kv_reserved_deque");
+        deques.clear();
+        deques.insert_or_assign(7, std::deque<double>{1.5, -2.25, 3.0});
+        MDBXC_TEST_ASSERT((deques.at(7) == std::deque<double>{1.5, -2.25, 3.0}));
+
+        static_assert(mdbxc::has_serializer<PackedPrice>::value, "serializer specialization not detected");
+        static_assert(mdbxc::is_reserved_value<PackedPrice>::value, "serializer values use MDBX_RESERVE");
+        mdbxc::KeyValueTable<int, PackedPrice> prices(conn, "kv_serializer_trait");
+        prices.clear();
+        const PackedPrice tick = {1234567890123LL, -42};
+        prices.insert_or_assign(1, tick);
+        MDBXC_TEST_ASSERT(prices.at(1) == tick);
+        mdbxc::SerializeScratch price_sc;
+        MDBXC_TEST_ASSERT(mdbxc::serialize_value(tick, price_sc).iov_len == sizeof(int64_t) + sizeof(int32_t));
+    }
+
+    std::cout << "[case] by-reference raw value reads\n";
+    {
+        struct PriceRecord {
+            int64_t price;
+            int64_t volume;
+        };
+        mdbxc::KeyValueTable<uint64_t, PriceRecord, mdbxc::FastIntegerKeyOptions> ticks(conn, "kv_value_refs");
+        ticks.clear();
+        for (uint64_t i = 1; i <= 200; ++i) {
+            const PriceRecord rec = {static_cast<int64_t>(i * 100), static_cast<int64_t>(i)};
+            ticks.insert_or_assign(i, rec);
+        }
+        int64_t volume = 0;
+        MDBXC_TEST_ASSERT(ticks.for_each_range_ref(10, 20, [&volume](const uint64_t& key, const PriceRecord& rec) -> bool {
+            MDBXC_TEST_ASSERT(rec.price == static_cast<int64_t>(key * 100));
+            volume += rec.volume;
+            return true;
+        }));
+        MDBXC_TEST_ASSERT(volume == 165);
+        std::size_t visited = 0;
+        MDBXC_TEST_ASSERT(!ticks.for_each_range_ref(1, 200, [&visited](const uint64_t&, const PriceRecord&) -> bool {
+            return ++visited < 3;
+        }));
+        MDBXC_TEST_ASSERT(visited == 3);
+
+        int64_t price = 0;
+        MDBXC_TEST_ASSERT(ticks.find_ref(42, [&price](const PriceRecord& rec) { price = rec.price; }));
+        MDBXC_TEST_ASSERT(price == 4200);
+        MDBXC_TEST_ASSERT(!ticks.find_ref(1000, [](const PriceRecord&) {}));
+    }
+
+    std::cout << "[case] cached cursor reuse\n";
+    {
+        mdbxc::KeyValueTable<int, int> kv(conn, "kv_cached_cursor");
+        kv.clear();
+        for (int i = 0; i < 64; ++i) kv.insert_or_assign(i * 2, i);
+
+        {
+            // Many cursor helpers in one transaction reuse the cached cursor.
+            mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            std::size_t hits = 0;
+            for (int round = 0; round < 500; ++round) {
+                const int from = round % 128; // keys are 0, 2, ..., 126
+                hits += kv.count_range(from, from + 1, txn);
+                if (kv.contains_range(from, from, txn)) ++hits;
+            }
+            MDBXC_TEST_ASSERT(hits == 747);
+        }
+
+        // A new transaction rebinds the cursor; writes go through it too.
+        MDBXC_TEST_ASSERT(kv.erase_range(0, 9) == 5);
+        MDBXC_TEST_ASSERT(kv.count_range(0, 20) == 6);
+        MDBXC_TEST_ASSERT(!kv.contains_range(0, 9));
+        std::vector<std::pair<int, int>> all;
+        kv.load(all);
+        MDBXC_TEST_ASSERT(all.size() == 59);
+        MDBXC_TEST_ASSERT(all.front().first == 10);
+
+        // Copies start with their own cursor slot; moves take the idle cursor.
+        mdbxc::KeyValueTable<int, int> copy(kv);
+        MDBXC_TEST_ASSERT(copy.count_range(0, 20) == 6);
+        mdbxc::KeyValueTable<int, int> moved(std::move(copy));
+        MDBXC_TEST_ASSERT(moved.count_range(0, 20) == 6);
+        copy = kv;
+        MDBXC_TEST_ASSERT(copy.count_range(0, 20) == 6 && kv.count_range(0, 20) == 6);
+    }
+
+    std::cout << "[case] parallel_for_each_range\n";
+    {
+        mdbxc::KeyValueTable<int, int> kv(conn, "kv_parallel_scan");
+        kv.clear();
+        for (int i = -500; i < 500; ++i) kv.insert_or_assign(i, i * 3);
+
+        std::mutex mtx;
+        std::set<int> seen;
+        std::atomic<long long> sum(0);
+        MDBXC_TEST_ASSERT(kv.parallel_for_each_range(-400, 399, 4, [&sum, &mtx, &seen](const int& k, const int& v) {
+            MDBXC_TEST_ASSERT(v == k * 3);
+            sum += v;
+            std::lock_guard<std::mutex> lock(mtx);
+            seen.insert(k);
+            return true;
+        }));
+        MDBXC_TEST_ASSERT(seen.size() == 800);
+        MDBXC_TEST_ASSERT(*seen.begin() == -400 && *seen.rbegin() == 399);
+        MDBXC_TEST_ASSERT(sum.load() == -1200);
+
+        // Early stop halts every worker.
+        std::atomic<int> visited(0);
+        MDBXC_TEST_ASSERT(!kv.parallel_for_each_range(-500, 499, 4, [&visited](const int&, const int&) {
+            return ++visited < 10;
+        }));
+        MDBXC_TEST_ASSERT(visited.load() < 1000);
+
+        // Worker exceptions propagate to the caller.
+        bool thrown = false;
+        try {
+            kv.parallel_for_each_range(-500, 499, 3, [](const int& k, const int&) -> bool {
+                if (k == 123) throw std::runtime_error("stop");
+                return true;
+            });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        MDBXC_TEST_ASSERT(thrown);
+
+        // Non-integral keys fall back to a serial scan.
+        mdbxc::KeyValueTable<std::string, int> skv(conn, "kv_parallel_scan_str");
+        skv.clear();
+        skv.insert_or_assign("a", 1);
+        skv.insert_or_assign("b", 2);
+        skv.insert_or_assign("c", 3);
+        int total = 0;
+        MDBXC_TEST_ASSERT(skv.parallel_for_each_range("a", "b", 4, [&total](const std::string&, const int& v) {
+            total += v;
+            return true;
+        }));
+        MDBXC_TEST_ASSERT(total == 3);
+    }
+
+    std::cout << "[case] parallel_load\n";
+    {
+        mdbxc::KeyValueTable<std::string, std::string> kv(conn, "kv_parallel_load");
+        kv.clear();
+        std::map<std::string, std::string> expected;
+        for (int i = 0; i < 20000; ++i) {
+            const std::string key = "k" + std::to_string(i);
+            kv.insert_or_assign(key, "value-" + std::to_string(i * 7));
+            expected[key] = "value-" + std::to_string(i * 7);
+        }
+
+        // Pairs keep key order across worker batches.
+        const std::vector<std::pair<std::string, std::string>> ordered(expected.begin(), expected.end());
+        std::vector<std::pair<std::string, std::string>> pairs;
+        kv.parallel_load(pairs, 4);
+        MDBXC_TEST_ASSERT(pairs == ordered);
+
+        std::unordered_map<std::string, std::string> by_key;
+        kv.parallel_load(by_key, 0);
+        MDBXC_TEST_ASSERT(by_key.size() == expected.size());
+        MDBXC_TEST_ASSERT(by_key["k123"] == "value-861");
+
+        std::vector<std::pair<std::string, std::string>> serial;
+        kv.parallel_load(serial, 1);
+        MDBXC_TEST_ASSERT(serial == pairs);
+    }
+
+    std::cout << "[case] *_into caller containers\n";
+    {
+        mdbxc::KeyValueTable<std::string, std::string> kv(conn, "kv_into");
+        kv.clear();
+        for (int i = 0; i < 10; ++i) {
+            kv.insert_or_assign("k" + std::to_string(i), "value-" + std::to_string(i));
+        }
+
+        std::vector<std::pair<std::string, std::string>> pairs;
+        kv.range_into("k2", "k4", pairs);
+        MDBXC_TEST_ASSERT(pairs.size() == 3 && pairs.front().first == "k2" && pairs.back().second == "value-4");
+        std::map<std::string, std::string> all;
+        kv.load_into(all);
+        MDBXC_TEST_ASSERT(all.size() == 10 && all["k7"] == "value-7");
+        std::vector<std::string> keys;
+        keys.push_back("k9");
+        keys.push_back("missing");
+        keys.push_back("k0");
+        pairs.clear();
+        MDBXC_TEST_ASSERT(kv.find_many_into(keys, pairs) == 2);
+        MDBXC_TEST_ASSERT(pairs[0].first == "k9" && pairs[1].second == "value-0");
+
+#if MDBXC_HAS_PMR
+        // Strings are copied straight from the page into the arena.
+        char buffer[16384];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        std::pmr::vector<std::pair<std::pmr::string, std::pmr::string>> pmr_pairs(&arena);
+        {
+            mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            kv.range_into("k0", "k9", pmr_pairs, txn);
+            kv.find_many_into(keys, pmr_pairs, txn);
+            txn.commit();
+        }
+        MDBXC_TEST_ASSERT(pmr_pairs.size() == 12);
+        MDBXC_TEST_ASSERT(pmr_pairs[3].first == "k3" && pmr_pairs[3].second == "value-3");
+        MDBXC_TEST_ASSERT(pmr_pairs[3].second.get_allocator().resource() == &arena);
+        std::pmr::map<std::pmr::string, std::pmr::string> pmr_map(&arena);
+        kv.load_into(pmr_map);
+        MDBXC_TEST_ASSERT(pmr_map.size() == 10 && pmr_map.begin()->second == "value-0");
+#endif
+    }
+
+    std::cout << "[case] scan_range key filter and projection\n";
+    {
+        mdbxc::KeyValueTable<int, std::string> kv(conn, "kv_scan_range");
+        kv.clear();
+        for (int i = 0; i < 100; ++i) kv.insert_or_assign(i, "v" + std::to_string(i));
+
+        std::vector<std::string> values;
+        std::size_t n = kv.scan_range(0, 99,
+            [](const int& k) { return k % 10 == 3; },
+            [&values](const int&, const std::string& v) { values.push_back(v); return true; });
+        MDBXC_TEST_ASSERT(n == 10);
+        MDBXC_TEST_ASSERT(values.size() == 10 && values.front() == "v3" && values.back() == "v93");
+
+        // limit and early stop
+        values.clear();
+        n = kv.scan_range(0, 99, [](const int& k) { return k >= 50; },
+            [&values](const int&, const std::string& v) { values.push_back(v); return true; }, 3);
+        MDBXC_TEST_ASSERT(n == 3 && values.back() == "v52");
+        n = kv.scan_range(0, 99, [](const int&) { return true; },
+            [](const int& k, const std::string&) { return k < 4; });
+        MDBXC_TEST_ASSERT(n == 5);
+        MDBXC_TEST_ASSERT(kv.scan_range(0, 99, [](const int&) { return true; },
+            [](const int&, const std::string&) { return true; }, 0) == 0);
+
+        // raw value predicate sees serialized bytes before deserialization
+        std::vector<int> keys;
+        n = kv.scan_range_view(0, 99, [](const int&) { return true; },
+            [](const int&, const mdbxc::ByteView& view) { return view.size == 3; },
+            [&keys](const int& k, const std::string&) { keys.push_back(k); return true; });
+        MDBXC_TEST_ASSERT(n == 90 && keys.front() == 10);
+
+        // key-only mode inside an explicit transaction
+        {
+            mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            int sum = 0;
+            n = kv.scan_keys_range(10, 19, [](const int& k) { return k % 2 == 0; },
+                [&sum](const int& k) { sum += k; return true; },
+                mdbxc::KeyValueTable<int, std::string>::no_limit, txn);
+            MDBXC_TEST_ASSERT(n == 5 && sum == 70);
+        }
+        MDBXC_TEST_ASSERT(kv.scan_keys_range(20, 10, [](const int&) { return true; },
+            [](const int&) { return true; }) == 0);
+    }
+
+    std::cout << "[case] prefix scans\n";
+    {
+        mdbxc::KeyValueTable<std::string, int> kv(conn, "kv_prefix_scan");
+        kv.clear();
+        kv.insert_or_assign("tenant/a/1", 1);
+        kv.insert_or_assign("tenant/a/2", 2);
+        kv.insert_or_assign("tenant/b/1", 3);
+        kv.insert_or_assign("tenant/c", 4);
+        kv.insert_or_assign("other", 5);
+
+        int sum = 0;
+        MDBXC_TEST_ASSERT(kv.for_each_prefix("tenant/a/", [&sum](const std::string&, const int& v) {
+            sum += v;
+            return true;
+        }));
+        MDBXC_TEST_ASSERT(sum == 3);
+        MDBXC_TEST_ASSERT(kv.count_prefix("tenant/") == 4);
+        MDBXC_TEST_ASSERT(kv.count_prefix("tenant/d") == 0);
+
+        {
+            mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            MDBXC_TEST_ASSERT(kv.erase_prefix("tenant/", txn) == 4);
+            MDBXC_TEST_ASSERT(kv.count_prefix("", txn) == 1);
+            txn.commit();
+        }
+        MDBXC_TEST_ASSERT(kv.count() == 1);
+
+        mdbxc::KeyValueTable<std::vector<uint8_t>, int> bytes(conn, "kv_prefix_scan_bytes");
+        bytes.clear();
+        bytes.insert_or_assign(std::vector<uint8_t>{1, 2, 3}, 1);
+        bytes.insert_or_assign(std::vector<uint8_t>{1, 2}, 2);
+        bytes.insert_or_assign(std::vector<uint8_t>{1, 3}, 3);
+        MDBXC_TEST_ASSERT(bytes.count_prefix(std::vector<uint8_t>{1, 2}) == 2);
+    }
+
+    std::cout << "[case] erase_range_chunked\n";
+    {
+        mdbxc::KeyValueTable<int, int> kv(conn, "kv_erase_chunked");
+        kv.clear();
+        for (int i = 0; i < 250; ++i) kv.insert_or_assign(i, i);
+
+        MDBXC_TEST_ASSERT(kv.erase_range_chunked(10, 209, 64) == 200);
+        MDBXC_TEST_ASSERT(kv.count() == 50);
+        MDBXC_TEST_ASSERT(kv.count_range(0, 9) == 10);
+        MDBXC_TEST_ASSERT(kv.count_range(210, 249) == 40);
+        MDBXC_TEST_ASSERT(kv.erase_range_chunked(0, 9, 5) == 10); // exact multiple
+        MDBXC_TEST_ASSERT(kv.erase_range_chunked(0, 9, 5) == 0);
+
+        bool threw = false;
+        try {
+            kv.erase_range_chunked(0, 1, 0);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+
+        threw = false;
+        {
+            mdbxc::Transaction txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            try {
+                kv.erase_range_chunked(210, 249, 8);
+            } catch (const std::logic_error&) {
+                threw = true;
+            }
+            txn.rollback();
+        }
+        MDBXC_TEST_ASSERT(threw);
+        MDBXC_TEST_ASSERT(kv.count() == 40);
+    }
+
+    std::cout << "[case] reconcile_sorted\n";
+    {
+        mdbxc::KeyValueTable<int, std::string> kv(conn, "kv_reconcile_sorted");
+        kv.clear();
+        for (int i = 0; i < 20; ++i) kv.insert_or_assign(i, "old");
+
+        // Keep even keys (odd ones are erased), change 0..9, add 20..24.
+        std::map<int, std::string> source;
+        for (int i = 0; i < 25; i += 2) source[i] = i < 10 ? "new" : "old";
+        for (int i = 21; i < 25; i += 2) source[i] = "new";
+
+        std::size_t reports = 0;
+        std::size_t last_chunks = 0;
+        mdbxc::ReconcileProgress stats = kv.reconcile_sorted(source.begin(), source.end(), 3,
+            [&reports, &last_chunks](const mdbxc::ReconcileProgress& p) {
+                ++reports;
+                MDBXC_TEST_ASSERT(p.chunks == last_chunks + 1);
+                last_chunks = p.chunks;
+            });
+        MDBXC_TEST_ASSERT(stats.erased == 10);
+        MDBXC_TEST_ASSERT(stats.updated == 5);
+        MDBXC_TEST_ASSERT(stats.inserted == 5);
+        MDBXC_TEST_ASSERT(stats.scanned == source.size());
+        MDBXC_TEST_ASSERT(reports == stats.chunks && stats.chunks >= 7);
+
+        std::vector<std::pair<int, std::string>> all;
+        kv.load(all);
+        MDBXC_TEST_ASSERT(all.size() == source.size());
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            MDBXC_TEST_ASSERT(source[all[i].first] == all[i].second);
+        }
+
+        // A second pass over identical input changes nothing.
+        stats = kv.reconcile_sorted(source.begin(), source.end(), 3);
+        MDBXC_TEST_ASSERT(stats.inserted == 0 && stats.updated == 0 && stats.erased == 0);
+        MDBXC_TEST_ASSERT(stats.chunks == 1);
+
+        // Empty input erases everything; unsorted input is rejected.
+        std::vector<std::pair<int, std::string>> unsorted;
+        unsorted.push_back(std::make_pair(5, std::string("a")));
+        unsorted.push_back(std::make_pair(3, std::string("b")));
+        bool threw = false;
+        try {
+            kv.reconcile_sorted(unsorted.begin(), unsorted.end(), 100);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+        MDBXC_TEST_ASSERT(kv.count() == source.size());
+        stats = kv.reconcile_sorted(unsorted.end(), unsorted.end(), 4);
+        MDBXC_TEST_ASSERT(stats.erased == source.size() && kv.count() == 0);
+    }
+
+    std::cout << "[case] nothrow status overloads\n";
+    {
+        mdbxc::KeyValueTable<int, std::string> kv(conn, "nothrow_status");
+        kv.clear();
+
+        mdbxc::Status st = kv.insert(std::nothrow, 1, std::string("one"));
+        MDBXC_TEST_ASSERT(st.ok() && st.code() == mdbxc::StatusCode::Ok);
+        st = kv.insert(std::nothrow, 1, std::string("uno"));
+        MDBXC_TEST_ASSERT(st.code() == mdbxc::StatusCode::KeyExists);
+        MDBXC_TEST_ASSERT(!st.exception());
+
+        mdbxc::Result<std::string> found = kv.find(std::nothrow, 1);
+        MDBXC_TEST_ASSERT(found.ok() && found.value() == "one");
+        found = kv.find(std::nothrow, 2);
+        MDBXC_TEST_ASSERT(found.status().code() == mdbxc::StatusCode::NotFound);
+        MDBXC_TEST_ASSERT(found.status().message() == "not found");
+
+        // A write through a read-only transaction fails with an MDBX code,
+        // returned without throwing; the throwing overload raises the same code.
+        {
+            auto ro = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            st = kv.insert(std::nothrow, 3, std::string("three"), ro);
+            MDBXC_TEST_ASSERT(st.code() == mdbxc::StatusCode::MdbxError);
+            MDBXC_TEST_ASSERT(st.mdbx_error() != 0 && !st.exception());
+            MDBXC_TEST_ASSERT(!st.message().empty());
+            bool threw = false;
+            try {
+                kv.insert(3, std::string("three"), ro);
+            } catch (const mdbxc::MdbxException& e) {
+                threw = e.error_code() == st.mdbx_error();
+            }
+            MDBXC_TEST_ASSERT(threw);
+            ro.rollback();
+        }
+
+        // Misuse of the connection keeps its exception type in the status.
+        {
+            auto rw = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            mdbxc::Status begun;
+            mdbxc::Transaction nested =
+                conn->transaction(std::nothrow, mdbxc::TransactionMode::WRITABLE, begun);
+            MDBXC_TEST_ASSERT(begun.code() == mdbxc::StatusCode::Error);
+            MDBXC_TEST_ASSERT(begun.exception() && !nested.handle());
+            bool logic = false;
+            try {
+                mdbxc::check_status(begun);
+            } catch (const std::logic_error&) {
+                logic = true;
+            }
+            MDBXC_TEST_ASSERT(logic);
+            rw.rollback();
+        }
+
+        MDBXC_TEST_ASSERT(kv.erase(std::nothrow, 1).ok());
+        MDBXC_TEST_ASSERT(kv.erase(std::nothrow, 1).code() == mdbxc::StatusCode::NotFound);
+        MDBXC_TEST_ASSERT(kv.count() == 0);
+    }
+
     std::cout << "[result] all tests passed\n";
     return 0;
 }
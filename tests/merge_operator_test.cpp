@@ -0,0 +1,139 @@
+#include "test_assert.hpp"
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mdbx_containers/KeyValueTable.hpp>
+
+namespace {
+
+std::vector<std::uint8_t> merge_bytes(const mdbxc::MergeOperator& op,
+                                      const void* stored, std::size_t stored_size, bool exists,
+                                      const void* operand, std::size_t operand_size) {
+    std::vector<std::uint8_t> out;
+    op.apply(stored, stored_size, exists, operand, operand_size, out);
+    return out;
+}
+
+void test_operator_bytes() {
+    const mdbxc::MergeOperator add = mdbxc::make_merge_operator<std::uint8_t>(mdbxc::MergeKind::AddInteger);
+    const std::uint8_t a = 250, b = 10;
+    std::vector<std::uint8_t> out = merge_bytes(add, &a, 1, true, &b, 1);
+    MDBXC_TEST_ASSERT(out.size() == 1 && out[0] == 4);
+
+    const mdbxc::MergeOperator max = mdbxc::make_merge_operator<std::int32_t>(mdbxc::MergeKind::Max);
+    const std::int32_t neg = -7, pos = 3;
+    out = merge_bytes(max, &neg, 4, true, &pos, 4);
+    std::int32_t r = 0;
+    std::memcpy(&r, out.data(), 4);
+    MDBXC_TEST_ASSERT(r == 3);
+
+    std::uint8_t encoded[mdbxc::MergeOperator::encoded_size];
+    max.encode(encoded);
+    mdbxc::MergeOperator decoded;
+    MDBXC_TEST_ASSERT(mdbxc::MergeOperator::decode(encoded, sizeof(encoded), decoded));
+    MDBXC_TEST_ASSERT(decoded.kind == mdbxc::MergeKind::Max);
+    MDBXC_TEST_ASSERT(decoded.element_size == 4 && decoded.is_signed);
+    encoded[1] = 3;
+    MDBXC_TEST_ASSERT(!mdbxc::MergeOperator::decode(encoded, sizeof(encoded), decoded));
+
+    bool threw = false;
+    try {
+        out = merge_bytes(max, &neg, 2, true, &pos, 4);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    MDBXC_TEST_ASSERT(threw);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_operator_bytes();
+
+        mdbxc::Config cfg;
+        cfg.pathname = "data/merge_operator_test.mdbx";
+        cfg.max_dbs = 8;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+
+        mdbxc::KeyValueTable<std::string, std::int64_t> counters(conn, "merge_counters");
+        counters.clear();
+        bool threw = false;
+        try {
+            counters.merge("a", 1);
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+
+        counters.set_merge_operator(mdbxc::MergeKind::AddInteger);
+        MDBXC_TEST_ASSERT(counters.has_merge_operator());
+        counters.merge("a", 5);
+        counters.merge("a", -2);
+        {
+            auto txn = conn->transaction();
+            for (int i = 0; i < 10; ++i) counters.merge("b", 1, txn);
+            txn.commit();
+        }
+        MDBXC_TEST_ASSERT(counters.at("a") == 3);
+        MDBXC_TEST_ASSERT(counters.at("b") == 10);
+
+        mdbxc::KeyValueTable<int, std::uint16_t> peaks(conn, "merge_peaks");
+        peaks.clear();
+        peaks.set_merge_operator(mdbxc::MergeKind::Max);
+        peaks.merge(1, 40);
+        peaks.merge(1, 12);
+        peaks.merge(1, 90);
+        MDBXC_TEST_ASSERT(peaks.at(1) == 90);
+
+        mdbxc::KeyValueTable<int, std::int32_t> lows(conn, "merge_lows");
+        lows.clear();
+        lows.set_merge_operator(mdbxc::MergeKind::Min);
+        lows.merge(1, 4);
+        lows.merge(1, -8);
+        lows.merge(1, 0);
+        MDBXC_TEST_ASSERT(lows.at(1) == -8);
+
+        mdbxc::KeyValueTable<int, std::vector<std::uint32_t>> events(conn, "merge_events");
+        events.clear();
+        events.set_merge_operator(mdbxc::MergeKind::Append);
+        events.merge(1, std::vector<std::uint32_t>{1, 2});
+        events.merge(1, std::vector<std::uint32_t>{2});
+        MDBXC_TEST_ASSERT(events.at(1) == std::vector<std::uint32_t>({1, 2, 2}));
+
+        mdbxc::KeyValueTable<int, std::set<std::int64_t>> tags(conn, "merge_tags");
+        tags.clear();
+        tags.set_merge_operator(mdbxc::MergeKind::SetUnion);
+        tags.merge(1, std::set<std::int64_t>{5, -1});
+        tags.merge(1, std::set<std::int64_t>{-1, 7});
+        MDBXC_TEST_ASSERT(tags.at(1) == std::set<std::int64_t>({-1, 5, 7}));
+
+        mdbxc::KeyValueTable<int, std::string> log(conn, "merge_log");
+        log.clear();
+        log.set_merge_operator(mdbxc::MergeKind::Append);
+        log.merge(1, "ab");
+        log.merge(1, "cd");
+        MDBXC_TEST_ASSERT(log.at(1) == "abcd");
+
+        threw = false;
+        try {
+            log.set_merge_operator(mdbxc::MergeKind::AddInteger);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    } catch (const std::exception& e) {
+        std::cerr << "Merge operator test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Merge operator test passed.\n";
+    return 0;
+}
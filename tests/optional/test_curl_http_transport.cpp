@@ -0,0 +1,87 @@
+#include <mdbx_containers/sync/transports/curl/HttpTransport.hpp>
+
+#include "../test_assert.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#if !defined(MDBXC_HAS_CURL_HTTP_TRANSPORT)
+#error "libcurl HTTP transport target must define its feature macro"
+#endif
+
+#if !MDBXC_HAS_CURL_HTTP_TRANSPORT
+#error "libcurl HTTP transport feature macro must be non-zero"
+#endif
+
+namespace {
+
+    void test_config_defaults_and_validation() {
+        mdbxc::sync::curl::HttpSyncClientConfig config;
+        MDBXC_TEST_ASSERT(config.http_version ==
+                          mdbxc::sync::curl::HttpVersion::Http2Tls);
+        MDBXC_TEST_ASSERT(config.share_connection);
+
+        bool threw = false;
+        config.base_url.clear();
+        try {
+            mdbxc::sync::curl::HttpSyncClient client(config);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+
+        threw = false;
+        config.base_url = "http://127.0.0.1:18080";
+        config.request_timeout = std::chrono::milliseconds(-1);
+        try {
+            mdbxc::sync::curl::HttpSyncClient client(config);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    void test_shared_multiplexer_per_base_url() {
+        const std::shared_ptr<mdbxc::sync::curl::detail::CurlMultiplexer> shared =
+            mdbxc::sync::curl::detail::shared_multiplexer("http://127.0.0.1:18080");
+        MDBXC_TEST_ASSERT(
+            mdbxc::sync::curl::detail::shared_multiplexer("http://127.0.0.1:18080") ==
+            shared);
+        MDBXC_TEST_ASSERT(
+            mdbxc::sync::curl::detail::shared_multiplexer("http://127.0.0.1:18081") !=
+            shared);
+    }
+
+    void test_cancelled_and_unreachable_requests() {
+        mdbxc::sync::curl::HttpSyncClientConfig config;
+        // Port 1 is not listening, so the connect is refused right away.
+        config.base_url = "http://127.0.0.1:1";
+        config.http_version = mdbxc::sync::curl::HttpVersion::Http1_1;
+        config.request_timeout = std::chrono::milliseconds(5000);
+        mdbxc::sync::curl::HttpSyncClient client(config);
+        const std::vector<std::uint8_t> body(16, 0x5a);
+
+        mdbxc::sync::CancellationSource cancel;
+        cancel.request_cancel();
+        mdbxc::sync::HttpSyncResponse response =
+            client.post(mdbxc::sync::HttpSyncRoutes::pull_target(),
+                        mdbxc::sync::HttpSyncRoutes::content_type(),
+                        body, cancel.token());
+        MDBXC_TEST_ASSERT(response.status_code == 503u);
+
+        response = client.post(mdbxc::sync::HttpSyncRoutes::pull_target(),
+                               mdbxc::sync::HttpSyncRoutes::content_type(),
+                               body, mdbxc::sync::CancellationToken());
+        MDBXC_TEST_ASSERT(response.status_code == 0u);
+        MDBXC_TEST_ASSERT(!response.error.empty());
+    }
+
+} // namespace
+
+int main() {
+    test_config_defaults_and_validation();
+    test_shared_multiplexer_per_base_url();
+    test_cancelled_and_unreachable_requests();
+    return 0;
+}
@@ -2,6 +2,8 @@
 
 #include "../test_assert.hpp"
 
+#include <memory>
+
 #if !defined(MDBXC_HAS_KURLYK_HTTP_TRANSPORT)
 #error "Kurlyk HTTP transport target must define its feature macro"
 #endif
@@ -17,6 +19,16 @@ int main() {
 
     MDBXC_TEST_ASSERT(config.base_url == "http://127.0.0.1:18080");
     MDBXC_TEST_ASSERT(config.bounds.max_transport_message_bytes == 1024u);
+    MDBXC_TEST_ASSERT(!config.share_client);
+
+    const std::shared_ptr< ::kurlyk::HttpClient > shared =
+        mdbxc::sync::kurlyk::detail::shared_http_client(config.base_url);
+    MDBXC_TEST_ASSERT(
+        mdbxc::sync::kurlyk::detail::shared_http_client(config.base_url) ==
+        shared);
+    MDBXC_TEST_ASSERT(
+        mdbxc::sync::kurlyk::detail::shared_http_client(
+            "http://127.0.0.1:18081") != shared);
 
     return 0;
 }
@@ -5,8 +5,10 @@
 #include <cstdlib>
 #include <cstdio>
 #include <cstdint>
+#include <istream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #if !defined(MDBXC_HAS_SIMPLE_WEB_HTTP_TRANSPORT)
 #error "Simple-Web HTTP transport target must define its feature macro"
@@ -80,6 +82,55 @@ void test_http_listener_rejects_oversized_body() {
     cleanup(path);
 }
 
+void test_byte_view_stream_buf_seeks_and_reads() {
+    const std::vector<std::uint8_t> bytes = { 'a', 'b', 'c', 'd' };
+    mdbxc::sync::simple_web::detail::ByteViewStreamBuf buf(&bytes[0], bytes.size());
+    std::istream stream(&buf);
+    stream.seekg(0, std::ios::end);
+    MDBXC_TEST_ASSERT(stream.tellg() == std::streampos(4));
+    stream.seekg(0, std::ios::beg);
+    std::string read(4, '\0');
+    stream.read(&read[0], 4);
+    MDBXC_TEST_ASSERT(read == "abcd");
+    MDBXC_TEST_ASSERT(stream.get() == std::char_traits<char>::eof());
+}
+
+void test_http_client_pulls_through_listener() {
+    const std::string path = "test_simple_web_http_roundtrip.mdbx";
+    cleanup(path);
+
+    std::shared_ptr<mdbxc::Connection> conn = open_env(path);
+    mdbxc::sync::SyncEngine engine(conn);
+    engine.initialize_local_identity(make_node(0x10), make_node(0xD0));
+
+    mdbxc::sync::HttpSyncServer server(engine);
+    mdbxc::sync::simple_web::HttpSyncListenerConfig listener_config;
+    listener_config.host = "127.0.0.1";
+    listener_config.port = 0;
+    mdbxc::sync::simple_web::HttpSyncListener listener(
+        server, listener_config);
+    listener.start();
+
+    mdbxc::sync::simple_web::HttpSyncClientConfig client_config;
+    client_config.host = "127.0.0.1";
+    client_config.port = listener.port();
+    mdbxc::sync::simple_web::HttpSyncClient client(client_config);
+    mdbxc::sync::HttpSyncPeer peer(client);
+
+    mdbxc::sync::PullRequest request;
+    request.requester = make_node(0x20);
+    request.db_id = make_node(0xD0);
+    const mdbxc::sync::PullResponse response = peer.pull(request);
+
+    listener.stop();
+
+    MDBXC_TEST_ASSERT(response.ok);
+    MDBXC_TEST_ASSERT(!response.has_more);
+
+    conn->disconnect();
+    cleanup(path);
+}
+
 } // namespace
 
 int main() {
@@ -98,6 +149,8 @@ int main() {
         listener_config.bounds.max_transport_message_bytes == 64u);
 
     test_http_listener_rejects_oversized_body();
+    test_byte_view_stream_buf_seeks_and_reads();
+    test_http_client_pulls_through_listener();
 
     return 0;
 }
@@ -11,6 +11,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdio>
 #include <future>
 #include <memory>
 #include <mutex>
@@ -29,6 +30,19 @@ mdbxc::sync::NodeId make_node(std::uint8_t seed) {
     return node;
 }
 
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path) {
+    mdbxc::Config config;
+    config.pathname = path;
+    config.no_subdir = true;
+    config.max_dbs = 16;
+    return mdbxc::Connection::create(config);
+}
+
 class SilentWebSocketServer {
 public:
     SilentWebSocketServer()
@@ -124,6 +138,97 @@ private:
     bool m_running;
 };
 
+// Answers tagged messages in pairs, the second one first, echoing bodies.
+class ReversingWebSocketServer {
+public:
+    ReversingWebSocketServer()
+        : m_connections(0),
+          m_running(false) {
+        m_server.config.address = "127.0.0.1";
+        m_server.config.port = 0;
+        m_server.config.thread_pool_size = 1;
+
+        Server::Endpoint& endpoint =
+            m_server.endpoint["^/mdbxc/sync/v1/ws/?$"];
+        endpoint.on_open =
+            [this](std::shared_ptr<Server::Connection> connection) {
+                (void)connection;
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_connections;
+            };
+        endpoint.on_message =
+            [this](
+                std::shared_ptr<Server::Connection> connection,
+                std::shared_ptr<Server::InMessage> in_message) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_held.push_back(in_message->string());
+                if (m_held.size() < 2u) {
+                    return;
+                }
+                for (std::size_t i = m_held.size(); i-- > 0;) {
+                    connection->send(m_held[i], nullptr, 130);
+                }
+                m_held.clear();
+            };
+    }
+
+    ~ReversingWebSocketServer() {
+        stop();
+    }
+
+    void start() {
+        std::shared_ptr<std::promise<unsigned short> > started(
+            new std::promise<unsigned short>());
+        std::future<unsigned short> started_future = started->get_future();
+        m_thread = std::thread(
+            [this, started]() {
+                try {
+                    m_server.start(
+                        [started](unsigned short assigned_port) {
+                            started->set_value(assigned_port);
+                        });
+                } catch (...) {
+                    try {
+                        started->set_exception(std::current_exception());
+                    } catch (...) {}
+                }
+            });
+        m_port = started_future.get();
+        m_running = true;
+    }
+
+    void stop() {
+        if (!m_running) {
+            return;
+        }
+        m_server.stop();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        m_running = false;
+    }
+
+    unsigned short port() const {
+        return m_port;
+    }
+
+    std::size_t connections() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_connections;
+    }
+
+private:
+    typedef SimpleWeb::SocketServer<SimpleWeb::WS> Server;
+
+    Server m_server;
+    std::thread m_thread;
+    unsigned short m_port = 0;
+    mutable std::mutex m_mutex;
+    std::vector<std::string> m_held;
+    std::size_t m_connections;
+    bool m_running;
+};
+
 void require_true(bool value, const char* message) {
     if (!value) {
         throw std::runtime_error(message);
@@ -271,6 +376,96 @@ void test_websocket_channel_deadline_unblocks_silent_exchange() {
                  "WebSocket deadline exchange reported wrong result");
 }
 
+void test_persistent_websocket_channel_matches_out_of_order_responses() {
+    ReversingWebSocketServer server;
+    server.start();
+
+    mdbxc::sync::simple_web::WebSocketSyncChannelConfig config;
+    config.host = "127.0.0.1";
+    config.port = server.port();
+    config.exchange_timeout = std::chrono::seconds(5);
+    mdbxc::sync::simple_web::PersistentWebSocketSyncChannel channel(config);
+
+    // Two rounds of two concurrent exchanges over one connection.
+    bool matched = true;
+    for (int round = 0; round < 2; ++round) {
+        const std::vector<std::uint8_t> first(3u, static_cast<std::uint8_t>(0x10 + round));
+        const std::vector<std::uint8_t> second(5u, static_cast<std::uint8_t>(0x20 + round));
+        std::vector<std::uint8_t> first_reply;
+        std::vector<std::uint8_t> second_reply;
+        std::thread other(
+            [&channel, &second, &second_reply]() {
+                try {
+                    second_reply = channel.exchange_binary(
+                        second, mdbxc::sync::CancellationToken());
+                } catch (...) {}
+            });
+        try {
+            first_reply = channel.exchange_binary(
+                first, mdbxc::sync::CancellationToken());
+        } catch (...) {}
+        other.join();
+        matched = matched && first_reply == first && second_reply == second;
+    }
+    const std::size_t connections = server.connections();
+    channel.close();
+    server.stop();
+
+    require_true(matched,
+                 "persistent WebSocket channel mixed up responses");
+    require_true(connections == 1u && channel.connect_count() == 1u,
+                 "persistent WebSocket channel reconnected between exchanges");
+}
+
+void test_websocket_listener_serves_pulls_while_handler_mutex_held() {
+    const std::string path = "test_simple_websocket_pull_pool.mdbx";
+    cleanup(path);
+    std::shared_ptr<mdbxc::Connection> conn = open_env(path);
+    mdbxc::sync::SyncEngine engine(conn);
+    engine.initialize_local_identity(make_node(0x10), make_node(0xD0));
+    mdbxc::sync::WebSocketSyncServer server(engine);
+    mdbxc::sync::WebSocketSyncServerMiddleware middleware(server);
+
+    std::mutex handler_mutex;
+    mdbxc::sync::simple_web::WebSocketSyncListenerConfig listener_config;
+    listener_config.handler_mutex = &handler_mutex;
+    listener_config.serialize_pulls = false;
+    listener_config.pull_threads = 2;
+    mdbxc::sync::simple_web::WebSocketSyncListener listener(
+        middleware, listener_config);
+    listener.start();
+
+    mdbxc::sync::simple_web::WebSocketSyncChannelConfig channel_config;
+    channel_config.host = "127.0.0.1";
+    channel_config.port = listener.port();
+    channel_config.exchange_timeout = std::chrono::seconds(5);
+    mdbxc::sync::simple_web::PersistentWebSocketSyncChannel channel(
+        channel_config);
+    mdbxc::sync::WebSocketSyncPeer peer(channel);
+
+    mdbxc::sync::PullRequest request;
+    request.requester = make_node(0x20);
+    request.db_id = make_node(0xD0);
+    bool served = false;
+    {
+        // Stands in for a long push; pulls must not wait for it.
+        std::lock_guard<std::mutex> held(handler_mutex);
+        try {
+            served = peer.pull(request).ok && peer.pull(request).ok;
+        } catch (const std::exception&) {}
+    }
+    const std::size_t connections = channel.connect_count();
+    channel.close();
+    listener.stop();
+    conn->disconnect();
+    cleanup(path);
+
+    require_true(served,
+                 "WebSocket listener pull waited for the push handler mutex");
+    require_true(connections == 1u,
+                 "persistent WebSocket channel reconnected against the listener");
+}
+
 void test_websocket_channel_rejects_negative_deadline() {
     mdbxc::sync::simple_web::WebSocketSyncChannelConfig config;
     config.host = "127.0.0.1";
@@ -300,5 +495,7 @@ int main() {
     test_websocket_channel_rejects_oversized_outbound_message();
     test_websocket_channel_deadline_unblocks_silent_exchange();
     test_websocket_channel_rejects_negative_deadline();
+    test_persistent_websocket_channel_matches_out_of_order_responses();
+    test_websocket_listener_serves_pulls_while_handler_mutex_held();
     return 0;
 }
@@ -0,0 +1,100 @@
+#include "test_assert.hpp"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+#include <mdbx_containers/KeyValueTable.hpp>
+
+namespace {
+
+mdbxc::RangeAggregate brute_force(const std::map<std::uint64_t, double>& model,
+                                  std::uint64_t from, std::uint64_t to) {
+    mdbxc::RangeAggregate agg;
+    for (std::map<std::uint64_t, double>::const_iterator it = model.lower_bound(from);
+         it != model.end() && it->first <= to; ++it) {
+        agg.add(it->second);
+    }
+    return agg;
+}
+
+bool same(const mdbxc::RangeAggregate& a, const mdbxc::RangeAggregate& b) {
+    if (a.count != b.count) return false;
+    if (a.count == 0) return true;
+    return a.min == b.min && a.max == b.max && std::fabs(a.sum - b.sum) < 1e-6;
+}
+
+} // namespace
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/range_aggregate_test.mdbx";
+        cfg.max_dbs = 8;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+        std::map<std::uint64_t, double> model;
+
+        mdbxc::KeyValueTable<std::uint64_t, double> prices(conn, "agg_prices");
+        prices.clear();
+        bool threw = false;
+        try {
+            prices.range_aggregate(0, 10);
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+
+        // Records written before attaching are summarized on attach.
+        for (std::uint64_t k = 0; k < 500; ++k) {
+            prices.insert_or_assign(k * 7, static_cast<double>(k % 13));
+            model[k * 7] = static_cast<double>(k % 13);
+        }
+        prices.add_range_aggregates();
+        MDBXC_TEST_ASSERT(prices.has_range_aggregates());
+        MDBXC_TEST_ASSERT(same(prices.range_aggregate(0, 3499), brute_force(model, 0, 3499)));
+
+        std::mt19937_64 rng(42);
+        for (int i = 0; i < 2000; ++i) {
+            const std::uint64_t key = rng() % 20000;
+            if (rng() % 4 == 0) {
+                prices.erase(key);
+                model.erase(key);
+            } else {
+                const double value = static_cast<double>(rng() % 1000) - 500.0;
+                prices.insert_or_assign(key, value);
+                model[key] = value;
+            }
+        }
+        const std::uint64_t far_key = std::uint64_t(1) << 62;
+        prices.insert_or_assign(far_key, 1e6);
+        model[far_key] = 1e6;
+
+        for (int i = 0; i < 200; ++i) {
+            std::uint64_t a = rng() % 21000;
+            std::uint64_t b = rng() % 21000;
+            if (a > b) std::swap(a, b);
+            MDBXC_TEST_ASSERT(same(prices.range_aggregate(a, b), brute_force(model, a, b)));
+        }
+        mdbxc::RangeAggregate all = prices.range_aggregate(0, UINT64_MAX);
+        MDBXC_TEST_ASSERT(same(all, brute_force(model, 0, UINT64_MAX)));
+        MDBXC_TEST_ASSERT(all.max == 1e6);
+        MDBXC_TEST_ASSERT(prices.range_aggregate(20001, far_key - 1).count == 0);
+
+        prices.rebuild_range_aggregates();
+        MDBXC_TEST_ASSERT(same(prices.range_aggregate(0, UINT64_MAX), all));
+
+        prices.clear();
+        MDBXC_TEST_ASSERT(prices.range_aggregate(0, UINT64_MAX).count == 0);
+    } catch (const std::exception& e) {
+        std::cerr << "Range aggregate test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Range aggregate test passed.\n";
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include "test_assert.hpp"
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mdbx_containers/KeyValueTable.hpp>
+
+namespace {
+
+std::string city_of(const std::string& value) {
+    return value.substr(0, value.find(':'));
+}
+
+} // namespace
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/secondary_index_test.mdbx";
+        cfg.max_dbs = 8;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+        typedef std::vector<std::uint64_t> Ids;
+
+        {
+            mdbxc::KeyValueTable<std::uint64_t, std::string> users(conn, "users");
+            users.add_index<std::string>("city", city_of);
+            users.add_index<std::size_t>("length", [](const std::string& value) {
+                return value.size();
+            });
+            users.clear();
+            users.insert_or_assign(1, "berlin:ann");
+            users.insert_or_assign(2, "paris:bob");
+            MDBXC_TEST_ASSERT(users.has_index("city"));
+            MDBXC_TEST_ASSERT(!users.has_index("zip"));
+
+            users.insert_or_assign(3, "berlin:carl");
+            MDBXC_TEST_ASSERT(users.insert(4, "oslo:dina"));
+            MDBXC_TEST_ASSERT(users.find_keys_by_index<std::string>("city", "berlin") == (Ids{1, 3}));
+            MDBXC_TEST_ASSERT(users.count_by_index<std::string>("city", "berlin") == 2);
+            MDBXC_TEST_ASSERT(users.count_by_index<std::string>("city", "rome") == 0);
+
+            // Updates move entries, erases drop them.
+            users.insert_or_assign(1, "paris:ann");
+            MDBXC_TEST_ASSERT(users.find_keys_by_index<std::string>("city", "berlin") == (Ids{3}));
+            MDBXC_TEST_ASSERT(users.find_keys_by_index<std::string>("city", "paris") == (Ids{1, 2}));
+            MDBXC_TEST_ASSERT(users.erase(2));
+            MDBXC_TEST_ASSERT(users.find_keys_by_index<std::string>("city", "paris") == (Ids{1}));
+
+            const std::vector<std::pair<std::uint64_t, std::string>> paris =
+                users.find_by_index<std::string>("city", "paris");
+            MDBXC_TEST_ASSERT(paris.size() == 1 && paris[0].second == "paris:ann");
+
+            std::vector<std::string> cities;
+            MDBXC_TEST_ASSERT(users.for_each_index_range<std::string>("city", "a", "p",
+                [&cities](const std::string& city, const std::uint64_t&) {
+                    cities.push_back(city);
+                    return true;
+                }));
+            MDBXC_TEST_ASSERT(cities == (std::vector<std::string>{"berlin", "oslo"}));
+
+            std::size_t visited = 0;
+            MDBXC_TEST_ASSERT(!users.for_each_by_index_range<std::size_t>("length", 0, 100,
+                [&visited](const std::size_t& length, const std::uint64_t&, const std::string& value) {
+                    MDBXC_TEST_ASSERT(length == value.size());
+                    return ++visited < 2;
+                }));
+            MDBXC_TEST_ASSERT(visited == 2);
+
+            // Bulk writes, range erase and reconcile keep the index in step.
+            std::map<std::uint64_t, std::string> batch;
+            batch[5] = "oslo:eve";
+            batch[6] = "rome:finn";
+            users.append(batch);
+            MDBXC_TEST_ASSERT(users.find_keys_by_index<std::string>("city", "oslo") == (Ids{4, 5}));
+            MDBXC_TEST_ASSERT(users.erase_range(4, 5) == 2);
+            MDBXC_TEST_ASSERT(users.count_by_index<std::string>("city", "oslo") == 0);
+
+            std::vector<std::pair<std::uint64_t, std::string>> sorted;
+            sorted.push_back(std::make_pair(std::uint64_t(1), std::string("rome:ann")));
+            sorted.push_back(std::make_pair(std::uint64_t(7), std::string("berlin:gus")));
+            users.reconcile_sorted(sorted.begin(), sorted.end(), 1);
+            MDBXC_TEST_ASSERT(users.find_keys_by_index<std::string>("city", "rome") == (Ids{1}));
+            MDBXC_TEST_ASSERT(users.find_keys_by_index<std::string>("city", "berlin") == (Ids{7}));
+            MDBXC_TEST_ASSERT(users.count_by_index<std::string>("city", "paris") == 0);
+
+            bool thrown = false;
+            try {
+                users.find_keys_by_index<int>("city", 1);
+            } catch (const std::invalid_argument&) {
+                thrown = true;
+            }
+            MDBXC_TEST_ASSERT(thrown);
+
+            users.clear();
+            MDBXC_TEST_ASSERT(users.count_by_index<std::string>("city", "rome") == 0);
+        }
+
+        // rebuild_index() repairs an index after writes through a plain wrapper.
+        {
+            mdbxc::KeyValueTable<std::uint64_t, std::string> indexed(conn, "users");
+            indexed.add_index<std::string>("city", city_of);
+            indexed.insert_or_assign(10, "lima:hal");
+
+            mdbxc::KeyValueTable<std::uint64_t, std::string> plain(conn, "users");
+            plain.insert_or_assign(11, "lima:ivy");
+            MDBXC_TEST_ASSERT(indexed.count_by_index<std::string>("city", "lima") == 1);
+            indexed.rebuild_index("city");
+            MDBXC_TEST_ASSERT(indexed.find_keys_by_index<std::string>("city", "lima") == (Ids{10, 11}));
+        }
+
+        // add_index() fills an empty index from existing records.
+        {
+            mdbxc::KeyValueTable<std::uint64_t, std::string> plain(conn, "visits");
+            plain.clear();
+            plain.insert_or_assign(1, "quito:jo");
+            plain.insert_or_assign(2, "quito:kim");
+
+            mdbxc::KeyValueTable<std::uint64_t, std::string> indexed(conn, "visits");
+            indexed.add_index<std::string>("city", city_of);
+            MDBXC_TEST_ASSERT(indexed.find_keys_by_index<std::string>("city", "quito") == (Ids{1, 2}));
+            indexed.clear();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Secondary index test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Secondary index test passed.\n";
+    return 0;
+}
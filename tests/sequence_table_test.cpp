@@ -1,9 +1,13 @@
 #include "test_assert.hpp"
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <list>
+#include <map>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <mdbx_containers/SequenceTable.hpp>
@@ -49,7 +53,7 @@ struct Profile {
 int main() {
     mdbxc::Config cfg;
     cfg.pathname = "data/sequence_table_test.mdbx";
-    cfg.max_dbs = 10;
+    cfg.max_dbs = 16;
     cfg.no_subdir = true;
     cfg.relative_to_exe = true;
 
@@ -321,6 +325,252 @@ int main() {
         MDBXC_TEST_ASSERT(table.at(0) == "config_test");
     }
 
+    // --- 10. bulk_load_sorted ---
+    {
+        mdbxc::SequenceTable<std::string> table(conn, "seq_bulk_load");
+        table.clear();
+
+        std::map<uint64_t, std::string> snapshot;
+        snapshot[1] = "one";
+        snapshot[4] = "four";
+        MDBXC_TEST_ASSERT(table.bulk_load_sorted(snapshot, mdbxc::BulkLoadMode::Strict));
+        MDBXC_TEST_ASSERT(table.append("five") == 5);
+
+        std::vector<std::pair<uint64_t, std::string>> unsorted;
+        unsorted.push_back(std::make_pair(uint64_t(7), std::string("seven")));
+        unsorted.push_back(std::make_pair(uint64_t(2), std::string("two")));
+        MDBXC_TEST_ASSERT(!table.bulk_load_sorted(unsorted));
+        MDBXC_TEST_ASSERT(table.at(2) == "two");
+        MDBXC_TEST_ASSERT(table.at(7) == "seven");
+        MDBXC_TEST_ASSERT(table.count() == 5);
+
+        bool threw = false;
+        try {
+            table.bulk_load_sorted(unsorted, mdbxc::BulkLoadMode::Strict);
+        } catch (const mdbxc::MdbxException&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 11. cached next id and append run ---
+    {
+        mdbxc::SequenceTable<int> table(conn, "seq_next_id");
+        mdbxc::SequenceTable<int> other(conn, "seq_next_id");
+        table.clear();
+
+        MDBXC_TEST_ASSERT(table.append(1) == 0);
+        MDBXC_TEST_ASSERT(table.append(2) == 1);
+        MDBXC_TEST_ASSERT(other.append(3) == 2);
+        MDBXC_TEST_ASSERT(table.append(4) == 3);
+
+        std::vector<int> run;
+        run.push_back(10);
+        run.push_back(11);
+        run.push_back(12);
+        std::pair<uint64_t, uint64_t> ids = table.append_many(run.begin(), run.end());
+        MDBXC_TEST_ASSERT(ids.first == 4 && ids.second == 7);
+        MDBXC_TEST_ASSERT(table.at(6) == 12);
+        ids = table.append_many(run.end(), run.end());
+        MDBXC_TEST_ASSERT(ids.first == ids.second);
+
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            MDBXC_TEST_ASSERT(table.append(5, txn) == 7);
+            MDBXC_TEST_ASSERT(other.append(6, txn) == 8);
+            MDBXC_TEST_ASSERT(table.append(7, txn) == 9);
+            txn.rollback();
+        }
+        MDBXC_TEST_ASSERT(table.append(8) == 7);
+
+        MDBXC_TEST_ASSERT(table.erase(7));
+        MDBXC_TEST_ASSERT(table.append(9) == 7);
+        other.set(20, 20);
+        MDBXC_TEST_ASSERT(table.append(21) == 21);
+        MDBXC_TEST_ASSERT(table.count() == 10);
+
+        // The next writer reuses the txnid of a rolled back one.
+        const uint64_t aborts = conn->abort_sequence();
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            MDBXC_TEST_ASSERT(table.append(30, txn) == 22);
+            txn.rollback();
+        }
+        MDBXC_TEST_ASSERT(conn->abort_sequence() == aborts + 1);
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            other.set(0, 31, txn);
+            MDBXC_TEST_ASSERT(table.append(32, txn) == 22);
+            txn.commit();
+        }
+        MDBXC_TEST_ASSERT(table.count() == 11 && table.at(0) == 31);
+    }
+
+    // --- 12. reserved ids from concurrent producers ---
+    {
+        mdbxc::SequenceTable<int> table(conn, "seq_reserve");
+        table.clear();
+        MDBXC_TEST_ASSERT(table.append(-1) == 0);
+        MDBXC_TEST_ASSERT(table.append(-2) == 1);
+
+        std::pair<uint64_t, uint64_t> none = table.reserve_ids(0);
+        MDBXC_TEST_ASSERT(none.first == none.second);
+
+        const int producers = 4;
+        const int batches = 25;
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.push_back(std::thread([&table, p]() {
+                for (int b = 0; b < batches; ++b) {
+                    std::pair<uint64_t, uint64_t> ids = table.reserve_ids(2);
+                    for (uint64_t id = ids.second; id != ids.first; --id) {
+                        table.insert_reserved(id - 1, p);
+                    }
+                }
+            }));
+        }
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+
+        const uint64_t written = 2 + producers * batches * 2;
+        MDBXC_TEST_ASSERT(table.count() == written);
+        MDBXC_TEST_ASSERT(table.last_index_compat().second == written - 1);
+
+        MDBXC_TEST_ASSERT(table.append(100) == written);
+        std::pair<uint64_t, uint64_t> ids = table.reserve_ids(3);
+        MDBXC_TEST_ASSERT(ids.first == written + 1 && ids.second == written + 4);
+        table.insert_reserved(ids.first + 2, 1);
+        table.insert_reserved(ids.first, 2);
+        bool threw = false;
+        try {
+            table.insert_reserved(ids.first, 3);
+        } catch (const mdbxc::MdbxException&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+
+        table.set(500, 5);
+        MDBXC_TEST_ASSERT(table.reserve_ids(1).first == 501);
+        std::list<int> tail;
+        tail.push_back(7);
+        tail.push_back(8);
+        ids = table.append_many(tail.begin(), tail.end());
+        MDBXC_TEST_ASSERT(ids.first == 502 && ids.second == 504);
+        MDBXC_TEST_ASSERT(table.at(503) == 8);
+
+        // Another wrapper has its own counter; writes move past its indices.
+        mdbxc::SequenceTable<int> second(conn, "seq_reserve");
+        ids = second.reserve_ids(2);
+        MDBXC_TEST_ASSERT(ids.first == 504);
+        second.insert_reserved(ids.first, 1);
+        second.insert_reserved(ids.first + 1, 2);
+        MDBXC_TEST_ASSERT(table.append(9) == 506);
+        ids = second.reserve_ids(1);
+        MDBXC_TEST_ASSERT(ids.first == 506);
+        threw = false;
+        try {
+            second.insert_reserved(ids.first, 3);
+        } catch (const mdbxc::MdbxException&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+        MDBXC_TEST_ASSERT(second.reserve_ids(1).first == 507);
+
+        // A copy starts unseeded; clear() restarts the counter.
+        mdbxc::SequenceTable<int> copy(table);
+        MDBXC_TEST_ASSERT(copy.append(10) == 507);
+        table.clear();
+        MDBXC_TEST_ASSERT(table.reserve_ids(2).first == 0);
+        MDBXC_TEST_ASSERT(table.append(11) == 2);
+    }
+
+    // --- 13. tail woken by commits ---
+    {
+        mdbxc::SequenceTable<int> table(conn, "seq_tail");
+        table.clear();
+        for (int i = 0; i < 5; ++i) {
+            table.append(i);
+        }
+
+        std::vector<std::pair<uint64_t, int>> batch =
+            table.tail(1, 3, std::chrono::milliseconds(0));
+        MDBXC_TEST_ASSERT(batch.size() == 3);
+        MDBXC_TEST_ASSERT(batch.front().first == 1 && batch.back().first == 3);
+        MDBXC_TEST_ASSERT(table.tail(0, 0, std::chrono::milliseconds(0)).empty());
+        MDBXC_TEST_ASSERT(table.tail(5, 10, std::chrono::milliseconds(10)).empty());
+
+        const uint64_t seen = conn->commit_sequence();
+        std::thread producer([&table]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            table.append(5);
+        });
+        batch = table.tail(5, 10, std::chrono::seconds(10));
+        producer.join();
+        MDBXC_TEST_ASSERT(batch.size() == 1);
+        MDBXC_TEST_ASSERT(batch[0].first == 5 && batch[0].second == 5);
+        MDBXC_TEST_ASSERT(conn->commit_sequence() != seen);
+        MDBXC_TEST_ASSERT(conn->wait_for_commit(seen, std::chrono::milliseconds(0)));
+    }
+
+    // --- 14. chunked prefix truncation ---
+    {
+        mdbxc::SequenceTable<std::string> table(conn, "seq_truncate");
+        table.clear();
+        std::vector<std::string> rows(1000, std::string(64, 'x'));
+        table.append_many(rows.begin(), rows.end());
+
+        mdbxc::RetentionStats stats = table.truncate_before(700, 128, true);
+        MDBXC_TEST_ASSERT(stats.removed == 700);
+        MDBXC_TEST_ASSERT(stats.chunks == 6);
+        MDBXC_TEST_ASSERT(stats.reclaimed_pages() > 0);
+        MDBXC_TEST_ASSERT(stats.table_pages_after < stats.table_pages_before);
+        MDBXC_TEST_ASSERT(table.count() == 300);
+        MDBXC_TEST_ASSERT(table.first_index_compat().second == 700);
+        MDBXC_TEST_ASSERT(table.append("next") == 1000);
+
+        stats = table.truncate_before(700);
+        MDBXC_TEST_ASSERT(stats.removed == 0 && stats.chunks == 0);
+        stats = table.truncate_before(5000, 1000);
+        MDBXC_TEST_ASSERT(stats.removed == 301 && stats.chunks == 1);
+        MDBXC_TEST_ASSERT(table.empty());
+
+        bool threw = false;
+        try {
+            table.truncate_before(1, 0);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 15. nothrow append ---
+    {
+        mdbxc::SequenceTable<std::string> table(conn, "seq_nothrow");
+        table.clear();
+
+        mdbxc::Result<uint64_t> id = table.append(std::nothrow, "first");
+        MDBXC_TEST_ASSERT(id.ok() && id.value() == 0);
+        id = table.append(std::nothrow, "second");
+        MDBXC_TEST_ASSERT(id.ok() && id.value() == 1);
+
+        // The MDBX error of the put is returned, not thrown and caught.
+        auto ro = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+        id = table.append(std::nothrow, "third", ro);
+        MDBXC_TEST_ASSERT(!id.ok());
+        MDBXC_TEST_ASSERT(id.status().code() == mdbxc::StatusCode::MdbxError);
+        MDBXC_TEST_ASSERT(!id.status().exception());
+        bool threw = false;
+        try {
+            table.append("third", ro);
+        } catch (const mdbxc::MdbxException& e) {
+            threw = e.error_code() == id.status().mdbx_error();
+        }
+        MDBXC_TEST_ASSERT(threw);
+        ro.rollback();
+        MDBXC_TEST_ASSERT(table.count() == 2);
+    }
+
     std::cout << "SequenceTable test passed.\n";
     return 0;
 }
@@ -0,0 +1,86 @@
+#include "test_assert.hpp"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mdbx_containers/ShardedKeyValueTable.hpp>
+
+int main() {
+    try {
+        MDBXC_TEST_ASSERT(mdbxc::ShardedConnection::shard_pathname("data/kv.mdbx", 2) ==
+                          "data/kv-shard2.mdbx");
+        MDBXC_TEST_ASSERT(mdbxc::ShardedConnection::shard_pathname("data/kv", 0) ==
+                          "data/kv-shard0");
+
+        mdbxc::Config cfg;
+        cfg.pathname = "data/sharded_key_value_table_test.mdbx";
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::ShardedConnection::create(cfg, 4);
+        MDBXC_TEST_ASSERT(conn->shard_count() == 4);
+
+        mdbxc::ShardedKeyValueTable<int, std::string> table(conn, "sharded_kv");
+        table.clear();
+
+        // Parallel writers; each thread writes its own keys.
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 4; ++t) {
+            writers.emplace_back([&table, t]() {
+                for (int i = t * 100; i < (t + 1) * 100; ++i) {
+                    table.insert_or_assign(i, std::to_string(i));
+                }
+            });
+        }
+        for (std::size_t i = 0; i < writers.size(); ++i) writers[i].join();
+
+        MDBXC_TEST_ASSERT(table.count() == 400);
+        MDBXC_TEST_ASSERT(table.at(123) == "123");
+        MDBXC_TEST_ASSERT(table.contains(399));
+        MDBXC_TEST_ASSERT(!table.contains(400));
+        MDBXC_TEST_ASSERT(!table.insert(5, "five"));
+
+        // Every key is stored in the shard it hashes to, and shards are used.
+        std::size_t used_shards = 0;
+        for (std::size_t s = 0; s < table.shard_count(); ++s) {
+            const std::size_t n = table.shard(s).count();
+            if (n > 0) ++used_shards;
+        }
+        MDBXC_TEST_ASSERT(used_shards > 1);
+        MDBXC_TEST_ASSERT(table.shard(table.shard_of(42)).contains(42));
+
+        std::vector<std::pair<int, std::string>> batch;
+        for (int i = 400; i < 500; ++i) batch.emplace_back(i, "b" + std::to_string(i));
+        batch.emplace_back(400, "last");
+        table.insert_or_assign(batch);
+        MDBXC_TEST_ASSERT(table.count() == 500);
+        MDBXC_TEST_ASSERT(table.at(400) == "last");
+
+        const std::map<int, std::string> part = table.range(95, 104);
+        MDBXC_TEST_ASSERT(part.size() == 10);
+        MDBXC_TEST_ASSERT(part.begin()->first == 95);
+        MDBXC_TEST_ASSERT(part.rbegin()->first == 104);
+        MDBXC_TEST_ASSERT(table.retrieve_all().size() == 500);
+
+        MDBXC_TEST_ASSERT(table.erase(42));
+        MDBXC_TEST_ASSERT(!table.erase(42));
+#       if __cplusplus >= 201703L
+        MDBXC_TEST_ASSERT(!table.find(42).has_value());
+        MDBXC_TEST_ASSERT(*table.find(43) == "43");
+#       else
+        MDBXC_TEST_ASSERT(!table.find(42).first);
+        MDBXC_TEST_ASSERT(table.find(43).second == "43");
+#       endif
+
+        table.clear();
+        MDBXC_TEST_ASSERT(table.count() == 0);
+    } catch (const std::exception& e) {
+        std::cerr << "Sharded key-value table test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Sharded key-value table test passed.\n";
+    return 0;
+}
@@ -0,0 +1,160 @@
+#define MDBXC_METRICS_ENABLED 1
+
+#include "test_assert.hpp"
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <mdbx_containers/KeyValueTable.hpp>
+
+namespace {
+
+void test_latency_histogram() {
+    mdbxc::LatencyHistogram hist;
+    MDBXC_TEST_ASSERT(hist.percentile(0.99) == 0);
+
+    for (std::uint64_t v = 1; v <= 100; ++v) {
+        hist.record(v * 1000);
+    }
+    MDBXC_TEST_ASSERT(hist.count() == 100);
+    MDBXC_TEST_ASSERT(hist.min() == 1000);
+    MDBXC_TEST_ASSERT(hist.max() == 100000);
+
+    // Percentiles stay within one sub-bucket (1/16) above the exact value.
+    const std::uint64_t p50 = hist.percentile(0.5);
+    const std::uint64_t p99 = hist.percentile(0.99);
+    MDBXC_TEST_ASSERT(p50 >= 50000 && p50 <= 50000 + 50000 / 16);
+    MDBXC_TEST_ASSERT(p99 >= 99000 && p99 <= 99000 + 99000 / 16);
+    MDBXC_TEST_ASSERT(hist.percentile(1.0) == 100000);
+
+    for (std::uint64_t v = 0; v < 4096; ++v) {
+        const std::size_t index = mdbxc::LatencyHistogram::bucket_index(v);
+        MDBXC_TEST_ASSERT(mdbxc::LatencyHistogram::bucket_upper(index) >= v);
+    }
+    MDBXC_TEST_ASSERT(mdbxc::LatencyHistogram::bucket_index(~std::uint64_t(0)) ==
+                      mdbxc::LatencyHistogram::bucket_count - 1);
+
+    mdbxc::LatencyHistogram other;
+    other.record(std::chrono::nanoseconds(5));
+    hist.merge(other);
+    MDBXC_TEST_ASSERT(hist.count() == 101);
+    MDBXC_TEST_ASSERT(hist.min() == 5);
+    hist.reset();
+    MDBXC_TEST_ASSERT(hist.count() == 0);
+}
+
+void test_space_saving_sketch() {
+    mdbxc::SpaceSavingSketch sketch(8);
+    for (int round = 0; round < 100; ++round) {
+        sketch.offer("hot");
+        if (round % 2 == 0) sketch.offer("warm");
+        // A long tail of distinct keys churns the remaining counters.
+        sketch.offer("cold" + std::to_string(round));
+    }
+    MDBXC_TEST_ASSERT(sketch.total() == 250);
+    const std::vector<mdbxc::HotKey> top = sketch.top(2);
+    MDBXC_TEST_ASSERT(top.size() == 2);
+    MDBXC_TEST_ASSERT(top[0].key == "hot" && top[0].count == 100 && top[0].error == 0);
+    MDBXC_TEST_ASSERT(top[1].key == "warm");
+    MDBXC_TEST_ASSERT(top[1].count - top[1].error <= 50 && top[1].count >= 50);
+    MDBXC_TEST_ASSERT(sketch.top(10).size() == 8);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_latency_histogram();
+        test_space_saving_sketch();
+
+        mdbxc::Config cfg;
+        cfg.pathname = "data/table_metrics_test.mdbx";
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+        mdbxc::KeyValueTable<int, std::string> table(conn, "metrics_table");
+        table.clear();
+
+        mdbxc::TableMetricsObserver observer;
+        conn->attach_table_observer(&observer);
+
+        table.insert_or_assign(1, "one");
+        table.insert_or_assign(2, "two");
+        MDBXC_TEST_ASSERT(table.at(1) == "one");
+        MDBXC_TEST_ASSERT(table.contains(1));
+        MDBXC_TEST_ASSERT(!table.contains(3));
+        MDBXC_TEST_ASSERT(table.erase(2));
+        MDBXC_TEST_ASSERT(table.range(0, 10).size() == 1);
+
+        conn->attach_table_observer(nullptr);
+        table.insert_or_assign(4, "unobserved");
+
+        const mdbxc::TableMetrics metrics = observer.metrics("metrics_table");
+        const mdbxc::OperationMetrics& inserts = metrics[mdbxc::TableOperation::Insert];
+        MDBXC_TEST_ASSERT(inserts.count == 2);
+        // Both records have the same key width and a 3-byte value.
+        MDBXC_TEST_ASSERT(inserts.bytes == 2 * metrics[mdbxc::TableOperation::Find].bytes);
+        MDBXC_TEST_ASSERT(inserts.latency.count() == 2);
+        MDBXC_TEST_ASSERT(metrics[mdbxc::TableOperation::Find].count == 3);
+        MDBXC_TEST_ASSERT(metrics[mdbxc::TableOperation::Find].bytes > 3);
+        MDBXC_TEST_ASSERT(metrics[mdbxc::TableOperation::Erase].count == 1);
+        MDBXC_TEST_ASSERT(metrics[mdbxc::TableOperation::Range].count == 1);
+
+        // Auto-transaction writes commit once each; reads commit nothing.
+        const mdbxc::TableMetrics commits = observer.metrics(std::string());
+        MDBXC_TEST_ASSERT(commits[mdbxc::TableOperation::Commit].count >= 3);
+        // Each reported commit also carries its MDBX phase breakdown.
+        const mdbxc::CommitPhaseMetrics phases = observer.commit_phases();
+        MDBXC_TEST_ASSERT(phases.count == commits[mdbxc::TableOperation::Commit].count);
+        MDBXC_TEST_ASSERT(phases.sync.count() == phases.count);
+
+        observer.reset();
+        MDBXC_TEST_ASSERT(observer.tables().empty());
+        MDBXC_TEST_ASSERT(observer.commit_phases().count == 0);
+
+        // Keys are sampled independently of the observer.
+        mdbxc::KeyAccessSampler sampler(1);
+        conn->attach_key_sampler(&sampler);
+        for (int i = 0; i < 5; ++i) {
+            MDBXC_TEST_ASSERT(table.at(1) == "one");
+        }
+        MDBXC_TEST_ASSERT(!table.contains(7));
+        table.insert_or_assign(5, "five");
+        MDBXC_TEST_ASSERT(table.range(1, 5).size() == 3);
+        conn->attach_key_sampler(nullptr);
+        MDBXC_TEST_ASSERT(table.at(5) == "five");
+        MDBXC_TEST_ASSERT(observer.tables().empty());
+
+        const std::vector<mdbxc::HotKey> reads =
+            sampler.top("metrics_table", mdbxc::TableOperation::Find);
+        MDBXC_TEST_ASSERT(reads.size() == 2);
+        MDBXC_TEST_ASSERT(reads[0].count == 5 && reads[1].count == 1);
+        int hot_key = 0;
+        MDBXC_TEST_ASSERT(reads[0].key.size() == sizeof(hot_key));
+        std::memcpy(&hot_key, reads[0].key.data(), sizeof(hot_key));
+        MDBXC_TEST_ASSERT(hot_key == 1);
+        const mdbxc::TableKeySketches sketches = sampler.sketches("metrics_table");
+        MDBXC_TEST_ASSERT(sketches[mdbxc::TableOperation::Insert].total() == 1);
+        MDBXC_TEST_ASSERT(sketches[mdbxc::TableOperation::Range].total() == 1);
+        MDBXC_TEST_ASSERT(sketches[mdbxc::TableOperation::Find].total() == 6);
+        sampler.reset();
+        MDBXC_TEST_ASSERT(sampler.tables().empty());
+
+        // Sparse sampling records about one access in sample_every.
+        mdbxc::KeyAccessSampler sparse(8);
+        for (int i = 0; i < 8000; ++i) {
+            sparse.offer("t", mdbxc::TableOperation::Find, "k", 1);
+        }
+        const std::uint64_t sampled = sparse.sketches("t")[mdbxc::TableOperation::Find].total();
+        MDBXC_TEST_ASSERT(sampled > 700 && sampled < 1300);
+    } catch (const std::exception& e) {
+        std::cerr << "Table metrics test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Table metrics test passed.\n";
+    return 0;
+}
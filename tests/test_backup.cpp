@@ -179,6 +179,147 @@ void test_sync_to_disk_readonly_throws() {
     cleanup(p);
 }
 
+void test_backup_to_stream() {
+    using namespace mdbxc;
+
+    const std::string src = "test_backup_stream_src.mdbx";
+    const std::string dst = "test_backup_stream_dst.mdbx";
+    cleanup(src);
+    cleanup(dst);
+
+    {
+        Config cfg;
+        cfg.pathname = src;
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        auto conn = Connection::create(cfg);
+        KeyValueTable<int, std::string> kv(conn, "t");
+        for (int i = 0; i < 128; ++i) {
+            kv.insert_or_assign(i, "s_" + std::to_string(i));
+        }
+
+        std::string image;
+        BackupOptions opt;
+        opt.max_bytes_per_sec = 64u * 1024u * 1024u;
+        conn->backup_to_stream([&image](const void* data, std::size_t size) {
+            image.append(static_cast<const char*>(data), size);
+        }, opt);
+        if (image.empty()) {
+            throw std::runtime_error("stream backup: empty image");
+        }
+        std::FILE* out = std::fopen(dst.c_str(), "wb");
+        if (!out || std::fwrite(image.data(), 1, image.size(), out) != image.size()) {
+            throw std::runtime_error("stream backup: cannot write image");
+        }
+        std::fclose(out);
+
+        bool sink_threw = false;
+        try {
+            conn->backup_to_stream([](const void*, std::size_t) {
+                throw std::runtime_error("sink failure");
+            });
+        } catch (const std::runtime_error& e) {
+            sink_threw = std::string(e.what()) == "sink failure";
+        }
+        if (!sink_threw) {
+            throw std::runtime_error("stream backup: sink error not propagated");
+        }
+        // The connection stays usable after an abandoned stream.
+        kv.insert_or_assign(1000, "after");
+    }
+
+    {
+        Config cfg;
+        cfg.pathname = dst;
+        cfg.read_only = true;
+        cfg.no_subdir = true;
+        auto conn = Connection::create(cfg);
+        KeyValueTable<int, std::string> kv(conn, "t");
+        std::map<int, std::string> data = kv.retrieve_all();
+        if (data.size() != 128u || data.at(127) != "s_127") {
+            throw std::runtime_error("stream backup: record mismatch");
+        }
+    }
+
+    cleanup(src);
+    cleanup(dst);
+}
+
+void test_compact_to() {
+    using namespace mdbxc;
+
+    const std::string src = "test_compact_src.mdbx";
+    const std::string dst = "test_compact_dst.mdbx";
+    cleanup(src);
+    cleanup(dst);
+
+    {
+        Config cfg;
+        cfg.pathname = src;
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        auto conn = Connection::create(cfg);
+        KeyValueTable<int, std::string> kv(conn, "kv");
+        KeyMultiValueTable<int, int> multi(conn, "multi");
+        for (int i = 0; i < 1000; ++i) {
+            kv.insert_or_assign(i, std::string(200, 'c'));
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            kv.erase(i);
+        }
+        for (int k = 0; k < 50; ++k) {
+            for (int v = 0; v < 4; ++v) {
+                multi.insert(k, v);
+            }
+        }
+
+        Config target;
+        target.pathname = dst;
+        target.max_dbs = 1;
+        target.no_subdir = true;
+        CompactOptions opt;
+        opt.batch_entries = 64;
+        std::map<std::string, std::uint64_t> finished;
+        opt.progress = [&finished](const CompactProgress& p) {
+            if (p.entries_copied > p.entries_total) {
+                throw std::runtime_error("compact: progress overshoot");
+            }
+            if (p.done) finished[p.table] = p.entries_copied;
+        };
+        const CompactResult result = conn->compact_to(target, opt);
+        if (result.tables != 2 || result.entries != 500u + 200u) {
+            throw std::runtime_error("compact: unexpected totals");
+        }
+        if (finished.size() != 2 || finished["kv"] != 500u || finished["multi"] != 200u) {
+            throw std::runtime_error("compact: progress did not finish every table");
+        }
+        if (result.target_used_bytes == 0 || result.target_used_bytes > result.source_used_bytes) {
+            throw std::runtime_error("compact: target is not smaller");
+        }
+    }
+
+    {
+        Config cfg;
+        cfg.pathname = dst;
+        cfg.read_only = true;
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        auto conn = Connection::create(cfg);
+        KeyValueTable<int, std::string> kv(conn, "kv");
+        KeyMultiValueTable<int, int> multi(conn, "multi");
+        std::map<int, std::string> data = kv.retrieve_all();
+        if (data.size() != 500u || data.count(0) != 0 || data.at(1) != std::string(200, 'c')) {
+            throw std::runtime_error("compact: kv mismatch");
+        }
+        if (multi.count() != 200u) {
+            throw std::runtime_error("compact: multi mismatch");
+        }
+    }
+
+    cleanup(src);
+    cleanup(dst);
+}
+
 #if __cplusplus >= 201703L
 void test_backup_directory_mode() {
     using namespace mdbxc;
@@ -235,6 +376,8 @@ int main() {
     test_backup_normal_overwrite();
     test_sync_to_disk();
     test_sync_to_disk_readonly_throws();
+    test_backup_to_stream();
+    test_compact_to();
 #if __cplusplus >= 201703L
     test_backup_directory_mode();
 #endif
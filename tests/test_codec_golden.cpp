@@ -47,7 +47,7 @@ void test_golden_magic_and_version() {
             throw std::runtime_error("magic byte mismatch");
         }
     }
-    expect("codec_version low", bytes[8], 1u);
+    expect("codec_version low", bytes[8], 2u);
     expect("codec_version high", bytes[9], 0u);
     expect("batch_version b0", bytes[10], 1u);
     expect("batch_version b1", bytes[11], 0u);
@@ -65,6 +65,15 @@ void test_golden_magic_and_version() {
     expect("time b7", bytes[49], 0x11u);
     expect("ops_count b0", bytes[50], 1u);
     expect("ops_count b3", bytes[53], 0u);
+
+    // Put, no flags, new table name #0 "t", key AA BB, value CC DD EE.
+    static const std::uint8_t expected_op[] = {
+        0x00, 0x00, 0x00, 0x00, 0x01, 't', 0x02, 0xAA, 0xBB, 0x03, 0xCC, 0xDD, 0xEE
+    };
+    expect("total size", bytes.size(), 54u + sizeof(expected_op));
+    for (std::size_t i = 0; i < sizeof(expected_op); ++i) {
+        expect("op byte " + std::to_string(i), bytes[54 + i], expected_op[i]);
+    }
 }
 
 void test_golden_trailing_bytes_rejected() {
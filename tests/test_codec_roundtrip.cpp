@@ -133,6 +133,238 @@ void test_roundtrip_no_ops() {
     assert_eq("seq 7", decoded.seq, 7u);
 }
 
+void test_streamed_ops_match_encode() {
+    using namespace mdbxc::sync;
+    ChangeBatch batch;
+    batch.seq = 9;
+    batch.origin_node_id[3] = 0x5A;
+    ChangeOp put;
+    put.op_type = ChangeOpType::Put;
+    put.dbi_flags = 0x10;
+    put.dbi_name = "quotes";
+    put.storage_key = { 0x01, 0x02 };
+    put.value = { 0x0A, 0x0B, 0x0C };
+    ChangeOp del;
+    del.op_type = ChangeOpType::Delete;
+    del.dbi_name = "quotes";
+    del.storage_key = { 0x03 };
+    ChangeOp clear;
+    clear.op_type = ChangeOpType::ClearTable;
+    clear.dbi_name = "quotes";
+    batch.ops.push_back(put);
+    batch.ops.push_back(del);
+    batch.ops.push_back(clear);
+
+    // Header reserved first, ops streamed, header filled in last.
+    std::vector<std::uint8_t> streamed(ChangeBatchCodec::header_size());
+    ChangeBatchCodec::NameDictionary names;
+    for (std::size_t i = 0; i < batch.ops.size(); ++i) {
+        const ChangeOp& op = batch.ops[i];
+        ChangeBatchCodec::append_op(streamed, names, op.op_type, op.dbi_flags, op.dbi_name,
+                                    op.storage_key.data(), op.storage_key.size(),
+                                    op.value.data(), op.value.size());
+    }
+    ChangeBatchCodec::write_header(&streamed[0], batch.batch_flags, batch.origin_node_id,
+                                   batch.seq, batch.time_unix_ns,
+                                   static_cast<std::uint32_t>(batch.ops.size()));
+    assert_eq_bytes("streamed ops", streamed, ChangeBatchCodec::encode(batch));
+    assert_eq("streamed names", names.names.size(), 1u);
+}
+
+void test_table_names_stored_once() {
+    using namespace mdbxc::sync;
+    ChangeBatch batch;
+    batch.origin_node_id[0] = 0x11;
+    const std::string tables[] = { "quotes_by_symbol", "trades_by_symbol" };
+    for (int i = 0; i < 100; ++i) {
+        ChangeOp op;
+        op.op_type = ChangeOpType::Put;
+        op.dbi_name = tables[i % 2];
+        op.storage_key = { static_cast<std::uint8_t>(i) };
+        op.value = { 0x01 };
+        batch.ops.push_back(op);
+    }
+    const std::vector<std::uint8_t> bytes = ChangeBatchCodec::encode(batch);
+    // Per op: type, flags, dbi flags, ref, key and value, each one byte long.
+    assert_eq("dictionary size", bytes.size(),
+              ChangeBatchCodec::header_size() + 100 * 8 + 2 * (1 + 16));
+    const ChangeBatch decoded = ChangeBatchCodec::decode_exact(bytes);
+    for (int i = 0; i < 100; ++i) {
+        if (decoded.ops[i].dbi_name != tables[i % 2] ||
+            decoded.ops[i].storage_key[0] != static_cast<std::uint8_t>(i)) {
+            throw std::runtime_error("dictionary: op " + std::to_string(i) + " differs");
+        }
+    }
+
+    // A reference past the next new index is rejected.
+    std::vector<std::uint8_t> bad = bytes;
+    bad[ChangeBatchCodec::header_size() + 3] = 5;
+    bool caught = false;
+    try {
+        (void)ChangeBatchCodec::decode_exact(bad);
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    if (!caught) {
+        throw std::runtime_error("dictionary: invalid dbi_ref accepted");
+    }
+}
+
+void append_u32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+}
+
+void test_decodes_codec_version_1() {
+    using namespace mdbxc::sync;
+    ChangeBatch batch = make_batch();
+    std::vector<std::uint8_t> v1(ChangeBatchCodec::header_size());
+    ChangeBatchCodec::write_header(&v1[0], BATCH_NONE, batch.origin_node_id, batch.seq,
+                                   batch.time_unix_ns, 2);
+    v1[8] = 1;
+    v1[9] = 0;
+    // Put with a revision key, then a tombstone, in the fixed-width layout.
+    v1.push_back(static_cast<std::uint8_t>(ChangeOpType::Put));
+    append_u32(v1, OP_HAS_REVISION_KEY);
+    append_u32(v1, 0);
+    append_u32(v1, 6);
+    v1.insert(v1.end(), batch.ops[0].dbi_name.begin(), batch.ops[0].dbi_name.end());
+    append_u32(v1, 4);
+    v1.insert(v1.end(), batch.ops[0].storage_key.begin(), batch.ops[0].storage_key.end());
+    append_u32(v1, 64);
+    v1.insert(v1.end(), batch.ops[0].value.begin(), batch.ops[0].value.end());
+    append_u32(v1, 2);
+    v1.insert(v1.end(), batch.ops[0].revision_key.begin(), batch.ops[0].revision_key.end());
+    v1.push_back(static_cast<std::uint8_t>(ChangeOpType::Delete));
+    append_u32(v1, OP_TOMBSTONE);
+    append_u32(v1, 0);
+    append_u32(v1, 6);
+    v1.insert(v1.end(), batch.ops[1].dbi_name.begin(), batch.ops[1].dbi_name.end());
+    append_u32(v1, 2);
+    v1.insert(v1.end(), batch.ops[1].storage_key.begin(), batch.ops[1].storage_key.end());
+    append_u32(v1, 0xFFFFFFFFu);
+
+    const ChangeBatch decoded = ChangeBatchCodec::decode_exact(v1);
+    assert_eq_bytes("v1 re-encoded", ChangeBatchCodec::encode(decoded),
+                    ChangeBatchCodec::encode(batch));
+}
+
+void test_batch_view() {
+    using namespace mdbxc::sync;
+    const std::vector<std::uint8_t> bytes = ChangeBatchCodec::encode(make_batch());
+    const ChangeBatchView view(bytes);
+    assert_eq("view seq", view.seq(), 42u);
+    assert_eq("view ops_count", view.ops_count(), 2u);
+    assert_eq("view origin", view.origin_node_id()[15], 16u);
+    assert_eq("view size", view.size(), bytes.size());
+
+    // Op fields point into the encoded bytes; no payload is copied.
+    const std::uint8_t* begin = &bytes[0];
+    const std::uint8_t* end = begin + bytes.size();
+    ChangeBatchCodec::Reader reader = view.ops();
+    ChangeOpView first;
+    ChangeOpView second;
+    if (!reader.next(first) || !reader.next(second)) {
+        throw std::runtime_error("view: missing ops");
+    }
+    if (first.value < begin || first.value + first.value_len > end) {
+        throw std::runtime_error("view: value is not borrowed");
+    }
+    if (second.dbi_name != first.dbi_name) {
+        throw std::runtime_error("view: repeated table name is not shared");
+    }
+    assert_eq("view name", second.dbi_name_len, 6u);
+    assert_eq("view value", first.value_len, 64u);
+    assert_eq("view revision", first.revision_key_len, 2u);
+    assert_eq("view tombstone value", second.value_len, 0u);
+    ChangeOpView extra;
+    if (reader.next(extra)) {
+        throw std::runtime_error("view: extra op");
+    }
+    assert_eq("view bytes_read", reader.bytes_read(), bytes.size());
+
+    assert_eq_bytes("view to_batch", ChangeBatchCodec::encode(view.to_batch()), bytes);
+
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+    ChangeBatch batch = make_batch();
+    for (int i = 0; i < 32; ++i) {
+        batch.ops.push_back(batch.ops[0]);
+    }
+    batch.batch_flags = BATCH_COMPRESSED_ZSTD;
+    const std::vector<std::uint8_t> packed = ChangeBatchCodec::encode(batch);
+    const ChangeBatchView packed_view(packed);
+    if (!packed_view.compressed()) {
+        throw std::runtime_error("view: compressed flag lost");
+    }
+    ChangeBatchCodec::Reader packed_reader = packed_view.ops();
+    std::size_t count = 0;
+    ChangeOpView op;
+    while (packed_reader.next(op)) {
+        ++count;
+    }
+    assert_eq("view compressed ops", count, batch.ops.size());
+    assert_eq("view compressed bytes_read", packed_reader.bytes_read(), packed.size());
+#endif
+}
+
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+void test_roundtrip_compressed() {
+    using namespace mdbxc::sync;
+    ChangeBatch batch = make_batch();
+    for (int i = 0; i < 32; ++i) {
+        batch.ops.push_back(batch.ops[0]);
+    }
+    const std::vector<std::uint8_t> plain = ChangeBatchCodec::encode(batch);
+    batch.batch_flags = BATCH_COMPRESSED_ZSTD;
+    const std::vector<std::uint8_t> packed = ChangeBatchCodec::encode(batch);
+    if (packed.size() >= plain.size()) {
+        throw std::runtime_error("compressed: batch did not shrink");
+    }
+    ChangeBatch decoded = ChangeBatchCodec::decode_exact(packed);
+    assert_eq("compressed flag kept", decoded.batch_flags,
+              static_cast<std::uint32_t>(BATCH_COMPRESSED_ZSTD));
+    assert_eq_bytes("compressed re-encode", ChangeBatchCodec::encode(decoded), packed);
+    decoded.batch_flags = BATCH_NONE;
+    assert_eq_bytes("compressed content", ChangeBatchCodec::encode(decoded), plain);
+
+    // Compressing a plain encoding yields the same bytes.
+    std::vector<std::uint8_t> copy;
+    if (!ChangeBatchCodec::compress(plain, copy, 0, 3)) {
+        throw std::runtime_error("compressed: compress() refused");
+    }
+    assert_eq_bytes("compress copy", copy, packed);
+
+    // Below the threshold the batch stays plain.
+    if (ChangeBatchCodec::compress(plain, copy, plain.size())) {
+        throw std::runtime_error("compressed: threshold ignored");
+    }
+    if (ChangeBatchCodec::compress(packed, copy)) {
+        throw std::runtime_error("compressed: compressed twice");
+    }
+
+    // Stream mode reports the compressed length.
+    std::vector<std::uint8_t> stream = packed;
+    stream.push_back(0xEE);
+    std::size_t consumed = 0;
+    (void)ChangeBatchCodec::decode(stream, &consumed);
+    assert_eq("compressed consumed", consumed, packed.size());
+
+    // The plain size is checked against the bounds before expanding.
+    CodecBounds bounds;
+    bounds.max_batch_total_bytes = static_cast<std::uint32_t>(packed.size() + 1);
+    bool caught = false;
+    try {
+        (void)ChangeBatchCodec::decode(packed, nullptr, &bounds);
+    } catch (const std::length_error&) {
+        caught = true;
+    }
+    if (!caught) {
+        throw std::runtime_error("compressed: plain size bound not enforced");
+    }
+}
+#endif
+
 } // namespace
 
 int main() {
@@ -140,5 +372,12 @@ int main() {
     test_roundtrip_idempotent();
     test_roundtrip_no_ops();
     test_roundtrip_stream_mode();
+    test_streamed_ops_match_encode();
+    test_table_names_stored_once();
+    test_decodes_codec_version_1();
+    test_batch_view();
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+    test_roundtrip_compressed();
+#endif
     return 0;
 }
\ No newline at end of file
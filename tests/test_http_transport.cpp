@@ -55,8 +55,10 @@ std::string get_value(const std::shared_ptr<mdbxc::Connection>& conn,
 class LoopbackHttpClient : public mdbxc::sync::IHttpSyncClient {
 public:
     explicit LoopbackHttpClient(mdbxc::sync::HttpSyncServer& server)
-        : m_server(server),
+        : m_server(&server),
           m_cancel_count(0),
+          m_post_count(0),
+          m_last_body_size(0),
           m_last_token_cancellable(false) {}
 
     mdbxc::sync::HttpSyncResponse post(
@@ -67,15 +69,19 @@ public:
         m_last_target = target;
         m_last_content_type = content_type;
         m_last_token_cancellable = cancel_token.can_be_cancelled();
+        ++m_post_count;
+        m_last_body_size = body.size();
 
         mdbxc::sync::HttpSyncRequest request;
         request.method = mdbxc::sync::HttpSyncRoutes::method_post();
         request.target = target;
         request.content_type = content_type;
         request.body = body;
-        return m_server.handle(request);
+        return m_server->handle(request);
     }
 
+    void set_server(mdbxc::sync::HttpSyncServer& server) { m_server = &server; }
+
     void request_cancel() override {
         ++m_cancel_count;
     }
@@ -86,10 +92,14 @@ public:
     }
     bool last_token_cancellable() const { return m_last_token_cancellable; }
     std::size_t cancel_count() const { return m_cancel_count; }
+    std::size_t post_count() const { return m_post_count; }
+    std::size_t last_body_size() const { return m_last_body_size; }
 
 private:
-    mdbxc::sync::HttpSyncServer& m_server;
+    mdbxc::sync::HttpSyncServer* m_server;
     std::size_t m_cancel_count;
+    std::size_t m_post_count;
+    std::size_t m_last_body_size;
     bool m_last_token_cancellable;
     std::string m_last_target;
     std::string m_last_content_type;
@@ -167,6 +177,23 @@ void test_http_peer_pull_and_push_roundtrip() {
     require_true(primary_http.last_token_cancellable(),
                  "HTTP client did not receive cancellation token");
 
+    // Bindings that accept a chunked body get the same bytes as chunks.
+    mdbxc::sync::HttpSyncRequest raw_pull;
+    raw_pull.method = mdbxc::sync::HttpSyncRoutes::method_post();
+    raw_pull.target = mdbxc::sync::HttpSyncRoutes::pull_target();
+    raw_pull.content_type = mdbxc::sync::HttpSyncRoutes::content_type();
+    raw_pull.body =
+        mdbxc::sync::TransportMessageCodec::encode_pull_request(pull);
+    const mdbxc::sync::HttpSyncResponse whole = primary_server.handle(raw_pull);
+    raw_pull.accept_chunked_body = true;
+    const mdbxc::sync::HttpSyncResponse chunked =
+        primary_server.handle(raw_pull);
+    require_true(whole.body_chunks.empty() && chunked.body.empty() &&
+                     chunked.status_code == 200,
+                 "HTTP chunked pull response shape mismatch");
+    require_true(chunked.body_chunks.to_vector() == whole.body,
+                 "HTTP chunked pull body differs from contiguous body");
+
     mdbxc::sync::PushRequest local_apply;
     local_apply.sender = primary_node;
     local_apply.db_id = db_id;
@@ -212,6 +239,100 @@ void test_http_peer_pull_and_push_roundtrip() {
     cleanup(replica_path);
 }
 
+void test_http_peer_cursor_deltas() {
+    const std::string path = "test_http_transport_deltas.mdbx";
+    cleanup(path);
+    std::shared_ptr<mdbxc::Connection> primary = open_db(path);
+    const mdbxc::sync::DbId db_id = make_node(0xD0);
+    mdbxc::sync::SyncEngine engine(primary);
+    engine.initialize_local_identity(make_node(0x10), db_id);
+
+    mdbxc::sync::HttpSyncServer server(engine);
+    LoopbackHttpClient http(server);
+    mdbxc::sync::HttpSyncPeer peer(http);
+
+    mdbxc::sync::PullRequest pull;
+    pull.requester = make_node(0x20);
+    pull.db_id = db_id;
+    for (std::uint8_t i = 0; i < 32; ++i) {
+        pull.have.last_seq_by_origin[make_node(static_cast<std::uint8_t>(0x40 + i))] = i;
+    }
+
+    mdbxc::sync::PullResponse pulled = peer.pull(pull);
+    require_true(pulled.ok && pulled.cursor_baseline_stored,
+                 "first pull must store a cursor baseline");
+    const std::size_t full_size = http.last_body_size();
+    pulled = peer.pull(pull);
+    require_true(pulled.ok && http.post_count() == 2u,
+                 "delta pull failed: " + pulled.error);
+    require_true(http.last_body_size() + 32u * 24u - 16u <= full_size,
+                 "idle pull must send a cursor delta");
+
+    // A server without the baseline makes the peer resend the full cursor.
+    mdbxc::sync::HttpSyncServer restarted(engine);
+    http.set_server(restarted);
+    pulled = peer.pull(pull);
+    require_true(pulled.ok && pulled.cursor_baseline_stored &&
+                     http.post_count() == 4u &&
+                     http.last_body_size() == full_size,
+                 "lost baseline must fall back to a full cursor");
+
+    primary->disconnect();
+    cleanup(path);
+}
+
+void test_http_compression() {
+    const std::string path = "test_http_transport_compression.mdbx";
+    cleanup(path);
+    std::shared_ptr<mdbxc::Connection> primary = open_db(path);
+    const mdbxc::sync::DbId db_id = make_node(0xD0);
+    mdbxc::sync::SyncEngine engine(primary);
+    engine.initialize_local_identity(make_node(0x10), db_id);
+
+    mdbxc::sync::ThreadLocalChangeAccumulator capture(primary);
+    mdbxc::KeyValueTable<int, std::string> ticks(primary, "ticks");
+    primary->attach_sync_capture(&capture);
+    for (int i = 0; i < 64; ++i) {
+        ticks.insert_or_assign(i, "BTC/USD order book snapshot");
+    }
+    primary->detach_sync_capture();
+
+    mdbxc::sync::HttpSyncServer server(engine);
+    mdbxc::sync::TransportCompression compression;
+    compression.enabled = true;
+    compression.min_bytes = 256;
+    server.set_compression(compression);
+
+    mdbxc::sync::PullRequest pull;
+    pull.requester = make_node(0x20);
+    pull.db_id = db_id;
+    pull.max_batches = 100;
+    mdbxc::sync::HttpSyncRequest raw_pull;
+    raw_pull.method = mdbxc::sync::HttpSyncRoutes::method_post();
+    raw_pull.target = mdbxc::sync::HttpSyncRoutes::pull_target();
+    raw_pull.content_type = mdbxc::sync::HttpSyncRoutes::content_type();
+    raw_pull.body =
+        mdbxc::sync::TransportMessageCodec::encode_pull_request(pull);
+    const mdbxc::sync::HttpSyncResponse packed = server.handle(raw_pull);
+    pull.accept_compressed_messages = false;
+    raw_pull.body =
+        mdbxc::sync::TransportMessageCodec::encode_pull_request(pull);
+    const mdbxc::sync::HttpSyncResponse plain = server.handle(raw_pull);
+
+    require_true(!mdbxc::sync::TransportMessageCodec::is_compressed(plain.body),
+                 "requester without compression got a compressed response");
+    require_true(mdbxc::sync::TransportMessageCodec::is_compressed(packed.body) ==
+                     mdbxc::sync::batch_compression_supported(),
+                 "compressed pull response expected with zstd");
+    require_true(mdbxc::sync::TransportMessageCodec::encode_pull_response(
+                     mdbxc::sync::TransportMessageCodec::decode_pull_response(
+                         packed.body)) == plain.body,
+                 "compressed pull response must decode to the plain one");
+
+    primary->disconnect();
+    cleanup(path);
+}
+
 void test_http_server_status_mapping() {
     const std::string path = "test_http_transport_status.mdbx";
     cleanup(path);
@@ -300,9 +421,123 @@ void test_http_peer_rejects_transport_error() {
 
 } // namespace
 
+void test_http_server_pull_page_cache() {
+    const std::string path = "test_http_transport_page_cache.mdbx";
+    cleanup(path);
+
+    std::shared_ptr<mdbxc::Connection> db = open_db(path);
+    const mdbxc::sync::DbId db_id = make_node(0xD2);
+    mdbxc::sync::SyncEngine engine(db);
+    engine.initialize_local_identity(make_node(0x40), db_id);
+    mdbxc::sync::ThreadLocalChangeAccumulator capture(db);
+    mdbxc::KeyValueTable<int, std::string> ticks(db, "ticks");
+    db->attach_sync_capture(&capture);
+    ticks.insert_or_assign(1, "BTC/USD");
+    ticks.insert_or_assign(2, "ETH/USD");
+
+    std::shared_ptr<mdbxc::sync::PullPageCache> pages =
+        std::make_shared<mdbxc::sync::PullPageCache>();
+    mdbxc::sync::HttpSyncServer server(engine);
+    server.set_pull_page_cache(pages);
+
+    mdbxc::sync::PullRequest pull;
+    pull.db_id = db_id;
+    auto pull_as = [&pull, &server](std::uint8_t requester, bool chunked) {
+        pull.requester = make_node(requester);
+        mdbxc::sync::HttpSyncRequest request;
+        request.method = mdbxc::sync::HttpSyncRoutes::method_post();
+        request.target = mdbxc::sync::HttpSyncRoutes::pull_target();
+        request.content_type = mdbxc::sync::HttpSyncRoutes::content_type();
+        request.body = mdbxc::sync::TransportMessageCodec::encode_pull_request(pull);
+        request.accept_chunked_body = chunked;
+        const mdbxc::sync::HttpSyncResponse response = server.handle(request);
+        require_true(response.status_code == 200, "cached pull failed");
+        return chunked ? response.body_chunks.to_vector() : response.body;
+    };
+
+    // Replicas with the same cursor share the page of the first one.
+    const std::vector<std::uint8_t> first = pull_as(0x51, false);
+    require_true(pull_as(0x52, false) == first && pull_as(0x53, true) == first,
+                 "replicas with one cursor must get identical pages");
+    mdbxc::sync::PullPageCache::Stats stats = pages->stats();
+    require_true(stats.misses == 1u && stats.hits == 2u && stats.entries == 1u &&
+                     stats.bytes == first.size(),
+                 "page must be read and encoded once");
+    require_true(mdbxc::sync::TransportMessageCodec::decode_pull_response(first)
+                         .batches.size() == 2u,
+                 "cached page must carry both batches");
+
+    // A commit moves later pulls to a fresh page.
+    ticks.insert_or_assign(3, "SOL/USD");
+    const std::vector<std::uint8_t> second = pull_as(0x51, false);
+    const mdbxc::sync::PullResponse decoded =
+        mdbxc::sync::TransportMessageCodec::decode_pull_response(second);
+    require_true(decoded.batches.size() == 3u, "commit must invalidate the page");
+    stats = pages->stats();
+    require_true(stats.misses == 2u && stats.entries == 1u,
+                 "pages of older transactions must be dropped");
+
+    // Caught-up pulls are not cached, so long-polls keep waiting.
+    pull.have = decoded.remote_have;
+    (void)pull_as(0x51, false);
+    (void)pull_as(0x52, false);
+    stats = pages->stats();
+    require_true(stats.misses == 4u && stats.hits == 2u,
+                 "idle pages must not be shared");
+
+    db->detach_sync_capture();
+    db->disconnect();
+    cleanup(path);
+}
+
+void test_http_server_busy_push() {
+    const std::string path = "test_http_transport_busy.mdbx";
+    cleanup(path);
+
+    std::shared_ptr<mdbxc::Connection> db = open_db(path);
+    mdbxc::sync::SyncEngine engine(db);
+    engine.initialize_local_identity(make_node(0x30), make_node(0xD1));
+    mdbxc::sync::HttpSyncServer server(engine);
+    server.set_push_handler([](const mdbxc::sync::PushRequest&) {
+        mdbxc::sync::PushResponse response;
+        response.ok = false;
+        response.error = "receiver apply queue is full";
+        response.error_code = mdbxc::sync::SyncResponseErrorCode::Busy;
+        response.error_retryable = true;
+        response.retry_after_seconds = 4;
+        return response;
+    });
+
+    LoopbackHttpClient client(server);
+    mdbxc::sync::HttpSyncPeer peer(client);
+    mdbxc::sync::PushRequest request;
+    request.db_id = make_node(0xD1);
+    bool caught = false;
+    try {
+        (void)peer.push(request);
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()).find("503") != std::string::npos;
+    }
+    require_true(caught, "busy push must surface as status 503");
+    const mdbxc::sync::SyncTransportRetryHint hint = peer.last_retry_hint();
+    require_true(hint.available && hint.retryable && hint.has_retry_after &&
+                     hint.retry_after_seconds == 4u,
+                 "busy push must carry its Retry-After delay");
+
+    server.set_push_handler(mdbxc::sync::HttpSyncServer::PushHandler());
+    require_true(peer.push(request).ok, "engine must serve pushes again");
+
+    db->disconnect();
+    cleanup(path);
+}
+
 int main() {
     test_http_peer_pull_and_push_roundtrip();
+    test_http_peer_cursor_deltas();
+    test_http_compression();
     test_http_server_status_mapping();
     test_http_peer_rejects_transport_error();
+    test_http_server_pull_page_cache();
+    test_http_server_busy_push();
     return 0;
 }
@@ -0,0 +1,179 @@
+#include <mdbx_containers/sync.hpp>
+
+#include "test_assert.hpp"
+
+#include <chrono>
+#include <clocale>
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <string>
+
+namespace {
+
+    bool contains(const std::string& text, const std::string& needle) {
+        return text.find(needle) != std::string::npos;
+    }
+
+    void test_families_are_grouped_and_terminated() {
+        mdbxc::sync::SyncWorkerStatus a;
+        a.rounds_started = 3;
+        a.rounds_failed = 1;
+        a.last_progress.remote_tail_known = true;
+        a.last_progress.batches_remaining = 42;
+        mdbxc::sync::SyncWorkerStatus b;
+        b.rounds_started = 7;
+
+        mdbxc::sync::OpenMetricsWriter writer;
+        mdbxc::sync::append_sync_worker_metrics(writer, a, "hub-a");
+        mdbxc::sync::append_sync_worker_metrics(writer, b, "hub\"b");
+        const std::string text = writer.str();
+
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_sync_worker_rounds_started_total{peer=\"hub-a\"} 3\n"
+                  "mdbxc_sync_worker_rounds_started_total{peer=\"hub\\\"b\"} 7\n"));
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_sync_worker_lag_batches{peer=\"hub-a\"} 42\n"));
+        MDBXC_TEST_ASSERT(!contains(
+            text, "mdbxc_sync_worker_lag_batches{peer=\"hub\\\"b\"}"));
+
+        std::size_t type_lines = 0;
+        for (std::size_t pos = 0;
+             (pos = text.find("# TYPE mdbxc_sync_worker_rounds_started ", pos)) !=
+                 std::string::npos;
+             ++pos) {
+            ++type_lines;
+        }
+        MDBXC_TEST_ASSERT(type_lines == 1u);
+        MDBXC_TEST_ASSERT(text.size() >= 6 &&
+                          text.compare(text.size() - 6, 6, "# EOF\n") == 0);
+    }
+
+    void test_transport_latency_histogram() {
+        mdbxc::sync::SyncTransportMetricsSnapshot snapshot;
+        snapshot.pull_calls = 2;
+        snapshot.pull_latency.record(std::chrono::microseconds(50));
+        snapshot.pull_latency.record(std::chrono::milliseconds(3));
+
+        mdbxc::sync::OpenMetricsWriter writer;
+        mdbxc::sync::OpenMetricsLabels labels;
+        labels.push_back(mdbxc::sync::OpenMetricsLabel{"layer", "peer"});
+        mdbxc::sync::append_sync_transport_metrics(writer, snapshot, labels);
+        const std::string text = writer.str();
+
+        MDBXC_TEST_ASSERT(contains(
+            text, "# TYPE mdbxc_sync_transport_latency_seconds histogram\n"));
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_sync_transport_calls_total{layer=\"peer\","
+                  "operation=\"pull\"} 2\n"));
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_sync_transport_latency_seconds_bucket{layer=\"peer\","
+                  "operation=\"pull\",le=\"0.001\"} 1\n"));
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_sync_transport_latency_seconds_bucket{layer=\"peer\","
+                  "operation=\"pull\",le=\"0.005\"} 2\n"));
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_sync_transport_latency_seconds_bucket{layer=\"peer\","
+                  "operation=\"pull\",le=\"+Inf\"} 2\n"));
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_sync_transport_latency_seconds_count{layer=\"peer\","
+                  "operation=\"push\"} 0\n"));
+    }
+
+    void test_table_metrics() {
+        mdbxc::TableMetricsObserver observer;
+        observer.on_table_operation("orders", mdbxc::TableOperation::Insert, 24,
+                                    std::chrono::microseconds(200));
+
+        mdbxc::sync::OpenMetricsWriter writer;
+        mdbxc::sync::append_table_metrics(writer, observer);
+        const std::string text = writer.str();
+
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_table_operations_total{table=\"orders\","
+                  "operation=\"insert\"} 1\n"));
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_table_bytes_total{table=\"orders\","
+                  "operation=\"insert\"} 24\n"));
+        MDBXC_TEST_ASSERT(!contains(text, "operation=\"find\""));
+    }
+
+    void test_key_sampler_metrics() {
+        mdbxc::KeyAccessSampler sampler(1, 4);
+        for (int i = 0; i < 3; ++i) {
+            sampler.offer("orders", mdbxc::TableOperation::Find, "\x01\xab", 2);
+        }
+        sampler.offer("orders", mdbxc::TableOperation::Find, "\x02", 1);
+
+        mdbxc::sync::OpenMetricsWriter writer;
+        mdbxc::sync::append_key_sampler_metrics(writer, sampler, 1);
+        const std::string text = writer.str();
+
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_table_key_samples_total{table=\"orders\","
+                  "operation=\"find\"} 4\n"));
+        MDBXC_TEST_ASSERT(contains(
+            text, "mdbxc_table_hot_key_accesses{table=\"orders\","
+                  "operation=\"find\",key=\"01ab\"} 3\n"));
+        // Only the top key of each table and operation is exported.
+        MDBXC_TEST_ASSERT(!contains(text, "key=\"02\""));
+        MDBXC_TEST_ASSERT(!contains(text, "operation=\"insert\""));
+    }
+
+    void test_gauge_special_values() {
+        mdbxc::sync::OpenMetricsWriter writer;
+        writer.gauge("nan_value", "", std::numeric_limits<double>::quiet_NaN());
+        writer.gauge("pos_inf", "", std::numeric_limits<double>::infinity());
+        writer.gauge("neg_inf", "", -std::numeric_limits<double>::infinity());
+        writer.gauge("ratio", "", 1.5);
+        const std::string text = writer.str();
+
+        MDBXC_TEST_ASSERT(contains(text, "nan_value NaN\n"));
+        MDBXC_TEST_ASSERT(contains(text, "pos_inf +Inf\n"));
+        MDBXC_TEST_ASSERT(contains(text, "neg_inf -Inf\n"));
+        MDBXC_TEST_ASSERT(contains(text, "ratio 1.5\n"));
+    }
+
+    struct CommaDecimal : std::numpunct<char> {
+        char do_decimal_point() const override { return ','; }
+        std::string do_grouping() const override { return "\3"; }
+        char do_thousands_sep() const override { return '.'; }
+    };
+
+    void test_gauge_ignores_locale() {
+        // A comma-decimal C locale is used when the system provides one.
+        const char* const c_locales[] = {"de_DE.UTF-8", "ru_RU.UTF-8", "fr_FR.UTF-8"};
+        const std::string saved_c = std::setlocale(LC_NUMERIC, nullptr);
+        for (std::size_t i = 0; i < sizeof(c_locales) / sizeof(c_locales[0]); ++i) {
+            if (std::setlocale(LC_NUMERIC, c_locales[i]) != nullptr) break;
+        }
+        const std::locale saved = std::locale::global(
+            std::locale(std::locale::classic(), new CommaDecimal()));
+
+        mdbxc::sync::OpenMetricsWriter writer;
+        writer.gauge("ratio", "", 1.5);
+        writer.gauge("large", "", 1234567.0);
+        mdbxc::sync::SyncTransportMetricsSnapshot snapshot;
+        mdbxc::sync::append_sync_transport_metrics(writer, snapshot);
+        const std::string text = writer.str();
+
+        std::locale::global(saved);
+        std::setlocale(LC_NUMERIC, saved_c.c_str());
+
+        MDBXC_TEST_ASSERT(contains(text, "ratio 1.5\n"));
+        MDBXC_TEST_ASSERT(contains(text, "large 1234567\n"));
+        MDBXC_TEST_ASSERT(contains(text, "le=\"0.0001\"}"));
+        MDBXC_TEST_ASSERT(!contains(text, "1,5"));
+    }
+
+} // namespace
+
+int main() {
+    test_families_are_grouped_and_terminated();
+    test_transport_latency_histogram();
+    test_table_metrics();
+    test_key_sampler_metrics();
+    test_gauge_special_values();
+    test_gauge_ignores_locale();
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include <mdbx_containers.hpp>
+#include <mdbx_containers/sync.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+
+namespace {
+
+mdbxc::sync::NodeId make_node(std::uint8_t seed) {
+    mdbxc::sync::NodeId node{};
+    for (int i = 0; i < 16; ++i) {
+        node[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return node;
+}
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+mdbxc::Config config(const std::string& path) {
+    mdbxc::Config cfg;
+    cfg.pathname = path;
+    cfg.no_subdir = true;
+    cfg.max_dbs = 32;
+    return cfg;
+}
+
+std::shared_ptr<mdbxc::Connection> open_db(const std::string& path) {
+    return mdbxc::Connection::create(config(path));
+}
+
+void require_true(bool condition, const std::string& message) {
+    if (!condition) {
+        throw std::runtime_error(message);
+    }
+}
+
+std::string get_value(const std::shared_ptr<mdbxc::Connection>& conn,
+                      mdbxc::KeyValueTable<int, std::string>& table,
+                      int key) {
+    std::string out;
+    auto txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+    if (!table.try_get(key, out, txn.handle())) {
+        throw std::runtime_error("missing replicated value");
+    }
+    return out;
+}
+
+void test_shared_memory_ring_streams_large_messages() {
+    const std::string path = "test_shared_memory_ring.shm";
+    mdbxc::sync::detail::SharedMemorySyncMapping server;
+    server.create(path, 4096);
+    mdbxc::sync::detail::SharedMemorySyncMapping client;
+    client.open(path);
+
+    std::vector<std::uint8_t> message(256 * 1024);
+    for (std::size_t i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<std::uint8_t>(i * 7u);
+    }
+    const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    bool written = false;
+    std::thread writer([&written, &client, &message, deadline]() {
+        written = client.requests().write(client.region(), &message[0],
+                                          message.size(), deadline);
+    });
+    std::vector<std::uint8_t> received(message.size());
+    const bool read = server.requests().read(server.region(), &received[0],
+                                             received.size(), deadline);
+    writer.join();
+    require_true(written && read && received == message,
+                 "ring must stream a message larger than its capacity");
+    cleanup(path);
+}
+
+void test_shared_memory_peer_pull_and_push_roundtrip() {
+    const std::string primary_path = "test_shm_transport_primary.mdbx";
+    const std::string replica_path = "test_shm_transport_replica.mdbx";
+    const std::string region_path = "test_shm_transport.shm";
+    cleanup(primary_path);
+    cleanup(replica_path);
+
+    std::shared_ptr<mdbxc::Connection> primary = open_db(primary_path);
+    std::shared_ptr<mdbxc::Connection> replica = open_db(replica_path);
+    const mdbxc::sync::NodeId primary_node = make_node(0x10);
+    const mdbxc::sync::NodeId replica_node = make_node(0x20);
+    const mdbxc::sync::DbId db_id = make_node(0xD0);
+
+    mdbxc::sync::SyncEngine primary_engine(primary);
+    mdbxc::sync::SyncEngine replica_engine(replica);
+    primary_engine.initialize_local_identity(primary_node, db_id);
+    replica_engine.initialize_local_identity(replica_node, db_id);
+
+    mdbxc::sync::ThreadLocalChangeAccumulator capture(primary);
+    mdbxc::KeyValueTable<int, std::string> primary_ticks(primary, "ticks");
+    primary->attach_sync_capture(&capture);
+    primary_ticks.insert_or_assign(1, "BTC/USD");
+    primary_ticks.insert_or_assign(2, "ETH/USD");
+    primary->detach_sync_capture();
+
+    mdbxc::sync::SharedMemorySyncOptions options;
+    options.ring_bytes = 4096;
+    options.exchange_timeout = std::chrono::milliseconds(10000);
+    mdbxc::sync::SharedMemorySyncServer server(primary_engine, region_path, options);
+    mdbxc::sync::CancellationSource stop;
+    std::thread serving([&server, &stop]() { server.serve(stop.token()); });
+
+    {
+        mdbxc::sync::SharedMemorySyncPeer peer(region_path, options);
+        mdbxc::sync::PullRequest pull;
+        pull.requester = replica_node;
+        pull.db_id = db_id;
+        pull.have = replica_engine.applied_cursor();
+        pull.max_batches = 100;
+        const mdbxc::sync::PullResponse pulled = peer.pull(pull);
+        require_true(pulled.ok && pulled.batches.size() == 2u,
+                     "shared-memory pull failed: " + pulled.error);
+
+        mdbxc::sync::PushRequest apply;
+        apply.sender = primary_node;
+        apply.db_id = db_id;
+        apply.batches = pulled.batches;
+        require_true(replica_engine.handle_push(apply).ok, "local apply failed");
+        mdbxc::KeyValueTable<int, std::string> replica_ticks(replica, "ticks");
+        require_true(get_value(replica, replica_ticks, 2) == "ETH/USD",
+                     "replica value mismatch");
+    }
+
+    // A restarted reader attaches to a clean session on the same region.
+    mdbxc::sync::SharedMemorySyncPeer restarted(region_path, options);
+    mdbxc::sync::PullRequest idle;
+    idle.requester = replica_node;
+    idle.db_id = db_id;
+    idle.have = replica_engine.applied_cursor();
+    const mdbxc::sync::PullResponse none = restarted.pull(idle);
+    require_true(none.ok && none.batches.empty(),
+                 "reattached pull must see no new batches");
+
+    stop.request_cancel();
+    serving.join();
+    primary->disconnect();
+    replica->disconnect();
+    cleanup(primary_path);
+    cleanup(replica_path);
+}
+
+void test_shared_memory_peer_fails_without_server() {
+    const std::string region_path = "test_shm_transport_missing.shm";
+    cleanup(region_path);
+    mdbxc::sync::SharedMemorySyncPeer peer(region_path);
+    bool caught = false;
+    try {
+        (void)peer.pull(mdbxc::sync::PullRequest());
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    require_true(caught, "pull without a server must throw");
+}
+
+} // namespace
+
+int main() {
+    test_shared_memory_ring_streams_large_messages();
+    test_shared_memory_peer_pull_and_push_roundtrip();
+    test_shared_memory_peer_fails_without_server();
+    return 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif
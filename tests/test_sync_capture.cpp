@@ -668,6 +668,64 @@ void test_key_value_bulk_writes_via_sink() {
     }
 }
 
+void test_suppress_unchanged_skips_capture() {
+    using namespace mdbxc;
+    const std::string p = "test_capture_kv_unchanged.mdbx";
+    cleanup(p);
+
+    Config cfg;
+    cfg.pathname = p;
+    cfg.max_dbs = 8;
+    cfg.no_subdir = true;
+    auto conn = Connection::create(cfg);
+
+    StubSink sink;
+    conn->attach_sync_capture(&sink);
+
+    KeyValueTable<int, std::string> kv(conn, "unchanged");
+    kv.set_suppress_unchanged(true);
+    kv.insert_or_assign(1, "one");
+    kv.insert_or_assign(2, "");
+    kv.insert_or_assign(1, "one");
+    kv.insert_or_assign(2, "");
+
+    std::vector<std::pair<int, std::string> > batch;
+    batch.push_back(std::make_pair(1, std::string("one")));
+    batch.push_back(std::make_pair(3, std::string("three")));
+    kv.append(batch);
+
+    std::map<int, std::string> replacement;
+    replacement[1] = "uno";
+    replacement[3] = "three";
+    kv.reconcile(replacement);
+
+    kv.set_suppress_unchanged(false);
+    kv.insert_or_assign(3, "three");
+
+    conn->detach_sync_capture();
+    std::string one;
+    std::string three;
+    kv.try_get(1, one, nullptr);
+    kv.try_get(3, three, nullptr);
+    const bool has_two = kv.contains(2);
+    conn->disconnect();
+    cleanup(p);
+
+    // 1, 2, 3 written once; 1 replaced; 2 deleted; 3 rewritten after opt-out.
+    if (sink.m_recorded.size() != 6u) {
+        throw std::runtime_error("expected six ops with unchanged writes suppressed, got " +
+                                 std::to_string(sink.m_recorded.size()));
+    }
+    if (sink.m_recorded[3].op_type != sync::ChangeOpType::Put ||
+        sink.m_recorded[4].op_type != sync::ChangeOpType::Delete ||
+        sink.m_recorded[5].op_type != sync::ChangeOpType::Put) {
+        throw std::runtime_error("suppressed op sequence unexpected");
+    }
+    if (one != "uno" || three != "three" || has_two) {
+        throw std::runtime_error("suppressed writes changed stored values");
+    }
+}
+
 void test_range_erase_writes_via_sink() {
     using namespace mdbxc;
     const std::string p = "test_capture_range_erase.mdbx";
@@ -889,11 +947,33 @@ void test_any_value_table_does_not_capture_in_v01() {
     cleanup(p);
 }
 
-void test_key_multi_value_table_does_not_capture_in_v01() {
+void require_multi_capture(StubSink& sink,
+                           const char* operation_name,
+                           const std::vector<mdbxc::sync::ChangeOpType>& types,
+                           const std::vector<std::string>& values) {
+    std::lock_guard<std::mutex> lk(sink.m_mutex);
+    if (sink.m_recorded.size() != types.size()) {
+        throw std::runtime_error(std::string(operation_name) + " expected " +
+                                 std::to_string(types.size()) + " ops, got " +
+                                 std::to_string(sink.m_recorded.size()));
+    }
+    for (std::size_t i = 0; i < types.size(); ++i) {
+        const mdbxc::sync::ChangeOp& op = sink.m_recorded[i];
+        const std::string value(op.value.begin(), op.value.end());
+        if (op.dbi_name != "multi_values" || op.op_type != types[i] || value != values[i] ||
+            (op.dbi_flags & MDBX_DUPSORT) == 0) {
+            throw std::runtime_error(std::string(operation_name) +
+                                     " captured an unexpected op at " + std::to_string(i));
+        }
+    }
+    sink.m_recorded.clear();
+}
+
+void test_key_multi_value_table_captures_multiset_ops() {
     using namespace mdbxc;
     typedef KeyMultiValueTable<int, std::string> MultiTable;
-    typedef KeyOrderedMultiValueTable<int, std::string> OrderedMultiTable;
-    const std::string p = "test_capture_key_multi_value_deferred.mdbx";
+    typedef sync::ChangeOpType T;
+    const std::string p = "test_capture_key_multi_value.mdbx";
     cleanup(p);
 
     Config cfg;
@@ -907,44 +987,66 @@ void test_key_multi_value_table_does_not_capture_in_v01() {
         sync::SyncCaptureScope capture(conn, sink);
         MultiTable multi_values(conn, "multi_values");
         multi_values.insert(1, "one");
-        require_no_capture(sink, "KeyMultiValueTable", "insert");
-        multi_values.insert(1, "uno");
-        require_no_capture(sink, "KeyMultiValueTable", "insert repeated key");
+        multi_values.insert(1, "one");
+        // Values travel without the local sequence prefix.
+        require_multi_capture(sink, "insert", { T::MultiInsert, T::MultiInsert },
+                              { "one", "one" });
 
         std::vector<MultiTable::value_type> appended;
         appended.push_back(MultiTable::value_type(2, "two"));
         appended.push_back(MultiTable::value_type(2, "two"));
         multi_values.append(appended);
-        require_no_capture(sink, "KeyMultiValueTable", "append");
+        require_multi_capture(sink, "append", { T::MultiInsert, T::MultiInsert },
+                              { "two", "two" });
 
         std::vector<MultiTable::value_type> reconciled;
         reconciled.push_back(MultiTable::value_type(1, "one"));
+        reconciled.push_back(MultiTable::value_type(2, "two"));
+        reconciled.push_back(MultiTable::value_type(2, "two"));
         reconciled.push_back(MultiTable::value_type(3, "three"));
         multi_values.reconcile(reconciled);
-        require_no_capture(sink, "KeyMultiValueTable", "reconcile");
+        require_multi_capture(sink, "reconcile", { T::MultiEraseOne, T::MultiInsert },
+                              { "one", "three" });
 
-        multi_values.erase(1, "one");
-        require_no_capture(sink, "KeyMultiValueTable", "erase value");
+        if (multi_values.erase(2, "two") != 2u) {
+            throw std::runtime_error("KeyMultiValueTable::erase(key, value) removed wrong count");
+        }
+        require_multi_capture(sink, "erase value", { T::MultiEraseAll }, { "two" });
         multi_values.erase(3);
-        require_no_capture(sink, "KeyMultiValueTable", "erase key");
+        require_multi_capture(sink, "erase key", { T::Delete }, { "" });
 
         multi_values.insert(4, "four");
-        require_no_capture(sink, "KeyMultiValueTable", "prepare erase_range");
+        multi_values.insert(4, "vier");
         multi_values.insert(5, "five");
-        require_no_capture(sink, "KeyMultiValueTable", "prepare erase_range");
-        if (multi_values.erase_range(4, 5) == 0u) {
+        sink.clear_recorded();
+        if (multi_values.erase_range(4, 5) != 3u) {
             throw std::runtime_error("KeyMultiValueTable::erase_range did not remove prepared rows");
         }
-        require_no_capture(sink, "KeyMultiValueTable", "erase_range");
+        require_multi_capture(sink, "erase_range", { T::Delete, T::Delete }, { "", "" });
 
-        multi_values.insert(6, "six");
-        require_no_capture(sink, "KeyMultiValueTable", "prepare clear");
-        if (multi_values.empty()) {
-            throw std::runtime_error("KeyMultiValueTable clear precondition is empty");
-        }
         multi_values.clear();
-        require_no_capture(sink, "KeyMultiValueTable", "clear");
+        require_multi_capture(sink, "clear", { T::ClearTable }, { "" });
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_key_ordered_multi_value_table_does_not_capture_in_v01() {
+    using namespace mdbxc;
+    typedef KeyOrderedMultiValueTable<int, std::string> OrderedMultiTable;
+    const std::string p = "test_capture_key_ordered_multi_value_deferred.mdbx";
+    cleanup(p);
+
+    Config cfg;
+    cfg.pathname = p;
+    cfg.max_dbs = 8;
+    cfg.no_subdir = true;
+    auto conn = Connection::create(cfg);
 
+    StubSink sink;
+    {
+        sync::SyncCaptureScope capture(conn, sink);
         OrderedMultiTable ordered_multi_values(conn, "ordered_multi_values");
         ordered_multi_values.append(1, "one");
         require_no_capture(sink, "KeyOrderedMultiValueTable", "append");
@@ -1209,6 +1311,237 @@ void test_explicit_rollback_does_not_flush() {
 }
 
 
+void test_interleaved_accumulators_keep_ops_apart() {
+    using namespace mdbxc;
+    const std::string p1 = "test_capture_interleaved_a.mdbx";
+    const std::string p2 = "test_capture_interleaved_b.mdbx";
+    cleanup(p1);
+    cleanup(p2);
+
+    Config cfg;
+    cfg.max_dbs = 8;
+    cfg.no_subdir = true;
+    cfg.pathname = p1;
+    auto conn1 = Connection::create(cfg);
+    cfg.pathname = p2;
+    auto conn2 = Connection::create(cfg);
+
+    sync::NodeId n{};
+    n[0] = 0xB2;
+    for (std::shared_ptr<Connection> conn : { conn1, conn2 }) {
+        sync::MetaStore meta(conn->env_handle());
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        meta.open(txn.handle());
+        meta.set_node_id(txn.handle(), n);
+        txn.commit();
+    }
+
+    sync::ThreadLocalChangeAccumulator sink1(conn1);
+    sync::ThreadLocalChangeAccumulator sink2(conn2);
+    conn1->attach_sync_capture(&sink1);
+    conn2->attach_sync_capture(&sink2);
+
+    /// Both write transactions live on this thread, so each op switches the
+    /// thread-local capture slot to the other accumulator.
+    KeyValueTable<int, int> kv1(conn1, "t");
+    KeyValueTable<int, int> kv2(conn2, "t");
+    {
+        auto txn1 = conn1->transaction(TransactionMode::WRITABLE);
+        auto txn2 = conn2->transaction(TransactionMode::WRITABLE);
+        kv1.insert_or_assign(1, 100);
+        kv2.insert_or_assign(10, 1000);
+        kv1.insert_or_assign(2, 200);
+        kv2.insert_or_assign(20, 2000);
+        txn1.commit();
+        kv2.insert_or_assign(30, 3000);
+        txn2.commit();
+    }
+    kv1.insert_or_assign(3, 300);
+
+    conn1->detach_sync_capture();
+    conn2->detach_sync_capture();
+
+    auto read_batch = [&n](const std::shared_ptr<Connection>& conn,
+                           std::uint64_t seq) -> sync::ChangeBatch {
+        sync::ChangeLogStore cl(conn->env_handle());
+        {
+            auto txn = conn->transaction(TransactionMode::WRITABLE);
+            cl.open(txn.handle());
+            txn.commit();
+        }
+        std::vector<std::uint8_t> bytes;
+        auto txn = conn->transaction(TransactionMode::READ_ONLY);
+        if (!cl.get(txn.handle(), n, seq, bytes)) {
+            throw std::runtime_error("changelog missing seq " + std::to_string(seq));
+        }
+        return sync::ChangeBatchCodec::decode_exact(bytes);
+    };
+    auto expect_keys = [](const sync::ChangeBatch& batch, const std::vector<int>& keys,
+                          const char* label) {
+        if (batch.ops.size() != keys.size()) {
+            throw std::runtime_error(std::string(label) + ": unexpected op count");
+        }
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (batch.ops[i].storage_key != storage_key_bytes(keys[i])) {
+                throw std::runtime_error(std::string(label) + ": unexpected key order");
+            }
+        }
+    };
+
+    expect_keys(read_batch(conn1, 1), { 1, 2 }, "conn1 seq 1");
+    expect_keys(read_batch(conn2, 1), { 10, 20, 30 }, "conn2 seq 1");
+    expect_keys(read_batch(conn1, 2), { 3 }, "conn1 seq 2");
+
+    conn1->disconnect();
+    conn2->disconnect();
+    cleanup(p1);
+    cleanup(p2);
+}
+
+void test_cached_local_seq_follows_foreign_commits() {
+    using namespace mdbxc;
+    const std::string p = "test_capture_cached_seq.mdbx";
+    cleanup(p);
+
+    Config cfg;
+    cfg.pathname = p;
+    cfg.max_dbs = 8;
+    cfg.no_subdir = true;
+    auto conn = Connection::create(cfg);
+
+    sync::NodeId n{};
+    n[0] = 0xC3;
+    {
+        sync::MetaStore meta(conn->env_handle());
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        meta.open(txn.handle());
+        meta.set_node_id(txn.handle(), n);
+        txn.commit();
+    }
+
+    sync::ThreadLocalChangeAccumulator sink(conn);
+    conn->attach_sync_capture(&sink);
+    KeyValueTable<int, int> kv(conn, "t");
+
+    /// Back-to-back commits reuse the store handles and the in-memory seq.
+    for (int i = 1; i <= 3; ++i) {
+        kv.insert_or_assign(i, i * 10);
+    }
+
+    /// A commit the accumulator did not flush, here moving local_seq as a
+    /// second writer would, must be picked up from _mdbxc_meta.
+    {
+        sync::MetaStore meta(conn->env_handle());
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        meta.open(txn.handle());
+        meta.set_local_seq(txn.handle(), 10);
+        txn.commit();
+    }
+    kv.insert_or_assign(4, 40);
+    kv.insert_or_assign(5, 50);
+
+    conn->detach_sync_capture();
+
+    sync::ChangeLogStore cl(conn->env_handle());
+    sync::MetaStore meta(conn->env_handle());
+    {
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        cl.open(txn.handle());
+        meta.open(txn.handle());
+        txn.commit();
+    }
+    {
+        auto txn = conn->transaction(TransactionMode::READ_ONLY);
+        const std::uint64_t expected[] = { 1, 2, 3, 11, 12 };
+        for (std::size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i) {
+            if (!cl.contains(txn.handle(), n, expected[i])) {
+                throw std::runtime_error("changelog missing seq " +
+                                         std::to_string(expected[i]));
+            }
+        }
+        if (cl.contains(txn.handle(), n, 4)) {
+            throw std::runtime_error("stale cached seq reused after a foreign commit");
+        }
+        if (meta.get_local_seq(txn.handle()) != 12) {
+            throw std::runtime_error("local_seq was not written through");
+        }
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+void test_compressed_changelog_batches() {
+    using namespace mdbxc;
+    const std::string p = "test_capture_compressed.mdbx";
+    cleanup(p);
+
+    Config cfg;
+    cfg.pathname = p;
+    cfg.max_dbs = 8;
+    cfg.no_subdir = true;
+    auto conn = Connection::create(cfg);
+
+    sync::NodeId n{};
+    n[0] = 0xC4;
+    {
+        sync::MetaStore meta(conn->env_handle());
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        meta.open(txn.handle());
+        meta.set_node_id(txn.handle(), n);
+        txn.commit();
+    }
+
+    sync::BatchCompression compression;
+    compression.enabled = true;
+    compression.min_bytes = 256;
+    sync::ThreadLocalChangeAccumulator sink(conn, compression);
+    conn->attach_sync_capture(&sink);
+    KeyValueTable<int, std::string> kv(conn, "ticks");
+
+    /// One small batch below the threshold, then one large repetitive batch.
+    kv.insert_or_assign(0, "x");
+    {
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        for (int i = 1; i <= 64; ++i) {
+            kv.insert_or_assign(i, std::string(32, 'p'), txn.handle());
+        }
+        txn.commit();
+    }
+    conn->detach_sync_capture();
+
+    sync::ChangeLogStore cl(conn->env_handle());
+    {
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        cl.open(txn.handle());
+        txn.commit();
+    }
+    {
+        auto txn = conn->transaction(TransactionMode::READ_ONLY);
+        std::vector<std::uint8_t> small;
+        std::vector<std::uint8_t> large;
+        if (!cl.get(txn.handle(), n, 1, small) || !cl.get(txn.handle(), n, 2, large)) {
+            throw std::runtime_error("compressed batches missing from changelog");
+        }
+        const sync::ChangeBatch b1 = sync::ChangeBatchCodec::decode_exact(small);
+        const sync::ChangeBatch b2 = sync::ChangeBatchCodec::decode_exact(large);
+        if (b1.batch_flags != sync::BATCH_NONE) {
+            throw std::runtime_error("batch below the threshold was compressed");
+        }
+        if (b2.batch_flags != sync::BATCH_COMPRESSED_ZSTD || b2.ops.size() != 64) {
+            throw std::runtime_error("large batch was not stored compressed");
+        }
+        if (large.size() >= 64 * 32) {
+            throw std::runtime_error("compressed batch did not shrink");
+        }
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+#endif
+
 void test_aborted_transaction_does_not_flush() {
     using namespace mdbxc;
     const std::string p = "test_capture_aborted.mdbx";
@@ -1341,6 +1674,8 @@ int main(int argc, char** argv) {
           &test_value_table_writes_storage_key_via_sink },
         { "test_key_value_bulk_writes_via_sink",
           &test_key_value_bulk_writes_via_sink },
+        { "test_suppress_unchanged_skips_capture",
+          &test_suppress_unchanged_skips_capture },
         { "test_range_erase_writes_via_sink", &test_range_erase_writes_via_sink },
         { "test_clear_writes_via_sink", &test_clear_writes_via_sink },
         { "test_vector_store_writes_via_sink",
@@ -1348,12 +1683,21 @@ int main(int argc, char** argv) {
         { "test_capture_flush_on_commit", &test_capture_flush_on_commit },
         { "test_any_value_table_does_not_capture_in_v01",
           &test_any_value_table_does_not_capture_in_v01 },
-        { "test_key_multi_value_table_does_not_capture_in_v01",
-          &test_key_multi_value_table_does_not_capture_in_v01 },
+        { "test_key_multi_value_table_captures_multiset_ops",
+          &test_key_multi_value_table_captures_multiset_ops },
+        { "test_key_ordered_multi_value_table_does_not_capture_in_v01",
+          &test_key_ordered_multi_value_table_does_not_capture_in_v01 },
         { "test_hashed_key_value_store_does_not_capture_in_v01",
           &test_hashed_key_value_store_does_not_capture_in_v01 },
         { "test_changelog_capture_roundtrip", &test_changelog_capture_roundtrip },
         { "test_zero_node_id_rejected", &test_zero_node_id_rejected },
+        { "test_interleaved_accumulators_keep_ops_apart",
+          &test_interleaved_accumulators_keep_ops_apart },
+        { "test_cached_local_seq_follows_foreign_commits",
+          &test_cached_local_seq_follows_foreign_commits },
+#if defined(MDBXC_HAS_ZSTD) && MDBXC_HAS_ZSTD
+        { "test_compressed_changelog_batches", &test_compressed_changelog_batches },
+#endif
         { "test_aborted_transaction_does_not_flush",
           &test_aborted_transaction_does_not_flush },
         { "test_explicit_rollback_does_not_flush",
@@ -0,0 +1,252 @@
+/// \file test_sync_coroutines.cpp
+/// \brief C++20 coroutine writes, async peers and CoroSyncWorker tests.
+
+#include <mdbx_containers.hpp>
+#include <mdbx_containers/coroutine.hpp>
+#include <mdbx_containers/sync.hpp>
+
+#include <cstdio>
+#include <iostream>
+
+#if MDBXC_HAS_COROUTINES
+
+#include <mdbx_containers/detail/ThreadPool.hpp>
+#include <mdbx_containers/sync/CoroSyncWorker.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void cleanup(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-lck").c_str());
+}
+
+mdbxc::sync::NodeId make_node(std::uint8_t seed) {
+    mdbxc::sync::NodeId node{};
+    for (int i = 0; i < 16; ++i) {
+        node[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return node;
+}
+
+std::shared_ptr<mdbxc::Connection> open_env(const std::string& path) {
+    mdbxc::Config config;
+    config.pathname = path;
+    config.max_dbs = 16;
+    config.no_subdir = true;
+    return mdbxc::Connection::create(config);
+}
+
+/// Completes every post on a pool thread, like a client with its own I/O loop.
+class PooledHttpClient : public mdbxc::sync::IAsyncHttpSyncClient {
+public:
+    PooledHttpClient(const mdbxc::sync::HttpSyncServer& server,
+                     mdbxc::detail::ThreadPool& pool)
+        : m_server(server), m_pool(pool) {}
+
+    void async_post(const std::string& target,
+                    const std::string& content_type,
+                    const std::vector<std::uint8_t>& body,
+                    const mdbxc::sync::CancellationToken&,
+                    Callback done) override {
+        mdbxc::sync::HttpSyncRequest request;
+        request.method = mdbxc::sync::HttpSyncRoutes::method_post();
+        request.target = target;
+        request.content_type = content_type;
+        request.body = body;
+        const mdbxc::sync::HttpSyncServer* server = &m_server;
+        ++posts;
+        m_pool.post([server, request, done]() {
+            done(std::exception_ptr(), server->handle(request));
+        });
+    }
+
+    std::atomic<int> posts{0};
+
+private:
+    const mdbxc::sync::HttpSyncServer& m_server;
+    mdbxc::detail::ThreadPool& m_pool;
+};
+
+struct ReplicaPair {
+    std::shared_ptr<mdbxc::Connection> primary_conn;
+    std::shared_ptr<mdbxc::Connection> replica_conn;
+    std::unique_ptr<mdbxc::sync::SyncEngine> primary;
+    std::unique_ptr<mdbxc::sync::SyncEngine> replica;
+
+    ReplicaPair(const std::string& prefix, int records) {
+        cleanup(prefix + "_primary.mdbx");
+        cleanup(prefix + "_replica.mdbx");
+        primary_conn = open_env(prefix + "_primary.mdbx");
+        replica_conn = open_env(prefix + "_replica.mdbx");
+        primary.reset(new mdbxc::sync::SyncEngine(primary_conn));
+        replica.reset(new mdbxc::sync::SyncEngine(replica_conn));
+        const mdbxc::sync::NodeId db_id = make_node(0xD0);
+        primary->initialize_local_identity(make_node(0xA0), db_id);
+        replica->initialize_local_identity(make_node(0xB0), db_id);
+
+        mdbxc::sync::ThreadLocalChangeAccumulator sink(primary_conn);
+        primary_conn->attach_sync_capture(&sink);
+        {
+            mdbxc::KeyValueTable<int, int> kv(primary_conn, "kv");
+            for (int i = 1; i <= records; ++i) {
+                kv.insert_or_assign(i, i * 10);
+            }
+        }
+        primary_conn->detach_sync_capture();
+    }
+
+    void expect_replicated(int records) const {
+        mdbxc::KeyValueTable<int, int> kv(replica_conn, "kv");
+        for (int i = 1; i <= records; ++i) {
+            const std::optional<int> value = kv.find(i);
+            if (!value || *value != i * 10) {
+                throw std::runtime_error("replica misses key " + std::to_string(i));
+            }
+        }
+    }
+};
+
+mdbxc::coro::Task<void> write_one(mdbxc::Connection& conn,
+                                  mdbxc::KeyValueTable<int, int>& kv,
+                                  int key) {
+    co_await mdbxc::coro::write(conn, [&kv, key](MDBX_txn* txn) {
+        kv.insert_or_assign(key, key * 2, txn);
+    });
+}
+
+mdbxc::coro::Task<bool> failing_write(mdbxc::Connection& conn) {
+    try {
+        co_await mdbxc::coro::write(conn, [](MDBX_txn*) {
+            throw std::runtime_error("rejected");
+        });
+    } catch (const std::runtime_error&) {
+        co_return true;
+    }
+    co_return false;
+}
+
+void test_awaitable_writes() {
+    const std::string path = "test_coro_writes.mdbx";
+    cleanup(path);
+    std::shared_ptr<mdbxc::Connection> conn = open_env(path);
+    mdbxc::KeyValueTable<int, int> kv(conn, "kv");
+
+    // Many suspended writers share the single writer thread.
+    const int writers = 200;
+    std::atomic<int> remaining(writers);
+    std::promise<void> all_done;
+    for (int i = 0; i < writers; ++i) {
+        mdbxc::coro::spawn(write_one(*conn, kv, i), [&all_done, &remaining](std::exception_ptr error) {
+            if (error) {
+                all_done.set_exception(error);
+            } else if (--remaining == 0) {
+                all_done.set_value();
+            }
+        });
+    }
+    all_done.get_future().get();
+    for (int i = 0; i < writers; ++i) {
+        const std::optional<int> value = kv.find(i);
+        if (!value || *value != i * 2) {
+            throw std::runtime_error("awaited write is missing");
+        }
+    }
+    if (!mdbxc::coro::sync_wait(failing_write(*conn))) {
+        throw std::runtime_error("write error was not rethrown in the coroutine");
+    }
+    conn->disconnect();
+    cleanup(path);
+}
+
+void test_coro_worker_over_async_http() {
+    ReplicaPair pair("test_coro_http", 5);
+    mdbxc::sync::HttpSyncServer server(*pair.primary);
+    mdbxc::detail::ThreadPool pool(2);
+    PooledHttpClient client(server, pool);
+    mdbxc::sync::AsyncHttpSyncPeer peer(client);
+
+    mdbxc::sync::SyncWorkerOptions options;
+    options.max_batches = 2;
+    mdbxc::sync::CoroSyncWorker worker(*pair.replica, peer, options);
+    const mdbxc::sync::SyncWorkerRoundResult result =
+        mdbxc::coro::sync_wait(worker.run_once());
+    if (!result.ok) {
+        throw std::runtime_error("coroutine round failed: " + result.error);
+    }
+    if (result.pages_pulled != 3u || result.batches_applied != 5u) {
+        throw std::runtime_error("coroutine round did not drain paginated pull");
+    }
+    if (client.posts.load() < 3) {
+        throw std::runtime_error("pulls did not go through the async client");
+    }
+    pair.expect_replicated(5);
+}
+
+void test_coro_worker_loop_over_adapter() {
+    ReplicaPair pair("test_coro_loop", 4);
+    mdbxc::sync::DirectSyncPeer direct(pair.primary.get());
+    mdbxc::sync::AsyncSyncPeerAdapter peer(
+        direct, [](std::function<void()> task) { task(); });
+
+    mdbxc::sync::SyncWorkerOptions options;
+    options.idle_interval = std::chrono::milliseconds(5);
+    mdbxc::sync::CoroSyncWorker worker(*pair.replica, peer, options);
+
+    // The loop sleeps on this scheduler; stop after the second idle delay.
+    int delays = 0;
+    mdbxc::coro::Scheduler scheduler =
+        [&delays, &options, &worker](std::chrono::milliseconds delay, std::function<void()> fire) {
+            if (delay != options.idle_interval) {
+                throw std::runtime_error("unexpected loop delay");
+            }
+            if (++delays == 2) {
+                worker.request_stop();
+            }
+            fire();
+        };
+    mdbxc::coro::sync_wait(worker.run(scheduler));
+    if (delays != 2 || !worker.stop_requested() || !worker.last_error().empty()) {
+        throw std::runtime_error("coroutine loop did not stop cleanly");
+    }
+    pair.expect_replicated(4);
+}
+
+} // namespace
+
+int main() {
+    struct Case { const char* name; void (*fn)(); };
+    const Case cases[] = {
+        { "test_awaitable_writes", &test_awaitable_writes },
+        { "test_coro_worker_over_async_http", &test_coro_worker_over_async_http },
+        { "test_coro_worker_loop_over_adapter", &test_coro_worker_loop_over_adapter },
+    };
+    for (const Case& c : cases) {
+        try {
+            c.fn();
+            std::cout << "[ok] " << c.name << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << "[fail] " << c.name << ": " << e.what() << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "C++20 coroutines are not enabled; skipped.\n";
+    return 0;
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include <mdbx_containers.hpp>
 #include <mdbx_containers/sync.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
@@ -8,6 +9,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <optional>
+#include <new>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -67,6 +69,7 @@ public:
         applied_batches = event.applied_batches;
         applied_ops = event.applied_ops;
         affected_dbi_names = event.affected_dbi_names;
+        applied_keys = event.applied_keys;
     }
 
     std::size_t calls;
@@ -74,6 +77,7 @@ public:
     std::size_t applied_batches;
     std::size_t applied_ops;
     std::vector<std::string> affected_dbi_names;
+    std::vector<mdbxc::sync::SyncAppliedKey> applied_keys;
 };
 
 class ThrowingApplyObserver : public mdbxc::sync::ISyncApplyObserver {
@@ -261,6 +265,14 @@ const char* op_type_name(mdbxc::sync::ChangeOpType type) {
             return "Delete";
         case mdbxc::sync::ChangeOpType::ClearTable:
             return "ClearTable";
+        case mdbxc::sync::ChangeOpType::Merge:
+            return "Merge";
+        case mdbxc::sync::ChangeOpType::MultiInsert:
+            return "MultiInsert";
+        case mdbxc::sync::ChangeOpType::MultiEraseOne:
+            return "MultiEraseOne";
+        case mdbxc::sync::ChangeOpType::MultiEraseAll:
+            return "MultiEraseAll";
     }
     return "unknown";
 }
@@ -523,6 +535,224 @@ void test_engine_reserved_dbi_rolls_back_multi_batch_push() {
     cleanup(p);
 }
 
+void test_engine_handle_push_coalesces_overwritten_ops() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_push_coalesce.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    sync::SyncEngine engine(conn);
+    const sync::NodeId local = make_node(0xA7);
+    const sync::NodeId origin_x = make_node(0xB7);
+    const sync::NodeId origin_y = make_node(0xC7);
+    const sync::DbId db_id = make_node(0xD7);
+    engine.initialize_local_identity(local, db_id);
+    KeyValueTable<int, int> hot(conn, "hot");
+
+    auto make_op = [](sync::ChangeOpType type, int key, int value) {
+        sync::ChangeOp op;
+        op.op_type = type;
+        op.dbi_name = "hot";
+        op.dbi_flags = static_cast<std::uint32_t>(MDBX_INTEGERKEY);
+        assign_int_key(op.storage_key, key);
+        if (type == sync::ChangeOpType::Put) {
+            assign_int_value(op.value, value);
+        }
+        return op;
+    };
+    auto make_batch = [](const sync::NodeId& origin, std::uint64_t seq,
+                          const sync::ChangeOp& op) {
+        sync::ChangeBatch batch;
+        batch.origin_node_id = origin;
+        batch.seq = seq;
+        batch.ops.push_back(op);
+        return batch;
+    };
+
+    sync::PushRequest first;
+    first.sender = origin_y;
+    first.db_id = db_id;
+    first.batches.push_back(make_batch(origin_y, 1, make_op(sync::ChangeOpType::Put, 1, 10)));
+    if (!engine.handle_push(first).ok) {
+        throw std::runtime_error("first push failed");
+    }
+
+    // The replayed batch of origin_y is skipped, so it must not hide the
+    // earlier write of origin_x to the same key.
+    sync::PushRequest replay;
+    replay.sender = origin_x;
+    replay.db_id = db_id;
+    replay.batches.push_back(make_batch(origin_x, 1, make_op(sync::ChangeOpType::Put, 1, 20)));
+    replay.batches.push_back(make_batch(origin_y, 1, make_op(sync::ChangeOpType::Put, 1, 10)));
+    if (!engine.handle_push(replay).ok) {
+        throw std::runtime_error("replay push failed");
+    }
+    if (kv_or_throw(conn, hot, 1, "key 1 after replay") != 20) {
+        throw std::runtime_error("skipped batch superseded an applied write");
+    }
+
+    sync::PushRequest burst;
+    burst.sender = origin_x;
+    burst.db_id = db_id;
+    burst.batches.push_back(make_batch(origin_x, 2, make_op(sync::ChangeOpType::Put, 2, 1)));
+    burst.batches.push_back(make_batch(origin_x, 3, make_op(sync::ChangeOpType::Put, 2, 2)));
+    burst.batches.push_back(make_batch(origin_x, 4, make_op(sync::ChangeOpType::Delete, 2, 0)));
+    burst.batches.push_back(make_batch(origin_x, 5, make_op(sync::ChangeOpType::Put, 2, 3)));
+    burst.batches.push_back(make_batch(origin_x, 6, make_op(sync::ChangeOpType::Put, 3, 1)));
+    burst.batches.push_back(make_batch(origin_x, 7, make_op(sync::ChangeOpType::Delete, 3, 0)));
+    burst.batches.push_back(make_batch(origin_y, 2, make_op(sync::ChangeOpType::Put, 1, 30)));
+    if (!engine.handle_push(burst).ok) {
+        throw std::runtime_error("burst push failed");
+    }
+    if (kv_or_throw(conn, hot, 2, "key 2 after burst") != 3 || kv_has(conn, hot, 3) ||
+        kv_or_throw(conn, hot, 1, "key 1 after burst") != 30) {
+        throw std::runtime_error("coalesced push left the wrong values");
+    }
+    const sync::SyncCursor have = engine.applied_cursor();
+    if (have.last_seq_for(origin_x) != 7u || have.last_seq_for(origin_y) != 2u) {
+        throw std::runtime_error("coalesced push lost applied sequences");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_engine_handle_push_yields_to_local_writers() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_push_slices.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    sync::SyncEngine engine(conn);
+    const sync::NodeId origin = make_node(0xB9);
+    const sync::DbId db_id = make_node(0xD9);
+    engine.initialize_local_identity(make_node(0xA9), db_id);
+    KeyValueTable<int, int> hot(conn, "hot");
+
+    const int batches = 16;
+    const int ops_per_batch = 1100;
+    sync::PushRequest req;
+    req.sender = origin;
+    req.db_id = db_id;
+    for (int b = 0; b < batches; ++b) {
+        sync::ChangeBatch batch;
+        batch.origin_node_id = origin;
+        batch.seq = static_cast<std::uint64_t>(b + 1);
+        for (int k = 0; k < ops_per_batch; ++k) {
+            sync::ChangeOp op;
+            op.op_type = sync::ChangeOpType::Put;
+            op.dbi_name = "hot";
+            op.dbi_flags = static_cast<std::uint32_t>(MDBX_INTEGERKEY);
+            // Every batch rewrites half of the previous batch's keys.
+            const int key = b * ops_per_batch / 2 + k;
+            assign_int_key(op.storage_key, key);
+            assign_int_value(op.value, b);
+            batch.ops.push_back(op);
+        }
+        req.batches.push_back(batch);
+    }
+
+    // A local writer that never begins keeps every slice check true; each
+    // yield then ends at the limit.
+    WriterScheduler& scheduler = conn->writer_scheduler();
+    scheduler.configure(std::chrono::milliseconds(1), std::chrono::milliseconds(1));
+    {
+        const WriterScheduler::WaitScope waiting(scheduler);
+        if (scheduler.local_waiters() != 1u) {
+            throw std::runtime_error("local writer not counted");
+        }
+        if (!engine.handle_push(req).ok) {
+            throw std::runtime_error("sliced push failed");
+        }
+    }
+    scheduler.configure(std::chrono::milliseconds(0), std::chrono::milliseconds(50));
+    const WriterScheduler::Stats stats = scheduler.stats();
+    if (stats.yields == 0u || stats.yield_timeouts != stats.yields) {
+        throw std::runtime_error("sliced push did not yield");
+    }
+
+    // Slices committed separately still leave the state of one push.
+    const int last_key = (batches - 1) * ops_per_batch / 2 + ops_per_batch - 1;
+    for (int key = 0; key <= last_key; ++key) {
+        const int newest = (std::min)(key * 2 / ops_per_batch, batches - 1);
+        if (kv_or_throw(conn, hot, key, "key after sliced push") != newest) {
+            throw std::runtime_error("sliced push left the wrong value");
+        }
+    }
+    if (engine.applied_cursor().last_seq_for(origin) != static_cast<std::uint64_t>(batches)) {
+        throw std::runtime_error("sliced push lost applied sequences");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_engine_handle_push_nothrow_status() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_push_nothrow.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    sync::SyncEngine engine(conn);
+    const sync::NodeId origin = make_node(0xB8);
+    const sync::DbId db_id = make_node(0xD8);
+    engine.initialize_local_identity(make_node(0xA8), db_id);
+
+    auto make_batch = [&origin](std::uint64_t seq) {
+        sync::ChangeBatch batch;
+        batch.origin_node_id = origin;
+        batch.seq = seq;
+        sync::ChangeOp op;
+        op.op_type = sync::ChangeOpType::Put;
+        op.dbi_name = "t";
+        op.storage_key = { static_cast<std::uint8_t>(seq) };
+        op.value = { 0x01 };
+        batch.ops.push_back(op);
+        return batch;
+    };
+
+    sync::PushRequest req;
+    req.sender = origin;
+    req.db_id = db_id;
+    req.batches.push_back(make_batch(1));
+    sync::PushResponse resp;
+    Status st = engine.handle_push(std::nothrow, req, resp);
+    if (!st.ok() || !resp.ok || resp.receiver_have.last_seq_for(origin) != 1u) {
+        throw std::runtime_error("nothrow push should apply");
+    }
+
+    // A gap is a conflict; its reason is in the status, not in resp.error.
+    req.batches.clear();
+    req.batches.push_back(make_batch(3));
+    st = engine.handle_push(std::nothrow, req, resp);
+    if (st.code() != StatusCode::Conflict ||
+        std::string(st.context()) != "sequence_gap" || st.exception() ||
+        resp.ok || !resp.error.empty() ||
+        resp.error_code != sync::SyncResponseErrorCode::ApplyConflict ||
+        !resp.error_retryable) {
+        throw std::runtime_error("nothrow push gap status incorrect");
+    }
+    if (st.message() != "conflict: sequence_gap") {
+        throw std::runtime_error("nothrow push gap message incorrect");
+    }
+
+    req.db_id = make_node(0xFF);
+    st = engine.handle_push(std::nothrow, req, resp);
+    if (st.code() != StatusCode::Rejected ||
+        std::string(st.context()) != "db_id_mismatch" || !resp.error.empty() ||
+        resp.error_code != sync::SyncResponseErrorCode::DbIdMismatch) {
+        throw std::runtime_error("nothrow push db_id status incorrect");
+    }
+
+    // The throwing overload still fills the error text.
+    if (engine.handle_push(req).error != "db_id mismatch") {
+        throw std::runtime_error("handle_push lost its error text");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
 void test_engine_skips_self_origin() {
     using namespace mdbxc;
     const std::string p = "test_engine_self_origin.mdbx";
@@ -692,6 +922,79 @@ void test_engine_conflicting_dbi_flags_returns_conflict() {
     cleanup(p);
 }
 
+void test_engine_sorted_apply_matches_capture_order() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_sorted_apply.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    seed_node_id(conn, make_node(0x10));
+    sync::SyncEngine engine(conn);
+    KeyValueTable<int, int> kv(conn, "kv");
+    KeyValueTable<int, int> other(conn, "other");
+    const sync::NodeId origin = make_node(0x21);
+
+    auto make_op = [](const char* dbi, sync::ChangeOpType type, int key, int value) {
+        sync::ChangeOp op;
+        op.op_type = type;
+        op.dbi_name = dbi;
+        op.dbi_flags = static_cast<std::uint32_t>(MDBX_INTEGERKEY);
+        assign_int_key(op.storage_key, key);
+        if (type == sync::ChangeOpType::Put) {
+            assign_int_value(op.value, value);
+        }
+        return op;
+    };
+
+    // Distinct keys in scattered order across two DBIs take the sorted path.
+    sync::ChangeBatch scattered;
+    scattered.origin_node_id = origin;
+    scattered.seq = 1;
+    const int keys[] = { 907, 3, 511, -42, 64, 1000000, 17, 250 };
+    for (std::size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i) {
+        scattered.ops.push_back(make_op(i % 2 == 0 ? "kv" : "other",
+                                        sync::ChangeOpType::Put, keys[i], keys[i] * 2));
+    }
+    // Repeated keys keep capture order: the last put of key 1 wins.
+    sync::ChangeBatch repeated;
+    repeated.origin_node_id = origin;
+    repeated.seq = 2;
+    for (int k = 1; k <= 8; ++k) {
+        repeated.ops.push_back(make_op("kv", sync::ChangeOpType::Put, k, k));
+    }
+    repeated.ops.push_back(make_op("kv", sync::ChangeOpType::Put, 1, 100));
+    repeated.ops.push_back(make_op("kv", sync::ChangeOpType::Delete, 907, 0));
+
+    {
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        if (engine.apply_batch_ex(txn.handle(), scattered).result != sync::ApplyResult::Applied ||
+            engine.apply_batch_ex(txn.handle(), repeated).result != sync::ApplyResult::Applied) {
+            throw std::runtime_error("sorted apply batches not applied");
+        }
+        txn.commit();
+    }
+
+    for (std::size_t i = 1; i < sizeof(keys) / sizeof(keys[0]); ++i) {
+        KeyValueTable<int, int>& table = i % 2 == 0 ? kv : other;
+        if (kv_or_throw(conn, table, keys[i], "sorted apply key") != keys[i] * 2) {
+            throw std::runtime_error("sorted apply wrote the wrong value");
+        }
+    }
+    if (kv_has(conn, kv, 907)) {
+        throw std::runtime_error("delete after sorted apply lost");
+    }
+    if (kv_or_throw(conn, kv, 1, "repeated key") != 100 ||
+        kv_or_throw(conn, kv, 8, "key 8") != 8) {
+        throw std::runtime_error("repeated keys not applied in capture order");
+    }
+    if (engine.applied_cursor().last_seq_for(origin) != 2u) {
+        throw std::runtime_error("sorted apply lost the applied seq");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
 void test_engine_existing_dbi_flag_mismatch_returns_conflict() {
     using namespace mdbxc;
     const std::string p = "test_engine_existing_dbi_flag_mismatch.mdbx";
@@ -996,6 +1299,279 @@ void test_engine_applied_cursor() {
     cleanup(p);
 }
 
+void test_engine_applied_cursor_cache() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_cursor_cache.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    sync::SyncEngine engine(conn);
+    engine.initialize_local_identity(make_node(0x10), make_node(0xD0));
+    const std::shared_ptr<sync::AppliedCursorCache> cache = engine.applied_cursor_cache();
+
+    auto make_batch = [](std::uint64_t seq) {
+        sync::ChangeBatch b;
+        b.origin_node_id = make_node(0x20);
+        b.seq = seq;
+        sync::ChangeOp op;
+        op.op_type = sync::ChangeOpType::Put;
+        op.dbi_name = "t";
+        op.storage_key = { static_cast<std::uint8_t>(seq) };
+        op.value = { 0xFF };
+        b.ops.push_back(op);
+        return b;
+    };
+
+    {
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        engine.apply_batch(txn.handle(), make_batch(1));
+        txn.commit();
+    }
+    if (engine.applied_cursor().last_seq_for(make_node(0x20)) != 1u) {
+        throw std::runtime_error("cursor should report last=1");
+    }
+    sync::SyncCursor cached;
+    if (!cache->lookup(conn->last_txn_id(), cached) ||
+        cached.last_seq_for(make_node(0x20)) != 1u) {
+        throw std::runtime_error("read should fill the applied cursor cache");
+    }
+
+    // A push commit advances the cache under the sync-apply write guard.
+    sync::DirectSyncPeer peer(&engine);
+    sync::PushRequest req;
+    req.sender = make_node(0x20);
+    req.db_id = make_node(0xD0);
+    req.batches.push_back(make_batch(2));
+    const sync::PushResponse pushed = peer.push(req);
+    if (!pushed.ok || pushed.receiver_have.last_seq_for(make_node(0x20)) != 2u) {
+        throw std::runtime_error("push should report last=2");
+    }
+    if (!cache->lookup(conn->last_txn_id(), cached) ||
+        cached.last_seq_for(make_node(0x20)) != 2u) {
+        throw std::runtime_error("push commit should advance the applied cursor cache");
+    }
+
+    // Writes the engine does not see still show up on the next read.
+    {
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        engine.apply_batch(txn.handle(), make_batch(3));
+        txn.commit();
+    }
+    if (engine.applied_cursor().last_seq_for(make_node(0x20)) != 3u) {
+        throw std::runtime_error("external apply commit returned a stale cursor");
+    }
+    {
+        KeyValueTable<int, int> kv(conn, "kv");
+        kv.insert_or_assign(1, 10);
+    }
+    if (engine.applied_cursor().last_seq_for(make_node(0x20)) != 3u) {
+        throw std::runtime_error("user write changed the applied cursor");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_engine_push_replay_skips_writer() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_push_replay.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    sync::SyncEngine engine(conn);
+    engine.initialize_local_identity(make_node(0x10), make_node(0xD0));
+    const sync::NodeId origin = make_node(0x20);
+
+    sync::DirectSyncPeer peer(&engine);
+    sync::PushRequest req;
+    req.sender = origin;
+    req.db_id = make_node(0xD0);
+    req.batches.push_back(make_raw_batch(origin, 1, "t", 0x01));
+    req.encoded_batches.push_back(
+        sync::ChangeBatchCodec::encode(make_raw_batch(origin, 2, "t", 0x02)));
+    if (!peer.push(req).ok) {
+        throw std::runtime_error("first delivery should apply");
+    }
+
+    // A relayed copy of the same batches is answered from the cached cursor.
+    const std::uint64_t txn_before = conn->last_txn_id();
+    const sync::PushResponse replay = peer.push(req);
+    if (!replay.ok || replay.receiver_have.last_seq_for(origin) != 2u) {
+        throw std::runtime_error("replayed push should succeed with last=2");
+    }
+    if (conn->last_txn_id() != txn_before) {
+        throw std::runtime_error("replayed push should not commit a transaction");
+    }
+
+    // Replays mixed with a new batch still apply the new one.
+    req.batches.push_back(make_raw_batch(origin, 3, "t", 0x03));
+    const sync::PushResponse mixed = peer.push(req);
+    if (!mixed.ok || mixed.receiver_have.last_seq_for(origin) != 3u) {
+        throw std::runtime_error("mixed push should apply seq=3");
+    }
+    {
+        KeyValueTable<std::vector<std::uint8_t>, std::vector<std::uint8_t>> t(conn, "t");
+        if (t.count() != 3u) {
+            throw std::runtime_error("replays should not duplicate writes");
+        }
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_sharded_push_applier() {
+    using namespace mdbxc;
+    const std::string p0 = "test_sharded_push_0.mdbx";
+    const std::string p1 = "test_sharded_push_1.mdbx";
+    cleanup(p0);
+    cleanup(p1);
+
+    auto conn0 = open_env(p0);
+    auto conn1 = open_env(p1);
+    sync::SyncEngine engine0(conn0);
+    sync::SyncEngine engine1(conn1);
+    engine0.initialize_local_identity(make_node(0x10), make_node(0xD0));
+    engine1.initialize_local_identity(make_node(0x11), make_node(0xD0));
+    const sync::NodeId a = make_node(0x20);
+    const sync::NodeId b = make_node(0x30);
+
+    std::vector<sync::SyncEngine*> engines;
+    engines.push_back(&engine0);
+    engines.push_back(&engine1);
+    sync::ShardedPushApplier applier(engines, [a](const sync::NodeId& origin) {
+        return origin == a ? std::size_t(0) : std::size_t(1);
+    });
+
+    sync::PushRequest req;
+    req.sender = make_node(0x40);
+    req.db_id = make_node(0xD0);
+    req.batches.push_back(make_raw_batch(a, 1, "t", 0x01));
+    req.batches.push_back(make_raw_batch(b, 1, "t", 0x02));
+    req.encoded_batches.push_back(
+        sync::ChangeBatchCodec::encode(make_raw_batch(a, 2, "t", 0x03)));
+    const std::vector<sync::PushRequest> parts = applier.plan(req);
+    if (parts[0].batches.size() != 1u || parts[0].encoded_batches.size() != 1u ||
+        parts[1].batches.size() != 1u || !parts[1].encoded_batches.empty()) {
+        throw std::runtime_error("plan should route batches by origin");
+    }
+
+    const sync::PushResponse res = applier.handle_push(req);
+    if (!res.ok || res.receiver_have.last_seq_for(a) != 2u ||
+        res.receiver_have.last_seq_for(b) != 1u) {
+        throw std::runtime_error("sharded push should apply both origins");
+    }
+    if (engine0.applied_cursor().last_seq_for(b) != 0u ||
+        engine1.applied_cursor().last_seq_for(a) != 0u) {
+        throw std::runtime_error("each origin should land on its own shard");
+    }
+
+    // A gap on one shard fails the push without undoing the other shard.
+    sync::PushRequest gap;
+    gap.sender = req.sender;
+    gap.db_id = req.db_id;
+    gap.batches.push_back(make_raw_batch(a, 3, "t", 0x04));
+    gap.batches.push_back(make_raw_batch(b, 5, "t", 0x05));
+    const sync::PushResponse partial = applier.handle_push(gap);
+    if (partial.ok || partial.receiver_have.last_seq_for(a) != 3u ||
+        applier.applied_cursor().last_seq_for(b) != 1u) {
+        throw std::runtime_error("shard failure should be reported per shard");
+    }
+
+    conn0->disconnect();
+    conn1->disconnect();
+    cleanup(p0);
+    cleanup(p1);
+}
+
+void test_push_apply_queue() {
+    using namespace mdbxc;
+    const std::string p = "test_push_apply_queue.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    sync::SyncEngine engine(conn);
+    engine.initialize_local_identity(make_node(0x10), make_node(0xD0));
+    const sync::NodeId origin = make_node(0x20);
+    auto push_of = [&origin](std::uint64_t seq) {
+        sync::PushRequest req;
+        req.sender = origin;
+        req.db_id = make_node(0xD0);
+        req.batches.push_back(make_raw_batch(origin, seq, "t", 0x41));
+        return req;
+    };
+    expect_invalid_argument("PushApplyQueue without slots", [&engine]() {
+        sync::PushApplyQueueOptions none;
+        none.max_pending_pushes = 0;
+        sync::PushApplyQueue queue(engine, none);
+    });
+
+    // An admitted push holds its slot until the engine returns; the observer
+    // callback keeps it there while a second push arrives.
+    sync::PushApplyQueueOptions options;
+    options.max_pending_pushes = 1;
+    options.retry_after_seconds = 2;
+    for (int spill = 0; spill < 2; ++spill) {
+        options.spill = spill != 0;
+        sync::PushApplyQueue queue(engine, options);
+        BlockingApplyObserver observer;
+        const std::uint64_t token = conn->add_sync_apply_observer(&observer);
+        const std::uint64_t seq = spill ? 2u : 1u;
+        sync::PushResponse first;
+        std::string push_error;
+        std::thread pusher([&queue, &first, &push_error, &push_of, seq]() {
+            try {
+                first = queue.handle_push(push_of(seq));
+            } catch (const std::exception& e) {
+                push_error = e.what();
+            }
+        });
+        if (!observer.wait_until_entered(std::chrono::milliseconds(1000))) {
+            observer.release_callback();
+            pusher.join();
+            throw std::runtime_error("admitted push did not reach the observer");
+        }
+        const sync::PushResponse second = queue.handle_push(push_of(seq + 1));
+        std::size_t reopened_staged = 0;
+        if (spill) {
+            // Staged pushes are durable; a queue built later counts them.
+            sync::PushApplyQueue reopened(engine, options);
+            reopened_staged = static_cast<std::size_t>(reopened.stats().staged_pushes);
+        }
+        observer.release_callback();
+        pusher.join();
+        conn->remove_sync_apply_observer(token);
+        if (!push_error.empty() || !first.ok) {
+            throw std::runtime_error("admitted push should apply: " + push_error);
+        }
+
+        const sync::PushApplyQueue::Stats stats = queue.stats();
+        if (stats.pending_pushes != 0u || stats.pending_bytes != 0u) {
+            throw std::runtime_error("PushApplyQueue should release its admissions");
+        }
+        if (!spill) {
+            if (second.ok || second.error_code != sync::SyncResponseErrorCode::Busy ||
+                !second.error_retryable || second.retry_after_seconds != 2u ||
+                stats.applied != 1u || stats.refused != 1u) {
+                throw std::runtime_error("full PushApplyQueue should answer Busy");
+            }
+            continue;
+        }
+        if (!second.ok || second.receiver_have.last_seq_for(origin) != 2u ||
+            reopened_staged != 1u) {
+            throw std::runtime_error("PushApplyQueue should stage the overflow push");
+        }
+        if (engine.applied_cursor().last_seq_for(origin) != 3u ||
+            stats.spilled != 1u || stats.drained != 1u ||
+            stats.staged_pushes != 0u || stats.staged_bytes != 0u) {
+            throw std::runtime_error("admitted push should drain the staged push");
+        }
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
 void test_engine_handle_push_to_remote() {
     using namespace mdbxc;
     const std::string origin_path = "test_engine_push_origin.mdbx";
@@ -1071,6 +1647,12 @@ void test_engine_handle_push_to_remote() {
         observer.affected_dbi_names[0] != "kv") {
         throw std::runtime_error("remote apply observer DBI names incorrect");
     }
+    if (observer.applied_keys.size() != 1u ||
+        observer.applied_keys[0].dbi_name != "kv" ||
+        observer.applied_keys[0].op_type != sync::ChangeOpType::Put ||
+        observer.applied_keys[0].storage_key.size() != sizeof(int)) {
+        throw std::runtime_error("remote apply observer keys incorrect");
+    }
     if (reentrant_observer.calls != 1u ||
         reentrant_observer.last_count != 0u) {
         throw std::runtime_error(
@@ -1587,37 +2169,119 @@ void test_engine_handle_pull_wrong_db_id() {
     cleanup(p);
 }
 
-void test_engine_rejects_full_snapshot_request() {
+void test_engine_full_snapshot_bootstrap() {
     using namespace mdbxc;
-    const std::string p = "test_engine_full_snapshot_request.mdbx";
-    cleanup(p);
-
-    auto conn = open_env(p);
-    sync::SyncEngine engine(conn);
-    engine.initialize_local_identity(make_node(0xA0), make_node(0xD0));
+    const std::string primary_path = "test_engine_snapshot_primary.mdbx";
+    const std::string replica_path = "test_engine_snapshot_replica.mdbx";
+    cleanup(primary_path);
+    cleanup(replica_path);
 
-    sync::PullRequest req;
-    req.requester = make_node(0xB0);
-    req.db_id = make_node(0xD0);
-    req.request_full_snapshot = true;
+    auto primary_conn = open_env(primary_path);
+    auto replica_conn = open_env(replica_path);
+    const sync::NodeId primary_node = make_node(0xA0);
+    const sync::NodeId replica_node = make_node(0xB0);
+    const sync::NodeId db_uuid = make_node(0xD0);
+    sync::SyncEngine primary_engine(primary_conn);
+    sync::SyncEngine replica_engine(replica_conn);
+    primary_engine.initialize_local_identity(primary_node, db_uuid);
+    replica_engine.initialize_local_identity(replica_node, db_uuid);
 
-    const sync::PullResponse resp = engine.handle_pull(req);
-    if (resp.ok) {
-        throw std::runtime_error("full snapshot request should be rejected");
-    }
-    if (!resp.batches.empty()) {
-        throw std::runtime_error("full snapshot rejection returned batches");
-    }
-    if (resp.error.find("request_full_snapshot") == std::string::npos) {
-        throw std::runtime_error("full snapshot rejection error is not explicit");
-    }
-    if (resp.error_code != sync::SyncResponseErrorCode::UnsupportedFullSnapshot ||
-        resp.error_retryable) {
-        throw std::runtime_error("full snapshot rejection code incorrect");
+    sync::ThreadLocalChangeAccumulator primary_sink(primary_conn);
+    primary_conn->attach_sync_capture(&primary_sink);
+    KeyValueTable<int, int> primary_kv(primary_conn, "kv");
+    KeyValueTable<std::string, std::string> primary_names(primary_conn, "names");
+    for (int i = 1; i <= 40; ++i) {
+        primary_kv.insert_or_assign(i, i * 10);
     }
+    primary_names.insert_or_assign("alpha", "a");
+    primary_names.insert_or_assign("beta", "b");
+    primary_conn->detach_sync_capture();
 
-    conn->disconnect();
-    cleanup(p);
+    // The snapshot replaces "kv" and "names" but keeps "local".
+    KeyValueTable<int, int> replica_kv(replica_conn, "kv");
+    KeyValueTable<int, int> replica_local(replica_conn, "local");
+    replica_kv.insert_or_assign(999, 1);
+    replica_local.insert_or_assign(7, 70);
+
+    sync::PullRequest req;
+    req.requester = replica_node;
+    req.db_id = db_uuid;
+    req.request_full_snapshot = true;
+    req.max_bytes = 256;
+    std::size_t pages = 0;
+    sync::PullResponse resp;
+    do {
+        resp = primary_engine.handle_pull(
+            req, pages % 2 == 0 ? sync::PullBatchForm::Decoded : sync::PullBatchForm::Encoded);
+        if (!resp.ok) {
+            throw std::runtime_error("snapshot page failed: " + resp.error);
+        }
+        if (pages == 0) {
+            // Written after the export started, so not part of it.
+            primary_kv.insert_or_assign(1000, 1);
+        }
+        const sync::PushResponse applied =
+            replica_engine.apply_snapshot_page(resp, req.snapshot_token.empty());
+        if (!applied.ok) {
+            throw std::runtime_error("snapshot page apply failed: " + applied.error);
+        }
+        if (resp.has_more && (resp.snapshot_token.empty() ||
+                              !replica_engine.snapshot_import_pending())) {
+            throw std::runtime_error("unfinished snapshot lost its token or marker");
+        }
+        req.snapshot_token = resp.snapshot_token;
+        ++pages;
+    } while (resp.has_more && pages < 100);
+    if (pages < 3 || resp.has_more) {
+        throw std::runtime_error("snapshot should span several pages, got " +
+                                 std::to_string(pages));
+    }
+    if (replica_engine.snapshot_import_pending()) {
+        throw std::runtime_error("finished snapshot left the import marker");
+    }
+
+    for (int i = 1; i <= 40; ++i) {
+        if (kv_or_throw(replica_conn, replica_kv, i, "snapshot kv") != i * 10) {
+            throw std::runtime_error("snapshot kv value mismatch");
+        }
+    }
+    KeyValueTable<std::string, std::string> replica_names(replica_conn, "names");
+    if (kv_or_throw(replica_conn, replica_names, std::string("beta"), "snapshot names") != "b") {
+        throw std::runtime_error("snapshot names value mismatch");
+    }
+    if (kv_has(replica_conn, replica_kv, 999) || kv_has(replica_conn, replica_kv, 1000)) {
+        throw std::runtime_error("snapshot kept a stale key or saw a later write");
+    }
+    if (kv_or_throw(replica_conn, replica_local, 7, "unlisted table") != 70) {
+        throw std::runtime_error("snapshot touched a table it does not list");
+    }
+    const sync::SyncCursor cursor = replica_engine.applied_cursor();
+    if (cursor.last_seq_by_origin != resp.remote_tail.last_seq_by_origin ||
+        cursor.last_seq_for(primary_node) != 42u) {
+        throw std::runtime_error("snapshot did not move the cursor to its tail");
+    }
+
+    // Incremental pulls continue from the snapshot cursor.
+    sync::PullRequest next;
+    next.requester = replica_node;
+    next.db_id = db_uuid;
+    next.have = cursor;
+    const sync::PullResponse incremental = primary_engine.handle_pull(next);
+    if (!incremental.ok || !incremental.batches.empty()) {
+        throw std::runtime_error("pull after snapshot replayed covered batches");
+    }
+
+    req.snapshot_token = "not-a-token";
+    const sync::PullResponse expired = primary_engine.handle_pull(req);
+    if (expired.ok || expired.error_code != sync::SyncResponseErrorCode::SnapshotExpired ||
+        expired.error_retryable) {
+        throw std::runtime_error("unknown snapshot token should be SnapshotExpired");
+    }
+
+    primary_conn->disconnect();
+    replica_conn->disconnect();
+    cleanup(primary_path);
+    cleanup(replica_path);
 }
 
 void test_engine_changelog_page_rejects_full_snapshot_request() {
@@ -1715,6 +2379,208 @@ void test_engine_pull_reports_snapshot_required_after_prune() {
     cleanup(p);
 }
 
+void test_engine_prune_changelog_retention() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_prune_changelog_retention.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    sync::SyncEngine engine(conn);
+    const sync::NodeId local = make_node(0xA4);
+    const sync::NodeId origin = make_node(0xB4);
+    const sync::DbId db_id = make_node(0xD4);
+    const sync::NodeId peer_a = make_node(0xE4);
+    const sync::NodeId peer_b = make_node(0xF4);
+    engine.initialize_local_identity(local, db_id);
+
+    {
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        sync::ChangeLogStore log(conn->env_handle());
+        log.open(txn.handle());
+        for (std::uint64_t seq = 1; seq <= 6; ++seq) {
+            sync::ChangeBatch batch = make_raw_batch(origin, seq, "t", 0x04);
+            // Seq 5 is stamped long ago; seq 6 predates stamping.
+            batch.time_unix_ns = seq == 5 ? 1u : 0u;
+            append_raw_batch(log, txn.handle(), batch);
+        }
+        txn.commit();
+    }
+
+    sync::SyncCursor have;
+    have.last_seq_by_origin[origin] = 5;
+    engine.note_peer_have(peer_a, have);
+    have.last_seq_by_origin[origin] = 4;
+    engine.note_peer_have(peer_b, have);
+    if (engine.peer_watermarks().size() != 2u) {
+        throw std::runtime_error("pending peer reports not listed");
+    }
+
+    sync::ChangeLogRetention policy;
+    policy.max_batches_per_txn = 1;
+    sync::ChangeLogPruneResult result = engine.prune_changelog(policy);
+    if (result.batches_removed != 4u || result.transactions != 5u) {
+        throw std::runtime_error("acknowledged prune must remove seq 1..4 one per txn");
+    }
+    {
+        auto txn = conn->transaction(TransactionMode::READ_ONLY);
+        sync::ChangeLogStore log(conn->env_handle());
+        log.open(txn.handle());
+        std::uint64_t first = 0;
+        MDBX_val value;
+        if (!log.first(txn.handle(), origin, first, value) || first != 5u) {
+            throw std::runtime_error("acknowledged prune kept the wrong head");
+        }
+    }
+    const std::vector<sync::PeerWatermarkStore::PeerWatermark> marks = engine.peer_watermarks();
+    if (marks.size() != 2u || marks[0].have.last_seq_for(origin) != 5u) {
+        throw std::runtime_error("peer reports not persisted by the prune");
+    }
+
+    sync::PullRequest req;
+    req.requester = make_node(0xC4);
+    req.db_id = db_id;
+    req.have.last_seq_by_origin[origin] = 2;
+    const sync::PullResponse resp = engine.handle_pull(req);
+    if (resp.ok || resp.error_code != sync::SyncResponseErrorCode::SnapshotRequired) {
+        throw std::runtime_error("pull behind the pruned range must need a snapshot");
+    }
+
+    sync::ChangeLogRetention by_age;
+    by_age.prune_acknowledged = false;
+    by_age.max_age = std::chrono::milliseconds(1);
+    result = engine.prune_changelog(by_age);
+    if (result.batches_removed != 1u) {
+        throw std::runtime_error("age prune must remove only the stamped old batch");
+    }
+
+    if (!engine.forget_peer(peer_a) || engine.forget_peer(peer_a)) {
+        throw std::runtime_error("forget_peer result mismatch");
+    }
+    if (engine.peer_watermarks().size() != 2u) {
+        // The pull above made its requester a tracked peer as well.
+        throw std::runtime_error("forget_peer removed the wrong peers");
+    }
+
+    sync::ChangeLogRetention by_size;
+    by_size.prune_acknowledged = false;
+    by_size.max_bytes = 1;
+    result = engine.prune_changelog(by_size);
+    if (result.batches_removed != 1u || result.bytes_removed == 0u) {
+        throw std::runtime_error("size prune must remove the remaining batch");
+    }
+    {
+        auto txn = conn->transaction(TransactionMode::READ_ONLY);
+        sync::ChangeLogStore log(conn->env_handle());
+        log.open(txn.handle());
+        std::uint64_t first = 0;
+        MDBX_val value;
+        if (log.first(txn.handle(), origin, first, value)) {
+            throw std::runtime_error("size prune left batches behind");
+        }
+    }
+    sync::PullRequest fresh;
+    fresh.requester = make_node(0xC5);
+    fresh.db_id = db_id;
+    fresh.have.last_seq_by_origin[origin] = 6;
+    if (!engine.handle_pull(fresh).ok) {
+        throw std::runtime_error("caught-up pull must succeed after every batch is pruned");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_engine_compact_changelog() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_compact_changelog.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    sync::SyncEngine engine(conn);
+    const sync::NodeId local = make_node(0xA6);
+    const sync::NodeId origin = make_node(0xB6);
+    engine.initialize_local_identity(local, make_node(0xD6));
+
+    // seq 1: k1=a, k2=a; seq 2: k1=b; seq 3: del k2; seq 4: k1=c; seq 5: k3=a
+    const std::uint8_t k1 = 0x01, k2 = 0x02, k3 = 0x03;
+    {
+        auto txn = conn->transaction(TransactionMode::WRITABLE);
+        sync::ChangeLogStore log(conn->env_handle());
+        log.open(txn.handle());
+        sync::ChangeBatch b1 = make_raw_batch(origin, 1, "t", k1);
+        b1.ops.push_back(make_raw_batch(origin, 1, "t", k2).ops[0]);
+        append_raw_batch(log, txn.handle(), b1);
+        append_raw_batch(log, txn.handle(), origin, 2, "t", k1);
+        sync::ChangeBatch b3 = make_raw_batch(origin, 1, "t", k2);
+        b3.seq = 3;
+        b3.ops[0].op_type = sync::ChangeOpType::Delete;
+        b3.ops[0].value.clear();
+        append_raw_batch(log, txn.handle(), b3);
+        sync::ChangeBatch b4 = make_raw_batch(origin, 4, "t", k1);
+        b4.time_unix_ns = 44;
+        append_raw_batch(log, txn.handle(), b4);
+        append_raw_batch(log, txn.handle(), origin, 5, "t", k3);
+        txn.commit();
+    }
+
+    sync::ChangeLogCompaction policy;
+    policy.keep_recent = 1;
+    policy.max_batches_per_txn = 3;
+    sync::ChangeLogCompactResult result = engine.compact_changelog(policy);
+    if (result.ops_removed != 3u || result.batches_rewritten != 2u ||
+        result.transactions != 2u || result.bytes_saved == 0u) {
+        throw std::runtime_error("compaction result mismatch");
+    }
+
+    {
+        auto txn = conn->transaction(TransactionMode::READ_ONLY);
+        sync::ChangeLogStore log(conn->env_handle());
+        log.open(txn.handle());
+        std::vector<std::size_t> op_counts;
+        for (std::uint64_t seq = 1; seq <= 5; ++seq) {
+            std::vector<std::uint8_t> bytes;
+            if (!log.get(txn.handle(), origin, seq, bytes)) {
+                throw std::runtime_error("compaction removed a batch");
+            }
+            const sync::ChangeBatch batch = sync::ChangeBatchCodec::decode(bytes);
+            if (batch.seq != seq || batch.origin_node_id != origin) {
+                throw std::runtime_error("compacted batch header changed");
+            }
+            op_counts.push_back(batch.ops.size());
+            if (seq == 4 && (batch.time_unix_ns != 44u || batch.ops[0].value[1] != 4u)) {
+                throw std::runtime_error("latest write of k1 must survive as written");
+            }
+            if (seq == 3 && batch.ops[0].op_type != sync::ChangeOpType::Delete) {
+                throw std::runtime_error("latest delete of k2 must survive");
+            }
+        }
+        const std::vector<std::size_t> expected = { 0u, 0u, 1u, 1u, 1u };
+        if (op_counts != expected) {
+            throw std::runtime_error("superseded ops not dropped");
+        }
+    }
+
+    result = engine.compact_changelog(policy);
+    if (result.ops_removed != 0u || result.batches_rewritten != 0u) {
+        throw std::runtime_error("second compaction must find nothing to drop");
+    }
+
+    sync::ChangeLogCompaction invalid;
+    invalid.max_batches_per_txn = 0;
+    bool threw = false;
+    try {
+        engine.compact_changelog(invalid);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("invalid compaction options accepted");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
 void test_engine_pull_max_bytes_is_soft_page_budget() {
     using namespace mdbxc;
     const std::string p = "test_engine_pull_soft_max_bytes.mdbx";
@@ -2117,6 +2983,324 @@ void test_engine_handle_pull_legacy_changelog_without_origin_index() {
     cleanup(primary_path);
 }
 
+void test_engine_handle_pull_round_robin_schedule() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_engine_pull_round_robin.mdbx";
+    cleanup(primary_path);
+
+    auto primary_conn = open_env(primary_path);
+
+    const sync::NodeId replica_node = make_node(0xB0);
+    const sync::NodeId db_uuid = make_node(0xD0);
+    const sync::NodeId origin_a = make_node(0x20);
+    const sync::NodeId origin_b = make_node(0x40);
+    const sync::NodeId origin_c = make_node(0x60);
+
+    sync::SyncEngine primary_engine(primary_conn);
+    primary_engine.initialize_local_identity(make_node(0xA0), db_uuid);
+    if (primary_engine.pull_schedule() != sync::PullSchedule::KeyOrder) {
+        throw std::runtime_error("pull schedule should default to KeyOrder");
+    }
+    primary_engine.set_pull_schedule(sync::PullSchedule::RoundRobin);
+
+    {
+        auto txn = primary_conn->transaction(TransactionMode::WRITABLE);
+        sync::ChangeLogStore log(primary_conn->env_handle());
+        log.open(txn.handle());
+        for (std::uint64_t seq = 1; seq <= 3; ++seq) {
+            const std::uint8_t value = static_cast<std::uint8_t>(seq);
+            append_raw_batch(log, txn.handle(), origin_a, seq, "kv", value);
+            append_raw_batch(log, txn.handle(), origin_b, seq, "kv", value);
+            append_raw_batch(log, txn.handle(), origin_c, seq, "kv", value);
+        }
+        txn.commit();
+    }
+
+    // Two batches per page over three origins: each page starts where the
+    // previous one stopped instead of at origin A.
+    const sync::NodeId expected_origins[] = {
+        origin_a, origin_b, origin_c, origin_a, origin_b,
+        origin_c, origin_a, origin_b, origin_c,
+    };
+    sync::PullRequest req;
+    req.requester = replica_node;
+    req.db_id = db_uuid;
+    req.max_batches = 2;
+    std::size_t served = 0;
+    for (int page = 0; page < 5; ++page) {
+        const sync::PullResponse resp = primary_engine.handle_pull(req);
+        if (!resp.ok) {
+            throw std::runtime_error("round-robin pull failed: " + resp.error);
+        }
+        for (std::size_t i = 0; i < resp.batches.size(); ++i, ++served) {
+            const sync::ChangeBatch& batch = resp.batches[i];
+            if (served >= 9u || batch.origin_node_id != expected_origins[served]) {
+                throw std::runtime_error("round-robin pull served origins out of turn");
+            }
+            if (batch.seq != req.have.last_seq_for(batch.origin_node_id) + 1) {
+                throw std::runtime_error("round-robin pull broke per-origin order");
+            }
+            req.have.last_seq_by_origin[batch.origin_node_id] = batch.seq;
+        }
+        if (resp.has_more != (page < 4)) {
+            throw std::runtime_error("round-robin has_more mismatch");
+        }
+    }
+    if (served != 9u) {
+        throw std::runtime_error("round-robin pull did not drain every origin");
+    }
+
+    primary_conn->disconnect();
+    cleanup(primary_path);
+}
+
+void test_engine_handle_pull_long_poll() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_engine_pull_long_poll.mdbx";
+    cleanup(primary_path);
+
+    auto primary_conn = open_env(primary_path);
+
+    const sync::NodeId db_uuid = make_node(0xD0);
+    const sync::NodeId origin = make_node(0x20);
+
+    sync::SyncEngine primary_engine(primary_conn);
+    primary_engine.initialize_local_identity(make_node(0xA0), db_uuid);
+
+    sync::PullRequest req;
+    req.requester = make_node(0xB0);
+    req.db_id = db_uuid;
+    req.wait_timeout_ms = 60000;
+
+    // Long-poll is off until the responder allows it.
+    const std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    sync::PullResponse resp = primary_engine.handle_pull(req);
+    if (!resp.ok || !resp.batches.empty() ||
+        std::chrono::steady_clock::now() - started > std::chrono::seconds(10)) {
+        throw std::runtime_error("pull without max_pull_wait should return at once");
+    }
+
+    primary_engine.set_max_pull_wait(std::chrono::milliseconds(60000));
+    std::thread writer([&primary_conn, &origin]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto txn = primary_conn->transaction(TransactionMode::WRITABLE);
+        sync::ChangeLogStore log(primary_conn->env_handle());
+        log.open(txn.handle());
+        append_raw_batch(log, txn.handle(), origin, 1, "kv", 7);
+        txn.commit();
+    });
+    resp = primary_engine.handle_pull(req);
+    writer.join();
+    if (!resp.ok || resp.batches.size() != 1u || resp.batches[0].seq != 1u) {
+        throw std::runtime_error("long-poll pull should return the committed batch");
+    }
+
+    // Nothing new: the capped wait ends with an empty page.
+    req.have.last_seq_by_origin[origin] = 1;
+    primary_engine.set_max_pull_wait(std::chrono::milliseconds(150));
+    resp = primary_engine.handle_pull(req);
+    if (!resp.ok || !resp.batches.empty() || resp.has_more) {
+        throw std::runtime_error("timed out long-poll should return an empty page");
+    }
+
+    primary_conn->disconnect();
+    cleanup(primary_path);
+}
+
+std::uint64_t origin_index_txnid(const std::shared_ptr<mdbxc::Connection>& conn) {
+    auto txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+    mdbxc::sync::OriginIndexStore origins(conn->env_handle());
+    if (!origins.open_existing(txn.handle())) {
+        throw std::runtime_error("origin index is missing");
+    }
+    return origins.mod_txnid(txn.handle());
+}
+
+void test_engine_handle_pull_origin_tail_cache() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_engine_pull_tail_cache.mdbx";
+    cleanup(primary_path);
+
+    auto primary_conn = open_env(primary_path);
+
+    const sync::NodeId primary_node = make_node(0xA0);
+    const sync::NodeId replica_node = make_node(0xB0);
+    const sync::NodeId db_uuid = make_node(0xD0);
+    const sync::NodeId origin = make_node(0x20);
+
+    sync::SyncEngine primary_engine(primary_conn);
+    primary_engine.initialize_local_identity(primary_node, db_uuid);
+    sync::ThreadLocalChangeAccumulator sink(primary_conn);
+    primary_conn->attach_sync_capture(&sink);
+    const std::shared_ptr<sync::OriginTailCache> cache = sink.origin_tail_cache();
+    if (!cache) {
+        throw std::runtime_error("accumulator should keep an origin tail cache");
+    }
+
+    {
+        auto txn = primary_conn->transaction(TransactionMode::WRITABLE);
+        sync::ChangeLogStore log(primary_conn->env_handle());
+        log.open(txn.handle());
+        append_raw_batch(log, txn.handle(), origin, 1, "kv", 0xA1);
+        txn.commit();
+    }
+
+    sync::DirectSyncPeer peer(&primary_engine);
+    sync::PullRequest req;
+    req.requester = replica_node;
+    req.db_id = db_uuid;
+    const sync::PullResponse first = peer.pull(req);
+    if (!first.ok || first.batches.size() != 1u || !first.remote_tail_known) {
+        throw std::runtime_error("initial pull should return the raw batch");
+    }
+    std::vector<sync::OriginTailCache::OriginTail> tails;
+    if (!cache->lookup(origin_index_txnid(primary_conn), tails) || tails.size() != 1u) {
+        throw std::runtime_error("pull should fill the origin tail cache");
+    }
+
+    // A captured commit raises the local origin in the cache.
+    {
+        KeyValueTable<int, int> kv(primary_conn, "kv");
+        kv.insert_or_assign(1, 10);
+    }
+    if (!cache->lookup(origin_index_txnid(primary_conn), tails) || tails.size() != 2u) {
+        throw std::runtime_error("committed append should update the cached tails");
+    }
+    bool local_tail = false;
+    for (std::size_t i = 0; i < tails.size(); ++i) {
+        if (tails[i].origin == primary_node && tails[i].last_seq == 1u) {
+            local_tail = true;
+        }
+    }
+    if (!local_tail) {
+        throw std::runtime_error("cached tails miss the local origin");
+    }
+
+    req.have.last_seq_by_origin[origin] = 1;
+    req.have.last_seq_by_origin[primary_node] = 1;
+    const sync::PullResponse idle = peer.pull(req);
+    if (!idle.ok || !idle.batches.empty() || idle.has_more ||
+        idle.remote_tail.last_seq_for(primary_node) != 1u ||
+        idle.remote_tail.last_seq_for(origin) != 1u) {
+        throw std::runtime_error("caught-up pull should be answered from the cache");
+    }
+
+    // Index writes the sink does not see change its version and miss the cache.
+    {
+        auto txn = primary_conn->transaction(TransactionMode::WRITABLE);
+        sync::ChangeLogStore log(primary_conn->env_handle());
+        log.open(txn.handle());
+        append_raw_batch(log, txn.handle(), origin, 2, "kv", 0xA2);
+        txn.commit();
+    }
+    const sync::PullResponse next = peer.pull(req);
+    if (!next.ok || next.batches.size() != 1u ||
+        next.batches[0].origin_node_id != origin || next.batches[0].seq != 2u) {
+        throw std::runtime_error("pull after an unseen index write returned stale tails");
+    }
+
+    primary_conn->detach_sync_capture();
+    primary_conn->disconnect();
+    cleanup(primary_path);
+}
+
+void test_engine_handle_pull_subscription() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_engine_pull_subscription.mdbx";
+    const std::string replica_path = "test_engine_pull_subscription_replica.mdbx";
+    cleanup(primary_path);
+    cleanup(replica_path);
+
+    auto primary_conn = open_env(primary_path);
+    auto replica_conn = open_env(replica_path);
+
+    const sync::NodeId primary_node = make_node(0xA0);
+    const sync::NodeId replica_node = make_node(0xB0);
+    const sync::NodeId db_uuid = make_node(0xD0);
+    const sync::NodeId origin = make_node(0x20);
+
+    sync::SyncEngine primary_engine(primary_conn);
+    primary_engine.initialize_local_identity(primary_node, db_uuid);
+    sync::SyncEngine replica_engine(replica_conn);
+    replica_engine.initialize_local_identity(replica_node, db_uuid);
+
+    {
+        auto txn = primary_conn->transaction(TransactionMode::WRITABLE);
+        sync::ChangeLogStore log(primary_conn->env_handle());
+        log.open(txn.handle());
+        // seq=1 mixes both shards of "orders" with another table.
+        sync::ChangeBatch mixed = make_raw_batch(origin, 1, "orders", 0x01);
+        mixed.ops.push_back(make_raw_batch(origin, 1, "orders", 0x02).ops[0]);
+        mixed.ops.push_back(make_raw_batch(origin, 1, "audit", 0x01).ops[0]);
+        append_raw_batch(log, txn.handle(), mixed);
+        append_raw_batch(log, txn.handle(), origin, 2, "audit", 0x03);
+        append_raw_batch(log, txn.handle(), origin, 3, "orders", 0x01);
+        txn.commit();
+    }
+
+    sync::DirectSyncPeer peer(&primary_engine);
+    sync::PullRequest req;
+    req.requester = replica_node;
+    req.db_id = db_uuid;
+    req.batch_form = sync::PullBatchForm::Encoded;
+    sync::SyncTableSubscription orders;
+    orders.dbi_name = "orders";
+    orders.key_prefixes.push_back(std::vector<std::uint8_t>{ 0x01 });
+    req.subscription.push_back(orders);
+
+    const sync::PullResponse page = peer.pull(req);
+    if (!page.ok || page.has_more || page.encoded_batches.size() != 3u) {
+        throw std::runtime_error("subscribed pull should keep one batch per seq");
+    }
+    const std::size_t expected_ops[] = { 1u, 0u, 1u };
+    for (std::size_t i = 0; i < page.encoded_batches.size(); ++i) {
+        const sync::ChangeBatch batch =
+            sync::ChangeBatchCodec::decode_exact(page.encoded_batches[i]);
+        if (batch.seq != i + 1 || batch.ops.size() != expected_ops[i]) {
+            throw std::runtime_error("subscribed pull returned unexpected ops");
+        }
+        for (std::size_t j = 0; j < batch.ops.size(); ++j) {
+            if (batch.ops[j].dbi_name != "orders" || batch.ops[j].storage_key[0] != 0x01) {
+                throw std::runtime_error("subscribed pull leaked an op outside the shard");
+            }
+        }
+    }
+
+    {
+        // The per-DBI index changes which batches are read, not the page.
+        auto txn = primary_conn->transaction(TransactionMode::WRITABLE);
+        sync::ChangeLogStore log(primary_conn->env_handle());
+        log.open(txn.handle());
+        if (log.rebuild_dbi_index(txn.handle()) != 3u) {
+            throw std::runtime_error("dbi index should cover every retained batch");
+        }
+        txn.commit();
+    }
+    if (peer.pull(req).encoded_batches != page.encoded_batches) {
+        throw std::runtime_error("indexed subscribed pull should match the scanning one");
+    }
+
+    sync::PushRequest push;
+    push.sender = primary_node;
+    push.db_id = db_uuid;
+    push.encoded_batches = page.encoded_batches;
+    const sync::PushResponse applied = replica_engine.handle_push(push);
+    if (!applied.ok || applied.receiver_have.last_seq_for(origin) != 3u) {
+        throw std::runtime_error("filtered batches should advance the replica cursor");
+    }
+    {
+        KeyValueTable<std::vector<std::uint8_t>, std::vector<std::uint8_t>> t(replica_conn, "orders");
+        if (t.count() != 2u) {
+            throw std::runtime_error("replica should hold only the subscribed shard");
+        }
+    }
+
+    primary_conn->disconnect();
+    replica_conn->disconnect();
+    cleanup(primary_path);
+    cleanup(replica_path);
+}
+
 void test_engine_handle_pull_skips_old_batches_without_decoding() {
     using namespace mdbxc;
     const std::string primary_path = "test_engine_pull_skip_old_decode.mdbx";
@@ -2164,6 +3348,272 @@ void test_engine_handle_pull_skips_old_batches_without_decoding() {
     cleanup(primary_path);
 }
 
+void test_engine_handle_pull_encoded_form() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_pull_encoded.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    const sync::NodeId node = make_node(0xA0);
+    const sync::NodeId db_uuid = make_node(0xD0);
+    sync::SyncEngine engine(conn);
+    engine.initialize_local_identity(node, db_uuid);
+
+    sync::ThreadLocalChangeAccumulator sink(conn);
+    conn->attach_sync_capture(&sink);
+    {
+        KeyValueTable<int, int> kv(conn, "kv");
+        for (int i = 1; i <= 3; ++i) {
+            kv.insert_or_assign(i, i * 100);
+        }
+    }
+    conn->detach_sync_capture();
+
+    sync::PullRequest req;
+    req.requester = make_node(0xB0);
+    req.db_id = db_uuid;
+    const sync::PullResponse decoded = engine.handle_pull(req);
+    const sync::PullResponse encoded =
+        engine.handle_pull(req, sync::PullBatchForm::Encoded);
+    if (decoded.batches.size() != 3u || !decoded.encoded_batches.empty()) {
+        throw std::runtime_error("decoded pull returned the wrong form");
+    }
+    if (encoded.encoded_batches.size() != 3u || !encoded.batches.empty()) {
+        throw std::runtime_error("encoded pull returned the wrong form");
+    }
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (encoded.encoded_batches[i] != sync::ChangeBatchCodec::encode(decoded.batches[i])) {
+            throw std::runtime_error("encoded pull changed the stored batch bytes");
+        }
+    }
+    if (sync::TransportMessageCodec::encode_pull_response(encoded) !=
+        sync::TransportMessageCodec::encode_pull_response(decoded)) {
+        throw std::runtime_error("encoded pull serializes differently");
+    }
+
+    req.max_batches = 2;
+    const sync::PullResponse page =
+        engine.handle_pull(req, sync::PullBatchForm::Encoded);
+    if (page.encoded_batches.size() != 2u || !page.has_more) {
+        throw std::runtime_error("encoded pull ignored max_batches");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_engine_handle_pull_readahead() {
+    using namespace mdbxc;
+    const std::string p = "test_engine_pull_readahead.mdbx";
+    cleanup(p);
+
+    auto conn = open_env(p);
+    const sync::NodeId node = make_node(0xA0);
+    const sync::NodeId db_uuid = make_node(0xD0);
+    sync::SyncEngine engine(conn);
+    engine.initialize_local_identity(node, db_uuid);
+    if (!engine.pull_readahead()) {
+        throw std::runtime_error("pull read-ahead must default to on");
+    }
+
+    sync::ThreadLocalChangeAccumulator sink(conn);
+    conn->attach_sync_capture(&sink);
+    {
+        // Values above a page land in overflow pages, the hinted case.
+        KeyValueTable<int, std::string> kv(conn, "kv");
+        for (int i = 1; i <= 12; ++i) {
+            kv.insert_or_assign(i, std::string(20000 + i, static_cast<char>('a' + i)));
+        }
+    }
+    conn->detach_sync_capture();
+
+    sync::PullRequest req;
+    req.requester = make_node(0xB0);
+    req.db_id = db_uuid;
+    req.max_bytes = 5 * 20000;
+    const sync::PullResponse hinted =
+        engine.handle_pull(req, sync::PullBatchForm::Encoded);
+    const sync::PullResponse hinted_decoded = engine.handle_pull(req);
+    engine.set_pull_readahead(false);
+    const sync::PullResponse plain =
+        engine.handle_pull(req, sync::PullBatchForm::Encoded);
+    const sync::PullResponse plain_decoded = engine.handle_pull(req);
+
+    if (hinted.encoded_batches.size() != 5u || !hinted.has_more) {
+        throw std::runtime_error("read-ahead changed the page budget");
+    }
+    if (hinted.encoded_batches != plain.encoded_batches ||
+        hinted.has_more != plain.has_more) {
+        throw std::runtime_error("read-ahead changed the encoded page");
+    }
+    if (sync::TransportMessageCodec::encode_pull_response(hinted_decoded) !=
+        sync::TransportMessageCodec::encode_pull_response(plain_decoded)) {
+        throw std::runtime_error("read-ahead changed the decoded page");
+    }
+
+    engine.set_pull_readahead(true);
+    req.have.last_seq_by_origin[node] = 10;
+    const sync::PullResponse tail = engine.handle_pull(req);
+    if (tail.batches.size() != 2u || tail.has_more || tail.batches[0].seq != 11u) {
+        throw std::runtime_error("read-ahead pull from a cursor returned the wrong tail");
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_engine_handle_push_encoded_batches() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_engine_push_encoded.mdbx";
+    const std::string replica_path = "test_engine_push_encoded_replica.mdbx";
+    cleanup(primary_path); cleanup(replica_path);
+
+    auto primary_conn = open_env(primary_path);
+    auto replica_conn = open_env(replica_path);
+    const sync::NodeId db_uuid = make_node(0xD0);
+    sync::SyncEngine primary_engine(primary_conn);
+    sync::SyncEngine replica_engine(replica_conn);
+    primary_engine.initialize_local_identity(make_node(0xA0), db_uuid);
+    replica_engine.initialize_local_identity(make_node(0xB0), db_uuid);
+
+    sync::ThreadLocalChangeAccumulator sink(primary_conn);
+    primary_conn->attach_sync_capture(&sink);
+    {
+        KeyValueTable<int, int> kv(primary_conn, "kv");
+        for (int i = 1; i <= 4; ++i) {
+            kv.insert_or_assign(i, i * 10);
+        }
+        kv.erase(2);
+    }
+    primary_conn->detach_sync_capture();
+
+    // Pull through a peer in the Encoded form, as SyncWorker does.
+    sync::DirectSyncPeer peer(&primary_engine);
+    sync::PullRequest req;
+    req.requester = make_node(0xB0);
+    req.db_id = db_uuid;
+    req.batch_form = sync::PullBatchForm::Encoded;
+    const sync::PullResponse resp = peer.pull(req);
+    if (resp.encoded_batches.size() != 5u || !resp.batches.empty()) {
+        throw std::runtime_error("peer ignored PullBatchForm::Encoded");
+    }
+
+    // A skipped batch is recognized from its header alone.
+    {
+        auto txn = replica_conn->transaction(TransactionMode::WRITABLE);
+        const sync::ChangeBatchView first(resp.encoded_batches[0]);
+        if (replica_engine.apply_batch(txn.handle(), first) != sync::ApplyResult::Applied ||
+            replica_engine.apply_batch(txn.handle(), first) != sync::ApplyResult::Skipped) {
+            throw std::runtime_error("encoded batch apply results mismatch");
+        }
+        txn.commit();
+    }
+
+    sync::PushRequest apply;
+    apply.db_id = db_uuid;
+    apply.encoded_batches = resp.encoded_batches;
+    const sync::PushResponse pushed = replica_engine.handle_push(apply);
+    if (!pushed.ok) {
+        throw std::runtime_error("encoded push failed: " + pushed.error);
+    }
+
+    KeyValueTable<int, int> replica_kv(replica_conn, "kv");
+    for (int i = 1; i <= 4; ++i) {
+        if (i == 2) {
+            continue;
+        }
+        if (kv_or_throw(replica_conn, replica_kv, i, "missing on replica") != i * 10) {
+            throw std::runtime_error("wrong value after encoded push");
+        }
+    }
+    {
+        auto txn = replica_conn->transaction(TransactionMode::READ_ONLY);
+        if (replica_kv.contains(2, txn.handle())) {
+            throw std::runtime_error("encoded delete was not applied");
+        }
+    }
+
+    primary_conn->disconnect();
+    replica_conn->disconnect();
+    cleanup(primary_path); cleanup(replica_path);
+}
+
+void test_engine_handle_push_parallel_prepare() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_engine_push_prepare.mdbx";
+    const std::string replica_path = "test_engine_push_prepare_replica.mdbx";
+    cleanup(primary_path); cleanup(replica_path);
+
+    auto primary_conn = open_env(primary_path);
+    auto replica_conn = open_env(replica_path);
+    const sync::NodeId db_uuid = make_node(0xD0);
+    sync::SyncEngine primary_engine(primary_conn);
+    sync::SyncEngine replica_engine(replica_conn);
+    primary_engine.initialize_local_identity(make_node(0xA0), db_uuid);
+    replica_engine.initialize_local_identity(make_node(0xB0), db_uuid);
+    replica_engine.set_push_prepare_threads(3);
+    if (replica_engine.push_prepare_threads() != 3u) {
+        throw std::runtime_error("push_prepare_threads mismatch");
+    }
+
+    sync::ThreadLocalChangeAccumulator sink(primary_conn);
+    primary_conn->attach_sync_capture(&sink);
+    {
+        KeyValueTable<int, int> kv(primary_conn, "kv");
+        for (int i = 1; i <= 8; ++i) {
+            kv.insert_or_assign(i, i * 10);
+        }
+    }
+    primary_conn->detach_sync_capture();
+
+    sync::PullRequest req;
+    req.requester = make_node(0xB0);
+    req.db_id = db_uuid;
+    const sync::PullResponse resp =
+        primary_engine.handle_pull(req, sync::PullBatchForm::Encoded);
+    if (resp.encoded_batches.size() != 8u) {
+        throw std::runtime_error("expected eight encoded batches");
+    }
+
+    // A gap fails the whole push without writes.
+    sync::PushRequest gap;
+    gap.db_id = db_uuid;
+    gap.encoded_batches.assign(resp.encoded_batches.begin() + 1,
+                               resp.encoded_batches.end());
+    const sync::PushResponse gap_pushed = replica_engine.handle_push(gap);
+    if (gap_pushed.ok || !gap_pushed.error_retryable ||
+        gap_pushed.receiver_have.last_seq_for(make_node(0xA0)) != 0u) {
+        throw std::runtime_error("gap push must fail atomically");
+    }
+
+    // Mixed forms apply in order; a malformed batch that is already applied
+    // is skipped by its header, as without the workers.
+    sync::PushRequest apply;
+    apply.db_id = db_uuid;
+    for (std::size_t i = 0; i < 3; ++i) {
+        apply.batches.push_back(
+            sync::ChangeBatchCodec::decode_exact(resp.encoded_batches[i]));
+    }
+    apply.encoded_batches.assign(resp.encoded_batches.begin() + 3,
+                                 resp.encoded_batches.end());
+    apply.encoded_batches.push_back(resp.encoded_batches[0]);
+    apply.encoded_batches.back().pop_back();
+    const sync::PushResponse pushed = replica_engine.handle_push(apply);
+    if (!pushed.ok || pushed.receiver_have.last_seq_for(make_node(0xA0)) != 8u) {
+        throw std::runtime_error("parallel prepared push failed: " + pushed.error);
+    }
+    KeyValueTable<int, int> replica_kv(replica_conn, "kv");
+    for (int i = 1; i <= 8; ++i) {
+        if (kv_or_throw(replica_conn, replica_kv, i, "missing on replica") != i * 10) {
+            throw std::runtime_error("wrong value after parallel prepared push");
+        }
+    }
+
+    primary_conn->disconnect();
+    replica_conn->disconnect();
+    cleanup(primary_path); cleanup(replica_path);
+}
+
 void test_engine_handle_pull_lifecycle() {
     using namespace mdbxc;
     const std::string p = "test_engine_pull_lifecycle.mdbx";
@@ -2205,15 +3655,23 @@ int main() {
           &test_engine_rejects_reserved_dbi_changes_and_rolls_back_page },
         { "test_engine_reserved_dbi_rolls_back_multi_batch_push",
           &test_engine_reserved_dbi_rolls_back_multi_batch_push },
+        { "test_engine_handle_push_coalesces",&test_engine_handle_push_coalesces_overwritten_ops },
+        { "test_engine_handle_push_nothrow",&test_engine_handle_push_nothrow_status },
+        { "test_engine_handle_push_yields",  &test_engine_handle_push_yields_to_local_writers },
         { "test_engine_skips_self_origin",      &test_engine_skips_self_origin },
         { "test_engine_idempotent_replay",      &test_engine_idempotent_replay },
         { "test_engine_legacy_zero_flags",      &test_engine_applies_legacy_zero_flags_to_integer_dbi },
         { "test_engine_conflicting_dbi_flags",  &test_engine_conflicting_dbi_flags_returns_conflict },
+        { "test_engine_sorted_apply",         &test_engine_sorted_apply_matches_capture_order },
         { "test_engine_existing_dbi_flag_mismatch",&test_engine_existing_dbi_flag_mismatch_returns_conflict },
         { "test_engine_existing_dbi_flag_mismatch_first",&test_engine_existing_dbi_flag_mismatch_reports_first_batch_dbi },
         { "test_engine_push_dbi_conflicts_not_retryable",&test_engine_push_dbi_conflicts_are_not_retryable },
         { "test_engine_gap_returns_conflict",   &test_engine_gap_returns_conflict },
         { "test_engine_applied_cursor",         &test_engine_applied_cursor },
+        { "test_engine_applied_cursor_cache",   &test_engine_applied_cursor_cache },
+        { "test_engine_push_replay_skips_writer", &test_engine_push_replay_skips_writer },
+        { "test_sharded_push_applier", &test_sharded_push_applier },
+        { "test_push_apply_queue", &test_push_apply_queue },
         { "test_engine_handle_push_to_remote",  &test_engine_handle_push_to_remote },
         { "test_engine_push_gap_rolls_back",    &test_engine_push_gap_rolls_back },
         { "test_sync_apply_observer_remove_waits",
@@ -2228,12 +3686,15 @@ int main() {
           &test_sync_apply_observer_reports_clear_and_delete_dbi_names },
         { "test_engine_push_multi_batch_gap_cursor",&test_engine_push_multi_batch_gap_reports_persistent_cursor },
         { "test_engine_handle_pull_wrong_db_id",&test_engine_handle_pull_wrong_db_id },
-        { "test_engine_rejects_full_snapshot_request",
-          &test_engine_rejects_full_snapshot_request },
+        { "test_engine_full_snapshot_bootstrap",
+          &test_engine_full_snapshot_bootstrap },
         { "test_engine_changelog_page_rejects_full_snapshot_request",
           &test_engine_changelog_page_rejects_full_snapshot_request },
         { "test_engine_pull_reports_snapshot_required_after_prune",
           &test_engine_pull_reports_snapshot_required_after_prune },
+        { "test_engine_prune_changelog_retention",
+          &test_engine_prune_changelog_retention },
+        { "test_engine_compact_changelog",   &test_engine_compact_changelog },
         { "test_engine_pull_max_bytes_is_soft_page_budget",
           &test_engine_pull_max_bytes_is_soft_page_budget },
         { "test_engine_pull_rejects_oversized_single_batch",
@@ -2244,7 +3705,15 @@ int main() {
         { "test_engine_handle_pull_pagination", &test_engine_handle_pull_pagination_has_more },
         { "test_engine_handle_pull_multi_origin",&test_engine_handle_pull_multi_origin_pagination },
         { "test_engine_handle_pull_legacy_origin_index",&test_engine_handle_pull_legacy_changelog_without_origin_index },
+        { "test_engine_handle_pull_origin_tail_cache",&test_engine_handle_pull_origin_tail_cache },
+        { "test_engine_handle_pull_round_robin",&test_engine_handle_pull_round_robin_schedule },
+        { "test_engine_handle_pull_long_poll",  &test_engine_handle_pull_long_poll },
+        { "test_engine_handle_pull_subscription",&test_engine_handle_pull_subscription },
         { "test_engine_handle_pull_skip_old_decode",&test_engine_handle_pull_skips_old_batches_without_decoding },
+        { "test_engine_handle_pull_encoded_form",&test_engine_handle_pull_encoded_form },
+        { "test_engine_handle_pull_readahead", &test_engine_handle_pull_readahead },
+        { "test_engine_handle_push_encoded_batches",&test_engine_handle_push_encoded_batches },
+        { "test_engine_handle_push_parallel_prepare",&test_engine_handle_push_parallel_prepare },
         { "test_engine_handle_pull_lifecycle", &test_engine_handle_pull_lifecycle },
     };
 
@@ -0,0 +1,356 @@
+/// \file test_sync_range_hash.cpp
+/// \brief Range-hash maintenance, anti-entropy verification and transport.
+
+#include <mdbx_containers.hpp>
+#include <mdbx_containers/sync.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void cleanup(const std::string& p) {
+    std::remove(p.c_str());
+    std::remove((p + "-lck").c_str());
+}
+
+mdbxc::sync::NodeId make_node(std::uint8_t seed) {
+    mdbxc::sync::NodeId n{};
+    for (int i = 0; i < 16; ++i) n[i] = static_cast<std::uint8_t>(seed + i);
+    return n;
+}
+
+std::shared_ptr<mdbxc::Connection> open(const std::string& path) {
+    mdbxc::Config c;
+    c.pathname = path;
+    c.max_dbs = 16;
+    c.no_subdir = true;
+    return mdbxc::Connection::create(c);
+}
+
+std::string value_or_none(const std::shared_ptr<mdbxc::Connection>& conn, int key) {
+    mdbxc::KeyValueTable<int, std::string> kv(conn, "kv");
+    auto txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+    std::string out;
+    return kv.try_get(key, out, txn.handle()) ? out : std::string("<none>");
+}
+
+/// \brief Root node of the range hashes of \p table.
+mdbxc::sync::RangeHashNode root_of(mdbxc::sync::SyncEngine& engine,
+                                   const std::string& table) {
+    mdbxc::sync::RangeHashRequest request;
+    request.db_id = engine.db_uuid();
+    request.dbi_name = table;
+    request.indexes.push_back(0);
+    const mdbxc::sync::RangeHashResponse response = engine.handle_range_hash(request);
+    if (!response.ok || response.nodes.size() != 1u) {
+        throw std::runtime_error("root request failed: " + response.error);
+    }
+    return response.nodes[0];
+}
+
+/// \brief Root now, then after a full rebuild; they must agree.
+void expect_root_matches_rebuild(mdbxc::sync::SyncEngine& engine,
+                                 const std::string& table,
+                                 std::uint64_t expected_count) {
+    const mdbxc::sync::RangeHashNode incremental = root_of(engine, table);
+    engine.rebuild_range_hash(table);
+    const mdbxc::sync::RangeHashNode rebuilt = root_of(engine, table);
+    if (incremental.count != rebuilt.count || incremental.hash != rebuilt.hash) {
+        throw std::runtime_error("incremental range hash differs from rebuild of " + table);
+    }
+    if (rebuilt.count != expected_count) {
+        throw std::runtime_error("range hash counts " + std::to_string(rebuilt.count) +
+                                 " records of " + table);
+    }
+}
+
+struct Replicas {
+    std::string primary_path;
+    std::string replica_path;
+    std::shared_ptr<mdbxc::Connection> primary_conn;
+    std::shared_ptr<mdbxc::Connection> replica_conn;
+    std::unique_ptr<mdbxc::sync::SyncEngine> primary;
+    std::unique_ptr<mdbxc::sync::SyncEngine> replica;
+    std::unique_ptr<mdbxc::sync::ThreadLocalChangeAccumulator> sink;
+
+    explicit Replicas(const std::string& prefix)
+        : primary_path(prefix + "_primary.mdbx"),
+          replica_path(prefix + "_replica.mdbx") {
+        cleanup(primary_path);
+        cleanup(replica_path);
+        primary_conn = open(primary_path);
+        replica_conn = open(replica_path);
+        primary.reset(new mdbxc::sync::SyncEngine(primary_conn));
+        replica.reset(new mdbxc::sync::SyncEngine(replica_conn));
+        primary->initialize_local_identity(make_node(0xA0), make_node(0xD0));
+        replica->initialize_local_identity(make_node(0xB0), make_node(0xD0));
+        sink.reset(new mdbxc::sync::ThreadLocalChangeAccumulator(primary_conn));
+        primary_conn->attach_sync_capture(sink.get());
+    }
+
+    ~Replicas() {
+        primary_conn->detach_sync_capture();
+        primary.reset();
+        replica.reset();
+        primary_conn->disconnect();
+        replica_conn->disconnect();
+        cleanup(primary_path);
+        cleanup(replica_path);
+    }
+
+    void pull() {
+        mdbxc::sync::PullRequest request;
+        request.requester = replica->local_node_id();
+        request.db_id = replica->db_uuid();
+        bool has_more = true;
+        while (has_more) {
+            request.have = replica->applied_cursor();
+            const mdbxc::sync::PullResponse page = primary->handle_pull(request);
+            if (!page.ok) throw std::runtime_error("pull failed: " + page.error);
+            if (!page.batches.empty()) {
+                mdbxc::sync::PushRequest push;
+                push.sender = primary->local_node_id();
+                push.db_id = primary->db_uuid();
+                push.batches = page.batches;
+                const mdbxc::sync::PushResponse applied = replica->handle_push(push);
+                if (!applied.ok) throw std::runtime_error("apply failed: " + applied.error);
+            }
+            has_more = page.has_more;
+        }
+    }
+};
+
+void test_range_hash_incremental_matches_rebuild() {
+    Replicas r("test_range_hash_incremental");
+    mdbxc::KeyValueTable<int, std::string> kv(r.primary_conn, "kv");
+    mdbxc::KeyMultiValueTable<int, int> multi(r.primary_conn, "multi");
+    kv.insert_or_assign(0, "seed");
+    multi.insert(0, 0);
+    // Small leaves, so writes often add and remove leaf starts.
+    r.primary->enable_range_hash("kv", 2);
+    r.primary->enable_range_hash("multi", 2);
+
+    std::mt19937 rng(136);
+    std::map<int, std::string> model;
+    model[0] = "seed";
+    for (int round = 0; round < 40; ++round) {
+        auto txn = r.primary_conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        for (int i = 0; i < 25; ++i) {
+            const int key = static_cast<int>(rng() % 300);
+            if (rng() % 4 == 0) {
+                kv.erase(key, txn.handle());
+                multi.erase(key, txn.handle());
+                model.erase(key);
+            } else {
+                const std::string value = "v" + std::to_string(rng() % 1000);
+                kv.insert_or_assign(key, value, txn.handle());
+                multi.insert(key, static_cast<int>(rng() % 3), txn.handle());
+                model[key] = value;
+            }
+        }
+        txn.commit();
+    }
+    expect_root_matches_rebuild(*r.primary, "kv", model.size());
+    const std::uint64_t multi_count = root_of(*r.primary, "multi").count;
+    expect_root_matches_rebuild(*r.primary, "multi", multi_count);
+
+    kv.clear();
+    expect_root_matches_rebuild(*r.primary, "kv", 0);
+}
+
+void test_range_hash_follows_remote_apply() {
+    Replicas r("test_range_hash_apply");
+    mdbxc::KeyValueTable<int, int> kv(r.primary_conn, "kv");
+    kv.insert_or_assign(1, 1);
+    r.pull();
+    r.replica->enable_range_hash("kv", 3);
+    for (int i = 0; i < 200; ++i) {
+        kv.insert_or_assign(i, i * 7);
+    }
+    for (int i = 0; i < 200; i += 3) {
+        kv.erase(i);
+    }
+    r.pull();
+    expect_root_matches_rebuild(*r.replica, "kv", 200 - 67);
+}
+
+void test_range_hash_verify_repairs_divergence() {
+    Replicas r("test_range_hash_verify");
+    mdbxc::KeyValueTable<int, std::string> kv(r.primary_conn, "kv");
+    for (int i = 0; i < 500; ++i) {
+        kv.insert_or_assign(i, "p" + std::to_string(i));
+    }
+    r.pull();
+    r.primary->enable_range_hash("kv", 3);
+    r.replica->enable_range_hash("kv", 3);
+
+    mdbxc::sync::DirectSyncPeer peer(r.primary.get());
+    mdbxc::sync::RangeHashVerifier verifier(*r.replica, peer);
+    mdbxc::sync::RangeHashVerifyResult result = verifier.verify("kv");
+    if (!result.ok || !result.consistent || result.requests != 2u) {
+        throw std::runtime_error("equal replicas did not match at the root");
+    }
+
+    // Lost updates on the replica, and writes it never pulled.
+    {
+        mdbxc::KeyValueTable<int, std::string> replica_kv(r.replica_conn, "kv");
+        replica_kv.erase(17);
+        replica_kv.insert_or_assign(250, "stale");
+        replica_kv.insert_or_assign(9000, "extra");
+    }
+    r.replica->rebuild_range_hash("kv");
+    kv.insert_or_assign(420, "changed");
+    kv.erase(3);
+
+    mdbxc::sync::RangeHashVerifyOptions options;
+    options.repair = false;
+    mdbxc::sync::RangeHashVerifier checker(*r.replica, peer, options);
+    result = checker.verify("kv");
+    if (!result.ok || result.consistent || result.divergent_buckets == 0u ||
+        result.divergent_ranges != 0u) {
+        throw std::runtime_error("check without repair missed the divergence");
+    }
+
+    result = verifier.verify("kv");
+    if (!result.ok || result.consistent || !result.consistent_after_repair) {
+        throw std::runtime_error("verify did not repair: " + result.error);
+    }
+    if (result.records_fetched == 0u || result.records_fetched > 200u) {
+        throw std::runtime_error("verify fetched " + std::to_string(result.records_fetched) +
+                                 " records for five differing keys");
+    }
+    if (value_or_none(r.replica_conn, 17) != "p17" ||
+        value_or_none(r.replica_conn, 250) != "p250" ||
+        value_or_none(r.replica_conn, 420) != "changed" ||
+        value_or_none(r.replica_conn, 3) != "<none>" ||
+        value_or_none(r.replica_conn, 9000) != "<none>") {
+        throw std::runtime_error("repaired replica differs from the primary");
+    }
+    expect_root_matches_rebuild(*r.replica, "kv", 499);
+}
+
+void test_range_hash_unavailable_and_transport() {
+    Replicas r("test_range_hash_transport");
+    mdbxc::KeyValueTable<int, int> kv(r.primary_conn, "kv");
+    for (int i = 0; i < 50; ++i) {
+        kv.insert_or_assign(i, i);
+    }
+    r.pull();
+
+    mdbxc::sync::HttpSyncServer server(*r.primary);
+    struct Loopback : mdbxc::sync::IHttpSyncClient {
+        explicit Loopback(mdbxc::sync::HttpSyncServer& s) : server(s) {}
+        mdbxc::sync::HttpSyncResponse post(const std::string& target,
+                                           const std::string& content_type,
+                                           const std::vector<std::uint8_t>& body,
+                                           const mdbxc::sync::CancellationToken&) override {
+            mdbxc::sync::HttpSyncRequest request;
+            request.method = mdbxc::sync::HttpSyncRoutes::method_post();
+            request.target = target;
+            request.content_type = content_type;
+            request.body = body;
+            return server.handle(request);
+        }
+        mdbxc::sync::HttpSyncServer& server;
+    } client(server);
+    mdbxc::sync::HttpSyncPeer peer(client);
+
+    r.replica->enable_range_hash("kv");
+    mdbxc::sync::RangeHashVerifier verifier(*r.replica, peer);
+    mdbxc::sync::RangeHashVerifyResult result = verifier.verify("kv");
+    if (result.ok ||
+        result.error_code != mdbxc::sync::SyncResponseErrorCode::RangeHashUnavailable) {
+        throw std::runtime_error("table without range hashes was compared");
+    }
+
+    r.primary->enable_range_hash("kv");
+    {
+        mdbxc::KeyValueTable<int, int> replica_kv(r.replica_conn, "kv");
+        replica_kv.insert_or_assign(7, -7);
+    }
+    r.replica->rebuild_range_hash("kv");
+    result = verifier.verify("kv");
+    if (!result.ok || result.consistent || !result.consistent_after_repair) {
+        throw std::runtime_error("verify over HTTP failed: " + result.error);
+    }
+
+    mdbxc::sync::RangeHashRequest request;
+    request.requester = make_node(1);
+    request.db_id = make_node(2);
+    request.dbi_name = "kv";
+    request.query = mdbxc::sync::RangeHashQuery::Records;
+    request.from_head = false;
+    request.lo.assign(3, 0x01);
+    request.has_hi = true;
+    request.hi.assign(2, 0xFF);
+    request.max_records = 9;
+    const mdbxc::sync::RangeHashRequest decoded_request =
+        mdbxc::sync::TransportMessageCodec::decode_range_hash_request(
+            mdbxc::sync::TransportMessageCodec::encode_range_hash_request(request));
+    if (decoded_request.dbi_name != "kv" || decoded_request.query != request.query ||
+        decoded_request.from_head || decoded_request.lo != request.lo ||
+        !decoded_request.has_hi || decoded_request.hi != request.hi ||
+        decoded_request.max_records != 9u) {
+        throw std::runtime_error("range hash request round trip");
+    }
+
+    mdbxc::sync::RangeHashResponse response;
+    response.ok = false;
+    response.error_code = mdbxc::sync::SyncResponseErrorCode::RangeHashUnavailable;
+    response.leaf_bits = 6;
+    mdbxc::sync::RangeHashLeaf leaf;
+    leaf.bucket = 65535;
+    leaf.start_key.assign(4, 0x42);
+    leaf.count = 3;
+    leaf.hash = 0x0123456789ABCDEFull;
+    response.leaves.push_back(leaf);
+    mdbxc::sync::RangeHashRecord record;
+    record.key.assign(1, 0x07);
+    record.value.assign(5, 0x09);
+    response.records.push_back(record);
+    response.has_more = true;
+    response.resume_key.assign(1, 0x08);
+    const mdbxc::sync::RangeHashResponse decoded =
+        mdbxc::sync::TransportMessageCodec::decode_range_hash_response(
+            mdbxc::sync::TransportMessageCodec::encode_range_hash_response(response));
+    if (decoded.ok || decoded.error_code != response.error_code || decoded.leaf_bits != 6u ||
+        decoded.leaves.size() != 1u || decoded.leaves[0].bucket != 65535u ||
+        decoded.leaves[0].start_key != leaf.start_key || decoded.leaves[0].hash != leaf.hash ||
+        decoded.records.size() != 1u || decoded.records[0].value != record.value ||
+        !decoded.has_more || decoded.resume_key != response.resume_key) {
+        throw std::runtime_error("range hash response round trip");
+    }
+}
+
+} // namespace
+
+int main() {
+    struct Case { const char* name; void (*fn)(); };
+    const Case cases[] = {
+        { "test_range_hash_incremental_matches_rebuild",
+          &test_range_hash_incremental_matches_rebuild },
+        { "test_range_hash_follows_remote_apply", &test_range_hash_follows_remote_apply },
+        { "test_range_hash_verify_repairs_divergence",
+          &test_range_hash_verify_repairs_divergence },
+        { "test_range_hash_unavailable_and_transport",
+          &test_range_hash_unavailable_and_transport },
+    };
+    int rc = 0;
+    for (std::size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        try {
+            cases[i].fn();
+            std::printf("PASS %s\n", cases[i].name);
+        } catch (const std::exception& e) {
+            std::printf("FAIL %s: %s\n", cases[i].name, e.what());
+            rc = static_cast<int>(i + 1);
+        }
+    }
+    return rc;
+}
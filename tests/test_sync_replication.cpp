@@ -302,6 +302,149 @@ void test_replication_mixed_ops() {
     cleanup(p); cleanup(r);
 }
 
+/// \brief Merges from two origins converge on a replica without overwriting each other.
+void test_replication_merge_ops_converge() {
+    using namespace mdbxc;
+    const std::string a = "test_rep_merge_a.mdbx";
+    const std::string b = "test_rep_merge_b.mdbx";
+    const std::string r = "test_rep_merge_replica.mdbx";
+    cleanup(a); cleanup(b); cleanup(r);
+
+    auto origin_a = open(a);
+    auto origin_b = open(b);
+    auto replica = open(r);
+    sync::SyncEngine ae(origin_a), be(origin_b), re(replica);
+    ae.initialize_local_identity(make_node(0xA1), make_node(0xD1));
+    be.initialize_local_identity(make_node(0xA2), make_node(0xD1));
+    re.initialize_local_identity(make_node(0xB1), make_node(0xD1));
+
+    sync::ThreadLocalChangeAccumulator sink_a(origin_a);
+    sync::ThreadLocalChangeAccumulator sink_b(origin_b);
+    origin_a->attach_sync_capture(&sink_a);
+    origin_b->attach_sync_capture(&sink_b);
+    {
+        KeyValueTable<int, std::int64_t> hits_a(origin_a, "merge_hits");
+        KeyValueTable<int, std::vector<std::uint32_t>> tags_a(origin_a, "merge_tags");
+        hits_a.set_merge_operator(MergeKind::AddInteger);
+        tags_a.set_merge_operator(MergeKind::SetUnion);
+        hits_a.merge(1, 5);
+        hits_a.merge(1, 7);
+        tags_a.merge(1, std::vector<std::uint32_t>{3, 1});
+
+        KeyValueTable<int, std::int64_t> hits_b(origin_b, "merge_hits");
+        KeyValueTable<int, std::vector<std::uint32_t>> tags_b(origin_b, "merge_tags");
+        hits_b.set_merge_operator(MergeKind::AddInteger);
+        tags_b.set_merge_operator(MergeKind::SetUnion);
+        hits_b.merge(1, -2);
+        tags_b.merge(1, std::vector<std::uint32_t>{2, 3});
+    }
+    origin_a->detach_sync_capture();
+    origin_b->detach_sync_capture();
+
+    {
+        sync::DirectSyncPeer peer(&ae);
+        sync::PullRequest req; req.requester = make_node(0xB1); req.db_id = make_node(0xD1);
+        const sync::PullResponse resp = peer.pull(req);
+        if (resp.batches.empty() || resp.batches[0].ops.empty() ||
+            resp.batches[0].ops[0].op_type != sync::ChangeOpType::Merge) {
+            throw std::runtime_error("merge was not captured as a merge op");
+        }
+    }
+    pull_all_to_replica(ae, re, make_node(0xA1), make_node(0xB1), make_node(0xD1));
+    pull_all_to_replica(be, re, make_node(0xA2), make_node(0xB1), make_node(0xD1));
+
+    {
+        KeyValueTable<int, std::int64_t> hits(replica, "merge_hits");
+        KeyValueTable<int, std::vector<std::uint32_t>> tags(replica, "merge_tags");
+        if (kv_or_throw(replica, hits, 1, "hits[1]") != 10) throw std::runtime_error("hits[1]");
+        if (kv_or_throw(replica, tags, 1, "tags[1]") != std::vector<std::uint32_t>({1, 2, 3})) {
+            throw std::runtime_error("tags[1]");
+        }
+    }
+
+    origin_a->disconnect(); origin_b->disconnect(); replica->disconnect();
+    cleanup(a); cleanup(b); cleanup(r);
+}
+
+/// \brief KeyMultiValueTable changes replicate as per-value ops and keep multiplicity.
+void test_replication_multi_value_multiset() {
+    using namespace mdbxc;
+    typedef KeyMultiValueTable<int, std::string> MultiTable;
+    const std::string p = "test_rep_multi_value.mdbx";
+    const std::string r = "test_rep_multi_value_replica.mdbx";
+    cleanup(p); cleanup(r);
+
+    auto primary = open(p);
+    auto replica = open(r);
+    sync::SyncEngine pe(primary), re(replica);
+    pe.initialize_local_identity(make_node(0xA1), make_node(0xD1));
+    re.initialize_local_identity(make_node(0xB1), make_node(0xD1));
+    {
+        // Local values hold the replica's own sequence prefixes.
+        MultiTable local(replica, "multi");
+        local.insert(1, "local");
+    }
+
+    sync::ThreadLocalChangeAccumulator sink(primary);
+    primary->attach_sync_capture(&sink);
+    MultiTable multi(primary, "multi");
+    std::vector<std::string> many(200, "bulk");
+    multi.insert_many(9, many.begin(), many.end());
+    multi.insert(1, "a");
+    multi.insert(1, "a");
+    multi.insert(1, "a");
+    multi.insert(1, "b");
+    multi.insert(2, "c");
+    pull_all_to_replica(pe, re, make_node(0xA1), make_node(0xB1), make_node(0xD1));
+
+    std::vector<MultiTable::value_type> desired;
+    desired.push_back(MultiTable::value_type(1, "a"));
+    desired.push_back(MultiTable::value_type(1, "b"));
+    desired.push_back(MultiTable::value_type(1, "d"));
+    desired.push_back(MultiTable::value_type(2, "c"));
+    desired.push_back(MultiTable::value_type(2, "c"));
+    for (std::size_t i = 0; i < many.size(); ++i) {
+        desired.push_back(MultiTable::value_type(9, "bulk"));
+    }
+    multi.reconcile(desired);
+    multi.erase(1, "b");
+    multi.insert(9, "one more");
+
+    {
+        // A change to a large value set ships only the changed values.
+        sync::DirectSyncPeer peer(&pe);
+        sync::PullRequest req; req.requester = make_node(0xB1); req.db_id = make_node(0xD1);
+        req.have = re.applied_cursor();
+        const sync::PullResponse resp = peer.pull(req);
+        std::size_t ops = 0;
+        for (std::size_t i = 0; i < resp.batches.size(); ++i) {
+            ops += resp.batches[i].ops.size();
+        }
+        if (!resp.ok || ops != 6u) {
+            throw std::runtime_error("multi-value change shipped " + std::to_string(ops) + " ops");
+        }
+    }
+    pull_all_to_replica(pe, re, make_node(0xA1), make_node(0xB1), make_node(0xD1));
+    primary->detach_sync_capture();
+
+    {
+        MultiTable copy(replica, "multi");
+        if (copy.count(1, "a") != 1u || copy.count(1, "b") != 0u ||
+            copy.count(1, "d") != 1u || copy.count(1, "local") != 1u ||
+            copy.count(2, "c") != 2u ||
+            copy.count(9, "bulk") != many.size() || copy.count(9, "one more") != 1u) {
+            throw std::runtime_error("replica multiset counts differ from the primary");
+        }
+        copy.insert(1, "after");
+        if (copy.count(1) != 4u) {
+            throw std::runtime_error("replica cannot insert after replicated values");
+        }
+    }
+
+    primary->disconnect(); replica->disconnect();
+    cleanup(p); cleanup(r);
+}
+
 void test_replication_value_table_singleton_key() {
     using namespace mdbxc;
     const std::string p = "test_rep_value_table.mdbx";
@@ -1420,12 +1563,63 @@ void test_vector_store_search_during_remote_apply() {
 
 } // namespace
 
+void test_vector_store_incremental_remote_refresh() {
+    using namespace mdbxc;
+    const std::string p = "test_rep_vector_incremental.mdbx";
+    const std::string r = "test_rep_vector_incremental_replica.mdbx";
+    cleanup(p); cleanup(r);
+
+    auto primary = open(p);
+    auto replica = open(r);
+    const sync::NodeId primary_node = make_node(0xA0);
+    const sync::NodeId replica_node = make_node(0xB0);
+    const sync::NodeId db_id = make_node(0xD0);
+    sync::SyncEngine pe(primary), re(replica);
+    pe.initialize_local_identity(primary_node, db_id);
+    re.initialize_local_identity(replica_node, db_id);
+
+    sync::ThreadLocalChangeAccumulator sink(primary);
+    primary->attach_sync_capture(&sink);
+    VectorStore source(primary, "incremental");
+    const std::uint64_t alpha_id = source.add(make_embedding(1.0f, 0.0f), "alpha", "{}");
+    source.add(make_embedding(0.0f, 1.0f), "beta", "{}");
+    if (pull_all_to_replica(pe, re, primary_node, replica_node, db_id, 10) == 0u) {
+        throw std::runtime_error("incremental vector setup pulled no batches");
+    }
+
+    VectorStore live(replica, "incremental");
+    if (live.search(make_embedding(1.0f, 0.0f), 10).size() != 2u) {
+        throw std::runtime_error("incremental vector setup did not replicate");
+    }
+
+    // Applied ids are patched into the open store's index on its next search.
+    const std::uint64_t gamma_id = source.add(make_embedding(0.9f, 0.1f), "gamma", "{}");
+    if (!source.erase(alpha_id)) {
+        throw std::runtime_error("incremental vector erase setup failed");
+    }
+    if (pull_all_to_replica(pe, re, primary_node, replica_node, db_id, 10) == 0u) {
+        throw std::runtime_error("incremental vector changes pulled no batches");
+    }
+    primary->detach_sync_capture();
+
+    const std::vector<SearchResult> results = live.search(make_embedding(1.0f, 0.0f), 10);
+    if (results.size() != 2u || results[0].id != gamma_id ||
+        results[0].text != "gamma" || results[1].text != "beta") {
+        throw std::runtime_error("VectorStore did not apply remote add and erase");
+    }
+
+    primary->disconnect(); replica->disconnect();
+    cleanup(p); cleanup(r);
+}
+
 int main() {
     struct Case { const char* name; void (*fn)(); };
     const Case cases[] = {
         { "test_replication_pull_three_tables",  &test_replication_pull_three_tables },
         { "test_replication_push_three_tables",  &test_replication_push_three_tables },
         { "test_replication_mixed_ops",          &test_replication_mixed_ops },
+        { "test_replication_merge_ops_converge", &test_replication_merge_ops_converge },
+        { "test_replication_multi_value_multiset", &test_replication_multi_value_multiset },
         { "test_replication_value_table_singleton_key", &test_replication_value_table_singleton_key },
         { "test_replication_sequence_table_roundtrip",
           &test_replication_sequence_table_roundtrip },
@@ -1443,6 +1637,8 @@ int main() {
         { "test_replication_make_push_request", &test_replication_make_push_request_helper },
         { "test_vector_store_search_during_remote_apply",
           &test_vector_store_search_during_remote_apply },
+        { "test_vector_store_incremental_remote_refresh",
+          &test_vector_store_incremental_remote_refresh },
     };
     int rc = 0;
     for (std::size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
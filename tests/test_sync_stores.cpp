@@ -421,6 +421,67 @@ void test_applied_store() {
     cleanup(p);
 }
 
+void test_peer_watermark_store() {
+    using namespace mdbxc::sync;
+    const std::string p = "test_sync_stores_peers.mdbx";
+    cleanup(p);
+
+    mdbxc::Config cfg;
+    cfg.pathname = p;
+    cfg.max_dbs = 8;
+    cfg.no_subdir = true;
+    auto conn = mdbxc::Connection::create(cfg);
+
+    PeerWatermarkStore store(conn->env_handle());
+    const NodeId peer_a = make_node(0x10);
+    const NodeId peer_b = make_node(0x20);
+    const NodeId origin_x = make_node(0xC0);
+    const NodeId origin_y = make_node(0xD0);
+
+    {
+        auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        store.open(txn.handle());
+        SyncCursor have;
+        have.last_seq_by_origin[origin_x] = 7;
+        have.last_seq_by_origin[origin_y] = 3;
+        store.record(txn.handle(), peer_a, have, 1000);
+        have.last_seq_by_origin.erase(origin_y);
+        have.last_seq_by_origin[origin_x] = 5;
+        store.record(txn.handle(), peer_a, have, 2000);
+        store.record(txn.handle(), peer_b, have, 1500);
+        txn.commit();
+    }
+
+    {
+        auto txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+        const std::vector<PeerWatermarkStore::PeerWatermark> peers = store.peers(txn.handle());
+        if (peers.size() != 2u || peers[0].peer != peer_a || peers[1].peer != peer_b) {
+            throw std::runtime_error("peer watermarks not listed per peer in key order");
+        }
+        // A lower report replaces the row; an unreported origin keeps its own.
+        if (peers[0].have.last_seq_for(origin_x) != 5u ||
+            peers[0].have.last_seq_for(origin_y) != 3u ||
+            peers[0].seen_unix_ms != 2000u) {
+            throw std::runtime_error("peer_a watermark mismatch");
+        }
+    }
+
+    {
+        auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        if (store.forget(txn.handle(), peer_a) != 2u) {
+            throw std::runtime_error("forget must remove every row of the peer");
+        }
+        const std::vector<PeerWatermarkStore::PeerWatermark> peers = store.peers(txn.handle());
+        if (peers.size() != 1u || peers[0].peer != peer_b) {
+            throw std::runtime_error("forget removed the wrong peer");
+        }
+        txn.commit();
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
 void test_identity_index_store() {
     using namespace mdbxc::sync;
     const std::string p = "test_sync_stores_identity.mdbx";
@@ -488,6 +549,66 @@ void test_identity_index_store() {
     cleanup(p);
 }
 
+void test_identity_index_write_batch() {
+    using namespace mdbxc::sync;
+    const std::string p = "test_sync_stores_identity_batch.mdbx";
+    cleanup(p);
+
+    mdbxc::Config cfg;
+    cfg.pathname = p;
+    cfg.max_dbs = 8;
+    cfg.no_subdir = true;
+    auto conn = mdbxc::Connection::create(cfg);
+
+    IdentityIndexStore store(conn->env_handle());
+    auto make_update = [](const std::string& dbi, std::uint8_t id, std::uint64_t seq) {
+        IdentityIndexUpdate u;
+        u.dbi_name = dbi;
+        u.identity_key = { id };
+        u.value.storage_key = { id, 0x01 };
+        u.value.origin_node_id = make_node(0xE0);
+        u.value.seq = seq;
+        return u;
+    };
+
+    {
+        auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        store.open(txn.handle());
+        store.put(txn.handle(), "b", { 0x07 }, make_update("b", 0x07, 1).value);
+        std::vector<IdentityIndexUpdate> updates;
+        updates.push_back(make_update("b", 0x02, 2));
+        updates.push_back(make_update("a", 0x05, 3));
+        updates.push_back(make_update("b", 0x02, 4));
+        IdentityIndexUpdate gone = make_update("b", 0x07, 5);
+        gone.erase = true;
+        updates.push_back(gone);
+        IdentityIndexUpdate missing = make_update("c", 0x09, 6);
+        missing.erase = true;
+        updates.push_back(missing);
+        if (store.write_batch(txn.handle(), updates) != 3u) {
+            throw std::runtime_error("write_batch should skip superseded and absent entries");
+        }
+        txn.commit();
+    }
+
+    {
+        auto txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+        IdentityIndexValue out;
+        if (!store.get(txn.handle(), "b", { 0x02 }, out) || out.seq != 4u) {
+            throw std::runtime_error("last update of a key should win");
+        }
+        if (!store.get(txn.handle(), "a", { 0x05 }, out) || out.seq != 3u) {
+            throw std::runtime_error("batched put missing");
+        }
+        if (store.get(txn.handle(), "b", { 0x07 }, out)) {
+            throw std::runtime_error("batched erase should remove the record");
+        }
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
 void test_changelog_prune_up_to_boundary() {
     using namespace mdbxc::sync;
     const std::string p = "test_sync_stores_prune.mdbx";
@@ -570,6 +691,192 @@ void test_changelog_prune_does_not_touch_other_origin() {
     cleanup(p);
 }
 
+std::vector<std::uint8_t> encode_table_batch(const mdbxc::sync::NodeId& origin,
+                                             std::uint64_t seq,
+                                             const std::vector<std::string>& tables) {
+    mdbxc::sync::ChangeBatch batch;
+    batch.origin_node_id = origin;
+    batch.seq = seq;
+    for (std::size_t i = 0; i < tables.size(); ++i) {
+        mdbxc::sync::ChangeOp op;
+        op.dbi_name = tables[i];
+        op.op_type = mdbxc::sync::ChangeOpType::Put;
+        op.storage_key = { static_cast<std::uint8_t>(i) };
+        op.value = { 0x01 };
+        batch.ops.push_back(op);
+    }
+    return mdbxc::sync::ChangeBatchCodec::encode(batch);
+}
+
+void expect_dbi_index_seq(MDBX_txn* txn,
+                          const mdbxc::sync::ChangeLogDbiIndexStore& index,
+                          const std::string& table,
+                          const mdbxc::sync::NodeId& origin,
+                          std::uint64_t from_seq,
+                          std::uint64_t expected) {
+    std::uint64_t seq = 0;
+    const bool found = index.next_seq(txn, table, origin, from_seq, seq);
+    if (found != (expected != 0) || (found && seq != expected)) {
+        throw std::runtime_error("dbi index: unexpected next seq of " + table +
+                                 " from " + std::to_string(from_seq));
+    }
+}
+
+void test_changelog_dbi_index() {
+    using namespace mdbxc::sync;
+    const std::string p = "test_sync_stores_dbi_index.mdbx";
+    cleanup(p);
+
+    mdbxc::Config cfg;
+    cfg.pathname = p;
+    cfg.max_dbs = 8;
+    cfg.no_subdir = true;
+    auto conn = mdbxc::Connection::create(cfg);
+
+    const NodeId origin = make_node(0xA4);
+    const NodeId other = make_node(0xB4);
+    {
+        auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        ChangeLogStore log(conn->env_handle());
+        log.open(txn.handle());
+        log.append(txn.handle(), origin, 1, encode_table_batch(origin, 1, { "orders", "audit", "orders" }));
+        log.append(txn.handle(), origin, 2, encode_table_batch(origin, 2, { "audit" }));
+        ChangeLogDbiIndexStore absent(conn->env_handle());
+        if (absent.open_existing(txn.handle())) {
+            throw std::runtime_error("dbi index must not exist before it is built");
+        }
+        if (log.rebuild_dbi_index(txn.handle()) != 2u) {
+            throw std::runtime_error("dbi index rebuild should index both batches");
+        }
+        txn.commit();
+    }
+    {
+        // A fresh store finds the index and keeps it in step.
+        auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        ChangeLogStore log(conn->env_handle());
+        log.open(txn.handle());
+        log.append(txn.handle(), origin, 3, encode_table_batch(origin, 3, { "orders" }));
+        log.append(txn.handle(), other, 1, encode_table_batch(other, 1, { "orders" }));
+
+        ChangeLogDbiIndexStore index(conn->env_handle());
+        if (!index.open_existing(txn.handle())) {
+            throw std::runtime_error("dbi index should exist after rebuild");
+        }
+        expect_dbi_index_seq(txn.handle(), index, "orders", origin, 1, 1);
+        expect_dbi_index_seq(txn.handle(), index, "orders", origin, 2, 3);
+        expect_dbi_index_seq(txn.handle(), index, "audit", origin, 2, 2);
+        expect_dbi_index_seq(txn.handle(), index, "audit", origin, 3, 0);
+        expect_dbi_index_seq(txn.handle(), index, "users", origin, 1, 0);
+
+        if (!log.erase(txn.handle(), origin, 3)) {
+            throw std::runtime_error("seq 3 should be erased");
+        }
+        expect_dbi_index_seq(txn.handle(), index, "orders", origin, 2, 0);
+        if (log.prune_up_to(txn.handle(), origin, 1) != 1u) {
+            throw std::runtime_error("prune should remove seq 1");
+        }
+        expect_dbi_index_seq(txn.handle(), index, "orders", origin, 1, 0);
+        expect_dbi_index_seq(txn.handle(), index, "audit", origin, 1, 2);
+        expect_dbi_index_seq(txn.handle(), index, "orders", other, 1, 1);
+        txn.commit();
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
+void test_changelog_per_origin_layout() {
+    using namespace mdbxc::sync;
+    const std::string p = "test_sync_stores_per_origin.mdbx";
+    cleanup(p);
+
+    mdbxc::Config cfg;
+    cfg.pathname = p;
+    cfg.max_dbs = 12;
+    cfg.no_subdir = true;
+    auto conn = mdbxc::Connection::create(cfg);
+
+    SyncEngine engine(conn);
+    engine.initialize_local_identity(make_node(0xA5), make_node(0xD5));
+    engine.set_changelog_layout(ChangeLogLayout::PerOrigin);
+    if (engine.changelog_layout() != ChangeLogLayout::PerOrigin) {
+        throw std::runtime_error("per-origin layout was not recorded");
+    }
+
+    const NodeId origin = make_node(0xA5);
+    const NodeId other = make_node(0xB5);
+    {
+        auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        ChangeLogStore log(conn->env_handle());
+        log.open(txn.handle());
+        if (log.layout() != ChangeLogLayout::PerOrigin) {
+            throw std::runtime_error("store did not read the per-origin layout");
+        }
+        log.append(txn.handle(), origin, 1, encode_table_batch(origin, 1, { "orders" }));
+        log.append(txn.handle(), other, 1, encode_table_batch(other, 1, { "orders" }));
+        // Out of order: falls back from MDBX_APPEND.
+        log.append(txn.handle(), origin, 3, encode_table_batch(origin, 3, { "orders" }));
+        log.append(txn.handle(), origin, 2, encode_table_batch(origin, 2, { "orders" }));
+
+        const ChangeLogKeyspace keys = log.keyspace(txn.handle());
+        if (keys.dbi_for(origin) == 0 || keys.dbi_for(origin) == log.handle() ||
+            keys.dbi_for(origin) == keys.dbi_for(other)) {
+            throw std::runtime_error("each origin needs its own DBI");
+        }
+        MDBX_stat stat;
+        mdbxc::check_mdbx(mdbx_dbi_stat(txn.handle(), log.handle(), &stat, sizeof(stat)),
+                          "stat failed");
+        if (stat.ms_entries != 0) {
+            throw std::runtime_error("shared DBI must stay empty");
+        }
+        const std::vector<NodeId> origins = keys.origins();
+        if (origins.size() != 2u || origins[0] != origin || origins[1] != other) {
+            throw std::runtime_error("keyspace should list both origins");
+        }
+        if (keys.dbi_for(make_node(0xC5)) != 0) {
+            throw std::runtime_error("unknown origin must have no DBI");
+        }
+        if (!log.contains(txn.handle(), origin, 2) ||
+            log.contains(txn.handle(), make_node(0xC5), 1)) {
+            throw std::runtime_error("contains mismatch in per-origin layout");
+        }
+        if (log.prune_up_to(txn.handle(), origin, 2) != 2u) {
+            throw std::runtime_error("prune should remove seq 1 and 2");
+        }
+        std::uint64_t seq = 0;
+        MDBX_val value;
+        if (!log.first(txn.handle(), origin, seq, value) || seq != 3) {
+            throw std::runtime_error("first retained seq should be 3");
+        }
+        if (log.stored_bytes(txn.handle()) == 0) {
+            throw std::runtime_error("stored_bytes should count per-origin DBIs");
+        }
+        txn.commit();
+    }
+    {
+        auto txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+        PullRequest request;
+        request.requester = make_node(0xE5);
+        request.db_id = make_node(0xD5);
+        const PullResponse page = engine.pull_changelog_page(txn.handle(), 0, request);
+        if (!page.ok) {
+            throw std::runtime_error("per-origin pull failed: " + page.error);
+        }
+        if (page.batches.size() != 2u || page.batches[0].seq != 3 ||
+            page.batches[1].origin_node_id != other) {
+            throw std::runtime_error("per-origin pull returned unexpected batches");
+        }
+    }
+    try {
+        engine.set_changelog_layout(ChangeLogLayout::Shared);
+        throw std::runtime_error("layout change over records must throw");
+    } catch (const std::logic_error&) {
+    }
+
+    conn->disconnect();
+    cleanup(p);
+}
+
 void test_identity_key_collision() {
     using namespace mdbxc::sync;
     const std::string p = "test_sync_stores_collision.mdbx";
@@ -648,33 +955,45 @@ void test_stores_require_open() {
 
         MetaStore meta(conn->env_handle());
         expect_open_required("MetaStore::get_db_uuid", meta,
-                            [&] { (void)meta.get_db_uuid(txn.handle()); });
+                            [&meta, &txn] { (void)meta.get_db_uuid(txn.handle()); });
         expect_open_required("MetaStore::set_db_uuid", meta,
-                            [&] { meta.set_db_uuid(txn.handle(), make_node(0xA0)); });
+                            [&meta, &txn] { meta.set_db_uuid(txn.handle(), make_node(0xA0)); });
         expect_open_required("MetaStore::get_local_seq", meta,
-                            [&] { (void)meta.get_local_seq(txn.handle()); });
+                            [&meta, &txn] { (void)meta.get_local_seq(txn.handle()); });
         expect_open_required("MetaStore::increment_local_seq", meta,
-                            [&] { (void)meta.increment_local_seq(txn.handle()); });
+                            [&meta, &txn] { (void)meta.increment_local_seq(txn.handle()); });
 
         AppliedStore applied(conn->env_handle());
         expect_open_required("AppliedStore::last_applied_seq", applied,
-                            [&] { (void)applied.last_applied_seq(txn.handle(), make_node(0xB0)); });
+                            [&applied, &txn] { (void)applied.last_applied_seq(txn.handle(), make_node(0xB0)); });
         expect_open_required("AppliedStore::set_last_applied_seq", applied,
-                            [&] { applied.set_last_applied_seq(txn.handle(), make_node(0xB0), 1); });
+                            [&applied, &txn] { applied.set_last_applied_seq(txn.handle(), make_node(0xB0), 1); });
 
         ChangeLogStore change(conn->env_handle());
         expect_open_required("ChangeLogStore::append", change,
-                            [&] { change.append(txn.handle(), make_node(0xC0), 1, { 0x01 }); });
+                            [&change, &txn] { change.append(txn.handle(), make_node(0xC0), 1, { 0x01 }); });
         expect_open_required("ChangeLogStore::contains", change,
-                            [&] { (void)change.contains(txn.handle(), make_node(0xC0), 1); });
+                            [&change, &txn] { (void)change.contains(txn.handle(), make_node(0xC0), 1); });
         expect_open_required("ChangeLogStore::erase", change,
-                            [&] { (void)change.erase(txn.handle(), make_node(0xC0), 1); });
+                            [&change, &txn] { (void)change.erase(txn.handle(), make_node(0xC0), 1); });
         expect_open_required("ChangeLogStore::prune_up_to", change,
-                            [&] { (void)change.prune_up_to(txn.handle(), make_node(0xC0), 1); });
+                            [&change, &txn] { (void)change.prune_up_to(txn.handle(), make_node(0xC0), 1); });
         expect_open_required("ChangeLogStore::origin_index_matches_changelog", change,
                             [&change, &txn] { (void)change.origin_index_matches_changelog(txn.handle()); });
         expect_open_required("ChangeLogStore::rebuild_origin_index", change,
                             [&change, &txn] { (void)change.rebuild_origin_index(txn.handle()); });
+        expect_open_required("ChangeLogStore::rebuild_dbi_index", change,
+                            [&change, &txn] { (void)change.rebuild_dbi_index(txn.handle()); });
+
+        ChangeLogDbiIndexStore dbi_index(conn->env_handle());
+        std::uint64_t next_seq = 0;
+        expect_open_required("ChangeLogDbiIndexStore::note_batch", dbi_index,
+                            [&dbi_index, &txn] { dbi_index.note_batch(txn.handle(), make_node(0xC0), 1,
+                                                       std::vector<std::string>{ "t" }); });
+        expect_open_required("ChangeLogDbiIndexStore::next_seq", dbi_index,
+                            [&dbi_index, &txn, &next_seq] { (void)dbi_index.next_seq(txn.handle(), "t", make_node(0xC0), 1, next_seq); });
+        expect_open_required("ChangeLogDbiIndexStore::erase_range", dbi_index,
+                            [&dbi_index, &txn] { (void)dbi_index.erase_range(txn.handle(), make_node(0xC0), 0, 1); });
 
         OriginIndexStore origins(conn->env_handle());
         std::uint64_t seq = 0;
@@ -692,13 +1011,16 @@ void test_stores_require_open() {
         IdentityIndexStore identity(conn->env_handle());
         IdentityIndexValue iv;
         expect_open_required("IdentityIndexStore::put", identity,
-                            [&] { identity.put(txn.handle(), "t", { 0x01 }, iv); });
+                            [&identity, &txn, &iv] { identity.put(txn.handle(), "t", { 0x01 }, iv); });
         expect_open_required("IdentityIndexStore::get", identity,
-                            [&] { (void)identity.get(txn.handle(), "t", { 0x01 }, iv); });
+                            [&identity, &txn, &iv] { (void)identity.get(txn.handle(), "t", { 0x01 }, iv); });
         expect_open_required("IdentityIndexStore::tombstone", identity,
-                            [&] { identity.tombstone(txn.handle(), "t", { 0x01 }, iv); });
+                            [&identity, &txn, &iv] { identity.tombstone(txn.handle(), "t", { 0x01 }, iv); });
         expect_open_required("IdentityIndexStore::erase", identity,
-                            [&] { (void)identity.erase(txn.handle(), "t", { 0x01 }); });
+                            [&identity, &txn] { (void)identity.erase(txn.handle(), "t", { 0x01 }); });
+        expect_open_required("IdentityIndexStore::write_batch", identity,
+                            [&identity, &txn] { (void)identity.write_batch(txn.handle(),
+                                      std::vector<IdentityIndexUpdate>()); });
     }
 
     conn->disconnect();
@@ -715,9 +1037,13 @@ int main() {
     test_changelog_backfills_legacy_origins_on_append();
     test_changelog_rebuilds_partial_origin_index();
     test_applied_store();
+    test_peer_watermark_store();
     test_identity_index_store();
+    test_identity_index_write_batch();
     test_changelog_prune_up_to_boundary();
     test_changelog_prune_does_not_touch_other_origin();
+    test_changelog_dbi_index();
+    test_changelog_per_origin_layout();
     test_identity_key_collision();
     test_stores_require_open();
     return 0;
@@ -0,0 +1,108 @@
+#include <mdbx_containers/sync.hpp>
+
+#include "test_assert.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct RecordedSpan {
+        mdbxc::sync::SyncSpanKind kind;
+        bool ok;
+        std::uint64_t items;
+    };
+
+    class RecordingTracer : public mdbxc::sync::ISyncTracer {
+    public:
+        void* start_sync_span(mdbxc::sync::SyncSpanKind) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++started;
+            return &started;
+        }
+
+        void end_sync_span(void* span,
+                           mdbxc::sync::SyncSpanKind kind,
+                           bool ok,
+                           std::uint64_t items) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            MDBXC_TEST_ASSERT(span == &started);
+            ended.push_back(RecordedSpan{kind, ok, items});
+        }
+
+        std::mutex mutex;
+        std::size_t started = 0;
+        std::vector<RecordedSpan> ended;
+    };
+
+    class TracerScope {
+    public:
+        explicit TracerScope(mdbxc::sync::ISyncTracer* tracer) {
+            mdbxc::sync::set_sync_tracer(tracer);
+        }
+        ~TracerScope() { mdbxc::sync::set_sync_tracer(nullptr); }
+    };
+
+    void test_codec_spans_are_paired() {
+        RecordingTracer tracer;
+        TracerScope scope(&tracer);
+
+        mdbxc::sync::PullRequest request;
+        request.max_batches = 8;
+        const std::vector<std::uint8_t> bytes =
+            mdbxc::sync::TransportMessageCodec::encode_pull_request(request);
+        const mdbxc::sync::PullRequest decoded =
+            mdbxc::sync::TransportMessageCodec::decode_pull_request(bytes);
+        MDBXC_TEST_ASSERT(decoded.max_batches == 8u);
+
+        MDBXC_TEST_ASSERT(tracer.started == 2u);
+        MDBXC_TEST_ASSERT(tracer.ended.size() == 2u);
+        MDBXC_TEST_ASSERT(tracer.ended[0].kind == mdbxc::sync::SyncSpanKind::CodecEncode);
+        MDBXC_TEST_ASSERT(tracer.ended[0].ok);
+        MDBXC_TEST_ASSERT(tracer.ended[0].items == bytes.size());
+        MDBXC_TEST_ASSERT(tracer.ended[1].kind == mdbxc::sync::SyncSpanKind::CodecDecode);
+        MDBXC_TEST_ASSERT(tracer.ended[1].items == bytes.size());
+    }
+
+    void test_failed_decode_ends_span_as_failed() {
+        RecordingTracer tracer;
+        TracerScope scope(&tracer);
+
+        std::vector<std::uint8_t> bytes =
+            mdbxc::sync::TransportMessageCodec::encode_push_response(
+                mdbxc::sync::PushResponse());
+        bytes.push_back(0);
+        bool threw = false;
+        try {
+            mdbxc::sync::TransportMessageCodec::decode_push_response(bytes);
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+        MDBXC_TEST_ASSERT(tracer.ended.size() == 2u);
+        MDBXC_TEST_ASSERT(tracer.ended[1].kind == mdbxc::sync::SyncSpanKind::CodecDecode);
+        MDBXC_TEST_ASSERT(!tracer.ended[1].ok);
+    }
+
+    void test_no_tracer_records_nothing() {
+        RecordingTracer tracer;
+        mdbxc::sync::TransportMessageCodec::encode_pull_request(
+            mdbxc::sync::PullRequest());
+        MDBXC_TEST_ASSERT(tracer.started == 0u);
+        MDBXC_TEST_ASSERT(mdbxc::sync::sync_tracer() == nullptr);
+        MDBXC_TEST_ASSERT(std::string(mdbxc::sync::sync_span_name(
+                              mdbxc::sync::SyncSpanKind::PushCommit)) ==
+                          "mdbxc.sync.engine.push_commit");
+    }
+
+} // namespace
+
+int main() {
+    test_codec_spans_are_paired();
+    test_failed_decode_ends_span_as_failed();
+    test_no_tracer_records_nothing();
+    return 0;
+}
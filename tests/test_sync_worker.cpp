@@ -4,6 +4,7 @@
 #include <mdbx_containers.hpp>
 #include <mdbx_containers/sync.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
@@ -215,6 +216,71 @@ private:
     mdbxc::sync::PullResponse m_response;
 };
 
+class CursorRecordingPeer : public mdbxc::sync::ISyncPeer {
+public:
+    CursorRecordingPeer(mdbxc::sync::ISyncPeer& next,
+                        const mdbxc::sync::NodeId& origin)
+        : m_next(next), m_origin(origin) {}
+
+    mdbxc::sync::PullResponse pull(
+            const mdbxc::sync::PullRequest& request) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_have.push_back(request.have.last_seq_for(m_origin));
+        }
+        return m_next.pull(request);
+    }
+
+    mdbxc::sync::PushResponse push(
+            const mdbxc::sync::PushRequest& request) override {
+        return m_next.push(request);
+    }
+
+    std::vector<std::uint64_t> have() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_have;
+    }
+
+private:
+    mdbxc::sync::ISyncPeer& m_next;
+    mdbxc::sync::NodeId m_origin;
+    mutable std::mutex m_mutex;
+    std::vector<std::uint64_t> m_have;
+};
+
+class BudgetRecordingPeer : public mdbxc::sync::ISyncPeer {
+public:
+    BudgetRecordingPeer(mdbxc::sync::ISyncPeer& next,
+                        std::chrono::milliseconds delay)
+        : m_next(next), m_delay(delay) {}
+
+    mdbxc::sync::PullResponse pull(
+            const mdbxc::sync::PullRequest& request) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_max_bytes.push_back(request.max_bytes);
+        }
+        std::this_thread::sleep_for(m_delay);
+        return m_next.pull(request);
+    }
+
+    mdbxc::sync::PushResponse push(
+            const mdbxc::sync::PushRequest& request) override {
+        return m_next.push(request);
+    }
+
+    std::vector<std::uint64_t> max_bytes() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_max_bytes;
+    }
+
+private:
+    mdbxc::sync::ISyncPeer& m_next;
+    std::chrono::milliseconds m_delay;
+    mutable std::mutex m_mutex;
+    std::vector<std::uint64_t> m_max_bytes;
+};
+
 class BlockingPeer : public mdbxc::sync::ISyncPeer {
 public:
     explicit BlockingPeer(const mdbxc::sync::PullResponse& response)
@@ -1118,6 +1184,353 @@ void test_worker_run_once_drains_paginated_pull() {
     cleanup(replica_path);
 }
 
+void test_worker_adaptive_paging_follows_page_time() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_worker_adaptive_primary.mdbx";
+    const std::string fast_path = "test_worker_adaptive_fast.mdbx";
+    const std::string slow_path = "test_worker_adaptive_slow.mdbx";
+    cleanup(primary_path);
+    cleanup(fast_path);
+    cleanup(slow_path);
+
+    std::shared_ptr<Connection> primary_conn = open_env(primary_path);
+    std::shared_ptr<Connection> fast_conn = open_env(fast_path);
+    std::shared_ptr<Connection> slow_conn = open_env(slow_path);
+
+    const sync::NodeId db_id = make_node(0xD0);
+    sync::SyncEngine primary_engine(primary_conn);
+    sync::SyncEngine fast_engine(fast_conn);
+    sync::SyncEngine slow_engine(slow_conn);
+    primary_engine.initialize_local_identity(make_node(0xA0), db_id);
+    fast_engine.initialize_local_identity(make_node(0xB0), db_id);
+    slow_engine.initialize_local_identity(make_node(0xB1), db_id);
+
+    sync::ThreadLocalChangeAccumulator sink(primary_conn);
+    primary_conn->attach_sync_capture(&sink);
+    {
+        KeyValueTable<int, int> kv(primary_conn, "kv");
+        for (int i = 1; i <= 5; ++i) {
+            kv.insert_or_assign(i, i * 10);
+        }
+    }
+    primary_conn->detach_sync_capture();
+
+    sync::DirectSyncPeer direct(&primary_engine);
+    sync::SyncWorkerOptions options;
+    options.max_batches = 2;
+    options.max_bytes = 4096;
+    options.adaptive_paging = true;
+    options.adaptive_min_bytes = 1024;
+    options.adaptive_max_bytes = 65536;
+
+    // Full pages well under the target grow the budget additively.
+    {
+        BudgetRecordingPeer peer(direct, std::chrono::milliseconds(0));
+        sync::SyncWorkerOptions fast = options;
+        fast.adaptive_target_page_time = std::chrono::milliseconds(60000);
+        sync::SyncWorker worker(fast_engine, peer, fast);
+        if (worker.status().page_max_bytes != 4096u ||
+            worker.status().page_max_batches != 2u) {
+            throw std::runtime_error("adaptive paging did not start from max_bytes");
+        }
+        const sync::SyncWorkerRoundResult result = worker.run_once();
+        if (!result.ok || result.batches_applied != 5u) {
+            throw std::runtime_error("adaptive fast round failed: " + result.error);
+        }
+        const std::vector<std::uint64_t> sent = peer.max_bytes();
+        if (sent.size() < 2u || sent[0] != 4096u || sent[1] != 4096u + 1025u) {
+            throw std::runtime_error("adaptive paging did not grow after a full page");
+        }
+        const sync::SyncWorkerStatus status = worker.status();
+        if (status.page_max_bytes != 4096u + 2u * 1025u ||
+            status.page_max_batches != 3u) {
+            throw std::runtime_error("adaptive paging status mismatch after growth");
+        }
+    }
+
+    // Pages slower than the target halve the budget down to its floor.
+    {
+        BudgetRecordingPeer peer(direct, std::chrono::milliseconds(20));
+        sync::SyncWorkerOptions slow = options;
+        slow.adaptive_target_page_time = std::chrono::milliseconds(1);
+        sync::SyncWorker worker(slow_engine, peer, slow);
+        const sync::SyncWorkerRoundResult result = worker.run_once();
+        if (!result.ok || result.batches_applied != 5u) {
+            throw std::runtime_error("adaptive slow round failed: " + result.error);
+        }
+        const std::vector<std::uint64_t> sent = peer.max_bytes();
+        if (sent.size() < 3u || sent[0] != 4096u || sent[1] != 2048u ||
+            sent[2] != 1024u) {
+            throw std::runtime_error("adaptive paging did not halve on slow pages");
+        }
+        const sync::SyncWorkerStatus status = worker.status();
+        if (status.page_max_bytes != 1024u || status.page_max_batches != 1u) {
+            throw std::runtime_error("adaptive paging left its lower bound");
+        }
+    }
+
+    primary_conn->disconnect();
+    fast_conn->disconnect();
+    slow_conn->disconnect();
+    cleanup(primary_path);
+    cleanup(fast_path);
+    cleanup(slow_path);
+}
+
+void test_worker_pipelined_pull_applies_in_order() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_worker_pipeline_primary.mdbx";
+    const std::string replica_path = "test_worker_pipeline_replica.mdbx";
+    cleanup(primary_path);
+    cleanup(replica_path);
+
+    std::shared_ptr<Connection> primary_conn = open_env(primary_path);
+    std::shared_ptr<Connection> replica_conn = open_env(replica_path);
+
+    const sync::NodeId primary_node = make_node(0xA0);
+    const sync::NodeId db_id = make_node(0xD0);
+
+    sync::SyncEngine primary_engine(primary_conn);
+    sync::SyncEngine replica_engine(replica_conn);
+    primary_engine.initialize_local_identity(primary_node, db_id);
+    replica_engine.initialize_local_identity(make_node(0xB0), db_id);
+
+    sync::ThreadLocalChangeAccumulator sink(primary_conn);
+    primary_conn->attach_sync_capture(&sink);
+    {
+        KeyValueTable<int, int> kv(primary_conn, "kv");
+        for (int i = 1; i <= 9; ++i) {
+            kv.insert_or_assign(i, i * 10);
+        }
+    }
+    primary_conn->detach_sync_capture();
+
+    sync::DirectSyncPeer direct(&primary_engine);
+    CursorRecordingPeer peer(direct, primary_node);
+    RecordingWorkerObserver observer;
+    sync::SyncWorkerOptions options;
+    options.max_batches = 2;
+    options.pipeline_depth = 2;
+    options.observer = &observer;
+
+    sync::SyncWorker worker(replica_engine, peer, options);
+    const sync::SyncWorkerRoundResult result = worker.run_once();
+    if (!result.ok) {
+        throw std::runtime_error("pipelined run_once failed: " + result.error);
+    }
+    if (result.pages_pulled != 5u || result.batches_applied != 9u || result.has_more) {
+        throw std::runtime_error("pipelined worker did not drain all pages");
+    }
+
+    // Pages after the first are requested from the cursor the previous
+    // page reaches, before that page is applied.
+    const std::vector<std::uint64_t> have = peer.have();
+    const std::uint64_t expected_have[] = { 0, 2, 4, 6, 8 };
+    if (have.size() != 5u ||
+        !std::equal(have.begin(), have.end(), expected_have)) {
+        throw std::runtime_error("pipelined pulls used unexpected cursors");
+    }
+    const std::vector<sync::SyncWorkerPageEvent> pages = observer.pages();
+    if (pages.size() != 5u ||
+        pages[4].applied_cursor.last_seq_for(primary_node) != 9u) {
+        throw std::runtime_error("pipelined pages were not applied in order");
+    }
+
+    KeyValueTable<int, int> replica_kv(replica_conn, "kv");
+    for (int i = 1; i <= 9; ++i) {
+        if (kv_or_throw(replica_conn, replica_kv, i, "pipelined value") != i * 10) {
+            throw std::runtime_error("pipelined apply wrote wrong value");
+        }
+    }
+
+    primary_conn->disconnect();
+    replica_conn->disconnect();
+    cleanup(primary_path);
+    cleanup(replica_path);
+}
+
+void test_multi_peer_worker_fans_in_without_duplicates() {
+    using namespace mdbxc;
+    const std::string a_path = "test_multi_peer_a.mdbx";
+    const std::string b_path = "test_multi_peer_b.mdbx";
+    const std::string replica_path = "test_multi_peer_replica.mdbx";
+    cleanup(a_path);
+    cleanup(b_path);
+    cleanup(replica_path);
+
+    std::shared_ptr<Connection> a_conn = open_env(a_path);
+    std::shared_ptr<Connection> b_conn = open_env(b_path);
+    std::shared_ptr<Connection> replica_conn = open_env(replica_path);
+    const sync::NodeId a_node = make_node(0xA0);
+    const sync::NodeId b_node = make_node(0xA8);
+    const sync::NodeId db_id = make_node(0xD0);
+
+    sync::SyncEngine a_engine(a_conn);
+    sync::SyncEngine b_engine(b_conn);
+    sync::SyncEngine replica_engine(replica_conn);
+    a_engine.initialize_local_identity(a_node, db_id);
+    b_engine.initialize_local_identity(b_node, db_id);
+    replica_engine.initialize_local_identity(make_node(0xB0), db_id);
+
+    {
+        sync::ThreadLocalChangeAccumulator sink(a_conn);
+        a_conn->attach_sync_capture(&sink);
+        KeyValueTable<int, int> kv(a_conn, "kv");
+        for (int i = 1; i <= 5; ++i) {
+            kv.insert_or_assign(i, i * 10);
+        }
+        a_conn->detach_sync_capture();
+    }
+    {
+        sync::ThreadLocalChangeAccumulator sink(b_conn);
+        b_conn->attach_sync_capture(&sink);
+        KeyValueTable<int, int> kv(b_conn, "kv");
+        for (int i = 101; i <= 103; ++i) {
+            kv.insert_or_assign(i, i * 10);
+        }
+        b_conn->detach_sync_capture();
+    }
+
+    // Two peers serve the same origin, as two hubs would.
+    sync::DirectSyncPeer a_peer(&a_engine);
+    sync::DirectSyncPeer a_mirror(&a_engine);
+    sync::DirectSyncPeer b_peer(&b_engine);
+    std::vector<sync::ISyncPeer*> peers;
+    peers.push_back(&a_peer);
+    peers.push_back(&a_mirror);
+    peers.push_back(&b_peer);
+
+    sync::MultiPeerSyncWorkerOptions options;
+    options.max_batches = 2;
+    options.idle_interval = std::chrono::milliseconds(5);
+    sync::MultiPeerSyncWorker worker(replica_engine, peers, options);
+    worker.start();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (;;) {
+        const sync::SyncCursor have = replica_engine.applied_cursor();
+        if (have.last_seq_for(a_node) == 5u && have.last_seq_for(b_node) == 3u) {
+            break;
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("multi-peer worker did not catch up");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    worker.stop();
+
+    const sync::MultiPeerSyncWorkerStatus status = worker.status();
+    if (status.running || status.batches_applied != 8u || !status.last_apply_error.empty()) {
+        throw std::runtime_error("multi-peer worker applied duplicates or failed");
+    }
+    if (status.peers.size() != 3u || status.peers[2].batches_pulled != 3u) {
+        throw std::runtime_error("multi-peer worker peer counters mismatch");
+    }
+    KeyValueTable<int, int> kv(replica_conn, "kv");
+    if (kv_or_throw(replica_conn, kv, 5, "key 5") != 50 ||
+        kv_or_throw(replica_conn, kv, 103, "key 103") != 1030) {
+        throw std::runtime_error("multi-peer worker replica data mismatch");
+    }
+
+    bool threw = false;
+    try {
+        sync::MultiPeerSyncWorker empty(replica_engine, std::vector<sync::ISyncPeer*>());
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("multi-peer worker accepted no peers");
+    }
+
+    a_conn->disconnect();
+    b_conn->disconnect();
+    replica_conn->disconnect();
+    cleanup(a_path);
+    cleanup(b_path);
+    cleanup(replica_path);
+}
+
+void test_sync_pusher_pushes_on_commit() {
+    using namespace mdbxc;
+    const std::string primary_path = "test_pusher_primary.mdbx";
+    const std::string replica_path = "test_pusher_replica.mdbx";
+    cleanup(primary_path);
+    cleanup(replica_path);
+
+    std::shared_ptr<Connection> primary_conn = open_env(primary_path);
+    std::shared_ptr<Connection> replica_conn = open_env(replica_path);
+    const sync::NodeId primary_node = make_node(0xA0);
+    const sync::NodeId db_id = make_node(0xD0);
+    sync::SyncEngine primary(primary_conn);
+    sync::SyncEngine replica(replica_conn);
+    primary.initialize_local_identity(primary_node, db_id);
+    replica.initialize_local_identity(make_node(0xB0), db_id);
+
+    sync::ThreadLocalChangeAccumulator sink(primary_conn);
+    primary_conn->attach_sync_capture(&sink);
+    KeyValueTable<int, int> kv(primary_conn, "kv");
+    for (int i = 1; i <= 3; ++i) {
+        kv.insert_or_assign(i, i * 10);
+    }
+
+    sync::DirectSyncPeer peer(&replica);
+    std::vector<sync::ISyncPeer*> peers(1, &peer);
+    sync::SyncPusherOptions options;
+    options.max_batches = 2;
+    // Far longer than the test waits: only commits can wake the pusher.
+    options.recheck_interval = std::chrono::seconds(60);
+    sync::SyncPusher pusher(primary, peers, options);
+
+    auto wait_for_seq = [&replica, &primary_node](std::uint64_t seq, const char* what) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (replica.applied_cursor().last_seq_for(primary_node) < seq) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                throw std::runtime_error(what);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    pusher.start();
+    wait_for_seq(3, "pusher did not send the existing batches");
+    kv.insert_or_assign(4, 40);
+    wait_for_seq(4, "commit did not wake the pusher");
+    pusher.stop();
+
+    sync::SyncPusherStatus status = pusher.status();
+    if (status.running || status.peers.size() != 1u ||
+        status.peers[0].batches_pushed != 4u || status.peers[0].failures != 0u ||
+        status.peers[0].next_seq != 5u) {
+        throw std::runtime_error("pusher counters mismatch");
+    }
+
+    kv.insert_or_assign(5, 50);
+    if (!pusher.push_now() || replica.applied_cursor().last_seq_for(primary_node) != 5u) {
+        throw std::runtime_error("push_now did not send the new batch");
+    }
+    primary_conn->detach_sync_capture();
+    KeyValueTable<int, int> replica_kv(replica_conn, "kv");
+    if (kv_or_throw(replica_conn, replica_kv, 4, "key 4") != 40 ||
+        kv_or_throw(replica_conn, replica_kv, 5, "key 5") != 50) {
+        throw std::runtime_error("pushed replica data mismatch");
+    }
+
+    bool threw = false;
+    try {
+        options.max_batches = 0;
+        sync::SyncPusher invalid(primary, peers, options);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("pusher accepted max_batches 0");
+    }
+
+    primary_conn->disconnect();
+    replica_conn->disconnect();
+    cleanup(primary_path);
+    cleanup(replica_path);
+}
+
 void test_worker_start_stop_idle() {
     using namespace mdbxc;
     const std::string path = "test_worker_idle.mdbx";
@@ -1710,6 +2123,17 @@ void test_worker_rejects_invalid_options() {
     invalid.max_backoff = std::chrono::milliseconds(9);
     expect_invalid_options(engine, peer, invalid, "max_backoff ordering");
 
+    invalid = options;
+    invalid.adaptive_paging = true;
+    invalid.adaptive_target_page_time = std::chrono::milliseconds(0);
+    expect_invalid_options(engine, peer, invalid, "adaptive_target_page_time");
+
+    invalid = options;
+    invalid.adaptive_paging = true;
+    invalid.adaptive_min_bytes = 2048;
+    invalid.adaptive_max_bytes = 1024;
+    expect_invalid_options(engine, peer, invalid, "adaptive bounds ordering");
+
     conn->disconnect();
     cleanup(path);
 }
@@ -2600,7 +3024,14 @@ int main() {
     const Case cases[] = {
         { "test_worker_run_once_drains_paginated_pull",
           &test_worker_run_once_drains_paginated_pull },
+        { "test_worker_pipelined_pull_applies_in_order",
+          &test_worker_pipelined_pull_applies_in_order },
+        { "test_worker_adaptive_paging_follows_page_time",
+          &test_worker_adaptive_paging_follows_page_time },
         { "test_worker_start_stop_idle", &test_worker_start_stop_idle },
+        { "test_multi_peer_worker_fans_in_without_duplicates",
+          &test_multi_peer_worker_fans_in_without_duplicates },
+        { "test_sync_pusher_pushes_on_commit", &test_sync_pusher_pushes_on_commit },
         { "test_worker_background_pull_over_http_transport",
           &test_worker_background_pull_over_http_transport },
         { "test_worker_stop_cancels_http_transport_peer",
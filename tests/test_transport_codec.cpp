@@ -61,6 +61,18 @@ void test_pull_request_roundtrip() {
     request.max_bytes = 4096;
     request.request_full_snapshot = true;
     request.max_single_batch_bytes = 8192;
+    request.accept_compressed_batches = true;
+    request.accept_compressed_messages = false;
+    request.wait_timeout_ms = 30000;
+    request.snapshot_token = std::string("\x01\x00token", 7);
+    SyncTableSubscription orders;
+    orders.dbi_name = "orders";
+    orders.key_prefixes.push_back(std::vector<std::uint8_t>{ 0x01, 0x02 });
+    orders.key_prefixes.push_back(std::vector<std::uint8_t>());
+    request.subscription.push_back(orders);
+    SyncTableSubscription users;
+    users.dbi_name = "users";
+    request.subscription.push_back(users);
     CancellationSource source;
     request.cancel_token = source.token();
 
@@ -85,6 +97,20 @@ void test_pull_request_roundtrip() {
                  "PullRequest full snapshot mismatch");
     require_true(decoded.max_single_batch_bytes == 8192,
                  "PullRequest max_single_batch_bytes mismatch");
+    require_true(decoded.accept_compressed_batches,
+                 "PullRequest accept_compressed_batches mismatch");
+    require_true(decoded.wait_timeout_ms == 30000,
+                 "PullRequest wait_timeout_ms mismatch");
+    require_true(decoded.snapshot_token == request.snapshot_token,
+                 "PullRequest snapshot_token mismatch");
+    require_true(decoded.subscription.size() == 2u &&
+                     decoded.subscription[0].dbi_name == "orders" &&
+                     decoded.subscription[0].key_prefixes == orders.key_prefixes &&
+                     decoded.subscription[1].dbi_name == "users" &&
+                     decoded.subscription[1].key_prefixes.empty(),
+                 "PullRequest subscription mismatch");
+    require_true(!decoded.accept_compressed_messages,
+                 "PullRequest accept_compressed_messages mismatch");
     require_true(!decoded.cancel_token.can_be_cancelled(),
                  "PullRequest cancel token must not be serialized");
 }
@@ -104,6 +130,7 @@ void test_pull_response_roundtrip() {
     response.error = "temporary upstream timeout";
     response.error_code = SyncResponseErrorCode::BatchTooLarge;
     response.error_retryable = false;
+    response.snapshot_token = "next-page";
 
     const std::vector<std::uint8_t> bytes =
         TransportMessageCodec::encode_pull_response(response);
@@ -133,6 +160,122 @@ void test_pull_response_roundtrip() {
                  "PullResponse error_code mismatch");
     require_true(decoded.error_retryable == response.error_retryable,
                  "PullResponse error_retryable mismatch");
+    require_true(decoded.snapshot_token == response.snapshot_token,
+                 "PullResponse snapshot_token mismatch");
+}
+
+void test_pull_response_encoded_batches() {
+    using namespace mdbxc::sync;
+    PullResponse decoded_form;
+    decoded_form.batches.push_back(make_batch(0xA0, 5));
+    decoded_form.batches.push_back(make_batch(0xB0, 9));
+
+    // Pre-encoded batches are written after decoded ones, byte for byte.
+    PullResponse encoded_form;
+    encoded_form.batches.push_back(make_batch(0xA0, 5));
+    encoded_form.encoded_batches.push_back(
+        ChangeBatchCodec::encode(make_batch(0xB0, 9)));
+    require_true(TransportMessageCodec::encode_pull_response(encoded_form) ==
+                     TransportMessageCodec::encode_pull_response(decoded_form),
+                 "PullResponse encoded batches differ from decoded ones");
+
+    const PullResponse decoded = TransportMessageCodec::decode_pull_response(
+        TransportMessageCodec::encode_pull_response(encoded_form));
+    require_true(decoded.batches.size() == 2u && decoded.encoded_batches.empty(),
+                 "PullResponse encoded batches not decoded");
+    require_true(decoded.batches[1].seq == 9u,
+                 "PullResponse encoded batch order mismatch");
+
+    CodecBounds bounds;
+    bounds.max_batches_per_message = 1;
+    expect_throw("encoded batches count bound", [&encoded_form, &bounds]() {
+        (void)TransportMessageCodec::encode_pull_response(encoded_form, &bounds);
+    });
+
+    // The Encoded form keeps every batch as bytes on the receiving side.
+    const PullResponse kept = TransportMessageCodec::decode_pull_response(
+        TransportMessageCodec::encode_pull_response(decoded_form), nullptr,
+        PullBatchForm::Encoded);
+    require_true(kept.batches.empty() && kept.encoded_batches.size() == 2u,
+                 "PullResponse Encoded decode filled the wrong field");
+    require_true(kept.encoded_batches[1] ==
+                     ChangeBatchCodec::encode(make_batch(0xB0, 9)),
+                 "PullResponse Encoded decode changed batch bytes");
+
+    PushRequest push;
+    push.sender = make_node(0x10);
+    push.db_id = make_node(0x20);
+    push.encoded_batches = kept.encoded_batches;
+    const PushRequest push_kept = TransportMessageCodec::decode_push_request(
+        TransportMessageCodec::encode_push_request(push), nullptr,
+        PullBatchForm::Encoded);
+    require_true(push_kept.encoded_batches == push.encoded_batches,
+                 "PushRequest encoded batches mismatch");
+    const PushRequest push_decoded = TransportMessageCodec::decode_push_request(
+        TransportMessageCodec::encode_push_request(push));
+    require_true(push_decoded.batches.size() == 2u &&
+                     push_decoded.batches[0].seq == 5u,
+                 "PushRequest encoded batches not decoded");
+
+    // Malformed batches are rejected by the Encoded form too.
+    PullResponse broken;
+    broken.encoded_batches.push_back(ChangeBatchCodec::encode(make_batch(0xA0, 5)));
+    broken.encoded_batches[0].pop_back();
+    const std::vector<std::uint8_t> broken_bytes =
+        TransportMessageCodec::encode_pull_response(broken);
+    expect_throw("encoded truncated batch", [&broken_bytes]() {
+        (void)TransportMessageCodec::decode_pull_response(
+            broken_bytes, nullptr, PullBatchForm::Encoded);
+    });
+}
+
+void test_pull_response_chunked() {
+    using namespace mdbxc::sync;
+    ChangeBatch large = make_batch(0xC0, 11);
+    large.ops[0].value.assign(TransportMessageCodec::chunked_batch_min_bytes(), 0x5A);
+
+    PullResponse response;
+    response.remote_tail_known = true;
+    response.remote_tail.last_seq_by_origin[make_node(0xC0)] = 11;
+    response.batches.push_back(make_batch(0xA0, 5));
+    response.encoded_batches.push_back(ChangeBatchCodec::encode(make_batch(0xB0, 9)));
+    response.encoded_batches.push_back(ChangeBatchCodec::encode(large));
+    response.has_more = true;
+    response.snapshot_token = "next-page";
+    const std::vector<std::uint8_t> contiguous =
+        TransportMessageCodec::encode_pull_response(response);
+
+    // The chunks join into the contiguous encoding; the large batch moves
+    // into a chunk of its own.
+    const ChunkedTransportMessage chunked =
+        TransportMessageCodec::encode_pull_response_chunked(response);
+    require_true(chunked.size() == contiguous.size() &&
+                     chunked.to_vector() == contiguous,
+                 "chunked PullResponse differs from contiguous encoding");
+    require_true(chunked.chunk_count() == 3u &&
+                     chunked.chunk(1) == response.encoded_batches[1],
+                 "chunked PullResponse large batch not in its own chunk");
+    std::vector<std::uint8_t> written;
+    chunked.write_to([&written](const std::uint8_t* data, std::size_t size) {
+        written.insert(written.end(), data, data + size);
+    });
+    require_true(written == contiguous, "chunked PullResponse write_to mismatch");
+
+    PullResponse empty;
+    require_true(TransportMessageCodec::encode_pull_response_chunked(empty).to_vector() ==
+                     TransportMessageCodec::encode_pull_response(empty),
+                 "chunked empty PullResponse mismatch");
+
+    CodecBounds bounds;
+    bounds.max_transport_message_bytes = contiguous.size() - 1;
+    expect_throw("chunked message size bound", [&response, &bounds]() {
+        (void)TransportMessageCodec::encode_pull_response_chunked(response, &bounds);
+    });
+    bounds = CodecBounds();
+    bounds.max_batch_total_bytes = response.encoded_batches[1].size() - 1;
+    expect_throw("chunked batch size bound", [&response, &bounds]() {
+        (void)TransportMessageCodec::encode_pull_response_chunked(response, &bounds);
+    });
 }
 
 void test_push_request_roundtrip() {
@@ -172,6 +315,8 @@ void test_push_response_roundtrip() {
     response.error = "sequence gap";
     response.error_code = SyncResponseErrorCode::ApplyConflict;
     response.error_retryable = true;
+    response.accept_compressed_batches = true;
+    response.accept_compressed_messages = false;
 
     const std::vector<std::uint8_t> bytes =
         TransportMessageCodec::encode_push_response(response);
@@ -186,6 +331,10 @@ void test_push_response_roundtrip() {
                  "PushResponse error_code mismatch");
     require_true(decoded.error_retryable == response.error_retryable,
                  "PushResponse error_retryable mismatch");
+    require_true(decoded.accept_compressed_batches,
+                 "PushResponse accept_compressed_batches mismatch");
+    require_true(!decoded.accept_compressed_messages,
+                 "PushResponse accept_compressed_messages mismatch");
 }
 
 void test_peek_message_type() {
@@ -238,7 +387,7 @@ void test_message_header_rejections() {
 
     expect_throw("unknown flags", [bytes] {
         std::vector<std::uint8_t> bad = bytes;
-        bad[11] = 0x01;
+        bad[11] = 0x80;
         (void)TransportMessageCodec::decode_pull_request(bad);
     });
 
@@ -256,7 +405,7 @@ void test_message_header_rejections() {
 
     expect_throw("invalid bool", [bytes] {
         std::vector<std::uint8_t> bad = bytes;
-        bad[bad.size() - 9u] = 2u;
+        bad[bad.size() - 28u] = 2u;
         (void)TransportMessageCodec::decode_pull_request(bad);
     });
 
@@ -270,10 +419,12 @@ void test_message_header_rejections() {
         const std::size_t envelope_size =
             TransportMessageCodec::magic_size() + 2u + 1u + 4u;
         const std::size_t node_size = request.requester.size();
+        const std::size_t cursor_form_size = 1u;
         const std::size_t cursor_count_size = 4u;
         const std::size_t seq_size = 8u;
         const std::size_t first_origin_offset =
-            envelope_size + node_size + node_size + cursor_count_size;
+            envelope_size + node_size + node_size + cursor_form_size +
+            cursor_count_size;
         const std::size_t second_origin_offset =
             first_origin_offset + node_size + seq_size;
 
@@ -328,16 +479,16 @@ void test_response_error_code_rejections() {
     expect_throw("pull response error code", [] {
         std::vector<std::uint8_t> bad =
             TransportMessageCodec::encode_pull_response(PullResponse());
-        bad[bad.size() - 3u] = 0xFFu;
-        bad[bad.size() - 2u] = 0xFFu;
+        bad[bad.size() - 8u] = 0xFFu;
+        bad[bad.size() - 7u] = 0xFFu;
         (void)TransportMessageCodec::decode_pull_response(bad);
     });
 
     expect_throw("push response error code", [] {
         std::vector<std::uint8_t> bad =
             TransportMessageCodec::encode_push_response(PushResponse());
+        bad[bad.size() - 4u] = 0xFFu;
         bad[bad.size() - 3u] = 0xFFu;
-        bad[bad.size() - 2u] = 0xFFu;
         (void)TransportMessageCodec::decode_push_response(bad);
     });
 }
@@ -352,7 +503,7 @@ void test_golden_header_shape() {
         require_true(bytes[i] == expected_magic[i],
                      "TransportMessageCodec magic mismatch");
     }
-    require_true(bytes[8] == 4u && bytes[9] == 0u,
+    require_true(bytes[8] == 10u && bytes[9] == 0u,
                  "TransportMessageCodec version mismatch");
     require_true(bytes[10] == 1u,
                  "TransportMessageCodec pull request type mismatch");
@@ -361,11 +512,175 @@ void test_golden_header_shape() {
                  "TransportMessageCodec flags mismatch");
 }
 
+void test_cursor_origins_stay_sorted() {
+    using namespace mdbxc::sync;
+    SyncCursor cursor;
+    cursor.last_seq_by_origin[make_node(0xC0)] = 3;
+    cursor.last_seq_by_origin[make_node(0xA0)] = 1;
+    cursor.last_seq_by_origin[make_node(0xB0)] = 2;
+    cursor.last_seq_by_origin[make_node(0xA0)] = 4;
+    require_true(cursor.last_seq_by_origin.size() == 3,
+                 "SyncCursor origin count mismatch");
+    require_true(cursor.last_seq_by_origin.begin()->first == make_node(0xA0) &&
+                     cursor.last_seq_by_origin.begin()->second == 4,
+                 "SyncCursor origins must be sorted");
+    require_true(cursor.last_seq_for(make_node(0xB0)) == 2 &&
+                     cursor.is_empty_for(make_node(0xD0)),
+                 "SyncCursor lookup mismatch");
+    require_true(cursor.last_seq_by_origin.erase(make_node(0xB0)) == 1 &&
+                     cursor.last_seq_by_origin.count(make_node(0xB0)) == 0,
+                 "SyncCursor erase mismatch");
+
+    PushResponse response;
+    response.receiver_have = cursor;
+    const PushResponse decoded = TransportMessageCodec::decode_push_response(
+        TransportMessageCodec::encode_push_response(response));
+    require_true(decoded.receiver_have.last_seq_by_origin == cursor.last_seq_by_origin,
+                 "SyncCursor roundtrip mismatch");
+}
+
+void test_pull_cursor_deltas() {
+    using namespace mdbxc::sync;
+    SyncCursor have;
+    for (std::uint8_t i = 0; i < 40; ++i) {
+        have.last_seq_by_origin[make_node(static_cast<std::uint8_t>(i * 4))] = 100 + i;
+    }
+    PullRequest request;
+    request.requester = make_node(0x10);
+    request.have = have;
+    request.accept_cursor_deltas = true;
+
+    // Without a stored baseline the request carries the full cursor.
+    CursorBaselineCache baselines;
+    const std::vector<std::uint8_t> full =
+        TransportMessageCodec::encode_pull_request(request);
+    PullRequest decoded = TransportMessageCodec::decode_pull_request(
+        full, nullptr, &baselines);
+    require_true(decoded.have.last_seq_by_origin == have.last_seq_by_origin &&
+                     decoded.have_baseline_digest == 0 && decoded.accept_cursor_deltas,
+                 "full cursor request mismatch");
+    PullResponse stored;
+    baselines.remember(decoded, stored);
+    require_true(stored.cursor_baseline_stored && baselines.size() == 1,
+                 "baseline must be stored");
+
+    // An idle poll against the baseline is a few bytes.
+    const std::vector<std::uint8_t> idle =
+        TransportMessageCodec::encode_pull_request(request, nullptr, &have);
+    require_true(idle.size() + 40 * 24 - 16 <= full.size(),
+                 "idle delta request must be small");
+    decoded = TransportMessageCodec::decode_pull_request(idle, nullptr, &baselines);
+    require_true(decoded.have.last_seq_by_origin == have.last_seq_by_origin &&
+                     decoded.have_baseline_digest == 0,
+                 "idle delta request mismatch");
+
+    // Changed, added, and removed origins round-trip.
+    request.have.last_seq_by_origin[make_node(8)] = 500;
+    request.have.last_seq_by_origin[make_node(9)] = 1;
+    request.have.last_seq_by_origin.erase(make_node(0));
+    decoded = TransportMessageCodec::decode_pull_request(
+        TransportMessageCodec::encode_pull_request(request, nullptr, &have),
+        nullptr, &baselines);
+    require_true(decoded.have.last_seq_by_origin == request.have.last_seq_by_origin,
+                 "delta request mismatch");
+
+    // An unknown baseline leaves have empty and flags the request.
+    decoded = TransportMessageCodec::decode_pull_request(idle);
+    require_true(decoded.have.last_seq_by_origin.empty() &&
+                     decoded.have_baseline_digest == sync_cursor_digest(have),
+                 "unresolved delta must be flagged");
+
+    // Response cursors are deltas against the request's have.
+    PullResponse response;
+    response.remote_have = have;
+    response.remote_tail = have;
+    response.remote_tail.last_seq_by_origin[make_node(4)] = 900;
+    response.remote_tail_known = true;
+    response.cursor_baseline_stored = true;
+    const std::vector<std::uint8_t> delta_response =
+        TransportMessageCodec::encode_pull_response(response, nullptr, &have);
+    require_true(delta_response.size() + 40 * 24 <
+                     TransportMessageCodec::encode_pull_response(response).size(),
+                 "delta response must be small");
+    const PullResponse decoded_response = TransportMessageCodec::decode_pull_response(
+        delta_response, nullptr, PullBatchForm::Decoded, &have);
+    require_true(decoded_response.remote_have.last_seq_by_origin ==
+                         have.last_seq_by_origin &&
+                     decoded_response.remote_tail.last_seq_for(make_node(4)) == 900 &&
+                     decoded_response.cursor_baseline_stored,
+                 "delta response mismatch");
+    require_true(TransportMessageCodec::encode_pull_response_chunked(
+                     response, nullptr, &have).to_vector() == delta_response,
+                 "chunked delta response mismatch");
+    expect_throw("delta response without baseline", [&delta_response]() {
+        TransportMessageCodec::decode_pull_response(delta_response);
+    });
+    expect_throw("delta response with another baseline", [&delta_response, &request]() {
+        TransportMessageCodec::decode_pull_response(
+            delta_response, nullptr, PullBatchForm::Decoded, &request.have);
+    });
+}
+
+void test_message_compression() {
+    using namespace mdbxc::sync;
+    PullResponse response;
+    for (std::uint64_t seq = 1; seq <= 64; ++seq) {
+        response.batches.push_back(make_batch(0xA0, seq));
+    }
+    const std::vector<std::uint8_t> plain =
+        TransportMessageCodec::encode_pull_response(response);
+
+    TransportCompression compression;
+    std::vector<std::uint8_t> message = plain;
+    require_true(!TransportMessageCodec::compress_message(message, compression) &&
+                     message == plain,
+                 "disabled compression must keep the message");
+    compression.enabled = true;
+    compression.min_bytes = plain.size();
+    require_true(!TransportMessageCodec::compress_message(message, compression) ||
+                     batch_compression_supported(),
+                 "compression without zstd must keep the message");
+    message = plain;
+    compression.min_bytes = plain.size() + 1;
+    require_true(!TransportMessageCodec::compress_message(message, compression),
+                 "messages below min_bytes must stay plain");
+
+    if (!batch_compression_supported()) {
+        return;
+    }
+    compression.min_bytes = 0;
+    require_true(TransportMessageCodec::compress_message(message, compression) &&
+                     message.size() < plain.size() &&
+                     TransportMessageCodec::is_compressed(message),
+                 "repetitive response must compress");
+    require_true(!TransportMessageCodec::compress_message(message, compression),
+                 "compressed message must not compress twice");
+    require_true(TransportMessageCodec::peek_message_type(message) ==
+                     TransportMessageType::PullResponse,
+                 "compressed message type mismatch");
+    const PullResponse decoded = TransportMessageCodec::decode_pull_response(message);
+    require_true(TransportMessageCodec::encode_pull_response(decoded) == plain,
+                 "compressed response round-trip mismatch");
+
+    expect_throw("compressed size above bound", [message] {
+        CodecBounds bounds;
+        bounds.max_transport_message_bytes = message.size() + 16;
+        (void)TransportMessageCodec::decode_pull_response(message, &bounds);
+    });
+    expect_throw("compressed size mismatch", [message] {
+        std::vector<std::uint8_t> bad = message;
+        bad[15] ^= 0x01u;
+        (void)TransportMessageCodec::decode_pull_response(bad);
+    });
+}
+
 } // namespace
 
 int main() {
     test_pull_request_roundtrip();
     test_pull_response_roundtrip();
+    test_pull_response_encoded_batches();
+    test_pull_response_chunked();
     test_push_request_roundtrip();
     test_push_response_roundtrip();
     test_peek_message_type();
@@ -373,5 +688,8 @@ int main() {
     test_bounds_rejections();
     test_response_error_code_rejections();
     test_golden_header_shape();
+    test_cursor_origins_stay_sorted();
+    test_pull_cursor_deltas();
+    test_message_compression();
     return 0;
 }
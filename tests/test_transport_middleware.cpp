@@ -241,6 +241,19 @@ void test_peer_middleware_allows_limits_and_observes() {
                  "pulled batch metric mismatch");
     require_true(snapshot.pushed_batches == 1u,
                  "pushed batch metric mismatch");
+    require_true(snapshot.pull_latency.count() == 1u,
+                 "rejected pull must not be timed");
+    require_true(snapshot.push_latency.count() == 1u,
+                 "forwarded push latency was not recorded");
+    require_true(snapshot.http_post_latency.count() == 0u,
+                 "peer middleware recorded HTTP latency");
+
+    metrics.reset();
+    const mdbxc::sync::SyncTransportMetricsSnapshot cleared =
+        metrics.snapshot();
+    require_true(cleared.pull_calls == 0u &&
+                     cleared.pull_latency.count() == 0u,
+                 "metrics reset left counters or latencies");
 }
 
 void test_transport_trace_context_helpers() {
@@ -878,6 +891,40 @@ void test_http_rate_limit_bucket_cap_and_eviction() {
                  "rate-limit bucket eviction left stale buckets");
 }
 
+void test_http_rate_limit_shards_keep_global_cap() {
+    bool threw = false;
+    try {
+        (void)mdbxc::sync::FixedWindowHttpRateLimitPolicy(
+            1u, std::chrono::seconds(1), 0u, 0u);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    require_true(threw, "zero HTTP rate-limit shard count must be rejected");
+
+    mdbxc::sync::FixedWindowHttpRateLimitPolicy rate(
+        1000u, std::chrono::seconds(60), 16u, 4u);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([&rate, t]() {
+            for (int i = 0; i < 100; ++i) {
+                mdbxc::sync::HttpSyncRequest request;
+                request.remote_address =
+                    "198.51.100." + std::to_string(t * 25 + i % 25);
+                (void)rate.check_http_request(request);
+            }
+        }));
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+    require_true(rate.bucket_count() == 16u,
+                 "sharded rate limit did not keep the global bucket cap");
+
+    rate.clear();
+    require_true(rate.bucket_count() == 0u,
+                 "sharded rate limit clear left buckets");
+}
+
 void test_http_client_middleware_copies_rejection_headers() {
     mdbxc::sync::FixedWindowHttpRateLimitPolicy rate(
         0, std::chrono::seconds(7));
@@ -965,6 +1012,7 @@ int main() {
     test_transport_message_size_policy();
     test_transport_zero_limit_policies();
     test_http_rate_limit_bucket_cap_and_eviction();
+    test_http_rate_limit_shards_keep_global_cap();
     test_http_client_middleware_copies_rejection_headers();
     test_http_server_middleware_copies_rejection_headers();
     return 0;
@@ -3,6 +3,7 @@
 
 #include <cstdio>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -102,6 +103,37 @@ private:
     mdbxc::sync::SyncTransportRetryHint m_last_retry_hint;
 };
 
+/// Holds sent messages until the sender waits, like a link with a long RTT.
+class LaggingWebSocketStream : public mdbxc::sync::IWebSocketSyncStream {
+public:
+    explicit LaggingWebSocketStream(mdbxc::sync::WebSocketSyncServer& server)
+        : m_server(server), m_sent(0) {}
+
+    void send_binary(const std::vector<std::uint8_t>& binary_message,
+                     const mdbxc::sync::CancellationToken&) override {
+        m_pending.push_back(binary_message);
+        ++m_sent;
+    }
+
+    std::vector<std::uint8_t> receive_binary(
+            const mdbxc::sync::CancellationToken&) override {
+        if (m_pending.empty()) {
+            throw std::runtime_error("nothing to receive");
+        }
+        const std::vector<std::uint8_t> request = m_pending.front();
+        m_pending.pop_front();
+        return m_server.handle_binary_message(request);
+    }
+
+    std::size_t pending() const { return m_pending.size(); }
+    std::size_t sent() const { return m_sent; }
+
+private:
+    mdbxc::sync::WebSocketSyncServer& m_server;
+    std::deque<std::vector<std::uint8_t>> m_pending;
+    std::size_t m_sent;
+};
+
 void test_websocket_peer_pull_and_push_roundtrip() {
     const std::string primary_path = "test_websocket_transport_primary.mdbx";
     const std::string replica_path = "test_websocket_transport_replica.mdbx";
@@ -208,6 +240,42 @@ void test_websocket_peer_pull_and_push_roundtrip() {
     cleanup(replica_path);
 }
 
+void test_websocket_tagged_message_roundtrip() {
+    mdbxc::sync::PullRequest request;
+    request.requester = make_node(0x10);
+    request.db_id = make_node(0xD0);
+    const std::vector<std::uint8_t> plain =
+        mdbxc::sync::TransportMessageCodec::encode_pull_request(request);
+    require_true(!mdbxc::sync::websocket_sync_message_is_tagged(plain),
+                 "plain sync message was detected as tagged");
+
+    const std::uint64_t request_id = 0x0102030405060708ULL;
+    const std::vector<std::uint8_t> tagged =
+        mdbxc::sync::websocket_sync_tag_message(request_id, plain);
+    require_true(mdbxc::sync::websocket_sync_message_is_tagged(tagged),
+                 "tagged sync message was not detected");
+    require_true(tagged.size() ==
+                     plain.size() + mdbxc::sync::websocket_sync_tag_size(),
+                 "tagged sync message has wrong size");
+
+    std::vector<std::uint8_t> inner;
+    require_true(mdbxc::sync::websocket_sync_untag_message(tagged, inner) ==
+                     request_id,
+                 "tagged sync message lost its request id");
+    require_true(inner == plain, "tagged sync message changed its body");
+    require_true(mdbxc::sync::TransportMessageCodec::peek_message_type(inner) ==
+                     mdbxc::sync::TransportMessageType::PullRequest,
+                 "untagged sync message has wrong type");
+
+    bool rejected = false;
+    try {
+        (void)mdbxc::sync::websocket_sync_untag_message(plain, inner);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    require_true(rejected, "untagging a plain sync message did not throw");
+}
+
 void test_websocket_server_rejects_response_messages() {
     const std::string path = "test_websocket_transport_reject.mdbx";
     cleanup(path);
@@ -447,8 +515,89 @@ void test_websocket_server_middleware_preserves_close_code() {
 
 } // namespace
 
+void test_websocket_streaming_push_keeps_window_in_flight() {
+    const std::string primary_path = "test_websocket_stream_primary.mdbx";
+    const std::string replica_path = "test_websocket_stream_replica.mdbx";
+    const std::string late_path = "test_websocket_stream_late.mdbx";
+    cleanup(primary_path);
+    cleanup(replica_path);
+    cleanup(late_path);
+
+    std::shared_ptr<mdbxc::Connection> primary = open_db(primary_path);
+    std::shared_ptr<mdbxc::Connection> replica = open_db(replica_path);
+    std::shared_ptr<mdbxc::Connection> late = open_db(late_path);
+    const mdbxc::sync::NodeId primary_node = make_node(0x10);
+    const mdbxc::sync::DbId db_id = make_node(0xD0);
+    mdbxc::sync::SyncEngine primary_engine(primary);
+    mdbxc::sync::SyncEngine replica_engine(replica);
+    mdbxc::sync::SyncEngine late_engine(late);
+    primary_engine.initialize_local_identity(primary_node, db_id);
+    replica_engine.initialize_local_identity(make_node(0x20), db_id);
+    late_engine.initialize_local_identity(make_node(0x30), db_id);
+
+    mdbxc::sync::ThreadLocalChangeAccumulator capture(primary);
+    mdbxc::KeyValueTable<int, std::string> primary_ticks(primary, "ticks");
+    primary->attach_sync_capture(&capture);
+    for (int i = 1; i <= 10; ++i) {
+        primary_ticks.insert_or_assign(i, "tick " + std::to_string(i));
+    }
+    primary->detach_sync_capture();
+
+    mdbxc::sync::WebSocketStreamingPushOptions options;
+    options.batches_per_message = 2;
+    options.max_in_flight_messages = 3;
+
+    mdbxc::sync::WebSocketSyncServer replica_server(replica_engine);
+    LaggingWebSocketStream stream(replica_server);
+    mdbxc::sync::WebSocketStreamingPushSender sender(primary_engine, stream, options);
+    const mdbxc::sync::WebSocketStreamingPushResult pushed = sender.push(1);
+    require_true(pushed.ok, "streaming push failed: " + pushed.error);
+    require_true(pushed.messages_sent == 5u && pushed.batches_sent == 10u,
+                 "streaming push message split mismatch");
+    require_true(pushed.max_in_flight == 3u,
+                 "streaming push did not fill its window");
+    require_true(pushed.acknowledged_seq == 10u &&
+                     pushed.receiver_have.last_seq_for(primary_node) == 10u,
+                 "streaming push acknowledgement mismatch");
+    require_true(stream.pending() == 0u, "streaming push left answers on the stream");
+    mdbxc::KeyValueTable<int, std::string> replica_ticks(replica, "ticks");
+    require_true(get_value(replica, replica_ticks, 10) == "tick 10",
+                 "streamed value mismatch");
+
+    // Starting past the receiver's cursor is a gap: every message fails,
+    // nothing is sent after the first answer, and the stream is drained.
+    mdbxc::sync::WebSocketSyncServer late_server(late_engine);
+    LaggingWebSocketStream late_stream(late_server);
+    mdbxc::sync::WebSocketStreamingPushSender late_sender(primary_engine, late_stream, options);
+    const mdbxc::sync::WebSocketStreamingPushResult rejected = late_sender.push(3);
+    require_true(!rejected.ok && !rejected.error.empty(),
+                 "streaming push past a gap did not fail");
+    require_true(late_stream.sent() == 3u && late_stream.pending() == 0u,
+                 "failed streaming push kept sending or left answers");
+    require_true(rejected.acknowledged_seq == 0u,
+                 "failed streaming push acknowledged missing batches");
+
+    bool threw = false;
+    try {
+        options.max_in_flight_messages = 0;
+        mdbxc::sync::WebSocketStreamingPushSender invalid(primary_engine, stream, options);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    require_true(threw, "streaming push accepted an empty window");
+
+    primary->disconnect();
+    replica->disconnect();
+    late->disconnect();
+    cleanup(primary_path);
+    cleanup(replica_path);
+    cleanup(late_path);
+}
+
 int main() {
     test_websocket_peer_pull_and_push_roundtrip();
+    test_websocket_tagged_message_roundtrip();
+    test_websocket_streaming_push_keeps_window_in_flight();
     test_websocket_server_rejects_response_messages();
     test_websocket_server_rejects_malformed_messages();
     test_websocket_authenticated_node_policy();
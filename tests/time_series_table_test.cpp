@@ -0,0 +1,101 @@
+#include "test_assert.hpp"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <mdbx_containers/TimeSeriesTable.hpp>
+
+namespace {
+
+struct Tick {
+    double        price;
+    std::uint64_t volume;
+    std::uint32_t flags;
+    std::uint32_t pad;
+};
+
+} // namespace
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/time_series_table_test.mdbx";
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+
+        typedef mdbxc::TimeSeriesTable<Tick> Ticks;
+        Ticks ticks(conn, "ts_ticks", 1000);
+        ticks.clear();
+
+        std::vector<Ticks::point_type> batch;
+        for (std::uint64_t i = 0; i < 3000; ++i) {
+            Tick t = Tick();
+            t.price = 100.0 + static_cast<double>(i % 7) * 0.25;
+            t.volume = 10 + i % 3;
+            t.flags = 1;
+            batch.push_back(Ticks::point_type(i * 10, t));
+        }
+        ticks.append(batch);
+        MDBXC_TEST_ASSERT(ticks.count() == 3000);
+
+        // Range reads return exactly the overlapping points in time order.
+        std::vector<Ticks::point_type> points = ticks.range(995, 2005);
+        MDBXC_TEST_ASSERT(points.size() == 101);
+        MDBXC_TEST_ASSERT(points.front().timestamp == 1000);
+        MDBXC_TEST_ASSERT(points.back().timestamp == 2000);
+        MDBXC_TEST_ASSERT(points[1].value.price == 100.0 + 3 * 0.25);
+        MDBXC_TEST_ASSERT(points[1].value.volume == 10 + 101 % 3);
+
+        std::size_t visited = 0;
+        MDBXC_TEST_ASSERT(!ticks.for_each_range(0, 29990, [&visited](std::uint64_t, const Tick&) {
+            return ++visited < 5;
+        }));
+        MDBXC_TEST_ASSERT(visited == 5);
+
+        // In-order single appends extend the last chunk; late points are merged.
+        Tick late = Tick();
+        late.price = 1.0;
+        late.volume = 11;
+        ticks.append(30000, late);
+        ticks.append(30000, late);
+        ticks.append(15, late);
+        points = ticks.range(10, 20);
+        MDBXC_TEST_ASSERT(points.size() == 3);
+        MDBXC_TEST_ASSERT(points[1].timestamp == 15 && points[1].value.price == 1.0);
+        MDBXC_TEST_ASSERT(ticks.range(30000, 30000).size() == 2);
+        MDBXC_TEST_ASSERT(ticks.count() == 3003);
+
+        std::vector<mdbxc::TimeSeriesAggregate> bars =
+            ticks.downsample(0, 9999, 5000, [](const Tick& t) { return t.volume; });
+        MDBXC_TEST_ASSERT(bars.size() == 2);
+        MDBXC_TEST_ASSERT(bars[0].start == 0 && bars[0].count == 501);
+        MDBXC_TEST_ASSERT(bars[1].start == 5000 && bars[1].count == 500);
+        MDBXC_TEST_ASSERT(bars[0].min == 10 && bars[0].max == 12);
+
+        // Retention drops whole chunks and trims the boundary chunk.
+        MDBXC_TEST_ASSERT(ticks.erase_before(1500) == 151);
+        MDBXC_TEST_ASSERT(ticks.range(0, 1499).empty());
+        MDBXC_TEST_ASSERT(ticks.range(1500, 1500).size() == 1);
+        MDBXC_TEST_ASSERT(ticks.count() == 3003 - 151);
+
+        mdbxc::TimeSeriesTable<double> temps(conn, "ts_temps", 60);
+        temps.clear();
+        temps.append(0, 20.0);
+        temps.append(30, 22.0);
+        temps.append(90, 18.0);
+        std::vector<mdbxc::TimeSeriesAggregate> hourly = temps.downsample(0, 120, 60);
+        MDBXC_TEST_ASSERT(hourly.size() == 2);
+        MDBXC_TEST_ASSERT(hourly[0].mean() == 21.0);
+        MDBXC_TEST_ASSERT(hourly[0].first == 20.0 && hourly[0].last == 22.0);
+        MDBXC_TEST_ASSERT(hourly[1].count == 1 && hourly[1].sum == 18.0);
+    } catch (const std::exception& e) {
+        std::cerr << "Time series table test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Time series table test passed.\n";
+    return 0;
+}
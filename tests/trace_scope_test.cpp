@@ -0,0 +1,88 @@
+#define MDBXC_TRACE_ENABLED 1
+
+#include "test_assert.hpp"
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <mdbx_containers/KeyValueTable.hpp>
+
+namespace {
+
+class RecordingSink : public mdbxc::ITraceSink {
+public:
+    std::uint64_t begin_trace_scope(mdbxc::TracePoint point) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        open.push_back(point);
+        return ++next_token;
+    }
+
+    void end_trace_scope(mdbxc::TracePoint point, std::uint64_t token) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Scopes on one thread nest, so each end closes the latest begin.
+        MDBXC_TEST_ASSERT(!open.empty() && open.back() == point);
+        MDBXC_TEST_ASSERT(token != 0);
+        open.pop_back();
+        ++counts[static_cast<std::size_t>(point)];
+    }
+
+    std::size_t count(mdbxc::TracePoint point) const {
+        return counts[static_cast<std::size_t>(point)];
+    }
+
+    std::mutex mutex;
+    std::vector<mdbxc::TracePoint> open;
+    std::uint64_t next_token = 0;
+    std::size_t counts[mdbxc::trace_point_count] = {};
+};
+
+} // namespace
+
+int main() {
+    try {
+        MDBXC_TEST_ASSERT(std::string(mdbxc::trace_point_name(mdbxc::TracePoint::TableFind)) ==
+                          "mdbxc.table.find");
+        MDBXC_TEST_ASSERT(std::string(mdbxc::trace_point_name(mdbxc::TracePoint::SyncApply)) ==
+                          "mdbxc.sync.apply");
+
+        mdbxc::Config cfg;
+        cfg.pathname = "data/trace_scope_test.mdbx";
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+        mdbxc::KeyValueTable<int, std::string> table(conn, "trace_table");
+        table.clear();
+
+        RecordingSink sink;
+        mdbxc::set_trace_sink(&sink);
+
+        table.insert_or_assign(1, "one");
+        table.insert_or_assign(2, "two");
+        MDBXC_TEST_ASSERT(table.at(1) == "one");
+        MDBXC_TEST_ASSERT(table.erase(2));
+        MDBXC_TEST_ASSERT(table.range(0, 10).size() == 1);
+
+        mdbxc::set_trace_sink(nullptr);
+        table.insert_or_assign(3, "untraced");
+
+        MDBXC_TEST_ASSERT(sink.open.empty());
+        MDBXC_TEST_ASSERT(sink.count(mdbxc::TracePoint::TableInsert) == 2);
+        MDBXC_TEST_ASSERT(sink.count(mdbxc::TracePoint::Serialize) == 2);
+        MDBXC_TEST_ASSERT(sink.count(mdbxc::TracePoint::TableFind) == 1);
+        MDBXC_TEST_ASSERT(sink.count(mdbxc::TracePoint::Deserialize) == 1);
+        MDBXC_TEST_ASSERT(sink.count(mdbxc::TracePoint::TableErase) == 1);
+        MDBXC_TEST_ASSERT(sink.count(mdbxc::TracePoint::TableRange) == 1);
+        // Each call runs in its own auto-transaction.
+        MDBXC_TEST_ASSERT(sink.count(mdbxc::TracePoint::TxnBegin) >= 5);
+        MDBXC_TEST_ASSERT(sink.count(mdbxc::TracePoint::TxnCommit) >= 3);
+    } catch (const std::exception& e) {
+        std::cerr << "Trace scope test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Trace scope test passed.\n";
+    return 0;
+}
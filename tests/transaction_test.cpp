@@ -1,12 +1,15 @@
 #include "test_assert.hpp"
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <mdbx_containers/KeyValueTable.hpp>
 #include <mdbx_containers/ValueTable.hpp>
@@ -71,7 +74,12 @@ int main() {
 
         names.insert_or_assign(1, "one", txn);
         version.set(1, txn);
+        MDBXC_TEST_ASSERT(txn.commit_latency().whole.count() == 0);
         txn.commit();
+        // MDBX reports the phases of the commit; the whole covers each one.
+        const mdbxc::CommitLatency& latency = txn.commit_latency();
+        MDBXC_TEST_ASSERT(latency.whole >= latency.sync);
+        MDBXC_TEST_ASSERT(latency.whole >= latency.write);
 
         MDBXC_TEST_ASSERT(names.at(1) == "one");
         MDBXC_TEST_ASSERT(version.get() == 1);
@@ -297,6 +305,710 @@ int main() {
         MDBXC_TEST_ASSERT(!shutdown_conn->is_connected());
     }
 
+    {
+        // More connections than per-thread tracker slots: the extra ones use
+        // the overflow maps and must still resolve their own bound txn.
+        const int conn_count = 12;
+        std::vector<std::shared_ptr<mdbxc::Connection>> conns;
+        std::vector<std::unique_ptr<mdbxc::KeyValueTable<int, int>>> tables;
+        for (int i = 0; i < conn_count; ++i) {
+            mdbxc::Config slot_cfg;
+            slot_cfg.pathname = "data/transaction_slot_test_" + std::to_string(i) + ".mdbx";
+            slot_cfg.max_dbs = 2;
+            slot_cfg.no_subdir = true;
+            slot_cfg.relative_to_exe = true;
+            conns.push_back(mdbxc::Connection::create(slot_cfg));
+            tables.emplace_back(new mdbxc::KeyValueTable<int, int>(conns.back(), "slots"));
+            tables.back()->clear();
+        }
+
+        for (int i = 0; i < conn_count; ++i) {
+            conns[i]->begin(mdbxc::TransactionMode::WRITABLE);
+            tables[i]->insert_or_assign(1, i);
+        }
+        for (int i = 0; i < conn_count; ++i) {
+            auto v = tables[i]->find_compat(1);
+            MDBXC_TEST_ASSERT(v.first && v.second == i);
+        }
+        for (int i = conn_count - 1; i >= 0; --i) {
+            if (i % 2 == 0) {
+                conns[i]->commit();
+            } else {
+                conns[i]->rollback();
+            }
+        }
+        for (int i = 0; i < conn_count; ++i) {
+            auto v = tables[i]->find_compat(1);
+            MDBXC_TEST_ASSERT(v.first == (i % 2 == 0));
+        }
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&conns, &tables, t]() {
+                for (int round = 0; round < 50; ++round) {
+                    const int i = (t * 3 + round) % conn_count;
+                    auto txn = conns[i]->transaction(mdbxc::TransactionMode::READ_ONLY);
+                    (void)tables[i]->find_compat(1, txn);
+                    txn.commit();
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        for (int i = 0; i < conn_count; ++i) {
+            MDBXC_TEST_ASSERT(conns[i]->shutdown_for(std::chrono::seconds(2)));
+            MDBXC_TEST_ASSERT(!conns[i]->is_connected());
+        }
+    }
+
+    {
+        mdbxc::Config cache_cfg;
+        cache_cfg.pathname = "data/transaction_read_cache_test.mdbx";
+        cache_cfg.max_dbs = 2;
+        cache_cfg.no_subdir = true;
+        cache_cfg.relative_to_exe = true;
+        cache_cfg.read_txn_cache_size = 4;
+        cache_cfg.read_txn_cache_max_idle_ms = 0;
+
+        auto cache_conn = mdbxc::Connection::create(cache_cfg);
+        mdbxc::KeyValueTable<int, int> cache_table(cache_conn, "cached_reads");
+        cache_table.clear();
+        cache_table.insert_or_assign(1, 10);
+
+        MDBX_txn* parked = nullptr;
+        {
+            auto read_txn = cache_conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            parked = read_txn.handle();
+            MDBXC_TEST_ASSERT(cache_table.at(1, read_txn) == 10);
+        }
+        MDBXC_TEST_ASSERT(!cache_conn->current_txn());
+
+        // The renewed handle must observe a fresh snapshot.
+        cache_table.insert_or_assign(1, 11);
+        {
+            auto read_txn = cache_conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            MDBXC_TEST_ASSERT(read_txn.handle() == parked);
+            MDBXC_TEST_ASSERT(cache_table.at(1, read_txn) == 11);
+            read_txn.commit();
+        }
+        MDBXC_TEST_ASSERT(cache_table.at(1) == 11);
+
+        // Handles parked by another thread are not reused here and are
+        // evicted once idle longer than the configured bound.
+        std::thread reader([&cache_table]() {
+            MDBXC_TEST_ASSERT(cache_table.at(1) == 11);
+        });
+        reader.join();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        {
+            auto read_txn = cache_conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            MDBXC_TEST_ASSERT(cache_table.contains(1, read_txn));
+        }
+
+        MDBXC_TEST_ASSERT(cache_conn->shutdown_for(std::chrono::seconds(2)));
+        MDBXC_TEST_ASSERT(!cache_conn->is_connected());
+        cache_conn->connect();
+        MDBXC_TEST_ASSERT(cache_table.at(1) == 11);
+        cache_conn->disconnect();
+        MDBXC_TEST_ASSERT(!cache_conn->is_connected());
+    }
+
+    {
+        mdbxc::Config group_cfg;
+        group_cfg.pathname = "data/transaction_group_commit_test.mdbx";
+        group_cfg.max_dbs = 2;
+        group_cfg.no_subdir = true;
+        group_cfg.relative_to_exe = true;
+        group_cfg.group_commit = true;
+        group_cfg.group_commit_max_batch = 16;
+
+        auto group_conn = mdbxc::Connection::create(group_cfg);
+        MDBXC_TEST_ASSERT(group_conn->group_commit_enabled());
+        mdbxc::KeyValueTable<int, int> group_table(group_conn, "grouped");
+        group_table.clear();
+
+        const int writer_count = 6;
+        const int writes_per_writer = 40;
+        std::vector<std::thread> writers;
+        for (int t = 0; t < writer_count; ++t) {
+            writers.emplace_back([group_conn, t]() {
+                mdbxc::KeyValueTable<int, int> local(group_conn, "grouped");
+                for (int i = 0; i < writes_per_writer; ++i) {
+                    local.insert_or_assign(t * 1000 + i, i);
+                }
+            });
+        }
+        for (auto& w : writers) w.join();
+        MDBXC_TEST_ASSERT(group_table.count() ==
+                          static_cast<std::size_t>(writer_count * writes_per_writer));
+        MDBXC_TEST_ASSERT(group_table.at(5 * 1000 + 7) == 7);
+
+        // A failing action reports its own error and leaves no partial write.
+        std::future<void> failed = group_conn->submit_write([&group_table](MDBX_txn* t) {
+            group_table.insert_or_assign(-1, -1, t);
+            throw std::runtime_error("grouped write failed");
+        });
+        bool failure_reported = false;
+        try {
+            failed.get();
+        } catch (const std::runtime_error&) {
+            failure_reported = true;
+        }
+        MDBXC_TEST_ASSERT(failure_reported);
+        MDBXC_TEST_ASSERT(!group_table.contains(-1));
+
+        // Within one batch only the failing action is dropped; the actions
+        // queued with it are retried together and the failing one runs once.
+        {
+            std::promise<void> gate_entered;
+            std::promise<void> gate_open;
+            std::shared_future<void> gate = gate_open.get_future().share();
+            std::future<void> gated = group_conn->async_write([&gate_entered, gate](MDBX_txn*) {
+                gate_entered.set_value();
+                gate.wait();
+            });
+            gate_entered.get_future().wait();
+            std::atomic<int> before_runs(0);
+            std::atomic<int> failing_runs(0);
+            std::atomic<int> after_runs(0);
+            std::future<void> before = group_conn->async_write([&group_table, &before_runs](MDBX_txn* t) {
+                ++before_runs;
+                group_table.insert_or_assign(-3, -3, t);
+            });
+            std::future<void> failing = group_conn->async_write([&group_table, &failing_runs](MDBX_txn* t) {
+                ++failing_runs;
+                group_table.insert_or_assign(-4, -4, t);
+                throw std::runtime_error("grouped write failed");
+            });
+            std::future<void> after = group_conn->async_write([&group_table, &after_runs](MDBX_txn* t) {
+                ++after_runs;
+                group_table.insert_or_assign(-5, -5, t);
+            });
+            gate_open.set_value();
+            gated.get();
+            before.get();
+            after.get();
+            bool failing_reported = false;
+            try {
+                failing.get();
+            } catch (const std::runtime_error&) {
+                failing_reported = true;
+            }
+            MDBXC_TEST_ASSERT(failing_reported);
+            MDBXC_TEST_ASSERT(failing_runs.load() == 1);
+            MDBXC_TEST_ASSERT(before_runs.load() == 2 && after_runs.load() == 1);
+            MDBXC_TEST_ASSERT(group_table.contains(-3) && group_table.contains(-5));
+            MDBXC_TEST_ASSERT(!group_table.contains(-4));
+            group_table.erase(-3);
+            group_table.erase(-5);
+        }
+
+        // Writes on a thread with a bound transaction keep using it.
+        {
+            auto txn = group_conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            group_table.insert_or_assign(-2, -2);
+            bool submit_blocked = false;
+            try {
+                group_conn->submit_write([](MDBX_txn*) {});
+            } catch (const std::logic_error&) {
+                submit_blocked = true;
+            }
+            MDBXC_TEST_ASSERT(submit_blocked);
+            txn.rollback();
+        }
+        MDBXC_TEST_ASSERT(!group_table.contains(-2));
+
+        group_conn->shutdown();
+        MDBXC_TEST_ASSERT(!group_conn->is_connected());
+    }
+
+    {
+        names.insert_or_assign(500, "before");
+        version.set(1);
+
+        mdbxc::Snapshot snap = conn->snapshot();
+        mdbxc::Snapshot copy = snap;
+        MDBXC_TEST_ASSERT(copy.valid() && copy.handle() == snap.handle());
+        const std::uint64_t pinned = snap.txn_id();
+
+        std::thread writer([&conn]() {
+            mdbxc::KeyValueTable<int, std::string> w_names(conn, "txn_names");
+            mdbxc::ValueTable<int> w_version(conn, "txn_version");
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            w_names.insert_or_assign(500, "after", txn);
+            w_version.set(2, txn);
+            txn.commit();
+        });
+        writer.join();
+
+        // Both tables read the pinned view, explicitly and through the thread binding.
+        MDBXC_TEST_ASSERT(names.at(500, copy) == "before");
+        MDBXC_TEST_ASSERT(version.get(snap) == 1);
+        MDBXC_TEST_ASSERT(names.at(500) == "before");
+        MDBXC_TEST_ASSERT(snap.max_age() == mdbxc::Snapshot::clock::duration::zero());
+
+        copy.renew();
+        MDBXC_TEST_ASSERT(snap.txn_id() > pinned);
+        MDBXC_TEST_ASSERT(names.at(500, snap) == "after");
+        MDBXC_TEST_ASSERT(version.get(snap) == 2);
+
+        bool nested_blocked = false;
+        try {
+            (void)conn->snapshot();
+        } catch (const std::logic_error&) {
+            nested_blocked = true;
+        }
+        MDBXC_TEST_ASSERT(nested_blocked);
+    }
+
+    {
+        mdbxc::Snapshot snap = conn->snapshot(std::chrono::milliseconds(1));
+        const std::uint64_t pinned = snap.txn_id();
+        std::thread writer([&conn]() {
+            mdbxc::ValueTable<int> w_version(conn, "txn_version");
+            w_version.set(3);
+        });
+        writer.join();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        MDBXC_TEST_ASSERT(version.get(snap) == 3);
+        MDBXC_TEST_ASSERT(snap.txn_id() > pinned);
+    }
+    MDBXC_TEST_ASSERT(!mdbxc::Snapshot().valid());
+
+    {
+        bool sticky_rejected = false;
+        try {
+            (void)conn->detached_snapshot();
+        } catch (const std::logic_error&) {
+            sticky_rejected = true;
+        }
+        MDBXC_TEST_ASSERT(sticky_rejected);
+
+        mdbxc::Config free_cfg;
+        free_cfg.pathname = "data/transaction_detached_snapshot_test.mdbx";
+        free_cfg.max_dbs = 2;
+        free_cfg.no_subdir = true;
+        free_cfg.relative_to_exe = true;
+        free_cfg.no_sticky_threads = true;
+        auto free_conn = mdbxc::Connection::create(free_cfg);
+        mdbxc::KeyValueTable<int, int> scan(free_conn, "detached_scan");
+        for (int i = 0; i < 4; ++i) {
+            scan.insert_or_assign(i, i);
+        }
+
+        mdbxc::Snapshot snap = free_conn->detached_snapshot();
+        MDBXC_TEST_ASSERT(snap.detached());
+        // The creating thread keeps its own transactions, which see new data.
+        scan.insert_or_assign(9, 9);
+        MDBXC_TEST_ASSERT(scan.contains(9));
+        MDBXC_TEST_ASSERT(!scan.contains(9, snap));
+
+        // Each step of the scan runs on another thread, like a migrating task.
+        int seen = 0;
+        for (int i = 0; i < 4; ++i) {
+            std::thread step([&scan, &snap, &seen, i]() {
+                seen += scan.at(i, snap) == i ? 1 : 0;
+            });
+            step.join();
+        }
+        MDBXC_TEST_ASSERT(seen == 4);
+        MDBXC_TEST_ASSERT(scan.count(snap) == 4);
+
+        // The last copy may end the read view on any thread.
+        std::thread closer([&snap]() {
+            snap = mdbxc::Snapshot();
+        });
+        closer.join();
+        free_conn->shutdown();
+        MDBXC_TEST_ASSERT(!free_conn->is_connected());
+    }
+
+    {
+        // Reopening a cached DBI needs no transaction, even inside an active one.
+        auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        names.insert_or_assign(900, "cached");
+        mdbxc::KeyValueTable<int, std::string> names_again(conn, "txn_names");
+        MDBXC_TEST_ASSERT(names_again.contains(900));
+        txn.rollback();
+        MDBXC_TEST_ASSERT(!names_again.contains(900));
+    }
+
+    {
+        mdbxc::EnvStats before = conn->stats();
+        MDBXC_TEST_ASSERT(before.page_size > 0);
+        MDBXC_TEST_ASSERT(before.used_pages > 0);
+        MDBXC_TEST_ASSERT(before.readers_in_use >= 1);
+        bool names_listed = false;
+        for (std::size_t i = 0; i < before.tables.size(); ++i) {
+            if (before.tables[i].name == "txn_names") {
+                names_listed = true;
+            }
+        }
+        MDBXC_TEST_ASSERT(names_listed);
+
+        // A reader pinned on another thread shows up as lag.
+        std::promise<void> pinned;
+        std::promise<void> release;
+        std::shared_future<void> release_future = release.get_future().share();
+        std::thread reader([&conn, &pinned, release_future]() {
+            auto read_txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            pinned.set_value();
+            release_future.wait();
+            read_txn.commit();
+        });
+        pinned.get_future().wait();
+        names.insert_or_assign(910, "lag-1");
+        names.insert_or_assign(911, "lag-2");
+        mdbxc::EnvStats lagging = conn->stats();
+        release.set_value();
+        reader.join();
+        MDBXC_TEST_ASSERT(lagging.oldest_reader_lag >= 2);
+        MDBXC_TEST_ASSERT(lagging.last_txn_id > before.last_txn_id);
+        names.erase(910);
+        names.erase(911);
+    }
+
+    {
+        mdbxc::KeyValueTable<int, std::string> batch(conn, "txn_savepoints");
+        batch.clear();
+
+        auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+        batch.insert_or_assign(1, "parent");
+        {
+            auto sp = txn.savepoint();
+            MDBXC_TEST_ASSERT(sp.handle() != txn.handle());
+            batch.insert_or_assign(2, "discarded");
+            sp.rollback();
+            MDBXC_TEST_ASSERT(!batch.contains(2));
+
+            // The same guard opens the next sub-batch under the same parent.
+            sp.begin();
+            batch.insert_or_assign(3, "kept");
+            sp.commit();
+        }
+        {
+            auto sp = txn.savepoint();
+            batch.insert_or_assign(4, "dropped by destructor");
+        }
+        MDBXC_TEST_ASSERT(batch.contains(1));
+        MDBXC_TEST_ASSERT(batch.contains(3));
+        MDBXC_TEST_ASSERT(!batch.contains(4));
+        txn.commit();
+
+        MDBXC_TEST_ASSERT(batch.count() == 2);
+        MDBXC_TEST_ASSERT(batch.at(3) == "kept");
+
+        auto read_txn = conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+        bool read_savepoint_rejected = false;
+        try {
+            auto sp = read_txn.savepoint();
+        } catch (const mdbxc::MdbxException&) {
+            read_savepoint_rejected = true;
+        }
+        MDBXC_TEST_ASSERT(read_savepoint_rejected);
+        read_txn.commit();
+    }
+
+    {
+        mdbxc::KeyValueTable<int, std::string> warm_table(conn, "warmup_table");
+        warm_table.clear();
+        for (int i = 0; i < 100; ++i) {
+            warm_table.insert_or_assign(i, std::string(static_cast<std::size_t>(i) * 100, 'w'));
+        }
+
+        mdbxc::WarmupOptions options;
+        options.progress_every = 10;
+        std::size_t callbacks = 0;
+        std::uint64_t last_entries = 0;
+        options.progress = [&last_entries, &callbacks](const mdbxc::WarmupProgress& p) {
+            MDBXC_TEST_ASSERT(p.entries >= last_entries);
+            MDBXC_TEST_ASSERT(p.tables_total == 1);
+            last_entries = p.entries;
+            ++callbacks;
+        };
+        mdbxc::WarmupResult warm = conn->warmup({"warmup_table"}, std::chrono::milliseconds(0), options);
+        MDBXC_TEST_ASSERT(warm.completed);
+        MDBXC_TEST_ASSERT(warm.tables_done == 1);
+        MDBXC_TEST_ASSERT(warm.entries == 100);
+        MDBXC_TEST_ASSERT(warm.bytes > 100 * 99 * 50);
+        MDBXC_TEST_ASSERT(callbacks >= 10);
+
+        std::future<mdbxc::WarmupResult> pending =
+            conn->warmup_async({"warmup_table"}, std::chrono::seconds(10));
+        MDBXC_TEST_ASSERT(pending.get().entries == 100);
+
+        bool missing_threw = false;
+        try {
+            conn->warmup({"warmup_missing_table"});
+        } catch (const mdbxc::MdbxException&) {
+            missing_threw = true;
+        }
+        MDBXC_TEST_ASSERT(missing_threw);
+        warm_table.clear();
+    }
+
+    {
+        mdbxc::Config geo_cfg;
+        geo_cfg.pathname = "data/transaction_geometry_test.mdbx";
+        geo_cfg.max_dbs = 4;
+        geo_cfg.no_subdir = true;
+        geo_cfg.relative_to_exe = true;
+        geo_cfg.page_size = 4096;
+        auto geo_conn = mdbxc::Connection::create(geo_cfg);
+        mdbxc::KeyValueTable<int, std::string> blobs(geo_conn, "geometry_blobs");
+        mdbxc::KeyValueTable<int, int> small(geo_conn, "geometry_small");
+        blobs.clear();
+        small.clear();
+        for (int i = 0; i < 200; ++i) {
+            blobs.insert_or_assign(i, std::string(3000, 'g'));
+            small.insert_or_assign(i, i);
+        }
+
+        mdbxc::GeometryAdviceOptions options;
+        options.page_sizes = {16384, 4096, 8192};
+        options.measure_dir = ".";
+        mdbxc::GeometryAdvice advice = geo_conn->advise_geometry(options);
+        MDBXC_TEST_ASSERT(advice.current_page_size == 4096);
+        MDBXC_TEST_ASSERT(advice.tables.size() == 2);
+        for (std::size_t i = 0; i < advice.tables.size(); ++i) {
+            const mdbxc::DbiProfile& table = advice.tables[i];
+            MDBXC_TEST_ASSERT(table.sampled == 200);
+            MDBXC_TEST_ASSERT(table.key_sizes.max == sizeof(int));
+            if (table.name == "geometry_blobs") {
+                MDBXC_TEST_ASSERT(table.value_sizes.max == 3000);
+                MDBXC_TEST_ASSERT(table.sampled_overflow == 200);
+                MDBXC_TEST_ASSERT(table.overflow_pages >= 200);
+            } else {
+                MDBXC_TEST_ASSERT(table.sampled_overflow == 0);
+                MDBXC_TEST_ASSERT(table.layout == mdbxc::ValueLayoutHint::Inline);
+            }
+        }
+        MDBXC_TEST_ASSERT(advice.estimates.size() == 3);
+        MDBXC_TEST_ASSERT(advice.estimates[0].page_size == 4096);
+        MDBXC_TEST_ASSERT(advice.estimates[0].overflow_entries == 200);
+        MDBXC_TEST_ASSERT(advice.estimates[2].overflow_entries == 0);
+        MDBXC_TEST_ASSERT(advice.recommended_page_size > 4096);
+        MDBXC_TEST_ASSERT(advice.recommended_growth_step >= 16 * 1024 * 1024);
+        MDBXC_TEST_ASSERT(advice.recommended_max_dupsort_value_size == -1);
+        MDBXC_TEST_ASSERT(!advice.notes.empty());
+
+        MDBXC_TEST_ASSERT(advice.measurements.size() == 3);
+        MDBXC_TEST_ASSERT(advice.measurements[0].entries == 400);
+        MDBXC_TEST_ASSERT(advice.measurements[0].overflow_pages >= 200);
+        MDBXC_TEST_ASSERT(advice.measurements[2].overflow_pages == 0);
+
+        mdbxc::SizeHistogram histogram;
+        histogram.add(0);
+        histogram.add(5);
+        histogram.add(1000);
+        MDBXC_TEST_ASSERT(histogram.buckets[0] == 1 && histogram.buckets[3] == 1);
+        MDBXC_TEST_ASSERT(histogram.percentile(0.5) == 7);
+        MDBXC_TEST_ASSERT(histogram.percentile(1.0) == 1000);
+        geo_conn->disconnect();
+    }
+
+    {
+        mdbxc::Config lazy_cfg;
+        lazy_cfg.pathname = "data/transaction_lazy_sync_test.mdbx";
+        lazy_cfg.max_dbs = 2;
+        lazy_cfg.no_subdir = true;
+        lazy_cfg.relative_to_exe = true;
+        lazy_cfg.sync_mode = mdbxc::SyncMode::SafeNoSync;
+        lazy_cfg.sync_period_ms = 10;
+
+        auto lazy_conn = mdbxc::Connection::create(lazy_cfg);
+        mdbxc::KeyValueTable<int, int> lazy_table(lazy_conn, "lazy_sync");
+        std::uint64_t written = 0;
+        {
+            auto txn = lazy_conn->transaction();
+            lazy_table.insert_or_assign(1, 1, txn);
+            written = mdbx_txn_id(txn.handle());
+            txn.commit();
+        }
+        // The background thread flushes within a few periods.
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (lazy_conn->durable_txn_id() < written && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        MDBXC_TEST_ASSERT(lazy_conn->durable_txn_id() >= written);
+
+        {
+            auto txn = lazy_conn->transaction();
+            lazy_table.insert_or_assign(2, 2, txn);
+            written = mdbx_txn_id(txn.handle());
+            txn.commit();
+        }
+        lazy_conn->wait_for_durable(written);
+        MDBXC_TEST_ASSERT(lazy_conn->durable_txn_id() >= written);
+        MDBXC_TEST_ASSERT(lazy_table.count() == 2);
+
+        // A disconnect refused with MDBX_BUSY keeps the periodic flush running.
+        {
+            auto held = lazy_conn->transaction(mdbxc::TransactionMode::READ_ONLY);
+            MDBXC_TEST_ASSERT(lazy_table.count(held) == 2);
+            bool disconnect_failed = false;
+            try {
+                lazy_conn->disconnect();
+            } catch (const mdbxc::MdbxException& ex) {
+                disconnect_failed = ex.error_code() == MDBX_BUSY;
+            }
+            MDBXC_TEST_ASSERT(disconnect_failed);
+            MDBXC_TEST_ASSERT(lazy_conn->is_connected());
+        }
+        {
+            auto txn = lazy_conn->transaction();
+            lazy_table.insert_or_assign(3, 3, txn);
+            written = mdbx_txn_id(txn.handle());
+            txn.commit();
+        }
+        const auto flush_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (lazy_conn->durable_txn_id() < written && std::chrono::steady_clock::now() < flush_deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        MDBXC_TEST_ASSERT(lazy_conn->durable_txn_id() >= written);
+        lazy_conn->disconnect();
+    }
+
+    {
+        MDBXC_TEST_ASSERT(conn->durable_txn_id() == conn->stats().last_txn_id);
+    }
+
+    {
+        const std::uint64_t seen = conn->last_txn_id();
+        MDBXC_TEST_ASSERT(seen == conn->stats().last_txn_id);
+        MDBXC_TEST_ASSERT(conn->wait_for_txn(seen, std::chrono::milliseconds(20)) == seen);
+
+        // A local commit wakes the waiter before the timeout.
+        std::thread writer([&names]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            names.insert_or_assign(900, std::string("commit-notify"));
+        });
+        const auto started = std::chrono::steady_clock::now();
+        const std::uint64_t next = conn->wait_for_txn(seen, std::chrono::seconds(10));
+        writer.join();
+        MDBXC_TEST_ASSERT(next > seen);
+        MDBXC_TEST_ASSERT(std::chrono::steady_clock::now() - started < std::chrono::seconds(5));
+        MDBXC_TEST_ASSERT(names.erase(900));
+    }
+
+    {
+        mdbxc::Config growth_cfg;
+        growth_cfg.pathname = "data/transaction_adaptive_growth_test.mdbx";
+        growth_cfg.max_dbs = 2;
+        growth_cfg.no_subdir = true;
+        growth_cfg.relative_to_exe = true;
+        growth_cfg.growth_step = 1024 * 1024;
+        growth_cfg.shrink_threshold = 2 * 1024 * 1024;
+        growth_cfg.growth_step_max = 64 * 1024 * 1024;
+        growth_cfg.adaptive_growth = true;
+        growth_cfg.adaptive_growth_window_ms = 0;
+
+        auto growth_conn = mdbxc::Connection::create(growth_cfg);
+        MDBXC_TEST_ASSERT(growth_conn->growth_step() == growth_cfg.growth_step);
+        mdbxc::KeyValueTable<int, std::string> growth_table(growth_conn, "adaptive_growth");
+        growth_table.clear();
+        const std::string blob(64 * 1024, 'g');
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        int key = 0;
+        // Each commit writes about 4 MiB, so one sampling window outgrows a 1 MiB step.
+        while (growth_conn->growth_step() == growth_cfg.growth_step &&
+               std::chrono::steady_clock::now() < deadline) {
+            auto txn = growth_conn->transaction();
+            for (int i = 0; i < 64; ++i) {
+                growth_table.insert_or_assign(key++, blob, txn);
+            }
+            txn.commit();
+        }
+        MDBXC_TEST_ASSERT(growth_conn->growth_step() > growth_cfg.growth_step);
+        MDBXC_TEST_ASSERT(growth_conn->growth_step() <= growth_cfg.growth_step_max);
+        growth_table.clear();
+    }
+
+    {
+        mdbxc::Config age_cfg;
+        age_cfg.pathname = "data/transaction_reader_age_test.mdbx";
+        age_cfg.max_dbs = 2;
+        age_cfg.no_subdir = true;
+        age_cfg.relative_to_exe = true;
+        age_cfg.track_read_txn_age = true;
+
+        auto age_conn = mdbxc::Connection::create(age_cfg);
+        age_conn->set_slow_reader_handler([](const mdbxc::SlowReaderInfo&) {
+            return mdbxc::SlowReaderAction::Kick;
+        });
+        mdbxc::KeyValueTable<int, int> age_table(age_conn, "reader_age");
+        age_table.insert_or_assign(1, 1);
+        MDBXC_TEST_ASSERT(age_conn->oldest_read_txn_age() == std::chrono::steady_clock::duration::zero());
+        {
+            mdbxc::Snapshot snap = age_conn->snapshot();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            MDBXC_TEST_ASSERT(age_conn->oldest_read_txn_age() >= std::chrono::milliseconds(20));
+            snap.renew();
+            MDBXC_TEST_ASSERT(age_conn->oldest_read_txn_age() < std::chrono::milliseconds(20));
+        }
+        MDBXC_TEST_ASSERT(age_conn->oldest_read_txn_age() == std::chrono::steady_clock::duration::zero());
+        age_conn->set_slow_reader_handler(mdbxc::SlowReaderHandler());
+        age_table.insert_or_assign(2, 2);
+        MDBXC_TEST_ASSERT(age_table.count() == 2);
+    }
+
+    {
+        mdbxc::Config async_cfg;
+        async_cfg.pathname = "data/transaction_async_write_test.mdbx";
+        async_cfg.max_dbs = 2;
+        async_cfg.no_subdir = true;
+        async_cfg.relative_to_exe = true;
+        async_cfg.group_commit_max_batch = 8;
+
+        auto async_conn = mdbxc::Connection::create(async_cfg);
+        mdbxc::KeyValueTable<int, int> async_table(async_conn, "async_writes");
+        async_table.clear();
+
+        std::vector<std::future<void>> pending;
+        for (int i = 0; i < 100; ++i) {
+            pending.push_back(async_conn->async_write([&async_table, i](MDBX_txn* t) {
+                async_table.insert_or_assign(i, i, t);
+            }));
+        }
+        // Later writes to the same key apply in submission order.
+        pending.push_back(async_conn->async_write([&async_table](MDBX_txn* t) {
+            async_table.insert_or_assign(0, 1000, t);
+        }));
+        std::future<void> failed = async_conn->async_write([&async_table](MDBX_txn* t) {
+            async_table.insert_or_assign(-1, -1, t);
+            throw std::runtime_error("async write failed");
+        });
+        for (auto& f : pending) f.get();
+        bool failure_reported = false;
+        try {
+            failed.get();
+        } catch (const std::runtime_error&) {
+            failure_reported = true;
+        }
+        MDBXC_TEST_ASSERT(failure_reported);
+        MDBXC_TEST_ASSERT(async_table.count() == 100);
+        MDBXC_TEST_ASSERT(async_table.at(0) == 1000);
+        MDBXC_TEST_ASSERT(!async_table.contains(-1));
+
+        // A thread holding a read view can still enqueue writes.
+        {
+            mdbxc::Snapshot snap = async_conn->snapshot();
+            async_conn->async_write([&async_table](MDBX_txn* t) {
+                async_table.insert_or_assign(200, 200, t);
+            }).get();
+            MDBXC_TEST_ASSERT(!async_table.contains(200, snap));
+        }
+        MDBXC_TEST_ASSERT(async_table.contains(200));
+
+        // Shutdown drains writes that are still queued.
+        std::future<void> last = async_conn->async_write([&async_table](MDBX_txn* t) {
+            async_table.insert_or_assign(300, 300, t);
+        });
+        async_conn->shutdown();
+        last.get();
+        MDBXC_TEST_ASSERT(!async_conn->is_connected());
+    }
+
     std::cout << "Transaction test passed.\n";
     return 0;
 }
@@ -0,0 +1,91 @@
+#include "test_assert.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <mdbx_containers/TtlKeyValueTable.hpp>
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/ttl_key_value_table_test.mdbx";
+        cfg.max_dbs = 8;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+        typedef mdbxc::TtlKeyValueTable<std::string, std::string> Sessions;
+        Sessions sessions(conn, "ttl_sessions");
+        sessions.clear();
+
+        const Sessions::time_point past = Sessions::clock_type::now() - std::chrono::hours(1);
+        const std::chrono::milliseconds hour = std::chrono::hours(1);
+
+        sessions.insert_or_assign("forever", "a");
+        sessions.insert_or_assign("live", "b", hour);
+        sessions.insert_or_assign("old1", "c", hour);
+        sessions.insert_or_assign("old2", "d", hour);
+        MDBXC_TEST_ASSERT(sessions.expire_at("old1", past));
+        MDBXC_TEST_ASSERT(sessions.expire_at("old2", past));
+
+        // Expired entries are hidden but stay stored until purged.
+        MDBXC_TEST_ASSERT(sessions.at("forever") == "a");
+        MDBXC_TEST_ASSERT(sessions.at("live") == "b");
+        MDBXC_TEST_ASSERT(!sessions.contains("old1"));
+        std::string value;
+        MDBXC_TEST_ASSERT(!sessions.try_get("old2", value));
+        MDBXC_TEST_ASSERT(!sessions.expire_after("old2", hour));
+        MDBXC_TEST_ASSERT(sessions.stored_count() == 4);
+
+        Sessions::time_point expiry;
+        MDBXC_TEST_ASSERT(sessions.try_get_expiry("forever", expiry));
+        MDBXC_TEST_ASSERT(expiry == Sessions::time_point::max());
+        MDBXC_TEST_ASSERT(sessions.try_get_expiry("live", expiry));
+        MDBXC_TEST_ASSERT(expiry > Sessions::clock_type::now());
+
+        // Purging walks the expiry order in bounded batches.
+        MDBXC_TEST_ASSERT(sessions.purge_expired(1) == 1);
+        MDBXC_TEST_ASSERT(sessions.purge_expired(10) == 1);
+        MDBXC_TEST_ASSERT(sessions.purge_expired(10) == 0);
+        MDBXC_TEST_ASSERT(sessions.stored_count() == 2);
+
+        // Rewrites and persist() move the entry out of the expiry order.
+        sessions.insert_or_assign("live", "b2", hour);
+        MDBXC_TEST_ASSERT(sessions.persist("live"));
+        MDBXC_TEST_ASSERT(sessions.try_get_expiry("live", expiry));
+        MDBXC_TEST_ASSERT(expiry == Sessions::time_point::max());
+        MDBXC_TEST_ASSERT(sessions.at("live") == "b2");
+        MDBXC_TEST_ASSERT(sessions.expire_at("forever", past));
+        MDBXC_TEST_ASSERT(!sessions.erase("forever"));
+        MDBXC_TEST_ASSERT(sessions.purge_expired() == 0);
+        MDBXC_TEST_ASSERT(sessions.erase("live"));
+        MDBXC_TEST_ASSERT(sessions.stored_count() == 0);
+
+        // The purge thread deletes expired records in the background.
+        mdbxc::TtlKeyValueTable<int, int> tokens(conn, "ttl_tokens");
+        tokens.clear();
+        for (int i = 0; i < 100; ++i) {
+            tokens.insert_or_assign(i, i, std::chrono::milliseconds(i < 50 ? 1 : 3600000));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        tokens.start_purge(std::chrono::milliseconds(5), 16);
+        for (int i = 0; i < 200 && tokens.purge_stats().purged < 50; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        tokens.stop_purge();
+        MDBXC_TEST_ASSERT(tokens.purge_stats().purged == 50);
+        MDBXC_TEST_ASSERT(tokens.purge_stats().failed_batches == 0);
+        MDBXC_TEST_ASSERT(tokens.stored_count() == 50);
+        MDBXC_TEST_ASSERT(tokens.at(50) == 50);
+
+        tokens.rebuild_expiry_index();
+        MDBXC_TEST_ASSERT(tokens.purge_expired() == 0);
+    } catch (const std::exception& e) {
+        std::cerr << "TTL key-value table test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "TTL key-value table test passed.\n";
+    return 0;
+}
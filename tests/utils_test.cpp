@@ -14,6 +14,35 @@ MDBX_val empty_value() {
     return val;
 }
 
+/// \brief Run-length test codec: (count, byte) pairs.
+struct RleTestCodec {
+    static std::uint8_t id() { return 0x7f; }
+
+    static bool compress(const void* src, std::size_t size, std::vector<std::uint8_t>& out) {
+        const std::uint8_t* p = static_cast<const std::uint8_t*>(src);
+        for (std::size_t i = 0; i < size;) {
+            std::size_t run = 1;
+            while (i + run < size && run < 255 && p[i + run] == p[i]) ++run;
+            out.push_back(static_cast<std::uint8_t>(run));
+            out.push_back(p[i]);
+            i += run;
+        }
+        return true;
+    }
+
+    static void decompress(const void* src, std::size_t size, void* dst, std::size_t raw_size) {
+        const std::uint8_t* p = static_cast<const std::uint8_t*>(src);
+        std::uint8_t* out = static_cast<std::uint8_t*>(dst);
+        std::size_t written = 0;
+        for (std::size_t i = 0; i + 1 < size; i += 2) {
+            if (written + p[i] > raw_size) throw std::runtime_error("rle: overflow");
+            std::memset(out + written, p[i + 1], p[i]);
+            written += p[i];
+        }
+        if (written != raw_size) throw std::runtime_error("rle: size mismatch");
+    }
+};
+
 template<typename T>
 void assert_deserializes_empty() {
     T out = mdbxc::deserialize_value<T>(empty_value());
@@ -313,5 +342,161 @@ int main() {
         static_cast<unsigned __int128>(2));
 #endif
 
+    {
+        mdbxc::detail::ScratchPool pool(64);
+        const void* first_slot = nullptr;
+        {
+            mdbxc::detail::ScratchLease lease(pool);
+            lease.get().bytes.assign(32, 0xAB);
+            first_slot = &lease.get();
+        }
+        {
+            mdbxc::detail::ScratchLease lease(pool);
+            MDBXC_TEST_ASSERT(&lease.get() == first_slot);
+            MDBXC_TEST_ASSERT(lease.get().bytes.empty());
+            MDBXC_TEST_ASSERT(lease.get().bytes.capacity() >= 32);
+            lease.get().bytes.resize(4096);
+        }
+        {
+            mdbxc::detail::ScratchLease lease(pool);
+            MDBXC_TEST_ASSERT(lease.get().bytes.capacity() == 0);
+        }
+
+        std::vector<mdbxc::SerializeScratch*> held;
+        for (std::size_t i = 0; i < mdbxc::detail::ScratchPool::slot_count; ++i) {
+            mdbxc::SerializeScratch* slot = pool.acquire();
+            MDBXC_TEST_ASSERT(slot != nullptr);
+            held.push_back(slot);
+        }
+        {
+            mdbxc::detail::ScratchLease overflow(pool);
+            for (std::size_t i = 0; i < held.size(); ++i) {
+                MDBXC_TEST_ASSERT(&overflow.get() != held[i]);
+            }
+        }
+        for (std::size_t i = 0; i < held.size(); ++i) pool.release(held[i]);
+        MDBXC_TEST_ASSERT(pool.acquire() != nullptr);
+    }
+
+    {
+        std::vector<std::int32_t> raw;
+        raw.push_back(0);
+        raw.push_back(-1);
+        raw.push_back(63);
+        raw.push_back(-64);
+        raw.push_back((std::numeric_limits<std::int32_t>::min)());
+        raw.push_back((std::numeric_limits<std::int32_t>::max)());
+        mdbxc::CompactVector<std::int32_t> signed_values(raw);
+        mdbxc::SerializeScratch sc;
+        MDBX_val encoded = mdbxc::serialize_value(signed_values, sc);
+        MDBXC_TEST_ASSERT(encoded.iov_len == 1 + 1 + 1 + 1 + 5 + 5);
+        MDBXC_TEST_ASSERT(mdbxc::deserialize_value<mdbxc::CompactVector<std::int32_t> >(encoded).values == raw);
+
+        std::vector<std::uint64_t> sorted;
+        for (std::uint64_t i = 0; i < 100; ++i) sorted.push_back(1000000 + i * 3);
+        mdbxc::DeltaVector<std::uint64_t> delta(sorted);
+        MDBXC_TEST_ASSERT(delta.serialized_size() == 3 + 99);
+        MDBXC_TEST_ASSERT(mdbxc::DeltaVector<std::uint64_t>::from_bytes(
+            delta.to_bytes().data(), delta.serialized_size()).values == sorted);
+
+        std::vector<std::uint64_t> unsorted;
+        unsorted.push_back(2);
+        unsorted.push_back(1);
+        bool rejected = false;
+        try {
+            (void)mdbxc::DeltaVector<std::uint64_t>(unsorted).to_bytes();
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        MDBXC_TEST_ASSERT(rejected);
+
+        std::vector<std::vector<std::uint32_t> > nested(3);
+        nested[0].push_back(5);
+        nested[0].push_back(9);
+        nested[2].push_back(70000);
+        mdbxc::CompactNestedVector<std::uint32_t, true> compact_nested(nested);
+        std::vector<std::uint8_t> nested_bytes = compact_nested.to_bytes();
+        MDBXC_TEST_ASSERT(nested_bytes.size() == 3 + 1 + 4);
+        MDBXC_TEST_ASSERT((mdbxc::CompactNestedVector<std::uint32_t, true>::from_bytes(
+            nested_bytes.data(), nested_bytes.size()).values == nested));
+
+        const std::uint8_t truncated[] = {0x80};
+        rejected = false;
+        try {
+            (void)mdbxc::CompactVector<std::uint32_t>::from_bytes(truncated, sizeof(truncated));
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        MDBXC_TEST_ASSERT(rejected);
+
+        const std::uint8_t too_large[] = {0xff, 0xff, 0x04};
+        rejected = false;
+        try {
+            (void)mdbxc::CompactVector<std::uint16_t>::from_bytes(too_large, sizeof(too_large));
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        MDBXC_TEST_ASSERT(rejected);
+    }
+
+    {
+        typedef mdbxc::CompressedString<RleTestCodec, 16> Text;
+        const Text repetitive(std::string(1000, 'a') + std::string(1000, 'b'));
+        std::vector<std::uint8_t> bytes = repetitive.to_bytes();
+        MDBXC_TEST_ASSERT(bytes[0] == RleTestCodec::id());
+        MDBXC_TEST_ASSERT(bytes.size() < 32);
+        MDBXC_TEST_ASSERT(Text::from_bytes(bytes.data(), bytes.size()) == repetitive);
+
+        const Text short_text(std::string("aaaa"));
+        bytes = short_text.to_bytes();
+        MDBXC_TEST_ASSERT(bytes.size() == 5 && bytes[0] == mdbxc::compression::plain_tag);
+        MDBXC_TEST_ASSERT(Text::from_bytes(bytes.data(), bytes.size()) == short_text);
+
+        std::string mixed;
+        for (int i = 0; i < 64; ++i) mixed.push_back(static_cast<char>('a' + i % 26));
+        const Text incompressible(mixed);
+        bytes = incompressible.to_bytes();
+        MDBXC_TEST_ASSERT(bytes.size() == 65 && bytes[0] == mdbxc::compression::plain_tag);
+        MDBXC_TEST_ASSERT(Text::from_bytes(bytes.data(), bytes.size()).value == mixed);
+
+        typedef mdbxc::Compressed<std::vector<std::uint32_t>, RleTestCodec, 16> Ids;
+        const Ids zeros(std::vector<std::uint32_t>(100, 0u));
+        mdbxc::SerializeScratch sc;
+        MDBX_val encoded = mdbxc::serialize_value(zeros, sc);
+        MDBXC_TEST_ASSERT(encoded.iov_len < 16);
+        MDBXC_TEST_ASSERT(mdbxc::deserialize_value<Ids>(encoded) == zeros);
+
+        bytes = repetitive.to_bytes();
+        bytes[0] = 0x42;
+        bool rejected = false;
+        try {
+            (void)Text::from_bytes(bytes.data(), bytes.size());
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        MDBXC_TEST_ASSERT(rejected);
+        MDBXC_TEST_ASSERT(mdbxc::compression::dictionary_table_name("docs") == "docs__dict");
+    }
+
+    {
+        std::vector<double> source;
+        for (int i = 0; i < 1000; ++i) source.push_back(i * 0.5);
+        const std::size_t bytes = source.size() * sizeof(double);
+        std::vector<std::uint8_t> storage(bytes + sizeof(double));
+        for (std::size_t offset = 0; offset < 2; ++offset) {
+            std::memcpy(storage.data() + offset, source.data(), bytes);
+            MDBX_val val;
+            val.iov_base = storage.data() + offset;
+            val.iov_len = bytes;
+            MDBXC_TEST_ASSERT(mdbxc::deserialize_value<std::vector<double> >(val) == source);
+            const std::deque<double> as_deque = mdbxc::deserialize_value<std::deque<double> >(val);
+            MDBXC_TEST_ASSERT(std::equal(as_deque.begin(), as_deque.end(), source.begin()) &&
+                              as_deque.size() == source.size());
+            const std::list<double> as_list = mdbxc::deserialize_value<std::list<double> >(val);
+            MDBXC_TEST_ASSERT(std::equal(as_list.begin(), as_list.end(), source.begin()) &&
+                              as_list.size() == source.size());
+        }
+    }
+
     return 0;
 }
@@ -147,6 +147,53 @@ int main() {
         update_txn.commit();
 
         MDBXC_TEST_ASSERT(table.get() == 10);
+
+        MDBXC_TEST_ASSERT(table.update_bytes([](mdbxc::MutableByteView& bytes) {
+            MDBXC_TEST_ASSERT(bytes.size == sizeof(int));
+            int value = 0;
+            std::memcpy(&value, bytes.data, sizeof(value));
+            ++value;
+            std::memcpy(bytes.data, &value, sizeof(value));
+        }));
+        MDBXC_TEST_ASSERT(table.get() == 11);
+    }
+
+    {
+        mdbxc::ValueTable<std::string> table(conn, "cached_value");
+        mdbxc::ValueTable<std::string> other(conn, "cached_value");
+        table.clear();
+        MDBXC_TEST_ASSERT(!table.get_shared());
+
+        table.set("first");
+        MDBXC_TEST_ASSERT(*table.get_shared() == "first");
+        MDBXC_TEST_ASSERT(table.get_shared() != table.get_shared());
+
+        table.set_value_cache(true);
+        MDBXC_TEST_ASSERT(table.value_cache_enabled());
+        std::shared_ptr<const std::string> a = table.get_shared();
+        std::shared_ptr<const std::string> b = table.get_shared();
+        MDBXC_TEST_ASSERT(a == b && *a == "first");
+
+        other.set("second");
+        std::shared_ptr<const std::string> c = table.get_shared();
+        MDBXC_TEST_ASSERT(c != a && *c == "second");
+        MDBXC_TEST_ASSERT(*a == "first");
+
+        {
+            auto txn = conn->transaction(mdbxc::TransactionMode::WRITABLE);
+            table.set("pending", txn);
+            MDBXC_TEST_ASSERT(*table.get_shared(txn) == "pending");
+            txn.rollback();
+        }
+        MDBXC_TEST_ASSERT(table.get_shared() == c);
+
+        mdbxc::ValueTable<std::string> copy(table);
+        MDBXC_TEST_ASSERT(copy.value_cache_enabled() && copy.get_shared() == c);
+
+        other.erase();
+        MDBXC_TEST_ASSERT(!table.get_shared());
+        table.set_value_cache(false);
+        MDBXC_TEST_ASSERT(!table.value_cache_enabled());
     }
 
     {
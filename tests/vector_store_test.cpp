@@ -1,8 +1,14 @@
 #include "test_assert.hpp"
 #include <exception>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <map>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -225,6 +231,774 @@ int main() {
         MDBXC_TEST_ASSERT(l2_index.dim() == 0);
     }
 
+    // --- 8b. SIMD kernels agree with the portable kernels ---
+    {
+        const mdbxc::detail::DistanceKernels& simd = mdbxc::detail::distance_kernels();
+        const mdbxc::detail::DistanceKernels& scalar = mdbxc::detail::scalar_distance_kernels();
+        const std::size_t dims[] = {1, 3, 7, 8, 15, 16, 17, 31, 33, 64, 65, 100, 768};
+        for (std::size_t d : dims) {
+            std::vector<float> a(d), b(d);
+            for (std::size_t i = 0; i < d; ++i) {
+                a[i] = static_cast<float>((i * 7) % 13) * 0.25f - 1.0f;
+                b[i] = static_cast<float>((i * 5) % 11) * 0.5f - 2.0f;
+            }
+            const float dot_ref = scalar.dot(a.data(), b.data(), d);
+            const float l2_ref = scalar.l2sq(a.data(), b.data(), d);
+            const float tol = 1e-4f * static_cast<float>(d);
+            MDBXC_TEST_ASSERT(std::fabs(simd.dot(a.data(), b.data(), d) - dot_ref) <= tol);
+            MDBXC_TEST_ASSERT(std::fabs(simd.l2sq(a.data(), b.data(), d) - l2_ref) <= tol);
+        }
+        mdbxc::FlatVectorIndex index(mdbxc::VectorMetric::L2);
+        MDBXC_TEST_ASSERT(std::string(index.kernel_name()) == simd.name);
+    }
+
+    // --- 8c. Bounded top-k search and batch search ---
+    {
+        mdbxc::FlatVectorIndex index(mdbxc::VectorMetric::L2);
+        for (uint64_t id = 0; id < 200; ++id) {
+            const float x = static_cast<float>((id * 37) % 200);
+            index.add(id, make_embedding({x, 1.0f}));
+        }
+        const std::vector<mdbxc::VectorMatch> top = index.search(make_embedding({100.2f, 1.0f}), 3);
+        MDBXC_TEST_ASSERT(top.size() == 3);
+        MDBXC_TEST_ASSERT(top[0].score >= top[1].score && top[1].score >= top[2].score);
+        // x == 100 is nearest, then 101, then 99.
+        MDBXC_TEST_ASSERT((top[0].id * 37) % 200 == 100);
+        MDBXC_TEST_ASSERT((top[1].id * 37) % 200 == 101);
+        MDBXC_TEST_ASSERT((top[2].id * 37) % 200 == 99);
+        MDBXC_TEST_ASSERT(index.search(make_embedding({0.0f, 0.0f}), 500).size() == 200);
+
+        std::vector<mdbxc::Embedding> queries;
+        queries.push_back(make_embedding({100.2f, 1.0f}));
+        queries.push_back(make_embedding({-5.0f, 1.0f}));
+        const std::vector<std::vector<mdbxc::VectorMatch>> batch = index.search_batch(queries, 3);
+        MDBXC_TEST_ASSERT(batch.size() == 2);
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            const std::vector<mdbxc::VectorMatch> single = index.search(queries[q], 3);
+            MDBXC_TEST_ASSERT(batch[q].size() == single.size());
+            for (std::size_t i = 0; i < single.size(); ++i) {
+                MDBXC_TEST_ASSERT(batch[q][i].id == single[i].id);
+            }
+        }
+        MDBXC_TEST_ASSERT(index.search_batch(queries, 0)[1].empty());
+
+        // Parallel block scans merge to the same result.
+        const std::vector<std::vector<mdbxc::VectorMatch>> parallel = index.search_batch(queries, 3, 4);
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            const std::vector<mdbxc::VectorMatch> threaded = index.search(queries[q], 3, 0);
+            for (std::size_t i = 0; i < 3; ++i) {
+                MDBXC_TEST_ASSERT(parallel[q][i].id == batch[q][i].id);
+                MDBXC_TEST_ASSERT(threaded[i].id == batch[q][i].id);
+            }
+        }
+    }
+
+    // --- 8d. Quantized kernels and index ---
+    {
+        const mdbxc::detail::DistanceKernels& simd = mdbxc::detail::distance_kernels();
+        const mdbxc::detail::DistanceKernels& scalar = mdbxc::detail::scalar_distance_kernels();
+        const float halves[] = {0.0f, 1.0f, -2.5f, 0.333251953125f, 65504.0f};
+        for (float h : halves) {
+            MDBXC_TEST_ASSERT(mdbxc::detail::half_to_float(mdbxc::detail::float_to_half(h)) == h);
+        }
+        const std::size_t dims[] = {1, 7, 8, 15, 16, 17, 33, 100, 768};
+        for (std::size_t d : dims) {
+            std::vector<float> q(d);
+            std::vector<std::int8_t> codes(d);
+            std::vector<std::uint16_t> h(d);
+            for (std::size_t i = 0; i < d; ++i) {
+                q[i] = static_cast<float>((i * 7) % 13) * 0.25f - 1.0f;
+                codes[i] = static_cast<std::int8_t>(static_cast<int>((i * 29) % 255) - 127);
+                h[i] = mdbxc::detail::float_to_half(static_cast<float>((i * 5) % 11) * 0.5f - 2.0f);
+            }
+            const float tol = 1e-3f * static_cast<float>(d);
+            MDBXC_TEST_ASSERT(std::fabs(simd.dot_i8(q.data(), codes.data(), 0.01f, d) -
+                                        scalar.dot_i8(q.data(), codes.data(), 0.01f, d)) <= tol);
+            MDBXC_TEST_ASSERT(std::fabs(simd.l2sq_i8(q.data(), codes.data(), 0.01f, d) -
+                                        scalar.l2sq_i8(q.data(), codes.data(), 0.01f, d)) <= tol);
+            MDBXC_TEST_ASSERT(std::fabs(simd.dot_f16(q.data(), h.data(), d) -
+                                        scalar.dot_f16(q.data(), h.data(), d)) <= tol);
+            MDBXC_TEST_ASSERT(std::fabs(simd.l2sq_f16(q.data(), h.data(), d) -
+                                        scalar.l2sq_f16(q.data(), h.data(), d)) <= tol);
+        }
+
+        const mdbxc::VectorQuantization modes[] = {
+            mdbxc::VectorQuantization::INT8, mdbxc::VectorQuantization::FP16};
+        for (mdbxc::VectorQuantization mode : modes) {
+            mdbxc::FlatVectorIndex exact(mdbxc::VectorMetric::COSINE);
+            mdbxc::FlatVectorIndex quantized(mdbxc::VectorMetric::COSINE, mode);
+            MDBXC_TEST_ASSERT(quantized.quantization() == mode);
+            std::vector<std::pair<uint64_t, mdbxc::Embedding>> all;
+            for (uint64_t id = 0; id < 64; ++id) {
+                const float angle = static_cast<float>(id) * 0.1f;
+                const mdbxc::Embedding e = make_embedding({std::cos(angle), std::sin(angle), 0.5f});
+                exact.add(id, e);
+                quantized.add(id, e);
+                all.push_back(std::make_pair(id, e));
+            }
+            MDBXC_TEST_ASSERT(quantized.memory_bytes() < exact.memory_bytes());
+            const mdbxc::Embedding query = make_embedding({std::cos(2.0f), std::sin(2.0f), 0.5f});
+            const std::vector<mdbxc::VectorMatch> ref = exact.search(query, 1);
+            const std::vector<mdbxc::VectorMatch> approx = quantized.search(query, 1);
+            MDBXC_TEST_ASSERT(approx[0].id == ref[0].id);
+            MDBXC_TEST_ASSERT(std::fabs(approx[0].score - ref[0].score) < 0.02f);
+
+            // Exact re-rank reproduces the fp32 ranking and scores.
+            const std::vector<mdbxc::VectorMatch> reranked = quantized.rescore(query, all, 3);
+            const std::vector<mdbxc::VectorMatch> ref3 = exact.search(query, 3);
+            MDBXC_TEST_ASSERT(reranked.size() == 3);
+            for (std::size_t i = 0; i < 3; ++i) {
+                MDBXC_TEST_ASSERT(reranked[i].id == ref3[i].id);
+                MDBXC_TEST_ASSERT(std::fabs(reranked[i].score - ref3[i].score) < 1e-5f);
+            }
+
+            quantized.erase(5);
+            MDBXC_TEST_ASSERT(quantized.size() == 63);
+            MDBXC_TEST_ASSERT(quantized.search(query, 1)[0].id == ref[0].id);
+        }
+    }
+
+    // --- 8e. HNSW index recall, tombstones and re-add ---
+    {
+        const mdbxc::VectorMetric metrics[] = {mdbxc::VectorMetric::COSINE, mdbxc::VectorMetric::L2};
+        for (mdbxc::VectorMetric metric : metrics) {
+            mdbxc::FlatVectorIndex flat(metric);
+            mdbxc::HnswVectorIndex hnsw(metric);
+            uint32_t state = 12345u;
+            const std::size_t dim = 16;
+            for (uint64_t id = 0; id < 2000; ++id) {
+                std::vector<float> v(dim);
+                for (std::size_t i = 0; i < dim; ++i) {
+                    state = state * 1664525u + 1013904223u;
+                    v[i] = static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+                }
+                flat.add(id, make_embedding(v));
+                hnsw.add(id, make_embedding(v));
+            }
+            for (uint64_t id = 0; id < 2000; id += 7) {
+                MDBXC_TEST_ASSERT(flat.erase(id));
+                MDBXC_TEST_ASSERT(hnsw.erase(id));
+            }
+            MDBXC_TEST_ASSERT(!hnsw.erase(0));
+            MDBXC_TEST_ASSERT(hnsw.size() == flat.size());
+            MDBXC_TEST_ASSERT(hnsw.deleted_count() == 286);
+
+            std::size_t hits = 0;
+            for (int q = 0; q < 20; ++q) {
+                std::vector<float> v(dim);
+                for (std::size_t i = 0; i < dim; ++i) {
+                    state = state * 1664525u + 1013904223u;
+                    v[i] = static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+                }
+                const std::vector<mdbxc::VectorMatch> exact = flat.search(make_embedding(v), 10);
+                const std::vector<mdbxc::VectorMatch> approx = hnsw.search(make_embedding(v), 10);
+                MDBXC_TEST_ASSERT(approx.size() == 10);
+                for (std::size_t i = 0; i < approx.size(); ++i) {
+                    MDBXC_TEST_ASSERT(approx[i].id % 7 != 0);
+                    if (i > 0) MDBXC_TEST_ASSERT(approx[i - 1].score >= approx[i].score);
+                    for (std::size_t j = 0; j < exact.size(); ++j) {
+                        if (exact[j].id == approx[i].id) ++hits;
+                    }
+                }
+            }
+            MDBXC_TEST_ASSERT(hits >= 190); // recall@10 >= 0.95
+
+            // Re-adding an id replaces its vector.
+            std::vector<float> far(dim, 10.0f);
+            hnsw.add(1, make_embedding(far));
+            MDBXC_TEST_ASSERT(hnsw.search(make_embedding(far), 1)[0].id == 1);
+            MDBXC_TEST_ASSERT(hnsw.size() == flat.size());
+        }
+
+        mdbxc::HnswVectorIndex small;
+        small.add(5, make_embedding({1.0f, 0.0f}));
+        MDBXC_TEST_ASSERT(small.erase(5));
+        MDBXC_TEST_ASSERT(small.size() == 0 && small.deleted_count() == 0 && small.dim() == 0);
+        MDBXC_TEST_ASSERT(small.search(make_embedding({1.0f, 0.0f, 0.0f}), 3).empty());
+
+        mdbxc::HnswParams bad;
+        bad.M = 1;
+        bool threw = false;
+        try {
+            mdbxc::HnswVectorIndex invalid(mdbxc::VectorMetric::L2, bad);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 8f. IVF index training, probing and restore ---
+    {
+        mdbxc::IvfParams params;
+        params.nlist = 4;
+        params.nprobe = 1;
+        mdbxc::IvfVectorIndex ivf(mdbxc::VectorMetric::L2, params);
+        mdbxc::FlatVectorIndex flat(mdbxc::VectorMetric::L2);
+        const float centers[4][2] = {{0.0f, 0.0f}, {10.0f, 0.0f}, {0.0f, 10.0f}, {10.0f, 10.0f}};
+        for (uint64_t id = 0; id < 400; ++id) {
+            const float* c = centers[id % 4];
+            const float dx = static_cast<float>((id * 7) % 10) * 0.1f - 0.5f;
+            const float dy = static_cast<float>((id * 3) % 10) * 0.1f - 0.5f;
+            ivf.add(id, make_embedding({c[0] + dx, c[1] + dy}));
+            flat.add(id, make_embedding({c[0] + dx, c[1] + dy}));
+        }
+        // Vectors repeat every 20 ids, so compare scores rather than tied ids.
+        // Untrained: one list, exact search.
+        MDBXC_TEST_ASSERT(!ivf.trained() && ivf.list_count() == 1);
+        const mdbxc::Embedding query = make_embedding({9.8f, 0.1f});
+        MDBXC_TEST_ASSERT(ivf.search(query, 1)[0].score == flat.search(query, 1)[0].score);
+
+        ivf.train();
+        MDBXC_TEST_ASSERT(ivf.trained() && ivf.list_count() == 4);
+        MDBXC_TEST_ASSERT(ivf.size() == 400);
+        const uint32_t list = ivf.assign(query);
+        const std::vector<mdbxc::VectorMatch> probed = ivf.search(query, 5);
+        const std::vector<mdbxc::VectorMatch> exact = flat.search(query, 5);
+        MDBXC_TEST_ASSERT(probed.size() == 5);
+        for (std::size_t i = 0; i < 5; ++i) {
+            MDBXC_TEST_ASSERT(probed[i].score == exact[i].score);
+            MDBXC_TEST_ASSERT(ivf.list_of(probed[i].id).second == list);
+        }
+
+        MDBXC_TEST_ASSERT(ivf.erase(exact[0].id));
+        MDBXC_TEST_ASSERT(!ivf.erase(exact[0].id));
+        MDBXC_TEST_ASSERT(!ivf.list_of(exact[0].id).first);
+        MDBXC_TEST_ASSERT(ivf.search(query, 1)[0].score == exact[1].score);
+        MDBXC_TEST_ASSERT(ivf.assignments().size() == 399);
+
+        // Centroids and assignments restore an equivalent index.
+        mdbxc::IvfVectorIndex restored(mdbxc::VectorMetric::L2, params);
+        restored.set_centroids(ivf.centroids());
+        const std::vector<std::pair<uint32_t, uint64_t>> assignments = ivf.assignments();
+        for (std::size_t i = 0; i < assignments.size(); ++i) {
+            const uint64_t id = assignments[i].second;
+            const float* c = centers[id % 4];
+            const float dx = static_cast<float>((id * 7) % 10) * 0.1f - 0.5f;
+            const float dy = static_cast<float>((id * 3) % 10) * 0.1f - 0.5f;
+            restored.add(id, make_embedding({c[0] + dx, c[1] + dy}), assignments[i].first);
+        }
+        MDBXC_TEST_ASSERT(restored.search(query, 1)[0].score == exact[1].score);
+
+        bool threw = false;
+        try {
+            restored.set_centroids(ivf.centroids());
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 8g. FlatVectorIndex snapshot round trip and bulk erase ---
+    {
+        const mdbxc::VectorQuantization modes[4] = {
+            mdbxc::VectorQuantization::NONE,
+            mdbxc::VectorQuantization::INT8,
+            mdbxc::VectorQuantization::FP16,
+            mdbxc::VectorQuantization::BINARY};
+        for (std::size_t m = 0; m < 4; ++m) {
+            mdbxc::FlatVectorIndex index(mdbxc::VectorMetric::COSINE, modes[m]);
+            for (uint64_t id = 1; id <= 50; ++id) {
+                const float x = static_cast<float>(id);
+                index.add(id, make_embedding({x, 1.0f, -0.5f * x}));
+            }
+            MDBXC_TEST_ASSERT(index.erase_many({3, 7, 99, 50, 7}) == 3);
+            MDBXC_TEST_ASSERT(index.size() == 47);
+
+            std::vector<unsigned char> bytes;
+            index.save([&bytes](const void* data, std::size_t size) {
+                const unsigned char* p = static_cast<const unsigned char*>(data);
+                bytes.insert(bytes.end(), p, p + size);
+            });
+            std::size_t offset = 0;
+            const auto source = [&bytes, &offset](void* data, std::size_t size) {
+                if (bytes.size() - offset < size) {
+                    throw std::runtime_error("short snapshot");
+                }
+                std::memcpy(data, bytes.data() + offset, size);
+                offset += size;
+            };
+
+            mdbxc::FlatVectorIndex restored(mdbxc::VectorMetric::COSINE, modes[m]);
+            restored.load(source);
+            MDBXC_TEST_ASSERT(offset == bytes.size());
+            MDBXC_TEST_ASSERT(restored.size() == 47 && restored.dim() == 3);
+            const mdbxc::Embedding query = make_embedding({4.0f, 1.0f, -2.0f});
+            const std::vector<mdbxc::VectorMatch> before = index.search(query, 5);
+            const std::vector<mdbxc::VectorMatch> after = restored.search(query, 5);
+            MDBXC_TEST_ASSERT(before.size() == after.size());
+            for (std::size_t i = 0; i < before.size(); ++i) {
+                MDBXC_TEST_ASSERT(before[i].id == after[i].id);
+                MDBXC_TEST_ASSERT(before[i].score == after[i].score);
+            }
+
+            offset = 0;
+            mdbxc::FlatVectorIndex other(mdbxc::VectorMetric::L2, modes[m]);
+            bool threw = false;
+            try {
+                other.load(source);
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            MDBXC_TEST_ASSERT(threw && other.size() == 0);
+        }
+    }
+
+    // --- 8h. FlatVectorIndex id map: erase, re-add and erase_many ---
+    {
+        mdbxc::FlatVectorIndex index(mdbxc::VectorMetric::L2);
+        for (uint64_t id = 0; id < 1000; ++id) {
+            index.add(id, make_embedding({static_cast<float>(id), 0.0f}));
+        }
+        std::vector<uint64_t> doomed;
+        for (uint64_t id = 0; id < 1000; id += 3) {
+            doomed.push_back(id);
+        }
+        MDBXC_TEST_ASSERT(index.erase_many(doomed) == 334);
+        MDBXC_TEST_ASSERT(index.erase(1) && !index.erase(1) && !index.erase(3));
+        MDBXC_TEST_ASSERT(index.size() == 665);
+        // Re-adding moves the id instead of duplicating it.
+        index.add(500, make_embedding({-7.0f, 0.0f}));
+        MDBXC_TEST_ASSERT(index.size() == 665);
+        const std::vector<mdbxc::VectorMatch> all =
+            index.search(make_embedding({-7.0f, 0.0f}), 1000);
+        MDBXC_TEST_ASSERT(all.size() == 665);
+        MDBXC_TEST_ASSERT(all[0].id == 500 && all[0].score == 0.0f);
+        MDBXC_TEST_ASSERT(all[1].id == 2);
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            MDBXC_TEST_ASSERT(all[i].id % 3 != 0 && all[i].id != 1);
+        }
+        MDBXC_TEST_ASSERT(index.erase_many(std::vector<uint64_t>(all.size(), 500)) == 1);
+        for (std::size_t i = 1; i < all.size(); ++i) {
+            MDBXC_TEST_ASSERT(index.erase(all[i].id));
+        }
+        MDBXC_TEST_ASSERT(index.size() == 0 && index.dim() == 0);
+    }
+
+    // --- 8i. Filtered search inside flat scan, HNSW traversal and IVF lists ---
+    {
+        mdbxc::FlatVectorIndex flat(mdbxc::VectorMetric::L2);
+        mdbxc::HnswVectorIndex hnsw(mdbxc::VectorMetric::L2);
+        mdbxc::IvfParams ivf_params;
+        ivf_params.nlist = 8;
+        ivf_params.nprobe = 1;
+        mdbxc::IvfVectorIndex ivf(mdbxc::VectorMetric::L2, ivf_params);
+        for (uint64_t id = 0; id < 2000; ++id) {
+            const mdbxc::Embedding e = make_embedding({
+                static_cast<float>(id % 50), static_cast<float>(id / 50), static_cast<float>(id % 7)});
+            flat.add(id, e);
+            hnsw.add(id, e);
+            ivf.add(id, e);
+        }
+        ivf.train();
+        const mdbxc::Embedding query = make_embedding({10.0f, 10.0f, 3.0f});
+
+        mdbxc::VectorFilter empty;
+        MDBXC_TEST_ASSERT(flat.search(query, 5, empty).empty());
+        MDBXC_TEST_ASSERT(hnsw.search(query, 5, empty).empty());
+        MDBXC_TEST_ASSERT(ivf.search(query, 5, empty).empty());
+
+        // Broad filter (graph traversal) and selective filter (exact fallback).
+        const uint64_t moduli[2] = {4, 97};
+        for (std::size_t m = 0; m < 2; ++m) {
+            mdbxc::VectorFilter filter;
+            for (uint64_t id = 0; id < 2000; ++id) {
+                if (id % moduli[m] == 1) {
+                    filter.allow(id);
+                }
+            }
+            filter.allow(5000); // absent ids are ignored
+            std::vector<mdbxc::VectorMatch> exact;
+            const std::vector<mdbxc::VectorMatch> all = flat.search(query, 2000);
+            for (std::size_t i = 0; i < all.size() && exact.size() < 10; ++i) {
+                if (all[i].id % moduli[m] == 1) {
+                    exact.push_back(all[i]);
+                }
+            }
+            const std::vector<mdbxc::VectorMatch> f = flat.search(query, 10, filter, 4);
+            const std::vector<mdbxc::VectorMatch> h = hnsw.search(query, 10, filter);
+            const std::vector<mdbxc::VectorMatch> v = ivf.search(query, 10, filter);
+            MDBXC_TEST_ASSERT(f.size() == 10 && h.size() == 10 && v.size() == 10);
+            for (std::size_t i = 0; i < 10; ++i) {
+                MDBXC_TEST_ASSERT(f[i].score == exact[i].score);
+                MDBXC_TEST_ASSERT(filter.allows(h[i].id) && filter.allows(v[i].id));
+            }
+            MDBXC_TEST_ASSERT(h[0].score == exact[0].score);
+        }
+
+        // Far ids outside the probed list are still returned.
+        mdbxc::VectorFilter corner;
+        corner.allow(1999);
+        corner.allow(1998);
+        const std::vector<mdbxc::VectorMatch> far = ivf.search(make_embedding({0.0f, 0.0f, 0.0f}), 5, corner);
+        MDBXC_TEST_ASSERT(far.size() == 2 && far[0].id == 1998);
+        corner.deny(1998);
+        MDBXC_TEST_ASSERT(corner.count() == 1 && !corner.allows(1998));
+        MDBXC_TEST_ASSERT(hnsw.search(query, 3, corner).size() == 1);
+    }
+
+    // --- 8j. FlatVectorIndex mapped from a snapshot file ---
+    {
+        const mdbxc::VectorQuantization modes[3] = {
+            mdbxc::VectorQuantization::NONE,
+            mdbxc::VectorQuantization::INT8,
+            mdbxc::VectorQuantization::FP16};
+        const std::string path = "vector_store_test_8j.snapshot";
+        for (std::size_t m = 0; m < 3; ++m) {
+            mdbxc::FlatVectorIndex index(mdbxc::VectorMetric::L2, modes[m]);
+            for (uint64_t id = 1; id <= 40; ++id) {
+                const float x = static_cast<float>(id);
+                index.add(id, make_embedding({x, 0.5f * x, 1.0f}));
+            }
+            {
+                std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+                index.save([&out](const void* data, std::size_t size) {
+                    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+                });
+            }
+
+            mdbxc::FlatVectorIndex mapped(mdbxc::VectorMetric::L2, modes[m]);
+            mapped.map(path);
+            MDBXC_TEST_ASSERT(mapped.size() == 40 && mapped.dim() == 3);
+            MDBXC_TEST_ASSERT(mapped.mapped_bytes() > 0);
+            const mdbxc::Embedding query = make_embedding({10.0f, 5.0f, 1.0f});
+            MDBXC_TEST_ASSERT(mapped.search(query, 1)[0].id == 10);
+
+            // Heap rows are appended after the mapped block; erase moves them in.
+            mapped.add(100, make_embedding({10.2f, 5.1f, 1.0f}));
+            MDBXC_TEST_ASSERT(mapped.erase(10));
+            MDBXC_TEST_ASSERT(mapped.erase(3));
+            MDBXC_TEST_ASSERT(mapped.erase_many({1, 2, 40}) == 3);
+            MDBXC_TEST_ASSERT(mapped.size() == 36);
+            MDBXC_TEST_ASSERT(mapped.search(query, 1)[0].id == 100);
+            MDBXC_TEST_ASSERT(mapped.search(make_embedding({20.0f, 10.0f, 1.0f}), 1)[0].id == 20);
+
+            const mdbxc::FlatVectorIndex copy = mapped;
+            mapped.clear();
+            MDBXC_TEST_ASSERT(copy.size() == 36 && copy.mapped_bytes() > 0);
+            MDBXC_TEST_ASSERT(copy.search(query, 1)[0].id == 100);
+
+            mdbxc::FlatVectorIndex other(mdbxc::VectorMetric::DOT, modes[m]);
+            bool threw = false;
+            try {
+                other.map(path);
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            MDBXC_TEST_ASSERT(threw && other.size() == 0);
+        }
+        std::remove(path.c_str());
+    }
+
+    // --- 8k. Text tokenizer and BM25 weights ---
+    {
+        std::map<std::string, uint32_t> terms;
+        MDBXC_TEST_ASSERT(mdbxc::detail::tokenize_text("MDBX, mdbx-Containers: 2 B+trees!", terms) == 6);
+        MDBXC_TEST_ASSERT(terms.size() == 5);
+        MDBXC_TEST_ASSERT(terms["mdbx"] == 2);
+        MDBXC_TEST_ASSERT(terms["containers"] == 1 && terms["2"] == 1);
+        MDBXC_TEST_ASSERT(terms["b"] == 1 && terms["trees"] == 1);
+
+        // Rarer terms, more occurrences and shorter records weigh more.
+        const float base = mdbxc::detail::bm25_weight(100, 10, 1, 10, 10.0);
+        MDBXC_TEST_ASSERT(mdbxc::detail::bm25_weight(100, 2, 1, 10, 10.0) > base);
+        MDBXC_TEST_ASSERT(mdbxc::detail::bm25_weight(100, 10, 3, 10, 10.0) > base);
+        MDBXC_TEST_ASSERT(mdbxc::detail::bm25_weight(100, 10, 1, 5, 10.0) > base);
+        MDBXC_TEST_ASSERT(base > 0.0f);
+    }
+
+    // --- 8l. Product quantization: training, ADC scan and restore ---
+    {
+        const mdbxc::detail::DistanceKernels& simd = mdbxc::detail::distance_kernels();
+        const mdbxc::detail::DistanceKernels& scalar = mdbxc::detail::scalar_distance_kernels();
+        const std::size_t subs[] = {1, 3, 8, 9, 16, 33, 64};
+        for (std::size_t m : subs) {
+            std::vector<float> table(m * 256);
+            std::vector<std::uint8_t> codes(m);
+            for (std::size_t i = 0; i < table.size(); ++i) {
+                table[i] = static_cast<float>((i * 7) % 31) * 0.125f - 2.0f;
+            }
+            for (std::size_t j = 0; j < m; ++j) {
+                codes[j] = static_cast<std::uint8_t>((j * 97 + 13) % 256);
+            }
+            MDBXC_TEST_ASSERT(std::fabs(simd.pq_adc(table.data(), codes.data(), m) -
+                                        scalar.pq_adc(table.data(), codes.data(), m)) <= 1e-4f * m);
+        }
+
+        mdbxc::PqParams pq;
+        pq.subspaces = 4;
+        mdbxc::FlatVectorIndex exact(mdbxc::VectorMetric::L2);
+        mdbxc::FlatVectorIndex index(mdbxc::VectorMetric::L2, mdbxc::VectorQuantization::PQ, pq);
+        std::vector<std::pair<uint64_t, mdbxc::Embedding>> all;
+        std::uint32_t seed = 7;
+        for (uint64_t id = 0; id < 2000; ++id) {
+            std::vector<float> values(16);
+            for (std::size_t d = 0; d < values.size(); ++d) {
+                seed = seed * 1664525u + 1013904223u;
+                values[d] = static_cast<float>(seed >> 8) / 16777216.0f + static_cast<float>(id % 5);
+            }
+            const mdbxc::Embedding e = make_embedding(values);
+            exact.add(id, e);
+            index.add(id, e);
+            all.push_back(std::make_pair(id, e));
+        }
+        const mdbxc::Embedding query = all[123].second;
+        // Untrained: full-precision rows, exact scores.
+        MDBXC_TEST_ASSERT(!index.trained());
+        MDBXC_TEST_ASSERT(index.search(query, 1)[0].id == 123);
+
+        index.train(2);
+        MDBXC_TEST_ASSERT(index.trained() && index.size() == 2000);
+        MDBXC_TEST_ASSERT(index.codebooks().size() == 256 * 16);
+        MDBXC_TEST_ASSERT(index.memory_bytes() * 4 < exact.memory_bytes());
+        const std::vector<mdbxc::VectorMatch> ref = exact.search(query, 10);
+        const std::vector<mdbxc::VectorMatch> approx = index.search(query, 10);
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < approx.size(); ++i) {
+            for (std::size_t j = 0; j < ref.size(); ++j) {
+                hits += approx[i].id == ref[j].id ? 1 : 0;
+            }
+        }
+        MDBXC_TEST_ASSERT(hits >= 7);
+        MDBXC_TEST_ASSERT(index.rescore(query, all, 1)[0].id == 123);
+
+        // Codes of new rows use the trained codebooks; erase keeps them aligned.
+        index.add(5000, query);
+        MDBXC_TEST_ASSERT(index.erase(123));
+        MDBXC_TEST_ASSERT(index.search(query, 1)[0].id == 5000);
+
+        std::vector<unsigned char> bytes;
+        index.save([&bytes](const void* data, std::size_t size) {
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            bytes.insert(bytes.end(), p, p + size);
+        });
+        std::size_t offset = 0;
+        mdbxc::FlatVectorIndex restored(mdbxc::VectorMetric::L2, mdbxc::VectorQuantization::PQ, pq);
+        restored.load([&bytes, &offset](void* data, std::size_t size) {
+            if (bytes.size() - offset < size) {
+                throw std::runtime_error("short snapshot");
+            }
+            std::memcpy(data, bytes.data() + offset, size);
+            offset += size;
+        });
+        MDBXC_TEST_ASSERT(offset == bytes.size() && restored.trained());
+        const std::vector<mdbxc::VectorMatch> before = index.search(query, 5);
+        const std::vector<mdbxc::VectorMatch> after = restored.search(query, 5);
+        for (std::size_t i = 0; i < before.size(); ++i) {
+            MDBXC_TEST_ASSERT(before[i].id == after[i].id && before[i].score == after[i].score);
+        }
+
+        const std::string path = "vector_store_test_8l.snapshot";
+        {
+            std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()),
+                      static_cast<std::streamsize>(bytes.size()));
+        }
+        mdbxc::FlatVectorIndex mapped(mdbxc::VectorMetric::L2, mdbxc::VectorQuantization::PQ, pq);
+        mapped.map(path);
+        MDBXC_TEST_ASSERT(mapped.mapped_bytes() == 2000 * 4);
+        MDBXC_TEST_ASSERT(mapped.erase(5000) && mapped.search(query, 1)[0].id != 5000);
+        std::remove(path.c_str());
+
+        // Restored codebooks encode like the trained index.
+        mdbxc::FlatVectorIndex recoded(mdbxc::VectorMetric::L2, mdbxc::VectorQuantization::PQ, pq);
+        recoded.set_codebooks(index.codebooks());
+        MDBXC_TEST_ASSERT(recoded.trained() && recoded.dim() == 16);
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            if (all[i].first != 123) {
+                recoded.add(all[i].first, all[i].second);
+            }
+        }
+        recoded.add(5000, query);
+        MDBXC_TEST_ASSERT(recoded.search(query, 5)[0].score == before[0].score);
+
+        bool threw = false;
+        try {
+            exact.train();
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+        threw = false;
+        try {
+            pq.subspaces = 3;
+            mdbxc::FlatVectorIndex odd(mdbxc::VectorMetric::L2, mdbxc::VectorQuantization::PQ, pq);
+            odd.add(1, query);
+            odd.train();
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 8m. Binary sign codes scored by Hamming distance ---
+    {
+        const mdbxc::detail::DistanceKernels& simd = mdbxc::detail::distance_kernels();
+        const mdbxc::detail::DistanceKernels& scalar = mdbxc::detail::scalar_distance_kernels();
+        std::vector<std::uint64_t> a(9), b(9);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            a[i] = 0x9e3779b97f4a7c15ULL * (i + 1);
+            b[i] = 0xc2b2ae3d27d4eb4fULL * (i + 3);
+        }
+        MDBXC_TEST_ASSERT(scalar.hamming(a.data(), a.data(), a.size()) == 0);
+        for (std::size_t words = 0; words <= a.size(); ++words) {
+            MDBXC_TEST_ASSERT(simd.hamming(a.data(), b.data(), words) ==
+                              scalar.hamming(a.data(), b.data(), words));
+        }
+        const std::uint64_t one = 1, all = ~std::uint64_t(0);
+        MDBXC_TEST_ASSERT(scalar.hamming(&one, &all, 1) == 63);
+
+        mdbxc::FlatVectorIndex exact(mdbxc::VectorMetric::COSINE);
+        mdbxc::FlatVectorIndex binary(mdbxc::VectorMetric::COSINE, mdbxc::VectorQuantization::BINARY);
+        std::vector<std::pair<uint64_t, mdbxc::Embedding>> all_rows;
+        std::uint32_t seed = 11;
+        for (uint64_t id = 0; id < 500; ++id) {
+            std::vector<float> values(256);
+            for (std::size_t d = 0; d < values.size(); ++d) {
+                seed = seed * 1664525u + 1013904223u;
+                values[d] = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+            }
+            exact.add(id, make_embedding(values));
+            binary.add(id, make_embedding(values));
+            all_rows.push_back(std::make_pair(id, make_embedding(values)));
+        }
+        MDBXC_TEST_ASSERT(binary.memory_bytes() * 32 == exact.memory_bytes());
+
+        // A near duplicate differs in a few signs, so it is the nearest code.
+        std::vector<float> near = all_rows[321].second.values;
+        for (std::size_t d = 0; d < 8; ++d) {
+            near[d * 30] = -near[d * 30];
+        }
+        const mdbxc::Embedding query = make_embedding(near);
+        const std::vector<mdbxc::VectorMatch> coarse = binary.search(query, 10);
+        MDBXC_TEST_ASSERT(coarse[0].id == 321 && coarse[0].score >= -8.0f);
+        MDBXC_TEST_ASSERT(coarse[1].score < -64.0f);
+
+        // The coarse candidates re-ranked in fp32 give the exact top match.
+        std::vector<std::pair<uint64_t, mdbxc::Embedding>> candidates;
+        for (std::size_t i = 0; i < coarse.size(); ++i) {
+            candidates.push_back(all_rows[static_cast<std::size_t>(coarse[i].id)]);
+        }
+        const std::vector<mdbxc::VectorMatch> reranked = binary.rescore(query, candidates, 1);
+        const std::vector<mdbxc::VectorMatch> ref = exact.search(query, 1);
+        MDBXC_TEST_ASSERT(reranked[0].id == ref[0].id);
+        MDBXC_TEST_ASSERT(std::fabs(reranked[0].score - ref[0].score) < 1e-5f);
+
+        const std::string path = "vector_store_test_8m.snapshot";
+        {
+            std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+            binary.save([&out](const void* data, std::size_t size) {
+                out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            });
+        }
+        mdbxc::FlatVectorIndex mapped(mdbxc::VectorMetric::COSINE, mdbxc::VectorQuantization::BINARY);
+        mapped.map(path);
+        MDBXC_TEST_ASSERT(mapped.mapped_bytes() == 500 * 32);
+        MDBXC_TEST_ASSERT(mapped.erase(0) && mapped.erase_many({1, 2, 3}) == 3);
+        MDBXC_TEST_ASSERT(mapped.search(query, 1)[0].id == 321);
+        std::remove(path.c_str());
+    }
+
+    // --- 8n. Truncated-prefix first pass with full-dimension re-rank ---
+    {
+        // Leading components carry most of the energy, as in Matryoshka models.
+        std::vector<mdbxc::Embedding> rows;
+        std::uint32_t seed = 29;
+        for (std::size_t i = 0; i < 600; ++i) {
+            std::vector<float> values(256);
+            for (std::size_t d = 0; d < values.size(); ++d) {
+                seed = seed * 1664525u + 1013904223u;
+                const float weight = d < 32 ? 1.0f : 0.25f;
+                values[d] = weight * (static_cast<float>(seed >> 8) / 8388608.0f - 1.0f);
+            }
+            rows.push_back(make_embedding(values));
+        }
+        mdbxc::PrefixParams prefix;
+        prefix.dim = 32;
+        prefix.rerank_factor = 8;
+        const mdbxc::VectorMetric metrics[2] = {mdbxc::VectorMetric::COSINE, mdbxc::VectorMetric::L2};
+        for (int m = 0; m < 2; ++m) {
+            mdbxc::FlatVectorIndex exact(metrics[m]);
+            mdbxc::FlatVectorIndex index(metrics[m], mdbxc::VectorQuantization::NONE,
+                                         mdbxc::PqParams(), prefix);
+            for (uint64_t id = 0; id < rows.size(); ++id) {
+                exact.add(id, rows[static_cast<std::size_t>(id)]);
+                index.add(id, rows[static_cast<std::size_t>(id)]);
+            }
+            MDBXC_TEST_ASSERT(index.memory_bytes() == exact.memory_bytes() + rows.size() * 32 * sizeof(float));
+
+            // Re-ranked scores are exact; the prefix pass keeps the true neighbours.
+            std::size_t hits = 0;
+            for (std::size_t q = 0; q < 20; ++q) {
+                std::vector<float> near = rows[q * 29].values;
+                near[40] += 0.3f;
+                const mdbxc::Embedding query = make_embedding(near);
+                const std::vector<mdbxc::VectorMatch> ref = exact.search(query, 5);
+                const std::vector<mdbxc::VectorMatch> got = index.search(query, 5, 2);
+                MDBXC_TEST_ASSERT(got.size() == 5);
+                MDBXC_TEST_ASSERT(got[0].id == ref[0].id);
+                MDBXC_TEST_ASSERT(std::fabs(got[0].score - ref[0].score) < 1e-4f);
+                for (std::size_t i = 0; i < got.size(); ++i) {
+                    for (std::size_t j = 0; j < ref.size(); ++j) {
+                        if (got[i].id == ref[j].id) ++hits;
+                    }
+                }
+            }
+            MDBXC_TEST_ASSERT(hits >= 90);
+
+            const mdbxc::Embedding query = rows[123];
+            MDBXC_TEST_ASSERT(index.search_batch({query}, 1)[0][0].id == 123);
+            MDBXC_TEST_ASSERT(index.erase(123) && index.erase_many({0, 1, 2}) == 3);
+            MDBXC_TEST_ASSERT(index.search(query, 1)[0].id != 123);
+            index.add(123, rows[123]);
+            MDBXC_TEST_ASSERT(index.search(query, 1)[0].id == 123);
+            mdbxc::VectorFilter filter;
+            filter.allow(5);
+            filter.allow(123);
+            const std::vector<mdbxc::VectorMatch> filtered = index.search(query, 3, filter);
+            MDBXC_TEST_ASSERT(filtered.size() == 2 && filtered[0].id == 123 && filtered[1].id == 5);
+
+            // Snapshots carry full rows only; the prefix block is rebuilt on load.
+            std::vector<unsigned char> bytes;
+            index.save([&bytes](const void* data, std::size_t size) {
+                const unsigned char* p = static_cast<const unsigned char*>(data);
+                bytes.insert(bytes.end(), p, p + size);
+            });
+            mdbxc::FlatVectorIndex restored(metrics[m], mdbxc::VectorQuantization::NONE,
+                                            mdbxc::PqParams(), prefix);
+            std::size_t offset = 0;
+            restored.load([&bytes, &offset](void* data, std::size_t size) {
+                std::memcpy(data, &bytes[offset], size);
+                offset += size;
+            });
+            MDBXC_TEST_ASSERT(restored.memory_bytes() == index.memory_bytes());
+            MDBXC_TEST_ASSERT(restored.search(query, 1)[0].id == 123);
+        }
+
+        // Quantized rows re-rank at full dimension from their codes.
+        mdbxc::FlatVectorIndex half(mdbxc::VectorMetric::COSINE, mdbxc::VectorQuantization::FP16,
+                                    mdbxc::PqParams(), prefix);
+        for (uint64_t id = 0; id < rows.size(); ++id) {
+            half.add(id, rows[static_cast<std::size_t>(id)]);
+        }
+        MDBXC_TEST_ASSERT(half.search(rows[77], 1)[0].id == 77);
+
+        // Prefixes at least as long as the vectors scan whole rows.
+        prefix.dim = 256;
+        mdbxc::FlatVectorIndex whole(mdbxc::VectorMetric::COSINE, mdbxc::VectorQuantization::NONE,
+                                     mdbxc::PqParams(), prefix);
+        whole.add(1, rows[1]);
+        MDBXC_TEST_ASSERT(whole.memory_bytes() == 256 * sizeof(float));
+
+        bool threw = false;
+        try {
+            mdbxc::FlatVectorIndex binary(mdbxc::VectorMetric::COSINE, mdbxc::VectorQuantization::BINARY,
+                                          mdbxc::PqParams(), prefix);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
     // --- 9. Failed add does not persist ---
     {
         mdbxc::Config cfg;
@@ -282,9 +1056,66 @@ int main() {
             threw = true;
         }
         MDBXC_TEST_ASSERT(threw);
+
+        // Odd dimensions are padded to a multiple of 8 bytes; the unpadded
+        // length of older records is still accepted.
+        mdbxc::Embedding odd = make_embedding({1.0f, 2.0f, 3.0f});
+        std::vector<uint8_t> padded = odd.to_bytes();
+        MDBXC_TEST_ASSERT(padded.size() == 24);
+        MDBXC_TEST_ASSERT(padded[20] == 0 && padded[23] == 0);
+        MDBXC_TEST_ASSERT(mdbxc::Embedding::from_bytes(padded.data(), padded.size()).values == odd.values);
+        MDBXC_TEST_ASSERT(mdbxc::Embedding::from_bytes(padded.data(), 20).values == odd.values);
+        threw = false;
+        padded[21] = 1;
+        try {
+            mdbxc::Embedding::from_bytes(padded.data(), padded.size());
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+        padded[21] = 0;
+
+        // Aligned bytes are viewed in place, unaligned ones through scratch.
+        std::vector<float> aligned(6);
+        std::memcpy(aligned.data(), padded.data(), padded.size());
+        std::vector<float> scratch;
+        mdbxc::EmbeddingView view = mdbxc::Embedding::view(aligned.data(), padded.size(), scratch);
+        MDBXC_TEST_ASSERT(view.dim == 3);
+        MDBXC_TEST_ASSERT(view.values == aligned.data() + 2);
+        MDBXC_TEST_ASSERT(scratch.empty());
+        std::vector<uint8_t> shifted(padded.size() + 1);
+        std::memcpy(shifted.data() + 1, padded.data(), padded.size());
+        view = mdbxc::Embedding::view(shifted.data() + 1, padded.size(), scratch);
+        MDBXC_TEST_ASSERT(view.values == scratch.data());
+        MDBXC_TEST_ASSERT(scratch == odd.values);
+
+        // View overloads of the flat index match the owning ones.
+        mdbxc::FlatVectorIndex owned(mdbxc::VectorMetric::COSINE);
+        mdbxc::FlatVectorIndex viewed(mdbxc::VectorMetric::COSINE);
+        mdbxc::Embedding other = make_embedding({0.0f, 1.0f, 0.5f});
+        owned.add(1, odd);
+        owned.add(2, other);
+        viewed.add(1, odd.view());
+        viewed.add(2, other.view());
+        const mdbxc::Embedding query = make_embedding({0.2f, 1.0f, 0.4f});
+        const std::vector<mdbxc::VectorMatch> a = owned.search(query, 2);
+        const std::vector<mdbxc::VectorMatch> b = viewed.search(query, 2);
+        MDBXC_TEST_ASSERT(a.size() == 2 && b.size() == 2);
+        MDBXC_TEST_ASSERT(a[0].id == b[0].id && a[0].score == b[0].score);
+        std::vector<std::pair<uint64_t, mdbxc::Embedding>> candidates;
+        candidates.push_back(std::make_pair(uint64_t(1), odd));
+        candidates.push_back(std::make_pair(uint64_t(2), other));
+        std::vector<std::pair<uint64_t, mdbxc::EmbeddingView>> views;
+        views.push_back(std::make_pair(uint64_t(1), odd.view()));
+        views.push_back(std::make_pair(uint64_t(2), other.view()));
+        const std::vector<mdbxc::VectorMatch> exact = owned.rescore(query, candidates, 2);
+        const std::vector<mdbxc::VectorMatch> exact_views = owned.rescore(query, views, 2);
+        MDBXC_TEST_ASSERT(exact.size() == 2 && exact_views.size() == 2);
+        MDBXC_TEST_ASSERT(exact[0].id == 2 && exact_views[0].id == 2);
+        MDBXC_TEST_ASSERT(exact[1].score == exact_views[1].score);
     }
 
-    // --- 11. One VectorStore instance serializes concurrent searches ---
+    // --- 11. Concurrent searches run alongside a writer ---
     {
         mdbxc::Config cfg;
         cfg.pathname = "data/vector_store_test_11.mdbx";
@@ -298,44 +1129,788 @@ int main() {
         store.add(make_embedding({0.0f, 1.0f}), "right");
 
         const mdbxc::Embedding query = make_embedding({1.0f, 0.0f});
-        std::exception_ptr error1;
-        std::exception_ptr error2;
-        std::thread first([&store, &query, &error1]() {
+        std::exception_ptr errors[3];
+        auto searcher = [&store, &query](std::exception_ptr& error) {
             try {
                 for (int i = 0; i < 200; ++i) {
                     const std::vector<mdbxc::SearchResult> results =
-                        store.search(query, 2);
-                    if (results.size() != 2u) {
+                        store.search(query, 3);
+                    if (results.size() < 2u || results.size() > 3u ||
+                        results[0].text != "left") {
                         throw std::runtime_error(
-                            "concurrent VectorStore search returned wrong size");
+                            "concurrent VectorStore search returned wrong results");
                     }
                 }
             } catch (...) {
-                error1 = std::current_exception();
+                error = std::current_exception();
             }
-        });
-        std::thread second([&store, &query, &error2]() {
+        };
+        std::thread first(searcher, std::ref(errors[0]));
+        std::thread second(searcher, std::ref(errors[1]));
+        std::thread writer([&store, &errors]() {
             try {
-                for (int i = 0; i < 200; ++i) {
-                    const std::vector<mdbxc::SearchResult> results =
-                        store.search(query, 2);
-                    if (results.size() != 2u) {
-                        throw std::runtime_error(
-                            "concurrent VectorStore search returned wrong size");
-                    }
+                for (int i = 0; i < 50; ++i) {
+                    const uint64_t id = store.add(make_embedding({-1.0f, 0.0f}), "back");
+                    store.erase(id);
                 }
             } catch (...) {
-                error2 = std::current_exception();
+                errors[2] = std::current_exception();
             }
         });
         first.join();
         second.join();
-        if (error1) {
-            std::rethrow_exception(error1);
+        writer.join();
+        for (std::size_t i = 0; i < 3; ++i) {
+            if (errors[i]) {
+                std::rethrow_exception(errors[i]);
+            }
+        }
+        MDBXC_TEST_ASSERT(store.count() == 2u);
+    }
+
+    // --- 12. Quantized store re-ranks with persisted embeddings ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_12.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStore store(cfg, "quantized", mdbxc::VectorMetric::L2,
+                                 mdbxc::VectorQuantization::INT8, 2);
+        store.clear();
+        const uint64_t near_id = store.add(make_embedding({0.30f, 0.70f}), "near");
+        store.add(make_embedding({0.90f, 0.10f}), "far");
+        store.add(make_embedding({-0.5f, 0.50f}), "other");
+
+        const std::vector<mdbxc::SearchResult> results =
+            store.search(make_embedding({0.31f, 0.69f}), 1);
+        MDBXC_TEST_ASSERT(results.size() == 1);
+        MDBXC_TEST_ASSERT(results[0].id == near_id);
+        // Score is the exact fp32 value, not the int8 approximation.
+        MDBXC_TEST_ASSERT(std::fabs(results[0].score + 0.0002f) < 1e-6f);
+
+        bool threw = false;
+        try {
+            mdbxc::VectorStore bad(cfg, "quantized", mdbxc::VectorMetric::L2,
+                                   mdbxc::VectorQuantization::INT8, 0);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 13. HNSW-backed store ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_13.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::HnswParams params;
+        params.M = 8;
+        uint64_t erased_id = 0;
+        {
+            mdbxc::VectorStore store(cfg, "hnsw", mdbxc::VectorMetric::COSINE,
+                                     mdbxc::VectorQuantization::NONE, 4,
+                                     mdbxc::VectorIndexType::HNSW, params);
+            store.clear();
+            const uint64_t a_id = store.add(make_embedding({1.0f, 0.0f}), "A");
+            erased_id = store.add(make_embedding({0.9f, 0.1f}), "B");
+            store.add(make_embedding({0.0f, 1.0f}), "C");
+            MDBXC_TEST_ASSERT(store.erase(erased_id));
+            const std::vector<mdbxc::SearchResult> results =
+                store.search(make_embedding({0.95f, 0.05f}), 2);
+            MDBXC_TEST_ASSERT(results.size() == 2);
+            MDBXC_TEST_ASSERT(results[0].id == a_id);
+            MDBXC_TEST_ASSERT(results[1].text == "C");
         }
-        if (error2) {
-            std::rethrow_exception(error2);
+        {
+            mdbxc::VectorStore store(cfg, "hnsw", mdbxc::VectorMetric::COSINE,
+                                     mdbxc::VectorQuantization::NONE, 4,
+                                     mdbxc::VectorIndexType::HNSW, params);
+            const std::vector<mdbxc::SearchResult> results =
+                store.search(make_embedding({1.0f, 0.0f}), 3);
+            MDBXC_TEST_ASSERT(results.size() == 2);
+            MDBXC_TEST_ASSERT(results[0].text == "A");
         }
+
+        bool threw = false;
+        try {
+            mdbxc::VectorStore bad(cfg, "hnsw", mdbxc::VectorMetric::COSINE,
+                                   mdbxc::VectorQuantization::INT8, 4,
+                                   mdbxc::VectorIndexType::HNSW);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 14. IVF-backed store persists centroids and lists ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_14.mdbx";
+        cfg.max_dbs = 16;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::IvfParams params;
+        params.nlist = 2;
+        params.nprobe = 1;
+        uint64_t late_id = 0;
+        {
+            mdbxc::VectorStore store(cfg, "ivf", mdbxc::VectorMetric::L2,
+                                     mdbxc::VectorQuantization::NONE, 4,
+                                     mdbxc::VectorIndexType::IVF,
+                                     mdbxc::HnswParams(), params);
+            store.clear();
+            store.add(make_embedding({0.0f, 0.0f}), "origin");
+            store.add(make_embedding({0.1f, 0.0f}), "near origin");
+            store.add(make_embedding({5.0f, 5.0f}), "far");
+            store.train_index();
+            late_id = store.add(make_embedding({5.1f, 5.0f}), "near far");
+            const std::vector<mdbxc::SearchResult> results =
+                store.search(make_embedding({5.0f, 5.1f}), 2);
+            MDBXC_TEST_ASSERT(results.size() == 2);
+            MDBXC_TEST_ASSERT(results[0].text == "far");
+            MDBXC_TEST_ASSERT(results[1].id == late_id);
+        }
+        {
+            mdbxc::KeyValueTable<uint32_t, mdbxc::Embedding> centroids(
+                mdbxc::Connection::create(cfg), "vectors_ivf_ivf_centroids");
+            MDBXC_TEST_ASSERT(centroids.count() == 2);
+        }
+        {
+            mdbxc::VectorStore store(cfg, "ivf", mdbxc::VectorMetric::L2,
+                                     mdbxc::VectorQuantization::NONE, 4,
+                                     mdbxc::VectorIndexType::IVF,
+                                     mdbxc::HnswParams(), params);
+            const std::vector<mdbxc::SearchResult> results =
+                store.search(make_embedding({0.0f, 0.1f}), 3);
+            MDBXC_TEST_ASSERT(results.size() == 2);
+            MDBXC_TEST_ASSERT(results[0].text == "origin");
+            MDBXC_TEST_ASSERT(store.erase(late_id));
+            MDBXC_TEST_ASSERT(store.search(make_embedding({5.0f, 5.0f}), 3).size() == 1);
+        }
+
+        mdbxc::VectorStore flat_store(cfg, "ivf_flat");
+        bool threw = false;
+        try {
+            flat_store.train_index();
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 15. Flat index snapshot skips the rebuild and replays changes ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_15.mdbx";
+        cfg.max_dbs = 16;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStoreOptions options;
+        options.metric = mdbxc::VectorMetric::L2;
+        options.index_snapshot = true;
+        uint64_t erased_id = 0;
+        uint64_t late_id = 0;
+        {
+            mdbxc::VectorStore store(cfg, "snap", options);
+            store.clear();
+            store.add(make_embedding({0.0f, 0.0f}), "origin");
+            erased_id = store.add(make_embedding({1.0f, 0.0f}), "one");
+            store.add(make_embedding({5.0f, 5.0f}), "far");
+            store.save_index_snapshot();
+            MDBXC_TEST_ASSERT(store.erase(erased_id));
+            late_id = store.add(make_embedding({1.1f, 0.0f}), "late");
+        }
+        {
+            mdbxc::KeyTable<uint64_t> dirty(mdbxc::Connection::create(cfg), "vectors_snap_dirty");
+            MDBXC_TEST_ASSERT(dirty.count() == 2);
+        }
+        {
+            mdbxc::VectorStore store(cfg, "snap", options);
+            const std::vector<mdbxc::SearchResult> results =
+                store.search(make_embedding({1.0f, 0.0f}), 4);
+            MDBXC_TEST_ASSERT(results.size() == 3);
+            MDBXC_TEST_ASSERT(results[0].id == late_id);
+            MDBXC_TEST_ASSERT(results[1].text == "origin");
+            store.save_index_snapshot();
+        }
+        {
+            // A snapshot of another metric is rejected and the index is rebuilt.
+            mdbxc::VectorStoreOptions cosine = options;
+            cosine.metric = mdbxc::VectorMetric::COSINE;
+            mdbxc::VectorStore store(cfg, "snap", cosine);
+            MDBXC_TEST_ASSERT(store.search(make_embedding({1.0f, 1.0f}), 1)[0].text == "far");
+        }
+
+        mdbxc::VectorStore plain(cfg, "snap_off");
+        bool threw = false;
+        try {
+            plain.save_index_snapshot();
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+
+        mdbxc::VectorStoreOptions hnsw = options;
+        hnsw.index_type = mdbxc::VectorIndexType::HNSW;
+        threw = false;
+        try {
+            mdbxc::VectorStore store(cfg, "snap_hnsw", hnsw);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 16. Filtered store search over metadata ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_16.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStore store(cfg, "filtered");
+        store.clear();
+        for (int i = 0; i < 20; ++i) {
+            store.add(make_embedding({1.0f, static_cast<float>(i) * 0.01f}),
+                      "doc-" + std::to_string(i),
+                      i % 5 == 0 ? "{\"lang\":\"ru\"}" : "{\"lang\":\"en\"}");
+        }
+        const mdbxc::VectorFilter ru = store.make_filter(
+            [](uint64_t, const std::string& metadata) {
+                return metadata.find("\"ru\"") != std::string::npos;
+            });
+        MDBXC_TEST_ASSERT(ru.count() == 4);
+        const std::vector<mdbxc::SearchResult> results =
+            store.search(make_embedding({1.0f, 0.0f}), 10, ru);
+        MDBXC_TEST_ASSERT(results.size() == 4);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            MDBXC_TEST_ASSERT(results[i].metadata_json == "{\"lang\":\"ru\"}");
+        }
+    }
+
+    // --- 17. Batch add writes one id run ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_17.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStore store(cfg, "batch");
+        store.clear();
+        const uint64_t single = store.add(make_embedding({0.0f, 1.0f}), "single");
+        MDBXC_TEST_ASSERT(store.add_batch(std::vector<mdbxc::VectorRecord>()).first == 0);
+
+        std::vector<mdbxc::VectorRecord> records(3);
+        records[0].embedding = make_embedding({1.0f, 0.0f});
+        records[0].text = "a";
+        records[0].metadata_json = "{\"n\":0}";
+        records[1].embedding = make_embedding({0.8f, 0.2f});
+        records[1].text = "b";
+        records[2].embedding = make_embedding({-1.0f, 0.0f});
+        records[2].text = "c";
+        const std::pair<uint64_t, uint64_t> ids = store.add_batch(records);
+        MDBXC_TEST_ASSERT(ids.first > single);
+        MDBXC_TEST_ASSERT(ids.second == ids.first + 3);
+        MDBXC_TEST_ASSERT(store.count() == 4);
+
+        const std::vector<mdbxc::SearchResult> results =
+            store.search(make_embedding({1.0f, 0.0f}), 2);
+        MDBXC_TEST_ASSERT(results.size() == 2);
+        MDBXC_TEST_ASSERT(results[0].id == ids.first);
+        MDBXC_TEST_ASSERT(results[0].metadata_json == "{\"n\":0}");
+        MDBXC_TEST_ASSERT(results[1].text == "b");
+        MDBXC_TEST_ASSERT(results[1].metadata_json == "{}");
+
+        records[1].embedding = make_embedding({1.0f, 0.0f, 0.0f});
+        bool threw = false;
+        try {
+            store.add_batch(records);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+        MDBXC_TEST_ASSERT(store.count() == 4);
+
+        store.rebuild_index();
+        MDBXC_TEST_ASSERT(store.search(make_embedding({-1.0f, 0.0f}), 1)[0].text == "c");
+    }
+
+    // --- 18. Payload projection and deferred payload loading ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_18.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStore store(cfg, "payload");
+        store.clear();
+        const uint64_t near = store.add(make_embedding({1.0f, 0.0f}), "near", "{\"n\":1}");
+        const uint64_t far = store.add(make_embedding({0.0f, 1.0f}), "far", "{\"n\":2}");
+        const mdbxc::Embedding query = make_embedding({1.0f, 0.1f});
+
+        std::vector<mdbxc::SearchResult> bare =
+            store.search(query, 2, mdbxc::SearchPayload::NONE);
+        MDBXC_TEST_ASSERT(bare.size() == 2);
+        MDBXC_TEST_ASSERT(bare[0].id == near);
+        MDBXC_TEST_ASSERT(bare[0].text.empty() && bare[0].metadata_json.empty());
+
+        const std::vector<mdbxc::SearchResult> meta =
+            store.search(query, 2, mdbxc::SearchPayload::METADATA);
+        MDBXC_TEST_ASSERT(meta[0].text.empty());
+        MDBXC_TEST_ASSERT(meta[0].metadata_json == "{\"n\":1}");
+
+        store.erase(far);
+        MDBXC_TEST_ASSERT(store.load_payloads(bare) == 1);
+        MDBXC_TEST_ASSERT(bare[0].text == "near");
+        MDBXC_TEST_ASSERT(bare[0].metadata_json == "{\"n\":1}");
+        MDBXC_TEST_ASSERT(bare[1].text.empty());
+    }
+
+    // --- 19. Shared index file mapped by every store ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_19.mdbx";
+        cfg.max_dbs = 16;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStoreOptions options;
+        options.metric = mdbxc::VectorMetric::L2;
+        options.index_snapshot = true;
+        options.shared_index_path = "vector_store_test_19.index";
+        const auto exists = [](const std::string& path) {
+            return std::ifstream(path.c_str()).good();
+        };
+        uint64_t late_id = 0;
+        {
+            mdbxc::VectorStore store(cfg, "shared", options);
+            store.clear();
+            store.add(make_embedding({0.0f, 0.0f}), "origin");
+            store.add(make_embedding({5.0f, 5.0f}), "far");
+            store.save_index_snapshot();
+            late_id = store.add(make_embedding({1.0f, 0.0f}), "late");
+        }
+        MDBXC_TEST_ASSERT(exists("vector_store_test_19.index.1"));
+        {
+            mdbxc::VectorStore store(cfg, "shared", options);
+            MDBXC_TEST_ASSERT(store.count() == 3);
+            MDBXC_TEST_ASSERT(store.search(make_embedding({1.0f, 0.1f}), 1)[0].id == late_id);
+            store.save_index_snapshot();
+            MDBXC_TEST_ASSERT(!exists("vector_store_test_19.index.1"));
+            MDBXC_TEST_ASSERT(exists("vector_store_test_19.index.2"));
+            MDBXC_TEST_ASSERT(store.search(make_embedding({4.0f, 4.0f}), 1)[0].text == "far");
+            store.clear();
+            MDBXC_TEST_ASSERT(!exists("vector_store_test_19.index.2"));
+        }
+
+        mdbxc::VectorStoreOptions unsnapshotted;
+        unsnapshotted.shared_index_path = "vector_store_test_19.index";
+        bool threw = false;
+        try {
+            mdbxc::VectorStore store(cfg, "shared_off", unsnapshotted);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 20. BM25 text search and hybrid fusion ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_20.mdbx";
+        cfg.max_dbs = 16;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        {
+            // Written without a text index; enabling it later rebuilds postings.
+            mdbxc::VectorStore plain(cfg, "hybrid");
+            plain.clear();
+            plain.add(make_embedding({1.0f, 0.0f}), "apple pie recipe");
+            plain.add(make_embedding({0.9f, 0.1f}), "banana bread");
+            bool threw = false;
+            try {
+                plain.text_search("apple", 1);
+            } catch (const std::logic_error&) {
+                threw = true;
+            }
+            MDBXC_TEST_ASSERT(threw);
+        }
+
+        mdbxc::VectorStoreOptions options;
+        options.text_index = true;
+        mdbxc::VectorStore store(cfg, "hybrid", options);
+        const uint64_t cider = store.add(make_embedding({0.0f, 1.0f}), "apple cider and apple juice");
+        store.add(make_embedding({-1.0f, 0.0f}), "car engine repair");
+
+        std::vector<mdbxc::SearchResult> text = store.text_search("Apple", 5);
+        MDBXC_TEST_ASSERT(text.size() == 2);
+        MDBXC_TEST_ASSERT(text[0].id == cider);
+        MDBXC_TEST_ASSERT(text[1].text == "apple pie recipe");
+        MDBXC_TEST_ASSERT(store.text_search("unknown words", 5).empty());
+
+        // "pie" is first by vector and in the text ranking, so fusion puts it on top.
+        const mdbxc::Embedding query = make_embedding({1.0f, 0.05f});
+        std::vector<mdbxc::SearchResult> fused = store.hybrid_search(query, "apple pie", 3);
+        MDBXC_TEST_ASSERT(fused.size() == 3);
+        MDBXC_TEST_ASSERT(fused[0].text == "apple pie recipe");
+        MDBXC_TEST_ASSERT(fused[0].score > fused[1].score);
+
+        mdbxc::HybridSearchOptions weighted;
+        weighted.fusion = mdbxc::HybridFusion::WEIGHTED;
+        weighted.vector_weight = 0.0f;
+        weighted.payload = mdbxc::SearchPayload::NONE;
+        fused = store.hybrid_search(query, "juice", 1, weighted);
+        MDBXC_TEST_ASSERT(fused.size() == 1);
+        MDBXC_TEST_ASSERT(fused[0].id == cider && fused[0].text.empty());
+
+        MDBXC_TEST_ASSERT(store.erase(cider));
+        text = store.text_search("apple", 5);
+        MDBXC_TEST_ASSERT(text.size() == 1 && text[0].text == "apple pie recipe");
+
+        std::vector<mdbxc::VectorRecord> batch(1);
+        batch[0].embedding = make_embedding({0.5f, 0.5f});
+        batch[0].text = "apple strudel";
+        store.add_batch(batch);
+        MDBXC_TEST_ASSERT(store.text_search("strudel", 5).size() == 1);
+    }
+
+    // --- 21. Product-quantized store persists its codebooks ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_21.mdbx";
+        cfg.max_dbs = 16;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStoreOptions options;
+        options.metric = mdbxc::VectorMetric::L2;
+        options.quantization = mdbxc::VectorQuantization::PQ;
+        options.pq.subspaces = 2;
+        std::vector<mdbxc::Embedding> vectors;
+        {
+            mdbxc::VectorStore store(cfg, "pq", options);
+            store.clear();
+            std::vector<mdbxc::VectorRecord> batch(300);
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                const float x = static_cast<float>(i);
+                batch[i].embedding = make_embedding({x, 0.5f * x, 300.0f - x, 1.0f});
+                vectors.push_back(batch[i].embedding);
+            }
+            store.add_batch(batch);
+            store.train_index(2);
+            // Re-ranking from fp32 embeddings keeps the exact top match.
+            const std::vector<mdbxc::SearchResult> results = store.search(vectors[42], 1);
+            MDBXC_TEST_ASSERT(results.size() == 1 && results[0].score == 0.0f);
+        }
+        {
+            // Reopening encodes with the stored codebooks instead of retraining.
+            mdbxc::VectorStore store(cfg, "pq", options);
+            MDBXC_TEST_ASSERT(store.count() == 300);
+            const uint64_t added = store.add(make_embedding({42.1f, 21.0f, 257.9f, 1.0f}), "");
+            const std::vector<mdbxc::SearchResult> results =
+                store.search(make_embedding({42.1f, 21.0f, 257.9f, 1.0f}), 2);
+            MDBXC_TEST_ASSERT(results.size() == 2 && results[0].id == added);
+        }
+
+        bool threw = false;
+        try {
+            mdbxc::VectorStore flat(cfg, "plain", mdbxc::VectorMetric::L2);
+            flat.train_index();
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+    }
+
+    // --- 22. Binary first pass with fp32 re-rank for near-duplicate lookup ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_22.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStoreOptions options;
+        options.quantization = mdbxc::VectorQuantization::BINARY;
+        options.rerank_factor = 8;
+        mdbxc::VectorStore store(cfg, "binary", options);
+        store.clear();
+        std::vector<mdbxc::Embedding> vectors;
+        std::uint32_t seed = 5;
+        for (std::size_t i = 0; i < 64; ++i) {
+            std::vector<float> values(128);
+            for (std::size_t d = 0; d < values.size(); ++d) {
+                seed = seed * 1664525u + 1013904223u;
+                values[d] = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+            }
+            vectors.push_back(make_embedding(values));
+            store.add(vectors.back(), "doc " + std::to_string(i));
+        }
+        std::vector<float> copy = vectors[17].values;
+        copy[3] *= 1.01f;
+        const std::vector<mdbxc::SearchResult> results = store.search(make_embedding(copy), 2);
+        MDBXC_TEST_ASSERT(results.size() == 2);
+        MDBXC_TEST_ASSERT(results[0].text == "doc 17");
+        // Re-ranked scores are exact cosines, not Hamming counts.
+        MDBXC_TEST_ASSERT(results[0].score > 0.99f && results[0].score <= 1.0001f);
+        MDBXC_TEST_ASSERT(results[1].score < 0.5f);
+    }
+
+    // --- 23. Registry shares a search pool and evicts cold indexes ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_23.mdbx";
+        cfg.max_dbs = 32;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        mdbxc::VectorStoreOptions options;
+        options.index_snapshot = true;
+        const char* names[] = {"tenant_a", "tenant_b", "tenant_c"};
+        const mdbxc::Embedding query = make_embedding({16.5f, 1.0f, 0.0f, 0.5f});
+        std::size_t one = 0;
+        {
+            mdbxc::VectorStoreRegistryOptions registry_options;
+            registry_options.search_threads = 2;
+            mdbxc::VectorStoreRegistry registry(mdbxc::Connection::create(cfg), registry_options);
+            MDBXC_TEST_ASSERT(registry.search_threads() == 2);
+            for (std::size_t c = 0; c < 3; ++c) {
+                std::shared_ptr<mdbxc::VectorStore> store = registry.open(names[c], options);
+                store->clear();
+                for (std::size_t i = 0; i < 16; ++i) {
+                    const float x = static_cast<float>(i + 1) + static_cast<float>(c) * 0.25f;
+                    store->add(make_embedding({x, 1.0f, 0.0f, 0.5f}),
+                               std::string(names[c]) + " " + std::to_string(i));
+                }
+                store->save_index_snapshot();
+            }
+            MDBXC_TEST_ASSERT(registry.collections().size() == 3);
+            MDBXC_TEST_ASSERT(registry.open("tenant_a", options) == registry.get("tenant_a"));
+            MDBXC_TEST_ASSERT(!registry.get("missing"));
+
+            one = registry.get("tenant_a")->index_memory_bytes();
+            MDBXC_TEST_ASSERT(one > 0);
+            MDBXC_TEST_ASSERT(registry.index_memory_bytes() == 3 * one);
+            MDBXC_TEST_ASSERT(registry.trim() == 0);
+
+            // Fan-out search merges the best matches of every collection.
+            std::vector<std::string> all(names, names + 3);
+            std::vector<mdbxc::SearchResult> merged = registry.search(all, query, 4);
+            MDBXC_TEST_ASSERT(merged.size() == 4);
+            for (std::size_t i = 1; i < merged.size(); ++i) {
+                MDBXC_TEST_ASSERT(merged[i - 1].score >= merged[i].score);
+            }
+            std::future<std::vector<mdbxc::SearchResult>> single = registry.search_async("tenant_b", query, 1);
+            MDBXC_TEST_ASSERT(single.get()[0].collection == "tenant_b");
+            bool threw = false;
+            try {
+                registry.search_async("missing", query, 1);
+            } catch (const std::out_of_range&) {
+                threw = true;
+            }
+            MDBXC_TEST_ASSERT(threw);
+        }
+
+        // A cap of two indexes evicts the least recently used collection.
+        mdbxc::VectorStoreRegistryOptions capped_options;
+        capped_options.memory_limit = 2 * one;
+        capped_options.search_threads = 1;
+        mdbxc::VectorStoreRegistry capped(mdbxc::Connection::create(cfg), capped_options);
+        capped.open("tenant_a", options);
+        capped.open("tenant_b", options);
+        capped.open("tenant_c", options);
+        std::vector<mdbxc::CollectionMemoryStats> stats = capped.memory_stats();
+        MDBXC_TEST_ASSERT(stats.size() == 3);
+        MDBXC_TEST_ASSERT(!stats[0].loaded && stats[0].index_bytes == 0 && stats[0].evictions == 1);
+        MDBXC_TEST_ASSERT(stats[1].loaded && stats[2].loaded);
+        MDBXC_TEST_ASSERT(capped.index_memory_bytes() <= capped.memory_limit());
+
+        // Searching the evicted collection reloads it from its snapshot and
+        // evicts the next coldest one instead.
+        std::vector<mdbxc::SearchResult> reloaded = capped.search_async("tenant_a", query, 1).get();
+        MDBXC_TEST_ASSERT(reloaded.size() == 1 && reloaded[0].text == "tenant_a 15");
+        stats = capped.memory_stats();
+        MDBXC_TEST_ASSERT(stats[0].loaded);
+        MDBXC_TEST_ASSERT(!stats[1].loaded && stats[1].evictions == 1);
+        MDBXC_TEST_ASSERT(capped.close("tenant_c"));
+        MDBXC_TEST_ASSERT(!capped.close("tenant_c"));
+        MDBXC_TEST_ASSERT(capped.collections().size() == 2);
+    }
+
+    // --- 24. Reduced-precision persisted embeddings ---
+    {
+        // Serialized rows are half the size and widen back within rounding.
+        std::vector<float> vals;
+        for (int i = 0; i < 37; ++i) vals.push_back(0.25f * static_cast<float>(i) - 3.1f);
+        mdbxc::Embedding e = make_embedding(vals);
+        const std::size_t fp32_size = e.to_bytes().size();
+        MDBXC_TEST_ASSERT(fp32_size == 8 + 38 * 4);
+        const mdbxc::EmbeddingPrecision precisions[2] = {
+            mdbxc::EmbeddingPrecision::FP16, mdbxc::EmbeddingPrecision::BF16
+        };
+        for (int p = 0; p < 2; ++p) {
+            e.precision = precisions[p];
+            const std::vector<uint8_t> bytes = e.to_bytes();
+            MDBXC_TEST_ASSERT(bytes.size() == 8 + 40 * 2);
+            MDBXC_TEST_ASSERT(bytes[4] == static_cast<uint8_t>(precisions[p]));
+            const mdbxc::Embedding back = mdbxc::Embedding::from_bytes(bytes.data(), bytes.size());
+            MDBXC_TEST_ASSERT(back.precision == precisions[p]);
+            MDBXC_TEST_ASSERT(back.dim == e.dim);
+            const float tolerance = p == 0 ? 1e-3f : 2e-2f;
+            for (std::size_t i = 0; i < vals.size(); ++i) {
+                MDBXC_TEST_ASSERT(std::fabs(back.values[i] - vals[i]) <= tolerance * (1.0f + std::fabs(vals[i])));
+            }
+            // The unpadded length and an odd address decode the same values.
+            std::vector<uint8_t> shifted(bytes.size() + 1, 0);
+            std::memcpy(shifted.data() + 1, bytes.data(), bytes.size());
+            std::vector<float> scratch;
+            const mdbxc::EmbeddingView view = mdbxc::Embedding::view(shifted.data() + 1, 8 + 37 * 2, scratch);
+            MDBXC_TEST_ASSERT(view.dim == 37);
+            MDBXC_TEST_ASSERT(std::memcmp(view.values, back.values.data(), 37 * sizeof(float)) == 0);
+        }
+        std::vector<uint8_t> bad = e.to_bytes();
+        bad[4] = 3;
+        bool threw = false;
+        try {
+            mdbxc::Embedding::from_bytes(bad.data(), bad.size());
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
+
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_24.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+        auto conn = mdbxc::Connection::create(cfg);
+
+        mdbxc::VectorStoreOptions options;
+        options.embedding_precision = mdbxc::EmbeddingPrecision::FP16;
+        uint64_t near_id = 0;
+        {
+            mdbxc::VectorStore store(conn, "half", options);
+            store.clear();
+            near_id = store.add(make_embedding({0.9f, 0.1f, 0.0f}), "near");
+            std::vector<mdbxc::VectorRecord> batch(2);
+            batch[0].embedding = make_embedding({0.0f, 1.0f, 0.0f});
+            batch[0].text = "far";
+            batch[1].embedding = make_embedding({0.0f, 0.0f, 1.0f});
+            batch[1].text = "other";
+            store.add_batch(batch);
+        }
+        mdbxc::KeyValueTable<uint64_t, std::vector<uint8_t>> raw(conn, "vectors_half_embeddings");
+        MDBXC_TEST_ASSERT(raw.at(near_id).size() == 8 + 4 * 2);
+        MDBXC_TEST_ASSERT(raw.at(near_id)[4] == static_cast<uint8_t>(mdbxc::EmbeddingPrecision::FP16));
+
+        // Reopening rebuilds the index from the fp16 rows; a later fp32
+        // writer keeps reading them.
+        options.embedding_precision = mdbxc::EmbeddingPrecision::FP32;
+        mdbxc::VectorStore reopened(conn, "half", options);
+        MDBXC_TEST_ASSERT(reopened.count() == 3);
+        uint64_t wide_id = reopened.add(make_embedding({0.5f, 0.5f, 0.0f}), "wide");
+        MDBXC_TEST_ASSERT(raw.at(wide_id).size() == 8 + 4 * 4);
+        reopened.rebuild_index();
+        std::vector<mdbxc::SearchResult> results = reopened.search(make_embedding({1.0f, 0.0f, 0.0f}), 2);
+        MDBXC_TEST_ASSERT(results.size() == 2);
+        MDBXC_TEST_ASSERT(results[0].id == near_id && results[0].text == "near");
+        MDBXC_TEST_ASSERT(results[1].id == wide_id);
+    }
+
+    // --- 25. Background rebuild keeps serving searches and replays concurrent writes ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_25.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+        auto conn = mdbxc::Connection::create(cfg);
+
+        const mdbxc::VectorIndexType types[2] = {
+            mdbxc::VectorIndexType::FLAT, mdbxc::VectorIndexType::HNSW
+        };
+        for (int t = 0; t < 2; ++t) {
+            mdbxc::VectorStoreOptions options;
+            options.index_type = types[t];
+            mdbxc::VectorStore store(conn, t == 0 ? "bg_flat" : "bg_hnsw", options);
+            store.clear();
+            std::vector<mdbxc::VectorRecord> batch(2000);
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                const float angle = static_cast<float>(i) * 0.001f;
+                batch[i].embedding = make_embedding({std::cos(angle), std::sin(angle), 0.0f});
+                batch[i].text = "base";
+            }
+            const uint64_t first = store.add_batch(batch).first;
+
+            std::future<bool> rebuilt = store.rebuild_index_async();
+            const uint64_t added = store.add(make_embedding({0.0f, 0.0f, 1.0f}), "added");
+            MDBXC_TEST_ASSERT(store.erase(first));
+            MDBXC_TEST_ASSERT(store.search(make_embedding({0.0f, 0.0f, 1.0f}), 1)[0].id == added);
+            MDBXC_TEST_ASSERT(rebuilt.get());
+
+            MDBXC_TEST_ASSERT(store.count() == batch.size());
+            std::vector<mdbxc::SearchResult> results = store.search(make_embedding({0.0f, 0.0f, 1.0f}), 1);
+            MDBXC_TEST_ASSERT(results.size() == 1 && results[0].id == added);
+            results = store.search(make_embedding({1.0f, 0.0f, 0.0f}), 1);
+            MDBXC_TEST_ASSERT(results.size() == 1 && results[0].id == first + 1);
+            MDBXC_TEST_ASSERT(store.rebuild_index());
+        }
+    }
+
+    // --- 26. Truncated-prefix first pass in a store ---
+    {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/vector_store_test_26.mdbx";
+        cfg.max_dbs = 10;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+        auto conn = mdbxc::Connection::create(cfg);
+
+        mdbxc::VectorStoreOptions options;
+        options.quantization = mdbxc::VectorQuantization::INT8;
+        options.prefix_dim = 16;
+        mdbxc::VectorStore store(conn, "prefix", options);
+        store.clear();
+        std::vector<mdbxc::Embedding> vectors;
+        std::uint32_t seed = 41;
+        for (std::size_t i = 0; i < 200; ++i) {
+            std::vector<float> values(64);
+            for (std::size_t d = 0; d < values.size(); ++d) {
+                seed = seed * 1664525u + 1013904223u;
+                values[d] = (d < 16 ? 1.0f : 0.25f) * (static_cast<float>(seed >> 8) / 8388608.0f - 1.0f);
+            }
+            vectors.push_back(make_embedding(values));
+            store.add(vectors.back(), "doc " + std::to_string(i));
+        }
+        std::vector<mdbxc::SearchResult> results = store.search(vectors[42], 3);
+        MDBXC_TEST_ASSERT(results.size() == 3 && results[0].text == "doc 42");
+        // Final scores come from persisted fp32 embeddings.
+        MDBXC_TEST_ASSERT(std::fabs(results[0].score - 1.0f) < 1e-4f);
+        store.rebuild_index();
+        results = store.search(vectors[7], 1);
+        MDBXC_TEST_ASSERT(results.size() == 1 && results[0].text == "doc 7");
+
+        bool threw = false;
+        try {
+            mdbxc::VectorStoreOptions hnsw;
+            hnsw.index_type = mdbxc::VectorIndexType::HNSW;
+            hnsw.prefix_dim = 16;
+            mdbxc::VectorStore rejected(conn, "prefix_hnsw", hnsw);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        MDBXC_TEST_ASSERT(threw);
     }
 
     std::cout << "VectorStore test passed.\n";
@@ -0,0 +1,90 @@
+#include "test_assert.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <mdbx_containers/WriteBehindKeyValueTable.hpp>
+
+int main() {
+    try {
+        mdbxc::Config cfg;
+        cfg.pathname = "data/write_behind_key_value_table_test.mdbx";
+        cfg.max_dbs = 4;
+        cfg.no_subdir = true;
+        cfg.relative_to_exe = true;
+
+        auto conn = mdbxc::Connection::create(cfg);
+
+        mdbxc::WriteBehindOptions manual;
+        manual.max_entries = 100;
+        manual.flush_interval = std::chrono::milliseconds(0);
+        {
+            mdbxc::WriteBehindKeyValueTable<std::string, std::uint64_t> counters(conn, "wb_counters", manual);
+            counters.clear();
+            counters.table().insert_or_assign("stored", 10);
+
+            // Updates coalesce in memory and start from the stored value.
+            for (int i = 0; i < 50; ++i) {
+                counters.update("hits", [](std::uint64_t& v) { ++v; });
+                counters.update("stored", [](std::uint64_t& v) { ++v; });
+            }
+            MDBXC_TEST_ASSERT(counters.pending_count() == 2);
+            MDBXC_TEST_ASSERT(counters.at("hits") == 50);
+            MDBXC_TEST_ASSERT(counters.at("stored") == 60);
+            MDBXC_TEST_ASSERT(!counters.table().contains("hits"));
+            MDBXC_TEST_ASSERT(counters.table().at("stored") == 10);
+
+            counters.insert_or_assign("gone", 1);
+            counters.erase("gone");
+            MDBXC_TEST_ASSERT(!counters.contains("gone"));
+
+            mdbxc::WriteBehindStats stats = counters.stats();
+            MDBXC_TEST_ASSERT(stats.writes == 102);
+            MDBXC_TEST_ASSERT(stats.coalesced == 99);
+            MDBXC_TEST_ASSERT(stats.flushes == 0);
+
+            MDBXC_TEST_ASSERT(counters.flush() == 3);
+            MDBXC_TEST_ASSERT(counters.pending_count() == 0);
+            MDBXC_TEST_ASSERT(counters.table().at("hits") == 50);
+            MDBXC_TEST_ASSERT(counters.table().at("stored") == 60);
+            MDBXC_TEST_ASSERT(!counters.table().contains("gone"));
+            MDBXC_TEST_ASSERT(counters.flush() == 0);
+
+            // Reaching max_entries without a flush thread flushes inline.
+            for (int i = 0; i < 100; ++i) {
+                counters.insert_or_assign("k" + std::to_string(i), static_cast<std::uint64_t>(i));
+            }
+            MDBXC_TEST_ASSERT(counters.pending_count() == 0);
+            MDBXC_TEST_ASSERT(counters.table().at("k99") == 99);
+
+            // The destructor flushes what is left.
+            counters.update("hits", [](std::uint64_t& v) { v += 5; });
+        }
+        {
+            mdbxc::KeyValueTable<std::string, std::uint64_t> plain(conn, "wb_counters");
+            MDBXC_TEST_ASSERT(plain.at("hits") == 55);
+        }
+
+        mdbxc::WriteBehindOptions timed;
+        timed.max_entries = 1000;
+        timed.flush_interval = std::chrono::milliseconds(10);
+        mdbxc::WriteBehindKeyValueTable<int, std::string> last_seen(conn, "wb_last_seen", timed);
+        last_seen.clear();
+        last_seen.insert_or_assign(1, "a");
+        last_seen.insert_or_assign(1, "b");
+        for (int i = 0; i < 200 && last_seen.stats().flushes == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        MDBXC_TEST_ASSERT(last_seen.pending_count() == 0);
+        MDBXC_TEST_ASSERT(last_seen.table().at(1) == "b");
+        MDBXC_TEST_ASSERT(last_seen.stats().flushed_records == 1);
+    } catch (const std::exception& e) {
+        std::cerr << "Write-behind key-value table test failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "Write-behind key-value table test passed.\n";
+    return 0;
+}